@@ -52,11 +52,18 @@ typedef struct _mp_obj_task_t {
     mp_obj_t data;
     mp_obj_t state;
     mp_obj_t ph_key;
+    // CIRCUITPY-CHANGE: link in a TaskQueue's ready FIFO
+    struct _mp_obj_task_t *ready_next;
 } mp_obj_task_t;
 
+// CIRCUITPY-CHANGE: Tasks that are already due go on a FIFO instead of the
+// heap. Their keys are never earlier than the tail's, so the FIFO stays in
+// key order and its head can be compared with the top of the heap.
 typedef struct _mp_obj_task_queue_t {
     mp_obj_base_t base;
     mp_obj_task_t *heap;
+    mp_obj_task_t *ready_head;
+    mp_obj_task_t *ready_tail;
 } mp_obj_task_queue_t;
 
 STATIC const mp_obj_type_t task_queue_type;
@@ -107,15 +114,28 @@ STATIC mp_obj_t task_queue_make_new(const mp_obj_type_t *type, size_t n_args, si
     mp_arg_check_num(n_args, n_kw, 0, 0, false);
     mp_obj_task_queue_t *self = mp_obj_malloc(mp_obj_task_queue_t, type);
     self->heap = (mp_obj_task_t *)mp_pairheap_new(task_lt);
+    self->ready_head = NULL;
+    self->ready_tail = NULL;
     return MP_OBJ_FROM_PTR(self);
 }
 
+// CIRCUITPY-CHANGE: The next task is the earlier of the FIFO head and the top
+// of the heap, preferring the FIFO on a tie.
+STATIC mp_obj_task_t *task_queue_first(mp_obj_task_queue_t *self) {
+    mp_obj_task_t *ready = self->ready_head;
+    if (ready == NULL || (self->heap != NULL && ticks_diff(self->heap->ph_key, ready->ph_key) < 0)) {
+        return self->heap;
+    }
+    return ready;
+}
+
 STATIC mp_obj_t task_queue_peek(mp_obj_t self_in) {
     mp_obj_task_queue_t *self = MP_OBJ_TO_PTR(self_in);
-    if (self->heap == NULL) {
+    mp_obj_task_t *first = task_queue_first(self);
+    if (first == NULL) {
         return mp_const_none;
     } else {
-        return MP_OBJ_FROM_PTR(self->heap);
+        return MP_OBJ_FROM_PTR(first);
     }
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(task_queue_peek_obj, task_queue_peek);
@@ -124,24 +144,48 @@ STATIC mp_obj_t task_queue_push(size_t n_args, const mp_obj_t *args) {
     mp_obj_task_queue_t *self = MP_OBJ_TO_PTR(args[0]);
     mp_obj_task_t *task = MP_OBJ_TO_PTR(args[1]);
     task->data = mp_const_none;
+    // CIRCUITPY-CHANGE: due tasks are appended to the ready FIFO in O(1)
+    mp_obj_t now = ticks();
+    bool ready = true;
     if (n_args == 2) {
-        task->ph_key = ticks();
+        task->ph_key = now;
     } else {
         assert(mp_obj_is_small_int(args[2]));
         task->ph_key = args[2];
+        ready = ticks_diff(task->ph_key, now) <= 0;
+    }
+    mp_obj_task_t *tail = self->ready_tail;
+    if (ready && (tail == NULL || ticks_diff(task->ph_key, tail->ph_key) >= 0)) {
+        task->ready_next = NULL;
+        if (tail == NULL) {
+            self->ready_head = task;
+        } else {
+            tail->ready_next = task;
+        }
+        self->ready_tail = task;
+    } else {
+        self->heap = (mp_obj_task_t *)mp_pairheap_push(task_lt, TASK_PAIRHEAP(self->heap), TASK_PAIRHEAP(task));
     }
-    self->heap = (mp_obj_task_t *)mp_pairheap_push(task_lt, TASK_PAIRHEAP(self->heap), TASK_PAIRHEAP(task));
     return mp_const_none;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(task_queue_push_obj, 2, 3, task_queue_push);
 
 STATIC mp_obj_t task_queue_pop(mp_obj_t self_in) {
     mp_obj_task_queue_t *self = MP_OBJ_TO_PTR(self_in);
-    mp_obj_task_t *head = (mp_obj_task_t *)mp_pairheap_peek(task_lt, &self->heap->pairheap);
+    mp_obj_task_t *head = task_queue_first(self);
     if (head == NULL) {
         mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("empty heap"));
     }
-    self->heap = (mp_obj_task_t *)mp_pairheap_pop(task_lt, &self->heap->pairheap);
+    // CIRCUITPY-CHANGE: pop from whichever of the FIFO and the heap is first
+    if (head == self->ready_head) {
+        self->ready_head = head->ready_next;
+        if (self->ready_head == NULL) {
+            self->ready_tail = NULL;
+        }
+        head->ready_next = NULL;
+    } else {
+        self->heap = (mp_obj_task_t *)mp_pairheap_pop(task_lt, &self->heap->pairheap);
+    }
     return MP_OBJ_FROM_PTR(head);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(task_queue_pop_obj, task_queue_pop);
@@ -149,6 +193,22 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(task_queue_pop_obj, task_queue_pop);
 STATIC mp_obj_t task_queue_remove(mp_obj_t self_in, mp_obj_t task_in) {
     mp_obj_task_queue_t *self = MP_OBJ_TO_PTR(self_in);
     mp_obj_task_t *task = MP_OBJ_TO_PTR(task_in);
+    // CIRCUITPY-CHANGE: the task may be on the ready FIFO rather than the heap
+    mp_obj_task_t *prev = NULL;
+    for (mp_obj_task_t *t = self->ready_head; t != NULL; prev = t, t = t->ready_next) {
+        if (t == task) {
+            if (prev == NULL) {
+                self->ready_head = task->ready_next;
+            } else {
+                prev->ready_next = task->ready_next;
+            }
+            if (self->ready_tail == task) {
+                self->ready_tail = prev;
+            }
+            task->ready_next = NULL;
+            return mp_const_none;
+        }
+    }
     self->heap = (mp_obj_task_t *)mp_pairheap_delete(task_lt, &self->heap->pairheap, &task->pairheap);
     return mp_const_none;
 }
@@ -190,6 +250,7 @@ STATIC mp_obj_t task_make_new(const mp_obj_type_t *type, size_t n_args, size_t n
     self->data = mp_const_none;
     self->state = TASK_STATE_RUNNING_NOT_WAITED_ON;
     self->ph_key = MP_OBJ_NEW_SMALL_INT(0);
+    self->ready_next = NULL;
     if (n_args == 2) {
         asyncio_context = args[1];
     }
@@ -187,49 +187,57 @@ STATIC mp_uint_t json_python_readinto(mp_obj_t obj, void *buf, mp_uint_t size, i
     return 1;
 }
 
-STATIC mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
+// CIRCUITPY-CHANGE
+// The parser is split into a tokenizer, json_next_token, and a builder for
+// nested values, json_parse_value, so that iterparse can share them.
+
+NORETURN STATIC void json_fail(void) {
+    mp_raise_ValueError(MP_ERROR_TEXT("syntax error in JSON"));
+}
+
+STATIC void json_stream_init(json_stream_t *s, mp_obj_t stream_obj, uint8_t *character_buffer) {
     const mp_stream_p_t *stream_p = mp_proto_get(0, stream_obj);
-    json_stream_t s;
-    uint8_t character_buffer[CIRCUITPY_JSON_READ_CHUNK_SIZE];
+    s->errcode = 0;
+    s->cur = 0;
     if (stream_p == NULL) {
-        s.start = 0;
-        s.end = 0;
-        mp_load_method(stream_obj, MP_QSTR_readinto, s.python_readinto);
-        s.bytearray_obj.base.type = &mp_type_bytearray;
-        s.bytearray_obj.typecode = BYTEARRAY_TYPECODE;
-        s.bytearray_obj.len = CIRCUITPY_JSON_READ_CHUNK_SIZE;
-        s.bytearray_obj.free = 0;
-        s.bytearray_obj.items = character_buffer;
-        s.python_readinto[2] = MP_OBJ_FROM_PTR(&s.bytearray_obj);
-        s.stream_obj = &s;
-        s.read = json_python_readinto;
+        s->start = 0;
+        s->end = 0;
+        mp_load_method(stream_obj, MP_QSTR_readinto, s->python_readinto);
+        s->bytearray_obj.base.type = &mp_type_bytearray;
+        s->bytearray_obj.typecode = BYTEARRAY_TYPECODE;
+        s->bytearray_obj.len = CIRCUITPY_JSON_READ_CHUNK_SIZE;
+        s->bytearray_obj.free = 0;
+        s->bytearray_obj.items = character_buffer;
+        s->python_readinto[2] = MP_OBJ_FROM_PTR(&s->bytearray_obj);
+        s->stream_obj = s;
+        s->read = json_python_readinto;
     } else {
         stream_p = mp_get_stream_raise(stream_obj, MP_STREAM_OP_READ);
-        s.stream_obj = stream_obj;
-        s.read = stream_p->read;
-        s.errcode = 0;
-        s.cur = 0;
+        s->stream_obj = stream_obj;
+        s->read = stream_p->read;
     }
-
     JSON_DEBUG("got JSON stream\n");
-    vstr_t vstr;
-    vstr_init(&vstr, 8);
-    mp_obj_list_t stack; // we use a list as a simple stack for nested JSON
-    stack.len = 0;
-    stack.items = NULL;
-    mp_obj_t stack_top = MP_OBJ_NULL;
-    const mp_obj_type_t *stack_top_type = NULL;
-    mp_obj_t stack_key = MP_OBJ_NULL;
-    S_NEXT(s);
+    S_NEXT(*s);
+}
+
+enum {
+    JSON_TOKEN_END,
+    JSON_TOKEN_VALUE,
+    JSON_TOKEN_LIST,
+    JSON_TOKEN_DICT,
+    JSON_TOKEN_CLOSE,
+};
+
+// Read the next token.  For JSON_TOKEN_VALUE the primitive is stored in
+// *value; if vstr is NULL the primitive is only skipped over, without
+// allocating, and *value is None.
+STATIC int json_next_token(json_stream_t *s, vstr_t *vstr, mp_obj_t *value) {
     for (;;) {
-    cont:
-        if (S_END(s)) {
-            break;
+        if (S_END(*s)) {
+            return JSON_TOKEN_END;
         }
-        mp_obj_t next = MP_OBJ_NULL;
-        bool enter = false;
-        byte cur = S_CUR(s);
-        S_NEXT(s);
+        byte cur = S_CUR(*s);
+        S_NEXT(*s);
         switch (cur) {
             case ',':
             case ':':
@@ -237,37 +245,36 @@ STATIC mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
             case '\t':
             case '\n':
             case '\r':
-                goto cont;
+                continue;
             case 'n':
-                if (S_CUR(s) == 'u' && S_NEXT(s) == 'l' && S_NEXT(s) == 'l') {
-                    S_NEXT(s);
-                    next = mp_const_none;
-                } else {
-                    goto fail;
+                if (S_CUR(*s) == 'u' && S_NEXT(*s) == 'l' && S_NEXT(*s) == 'l') {
+                    S_NEXT(*s);
+                    *value = mp_const_none;
+                    return JSON_TOKEN_VALUE;
                 }
-                break;
+                json_fail();
             case 'f':
-                if (S_CUR(s) == 'a' && S_NEXT(s) == 'l' && S_NEXT(s) == 's' && S_NEXT(s) == 'e') {
-                    S_NEXT(s);
-                    next = mp_const_false;
-                } else {
-                    goto fail;
+                if (S_CUR(*s) == 'a' && S_NEXT(*s) == 'l' && S_NEXT(*s) == 's' && S_NEXT(*s) == 'e') {
+                    S_NEXT(*s);
+                    *value = mp_const_false;
+                    return JSON_TOKEN_VALUE;
                 }
-                break;
+                json_fail();
             case 't':
-                if (S_CUR(s) == 'r' && S_NEXT(s) == 'u' && S_NEXT(s) == 'e') {
-                    S_NEXT(s);
-                    next = mp_const_true;
-                } else {
-                    goto fail;
+                if (S_CUR(*s) == 'r' && S_NEXT(*s) == 'u' && S_NEXT(*s) == 'e') {
+                    S_NEXT(*s);
+                    *value = mp_const_true;
+                    return JSON_TOKEN_VALUE;
                 }
-                break;
+                json_fail();
             case '"':
-                vstr_reset(&vstr);
-                for (; !S_END(s) && S_CUR(s) != '"';) {
-                    byte c = S_CUR(s);
+                if (vstr != NULL) {
+                    vstr_reset(vstr);
+                }
+                for (; !S_END(*s) && S_CUR(*s) != '"';) {
+                    byte c = S_CUR(*s);
                     if (c == '\\') {
-                        c = S_NEXT(s);
+                        c = S_NEXT(*s);
                         switch (c) {
                             case 'b':
                                 c = 0x08;
@@ -287,27 +294,31 @@ STATIC mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
                             case 'u': {
                                 mp_uint_t num = 0;
                                 for (int i = 0; i < 4; i++) {
-                                    c = (S_NEXT(s) | 0x20) - '0';
+                                    c = (S_NEXT(*s) | 0x20) - '0';
                                     if (c > 9) {
                                         c -= ('a' - ('9' + 1));
                                     }
                                     num = (num << 4) | c;
                                 }
-                                vstr_add_char(&vstr, num);
+                                if (vstr != NULL) {
+                                    vstr_add_char(vstr, num);
+                                }
                                 goto str_cont;
                             }
                         }
                     }
-                    vstr_add_byte(&vstr, c);
+                    if (vstr != NULL) {
+                        vstr_add_byte(vstr, c);
+                    }
                 str_cont:
-                    S_NEXT(s);
+                    S_NEXT(*s);
                 }
-                if (S_END(s)) {
-                    goto fail;
+                if (S_END(*s)) {
+                    json_fail();
                 }
-                S_NEXT(s);
-                next = mp_obj_new_str(vstr.buf, vstr.len);
-                break;
+                S_NEXT(*s);
+                *value = vstr == NULL ? mp_const_none : mp_obj_new_str(vstr->buf, vstr->len);
+                return JSON_TOKEN_VALUE;
             case '-':
             case '0':
             case '1':
@@ -320,10 +331,14 @@ STATIC mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
             case '8':
             case '9': {
                 bool flt = false;
-                vstr_reset(&vstr);
+                if (vstr != NULL) {
+                    vstr_reset(vstr);
+                }
                 for (;;) {
-                    vstr_add_byte(&vstr, cur);
-                    cur = S_CUR(s);
+                    if (vstr != NULL) {
+                        vstr_add_byte(vstr, cur);
+                    }
+                    cur = S_CUR(*s);
                     if (cur == '.' || cur == 'E' || cur == 'e') {
                         flt = true;
                     } else if (cur == '+' || cur == '-' || unichar_isdigit(cur)) {
@@ -331,47 +346,75 @@ STATIC mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
                     } else {
                         break;
                     }
-                    S_NEXT(s);
+                    S_NEXT(*s);
                 }
-                if (flt) {
-                    next = mp_parse_num_float(vstr.buf, vstr.len, false, NULL);
+                if (vstr == NULL) {
+                    *value = mp_const_none;
+                } else if (flt) {
+                    *value = mp_parse_num_float(vstr->buf, vstr->len, false, NULL);
                 } else {
-                    next = mp_parse_num_integer(vstr.buf, vstr.len, 10, NULL);
+                    *value = mp_parse_num_integer(vstr->buf, vstr->len, 10, NULL);
                 }
-                break;
+                return JSON_TOKEN_VALUE;
             }
             case '[':
+                return JSON_TOKEN_LIST;
+            case '{':
+                return JSON_TOKEN_DICT;
+            case '}':
+            case ']':
+                return JSON_TOKEN_CLOSE;
+            default:
+                json_fail();
+        }
+    }
+}
+
+// Build the value that starts with token tok (whose primitive, if any, is
+// next), reading the rest of it from the stream.
+STATIC mp_obj_t json_parse_value(json_stream_t *s, vstr_t *vstr, int tok, mp_obj_t next) {
+    mp_obj_list_t stack; // we use a list as a simple stack for nested JSON
+    stack.len = 0;
+    stack.items = NULL;
+    mp_obj_t stack_top = MP_OBJ_NULL;
+    const mp_obj_type_t *stack_top_type = NULL;
+    mp_obj_t stack_key = MP_OBJ_NULL;
+    for (;; tok = json_next_token(s, vstr, &next)) {
+        bool enter = false;
+        switch (tok) {
+            case JSON_TOKEN_VALUE:
+                break;
+            case JSON_TOKEN_LIST:
                 next = mp_obj_new_list(0, NULL);
                 enter = true;
                 break;
-            case '{':
+            case JSON_TOKEN_DICT:
                 next = mp_obj_new_dict(0);
                 enter = true;
                 break;
-            case '}':
-            case ']': {
+            case JSON_TOKEN_CLOSE:
                 if (stack_top == MP_OBJ_NULL) {
                     // no object at all
-                    goto fail;
+                    json_fail();
                 }
                 if (stack.len == 0) {
                     // finished; compound object
-                    goto success;
+                    return stack_top;
                 }
                 stack.len -= 1;
                 stack_top = stack.items[stack.len];
                 stack_top_type = mp_obj_get_type(stack_top);
-                goto cont;
-            }
+                continue;
             default:
-                goto fail;
+                // end of stream before the value is complete
+                json_fail();
         }
         if (stack_top == MP_OBJ_NULL) {
             stack_top = next;
             stack_top_type = mp_obj_get_type(stack_top);
             if (!enter) {
                 // finished; single primitive only
-                goto success;
+                return stack_top;
             }
         } else {
             // append to list or dict
@@ -381,7 +424,7 @@ STATIC mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
                 if (stack_key == MP_OBJ_NULL) {
                     stack_key = next;
                     if (enter) {
-                        goto fail;
+                        json_fail();
                     }
                 } else {
                     mp_obj_dict_store(stack_top, stack_key, next);
@@ -400,8 +443,18 @@ STATIC mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
             }
         }
     }
-success:
-    // CIRCUITPY-CHANGE
+}
+
+STATIC mp_obj_t _mod_json_load(mp_obj_t stream_obj, bool return_first_json) {
+    json_stream_t s;
+    uint8_t character_buffer[CIRCUITPY_JSON_READ_CHUNK_SIZE];
+    json_stream_init(&s, stream_obj, character_buffer);
+
+    vstr_t vstr;
+    vstr_init(&vstr, 8);
+    mp_obj_t next = MP_OBJ_NULL;
+    int tok = json_next_token(&s, &vstr, &next);
+    mp_obj_t result = json_parse_value(&s, &vstr, tok, next);
 
     // It is legal for a stream to have contents after JSON.
     // E.g., A UART is not closed after receiving an object; in load() we will
@@ -413,18 +466,11 @@ success:
         }
         if (!S_END(s)) {
             // unexpected chars
-            goto fail;
+            json_fail();
         }
     }
-    if (stack_top == MP_OBJ_NULL || stack.len != 0) {
-        // not exactly 1 object
-        goto fail;
-    }
     vstr_clear(&vstr);
-    return stack_top;
-
-fail:
-    mp_raise_ValueError(MP_ERROR_TEXT("syntax error in JSON"));
+    return result;
 }
 
 STATIC mp_obj_t mod_json_load(mp_obj_t stream_obj) {
@@ -441,12 +487,192 @@ STATIC mp_obj_t mod_json_loads(mp_obj_t obj) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(mod_json_loads_obj, mod_json_loads);
 
+// CIRCUITPY-CHANGE
+#if MICROPY_PY_JSON_ITERPARSE
+
+enum {
+    JSON_MATCH_NONE,   // skip the value
+    JSON_MATCH_PREFIX, // a selected path lies inside the value
+    JSON_MATCH_EXACT,  // yield the whole value
+    JSON_MATCH_ALL,    // no paths given; yield every primitive value
+};
+
+typedef struct _mp_obj_json_iterparse_t {
+    mp_obj_base_t base;
+    json_stream_t s;
+    vstr_t vstr;
+    // Tuple of path tuples, or NULL to yield every primitive value.
+    mp_obj_tuple_t *paths;
+    // For each enclosing container, the key or index of the current value
+    // in path, and '[' or '{' in kinds.
+    mp_obj_list_t path;
+    vstr_t kinds;
+    bool want_key;
+    bool done;
+    uint8_t character_buffer[CIRCUITPY_JSON_READ_CHUNK_SIZE];
+} mp_obj_json_iterparse_t;
+
+STATIC int json_iterparse_match(mp_obj_json_iterparse_t *self) {
+    if (self->paths == NULL) {
+        return JSON_MATCH_ALL;
+    }
+    size_t depth = self->path.len;
+    int match = JSON_MATCH_NONE;
+    for (size_t i = 0; i < self->paths->len; i++) {
+        mp_obj_tuple_t *p = MP_OBJ_TO_PTR(self->paths->items[i]);
+        if (p->len < depth) {
+            continue;
+        }
+        size_t j = 0;
+        while (j < depth && (p->items[j] == mp_const_none || mp_obj_equal(p->items[j], self->path.items[j]))) {
+            j++;
+        }
+        if (j < depth) {
+            continue;
+        }
+        if (p->len == depth) {
+            return JSON_MATCH_EXACT;
+        }
+        match = JSON_MATCH_PREFIX;
+    }
+    return match;
+}
+
+// Skip the rest of a list or dict whose opening bracket has been read.
+STATIC void json_skip_value(json_stream_t *s) {
+    size_t depth = 1;
+    mp_obj_t value;
+    while (depth > 0) {
+        switch (json_next_token(s, NULL, &value)) {
+            case JSON_TOKEN_LIST:
+            case JSON_TOKEN_DICT:
+                depth++;
+                break;
+            case JSON_TOKEN_CLOSE:
+                depth--;
+                break;
+            case JSON_TOKEN_END:
+                json_fail();
+        }
+    }
+}
+
+// Advance the path past the value that has just been read.
+STATIC void json_iterparse_value_done(mp_obj_json_iterparse_t *self) {
+    size_t depth = self->path.len;
+    if (depth == 0) {
+        self->done = true;
+    } else if (self->kinds.buf[depth - 1] == '[') {
+        self->path.items[depth - 1] = MP_OBJ_NEW_SMALL_INT(MP_OBJ_SMALL_INT_VALUE(self->path.items[depth - 1]) + 1);
+    } else {
+        self->want_key = true;
+    }
+}
+
+STATIC mp_obj_t json_iterparse_result(mp_obj_json_iterparse_t *self, mp_obj_t value) {
+    mp_obj_t items[2] = { mp_obj_new_tuple(self->path.len, self->path.items), value };
+    json_iterparse_value_done(self);
+    return mp_obj_new_tuple(2, items);
+}
+
+STATIC mp_obj_t json_iterparse_iternext(mp_obj_t self_in) {
+    mp_obj_json_iterparse_t *self = MP_OBJ_TO_PTR(self_in);
+    while (!self->done) {
+        size_t depth = self->path.len;
+        bool is_key = self->want_key;
+        int match = is_key ? JSON_MATCH_EXACT : json_iterparse_match(self);
+        mp_obj_t value = MP_OBJ_NULL;
+        int tok = json_next_token(&self->s, match == JSON_MATCH_NONE ? NULL : &self->vstr, &value);
+        if (tok == JSON_TOKEN_END) {
+            json_fail();
+        }
+        if (tok == JSON_TOKEN_CLOSE) {
+            if (depth == 0) {
+                json_fail();
+            }
+            self->path.len--;
+            self->kinds.len--;
+            self->want_key = false;
+            json_iterparse_value_done(self);
+            continue;
+        }
+        if (is_key) {
+            if (tok != JSON_TOKEN_VALUE) {
+                json_fail();
+            }
+            self->path.items[depth - 1] = value;
+            self->want_key = false;
+            continue;
+        }
+        if (tok == JSON_TOKEN_VALUE) {
+            if (match == JSON_MATCH_EXACT || match == JSON_MATCH_ALL) {
+                return json_iterparse_result(self, value);
+            }
+            json_iterparse_value_done(self);
+            continue;
+        }
+        // start of a list or dict
+        if (match == JSON_MATCH_EXACT) {
+            return json_iterparse_result(self, json_parse_value(&self->s, &self->vstr, tok, value));
+        }
+        if (match == JSON_MATCH_NONE) {
+            json_skip_value(&self->s);
+            json_iterparse_value_done(self);
+            continue;
+        }
+        vstr_add_byte(&self->kinds, tok == JSON_TOKEN_LIST ? '[' : '{');
+        mp_obj_list_append(MP_OBJ_FROM_PTR(&self->path), tok == JSON_TOKEN_LIST ? MP_OBJ_NEW_SMALL_INT(0) : mp_const_none);
+        self->want_key = tok == JSON_TOKEN_DICT;
+    }
+    return MP_OBJ_STOP_ITERATION;
+}
+
+STATIC MP_DEFINE_CONST_OBJ_TYPE(
+    json_iterparse_type,
+    MP_QSTR_iterparse,
+    MP_TYPE_FLAG_ITER_IS_ITERNEXT,
+    iter, json_iterparse_iternext
+    );
+
+STATIC mp_obj_t mod_json_iterparse(size_t n_args, const mp_obj_t *args) {
+    mp_obj_tuple_t *paths = NULL;
+    if (n_args > 1 && args[1] != mp_const_none) {
+        size_t n;
+        mp_obj_t *items;
+        mp_obj_get_array(args[1], &n, &items);
+        paths = MP_OBJ_TO_PTR(mp_obj_new_tuple(n, NULL));
+        for (size_t i = 0; i < n; i++) {
+            size_t len;
+            mp_obj_t *keys;
+            mp_obj_get_array(items[i], &len, &keys);
+            paths->items[i] = mp_obj_new_tuple(len, keys);
+        }
+    }
+
+    mp_obj_json_iterparse_t *self = mp_obj_malloc(mp_obj_json_iterparse_t, &json_iterparse_type);
+    self->paths = paths;
+    vstr_init(&self->vstr, 8);
+    mp_obj_list_init(&self->path, 0);
+    vstr_init(&self->kinds, 8);
+    self->want_key = false;
+    self->done = false;
+    json_stream_init(&self->s, args[0], self->character_buffer);
+    return MP_OBJ_FROM_PTR(self);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mod_json_iterparse_obj, 1, 2, mod_json_iterparse);
+
+#endif
+
 STATIC const mp_rom_map_elem_t mp_module_json_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_json) },
     { MP_ROM_QSTR(MP_QSTR_dump), MP_ROM_PTR(&mod_json_dump_obj) },
     { MP_ROM_QSTR(MP_QSTR_dumps), MP_ROM_PTR(&mod_json_dumps_obj) },
     { MP_ROM_QSTR(MP_QSTR_load), MP_ROM_PTR(&mod_json_load_obj) },
     { MP_ROM_QSTR(MP_QSTR_loads), MP_ROM_PTR(&mod_json_loads_obj) },
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_JSON_ITERPARSE
+    { MP_ROM_QSTR(MP_QSTR_iterparse), MP_ROM_PTR(&mod_json_iterparse_obj) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_json_globals, mp_module_json_globals_table);
@@ -40,13 +40,33 @@
 #if MICROPY_PY_RE
 
 #define re1_5_stack_chk() MP_STACK_CHECK()
+// CIRCUITPY-CHANGE
+#define re1_5_alloc(size) m_malloc(size)
+#define re1_5_free(ptr, size) m_del(char, ptr, size)
 
 #include "lib/re1.5/re1.5.h"
 
 #define FLAG_DEBUG 0x1000
 
+// CIRCUITPY-CHANGE
+#if MICROPY_PY_RE_PIKEVM
+#define re1_5_exec re1_5_pikevm
+#else
+#define re1_5_exec re1_5_recursiveloopprog
+#endif
+
+#if MICROPY_ENABLE_DYNRUNTIME
+#define RE_CACHE_SIZE (0)
+#else
+#define RE_CACHE_SIZE (MICROPY_PY_RE_CACHE_SIZE)
+#endif
+
 typedef struct _mp_obj_re_t {
     mp_obj_base_t base;
+    // CIRCUITPY-CHANGE
+    #if RE_CACHE_SIZE
+    mp_obj_t pattern;
+    #endif
     ByteProg re;
 } mp_obj_re_t;
 
@@ -194,14 +214,52 @@ STATIC void re_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t
     mp_printf(print, "<re %p>", self);
 }
 
+// CIRCUITPY-CHANGE
+#if RE_CACHE_SIZE
+// The module-level functions are usually called with the same few pattern
+// literals over and over, so the compiled forms of the latest few are kept.
+STATIC mp_obj_t re_compile_cached(mp_obj_t pattern) {
+    mp_obj_t *cache = MP_STATE_VM(re_cache);
+    const mp_obj_type_t *type = mp_obj_get_type(pattern);
+    mp_obj_t found = MP_OBJ_NULL;
+    size_t i;
+    for (i = 0; i < RE_CACHE_SIZE && cache[i] != MP_OBJ_NULL; i++) {
+        mp_obj_t cached = ((mp_obj_re_t *)MP_OBJ_TO_PTR(cache[i]))->pattern;
+        if (cached == pattern || (mp_obj_get_type(cached) == type && mp_obj_equal(cached, pattern))) {
+            found = cache[i];
+            break;
+        }
+    }
+    if (found == MP_OBJ_NULL) {
+        found = mod_re_compile(1, &pattern);
+        if (i == RE_CACHE_SIZE) {
+            // Drop the least recently used.
+            i--;
+        }
+    }
+    memmove(&cache[1], &cache[0], i * sizeof(mp_obj_t));
+    cache[0] = found;
+    return found;
+}
+
+MP_REGISTER_ROOT_POINTER(mp_obj_t re_cache[MICROPY_PY_RE_CACHE_SIZE]);
+#endif
+
+STATIC mp_obj_re_t *re_get(mp_obj_t pattern) {
+    if (mp_obj_is_type(pattern, (mp_obj_type_t *)&re_type)) {
+        return MP_OBJ_TO_PTR(pattern);
+    }
+    #if RE_CACHE_SIZE
+    return MP_OBJ_TO_PTR(re_compile_cached(pattern));
+    #else
+    return MP_OBJ_TO_PTR(mod_re_compile(1, &pattern));
+    #endif
+}
+
 STATIC mp_obj_t re_exec(bool is_anchored, uint n_args, const mp_obj_t *args) {
     (void)n_args;
-    mp_obj_re_t *self;
-    if (mp_obj_is_type(args[0], (mp_obj_type_t *)&re_type)) {
-        self = MP_OBJ_TO_PTR(args[0]);
-    } else {
-        self = MP_OBJ_TO_PTR(mod_re_compile(1, args));
-    }
+    // CIRCUITPY-CHANGE
+    mp_obj_re_t *self = re_get(args[0]);
     Subject subj;
     size_t len;
     subj.begin_line = subj.begin = mp_obj_str_get_data(args[1], &len);
@@ -241,7 +299,7 @@ STATIC mp_obj_t re_exec(bool is_anchored, uint n_args, const mp_obj_t *args) {
     mp_obj_match_t *match = m_new_obj_var(mp_obj_match_t, char *, caps_num);
     // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
     memset((char *)match->caps, 0, caps_num * sizeof(char *));
-    int res = re1_5_recursiveloopprog(&self->re, &subj, match->caps, caps_num, is_anchored);
+    int res = re1_5_exec(&self->re, &subj, match->caps, caps_num, is_anchored);
     if (res == 0) {
         m_del_var(mp_obj_match_t, char *, caps_num, match);
         return mp_const_none;
@@ -282,7 +340,7 @@ STATIC mp_obj_t re_split(size_t n_args, const mp_obj_t *args) {
     while (true) {
         // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
         memset((char **)caps, 0, caps_num * sizeof(char *));
-        int res = re1_5_recursiveloopprog(&self->re, &subj, caps, caps_num, false);
+        int res = re1_5_exec(&self->re, &subj, caps, caps_num, false);
 
         // if we didn't have a match, or had an empty match, it's time to stop
         if (!res || caps[0] == caps[1]) {
@@ -311,12 +369,8 @@ MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(re_split_obj, 2, 3, re_split);
 #if MICROPY_PY_RE_SUB
 
 STATIC mp_obj_t re_sub_helper(size_t n_args, const mp_obj_t *args) {
-    mp_obj_re_t *self;
-    if (mp_obj_is_type(args[0], (mp_obj_type_t *)&re_type)) {
-        self = MP_OBJ_TO_PTR(args[0]);
-    } else {
-        self = MP_OBJ_TO_PTR(mod_re_compile(1, args));
-    }
+    // CIRCUITPY-CHANGE
+    mp_obj_re_t *self = re_get(args[0]);
     mp_obj_t replace = args[1];
     mp_obj_t where = args[2];
     mp_int_t count = 0;
@@ -342,7 +396,7 @@ STATIC mp_obj_t re_sub_helper(size_t n_args, const mp_obj_t *args) {
     for (;;) {
         // cast is a workaround for a bug in msvc: it treats const char** as a const pointer instead of a pointer to pointer to const char
         memset((char *)match->caps, 0, caps_num * sizeof(char *));
-        int res = re1_5_recursiveloopprog(&self->re, &subj, match->caps, caps_num, false);
+        int res = re1_5_exec(&self->re, &subj, match->caps, caps_num, false);
 
         // If we didn't have a match, or had an empty match, it's time to stop
         if (!res || match->caps[0] == match->caps[1]) {
@@ -466,6 +520,10 @@ STATIC mp_obj_t mod_re_compile(size_t n_args, const mp_obj_t *args) {
         flags = mp_obj_get_int(args[1]);
     }
     #endif
+    // CIRCUITPY-CHANGE
+    #if RE_CACHE_SIZE
+    o->pattern = args[0];
+    #endif
     int error = re1_5_compilecode(&o->re, re_str);
     if (error != 0) {
     error:
@@ -510,7 +568,12 @@ MP_REGISTER_EXTENSIBLE_MODULE(MP_QSTR_re, mp_module_re);
 #define re1_5_fatal(x) assert(!x)
 
 #include "lib/re1.5/compilecode.c"
+// CIRCUITPY-CHANGE
+#if MICROPY_PY_RE_PIKEVM
+#include "lib/re1.5/pike.c"
+#else
 #include "lib/re1.5/recursiveloop.c"
+#endif
 #include "lib/re1.5/charclass.c"
 
 #if MICROPY_PY_RE_DEBUG
@@ -80,6 +80,14 @@ typedef struct _poll_obj_t {
     mp_uint_t events;
     mp_uint_t revents;
     #endif
+    #if MICROPY_PY_SELECT_POLL_GEN
+    // If the object provides MP_STREAM_GET_POLL_GEN then poll_gen.counter is non-NULL.
+    // While poll_gen_idle is true the object was found not ready when the counter was
+    // poll_gen_seen, so it need not be polled again until the counter changes.
+    mp_stream_poll_gen_t poll_gen;
+    mp_uint_t poll_gen_seen;
+    bool poll_gen_idle;
+    #endif
 } poll_obj_t;
 
 // A set of pollable objects.
@@ -195,6 +203,19 @@ static inline void poll_obj_set_revents(poll_obj_t *poll_obj, mp_uint_t revents)
 
 #endif
 
+#if MICROPY_PY_SELECT_POLL_GEN
+
+STATIC void poll_obj_init_poll_gen(poll_obj_t *poll_obj) {
+    poll_obj->poll_gen.counter = NULL;
+    poll_obj->poll_gen_idle = false;
+    if (poll_obj->ioctl != NULL) {
+        int errcode;
+        poll_obj->ioctl(poll_obj->obj, MP_STREAM_GET_POLL_GEN, (uintptr_t)&poll_obj->poll_gen, &errcode);
+    }
+}
+
+#endif
+
 STATIC void poll_set_add_obj(poll_set_t *poll_set, const mp_obj_t *obj, mp_uint_t obj_len, mp_uint_t events, bool or_events) {
     for (mp_uint_t i = 0; i < obj_len; i++) {
         mp_map_elem_t *elem = mp_map_lookup(&poll_set->map, mp_obj_id(obj[i]), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
@@ -238,6 +259,10 @@ STATIC void poll_set_add_obj(poll_set_t *poll_set, const mp_obj_t *obj, mp_uint_
             poll_obj->ioctl = stream_p->ioctl;
             #endif
 
+            #if MICROPY_PY_SELECT_POLL_GEN
+            poll_obj_init_poll_gen(poll_obj);
+            #endif
+
             poll_obj_set_events(poll_obj, events);
             poll_obj_set_revents(poll_obj, 0);
             elem->value = MP_OBJ_FROM_PTR(poll_obj);
@@ -252,6 +277,9 @@ STATIC void poll_set_add_obj(poll_set_t *poll_set, const mp_obj_t *obj, mp_uint_
             (void)or_events;
             #endif
             poll_obj_set_events(poll_obj, events);
+            #if MICROPY_PY_SELECT_POLL_GEN
+            poll_obj->poll_gen_idle = false;
+            #endif
         }
     }
 }
@@ -273,6 +301,17 @@ STATIC mp_uint_t poll_set_poll_once(poll_set_t *poll_set, size_t *rwx_num) {
         }
         #endif
 
+        #if MICROPY_PY_SELECT_POLL_GEN
+        mp_uint_t gen = 0;
+        if (poll_obj->poll_gen.counter != NULL) {
+            gen = *poll_obj->poll_gen.counter;
+            if (poll_obj->poll_gen_idle && gen == poll_obj->poll_gen_seen) {
+                // Not ready last time and the stream has not signalled a change since.
+                continue;
+            }
+        }
+        #endif
+
         int errcode;
         mp_int_t ret = poll_obj->ioctl(poll_obj->obj, MP_STREAM_POLL, poll_obj_get_events(poll_obj), &errcode);
         poll_obj_set_revents(poll_obj, ret);
@@ -282,6 +321,16 @@ STATIC mp_uint_t poll_set_poll_once(poll_set_t *poll_set, size_t *rwx_num) {
             mp_raise_OSError(errcode);
         }
 
+        #if MICROPY_PY_SELECT_POLL_GEN
+        if (poll_obj->poll_gen.counter != NULL) {
+            // Only a not-ready result can be remembered: a ready stream becomes not ready
+            // (eg when read) without bumping its counter, so it must be polled again.
+            mp_uint_t notified = poll_obj->poll_gen.events | MP_STREAM_POLL_ERR | MP_STREAM_POLL_HUP;
+            poll_obj->poll_gen_idle = ret == 0 && (poll_obj_get_events(poll_obj) & ~notified) == 0;
+            poll_obj->poll_gen_seen = gen;
+        }
+        #endif
+
         if (ret != 0) {
             // object is ready
             n_ready += 1;
@@ -500,7 +549,11 @@ STATIC mp_obj_t poll_modify(mp_obj_t self_in, mp_obj_t obj_in, mp_obj_t eventmas
     if (elem == NULL) {
         mp_raise_OSError(MP_ENOENT);
     }
-    poll_obj_set_events((poll_obj_t *)MP_OBJ_TO_PTR(elem->value), mp_obj_get_int(eventmask_in));
+    poll_obj_t *poll_obj = (poll_obj_t *)MP_OBJ_TO_PTR(elem->value);
+    poll_obj_set_events(poll_obj, mp_obj_get_int(eventmask_in));
+    #if MICROPY_PY_SELECT_POLL_GEN
+    poll_obj->poll_gen_idle = false;
+    #endif
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_3(poll_modify_obj, poll_modify);
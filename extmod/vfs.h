@@ -58,6 +58,8 @@
 #define MP_BLOCKDEV_IOCTL_BLOCK_COUNT   (4)
 #define MP_BLOCKDEV_IOCTL_BLOCK_SIZE    (5)
 #define MP_BLOCKDEV_IOCTL_BLOCK_ERASE   (6)
+// CIRCUITPY-CHANGE: native block devices only; returns the memory-mapped address of a block
+#define MP_BLOCKDEV_IOCTL_XIP_ADDR      (7)
 
 
 // At the moment the VFS protocol just has import_stat, but could be extended to other methods
@@ -103,9 +105,14 @@ mp_obj_t mp_vfs_ilistdir_it_iternext(mp_obj_t self_in);
 void mp_vfs_blockdev_init(mp_vfs_blockdev_t *self, mp_obj_t bdev);
 int mp_vfs_blockdev_read(mp_vfs_blockdev_t *self, size_t block_num, size_t num_blocks, uint8_t *buf);
 int mp_vfs_blockdev_read_ext(mp_vfs_blockdev_t *self, size_t block_num, size_t block_off, size_t len, uint8_t *buf);
+// CIRCUITPY-CHANGE: Incremented by every block write, on any filesystem.
+extern uint32_t mp_vfs_blockdev_write_count;
 int mp_vfs_blockdev_write(mp_vfs_blockdev_t *self, size_t block_num, size_t num_blocks, const uint8_t *buf);
 int mp_vfs_blockdev_write_ext(mp_vfs_blockdev_t *self, size_t block_num, size_t block_off, size_t len, const uint8_t *buf);
 mp_obj_t mp_vfs_blockdev_ioctl(mp_vfs_blockdev_t *self, uintptr_t cmd, uintptr_t arg);
+#if MICROPY_VFS_XIP
+const uint8_t *mp_vfs_blockdev_get_xip_addr(mp_vfs_blockdev_t *self, size_t block_num);
+#endif
 
 mp_vfs_mount_t *mp_vfs_lookup_path(const char *path, const char **path_out);
 mp_import_stat_t mp_vfs_import_stat(const char *path);
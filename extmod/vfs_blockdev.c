@@ -36,6 +36,9 @@
 #if CIRCUITPY_SDIOIO
 #include "shared-bindings/sdioio/SDCard.h"
 #endif
+#if CIRCUITPY_PYUSB
+#include "shared-bindings/usb/msc/BlockDevice.h"
+#endif
 
 
 #if MICROPY_VFS
@@ -60,6 +63,21 @@ void mp_vfs_blockdev_init(mp_vfs_blockdev_t *self, mp_obj_t bdev) {
         self->u.ioctl[2] = (mp_obj_t)sdcardio_sdcard_ioctl; // native version
     }
     #endif
+    // CIRCUITPY-CHANGE: Support native USB mass storage devices.
+    #if CIRCUITPY_PYUSB
+    if (mp_obj_get_type(bdev) == &usb_msc_blockdevice_type) {
+        self->flags |= MP_BLOCKDEV_FLAG_NATIVE | MP_BLOCKDEV_FLAG_HAVE_IOCTL;
+        self->readblocks[0] = mp_const_none;
+        self->readblocks[1] = bdev;
+        self->readblocks[2] = (mp_obj_t)usb_msc_blockdevice_readblocks; // native version
+        self->writeblocks[0] = mp_const_none;
+        self->writeblocks[1] = bdev;
+        self->writeblocks[2] = (mp_obj_t)usb_msc_blockdevice_writeblocks; // native version
+        self->u.ioctl[0] = mp_const_none;
+        self->u.ioctl[1] = bdev;
+        self->u.ioctl[2] = (mp_obj_t)usb_msc_blockdevice_ioctl; // native version
+    }
+    #endif
     #if CIRCUITPY_SDIOIO
     if (mp_obj_get_type(bdev) == &sdioio_SDCard_type) {
         // TODO: Enable native blockdev for SDIO too.
@@ -104,11 +122,16 @@ int mp_vfs_blockdev_read_ext(mp_vfs_blockdev_t *self, size_t block_num, size_t b
     }
 }
 
+// CIRCUITPY-CHANGE: Count writes so copies of file contents can tell when they are stale.
+uint32_t mp_vfs_blockdev_write_count;
+
 int mp_vfs_blockdev_write(mp_vfs_blockdev_t *self, size_t block_num, size_t num_blocks, const uint8_t *buf) {
     if (self->writeblocks[0] == MP_OBJ_NULL) {
         // read-only block device
         return -MP_EROFS;
     }
+    // CIRCUITPY-CHANGE
+    mp_vfs_blockdev_write_count++;
 
     if (self->flags & MP_BLOCKDEV_FLAG_NATIVE) {
         // CIRCUITPY-CHANGE: Pass the blockdev object into native readblocks so
@@ -130,6 +153,8 @@ int mp_vfs_blockdev_write_ext(mp_vfs_blockdev_t *self, size_t block_num, size_t
         // read-only block device
         return -MP_EROFS;
     }
+    // CIRCUITPY-CHANGE
+    mp_vfs_blockdev_write_count++;
 
     mp_obj_array_t ar = {{&mp_type_bytearray}, BYTEARRAY_TYPECODE, 0, len, (void *)buf};
     self->writeblocks[2] = MP_OBJ_NEW_SMALL_INT(block_num);
@@ -183,4 +208,21 @@ mp_obj_t mp_vfs_blockdev_ioctl(mp_vfs_blockdev_t *self, uintptr_t cmd, uintptr_t
     }
 }
 
+#if MICROPY_VFS_XIP
+// Returns the address at which the given block, and the ones following it, can
+// be read directly, or NULL.  Only native block devices can provide this.
+const uint8_t *mp_vfs_blockdev_get_xip_addr(mp_vfs_blockdev_t *self, size_t block_num) {
+    const uint16_t flags = MP_BLOCKDEV_FLAG_NATIVE | MP_BLOCKDEV_FLAG_HAVE_IOCTL;
+    if ((self->flags & flags) != flags) {
+        return NULL;
+    }
+    size_t out_value;
+    bool (*f)(mp_obj_t self, uint32_t, uint32_t, size_t *) = (void *)(uintptr_t)self->u.ioctl[2];
+    if (!f(self->u.ioctl[1], MP_BLOCKDEV_IOCTL_XIP_ADDR, block_num, &out_value)) {
+        return NULL;
+    }
+    return (const uint8_t *)out_value;
+}
+#endif
+
 #endif // MICROPY_VFS
@@ -52,4 +52,9 @@ typedef struct _pyb_file_obj_t {
     FIL fp;
 } pyb_file_obj_t;
 
+// CIRCUITPY-CHANGE: Files opened read-only get a cluster link map when opened.
+// Readers that seek a lot call this to make sure they have one. Returns false
+// if the file is writable or there isn't room for the map.
+bool fat_file_enable_fast_seek(pyb_file_obj_t *self);
+
 #endif  // MICROPY_INCLUDED_EXTMOD_VFS_FAT_H
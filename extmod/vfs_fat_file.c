@@ -93,6 +93,62 @@ STATIC mp_uint_t file_obj_write(mp_obj_t self_in, const void *buf, mp_uint_t siz
     return sz_out;
 }
 
+// CIRCUITPY-CHANGE: Build a cluster link map so a seek finds its cluster
+// without walking the FAT chain from the start of the file. FatFS can't grow a
+// file in fast seek mode, so only read-only files get one.
+bool fat_file_enable_fast_seek(pyb_file_obj_t *self) {
+    FIL *fp = &self->fp;
+    if (fp->cltbl != NULL) {
+        return true;
+    }
+    if (fp->flag & FA_WRITE) {
+        return false;
+    }
+    // One call to determine how much space we need.
+    DWORD temp_table[2] = {MP_ARRAY_SIZE(temp_table)};
+    fp->cltbl = temp_table;
+    f_lseek(fp, CREATE_LINKMAP);
+    DWORD size = temp_table[0];
+
+    // Now allocate the size and construct the map.
+    DWORD *table = m_malloc_maybe(size * sizeof(DWORD));
+    fp->cltbl = table;
+    if (table == NULL) {
+        return false;
+    }
+    table[0] = size;
+    if (f_lseek(fp, CREATE_LINKMAP) != FR_OK) {
+        fp->cltbl = NULL;
+        m_del(DWORD, table, size);
+        return false;
+    }
+    return true;
+}
+
+#if MICROPY_VFS_XIP
+// A file opened read-only whose clusters form a single run can be read in place
+// if the underlying block device is memory mapped.
+STATIC const byte *file_obj_get_xip_addr(pyb_file_obj_t *self) {
+    FIL *fp = &self->fp;
+    if ((fp->flag & FA_WRITE) || f_size(fp) == 0) {
+        return NULL;
+    }
+    // Room for exactly one fragment: fails with FR_NOT_ENOUGH_CORE otherwise.
+    DWORD tbl[4] = {MP_ARRAY_SIZE(tbl)};
+    DWORD *fast_seek_table = fp->cltbl;
+    fp->cltbl = tbl;
+    FRESULT res = f_lseek(fp, CREATE_LINKMAP);
+    fp->cltbl = fast_seek_table;
+    if (res != FR_OK) {
+        return NULL;
+    }
+    FATFS *fs = fp->obj.fs;
+    DWORD sect = fs->database + (DWORD)fs->csize * (tbl[2] - 2);
+    fs_user_mount_t *vfs = fs->drv;
+    return mp_vfs_blockdev_get_xip_addr(&vfs->blockdev, sect);
+}
+#endif
+
 STATIC mp_uint_t file_obj_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg, int *errcode) {
     pyb_file_obj_t *self = MP_OBJ_TO_PTR(o_in);
 
@@ -135,6 +191,17 @@ STATIC mp_uint_t file_obj_ioctl(mp_obj_t o_in, mp_uint_t request, uintptr_t arg,
         }
         return 0;
 
+    #if MICROPY_VFS_XIP
+    } else if (request == MP_STREAM_GET_XIP_ADDR) {
+        const byte *addr = file_obj_get_xip_addr(self);
+        if (addr == NULL) {
+            *errcode = MP_EINVAL;
+            return MP_STREAM_ERROR;
+        }
+        *(const byte **)arg = addr;
+        return f_size(&self->fp);
+    #endif
+
     } else {
         *errcode = MP_EINVAL;
         return MP_STREAM_ERROR;
@@ -260,22 +327,7 @@ STATIC mp_obj_t fat_vfs_open(mp_obj_t self_in, mp_obj_t path_in, mp_obj_t mode_i
     // CIRCUITPY-CHANGE: does fast seek.
     // If we're reading, turn on fast seek.
     if (mode == FA_READ) {
-        // One call to determine how much space we need.
-        DWORD temp_table[2];
-        temp_table[0] = 2;
-        o->fp.cltbl = temp_table;
-        f_lseek(&o->fp, CREATE_LINKMAP);
-        DWORD size = (temp_table[0] + 1) * 2;
-
-        // Now allocate the size and construct the map.
-        o->fp.cltbl = m_malloc_maybe(size * sizeof(DWORD));
-        if (o->fp.cltbl != NULL) {
-            o->fp.cltbl[0] = size;
-            res = f_lseek(&o->fp, CREATE_LINKMAP);
-            if (res != FR_OK) {
-                o->fp.cltbl = NULL;
-            }
-        }
+        fat_file_enable_fast_seek(o);
     }
 
     // for 'a' mode, we must begin at the end of the file
@@ -33,6 +33,10 @@
 #include "extmod/vfs.h"
 #include "extmod/vfs_lfs.h"
 
+#if CIRCUITPY_FILESYSTEM_LFS && CIRCUITPY_RTC
+#include "shared-bindings/rtc/RTC.h"
+#endif
+
 enum { LFS_MAKE_ARG_bdev, LFS_MAKE_ARG_readsize, LFS_MAKE_ARG_progsize, LFS_MAKE_ARG_lookahead, LFS_MAKE_ARG_mtime };
 
 static const mp_arg_t lfs_make_allowed_args[] = {
@@ -105,14 +109,7 @@ mp_obj_t mp_vfs_lfs1_file_open(mp_obj_t self_in, mp_obj_t path_in, mp_obj_t mode
 // Attribute ids for lfs2_attr.type.
 #define LFS_ATTR_MTIME (1) // 64-bit little endian, nanoseconds since 1970/1/1
 
-typedef struct _mp_obj_vfs_lfs2_t {
-    mp_obj_base_t base;
-    mp_vfs_blockdev_t blockdev;
-    bool enable_mtime;
-    vstr_t cur_dir;
-    struct lfs2_config config;
-    lfs2_t lfs;
-} mp_obj_vfs_lfs2_t;
+// CIRCUITPY-CHANGE: mp_obj_vfs_lfs2_t is in vfs_lfs.h so the supervisor can mount CIRCUITPY.
 
 typedef struct _mp_obj_vfs_lfs2_file_t {
     mp_obj_base_t base;
@@ -129,7 +126,19 @@ mp_obj_t mp_vfs_lfs2_file_open(mp_obj_t self_in, mp_obj_t path_in, mp_obj_t mode
 
 STATIC void lfs_get_mtime(uint8_t buf[8]) {
     // On-disk storage of timestamps uses 1970 as the Epoch, so convert from host's Epoch.
+    #if CIRCUITPY_FILESYSTEM_LFS
+    // CIRCUITPY-CHANGE: Ports don't provide mp_hal_time_ns(), so stamp files
+    // from the RTC the same way FAT timestamps are made.
+    uint64_t ns = 0;
+    #if CIRCUITPY_RTC
+    timeutils_struct_time_t tm;
+    common_hal_rtc_get_time(&tm);
+    uint64_t seconds = timeutils_seconds_since_2000(tm.tm_year, tm.tm_mon, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+    ns = (seconds + TIMEUTILS_SECONDS_1970_TO_2000) * 1000000000ULL;
+    #endif
+    #else
     uint64_t ns = timeutils_nanoseconds_since_epoch_to_nanoseconds_since_1970(mp_hal_time_ns());
+    #endif
     // Store "ns" to "buf" in little-endian format (essentially htole64).
     for (size_t i = 0; i < 8; ++i) {
         buf[i] = ns;
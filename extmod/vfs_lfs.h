@@ -36,4 +36,20 @@ extern const mp_obj_type_t mp_type_vfs_lfs2;
 extern const mp_obj_type_t mp_type_vfs_lfs2_fileio;
 extern const mp_obj_type_t mp_type_vfs_lfs2_textio;
 
+// CIRCUITPY-CHANGE: Expose the object so CIRCUITPY itself can be littlefs.
+// The supervisor mounts it before the VM heap exists.
+#if MICROPY_VFS_LFS2
+#include "extmod/vfs.h"
+#include "lib/littlefs/lfs2.h"
+
+typedef struct _mp_obj_vfs_lfs2_t {
+    mp_obj_base_t base;
+    mp_vfs_blockdev_t blockdev;
+    bool enable_mtime;
+    vstr_t cur_dir;
+    struct lfs2_config config;
+    lfs2_t lfs;
+} mp_obj_vfs_lfs2_t;
+#endif
+
 #endif // MICROPY_INCLUDED_EXTMOD_VFS_LFS_H
@@ -46,6 +46,33 @@ typedef struct _mp_obj_vfs_posix_file_t {
     int fd;
 } mp_obj_vfs_posix_file_t;
 
+// CIRCUITPY-CHANGE: lets a port send sys.stdin, sys.stdout and sys.stderr to
+// other fds, eg a different set for each thread. Files the script opened
+// itself keep their own fd, even when it is 0, 1 or 2.
+#ifdef mp_hal_stdio_fd
+extern const mp_obj_vfs_posix_file_t mp_sys_stdin_obj;
+extern const mp_obj_vfs_posix_file_t mp_sys_stdout_obj;
+extern const mp_obj_vfs_posix_file_t mp_sys_stderr_obj;
+#if MICROPY_PY_SYS_STDIO_BUFFER
+extern const mp_obj_vfs_posix_file_t mp_sys_stdin_buffer_obj;
+extern const mp_obj_vfs_posix_file_t mp_sys_stdout_buffer_obj;
+extern const mp_obj_vfs_posix_file_t mp_sys_stderr_buffer_obj;
+#endif
+
+STATIC int vfs_posix_file_fd(const mp_obj_vfs_posix_file_t *o) {
+    if (o == &mp_sys_stdin_obj || o == &mp_sys_stdout_obj || o == &mp_sys_stderr_obj
+        #if MICROPY_PY_SYS_STDIO_BUFFER
+        || o == &mp_sys_stdin_buffer_obj || o == &mp_sys_stdout_buffer_obj || o == &mp_sys_stderr_buffer_obj
+        #endif
+        ) {
+        return mp_hal_stdio_fd(o->fd);
+    }
+    return o->fd;
+}
+#else
+#define vfs_posix_file_fd(o) ((o)->fd)
+#endif
+
 #if MICROPY_CPYTHON_COMPAT
 STATIC void check_fd_is_open(const mp_obj_vfs_posix_file_t *o) {
     if (o->fd < 0) {
@@ -119,7 +146,8 @@ STATIC mp_uint_t vfs_posix_file_read(mp_obj_t o_in, void *buf, mp_uint_t size, i
     mp_obj_vfs_posix_file_t *o = MP_OBJ_TO_PTR(o_in);
     check_fd_is_open(o);
     ssize_t r;
-    MP_HAL_RETRY_SYSCALL(r, read(o->fd, buf, size), {
+    // CIRCUITPY-CHANGE: the port may redirect the standard streams
+    MP_HAL_RETRY_SYSCALL(r, read(vfs_posix_file_fd(o), buf, size), {
         *errcode = err;
         return MP_STREAM_ERROR;
     });
@@ -136,7 +164,8 @@ STATIC mp_uint_t vfs_posix_file_write(mp_obj_t o_in, const void *buf, mp_uint_t
     }
     #endif
     ssize_t r;
-    MP_HAL_RETRY_SYSCALL(r, write(o->fd, buf, size), {
+    // CIRCUITPY-CHANGE: the port may redirect the standard streams
+    MP_HAL_RETRY_SYSCALL(r, write(vfs_posix_file_fd(o), buf, size), {
         *errcode = err;
         return MP_STREAM_ERROR;
     });
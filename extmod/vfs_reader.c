@@ -77,6 +77,22 @@ void mp_reader_new_file(mp_reader_t *reader, const char *filename) {
     };
     rf->file = mp_vfs_open(MP_ARRAY_SIZE(args), &args[0], (mp_map_t *)&mp_const_empty_map);
     int errcode;
+    #if MICROPY_PERSISTENT_CODE_LOAD_XIP
+    {
+        // If the file is memory mapped then read it from there, which also lets
+        // loaded code refer to it in place.
+        const mp_stream_p_t *stream_p = mp_get_stream(rf->file);
+        const byte *addr = NULL;
+        mp_uint_t len = stream_p->ioctl == NULL ? MP_STREAM_ERROR
+            : stream_p->ioctl(rf->file, MP_STREAM_GET_XIP_ADDR, (uintptr_t)&addr, &errcode);
+        if (len != MP_STREAM_ERROR && addr != NULL) {
+            mp_stream_close(rf->file);
+            m_del_obj(mp_reader_vfs_t, rf);
+            mp_reader_new_mem(reader, addr, len, 0);
+            return;
+        }
+    }
+    #endif
     rf->len = mp_stream_rw(rf->file, rf->buf, sizeof(rf->buf), &errcode, MP_STREAM_RW_READ | MP_STREAM_RW_ONCE);
     if (errcode != 0) {
         mp_raise_OSError(errcode);
@@ -1617,6 +1617,36 @@ static DWORD clmt_clust (   /* <2:Error, >=2:Cluster number */
 #endif  /* FF_USE_FASTSEEK */
 
 
+// CIRCUITPY-CHANGE: Count how many of the clusters after clst follow it
+// contiguously on the disk, up to max. f_read() uses this to read across
+// cluster boundaries with a single disk_read().
+static DWORD contiguous_clusters (
+    FIL* fp,        /* Pointer to the file object */
+    DWORD clst,     /* Cluster to start from */
+    DWORD max       /* Most clusters wanted */
+)
+{
+    DWORD n = 0;
+#if FF_USE_FASTSEEK
+    if (fp->cltbl) {    /* The link map already knows the fragments */
+        DWORD ncl, top, *tbl = fp->cltbl + 1;
+        while ((ncl = *tbl++) != 0) {
+            top = *tbl++;
+            if (clst >= top && clst - top < ncl) {
+                n = top + ncl - 1 - clst;
+                break;
+            }
+        }
+        return (n < max) ? n : max;
+    }
+#endif
+    while (n < max && get_fat(&fp->obj, clst + n) == clst + n + 1) {
+        n++;
+    }
+    return n;
+}
+
+
 
 
 /*-----------------------------------------------------------------------*/
@@ -3672,10 +3702,16 @@ FRESULT f_read (
             sect += csect;
             cc = btr / SS(fs);                  /* When remaining bytes >= sector size, */
             if (cc > 0) {                       /* Read maximum contiguous sectors directly */
-                if (csect + cc > fs->csize) {   /* Clip at cluster boundary */
-                    cc = fs->csize - csect;
+                if (csect + cc > fs->csize) {   /* Clip at the end of the contiguous clusters */
+                    // CIRCUITPY-CHANGE: Read through following clusters that are
+                    // next to each other on the disk instead of stopping at each one.
+                    DWORD ncl = 1 + contiguous_clusters(fp, fp->clust, (csect + cc - 1) / fs->csize);
+                    if (csect + cc > fs->csize * ncl) {
+                        cc = fs->csize * ncl - csect;
+                    }
                 }
                 if (disk_read(fs->drv, rbuff, sect, cc) != RES_OK) ABORT(fs, FR_DISK_ERR);
+                fp->clust += (csect + cc - 1) / fs->csize;  /* Cluster of the last sector read */
 #if !FF_FS_READONLY && FF_FS_MINIMIZE <= 2      /* Replace one of the read sectors with cached data if it contains a dirty sector */
 #if FF_FS_TINY
                 if (fs->wflag && fs->winsect - sect < cc) {
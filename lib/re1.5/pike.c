@@ -0,0 +1,160 @@
+// Copyright 2007-2009 Russ Cox.  All Rights Reserved.
+// Copyright 2014 Paul Sokolovsky.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#include "re1.5.h"
+
+// Pike VM: every thread takes a step for each input character, so the time is
+// bounded by input length times program length, however the pattern is
+// nested. Threads are kept in priority order and a lower priority thread
+// never replaces one already on a list, so the match found is the same one
+// recursiveloop() would find.
+
+typedef struct {
+	int n;
+	char **pc;
+	const char **sub; // nsubp captures for each thread
+} Threadlist;
+
+typedef struct {
+	ByteProg *prog;
+	Subject *input;
+	int nsubp;
+	int *marks; // generation that each instruction was last added in
+	int gen;
+} Pikestate;
+
+static void
+addthread(Pikestate *st, Threadlist *l, char *pc, const char **sub, const char *sp)
+{
+	const char *old;
+	int off;
+
+	re1_5_stack_chk();
+
+	if(st->marks[pc - st->prog->insts] == st->gen)
+		return;
+	st->marks[pc - st->prog->insts] = st->gen;
+
+	switch(*pc) {
+	case Jmp:
+		off = (signed char)pc[1];
+		addthread(st, l, pc + 2 + off, sub, sp);
+		return;
+	case Split:
+		off = (signed char)pc[1];
+		addthread(st, l, pc + 2, sub, sp);
+		addthread(st, l, pc + 2 + off, sub, sp);
+		return;
+	case RSplit:
+		off = (signed char)pc[1];
+		addthread(st, l, pc + 2 + off, sub, sp);
+		addthread(st, l, pc + 2, sub, sp);
+		return;
+	case Save:
+		off = (unsigned char)pc[1];
+		if(off >= st->nsubp) {
+			addthread(st, l, pc + 2, sub, sp);
+			return;
+		}
+		old = sub[off];
+		sub[off] = sp;
+		addthread(st, l, pc + 2, sub, sp);
+		sub[off] = old;
+		return;
+	case Bol:
+		if(sp == st->input->begin_line)
+			addthread(st, l, pc + 1, sub, sp);
+		return;
+	case Eol:
+		if(sp == st->input->end)
+			addthread(st, l, pc + 1, sub, sp);
+		return;
+	}
+	// A consumer or Match waits here for the next step.
+	l->pc[l->n] = pc;
+	memcpy((char*)&l->sub[l->n * st->nsubp], sub, st->nsubp * sizeof(char*));
+	l->n++;
+}
+
+int
+re1_5_pikevm(ByteProg *prog, Subject *input, const char **subp, int nsubp, int is_anchored)
+{
+	// Only consumers and Match go on a list, and each at most once, so
+	// every list fits one thread per instruction.
+	int slots = prog->len;
+	size_t size = prog->bytelen * sizeof(int)
+		+ 2 * slots * sizeof(char*)
+		+ (2 * slots + 1) * nsubp * sizeof(char*);
+	char *mem = re1_5_alloc(size);
+	Threadlist lists[2];
+	Threadlist *clist = &lists[0], *nlist = &lists[1], *tmp;
+	Pikestate st = { prog, input, nsubp, (int*)mem, 0 };
+	const char **sub;
+	const char *sp;
+	char *pc, *next;
+	int i, matched = 0;
+
+	memset(st.marks, 0, prog->bytelen * sizeof(int));
+	lists[0].pc = (char**)(mem + prog->bytelen * sizeof(int));
+	lists[1].pc = lists[0].pc + slots;
+	lists[0].sub = (const char**)(lists[1].pc + slots);
+	lists[1].sub = lists[0].sub + slots * nsubp;
+	sub = lists[1].sub + slots * nsubp;
+	memcpy((char*)sub, subp, nsubp * sizeof(char*));
+
+	st.gen = 1;
+	clist->n = 0;
+	addthread(&st, clist, HANDLE_ANCHORED(prog->insts, is_anchored), sub, input->begin);
+
+	for(sp = input->begin; clist->n > 0; sp++) {
+		st.gen++;
+		nlist->n = 0;
+		for(i = 0; i < clist->n; i++) {
+			pc = clist->pc[i];
+			sub = &clist->sub[i * nsubp];
+			if(*pc == Match) {
+				// Threads after this one have lower priority, so drop them.
+				memcpy((char*)subp, sub, nsubp * sizeof(char*));
+				matched = 1;
+				break;
+			}
+			if(sp >= input->end)
+				continue;
+			switch(*pc) {
+			case Char:
+				if(*sp != pc[1])
+					continue;
+				next = pc + 2;
+				break;
+			case Any:
+				next = pc + 1;
+				break;
+			case Class:
+			case ClassNot:
+				if(!_re1_5_classmatch(pc + 1, sp))
+					continue;
+				next = pc + 1 + *(unsigned char*)(pc + 1) * 2 + 1;
+				break;
+			case NamedClass:
+				if(!_re1_5_namedclassmatch(pc + 1, sp))
+					continue;
+				next = pc + 2;
+				break;
+			default:
+				re1_5_fatal("pikevm");
+				continue;
+			}
+			addthread(&st, nlist, next, sub, sp + 1);
+		}
+		tmp = clist;
+		clist = nlist;
+		nlist = tmp;
+		if(sp >= input->end)
+			break;
+	}
+
+	re1_5_free(mem, size);
+	return matched;
+}
@@ -53,6 +53,13 @@ void re1_5_fatal(char*);
 #ifndef re1_5_stack_chk
 #define re1_5_stack_chk()
 #endif
+// CIRCUITPY-CHANGE: working memory for re1_5_pikevm()
+#ifndef re1_5_alloc
+#define re1_5_alloc(size) malloc(size)
+#endif
+#ifndef re1_5_free
+#define re1_5_free(ptr, size) free(ptr)
+#endif
 void *mal(int);
 
 struct Prog
@@ -700,12 +700,14 @@ static void block_idct (
 /*-----------------------------------------------------------------------*/
 
 static JRESULT mcu_load (
-	JDEC* jd		/* Pointer to the decompressor object */
+	JDEC* jd,		/* Pointer to the decompressor object */
+	int discard		/* CIRCUITPY-CHANGE: Only advance the stream, the MCU will not be output */
 )
 {
 	int32_t *tmp = (int32_t*)jd->workbuf;	/* Block working buffer for de-quantize and IDCT */
 	int d, e;
 	unsigned int blk, nby, i, bc, z, id, cmp;
+	int dc_only;
 	jd_yuv_t *bp;
 	const int32_t *dqf;
 
@@ -721,6 +723,8 @@ static JRESULT mcu_load (
 
 		} else {							/* Load Y/C blocks from input stream */
 			id = cmp ? 1 : 0;						/* Huffman table ID of this component */
+			/* CIRCUITPY-CHANGE: AC elements are not needed for a discarded MCU or at 1/8 scale */
+			dc_only = discard || (JD_USE_SCALE && jd->scale == 3);
 
 			/* Extract a DC element from input stream */
 			d = huffext(jd, id, 0);					/* Extract a huffman coded data (bit length) */
@@ -739,7 +743,7 @@ static JRESULT mcu_load (
 			tmp[0] = d * dqf[0] >> 8;				/* De-quantize, apply scale factor of Arai algorithm and descale 8 bits */
 
 			/* Extract following 63 AC elements from input stream */
-			memset(&tmp[1], 0, 63 * sizeof (int32_t));	/* Initialize all AC elements */
+			if (!dc_only) memset(&tmp[1], 0, 63 * sizeof (int32_t));	/* Initialize all AC elements */
 			z = 1;		/* Top of the AC elements (in zigzag-order) */
 			do {
 				d = huffext(jd, id, 1);				/* Extract a huffman coded value (zero runs and bit length) */
@@ -751,6 +755,7 @@ static JRESULT mcu_load (
 				if (bc &= 0x0F) {					/* Bit length? */
 					d = bitext(jd, bc);				/* Extract data bits */
 					if (d < 0) return (JRESULT)(0 - d);	/* Err: input device */
+					if (dc_only) continue;			/* CIRCUITPY-CHANGE: The value is not used */
 					bc = 1 << (bc - 1);				/* MSB position */
 					if (!(d & bc)) d -= (bc << 1) - 1;	/* Restore negative value if needed */
 					i = Zig[z];						/* Get raster-order index */
@@ -758,8 +763,12 @@ static JRESULT mcu_load (
 				}
 			} while (++z < 64);		/* Next AC element */
 
-			if (JD_FORMAT != 2 || !cmp) {	/* C components may not be processed if in grayscale output */
-				if (z == 1 || (JD_USE_SCALE && jd->scale == 3)) {	/* If no AC element or scale ratio is 1/8, IDCT can be ommited and the block is filled with DC value */
+			if (discard) {
+				/* CIRCUITPY-CHANGE: Nothing to store */
+			} else if (JD_FORMAT != 2 || !cmp) {	/* C components may not be processed if in grayscale output */
+				if (JD_USE_SCALE && jd->scale == 3) {	/* CIRCUITPY-CHANGE: Only the DC value of each block is used at 1/8 scale */
+					bp[0] = (jd_yuv_t)((*tmp / 256) + 128);
+				} else if (z == 1) {	/* If no AC element or scale ratio is 1/8, IDCT can be ommited and the block is filled with DC value */
 					d = (jd_yuv_t)((*tmp / 256) + 128);
 					if (JD_FASTDECODE >= 1) {
 						for (i = 0; i < 64; bp[i++] = d) ;
@@ -1088,6 +1097,10 @@ JRESULT jd_prepare (
 			}
 			jd->dptr = seg + ofs - (JD_FASTDECODE ? 0 : 1);
 
+			/* CIRCUITPY-CHANGE: Output the whole image unless the caller narrows it */
+			jd->roi.left = 0; jd->roi.right = jd->width - 1;
+			jd->roi.top = 0; jd->roi.bottom = jd->height - 1;
+
 			return JDR_OK;		/* Initialization succeeded. Ready to decompress the JPEG image. */
 
 		case 0xC1:	/* SOF1 */
@@ -1115,6 +1128,72 @@ JRESULT jd_prepare (
 
 
 
+/*-----------------------------------------------------------------------*/
+/* CIRCUITPY-CHANGE: Region of interest                                  */
+/*-----------------------------------------------------------------------*/
+
+static int mcu_in_roi (	/* 1:MCU overlaps the ROI, 0:MCU is not output */
+	JDEC* jd,			/* Pointer to the decompressor object */
+	unsigned int x,		/* MCU location in the image */
+	unsigned int y
+)
+{
+	return x <= jd->roi.right && x + jd->msx * 8 > jd->roi.left
+		&& y <= jd->roi.bottom && y + jd->msy * 8 > jd->roi.top;
+}
+
+
+static int interval_in_roi (	/* 1:Some MCU of the restart interval starting at x, y is output */
+	JDEC* jd,			/* Pointer to the decompressor object */
+	unsigned int x,		/* Location of the first MCU of the interval */
+	unsigned int y
+)
+{
+	unsigned int n;
+
+
+	for (n = jd->nrst; n && y < jd->height; n--) {
+		if (mcu_in_roi(jd, x, y)) return 1;
+		x += jd->msx * 8;
+		if (x >= jd->width) {
+			x = 0; y += jd->msy * 8;
+		}
+	}
+	return 0;
+}
+
+
+#if JD_FASTDECODE >= 1
+static JRESULT skip_interval (	/* Scan forward to the marker that ends this restart interval */
+	JDEC* jd			/* Pointer to the decompressor object */
+)
+{
+	uint8_t *dp = jd->dptr;
+	size_t dc = jd->dctr;
+	unsigned int d, flg = 0;
+
+
+	while (!jd->marker) {	/* The bit reader may have stopped at the marker already */
+		if (!dc) {	/* Buffer empty, re-fill input buffer */
+			dp = jd->inbuf;
+			dc = jd->infunc(jd, dp, JD_SZBUF);
+			if (!dc) return JDR_INP;	/* Err: read error or wrong stream termination */
+		}
+		d = *dp++; dc--;
+		if (flg && d != 0 && d != 0xFF) {	/* Not an escape of 0xFF nor a fill byte but a marker */
+			jd->marker = d;
+		}
+		flg = (d == 0xFF);
+	}
+	jd->dptr = dp; jd->dctr = dc;
+	jd->dbit = 0;	/* Discard bits left in the working register */
+	return JDR_OK;
+}
+#endif
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Start to decompress the JPEG picture                                  */
 /*-----------------------------------------------------------------------*/
@@ -1128,6 +1207,7 @@ JRESULT jd_decomp (
 	unsigned int x, y, mx, my;
 	uint16_t rst, rsc;
 	JRESULT rc;
+	int skip = 0, in_roi;	/* CIRCUITPY-CHANGE */
 
 
 	if (scale > (JD_USE_SCALE ? 3 : 0)) return JDR_PAR;
@@ -1140,14 +1220,28 @@ JRESULT jd_decomp (
 
 	rc = JDR_OK;
 	for (y = 0; y < jd->height; y += my) {		/* Vertical loop of MCUs */
+		if (y > jd->roi.bottom) break;			/* CIRCUITPY-CHANGE: Nothing more will be output */
 		for (x = 0; x < jd->width; x += mx) {	/* Horizontal loop of MCUs */
 			if (jd->nrst && rst++ == jd->nrst) {	/* Process restart interval if enabled */
 				rc = restart(jd, rsc++);
 				if (rc != JDR_OK) return rc;
 				rst = 1;
+				skip = 0;
 			}
-			rc = mcu_load(jd);					/* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
+			/* CIRCUITPY-CHANGE: Skip over restart intervals and MCUs outside the ROI */
+			if (skip) continue;
+#if JD_FASTDECODE >= 1
+			if (jd->nrst && rst == 1 && !interval_in_roi(jd, x, y)) {
+				rc = skip_interval(jd);			/* Don't even huffman decode this interval */
+				if (rc != JDR_OK) return rc;
+				skip = 1;
+				continue;
+			}
+#endif
+			in_roi = mcu_in_roi(jd, x, y);
+			rc = mcu_load(jd, !in_roi);			/* Load an MCU (decompress huffman coded stream, dequantize and apply IDCT) */
 			if (rc != JDR_OK) return rc;
+			if (!in_roi) continue;
 			rc = mcu_output(jd, outfunc, x, y);	/* Output the MCU (YCbCr to RGB, scaling and output) */
 			if (rc != JDR_OK) return rc;
 		}
@@ -86,6 +86,7 @@ struct JDEC {
 	size_t sz_pool;				/* Size of momory pool (bytes available) */
 	size_t (*infunc)(JDEC*, uint8_t*, size_t);	/* Pointer to jpeg stream input function */
 	void* device;				/* Pointer to I/O device identifiler for the session */
+	JRECT roi;					/* CIRCUITPY-CHANGE: Part of the input image (pixel) to output; MCUs outside it are not output */
 };
 
 
@@ -30,6 +30,7 @@
 #include "supervisor/cpu.h"
 #include "supervisor/filesystem.h"
 #include "supervisor/port.h"
+#include "supervisor/shared/memory.h"
 #include "supervisor/shared/reload.h"
 #include "supervisor/shared/safe_mode.h"
 #include "supervisor/shared/serial.h"
@@ -82,6 +83,18 @@
 #include "shared-module/keypad/__init__.h"
 #endif
 
+#if CIRCUITPY_MICROCONTROLLER_CORE1
+#include "shared-module/microcontroller/Core1.h"
+#endif
+
+#if CIRCUITPY_USB_CDC
+#include "shared-module/usb_cdc/__init__.h"
+#endif
+
+#if CIRCUITPY_BOOT_TIMING
+#include "supervisor/shared/boot_timing.h"
+#endif
+
 #if CIRCUITPY_MEMORYMONITOR
 #include "shared-module/memorymonitor/__init__.h"
 #endif
@@ -106,12 +119,16 @@
 #include "shared-bindings/wifi/__init__.h"
 #endif
 
+#if CIRCUITPY_NVM && CIRCUITPY_INTERNAL_NVM_SIZE > 0
+#include "shared-module/nvm/ByteArray.h"
+#endif
+
 #if CIRCUITPY_BOOT_COUNTER
 #include "shared-bindings/nvm/ByteArray.h"
 uint8_t value_out = 0;
 #endif
 
-#if MICROPY_ENABLE_PYSTACK && CIRCUITPY_OS_GETENV
+#if CIRCUITPY_OS_GETENV
 #include "shared-module/os/__init__.h"
 #endif
 
@@ -126,6 +143,13 @@ static uint8_t *_pystack;
 
 static const char line_clear[] = "\x1b[2K\x1b[0G";
 
+#if CIRCUITPY_ALARM && CIRCUITPY_OS_GETENV
+// The file named by CIRCUITPY_WAKE_FILE when waking from a true deep sleep. It
+// runs instead of boot.py and code.py, once, so a sensor that wakes, reads
+// and sleeps again doesn't pay for the rest of startup.
+static char _wake_file[64];
+#endif
+
 #if MICROPY_ENABLE_PYSTACK || MICROPY_ENABLE_GC
 static uint8_t *_allocate_memory(safe_mode_t safe_mode, const char *env_key, size_t default_size, size_t *final_size) {
     *final_size = default_size;
@@ -347,6 +371,10 @@ static void cleanup_after_vm(mp_obj_t exception) {
     // Reset port-independent devices, like CIRCUITPY_BLEIO_HCI.
     reset_devices();
 
+    #if CIRCUITPY_NVM && CIRCUITPY_INTERNAL_NVM_SIZE > 0
+    nvm_bytearray_flush();
+    #endif
+
     #if CIRCUITPY_ATEXIT
     atexit_reset();
     #endif
@@ -373,6 +401,21 @@ static void cleanup_after_vm(mp_obj_t exception) {
     keypad_reset();
     #endif
 
+    #if CIRCUITPY_MICROCONTROLLER_CORE1
+    microcontroller_core1_reset();
+    #endif
+
+    // Natives interrupted by an exception may not have returned their scratch.
+    supervisor_scratch_reset();
+
+    #if CIRCUITPY_USB_CDC
+    usb_cdc_user_reset();
+    #endif
+
+    #if CIRCUITPY_SAMPLING_PROFILER
+    supervisor_profiling_stop();
+    #endif
+
     // Close user-initiated sockets.
     #if CIRCUITPY_SOCKETPOOL
     socketpool_user_reset();
@@ -453,8 +496,25 @@ static bool __attribute__((noinline)) run_code_py(safe_mode_t safe_mode, bool *s
         usb_setup_with_vm();
         #endif
 
+        #if CIRCUITPY_BOOT_TIMING
+        supervisor_boot_timing_mark(BOOT_PHASE_CODE_PY_START);
+        #endif
+
+        #if CIRCUITPY_ALARM && CIRCUITPY_OS_GETENV
+        if (_wake_file[0] != '\0') {
+            const char *const filenames[] = { _wake_file };
+            found_main = maybe_run_list(filenames, MP_ARRAY_SIZE(filenames));
+            if (!found_main) {
+                serial_write(_wake_file);
+                serial_write_compressed(MP_ERROR_TEXT(" not found.\n"));
+            }
+            // Later runs, such as after a reload, are ordinary ones.
+            _wake_file[0] = '\0';
+        }
+        #endif
+
         // Check if a different run file has been allocated
-        if (next_code_configuration != NULL) {
+        if (!found_main && next_code_configuration != NULL) {
             next_code_configuration->options &= ~SUPERVISOR_NEXT_CODE_OPT_NEWLY_SET;
             next_code_options = next_code_configuration->options;
             if (next_code_configuration->filename[0] != '\0') {
@@ -815,9 +875,13 @@ static void __attribute__ ((noinline)) run_boot_py(safe_mode_t safe_mode) {
     // If not in safe mode, run boot before initing USB and capture output in a file.
 
     // There is USB setup to do even if boot.py is not actually run.
-    const bool ok_to_run = filesystem_present()
+    bool ok_to_run = filesystem_present()
         && safe_mode == SAFE_MODE_NONE
         && MP_STATE_VM(vfs_mount_table) != NULL;
+    #if CIRCUITPY_ALARM && CIRCUITPY_OS_GETENV
+    // The wake file replaces boot.py too.
+    ok_to_run = ok_to_run && _wake_file[0] == '\0';
+    #endif
 
     static const char *const boot_py_filenames[] = {"boot.py", "boot.txt"};
 
@@ -854,9 +918,20 @@ static void __attribute__ ((noinline)) run_boot_py(safe_mode_t safe_mode) {
         port_boot_info();
         #endif
 
+        #if CIRCUITPY_BOOT_TIMING
+        supervisor_boot_timing_mark(BOOT_PHASE_BOOT_PY_START);
+        #endif
+
         bool found_boot = maybe_run_list(boot_py_filenames, MP_ARRAY_SIZE(boot_py_filenames));
         (void)found_boot;
 
+        #if CIRCUITPY_BOOT_TIMING
+        supervisor_boot_timing_mark(BOOT_PHASE_BOOT_PY_DONE);
+        #if CIRCUITPY_BOOT_TIMING_IN_BOOT_OUT
+        supervisor_boot_timing_print();
+        #endif
+        #endif
+
 
         #ifdef CIRCUITPY_BOOT_OUTPUT_FILE
         // Get the base filesystem.
@@ -979,7 +1054,12 @@ int __attribute__((used)) main(void) {
     // initialise the cpu and peripherals
     set_safe_mode(port_init());
 
+    #if CIRCUITPY_BOOT_TIMING
+    supervisor_boot_timing_mark(BOOT_PHASE_PORT_INIT);
+    #endif
+
     port_heap_init();
+    supervisor_scratch_init();
 
     // Turn on RX and TX LEDs if we have them.
     init_rxtx_leds();
@@ -1000,6 +1080,10 @@ int __attribute__((used)) main(void) {
         set_safe_mode(wait_for_safe_mode_reset());
     }
 
+    #if CIRCUITPY_BOOT_TIMING
+    supervisor_boot_timing_mark(BOOT_PHASE_SAFE_MODE_WAIT);
+    #endif
+
     stack_init();
 
     #if CIRCUITPY_STATUS_BAR
@@ -1027,6 +1111,10 @@ int __attribute__((used)) main(void) {
         set_safe_mode(SAFE_MODE_NO_CIRCUITPY);
     }
 
+    #if CIRCUITPY_BOOT_TIMING
+    supervisor_boot_timing_mark(BOOT_PHASE_FILESYSTEM_INIT);
+    #endif
+
     #if CIRCUITPY_ALARM
     // Record which alarm woke us up, if any.
     // common_hal_alarm_record_wake_alarm() should return a static, non-heap object
@@ -1034,6 +1122,14 @@ int __attribute__((used)) main(void) {
     // Then reset the alarm system. It's not reset in reset_port(), because that's also called
     // on VM teardown, which would clear any alarm setup.
     alarm_reset();
+
+    #if CIRCUITPY_OS_GETENV
+    if (get_safe_mode() == SAFE_MODE_NONE &&
+        common_hal_mcu_processor_get_reset_reason() == RESET_REASON_DEEP_SLEEP_ALARM &&
+        common_hal_os_getenv_str("CIRCUITPY_WAKE_FILE", _wake_file, sizeof(_wake_file)) != GETENV_OK) {
+        _wake_file[0] = '\0';
+    }
+    #endif
     #endif
 
     // Reset everything and prep MicroPython to run boot.py.
@@ -1045,6 +1141,10 @@ int __attribute__((used)) main(void) {
     // displays init after filesystem, since they could share the flash SPI
     board_init();
 
+    #if CIRCUITPY_BOOT_TIMING
+    supervisor_boot_timing_mark(BOOT_PHASE_BOARD_INIT);
+    #endif
+
     mp_hal_stdout_tx_str(line_clear);
 
     // This is first time we are running CircuitPython after a reset or power-up.
@@ -1071,6 +1171,10 @@ int __attribute__((used)) main(void) {
 
     supervisor_workflow_start();
 
+    #if CIRCUITPY_BOOT_TIMING
+    supervisor_boot_timing_mark(BOOT_PHASE_WORKFLOW_START);
+    #endif
+
     #if CIRCUITPY_STATUS_BAR
     supervisor_status_bar_request_update(true);
     #endif
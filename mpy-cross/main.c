@@ -43,6 +43,8 @@
 // Command line options, with their defaults
 STATIC uint emit_opt = MP_EMIT_OPT_NONE;
 mp_uint_t mp_verbose_flag = 0;
+// CIRCUITPY-CHANGE
+STATIC bool strip_private = false;
 
 // Heap size of GC heap (if enabled)
 // Make it larger on a 64 bit machine, because pointers are larger.
@@ -64,31 +66,225 @@ STATIC void stderr_print_strn(void *env, const char *str, size_t len) {
 
 STATIC const mp_print_t mp_stderr_print = {NULL, stderr_print_strn};
 
+// CIRCUITPY-CHANGE: split out of compile_and_save so it can be run more than once
+STATIC void compile_file(const char *file, qstr source_name, mp_compiled_module_t *cm) {
+    mp_lexer_t *lex;
+    if (strcmp(file, "-") == 0) {
+        lex = mp_lexer_new_from_fd(MP_QSTR__lt_stdin_gt_, STDIN_FILENO, false);
+    } else {
+        lex = mp_lexer_new_from_file(file);
+    }
+
+    #if MICROPY_PY___FILE__
+    mp_store_global(MP_QSTR___file__, MP_OBJ_NEW_QSTR(source_name));
+    #endif
+
+    mp_parse_tree_t parse_tree = mp_parse(lex, MP_PARSE_FILE_INPUT);
+    if (strip_private) {
+        mp_parse_strip_unused_private(&parse_tree);
+    }
+    cm->context = m_new_obj(mp_module_context_t);
+    mp_compile_to_raw_code(&parse_tree, source_name, false, cm);
+}
+
+#if MICROPY_EMIT_NATIVE
+// CIRCUITPY-CHANGE
+// Profile-guided native code. The samples printed by
+// supervisor.print_profile() are credited to the function of the same name
+// whose def is the last one at or before the sampled line. The functions with
+// the most samples are made native, as long as the growth in the .mpy that
+// each one causes on its own fits in the budget.
+
+typedef struct {
+    qstr name;
+    size_t line;
+    size_t samples;
+    // Bytes the .mpy grows by when only this function is native, or -1 if it can't be.
+    long cost;
+    bool native;
+} native_candidate_t;
+
+STATIC const char *native_profile = NULL;
+STATIC long native_budget = 2048;
+STATIC native_candidate_t *native_candidates = NULL;
+STATIC size_t native_candidates_len = 0;
+STATIC bool native_discover = false;
+
+STATIC bool native_select(qstr name, size_t line) {
+    for (size_t i = 0; i < native_candidates_len; i++) {
+        if (native_candidates[i].name == name && native_candidates[i].line == line) {
+            return native_candidates[i].native;
+        }
+    }
+    if (native_discover) {
+        native_candidates = realloc(native_candidates, (native_candidates_len + 1) * sizeof(native_candidate_t));
+        native_candidates[native_candidates_len++] = (native_candidate_t) { name, line, 0, -1, false };
+    }
+    return false;
+}
+
+// Whether the two paths name the same file, allowing either to be relative.
+STATIC bool same_file(const char *a, const char *b) {
+    size_t a_len = strlen(a);
+    size_t b_len = strlen(b);
+    if (a_len < b_len) {
+        const char *t = a;
+        a = b;
+        b = t;
+        size_t t_len = a_len;
+        a_len = b_len;
+        b_len = t_len;
+    }
+    return strcmp(a + a_len - b_len, b) == 0 && (a_len == b_len || a[a_len - b_len - 1] == '/');
+}
+
+// Credit the samples on one line of the profile. Lines are either
+// "count file:line (name)" or in the collapsed form
+// "file:name:line;...;file:name:line count", where the last frame is the one
+// that was running.
+STATIC void add_profile_line(char *text, const char *source) {
+    char *end = text + strlen(text);
+    while (end > text && (end[-1] == '\n' || end[-1] == '\r')) {
+        *--end = '\0';
+    }
+    char *file;
+    char *name;
+    char *line;
+    unsigned long count;
+    if (end > text && end[-1] == ')') {
+        count = strtoul(text, &file, 10);
+        char *paren = strrchr(text, '(');
+        if (file == text || paren == NULL || paren == text || paren[-1] != ' ') {
+            return;
+        }
+        paren[-1] = '\0';
+        end[-1] = '\0';
+        name = paren + 1;
+        while (*file == ' ') {
+            file++;
+        }
+        line = strrchr(file, ':');
+        if (line == NULL) {
+            return;
+        }
+        *line++ = '\0';
+    } else {
+        char *space = strrchr(text, ' ');
+        if (space == NULL) {
+            return;
+        }
+        *space = '\0';
+        count = strtoul(space + 1, NULL, 10);
+        file = strrchr(text, ';');
+        file = file == NULL ? text : file + 1;
+        line = strrchr(file, ':');
+        if (line == NULL || line == file) {
+            return;
+        }
+        *line++ = '\0';
+        name = strrchr(file, ':');
+        if (name == NULL) {
+            return;
+        }
+        *name++ = '\0';
+    }
+    if (!same_file(file, source)) {
+        return;
+    }
+    size_t sample_line = strtoul(line, NULL, 10);
+    qstr q = qstr_find_strn(name, strlen(name));
+    native_candidate_t *best = NULL;
+    for (size_t i = 0; i < native_candidates_len; i++) {
+        native_candidate_t *c = &native_candidates[i];
+        if (c->name == q && c->line <= sample_line && (best == NULL || c->line > best->line)) {
+            best = c;
+        }
+    }
+    if (best != NULL) {
+        best->samples += count;
+    }
+}
+
+STATIC int compare_samples(const void *a, const void *b) {
+    const native_candidate_t *ca = a;
+    const native_candidate_t *cb = b;
+    return ca->samples < cb->samples ? 1 : ca->samples > cb->samples ? -1 : 0;
+}
+
+STATIC size_t compiled_size(const char *file, qstr source_name) {
+    mp_compiled_module_t cm;
+    compile_file(file, source_name, &cm);
+    vstr_t vstr;
+    mp_print_t print;
+    vstr_init_print(&vstr, 256, &print);
+    mp_raw_code_save(&cm, &print);
+    size_t size = vstr.len;
+    vstr_clear(&vstr);
+    return size;
+}
+
+STATIC void choose_native(const char *file, qstr source_name) {
+    mp_dynamic_compiler.native_select = native_select;
+    native_candidates_len = 0;
+    native_discover = true;
+    size_t base_size = compiled_size(file, source_name);
+    native_discover = false;
+
+    FILE *f = fopen(native_profile, "r");
+    if (f == NULL) {
+        mp_raise_msg_varg(&mp_type_OSError, MP_ERROR_TEXT("can't open %s"), native_profile);
+    }
+    char text[512];
+    while (fgets(text, sizeof(text), f) != NULL) {
+        add_profile_line(text, qstr_str(source_name));
+    }
+    fclose(f);
+
+    qsort(native_candidates, native_candidates_len, sizeof(native_candidate_t), compare_samples);
+    for (size_t i = 0; i < native_candidates_len && native_candidates[i].samples > 0; i++) {
+        native_candidate_t *c = &native_candidates[i];
+        c->native = true;
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            c->cost = (long)compiled_size(file, source_name) - (long)base_size;
+            nlr_pop();
+        }
+        c->native = false;
+    }
+
+    long budget = native_budget;
+    for (size_t i = 0; i < native_candidates_len && native_candidates[i].samples > 0; i++) {
+        native_candidate_t *c = &native_candidates[i];
+        if (c->cost >= 0 && c->cost <= budget) {
+            c->native = true;
+            budget -= c->cost;
+        }
+        if (mp_verbose_flag) {
+            mp_printf(&mp_stderr_print, "%s %q (line %u): %u samples, %d bytes\n",
+                c->native ? "native" : "bytecode", c->name, (uint)c->line, (uint)c->samples, (int)c->cost);
+        }
+    }
+}
+#endif
+
 STATIC int compile_and_save(const char *file, const char *output_file, const char *source_file) {
     nlr_buf_t nlr;
     if (nlr_push(&nlr) == 0) {
-        mp_lexer_t *lex;
-        if (strcmp(file, "-") == 0) {
-            lex = mp_lexer_new_from_fd(MP_QSTR__lt_stdin_gt_, STDIN_FILENO, false);
-        } else {
-            lex = mp_lexer_new_from_file(file);
-        }
-
         qstr source_name;
         if (source_file == NULL) {
-            source_name = lex->source_name;
+            source_name = strcmp(file, "-") == 0 ? MP_QSTR__lt_stdin_gt_ : qstr_from_str(file);
         } else {
             source_name = qstr_from_str(source_file);
         }
 
-        #if MICROPY_PY___FILE__
-        mp_store_global(MP_QSTR___file__, MP_OBJ_NEW_QSTR(source_name));
+        #if MICROPY_EMIT_NATIVE
+        if (native_profile != NULL) {
+            choose_native(file, source_name);
+        }
         #endif
 
-        mp_parse_tree_t parse_tree = mp_parse(lex, MP_PARSE_FILE_INPUT);
         mp_compiled_module_t cm;
-        cm.context = m_new_obj(mp_module_context_t);
-        mp_compile_to_raw_code(&parse_tree, source_name, false, &cm);
+        compile_file(file, source_name, &cm);
 
         if ((output_file != NULL && strcmp(output_file, "-") == 0) ||
             (output_file == NULL && strcmp(file, "-") == 0)) {
@@ -117,6 +313,38 @@ STATIC int compile_and_save(const char *file, const char *output_file, const cha
     }
 }
 
+// CIRCUITPY-CHANGE
+// Read the constants of the module in file, named from its path: a/b.py and
+// a/b/__init__.py are both module a.b.
+STATIC int add_import_consts(const char *file) {
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        vstr_t vstr;
+        vstr_init(&vstr, 16);
+        vstr_add_str(&vstr, file);
+        if (vstr.len >= 3 && strcmp(vstr.buf + vstr.len - 3, ".py") == 0) {
+            vstr_cut_tail_bytes(&vstr, 3);
+        }
+        if (vstr.len >= 9 && strcmp(vstr_null_terminated_str(&vstr) + vstr.len - 9, "/__init__") == 0) {
+            vstr_cut_tail_bytes(&vstr, 9);
+        }
+        for (size_t i = 0; i < vstr.len; i++) {
+            if (vstr.buf[i] == '/') {
+                vstr.buf[i] = '.';
+            }
+        }
+        qstr module = qstr_from_strn(vstr.buf, vstr.len);
+        vstr_clear(&vstr);
+
+        mp_parse_add_import_consts(module, mp_lexer_new_from_file(file));
+        nlr_pop();
+        return 0;
+    } else {
+        mp_obj_print_exception(&mp_stderr_print, (mp_obj_t)nlr.ret_val);
+        return 1;
+    }
+}
+
 STATIC int usage(char **argv) {
     printf(
         "usage: %s [<opts>] [-X <implopt>] [--] <input filename>\n"
@@ -126,10 +354,16 @@ STATIC int usage(char **argv) {
         "-s : source filename to embed in the compiled bytecode (defaults to input file)\n"
         "-v : verbose (trace various operations); can be multiple\n"
         "-O[N] : apply bytecode optimizations of level N\n"
+        "-C <file> : fold the const() values that the input imports from the module in <file>, named from its path; can be repeated\n"
+        "--strip-private : leave out top-level functions and classes named _<name> that the input never refers to\n"
         "\n"
         "Target specific options:\n"
         "-msmall-int-bits=number : set the maximum bits used to encode a small-int\n"
-        "-march=<arch> : set architecture for native emitter; x86, x64, armv6, armv6m, armv7m, armv7em, armv7emsp, armv7emdp, xtensa, xtensawin\n"
+        "-march=<arch> : set architecture for native emitter; x86, x64, armv6, armv6m, armv7m, armv7em, armv7emsp, armv7emdp, xtensa, xtensawin, rv32imc\n"
+        #if MICROPY_EMIT_NATIVE
+        "--native-profile <file> : emit native code for the functions with the most samples in <file>, as printed by supervisor.print_profile()\n"
+        "--native-budget=<bytes> : how much larger --native-profile may make the output (default 2048)\n"
+        #endif
         "\n"
         "Implementation specific options:\n", argv[0]
         );
@@ -252,6 +486,31 @@ MP_NOINLINE int main_(int argc, char **argv) {
                 return 0;
             } else if (strcmp(argv[a], "-v") == 0) {
                 mp_verbose_flag++;
+            // CIRCUITPY-CHANGE
+            } else if (strcmp(argv[a], "-C") == 0) {
+                if (a + 1 >= argc) {
+                    exit(usage(argv));
+                }
+                a += 1;
+                if (add_import_consts(backslash_to_forwardslash(argv[a])) != 0) {
+                    return 1;
+                }
+            } else if (strcmp(argv[a], "--strip-private") == 0) {
+                strip_private = true;
+            #if MICROPY_EMIT_NATIVE
+            } else if (strcmp(argv[a], "--native-profile") == 0) {
+                if (a + 1 >= argc) {
+                    exit(usage(argv));
+                }
+                a += 1;
+                native_profile = argv[a];
+            } else if (strncmp(argv[a], "--native-budget=", sizeof("--native-budget=") - 1) == 0) {
+                char *end;
+                native_budget = strtol(argv[a] + sizeof("--native-budget=") - 1, &end, 0);
+                if (*end) {
+                    return usage(argv);
+                }
+            #endif
             } else if (strncmp(argv[a], "-O", 2) == 0) {
                 if (unichar_isdigit(argv[a][2])) {
                     MP_STATE_VM(mp_optimise_value) = argv[a][2] & 0xf;
@@ -312,6 +571,9 @@ MP_NOINLINE int main_(int argc, char **argv) {
                 } else if (strcmp(arch, "xtensawin") == 0) {
                     mp_dynamic_compiler.native_arch = MP_NATIVE_ARCH_XTENSAWIN;
                     mp_dynamic_compiler.nlr_buf_num_regs = MICROPY_NLR_NUM_REGS_XTENSAWIN;
+                } else if (strcmp(arch, "rv32imc") == 0) {
+                    mp_dynamic_compiler.native_arch = MP_NATIVE_ARCH_RV32IMC;
+                    mp_dynamic_compiler.nlr_buf_num_regs = MICROPY_NLR_NUM_REGS_RV32I;
                 } else if (strcmp(arch, "host") == 0) {
                     #if defined(__i386__) || defined(_M_IX86)
                     mp_dynamic_compiler.native_arch = MP_NATIVE_ARCH_X86;
@@ -348,6 +610,20 @@ MP_NOINLINE int main_(int argc, char **argv) {
         exit(1);
     }
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_EMIT_NATIVE
+    if (native_profile != NULL) {
+        if (mp_dynamic_compiler.native_arch == MP_NATIVE_ARCH_NONE) {
+            mp_printf(&mp_stderr_print, "--native-profile needs -march\n");
+            exit(1);
+        }
+        if (strcmp(input_file, "-") == 0) {
+            mp_printf(&mp_stderr_print, "--native-profile can't be used with stdin\n");
+            exit(1);
+        }
+    }
+    #endif
+
     int ret = compile_and_save(input_file, output_file, source_file);
 
     #if MICROPY_PY_MICROPYTHON_MEM_INFO
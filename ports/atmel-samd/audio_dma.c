@@ -15,6 +15,9 @@
 #include "shared-bindings/audiocore/WaveFile.h"
 #include "shared-bindings/microcontroller/__init__.h"
 #include "supervisor/background_callback.h"
+#include "supervisor/filesystem.h"
+#include "supervisor/port.h"
+#include "supervisor/shared/trace.h"
 
 #include "py/mpstate.h"
 #include "py/runtime.h"
@@ -51,6 +54,13 @@ uint8_t dma_allocate_channel(void) {
     return channel; // i.e., return failure
 }
 
+// Current time in 1/32768 s units, finer than the 1/1024 s tick.
+static uint32_t audio_dma_now(void) {
+    uint8_t subticks;
+    uint64_t ticks = port_get_raw_ticks(&subticks);
+    return (uint32_t)(ticks * 32 + subticks);
+}
+
 void dma_free_channel(uint8_t channel) {
     assert(channel < AUDIO_DMA_CHANNEL_COUNT);
     assert(audio_dma_allocated[channel]);
@@ -164,6 +174,7 @@ static void audio_dma_load_next_block(audio_dma_t *dma, size_t buffer_idx) {
         }
     }
     descriptor->BTCTRL.bit.VALID = true;
+    dma->stats.buffers++;
 }
 
 static void setup_audio_descriptor(DmacDescriptor *descriptor, uint8_t beat_size,
@@ -206,6 +217,7 @@ audio_dma_result audio_dma_setup_playback(audio_dma_t *dma,
     dma->spacing = 1;
     audiosample_reset_buffer(sample, single_channel_output, audio_channel);
     dma->buffer_to_load = NO_BUFFER_TO_LOAD;
+    dma->stats = (audiocore_dma_stats_t) { 0 };
     dma->descriptor[0] = dma_descriptor(dma_channel);
     dma->descriptor[1] = &dma->second_descriptor;
 
@@ -295,6 +307,9 @@ audio_dma_result audio_dma_setup_playback(audio_dma_t *dma,
         audio_dma_load_next_block(dma, 1);
     }
 
+    if (!dma->playing_in_progress) {
+        filesystem_defer_flush(true);
+    }
     dma->playing_in_progress = true;
     dma_configure(dma_channel, dma_trigger_source, true);
     audio_dma_enable_channel(dma_channel);
@@ -314,6 +329,9 @@ void audio_dma_stop(audio_dma_t *dma) {
         dma_free_channel(dma->dma_channel);
     }
     dma->dma_channel = AUDIO_DMA_CHANNEL_COUNT;
+    if (dma->playing_in_progress) {
+        filesystem_defer_flush(false);
+    }
     dma->playing_in_progress = false;
 }
 
@@ -334,6 +352,13 @@ bool audio_dma_get_paused(audio_dma_t *dma) {
     return (status & DMAC_CHINTFLAG_SUSP) != 0;
 }
 
+void audio_dma_get_stats(audio_dma_t *dma, audiocore_dma_stats_t *stats) {
+    // The underrun count is updated from the event interrupt.
+    common_hal_mcu_disable_interrupts();
+    *stats = dma->stats;
+    common_hal_mcu_enable_interrupts();
+}
+
 void audio_dma_init(audio_dma_t *dma) {
     dma->dma_channel = AUDIO_DMA_CHANNEL_COUNT;
 }
@@ -366,13 +391,19 @@ static void dma_callback_fun(void *arg) {
 
     common_hal_mcu_disable_interrupts();
     uint8_t buffer_to_load = dma->buffer_to_load;
+    uint32_t requested_ticks = dma->load_requested_ticks;
     dma->buffer_to_load = NO_BUFFER_TO_LOAD;
     common_hal_mcu_enable_interrupts();
 
     if (buffer_to_load == NO_BUFFER_TO_LOAD) {
         audio_dma_stop(dma);
     } else {
+        // 1/32768 s to us is 1000000 / 32768 = 15625 / 512.
+        uint32_t elapsed = audio_dma_now() - requested_ticks;
+        audiocore_dma_stats_add_latency(&dma->stats, (uint32_t)((uint64_t)elapsed * 15625 / 512));
+        CIRCUITPY_TRACE_BEGIN(TRACE_EVENT_AUDIO_DMA_REFILL);
         audio_dma_load_next_block(dma, buffer_to_load);
+        CIRCUITPY_TRACE_END(TRACE_EVENT_AUDIO_DMA_REFILL);
     }
 }
 
@@ -386,6 +417,7 @@ void audio_dma_evsys_handler(void) {
         if (!block_done) {
             continue;
         }
+        CIRCUITPY_TRACE_INSTANT(TRACE_EVENT_AUDIO_DMA_IRQ);
 
         // By the time we get here, the write-back descriptor has been set to the
         // current running descriptor. Fill the buffer that the next chained descriptor
@@ -398,6 +430,12 @@ void audio_dma_evsys_handler(void) {
         // of which buffer to fill here appears correct.
         DmacDescriptor *next_descriptor =
             (DmacDescriptor *)dma_write_back_descriptor(dma->dma_channel)->DESCADDR.reg;
+        // The previous request was never serviced, so the DMA has moved on
+        // to a buffer that still holds old data.
+        if (dma->buffer_to_load != NO_BUFFER_TO_LOAD) {
+            dma->stats.underruns++;
+        }
+        dma->load_requested_ticks = audio_dma_now();
         if (next_descriptor == dma->descriptor[0]) {
             dma->buffer_to_load = 0;
         } else if (next_descriptor == dma->descriptor[1]) {
@@ -408,7 +446,7 @@ void audio_dma_evsys_handler(void) {
             continue;
         }
 
-        background_callback_add(&dma->callback, dma_callback_fun, (void *)dma);
+        background_callback_add_with_priority(&dma->callback, dma_callback_fun, (void *)dma, BACKGROUND_CALLBACK_PRIORITY_REALTIME);
     }
 }
 
@@ -19,6 +19,8 @@ typedef struct {
     DmacDescriptor *descriptor[2];
     DmacDescriptor second_descriptor;
     background_callback_t callback;
+    audiocore_dma_stats_t stats;
+    uint32_t load_requested_ticks; // 1/32768 s ticks when the DMA asked for buffer_to_load.
     uint8_t dma_channel;
     uint8_t event_channel;
     uint8_t audio_channel;
@@ -75,6 +77,7 @@ bool audio_dma_get_playing(audio_dma_t *dma);
 void audio_dma_pause(audio_dma_t *dma);
 void audio_dma_resume(audio_dma_t *dma);
 bool audio_dma_get_paused(audio_dma_t *dma);
+void audio_dma_get_stats(audio_dma_t *dma, audiocore_dma_stats_t *stats);
 
 void audio_dma_background(void);
 
@@ -69,6 +69,71 @@ void pdmin_reset(void) {
     I2S->CTRLA.reg = I2S_CTRLA_SWRST;
 }
 
+// a windowed sinc filter for 44 khz, 64 samples
+//
+// This filter is good enough to use for lower sample rates as
+// well. It does not increase the noise enough to be a problem.
+//
+// In the long run we could use a fast filter like this to do the
+// decimation and initial filtering in real time, filtering to a
+// higher sample rate than specified.  Then after the audio is
+// recorded, a more expensive filter non-real-time filter could be
+// used to down-sample and low-pass.
+const uint16_t sinc_filter[OVERSAMPLING] = {
+    0, 2, 9, 21, 39, 63, 94, 132,
+    179, 236, 302, 379, 467, 565, 674, 792,
+    920, 1055, 1196, 1341, 1487, 1633, 1776, 1913,
+    2042, 2159, 2263, 2352, 2422, 2474, 2506, 2516,
+    2506, 2474, 2422, 2352, 2263, 2159, 2042, 1913,
+    1776, 1633, 1487, 1341, 1196, 1055, 920, 792,
+    674, 565, 467, 379, 302, 236, 179, 132,
+    94, 63, 39, 21, 9, 2, 0, 0
+};
+
+// The filter is applied a few PDM bits at a time. Each group of the table holds
+// the sum of the taps for the set bits of one value of its bits, so a sample
+// takes a lookup per group instead of a test per bit. The sums wrap the same way
+// the running sum does, so the result matches summing the taps one by one.
+#ifdef SAMD21
+// Four bits at a time keeps the table to 512 bytes.
+#define FILTER_TABLE_BITS (4)
+#else
+#define FILTER_TABLE_BITS (8)
+#endif
+#define FILTER_TABLE_ENTRIES (1 << FILTER_TABLE_BITS)
+#define FILTER_TABLE_GROUPS (OVERSAMPLING / FILTER_TABLE_BITS)
+
+static void build_filter_table(uint16_t *table) {
+    for (size_t group = 0; group < FILTER_TABLE_GROUPS; group++) {
+        const uint16_t *taps = sinc_filter + group * FILTER_TABLE_BITS;
+        for (size_t value = 0; value < FILTER_TABLE_ENTRIES; value++) {
+            uint16_t sum = 0;
+            // Bits arrive msb first.
+            for (size_t bit = 0; bit < FILTER_TABLE_BITS; bit++) {
+                if (value & (1 << (FILTER_TABLE_BITS - 1 - bit))) {
+                    sum += taps[bit];
+                }
+            }
+            *table++ = sum;
+        }
+    }
+}
+
+static uint16_t filter_sample(const uint16_t *table, uint32_t pdm_samples[4]) {
+    uint16_t running_sum = 0;
+    for (uint8_t i = 0; i < OVERSAMPLING / 16; i++) {
+        // The sample is 16-bits right channel in the upper two bytes and 16-bits left channel
+        // in the lower two bytes.
+        // We just ignore the upper bits
+        uint32_t pdm_sample = pdm_samples[i];
+        for (int8_t shift = 16 - FILTER_TABLE_BITS; shift >= 0; shift -= FILTER_TABLE_BITS) {
+            running_sum += table[(pdm_sample >> shift) & (FILTER_TABLE_ENTRIES - 1)];
+            table += FILTER_TABLE_ENTRIES;
+        }
+    }
+    return running_sum;
+}
+
 // Caller validates that pins are free.
 void common_hal_audiobusio_pdmin_construct(audiobusio_pdmin_obj_t *self,
     const mcu_pin_obj_t *clock_pin,
@@ -140,6 +205,10 @@ void common_hal_audiobusio_pdmin_construct(audiobusio_pdmin_obj_t *self,
         mp_raise_NotImplementedError_varg(MP_ERROR_TEXT("Only 8 or 16 bit mono with %dx oversampling supported."), OVERSAMPLING);
     }
 
+    // Allocate before touching the hardware so a MemoryError leaves nothing behind.
+    self->filter_table = m_malloc(FILTER_TABLE_GROUPS * FILTER_TABLE_ENTRIES * sizeof(uint16_t));
+    build_filter_table(self->filter_table);
+
     turn_on_i2s();
 
     if (I2S->CTRLA.bit.ENABLE == 0) {
@@ -244,6 +313,7 @@ void common_hal_audiobusio_pdmin_deinit(audiobusio_pdmin_obj_t *self) {
     reset_pin_number(self->data_pin->number);
     self->clock_pin = NULL;
     self->data_pin = NULL;
+    self->filter_table = NULL;
 }
 
 uint8_t common_hal_audiobusio_pdmin_get_bit_depth(audiobusio_pdmin_obj_t *self) {
@@ -313,53 +383,6 @@ static void setup_dma(audiobusio_pdmin_obj_t *self, uint32_t length,
     }
 }
 
-// a windowed sinc filter for 44 khz, 64 samples
-//
-// This filter is good enough to use for lower sample rates as
-// well. It does not increase the noise enough to be a problem.
-//
-// In the long run we could use a fast filter like this to do the
-// decimation and initial filtering in real time, filtering to a
-// higher sample rate than specified.  Then after the audio is
-// recorded, a more expensive filter non-real-time filter could be
-// used to down-sample and low-pass.
-const uint16_t sinc_filter[OVERSAMPLING] = {
-    0, 2, 9, 21, 39, 63, 94, 132,
-    179, 236, 302, 379, 467, 565, 674, 792,
-    920, 1055, 1196, 1341, 1487, 1633, 1776, 1913,
-    2042, 2159, 2263, 2352, 2422, 2474, 2506, 2516,
-    2506, 2474, 2422, 2352, 2263, 2159, 2042, 1913,
-    1776, 1633, 1487, 1341, 1196, 1055, 920, 792,
-    674, 565, 467, 379, 302, 236, 179, 132,
-    94, 63, 39, 21, 9, 2, 0, 0
-};
-
-#ifdef SAMD21
-#define REPEAT_16_TIMES(X) do { for (uint8_t j = 0; j < 4; j++) { X X X X } } while (0)
-#else
-#define REPEAT_16_TIMES(X) do { X X X X X X X X X X X X X X X X } while (0)
-#endif
-
-static uint16_t filter_sample(uint32_t pdm_samples[4]) {
-    uint16_t running_sum = 0;
-    const uint16_t *filter_ptr = sinc_filter;
-    for (uint8_t i = 0; i < OVERSAMPLING / 16; i++) {
-        // The sample is 16-bits right channel in the upper two bytes and 16-bits left channel
-        // in the lower two bytes.
-        // We just ignore the upper bits
-        uint32_t pdm_sample = pdm_samples[i];
-        REPEAT_16_TIMES({
-            if (pdm_sample & 0x8000) {
-                running_sum += *filter_ptr;
-            }
-            filter_ptr++;
-            pdm_sample <<= 1;
-        }
-            );
-    }
-    return running_sum;
-}
-
 // output_buffer may be a byte buffer or a halfword buffer.
 // output_buffer_length is the number of slots, not the number of bytes.
 uint32_t common_hal_audiobusio_pdmin_record_to_buffer(audiobusio_pdmin_obj_t *self,
@@ -438,7 +461,7 @@ uint32_t common_hal_audiobusio_pdmin_record_to_buffer(audiobusio_pdmin_obj_t *se
         uint32_t samples_to_process = min(remaining_samples_needed, samples_gathered);
         for (uint32_t i = 0; i < samples_to_process; i++) {
             // Call filter_sample just one place so it can be inlined.
-            uint16_t value = filter_sample(buffer + i * words_per_sample);
+            uint16_t value = filter_sample(self->filter_table, buffer + i * words_per_sample);
             if (self->bit_depth == 8) {
                 // Truncate to 8 bits.
                 ((uint8_t *)output_buffer)[values_output] = value >> 8;
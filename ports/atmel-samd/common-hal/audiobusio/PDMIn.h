@@ -21,6 +21,8 @@ typedef struct {
     uint8_t bytes_per_sample;
     uint8_t bit_depth;
     uint8_t gclk;
+    // Partial sums of the filter for every value of each group of sample bits.
+    uint16_t *filter_table;
 } audiobusio_pdmin_obj_t;
 
 void pdmin_reset(void);
@@ -350,6 +350,8 @@ void common_hal_audioio_audioout_play(audioio_audioout_obj_t *self,
     #endif
 
     #ifdef SAM_D5X_E5X
+    // The right DMA is only set up for some samples; don't report its old counts.
+    self->right_dma.stats = (audiocore_dma_stats_t) { 0 };
     uint32_t left_channel_reg = (uint32_t)&DAC->DATABUF[0].reg;
     uint8_t tc_trig_id = TC0_DMAC_ID_OVF + 3 * self->tc_index;
     uint8_t left_channel_trigger = tc_trig_id;
@@ -436,6 +438,17 @@ bool common_hal_audioio_audioout_get_paused(audioio_audioout_obj_t *self) {
     return audio_dma_get_paused(&self->left_dma);
 }
 
+void common_hal_audioio_audioout_get_dma_stats(audioio_audioout_obj_t *self, audiocore_dma_stats_t *stats) {
+    audio_dma_get_stats(&self->left_dma, stats);
+    #ifdef SAM_D5X_E5X
+    audiocore_dma_stats_t right;
+    audio_dma_get_stats(&self->right_dma, &right);
+    stats->buffers += right.buffers;
+    stats->underruns += right.underruns;
+    audiocore_dma_stats_add_latency(stats, right.max_latency_us);
+    #endif
+}
+
 void common_hal_audioio_audioout_stop(audioio_audioout_obj_t *self) {
     // Do not stop the timer here. There are occasional audible artifacts if the DMA-triggering timer
     // is stopped between audio plays. (Heard this only on PyPortal with one particular 32kHz sample.)
@@ -365,6 +365,10 @@ void common_hal_busio_uart_deinit(busio_uart_obj_t *self) {
     self->cts_pin = NO_PIN;
 }
 
+static bool uart_rx_ready(void *usart_desc_p) {
+    return usart_async_is_rx_not_empty(usart_desc_p);
+}
+
 // Read characters.
 size_t common_hal_busio_uart_read(busio_uart_obj_t *self, uint8_t *data, size_t len, int *errcode) {
     if (self->rx_pin == NO_PIN) {
@@ -383,10 +387,10 @@ size_t common_hal_busio_uart_read(busio_uart_obj_t *self, uint8_t *data, size_t
     usart_async_get_io_descriptor(usart_desc_p, &io);
 
     size_t total_read = 0;
-    uint64_t start_ticks = supervisor_ticks_ms64();
 
-    // Busy-wait until timeout or until we've read enough chars.
-    while (supervisor_ticks_ms64() - start_ticks <= self->timeout_ms) {
+    // Sleep between characters until timeout or until we've read enough chars.
+    // The RX interrupt wakes us up.
+    while (true) {
         // Read as many chars as we can right now, up to len.
         size_t num_read = io_read(io, data, len);
 
@@ -398,18 +402,10 @@ size_t common_hal_busio_uart_read(busio_uart_obj_t *self, uint8_t *data, size_t
             // Don't need to read any more: data buf is full.
             break;
         }
-        if (num_read > 0) {
-            // Reset the timeout on every character read.
-            start_ticks = supervisor_ticks_ms64();
-        }
-        RUN_BACKGROUND_TASKS;
-        // Allow user to break out of a timeout with a KeyboardInterrupt.
-        if (mp_hal_is_interrupted()) {
-            break;
-        }
-        // If we are zero timeout, make sure we don't loop again (in the event
-        // we read in under 1ms)
-        if (self->timeout_ms == 0) {
+        // The timeout restarts on every character read. This also ends a zero
+        // timeout once we've read what was already here.
+        if (!supervisor_wait_until(uart_rx_ready, usart_desc_p, self->timeout_ms)) {
+            // Timed out, or the user broke out with a KeyboardInterrupt.
             break;
         }
     }
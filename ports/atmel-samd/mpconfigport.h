@@ -46,6 +46,9 @@
 // Only support simpler HID descriptors on SAMD21.
 #define CIRCUITPY_USB_HID_MAX_REPORT_IDS_PER_DESCRIPTOR (1)
 
+// Compile imported .py files a statement at a time so they fit in 32kB of RAM.
+#define MICROPY_COMPILE_BY_STATEMENT (1)
+
 #endif // SAMD21
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -95,6 +98,11 @@
 #define CIRCUITPY_DEFAULT_STACK_SIZE                3584
 #endif
 
+// Not enough ram to hold more than one sector of external flash.
+#ifndef CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS
+#define CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS (1)
+#endif
+
 #ifndef SAMD21_BOD33_LEVEL
 // Set brownout detection to ~2.7V. Default from factory is 1.7V,
 // which is too low for proper operation of external SPI flash chips
@@ -193,6 +193,12 @@ MP_PROPERTY_GETTER(espcamera_camera_frame_available_obj,
 //|         In the case of timeout, `None` is returned.
 //|         If `pixel_format` is `PixelFormat.JPEG`, the returned value is a read-only `memoryview`.
 //|         Otherwise, the returned value is a read-only `displayio.Bitmap`.
+//|
+//|         The frame is not copied: the returned value refers to the camera's
+//|         frame buffer, which is handed back to the camera by the next call to
+//|         `take`. While the frame size and format stay the same, each call
+//|         returns the same `displayio.Bitmap`, now showing the new frame, so a
+//|         `displayio.TileGrid` made from it shows a live preview.
 //|         """
 static mp_obj_t espcamera_camera_take(size_t n_args, const mp_obj_t *args) {
     espcamera_camera_obj_t *self = MP_OBJ_TO_PTR(args[0]);
@@ -208,9 +214,17 @@ static mp_obj_t espcamera_camera_take(size_t n_args, const mp_obj_t *args) {
     } else {
         int width = common_hal_espcamera_camera_get_width(self);
         int height = common_hal_espcamera_camera_get_height(self);
-        displayio_bitmap_t *bitmap = m_new_obj(displayio_bitmap_t);
-        bitmap->base.type = &displayio_bitmap_type;
-        common_hal_displayio_bitmap_construct_from_buffer(bitmap, width, height, (format == PIXFORMAT_RGB565) ? 16 : 8, (uint32_t *)(void *)result->buf, true);
+        int bits_per_value = (format == PIXFORMAT_RGB565) ? 16 : 8;
+        // The previous frame's buffer has gone back to the driver, so its
+        // Bitmap is reused for the new frame rather than left pointing at a
+        // buffer being filled. A TileGrid showing it then displays each new
+        // frame without any copying.
+        displayio_bitmap_t *bitmap = self->bitmap;
+        if (bitmap == NULL || bitmap->width != width || bitmap->height != height || bitmap->bits_per_value != bits_per_value) {
+            bitmap = mp_obj_malloc(displayio_bitmap_t, &displayio_bitmap_type);
+            self->bitmap = bitmap;
+        }
+        common_hal_displayio_bitmap_construct_from_buffer(bitmap, width, height, bits_per_value, (uint32_t *)(void *)result->buf, true);
         return bitmap;
     }
 }
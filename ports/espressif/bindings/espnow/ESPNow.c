@@ -151,6 +151,43 @@ static mp_obj_t espnow_read(mp_obj_t self_in) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(espnow_read_obj, espnow_read);
 
+//|     def read_into(self, buffer: WriteableBuffer, index: array.array) -> int:
+//|         """Read as many packets as will fit from the receive buffer, without allocating.
+//|
+//|         Each packet is copied into ``buffer`` as its 6-byte peer address followed
+//|         by its message. For each packet, four values are stored in ``index``,
+//|         which must be an ``array.array('l')``: the offset of the packet in
+//|         ``buffer``, the message length, the RSSI and the receive time in
+//|         milliseconds. The peer address of a packet is then
+//|         ``buffer[offset:offset + 6]`` and its message is
+//|         ``buffer[offset + 6:offset + 6 + length]``.
+//|
+//|         Reading stops when no packets are left, or when ``buffer`` or ``index``
+//|         has no room for the next packet, which then stays in the receive buffer.
+//|         A ``buffer`` of 256 bytes always has room for at least one packet.
+//|
+//|         :param WriteableBuffer buffer: Where the peer addresses and messages are copied.
+//|         :param array.array index: Receives offset, length, rssi and time for each packet.
+//|         :returns: The number of packets read."""
+//|         ...
+static mp_obj_t espnow_read_into(mp_obj_t self_in, mp_obj_t buffer_in, mp_obj_t index_in) {
+    espnow_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    espnow_check_for_deinit(self);
+
+    mp_buffer_info_t buffer;
+    mp_get_buffer_raise(buffer_in, &buffer, MP_BUFFER_WRITE);
+
+    mp_buffer_info_t index;
+    mp_get_buffer_raise(index_in, &index, MP_BUFFER_WRITE);
+    if (index.typecode != 'l') {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("%q must be array of type 'l'"), MP_QSTR_index);
+    }
+    size_t max_packets = index.len / (sizeof(int32_t) * ESPNOW_READ_INTO_FIELDS);
+
+    return MP_OBJ_NEW_SMALL_INT(common_hal_espnow_read_into(self, buffer.buf, buffer.len, index.buf, max_packets));
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(espnow_read_into_obj, espnow_read_into);
+
 //|     send_success: int
 //|     """The number of tx packets received by the peer(s) ``ESP_NOW_SEND_SUCCESS``. (read-only)"""
 //|
@@ -276,6 +313,7 @@ static const mp_rom_map_elem_t espnow_locals_dict_table[] = {
 
     // Read messages
     { MP_ROM_QSTR(MP_QSTR_read),         MP_ROM_PTR(&espnow_read_obj) },
+    { MP_ROM_QSTR(MP_QSTR_read_into),    MP_ROM_PTR(&espnow_read_into_obj) },
     { MP_ROM_QSTR(MP_QSTR_read_success), MP_ROM_PTR(&espnow_read_success_obj)},
     { MP_ROM_QSTR(MP_QSTR_read_failure), MP_ROM_PTR(&espnow_read_failure_obj)},
 
@@ -300,7 +338,7 @@ static mp_uint_t espnow_stream_ioctl(mp_obj_t self_in, mp_uint_t request, uintpt
         case MP_STREAM_POLL: {
             mp_uint_t flags = arg;
             mp_uint_t ret = 0;
-            if ((flags & MP_STREAM_POLL_RD) && ringbuf_num_filled(self->recv_buffer) > 0) {
+            if ((flags & MP_STREAM_POLL_RD) && ringbuf_spsc_num_filled(self->recv_buffer) > 0) {
                 ret |= MP_STREAM_POLL_RD;
             }
             return ret;
@@ -328,7 +366,7 @@ static const mp_stream_p_t espnow_stream_p = {
 static mp_obj_t espnow_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
     espnow_obj_t *self = MP_OBJ_TO_PTR(self_in);
     espnow_check_for_deinit(self);
-    size_t len = ringbuf_num_filled(self->recv_buffer);
+    size_t len = ringbuf_spsc_num_filled(self->recv_buffer);
     switch (op) {
         case MP_UNARY_OP_BOOL:
             return mp_obj_new_bool(len != 0);
@@ -63,7 +63,8 @@ static void display_init(void) {
         false,          // DE idle high
         false,          // pclk active high
         false,          // pclk idle high
-        0               // overscan left
+        0,              // overscan left
+        0               // bounce buffer lines
         );
 
     framebufferio_framebufferdisplay_obj_t *display = &allocate_display_or_raise()->framebuffer_display;
@@ -240,7 +240,8 @@ static int _scan_event(struct ble_gap_event *event, void *scan_results_in) {
 
 mp_obj_t common_hal_bleio_adapter_start_scan(bleio_adapter_obj_t *self, uint8_t *prefixes,
     size_t prefix_length, bool extended, mp_int_t buffer_size, mp_float_t timeout,
-    mp_float_t interval, mp_float_t window, mp_int_t minimum_rssi, bool active) {
+    mp_float_t interval, mp_float_t window, mp_int_t minimum_rssi, bool active,
+    uint8_t *addresses, size_t addresses_length, mp_int_t duplicate_timeout_ms) {
     if (self->scan_results != NULL) {
         if (!shared_module_bleio_scanresults_get_done(self->scan_results)) {
             mp_raise_bleio_BluetoothError(MP_ERROR_TEXT("Scan already in progress. Stop with stop_scan."));
@@ -248,7 +249,8 @@ mp_obj_t common_hal_bleio_adapter_start_scan(bleio_adapter_obj_t *self, uint8_t
         self->scan_results = NULL;
     }
 
-    self->scan_results = shared_module_bleio_new_scanresults(buffer_size, prefixes, prefix_length, minimum_rssi);
+    self->scan_results = shared_module_bleio_new_scanresults(buffer_size, prefixes, prefix_length, minimum_rssi,
+        addresses, addresses_length, duplicate_timeout_ms);
     // size_t max_packet_size = extended ? BLE_HCI_MAX_EXT_ADV_DATA_LEN : BLE_HCI_MAX_ADV_DATA_LEN;
 
     uint8_t own_addr_type;
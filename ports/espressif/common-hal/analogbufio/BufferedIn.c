@@ -293,3 +293,22 @@ uint32_t common_hal_analogbufio_bufferedin_readinto(analogbufio_bufferedin_obj_t
     #endif // DEBUG_ANALOGBUFIO
     return captured_samples;
 }
+
+void common_hal_analogbufio_bufferedin_start_loop(analogbufio_bufferedin_obj_t *self, uint8_t *buffer, uint32_t len, uint8_t bytes_per_sample) {
+    mp_raise_NotImplementedError_varg(MP_ERROR_TEXT("%q"), MP_QSTR_loop);
+}
+
+void common_hal_analogbufio_bufferedin_stop_loop(analogbufio_bufferedin_obj_t *self) {
+}
+
+bool common_hal_analogbufio_bufferedin_get_looping(analogbufio_bufferedin_obj_t *self) {
+    return false;
+}
+
+uint32_t common_hal_analogbufio_bufferedin_get_write_index(analogbufio_bufferedin_obj_t *self) {
+    return 0;
+}
+
+uint32_t common_hal_analogbufio_bufferedin_read_last(analogbufio_bufferedin_obj_t *self, uint8_t *buffer, uint32_t len, uint8_t bytes_per_sample) {
+    return 0;
+}
@@ -91,7 +91,7 @@ void common_hal_audiobusio_i2sout_deinit(audiobusio_i2sout_obj_t *self) {
 }
 
 void common_hal_audiobusio_i2sout_play(audiobusio_i2sout_obj_t *self,
-    mp_obj_t sample, bool loop) {
+    mp_obj_t sample, bool loop, uint8_t buffer_count, uint32_t target_latency_us) {
     if (common_hal_audiobusio_i2sout_get_playing(self)) {
         common_hal_audiobusio_i2sout_stop(self);
     }
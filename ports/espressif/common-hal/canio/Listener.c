@@ -114,17 +114,17 @@ int common_hal_canio_listener_in_waiting(canio_listener_obj_t *self) {
     return self->pending;
 }
 
-mp_obj_t common_hal_canio_listener_receive(canio_listener_obj_t *self) {
+bool common_hal_canio_listener_receive(canio_listener_obj_t *self, canio_message_obj_t *message) {
     if (!common_hal_canio_listener_in_waiting(self)) {
         uint64_t deadline = supervisor_ticks_ms64() + self->timeout_ms;
         do {
             if (supervisor_ticks_ms64() > deadline) {
-                return NULL;
+                return false;
             }
             RUN_BACKGROUND_TASKS;
             // Allow user to break out of a timeout with a KeyboardInterrupt.
             if (mp_hal_is_interrupted()) {
-                return NULL;
+                return false;
             }
         } while (!common_hal_canio_listener_in_waiting(self));
     }
@@ -132,8 +132,7 @@ mp_obj_t common_hal_canio_listener_receive(canio_listener_obj_t *self) {
     bool rtr = self->message_in.rtr;
 
     int dlc = self->message_in.data_length_code;
-    canio_message_obj_t *message =
-        mp_obj_malloc(canio_message_obj_t, rtr ? &canio_remote_transmission_request_type : &canio_message_type);
+    message->base.type = rtr ? &canio_remote_transmission_request_type : &canio_message_type;
     message->extended = self->message_in.extd;
     message->id = self->message_in.identifier;
     message->size = dlc;
@@ -145,7 +144,7 @@ mp_obj_t common_hal_canio_listener_receive(canio_listener_obj_t *self) {
 
     self->pending = false;
 
-    return message;
+    return true;
 }
 
 void common_hal_canio_listener_deinit(canio_listener_obj_t *self) {
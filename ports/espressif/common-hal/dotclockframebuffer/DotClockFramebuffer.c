@@ -71,7 +71,8 @@ void common_hal_dotclockframebuffer_framebuffer_construct(dotclockframebuffer_fr
     int frequency, int width, int height,
     int hsync_pulse_width, int hsync_back_porch, int hsync_front_porch, bool hsync_idle_low,
     int vsync_pulse_width, int vsync_back_porch, int vsync_front_porch, bool vsync_idle_low,
-    bool de_idle_high, bool pclk_active_high, bool pclk_idle_high, int overscan_left) {
+    bool de_idle_high, bool pclk_active_high, bool pclk_idle_high, int overscan_left,
+    int bounce_buffer_lines) {
 
     if (num_red != 5 || num_green != 6 || num_blue != 5) {
         mp_raise_ValueError(MP_ERROR_TEXT("Must provide 5/6/5 RGB pins"));
@@ -141,6 +142,8 @@ void common_hal_dotclockframebuffer_framebuffer_construct(dotclockframebuffer_fr
     cfg->flags.disp_active_low = 0;
     cfg->flags.refresh_on_demand = 0;
     cfg->flags.fb_in_psram = 1; // allocate frame buffer in PSRAM
+    // The panel is then fed from internal RAM that ISRs refill from the framebuffer.
+    cfg->bounce_buffer_size_px = bounce_buffer_lines * cfg->timings.h_res;
 
     esp_err_t ret = esp_lcd_new_rgb_panel(&self->panel_config, &self->panel_handle);
     CHECK_ESP_RESULT(ret);
@@ -157,6 +160,7 @@ void common_hal_dotclockframebuffer_framebuffer_construct(dotclockframebuffer_fr
     self->width = width;
     self->row_stride = 2 * (cfg->timings.h_res);
     self->first_pixel_offset = 2 * overscan_left;
+    self->bounce_buffers = bounce_buffer_lines > 0;
     self->refresh_rate = frequency / (cfg->timings.h_res + hsync_front_porch + hsync_back_porch) / (height + vsync_front_porch + vsync_back_porch);
     self->bufinfo.buf = (uint8_t *)fb;
     self->bufinfo.len = 2 * (cfg->timings.h_res * cfg->timings.v_res);
@@ -203,8 +207,31 @@ mp_int_t common_hal_dotclockframebuffer_framebuffer_get_first_pixel_offset(dotcl
     return self->first_pixel_offset;
 }
 
-void common_hal_dotclockframebuffer_framebuffer_refresh(dotclockframebuffer_framebuffer_obj_t *self) {
-    Cache_WriteBack_Addr((uint32_t)(self->bufinfo.buf), self->bufinfo.len);
+void common_hal_dotclockframebuffer_framebuffer_refresh(dotclockframebuffer_framebuffer_obj_t *self, const uint8_t *dirty_row_bitmap) {
+    // Bounce buffers are refilled through the cache, so they already see every write.
+    if (self->bounce_buffers) {
+        return;
+    }
+    if (dirty_row_bitmap == NULL) {
+        Cache_WriteBack_Addr((uint32_t)(self->bufinfo.buf), self->bufinfo.len);
+        return;
+    }
+    // Write back each run of dirty rows at once.
+    uint8_t *buf = self->bufinfo.buf;
+    mp_int_t height = self->panel_config.timings.v_res;
+    #define ROW_DIRTY(y) (dirty_row_bitmap[(y) / 8] & (1 << ((y) & 7)))
+    for (mp_int_t y = 0; y < height; y++) {
+        if (!ROW_DIRTY(y)) {
+            continue;
+        }
+        mp_int_t end = y + 1;
+        while (end < height && ROW_DIRTY(end)) {
+            end++;
+        }
+        Cache_WriteBack_Addr((uint32_t)(buf + y * self->row_stride), (end - y) * self->row_stride);
+        y = end;
+    }
+    #undef ROW_DIRTY
 }
 
 mp_int_t common_hal_dotclockframebuffer_framebuffer_get_refresh_rate(dotclockframebuffer_framebuffer_obj_t *self) {
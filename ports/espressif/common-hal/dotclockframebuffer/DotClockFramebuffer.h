@@ -22,6 +22,7 @@ typedef struct dotclockframebuffer_framebuffer_obj {
     uint32_t first_pixel_offset;
     uint64_t used_pins_mask;
     volatile int32_t frame_count;
+    bool bounce_buffers;
     esp_lcd_rgb_panel_config_t panel_config;
     esp_lcd_panel_handle_t panel_handle;
 } dotclockframebuffer_framebuffer_obj_t;
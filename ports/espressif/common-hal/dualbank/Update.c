@@ -0,0 +1,206 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/runtime.h"
+
+#include "bindings/espidf/__init__.h"
+#include "common-hal/dualbank/__init__.h"
+#include "shared-bindings/dualbank/Update.h"
+
+#include "esp_log.h"
+
+static const char *TAG = "dualbank";
+
+// Writes each buffer handed over by the VM. esp_ota_write() erases every
+// sector as it is first reached, so the erase happens here too.
+static void update_task(void *arg) {
+    dualbank_update_obj_t *self = arg;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (self->err == ESP_OK) {
+            self->err = esp_ota_write(self->handle, self->pending, self->pending_len);
+        }
+        xSemaphoreGive(self->idle);
+    }
+}
+
+static void wait_for_task(dualbank_update_obj_t *self) {
+    if (self->busy) {
+        xSemaphoreTake(self->idle, portMAX_DELAY);
+        self->busy = false;
+    }
+}
+
+static void __attribute__((noreturn)) update_failed(dualbank_update_obj_t *self, esp_err_t err) {
+    ESP_LOGE(TAG, "update failed (%s)", esp_err_to_name(err));
+    common_hal_dualbank_update_deinit(self);
+    if (err == ESP_ERR_OTA_VALIDATE_FAILED) {
+        mp_raise_RuntimeError(MP_ERROR_TEXT("Firmware is invalid"));
+    }
+    mp_raise_RuntimeError(MP_ERROR_TEXT("Update Failed"));
+}
+
+// Hand the buffer being filled to the task, once it has finished the other one.
+static void write_buffer(dualbank_update_obj_t *self) {
+    wait_for_task(self);
+    if (self->err != ESP_OK) {
+        update_failed(self, self->err);
+    }
+    if (self->pending == NULL) {
+        // The first buffer holds the app description.
+        dualbank_check_new_firmware(self->buf[self->fill], self->fill_len);
+    }
+    self->pending = self->buf[self->fill];
+    self->pending_len = self->fill_len;
+    self->busy = true;
+    xTaskNotifyGive(self->task);
+    self->fill ^= 1;
+    self->fill_len = 0;
+}
+
+void common_hal_dualbank_update_construct(dualbank_update_obj_t *self, size_t size, const uint8_t *sha256) {
+    if (MP_STATE_PORT(dualbank_update) != NULL) {
+        mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("%q in use"), MP_QSTR_dualbank);
+    }
+    self->partition = esp_ota_get_next_update_partition(NULL);
+    if (self->partition == NULL) {
+        mp_raise_RuntimeError(MP_ERROR_TEXT("Update Failed"));
+    }
+    if (size > self->partition->size) {
+        mp_raise_RuntimeError(MP_ERROR_TEXT("Firmware is too big"));
+    }
+    self->expected_size = size;
+    self->check_sha256 = sha256 != NULL;
+    if (self->check_sha256) {
+        memcpy(self->expected_sha256, sha256, sizeof(self->expected_sha256));
+    }
+    self->buf[0] = m_malloc(CIRCUITPY_DUALBANK_UPDATE_BUFFER_SIZE);
+    self->buf[1] = m_malloc(CIRCUITPY_DUALBANK_UPDATE_BUFFER_SIZE);
+
+    self->idle = xSemaphoreCreateBinary();
+    if (self->idle == NULL) {
+        mp_raise_espidf_MemoryError();
+    }
+    // Nothing is erased up front. Each sector is erased when it is written.
+    esp_err_t err = esp_ota_begin(self->partition, OTA_WITH_SEQUENTIAL_WRITES, &self->handle);
+    if (err != ESP_OK) {
+        vSemaphoreDelete(self->idle);
+        CHECK_ESP_RESULT(err);
+    }
+    // The task is not pinned, so on dual core chips flash writes can run on
+    // the other core while the VM receives and hashes the next buffer.
+    if (xTaskCreatePinnedToCore(update_task, "dualbank", 4096, self,
+        CONFIG_PTHREAD_TASK_PRIO_DEFAULT, &self->task, tskNO_AFFINITY) != pdPASS) {
+        esp_ota_abort(self->handle);
+        vSemaphoreDelete(self->idle);
+        self->task = NULL;
+        mp_raise_espidf_MemoryError();
+    }
+    self->err = ESP_OK;
+    self->pending = NULL;
+    self->busy = false;
+    self->written = 0;
+    self->fill = 0;
+    self->fill_len = 0;
+    mbedtls_sha256_init(&self->sha256);
+    mbedtls_sha256_starts(&self->sha256, 0);
+    MP_STATE_PORT(dualbank_update) = self;
+}
+
+bool common_hal_dualbank_update_deinited(dualbank_update_obj_t *self) {
+    return self->task == NULL;
+}
+
+void common_hal_dualbank_update_deinit(dualbank_update_obj_t *self) {
+    if (common_hal_dualbank_update_deinited(self)) {
+        return;
+    }
+    // The task may still be using one of the buffers.
+    wait_for_task(self);
+    vTaskDelete(self->task);
+    self->task = NULL;
+    vSemaphoreDelete(self->idle);
+    if (self->handle != 0) {
+        esp_ota_abort(self->handle);
+        self->handle = 0;
+    }
+    mbedtls_sha256_free(&self->sha256);
+    self->buf[0] = NULL;
+    self->buf[1] = NULL;
+    MP_STATE_PORT(dualbank_update) = NULL;
+}
+
+void common_hal_dualbank_update_write(dualbank_update_obj_t *self, const uint8_t *buf, size_t len) {
+    if (len > self->partition->size - self->written) {
+        common_hal_dualbank_update_deinit(self);
+        mp_raise_RuntimeError(MP_ERROR_TEXT("Firmware is too big"));
+    }
+    // Hashed here while the task writes the previous buffer.
+    mbedtls_sha256_update(&self->sha256, buf, len);
+    self->written += len;
+    while (len > 0) {
+        size_t n = MIN(len, CIRCUITPY_DUALBANK_UPDATE_BUFFER_SIZE - self->fill_len);
+        memcpy(self->buf[self->fill] + self->fill_len, buf, n);
+        self->fill_len += n;
+        buf += n;
+        len -= n;
+        if (self->fill_len == CIRCUITPY_DUALBANK_UPDATE_BUFFER_SIZE) {
+            write_buffer(self);
+        }
+    }
+}
+
+void common_hal_dualbank_update_get_sha256(dualbank_update_obj_t *self, uint8_t *digest) {
+    mbedtls_sha256_context copy;
+    mbedtls_sha256_init(&copy);
+    mbedtls_sha256_clone(&copy, &self->sha256);
+    mbedtls_sha256_finish(&copy, digest);
+    mbedtls_sha256_free(&copy);
+}
+
+size_t common_hal_dualbank_update_get_written(dualbank_update_obj_t *self) {
+    return self->written;
+}
+
+void common_hal_dualbank_update_commit(dualbank_update_obj_t *self) {
+    if (self->fill_len > 0) {
+        write_buffer(self);
+    }
+    wait_for_task(self);
+    if (self->err != ESP_OK) {
+        update_failed(self, self->err);
+    }
+    if (self->expected_size != 0 && self->written != self->expected_size) {
+        update_failed(self, ESP_ERR_OTA_VALIDATE_FAILED);
+    }
+    if (self->check_sha256) {
+        uint8_t digest[32];
+        common_hal_dualbank_update_get_sha256(self, digest);
+        if (memcmp(digest, self->expected_sha256, sizeof(digest)) != 0) {
+            update_failed(self, ESP_ERR_OTA_VALIDATE_FAILED);
+        }
+    }
+    // Checks the image that was written. Nothing changes at boot until it passes.
+    esp_err_t err = esp_ota_end(self->handle);
+    self->handle = 0;
+    if (err == ESP_OK) {
+        err = esp_ota_set_boot_partition(self->partition);
+    }
+    if (err != ESP_OK) {
+        update_failed(self, err);
+    }
+    common_hal_dualbank_update_deinit(self);
+}
+
+void dualbank_update_reset(void) {
+    if (MP_STATE_PORT(dualbank_update) != NULL) {
+        common_hal_dualbank_update_deinit(MP_STATE_PORT(dualbank_update));
+    }
+}
+
+MP_REGISTER_ROOT_POINTER(struct _dualbank_update_obj_t *dualbank_update);
@@ -0,0 +1,45 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+#include "esp_ota_ops.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "mbedtls/sha256.h"
+
+// Bytes collected before each flash write. One flash sector, so that the
+// sector erase and the write go together.
+#ifndef CIRCUITPY_DUALBANK_UPDATE_BUFFER_SIZE
+#define CIRCUITPY_DUALBANK_UPDATE_BUFFER_SIZE (4096)
+#endif
+
+typedef struct _dualbank_update_obj_t {
+    mp_obj_base_t base;
+    const esp_partition_t *partition;
+    esp_ota_handle_t handle;
+    // Erases and writes each full buffer while the VM fills the other one.
+    TaskHandle_t task;
+    SemaphoreHandle_t idle;
+    uint8_t *buf[2];
+    // Handed to the task. Only touched by the VM while the task is idle.
+    const uint8_t *pending;
+    size_t pending_len;
+    volatile esp_err_t err;
+    mbedtls_sha256_context sha256;
+    uint8_t expected_sha256[32];
+    size_t expected_size;
+    size_t written;
+    size_t fill_len;
+    uint8_t fill;
+    bool busy;
+    bool check_sha256;
+} dualbank_update_obj_t;
+
+extern void dualbank_update_reset(void);
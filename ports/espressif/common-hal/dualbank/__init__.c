@@ -6,6 +6,7 @@
 
 #include "common-hal/dualbank/__init__.h"
 #include "shared-bindings/dualbank/__init__.h"
+#include "common-hal/dualbank/Update.h"
 
 #include <string.h>
 
@@ -19,6 +20,7 @@ static esp_ota_handle_t update_handle = 0;
 static const char *TAG = "dualbank";
 
 void dualbank_reset(void) {
+    dualbank_update_reset();
     if (esp_ota_abort(update_handle) == ESP_OK) {
         update_handle = 0;
         update_partition = NULL;
@@ -30,11 +32,50 @@ static void __attribute__((noreturn)) task_fatal_error(void) {
     mp_raise_RuntimeError(MP_ERROR_TEXT("Update Failed"));
 }
 
+// Check the app description at the start of a new image against the running
+// and last invalid firmware.
+void dualbank_check_new_firmware(const void *buf, size_t len) {
+    if (len <= sizeof(esp_image_header_t) + sizeof(esp_image_segment_header_t) + sizeof(esp_app_desc_t)) {
+        ESP_LOGE(TAG, "received package is not fit len");
+        mp_raise_RuntimeError(MP_ERROR_TEXT("Firmware is too big"));
+    }
+
+    const esp_partition_t *running = esp_ota_get_running_partition();
+    const esp_partition_t *last_invalid = esp_ota_get_last_invalid_partition();
+
+    esp_app_desc_t new_app_info;
+    memcpy(&new_app_info, &((char *)buf)[sizeof(esp_image_header_t) + sizeof(esp_image_segment_header_t)], sizeof(esp_app_desc_t));
+    ESP_LOGI(TAG, "New firmware version: %s", new_app_info.version);
+
+    esp_app_desc_t running_app_info;
+    if (esp_ota_get_partition_description(running, &running_app_info) == ESP_OK) {
+        ESP_LOGI(TAG, "Running firmware version: %s", running_app_info.version);
+    }
+
+    esp_app_desc_t invalid_app_info;
+    if (esp_ota_get_partition_description(last_invalid, &invalid_app_info) == ESP_OK) {
+        ESP_LOGI(TAG, "Last invalid firmware version: %s", invalid_app_info.version);
+    }
+
+    // check new version with running version
+    if (memcmp(new_app_info.version, running_app_info.version, sizeof(new_app_info.version)) == 0) {
+        ESP_LOGW(TAG, "New version is the same as running version.");
+        mp_raise_RuntimeError(MP_ERROR_TEXT("Firmware is duplicate"));
+    }
+
+    // check new version with last invalid partition
+    if (last_invalid != NULL) {
+        if (memcmp(new_app_info.version, invalid_app_info.version, sizeof(new_app_info.version)) == 0) {
+            ESP_LOGW(TAG, "New version is the same as invalid version.");
+            mp_raise_RuntimeError(MP_ERROR_TEXT("Firmware is invalid"));
+        }
+    }
+}
+
 void common_hal_dualbank_flash(const void *buf, const size_t len, const size_t offset) {
     esp_err_t err;
 
     const esp_partition_t *running = esp_ota_get_running_partition();
-    const esp_partition_t *last_invalid = esp_ota_get_last_invalid_partition();
 
     if (update_partition == NULL) {
         update_partition = esp_ota_get_next_update_partition(NULL);
@@ -48,43 +89,12 @@ void common_hal_dualbank_flash(const void *buf, const size_t len, const size_t o
     }
 
     if (update_handle == 0) {
-        if (len > sizeof(esp_image_header_t) + sizeof(esp_image_segment_header_t) + sizeof(esp_app_desc_t)) {
-            esp_app_desc_t new_app_info;
-            memcpy(&new_app_info, &((char *)buf)[sizeof(esp_image_header_t) + sizeof(esp_image_segment_header_t)], sizeof(esp_app_desc_t));
-            ESP_LOGI(TAG, "New firmware version: %s", new_app_info.version);
-
-            esp_app_desc_t running_app_info;
-            if (esp_ota_get_partition_description(running, &running_app_info) == ESP_OK) {
-                ESP_LOGI(TAG, "Running firmware version: %s", running_app_info.version);
-            }
-
-            esp_app_desc_t invalid_app_info;
-            if (esp_ota_get_partition_description(last_invalid, &invalid_app_info) == ESP_OK) {
-                ESP_LOGI(TAG, "Last invalid firmware version: %s", invalid_app_info.version);
-            }
-
-            // check new version with running version
-            if (memcmp(new_app_info.version, running_app_info.version, sizeof(new_app_info.version)) == 0) {
-                ESP_LOGW(TAG, "New version is the same as running version.");
-                mp_raise_RuntimeError(MP_ERROR_TEXT("Firmware is duplicate"));
-            }
-
-            // check new version with last invalid partition
-            if (last_invalid != NULL) {
-                if (memcmp(new_app_info.version, invalid_app_info.version, sizeof(new_app_info.version)) == 0) {
-                    ESP_LOGW(TAG, "New version is the same as invalid version.");
-                    mp_raise_RuntimeError(MP_ERROR_TEXT("Firmware is invalid"));
-                }
-            }
-
-            err = esp_ota_begin(update_partition, OTA_SIZE_UNKNOWN, &update_handle);
-            if (err != ESP_OK) {
-                ESP_LOGE(TAG, "esp_ota_begin failed (%s)", esp_err_to_name(err));
-                task_fatal_error();
-            }
-        } else {
-            ESP_LOGE(TAG, "received package is not fit len");
-            mp_raise_RuntimeError(MP_ERROR_TEXT("Firmware is too big"));
+        dualbank_check_new_firmware(buf, len);
+
+        err = esp_ota_begin(update_partition, OTA_SIZE_UNKNOWN, &update_handle);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "esp_ota_begin failed (%s)", esp_err_to_name(err));
+            task_fatal_error();
         }
     }
 
@@ -6,4 +6,7 @@
 
 #pragma once
 
+#include <stddef.h>
+
 extern void dualbank_reset(void);
+extern void dualbank_check_new_firmware(const void *buf, size_t len);
@@ -10,11 +10,14 @@
 #include "esp_camera.h"
 #include "shared-bindings/pwmio/PWMOut.h"
 #include "common-hal/busio/I2C.h"
+#include "shared-module/displayio/Bitmap.h"
 
 typedef struct espcamera_camera_obj {
     mp_obj_base_t base;
     camera_config_t camera_config;
     camera_fb_t *buffer_to_return;
+    // The Bitmap returned by take(), repointed at each new frame.
+    displayio_bitmap_t *bitmap;
     pwmio_pwmout_obj_t pwm;
     busio_i2c_obj_t *i2c;
 } espcamera_obj_t;
@@ -7,6 +7,8 @@
 //
 // SPDX-License-Identifier: MIT
 
+#include <string.h>
+
 #include "py/mperrno.h"
 #include "py/runtime.h"
 
@@ -68,14 +70,10 @@ static void send_cb(const uint8_t *mac, esp_now_send_status_t status) {
 // Callback triggered when an ESP-NOW packet is received.
 // Write the peer MAC address and the message into the recv_buffer as an ESPNow packet.
 // If the buffer is full, drop the message and increment the dropped count.
+// This runs on the WiFi task while the VM reads, so the whole packet goes in
+// with one put and the VM never sees half of one.
 static void recv_cb(const esp_now_recv_info_t *esp_now_info, const uint8_t *msg, int msg_len) {
     espnow_obj_t *self = MP_STATE_PORT(espnow_singleton);
-    ringbuf_t *buf = self->recv_buffer;
-
-    if (sizeof(espnow_packet_t) + msg_len > ringbuf_num_empty(buf)) {
-        self->read_failure++;
-        return;
-    }
 
     // Get the RSSI value from the wifi packet header
     // Secret magic to get the rssi from the wifi packet header
@@ -90,15 +88,20 @@ static void recv_cb(const esp_now_recv_info_t *esp_now_info, const uint8_t *msg,
         msg - SIZEOF_ESPNOW_FRAME_FORMAT - sizeof(wifi_promiscuous_pkt_t));
     #pragma GCC diagnostic pop
 
-    espnow_header_t header;
-    header.magic = ESPNOW_MAGIC;
-    header.msg_len = msg_len;
-    header.rssi = wifi_packet->rx_ctrl.rssi;
-    header.time_ms = mp_hal_ticks_ms();
-
-    ringbuf_put_n(buf, (uint8_t *)&header, sizeof(header));
-    ringbuf_put_n(buf, esp_now_info->src_addr, ESP_NOW_ETH_ALEN);
-    ringbuf_put_n(buf, msg, msg_len);
+    uint8_t packet_buf[MAX_PACKET_LEN];
+    espnow_packet_t *packet = (espnow_packet_t *)packet_buf;
+    packet->header.magic = ESPNOW_MAGIC;
+    packet->header.msg_len = msg_len;
+    packet->header.rssi = wifi_packet->rx_ctrl.rssi;
+    packet->header.time_ms = mp_hal_ticks_ms();
+    memcpy(packet->peer, esp_now_info->src_addr, ESP_NOW_ETH_ALEN);
+    memcpy(packet->msg, msg, msg_len);
+
+    size_t packet_len = sizeof(espnow_packet_t) + msg_len;
+    if (ringbuf_spsc_put_n(self->recv_buffer, packet_buf, packet_len) != packet_len) {
+        self->read_failure++;
+        return;
+    }
 
     self->read_success++;
 }
@@ -122,8 +125,8 @@ void common_hal_espnow_init(espnow_obj_t *self) {
         return;
     }
 
-    self->recv_buffer = m_new_obj(ringbuf_t);
-    if (!ringbuf_alloc(self->recv_buffer, self->recv_buffer_size /*, true*/)) {
+    self->recv_buffer = m_new_obj(ringbuf_spsc_t);
+    if (!ringbuf_spsc_alloc(self->recv_buffer, self->recv_buffer_size)) {
         m_malloc_fail(self->recv_buffer_size);
     }
 
@@ -186,13 +189,13 @@ mp_obj_t common_hal_espnow_send(espnow_obj_t *self, const mp_buffer_info_t *mess
 }
 
 mp_obj_t common_hal_espnow_read(espnow_obj_t *self) {
-    if (!ringbuf_num_filled(self->recv_buffer)) {
+    if (!ringbuf_spsc_num_filled(self->recv_buffer)) {
         return mp_const_none;
     }
 
     // Read the packet header from the incoming buffer
     espnow_header_t header;
-    if (ringbuf_get_n(self->recv_buffer, (uint8_t *)&header, sizeof(header)) != sizeof(header)) {
+    if (ringbuf_spsc_get_n(self->recv_buffer, (uint8_t *)&header, sizeof(header)) != sizeof(header)) {
         mp_arg_error_invalid(MP_QSTR_buffer);
     }
 
@@ -204,8 +207,8 @@ mp_obj_t common_hal_espnow_read(espnow_obj_t *self) {
     // Check the message packet header format and read the message data
     if (header.magic != ESPNOW_MAGIC ||
         msg_len > ESP_NOW_MAX_DATA_LEN ||
-        ringbuf_get_n(self->recv_buffer, mac_buf, ESP_NOW_ETH_ALEN) != ESP_NOW_ETH_ALEN ||
-        ringbuf_get_n(self->recv_buffer, msg_buf, msg_len) != msg_len) {
+        ringbuf_spsc_get_n(self->recv_buffer, mac_buf, ESP_NOW_ETH_ALEN) != ESP_NOW_ETH_ALEN ||
+        ringbuf_spsc_get_n(self->recv_buffer, msg_buf, msg_len) != msg_len) {
         mp_arg_error_invalid(MP_QSTR_buffer);
     }
 
@@ -218,3 +221,41 @@ mp_obj_t common_hal_espnow_read(espnow_obj_t *self) {
 
     return namedtuple_make_new((const mp_obj_type_t *)&espnow_packet_type_obj, 4, 0, elems);
 }
+
+size_t common_hal_espnow_read_into(espnow_obj_t *self, uint8_t *buf, size_t buf_len, int32_t *index, size_t max_packets) {
+    ringbuf_spsc_t *r = self->recv_buffer;
+    size_t count = 0;
+    size_t offset = 0;
+
+    while (count < max_packets && ringbuf_spsc_num_filled(r) >= MIN_PACKET_LEN) {
+        // Peek at the message length, so that a packet that doesn't fit stays queued.
+        uint8_t msg_len;
+        ringbuf_spsc_peek_n(r, offsetof(espnow_header_t, msg_len), &msg_len, 1);
+        if (ESP_NOW_ETH_ALEN + msg_len > buf_len - offset) {
+            break;
+        }
+
+        // Copy the peer address and message straight into the caller's buffer.
+        espnow_header_t header;
+        uint8_t *dest = buf + offset;
+        if (ringbuf_spsc_get_n(r, (uint8_t *)&header, sizeof(header)) != sizeof(header) ||
+            header.magic != ESPNOW_MAGIC ||
+            header.msg_len != msg_len ||
+            msg_len > ESP_NOW_MAX_DATA_LEN ||
+            ringbuf_spsc_get_n(r, dest, ESP_NOW_ETH_ALEN) != ESP_NOW_ETH_ALEN ||
+            ringbuf_spsc_get_n(r, dest + ESP_NOW_ETH_ALEN, msg_len) != msg_len) {
+            mp_arg_error_invalid(MP_QSTR_buffer);
+        }
+
+        int32_t *entry = index + count * ESPNOW_READ_INTO_FIELDS;
+        entry[0] = offset;
+        entry[1] = msg_len;
+        entry[2] = header.rssi;
+        entry[3] = header.time_ms;
+
+        offset += ESP_NOW_ETH_ALEN + msg_len;
+        count++;
+    }
+
+    return count;
+}
@@ -15,7 +15,8 @@
 
 typedef struct _espnow_obj_t {
     mp_obj_base_t base;
-    ringbuf_t *recv_buffer;
+    // Filled by recv_cb() on the WiFi task and drained by the VM.
+    ringbuf_spsc_t *recv_buffer;
     size_t recv_buffer_size;
     wifi_phy_rate_t phy_rate;
     espnow_peers_obj_t *peers;
@@ -37,3 +38,7 @@ extern void common_hal_espnow_set_pmk(espnow_obj_t *self, const uint8_t *key);
 
 extern mp_obj_t common_hal_espnow_send(espnow_obj_t *self, const mp_buffer_info_t *message, const uint8_t *mac);
 extern mp_obj_t common_hal_espnow_read(espnow_obj_t *self);
+
+// Entries written to the index array for each packet by read_into.
+#define ESPNOW_READ_INTO_FIELDS (4)
+extern size_t common_hal_espnow_read_into(espnow_obj_t *self, uint8_t *buf, size_t buf_len, int32_t *index, size_t max_packets);
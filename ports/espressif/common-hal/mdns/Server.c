@@ -6,10 +6,14 @@
 
 #include "shared-bindings/mdns/Server.h"
 
+#include <string.h>
+#include <strings.h>
+
 #include "py/gc.h"
 #include "py/runtime.h"
 #include "shared-bindings/mdns/RemoteService.h"
 #include "shared-bindings/wifi/__init__.h"
+#include "supervisor/shared/tick.h"
 
 #include "mdns.h"
 
@@ -18,6 +22,16 @@
 // could be created.)
 static mdns_server_obj_t *_active_object = NULL;
 
+// Hostnames are stored without ".local". A single mDNS label is at most 63
+// characters.
+typedef struct {
+    uint64_t expires_ms;
+    uint32_t addr;
+    char hostname[64];
+} mdns_cache_entry_t;
+
+static mdns_cache_entry_t _cache[CIRCUITPY_MDNS_CACHE_SIZE];
+
 void mdns_server_construct(mdns_server_obj_t *self, bool workflow) {
     if (_active_object != NULL) {
         if (self == _active_object) {
@@ -74,6 +88,8 @@ void common_hal_mdns_server_deinit(mdns_server_obj_t *self) {
     self->inited = false;
     _active_object = NULL;
     mdns_free();
+    // Another network may reuse the names.
+    memset(_cache, 0, sizeof(_cache));
 }
 
 void mdns_server_deinit_singleton(void) {
@@ -144,6 +160,68 @@ size_t mdns_server_find(mdns_server_obj_t *self, const char *service_type, const
     return num_results;
 }
 
+bool mdns_server_resolve_local(const char *host, uint32_t *addr) {
+    const size_t suffix_len = sizeof(".local") - 1;
+    size_t len = strlen(host);
+    if (_active_object == NULL || len <= suffix_len || strcasecmp(host + len - suffix_len, ".local") != 0) {
+        return false;
+    }
+    len -= suffix_len;
+    if (len >= sizeof(_cache[0].hostname)) {
+        return false;
+    }
+
+    // Answer from the cache while the entry is live, otherwise query into
+    // the entry that expires first.
+    uint64_t now = supervisor_ticks_ms64();
+    mdns_cache_entry_t *slot = &_cache[0];
+    for (size_t i = 0; i < CIRCUITPY_MDNS_CACHE_SIZE; i++) {
+        mdns_cache_entry_t *entry = &_cache[i];
+        if (entry->expires_ms > now && strncasecmp(entry->hostname, host, len) == 0 && entry->hostname[len] == '\0') {
+            *addr = entry->addr;
+            return true;
+        }
+        if (entry->expires_ms < slot->expires_ms) {
+            slot = entry;
+        }
+    }
+
+    char hostname[sizeof(slot->hostname)];
+    memcpy(hostname, host, len);
+    hostname[len] = '\0';
+    mdns_search_once_t *search = mdns_query_async_new(hostname, NULL, NULL, MDNS_TYPE_A, CIRCUITPY_MDNS_QUERY_TIMEOUT_MS, 1, NULL);
+    if (search == NULL) {
+        return false;
+    }
+    uint8_t num_results;
+    mdns_result_t *results;
+    while (!mdns_query_async_get_results(search, 1, &results, &num_results)) {
+        RUN_BACKGROUND_TASKS;
+    }
+    mdns_query_async_delete(search);
+
+    bool found = false;
+    uint32_t ttl = 0;
+    for (mdns_result_t *result = results; result != NULL && !found; result = result->next) {
+        for (mdns_ip_addr_t *ip = result->addr; ip != NULL; ip = ip->next) {
+            if (ip->addr.type == ESP_IPADDR_TYPE_V4) {
+                *addr = ip->addr.u_addr.ip4.addr;
+                ttl = result->ttl;
+                found = true;
+                break;
+            }
+        }
+    }
+    mdns_query_results_free(results);
+
+    if (found && ttl > 0) {
+        memcpy(slot->hostname, hostname, len + 1);
+        slot->addr = *addr;
+        slot->expires_ms = supervisor_ticks_ms64() + ttl * 1000ULL;
+    }
+    return found;
+}
+
 mp_obj_t common_hal_mdns_server_find(mdns_server_obj_t *self, const char *service_type, const char *protocol, mp_float_t timeout) {
     mdns_search_once_t *search = mdns_query_async_new(NULL, service_type, protocol, MDNS_TYPE_PTR, timeout * 1000, 255, NULL);
     if (search == NULL) {
@@ -8,6 +8,17 @@
 
 #include "py/obj.h"
 
+// How many .local hostname lookups to remember, each for as long as its
+// answer's TTL.
+#ifndef CIRCUITPY_MDNS_CACHE_SIZE
+#define CIRCUITPY_MDNS_CACHE_SIZE (4)
+#endif
+
+// How long to wait for a .local hostname to answer, in milliseconds.
+#ifndef CIRCUITPY_MDNS_QUERY_TIMEOUT_MS
+#define CIRCUITPY_MDNS_QUERY_TIMEOUT_MS (1000)
+#endif
+
 typedef struct {
     mp_obj_base_t base;
     const char *hostname;
@@ -18,3 +29,9 @@ typedef struct {
 } mdns_server_obj_t;
 
 void mdns_server_deinit_singleton(void);
+
+// Looks up the IPv4 address of a .local host with mDNS, answering from the
+// cache while the last answer is still live. Returns false when the host
+// isn't a .local name, mDNS isn't running or nothing answered. The address is
+// stored in network byte order.
+bool mdns_server_resolve_local(const char *host, uint32_t *addr);
@@ -18,11 +18,33 @@
 #error "CircuitPython RMT callback is not IRAM safe"
 #endif
 
+// The most RMT symbols, two pulses each, captured by one receive. Chips with
+// RX ping-pong copy symbols out of the channel memory as they arrive, so a
+// transmission can be longer than the channel memory. Other chips can only
+// capture what fits in it.
+#ifndef CIRCUITPY_PULSEIN_RMT_MAX_SYMBOLS
+#if SOC_RMT_SUPPORT_RX_PINGPONG
+#define CIRCUITPY_PULSEIN_RMT_MAX_SYMBOLS (256)
+#else
+#define CIRCUITPY_PULSEIN_RMT_MAX_SYMBOLS (SOC_RMT_MEM_WORDS_PER_CHANNEL)
+#endif
+#endif
+
 static const rmt_receive_config_t rx_config = {
     .signal_range_min_ns = 1250, // 1.25 microseconds
     .signal_range_max_ns = 0xffff * 1000, // ~65 milliseconds
 };
 
+// Adds a pulse, dropping the oldest one when the buffer is full.
+static void _push(pulseio_pulsein_obj_t *self, uint16_t val) {
+    if (self->len == self->maxlen) {
+        self->start = (self->start + 1) % self->maxlen;
+        self->len--;
+    }
+    self->buffer[(self->start + self->len) % self->maxlen] = val;
+    self->len++;
+}
+
 static bool _done_callback(rmt_channel_handle_t rx_chan,
     const rmt_rx_done_event_data_t *edata, void *user_ctx) {
     pulseio_pulsein_obj_t *self = (pulseio_pulsein_obj_t *)user_ctx;
@@ -31,7 +53,6 @@ static bool _done_callback(rmt_channel_handle_t rx_chan,
     }
 
     for (size_t i = 0; i < edata->num_symbols; i++) {
-        uint16_t pos = (self->start + self->len) % self->maxlen;
         rmt_symbol_word_t symbol = edata->received_symbols[i];
         uint32_t val = symbol.duration0 * 2;
 
@@ -43,14 +64,12 @@ static bool _done_callback(rmt_channel_handle_t rx_chan,
         }
         if (!self->find_first || symbol.level0 == !self->idle_state) {
             self->find_first = false;
-            self->buffer[pos] = (uint16_t)val;
-            self->len++;
+            _push(self, (uint16_t)val);
             if (done) {
                 break;
             }
         }
 
-        pos = (self->start + self->len) % self->maxlen;
         val = symbol.duration1 * 2;
         done = val == 0;
         // Duration of zero indicates the end of transmission which is longer
@@ -58,8 +77,7 @@ static bool _done_callback(rmt_channel_handle_t rx_chan,
         if (val == 0) {
             val = 65535;
         }
-        self->buffer[pos] = (uint16_t)val;
-        self->len++;
+        _push(self, (uint16_t)val);
         self->find_first = false;
         if (done) {
             break;
@@ -80,7 +98,7 @@ void common_hal_pulseio_pulsein_construct(pulseio_pulsein_obj_t *self, const mcu
     }
     // We add one to the maxlen version to ensure that two symbols at lease are
     // captured because we may skip the first portion of a symbol.
-    self->raw_symbols_size = MIN(64, maxlen / 2 + 1) * sizeof(rmt_symbol_word_t);
+    self->raw_symbols_size = MIN(CIRCUITPY_PULSEIN_RMT_MAX_SYMBOLS, maxlen / 2 + 1) * sizeof(rmt_symbol_word_t);
     self->raw_symbols = (rmt_symbol_word_t *)m_malloc(self->raw_symbols_size);
     if (self->raw_symbols == NULL) {
         m_free(self->buffer);
@@ -67,6 +67,8 @@ void common_hal_rotaryio_incrementalencoder_construct(rotaryio_incrementalencode
 
     pcnt_unit_enable(self->unit);
     pcnt_unit_start(self->unit);
+
+    rotaryio_velocity_reset(&self->velocity, 0);
 }
 
 bool common_hal_rotaryio_incrementalencoder_deinited(rotaryio_incrementalencoder_obj_t *self) {
@@ -90,13 +92,22 @@ mp_int_t common_hal_rotaryio_incrementalencoder_get_position(rotaryio_incrementa
     int count;
     pcnt_unit_get_count(self->unit, &count);
 
-    return (count + self->position) / self->divisor;
+    mp_int_t position = (count + self->position) / self->divisor;
+    rotaryio_velocity_update(&self->velocity, position);
+    return position;
 }
 
 void common_hal_rotaryio_incrementalencoder_set_position(rotaryio_incrementalencoder_obj_t *self,
     mp_int_t new_position) {
     self->position = new_position * self->divisor;
     pcnt_unit_clear_count(self->unit);
+    rotaryio_velocity_reset(&self->velocity, new_position);
+}
+
+mp_float_t common_hal_rotaryio_incrementalencoder_get_velocity(rotaryio_incrementalencoder_obj_t *self) {
+    // PCNT doesn't time the edges, so note the count now.
+    common_hal_rotaryio_incrementalencoder_get_position(self);
+    return rotaryio_velocity_get(&self->velocity);
 }
 
 mp_int_t common_hal_rotaryio_incrementalencoder_get_divisor(rotaryio_incrementalencoder_obj_t *self) {
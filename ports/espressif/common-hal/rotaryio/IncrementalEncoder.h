@@ -8,6 +8,7 @@
 
 #include "py/obj.h"
 #include "driver/pulse_cnt.h"
+#include "shared-module/rotaryio/velocity.h"
 
 typedef struct {
     mp_obj_base_t base;
@@ -16,5 +17,6 @@ typedef struct {
     pcnt_unit_handle_t unit;
     pcnt_channel_handle_t channel_a;
     pcnt_channel_handle_t channel_b;
+    rotaryio_velocity_t velocity;
     int8_t divisor; // Number of quadrature edges required per count
 } rotaryio_incrementalencoder_obj_t;
@@ -23,109 +23,103 @@
 #include "components/lwip/lwip/src/include/lwip/sockets.h"
 #include "components/lwip/lwip/src/include/lwip/sys.h"
 #include "components/lwip/lwip/src/include/lwip/netdb.h"
-#include "components/vfs/include/esp_vfs_eventfd.h"
-
-StackType_t socket_select_stack[2 * configMINIMAL_STACK_SIZE];
+#include "components/lwip/lwip/src/include/lwip/api.h"
+#include "components/lwip/lwip/src/include/lwip/priv/sockets_priv.h"
 
 /* Socket state table:
  * 0 := Closed (unused)
  * 1 := Open
- * 2 := Closing (remove from rfds)
  * Index into socket_fd_state is calculated from actual lwip fd. idx := fd - LWIP_SOCKET_OFFSET
 */
 #define FDSTATE_CLOSED  0
 #define FDSTATE_OPEN    1
-#define FDSTATE_CLOSING 2
 static uint8_t socket_fd_state[CONFIG_LWIP_MAX_SOCKETS];
 
 // How long to wait between checks for a socket to connect.
 #define SOCKET_CONNECT_POLL_INTERVAL_MS 100
 
 static socketpool_socket_obj_t *user_socket[CONFIG_LWIP_MAX_SOCKETS];
-StaticTask_t socket_select_task_buffer;
-TaskHandle_t socket_select_task_handle;
-static int socket_change_fd = -1;
-
-static void socket_select_task(void *arg) {
-    uint64_t signal;
-    fd_set readfds;
-    fd_set excptfds;
-
-    while (true) {
-        FD_ZERO(&readfds);
-        FD_ZERO(&excptfds);
-        FD_SET(socket_change_fd, &readfds);
-        int max_fd = socket_change_fd;
-        for (size_t i = 0; i < MP_ARRAY_SIZE(socket_fd_state); i++) {
-            if ((socket_fd_state[i] == FDSTATE_OPEN) && (user_socket[i] == NULL)) {
-                int sockfd = i + LWIP_SOCKET_OFFSET;
-                max_fd = MAX(max_fd, sockfd);
-                FD_SET(sockfd, &readfds);
-                FD_SET(sockfd, &excptfds);
-            }
-        }
-
-        int num_triggered = select(max_fd + 1, &readfds, NULL, &excptfds, NULL);
-        // Hard error (or someone closed a socket on another thread)
-        if (num_triggered == -1) {
-            assert(errno == EBADF);
-            continue;
-        }
+static bool socket_initialized;
+
+// Workflow (non-user) sockets wake CircuitPython from lwIP's netconn event
+// callback, which runs in the tcpip thread. The callback lwIP installs for
+// its select() bookkeeping is kept and chained to.
+static netconn_callback lwip_event_callback;
+static portMUX_TYPE socket_wake_lock = portMUX_INITIALIZER_UNLOCKED;
+static bool socket_wake_armed;
+static bool socket_resuming;
+
+// Same test lwIP's select() makes, without its fd_set and semaphore setup.
+static void socket_get_ready(int fd, bool *readable, bool *writable) {
+    struct lwip_sock *sock = lwip_socket_dbg_get_socket(fd);
+    if (sock == NULL) {
+        // Report errors as ready, like select() does.
+        *readable = *writable = true;
+        return;
+    }
+    SYS_ARCH_DECL_PROTECT(lev);
+    SYS_ARCH_PROTECT(lev);
+    bool error = sock->errevent != 0;
+    *readable = error || sock->lastdata.pbuf != NULL || sock->rcvevent > 0;
+    *writable = error || sock->sendevent != 0;
+    SYS_ARCH_UNPROTECT(lev);
+}
 
-        assert(num_triggered > 0);
+static bool socket_is_workflow_readable(size_t i) {
+    if (socket_fd_state[i] != FDSTATE_OPEN || user_socket[i] != NULL) {
+        return false;
+    }
+    bool readable, writable;
+    socket_get_ready(i + LWIP_SOCKET_OFFSET, &readable, &writable);
+    return readable;
+}
 
-        // Notice event trigger
-        if (FD_ISSET(socket_change_fd, &readfds)) {
-            read(socket_change_fd, &signal, sizeof(signal));
-            num_triggered--;
-        }
+// Wake CircuitPython once; socketpool_socket_poll_resume() re-arms.
+static void socket_request_wake(void) {
+    taskENTER_CRITICAL(&socket_wake_lock);
+    bool wake = socket_wake_armed;
+    socket_wake_armed = false;
+    taskEXIT_CRITICAL(&socket_wake_lock);
+    if (wake) {
+        supervisor_workflow_request_background();
+    }
+}
 
-        // Handle active FDs, close the dead ones
-        for (size_t i = 0; i < MP_ARRAY_SIZE(socket_fd_state); i++) {
-            int sockfd = i + LWIP_SOCKET_OFFSET;
-            if (socket_fd_state[i] != FDSTATE_CLOSED) {
-                if (FD_ISSET(sockfd, &readfds) || FD_ISSET(sockfd, &excptfds)) {
-                    if (socket_fd_state[i] == FDSTATE_CLOSING) {
-                        socket_fd_state[i] = FDSTATE_CLOSED;
-                        num_triggered--;
-                    }
-                }
-            }
-        }
+static void socket_event_callback(struct netconn *conn, enum netconn_evt evt, u16_t len) {
+    lwip_event_callback(conn, evt, len);
 
-        if (num_triggered > 0) {
-            // Wake up CircuitPython by queuing request
-            supervisor_workflow_request_background();
-            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        }
+    // conn->socket is negative for accepted connections that don't have an fd yet.
+    int fd = conn->socket;
+    if (fd < LWIP_SOCKET_OFFSET || fd >= LWIP_SOCKET_OFFSET + CONFIG_LWIP_MAX_SOCKETS) {
+        return;
+    }
+    if (socket_is_workflow_readable(fd - LWIP_SOCKET_OFFSET)) {
+        socket_request_wake();
     }
+}
 
-    close(socket_change_fd);
-    socket_change_fd = -1;
-    vTaskDelete(NULL);
+// Connections accepted on a hooked socket inherit the callback from it.
+static void socket_hook_events(int fd) {
+    struct lwip_sock *sock = lwip_socket_dbg_get_socket(fd);
+    if (sock == NULL || sock->conn == NULL || sock->conn->callback == socket_event_callback) {
+        return;
+    }
+    if (lwip_event_callback == NULL) {
+        lwip_event_callback = sock->conn->callback;
+    }
+    if (lwip_event_callback != NULL) {
+        sock->conn->callback = socket_event_callback;
+    }
 }
 
 void socket_user_reset(void) {
-    if (socket_change_fd < 0) {
-        esp_vfs_eventfd_config_t config = ESP_VFS_EVENTD_CONFIG_DEFAULT();
-        ESP_ERROR_CHECK(esp_vfs_eventfd_register(&config));
-
+    if (!socket_initialized) {
         // Clear initial socket states
         for (size_t i = 0; i < MP_ARRAY_SIZE(socket_fd_state); i++) {
             socket_fd_state[i] = FDSTATE_CLOSED;
             user_socket[i] = NULL;
         }
-        socket_change_fd = eventfd(0, 0);
-        // Run this at the same priority as CP so that the web workflow background task can be
-        // queued while CP is running. Both tasks can still sleep and, therefore, sleep overall.
-        socket_select_task_handle = xTaskCreateStaticPinnedToCore(socket_select_task,
-            "socket_select",
-            2 * configMINIMAL_STACK_SIZE,
-            NULL,
-            uxTaskPriorityGet(NULL),
-            socket_select_stack,
-            &socket_select_task_buffer,
-            xPortGetCoreID());
+        socket_initialized = true;
     } else {
         // Not init - close open user sockets
         for (size_t i = 0; i < MP_ARRAY_SIZE(socket_fd_state); i++) {
@@ -136,23 +130,32 @@ void socket_user_reset(void) {
     }
 }
 
-// Unblock select task (ok if not blocked yet)
+// Re-arm the workflow wakeup after the workflow has handled its sockets. Data
+// that is still pending wakes it again straight away.
 void socketpool_socket_poll_resume(void) {
-    if (socket_select_task_handle) {
-        xTaskNotifyGive(socket_select_task_handle);
+    taskENTER_CRITICAL(&socket_wake_lock);
+    socket_wake_armed = true;
+    taskEXIT_CRITICAL(&socket_wake_lock);
+
+    // supervisor_workflow_request_background() may call back into here.
+    if (socket_resuming) {
+        return;
+    }
+    socket_resuming = true;
+    for (size_t i = 0; i < MP_ARRAY_SIZE(socket_fd_state); i++) {
+        if (socket_is_workflow_readable(i)) {
+            socket_request_wake();
+            break;
+        }
     }
+    socket_resuming = false;
 }
 
-// The writes below send an event to the socket select task so that it redoes the
-// select with the new open socket set.
-
 static bool register_open_socket(int fd) {
     if (fd < FD_SETSIZE) {
         socket_fd_state[fd - LWIP_SOCKET_OFFSET] = FDSTATE_OPEN;
         user_socket[fd - LWIP_SOCKET_OFFSET] = NULL;
-
-        uint64_t signal = 1;
-        write(socket_change_fd, &signal, sizeof(signal));
+        socket_hook_events(fd);
         socketpool_socket_poll_resume();
         return true;
     }
@@ -162,7 +165,7 @@ static bool register_open_socket(int fd) {
 static void mark_user_socket(int fd, socketpool_socket_obj_t *obj) {
     socket_fd_state[fd - LWIP_SOCKET_OFFSET] = FDSTATE_OPEN;
     user_socket[fd - LWIP_SOCKET_OFFSET] = obj;
-    // No need to wakeup select task
+    socket_hook_events(fd);
 }
 
 static bool _socketpool_socket(socketpool_socketpool_obj_t *self,
@@ -356,16 +359,10 @@ void socketpool_socket_close(socketpool_socket_obj_t *self) {
     int fd = self->num;
     // Ignore bogus/closed sockets
     if (fd >= LWIP_SOCKET_OFFSET) {
-        if (user_socket[fd - LWIP_SOCKET_OFFSET] == NULL) {
-            socket_fd_state[fd - LWIP_SOCKET_OFFSET] = FDSTATE_CLOSING;
-            lwip_shutdown(fd, SHUT_RDWR);
-            lwip_close(fd);
-        } else {
-            lwip_shutdown(fd, SHUT_RDWR);
-            lwip_close(fd);
-            socket_fd_state[fd - LWIP_SOCKET_OFFSET] = FDSTATE_CLOSED;
-            user_socket[fd - LWIP_SOCKET_OFFSET] = NULL;
-        }
+        socket_fd_state[fd - LWIP_SOCKET_OFFSET] = FDSTATE_CLOSED;
+        user_socket[fd - LWIP_SOCKET_OFFSET] = NULL;
+        lwip_shutdown(fd, SHUT_RDWR);
+        lwip_close(fd);
     }
     self->num = -1;
 }
@@ -376,24 +373,11 @@ void common_hal_socketpool_socket_close(socketpool_socket_obj_t *self) {
 
 void common_hal_socketpool_socket_connect(socketpool_socket_obj_t *self,
     const char *host, size_t hostlen, uint32_t port) {
-    const struct addrinfo hints = {
-        .ai_family = AF_INET,
-        .ai_socktype = SOCK_STREAM,
-    };
-    struct addrinfo *result_i;
-    int error = lwip_getaddrinfo(host, NULL, &hints, &result_i);
-    if (error != 0 || result_i == NULL) {
+    struct sockaddr_in dest_addr;
+    if (!socketpool_resolve_host(host, &dest_addr.sin_addr.s_addr)) {
         common_hal_socketpool_socketpool_raise_gaierror_noname();
     }
 
-    // Set parameters
-    struct sockaddr_in dest_addr;
-    #pragma GCC diagnostic push
-    #pragma GCC diagnostic ignored "-Wcast-align"
-    dest_addr.sin_addr.s_addr = ((struct sockaddr_in *)result_i->ai_addr)->sin_addr.s_addr;
-    #pragma GCC diagnostic pop
-    lwip_freeaddrinfo(result_i);
-
     dest_addr.sin_family = AF_INET;
     dest_addr.sin_port = htons(port);
 
@@ -606,24 +590,11 @@ mp_uint_t common_hal_socketpool_socket_sendto(socketpool_socket_obj_t *self,
     const char *host, size_t hostlen, uint32_t port, const uint8_t *buf, uint32_t len) {
 
     // Set parameters
-    const struct addrinfo hints = {
-        .ai_family = AF_INET,
-        .ai_socktype = SOCK_STREAM,
-    };
-    struct addrinfo *result_i;
-    int error = lwip_getaddrinfo(host, NULL, &hints, &result_i);
-    if (error != 0 || result_i == NULL) {
+    struct sockaddr_in dest_addr;
+    if (!socketpool_resolve_host(host, &dest_addr.sin_addr.s_addr)) {
         common_hal_socketpool_socketpool_raise_gaierror_noname();
     }
 
-    // Set parameters
-    struct sockaddr_in dest_addr;
-    #pragma GCC diagnostic push
-    #pragma GCC diagnostic ignored "-Wcast-align"
-    dest_addr.sin_addr.s_addr = ((struct sockaddr_in *)result_i->ai_addr)->sin_addr.s_addr;
-    #pragma GCC diagnostic pop
-    lwip_freeaddrinfo(result_i);
-
     dest_addr.sin_family = AF_INET;
     dest_addr.sin_port = htons(port);
 
@@ -653,27 +624,15 @@ int common_hal_socketpool_socket_setsockopt(socketpool_socket_obj_t *self, int l
 }
 
 bool common_hal_socketpool_readable(socketpool_socket_obj_t *self) {
-    struct timeval immediate = {0, 0};
-
-    fd_set fds;
-    FD_ZERO(&fds);
-    FD_SET(self->num, &fds);
-    int num_triggered = select(self->num + 1, &fds, NULL, &fds, &immediate);
-
-    // including returning true in the error case
-    return num_triggered != 0;
+    bool readable, writable;
+    socket_get_ready(self->num, &readable, &writable);
+    return readable;
 }
 
 bool common_hal_socketpool_writable(socketpool_socket_obj_t *self) {
-    struct timeval immediate = {0, 0};
-
-    fd_set fds;
-    FD_ZERO(&fds);
-    FD_SET(self->num, &fds);
-    int num_triggered = select(self->num + 1, NULL, &fds, &fds, &immediate);
-
-    // including returning true in the error case
-    return num_triggered != 0;
+    bool readable, writable;
+    socket_get_ready(self->num, &readable, &writable);
+    return writable;
 }
 
 void socketpool_socket_move(socketpool_socket_obj_t *self, socketpool_socket_obj_t *sock) {
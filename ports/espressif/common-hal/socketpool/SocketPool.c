@@ -14,6 +14,10 @@
 
 #include "bindings/espidf/__init__.h"
 
+#if CIRCUITPY_MDNS
+#include "common-hal/mdns/Server.h"
+#endif
+
 void common_hal_socketpool_socketpool_construct(socketpool_socketpool_obj_t *self, mp_obj_t radio) {
     if (radio != MP_OBJ_FROM_PTR(&common_hal_wifi_radio_obj)) {
         mp_raise_ValueError(MP_ERROR_TEXT("SocketPool can only be used with wifi.radio"));
@@ -22,6 +26,31 @@ void common_hal_socketpool_socketpool_construct(socketpool_socketpool_obj_t *sel
 
 // common_hal_socketpool_socket is in socketpool/Socket.c to centralize open socket tracking.
 
+bool socketpool_resolve_host(const char *host, uint32_t *addr) {
+    #if CIRCUITPY_MDNS
+    if (mdns_server_resolve_local(host, addr)) {
+        return true;
+    }
+    #endif
+
+    const struct addrinfo hints = {
+        .ai_family = AF_INET,
+        .ai_socktype = SOCK_STREAM,
+    };
+    struct addrinfo *res;
+    int err = lwip_getaddrinfo(host, NULL, &hints, &res);
+    if (err != 0 || res == NULL) {
+        return false;
+    }
+
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wcast-align"
+    *addr = ((struct sockaddr_in *)res->ai_addr)->sin_addr.s_addr;
+    #pragma GCC diagnostic pop
+    lwip_freeaddrinfo(res);
+    return true;
+}
+
 mp_obj_t common_hal_socketpool_socketpool_gethostbyname(socketpool_socketpool_obj_t *self,
     const char *host) {
 
@@ -35,24 +64,14 @@ mp_obj_t common_hal_socketpool_socketpool_gethostbyname(socketpool_socketpool_ob
         host = mp_obj_str_get_str(nodot);
     }
 
-    const struct addrinfo hints = {
-        .ai_family = AF_INET,
-        .ai_socktype = SOCK_STREAM,
-    };
-    struct addrinfo *res;
-    int err = lwip_getaddrinfo(host, NULL, &hints, &res);
-    if (err != 0 || res == NULL) {
+    struct in_addr addr;
+    if (!socketpool_resolve_host(host, &addr.s_addr)) {
         return mp_const_none;
     }
 
-    #pragma GCC diagnostic push
-    #pragma GCC diagnostic ignored "-Wcast-align"
-    struct in_addr *addr = &((struct sockaddr_in *)res->ai_addr)->sin_addr;
-    #pragma GCC diagnostic pop
     char ip_str[IP4ADDR_STRLEN_MAX];
-    inet_ntoa_r(*addr, ip_str, IP4ADDR_STRLEN_MAX);
+    inet_ntoa_r(addr, ip_str, IP4ADDR_STRLEN_MAX);
     mp_obj_t ip_obj = mp_obj_new_str(ip_str, strlen(ip_str));
-    lwip_freeaddrinfo(res);
 
     return ip_obj;
 }
@@ -11,3 +11,7 @@
 typedef struct {
     mp_obj_base_t base;
 } socketpool_socketpool_obj_t;
+
+// Looks up the IPv4 address of host, in network byte order. .local names are
+// answered by mDNS when it is running, using its cache of recent answers.
+bool socketpool_resolve_host(const char *host, uint32_t *addr);
@@ -21,6 +21,8 @@
 #include "shared-module/ipaddress/__init__.h"
 
 #include "components/esp_wifi/include/esp_wifi.h"
+#include "esp_attr.h"
+#include "soc/soc_caps.h"
 #include "components/lwip/include/apps/ping/ping_sock.h"
 
 #if CIRCUITPY_MDNS
@@ -29,6 +31,31 @@
 
 #define MAC_ADDRESS_LENGTH 6
 
+#if CIRCUITPY_WIFI_FAST_RECONNECT
+// The access point and channel of the last network joined, so that joining it
+// again after a reload or deep sleep can skip the scan of every channel.
+typedef struct {
+    uint32_t ssid_hash;
+    uint8_t bssid[MAC_ADDRESS_LENGTH];
+    uint8_t channel;
+} fast_reconnect_t;
+
+#if SOC_RTC_MEM_SUPPORTED
+static RTC_DATA_ATTR fast_reconnect_t fast_reconnect;
+#else
+static fast_reconnect_t fast_reconnect;
+#endif
+
+static uint32_t ssid_hash(const uint8_t *ssid, size_t ssid_len) {
+    // FNV-1a. Never zero, so zero marks an empty entry.
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < ssid_len; i++) {
+        hash = (hash ^ ssid[i]) * 16777619u;
+    }
+    return hash | 1;
+}
+#endif
+
 static void set_mode_station(wifi_radio_obj_t *self, bool state) {
     wifi_mode_t next_mode;
     if (state) {
@@ -268,6 +295,23 @@ mp_obj_t common_hal_wifi_radio_get_stations_ap(wifi_radio_obj_t *self) {
     return mp_sta_list;
 }
 
+static EventBits_t wait_for_connection(wifi_radio_obj_t *self, uint32_t end_time) {
+    EventBits_t bits;
+    do {
+        RUN_BACKGROUND_TASKS;
+        bits = xEventGroupWaitBits(self->event_group_handle,
+            WIFI_CONNECTED_BIT | WIFI_DISCONNECTED_BIT,
+            pdTRUE,
+            pdTRUE,
+            0);
+        // Don't retry anymore if we're over our time budget.
+        if (self->retries_left > 0 && common_hal_time_monotonic_ms() > end_time) {
+            self->retries_left = 0;
+        }
+    } while ((bits & (WIFI_CONNECTED_BIT | WIFI_DISCONNECTED_BIT)) == 0 && !mp_hal_is_interrupted());
+    return bits;
+}
+
 wifi_radio_error_t common_hal_wifi_radio_connect(wifi_radio_obj_t *self, uint8_t *ssid, size_t ssid_len, uint8_t *password, size_t password_len, uint8_t channel, mp_float_t timeout, uint8_t *bssid, size_t bssid_len) {
     if (!common_hal_wifi_radio_get_enabled(self)) {
         mp_raise_RuntimeError(MP_ERROR_TEXT("wifi is not enabled"));
@@ -337,23 +381,43 @@ wifi_radio_error_t common_hal_wifi_radio_connect(wifi_radio_obj_t *self, uint8_t
     } else {
         config->sta.scan_method = WIFI_FAST_SCAN;
     }
+    #if CIRCUITPY_WIFI_FAST_RECONNECT
+    // Go straight to the access point used last time unless told where to look.
+    uint32_t hash = ssid_hash(ssid, ssid_len);
+    bool use_cache = config->sta.scan_method == WIFI_ALL_CHANNEL_SCAN && fast_reconnect.ssid_hash == hash;
+    if (use_cache) {
+        memcpy(&config->sta.bssid, fast_reconnect.bssid, MAC_ADDRESS_LENGTH);
+        config->sta.bssid_set = true;
+        config->sta.channel = fast_reconnect.channel;
+        config->sta.scan_method = WIFI_FAST_SCAN;
+    }
+    #endif
     esp_wifi_set_config(ESP_IF_WIFI_STA, config);
     self->starting_retries = 5;
     self->retries_left = 5;
+    #if CIRCUITPY_WIFI_FAST_RECONNECT
+    if (use_cache) {
+        // Fall back to a full scan soon if the access point has moved.
+        self->retries_left = 1;
+    }
+    #endif
     esp_wifi_connect();
 
-    do {
-        RUN_BACKGROUND_TASKS;
-        bits = xEventGroupWaitBits(self->event_group_handle,
-            WIFI_CONNECTED_BIT | WIFI_DISCONNECTED_BIT,
-            pdTRUE,
-            pdTRUE,
-            0);
-        // Don't retry anymore if we're over our time budget.
-        if (self->retries_left > 0 && common_hal_time_monotonic_ms() > end_time) {
-            self->retries_left = 0;
-        }
-    } while ((bits & (WIFI_CONNECTED_BIT | WIFI_DISCONNECTED_BIT)) == 0 && !mp_hal_is_interrupted());
+    bits = wait_for_connection(self, end_time);
+
+    #if CIRCUITPY_WIFI_FAST_RECONNECT
+    if (use_cache && (bits & WIFI_DISCONNECTED_BIT) != 0 && !mp_hal_is_interrupted()) {
+        // The cached access point didn't answer, so forget it and scan.
+        fast_reconnect.ssid_hash = 0;
+        config->sta.bssid_set = false;
+        config->sta.channel = 0;
+        config->sta.scan_method = WIFI_ALL_CHANNEL_SCAN;
+        esp_wifi_set_config(ESP_IF_WIFI_STA, config);
+        self->retries_left = self->starting_retries;
+        esp_wifi_connect();
+        bits = wait_for_connection(self, end_time);
+    }
+    #endif
 
     if ((bits & WIFI_DISCONNECTED_BIT) != 0) {
         if (
@@ -370,6 +434,14 @@ wifi_radio_error_t common_hal_wifi_radio_connect(wifi_radio_obj_t *self, uint8_t
     } else {
         // We're connected, allow us to retry if we get disconnected.
         self->retries_left = self->starting_retries;
+        #if CIRCUITPY_WIFI_FAST_RECONNECT
+        wifi_ap_record_t record;
+        if (esp_wifi_sta_get_ap_info(&record) == ESP_OK) {
+            fast_reconnect.ssid_hash = hash;
+            memcpy(fast_reconnect.bssid, record.bssid, MAC_ADDRESS_LENGTH);
+            fast_reconnect.channel = record.primary;
+        }
+        #endif
     }
     return WIFI_RADIO_ERROR_NONE;
 }
@@ -22,6 +22,24 @@
 #define MICROPY_NLR_SETJMP                  (1)
 #define CIRCUITPY_DEFAULT_STACK_SIZE        0x6000
 
+// PSRAM heaps are large enough that big allocations benefit from skipping the
+// linear allocation table scan.
+#define MICROPY_GC_FREE_RUN_INDEX           (8)
+// Sweeping a PSRAM heap in one go stalls displayio and audio for tens of ms.
+#define MICROPY_GC_INCREMENTAL_SWEEP        (1)
+#ifdef CONFIG_SPIRAM
+// Keep bound methods, frames and small tuples in internal RAM when it has room,
+// and put larger objects, like buffers and bitmaps, in PSRAM.
+#define MICROPY_GC_HOT_ALLOC_MAX_BYTES      (64)
+#endif
+
+// Speed up interning when importing large libraries.
+#define MICROPY_QSTR_SORTED_INDEX           (1)
+#define MICROPY_QSTR_HASH_INDEX             (1)
+
+// Driver loops are dominated by attribute and global lookups.
+#define MICROPY_OPT_LOAD_ATTR_INLINE_CACHE  (1)
+
 // Nearly all boards have this because it is used to enter the ROM bootloader.
 #ifndef CIRCUITPY_BOOT_BUTTON
   #if defined(CONFIG_IDF_TARGET_ESP32C2) || defined(CONFIG_IDF_TARGET_ESP32C3) || defined(CONFIG_IDF_TARGET_ESP32C6) || defined(CONFIG_IDF_TARGET_ESP32H2)
@@ -43,6 +61,12 @@
 #define CIRCUITPY_INTERNAL_NVM_SIZE (8 * 1024)
 #endif
 
+// Remember the access point and channel of the last network joined in RTC
+// memory, and try them first when joining the same network again.
+#ifndef CIRCUITPY_WIFI_FAST_RECONNECT
+#define CIRCUITPY_WIFI_FAST_RECONNECT (1)
+#endif
+
 // Define to (1) in mpconfigboard.h if the board has a defined I2C port that
 // lacks pull up resistors (Espressif's HMI Devkit), and the internal pull-up
 // resistors will be enabled for all busio.I2C objects. This is only to
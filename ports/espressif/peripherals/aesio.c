@@ -0,0 +1,42 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "shared-module/aesio/__init__.h"
+
+#include "soc/soc_caps.h"
+
+#if SOC_AES_SUPPORTED
+
+#include "aes/esp_aes.h"
+
+// Below this, setting up the engine costs more than tinyaes takes.
+#ifndef CIRCUITPY_AESIO_HW_MIN_LENGTH
+#define CIRCUITPY_AESIO_HW_MIN_LENGTH (64)
+#endif
+
+bool aesio_aes_port_crypt(aesio_aes_obj_t *self, bool encrypt, uint8_t *buffer, size_t length) {
+    if (length < CIRCUITPY_AESIO_HW_MIN_LENGTH) {
+        return false;
+    }
+    esp_aes_context ctx;
+    esp_aes_init(&ctx);
+    bool ok = esp_aes_setkey(&ctx, self->ctx.RoundKey128, self->ctx.KeyLength * 8) == 0;
+    if (ok && self->mode == AES_MODE_CBC) {
+        ok = esp_aes_crypt_cbc(&ctx, encrypt ? ESP_AES_ENCRYPT : ESP_AES_DECRYPT,
+            length, self->ctx.Iv, buffer, buffer) == 0;
+    } else if (ok && self->mode == AES_MODE_CTR) {
+        // Like tinyaes, each call starts on a fresh counter block.
+        size_t nc_off = 0;
+        uint8_t stream_block[AES_BLOCKLEN];
+        ok = esp_aes_crypt_ctr(&ctx, length, &nc_off, self->ctx.Iv, stream_block, buffer, buffer) == 0;
+    } else {
+        ok = false;
+    }
+    esp_aes_free(&ctx);
+    return ok;
+}
+
+#endif
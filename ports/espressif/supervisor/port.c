@@ -64,9 +64,11 @@
 
 #include "bootloader_flash_config.h"
 
+#include "esp_cpu.h"
 #include "esp_debug_helpers.h"
 #include "esp_efuse.h"
 #include "esp_ipc.h"
+#include "esp_memory_utils.h"
 #include "esp_rom_efuse.h"
 #include "esp_timer.h"
 
@@ -310,6 +312,17 @@ void *port_malloc(size_t size, bool dma_capable) {
     return ptr;
 }
 
+// Internal RAM left for the IDF, mostly WiFi and BLE, when the GC asks for a
+// fast heap area.
+#define INTERNAL_RAM_RESERVE (48 * 1024)
+
+void *port_malloc_fast(size_t size) {
+    if (heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT) < size + INTERNAL_RAM_RESERVE) {
+        return NULL;
+    }
+    return heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+}
+
 void port_free(void *ptr) {
     heap_caps_free(ptr);
 }
@@ -323,6 +336,10 @@ size_t port_heap_get_largest_free_size(void) {
     return free_size;
 }
 
+bool port_heap_is_slow(const void *ptr) {
+    return esp_ptr_external_ram(ptr);
+}
+
 void reset_port(void) {
     // TODO deinit for esp32-camera
     #if CIRCUITPY_ESPCAMERA
@@ -377,6 +394,8 @@ void reset_port(void) {
     watchdog_reset();
     #endif
 
+    port_second_core_stop();
+
     // Yield so the idle task can run and do any IDF cleanup needed.
     port_yield();
 }
@@ -423,6 +442,10 @@ uint32_t port_get_saved_word(void) {
     return REG_READ(CP_SAVED_WORD_REGISTER);
 }
 
+uint32_t port_get_cpu_cycles(void) {
+    return esp_cpu_get_cycle_count();
+}
+
 uint64_t port_get_raw_ticks(uint8_t *subticks) {
     // Convert microseconds to subticks of 1/32768 seconds
     // 32768/1000000 = 64/15625 in lowest terms
@@ -460,6 +483,59 @@ void port_yield() {
     vTaskDelay(4);
 }
 
+#if !(defined(CONFIG_FREERTOS_UNICORE) && CONFIG_FREERTOS_UNICORE)
+static TaskHandle_t volatile second_core_task;
+static void (*_second_core_fn)(void *arg);
+static void *_second_core_arg;
+static volatile bool _second_core_stopping;
+
+static void second_core_task_fn(void *unused) {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (_second_core_stopping) {
+            break;
+        }
+        _second_core_fn(_second_core_arg);
+    }
+    second_core_task = NULL;
+    vTaskDelete(NULL);
+}
+
+bool port_second_core_start(void (*fn)(void *arg), void *arg) {
+    if (second_core_task != NULL) {
+        return false;
+    }
+    _second_core_fn = fn;
+    _second_core_arg = arg;
+    _second_core_stopping = false;
+    // Pin to whichever core CircuitPython isn't using.
+    TaskHandle_t task;
+    if (xTaskCreatePinnedToCore(second_core_task_fn, "second_core", 4096, NULL,
+        CONFIG_PTHREAD_TASK_PRIO_DEFAULT, &task, !xPortGetCoreID()) != pdPASS) {
+        return false;
+    }
+    second_core_task = task;
+    return true;
+}
+
+void port_second_core_wake(void) {
+    if (second_core_task != NULL) {
+        xTaskNotifyGive(second_core_task);
+    }
+}
+
+void port_second_core_stop(void) {
+    if (second_core_task == NULL) {
+        return;
+    }
+    _second_core_stopping = true;
+    xTaskNotifyGive(second_core_task);
+    while (second_core_task != NULL) {
+        vTaskDelay(1);
+    }
+}
+#endif
+
 void sleep_timer_cb(void *arg) {
     port_wake_main_task();
 }
@@ -11,6 +11,10 @@
 #include "shared/runtime/interrupt_char.h"
 #include "shared/readline/readline.h"
 
+#if CIRCUITPY_USB_CDC
+#include "shared-module/usb_cdc/__init__.h"
+#endif
+
 #include "hal/gpio_ll.h"
 
 #include "esp_err.h"
@@ -81,6 +85,9 @@ void tud_cdc_rx_wanted_cb(uint8_t itf, char wanted_char) {
 
 void tud_cdc_rx_cb(uint8_t itf) {
     (void)itf;
+    #if CIRCUITPY_USB_CDC
+    usb_cdc_poll_notify(itf);
+    #endif
     // Workaround for "press any key to enter REPL" response being delayed on espressif.
     // Wake main task when any key is pressed.
     port_wake_main_task();
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "common-hal/microcontroller/Pin.h"
+#include "shared-module/rotaryio/velocity.h"
 
 #include "py/obj.h"
 
@@ -18,6 +19,7 @@ typedef struct {
     int8_t sub_count; // count intermediate transitions between detents
     int8_t divisor; // Number of quadrature edges required per count
     mp_int_t position;
+    rotaryio_velocity_t velocity;
 } rotaryio_incrementalencoder_obj_t;
 
 
@@ -269,6 +269,15 @@ static bool adapter_on_ble_evt(ble_evt_t *ble_evt, void *self_in) {
                 conn_params.min_conn_interval > connected->conn_params.max_conn_interval) {
                 sd_ble_gap_conn_param_update(ble_evt->evt.gap_evt.conn_handle, &conn_params);
             }
+
+            // Ask for a better PHY and longer data lengths because not every central starts those
+            // itself. The central negotiates the MTU. These are nice-to-haves so ignore any errors.
+            ble_gap_phys_t const phys = {
+                .rx_phys = BLE_GAP_PHY_AUTO,
+                .tx_phys = BLE_GAP_PHY_AUTO,
+            };
+            sd_ble_gap_phy_update(ble_evt->evt.gap_evt.conn_handle, &phys);
+            sd_ble_gap_data_length_update(ble_evt->evt.gap_evt.conn_handle, NULL, NULL);
             self->current_advertising_data = NULL;
             break;
         }
@@ -505,7 +514,7 @@ static bool scan_on_ble_evt(ble_evt_t *ble_evt, void *scan_results_in) {
     return true;
 }
 
-mp_obj_t common_hal_bleio_adapter_start_scan(bleio_adapter_obj_t *self, uint8_t *prefixes, size_t prefix_length, bool extended, mp_int_t buffer_size, mp_float_t timeout, mp_float_t interval, mp_float_t window, mp_int_t minimum_rssi, bool active) {
+mp_obj_t common_hal_bleio_adapter_start_scan(bleio_adapter_obj_t *self, uint8_t *prefixes, size_t prefix_length, bool extended, mp_int_t buffer_size, mp_float_t timeout, mp_float_t interval, mp_float_t window, mp_int_t minimum_rssi, bool active, uint8_t *addresses, size_t addresses_length, mp_int_t duplicate_timeout_ms) {
     if (self->scan_results != NULL) {
         if (!shared_module_bleio_scanresults_get_done(self->scan_results)) {
             mp_raise_bleio_BluetoothError(MP_ERROR_TEXT("Scan already in progress. Stop with stop_scan."));
@@ -522,7 +531,8 @@ mp_obj_t common_hal_bleio_adapter_start_scan(bleio_adapter_obj_t *self, uint8_t
     if (self->current_advertising_data != NULL) {
         common_hal_bleio_adapter_stop_advertising(self);
     }
-    self->scan_results = shared_module_bleio_new_scanresults(buffer_size, prefixes, prefix_length, minimum_rssi);
+    self->scan_results = shared_module_bleio_new_scanresults(buffer_size, prefixes, prefix_length, minimum_rssi,
+        addresses, addresses_length, duplicate_timeout_ms);
     size_t max_packet_size = extended ? BLE_GAP_SCAN_BUFFER_EXTENDED_MAX_SUPPORTED : BLE_GAP_SCAN_BUFFER_MAX;
     uint8_t *raw_data = m_malloc(sizeof(ble_data_t) + max_packet_size);
     ble_data_t *sd_data = (ble_data_t *)raw_data;
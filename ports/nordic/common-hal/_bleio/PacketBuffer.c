@@ -45,53 +45,68 @@ static void write_to_ringbuf(bleio_packet_buffer_obj_t *self, uint8_t *data, uin
     sd_nvic_critical_region_exit(is_nested_critical_region);
 }
 
+static bool one_at_a_time(bleio_packet_buffer_obj_t *self) {
+    // Indications and writes with response wait for the peer to answer before the next one.
+    if (self->client) {
+        return self->write_type == BLE_GATT_OP_WRITE_REQ;
+    }
+    return self->write_type == BLE_GATT_HVX_INDICATION;
+}
+
 static uint32_t queue_next_write(bleio_packet_buffer_obj_t *self) {
-    // Queue up the next outgoing buffer. We use two, one that has been passed to the SD for
-    // transmission (when packet_queued is true) and the other is `pending` and can still be
-    // modified. By primarily appending to the `pending` buffer we can reduce the protocol overhead
-    // of the lower level link and ATT layers.
-    self->packet_queued = false;
-    if (self->pending_size > 0) {
-        uint16_t conn_handle = self->conn_handle;
-        uint32_t err_code;
-        if (self->client) {
-            ble_gattc_write_params_t write_params = {
-                .write_op = self->write_type,
-                .handle = self->characteristic->handle,
-                .p_value = (const uint8_t *)self->outgoing[self->pending_index],
-                .len = self->pending_size,
-            };
-
-            err_code = sd_ble_gattc_write(conn_handle, &write_params);
-        } else {
-            uint16_t hvx_len = self->pending_size;
-
-            ble_gatts_hvx_params_t hvx_params = {
-                .handle = self->characteristic->handle,
-                .type = self->write_type,
-                .offset = 0,
-                .p_len = &hvx_len,
-                .p_data = (const uint8_t *)self->outgoing[self->pending_index],
-            };
-            err_code = sd_ble_gatts_hvx(conn_handle, &hvx_params);
-        }
-        if (err_code != NRF_SUCCESS) {
-            // On error, simply skip updating the pending buffers so that the next HVC or WRITE
-            // complete event triggers another attempt.
-            return err_code;
-        }
-        self->pending_size = 0;
-        self->pending_index = (self->pending_index + 1) % 2;
-        self->packet_queued = true;
+    // Queue up the next outgoing buffer. The SD copies notifications and writes without response
+    // into its own TX queue, so we keep handing it packets until that queue is full
+    // (NRF_ERROR_RESOURCES) and several go out in each connection event. The `pending` buffer
+    // can still be modified, so when the SD can't take it yet we keep appending to it to reduce
+    // the protocol overhead of the lower level link and ATT layers.
+    if (self->pending_size == 0 || (self->packets_queued > 0 && one_at_a_time(self))) {
+        return NRF_SUCCESS;
+    }
+    uint16_t conn_handle = self->conn_handle;
+    uint32_t err_code;
+    if (self->client) {
+        ble_gattc_write_params_t write_params = {
+            .write_op = self->write_type,
+            .handle = self->characteristic->handle,
+            .p_value = (const uint8_t *)self->outgoing[self->pending_index],
+            .len = self->pending_size,
+        };
+
+        err_code = sd_ble_gattc_write(conn_handle, &write_params);
+    } else {
+        uint16_t hvx_len = self->pending_size;
+
+        ble_gatts_hvx_params_t hvx_params = {
+            .handle = self->characteristic->handle,
+            .type = self->write_type,
+            .offset = 0,
+            .p_len = &hvx_len,
+            .p_data = (const uint8_t *)self->outgoing[self->pending_index],
+        };
+        err_code = sd_ble_gatts_hvx(conn_handle, &hvx_params);
+    }
+    if (err_code != NRF_SUCCESS) {
+        // On error, simply skip updating the pending buffers so that the next HVC or WRITE
+        // complete event triggers another attempt.
+        return err_code;
     }
+    self->pending_size = 0;
+    self->pending_index = (self->pending_index + 1) % 2;
+    self->packets_queued++;
     return NRF_SUCCESS;
 }
 
+static void packets_sent(bleio_packet_buffer_obj_t *self, uint8_t count) {
+    self->packets_queued = count < self->packets_queued ? self->packets_queued - count : 0;
+    queue_next_write(self);
+}
+
 static bool packet_buffer_on_ble_client_evt(ble_evt_t *ble_evt, void *param) {
     const uint16_t evt_id = ble_evt->header.evt_id;
     bleio_packet_buffer_obj_t *self = (bleio_packet_buffer_obj_t *)param;
     if (evt_id == BLE_GAP_EVT_DISCONNECTED && self->conn_handle == ble_evt->evt.gap_evt.conn_handle) {
         self->conn_handle = BLE_CONN_HANDLE_INVALID;
+        self->packets_queued = 0;
     }
     // Check if this is a GATTC event so we can make sure the conn_handle is valid.
     if (evt_id < BLE_GATTC_EVT_BASE || evt_id > BLE_GATTC_EVT_LAST) {
@@ -116,10 +131,10 @@ static bool packet_buffer_on_ble_client_evt(ble_evt_t *ble_evt, void *param) {
             break;
         }
         case BLE_GATTC_EVT_WRITE_CMD_TX_COMPLETE:
-            queue_next_write(self);
+            packets_sent(self, ble_evt->evt.gattc_evt.params.write_cmd_tx_complete.count);
             break;
         case BLE_GATTC_EVT_WRITE_RSP:
-            queue_next_write(self);
+            packets_sent(self, 1);
             break;
         default:
             return false;
@@ -177,10 +192,15 @@ static bool packet_buffer_on_ble_server_evt(ble_evt_t *ble_evt, void *param) {
         case BLE_GAP_EVT_DISCONNECTED:
             if (self->conn_handle == ble_evt->evt.gap_evt.conn_handle) {
                 self->conn_handle = BLE_CONN_HANDLE_INVALID;
+                self->packets_queued = 0;
             }
             break;
         case BLE_GATTS_EVT_HVN_TX_COMPLETE:
-            queue_next_write(self);
+            packets_sent(self, ble_evt->evt.gatts_evt.params.hvn_tx_complete.count);
+            break;
+        case BLE_GATTS_EVT_HVC:
+            // The peer confirmed an indication.
+            packets_sent(self, 1);
             break;
         default:
             return false;
@@ -216,7 +236,7 @@ void _common_hal_bleio_packet_buffer_construct(
         ringbuf_init(&self->ringbuf, (uint8_t *)incoming_buffer, incoming_buffer_size);
     }
 
-    self->packet_queued = false;
+    self->packets_queued = 0;
     self->pending_index = 0;
     self->pending_size = 0;
     self->outgoing[0] = outgoing_buffer1;
@@ -381,12 +401,11 @@ mp_int_t common_hal_bleio_packet_buffer_write(bleio_packet_buffer_obj_t *self, c
     self->pending_size += len;
     num_bytes_written += len;
 
-    sd_nvic_critical_region_exit(is_nested_critical_region);
+    // Hand the data to the SD now if it has room for it. This stays in the critical region
+    // because the TX complete events queue packets too.
+    queue_next_write(self);
 
-    // If no writes are queued then sneak in this data.
-    if (!self->packet_queued) {
-        queue_next_write(self);
-    }
+    sd_nvic_critical_region_exit(is_nested_critical_region);
     return num_bytes_written;
 }
 
@@ -467,7 +486,7 @@ mp_int_t common_hal_bleio_packet_buffer_get_outgoing_packet_length(bleio_packet_
 
 void common_hal_bleio_packet_buffer_flush(bleio_packet_buffer_obj_t *self) {
     while ((self->pending_size != 0 ||
-            self->packet_queued) &&
+            self->packets_queued > 0) &&
            self->conn_handle != BLE_CONN_HANDLE_INVALID &&
            !mp_hal_is_interrupted()) {
         RUN_BACKGROUND_TASKS;
@@ -16,8 +16,8 @@ typedef struct {
     bleio_characteristic_obj_t *characteristic;
     // Ring buffer storing consecutive incoming values.
     ringbuf_t ringbuf;
-    // Two outgoing buffers to alternate between. One will be queued for transmission by the SD and
-    // the other is waiting to be queued and can be extended.
+    // Two outgoing buffers to alternate between. The last one handed to the SD and the other one
+    // that is waiting to be queued and can be extended.
     uint32_t *outgoing[2];
     volatile uint16_t pending_size;
     // We remember the conn_handle so we can do a NOTIFY/INDICATE to a client.
@@ -27,5 +27,6 @@ typedef struct {
     uint8_t pending_index;
     uint8_t write_type;
     bool client;
-    bool packet_queued;
+    // Packets handed to the SD that haven't been sent yet.
+    volatile uint8_t packets_queued;
 } bleio_packet_buffer_obj_t;
@@ -11,11 +11,14 @@
 #include "shared-bindings/microcontroller/__init__.h"
 #include "bindings/rp2pio/StateMachine.h"
 #include "supervisor/background_callback.h"
+#include "supervisor/filesystem.h"
+#include "supervisor/shared/trace.h"
 
 #include "py/mpstate.h"
 #include "py/runtime.h"
 
 #include "src/rp2_common/hardware_irq/include/hardware/irq.h"
+#include "src/rp2_common/hardware_timer/include/hardware/timer.h"
 
 #if CIRCUITPY_AUDIOCORE
 
@@ -114,51 +117,110 @@ static size_t audio_dma_convert_samples(audio_dma_t *dma, uint8_t *input, uint32
     return output_length_used;
 }
 
-// buffer_idx is 0 or 1.
-static void audio_dma_load_next_block(audio_dma_t *dma, size_t buffer_idx) {
-    size_t dma_channel = dma->channel[buffer_idx];
+// Convert the next piece of the sample into buffer_idx. A sample buffer larger than
+// the DMA buffer is spread over several fills. Returns false if playback was stopped.
+static bool audio_dma_fill_buffer(audio_dma_t *dma, size_t buffer_idx) {
+    if (dma->pending_input_length == 0) {
+        audioio_get_buffer_result_t get_buffer_result = audiosample_get_buffer(dma->sample,
+            dma->single_channel_output, dma->audio_channel, &dma->pending_input, &dma->pending_input_length);
 
-    audioio_get_buffer_result_t get_buffer_result;
-    uint8_t *sample_buffer;
-    uint32_t sample_buffer_length;
-    get_buffer_result = audiosample_get_buffer(dma->sample,
-        dma->single_channel_output, dma->audio_channel, &sample_buffer, &sample_buffer_length);
-
-    if (get_buffer_result == GET_BUFFER_ERROR) {
-        audio_dma_stop(dma);
-        return;
+        if (get_buffer_result == GET_BUFFER_ERROR) {
+            audio_dma_stop(dma);
+            return false;
+        }
+        dma->pending_input_done = get_buffer_result == GET_BUFFER_DONE;
     }
 
     // Convert the sample format resolution and signedness, as necessary.
     // The input sample buffer is what was read from a file, Mixer, or a raw sample buffer.
-    // The output buffer is one of the DMA buffers (passed in).
+    // The output buffer is one of the DMA buffers.
+    uint32_t input_length = dma->buffer_length[buffer_idx] * dma->sample_spacing;
+    if (dma->sample_resolution <= 8 && dma->output_resolution > 8) {
+        input_length /= 2;
+    }
+    input_length = MIN(input_length, dma->pending_input_length);
 
     size_t output_length_used = audio_dma_convert_samples(
-        dma, sample_buffer, sample_buffer_length,
+        dma, dma->pending_input, input_length,
         dma->buffer[buffer_idx], dma->buffer_length[buffer_idx]);
+    dma->pending_input += input_length;
+    dma->pending_input_length -= input_length;
+    dma->buffer_trans_count[buffer_idx] = output_length_used / dma->output_size;
 
-    dma_channel_set_read_addr(dma_channel, dma->buffer[buffer_idx], false /* trigger */);
-    dma_channel_set_trans_count(dma_channel, output_length_used / dma->output_size, false /* trigger */);
-
-    if (get_buffer_result == GET_BUFFER_DONE) {
+    if (dma->pending_input_length == 0 && dma->pending_input_done) {
+        dma->pending_input_done = false;
         if (dma->loop) {
             audiosample_reset_buffer(dma->sample, dma->single_channel_output, dma->audio_channel);
         } else {
-            // Set channel trigger to ourselves so we don't keep going.
-            dma_channel_hw_t *c = &dma_hw->ch[dma_channel];
-            c->al1_ctrl =
-                (c->al1_ctrl & ~DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS) |
-                (dma_channel << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB);
-
-            if (output_length_used == 0 &&
-                !dma_channel_is_busy(dma->channel[0]) &&
-                !dma_channel_is_busy(dma->channel[1])) {
-                // No data has been read, and both DMA channels have now finished, so it's safe to stop.
-                audio_dma_stop(dma);
-                dma->playing_in_progress = false;
-            }
+            dma->last_buffer = buffer_idx;
         }
     }
+    if (output_length_used > 0) {
+        dma->stats.buffers++;
+    }
+    return true;
+}
+
+// Point DMA channel channel_idx at the oldest filled buffer. Called with interrupts off.
+static void audio_dma_queue_buffer(audio_dma_t *dma, size_t channel_idx) {
+    size_t buffer_idx = dma->next_buffer_to_queue;
+    dma->next_buffer_to_queue = (buffer_idx + 1) % dma->buffer_count;
+    dma->buffers_ready--;
+    dma->channel_buffer[channel_idx] = buffer_idx;
+
+    size_t dma_channel = dma->channel[channel_idx];
+    dma_channel_set_read_addr(dma_channel, dma->buffer[buffer_idx], false /* trigger */);
+    dma_channel_set_trans_count(dma_channel, dma->buffer_trans_count[buffer_idx], false /* trigger */);
+
+    if (buffer_idx == dma->last_buffer) {
+        // Set channel trigger to ourselves so we don't keep going.
+        dma_channel_hw_t *c = &dma_hw->ch[dma_channel];
+        c->al1_ctrl =
+            (c->al1_ctrl & ~DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS) |
+            (dma_channel << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB);
+    }
+}
+
+// Give filled buffers to the channels that are waiting for one, the idle channel
+// first. Called with interrupts off.
+static void audio_dma_queue_ready_buffers(audio_dma_t *dma) {
+    while (dma->buffers_ready > 0 && dma->channels_to_load_mask != 0) {
+        size_t channel_idx = 0;
+        uint32_t mask0 = 1 << dma->channel[0];
+        uint32_t mask1 = 1 << dma->channel[1];
+        if ((dma->channels_to_load_mask & mask0) == 0 ||
+            ((dma->channels_to_load_mask & mask1) != 0 && dma_channel_is_busy(dma->channel[0]))) {
+            channel_idx = 1;
+        }
+        dma->channels_to_load_mask &= ~(1 << dma->channel[channel_idx]);
+        audio_dma_queue_buffer(dma, channel_idx);
+    }
+}
+
+// Refill every free buffer and hand the results to waiting channels.
+static void audio_dma_fill_free_buffers(audio_dma_t *dma) {
+    while (true) {
+        common_hal_mcu_disable_interrupts();
+        bool fill = dma->buffers_free > 0 && dma->last_buffer == AUDIO_DMA_NO_BUFFER;
+        uint8_t buffer_idx = dma->next_buffer_to_fill;
+        uint32_t freed_us = dma->buffer_freed_us[buffer_idx];
+        common_hal_mcu_enable_interrupts();
+        if (!fill) {
+            return;
+        }
+
+        if (!audio_dma_fill_buffer(dma, buffer_idx)) {
+            return;
+        }
+        audiocore_dma_stats_add_latency(&dma->stats, time_us_32() - freed_us);
+
+        common_hal_mcu_disable_interrupts();
+        dma->buffers_free--;
+        dma->next_buffer_to_fill = (buffer_idx + 1) % dma->buffer_count;
+        dma->buffers_ready++;
+        audio_dma_queue_ready_buffers(dma);
+        common_hal_mcu_enable_interrupts();
+    }
 }
 
 // Playback should be shutdown before calling this.
@@ -172,7 +234,9 @@ audio_dma_result audio_dma_setup_playback(
     uint8_t output_resolution,
     uint32_t output_register_address,
     uint8_t dma_trigger_source,
-    bool swap_channel) {
+    bool swap_channel,
+    uint8_t buffer_count,
+    uint32_t target_latency_us) {
 
     // Use two DMA channels to play because the DMA can't wrap to itself without the
     // buffer being power of two aligned.
@@ -202,6 +266,7 @@ audio_dma_result audio_dma_setup_playback(
     dma->sample_resolution = audiosample_bits_per_sample(sample);
     dma->output_register_address = output_register_address;
     dma->swap_channel = swap_channel;
+    dma->stats = (audiocore_dma_stats_t) { 0 };
 
     audiosample_reset_buffer(sample, single_channel_output, audio_channel);
 
@@ -223,20 +288,6 @@ audio_dma_result audio_dma_setup_playback(
         max_buffer_length /= dma->sample_spacing;
     }
 
-    dma->buffer[0] = (uint8_t *)m_realloc(dma->buffer[0], max_buffer_length);
-    dma->buffer_length[0] = max_buffer_length;
-    if (dma->buffer[0] == NULL) {
-        return AUDIO_DMA_MEMORY_ERROR;
-    }
-
-    if (!single_buffer) {
-        dma->buffer[1] = (uint8_t *)m_realloc(dma->buffer[1], max_buffer_length);
-        dma->buffer_length[1] = max_buffer_length;
-        if (dma->buffer[1] == NULL) {
-            return AUDIO_DMA_MEMORY_ERROR;
-        }
-    }
-
     dma->signed_to_unsigned = !output_signed && samples_signed;
     dma->unsigned_to_signed = output_signed && !samples_signed;
 
@@ -256,6 +307,28 @@ audio_dma_result audio_dma_setup_playback(
         dma_size = DMA_SIZE_32;
     }
 
+    // A short single buffer is looped by the DMA itself, so it is never split.
+    dma->buffer_count = single_buffer ? 1 : buffer_count;
+    if (!single_buffer && target_latency_us > 0) {
+        // Spread the requested latency over all of the buffers.
+        uint32_t frames = (uint64_t)audiosample_sample_rate(sample) * target_latency_us / 1000000 / dma->buffer_count;
+        uint32_t target_length = MAX(frames, AUDIO_DMA_MIN_BUFFER_FRAMES) * dma->output_size;
+        max_buffer_length = MIN(max_buffer_length, target_length);
+    }
+
+    for (size_t i = 0; i < AUDIOCORE_DMA_MAX_BUFFER_COUNT; i++) {
+        if (i >= dma->buffer_count) {
+            m_free(dma->buffer[i]);
+            dma->buffer[i] = NULL;
+            continue;
+        }
+        dma->buffer[i] = (uint8_t *)m_realloc(dma->buffer[i], max_buffer_length);
+        dma->buffer_length[i] = max_buffer_length;
+        if (dma->buffer[i] == NULL) {
+            return AUDIO_DMA_MEMORY_ERROR;
+        }
+    }
+
     for (size_t i = 0; i < 2; i++) {
         dma_channel_config c = dma_channel_get_default_config(dma->channel[i]);
         channel_config_set_transfer_data_size(&c, dma_size);
@@ -275,10 +348,28 @@ audio_dma_result audio_dma_setup_playback(
     MP_STATE_PORT(playing_audio)[dma->channel[0]] = dma;
     MP_STATE_PORT(playing_audio)[dma->channel[1]] = dma;
 
-    // Load the first two blocks up front.
-    audio_dma_load_next_block(dma, 0);
+    // Fill every buffer up front. The first two go straight to the DMA channels.
+    dma->pending_input_length = 0;
+    dma->pending_input_done = false;
+    dma->buffers_free = dma->buffer_count;
+    dma->buffers_ready = 0;
+    dma->next_buffer_to_fill = 0;
+    dma->next_buffer_to_queue = 0;
+    dma->last_buffer = AUDIO_DMA_NO_BUFFER;
+    dma->channel_buffer[0] = AUDIO_DMA_NO_BUFFER;
+    dma->channel_buffer[1] = AUDIO_DMA_NO_BUFFER;
+    uint32_t now = time_us_32();
+    for (size_t i = 0; i < dma->buffer_count; i++) {
+        dma->buffer_freed_us[i] = now;
+    }
+    dma->channels_to_load_mask = 1 << dma->channel[0];
     if (!single_buffer) {
-        audio_dma_load_next_block(dma, 1);
+        dma->channels_to_load_mask |= 1 << dma->channel[1];
+    }
+    audio_dma_fill_free_buffers(dma);
+    if (dma->channel[0] == NUM_DMA_CHANNELS) {
+        // Reading the sample failed and playback was stopped.
+        return AUDIO_DMA_OK;
     }
 
     // Special case the DMA for a single buffer. It's commonly used for a single wave length of sound
@@ -305,6 +396,9 @@ audio_dma_result audio_dma_setup_playback(
         irq_set_mask_enabled(1 << DMA_IRQ_0, true);
     }
 
+    if (!dma->playing_in_progress) {
+        filesystem_defer_flush(true);
+    }
     dma->playing_in_progress = true;
     dma_channel_start(dma->channel[0]);
 
@@ -351,6 +445,9 @@ void audio_dma_stop(audio_dma_t *dma) {
         MP_STATE_PORT(playing_audio)[channel] = NULL;
         dma->channel[i] = NUM_DMA_CHANNELS;
     }
+    if (dma->playing_in_progress) {
+        filesystem_defer_flush(false);
+    }
     dma->playing_in_progress = false;
 
     // Hold onto our buffers.
@@ -406,19 +503,26 @@ void audio_dma_unpause_mask(uint32_t channel_mask) {
 }
 
 void audio_dma_init(audio_dma_t *dma) {
-    dma->buffer[0] = NULL;
-    dma->buffer[1] = NULL;
+    for (size_t i = 0; i < AUDIOCORE_DMA_MAX_BUFFER_COUNT; i++) {
+        dma->buffer[i] = NULL;
+    }
 
     dma->channel[0] = NUM_DMA_CHANNELS;
     dma->channel[1] = NUM_DMA_CHANNELS;
 }
 
 void audio_dma_deinit(audio_dma_t *dma) {
-    m_free(dma->buffer[0]);
-    dma->buffer[0] = NULL;
+    for (size_t i = 0; i < AUDIOCORE_DMA_MAX_BUFFER_COUNT; i++) {
+        m_free(dma->buffer[i]);
+        dma->buffer[i] = NULL;
+    }
+}
 
-    m_free(dma->buffer[1]);
-    dma->buffer[1] = NULL;
+void audio_dma_get_stats(audio_dma_t *dma, audiocore_dma_stats_t *stats) {
+    // The underrun count is updated from the DMA interrupt.
+    common_hal_mcu_disable_interrupts();
+    *stats = dma->stats;
+    common_hal_mcu_enable_interrupts();
 }
 
 bool audio_dma_get_playing(audio_dma_t *dma) {
@@ -438,24 +542,18 @@ static void dma_callback_fun(void *arg) {
         return;
     }
 
-    common_hal_mcu_disable_interrupts();
-    uint32_t channels_to_load_mask = dma->channels_to_load_mask;
-    dma->channels_to_load_mask = 0;
-    common_hal_mcu_enable_interrupts();
+    CIRCUITPY_TRACE_BEGIN(TRACE_EVENT_AUDIO_DMA_REFILL);
+    audio_dma_fill_free_buffers(dma);
+    CIRCUITPY_TRACE_END(TRACE_EVENT_AUDIO_DMA_REFILL);
 
-    // Load the blocks for the requested channels.
-    uint32_t channel = 0;
-    while (channels_to_load_mask) {
-        if (channels_to_load_mask & 1) {
-            if (dma->channel[0] == channel) {
-                audio_dma_load_next_block(dma, 0);
-            }
-            if (dma->channel[1] == channel) {
-                audio_dma_load_next_block(dma, 1);
-            }
-        }
-        channels_to_load_mask >>= 1;
-        channel++;
+    // The last buffer has been queued and both DMA channels have now finished, so it's safe to stop.
+    if (dma->channel[0] != NUM_DMA_CHANNELS &&
+        dma->last_buffer != AUDIO_DMA_NO_BUFFER &&
+        dma->buffers_ready == 0 &&
+        !dma_channel_is_busy(dma->channel[0]) &&
+        !dma_channel_is_busy(dma->channel[1])) {
+        audio_dma_stop(dma);
+        dma->playing_in_progress = false;
     }
 }
 
@@ -472,9 +570,25 @@ void isr_dma_0(void) {
         dma_hw->ints0 = mask;
         if (MP_STATE_PORT(playing_audio)[i] != NULL) {
             audio_dma_t *dma = MP_STATE_PORT(playing_audio)[i];
-            // Record all channels whose DMA has completed; they need loading.
+            CIRCUITPY_TRACE_INSTANT(TRACE_EVENT_AUDIO_DMA_IRQ);
+            // The channel that just finished chained to the other one. If that
+            // one is still waiting for a buffer, it is replaying stale data.
+            size_t channel_idx = dma->channel[0] == i ? 0 : 1;
+            if (dma->last_buffer == AUDIO_DMA_NO_BUFFER &&
+                (dma->channels_to_load_mask & (1 << dma->channel[1 - channel_idx]))) {
+                dma->stats.underruns++;
+            }
+            uint8_t buffer_idx = dma->channel_buffer[channel_idx];
+            if (buffer_idx != AUDIO_DMA_NO_BUFFER) {
+                dma->buffer_freed_us[buffer_idx] = time_us_32();
+                dma->channel_buffer[channel_idx] = AUDIO_DMA_NO_BUFFER;
+                dma->buffers_free++;
+            }
+            // Record all channels whose DMA has completed. Ones that can't be given
+            // a filled buffer right away wait for the background refill.
             dma->channels_to_load_mask |= mask;
-            background_callback_add(&dma->callback, dma_callback_fun, (void *)dma);
+            audio_dma_queue_ready_buffers(dma);
+            background_callback_add_with_priority(&dma->callback, dma_callback_fun, (void *)dma, BACKGROUND_CALLBACK_PRIORITY_REALTIME);
         }
         if (MP_STATE_PORT(background_pio)[i] != NULL) {
             rp2pio_statemachine_obj_t *pio = MP_STATE_PORT(background_pio)[i];
@@ -7,18 +7,38 @@
 #pragma once
 
 #include "py/obj.h"
+#include "shared-module/audiocore/__init__.h"
 #include "supervisor/background_callback.h"
 
 #include "src/rp2_common/hardware_dma/include/hardware/dma.h"
 
+// Value for last_buffer and channel_buffer meaning no buffer.
+#define AUDIO_DMA_NO_BUFFER (0xff)
+// Smallest buffer, in frames, that a target latency can ask for.
+#define AUDIO_DMA_MIN_BUFFER_FRAMES (16)
+
+// Buffers are filled in order, handed to the two DMA channels in order from the
+// DMA interrupt when one is ready, and refilled in the background when they come back.
 typedef struct {
     mp_obj_t sample;
-    uint8_t *buffer[2];
-    size_t buffer_length[2];
+    uint8_t *buffer[AUDIOCORE_DMA_MAX_BUFFER_COUNT];
+    size_t buffer_length[AUDIOCORE_DMA_MAX_BUFFER_COUNT];
+    uint32_t buffer_trans_count[AUDIOCORE_DMA_MAX_BUFFER_COUNT];
+    uint32_t buffer_freed_us[AUDIOCORE_DMA_MAX_BUFFER_COUNT]; // When each buffer came back for a refill.
+    uint8_t *pending_input; // Part of the last sample buffer that hasn't been converted yet.
+    uint32_t pending_input_length;
     uint32_t channels_to_load_mask;
     uint32_t output_register_address;
     background_callback_t callback;
+    audiocore_dma_stats_t stats;
     uint8_t channel[2];
+    uint8_t channel_buffer[2]; // Buffer each channel is set up to play.
+    uint8_t buffer_count;
+    uint8_t buffers_free;
+    uint8_t buffers_ready;
+    uint8_t next_buffer_to_fill;
+    uint8_t next_buffer_to_queue;
+    uint8_t last_buffer;
     uint8_t audio_channel;
     uint8_t output_size;
     uint8_t sample_spacing;
@@ -31,6 +51,7 @@ typedef struct {
     bool output_signed;
     bool playing_in_progress;
     bool swap_channel;
+    bool pending_input_done;
 } audio_dma_t;
 
 typedef enum {
@@ -53,6 +74,8 @@ void audio_dma_reset(void);
 // output_signed is true if the dma'd data should be signed. False and it will be unsigned.
 // output_register_address is the address to copy data to.
 // dma_trigger_source is the DMA trigger source which cause another copy
+// buffer_count is the number of DMA buffers, 2 to AUDIOCORE_DMA_MAX_BUFFER_COUNT.
+// target_latency_us, when not 0, shrinks the buffers so they hold about that much audio in total.
 audio_dma_result audio_dma_setup_playback(audio_dma_t *dma,
     mp_obj_t sample,
     bool loop,
@@ -62,13 +85,16 @@ audio_dma_result audio_dma_setup_playback(audio_dma_t *dma,
     uint8_t output_resolution,
     uint32_t output_register_address,
     uint8_t dma_trigger_source,
-    bool swap_channel);
+    bool swap_channel,
+    uint8_t buffer_count,
+    uint32_t target_latency_us);
 
 void audio_dma_stop(audio_dma_t *dma);
 bool audio_dma_get_playing(audio_dma_t *dma);
 void audio_dma_pause(audio_dma_t *dma);
 void audio_dma_resume(audio_dma_t *dma);
 bool audio_dma_get_paused(audio_dma_t *dma);
+void audio_dma_get_stats(audio_dma_t *dma, audiocore_dma_stats_t *stats);
 
 uint32_t audio_dma_pause_all(void);
 void audio_dma_unpause_mask(uint32_t channel_mask);
@@ -49,13 +49,18 @@
 //|
 //|         * 1 - Each bit is a pixel. Either white (1) or black (0).
 //|         * 2 - Each 2 bits is a pixels. Grayscale between white (0x3) and black (0x0).
-//|         * 8 - Each byte is a pixels in RGB332 format.
+//|         * 4 - Each 4 bits is a palette index. The palette starts out as RGBD
+//|           (red, green, blue and an unused bit, from most to least significant).
+//|         * 8 - Each byte is a pixels in RGB332 format. At full resolution it is
+//|           a palette index and the palette starts out as RGB332.
 //|         * 16 - Each two bytes are a pixel in RGB565 format.
 //|
 //|         Two output resolutions are currently supported, 640x480 and 800x480.
-//|         Monochrome framebuffers (color_depth=1 or 2) must be full resolution.
-//|         Color framebuffers must be half resolution (320x240 or 400x240) and
-//|         pixels will be duplicated to create the signal.
+//|         Monochrome and palette framebuffers (color_depth=1, 2, 4 or 8) may be
+//|         full resolution. Color framebuffers (color_depth=8 or 16) may be half
+//|         resolution (320x240 or 400x240) and pixels will be duplicated to
+//|         create the signal. A full resolution, 8 bit framebuffer needs more RAM
+//|         than the RP2040 has, so use a height of 240 to double each line.
 //|
 //|         A Framebuffer is often used in conjunction with a
 //|         `framebufferio.FramebufferDisplay`.
@@ -70,8 +75,8 @@
 //|         :param ~microcontroller.Pin green_dn: the negative green signal pin
 //|         :param ~microcontroller.Pin blue_dp: the positive blue signal pin
 //|         :param ~microcontroller.Pin blue_dn: the negative blue signal pin
-//|         :param int color_depth: the color depth of the framebuffer in bits. 1, 2 for grayscale
-//|           and 8 or 16 for color
+//|         :param int color_depth: the color depth of the framebuffer in bits. 1, 2 for grayscale,
+//|           4 or 8 for palette color and 8 or 16 for color
 //|         """
 
 static mp_obj_t picodvi_framebuffer_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
@@ -101,7 +106,7 @@ static mp_obj_t picodvi_framebuffer_make_new(const mp_obj_type_t *type, size_t n
     mp_uint_t width = (mp_uint_t)mp_arg_validate_int_min(args[ARG_width].u_int, 0, MP_QSTR_width);
     mp_uint_t height = (mp_uint_t)mp_arg_validate_int_min(args[ARG_height].u_int, 0, MP_QSTR_height);
     mp_uint_t color_depth = args[ARG_color_depth].u_int;
-    if (color_depth != 1 && color_depth != 2 && color_depth != 8 && color_depth != 16) {
+    if (color_depth != 1 && color_depth != 2 && color_depth != 4 && color_depth != 8 && color_depth != 16) {
         mp_raise_ValueError_varg(MP_ERROR_TEXT("Invalid %q"), MP_QSTR_color_depth);
     }
     common_hal_picodvi_framebuffer_construct(self,
@@ -151,7 +156,6 @@ MP_PROPERTY_GETTER(picodvi_framebuffer_width_obj,
 
 //|     height: int
 //|     """The width of the framebuffer, in pixels. It may be doubled for output."""
-//|
 static mp_obj_t picodvi_framebuffer_get_height(mp_obj_t self_in) {
     picodvi_framebuffer_obj_t *self = (picodvi_framebuffer_obj_t *)self_in;
     check_for_deinit(self);
@@ -162,11 +166,37 @@ MP_DEFINE_CONST_FUN_OBJ_1(picodvi_framebuffer_get_height_obj, picodvi_framebuffe
 MP_PROPERTY_GETTER(picodvi_framebuffer_height_obj,
     (mp_obj_t)&picodvi_framebuffer_get_height_obj);
 
+//|     def set_palette_color(self, index: int, color: int) -> None:
+//|         """Change the color shown for ``index`` in a palette framebuffer. Only
+//|         full resolution framebuffers with a color_depth of 4 or 8 have a palette.
+//|
+//|         Each channel of the color is rounded to the closest level that can be
+//|         sent on its own, which is at most two steps away.
+//|
+//|         :param int index: the palette index, less than ``2 ** color_depth``
+//|         :param int color: the color as an RGB888 integer, such as ``0xff8000``"""
+//|         ...
+//|
+static mp_obj_t picodvi_framebuffer_set_palette_color(mp_obj_t self_in, mp_obj_t index_in, mp_obj_t color_in) {
+    picodvi_framebuffer_obj_t *self = (picodvi_framebuffer_obj_t *)self_in;
+    check_for_deinit(self);
+    if (!common_hal_picodvi_framebuffer_get_indexed_color(self)) {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("Invalid %q"), MP_QSTR_color_depth);
+    }
+    int color_depth = common_hal_picodvi_framebuffer_get_color_depth(self);
+    mp_int_t index = mp_arg_validate_int_range(mp_obj_get_int(index_in), 0, (1 << color_depth) - 1, MP_QSTR_index);
+    mp_int_t color = mp_arg_validate_int_range(mp_obj_get_int(color_in), 0, 0xffffff, MP_QSTR_color);
+    common_hal_picodvi_framebuffer_set_palette_color(self, index, color);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(picodvi_framebuffer_set_palette_color_obj, picodvi_framebuffer_set_palette_color);
+
 static const mp_rom_map_elem_t picodvi_framebuffer_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&picodvi_framebuffer_deinit_obj) },
 
     { MP_ROM_QSTR(MP_QSTR_width), MP_ROM_PTR(&picodvi_framebuffer_width_obj) },
     { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&picodvi_framebuffer_height_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set_palette_color), MP_ROM_PTR(&picodvi_framebuffer_set_palette_color_obj) },
 };
 static MP_DEFINE_CONST_DICT(picodvi_framebuffer_locals_dict, picodvi_framebuffer_locals_dict_table);
 
@@ -198,6 +228,11 @@ static int picodvi_framebuffer_get_color_depth_proto(mp_obj_t self_in) {
     ;
 }
 
+static bool picodvi_framebuffer_get_grayscale_proto(mp_obj_t self_in) {
+    // 4 bit framebuffers are color so displayio renders RGBD into them.
+    return common_hal_picodvi_framebuffer_get_color_depth(self_in) < 4;
+}
+
 static int picodvi_framebuffer_get_bytes_per_cell_proto(mp_obj_t self_in) {
     return 1;
 }
@@ -221,6 +256,7 @@ static const framebuffer_p_t picodvi_framebuffer_proto = {
     .get_height = picodvi_framebuffer_get_height_proto,
     .get_color_depth = picodvi_framebuffer_get_color_depth_proto,
     .get_row_stride = picodvi_framebuffer_get_row_stride_proto,
+    .get_grayscale = picodvi_framebuffer_get_grayscale_proto,
     .get_bytes_per_cell = picodvi_framebuffer_get_bytes_per_cell_proto,
     .get_native_frames_per_second = picodvi_framebuffer_get_native_frames_per_second_proto,
     .get_pixels_in_byte_share_row = picodvi_framebuffer_get_pixels_in_byte_share_row_proto,
@@ -0,0 +1,263 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "bindings/rp2pio/WaveformOut.h"
+#include "shared-bindings/microcontroller/Pin.h"
+#include "shared-bindings/util.h"
+#include "shared/runtime/context_manager_helpers.h"
+#include "shared/runtime/interrupt_char.h"
+#include "py/mperrno.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+
+//| class WaveformOut:
+//|     """Drives a group of consecutive pins through a sequence of steps, each
+//|     held for an exact number of state machine cycles. The steps are sent by
+//|     DMA from a buffer, so their timing does not depend on Python. Use it to
+//|     step motors or to generate protocols that no other module supports."""
+//|
+//|     def __init__(
+//|         self,
+//|         first_pin: microcontroller.Pin,
+//|         frequency: int,
+//|         *,
+//|         pin_count: int = 1,
+//|         initial_state: int = 0,
+//|     ) -> None:
+//|         """Claim a state machine and the pins, and drive the pins to ``initial_state``.
+//|
+//|         :param ~microcontroller.Pin first_pin: The first of the pins to drive
+//|         :param int frequency: The state machine clock. Step lengths are counted in its cycles
+//|         :param int pin_count: The number of consecutive pins to drive, from 1 to 16
+//|         :param int initial_state: The pin levels until the first step, one bit per pin, first pin in bit 0
+//|
+//|         For example, to send two periods of a 250kHz square wave and a 10µs pause on ``board.GP0``:
+//|
+//|         .. code-block:: python
+//|
+//|             import array
+//|             import board
+//|             import rp2pio
+//|
+//|             wave = rp2pio.WaveformOut(board.GP0, 10_000_000)
+//|             steps = array.array("L", [wave.step(1, 20), wave.step(0, 20)] * 2 + [wave.step(0, 100)])
+//|             wave.play(steps)"""
+//|         ...
+//|
+static mp_obj_t rp2pio_waveformout_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_first_pin, ARG_frequency, ARG_pin_count, ARG_initial_state };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_first_pin, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_frequency, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_pin_count, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 1} },
+        { MP_QSTR_initial_state, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    const mcu_pin_obj_t *first_pin = validate_obj_is_free_pin(args[ARG_first_pin].u_obj, MP_QSTR_first_pin);
+    mp_int_t pin_count = mp_arg_validate_int_range(args[ARG_pin_count].u_int, 1, 16, MP_QSTR_pin_count);
+    mp_int_t initial_state = mp_arg_validate_int_range(args[ARG_initial_state].u_int, 0, (1 << pin_count) - 1, MP_QSTR_initial_state);
+    mp_int_t frequency = mp_arg_validate_int_min(args[ARG_frequency].u_int, 1, MP_QSTR_frequency);
+
+    rp2pio_waveformout_obj_t *self = mp_obj_malloc(rp2pio_waveformout_obj_t, &rp2pio_waveformout_type);
+    common_hal_rp2pio_waveformout_construct(self, first_pin, pin_count, frequency, initial_state);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+static void check_for_deinit(rp2pio_waveformout_obj_t *self) {
+    if (common_hal_rp2pio_waveformout_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|     def deinit(self) -> None:
+//|         """Stop playing and release the state machine and pins."""
+//|         ...
+//|
+static mp_obj_t rp2pio_waveformout_deinit(mp_obj_t self_in) {
+    rp2pio_waveformout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_rp2pio_waveformout_deinit(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(rp2pio_waveformout_deinit_obj, rp2pio_waveformout_deinit);
+
+//|     def __enter__(self) -> WaveformOut:
+//|         """No-op used by Context Managers.
+//|         Provided by context manager helper."""
+//|         ...
+//|
+//|     def __exit__(self) -> None:
+//|         """Automatically deinitializes the hardware when exiting a context. See
+//|         :ref:`lifetime-and-contextmanagers` for more info."""
+//|         ...
+//|
+static mp_obj_t rp2pio_waveformout_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_rp2pio_waveformout_deinit(MP_OBJ_TO_PTR(args[0]));
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(rp2pio_waveformout_obj___exit___obj, 4, 4, rp2pio_waveformout_obj___exit__);
+
+//|     def step(self, state: int, cycles: int) -> int:
+//|         """Returns the buffer entry for one step.
+//|
+//|         :param int state: The pin levels, one bit per pin, first pin in bit 0
+//|         :param int cycles: How long to hold them, at least 3. The limit is
+//|           ``2 ** (32 - pin_count) + 2``. Split longer holds into several steps."""
+//|         ...
+//|
+static mp_obj_t rp2pio_waveformout_step(mp_obj_t self_in, mp_obj_t state_in, mp_obj_t cycles_in) {
+    rp2pio_waveformout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    mp_int_t state = mp_arg_validate_int_range(mp_obj_get_int(state_in), 0, (1 << self->pin_count) - 1, MP_QSTR_state);
+    mp_int_t max_cycles = MIN(((uint64_t)1 << (32 - self->pin_count)) + 2, (uint64_t)MP_SMALL_INT_MAX);
+    mp_int_t cycles = mp_arg_validate_int_range(mp_obj_get_int(cycles_in), 3, max_cycles, MP_QSTR_cycles);
+    return mp_obj_new_int_from_uint(common_hal_rp2pio_waveformout_step(self, state, cycles));
+}
+MP_DEFINE_CONST_FUN_OBJ_3(rp2pio_waveformout_step_obj, rp2pio_waveformout_step);
+
+//|     def play(
+//|         self, once: Optional[ReadableBuffer] = None, *, loop: Optional[ReadableBuffer] = None
+//|     ) -> None:
+//|         """Play steps in the background, with optional looping. The buffers
+//|         must be `array.array` of type ``'L'`` holding values from `step`.
+//|
+//|         This works like `StateMachine.background_write`: the ``once`` steps
+//|         are played one time, then the ``loop`` steps repeat until `stop` or
+//|         the next `play`. To change a looping waveform without a gap or a
+//|         glitch, call `play` with the new ``loop`` buffer. The switch happens
+//|         at the end of the current pass through the old one. Alternate
+//|         between two buffers rather than changing the one that is playing.
+//|
+//|         Playing neither ``once`` nor ``loop`` ends a looping waveform after
+//|         its current pass. After the last step, the pins keep its levels.
+//|
+//|         :param ~Optional[circuitpython_typing.ReadableBuffer] once: Steps to play once
+//|         :param ~Optional[circuitpython_typing.ReadableBuffer] loop: Steps to play repeatedly"""
+//|         ...
+//|
+static void fill_step_info(sm_buf_info *info, mp_obj_t obj, qstr arg_name) {
+    if (obj == mp_const_none) {
+        memset(info, 0, sizeof(*info));
+        return;
+    }
+    info->obj = obj;
+    mp_get_buffer_raise(obj, &info->info, MP_BUFFER_READ);
+    if (info->info.typecode != 'L' && info->info.typecode != 'I') {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("%q must be array of type 'L'"), arg_name);
+    }
+}
+
+static mp_obj_t rp2pio_waveformout_play(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_once, ARG_loop };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_once, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_loop, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+    };
+    rp2pio_waveformout_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    check_for_deinit(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    sm_buf_info once_info;
+    sm_buf_info loop_info;
+    fill_step_info(&once_info, args[ARG_once].u_obj, MP_QSTR_once);
+    fill_step_info(&loop_info, args[ARG_loop].u_obj, MP_QSTR_loop);
+
+    bool ok = common_hal_rp2pio_waveformout_play(self, &once_info, &loop_info);
+    if (mp_hal_is_interrupted()) {
+        return mp_const_none;
+    }
+    if (!ok) {
+        mp_raise_OSError(MP_EIO);
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(rp2pio_waveformout_play_obj, 1, rp2pio_waveformout_play);
+
+//|     def stop(self) -> None:
+//|         """Stop playing immediately. Steps already in the state machine's
+//|         FIFO still play, and the pins keep the levels of the last one."""
+//|         ...
+//|
+static mp_obj_t rp2pio_waveformout_stop(mp_obj_t self_in) {
+    rp2pio_waveformout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    bool ok = common_hal_rp2pio_waveformout_stop(self);
+    if (mp_hal_is_interrupted()) {
+        return mp_const_none;
+    }
+    if (!ok) {
+        mp_raise_OSError(MP_EIO);
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(rp2pio_waveformout_stop_obj, rp2pio_waveformout_stop);
+
+//|     playing: bool
+//|     """True while steps are being sent from a buffer."""
+static mp_obj_t rp2pio_waveformout_get_playing(mp_obj_t self_in) {
+    rp2pio_waveformout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_bool(common_hal_rp2pio_waveformout_get_playing(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(rp2pio_waveformout_get_playing_obj, rp2pio_waveformout_get_playing);
+
+MP_PROPERTY_GETTER(rp2pio_waveformout_playing_obj,
+    (mp_obj_t)&rp2pio_waveformout_get_playing_obj);
+
+//|     pending: int
+//|     """The number of buffers given to `play` that have not started yet.
+//|     When it is 0, `play` will not block."""
+static mp_obj_t rp2pio_waveformout_get_pending(mp_obj_t self_in) {
+    rp2pio_waveformout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_int(common_hal_rp2pio_waveformout_get_pending(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(rp2pio_waveformout_get_pending_obj, rp2pio_waveformout_get_pending);
+
+MP_PROPERTY_GETTER(rp2pio_waveformout_pending_obj,
+    (mp_obj_t)&rp2pio_waveformout_get_pending_obj);
+
+//|     frequency: int
+//|     """The actual state machine clock, which may differ a little from the
+//|     one requested."""
+//|
+static mp_obj_t rp2pio_waveformout_get_frequency(mp_obj_t self_in) {
+    rp2pio_waveformout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_int_from_uint(common_hal_rp2pio_waveformout_get_frequency(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(rp2pio_waveformout_get_frequency_obj, rp2pio_waveformout_get_frequency);
+
+MP_PROPERTY_GETTER(rp2pio_waveformout_frequency_obj,
+    (mp_obj_t)&rp2pio_waveformout_get_frequency_obj);
+
+static const mp_rom_map_elem_t rp2pio_waveformout_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&rp2pio_waveformout_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&rp2pio_waveformout_obj___exit___obj) },
+
+    { MP_ROM_QSTR(MP_QSTR_step), MP_ROM_PTR(&rp2pio_waveformout_step_obj) },
+    { MP_ROM_QSTR(MP_QSTR_play), MP_ROM_PTR(&rp2pio_waveformout_play_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop), MP_ROM_PTR(&rp2pio_waveformout_stop_obj) },
+
+    { MP_ROM_QSTR(MP_QSTR_playing), MP_ROM_PTR(&rp2pio_waveformout_playing_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pending), MP_ROM_PTR(&rp2pio_waveformout_pending_obj) },
+    { MP_ROM_QSTR(MP_QSTR_frequency), MP_ROM_PTR(&rp2pio_waveformout_frequency_obj) },
+};
+static MP_DEFINE_CONST_DICT(rp2pio_waveformout_locals_dict, rp2pio_waveformout_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    rp2pio_waveformout_type,
+    MP_QSTR_WaveformOut,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    make_new, rp2pio_waveformout_make_new,
+    locals_dict, &rp2pio_waveformout_locals_dict
+    );
@@ -0,0 +1,26 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+#include "common-hal/microcontroller/Pin.h"
+#include "common-hal/rp2pio/WaveformOut.h"
+
+extern const mp_obj_type_t rp2pio_waveformout_type;
+
+void common_hal_rp2pio_waveformout_construct(rp2pio_waveformout_obj_t *self,
+    const mcu_pin_obj_t *first_pin, uint8_t pin_count, uint32_t frequency, uint32_t initial_state);
+void common_hal_rp2pio_waveformout_deinit(rp2pio_waveformout_obj_t *self);
+bool common_hal_rp2pio_waveformout_deinited(rp2pio_waveformout_obj_t *self);
+
+uint32_t common_hal_rp2pio_waveformout_step(rp2pio_waveformout_obj_t *self, uint32_t state, uint32_t cycles);
+bool common_hal_rp2pio_waveformout_play(rp2pio_waveformout_obj_t *self, const sm_buf_info *once, const sm_buf_info *loop);
+bool common_hal_rp2pio_waveformout_stop(rp2pio_waveformout_obj_t *self);
+bool common_hal_rp2pio_waveformout_get_playing(rp2pio_waveformout_obj_t *self);
+mp_int_t common_hal_rp2pio_waveformout_get_pending(rp2pio_waveformout_obj_t *self);
+uint32_t common_hal_rp2pio_waveformout_get_frequency(rp2pio_waveformout_obj_t *self);
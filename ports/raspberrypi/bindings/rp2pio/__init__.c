@@ -8,6 +8,7 @@
 #include "py/runtime.h"
 
 #include "bindings/rp2pio/StateMachine.h"
+#include "bindings/rp2pio/WaveformOut.h"
 #include "bindings/rp2pio/__init__.h"
 
 //| """Hardware interface to RP2 series' programmable IO (PIO) peripheral.
@@ -42,6 +43,7 @@ static MP_DEFINE_CONST_FUN_OBJ_1(rp2pio_pins_are_sequential_obj, rp2pio_pins_are
 static const mp_rom_map_elem_t rp2pio_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_rp2pio) },
     { MP_ROM_QSTR(MP_QSTR_StateMachine),  MP_ROM_PTR(&rp2pio_statemachine_type) },
+    { MP_ROM_QSTR(MP_QSTR_WaveformOut),  MP_ROM_PTR(&rp2pio_waveformout_type) },
     { MP_ROM_QSTR(MP_QSTR_pins_are_sequential),  MP_ROM_PTR(&rp2pio_pins_are_sequential_obj) },
 };
 
@@ -0,0 +1,152 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "bindings/rp2pio/StateMachine.h"
+#include "common-hal/rp2pio/StateMachine.h"
+#include "shared-module/bitbangio/SPI.h"
+
+#include "src/rp2_common/hardware_clocks/include/hardware/clocks.h"
+#include "src/rp2_common/hardware_gpio/include/hardware/gpio.h"
+
+// bitbangio.SPI transfers run on a PIO state machine when one is free, so the
+// clock is steady and the data moves by DMA instead of one bit at a time from
+// the CPU. The state machine only lives for one transfer. Between transfers the
+// pins are plain GPIO again, owned by the DigitalInOuts in the SPI object.
+
+// Every program takes four cycles per bit. The clock is side set and the
+// programs stall with it idle while the TX FIFO is empty. These are the
+// pico-examples SPI programs, with the side set values flipped for polarity 1.
+static const uint16_t spi_programs[2][2][3] = {
+    {
+        {
+            // out pins, 1   side 0 [1]
+            0x6101,
+            // in pins, 1    side 1 [1]
+            0x5101,
+        },
+        {
+            // out x, 1      side 0
+            0x6021,
+            // mov pins, x   side 1 [1]
+            0xb101,
+            // in pins, 1    side 0
+            0x4001,
+        },
+    },
+    {
+        {
+            // out pins, 1   side 1 [1]
+            0x7101,
+            // in pins, 1    side 0 [1]
+            0x4101,
+        },
+        {
+            // out x, 1      side 1
+            0x7021,
+            // mov pins, x   side 0 [1]
+            0xa101,
+            // in pins, 1    side 1
+            0x5001,
+        },
+    },
+};
+
+#define SPI_CYCLES_PER_BIT (4)
+
+// Bytes sent or received at a time when only one direction has a buffer.
+#define SCRATCH_SIZE (64)
+
+static void _give_pin_back(const digitalio_digitalinout_obj_t *pin) {
+    // The SIO output and direction were left alone while the PIO had the pin.
+    gpio_set_function(pin->pin->number, GPIO_FUNC_SIO);
+    gpio_set_drive_strength(pin->pin->number, GPIO_DRIVE_STRENGTH_4MA);
+}
+
+size_t bitbangio_spi_port_transfer(bitbangio_spi_obj_t *self,
+    const uint8_t *dout, uint8_t write_value, uint8_t *din, size_t len) {
+    if (len == 0 || !self->has_mosi) {
+        return 0;
+    }
+    const mcu_pin_obj_t *clock = self->clock.pin;
+    const mcu_pin_obj_t *mosi = self->mosi.pin;
+    // Without MISO the program reads MOSI back and the result is dropped.
+    const mcu_pin_obj_t *miso = self->has_miso ? self->miso.pin : mosi;
+
+    uint32_t clock_mask = 1 << clock->number;
+    uint32_t out_mask = clock_mask | (1 << mosi->number);
+    uint32_t pins_we_use = out_mask | (1 << miso->number);
+
+    uint32_t frequency = clock_get_hz(clk_sys);
+    if (self->baudrate < frequency / SPI_CYCLES_PER_BIT) {
+        frequency = self->baudrate * SPI_CYCLES_PER_BIT;
+    }
+
+    const uint16_t *program = spi_programs[self->polarity][self->phase];
+    size_t program_len = self->phase == 0 ? 2 : 3;
+
+    rp2pio_statemachine_obj_t state_machine;
+    bool ok = rp2pio_statemachine_construct(&state_machine,
+        program, program_len,
+        frequency,
+        NULL, 0, // init program
+        mosi, 1, // out
+        miso, 1, // in
+        0, 0, // in pulls
+        NULL, 0, // set
+        clock, 1, // sideset
+        self->polarity ? clock_mask : 0, out_mask, // initial pin state matches the idle GPIOs
+        NULL, // jump pin
+        pins_we_use, true, true,
+        true, 8, false, // TX, auto pull every 8 bits. shift left to output msb first
+        false, // Wait for txstall
+        true, 8, false, // RX, auto push every 8 bits. shift left to input msb first
+        false, // claim pins, the DigitalInOuts already have them
+        false, // Not user-interruptible.
+        false, // No sideset enable
+        0, -1, // wrap
+        PIO_ANY_OFFSET);
+    if (!ok) {
+        return 0;
+    }
+
+    uint8_t scratch[SCRATCH_SIZE];
+    if (dout == NULL) {
+        memset(scratch, write_value, sizeof(scratch));
+    }
+    size_t done = 0;
+    while (done < len) {
+        size_t chunk = len - done;
+        const uint8_t *out = scratch;
+        uint8_t *in = scratch;
+        if (dout == NULL || din == NULL) {
+            chunk = MIN(chunk, sizeof(scratch));
+        }
+        if (dout != NULL) {
+            out = dout + done;
+        }
+        if (din != NULL) {
+            in = din + done;
+        }
+        // Fails before sending anything when no DMA channel is free.
+        if (!common_hal_rp2pio_statemachine_write_readinto(&state_machine,
+            out, chunk, 1, in, chunk, 1, false, false)) {
+            break;
+        }
+        done += chunk;
+    }
+
+    // Every byte has been read back so the clock is idle again.
+    rp2pio_statemachine_deinit(&state_machine, true);
+    _give_pin_back(&self->clock);
+    _give_pin_back(&self->mosi);
+    if (self->has_miso) {
+        _give_pin_back(&self->miso);
+    }
+    return done;
+}
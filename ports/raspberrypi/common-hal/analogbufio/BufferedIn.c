@@ -6,6 +6,7 @@
 // SPDX-License-Identifier: MIT
 
 #include <stdio.h>
+#include <string.h>
 #include "common-hal/analogbufio/BufferedIn.h"
 #include "shared-bindings/analogbufio/BufferedIn.h"
 #include "shared-bindings/microcontroller/Pin.h"
@@ -70,6 +71,9 @@ void common_hal_analogbufio_bufferedin_construct(analogbufio_bufferedin_obj_t *s
     // Pace transfers based on availability of ADC samples
     channel_config_set_dreq(&(self->cfg), DREQ_ADC);
 
+    self->ctrl_dma_chan = -1;
+    self->looping = false;
+
     // clear any previous activity
     adc_fifo_drain();
     adc_run(false);
@@ -84,6 +88,8 @@ void common_hal_analogbufio_bufferedin_deinit(analogbufio_bufferedin_obj_t *self
         return;
     }
 
+    common_hal_analogbufio_bufferedin_stop_loop(self);
+
     // Release ADC Pin
     reset_pin_number(self->pin->number);
     self->pin = NULL;
@@ -101,6 +107,8 @@ uint32_t common_hal_analogbufio_bufferedin_readinto(analogbufio_bufferedin_obj_t
     // samples at the first sample with the error bit set.
     // Number of transfers is always the number of samples which is the array
     // byte length divided by the bytes_per_sample.
+    common_hal_analogbufio_bufferedin_stop_loop(self);
+
     uint dma_size = DMA_SIZE_8;
     bool show_error_bit = false;
     if (bytes_per_sample == 2) {
@@ -163,3 +171,130 @@ uint32_t common_hal_analogbufio_bufferedin_readinto(analogbufio_bufferedin_obj_t
     }
     return captured_count;
 }
+
+void common_hal_analogbufio_bufferedin_start_loop(analogbufio_bufferedin_obj_t *self, uint8_t *buffer, uint32_t len, uint8_t bytes_per_sample) {
+    common_hal_analogbufio_bufferedin_stop_loop(self);
+
+    int ctrl_dma_chan = dma_claim_unused_channel(false);
+    if (ctrl_dma_chan < 0) {
+        mp_raise_RuntimeError(MP_ERROR_TEXT("All dma channels in use"));
+    }
+    self->ctrl_dma_chan = ctrl_dma_chan;
+
+    // The error bit can't be checked as samples arrive, so leave it off and
+    // keep the raw 12-bit values. They are scaled when read back out.
+    adc_fifo_setup(true, true, 1, false, bytes_per_sample == 1);
+
+    self->loop_buffer = buffer;
+    self->loop_buffer_addr = (uint32_t)buffer;
+    self->loop_sample_count = len / bytes_per_sample;
+    self->loop_bytes_per_sample = bytes_per_sample;
+
+    // The control channel does a single transfer that writes the buffer
+    // address into the data channel and triggers it again. Nothing is done
+    // by the CPU so there is no gap between passes.
+    dma_channel_config ctrl_cfg = dma_channel_get_default_config(ctrl_dma_chan);
+    channel_config_set_transfer_data_size(&ctrl_cfg, DMA_SIZE_32);
+    channel_config_set_read_increment(&ctrl_cfg, false);
+    channel_config_set_write_increment(&ctrl_cfg, false);
+    dma_channel_configure(ctrl_dma_chan, &ctrl_cfg,
+        &dma_hw->ch[self->dma_chan].al2_write_addr_trig, // dst
+        &self->loop_buffer_addr, // src
+        1, // transfer count
+        false // don't start yet
+        );
+
+    channel_config_set_transfer_data_size(&(self->cfg), bytes_per_sample == 2 ? DMA_SIZE_16 : DMA_SIZE_8);
+    channel_config_set_chain_to(&(self->cfg), ctrl_dma_chan);
+    // The raw completion flag tells us when the buffer has been filled once.
+    // The channel's interrupt is never enabled so nothing else clears it.
+    dma_hw->intr = 1u << self->dma_chan;
+    dma_channel_configure(self->dma_chan, &(self->cfg),
+        buffer, // dst
+        &adc_hw->fifo, // src
+        self->loop_sample_count, // transfer count
+        true // start immediately
+        );
+
+    self->looping = true;
+    adc_run(true);
+}
+
+void common_hal_analogbufio_bufferedin_stop_loop(analogbufio_bufferedin_obj_t *self) {
+    if (!self->looping) {
+        return;
+    }
+    adc_run(false);
+    // Turn off chaining before aborting anything because aborting the data
+    // channel can trigger the channel it is chained to. Chaining to itself
+    // turns chaining off, which is also what single reads need.
+    channel_config_set_chain_to(&(self->cfg), self->dma_chan);
+    dma_channel_set_config(self->dma_chan, &(self->cfg), false);
+    dma_channel_abort(self->ctrl_dma_chan);
+    dma_channel_abort(self->dma_chan);
+    dma_channel_unclaim(self->ctrl_dma_chan);
+    self->ctrl_dma_chan = -1;
+    adc_fifo_drain();
+    self->loop_buffer = NULL;
+    self->looping = false;
+}
+
+bool common_hal_analogbufio_bufferedin_get_looping(analogbufio_bufferedin_obj_t *self) {
+    return self->looping;
+}
+
+uint32_t common_hal_analogbufio_bufferedin_get_write_index(analogbufio_bufferedin_obj_t *self) {
+    if (!self->looping) {
+        return 0;
+    }
+    uint32_t offset = dma_channel_hw_addr(self->dma_chan)->write_addr - self->loop_buffer_addr;
+    uint32_t index = offset / self->loop_bytes_per_sample;
+    // Between passes the write address is briefly at the end of the buffer.
+    if (index >= self->loop_sample_count) {
+        index = 0;
+    }
+    return index;
+}
+
+static void copy_samples(analogbufio_bufferedin_obj_t *self, uint32_t start, uint32_t count, uint8_t *out, uint8_t bytes_per_sample) {
+    if (self->loop_bytes_per_sample == 2) {
+        const uint16_t *src = (const uint16_t *)self->loop_buffer + start;
+        for (uint32_t i = 0; i < count; i++) {
+            uint16_t value = src[i] & 0xfff;
+            if (bytes_per_sample == 2) {
+                // Scale the values to the standard 16 bit range.
+                ((uint16_t *)out)[i] = (value << 4) | (value >> 8);
+            } else {
+                out[i] = value >> 4;
+            }
+        }
+    } else {
+        const uint8_t *src = self->loop_buffer + start;
+        if (bytes_per_sample == 1) {
+            memcpy(out, src, count);
+        } else {
+            for (uint32_t i = 0; i < count; i++) {
+                ((uint16_t *)out)[i] = src[i] << 8 | src[i];
+            }
+        }
+    }
+}
+
+uint32_t common_hal_analogbufio_bufferedin_read_last(analogbufio_bufferedin_obj_t *self, uint8_t *buffer, uint32_t len, uint8_t bytes_per_sample) {
+    if (!self->looping) {
+        return 0;
+    }
+    // Read the index before the filled flag. If the buffer wraps in between
+    // we only miss out on older samples.
+    uint32_t write_index = common_hal_analogbufio_bufferedin_get_write_index(self);
+    bool filled = (dma_hw->intr & (1u << self->dma_chan)) != 0;
+    uint32_t available = filled ? self->loop_sample_count : write_index;
+    uint32_t count = MIN(len / bytes_per_sample, available);
+
+    // Copy oldest first, in up to two pieces around the end of the buffer.
+    uint32_t start = (write_index + self->loop_sample_count - count) % self->loop_sample_count;
+    uint32_t first = MIN(count, self->loop_sample_count - start);
+    copy_samples(self, start, first, buffer, bytes_per_sample);
+    copy_samples(self, 0, count - first, buffer + first * bytes_per_sample, bytes_per_sample);
+    return count;
+}
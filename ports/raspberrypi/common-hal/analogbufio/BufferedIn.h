@@ -19,4 +19,12 @@ typedef struct {
     uint8_t chan;
     uint dma_chan;
     dma_channel_config cfg;
+    // Looping capture. The control channel rewrites the data channel's write
+    // address from loop_buffer_addr each time it finishes, restarting it.
+    uint8_t *loop_buffer;
+    uint32_t loop_buffer_addr;
+    uint32_t loop_sample_count;
+    int ctrl_dma_chan;
+    uint8_t loop_bytes_per_sample;
+    bool looping;
 } analogbufio_bufferedin_obj_t;
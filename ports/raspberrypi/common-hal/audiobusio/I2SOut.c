@@ -223,7 +223,7 @@ void common_hal_audiobusio_i2sout_deinit(audiobusio_i2sout_obj_t *self) {
 }
 
 void common_hal_audiobusio_i2sout_play(audiobusio_i2sout_obj_t *self,
-    mp_obj_t sample, bool loop) {
+    mp_obj_t sample, bool loop, uint8_t buffer_count, uint32_t target_latency_us) {
     if (common_hal_audiobusio_i2sout_get_playing(self)) {
         common_hal_audiobusio_i2sout_stop(self);
     }
@@ -262,7 +262,9 @@ void common_hal_audiobusio_i2sout_play(audiobusio_i2sout_obj_t *self,
         bits_per_sample,
         (uint32_t)&self->state_machine.pio->txf[self->state_machine.state_machine],  // output register
         self->state_machine.tx_dreq, // data request line
-        false); // swap channel
+        false, // swap channel
+        buffer_count,
+        target_latency_us);
 
     if (result == AUDIO_DMA_DMA_BUSY) {
         common_hal_audiobusio_i2sout_stop(self);
@@ -289,6 +291,10 @@ bool common_hal_audiobusio_i2sout_get_paused(audiobusio_i2sout_obj_t *self) {
     return audio_dma_get_paused(&self->dma);
 }
 
+void common_hal_audiobusio_i2sout_get_dma_stats(audiobusio_i2sout_obj_t *self, audiocore_dma_stats_t *stats) {
+    audio_dma_get_stats(&self->dma, stats);
+}
+
 void common_hal_audiobusio_i2sout_stop(audiobusio_i2sout_obj_t *self) {
     audio_dma_stop(&self->dma);
 
@@ -28,6 +28,62 @@ const uint16_t pdmin[] = {
     0x8040
 };
 
+// a windowed sinc filter for 44 khz, 64 samples
+//
+// This filter is good enough to use for lower sample rates as
+// well. It does not increase the noise enough to be a problem.
+//
+// In the long run we could use a fast filter like this to do the
+// decimation and initial filtering in real time, filtering to a
+// higher sample rate than specified.  Then after the audio is
+// recorded, a more expensive filter non-real-time filter could be
+// used to down-sample and low-pass.
+const uint16_t sinc_filter[OVERSAMPLING] = {
+    0, 2, 9, 21, 39, 63, 94, 132,
+    179, 236, 302, 379, 467, 565, 674, 792,
+    920, 1055, 1196, 1341, 1487, 1633, 1776, 1913,
+    2042, 2159, 2263, 2352, 2422, 2474, 2506, 2516,
+    2506, 2474, 2422, 2352, 2263, 2159, 2042, 1913,
+    1776, 1633, 1487, 1341, 1196, 1055, 920, 792,
+    674, 565, 467, 379, 302, 236, 179, 132,
+    94, 63, 39, 21, 9, 2, 0, 0
+};
+
+// The filter is applied a byte of PDM bits at a time. Each of the eight groups
+// of 256 entries holds the sum of the taps for the set bits of one byte, so a
+// sample takes eight lookups instead of 64 bit tests. The sums wrap the same way
+// the running sum does, so the result matches summing the taps one by one.
+#define FILTER_TABLE_GROUPS (OVERSAMPLING / 8)
+
+static void build_filter_table(uint16_t *table) {
+    for (size_t group = 0; group < FILTER_TABLE_GROUPS; group++) {
+        const uint16_t *taps = sinc_filter + group * 8;
+        for (size_t value = 0; value < 256; value++) {
+            uint16_t sum = 0;
+            // Bits arrive lsb first.
+            for (size_t bit = 0; bit < 8; bit++) {
+                if (value & (1 << bit)) {
+                    sum += taps[bit];
+                }
+            }
+            *table++ = sum;
+        }
+    }
+}
+
+static uint16_t filter_sample(const uint16_t *table, uint32_t pdm_samples[2]) {
+    uint16_t running_sum = 0;
+    for (uint8_t i = 0; i < 2; i++) {
+        uint32_t pdm_sample = pdm_samples[i];
+        for (uint8_t j = 0; j < 4; j++) {
+            running_sum += table[pdm_sample & 0xff];
+            table += 256;
+            pdm_sample >>= 8;
+        }
+    }
+    return running_sum;
+}
+
 // Caller validates that pins are free.
 void common_hal_audiobusio_pdmin_construct(audiobusio_pdmin_obj_t *self,
     const mcu_pin_obj_t *clock_pin,
@@ -40,6 +96,10 @@ void common_hal_audiobusio_pdmin_construct(audiobusio_pdmin_obj_t *self,
         mp_raise_NotImplementedError_varg(MP_ERROR_TEXT("Only 8 or 16 bit mono with %dx oversampling supported."), OVERSAMPLING);
     }
 
+    // Allocate before claiming any pins so a MemoryError leaves nothing behind.
+    self->filter_table = m_malloc(FILTER_TABLE_GROUPS * 256 * sizeof(uint16_t));
+    build_filter_table(self->filter_table);
+
     // Use the state machine to manage pins.
     common_hal_rp2pio_statemachine_construct(&self->state_machine,
         pdmin, MP_ARRAY_SIZE(pdmin),
@@ -78,6 +138,7 @@ void common_hal_audiobusio_pdmin_deinit(audiobusio_pdmin_obj_t *self) {
     if (common_hal_audiobusio_pdmin_deinited(self)) {
         return;
     }
+    self->filter_table = NULL;
     return common_hal_rp2pio_statemachine_deinit(&self->state_machine);
 }
 
@@ -89,46 +150,6 @@ uint32_t common_hal_audiobusio_pdmin_get_sample_rate(audiobusio_pdmin_obj_t *sel
     return self->sample_rate;
 }
 
-// a windowed sinc filter for 44 khz, 64 samples
-//
-// This filter is good enough to use for lower sample rates as
-// well. It does not increase the noise enough to be a problem.
-//
-// In the long run we could use a fast filter like this to do the
-// decimation and initial filtering in real time, filtering to a
-// higher sample rate than specified.  Then after the audio is
-// recorded, a more expensive filter non-real-time filter could be
-// used to down-sample and low-pass.
-const uint16_t sinc_filter[OVERSAMPLING] = {
-    0, 2, 9, 21, 39, 63, 94, 132,
-    179, 236, 302, 379, 467, 565, 674, 792,
-    920, 1055, 1196, 1341, 1487, 1633, 1776, 1913,
-    2042, 2159, 2263, 2352, 2422, 2474, 2506, 2516,
-    2506, 2474, 2422, 2352, 2263, 2159, 2042, 1913,
-    1776, 1633, 1487, 1341, 1196, 1055, 920, 792,
-    674, 565, 467, 379, 302, 236, 179, 132,
-    94, 63, 39, 21, 9, 2, 0, 0
-};
-
-#define REPEAT_32_TIMES(X) do { X X X X X X X X X X X X X X X X X X X X X X X X X X X X X X X X } while (0)
-
-static uint16_t filter_sample(uint32_t pdm_samples[2]) {
-    uint16_t running_sum = 0;
-    const uint16_t *filter_ptr = sinc_filter;
-    for (uint8_t i = 0; i < 2; i++) {
-        uint32_t pdm_sample = pdm_samples[i];
-        REPEAT_32_TIMES({
-            if (pdm_sample & 0x1) {
-                running_sum += *filter_ptr;
-            }
-            filter_ptr++;
-            pdm_sample >>= 1;
-        }
-            );
-    }
-    return running_sum;
-}
-
 // output_buffer may be a byte buffer or a halfword buffer.
 // output_buffer_length is the number of slots, not the number of bytes.
 uint32_t common_hal_audiobusio_pdmin_record_to_buffer(audiobusio_pdmin_obj_t *self,
@@ -141,7 +162,7 @@ uint32_t common_hal_audiobusio_pdmin_record_to_buffer(audiobusio_pdmin_obj_t *se
     while (output_count < output_buffer_length && !common_hal_rp2pio_statemachine_get_rxstall(&self->state_machine)) {
         common_hal_rp2pio_statemachine_readinto(&self->state_machine, (uint8_t *)samples, 2 * sizeof(uint32_t), sizeof(uint32_t), false);
         // Call filter_sample just one place so it can be inlined.
-        uint16_t value = filter_sample(samples);
+        uint16_t value = filter_sample(self->filter_table, samples);
         if (self->bit_depth == 8) {
             // Truncate to 8 bits.
             ((uint8_t *)output_buffer)[output_count] = value >> 8;
@@ -19,6 +19,8 @@ typedef struct {
     uint8_t clock_unit;
     uint8_t bytes_per_sample;
     uint8_t bit_depth;
+    // Partial sums of the filter for every value of each byte of a sample.
+    uint16_t *filter_table;
     rp2pio_statemachine_obj_t state_machine;
 } audiobusio_pdmin_obj_t;
 
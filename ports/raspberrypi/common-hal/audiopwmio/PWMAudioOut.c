@@ -154,7 +154,8 @@ void common_hal_audiopwmio_pwmaudioout_deinit(audiopwmio_pwmaudioout_obj_t *self
     audio_dma_deinit(&self->dma);
 }
 
-void common_hal_audiopwmio_pwmaudioout_play(audiopwmio_pwmaudioout_obj_t *self, mp_obj_t sample, bool loop) {
+void common_hal_audiopwmio_pwmaudioout_play(audiopwmio_pwmaudioout_obj_t *self,
+    mp_obj_t sample, bool loop, uint8_t buffer_count, uint32_t target_latency_us) {
 
     if (common_hal_audiopwmio_pwmaudioout_get_playing(self)) {
         common_hal_audiopwmio_pwmaudioout_stop(self);
@@ -204,7 +205,9 @@ void common_hal_audiopwmio_pwmaudioout_play(audiopwmio_pwmaudioout_obj_t *self,
         BITS_PER_SAMPLE,
         (uint32_t)tx_register,  // output register: PWM cc register
         0x3b + pacing_timer, // data request line
-        self->swap_channel);
+        self->swap_channel,
+        buffer_count,
+        target_latency_us);
 
     if (result == AUDIO_DMA_DMA_BUSY) {
         common_hal_audiopwmio_pwmaudioout_stop(self);
@@ -255,3 +258,7 @@ void common_hal_audiopwmio_pwmaudioout_resume(audiopwmio_pwmaudioout_obj_t *self
 bool common_hal_audiopwmio_pwmaudioout_get_paused(audiopwmio_pwmaudioout_obj_t *self) {
     return audio_dma_get_paused(&self->dma);
 }
+
+void common_hal_audiopwmio_pwmaudioout_get_dma_stats(audiopwmio_pwmaudioout_obj_t *self, audiocore_dma_stats_t *stats) {
+    audio_dma_get_stats(&self->dma, stats);
+}
@@ -77,6 +77,7 @@ void common_hal_busio_spi_construct(busio_spi_obj_t *self,
 
     self->target_frequency = 250000;
     self->real_frequency = spi_init(self->peripheral, self->target_frequency);
+    self->write_dma_channel = -1;
 
     gpio_set_function(clock->number, GPIO_FUNC_SPI);
     claim_pin(clock);
@@ -111,6 +112,7 @@ void common_hal_busio_spi_deinit(busio_spi_obj_t *self) {
     if (common_hal_busio_spi_deinited(self)) {
         return;
     }
+    common_hal_busio_spi_wait_for_write(self);
     never_reset_spi[spi_get_index(self->peripheral)] = false;
     spi_deinit(self->peripheral);
 
@@ -163,12 +165,14 @@ bool common_hal_busio_spi_has_lock(busio_spi_obj_t *self) {
 }
 
 void common_hal_busio_spi_unlock(busio_spi_obj_t *self) {
+    common_hal_busio_spi_wait_for_write(self);
     self->has_lock = false;
 }
 
 static bool _transfer(busio_spi_obj_t *self,
     const uint8_t *data_out, size_t out_len,
     uint8_t *data_in, size_t in_len) {
+    common_hal_busio_spi_wait_for_write(self);
     // Use DMA for large transfers if channels are available
     const size_t dma_min_size_threshold = 32;
     int chan_tx = -1;
@@ -256,6 +260,51 @@ bool common_hal_busio_spi_write(busio_spi_obj_t *self,
     return _transfer(self, data, len, (uint8_t *)&data_in, MIN(len, 4));
 }
 
+bool common_hal_busio_spi_start_write(busio_spi_obj_t *self,
+    const uint8_t *data, size_t len) {
+    common_hal_busio_spi_wait_for_write(self);
+    // Small writes aren't worth the DMA setup.
+    const size_t dma_min_size_threshold = 32;
+    int chan_tx = -1;
+    if (len >= dma_min_size_threshold) {
+        chan_tx = dma_claim_unused_channel(false);
+    }
+    if (chan_tx < 0) {
+        return common_hal_busio_spi_write(self, data, len);
+    }
+    // Only the TX FIFO is serviced. Anything clocked in is dropped once the write is done.
+    dma_channel_config c = dma_channel_get_default_config(chan_tx);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_dreq(&c, spi_get_index(self->peripheral) ? DREQ_SPI1_TX : DREQ_SPI0_TX);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    self->write_dma_channel = chan_tx;
+    dma_channel_configure(chan_tx, &c,
+        &spi_get_hw(self->peripheral)->dr,
+        data,
+        len,
+        true);
+    return true;
+}
+
+void common_hal_busio_spi_wait_for_write(busio_spi_obj_t *self) {
+    if (self->write_dma_channel < 0) {
+        return;
+    }
+    while (dma_channel_is_busy(self->write_dma_channel)) {
+        RUN_BACKGROUND_TASKS;
+    }
+    dma_channel_unclaim(self->write_dma_channel);
+    self->write_dma_channel = -1;
+    // Let the last bytes shift out and then drain the RX FIFO and its overrun flag.
+    while (spi_is_busy(self->peripheral)) {
+    }
+    while (spi_is_readable(self->peripheral)) {
+        (void)spi_get_hw(self->peripheral)->dr;
+    }
+    spi_get_hw(self->peripheral)->icr = SPI_SSPICR_RORIC_BITS;
+}
+
 bool common_hal_busio_spi_read(busio_spi_obj_t *self,
     uint8_t *data, size_t len, uint8_t write_value) {
     uint32_t data_out = write_value << 24 | write_value << 16 | write_value << 8 | write_value;
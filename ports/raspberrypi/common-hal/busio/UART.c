@@ -14,6 +14,7 @@
 #include "common-hal/microcontroller/Pin.h"
 #include "shared-bindings/microcontroller/Pin.h"
 
+#include "src/rp2_common/hardware_dma/include/hardware/dma.h"
 #include "src/rp2_common/hardware_irq/include/hardware/irq.h"
 #include "src/rp2_common/hardware_gpio/include/hardware/gpio.h"
 
@@ -28,11 +29,106 @@ typedef enum {
 } uart_status_t;
 
 static uart_status_t uart_status[NUM_UARTS];
+static busio_uart_obj_t *active_uarts[NUM_UARTS];
+
+// The largest ring the DMA can wrap within.
+#define RX_DMA_MAX_RING_BITS (15)
+
+// Receives into a DMA ring when one can be set up, so that no byte waits on an interrupt.
+// Falls back to the interrupt and ringbuf otherwise.
+static bool _start_rx_dma(busio_uart_obj_t *self, uint16_t receiver_buffer_size) {
+    uint ring_bits = 1;
+    while ((1u << ring_bits) < receiver_buffer_size) {
+        ring_bits++;
+    }
+    if (ring_bits > RX_DMA_MAX_RING_BITS) {
+        return false;
+    }
+    uint32_t ring_size = 1u << ring_bits;
+    int channel = dma_claim_unused_channel(false);
+    if (channel < 0) {
+        return false;
+    }
+    // Allocate twice the ring so an aligned ring fits inside.
+    uint8_t *allocation = m_malloc_maybe(2 * ring_size);
+    if (allocation == NULL) {
+        dma_channel_unclaim(channel);
+        return false;
+    }
+    self->rx_dma_allocation = allocation;
+    self->rx_dma_ring = (const volatile uint8_t *)(((uintptr_t)allocation + ring_size - 1) & ~(uintptr_t)(ring_size - 1));
+    self->rx_dma_ring_size = ring_size;
+    self->rx_dma_read = 0;
+    self->rx_dma_used = 0;
+    self->rx_dma_last_count = UINT32_MAX;
+    self->rx_dma_channel = channel;
+
+    hw_set_bits(&uart_get_hw(self->uart)->dmacr, UART_UARTDMACR_RXDMAE_BITS);
+    dma_channel_config c = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_dreq(&c, uart_get_dreq(self->uart, false));
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, ring_bits);
+    dma_channel_configure(channel, &c,
+        (void *)self->rx_dma_ring, // dst
+        &uart_get_hw(self->uart)->dr, // src
+        UINT32_MAX, // transfer count, hours of data even at 3 Mbaud
+        true // start immediately
+        );
+    return true;
+}
+
+static void _stop_rx_dma(busio_uart_obj_t *self) {
+    if (self->rx_dma_channel < 0) {
+        return;
+    }
+    dma_channel_abort(self->rx_dma_channel);
+    dma_channel_unclaim(self->rx_dma_channel);
+    self->rx_dma_channel = -1;
+    self->rx_dma_allocation = NULL;
+    self->rx_dma_ring = NULL;
+}
+
+// Accounts for what the DMA has written since the last call. If the ring was lapped, the
+// oldest bytes were overwritten and reading resumes from the oldest that remain.
+static void _update_rx_dma(busio_uart_obj_t *self) {
+    uint32_t count = dma_channel_hw_addr(self->rx_dma_channel)->transfer_count;
+    uint32_t written = self->rx_dma_last_count - count;
+    self->rx_dma_last_count = count;
+    uint32_t mask = self->rx_dma_ring_size - 1;
+    uint32_t write = (dma_channel_hw_addr(self->rx_dma_channel)->write_addr - (uintptr_t)self->rx_dma_ring) & mask;
+    if (self->rx_dma_used + written >= self->rx_dma_ring_size) {
+        self->rx_dma_read = write;
+        self->rx_dma_used = self->rx_dma_ring_size;
+    } else {
+        self->rx_dma_used = (write - self->rx_dma_read) & mask;
+    }
+    if (!dma_channel_is_busy(self->rx_dma_channel)) {
+        // The count ran out. The write address carries on around the ring.
+        self->rx_dma_last_count = UINT32_MAX;
+        dma_channel_set_trans_count(self->rx_dma_channel, UINT32_MAX, true);
+    }
+}
+
+static size_t _read_rx_dma(busio_uart_obj_t *self, uint8_t *data, size_t len) {
+    _update_rx_dma(self);
+    size_t total = MIN(len, self->rx_dma_used);
+    for (size_t i = 0; i < total; i++) {
+        data[i] = self->rx_dma_ring[self->rx_dma_read];
+        self->rx_dma_read = (self->rx_dma_read + 1) & (self->rx_dma_ring_size - 1);
+    }
+    self->rx_dma_used -= total;
+    return total;
+}
 
 void reset_uart(void) {
     for (uint8_t num = 0; num < NUM_UARTS; num++) {
         if (uart_status[num] == STATUS_BUSY) {
             uart_status[num] = STATUS_FREE;
+            if (active_uarts[num] != NULL) {
+                _stop_rx_dma(active_uarts[num]);
+            }
             uart_deinit(UART_INST(num));
         }
     }
@@ -54,8 +150,6 @@ static uint8_t pin_init(const uint8_t uart, const mcu_pin_obj_t *pin, const uint
     return pin->number;
 }
 
-static busio_uart_obj_t *active_uarts[NUM_UARTS];
-
 static void _copy_into_ringbuf(ringbuf_t *r, uart_inst_t *uart) {
     while (uart_is_readable(uart) && ringbuf_num_empty(r) > 0) {
         ringbuf_put(r, (uint8_t)uart_get_hw(uart)->dr);
@@ -64,6 +158,9 @@ static void _copy_into_ringbuf(ringbuf_t *r, uart_inst_t *uart) {
 
 static void shared_callback(busio_uart_obj_t *self) {
     _copy_into_ringbuf(&self->ringbuf, self->uart);
+    #if MICROPY_PY_SELECT_POLL_GEN
+    mp_stream_poll_gen_bump(&self->rx_poll_gen);
+    #endif
     // We always clear the interrupt so it doesn't continue to fire because we
     // may not have read everything available.
     uart_get_hw(self->uart)->icr = UART_UARTICR_RXIC_BITS | UART_UARTICR_RTIC_BITS;
@@ -134,9 +231,12 @@ void common_hal_busio_uart_construct(busio_uart_obj_t *self,
     uart_set_format(self->uart, bits, stop, parity);
     uart_set_hw_flow(self->uart, (cts != NULL), (rts != NULL));
 
+    self->rx_dma_channel = -1;
     if (rx != NULL) {
         // Use the provided buffer when given.
-        if (receiver_buffer != NULL) {
+        if (receiver_buffer == NULL && _start_rx_dma(self, receiver_buffer_size)) {
+            ringbuf_init(&self->ringbuf, NULL, 0);
+        } else if (receiver_buffer != NULL) {
             ringbuf_init(&self->ringbuf, receiver_buffer, receiver_buffer_size);
         } else {
             if (!ringbuf_alloc(&self->ringbuf, receiver_buffer_size)) {
@@ -155,7 +255,7 @@ void common_hal_busio_uart_construct(busio_uart_obj_t *self,
         irq_set_exclusive_handler(self->uart_irq_id, uart0_callback);
     }
     irq_set_enabled(self->uart_irq_id, true);
-    uart_set_irq_enables(self->uart, true /* rx has data */, false /* tx needs data */);
+    uart_set_irq_enables(self->uart, self->rx_dma_channel < 0 /* rx has data */, false /* tx needs data */);
 }
 
 bool common_hal_busio_uart_deinited(busio_uart_obj_t *self) {
@@ -166,6 +266,7 @@ void common_hal_busio_uart_deinit(busio_uart_obj_t *self) {
     if (common_hal_busio_uart_deinited(self)) {
         return;
     }
+    _stop_rx_dma(self);
     uart_deinit(self->uart);
     ringbuf_deinit(&self->ringbuf);
     active_uarts[self->uart_id] = NULL;
@@ -221,6 +322,30 @@ size_t common_hal_busio_uart_read(busio_uart_obj_t *self, uint8_t *data, size_t
         return 0;
     }
 
+    if (self->rx_dma_channel >= 0) {
+        size_t total_read = _read_rx_dma(self, data, len);
+        uint64_t start_ticks = supervisor_ticks_ms64();
+        // Busy-wait until timeout or until we've read enough chars.
+        while (total_read < len && (supervisor_ticks_ms64() - start_ticks < self->timeout_ms)) {
+            size_t n = _read_rx_dma(self, data + total_read, len - total_read);
+            if (n > 0) {
+                total_read += n;
+                // Reset the timeout whenever more arrives.
+                start_ticks = supervisor_ticks_ms64();
+            }
+            RUN_BACKGROUND_TASKS;
+            // Allow user to break out of a timeout with a KeyboardInterrupt.
+            if (mp_hal_is_interrupted()) {
+                break;
+            }
+        }
+        if (total_read == 0) {
+            *errcode = EAGAIN;
+            return MP_STREAM_ERROR;
+        }
+        return total_read;
+    }
+
     // Prevent conflict with uart irq.
     irq_set_enabled(self->uart_irq_id, false);
 
@@ -286,6 +411,10 @@ void common_hal_busio_uart_set_timeout(busio_uart_obj_t *self, mp_float_t timeou
 }
 
 uint32_t common_hal_busio_uart_rx_characters_available(busio_uart_obj_t *self) {
+    if (self->rx_dma_channel >= 0) {
+        _update_rx_dma(self);
+        return self->rx_dma_used;
+    }
     // Prevent conflict with uart irq.
     irq_set_enabled(self->uart_irq_id, false);
     // The UART only interrupts after a threshold so make sure to copy anything
@@ -296,6 +425,12 @@ uint32_t common_hal_busio_uart_rx_characters_available(busio_uart_obj_t *self) {
 }
 
 void common_hal_busio_uart_clear_rx_buffer(busio_uart_obj_t *self) {
+    if (self->rx_dma_channel >= 0) {
+        _update_rx_dma(self);
+        self->rx_dma_read = (self->rx_dma_read + self->rx_dma_used) & (self->rx_dma_ring_size - 1);
+        self->rx_dma_used = 0;
+        return;
+    }
     // Prevent conflict with uart irq.
     irq_set_enabled(self->uart_irq_id, false);
     ringbuf_clear(&self->ringbuf);
@@ -314,6 +449,16 @@ bool common_hal_busio_uart_ready_to_tx(busio_uart_obj_t *self) {
     return uart_is_writable(self->uart);
 }
 
+#if MICROPY_PY_SELECT_POLL_GEN
+volatile mp_uint_t *common_hal_busio_uart_get_rx_poll_gen(busio_uart_obj_t *self) {
+    // Without the receive interrupt there's nothing to bump the counter.
+    if (self->rx_dma_channel >= 0) {
+        return NULL;
+    }
+    return &self->rx_poll_gen;
+}
+#endif
+
 static void pin_never_reset(uint8_t pin) {
     if (pin != NO_PIN) {
         never_reset_pin_number(pin);
@@ -25,6 +25,18 @@ typedef struct {
     uint32_t timeout_ms;
     uart_inst_t *uart;
     ringbuf_t ringbuf;
+    // When rx_dma_channel >= 0, received bytes are written by DMA into the ring instead of
+    // the ringbuf. The ring is aligned to its power of two size within rx_dma_allocation.
+    int rx_dma_channel;
+    uint8_t *rx_dma_allocation;
+    const volatile uint8_t *rx_dma_ring;
+    uint32_t rx_dma_ring_size;
+    uint32_t rx_dma_read;
+    uint32_t rx_dma_used;
+    uint32_t rx_dma_last_count;
+    #if MICROPY_PY_SELECT_POLL_GEN
+    volatile mp_uint_t rx_poll_gen;
+    #endif
 } busio_uart_obj_t;
 
 extern void reset_uart(void);
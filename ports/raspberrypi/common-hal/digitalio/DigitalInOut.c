@@ -11,6 +11,7 @@
 #include "py/mphal.h"
 
 #include "common-hal/microcontroller/Pin.h"
+#include "common-hal/neopixel_write/__init__.h"
 #include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/digitalio/DigitalInOut.h"
 
@@ -57,6 +58,9 @@ void common_hal_digitalio_digitalinout_deinit(digitalio_digitalinout_obj_t *self
     if (common_hal_digitalio_digitalinout_deinited(self)) {
         return;
     }
+    #if CIRCUITPY_NEOPIXEL_WRITE
+    neopixel_write_wait(self->pin);
+    #endif
     common_hal_reset_pin(self->pin);
     self->pin = NULL;
 }
@@ -12,6 +12,8 @@
 #include "shared-bindings/time/__init__.h"
 #include "supervisor/shared/tick.h"
 
+#include "src/rp2_common/hardware_dma/include/hardware/dma.h"
+
 static const uint16_t fluxread_program[] = {
     // ; Count flux pulses and watch for index pin
     // ; flux input is the 'jmp pin'.  index is "pin zero".
@@ -47,28 +49,12 @@ static const uint16_t fluxread_program[] = {
     0x0040, //     jmp x--, wait_one
 };
 
-typedef struct {
-    PIO pio;
-    uint8_t sm;
-    bool word_available;
-    uint16_t half;
-} floppy_reader;
-
-static bool data_available(floppy_reader *reader) {
-    return reader->word_available || !pio_sm_is_rx_fifo_empty(reader->pio, reader->sm);
-}
-
-static uint16_t read_fifo(floppy_reader *reader) {
-    if (reader->word_available) {
-        reader->word_available = false;
-        return reader->half;
-    }
-    uint32_t value = pio_sm_get_blocking(reader->pio, reader->sm);
-    reader->half = value >> 16;
-    reader->word_available = true;
-    return value & 0xffff;
-}
-
+// Flux samples are moved out of the PIO by DMA into a small ring so that
+// interrupts can stay on. Each word holds two samples. The ring must be
+// aligned to its size for the DMA's address wrapping.
+#define FLUX_RING_SIZE_BITS (11)
+#define FLUX_RING_BYTES (1 << FLUX_RING_SIZE_BITS)
+#define FLUX_RING_WORDS (FLUX_RING_BYTES / sizeof(uint32_t))
 
 int common_hal_floppyio_flux_readinto(void *buf, size_t len, digitalio_digitalinout_obj_t *data, digitalio_digitalinout_obj_t *index, mp_int_t index_wait_ms) {
 #define READ_INDEX() (!!(*index_port & index_mask))
@@ -77,6 +63,16 @@ int common_hal_floppyio_flux_readinto(void *buf, size_t len, digitalio_digitalin
 
     memset(buf, 0, len);
 
+    // Allocate twice the ring so an aligned ring fits inside.
+    uint8_t *ring_allocation = m_malloc(2 * FLUX_RING_BYTES);
+    const volatile uint32_t *ring = (const volatile uint32_t *)(((uintptr_t)ring_allocation + FLUX_RING_BYTES - 1) & ~(uintptr_t)(FLUX_RING_BYTES - 1));
+
+    int channel = dma_claim_unused_channel(false);
+    if (channel < 0) {
+        m_free(ring_allocation);
+        mp_raise_RuntimeError(MP_ERROR_TEXT("No DMA channel found"));
+    }
+
     uint32_t pins_we_use = 1 << data->pin->number;
 
     rp2pio_statemachine_obj_t state_machine;
@@ -102,62 +98,92 @@ int common_hal_floppyio_flux_readinto(void *buf, size_t len, digitalio_digitalin
         PIO_ANY_OFFSET  // offset
         );
     if (!ok) {
+        dma_channel_unclaim(channel);
+        m_free(ring_allocation);
         mp_raise_RuntimeError(MP_ERROR_TEXT("All state machines in use"));
     }
 
-    floppy_reader reader = { .pio = state_machine.pio, .sm = state_machine.state_machine, };
+    PIO pio = state_machine.pio;
+    uint sm = state_machine.state_machine;
+    const char *error = NULL;
 
     uint8_t *ptr = buf, *end = ptr + len;
 
     uint64_t index_deadline_us = time_us_64() + index_wait_ms * 1000;
 
-    common_hal_mcu_disable_interrupts();
-
     // check if flux is arriving
     uint64_t flux_deadline_us = time_us_64() + 20;
-    while (pio_sm_is_rx_fifo_empty(reader.pio, reader.sm)) {
+    while (pio_sm_is_rx_fifo_empty(pio, sm)) {
         if (time_us_64() > flux_deadline_us) {
-            common_hal_mcu_enable_interrupts();
-            common_hal_rp2pio_statemachine_deinit(&state_machine);
-            mp_raise_RuntimeError(MP_ERROR_TEXT("timeout waiting for flux"));
+            error = MP_ERROR_TEXT("timeout waiting for flux");
+            goto done;
         }
     }
 
     // wait for index pulse low
     while (READ_INDEX()) {
         if (time_us_64() > index_deadline_us) {
-            common_hal_mcu_enable_interrupts();
-            common_hal_rp2pio_statemachine_deinit(&state_machine);
-            mp_raise_RuntimeError(MP_ERROR_TEXT("timeout waiting for index pulse"));
+            error = MP_ERROR_TEXT("timeout waiting for index pulse");
+            goto done;
         }
     }
 
-    pio_sm_clear_fifos(reader.pio, reader.sm);
+    pio_sm_clear_fifos(pio, sm);
+
+    dma_channel_config c = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, false));
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, FLUX_RING_SIZE_BITS);
+    dma_channel_configure(channel, &c,
+        (void *)ring, // dst
+        &pio->rxf[sm], // src
+        UINT32_MAX, // transfer count, far more than one revolution
+        true // start immediately
+        );
 
     // if another index doesn't show up ...
     index_deadline_us = time_us_64() + index_wait_ms * 1000;
 
-    int last = read_fifo(&reader);
-    bool last_index = READ_INDEX();
+    // Bit 0 of each sample is the index pin and the rest is the inverted count.
+    size_t words_read = 0;
+    uint32_t word = 0;
+    bool have_half = false;
+    int last = -1;
+    bool last_index = true;
     while (ptr != end) {
+        if (!have_half) {
+            size_t words_written = UINT32_MAX - dma_channel_hw_addr(channel)->transfer_count;
+            if (words_written == words_read) {
+                // no flux is arriving? is ANY flux arriving or has a full revolution gone by?
+                if (time_us_64() > index_deadline_us) {
+                    break;
+                }
+                continue;
+            }
+            if (words_written - words_read > FLUX_RING_WORDS) {
+                error = MP_ERROR_TEXT("flux capture overrun");
+                break;
+            }
+            word = ring[words_read % FLUX_RING_WORDS];
+            words_read++;
+        }
+        int timestamp = have_half ? word >> 16 : word & 0xffff;
+        have_half = !have_half;
 
         /* Handle index */
-        bool now_index = READ_INDEX();
-
-        if (!now_index && last_index) {
+        bool now_index = timestamp & 1;
+        if (!now_index && last_index && last >= 0) {
             break;
         }
         last_index = now_index;
 
-        if (!data_available(&reader)) {
-            // no flux is arriving? is ANY flux arriving or has a full revoulution gone by?
-            if (time_us_64() > index_deadline_us) {
-                break;
-            }
+        if (last < 0) {
+            last = timestamp;
             continue;
         }
 
-        int timestamp = read_fifo(&reader);
         int delta = last - timestamp;
         if (delta < 0) {
             delta += 65536;
@@ -168,8 +194,15 @@ int common_hal_floppyio_flux_readinto(void *buf, size_t len, digitalio_digitalin
         *ptr++ = delta > 255 ? 255 : delta;
     }
 
-    common_hal_mcu_enable_interrupts();
+done:
+    dma_channel_abort(channel);
+    dma_channel_unclaim(channel);
+    m_free(ring_allocation);
     common_hal_rp2pio_statemachine_deinit(&state_machine);
 
+    if (error) {
+        mp_raise_RuntimeError(error);
+    }
+
     return ptr - (uint8_t *)buf;
 }
@@ -108,6 +108,7 @@ void common_hal_imagecapture_parallelimagecapture_deinit(imagecapture_parallelim
     if (common_hal_imagecapture_parallelimagecapture_deinited(self)) {
         return;
     }
+    common_hal_imagecapture_parallelimagecapture_continuous_capture_stop(self);
     return common_hal_rp2pio_statemachine_deinit(&self->state_machine);
 }
 
@@ -115,10 +116,8 @@ bool common_hal_imagecapture_parallelimagecapture_deinited(imagecapture_parallel
     return common_hal_rp2pio_statemachine_deinited(&self->state_machine);
 }
 
-void common_hal_imagecapture_parallelimagecapture_singleshot_capture(imagecapture_parallelimagecapture_obj_t *self, mp_obj_t buffer) {
-    mp_buffer_info_t bufinfo;
-    mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_RW);
-
+// Start the program over so that it waits for the next vertical sync.
+static void restart_capture(imagecapture_parallelimagecapture_obj_t *self) {
     PIO pio = self->state_machine.pio;
     uint sm = self->state_machine.state_machine;
     uint8_t offset = rp2pio_statemachine_program_offset(&self->state_machine);
@@ -129,8 +128,66 @@ void common_hal_imagecapture_parallelimagecapture_singleshot_capture(imagecaptur
     pio_sm_restart(pio, sm);
     pio_sm_exec(pio, sm, pio_encode_jmp(offset));
     pio_sm_set_enabled(pio, sm, true);
+}
+
+void common_hal_imagecapture_parallelimagecapture_singleshot_capture(imagecapture_parallelimagecapture_obj_t *self, mp_obj_t buffer) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_RW);
+
+    common_hal_imagecapture_parallelimagecapture_continuous_capture_stop(self);
+    restart_capture(self);
 
     common_hal_rp2pio_statemachine_readinto(&self->state_machine, bufinfo.buf, bufinfo.len, 4, false);
 
-    pio_sm_set_enabled(pio, sm, false);
+    pio_sm_set_enabled(self->state_machine.pio, self->state_machine.state_machine, false);
+}
+
+void common_hal_imagecapture_parallelimagecapture_continuous_capture_start(imagecapture_parallelimagecapture_obj_t *self, mp_obj_t buffer1, mp_obj_t buffer2) {
+    sm_buf_info once = {0};
+    sm_buf_info loop = {.obj = buffer1};
+    sm_buf_info loop2 = {.obj = buffer2};
+    mp_get_buffer_raise(buffer1, &loop.info, MP_BUFFER_RW);
+    mp_get_buffer_raise(buffer2, &loop2.info, MP_BUFFER_RW);
+
+    common_hal_imagecapture_parallelimagecapture_continuous_capture_stop(self);
+    restart_capture(self);
+
+    // After the first frame the program keeps capturing without waiting for
+    // vertical sync again. Each buffer holds exactly one frame so the DMA
+    // moves to the other buffer at the start of every frame. The state
+    // machine holds the buffers so they can't be collected while capturing.
+    if (!common_hal_rp2pio_statemachine_background_read(&self->state_machine, &once, &loop, &loop2, 4, false)) {
+        pio_sm_set_enabled(self->state_machine.pio, self->state_machine.state_machine, false);
+        mp_raise_RuntimeError(MP_ERROR_TEXT("No DMA channel found"));
+    }
+}
+
+void common_hal_imagecapture_parallelimagecapture_continuous_capture_stop(imagecapture_parallelimagecapture_obj_t *self) {
+    if (!common_hal_rp2pio_statemachine_get_reading(&self->state_machine)) {
+        return;
+    }
+    pio_sm_set_enabled(self->state_machine.pio, self->state_machine.state_machine, false);
+    common_hal_rp2pio_statemachine_stop_background_read(&self->state_machine);
+}
+
+mp_obj_t common_hal_imagecapture_parallelimagecapture_continuous_capture_get_frame(imagecapture_parallelimagecapture_obj_t *self) {
+    // Return the newest frame that hasn't been returned yet, waiting for one
+    // if needed.
+    while (true) {
+        mp_obj_t frame = common_hal_rp2pio_statemachine_get_last_read(&self->state_machine);
+        if (frame != mp_const_empty_bytes) {
+            return frame;
+        }
+        if (!common_hal_rp2pio_statemachine_get_reading(&self->state_machine)) {
+            mp_raise_RuntimeError(MP_ERROR_TEXT("Not capturing"));
+        }
+        RUN_BACKGROUND_TASKS;
+        if (mp_hal_is_interrupted()) {
+            return mp_const_none;
+        }
+    }
+}
+
+mp_int_t common_hal_imagecapture_parallelimagecapture_get_dropped_frames(imagecapture_parallelimagecapture_obj_t *self) {
+    return self->state_machine.last_read_overwritten;
 }
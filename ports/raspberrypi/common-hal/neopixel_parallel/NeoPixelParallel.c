@@ -0,0 +1,219 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "shared-bindings/neopixel_parallel/NeoPixelParallel.h"
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "shared-bindings/adafruit_pixelbuf/PixelBuf.h"
+#include "shared-bindings/microcontroller/Pin.h"
+#include "supervisor/port.h"
+
+// Every strip gets the same bit at once. A bit is 10 cycles at 8 MHz: 3 high, then
+// 3 more high for a one or low for a zero, then 4 low. The state machine waits in the
+// low part for the next bit, so stalling between bits is harmless.
+static const uint16_t neopixel_parallel_program8[] = {
+// .wrap_target
+    0x6028, // out x, 8
+    0xa20b, // mov pins, !null [2]
+    0xa201, // mov pins, x     [2]
+    0xa203, // mov pins, null  [2]
+// .wrap
+};
+
+static const uint16_t neopixel_parallel_program16[] = {
+// .wrap_target
+    0x6030, // out x, 16
+    0xa20b, // mov pins, !null [2]
+    0xa201, // mov pins, x     [2]
+    0xa203, // mov pins, null  [2]
+// .wrap
+};
+
+void common_hal_neopixel_parallel_neopixelparallel_construct(neopixel_parallel_neopixelparallel_obj_t *self,
+    const mcu_pin_obj_t *data0, mp_obj_t strips) {
+    size_t strip_count;
+    mp_obj_t *items;
+    mp_obj_tuple_get(strips, &strip_count, &items);
+
+    uint8_t data_pin = data0->number;
+    if (data_pin + strip_count > NUM_BANK0_GPIOS) {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("%q out of range"), MP_QSTR_strips);
+    }
+    for (uint8_t i = 1; i < strip_count; i++) {
+        if (!pin_number_is_free(data_pin + i)) {
+            mp_raise_ValueError_varg(MP_ERROR_TEXT("Bus pin %d is already in use"), i);
+        }
+    }
+
+    bool wide = strip_count > 8;
+    uint32_t pin_mask = (1u << strip_count) - 1;
+    common_hal_rp2pio_statemachine_construct(&self->state_machine,
+        wide ? neopixel_parallel_program16 : neopixel_parallel_program8,
+        wide ? MP_ARRAY_SIZE(neopixel_parallel_program16) : MP_ARRAY_SIZE(neopixel_parallel_program8),
+        8000000, // 10 cycles per 1.25us bit
+        NULL, 0, // init
+        NULL, 0, // may_exec
+        data0, strip_count, 0, pin_mask, // first out pin, # out pins, start low as outputs
+        NULL, 0, 0, 0, // first in pin, # in pins
+        NULL, 0, 0, 0, // first set pin
+        NULL, 0, 0, 0, // first sideset pin
+        false, // No sideset enable
+        NULL, PULL_NONE, // jump pin
+        0, // wait gpio pins
+        true, // exclusive pin usage
+        true, wide ? 16 : 8, false, // TX, auto pull every entry. shift left to take the entry from the top
+        false, // wait for TX stall
+        false, 32, true, // RX setting we don't use
+        false, // Not user-interruptible.
+        0, -1, // wrap settings
+        PIO_ANY_OFFSET);
+
+    self->strips = strips;
+    self->planes = NULL;
+    self->planes_size = 0;
+    self->next_start_raw_ticks = 0;
+    self->data0_pin = data_pin;
+    self->strip_count = strip_count;
+    self->transmitting = false;
+    self->draining = false;
+}
+
+bool common_hal_neopixel_parallel_neopixelparallel_deinited(neopixel_parallel_neopixelparallel_obj_t *self) {
+    return self->strips == MP_OBJ_NULL;
+}
+
+// Returns true once the last show() is completely out, including the final bit.
+static bool _transmit_done(neopixel_parallel_neopixelparallel_obj_t *self) {
+    rp2pio_statemachine_obj_t *state_machine = &self->state_machine;
+    if (!self->transmitting) {
+        return true;
+    }
+    if (common_hal_rp2pio_statemachine_get_writing(state_machine) ||
+        !pio_sm_is_tx_fifo_empty(state_machine->pio, state_machine->state_machine)) {
+        return false;
+    }
+    // The last entry may still be going out. The state machine stalls once it is done.
+    if (!self->draining) {
+        common_hal_rp2pio_statemachine_clear_txstall(state_machine);
+        self->draining = true;
+        return false;
+    }
+    if (!common_hal_rp2pio_statemachine_get_txstall(state_machine)) {
+        return false;
+    }
+    self->transmitting = false;
+    // Give the strips at least 300us of low to latch the data.
+    self->next_start_raw_ticks = port_get_raw_ticks(NULL) + 2;
+    return true;
+}
+
+static void _wait_for_transmit(neopixel_parallel_neopixelparallel_obj_t *self) {
+    while (!_transmit_done(self)) {
+        RUN_BACKGROUND_TASKS;
+    }
+}
+
+void common_hal_neopixel_parallel_neopixelparallel_deinit(neopixel_parallel_neopixelparallel_obj_t *self) {
+    if (common_hal_neopixel_parallel_neopixelparallel_deinited(self)) {
+        return;
+    }
+    _wait_for_transmit(self);
+    common_hal_rp2pio_statemachine_deinit(&self->state_machine);
+    self->strips = MP_OBJ_NULL;
+    self->planes = NULL;
+    self->planes_size = 0;
+}
+
+bool common_hal_neopixel_parallel_neopixelparallel_get_busy(neopixel_parallel_neopixelparallel_obj_t *self) {
+    return !_transmit_done(self);
+}
+
+// Transposes an 8x8 bit matrix held one row per byte, so that bit b of byte s
+// becomes bit s of byte b.
+static inline uint64_t _transpose8(uint64_t x) {
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00aa00aa00aa00aaULL;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000cccc0000ccccULL;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000f0f0f0f0ULL;
+    x = x ^ t ^ (t << 28);
+    return x;
+}
+
+void common_hal_neopixel_parallel_neopixelparallel_show(neopixel_parallel_neopixelparallel_obj_t *self) {
+    size_t strip_count;
+    mp_obj_t *items;
+    mp_obj_tuple_get(self->strips, &strip_count, &items);
+
+    const uint8_t *data[NEOPIXEL_PARALLEL_MAX_STRIPS];
+    size_t len[NEOPIXEL_PARALLEL_MAX_STRIPS];
+    size_t max_len = 0;
+    for (size_t s = 0; s < strip_count; s++) {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(common_hal_adafruit_pixelbuf_pixelbuf_get_transmit_buffer(items[s]), &bufinfo, MP_BUFFER_READ);
+        data[s] = bufinfo.buf;
+        len[s] = bufinfo.len;
+        max_len = MAX(max_len, bufinfo.len);
+    }
+    if (max_len == 0) {
+        return;
+    }
+
+    // The planes are still being sent until this is done.
+    _wait_for_transmit(self);
+
+    size_t groups = (strip_count + 7) / 8;
+    size_t planes_size = max_len * 8 * groups;
+    if (self->planes_size < planes_size) {
+        // The old planes will be gc'd; don't free them.
+        self->planes = NULL;
+        self->planes_size = 0;
+        self->planes = m_malloc(planes_size);
+        self->planes_size = planes_size;
+    }
+
+    // Entry 8 * i + k holds bit 7 - k of byte i of every strip, so each byte goes
+    // out most significant bit first. Shorter strips are padded with zeros.
+    uint8_t *planes = self->planes;
+    for (size_t i = 0; i < max_len; i++) {
+        for (size_t g = 0; g < groups; g++) {
+            uint64_t x = 0;
+            for (size_t s = g * 8; s < MIN(strip_count, g * 8 + 8); s++) {
+                if (i < len[s]) {
+                    x |= (uint64_t)data[s][i] << (8 * (s - g * 8));
+                }
+            }
+            x = _transpose8(x);
+            for (size_t k = 0; k < 8; k++) {
+                planes[(8 * i + k) * groups + g] = x >> (8 * (7 - k));
+            }
+        }
+    }
+
+    while (port_get_raw_ticks(NULL) < self->next_start_raw_ticks) {
+        RUN_BACKGROUND_TASKS;
+    }
+
+    sm_buf_info once = {
+        .obj = mp_const_none,
+        .info = { .buf = planes, .len = planes_size },
+    };
+    sm_buf_info loop = { 0 };
+    self->draining = false;
+    self->transmitting = true;
+    if (!common_hal_rp2pio_statemachine_background_write(&self->state_machine, &once, &loop, groups, false)) {
+        // No DMA channel to spare, so send it while we wait.
+        self->transmitting = false;
+        common_hal_rp2pio_statemachine_write(&self->state_machine, planes, planes_size, groups, false);
+        common_hal_rp2pio_statemachine_clear_txstall(&self->state_machine);
+        while (!common_hal_rp2pio_statemachine_get_txstall(&self->state_machine)) {
+        }
+        self->next_start_raw_ticks = port_get_raw_ticks(NULL) + 2;
+    }
+}
@@ -0,0 +1,31 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+#include "bindings/rp2pio/StateMachine.h"
+#include "common-hal/rp2pio/StateMachine.h"
+
+// One bit of every strip goes out in each FIFO entry, so this is the widest
+// entry that the PIO program handles.
+#define NEOPIXEL_PARALLEL_MAX_STRIPS (16)
+
+typedef struct {
+    mp_obj_base_t base;
+    rp2pio_statemachine_obj_t state_machine;
+    mp_obj_t strips; // tuple of PixelBufs
+    // The strips' bytes transposed into one FIFO entry per bit time. Entries are
+    // uint8_t for up to 8 strips and uint16_t beyond that.
+    uint8_t *planes;
+    size_t planes_size;
+    uint64_t next_start_raw_ticks;
+    uint8_t data0_pin;
+    uint8_t strip_count;
+    bool transmitting;
+    // The DMA is done and we are waiting for the last entry to leave the state machine.
+    bool draining;
+} neopixel_parallel_neopixelparallel_obj_t;
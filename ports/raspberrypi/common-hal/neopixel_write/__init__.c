@@ -4,8 +4,14 @@
 //
 // SPDX-License-Identifier: MIT
 
+#include <string.h>
+
 #include "shared-bindings/neopixel_write/__init__.h"
+#include "common-hal/neopixel_write/__init__.h"
 
+#include "py/gc.h"
+#include "py/mpstate.h"
+#include "py/runtime.h"
 #include "bindings/rp2pio/StateMachine.h"
 #include "common-hal/rp2pio/StateMachine.h"
 #include "shared-bindings/microcontroller/__init__.h"
@@ -13,6 +19,8 @@
 
 #include "supervisor/port.h"
 
+#include "src/rp2_common/hardware_gpio/include/hardware/gpio.h"
+
 uint64_t next_start_raw_ticks = 0;
 
 // NeoPixels are 800khz bit streams. We are choosing zeros as <312ns hi, 936 lo> and ones
@@ -34,14 +42,15 @@ const uint16_t neopixel_program[] = {
     0xa442
 };
 
-void common_hal_neopixel_write(const digitalio_digitalinout_obj_t *digitalinout, uint8_t *pixels, uint32_t num_bytes) {
-    // Set everything up.
-    rp2pio_statemachine_obj_t state_machine;
+// The state machine of a transmission that may still be running. Only one pin is
+// driven at a time; a write to any pin first waits for the previous one to finish.
+static rp2pio_statemachine_obj_t _neopixel_state_machine;
+static uint8_t _neopixel_pin_number = NUM_BANK0_GPIOS;
+static size_t _neopixel_buffer_size = 0;
 
-    // TODO: Cache the state machine after we create it once. We'll need a way to
-    // change the pins then though.
-    uint32_t pins_we_use = 1 << digitalinout->pin->number;
-    bool ok = rp2pio_statemachine_construct(&state_machine,
+static bool _neopixel_construct(rp2pio_statemachine_obj_t *state_machine, const mcu_pin_obj_t *pin) {
+    uint32_t pins_we_use = 1 << pin->number;
+    return rp2pio_statemachine_construct(state_machine,
         neopixel_program, MP_ARRAY_SIZE(neopixel_program),
         12800000, // 12.8MHz, to get appropriate sub-bit times in PIO program.
         NULL, 0, // init program
@@ -49,7 +58,7 @@ void common_hal_neopixel_write(const digitalio_digitalinout_obj_t *digitalinout,
         NULL, 1, // in
         0, 0, // in pulls
         NULL, 1, // set
-        digitalinout->pin, 1, // sideset
+        pin, 1, // sideset
         0, pins_we_use, // initial pin state
         NULL, // jump pin
         pins_we_use, true, false,
@@ -62,6 +71,78 @@ void common_hal_neopixel_write(const digitalio_digitalinout_obj_t *digitalinout,
         0, -1, // wrap
         PIO_ANY_OFFSET  // offset
         );
+}
+
+static void _neopixel_release(rp2pio_statemachine_obj_t *state_machine, uint8_t pin_number) {
+    // Use a private deinit of the state machine that doesn't reset the pin.
+    rp2pio_statemachine_deinit(state_machine, true);
+
+    // Reset the pin and release it from the PIO, leaving it driven low.
+    gpio_init(pin_number);
+    gpio_put(pin_number, false);
+    gpio_set_dir(pin_number, GPIO_OUT);
+
+    // Update the next start to +2 ticks. This ensures we give it at least 300us.
+    next_start_raw_ticks = port_get_raw_ticks(NULL) + 2;
+}
+
+// Wait for a background transmission to finish and give its pin back.
+static void _neopixel_finish(void) {
+    if (_neopixel_pin_number == NUM_BANK0_GPIOS) {
+        return;
+    }
+    rp2pio_statemachine_obj_t *state_machine = &_neopixel_state_machine;
+    while (common_hal_rp2pio_statemachine_get_writing(state_machine) ||
+           !pio_sm_is_tx_fifo_empty(state_machine->pio, state_machine->state_machine)) {
+        RUN_BACKGROUND_TASKS;
+    }
+    // The last byte may still be shifting out. The state machine stalls once it is done.
+    common_hal_rp2pio_statemachine_clear_txstall(state_machine);
+    while (!common_hal_rp2pio_statemachine_get_txstall(state_machine)) {
+    }
+    _neopixel_release(state_machine, _neopixel_pin_number);
+    _neopixel_pin_number = NUM_BANK0_GPIOS;
+}
+
+void neopixel_write_wait(const mcu_pin_obj_t *pin) {
+    if (pin->number == _neopixel_pin_number) {
+        _neopixel_finish();
+    }
+}
+
+// Called during reset_port(), before the state machines are reset.
+void neopixel_write_reset(void) {
+    _neopixel_finish();
+    MP_STATE_PORT(neopixel_transmit_buffer) = NULL;
+    _neopixel_buffer_size = 0;
+}
+
+// Returns a copy of pixels that stays valid until the transmission is done, or NULL
+// when there's no heap to put it in.
+static uint8_t *_neopixel_buffer(const uint8_t *pixels, uint32_t num_bytes) {
+    if (!gc_alloc_possible()) {
+        return NULL;
+    }
+    if (_neopixel_buffer_size < num_bytes) {
+        // Old buffer will be gc'd; don't free it.
+        _neopixel_buffer_size = 0;
+        MP_STATE_PORT(neopixel_transmit_buffer) = m_malloc_maybe(num_bytes);
+        if (MP_STATE_PORT(neopixel_transmit_buffer) == NULL) {
+            return NULL;
+        }
+        _neopixel_buffer_size = num_bytes;
+    }
+    memcpy(MP_STATE_PORT(neopixel_transmit_buffer), pixels, num_bytes);
+    return MP_STATE_PORT(neopixel_transmit_buffer);
+}
+
+void common_hal_neopixel_write(const digitalio_digitalinout_obj_t *digitalinout, uint8_t *pixels, uint32_t num_bytes) {
+    // Only one transmission at a time, and each needs the pin to itself.
+    _neopixel_finish();
+
+    // Set everything up.
+    rp2pio_statemachine_obj_t *state_machine = &_neopixel_state_machine;
+    bool ok = _neopixel_construct(state_machine, digitalinout->pin);
     if (!ok) {
         // Do nothing. Maybe bitbang?
         return;
@@ -72,15 +153,24 @@ void common_hal_neopixel_write(const digitalio_digitalinout_obj_t *digitalinout,
     while (port_get_raw_ticks(NULL) < next_start_raw_ticks) {
     }
 
-    common_hal_rp2pio_statemachine_write(&state_machine, pixels, num_bytes, 1 /* stride in bytes */, false);
-
-    // Use a private deinit of the state machine that doesn't reset the pin.
-    rp2pio_statemachine_deinit(&state_machine, true);
-
-    // Reset the pin and release it from the PIO
-    gpio_init(digitalinout->pin->number);
-    common_hal_digitalio_digitalinout_switch_to_output((digitalio_digitalinout_obj_t *)digitalinout, false, DRIVE_MODE_PUSH_PULL);
+    // Send from a copy, so the caller may change its pixels as soon as we return, and
+    // let DMA feed the state machine while the caller carries on.
+    uint8_t *buffer = _neopixel_buffer(pixels, num_bytes);
+    if (buffer != NULL) {
+        sm_buf_info once = {
+            .obj = mp_const_none,
+            .info = { .buf = buffer, .len = num_bytes },
+        };
+        sm_buf_info loop = { 0 };
+        if (common_hal_rp2pio_statemachine_background_write(state_machine, &once, &loop, 1 /* stride in bytes */, false)) {
+            _neopixel_pin_number = digitalinout->pin->number;
+            return;
+        }
+    }
 
-    // Update the next start to +2 ticks. This ensures we give it at least 300us.
-    next_start_raw_ticks = port_get_raw_ticks(NULL) + 2;
+    // No memory or DMA channel to spare, so send it while we wait.
+    common_hal_rp2pio_statemachine_write(state_machine, pixels, num_bytes, 1 /* stride in bytes */, false);
+    _neopixel_release(state_machine, digitalinout->pin->number);
 }
+
+MP_REGISTER_ROOT_POINTER(uint8_t * neopixel_transmit_buffer);
@@ -0,0 +1,13 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2021 Scott Shawcroft for Adafruit Industries
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "common-hal/microcontroller/Pin.h"
+
+// Wait for a background transmission on pin, if any, to finish.
+void neopixel_write_wait(const mcu_pin_obj_t *pin);
+void neopixel_write_reset(void);
@@ -12,6 +12,7 @@
 #include "py/runtime.h"
 #include "src/rp2_common/hardware_flash/include/hardware/flash.h"
 #include "shared-bindings/microcontroller/__init__.h"
+#include "supervisor/second_core.h"
 
 extern uint32_t __flash_binary_start;
 static const uint32_t flash_binary_start = (uint32_t)&__flash_binary_start;
@@ -27,16 +28,20 @@ static void write_page(uint32_t page_addr, uint32_t offset, uint32_t len, uint8_
     // since we can only write a whole page at a time.
     if (offset == 0 && len == FLASH_PAGE_SIZE) {
         // disable interrupts to prevent core hang on rp2040
+        rp2_second_core_pause();
         common_hal_mcu_disable_interrupts();
         flash_range_program(RMV_OFFSET(page_addr), bytes, FLASH_PAGE_SIZE);
         common_hal_mcu_enable_interrupts();
+        rp2_second_core_resume();
     } else {
         uint8_t buffer[FLASH_PAGE_SIZE];
         memcpy(buffer, (uint8_t *)page_addr, FLASH_PAGE_SIZE);
         memcpy(buffer + offset, bytes, len);
+        rp2_second_core_pause();
         common_hal_mcu_disable_interrupts();
         flash_range_program(RMV_OFFSET(page_addr), buffer, FLASH_PAGE_SIZE);
         common_hal_mcu_enable_interrupts();
+        rp2_second_core_resume();
     }
 
 }
@@ -56,10 +61,12 @@ static void erase_and_write_sector(uint32_t address, uint32_t len, uint8_t *byte
     #pragma GCC diagnostic pop
     memcpy(buffer + address, bytes, len);
     // disable interrupts to prevent core hang on rp2040
+    rp2_second_core_pause();
     common_hal_mcu_disable_interrupts();
     flash_range_erase(RMV_OFFSET(CIRCUITPY_INTERNAL_NVM_START_ADDR), FLASH_SECTOR_SIZE);
     flash_range_program(RMV_OFFSET(CIRCUITPY_INTERNAL_NVM_START_ADDR), buffer, FLASH_SECTOR_SIZE);
     common_hal_mcu_enable_interrupts();
+    rp2_second_core_resume();
 }
 
 void common_hal_nvm_bytearray_get_bytes(const nvm_bytearray_obj_t *self,
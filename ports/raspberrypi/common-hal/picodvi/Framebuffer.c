@@ -12,6 +12,7 @@
 #include "common-hal/pwmio/PWMOut.h"
 #include "common-hal/rp2pio/StateMachine.h"
 #include "supervisor/port.h"
+#include "supervisor/second_core.h"
 
 #include "src/common/pico_stdlib/include/pico/stdlib.h"
 #include "src/rp2040/hardware_structs/include/hardware/structs/mpu.h"
@@ -26,6 +27,50 @@ picodvi_framebuffer_obj_t *active_picodvi = NULL;
 
 static PIO pio_instances[2] = {pio0, pio1};
 
+// Full width color framebuffers are palette indexed. Each palette entry is
+// stored as three precomputed TMDS symbols (blue, green, red) that are DC
+// balanced on their own, so any symbol may follow any other without tracking
+// the running disparity. The table lives after the TMDS buffers. For 4 bit
+// framebuffers it is indexed by a whole byte (two pixels) and holds the two
+// symbols already packed into a word for each lane. For 8 bit framebuffers it
+// is indexed by pixel and holds one symbol per lane.
+#define PALETTE_WORDS (256 * 3)
+
+static inline bool _indexed_color(picodvi_framebuffer_obj_t *self) {
+    return self->width > 400 && self->color_depth >= 4;
+}
+
+static inline uint32_t *_palette_table(picodvi_framebuffer_obj_t *self) {
+    return self->framebuffer + self->framebuffer_len + DVI_N_TMDS_BUFFERS * self->tmdsbuf_size;
+}
+
+static void __not_in_flash_func(_encode_indexed_4bpp)(const uint32_t *scanbuf, uint32_t *tmdsbuf, uint words_per_channel, const uint32_t *table) {
+    const uint8_t *pixels = (const uint8_t *)scanbuf;
+    uint32_t *blue = tmdsbuf;
+    uint32_t *green = blue + words_per_channel;
+    uint32_t *red = green + words_per_channel;
+    for (uint i = 0; i < words_per_channel; i++) {
+        const uint32_t *entry = table + pixels[i] * 3;
+        blue[i] = entry[0];
+        green[i] = entry[1];
+        red[i] = entry[2];
+    }
+}
+
+static void __not_in_flash_func(_encode_indexed_8bpp)(const uint32_t *scanbuf, uint32_t *tmdsbuf, uint words_per_channel, const uint32_t *table) {
+    const uint8_t *pixels = (const uint8_t *)scanbuf;
+    uint32_t *blue = tmdsbuf;
+    uint32_t *green = blue + words_per_channel;
+    uint32_t *red = green + words_per_channel;
+    for (uint i = 0; i < words_per_channel; i++) {
+        const uint32_t *first = table + pixels[2 * i] * 3;
+        const uint32_t *second = table + pixels[2 * i + 1] * 3;
+        blue[i] = first[0] | second[0] << 10;
+        green[i] = first[1] | second[1] << 10;
+        red[i] = first[2] | second[2] << 10;
+    }
+}
+
 static void __not_in_flash_func(core1_main)(void) {
     // The MPU is reset before this starts.
 
@@ -68,7 +113,13 @@ static void __not_in_flash_func(core1_main)(void) {
         }
         uint pixwidth = self->dvi.timing->h_active_pixels;
         uint words_per_channel = pixwidth / DVI_SYMBOLS_PER_WORD;
-        if (self->color_depth == 8) {
+        if (_indexed_color(self)) {
+            if (self->color_depth == 4) {
+                _encode_indexed_4bpp(scanbuf, tmdsbuf, words_per_channel, _palette_table(self));
+            } else {
+                _encode_indexed_8bpp(scanbuf, tmdsbuf, words_per_channel, _palette_table(self));
+            }
+        } else if (self->color_depth == 8) {
             tmds_encode_data_channel_8bpp(scanbuf, tmdsbuf + 0 * words_per_channel, pixwidth / 2, DVI_8BPP_BLUE_MSB,  DVI_8BPP_BLUE_LSB);
             tmds_encode_data_channel_8bpp(scanbuf, tmdsbuf + 1 * words_per_channel, pixwidth / 2, DVI_8BPP_GREEN_MSB, DVI_8BPP_GREEN_LSB);
             tmds_encode_data_channel_8bpp(scanbuf, tmdsbuf + 2 * words_per_channel, pixwidth / 2, DVI_8BPP_RED_MSB,   DVI_8BPP_RED_LSB);
@@ -107,6 +158,82 @@ static void __not_in_flash_func(core1_scanline_callback)(void) {
     }
 }
 
+// Transition minimize an 8 bit value the way the TMDS encoder does, using xor
+// or xnor between bits.
+static uint8_t _tmds_transition_minimize(uint8_t value, bool xnor) {
+    uint8_t bit = value & 1;
+    uint8_t result = bit;
+    for (size_t i = 1; i < 8; i++) {
+        bit ^= (value >> i) & 1;
+        if (xnor) {
+            bit ^= 1;
+        }
+        result |= bit << i;
+    }
+    return result;
+}
+
+// Find a ten bit symbol with exactly five ones for the value closest to the
+// given one. The receiver decodes either the xor or xnor form, inverted or
+// not, so we are free to pick whichever is balanced. About three quarters of
+// values (including 0 and 255) have such a form so the colors are very close.
+static uint16_t _balanced_symbol(uint8_t value) {
+    for (int delta = 0; delta < 256; delta++) {
+        for (int sign = -1; sign <= 1; sign += 2) {
+            int candidate = value + sign * delta;
+            if (candidate < 0 || candidate > 255) {
+                continue;
+            }
+            for (size_t xnor = 0; xnor < 2; xnor++) {
+                uint16_t minimized = _tmds_transition_minimize(candidate, xnor);
+                // Bit 8 is set for xor and clear for xnor.
+                uint16_t plain = minimized | (xnor ? 0 : 1 << 8);
+                uint16_t inverted = (plain ^ 0xff) | 1 << 9;
+                if (__builtin_popcount(plain) == 5) {
+                    return plain;
+                }
+                if (__builtin_popcount(inverted) == 5) {
+                    return inverted;
+                }
+            }
+        }
+    }
+    // Unreachable because 0 has a balanced form.
+    return 0;
+}
+
+static void _set_palette_color(picodvi_framebuffer_obj_t *self, size_t index, uint32_t color_rgb888) {
+    uint32_t symbols[3] = {
+        _balanced_symbol(color_rgb888 & 0xff),
+        _balanced_symbol((color_rgb888 >> 8) & 0xff),
+        _balanced_symbol((color_rgb888 >> 16) & 0xff),
+    };
+    uint32_t *table = _palette_table(self);
+    if (self->color_depth == 8) {
+        for (size_t lane = 0; lane < 3; lane++) {
+            table[index * 3 + lane] = symbols[lane];
+        }
+        return;
+    }
+    // The low nibble is the first pixel and is sent first. The pair of two
+    // identical pixels holds the symbols for a palette entry on its own.
+    for (size_t other = 0; other < 16; other++) {
+        for (size_t lane = 0; lane < 3; lane++) {
+            uint32_t other_symbol = other == index ? symbols[lane] : table[(other * 0x11) * 3 + lane] & 0x3ff;
+            table[(index << 4 | other) * 3 + lane] = symbols[lane] | other_symbol << 10;
+            table[(other << 4 | index) * 3 + lane] = other_symbol | symbols[lane] << 10;
+        }
+    }
+}
+
+void common_hal_picodvi_framebuffer_set_palette_color(picodvi_framebuffer_obj_t *self, size_t index, uint32_t color_rgb888) {
+    _set_palette_color(self, index, color_rgb888);
+}
+
+bool common_hal_picodvi_framebuffer_get_indexed_color(picodvi_framebuffer_obj_t *self) {
+    return _indexed_color(self);
+}
+
 extern uint8_t dvi_vertical_repeat;
 extern bool dvi_monochrome_tmds;
 
@@ -121,7 +248,7 @@ void common_hal_picodvi_framebuffer_construct(picodvi_framebuffer_obj_t *self,
         mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("%q in use"), MP_QSTR_picodvi);
     }
 
-    bool color_framebuffer = color_depth >= 8;
+    bool color_framebuffer = color_depth >= 4;
     const struct dvi_timing *timing = NULL;
     if ((width == 640 && height == 480) ||
         (width == 320 && height == 240) ||
@@ -140,9 +267,10 @@ void common_hal_picodvi_framebuffer_construct(picodvi_framebuffer_obj_t *self,
         mp_raise_ValueError_varg(MP_ERROR_TEXT("Invalid %q"), MP_QSTR_width);
     }
 
-    // If the width is > 400, then it must not be color frame buffer and vice
-    // versa.
-    if ((width > 400) == color_framebuffer) {
+    // Full width framebuffers are grayscale or palette indexed color. Half
+    // width ones are RGB332 or RGB565 and each pixel is doubled.
+    bool full_width = width > 400;
+    if ((full_width && color_depth > 8) || (!full_width && color_depth < 8)) {
         mp_raise_ValueError_varg(MP_ERROR_TEXT("Invalid %q"), MP_QSTR_color_depth);
     }
 
@@ -209,7 +337,9 @@ void common_hal_picodvi_framebuffer_construct(picodvi_framebuffer_obj_t *self,
     if (color_framebuffer) {
         dvi_monochrome_tmds = false;
         tmds_bufs_per_scanline = 3;
-        scanline_width *= 2;
+        if (!full_width) {
+            scanline_width *= 2;
+        }
     } else {
         dvi_monochrome_tmds = true;
         // One tmds buffer is used for all three color outputs.
@@ -224,7 +354,8 @@ void common_hal_picodvi_framebuffer_construct(picodvi_framebuffer_obj_t *self,
     self->pitch /= sizeof(uint32_t);
     size_t framebuffer_size = self->pitch * self->height;
     self->tmdsbuf_size = tmds_bufs_per_scanline * scanline_width / DVI_SYMBOLS_PER_WORD + 1;
-    size_t total_allocation_size = sizeof(uint32_t) * (framebuffer_size + DVI_N_TMDS_BUFFERS * self->tmdsbuf_size);
+    size_t palette_size = full_width && color_framebuffer ? PALETTE_WORDS : 0;
+    size_t total_allocation_size = sizeof(uint32_t) * (framebuffer_size + DVI_N_TMDS_BUFFERS * self->tmdsbuf_size + palette_size);
     self->framebuffer = (uint32_t *)port_malloc(total_allocation_size, true);
     if (self->framebuffer == NULL) {
         m_malloc_fail(total_allocation_size);
@@ -235,6 +366,11 @@ void common_hal_picodvi_framebuffer_construct(picodvi_framebuffer_obj_t *self,
     if (!pwmio_claim_slice_ab_channels(slice)) {
         mp_raise_ValueError(MP_ERROR_TEXT("All timers for this pin are in use"));
     }
+    if (!rp2_core1_claim()) {
+        pwmout_free(slice, 0);
+        pwmout_free(slice, 1);
+        mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("%q in use"), MP_QSTR_core1);
+    }
     self->pwm_slice = slice;
 
     for (size_t i = 0; i < 4; i++) {
@@ -251,6 +387,20 @@ void common_hal_picodvi_framebuffer_construct(picodvi_framebuffer_obj_t *self,
     self->framebuffer_len = framebuffer_size;
     self->color_depth = color_depth;
 
+    // Start with the palette displayio expects: RGBD for 4 bits and RGB332
+    // for 8 bits.
+    if (_indexed_color(self)) {
+        for (size_t i = 0; i < (1 << color_depth); i++) {
+            uint32_t color_rgb888;
+            if (color_depth == 4) {
+                color_rgb888 = (i & 0x8 ? 0xff0000 : 0) | (i & 0x4 ? 0x00ff00 : 0) | (i & 0x2 ? 0x0000ff : 0);
+            } else {
+                color_rgb888 = (((i >> 5) & 0x7) * 255 / 7) << 16 | (((i >> 2) & 0x7) * 255 / 7) << 8 | (i & 0x3) * 255 / 3;
+            }
+            _set_palette_color(self, i, color_rgb888);
+        }
+    }
+
     self->dvi.timing = timing;
     self->dvi.ser_cfg.pio = pio_instances[pio_index];
     self->dvi.ser_cfg.sm_tmds[0] = free_state_machines[0];
@@ -327,6 +477,7 @@ void common_hal_picodvi_framebuffer_deinit(picodvi_framebuffer_obj_t *self) {
     multicore_reset_core1();
     spin_unlock(colour_lock, colour_save);
     spin_unlock(tmds_lock, tmds_save);
+    rp2_core1_release();
 
     for (size_t i = 0; i < 4; i++) {
         reset_pin_number(self->pin_pair[i]);
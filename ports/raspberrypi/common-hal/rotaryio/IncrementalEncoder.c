@@ -6,39 +6,60 @@
 
 #include "py/runtime.h"
 
-#include <hardware/regs/pio.h>
 #include "common-hal/rotaryio/IncrementalEncoder.h"
 #include "shared-bindings/rotaryio/IncrementalEncoder.h"
-#include "shared-module/rotaryio/IncrementalEncoder.h"
 #include "bindings/rp2pio/__init__.h"
 #include "bindings/rp2pio/StateMachine.h"
 
+// Counts quadrature steps entirely in the PIO, so no step is missed however
+// busy the CPU is. This is the pico-examples quadrature_encoder program. The
+// previous and current pin states make a 4-bit index that MOV PC jumps to in
+// the table at the start of the program, so it must be loaded at offset 0.
+// The count is kept in Y and pushed without blocking on every sample.
 static const uint16_t encoder[] = {
-    //  again:
-    //      in pins, 2
-    0x4002,
-    //      mov x, isr
-    0xa026,
-    //      jmp x!=y, push_data
-    0x00a5,
-    //      mov isr, null
-    0xa0c3,
-    //      jmp again
-    0x0000,
-    //  push_data:
-    //      push
-    0x8020,
-    //      mov y, x
-    0xa041,
+    // 00 state
+    0x000f, // jmp update     ; read 00
+    0x000e, // jmp decrement  ; read 01
+    0x0015, // jmp increment  ; read 10
+    0x000f, // jmp update     ; read 11
+    // 01 state
+    0x0015, // jmp increment  ; read 00
+    0x000f, // jmp update     ; read 01
+    0x000f, // jmp update     ; read 10
+    0x000e, // jmp decrement  ; read 11
+    // 10 state
+    0x000e, // jmp decrement  ; read 00
+    0x000f, // jmp update     ; read 01
+    0x000f, // jmp update     ; read 10
+    0x0015, // jmp increment  ; read 11
+    // 11 state, whose last two entries are the code they jump to
+    0x000f, // jmp update     ; read 00
+    0x0015, // jmp increment  ; read 01
+    //  decrement:
+    0x008f, // jmp y--, update ; read 10
+    //  update:               ; read 11, wrap target
+    0xa0c2, // mov isr, y
+    0x8000, // push noblock
+    0x60c2, // out isr, 2     ; The previous state from OSR
+    0x4002, // in pins, 2     ; and the current one make the index.
+    0xa0e6, // mov osr, isr
+    0xa0a6, // mov pc, isr
+    //  increment:
+    0xa04a, // mov y, ~y
+    0x0097, // jmp y--, increment_cont
+    //  increment_cont:
+    0xa04a, // mov y, ~y      ; wrap
 };
 
+#define ENCODER_WRAP_TARGET (15)
+
 static const uint16_t encoder_init[] = {
-    //      set y, 31
-    0xe05f,
+    // set y, 0
+    0xe040,
+    // mov osr, pins          ; Start from the current state.
+    0xa0e0,
 };
 
-static void incrementalencoder_interrupt_handler(void *self_in);
-
 void common_hal_rotaryio_incrementalencoder_construct(rotaryio_incrementalencoder_obj_t *self,
     const mcu_pin_obj_t *pin_a, const mcu_pin_obj_t *pin_b) {
     const mcu_pin_obj_t *pins[] = { pin_a, pin_b };
@@ -55,11 +76,10 @@ void common_hal_rotaryio_incrementalencoder_construct(rotaryio_incrementalencode
     }
 
     self->position = 0;
-    self->sub_count = 0;
 
     common_hal_rp2pio_statemachine_construct(&self->state_machine,
         encoder, MP_ARRAY_SIZE(encoder),
-        1000000,
+        0, // Full speed, so steps up to clk_sys / 10 are counted
         encoder_init, MP_ARRAY_SIZE(encoder_init), // init
         NULL, 0, // may_exec
         NULL, 0, 0, 0, // out pin
@@ -71,20 +91,15 @@ void common_hal_rotaryio_incrementalencoder_construct(rotaryio_incrementalencode
         NULL, PULL_NONE, // jump pin
         0, // wait gpio pins
         true, // exclusive pin use
-        false, 32, false, // out settings
+        false, 32, true, // out settings, shift right to take the previous state from the bottom
         false, // Wait for txstall
         false, 32, false, // in settings
         false, // Not user-interruptible.
-        0, MP_ARRAY_SIZE(encoder) - 1, // wrap settings
-        PIO_ANY_OFFSET
+        ENCODER_WRAP_TARGET, MP_ARRAY_SIZE(encoder) - 1, // wrap settings
+        0 // MOV PC jumps to absolute addresses
         );
 
-    // We're guaranteed by the init code that some output will be available promptly
-    uint8_t quiescent_state;
-    common_hal_rp2pio_statemachine_readinto(&self->state_machine, &quiescent_state, 1, 1, false);
-
-    shared_module_softencoder_state_init(self, quiescent_state & 3);
-    common_hal_rp2pio_statemachine_set_interrupt_handler(&self->state_machine, incrementalencoder_interrupt_handler, self, PIO_IRQ0_INTF_SM0_RXNEMPTY_BITS);
+    rotaryio_velocity_reset(&self->velocity, 0);
 }
 
 bool common_hal_rotaryio_incrementalencoder_deinited(rotaryio_incrementalencoder_obj_t *self) {
@@ -95,24 +110,47 @@ void common_hal_rotaryio_incrementalencoder_deinit(rotaryio_incrementalencoder_o
     if (common_hal_rotaryio_incrementalencoder_deinited(self)) {
         return;
     }
-    common_hal_rp2pio_statemachine_set_interrupt_handler(&self->state_machine, NULL, NULL, 0);
     common_hal_rp2pio_statemachine_deinit(&self->state_machine);
 }
 
-static void incrementalencoder_interrupt_handler(void *self_in) {
-    rotaryio_incrementalencoder_obj_t *self = self_in;
-
-    while (common_hal_rp2pio_statemachine_get_in_waiting(&self->state_machine)) {
-        // Bypass all the logic of StateMachine.c:_transfer, we need something
-        // very simple and fast for an interrupt!
-        uint8_t new_state = self->state_machine.pio->rxf[self->state_machine.state_machine];
-        if (self->swapped) {
-            if (new_state == 0x1) {
-                new_state = 0x2;
-            } else if (new_state == 0x2) {
-                new_state = 0x1;
-            }
-        }
-        shared_module_softencoder_state_update(self, new_state);
+// Steps counted since construction.
+static int32_t read_count(rotaryio_incrementalencoder_obj_t *self) {
+    PIO pio = self->state_machine.pio;
+    uint sm = self->state_machine.state_machine;
+    // The FIFO holds counts from when it filled up. Empty it and take the
+    // next push, which is at most a few cycles old.
+    uint n = pio_sm_get_rx_fifo_level(pio, sm) + 1;
+    uint32_t count = 0;
+    while (n-- > 0) {
+        count = pio_sm_get_blocking(pio, sm);
     }
+    // The program counts the other way when pin A is the lower pin.
+    return self->swapped ? -(int32_t)count : (int32_t)count;
+}
+
+mp_int_t common_hal_rotaryio_incrementalencoder_get_position(rotaryio_incrementalencoder_obj_t *self) {
+    mp_int_t position = (read_count(self) + self->position) / self->divisor;
+    rotaryio_velocity_update(&self->velocity, position);
+    return position;
+}
+
+void common_hal_rotaryio_incrementalencoder_set_position(rotaryio_incrementalencoder_obj_t *self,
+    mp_int_t new_position) {
+    // The count in the state machine keeps running, so remember the offset.
+    self->position = new_position * self->divisor - read_count(self);
+    rotaryio_velocity_reset(&self->velocity, new_position);
+}
+
+mp_float_t common_hal_rotaryio_incrementalencoder_get_velocity(rotaryio_incrementalencoder_obj_t *self) {
+    // The state machine doesn't time the steps, so note the count now.
+    common_hal_rotaryio_incrementalencoder_get_position(self);
+    return rotaryio_velocity_get(&self->velocity);
+}
+
+mp_int_t common_hal_rotaryio_incrementalencoder_get_divisor(rotaryio_incrementalencoder_obj_t *self) {
+    return self->divisor;
+}
+
+void common_hal_rotaryio_incrementalencoder_set_divisor(rotaryio_incrementalencoder_obj_t *self, mp_int_t divisor) {
+    self->divisor = divisor;
 }
@@ -43,6 +43,14 @@ static int8_t _sm_dma_plus_one[NUM_PIOS][NUM_PIO_STATE_MACHINES];
 #define SM_DMA_CLEAR_CHANNEL(pio_index, sm) (_sm_dma_plus_one[(pio_index)][(sm)] = 0)
 #define SM_DMA_SET_CHANNEL(pio_isntance, sm, channel) (_sm_dma_plus_one[(pio_index)][(sm)] = (channel) + 1)
 
+// The RX side of a background read uses its own channel so reads and writes can run together.
+static int8_t _sm_dma_plus_one_read[NUM_PIOS][NUM_PIO_STATE_MACHINES];
+
+#define SM_DMA_ALLOCATED_READ(pio_index, sm) (_sm_dma_plus_one_read[(pio_index)][(sm)] != 0)
+#define SM_DMA_GET_CHANNEL_READ(pio_index, sm) (_sm_dma_plus_one_read[(pio_index)][(sm)] - 1)
+#define SM_DMA_CLEAR_CHANNEL_READ(pio_index, sm) (_sm_dma_plus_one_read[(pio_index)][(sm)] = 0)
+#define SM_DMA_SET_CHANNEL_READ(pio_index, sm, channel) (_sm_dma_plus_one_read[(pio_index)][(sm)] = (channel) + 1)
+
 static PIO pio_instances[2] = {pio0, pio1};
 typedef void (*interrupt_handler_type)(void *);
 static interrupt_handler_type _interrupt_handler[NUM_PIOS][NUM_PIO_STATE_MACHINES];
@@ -61,24 +69,35 @@ static void rp2pio_statemachine_set_pull(uint32_t pull_pin_up, uint32_t pull_pin
     }
 }
 
+static void rp2pio_statemachine_release_dma_channel(int channel) {
+    uint32_t channel_mask = 1u << channel;
+    dma_hw->inte0 &= ~channel_mask;
+    if (!dma_hw->inte0) {
+        irq_set_mask_enabled(1 << DMA_IRQ_0, false);
+    }
+    MP_STATE_PORT(background_pio)[channel] = NULL;
+    dma_channel_abort(channel);
+    dma_channel_unclaim(channel);
+}
+
 static void rp2pio_statemachine_clear_dma(int pio_index, int sm) {
     if (SM_DMA_ALLOCATED(pio_index, sm)) {
-        int channel = SM_DMA_GET_CHANNEL(pio_index, sm);
-        uint32_t channel_mask = 1u << channel;
-        dma_hw->inte0 &= ~channel_mask;
-        if (!dma_hw->inte0) {
-            irq_set_mask_enabled(1 << DMA_IRQ_0, false);
-        }
-        MP_STATE_PORT(background_pio)[channel] = NULL;
-        dma_channel_abort(channel);
-        dma_channel_unclaim(channel);
+        rp2pio_statemachine_release_dma_channel(SM_DMA_GET_CHANNEL(pio_index, sm));
     }
     SM_DMA_CLEAR_CHANNEL(pio_index, sm);
 }
 
+static void rp2pio_statemachine_clear_dma_read(int pio_index, int sm) {
+    if (SM_DMA_ALLOCATED_READ(pio_index, sm)) {
+        rp2pio_statemachine_release_dma_channel(SM_DMA_GET_CHANNEL_READ(pio_index, sm));
+    }
+    SM_DMA_CLEAR_CHANNEL_READ(pio_index, sm);
+}
+
 static void _reset_statemachine(PIO pio, uint8_t sm, bool leave_pins) {
     uint8_t pio_index = pio_get_index(pio);
     rp2pio_statemachine_clear_dma(pio_index, sm);
+    rp2pio_statemachine_clear_dma_read(pio_index, sm);
     uint32_t program_id = _current_program_id[pio_index][sm];
     if (program_id == 0) {
         return;
@@ -672,6 +691,7 @@ void rp2pio_statemachine_never_reset(PIO pio, int sm) {
 void rp2pio_statemachine_deinit(rp2pio_statemachine_obj_t *self, bool leave_pins) {
     common_hal_rp2pio_statemachine_stop(self);
     (void)common_hal_rp2pio_statemachine_stop_background_write(self);
+    (void)common_hal_rp2pio_statemachine_stop_background_read(self);
 
     uint8_t sm = self->state_machine;
     uint8_t pio_index = pio_get_index(self->pio);
@@ -1047,7 +1067,16 @@ bool common_hal_rp2pio_statemachine_background_write(rp2pio_statemachine_obj_t *
     return true;
 }
 
+static void rp2pio_statemachine_dma_complete_read(rp2pio_statemachine_obj_t *self, int channel);
+
 void rp2pio_statemachine_dma_complete(rp2pio_statemachine_obj_t *self, int channel) {
+    uint8_t pio_index = pio_get_index(self->pio);
+    uint8_t sm = self->state_machine;
+    if (SM_DMA_ALLOCATED_READ(pio_index, sm) && SM_DMA_GET_CHANNEL_READ(pio_index, sm) == channel) {
+        rp2pio_statemachine_dma_complete_read(self, channel);
+        return;
+    }
+
     self->current = self->once;
     self->once = self->loop;
 
@@ -1078,10 +1107,171 @@ bool common_hal_rp2pio_statemachine_get_writing(rp2pio_statemachine_obj_t *self)
     return !self->dma_completed;
 }
 
-int common_hal_rp2pio_statemachine_get_pending(rp2pio_statemachine_obj_t *self) {
+mp_int_t common_hal_rp2pio_statemachine_get_pending(rp2pio_statemachine_obj_t *self) {
     return self->pending_buffers;
 }
 
+bool common_hal_rp2pio_statemachine_background_read(rp2pio_statemachine_obj_t *self, const sm_buf_info *once, const sm_buf_info *loop, const sm_buf_info *loop2, uint8_t stride_in_bytes, bool swap) {
+    if (!self->in) {
+        mp_raise_RuntimeError(MP_ERROR_TEXT("No in in program"));
+    }
+
+    uint8_t pio_index = pio_get_index(self->pio);
+    uint8_t sm = self->state_machine;
+
+    static const sm_buf_info no_buffer;
+    int pending_buffers = (once->info.len != 0) + (loop->info.len != 0) + (loop2->info.len != 0);
+    if (!loop->info.len) {
+        loop = loop2;
+        loop2 = &no_buffer;
+    }
+
+    if (SM_DMA_ALLOCATED_READ(pio_index, sm)) {
+        if (stride_in_bytes != self->background_read_stride_in_bytes) {
+            mp_raise_ValueError(MP_ERROR_TEXT("Mismatched data size"));
+        }
+        if (swap != self->byteswap_read) {
+            mp_raise_ValueError(MP_ERROR_TEXT("Mismatched swap flag"));
+        }
+
+        while (self->pending_buffers_read) {
+            RUN_BACKGROUND_TASKS;
+            if (self->user_interruptible && mp_hal_is_interrupted()) {
+                return false;
+            }
+        }
+
+        common_hal_mcu_disable_interrupts();
+        self->once_read = *once;
+        self->loop_read = *loop;
+        self->loop2_read = *loop2;
+        self->pending_buffers_read = pending_buffers;
+
+        if (self->dma_completed_read && pending_buffers) {
+            self->dma_completed_read = false;
+            rp2pio_statemachine_dma_complete_read(self, SM_DMA_GET_CHANNEL_READ(pio_index, sm));
+        }
+
+        common_hal_mcu_enable_interrupts();
+
+        return true;
+    }
+
+    int channel = dma_claim_unused_channel(false);
+    if (channel == -1) {
+        return false;
+    }
+
+    SM_DMA_SET_CHANNEL_READ(pio_index, sm, channel);
+
+    const volatile uint8_t *rx_source = (const volatile uint8_t *)&self->pio->rxf[self->state_machine];
+    if (self->in_shift_right) {
+        rx_source += 4 - stride_in_bytes;
+    }
+
+    self->rx_dreq = pio_get_dreq(self->pio, self->state_machine, false);
+
+    memset(&self->current_read, 0, sizeof(self->current_read));
+    self->once_read = *once;
+    self->loop_read = *loop;
+    self->loop2_read = *loop2;
+    self->last_read = MP_OBJ_NULL;
+    self->last_read_overwritten = 0;
+    self->pending_buffers_read = pending_buffers;
+    self->dma_completed_read = false;
+    self->background_read_stride_in_bytes = stride_in_bytes;
+    self->byteswap_read = swap;
+
+    dma_channel_config c = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&c, _stride_to_dma_size(stride_in_bytes));
+    channel_config_set_dreq(&c, self->rx_dreq);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_bswap(&c, swap);
+    dma_channel_configure(channel, &c,
+        NULL,
+        rx_source,
+        0,
+        false);
+
+    common_hal_mcu_disable_interrupts();
+    MP_STATE_PORT(background_pio)[channel] = self;
+    dma_hw->inte0 |= 1u << channel;
+    irq_set_mask_enabled(1 << DMA_IRQ_0, true);
+    // Starts the first buffer.
+    rp2pio_statemachine_dma_complete_read(self, channel);
+    common_hal_mcu_enable_interrupts();
+
+    return true;
+}
+
+// Called from the DMA interrupt when a buffer is full, and to start the first one.
+// The buffers are used in the order once, then loop and loop2 alternately, forever.
+static void rp2pio_statemachine_dma_complete_read(rp2pio_statemachine_obj_t *self, int channel) {
+    if (self->current_read.info.buf) {
+        if (self->last_read != MP_OBJ_NULL) {
+            self->last_read_overwritten++;
+        }
+        self->last_read = self->current_read.obj;
+        if (self->pending_buffers_read > 0) {
+            self->pending_buffers_read--;
+        }
+    }
+
+    if (self->once_read.info.buf) {
+        self->current_read = self->once_read;
+        memset(&self->once_read, 0, sizeof(self->once_read));
+    } else if (self->loop_read.info.buf) {
+        self->current_read = self->loop_read;
+        if (self->loop2_read.info.buf) {
+            self->loop_read = self->loop2_read;
+            self->loop2_read = self->current_read;
+        }
+    } else {
+        memset(&self->current_read, 0, sizeof(self->current_read));
+        self->dma_completed_read = true;
+        self->pending_buffers_read = 0; // should be a no-op
+        return;
+    }
+
+    dma_channel_set_write_addr(channel, self->current_read.info.buf, false);
+    dma_channel_set_trans_count(channel, self->current_read.info.len / self->background_read_stride_in_bytes, true);
+}
+
+bool common_hal_rp2pio_statemachine_stop_background_read(rp2pio_statemachine_obj_t *self) {
+    uint8_t pio_index = pio_get_index(self->pio);
+    uint8_t sm = self->state_machine;
+    rp2pio_statemachine_clear_dma_read(pio_index, sm);
+    memset(&self->current_read, 0, sizeof(self->current_read));
+    memset(&self->once_read, 0, sizeof(self->once_read));
+    memset(&self->loop_read, 0, sizeof(self->loop_read));
+    memset(&self->loop2_read, 0, sizeof(self->loop2_read));
+    self->last_read = MP_OBJ_NULL;
+    self->pending_buffers_read = 0;
+    self->dma_completed_read = true;
+    return true;
+}
+
+bool common_hal_rp2pio_statemachine_get_reading(rp2pio_statemachine_obj_t *self) {
+    uint8_t pio_index = pio_get_index(self->pio);
+    return SM_DMA_ALLOCATED_READ(pio_index, self->state_machine) && !self->dma_completed_read;
+}
+
+mp_int_t common_hal_rp2pio_statemachine_get_pending_read(rp2pio_statemachine_obj_t *self) {
+    return self->pending_buffers_read;
+}
+
+mp_obj_t common_hal_rp2pio_statemachine_get_last_read(rp2pio_statemachine_obj_t *self) {
+    common_hal_mcu_disable_interrupts();
+    mp_obj_t last_read = self->last_read;
+    self->last_read = MP_OBJ_NULL;
+    common_hal_mcu_enable_interrupts();
+    if (last_read == MP_OBJ_NULL) {
+        return mp_const_empty_bytes;
+    }
+    return last_read;
+}
+
 // Use a compile-time constant for MP_REGISTER_POINTER so the preprocessor will
 // not split the expansion across multiple lines.
 MP_REGISTER_ROOT_POINTER(mp_obj_t background_pio[enum_NUM_DMA_CHANNELS]);
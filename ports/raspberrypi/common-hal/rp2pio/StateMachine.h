@@ -47,6 +47,15 @@ typedef struct {
     sm_buf_info current, once, loop;
     int background_stride_in_bytes;
     bool dma_completed, byteswap;
+
+    // background read items
+    volatile int pending_buffers_read;
+    sm_buf_info current_read, once_read, loop_read, loop2_read;
+    mp_obj_t last_read;
+    // Buffers that were filled again before anyone fetched them as last_read.
+    uint32_t last_read_overwritten;
+    int background_read_stride_in_bytes;
+    bool dma_completed_read, byteswap_read;
 } rp2pio_statemachine_obj_t;
 
 void reset_rp2pio_statemachine(void);
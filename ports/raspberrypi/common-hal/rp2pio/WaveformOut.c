@@ -0,0 +1,79 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "bindings/rp2pio/WaveformOut.h"
+#include "bindings/rp2pio/StateMachine.h"
+
+// Each step is one word, pulled automatically. Its low pin_count bits go to
+// the pins and the rest count down, so a step lasts (count + 3) cycles:
+//
+//     out pins, <pin_count>
+//     out x, <32 - pin_count>
+// hold:
+//     jmp x--, hold
+#define OUT_PINS (0x6000)
+#define OUT_X (0x6020)
+#define JMP_X_DEC (0x0040)
+
+void common_hal_rp2pio_waveformout_construct(rp2pio_waveformout_obj_t *self,
+    const mcu_pin_obj_t *first_pin, uint8_t pin_count, uint32_t frequency, uint32_t initial_state) {
+    self->pin_count = pin_count;
+    self->program[0] = OUT_PINS | pin_count;
+    self->program[1] = OUT_X | (32 - pin_count);
+    self->program[2] = JMP_X_DEC | 2;
+
+    common_hal_rp2pio_statemachine_construct(&self->state_machine,
+        self->program, MP_ARRAY_SIZE(self->program),
+        frequency,
+        NULL, 0, // init
+        NULL, 0, // may_exec
+        first_pin, pin_count, initial_state, (1 << pin_count) - 1, // out pins
+        NULL, 0, 0, 0, // in pins
+        NULL, 0, 0, 0, // set pins
+        NULL, 0, 0, 0, // sideset pins
+        false, // No sideset enable
+        NULL, PULL_NONE, // jump pin
+        0, // wait gpio pins
+        true, // exclusive pin use
+        true, 32, true, // out settings
+        false, // wait for txstall
+        false, 32, true, // in settings
+        false, // Not user-interruptible.
+        0, -1, // wrap settings
+        PIO_ANY_OFFSET);
+}
+
+void common_hal_rp2pio_waveformout_deinit(rp2pio_waveformout_obj_t *self) {
+    common_hal_rp2pio_statemachine_deinit(&self->state_machine);
+}
+
+bool common_hal_rp2pio_waveformout_deinited(rp2pio_waveformout_obj_t *self) {
+    return common_hal_rp2pio_statemachine_deinited(&self->state_machine);
+}
+
+uint32_t common_hal_rp2pio_waveformout_step(rp2pio_waveformout_obj_t *self, uint32_t state, uint32_t cycles) {
+    return ((cycles - 3) << self->pin_count) | state;
+}
+
+bool common_hal_rp2pio_waveformout_play(rp2pio_waveformout_obj_t *self, const sm_buf_info *once, const sm_buf_info *loop) {
+    return common_hal_rp2pio_statemachine_background_write(&self->state_machine, once, loop, 4, false);
+}
+
+bool common_hal_rp2pio_waveformout_stop(rp2pio_waveformout_obj_t *self) {
+    return common_hal_rp2pio_statemachine_stop_background_write(&self->state_machine);
+}
+
+bool common_hal_rp2pio_waveformout_get_playing(rp2pio_waveformout_obj_t *self) {
+    return common_hal_rp2pio_statemachine_get_writing(&self->state_machine);
+}
+
+mp_int_t common_hal_rp2pio_waveformout_get_pending(rp2pio_waveformout_obj_t *self) {
+    return common_hal_rp2pio_statemachine_get_pending(&self->state_machine);
+}
+
+uint32_t common_hal_rp2pio_waveformout_get_frequency(rp2pio_waveformout_obj_t *self) {
+    return common_hal_rp2pio_statemachine_get_frequency(&self->state_machine);
+}
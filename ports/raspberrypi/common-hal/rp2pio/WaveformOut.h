@@ -0,0 +1,18 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "common-hal/rp2pio/StateMachine.h"
+
+typedef struct {
+    mp_obj_base_t base;
+    rp2pio_statemachine_obj_t state_machine;
+    // Assembled for pin_count. Kept here because the state machine knows a
+    // loaded program by its address.
+    uint16_t program[3];
+    uint8_t pin_count;
+} rp2pio_waveformout_obj_t;
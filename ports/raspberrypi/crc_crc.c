@@ -0,0 +1,50 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "shared-module/crc/CRC.h"
+
+#include "src/rp2_common/hardware_dma/include/hardware/dma.h"
+
+// Below this, setting up a DMA channel costs more than the tables take.
+#ifndef CIRCUITPY_CRC_HW_MIN_LENGTH
+#define CIRCUITPY_CRC_HW_MIN_LENGTH (64)
+#endif
+
+// The DMA sniffer computes CRC-32 with the 0x04c11db7 polynomial while a
+// channel copies the data to a dummy word. It shifts out of bit 31 like the
+// tables do for unreflected CRCs. With bit-reversed data, its register is
+// the mirror image of the one the tables keep for reflected CRCs.
+bool crc_crc_port_update(crc_crc_obj_t *self, const uint8_t *data, size_t len) {
+    if (self->width != 32 || self->polynomial != 0x04c11db7 || len < CIRCUITPY_CRC_HW_MIN_LENGTH) {
+        return false;
+    }
+    int channel = dma_claim_unused_channel(false);
+    if (channel < 0) {
+        return false;
+    }
+
+    dma_channel_config config = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_sniff_enable(&config, true);
+
+    dma_hw->sniff_data = self->reflect_input ? crc_reflect(self->crc, 32) : self->crc;
+    dma_sniffer_enable(channel,
+        self->reflect_input ? DMA_SNIFF_CTRL_CALC_VALUE_CRC32R : DMA_SNIFF_CTRL_CALC_VALUE_CRC32,
+        true);
+
+    volatile uint32_t dummy;
+    dma_channel_configure(channel, &config, &dummy, data, len, true);
+    dma_channel_wait_for_finish_blocking(channel);
+
+    uint32_t crc = dma_hw->sniff_data;
+    self->crc = self->reflect_input ? crc_reflect(crc, 32) : crc;
+
+    dma_sniffer_disable();
+    dma_channel_unclaim(channel);
+    return true;
+}
@@ -27,6 +27,16 @@
 
 #define CIRCUITPY_PROCESSOR_COUNT           (2)
 
+#define CIRCUITPY_BUSIO_SPI_ASYNC_WRITE     (1)
+
+// Supervisor deadlines use their own hardware alarm instead of the tick.
+#define CIRCUITPY_TICKLESS_DEADLINES        (1)
+
+// Enough for bitmapfilter.morph on a 320 pixel wide bitmap.
+#ifndef CIRCUITPY_SCRATCH_ARENA_SIZE
+#define CIRCUITPY_SCRATCH_ARENA_SIZE        (16 * 1024)
+#endif
+
 #if CIRCUITPY_USB_HOST
 #define CIRCUITPY_USB_HOST_INSTANCE 1
 #endif
@@ -0,0 +1,113 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "bindings/rp2pio/StateMachine.h"
+#include "common-hal/rp2pio/StateMachine.h"
+#include "shared-bindings/microcontroller/__init__.h"
+#include "shared-module/onewireio/OneWire.h"
+
+#include "src/rp2_common/hardware_gpio/include/hardware/gpio.h"
+
+// onewireio byte transfers run on a PIO state machine when one is free, so the
+// slots are timed by the PIO instead of by delays with interrupts off. The
+// state machine only lives for one transfer. Resets and single bits stay in
+// software.
+
+// Runs at 1MHz so every cycle is a microsecond. The line is pulled low by
+// making the pin an output, because its output value is always 0. Each slot is
+// 71us and the bit is sampled 11 or 12us in, like the software read_bit().
+static const uint16_t onewire_program[] = {
+    // out x, 1
+    0x6021,
+    // set pindirs, 1 [5]  ; Drive low for 6us.
+    0xe581,
+    // jmp !x, 4           ; Keep driving low for a 0.
+    0x0024,
+    // set pindirs, 0      ; Release for a 1.
+    0xe080,
+    // nop [3]
+    0xa342,
+    // in pins, 1 [31]
+    0x5f01,
+    // nop [15]
+    0xaf42,
+    // set pindirs, 0 [9]  ; Release at 60us and let the line recover.
+    0xe980,
+};
+
+// Bytes read back and dropped at a time when only writing.
+#define SCRATCH_SIZE (16)
+
+size_t onewireio_onewire_port_transfer(onewireio_onewire_obj_t *self,
+    const uint8_t *out, uint8_t *in, size_t len) {
+    if (len == 0) {
+        return 0;
+    }
+    const mcu_pin_obj_t *pin = self->pin.pin;
+    uint32_t pins_we_use = 1 << pin->number;
+
+    rp2pio_statemachine_obj_t state_machine;
+    bool ok = rp2pio_statemachine_construct(&state_machine,
+        onewire_program, MP_ARRAY_SIZE(onewire_program),
+        1000000,
+        NULL, 0, // init program
+        NULL, 0, // out
+        pin, 1, // in
+        0, 0, // in pulls, the bus has its own pull up
+        pin, 1, // set
+        NULL, 0, // sideset
+        0, 0, // initial pin state, released
+        NULL, // jump pin
+        pins_we_use, true, true,
+        true, 8, true, // TX, auto pull every 8 bits. shift right to output lsb first
+        false, // Wait for txstall
+        true, 8, true, // RX, auto push every 8 bits. shift right to input lsb first
+        false, // claim pins, the DigitalInOut already has it
+        false, // Not user-interruptible.
+        false, // No sideset enable
+        0, -1, // wrap
+        PIO_ANY_OFFSET);
+    if (!ok) {
+        return 0;
+    }
+
+    uint8_t scratch[SCRATCH_SIZE];
+    if (out == NULL) {
+        memset(scratch, 0xff, sizeof(scratch));
+    }
+    size_t done = 0;
+    while (done < len) {
+        size_t chunk = len - done;
+        const uint8_t *data_out = scratch;
+        uint8_t *data_in = scratch;
+        if (out == NULL || in == NULL) {
+            chunk = MIN(chunk, sizeof(scratch));
+        }
+        if (out != NULL) {
+            data_out = out + done;
+        }
+        if (in != NULL) {
+            data_in = in + done;
+        }
+        // Fails before sending anything when no DMA channel is free.
+        if (!common_hal_rp2pio_statemachine_write_readinto(&state_machine,
+            data_out, chunk, 1, data_in, chunk, 1, false, false)) {
+            break;
+        }
+        done += chunk;
+    }
+
+    // The last sample has been read, but the slot may still be running.
+    // Wait for the release and recovery before handing the pin back.
+    common_hal_mcu_delay_us(60);
+    rp2pio_statemachine_deinit(&state_machine, true);
+    gpio_set_function(pin->number, GPIO_FUNC_SIO);
+    gpio_set_drive_strength(pin->number, GPIO_DRIVE_STRENGTH_4MA);
+    return done;
+}
@@ -20,6 +20,7 @@
 #include "shared-bindings/microcontroller/__init__.h"
 
 #include "audio_dma.h"
+#include "supervisor/second_core.h"
 #include "supervisor/flash.h"
 #include "supervisor/usb.h"
 
@@ -76,6 +77,8 @@ void port_internal_flash_flush(void) {
     if (_cache_lba == NO_CACHE) {
         return;
     }
+    // Core 1 may be running from flash too.
+    rp2_second_core_pause();
     // Make sure we don't have an interrupt while we do flash operations.
     common_hal_mcu_disable_interrupts();
     // and audio DMA must be paused as well
@@ -89,6 +92,7 @@ void port_internal_flash_flush(void) {
     audio_dma_unpause_mask(channel_mask);
     #endif
     common_hal_mcu_enable_interrupts();
+    rp2_second_core_resume();
 }
 
 mp_uint_t supervisor_flash_read_blocks(uint8_t *dest, uint32_t block, uint32_t num_blocks) {
@@ -99,6 +103,12 @@ mp_uint_t supervisor_flash_read_blocks(uint8_t *dest, uint32_t block, uint32_t n
     return 0;
 }
 
+#if MICROPY_VFS_XIP
+const uint8_t *supervisor_flash_get_xip_addr(uint32_t block) {
+    return (const uint8_t *)(XIP_BASE + CIRCUITPY_CIRCUITPY_DRIVE_START_ADDR + block * FILESYSTEM_BLOCK_SIZE);
+}
+#endif
+
 mp_uint_t supervisor_flash_write_blocks(const uint8_t *src, uint32_t lba, uint32_t num_blocks) {
     uint32_t blocks_per_sector = SECTOR_SIZE / FILESYSTEM_BLOCK_SIZE;
     uint32_t block = 0;
@@ -33,6 +33,7 @@
 
 #include "common-hal/rtc/RTC.h"
 #include "common-hal/busio/UART.h"
+#include "common-hal/neopixel_write/__init__.h"
 
 #include "supervisor/shared/safe_mode.h"
 #include "supervisor/shared/stack.h"
@@ -63,6 +64,7 @@ critical_section_t background_queue_lock;
 extern volatile bool mp_msc_enabled;
 
 static void _tick_callback(uint alarm_num);
+static void _deadline_callback(uint alarm_num);
 
 static void _binary_info(void) {
     // Binary info readable with `picotool`.
@@ -132,6 +134,10 @@ safe_mode_t port_init(void) {
     hardware_alarm_claim(0);
     hardware_alarm_set_callback(0, _tick_callback);
 
+    // For supervisor deadlines.
+    hardware_alarm_claim(1);
+    hardware_alarm_set_callback(1, _deadline_callback);
+
     // Check brownout.
 
     #if CIRCUITPY_CYW43
@@ -166,6 +172,11 @@ void reset_port(void) {
     reset_countio();
     #endif
 
+    #if CIRCUITPY_NEOPIXEL_WRITE
+    // Finish any background transmission before its state machine is reset.
+    neopixel_write_reset();
+    #endif
+
     #if CIRCUITPY_RP2PIO
     reset_rp2pio_statemachine();
     #endif
@@ -178,6 +189,8 @@ void reset_port(void) {
     audio_dma_reset();
     #endif
 
+    port_second_core_stop();
+
     #if CIRCUITPY_SSL
     ssl_reset();
     #endif
@@ -261,6 +274,20 @@ static void _tick_callback(uint alarm_num) {
     _woken_up = true;
 }
 
+static void _deadline_callback(uint alarm_num) {
+    supervisor_deadline_interrupt();
+    _woken_up = true;
+}
+
+void port_set_deadline_interrupt(uint64_t tick) {
+    // Inverse of port_get_raw_ticks() so that we don't wake before the tick.
+    uint64_t microseconds = (tick / 1024) * 1000000 + (tick % 1024) * 977;
+    if (hardware_alarm_set_target(1, from_us_since_boot(microseconds))) {
+        // Already passed.
+        hardware_alarm_force_irq(1);
+    }
+}
+
 // Enable 1/1024 second tick.
 void port_enable_tick(void) {
     ticks_enabled = true;
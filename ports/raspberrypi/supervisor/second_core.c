@@ -0,0 +1,103 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "supervisor/second_core.h"
+#include "supervisor/port.h"
+#include "supervisor/port_heap.h"
+
+#include "src/rp2_common/hardware_sync/include/hardware/sync.h"
+#include "src/rp2_common/pico_multicore/include/pico/multicore.h"
+
+#define SECOND_CORE_STACK_SIZE (4096)
+
+static bool _core1_claimed;
+static uint32_t *_stack;
+static void (*volatile _worker_fn)(void *arg);
+static void *volatile _worker_arg;
+static volatile bool _worker_busy;
+static volatile bool _worker_paused;
+
+// Lives in RAM so that core 1 can idle here while flash is being written.
+static void __not_in_flash_func(second_core_main)(void) {
+    while (true) {
+        __wfe();
+        _worker_busy = true;
+        __dmb();
+        if (!_worker_paused) {
+            _worker_fn(_worker_arg);
+        }
+        __dmb();
+        _worker_busy = false;
+    }
+}
+
+bool rp2_core1_claim(void) {
+    if (_core1_claimed) {
+        return false;
+    }
+    _core1_claimed = true;
+    return true;
+}
+
+void rp2_core1_release(void) {
+    _core1_claimed = false;
+}
+
+bool port_second_core_start(void (*fn)(void *arg), void *arg) {
+    if (_core1_claimed) {
+        return false;
+    }
+    _stack = port_malloc(SECOND_CORE_STACK_SIZE, false);
+    if (_stack == NULL) {
+        return false;
+    }
+    _core1_claimed = true;
+    _worker_fn = fn;
+    _worker_arg = arg;
+    _worker_busy = false;
+    _worker_paused = false;
+    multicore_launch_core1_with_stack(second_core_main, _stack, SECOND_CORE_STACK_SIZE);
+    return true;
+}
+
+void port_second_core_wake(void) {
+    if (_worker_fn != NULL) {
+        __sev();
+    }
+}
+
+void port_second_core_stop(void) {
+    if (_worker_fn == NULL) {
+        return;
+    }
+    rp2_second_core_pause();
+    multicore_reset_core1();
+    _worker_fn = NULL;
+    _worker_arg = NULL;
+    _worker_paused = false;
+    port_free(_stack);
+    _stack = NULL;
+    _core1_claimed = false;
+}
+
+void rp2_second_core_pause(void) {
+    if (_worker_fn == NULL) {
+        return;
+    }
+    _worker_paused = true;
+    __dmb();
+    while (_worker_busy) {
+    }
+}
+
+void rp2_second_core_resume(void) {
+    if (_worker_fn == NULL) {
+        return;
+    }
+    _worker_paused = false;
+    // Catch up on any wake that arrived while paused.
+    __sev();
+}
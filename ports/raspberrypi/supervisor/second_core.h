@@ -0,0 +1,19 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <stdbool.h>
+
+// Core 1 runs either the port_second_core_start() worker or a module's own
+// core 1 program (usb_host, picodvi), never both. Returns false if the worker
+// has it.
+bool rp2_core1_claim(void);
+void rp2_core1_release(void);
+
+// The worker runs decoder code from flash, so it must be parked in RAM while
+// flash is written. Pausing waits for the current call of the worker to finish.
+void rp2_second_core_pause(void);
+void rp2_second_core_resume(void);
@@ -232,7 +232,8 @@ void common_hal_audiopwmio_pwmaudioout_deinit(audiopwmio_pwmaudioout_obj_t *self
     self->pin[1] = 0;
 }
 
-void common_hal_audiopwmio_pwmaudioout_play(audiopwmio_pwmaudioout_obj_t *self, mp_obj_t sample, bool loop) {
+void common_hal_audiopwmio_pwmaudioout_play(audiopwmio_pwmaudioout_obj_t *self,
+    mp_obj_t sample, bool loop, uint8_t buffer_count, uint32_t target_latency_us) {
     common_hal_audiopwmio_pwmaudioout_stop(self);
     if (active_audio) {
         mp_raise_RuntimeError(MP_ERROR_TEXT("Another PWMAudioOut is already active")); // TODO
@@ -160,14 +160,14 @@ static void install_all_match_filter(canio_listener_obj_t *self) {
 
     // filter mode: 0 = mask
     // (this bit should be clear already, we never set it; but just in case)
-    CLEAR_BIT(self->can->filter_hw->FM1R, bank);
+    CLEAR_BIT(self->can->filter_hw->FM1R, 1 << bank);
     // filter scale: 1 = 32 bits
-    SET_BIT(self->can->filter_hw->FS1R, bank);
+    SET_BIT(self->can->filter_hw->FS1R, 1 << bank);
     // fifo assignment: 1 = FIFO 1
     if (self->fifo_idx) {
-        SET_BIT(self->can->filter_hw->FFA1R, bank);
+        SET_BIT(self->can->filter_hw->FFA1R, 1 << bank);
     } else {
-        CLEAR_BIT(self->can->filter_hw->FFA1R, bank);
+        CLEAR_BIT(self->can->filter_hw->FFA1R, 1 << bank);
     }
 
     // filter activation: 1 = enabled
@@ -246,17 +246,17 @@ int common_hal_canio_listener_in_waiting(canio_listener_obj_t *self) {
     return *(self->rfr) & CAN_RF0R_FMP0;
 }
 
-mp_obj_t common_hal_canio_listener_receive(canio_listener_obj_t *self) {
+bool common_hal_canio_listener_receive(canio_listener_obj_t *self, canio_message_obj_t *message) {
     if (!common_hal_canio_listener_in_waiting(self)) {
         uint64_t deadline = supervisor_ticks_ms64() + self->timeout_ms;
         do {
             if (supervisor_ticks_ms64() > deadline) {
-                return NULL;
+                return false;
             }
             RUN_BACKGROUND_TASKS;
             // Allow user to break out of a timeout with a KeyboardInterrupt.
             if (mp_hal_is_interrupted()) {
-                return NULL;
+                return false;
             }
         } while (!common_hal_canio_listener_in_waiting(self));
     }
@@ -265,8 +265,7 @@ mp_obj_t common_hal_canio_listener_receive(canio_listener_obj_t *self) {
     uint32_t rdtr = self->mailbox->RDTR;
 
     bool rtr = rir & CAN_RI0R_RTR;
-    canio_message_obj_t *message =
-        mp_obj_malloc(canio_message_obj_t, rtr ? &canio_remote_transmission_request_type : &canio_message_type);
+    message->base.type = rtr ? &canio_remote_transmission_request_type : &canio_message_type;
     message->extended = rir & CAN_RI0R_IDE;
     if (message->extended) {
         message->id = rir >> 3;
@@ -281,7 +280,7 @@ mp_obj_t common_hal_canio_listener_receive(canio_listener_obj_t *self) {
     }
     // Release the mailbox
     SET_BIT(*self->rfr, CAN_RF0R_RFOM0);
-    return message;
+    return true;
 }
 
 void common_hal_canio_listener_deinit(canio_listener_obj_t *self) {
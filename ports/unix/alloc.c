@@ -85,6 +85,15 @@ void mp_unix_mark_exec(void) {
     }
 }
 
+// CIRCUITPY-CHANGE: unmap every region before the heap holding the list goes
+// away, so that the next VM using this state starts with none.
+void mp_unix_free_all_exec(void) {
+    for (mmap_region_t *rg = MP_STATE_VM(mmap_region_head); rg != NULL; rg = rg->next) {
+        munmap(rg->ptr, (rg->len + 0xfff) & (~0xfff));
+    }
+    MP_STATE_VM(mmap_region_head) = NULL;
+}
+
 #if MICROPY_FORCE_PLAT_ALLOC_EXEC
 // Provide implementation of libffi ffi_closure_* functions in terms
 // of the functions above. On a normal Linux system, this save a lot
@@ -261,6 +261,92 @@ STATIC mp_obj_t extra_coverage(void) {
         mp_state_ctx.mem = mp_state_mem_orig;
     }
 
+    // CIRCUITPY-CHANGE: allocate between incremental sweep steps, then
+    // deinitialise the heap while a sweep is pending
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    {
+        mp_printf(&mp_plat_print, "# GC incremental sweep\n");
+
+        assert(MP_STATE_THREAD(gc_lock_depth) == 0);
+        mp_state_mem_t mp_state_mem_orig = mp_state_ctx.mem;
+
+        size_t heap_size = 16 * MICROPY_GC_INCREMENTAL_SWEEP_BLOCKS * MICROPY_BYTES_PER_GC_BLOCK;
+        char *heap = calloc(heap_size, 1);
+        gc_init(heap, heap + heap_size);
+
+        // fill part of the heap with garbage, keeping every 16th block and
+        // leaving holes that the sweep hasn't reached after the collection
+        #define NUM_KEEP (64)
+        void *keep[NUM_KEEP];
+        size_t keep_len[NUM_KEEP];
+        size_t n_keep = 0;
+        void *holes[NUM_KEEP];
+        size_t n_holes = 0;
+        for (size_t i = 0; i < 4 * MICROPY_GC_INCREMENTAL_SWEEP_BLOCKS; ++i) {
+            size_t n = i % 16 == 8 ? 3 : 1;
+            size_t *p = gc_alloc(n * MICROPY_BYTES_PER_GC_BLOCK, 0);
+            p[0] = i;
+            if (i % 16 == 0) {
+                keep_len[n_keep] = MICROPY_BYTES_PER_GC_BLOCK;
+                keep[n_keep++] = p;
+            } else if (n == 3 || i % 16 == 12) {
+                holes[n_holes++] = p;
+            }
+        }
+        for (size_t i = 0; i < n_holes; ++i) {
+            gc_free(holes[i]);
+        }
+        size_t n_garbage_keep = n_keep;
+        gc_info_t info;
+        gc_info(&info);
+        size_t used_before = info.used;
+
+        gc_collect_start();
+        gc_collect_root(keep, n_keep);
+        gc_collect_end();
+        mp_printf(&mp_plat_print, "%d\n", MP_STATE_MEM(gc_sweep_pending));
+
+        // a small and a multi-block allocation before every step
+        size_t n_steps = 0;
+        while (MP_STATE_MEM(gc_sweep_pending) && n_keep + 2 <= NUM_KEEP) {
+            for (size_t n = 1; n <= 3; n += 2) {
+                size_t *p = gc_alloc(n * MICROPY_BYTES_PER_GC_BLOCK, 0);
+                p[0] = n_keep;
+                keep_len[n_keep] = n * MICROPY_BYTES_PER_GC_BLOCK;
+                keep[n_keep++] = p;
+            }
+            gc_sweep_step();
+            ++n_steps;
+        }
+        mp_printf(&mp_plat_print, "%d %d\n", MP_STATE_MEM(gc_sweep_pending), n_steps > 1);
+
+        // everything kept survived with its contents, and nothing else did
+        bool ok = true;
+        size_t used_blocks = 0;
+        for (size_t i = 0; i < n_keep; ++i) {
+            size_t *p = keep[i];
+            ok = ok && gc_nbytes(p) == keep_len[i] && p[0] == (i < n_garbage_keep ? 16 * i : i);
+            used_blocks += keep_len[i] / MICROPY_BYTES_PER_GC_BLOCK;
+        }
+        gc_info(&info);
+        mp_printf(&mp_plat_print, "%d %d\n", ok, info.used == used_blocks * MICROPY_BYTES_PER_GC_BLOCK);
+        mp_printf(&mp_plat_print, "%d\n", info.used < used_before);
+
+        // deinit with a sweep pending frees everything
+        gc_collect_start();
+        gc_collect_root(keep, n_keep / 2);
+        gc_collect_end();
+        gc_sweep_step();
+        mp_printf(&mp_plat_print, "%d\n", MP_STATE_MEM(gc_sweep_pending));
+        gc_deinit();
+        mp_printf(&mp_plat_print, "%d %d\n", MP_STATE_MEM(gc_sweep_pending), MP_STATE_MEM(area).gc_pool_start == NULL);
+        free(heap);
+
+        // restore the GC state (the original heap)
+        mp_state_ctx.mem = mp_state_mem_orig;
+    }
+    #endif
+
     // tracked allocation
     {
         #define NUM_PTRS (8)
@@ -351,6 +437,38 @@ STATIC mp_obj_t extra_coverage(void) {
         }
     }
 
+    // CIRCUITPY-CHANGE: a vstr on a heap with no room to grow geometrically
+    // grows by just what it needs
+    #if MICROPY_VSTR_GROWTH_DIVISOR
+    {
+        mp_printf(&mp_plat_print, "# vstr growth on a full heap\n");
+
+        mp_state_mem_t mp_state_mem_orig = mp_state_ctx.mem;
+        size_t heap_size = 4096;
+        char *heap = calloc(heap_size, 1);
+        gc_init(heap, heap + heap_size);
+
+        vstr_t vstr;
+        vstr_init(&vstr, heap_size * 9 / 20);
+        memset(vstr_add_len(&vstr, vstr.alloc), 'a', vstr.alloc);
+        // stop the buffer growing in place, so it has to be copied
+        void *blocker = m_malloc(MICROPY_BYTES_PER_GC_BLOCK);
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            vstr_add_str(&vstr, "more");
+            nlr_pop();
+            mp_printf(&mp_plat_print, "%.4s %d\n", vstr.buf + vstr.len - 4, vstr.alloc < vstr.len + 32);
+        } else {
+            mp_obj_print_exception(&mp_plat_print, MP_OBJ_FROM_PTR(nlr.ret_val));
+        }
+        (void)blocker;
+        free(heap);
+
+        // restore the GC state (the original heap)
+        mp_state_ctx.mem = mp_state_mem_orig;
+    }
+    #endif
+
     // repl autocomplete
     {
         mp_printf(&mp_plat_print, "# repl\n");
@@ -678,6 +796,66 @@ STATIC mp_obj_t extra_coverage(void) {
         ringbuf_clear(&ringbuf);
         ringbuf_put(&ringbuf, 0xaa);
         mp_printf(&mp_plat_print, "%d\n", ringbuf_get16(&ringbuf));
+
+        // Bulk put/get that wraps around the end of the buffer.
+        byte data[RINGBUF_SIZE];
+        byte out[RINGBUF_SIZE];
+        for (int i = 0; i < RINGBUF_SIZE; ++i) {
+            data[i] = i;
+        }
+        ringbuf_clear(&ringbuf);
+        ringbuf_put_n(&ringbuf, data, 90);
+        ringbuf_get_n(&ringbuf, out, 90);
+        mp_printf(&mp_plat_print, "%d ", ringbuf_put_n(&ringbuf, data, 20));
+        mp_printf(&mp_plat_print, "%d ", ringbuf_get_n(&ringbuf, out, 50));
+        mp_printf(&mp_plat_print, "%d %d\n", out[8], out[19]);
+        mp_printf(&mp_plat_print, "%d\n", ringbuf_put_n(&ringbuf, data, RINGBUF_SIZE + 1));
+    }
+
+    // ringbuf_spsc
+    {
+        byte buf[RINGBUF_SIZE];
+        ringbuf_spsc_t ringbuf;
+        ringbuf_spsc_init(&ringbuf, buf, sizeof(buf));
+
+        mp_printf(&mp_plat_print, "# ringbuf_spsc\n");
+
+        byte data[RINGBUF_SIZE];
+        byte out[RINGBUF_SIZE];
+        for (int i = 0; i < RINGBUF_SIZE; ++i) {
+            data[i] = i + 1;
+        }
+
+        // Single bytes, and get from empty.
+        mp_printf(&mp_plat_print, "%d\n", ringbuf_spsc_get(&ringbuf));
+        ringbuf_spsc_put(&ringbuf, 22);
+        mp_printf(&mp_plat_print, "%d %d\n", ringbuf_spsc_num_empty(&ringbuf), ringbuf_spsc_num_filled(&ringbuf));
+        mp_printf(&mp_plat_print, "%d\n", ringbuf_spsc_get(&ringbuf));
+
+        // Fill completely, then a put that does not fit writes nothing.
+        mp_printf(&mp_plat_print, "%d ", ringbuf_spsc_put_n(&ringbuf, data, RINGBUF_SIZE));
+        mp_printf(&mp_plat_print, "%d %d ", ringbuf_spsc_num_empty(&ringbuf), ringbuf_spsc_num_filled(&ringbuf));
+        mp_printf(&mp_plat_print, "%d\n", ringbuf_spsc_put(&ringbuf, 0));
+
+        // Peek across the wrap, then consume and refill across it.
+        ringbuf_spsc_get_n(&ringbuf, out, 90);
+        mp_printf(&mp_plat_print, "%d ", ringbuf_spsc_put_n(&ringbuf, data, 20));
+        mp_printf(&mp_plat_print, "%d ", ringbuf_spsc_put_n(&ringbuf, data, 80));
+        mp_printf(&mp_plat_print, "%d ", ringbuf_spsc_peek_n(&ringbuf, 5, out, 10));
+        mp_printf(&mp_plat_print, "%d %d ", out[0], out[9]);
+        mp_printf(&mp_plat_print, "%d\n", ringbuf_spsc_num_filled(&ringbuf));
+        mp_printf(&mp_plat_print, "%d ", ringbuf_spsc_get_n(&ringbuf, out, 50));
+        mp_printf(&mp_plat_print, "%d %d ", out[8], out[28]);
+        mp_printf(&mp_plat_print, "%d %d\n", ringbuf_spsc_num_empty(&ringbuf), ringbuf_spsc_num_filled(&ringbuf));
+
+        // Keep going round so the indices pass twice the size.
+        for (int i = 0; i < 5; ++i) {
+            ringbuf_spsc_put_n(&ringbuf, data, 70);
+            ringbuf_spsc_get_n(&ringbuf, out, 70);
+        }
+        mp_printf(&mp_plat_print, "%d %d\n", ringbuf_spsc_num_empty(&ringbuf), ringbuf_spsc_num_filled(&ringbuf));
+        ringbuf_spsc_clear(&ringbuf);
+        mp_printf(&mp_plat_print, "%d %d\n", ringbuf_spsc_num_empty(&ringbuf), ringbuf_spsc_num_filled(&ringbuf));
     }
 
     // pairheap
@@ -0,0 +1,47 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+// Software versions of the displayio 2D port hooks. They stand in for a
+// hardware blitter so that the coverage build runs displayio and bitmaptools
+// through the same paths a port with one would.
+
+#include <string.h>
+
+#include "shared-module/displayio/Bitmap.h"
+
+bool displayio_port_fill_rect(void *dest, size_t dest_stride, uint16_t width, uint16_t height,
+    uint8_t bytes_per_pixel, uint32_t value) {
+    uint8_t *row = dest;
+    for (uint16_t j = 0; j < height; j++) {
+        for (uint16_t i = 0; i < width; i++) {
+            switch (bytes_per_pixel) {
+                case 1:
+                    row[i] = value;
+                    break;
+                case 2:
+                    ((uint16_t *)row)[i] = value;
+                    break;
+                default:
+                    ((uint32_t *)row)[i] = value;
+                    break;
+            }
+        }
+        row += dest_stride;
+    }
+    return true;
+}
+
+bool displayio_port_copy_rect(void *dest, size_t dest_stride, const void *src, size_t src_stride,
+    uint16_t width, uint16_t height, uint8_t bytes_per_pixel) {
+    uint8_t *d = dest;
+    const uint8_t *s = src;
+    for (uint16_t j = 0; j < height; j++) {
+        memcpy(d, s, width * bytes_per_pixel);
+        d += dest_stride;
+        s += src_stride;
+    }
+    return true;
+}
@@ -0,0 +1,250 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+// A display that composites its root group into an in-memory RGB565
+// framebuffer. It lets the unix port run and time the displayio compositor
+// without any display hardware.
+
+#include <string.h>
+
+#include "py/mphal.h"
+#include "py/objarray.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/displayio/Group.h"
+#include "shared-module/displayio/display_core.h"
+#include "supervisor/shared/display.h"
+#include "supervisor/shared/tick.h"
+
+#define NULLDISPLAY_COLOR_DEPTH (16)
+
+typedef struct {
+    mp_obj_base_t base;
+    displayio_display_core_t core;
+    mp_obj_t framebuffer;
+    uint8_t *buf;
+    size_t row_stride;
+    mp_int_t last_refresh_pixels;
+} displayio_nulldisplay_obj_t;
+
+// display_core.c expects these from the supervisor. There is no terminal,
+// and the tick only stamps refreshes.
+void supervisor_start_terminal(uint16_t width_px, uint16_t height_px) {
+    (void)width_px;
+    (void)height_px;
+}
+
+uint64_t supervisor_ticks_ms64(void) {
+    return mp_hal_ticks_ms();
+}
+
+uint32_t supervisor_ticks_us32(void) {
+    return mp_hal_ticks_us();
+}
+
+static const displayio_area_t *_get_refresh_areas(displayio_nulldisplay_obj_t *self) {
+    if (self->core.full_refresh) {
+        self->core.area.next = NULL;
+        return &self->core.area;
+    } else if (self->core.current_group != NULL) {
+        return displayio_group_get_refresh_areas(self->core.current_group, NULL);
+    }
+    return NULL;
+}
+
+// Renders one area in chunks of CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE bytes, the
+// same way FramebufferDisplay does.
+static void _refresh_area(displayio_nulldisplay_obj_t *self, const displayio_area_t *area) {
+    displayio_area_t clipped;
+    if (!displayio_display_core_clip_area(&self->core, area, &clipped)) {
+        return;
+    }
+    const size_t bytes_per_pixel = NULLDISPLAY_COLOR_DEPTH / 8;
+    size_t width = displayio_area_width(&clipped);
+    size_t rows_per_buffer = CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE / (width * bytes_per_pixel);
+    if (rows_per_buffer == 0) {
+        rows_per_buffer = 1;
+    }
+    size_t pixels_per_buffer = rows_per_buffer * width;
+    uint32_t buffer[(pixels_per_buffer * bytes_per_pixel + 3) / 4];
+    uint32_t mask_length = (pixels_per_buffer / 32) + 1;
+    uint32_t mask[mask_length];
+
+    for (int16_t y = clipped.y1; y < clipped.y2; y += rows_per_buffer) {
+        displayio_area_t subrectangle = {
+            .x1 = clipped.x1,
+            .y1 = y,
+            .x2 = clipped.x2,
+            .y2 = MIN(clipped.y2, (int16_t)(y + rows_per_buffer)),
+        };
+        memset(mask, 0, sizeof(mask));
+        memset(buffer, 0, sizeof(buffer));
+        displayio_display_core_fill_area(&self->core, &subrectangle, mask, buffer);
+
+        uint8_t *dest = self->buf + subrectangle.y1 * self->row_stride + subrectangle.x1 * bytes_per_pixel;
+        uint8_t *src = (uint8_t *)buffer;
+        size_t rowsize = width * bytes_per_pixel;
+        uint32_t copy_start_us = supervisor_ticks_us32();
+        for (int16_t i = subrectangle.y1; i < subrectangle.y2; i++) {
+            memcpy(dest, src, rowsize);
+            dest += self->row_stride;
+            src += rowsize;
+        }
+        displayio_display_core_record_send(&self->core,
+            rowsize * (subrectangle.y2 - subrectangle.y1), copy_start_us);
+        self->last_refresh_pixels += displayio_area_size(&subrectangle);
+    }
+}
+
+//| class NullDisplay:
+//|     """Composites a root group into an RGB565 framebuffer in memory."""
+//|
+//|     def __init__(self, width: int, height: int, *, rotation: int = 0) -> None:
+//|         """Create a display of the given size. Nothing is shown until `refresh` is called."""
+//|         ...
+static mp_obj_t displayio_nulldisplay_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_width, ARG_height, ARG_rotation };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_width, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
+        { MP_QSTR_height, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
+        { MP_QSTR_rotation, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t width = mp_arg_validate_int_range(args[ARG_width].u_int, 1, 32767, MP_QSTR_width);
+    mp_int_t height = mp_arg_validate_int_range(args[ARG_height].u_int, 1, 32767, MP_QSTR_height);
+    mp_int_t rotation = args[ARG_rotation].u_int;
+    if (rotation % 90 != 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("Display rotation must be in 90 degree increments"));
+    }
+
+    displayio_nulldisplay_obj_t *self = mp_obj_malloc(displayio_nulldisplay_obj_t, type);
+    displayio_display_core_construct(&self->core, width, height, rotation,
+        NULLDISPLAY_COLOR_DEPTH, false, false, 1, false, false);
+    self->core.full_refresh = true;
+
+    // The framebuffer is laid out in the rotated orientation, like the
+    // memory of a panel that is mounted rotated.
+    size_t buf_width = self->core.area.x2;
+    size_t buf_height = self->core.area.y2;
+    self->row_stride = buf_width * (NULLDISPLAY_COLOR_DEPTH / 8);
+    self->framebuffer = mp_obj_new_bytearray_of_zeros(self->row_stride * buf_height);
+    self->buf = ((mp_obj_array_t *)MP_OBJ_TO_PTR(self->framebuffer))->items;
+    self->last_refresh_pixels = 0;
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|     def refresh(self) -> int:
+//|         """Composite everything that changed since the last refresh and return the number of
+//|         pixels that were rendered."""
+//|         ...
+static mp_obj_t displayio_nulldisplay_refresh(mp_obj_t self_in) {
+    displayio_nulldisplay_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    self->last_refresh_pixels = 0;
+    displayio_display_core_start_refresh(&self->core);
+    const displayio_area_t *current_area = _get_refresh_areas(self);
+    #if CIRCUITPY_DISPLAY_COALESCE_AREA_COUNT > 0
+    displayio_area_t coalesced_areas[CIRCUITPY_DISPLAY_COALESCE_AREA_COUNT];
+    current_area = displayio_display_core_coalesce_areas(&self->core, current_area,
+        coalesced_areas, CIRCUITPY_DISPLAY_COALESCE_AREA_COUNT);
+    #endif
+    while (current_area != NULL) {
+        _refresh_area(self, current_area);
+        current_area = current_area->next;
+    }
+    displayio_display_core_finish_refresh(&self->core);
+    return MP_OBJ_NEW_SMALL_INT(self->last_refresh_pixels);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(displayio_nulldisplay_refresh_obj, displayio_nulldisplay_refresh);
+
+//|     root_group: Optional[Group]
+//|     """The group that is composited, or ``None`` to show nothing."""
+static mp_obj_t displayio_nulldisplay_get_root_group(mp_obj_t self_in) {
+    displayio_nulldisplay_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->core.current_group == NULL) {
+        return mp_const_none;
+    }
+    return MP_OBJ_FROM_PTR(self->core.current_group);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(displayio_nulldisplay_get_root_group_obj, displayio_nulldisplay_get_root_group);
+
+static mp_obj_t displayio_nulldisplay_set_root_group(mp_obj_t self_in, mp_obj_t group_in) {
+    displayio_nulldisplay_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    displayio_group_t *group = NULL;
+    if (group_in != mp_const_none) {
+        group = native_group(group_in);
+    }
+    if (!displayio_display_core_set_root_group(&self->core, group)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("Group already used"));
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(displayio_nulldisplay_set_root_group_obj, displayio_nulldisplay_set_root_group);
+
+MP_PROPERTY_GETSET(displayio_nulldisplay_root_group_obj,
+    (mp_obj_t)&displayio_nulldisplay_get_root_group_obj,
+    (mp_obj_t)&displayio_nulldisplay_set_root_group_obj);
+
+//|     framebuffer: bytearray
+//|     """The composited pixels, as little-endian RGB565."""
+static mp_obj_t displayio_nulldisplay_get_framebuffer(mp_obj_t self_in) {
+    displayio_nulldisplay_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return self->framebuffer;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(displayio_nulldisplay_get_framebuffer_obj, displayio_nulldisplay_get_framebuffer);
+
+MP_PROPERTY_GETTER(displayio_nulldisplay_framebuffer_obj,
+    (mp_obj_t)&displayio_nulldisplay_get_framebuffer_obj);
+
+static mp_obj_t displayio_nulldisplay_get_width(mp_obj_t self_in) {
+    displayio_nulldisplay_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return MP_OBJ_NEW_SMALL_INT(displayio_display_core_get_width(&self->core));
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(displayio_nulldisplay_get_width_obj, displayio_nulldisplay_get_width);
+
+MP_PROPERTY_GETTER(displayio_nulldisplay_width_obj,
+    (mp_obj_t)&displayio_nulldisplay_get_width_obj);
+
+static mp_obj_t displayio_nulldisplay_get_height(mp_obj_t self_in) {
+    displayio_nulldisplay_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return MP_OBJ_NEW_SMALL_INT(displayio_display_core_get_height(&self->core));
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(displayio_nulldisplay_get_height_obj, displayio_nulldisplay_get_height);
+
+MP_PROPERTY_GETTER(displayio_nulldisplay_height_obj,
+    (mp_obj_t)&displayio_nulldisplay_get_height_obj);
+
+//|     refresh_stats: Tuple[int, int, int, int, int, int, int]
+//|     """Statistics of the last refresh, as for `busdisplay.BusDisplay.refresh_stats`."""
+//|
+static mp_obj_t displayio_nulldisplay_get_refresh_stats(mp_obj_t self_in) {
+    displayio_nulldisplay_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return displayio_display_core_get_refresh_stats(&self->core);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(displayio_nulldisplay_get_refresh_stats_obj, displayio_nulldisplay_get_refresh_stats);
+
+MP_PROPERTY_GETTER(displayio_nulldisplay_refresh_stats_obj,
+    (mp_obj_t)&displayio_nulldisplay_get_refresh_stats_obj);
+
+static const mp_rom_map_elem_t displayio_nulldisplay_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_refresh), MP_ROM_PTR(&displayio_nulldisplay_refresh_obj) },
+    { MP_ROM_QSTR(MP_QSTR_root_group), MP_ROM_PTR(&displayio_nulldisplay_root_group_obj) },
+    { MP_ROM_QSTR(MP_QSTR_framebuffer), MP_ROM_PTR(&displayio_nulldisplay_framebuffer_obj) },
+    { MP_ROM_QSTR(MP_QSTR_width), MP_ROM_PTR(&displayio_nulldisplay_width_obj) },
+    { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&displayio_nulldisplay_height_obj) },
+    { MP_ROM_QSTR(MP_QSTR_refresh_stats), MP_ROM_PTR(&displayio_nulldisplay_refresh_stats_obj) },
+};
+static MP_DEFINE_CONST_DICT(displayio_nulldisplay_locals_dict, displayio_nulldisplay_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    displayio_nulldisplay_type,
+    MP_QSTR_NullDisplay,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    make_new, displayio_nulldisplay_make_new,
+    locals_dict, &displayio_nulldisplay_locals_dict
+    );
@@ -85,6 +85,12 @@ MP_DEFINE_CONST_FUN_OBJ_1(mod_os_getenv_str_obj, mod_os_getenv_str);
 // Command line options, with their defaults
 STATIC bool compile_only = false;
 STATIC uint emit_opt = MP_EMIT_OPT_NONE;
+// CIRCUITPY-CHANGE
+#if MICROPY_STATE_PER_THREAD
+// Number of VMs to run at once when given -X workers=<n>, or 0 to run the
+// first file as usual.
+STATIC long worker_count = 0;
+#endif
 
 #if MICROPY_ENABLE_GC
 // Heap size of GC heap (if enabled)
@@ -108,7 +114,8 @@ long heap_size = 1024 * 1024 * (sizeof(mp_uint_t) / 4);
 STATIC void stderr_print_strn(void *env, const char *str, size_t len) {
     (void)env;
     ssize_t ret;
-    MP_HAL_RETRY_SYSCALL(ret, write(STDERR_FILENO, str, len), {});
+    // CIRCUITPY-CHANGE: use this thread's stderr
+    MP_HAL_RETRY_SYSCALL(ret, write(mp_hal_stdio_fd(STDERR_FILENO), str, len), {});
     #if MICROPY_PY_OS_DUPTERM
     mp_os_dupterm_tx_strn(str, len);
     #endif
@@ -376,6 +383,11 @@ STATIC void print_help(char **argv) {
     printf("  realtime -- set thread priority to realtime\n");
     impl_opts_cnt++;
     #endif
+    // CIRCUITPY-CHANGE
+    #if MICROPY_STATE_PER_THREAD
+    printf("  workers=<n> -- run each <filename> in its own VM, <n> at a time\n");
+    impl_opts_cnt++;
+    #endif
 
     if (impl_opts_cnt == 0) {
         printf("  (none)\n");
@@ -456,6 +468,15 @@ STATIC void pre_process_options(int argc, char **argv) {
                     // was parsed, so we have to enable realtime here.
                     mp_thread_set_realtime();
                 #endif
+                // CIRCUITPY-CHANGE
+                #if MICROPY_STATE_PER_THREAD
+                } else if (strncmp(argv[a + 1], "workers=", sizeof("workers=") - 1) == 0) {
+                    char *end;
+                    worker_count = strtol(argv[a + 1] + sizeof("workers=") - 1, &end, 0);
+                    if (*end != 0 || worker_count < 1) {
+                        goto invalid_arg;
+                    }
+                #endif
                 } else {
                 invalid_arg:
                     exit(invalid_args());
@@ -491,53 +512,14 @@ STATIC void sys_set_excecutable(char *argv0) {
 #define PATHLIST_SEP_CHAR ':'
 #endif
 
-MP_NOINLINE int main_(int argc, char **argv);
-
-int main(int argc, char **argv) {
-    #if MICROPY_PY_THREAD
-    mp_thread_init();
-    #endif
-    // We should capture stack top ASAP after start, and it should be
-    // captured guaranteedly before any other stack variables are allocated.
-    // For this, actual main (renamed main_) should not be inlined into
-    // this function. main_() itself may have other functions inlined (with
-    // their own stack variables), that's why we need this main/main_ split.
-    mp_stack_ctrl_init();
-    return main_(argc, argv);
-}
-
-MP_NOINLINE int main_(int argc, char **argv) {
-    #ifdef SIGPIPE
-    // Do not raise SIGPIPE, instead return EPIPE. Otherwise, e.g. writing
-    // to peer-closed socket will lead to sudden termination of MicroPython
-    // process. SIGPIPE is particularly nasty, because unix shell doesn't
-    // print anything for it, so the above looks like completely sudden and
-    // silent termination for unknown reason. Ignoring SIGPIPE is also what
-    // CPython does. Note that this may lead to problems using MicroPython
-    // scripts as pipe filters, but again, that's what CPython does. So,
-    // scripts which want to follow unix shell pipe semantics (where SIGPIPE
-    // means "pipe was requested to terminate, it's not an error"), should
-    // catch EPIPE themselves.
-    signal(SIGPIPE, SIG_IGN);
-    #endif
-
-    // Define a reasonable stack limit to detect stack overflow.
-    mp_uint_t stack_limit = 40000 * (sizeof(void *) / 4);
-    #if defined(__arm__) && !defined(__thumb2__)
-    // ARM (non-Thumb) architectures require more stack.
-    stack_limit *= 2;
-    #endif
-    mp_stack_set_limit(stack_limit);
-
-    pre_process_options(argc, argv);
-
-    #if MICROPY_ENABLE_GC
+// CIRCUITPY-CHANGE: heap and VM setup are shared by main_() and the workers.
+#if MICROPY_ENABLE_GC
+STATIC void heap_init(char **heaps) {
     #if !MICROPY_GC_SPLIT_HEAP
-    char *heap = malloc(heap_size);
-    gc_init(heap, heap + heap_size);
+    heaps[0] = malloc(heap_size);
+    gc_init(heaps[0], heaps[0] + heap_size);
     #else
     assert(MICROPY_GC_SPLIT_HEAP_N_HEAPS > 0);
-    char *heaps[MICROPY_GC_SPLIT_HEAP_N_HEAPS];
     long multi_heap_size = heap_size / MICROPY_GC_SPLIT_HEAP_N_HEAPS;
     for (size_t i = 0; i < MICROPY_GC_SPLIT_HEAP_N_HEAPS; i++) {
         heaps[i] = malloc(multi_heap_size);
@@ -548,15 +530,25 @@ MP_NOINLINE int main_(int argc, char **argv) {
         }
     }
     #endif
-    #endif
+}
+#endif
 
-    #if MICROPY_ENABLE_PYSTACK
-    static mp_obj_t pystack[1024];
-    mp_pystack_init(pystack, &pystack[MP_ARRAY_SIZE(pystack)]);
+// Only the workers and debug builds give their heaps back.
+#if MICROPY_ENABLE_GC && (MICROPY_STATE_PER_THREAD || !defined(NDEBUG))
+STATIC void heap_free(char **heaps) {
+    #if !MICROPY_GC_SPLIT_HEAP
+    free(heaps[0]);
+    #else
+    for (size_t i = 0; i < MICROPY_GC_SPLIT_HEAP_N_HEAPS; i++) {
+        free(heaps[i]);
+    }
     #endif
+}
+#endif
 
-    mp_init();
-
+// Called after mp_init() to set up the emitter, the VFS, sys.path and the
+// extra coverage globals.
+STATIC void vm_init(void) {
     #if MICROPY_EMIT_NATIVE
     // Set default emitter options
     MP_STATE_VM(default_emit_opt) = emit_opt;
@@ -628,6 +620,266 @@ MP_NOINLINE int main_(int argc, char **argv) {
         mp_store_global(MP_QSTR_getenv_str, MP_OBJ_FROM_PTR(&mod_os_getenv_str_obj));
     }
     #endif
+}
+
+// CIRCUITPY-CHANGE: -X workers=<n> runs each file given on the command line in
+// a fresh VM of its own, on <n> threads, so that a lot of small scripts such
+// as tests can be run without starting a process for each one. The output of
+// each file is collected, then printed in command line order after a line of
+// the form "==> <exit status> <output length> <filename> <==".
+#if MICROPY_STATE_PER_THREAD
+
+#include <pthread.h>
+
+typedef struct {
+    const char *path;
+    FILE *out;
+    int ret;
+} worker_job_t;
+
+typedef struct {
+    worker_job_t *jobs;
+    size_t n_jobs;
+    size_t next_job;
+    pthread_mutex_t lock;
+    mp_uint_t stack_limit;
+    const char *argv0;
+} worker_queue_t;
+
+STATIC void worker_run_job(worker_job_t *job, const char *argv0) {
+    int fd = fileno(job->out);
+    mp_hal_stdio_fds[STDOUT_FILENO] = fd;
+    mp_hal_stdio_fds[STDERR_FILENO] = fd;
+
+    // Start each job from clean state, as a new process would. mp_init()
+    // leaves some of it alone, such as the VFS mount table and memory stats.
+    memset(&mp_state_ctx.vm, 0, sizeof(mp_state_ctx.vm));
+    memset(&mp_state_ctx.mem, 0, sizeof(mp_state_ctx.mem));
+
+    #if MICROPY_ENABLE_GC
+    char *heaps[MICROPY_GC_SPLIT_HEAP_N_HEAPS];
+    heap_init(heaps);
+    #endif
+    mp_init();
+    vm_init();
+
+    char *pathbuf = malloc(PATH_MAX);
+    char *basedir = realpath(job->path, pathbuf);
+    if (basedir == NULL) {
+        mp_printf(&mp_stderr_print, "%s: can't open file '%s': [Errno %d] %s\n", argv0, job->path, errno, strerror(errno));
+        job->ret = 2;
+    } else {
+        char *p = strrchr(basedir, '/');
+        mp_obj_list_store(mp_sys_path, MP_OBJ_NEW_SMALL_INT(0), mp_obj_new_str_via_qstr(basedir, p - basedir));
+        mp_obj_list_append(mp_sys_argv, MP_OBJ_NEW_QSTR(qstr_from_str(job->path)));
+        job->ret = do_file(job->path) & 0xff;
+    }
+    free(pathbuf);
+
+    #if MICROPY_PY_SYS_ATEXIT
+    if (mp_obj_is_callable(MP_STATE_VM(sys_exitfunc))) {
+        // An exception here must not take the other workers down with it.
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            mp_call_function_0(MP_STATE_VM(sys_exitfunc));
+            nlr_pop();
+        } else {
+            job->ret = handle_uncaught_exception(nlr.ret_val) & 0xff;
+        }
+    }
+    #endif
+
+    #if defined(MICROPY_UNIX_COVERAGE)
+    gc_sweep_all();
+    #endif
+
+    mp_deinit();
+
+    #if MICROPY_EMIT_NATIVE || (MICROPY_PY_FFI && MICROPY_FORCE_PLAT_ALLOC_EXEC)
+    mp_unix_free_all_exec();
+    #endif
+
+    #if MICROPY_ENABLE_GC
+    heap_free(heaps);
+    #endif
+}
+
+STATIC MP_NOINLINE void worker_loop(worker_queue_t *queue) {
+    mp_stack_set_limit(queue->stack_limit);
+    for (;;) {
+        pthread_mutex_lock(&queue->lock);
+        size_t i = queue->next_job++;
+        pthread_mutex_unlock(&queue->lock);
+        if (i >= queue->n_jobs) {
+            break;
+        }
+        worker_run_job(&queue->jobs[i], queue->argv0);
+    }
+}
+
+STATIC void *worker_thread(void *arg) {
+    // Every worker has its own VM state, which holds its own heap, qstrs,
+    // modules and stack limits.
+    mp_state_ctx_t *state = calloc(1, sizeof(mp_state_ctx_t));
+    if (state == NULL) {
+        return NULL;
+    }
+    mp_state_ctx_ptr = state;
+    // As in main(), capture the top of the stack before anything else uses it.
+    mp_stack_ctrl_init();
+    worker_loop(arg);
+    mp_state_ctx_ptr = NULL;
+    free(state);
+    return NULL;
+}
+
+STATIC int run_workers(int argc, char **argv, mp_uint_t stack_limit) {
+    worker_job_t *jobs = malloc(argc * sizeof(worker_job_t));
+    size_t n_jobs = 0;
+    int ret = 0;
+    for (int a = 1; a < argc; a++) {
+        if (argv[a][0] == '-') {
+            if (strcmp(argv[a], "-c") == 0 || strcmp(argv[a], "-m") == 0 || strcmp(argv[a], "-i") == 0) {
+                ret = invalid_args();
+                goto done;
+            }
+            if (strcmp(argv[a], "-X") == 0) {
+                a++;
+            }
+            continue;
+        }
+        jobs[n_jobs].path = argv[a];
+        jobs[n_jobs].out = tmpfile();
+        jobs[n_jobs].ret = 1;
+        if (jobs[n_jobs].out == NULL) {
+            perror("tmpfile");
+            ret = 1;
+            goto done;
+        }
+        n_jobs++;
+    }
+    if (n_jobs == 0) {
+        ret = invalid_args();
+        goto done;
+    }
+
+    #if MICROPY_PY_SYS_EXECUTABLE
+    sys_set_excecutable(argv[0]);
+    #endif
+
+    worker_queue_t queue = {
+        .jobs = jobs,
+        .n_jobs = n_jobs,
+        .next_job = 0,
+        .stack_limit = stack_limit,
+        .argv0 = argv[0],
+    };
+    pthread_mutex_init(&queue.lock, NULL);
+    size_t n_threads = MIN((size_t)worker_count, n_jobs);
+    pthread_t *threads = malloc(n_threads * sizeof(pthread_t));
+    size_t n_started = 0;
+    while (n_started < n_threads) {
+        if (pthread_create(&threads[n_started], NULL, worker_thread, &queue) != 0) {
+            break;
+        }
+        n_started++;
+    }
+    if (n_started == 0) {
+        // The files still get run, one after another in this thread.
+        worker_thread(&queue);
+    }
+    for (size_t i = 0; i < n_started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+    pthread_mutex_destroy(&queue.lock);
+
+    for (size_t i = 0; i < n_jobs; i++) {
+        worker_job_t *job = &jobs[i];
+        // The length lets a reader split up output that doesn't end in a newline.
+        long len = (long)lseek(fileno(job->out), 0, SEEK_END);
+        mp_printf(&mp_plat_print, "==> %d %ld %s <==\n", job->ret, len, job->path);
+        rewind(job->out);
+        char buf[512];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), job->out)) > 0) {
+            mp_hal_stdout_tx_strn(buf, n);
+        }
+        if (job->ret != 0) {
+            ret = 1;
+        }
+    }
+
+done:
+    for (size_t i = 0; i < n_jobs; i++) {
+        fclose(jobs[i].out);
+    }
+    free(jobs);
+    return ret;
+}
+
+#endif
+
+MP_NOINLINE int main_(int argc, char **argv);
+
+int main(int argc, char **argv) {
+    #if MICROPY_PY_THREAD
+    mp_thread_init();
+    #endif
+    // We should capture stack top ASAP after start, and it should be
+    // captured guaranteedly before any other stack variables are allocated.
+    // For this, actual main (renamed main_) should not be inlined into
+    // this function. main_() itself may have other functions inlined (with
+    // their own stack variables), that's why we need this main/main_ split.
+    mp_stack_ctrl_init();
+    return main_(argc, argv);
+}
+
+MP_NOINLINE int main_(int argc, char **argv) {
+    #ifdef SIGPIPE
+    // Do not raise SIGPIPE, instead return EPIPE. Otherwise, e.g. writing
+    // to peer-closed socket will lead to sudden termination of MicroPython
+    // process. SIGPIPE is particularly nasty, because unix shell doesn't
+    // print anything for it, so the above looks like completely sudden and
+    // silent termination for unknown reason. Ignoring SIGPIPE is also what
+    // CPython does. Note that this may lead to problems using MicroPython
+    // scripts as pipe filters, but again, that's what CPython does. So,
+    // scripts which want to follow unix shell pipe semantics (where SIGPIPE
+    // means "pipe was requested to terminate, it's not an error"), should
+    // catch EPIPE themselves.
+    signal(SIGPIPE, SIG_IGN);
+    #endif
+
+    // Define a reasonable stack limit to detect stack overflow.
+    mp_uint_t stack_limit = 40000 * (sizeof(void *) / 4);
+    #if defined(__arm__) && !defined(__thumb2__)
+    // ARM (non-Thumb) architectures require more stack.
+    stack_limit *= 2;
+    #endif
+    mp_stack_set_limit(stack_limit);
+
+    pre_process_options(argc, argv);
+
+    // CIRCUITPY-CHANGE
+    #if MICROPY_STATE_PER_THREAD
+    if (worker_count > 0) {
+        return run_workers(argc, argv, stack_limit);
+    }
+    #endif
+
+    #if MICROPY_ENABLE_GC
+    char *heaps[MICROPY_GC_SPLIT_HEAP_N_HEAPS];
+    heap_init(heaps);
+    #endif
+
+    #if MICROPY_ENABLE_PYSTACK
+    static mp_obj_t pystack[1024];
+    mp_pystack_init(pystack, &pystack[MP_ARRAY_SIZE(pystack)]);
+    #endif
+
+    mp_init();
+
+    vm_init();
 
     // Here is some example code to create a class and instance of that class.
     // First is the Python, then the C code.
@@ -807,13 +1059,7 @@ MP_NOINLINE int main_(int argc, char **argv) {
     #if MICROPY_ENABLE_GC && !defined(NDEBUG)
     // We don't really need to free memory since we are about to exit the
     // process, but doing so helps to find memory leaks.
-    #if !MICROPY_GC_SPLIT_HEAP
-    free(heap);
-    #else
-    for (size_t i = 0; i < MICROPY_GC_SPLIT_HEAP_N_HEAPS; i++) {
-        free(heaps[i]);
-    }
-    #endif
+    heap_free(heaps);
     #endif
 
     // printf("total bytes = %d\n", m_get_total_bytes_allocated());
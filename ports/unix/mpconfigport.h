@@ -144,7 +144,13 @@ typedef long mp_off_t;
 #define MICROPY_MACHINE_MEM_GET_READ_ADDR   mod_machine_mem_get_addr
 #define MICROPY_MACHINE_MEM_GET_WRITE_ADDR  mod_machine_mem_get_addr
 
+// CIRCUITPY-CHANGE: with a VM per thread, keep the LFN buffer on the stack
+// instead of sharing one static buffer between the threads.
+#if MICROPY_STATE_PER_THREAD
+#define MICROPY_FATFS_ENABLE_LFN       (2)
+#else
 #define MICROPY_FATFS_ENABLE_LFN       (1)
+#endif
 #define MICROPY_FATFS_RPATH            (2)
 #define MICROPY_FATFS_MAX_SS           (4096)
 #define MICROPY_FATFS_LFN_CODE_PAGE    437 /* 1=SFN/ANSI 437=LFN/U.S.(OEM) */
@@ -174,6 +180,8 @@ extern const struct _mp_print_t mp_stderr_print;
 void mp_unix_alloc_exec(size_t min_size, void **ptr, size_t *size);
 void mp_unix_free_exec(void *ptr, size_t size);
 void mp_unix_mark_exec(void);
+// CIRCUITPY-CHANGE
+void mp_unix_free_all_exec(void);
 #define MP_PLAT_ALLOC_EXEC(min_size, ptr, size) mp_unix_alloc_exec(min_size, ptr, size)
 #define MP_PLAT_FREE_EXEC(ptr, size) mp_unix_free_exec(ptr, size)
 #ifndef MICROPY_FORCE_PLAT_ALLOC_EXEC
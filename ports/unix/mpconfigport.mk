@@ -15,6 +15,11 @@ MICROPY_PY_BTREE = 0
 # _thread module using pthreads
 MICROPY_PY_THREAD = 1
 
+# CIRCUITPY-CHANGE
+# Separate VM state for each thread, for running many VMs in one process with
+# -X workers=<n>. Needs MICROPY_PY_THREAD = 0.
+MICROPY_STATE_PER_THREAD = 0
+
 # Subset of CPython termios module
 MICROPY_PY_TERMIOS = 1
 
@@ -36,6 +36,16 @@ void mp_hal_set_interrupt_char(int c);
 bool mp_hal_is_interrupted(void);
 
 #define mp_hal_stdio_poll unused // this is not implemented, nor needed
+
+// CIRCUITPY-CHANGE: the fd to use for STDIN_FILENO, STDOUT_FILENO or
+// STDERR_FILENO. With a VM per thread, each thread has its own, so that the
+// output of one VM can be kept apart from the others.
+#if MICROPY_STATE_PER_THREAD
+extern MICROPY_STATE_THREAD_LOCAL int mp_hal_stdio_fds[3];
+#define mp_hal_stdio_fd(fd) (mp_hal_stdio_fds[fd])
+#else
+#define mp_hal_stdio_fd(fd) (fd)
+#endif
 void mp_hal_stdio_mode_raw(void);
 void mp_hal_stdio_mode_orig(void);
 
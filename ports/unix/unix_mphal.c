@@ -181,7 +181,8 @@ main_term:;
 
     unsigned char c;
     ssize_t ret;
-    MP_HAL_RETRY_SYSCALL(ret, read(STDIN_FILENO, &c, 1), {});
+    // CIRCUITPY-CHANGE: use this thread's stdin
+    MP_HAL_RETRY_SYSCALL(ret, read(mp_hal_stdio_fd(STDIN_FILENO), &c, 1), {});
     if (ret == 0) {
         c = 4; // EOF, ctrl-D
     } else if (c == '\n') {
@@ -190,9 +191,15 @@ main_term:;
     return c;
 }
 
+// CIRCUITPY-CHANGE
+#if MICROPY_STATE_PER_THREAD
+MICROPY_STATE_THREAD_LOCAL int mp_hal_stdio_fds[3] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+#endif
+
 void mp_hal_stdout_tx_strn(const char *str, size_t len) {
     ssize_t ret;
-    MP_HAL_RETRY_SYSCALL(ret, write(STDOUT_FILENO, str, len), {});
+    // CIRCUITPY-CHANGE: use this thread's stdout
+    MP_HAL_RETRY_SYSCALL(ret, write(mp_hal_stdio_fd(STDOUT_FILENO), str, len), {});
     // CIRCUITPY-CHANGE: need to conditionalize MICROPY_PY_OS_DUPTERM
     #if MICROPY_PY_OS_DUPTERM
     mp_os_dupterm_tx_strn(str, len);
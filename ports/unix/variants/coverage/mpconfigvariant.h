@@ -37,6 +37,61 @@
 #define MICROPY_GC_SPLIT_HEAP          (1)
 #define MICROPY_GC_SPLIT_HEAP_N_HEAPS  (4)
 
+// Enable testing of the free run index.
+#define MICROPY_GC_FREE_RUN_INDEX      (8)
+
+// Enable testing of next fit for small allocations.
+#define MICROPY_GC_SMALL_ALLOC_NEXT_FIT (4)
+
+// Enable testing of the incremental sweep, in steps small enough that the
+// tests allocate and free while one is pending.
+#define MICROPY_GC_INCREMENTAL_SWEEP   (1)
+#define MICROPY_GC_INCREMENTAL_SWEEP_BLOCKS (64)
+
+// Enable testing of hot and cold area placement. Every area is fast here, so
+// large allocations always take the second pass.
+#define MICROPY_GC_HOT_ALLOC_MAX_BYTES (64)
+
+// Enable testing of the re pattern cache.
+#define MICROPY_PY_RE_CACHE_SIZE       (4)
+
+// Enable testing of the qstr lookup indices.
+#define MICROPY_QSTR_SORTED_INDEX      (1)
+#define MICROPY_QSTR_HASH_INDEX        (1)
+
+// Enable testing of movable buffers.
+#define MICROPY_GC_MOVABLE             (1)
+
+// Enable testing of the bytecode inline caches.
+#define MICROPY_OPT_LOAD_ATTR_INLINE_CACHE (1)
+
+// Enable testing of the fused local/small-int opcodes.
+#define MICROPY_OPT_FUSED_OPCODES      (1)
+
+// Enable testing of memorymonitor.AllocationProfiler, which needs the frame chain.
+#define MICROPY_PROF_FRAME_CHAIN       (1)
+
+// Enable testing of the import recorder behind supervisor.import_stats().
+#define MICROPY_MODULE_IMPORT_STATS    (1)
+#define MICROPY_GC_STATS               (1)
+
+// Enable testing of the high-water marks behind ustack.
+#define MICROPY_STACK_HIGH_WATER       (1)
+
+// Enable testing of the opcode counters behind micropython.opcode_stats().
+#define MICROPY_VM_OPCODE_STATS        (1)
+
+// CIRCUITPY-CHANGE: Use a small scratch arena so that both it and the
+// port heap fallback get exercised.
+#define CIRCUITPY_SCRATCH_ARENA_SIZE   (4 * 1024)
+
+// CIRCUITPY-CHANGE: Compositor settings for displayio.NullDisplay, matching
+// the circuitpy_mpconfig.h defaults.
+#define CIRCUITPY_DISPLAY_LIMIT (1)
+#define CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE (128)
+#define CIRCUITPY_DISPLAY_COALESCE_AREA_COUNT (16)
+#define CIRCUITPY_DISPLAY_AREA_SETUP_COST (64)
+
 // Enable additional features.
 #define MICROPY_DEBUG_PARSE_RULE_NAME  (1)
 #define MICROPY_TRACKED_ALLOC          (1)
@@ -24,7 +24,9 @@ $(BUILD)/lib/tjpgd/src/tjpgd.o: CFLAGS += -Wno-shadow -Wno-cast-align
 
 SRC_BITMAP := \
 	shared/runtime/context_manager_helpers.c \
+	displayio_2d.c \
 	displayio_min.c \
+	displayio_nulldisplay.c \
 	shared-bindings/__future__/__init__.c \
 	shared-bindings/aesio/aes.c \
 	shared-bindings/aesio/__init__.c \
@@ -37,27 +39,49 @@ SRC_BITMAP := \
 	shared-bindings/audiomp3/__init__.c \
 	shared-bindings/audiomp3/MP3Decoder.c \
 	shared-bindings/bitmapfilter/__init__.c \
+	shared-bindings/bitops/__init__.c \
 	shared-bindings/bitmaptools/__init__.c \
 	shared-bindings/codeop/__init__.c \
+	shared-bindings/crc/__init__.c \
+	shared-bindings/crc/CRC.c \
 	shared-bindings/displayio/Bitmap.c \
 	shared-bindings/displayio/ColorConverter.c \
+	shared-bindings/displayio/Group.c \
 	shared-bindings/displayio/Palette.c \
+	shared-bindings/displayio/TileGrid.c \
 	shared-bindings/floppyio/__init__.c \
 	shared-bindings/jpegio/__init__.c \
 	shared-bindings/jpegio/JpegDecoder.c \
 	shared-bindings/locale/__init__.c \
+	shared-bindings/memorymonitor/__init__.c \
+	shared-bindings/memorymonitor/AllocationAlarm.c \
+	shared-bindings/memorymonitor/AllocationProfiler.c \
+	shared-bindings/memorymonitor/AllocationSize.c \
+	shared-bindings/msgpack/__init__.c \
+	shared-bindings/msgpack/ExtType.c \
+	shared-bindings/msgpack/Unpacker.c \
 	shared-bindings/rainbowio/__init__.c \
 	shared-bindings/struct/__init__.c \
 	shared-bindings/synthio/__init__.c \
 	shared-bindings/synthio/Math.c \
 	shared-bindings/synthio/MidiTrack.c \
+	shared-bindings/uheap/__init__.c \
+	shared-bindings/ustack/__init__.c \
 	shared-bindings/synthio/LFO.c \
 	shared-bindings/synthio/Note.c \
 	shared-bindings/synthio/Biquad.c \
 	shared-bindings/synthio/Synthesizer.c \
+	shared-bindings/synthio/Wavetable.c \
 	shared-bindings/traceback/__init__.c \
 	shared-bindings/util.c \
+	shared-bindings/vectorio/__init__.c \
+	shared-bindings/vectorio/Circle.c \
+	shared-bindings/vectorio/Polygon.c \
+	shared-bindings/vectorio/Rectangle.c \
+	shared-bindings/vectorio/VectorShape.c \
 	shared-bindings/zlib/__init__.c \
+	shared-bindings/zlib/Compress.c \
+	shared-bindings/zlib/Decompress.c \
 	shared-module/aesio/aes.c \
 	shared-module/aesio/__init__.c \
 	shared-module/audiocore/__init__.c \
@@ -68,14 +92,24 @@ SRC_BITMAP := \
 	shared-module/audiomixer/Mixer.c \
 	shared-module/audiomixer/MixerVoice.c \
 	shared-module/bitmapfilter/__init__.c \
+	shared-module/bitops/__init__.c \
 	shared-module/bitmaptools/__init__.c \
+	shared-module/crc/CRC.c \
 	shared-module/displayio/area.c \
 	shared-module/displayio/Bitmap.c \
 	shared-module/displayio/ColorConverter.c \
+	shared-module/displayio/display_core.c \
+	shared-module/displayio/Group.c \
 	shared-module/displayio/Palette.c \
+	shared-module/displayio/TileGrid.c \
 	shared-module/floppyio/__init__.c \
 	shared-module/jpegio/__init__.c \
 	shared-module/jpegio/JpegDecoder.c \
+	shared-module/memorymonitor/__init__.c \
+	shared-module/memorymonitor/AllocationAlarm.c \
+	shared-module/memorymonitor/AllocationProfiler.c \
+	shared-module/memorymonitor/AllocationSize.c \
+	shared-module/msgpack/__init__.c \
 	shared-module/os/getenv.c \
 	shared-module/rainbowio/__init__.c \
 	shared-module/struct/__init__.c \
@@ -86,8 +120,18 @@ SRC_BITMAP := \
 	shared-module/synthio/Note.c \
 	shared-module/synthio/Biquad.c \
 	shared-module/synthio/Synthesizer.c \
+	shared-module/synthio/Wavetable.c \
 	shared-module/traceback/__init__.c \
+	shared-module/uheap/__init__.c \
+	shared-module/ustack/__init__.c \
+	shared-module/vectorio/__init__.c \
+	shared-module/vectorio/Circle.c \
+	shared-module/vectorio/Polygon.c \
+	shared-module/vectorio/Rectangle.c \
+	shared-module/vectorio/VectorShape.c \
 	shared-module/zlib/__init__.c \
+	shared-module/zlib/Compress.c \
+	shared-module/zlib/Decompress.c \
 
 SRC_C += $(SRC_BITMAP)
 
@@ -119,19 +163,28 @@ CFLAGS += \
 	-DCIRCUITPY_AUDIOMP3_USE_PORT_ALLOCATOR=0 \
 	-DCIRCUITPY_AUDIOCORE_DEBUG=1 \
 	-DCIRCUITPY_BITMAPTOOLS=1 \
+	-DCIRCUITPY_BITOPS=1 \
 	-DCIRCUITPY_CODEOP=1 \
+	-DCIRCUITPY_CRC=1 \
+	-DCIRCUITPY_CRC_TABLES=4 \
+	-DCIRCUITPY_DISPLAYIO_FILL_KERNELS=1 \
 	-DCIRCUITPY_DISPLAYIO_UNIX=1 \
 	-DCIRCUITPY_FLOPPYIO=1 \
 	-DCIRCUITPY_FUTURE=1 \
 	-DCIRCUITPY_GIFIO=1 \
 	-DCIRCUITPY_JPEGIO=1 \
 	-DCIRCUITPY_LOCALE=1 \
+	-DCIRCUITPY_MEMORYMONITOR=1 \
+	-DCIRCUITPY_MSGPACK=1 \
 	-DCIRCUITPY_OS_GETENV=1 \
 	-DCIRCUITPY_RAINBOWIO=1 \
 	-DCIRCUITPY_STRUCT=1 \
 	-DCIRCUITPY_SYNTHIO=1 \
 	-DCIRCUITPY_SYNTHIO_MAX_CHANNELS=14 \
 	-DCIRCUITPY_TRACEBACK=1 \
+	-DCIRCUITPY_UHEAP=1 \
+	-DCIRCUITPY_USTACK=1 \
+	-DCIRCUITPY_VECTORIO=1 \
 	-DCIRCUITPY_ZLIB=1
 
 # CIRCUITPY-CHANGE: test native base classes.
@@ -0,0 +1,256 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <stdio.h>
+#include <assert.h>
+
+#include "py/runtime.h"
+
+// wrapper around everything in this file
+#if MICROPY_EMIT_RV32
+
+#include "py/asmrv32.h"
+
+#define WORD_SIZE (4)
+#define FIT_SIGNED(x, bits) ((-(1 << ((bits) - 1)) <= (x)) && ((x) < (1 << ((bits) - 1))))
+
+void asm_rv32_end_pass(asm_rv32_t *as) {
+    (void)as;
+    #if 0
+    // make a hex dump of the machine code
+    if (as->base.pass == MP_ASM_PASS_EMIT) {
+        uint8_t *d = as->base.code_base;
+        printf("RV32 ASM:");
+        for (size_t i = 0; i < ((as->base.code_size + 15) & ~15); ++i) {
+            if (i % 16 == 0) {
+                printf("\n%08x:", (unsigned int)i);
+            }
+            if (i % 2 == 0) {
+                printf(" ");
+            }
+            printf("%02x", d[i]);
+        }
+        printf("\n");
+    }
+    #endif
+}
+
+void asm_rv32_op16(asm_rv32_t *as, uint16_t op) {
+    uint8_t *c = mp_asm_base_get_cur_to_write_bytes(&as->base, 2);
+    if (c != NULL) {
+        c[0] = op;
+        c[1] = op >> 8;
+    }
+}
+
+void asm_rv32_op32(asm_rv32_t *as, uint32_t op) {
+    // Instructions only need to be 2-byte aligned, so write them as two halves.
+    asm_rv32_op16(as, op);
+    asm_rv32_op16(as, op >> 16);
+}
+
+// Load a constant into reg_dest, in a way that always takes 8 bytes.
+STATIC void asm_rv32_op_li32(asm_rv32_t *as, uint reg_dest, uint32_t imm) {
+    // addi sign-extends its immediate, so round the upper part to compensate.
+    uint32_t hi = (imm + 0x800) & 0xfffff000;
+    asm_rv32_op_lui(as, reg_dest, hi);
+    asm_rv32_op_addi(as, reg_dest, reg_dest, (int32_t)(imm - hi));
+}
+
+void asm_rv32_op_lw(asm_rv32_t *as, uint rd, uint rs1, int offset) {
+    if (rs1 == ASM_RV32_REG_SP && rd != ASM_RV32_REG_ZERO && 0 <= offset && offset < 256 && (offset & 3) == 0) {
+        // c.lwsp
+        asm_rv32_op16(as, 0x4002 | (offset >> 5 & 1) << 12 | rd << 7 | (offset >> 2 & 7) << 4 | (offset >> 6 & 3) << 2);
+    } else if (ASM_RV32_IS_CREG(rd) && ASM_RV32_IS_CREG(rs1) && 0 <= offset && offset < 128 && (offset & 3) == 0) {
+        // c.lw
+        asm_rv32_op16(as, 0x4000 | (offset >> 3 & 7) << 10 | ASM_RV32_CREG(rs1) << 7 | (offset >> 2 & 1) << 6
+            | (offset >> 6 & 1) << 5 | ASM_RV32_CREG(rd) << 2);
+    } else {
+        asm_rv32_op32(as, ASM_RV32_ENCODE_I(0x03, 2, rd, rs1, offset));
+    }
+}
+
+void asm_rv32_op_sw(asm_rv32_t *as, uint rs2, uint rs1, int offset) {
+    if (rs1 == ASM_RV32_REG_SP && 0 <= offset && offset < 256 && (offset & 3) == 0) {
+        // c.swsp
+        asm_rv32_op16(as, 0xc002 | (offset >> 2 & 0xf) << 9 | (offset >> 6 & 3) << 7 | rs2 << 2);
+    } else if (ASM_RV32_IS_CREG(rs2) && ASM_RV32_IS_CREG(rs1) && 0 <= offset && offset < 128 && (offset & 3) == 0) {
+        // c.sw
+        asm_rv32_op16(as, 0xc000 | (offset >> 3 & 7) << 10 | ASM_RV32_CREG(rs1) << 7 | (offset >> 2 & 1) << 6
+            | (offset >> 6 & 1) << 5 | ASM_RV32_CREG(rs2) << 2);
+    } else {
+        asm_rv32_op32(as, ASM_RV32_ENCODE_S(0x23, 2, rs1, rs2, offset));
+    }
+}
+
+// Adjust sp by amount, which is a multiple of 16.
+STATIC void asm_rv32_adjust_sp(asm_rv32_t *as, int32_t amount) {
+    if (FIT_SIGNED(amount, 12)) {
+        asm_rv32_op_addi(as, ASM_RV32_REG_SP, ASM_RV32_REG_SP, amount);
+    } else {
+        asm_rv32_op_li32(as, ASM_RV32_REG_T0, amount);
+        asm_rv32_op_add(as, ASM_RV32_REG_SP, ASM_RV32_REG_SP, ASM_RV32_REG_T0);
+    }
+}
+
+void asm_rv32_entry(asm_rv32_t *as, int num_locals) {
+    // adjust the stack-pointer to store ra, s0-s3 and locals, 16-byte aligned
+    as->stack_adjust = (((ASM_RV32_NUM_REGS_SAVED + num_locals) * WORD_SIZE) + 15) & ~15;
+    asm_rv32_adjust_sp(as, -as->stack_adjust);
+
+    // save return address and callee-save registers
+    asm_rv32_op_sw(as, ASM_RV32_REG_RA, ASM_RV32_REG_SP, 0);
+    asm_rv32_op_sw(as, ASM_RV32_REG_S0, ASM_RV32_REG_SP, 1 * WORD_SIZE);
+    asm_rv32_op_sw(as, ASM_RV32_REG_S1, ASM_RV32_REG_SP, 2 * WORD_SIZE);
+    asm_rv32_op_sw(as, ASM_RV32_REG_S2, ASM_RV32_REG_SP, 3 * WORD_SIZE);
+    asm_rv32_op_sw(as, ASM_RV32_REG_S3, ASM_RV32_REG_SP, 4 * WORD_SIZE);
+}
+
+void asm_rv32_exit(asm_rv32_t *as) {
+    // restore registers
+    asm_rv32_op_lw(as, ASM_RV32_REG_S3, ASM_RV32_REG_SP, 4 * WORD_SIZE);
+    asm_rv32_op_lw(as, ASM_RV32_REG_S2, ASM_RV32_REG_SP, 3 * WORD_SIZE);
+    asm_rv32_op_lw(as, ASM_RV32_REG_S1, ASM_RV32_REG_SP, 2 * WORD_SIZE);
+    asm_rv32_op_lw(as, ASM_RV32_REG_S0, ASM_RV32_REG_SP, 1 * WORD_SIZE);
+    asm_rv32_op_lw(as, ASM_RV32_REG_RA, ASM_RV32_REG_SP, 0);
+
+    // restore stack-pointer and return
+    asm_rv32_adjust_sp(as, as->stack_adjust);
+    asm_rv32_op_jalr(as, ASM_RV32_REG_ZERO, ASM_RV32_REG_RA);
+}
+
+STATIC size_t get_label_dest(asm_rv32_t *as, uint label) {
+    assert(label < as->base.max_num_labels);
+    return as->base.label_offsets[label];
+}
+
+void asm_rv32_j_label(asm_rv32_t *as, uint label) {
+    int32_t rel = get_label_dest(as, label) - as->base.code_offset;
+    if (as->base.pass == MP_ASM_PASS_EMIT && !FIT_SIGNED(rel, 21)) {
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("asm overflow"));
+    }
+    asm_rv32_op_jal(as, ASM_RV32_REG_ZERO, rel);
+}
+
+void asm_rv32_bcc_reg_reg_label(asm_rv32_t *as, uint cond, uint rs1, uint rs2, uint label) {
+    // A conditional branch only reaches 4KiB. The code size has to be the same
+    // in both passes, so only labels that are already known (ie behind us) can
+    // use the short form; anything else branches over a jal.
+    size_t dest = get_label_dest(as, label);
+    int32_t rel = dest - as->base.code_offset;
+    if (dest != (size_t)-1 && rel <= 0 && FIT_SIGNED(rel, 13)) {
+        asm_rv32_op_bcc(as, cond, rs1, rs2, rel);
+    } else {
+        // flipping the low bit of funct3 inverts the condition
+        asm_rv32_op_bcc(as, cond ^ 1, rs1, rs2, 8);
+        asm_rv32_j_label(as, label);
+    }
+}
+
+// convenience function; reg_dest may be the same as reg_src[12]
+void asm_rv32_setcc_reg_reg_reg(asm_rv32_t *as, uint cond, uint reg_dest, uint reg_src1, uint reg_src2) {
+    switch (cond) {
+        case ASM_RV32_CC_EQ:
+        case ASM_RV32_CC_NE:
+            asm_rv32_op32(as, ASM_RV32_ENCODE_R(0x33, 0, 0x20, reg_dest, reg_src1, reg_src2));
+            if (cond == ASM_RV32_CC_EQ) {
+                asm_rv32_op_sltiu(as, reg_dest, reg_dest, 1);
+            } else {
+                asm_rv32_op_sltu(as, reg_dest, ASM_RV32_REG_ZERO, reg_dest);
+            }
+            break;
+        case ASM_RV32_CC_LT:
+        case ASM_RV32_CC_GE:
+            asm_rv32_op_slt(as, reg_dest, reg_src1, reg_src2);
+            break;
+        default:
+            asm_rv32_op_sltu(as, reg_dest, reg_src1, reg_src2);
+            break;
+    }
+    if (cond == ASM_RV32_CC_GE || cond == ASM_RV32_CC_GEU) {
+        asm_rv32_op_xori(as, reg_dest, reg_dest, 1);
+    }
+}
+
+void asm_rv32_mov_reg_imm(asm_rv32_t *as, uint reg_dest, mp_int_t imm) {
+    if (FIT_SIGNED(imm, 6)) {
+        // c.li
+        asm_rv32_op16(as, 0x4001 | (imm >> 5 & 1) << 12 | reg_dest << 7 | (imm & 0x1f) << 2);
+    } else if (FIT_SIGNED(imm, 12)) {
+        asm_rv32_op_addi(as, reg_dest, ASM_RV32_REG_ZERO, imm);
+    } else if ((imm & 0xfff) == 0) {
+        asm_rv32_op_lui(as, reg_dest, imm);
+    } else {
+        asm_rv32_op_li32(as, reg_dest, imm);
+    }
+}
+
+void asm_rv32_mov_reg_imm_fixed(asm_rv32_t *as, uint reg_dest, mp_int_t imm) {
+    asm_rv32_op_li32(as, reg_dest, imm);
+}
+
+// Form the address reg_base+offset, using t0 if offset doesn't fit in an
+// immediate. Returns the register to use as the base, and updates *offset.
+STATIC uint asm_rv32_base_offset(asm_rv32_t *as, uint reg_base, int32_t *offset) {
+    if (FIT_SIGNED(*offset, 12)) {
+        return reg_base;
+    }
+    asm_rv32_op_li32(as, ASM_RV32_REG_T0, *offset);
+    asm_rv32_op_add(as, ASM_RV32_REG_T0, ASM_RV32_REG_T0, reg_base);
+    *offset = 0;
+    return ASM_RV32_REG_T0;
+}
+
+void asm_rv32_load_reg_reg_offset(asm_rv32_t *as, uint reg_dest, uint reg_base, uint word_offset) {
+    int32_t offset = word_offset * WORD_SIZE;
+    reg_base = asm_rv32_base_offset(as, reg_base, &offset);
+    asm_rv32_op_lw(as, reg_dest, reg_base, offset);
+}
+
+void asm_rv32_store_reg_reg_offset(asm_rv32_t *as, uint reg_src, uint reg_base, uint word_offset) {
+    int32_t offset = word_offset * WORD_SIZE;
+    reg_base = asm_rv32_base_offset(as, reg_base, &offset);
+    asm_rv32_op_sw(as, reg_src, reg_base, offset);
+}
+
+void asm_rv32_load16_reg_reg_offset(asm_rv32_t *as, uint reg_dest, uint reg_base, uint uint16_offset) {
+    int32_t offset = uint16_offset * 2;
+    reg_base = asm_rv32_base_offset(as, reg_base, &offset);
+    asm_rv32_op_lhu(as, reg_dest, reg_base, offset);
+}
+
+void asm_rv32_mov_local_reg(asm_rv32_t *as, int local_num, uint reg_src) {
+    asm_rv32_store_reg_reg_offset(as, reg_src, ASM_RV32_REG_SP, local_num);
+}
+
+void asm_rv32_mov_reg_local(asm_rv32_t *as, uint reg_dest, int local_num) {
+    asm_rv32_load_reg_reg_offset(as, reg_dest, ASM_RV32_REG_SP, local_num);
+}
+
+void asm_rv32_mov_reg_local_addr(asm_rv32_t *as, uint reg_dest, int local_num) {
+    int32_t off = local_num * WORD_SIZE;
+    if (FIT_SIGNED(off, 12)) {
+        asm_rv32_op_addi(as, reg_dest, ASM_RV32_REG_SP, off);
+    } else {
+        asm_rv32_op_li32(as, reg_dest, off);
+        asm_rv32_op_add(as, reg_dest, reg_dest, ASM_RV32_REG_SP);
+    }
+}
+
+void asm_rv32_mov_reg_pcrel(asm_rv32_t *as, uint reg_dest, uint label) {
+    // Get relative offset from PC, which auipc adds to the upper bits
+    int32_t rel = get_label_dest(as, label) - as->base.code_offset;
+    uint32_t hi = (rel + 0x800) & 0xfffff000;
+    asm_rv32_op_auipc(as, reg_dest, hi);
+    asm_rv32_op_addi(as, reg_dest, reg_dest, rel - (int32_t)hi);
+}
+
+void asm_rv32_call_ind(asm_rv32_t *as, uint idx) {
+    asm_rv32_load_reg_reg_offset(as, ASM_RV32_REG_T0, ASM_RV32_REG_FUN_TABLE, idx);
+    asm_rv32_op_jalr(as, ASM_RV32_REG_RA, ASM_RV32_REG_T0);
+}
+
+#endif // MICROPY_EMIT_RV32
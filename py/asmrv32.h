@@ -0,0 +1,314 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#ifndef MICROPY_INCLUDED_PY_ASMRV32_H
+#define MICROPY_INCLUDED_PY_ASMRV32_H
+
+#include "py/misc.h"
+#include "py/asmbase.h"
+
+// calling conventions (standard RISC-V psABI, integer only):
+// up to 8 args in a0-a7
+// return value in a0
+// return address in ra
+// stack pointer is sp, stack full descending, is aligned to 16 bytes
+// callee save: sp, s0-s11
+// caller save: ra, t0-t6, a0-a7
+// t0 is used by the assembler as a scratch register and is never handed out
+// through the generic API
+
+#define ASM_RV32_REG_ZERO (0)
+#define ASM_RV32_REG_RA   (1)
+#define ASM_RV32_REG_SP   (2)
+#define ASM_RV32_REG_GP   (3)
+#define ASM_RV32_REG_TP   (4)
+#define ASM_RV32_REG_T0   (5)
+#define ASM_RV32_REG_T1   (6)
+#define ASM_RV32_REG_T2   (7)
+#define ASM_RV32_REG_S0   (8)
+#define ASM_RV32_REG_S1   (9)
+#define ASM_RV32_REG_A0   (10)
+#define ASM_RV32_REG_A1   (11)
+#define ASM_RV32_REG_A2   (12)
+#define ASM_RV32_REG_A3   (13)
+#define ASM_RV32_REG_A4   (14)
+#define ASM_RV32_REG_A5   (15)
+#define ASM_RV32_REG_A6   (16)
+#define ASM_RV32_REG_A7   (17)
+#define ASM_RV32_REG_S2   (18)
+#define ASM_RV32_REG_S3   (19)
+#define ASM_RV32_REG_S4   (20)
+#define ASM_RV32_REG_S5   (21)
+#define ASM_RV32_REG_S6   (22)
+#define ASM_RV32_REG_S7   (23)
+#define ASM_RV32_REG_S8   (24)
+#define ASM_RV32_REG_S9   (25)
+#define ASM_RV32_REG_S10  (26)
+#define ASM_RV32_REG_S11  (27)
+#define ASM_RV32_REG_T3   (28)
+#define ASM_RV32_REG_T4   (29)
+#define ASM_RV32_REG_T5   (30)
+#define ASM_RV32_REG_T6   (31)
+
+// for bcc and setcc; these are the funct3 values of the branch instructions
+#define ASM_RV32_CC_EQ  (0)
+#define ASM_RV32_CC_NE  (1)
+#define ASM_RV32_CC_LT  (4)
+#define ASM_RV32_CC_GE  (5)
+#define ASM_RV32_CC_LTU (6)
+#define ASM_RV32_CC_GEU (7)
+
+// ra, s0, s1, s2, s3
+#define ASM_RV32_NUM_REGS_SAVED (5)
+
+typedef struct _asm_rv32_t {
+    mp_asm_base_t base;
+    uint32_t stack_adjust;
+} asm_rv32_t;
+
+void asm_rv32_end_pass(asm_rv32_t *as);
+
+void asm_rv32_entry(asm_rv32_t *as, int num_locals);
+void asm_rv32_exit(asm_rv32_t *as);
+
+void asm_rv32_op16(asm_rv32_t *as, uint16_t op);
+void asm_rv32_op32(asm_rv32_t *as, uint32_t op);
+
+// raw instruction encodings
+#define ASM_RV32_ENCODE_R(op, f3, f7, rd, rs1, rs2) \
+    ((op) | ((rd) << 7) | ((f3) << 12) | ((rs1) << 15) | ((rs2) << 20) | ((uint32_t)(f7) << 25))
+#define ASM_RV32_ENCODE_I(op, f3, rd, rs1, imm) \
+    ((op) | ((rd) << 7) | ((f3) << 12) | ((rs1) << 15) | (((uint32_t)(imm) & 0xfff) << 20))
+#define ASM_RV32_ENCODE_S(op, f3, rs1, rs2, imm) \
+    ((op) | (((imm) & 0x1f) << 7) | ((f3) << 12) | ((rs1) << 15) | ((rs2) << 20) | (((uint32_t)(imm) >> 5 & 0x7f) << 25))
+#define ASM_RV32_ENCODE_B(f3, rs1, rs2, imm) \
+    (0x63 | (((imm) >> 11 & 1) << 7) | (((imm) >> 1 & 0xf) << 8) | ((f3) << 12) | ((rs1) << 15) | ((rs2) << 20) \
+    | (((uint32_t)(imm) >> 5 & 0x3f) << 25) | (((uint32_t)(imm) >> 12 & 1) << 31))
+#define ASM_RV32_ENCODE_U(op, rd, imm) \
+    ((op) | ((rd) << 7) | ((uint32_t)(imm) & 0xfffff000))
+#define ASM_RV32_ENCODE_J(rd, imm) \
+    (0x6f | ((rd) << 7) | ((uint32_t)(imm) & 0xff000) | (((imm) >> 11 & 1) << 20) | (((imm) >> 1 & 0x3ff) << 21) \
+    | (((uint32_t)(imm) >> 20 & 1) << 31))
+
+// The compressed forms that name registers with 3 bits can only reach s0-a5.
+#define ASM_RV32_IS_CREG(r) ((r) >= ASM_RV32_REG_S0 && (r) <= ASM_RV32_REG_A5)
+#define ASM_RV32_CREG(r) ((r) - ASM_RV32_REG_S0)
+
+static inline void asm_rv32_op_add(asm_rv32_t *as, uint rd, uint rs1, uint rs2) {
+    if (rd == rs1 && rd != ASM_RV32_REG_ZERO && rs2 != ASM_RV32_REG_ZERO) {
+        // c.add
+        asm_rv32_op16(as, 0x9002 | rd << 7 | rs2 << 2);
+    } else {
+        asm_rv32_op32(as, ASM_RV32_ENCODE_R(0x33, 0, 0x00, rd, rs1, rs2));
+    }
+}
+
+static inline void asm_rv32_op_addi(asm_rv32_t *as, uint rd, uint rs1, int imm12) {
+    asm_rv32_op32(as, ASM_RV32_ENCODE_I(0x13, 0, rd, rs1, imm12));
+}
+
+static inline void asm_rv32_op_mv(asm_rv32_t *as, uint rd, uint rs) {
+    // c.mv
+    asm_rv32_op16(as, 0x8002 | rd << 7 | rs << 2);
+}
+
+// sub, xor, or and and share the c.sub group of encodings
+static inline void asm_rv32_op_alu_c(asm_rv32_t *as, uint f3, uint f7, uint c_op, uint rd, uint rs1, uint rs2) {
+    if (rd == rs1 && ASM_RV32_IS_CREG(rd) && ASM_RV32_IS_CREG(rs2)) {
+        asm_rv32_op16(as, 0x8c01 | c_op << 5 | ASM_RV32_CREG(rd) << 7 | ASM_RV32_CREG(rs2) << 2);
+    } else {
+        asm_rv32_op32(as, ASM_RV32_ENCODE_R(0x33, f3, f7, rd, rs1, rs2));
+    }
+}
+
+static inline void asm_rv32_op_sub(asm_rv32_t *as, uint rd, uint rs1, uint rs2) {
+    asm_rv32_op_alu_c(as, 0, 0x20, 0, rd, rs1, rs2);
+}
+
+static inline void asm_rv32_op_xor(asm_rv32_t *as, uint rd, uint rs1, uint rs2) {
+    asm_rv32_op_alu_c(as, 4, 0x00, 1, rd, rs1, rs2);
+}
+
+static inline void asm_rv32_op_or(asm_rv32_t *as, uint rd, uint rs1, uint rs2) {
+    asm_rv32_op_alu_c(as, 6, 0x00, 2, rd, rs1, rs2);
+}
+
+static inline void asm_rv32_op_and(asm_rv32_t *as, uint rd, uint rs1, uint rs2) {
+    asm_rv32_op_alu_c(as, 7, 0x00, 3, rd, rs1, rs2);
+}
+
+static inline void asm_rv32_op_sll(asm_rv32_t *as, uint rd, uint rs1, uint rs2) {
+    asm_rv32_op32(as, ASM_RV32_ENCODE_R(0x33, 1, 0x00, rd, rs1, rs2));
+}
+
+static inline void asm_rv32_op_srl(asm_rv32_t *as, uint rd, uint rs1, uint rs2) {
+    asm_rv32_op32(as, ASM_RV32_ENCODE_R(0x33, 5, 0x00, rd, rs1, rs2));
+}
+
+static inline void asm_rv32_op_sra(asm_rv32_t *as, uint rd, uint rs1, uint rs2) {
+    asm_rv32_op32(as, ASM_RV32_ENCODE_R(0x33, 5, 0x20, rd, rs1, rs2));
+}
+
+static inline void asm_rv32_op_mul(asm_rv32_t *as, uint rd, uint rs1, uint rs2) {
+    asm_rv32_op32(as, ASM_RV32_ENCODE_R(0x33, 0, 0x01, rd, rs1, rs2));
+}
+
+static inline void asm_rv32_op_slt(asm_rv32_t *as, uint rd, uint rs1, uint rs2) {
+    asm_rv32_op32(as, ASM_RV32_ENCODE_R(0x33, 2, 0x00, rd, rs1, rs2));
+}
+
+static inline void asm_rv32_op_sltu(asm_rv32_t *as, uint rd, uint rs1, uint rs2) {
+    asm_rv32_op32(as, ASM_RV32_ENCODE_R(0x33, 3, 0x00, rd, rs1, rs2));
+}
+
+static inline void asm_rv32_op_sltiu(asm_rv32_t *as, uint rd, uint rs1, int imm12) {
+    asm_rv32_op32(as, ASM_RV32_ENCODE_I(0x13, 3, rd, rs1, imm12));
+}
+
+static inline void asm_rv32_op_xori(asm_rv32_t *as, uint rd, uint rs1, int imm12) {
+    asm_rv32_op32(as, ASM_RV32_ENCODE_I(0x13, 4, rd, rs1, imm12));
+}
+
+static inline void asm_rv32_op_lui(asm_rv32_t *as, uint rd, uint32_t imm) {
+    asm_rv32_op32(as, ASM_RV32_ENCODE_U(0x37, rd, imm));
+}
+
+static inline void asm_rv32_op_auipc(asm_rv32_t *as, uint rd, uint32_t imm) {
+    asm_rv32_op32(as, ASM_RV32_ENCODE_U(0x17, rd, imm));
+}
+
+static inline void asm_rv32_op_jal(asm_rv32_t *as, uint rd, int32_t rel) {
+    asm_rv32_op32(as, ASM_RV32_ENCODE_J(rd, rel));
+}
+
+static inline void asm_rv32_op_jalr(asm_rv32_t *as, uint rd, uint rs1) {
+    if (rd == ASM_RV32_REG_ZERO) {
+        // c.jr
+        asm_rv32_op16(as, 0x8002 | rs1 << 7);
+    } else if (rd == ASM_RV32_REG_RA) {
+        // c.jalr
+        asm_rv32_op16(as, 0x9002 | rs1 << 7);
+    } else {
+        asm_rv32_op32(as, ASM_RV32_ENCODE_I(0x67, 0, rd, rs1, 0));
+    }
+}
+
+static inline void asm_rv32_op_bcc(asm_rv32_t *as, uint cond, uint rs1, uint rs2, int32_t rel) {
+    asm_rv32_op32(as, ASM_RV32_ENCODE_B(cond, rs1, rs2, rel));
+}
+
+static inline void asm_rv32_op_lbu(asm_rv32_t *as, uint rd, uint rs1, int imm12) {
+    asm_rv32_op32(as, ASM_RV32_ENCODE_I(0x03, 4, rd, rs1, imm12));
+}
+
+static inline void asm_rv32_op_lhu(asm_rv32_t *as, uint rd, uint rs1, int imm12) {
+    asm_rv32_op32(as, ASM_RV32_ENCODE_I(0x03, 5, rd, rs1, imm12));
+}
+
+static inline void asm_rv32_op_sb(asm_rv32_t *as, uint rs2, uint rs1, int imm12) {
+    asm_rv32_op32(as, ASM_RV32_ENCODE_S(0x23, 0, rs1, rs2, imm12));
+}
+
+static inline void asm_rv32_op_sh(asm_rv32_t *as, uint rs2, uint rs1, int imm12) {
+    asm_rv32_op32(as, ASM_RV32_ENCODE_S(0x23, 1, rs1, rs2, imm12));
+}
+
+// lw and sw with a byte offset that fits in 12 signed bits
+void asm_rv32_op_lw(asm_rv32_t *as, uint rd, uint rs1, int offset);
+void asm_rv32_op_sw(asm_rv32_t *as, uint rs2, uint rs1, int offset);
+
+void asm_rv32_j_label(asm_rv32_t *as, uint label);
+void asm_rv32_bcc_reg_reg_label(asm_rv32_t *as, uint cond, uint rs1, uint rs2, uint label);
+void asm_rv32_setcc_reg_reg_reg(asm_rv32_t *as, uint cond, uint reg_dest, uint reg_src1, uint reg_src2);
+void asm_rv32_mov_reg_imm(asm_rv32_t *as, uint reg_dest, mp_int_t imm);
+void asm_rv32_mov_reg_imm_fixed(asm_rv32_t *as, uint reg_dest, mp_int_t imm);
+void asm_rv32_mov_local_reg(asm_rv32_t *as, int local_num, uint reg_src);
+void asm_rv32_mov_reg_local(asm_rv32_t *as, uint reg_dest, int local_num);
+void asm_rv32_mov_reg_local_addr(asm_rv32_t *as, uint reg_dest, int local_num);
+void asm_rv32_mov_reg_pcrel(asm_rv32_t *as, uint reg_dest, uint label);
+void asm_rv32_load_reg_reg_offset(asm_rv32_t *as, uint reg_dest, uint reg_base, uint word_offset);
+void asm_rv32_store_reg_reg_offset(asm_rv32_t *as, uint reg_src, uint reg_base, uint word_offset);
+void asm_rv32_load16_reg_reg_offset(asm_rv32_t *as, uint reg_dest, uint reg_base, uint uint16_offset);
+void asm_rv32_call_ind(asm_rv32_t *as, uint idx);
+
+// Holds a pointer to mp_fun_table
+#define ASM_RV32_REG_FUN_TABLE ASM_RV32_REG_S1
+
+#if defined(GENERIC_ASM_API) && GENERIC_ASM_API
+
+// The following macros provide a (mostly) arch-independent API to
+// generate native code, and are used by the native emitter.
+
+#define ASM_WORD_SIZE (4)
+
+#define REG_RET ASM_RV32_REG_A0
+#define REG_ARG_1 ASM_RV32_REG_A0
+#define REG_ARG_2 ASM_RV32_REG_A1
+#define REG_ARG_3 ASM_RV32_REG_A2
+#define REG_ARG_4 ASM_RV32_REG_A3
+
+#define REG_TEMP0 ASM_RV32_REG_A0
+#define REG_TEMP1 ASM_RV32_REG_A1
+#define REG_TEMP2 ASM_RV32_REG_A2
+
+#define REG_LOCAL_1 ASM_RV32_REG_S0
+#define REG_LOCAL_2 ASM_RV32_REG_S2
+#define REG_LOCAL_3 ASM_RV32_REG_S3
+#define REG_LOCAL_NUM (3)
+
+#define ASM_NUM_REGS_SAVED ASM_RV32_NUM_REGS_SAVED
+#define REG_FUN_TABLE ASM_RV32_REG_FUN_TABLE
+
+#define ASM_T               asm_rv32_t
+#define ASM_END_PASS        asm_rv32_end_pass
+#define ASM_ENTRY(as, nlocal) asm_rv32_entry((as), (nlocal))
+#define ASM_EXIT(as)        asm_rv32_exit((as))
+#define ASM_CALL_IND(as, idx) asm_rv32_call_ind((as), (idx))
+
+// The psABI extends bool return values to the full register, so bool_test
+// doesn't need special treatment.
+#define ASM_JUMP            asm_rv32_j_label
+#define ASM_JUMP_IF_REG_ZERO(as, reg, label, bool_test) \
+    asm_rv32_bcc_reg_reg_label((as), ASM_RV32_CC_EQ, (reg), ASM_RV32_REG_ZERO, (label))
+#define ASM_JUMP_IF_REG_NONZERO(as, reg, label, bool_test) \
+    asm_rv32_bcc_reg_reg_label((as), ASM_RV32_CC_NE, (reg), ASM_RV32_REG_ZERO, (label))
+#define ASM_JUMP_IF_REG_EQ(as, reg1, reg2, label) \
+    asm_rv32_bcc_reg_reg_label((as), ASM_RV32_CC_EQ, (reg1), (reg2), (label))
+#define ASM_JUMP_REG(as, reg) asm_rv32_op_jalr((as), ASM_RV32_REG_ZERO, (reg))
+
+#define ASM_MOV_LOCAL_REG(as, local_num, reg_src) asm_rv32_mov_local_reg((as), ASM_NUM_REGS_SAVED + (local_num), (reg_src))
+#define ASM_MOV_REG_IMM(as, reg_dest, imm) asm_rv32_mov_reg_imm((as), (reg_dest), (imm))
+#define ASM_MOV_REG_IMM_FIX_U16(as, reg_dest, imm) asm_rv32_mov_reg_imm_fixed((as), (reg_dest), (imm))
+#define ASM_MOV_REG_IMM_FIX_WORD(as, reg_dest, imm) asm_rv32_mov_reg_imm_fixed((as), (reg_dest), (imm))
+#define ASM_MOV_REG_LOCAL(as, reg_dest, local_num) asm_rv32_mov_reg_local((as), (reg_dest), ASM_NUM_REGS_SAVED + (local_num))
+#define ASM_MOV_REG_REG(as, reg_dest, reg_src) asm_rv32_op_mv((as), (reg_dest), (reg_src))
+#define ASM_MOV_REG_LOCAL_ADDR(as, reg_dest, local_num) asm_rv32_mov_reg_local_addr((as), (reg_dest), ASM_NUM_REGS_SAVED + (local_num))
+#define ASM_MOV_REG_PCREL(as, reg_dest, label) asm_rv32_mov_reg_pcrel((as), (reg_dest), (label))
+
+#define ASM_LSL_REG_REG(as, reg_dest, reg_shift) asm_rv32_op_sll((as), (reg_dest), (reg_dest), (reg_shift))
+#define ASM_LSR_REG_REG(as, reg_dest, reg_shift) asm_rv32_op_srl((as), (reg_dest), (reg_dest), (reg_shift))
+#define ASM_ASR_REG_REG(as, reg_dest, reg_shift) asm_rv32_op_sra((as), (reg_dest), (reg_dest), (reg_shift))
+#define ASM_OR_REG_REG(as, reg_dest, reg_src) asm_rv32_op_or((as), (reg_dest), (reg_dest), (reg_src))
+#define ASM_XOR_REG_REG(as, reg_dest, reg_src) asm_rv32_op_xor((as), (reg_dest), (reg_dest), (reg_src))
+#define ASM_AND_REG_REG(as, reg_dest, reg_src) asm_rv32_op_and((as), (reg_dest), (reg_dest), (reg_src))
+#define ASM_ADD_REG_REG(as, reg_dest, reg_src) asm_rv32_op_add((as), (reg_dest), (reg_dest), (reg_src))
+#define ASM_SUB_REG_REG(as, reg_dest, reg_src) asm_rv32_op_sub((as), (reg_dest), (reg_dest), (reg_src))
+#define ASM_MUL_REG_REG(as, reg_dest, reg_src) asm_rv32_op_mul((as), (reg_dest), (reg_dest), (reg_src))
+
+#define ASM_LOAD_REG_REG_OFFSET(as, reg_dest, reg_base, word_offset) asm_rv32_load_reg_reg_offset((as), (reg_dest), (reg_base), (word_offset))
+#define ASM_LOAD8_REG_REG(as, reg_dest, reg_base) asm_rv32_op_lbu((as), (reg_dest), (reg_base), 0)
+#define ASM_LOAD16_REG_REG(as, reg_dest, reg_base) asm_rv32_op_lhu((as), (reg_dest), (reg_base), 0)
+#define ASM_LOAD16_REG_REG_OFFSET(as, reg_dest, reg_base, uint16_offset) asm_rv32_load16_reg_reg_offset((as), (reg_dest), (reg_base), (uint16_offset))
+#define ASM_LOAD32_REG_REG(as, reg_dest, reg_base) asm_rv32_op_lw((as), (reg_dest), (reg_base), 0)
+
+#define ASM_STORE_REG_REG_OFFSET(as, reg_src, reg_base, word_offset) asm_rv32_store_reg_reg_offset((as), (reg_src), (reg_base), (word_offset))
+#define ASM_STORE8_REG_REG(as, reg_src, reg_base) asm_rv32_op_sb((as), (reg_src), (reg_base), 0)
+#define ASM_STORE16_REG_REG(as, reg_src, reg_base) asm_rv32_op_sh((as), (reg_src), (reg_base), 0)
+#define ASM_STORE32_REG_REG(as, reg_src, reg_base) asm_rv32_op_sw((as), (reg_src), (reg_base), 0)
+
+#endif // GENERIC_ASM_API
+
+#endif // MICROPY_INCLUDED_PY_ASMRV32_H
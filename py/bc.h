@@ -253,6 +253,10 @@ typedef struct _mp_code_state_t {
     struct _mp_code_state_t *prev_state;
     struct _mp_obj_frame_t *frame;
     #endif
+    #if MICROPY_PROF_FRAME_CHAIN
+    // The calling bytecode frame, if any, for the profilers.
+    struct _mp_code_state_t *prof_sample_prev;
+    #endif
     // Variable-length
     mp_obj_t state[0];
     // Variable-length, never accessed by name, only as (void*)(state + n_state)
@@ -278,6 +282,26 @@ mp_uint_t mp_decode_uint(const byte **ptr);
 mp_uint_t mp_decode_uint_value(const byte *ptr);
 const byte *mp_decode_uint_skip(const byte *ptr);
 
+// CIRCUITPY-CHANGE
+#if MICROPY_VM_OPCODE_STATS
+typedef struct _mp_opcode_pair_count_t {
+    // (previous opcode << 8 | opcode) + 1, or 0 for an unused entry.
+    uint32_t key;
+    uint32_t count;
+} mp_opcode_pair_count_t;
+
+typedef struct _mp_opcode_stats_t {
+    uint32_t opcodes[256];
+    // Open addressed hash table of pair counts.
+    mp_opcode_pair_count_t pairs[MICROPY_VM_OPCODE_STATS_PAIRS];
+    // Pairs not counted because the table was full.
+    uint32_t pairs_dropped;
+    uint8_t last_opcode;
+} mp_opcode_stats_t;
+
+extern mp_opcode_stats_t mp_opcode_stats;
+#endif
+
 mp_vm_return_kind_t mp_execute_bytecode(mp_code_state_t *code_state,
 #ifndef __cplusplus
     volatile
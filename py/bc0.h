@@ -55,7 +55,7 @@
 #define MP_BC_BASE_RESERVED                 (0x00) // ----------------
 #define MP_BC_BASE_QSTR_O                   (0x10) // LLLLLLSSSDDII---
 #define MP_BC_BASE_VINT_E                   (0x20) // MMLLLLSSDDBBBBBB
-#define MP_BC_BASE_VINT_O                   (0x30) // UUMMCCCC--------
+#define MP_BC_BASE_VINT_O                   (0x30) // UUMMCCCCOO------
 #define MP_BC_BASE_JUMP_E                   (0x40) // J-JJJJJEEEEF----
 #define MP_BC_BASE_BYTE_O                   (0x50) // LLLLSSDTTTTTEEFF
 #define MP_BC_BASE_BYTE_E                   (0x60) // --BREEEYYI------
@@ -155,6 +155,19 @@
 #define MP_BC_CALL_METHOD                   (MP_BC_BASE_VINT_O + 0x06) // uint
 #define MP_BC_CALL_METHOD_VAR_KW            (MP_BC_BASE_VINT_O + 0x07) // uint
 
+// Fused opcodes, only emitted with MICROPY_OPT_FUSED_OPCODES.  The uint packs
+// a local number, a small int and a binary op so that for locals 0-15 the
+// opcode is never longer than the sequence it replaces.
+#define MP_BC_BINARY_OP_FAST_SMALL_INT      (MP_BC_BASE_VINT_O + 0x08) // uint: push(local op int)
+#define MP_BC_INPLACE_OP_FAST_SMALL_INT     (MP_BC_BASE_VINT_O + 0x09) // uint: local = local op int
+
+#define MP_BC_FUSED_SMALL_INT_MIN           (-4)
+#define MP_BC_FUSED_SMALL_INT_MAX           (11)
+#define MP_BC_FUSED_ENCODE(local, i, op)    (((local) << 10) | (((i) - MP_BC_FUSED_SMALL_INT_MIN) << 6) | (op))
+#define MP_BC_FUSED_DECODE_LOCAL(arg)       ((arg) >> 10)
+#define MP_BC_FUSED_DECODE_INT(arg)         ((mp_int_t)(((arg) >> 6) & 0xf) + MP_BC_FUSED_SMALL_INT_MIN)
+#define MP_BC_FUSED_DECODE_OP(arg)          ((arg) & 0x3f)
+
 #define MP_BC_IMPORT_NAME                   (MP_BC_BASE_QSTR_O + 0x0b) // qstr
 #define MP_BC_IMPORT_FROM                   (MP_BC_BASE_QSTR_O + 0x0c) // qstr
 #define MP_BC_IMPORT_STAR                   (MP_BC_BASE_BYTE_E + 0x09)
@@ -71,6 +71,12 @@ MP_DECLARE_CONST_FUN_OBJ_KW(mp_builtin_open_obj);
 mp_obj_t mp_builtin___import__(size_t n_args, const mp_obj_t *args);
 mp_obj_t mp_builtin___import___default(size_t n_args, const mp_obj_t *args);
 
+// CIRCUITPY-CHANGE
+#if MICROPY_MODULE_IMPORT_STATS
+// Ends the load phase of the import in progress, if it hasn't ended yet.
+void mp_import_stats_loaded(void);
+#endif
+
 mp_obj_t mp_micropython_mem_info(size_t n_args, const mp_obj_t *args);
 
 MP_DECLARE_CONST_FUN_OBJ_VAR(mp_builtin___build_class___obj);
@@ -128,7 +134,12 @@ MP_DECLARE_CONST_FUN_OBJ_2(mp_op_delitem_obj);
 
 // Modules needed by the runtime.
 extern const mp_obj_dict_t mp_module_builtins_globals;
+// CIRCUITPY-CHANGE
+#if MICROPY_STATE_PER_THREAD
+#define mp_module___main__ (MP_STATE_VM(module_main))
+#else
 extern const mp_obj_module_t mp_module___main__;
+#endif
 extern const mp_obj_module_t mp_module_builtins;
 extern const mp_obj_module_t mp_module_sys;
 
@@ -31,8 +31,12 @@
 #include <assert.h>
 
 #include "py/compile.h"
+// CIRCUITPY-CHANGE: for count_module_stores()
+#include "py/bc0.h"
 // CIRCUITPY-CHANGE: for gc_collect() after each import
 #include "py/gc.h"
+// CIRCUITPY-CHANGE: for MICROPY_MODULE_IMPORT_STATS_TICKS_US
+#include "py/mphal.h"
 #include "py/objmodule.h"
 #include "py/persistentcode.h"
 #include "py/runtime.h"
@@ -161,11 +165,56 @@ STATIC void do_load_from_lexer(mp_module_context_t *context, mp_lexer_t *lex) {
 
     // parse, compile and execute the module in its context
     mp_obj_dict_t *mod_globals = context->module.globals;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_COMPILE_BY_STATEMENT
+    mp_parse_compile_execute_by_statement(lex, mod_globals);
+    #else
     mp_parse_compile_execute(lex, MP_PARSE_FILE_INPUT, mod_globals, mod_globals);
+    #endif
 }
 #endif
 
 #if (MICROPY_HAS_FILE_READER && MICROPY_PERSISTENT_CODE_LOAD) || MICROPY_MODULE_FROZEN_MPY
+// CIRCUITPY-CHANGE
+#if MICROPY_MODULE_PRESIZE_GLOBALS
+// Counts the names stored by a module body, so its globals can be sized once
+// instead of being rehashed over and over as a large module defines its
+// functions and classes. Names stored more than once are counted each time.
+// Module level code can't return, so its only RETURN_VALUE is the last opcode.
+STATIC size_t count_module_stores(const mp_raw_code_t *rc) {
+    if (rc->kind != MP_CODE_BYTECODE) {
+        return 0;
+    }
+    const byte *ip = rc->fun_data;
+    MP_BC_PRELUDE_SIG_DECODE(ip);
+    MP_BC_PRELUDE_SIZE_DECODE(ip);
+    ip += n_info + n_cell;
+    size_t n = 0;
+    for (;;) {
+        byte op = *ip++;
+        if (op == MP_BC_RETURN_VALUE) {
+            return n;
+        }
+        if (op == MP_BC_STORE_NAME) {
+            n++;
+        }
+        switch (MP_BC_FORMAT(op)) {
+            case MP_BC_FORMAT_QSTR:
+            case MP_BC_FORMAT_VAR_UINT:
+                while (*ip++ & 0x80) {
+                }
+                break;
+            case MP_BC_FORMAT_OFFSET:
+                ip += (*ip & 0x80) ? 2 : 1;
+                break;
+        }
+        if ((op & MP_BC_MASK_EXTRA_BYTE) == 0) {
+            ip++;
+        }
+    }
+}
+#endif
+
 STATIC void do_execute_raw_code(const mp_module_context_t *context, const mp_raw_code_t *rc, const char *source_name) {
     (void)source_name;
 
@@ -175,6 +224,10 @@ STATIC void do_execute_raw_code(const mp_module_context_t *context, const mp_raw
 
     // execute the module in its context
     mp_obj_dict_t *mod_globals = context->module.globals;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_MODULE_PRESIZE_GLOBALS
+    mp_map_reserve(&mod_globals->map, mod_globals->map.used + count_module_stores(rc));
+    #endif
 
     // save context
     nlr_jump_callback_node_globals_locals_t ctx;
@@ -190,6 +243,10 @@ STATIC void do_execute_raw_code(const mp_module_context_t *context, const mp_raw
 
     // make and execute the function
     mp_obj_t module_fun = mp_make_function_from_raw_code(rc, context, NULL);
+    // CIRCUITPY-CHANGE
+    #if MICROPY_MODULE_IMPORT_STATS
+    mp_import_stats_loaded();
+    #endif
     mp_call_function_0(module_fun);
 
     // deregister exception handler and restore context
@@ -261,6 +318,90 @@ STATIC void do_load(mp_module_context_t *module_obj, vstr_t *file) {
 
 // Convert a relative (to the current module) import, going up "level" levels,
 // into an absolute import.
+// CIRCUITPY-CHANGE
+#if MICROPY_MODULE_IMPORT_STATS
+// The import in progress. Each lives on the C stack of do_load_recorded.
+typedef struct _mp_import_timer_t {
+    nlr_jump_callback_node_t callback;
+    struct _mp_import_timer_t *outer;
+    mp_import_record_t *record; // NULL when the table is full
+    bool loaded;
+    uint32_t start_us;
+    uint32_t loaded_us;
+    size_t start_blocks;
+    // What the imports made by this one cost.
+    uint32_t nested_us;
+    size_t nested_blocks;
+} mp_import_timer_t;
+
+STATIC size_t import_stats_alloc_blocks(void) {
+    #if MICROPY_GC_STATS
+    return MP_STATE_MEM(gc_stats_alloc_blocks);
+    #else
+    return 0;
+    #endif
+}
+
+void mp_import_stats_loaded(void) {
+    mp_import_timer_t *timer = MP_STATE_VM(import_stats_timer);
+    if (timer != NULL && !timer->loaded) {
+        timer->loaded = true;
+        timer->loaded_us = MICROPY_MODULE_IMPORT_STATS_TICKS_US();
+    }
+}
+
+// Runs when the load finishes or raises, so that failed imports are counted too.
+STATIC void import_stats_finish(void *ctx_in) {
+    mp_import_timer_t *timer = ctx_in;
+    uint32_t end_us = MICROPY_MODULE_IMPORT_STATS_TICKS_US();
+    size_t blocks = import_stats_alloc_blocks() - timer->start_blocks;
+    MP_STATE_VM(import_stats_timer) = timer->outer;
+    if (!timer->loaded) {
+        // Compiled by statement or failed to load, so count it all as loading.
+        timer->loaded_us = end_us;
+    }
+    if (timer->record != NULL) {
+        timer->record->load_us = timer->loaded_us - timer->start_us;
+        timer->record->exec_us = end_us - timer->loaded_us - timer->nested_us;
+        timer->record->alloc_blocks = blocks - timer->nested_blocks;
+    }
+    if (timer->outer != NULL) {
+        timer->outer->nested_us += end_us - timer->start_us;
+        timer->outer->nested_blocks += blocks;
+    }
+}
+
+STATIC void do_load_recorded(mp_module_context_t *module_obj, vstr_t *file, qstr name) {
+    mp_import_timer_t timer = {
+        .outer = MP_STATE_VM(import_stats_timer),
+    };
+    if (MP_STATE_VM(import_stats_len) < MICROPY_MODULE_IMPORT_STATS_MAX) {
+        const char *file_str = vstr_null_terminated_str(file);
+        mp_import_record_t *record = &MP_STATE_VM(import_stats)[MP_STATE_VM(import_stats_len)];
+        record->name = name;
+        record->kind = file_str[file->len - 3] == 'm' ? MP_IMPORT_KIND_MPY : MP_IMPORT_KIND_PY;
+        #if MICROPY_MODULE_FROZEN
+        if (strncmp(file_str, MP_FROZEN_PATH_PREFIX, strlen(MP_FROZEN_PATH_PREFIX)) == 0) {
+            record->kind = MP_IMPORT_KIND_FROZEN;
+        }
+        #endif
+        timer.record = record;
+    }
+    MP_STATE_VM(import_stats_len) += 1;
+
+    MP_STATE_VM(import_stats_timer) = &timer;
+    nlr_push_jump_callback(&timer.callback, import_stats_finish);
+    timer.start_blocks = import_stats_alloc_blocks();
+    timer.start_us = MICROPY_MODULE_IMPORT_STATS_TICKS_US();
+
+    do_load(module_obj, file);
+
+    nlr_pop_jump_callback(true);
+}
+#else
+#define do_load_recorded(module_obj, file, name) do_load(module_obj, file)
+#endif
+
 STATIC void evaluate_relative_import(mp_int_t level, const char **module_name, size_t *module_name_len) {
     // What we want to do here is to take the name of the current module,
     // remove <level> trailing components, and concatenate the passed-in
@@ -495,7 +636,8 @@ STATIC mp_obj_t process_import_at_level(qstr full_mod_name, qstr level_mod_name,
 
         // execute "path/__init__.py" (if available).
         if (stat_file_py_or_mpy(&path) == MP_IMPORT_STAT_FILE) {
-            do_load(MP_OBJ_TO_PTR(module_obj), &path);
+            // CIRCUITPY-CHANGE
+            do_load_recorded(MP_OBJ_TO_PTR(module_obj), &path, full_mod_name);
         } else {
             // No-op. Nothing to load.
             // mp_warning("%s is imported as namespace package", vstr_str(&path));
@@ -504,7 +646,8 @@ STATIC mp_obj_t process_import_at_level(qstr full_mod_name, qstr level_mod_name,
         path.len = orig_path_len;
     } else { // MP_IMPORT_STAT_FILE
         // File -- execute "path.(m)py".
-        do_load(MP_OBJ_TO_PTR(module_obj), &path);
+        // CIRCUITPY-CHANGE
+        do_load_recorded(MP_OBJ_TO_PTR(module_obj), &path, full_mod_name);
         // Note: This should be the last component in the import path. If
         // there are remaining components then in the next call to
         // process_import_at_level will detect that it doesn't have
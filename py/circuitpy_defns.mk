@@ -177,6 +177,9 @@ endif
 ifeq ($(CIRCUITPY_COUNTIO),1)
 SRC_PATTERNS += countio/%
 endif
+ifeq ($(CIRCUITPY_CRC),1)
+SRC_PATTERNS += crc/%
+endif
 ifeq ($(CIRCUITPY_CYW43),1)
 SRC_PATTERNS += cyw43/%
 endif
@@ -279,6 +282,9 @@ endif
 ifeq ($(CIRCUITPY_MSGPACK),1)
 SRC_PATTERNS += msgpack/%
 endif
+ifeq ($(CIRCUITPY_NEOPIXEL_PARALLEL),1)
+SRC_PATTERNS += neopixel_parallel/%
+endif
 ifeq ($(CIRCUITPY_NEOPIXEL_WRITE),1)
 SRC_PATTERNS += neopixel_write/%
 endif
@@ -483,6 +489,7 @@ SRC_COMMON_HAL_ALL = \
 	digitalio/__init__.c \
 	dotclockframebuffer/DotClockFramebuffer.c \
 	dotclockframebuffer/__init__.c \
+	dualbank/Update.c \
 	dualbank/__init__.c \
 	floppyio/__init__.c \
 	frequencyio/FrequencyIn.c \
@@ -504,6 +511,7 @@ SRC_COMMON_HAL_ALL = \
 	mdns/__init__.c \
 	mdns/Server.c \
 	mdns/RemoteService.c \
+	neopixel_parallel/NeoPixelParallel.c \
 	neopixel_write/__init__.c \
 	nvm/ByteArray.c \
 	nvm/__init__.c \
@@ -574,6 +582,8 @@ $(filter $(SRC_PATTERNS), \
 	microcontroller/RunMode.c \
 	msgpack/__init__.c \
 	msgpack/ExtType.c \
+	msgpack/Unpacker.c \
+	neopixel_parallel/__init__.c \
 	paralleldisplaybus/__init__.c \
 	qrio/PixelPolicy.c \
 	qrio/QRInfo.c \
@@ -633,6 +643,7 @@ SRC_SHARED_MODULE_ALL = \
 	canio/Match.c \
 	canio/Message.c \
 	canio/RemoteTransmissionRequest.c \
+	crc/CRC.c \
 	displayio/Bitmap.c \
 	displayio/ColorConverter.c \
 	displayio/Group.c \
@@ -675,9 +686,11 @@ SRC_SHARED_MODULE_ALL = \
 	max3421e/Max3421E.c \
 	memorymonitor/__init__.c \
 	memorymonitor/AllocationAlarm.c \
+	memorymonitor/AllocationProfiler.c \
 	memorymonitor/AllocationSize.c \
 	network/__init__.c \
 	msgpack/__init__.c \
+	nvm/ByteArray.c \
 	onewireio/__init__.c \
 	onewireio/OneWire.c \
 	os/__init__.c \
@@ -689,11 +702,13 @@ SRC_SHARED_MODULE_ALL = \
 	rgbmatrix/RGBMatrix.c \
 	rgbmatrix/__init__.c \
 	rotaryio/IncrementalEncoder.c \
+	rotaryio/velocity.c \
 	sdcardio/SDCard.c \
 	sdcardio/__init__.c \
 	sharpdisplay/SharpMemoryFramebuffer.c \
 	sharpdisplay/__init__.c \
 	socket/__init__.c \
+	socketpool/SocketPool.c \
 	storage/__init__.c \
 	struct/__init__.c \
 	supervisor/__init__.c \
@@ -704,6 +719,7 @@ SRC_SHARED_MODULE_ALL = \
 	synthio/MidiTrack.c \
 	synthio/Note.c \
 	synthio/Synthesizer.c \
+	synthio/Wavetable.c \
 	synthio/__init__.c \
 	terminalio/Terminal.c \
 	terminalio/__init__.c \
@@ -713,6 +729,8 @@ SRC_SHARED_MODULE_ALL = \
 	usb/__init__.c \
 	usb/core/__init__.c \
 	usb/core/Device.c \
+	usb/msc/__init__.c \
+	usb/msc/BlockDevice.c \
 	ustack/__init__.c \
 	vectorio/Circle.c \
 	vectorio/Polygon.c \
@@ -722,6 +740,8 @@ SRC_SHARED_MODULE_ALL = \
 	warnings/__init__.c \
 	watchdog/__init__.c \
 	zlib/__init__.c \
+	zlib/Compress.c \
+	zlib/Decompress.c \
 
 # All possible sources are listed here, and are filtered by SRC_PATTERNS.
 SRC_SHARED_MODULE = $(filter $(SRC_PATTERNS), $(SRC_SHARED_MODULE_ALL))
@@ -735,6 +755,7 @@ SRC_COMMON_HAL_ALL += \
 	touchio/__init__.c
 else
 SRC_SHARED_MODULE_ALL += \
+	touchio/TouchGroup.c \
 	touchio/TouchIn.c \
 	touchio/__init__.c
 endif
@@ -751,6 +772,11 @@ SRC_SHARED_MODULE_ALL += \
 	ssl/SSLSocket.c
 endif
 
+ifeq ($(CIRCUITPY_MICROCONTROLLER_CORE1),1)
+SRC_SHARED_MODULE_ALL += \
+	microcontroller/Core1.c
+endif
+
 ifeq ($(CIRCUITPY_KEYPAD_DEMUX),1)
 SRC_SHARED_MODULE_ALL += \
 	keypad_demux/__init__.c \
@@ -48,7 +48,10 @@ extern void common_hal_mcu_enable_interrupts(void);
 #define MICROPY_PY_OS_DUPTERM            (0)
 #define MICROPY_ROM_TEXT_COMPRESSION     (0)
 #define MICROPY_VFS_LFS1                 (0)
+// Set from the command line when CIRCUITPY_FILESYSTEM_LFS is on.
+#ifndef MICROPY_VFS_LFS2
 #define MICROPY_VFS_LFS2                 (0)
+#endif
 
 // Sorted alphabetically for easy finding.
 //
@@ -62,8 +65,14 @@ extern void common_hal_mcu_enable_interrupts(void);
 #define MICROPY_COMP_MODULE_CONST        (1)
 #define MICROPY_COMP_TRIPLE_TUPLE_ASSIGN (0)
 #define MICROPY_DEBUG_PRINTERS           (0)
+#if defined(__riscv)
+#define MICROPY_EMIT_INLINE_THUMB        (0)
+#define MICROPY_EMIT_RV32                (CIRCUITPY_ENABLE_MPY_NATIVE)
+#define MICROPY_EMIT_THUMB               (0)
+#else
 #define MICROPY_EMIT_INLINE_THUMB        (CIRCUITPY_ENABLE_MPY_NATIVE)
 #define MICROPY_EMIT_THUMB               (CIRCUITPY_ENABLE_MPY_NATIVE)
+#endif
 #define MICROPY_EMIT_X64                 (0)
 #define MICROPY_ENABLE_DOC_STRING        (0)
 #define MICROPY_ENABLE_FINALISER         (1)
@@ -78,8 +87,17 @@ extern void common_hal_mcu_enable_interrupts(void);
 #define MICROPY_GC_ALLOC_THRESHOLD       (0)
 #define MICROPY_GC_SPLIT_HEAP            (1)
 #define MICROPY_GC_SPLIT_HEAP_AUTO       (1)
+#define MICROPY_GC_STATS                 (CIRCUITPY_GC_STATS || CIRCUITPY_SUPERVISOR_BENCHMARK || CIRCUITPY_SUPERVISOR_IMPORT_STATS)
+extern uint32_t supervisor_ticks_us32(void);
+#define MICROPY_GC_STATS_TICKS_US() supervisor_ticks_us32()
+// gifio.GifWriter and zlib.Decompress keep their large buffers movable.
+#ifndef MICROPY_GC_MOVABLE
+#define MICROPY_GC_MOVABLE               (CIRCUITPY_GIFIO || CIRCUITPY_ZLIB)
+#endif
 #define MP_PLAT_ALLOC_HEAP(size) port_malloc(size, false)
 #define MP_PLAT_FREE_HEAP(ptr) port_free(ptr)
+#define MP_PLAT_ALLOC_FAST_HEAP(size) port_malloc_fast(size)
+#define MP_PLAT_HEAP_IS_SLOW(ptr) port_heap_is_slow(ptr)
 #include "supervisor/port_heap.h"
 #define MICROPY_HELPER_LEXER_UNIX        (0)
 #define MICROPY_HELPER_REPL              (1)
@@ -87,13 +105,23 @@ extern void common_hal_mcu_enable_interrupts(void);
 #define MICROPY_MEM_STATS                (0)
 #define MICROPY_MODULE_BUILTIN_INIT      (1)
 #define MICROPY_MODULE_BUILTIN_SUBPACKAGES (1)
+#define MICROPY_MODULE_IMPORT_STATS      (CIRCUITPY_SUPERVISOR_IMPORT_STATS)
+#define MICROPY_MODULE_IMPORT_STATS_TICKS_US() supervisor_ticks_us32()
 #define MICROPY_NONSTANDARD_TYPECODES    (0)
 #define MICROPY_OPT_COMPUTED_GOTO        (1)
 #define MICROPY_OPT_COMPUTED_GOTO_SAVE_SPACE (CIRCUITPY_COMPUTED_GOTO_SAVE_SPACE)
+#define MICROPY_VM_OPCODE_STATS          (CIRCUITPY_OPCODE_STATS)
 #define MICROPY_OPT_LOAD_ATTR_FAST_PATH  (CIRCUITPY_OPT_LOAD_ATTR_FAST_PATH)
 #define MICROPY_OPT_MAP_LOOKUP_CACHE  (CIRCUITPY_OPT_MAP_LOOKUP_CACHE)
+#define MICROPY_OPT_MPZ_INT64            (CIRCUITPY_OPT_MPZ_INT64)
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (CIRCUITPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE)
 #define MICROPY_PERSISTENT_CODE_LOAD     (1)
+#define MICROPY_PERSISTENT_CODE_LOAD_XIP (CIRCUITPY_MPY_XIP)
+// The code cache saves compiled modules with mp_raw_code_save().
+#if CIRCUITPY_CODE_CACHE
+#define MICROPY_PERSISTENT_CODE_SAVE     (1)
+#endif
+#define MICROPY_VFS_XIP                  (CIRCUITPY_MPY_XIP || CIRCUITPY_STORAGE_MMAP)
 
 #define MICROPY_PY_ARRAY                 (CIRCUITPY_ARRAY)
 #define MICROPY_PY_ARRAY_SLICE_ASSIGN    (1)
@@ -143,6 +171,8 @@ extern void common_hal_mcu_enable_interrupts(void);
 #define MICROPY_PY_SYS_MAXSIZE           (1)
 #define MICROPY_PY_SYS_STDFILES          (1)
 #define MICROPY_PY___FILE__              (1)
+#define MICROPY_PROF_FRAME_CHAIN         (CIRCUITPY_SAMPLING_PROFILER || CIRCUITPY_MEMORYMONITOR)
+#define MICROPY_PROF_SAMPLING            (CIRCUITPY_SAMPLING_PROFILER)
 
 #define MICROPY_QSTR_BYTES_IN_HASH       (1)
 #define MICROPY_REPL_AUTO_INDENT         (1)
@@ -183,6 +213,7 @@ extern void common_hal_mcu_enable_interrupts(void);
 
 // Track stack usage. Expose results via ustack module.
 #define MICROPY_MAX_STACK_USAGE       (0)
+#define MICROPY_STACK_HIGH_WATER      (CIRCUITPY_USTACK)
 
 #define UINT_FMT "%u"
 #define INT_FMT "%d"
@@ -237,6 +268,8 @@ typedef long mp_off_t;
 #endif
 #define MICROPY_PY_BUILTINS_FROZENSET         (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PY_BUILTINS_STR_CENTER        (CIRCUITPY_FULL_BUILD)
+#define MICROPY_PY_LIST_SORT_STABLE           (CIRCUITPY_FULL_BUILD)
+#define MICROPY_PY_SELECT_POLL_GEN            (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PY_BUILTINS_STR_PARTITION     (CIRCUITPY_FULL_BUILD)
 #define MICROPY_PY_BUILTINS_STR_SPLITLINES    (CIRCUITPY_FULL_BUILD)
 #ifndef MICROPY_PY_COLLECTIONS_ORDEREDDICT
@@ -250,6 +283,9 @@ typedef long mp_off_t;
 #define MICROPY_PY_RE_MATCH_GROUPS           (CIRCUITPY_RE)
 #define MICROPY_PY_RE_MATCH_SPAN_START_END   (CIRCUITPY_RE)
 #define MICROPY_PY_RE_SUB                    (CIRCUITPY_RE)
+#ifndef MICROPY_PY_RE_CACHE_SIZE
+#define MICROPY_PY_RE_CACHE_SIZE             (4)
+#endif
 
 #define CIRCUITPY_MICROPYTHON_ADVANCED        (0)
 
@@ -344,9 +380,45 @@ typedef long mp_off_t;
 #define CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE (128)
 #endif
 
+// Persistent BusDisplay refresh buffer size in bytes, allocated outside the VM heap.
+// Zero uses a small buffer on the stack instead.
+#ifndef CIRCUITPY_BUSDISPLAY_REFRESH_BUFFER_SIZE
+#define CIRCUITPY_BUSDISPLAY_REFRESH_BUFFER_SIZE (0)
+#endif
+
+// Maximum number of dirty areas left after merging them for a refresh. Zero disables merging.
+#ifndef CIRCUITPY_DISPLAY_COALESCE_AREA_COUNT
+#define CIRCUITPY_DISPLAY_COALESCE_AREA_COUNT (16)
+#endif
+
+// Cost in pixels of starting to draw a separate area. Used to decide when to merge areas.
+#ifndef CIRCUITPY_DISPLAY_AREA_SETUP_COST
+#define CIRCUITPY_DISPLAY_AREA_SETUP_COST (64)
+#endif
+
+// Number of recent conversions each ColorConverter remembers. Must be a power of two
+// no larger than 32. One keeps only the last color.
+#ifndef CIRCUITPY_DISPLAYIO_COLORCONVERTER_CACHE_SIZE
+#define CIRCUITPY_DISPLAYIO_COLORCONVERTER_CACHE_SIZE (8)
+#endif
+
+// Whether TileGrid gets its own pixel loops for the most common bitmap, pixel shader and display
+// combinations, at the cost of some flash.
+#ifndef CIRCUITPY_DISPLAYIO_FILL_KERNELS
+#define CIRCUITPY_DISPLAYIO_FILL_KERNELS (CIRCUITPY_FULL_BUILD)
+#endif
+
 #else
 #define CIRCUITPY_DISPLAY_LIMIT (0)
 #define CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE (0)
+#define CIRCUITPY_BUSDISPLAY_REFRESH_BUFFER_SIZE (0)
+#define CIRCUITPY_DISPLAY_COALESCE_AREA_COUNT (0)
+#endif
+
+// Ports set this when busio.SPI can write in the background with
+// common_hal_busio_spi_start_write().
+#ifndef CIRCUITPY_BUSIO_SPI_ASYNC_WRITE
+#define CIRCUITPY_BUSIO_SPI_ASYNC_WRITE (0)
 #endif
 
 // This is not a top-level module; it's microcontroller.nvm.
@@ -413,10 +485,54 @@ void background_callback_run_all(void);
 #define CIRCUITPY_AUTORELOAD_DELAY_MS 750
 #endif
 
+// Ticks (1/1024 s) that one run of background callbacks may spend on idle priority work.
+#ifndef CIRCUITPY_BACKGROUND_CALLBACK_IDLE_BUDGET_TICKS
+#define CIRCUITPY_BACKGROUND_CALLBACK_IDLE_BUDGET_TICKS (2)
+#endif
+
+// Number of distinct callback functions tracked by CIRCUITPY_BACKGROUND_CALLBACK_STATS.
+// Any more are lumped together.
+#ifndef CIRCUITPY_BACKGROUND_CALLBACK_STATS_SLOTS
+#define CIRCUITPY_BACKGROUND_CALLBACK_STATS_SLOTS (16)
+#endif
+
+// Number of events kept by CIRCUITPY_SUPERVISOR_TRACE. Each takes 8 bytes.
+#ifndef CIRCUITPY_SUPERVISOR_TRACE_EVENTS
+#define CIRCUITPY_SUPERVISOR_TRACE_EVENTS (512)
+#endif
+
+// Also print the CIRCUITPY_BOOT_TIMING phases up to boot.py into boot_out.txt.
+// Off by default because the changing numbers make boot_out.txt be rewritten on every boot.
+#ifndef CIRCUITPY_BOOT_TIMING_IN_BOOT_OUT
+#define CIRCUITPY_BOOT_TIMING_IN_BOOT_OUT (0)
+#endif
+
+// Set by ports that implement port_set_deadline_interrupt(), so that supervisor deadlines don't
+// need the 1/1024 s tick.
+#ifndef CIRCUITPY_TICKLESS_DEADLINES
+#define CIRCUITPY_TICKLESS_DEADLINES (0)
+#endif
+
+// Number of distinct port_malloc() callers tracked by CIRCUITPY_PORT_HEAP_STATS.
+// Any more are lumped together.
+#ifndef CIRCUITPY_PORT_HEAP_STATS_SLOTS
+#define CIRCUITPY_PORT_HEAP_STATS_SLOTS (16)
+#endif
+
 #ifndef CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS
 #define CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS 1000
 #endif
 
+// Number of flush intervals a background flush may be held off by filesystem_defer_flush().
+#ifndef CIRCUITPY_FILESYSTEM_FLUSH_MAX_DEFERRALS
+#define CIRCUITPY_FILESYSTEM_FLUSH_MAX_DEFERRALS (10)
+#endif
+
+// Bytes of littlefs block allocation bitmap. Each byte covers 8 blocks.
+#ifndef CIRCUITPY_FILESYSTEM_LFS_LOOKAHEAD
+#define CIRCUITPY_FILESYSTEM_LFS_LOOKAHEAD (32)
+#endif
+
 #ifndef CIRCUITPY_PYSTACK_SIZE
 #define CIRCUITPY_PYSTACK_SIZE 1536
 #endif
@@ -428,6 +544,12 @@ void background_callback_run_all(void);
 #define CIRCUITPY_HEAP_START_SIZE (8 * 1024)
 #endif
 
+// Size of the scratch arena reserved at boot for temporary native buffers.
+// See supervisor/shared/memory.h. 0 sends every request to the port heap.
+#ifndef CIRCUITPY_SCRATCH_ARENA_SIZE
+#define CIRCUITPY_SCRATCH_ARENA_SIZE (0)
+#endif
+
 // How much of the c stack we leave to ensure we can process exceptions.
 #ifndef CIRCUITPY_EXCEPTION_STACK_SIZE
 #define CIRCUITPY_EXCEPTION_STACK_SIZE 1024
@@ -446,7 +568,10 @@ void background_callback_run_all(void);
 #define CIRCUITPY_STATUS_LED_POWER_INVERTED (0)
 #endif
 
+// boot_out.txt is written with oofatfs directly, so littlefs CIRCUITPY skips it.
+#if !CIRCUITPY_FILESYSTEM_LFS
 #define CIRCUITPY_BOOT_OUTPUT_FILE "/boot_out.txt"
+#endif
 
 #ifndef CIRCUITPY_BOOT_COUNTER
 #define CIRCUITPY_BOOT_COUNTER 0
@@ -533,6 +658,14 @@ void background_callback_run_all(void);
 #error "CIRCUITPY_USB_HID_MAX_REPORT_IDS_PER_DESCRIPTOR must be at least 1"
 #endif
 
+// Reports that usb_hid.Device.send_report() can queue while the host has not
+// yet polled for earlier ones.
+#ifndef CIRCUITPY_USB_HID_REPORT_QUEUE_LENGTH
+#define CIRCUITPY_USB_HID_REPORT_QUEUE_LENGTH (4)
+#elif CIRCUITPY_USB_HID_REPORT_QUEUE_LENGTH < 1
+#error "CIRCUITPY_USB_HID_REPORT_QUEUE_LENGTH must be at least 1"
+#endif
+
 #ifndef USB_MIDI_EP_NUM_OUT
 #define USB_MIDI_EP_NUM_OUT (0)
 #endif
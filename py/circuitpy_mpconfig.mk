@@ -138,6 +138,11 @@ CFLAGS += -DCIRCUITPY_AUDIOCORE_DEBUG=$(CIRCUITPY_AUDIOCORE_DEBUG)
 CIRCUITPY_AUDIOMP3 ?= $(call enable-if-all,$(CIRCUITPY_FULL_BUILD) $(CIRCUITPY_AUDIOCORE))
 CFLAGS += -DCIRCUITPY_AUDIOMP3=$(CIRCUITPY_AUDIOMP3)
 
+# Per-callback run counts and timing, readable from supervisor.runtime.background_stats.
+# Instrumentation only: it adds work to every background callback.
+CIRCUITPY_BACKGROUND_CALLBACK_STATS ?= 0
+CFLAGS += -DCIRCUITPY_BACKGROUND_CALLBACK_STATS=$(CIRCUITPY_BACKGROUND_CALLBACK_STATS)
+
 CIRCUITPY_BINASCII ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_BINASCII=$(CIRCUITPY_BINASCII)
 
@@ -164,6 +169,10 @@ CFLAGS += -DCIRCUITPY_BLE_FILE_SERVICE=$(CIRCUITPY_BLE_FILE_SERVICE)
 CIRCUITPY_BOARD ?= 1
 CFLAGS += -DCIRCUITPY_BOARD=$(CIRCUITPY_BOARD)
 
+# Record timestamps for phases of a cold boot. See supervisor.runtime.boot_timing.
+CIRCUITPY_BOOT_TIMING ?= 0
+CFLAGS += -DCIRCUITPY_BOOT_TIMING=$(CIRCUITPY_BOOT_TIMING)
+
 CIRCUITPY_BUSDEVICE ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_BUSDEVICE=$(CIRCUITPY_BUSDEVICE)
 
@@ -191,6 +200,10 @@ CFLAGS += -DCIRCUITPY_CAMERA=$(CIRCUITPY_CAMERA)
 CIRCUITPY_CANIO ?= 0
 CFLAGS += -DCIRCUITPY_CANIO=$(CIRCUITPY_CANIO)
 
+# Cache compiled code.py and boot.py bytecode next to the source.
+CIRCUITPY_CODE_CACHE ?= 0
+CFLAGS += -DCIRCUITPY_CODE_CACHE=$(CIRCUITPY_CODE_CACHE)
+
 CIRCUITPY_CODEOP ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_CODEOP=$(CIRCUITPY_CODEOP)
 
@@ -200,6 +213,11 @@ CFLAGS += -DCIRCUITPY_COLLECTIONS=$(CIRCUITPY_COLLECTIONS)
 CIRCUITPY_COMPUTED_GOTO_SAVE_SPACE ?= 0
 CFLAGS += -DCIRCUITPY_COMPUTED_GOTO_SAVE_SPACE=$(CIRCUITPY_COMPUTED_GOTO_SAVE_SPACE)
 
+# Count bytecode opcodes and opcode pairs for micropython.opcode_stats().
+# Slows the VM down, so only for builds made to collect statistics.
+CIRCUITPY_OPCODE_STATS ?= 0
+CFLAGS += -DCIRCUITPY_OPCODE_STATS=$(CIRCUITPY_OPCODE_STATS)
+
 CIRCUITPY_CYW43 ?= 0
 CFLAGS += -DCIRCUITPY_CYW43=$(CIRCUITPY_CYW43)
 
@@ -212,6 +230,9 @@ CFLAGS += -DCIRCUITPY_COPROC=$(CIRCUITPY_COPROC)
 CIRCUITPY_COUNTIO ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_COUNTIO=$(CIRCUITPY_COUNTIO)
 
+CIRCUITPY_CRC ?= $(CIRCUITPY_FULL_BUILD)
+CFLAGS += -DCIRCUITPY_CRC=$(CIRCUITPY_CRC)
+
 CIRCUITPY_DISPLAYIO ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_DISPLAYIO=$(CIRCUITPY_DISPLAYIO)
 
@@ -292,6 +313,10 @@ CFLAGS += -DCIRCUITPY_FUTURE=$(CIRCUITPY_FUTURE)
 CIRCUITPY_GETPASS ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_GETPASS=$(CIRCUITPY_GETPASS)
 
+# Collection count, pause time and allocation counters for gc.stats().
+CIRCUITPY_GC_STATS ?= $(CIRCUITPY_FULL_BUILD)
+CFLAGS += -DCIRCUITPY_GC_STATS=$(CIRCUITPY_GC_STATS)
+
 CIRCUITPY_GIFIO ?= $(CIRCUITPY_DISPLAYIO)
 CFLAGS += -DCIRCUITPY_GIFIO=$(CIRCUITPY_GIFIO)
 
@@ -367,12 +392,21 @@ CFLAGS += -DCIRCUITPY_MEMORYMONITOR=$(CIRCUITPY_MEMORYMONITOR)
 CIRCUITPY_MICROCONTROLLER ?= 1
 CFLAGS += -DCIRCUITPY_MICROCONTROLLER=$(CIRCUITPY_MICROCONTROLLER)
 
+# microcontroller.Core1, for ports that implement port_second_core_start()
+CIRCUITPY_MICROCONTROLLER_CORE1 ?= 0
+CFLAGS += -DCIRCUITPY_MICROCONTROLLER_CORE1=$(CIRCUITPY_MICROCONTROLLER_CORE1)
+
 CIRCUITPY_MDNS ?= $(CIRCUITPY_WIFI)
 CFLAGS += -DCIRCUITPY_MDNS=$(CIRCUITPY_MDNS)
 
 CIRCUITPY_MSGPACK ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_MSGPACK=$(CIRCUITPY_MSGPACK)
 
+# Run .mpy bytecode in place from memory-mapped flash. Needs the port to
+# implement supervisor_flash_get_xip_addr().
+CIRCUITPY_MPY_XIP ?= 0
+CFLAGS += -DCIRCUITPY_MPY_XIP=$(CIRCUITPY_MPY_XIP)
+
 CIRCUITPY_NEOPIXEL_WRITE ?= 1
 CFLAGS += -DCIRCUITPY_NEOPIXEL_WRITE=$(CIRCUITPY_NEOPIXEL_WRITE)
 
@@ -388,6 +422,9 @@ CFLAGS += -DCIRCUITPY_OPT_LOAD_ATTR_FAST_PATH=$(CIRCUITPY_OPT_LOAD_ATTR_FAST_PAT
 CIRCUITPY_OPT_MAP_LOOKUP_CACHE ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_OPT_MAP_LOOKUP_CACHE=$(CIRCUITPY_OPT_MAP_LOOKUP_CACHE)
 
+CIRCUITPY_OPT_MPZ_INT64 ?= $(CIRCUITPY_FULL_BUILD)
+CFLAGS += -DCIRCUITPY_OPT_MPZ_INT64=$(CIRCUITPY_OPT_MPZ_INT64)
+
 CIRCUITPY_OS ?= 1
 CFLAGS += -DCIRCUITPY_OS=$(CIRCUITPY_OS)
 
@@ -405,6 +442,19 @@ CFLAGS += -DCIRCUITPY_PIXELBUF=$(CIRCUITPY_PIXELBUF)
 CIRCUITPY_PIXELMAP ?= $(CIRCUITPY_PIXELBUF)
 CFLAGS += -DCIRCUITPY_PIXELMAP=$(CIRCUITPY_PIXELMAP)
 
+# Drives several PixelBuf strips at once. Needs a port implementation.
+ifeq ($(CIRCUITPY_PIXELBUF),1)
+CIRCUITPY_NEOPIXEL_PARALLEL ?= 0
+else
+CIRCUITPY_NEOPIXEL_PARALLEL = 0
+endif
+CFLAGS += -DCIRCUITPY_NEOPIXEL_PARALLEL=$(CIRCUITPY_NEOPIXEL_PARALLEL)
+
+# Port heap use per port_malloc() caller, readable from supervisor.runtime.port_heap_stats.
+# Instrumentation only: it adds a header to every port heap allocation.
+CIRCUITPY_PORT_HEAP_STATS ?= 0
+CFLAGS += -DCIRCUITPY_PORT_HEAP_STATS=$(CIRCUITPY_PORT_HEAP_STATS)
+
 # Only for SAMD boards for the moment
 CIRCUITPY_PS2IO ?= 0
 CFLAGS += -DCIRCUITPY_PS2IO=$(CIRCUITPY_PS2IO)
@@ -464,6 +514,10 @@ CFLAGS += -DCIRCUITPY_RTC=$(CIRCUITPY_RTC)
 CIRCUITPY_SAFEMODE_PY ?= 1
 CFLAGS += -DCIRCUITPY_SAFEMODE_PY=$(CIRCUITPY_SAFEMODE_PY)
 
+# Sampling profiler exposed through supervisor.start_profiling().
+CIRCUITPY_SAMPLING_PROFILER ?= 0
+CFLAGS += -DCIRCUITPY_SAMPLING_PROFILER=$(CIRCUITPY_SAMPLING_PROFILER)
+
 # CIRCUITPY_SAMD is handled in the atmel-samd tree.
 # Only for SAMD chips.
 # Assume not a SAMD build.
@@ -512,12 +566,30 @@ CFLAGS += -DCIRCUITPY_STORAGE=$(CIRCUITPY_STORAGE)
 CIRCUITPY_STORAGE_EXTEND ?= $(CIRCUITPY_DUALBANK)
 CFLAGS += -DCIRCUITPY_STORAGE_EXTEND=$(CIRCUITPY_STORAGE_EXTEND)
 
+# storage.mmap(): read files in place from memory-mapped flash. Needs the port
+# to implement supervisor_flash_get_xip_addr().
+CIRCUITPY_STORAGE_MMAP ?= 0
+CFLAGS += -DCIRCUITPY_STORAGE_MMAP=$(CIRCUITPY_STORAGE_MMAP)
+
 CIRCUITPY_STRUCT ?= 1
 CFLAGS += -DCIRCUITPY_STRUCT=$(CIRCUITPY_STRUCT)
 
 CIRCUITPY_SUPERVISOR ?= 1
 CFLAGS += -DCIRCUITPY_SUPERVISOR=$(CIRCUITPY_SUPERVISOR)
 
+# Cycle-counted benchmark runner exposed through supervisor.benchmark().
+CIRCUITPY_SUPERVISOR_BENCHMARK ?= $(CIRCUITPY_FULL_BUILD)
+CFLAGS += -DCIRCUITPY_SUPERVISOR_BENCHMARK=$(CIRCUITPY_SUPERVISOR_BENCHMARK)
+
+# Per-module import timings exposed through supervisor.import_stats().
+CIRCUITPY_SUPERVISOR_IMPORT_STATS ?= 0
+CFLAGS += -DCIRCUITPY_SUPERVISOR_IMPORT_STATS=$(CIRCUITPY_SUPERVISOR_IMPORT_STATS)
+
+# Ring buffer of GC, background callback, display and audio events, printed as
+# Chrome trace JSON by supervisor.dump_trace().
+CIRCUITPY_SUPERVISOR_TRACE ?= 0
+CFLAGS += -DCIRCUITPY_SUPERVISOR_TRACE=$(CIRCUITPY_SUPERVISOR_TRACE)
+
 CIRCUITPY_SYNTHIO ?= $(CIRCUITPY_AUDIOCORE)
 CFLAGS += -DCIRCUITPY_SYNTHIO=$(CIRCUITPY_SYNTHIO)
 
@@ -606,6 +678,20 @@ CFLAGS += -DCIRCUITPY_USB_MSC=$(CIRCUITPY_USB_MSC)
 CIRCUITPY_USB_MSC_ENABLED_DEFAULT ?= $(CIRCUITPY_USB_MSC)
 CFLAGS += -DCIRCUITPY_USB_MSC_ENABLED_DEFAULT=$(CIRCUITPY_USB_MSC_ENABLED_DEFAULT)
 
+# Format CIRCUITPY as littlefs instead of FAT. littlefs is wear leveled and
+# power-loss safe, but a host can't read it, so it needs USB MSC turned off.
+CIRCUITPY_FILESYSTEM_LFS ?= 0
+CFLAGS += -DCIRCUITPY_FILESYSTEM_LFS=$(CIRCUITPY_FILESYSTEM_LFS)
+ifeq ($(CIRCUITPY_FILESYSTEM_LFS),1)
+ifneq ($(CIRCUITPY_USB_MSC),0)
+$(error CIRCUITPY_FILESYSTEM_LFS requires CIRCUITPY_USB_MSC = 0)
+endif
+ifneq ($(CIRCUITPY_STORAGE_EXTEND),0)
+$(error CIRCUITPY_FILESYSTEM_LFS requires CIRCUITPY_STORAGE_EXTEND = 0)
+endif
+MICROPY_VFS_LFS2 = 1
+endif
+
 # Defaulting this to OFF initially because it has only been tested on a
 # limited number of platforms, and the other platforms do not have this
 # setting in their mpconfigport.mk and/or mpconfigboard.mk files yet.
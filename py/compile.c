@@ -104,6 +104,8 @@ STATIC const emit_method_table_t *emit_native_table[] = {
     &emit_native_thumb_method_table,
     &emit_native_xtensa_method_table,
     &emit_native_xtensawin_method_table,
+    // CIRCUITPY-CHANGE: RV32 native emitter
+    &emit_native_rv32_method_table,
 };
 
 #elif MICROPY_EMIT_NATIVE
@@ -120,6 +122,9 @@ STATIC const emit_method_table_t *emit_native_table[] = {
 #define NATIVE_EMITTER(f) emit_native_xtensa_##f
 #elif MICROPY_EMIT_XTENSAWIN
 #define NATIVE_EMITTER(f) emit_native_xtensawin_##f
+// CIRCUITPY-CHANGE: RV32 native emitter
+#elif MICROPY_EMIT_RV32
+#define NATIVE_EMITTER(f) emit_native_rv32_##f
 #else
 #error "unknown native emitter"
 #endif
@@ -143,6 +148,8 @@ STATIC const emit_inline_asm_method_table_t *emit_asm_table[] = {
     &emit_inline_thumb_method_table,
     &emit_inline_xtensa_method_table,
     NULL,
+    // CIRCUITPY-CHANGE: no inline assembler for RV32
+    NULL,
 };
 
 #elif MICROPY_EMIT_INLINE_ASM
@@ -167,6 +174,8 @@ typedef struct _compiler_t {
     uint8_t is_repl;
     uint8_t pass; // holds enum type pass_kind_t
     uint8_t have_star;
+    // CIRCUITPY-CHANGE: positional defaults are loaded as one constant tuple
+    uint8_t have_const_defaults;
 
     // try to keep compiler clean from nlr
     mp_obj_t compile_error; // set to an exception object if there's an error
@@ -728,22 +737,88 @@ STATIC void compile_funcdef_lambdef_param(compiler_t *comp, mp_parse_node_t pn)
                 EMIT(store_map);
             } else {
                 comp->num_default_params += 1;
-                compile_node(comp, pn_equal);
+                // CIRCUITPY-CHANGE: constant defaults are loaded together after the loop
+                if (!comp->have_const_defaults) {
+                    compile_node(comp, pn_equal);
+                }
             }
         }
     }
 }
 
+#if MICROPY_COMP_CONST_TUPLE
+// CIRCUITPY-CHANGE: if every default is a constant and there are no keyword-only
+// defaults, return the defaults as a tuple so they can be loaded as a single
+// constant object.  Frozen code then keeps the tuple in ROM instead of building
+// a new one on the heap each time the def runs.
+// Returns the default value of a parameter node, or MP_PARSE_NODE_NULL if it has none.
+STATIC mp_parse_node_t funcdef_lambdef_param_default(mp_parse_node_t pn, bool *have_star) {
+    if (MP_PARSE_NODE_IS_ID(pn)) {
+        return MP_PARSE_NODE_NULL;
+    }
+    mp_parse_node_struct_t *pns = (mp_parse_node_struct_t *)pn;
+    int pn_kind = MP_PARSE_NODE_STRUCT_KIND(pns);
+    if (pn_kind == PN_typedargslist_star || pn_kind == PN_varargslist_star) {
+        *have_star = true;
+    } else if (pn_kind == PN_typedargslist_name) {
+        return pns->nodes[2];
+    } else if (pn_kind == PN_varargslist_name) {
+        return pns->nodes[1];
+    }
+    return MP_PARSE_NODE_NULL;
+}
+
+STATIC mp_obj_t compile_funcdef_lambdef_const_defaults(mp_parse_node_t pn_params, pn_kind_t pn_list_kind) {
+    mp_parse_node_t *nodes;
+    size_t n = mp_parse_node_extract_list(&pn_params, pn_list_kind, &nodes);
+    size_t num_defaults = 0;
+    bool have_star = false;
+    for (size_t i = 0; i < n; i++) {
+        mp_parse_node_t pn_default = funcdef_lambdef_param_default(nodes[i], &have_star);
+        if (MP_PARSE_NODE_IS_NULL(pn_default)) {
+            continue;
+        }
+        if (have_star || !mp_parse_node_is_const(pn_default)) {
+            return MP_OBJ_NULL;
+        }
+        num_defaults += 1;
+    }
+    if (num_defaults == 0) {
+        return MP_OBJ_NULL;
+    }
+    mp_obj_tuple_t *tuple = MP_OBJ_TO_PTR(mp_obj_new_tuple(num_defaults, NULL));
+    num_defaults = 0;
+    for (size_t i = 0; i < n; i++) {
+        mp_parse_node_t pn_default = funcdef_lambdef_param_default(nodes[i], &have_star);
+        if (!MP_PARSE_NODE_IS_NULL(pn_default)) {
+            tuple->items[num_defaults++] = mp_parse_node_convert_to_obj(pn_default);
+        }
+    }
+    return MP_OBJ_FROM_PTR(tuple);
+}
+#endif
+
 STATIC void compile_funcdef_lambdef(compiler_t *comp, scope_t *scope, mp_parse_node_t pn_params, pn_kind_t pn_list_kind) {
     // When we call compile_funcdef_lambdef_param below it can compile an arbitrary
     // expression for default arguments, which may contain a lambda.  The lambda will
     // call here in a nested way, so we must save and restore the relevant state.
     bool orig_have_star = comp->have_star;
+    bool orig_have_const_defaults = comp->have_const_defaults;
     uint16_t orig_num_dict_params = comp->num_dict_params;
     uint16_t orig_num_default_params = comp->num_default_params;
 
+    // CIRCUITPY-CHANGE: the scope pass doesn't emit anything, so only the
+    // later passes need the constant tuple
+    mp_obj_t const_defaults = MP_OBJ_NULL;
+    #if MICROPY_COMP_CONST_TUPLE
+    if (comp->pass > MP_PASS_SCOPE) {
+        const_defaults = compile_funcdef_lambdef_const_defaults(pn_params, pn_list_kind);
+    }
+    #endif
+
     // compile default parameters
     comp->have_star = false;
+    comp->have_const_defaults = const_defaults != MP_OBJ_NULL;
     comp->num_dict_params = 0;
     comp->num_default_params = 0;
     apply_to_single_or_list(comp, pn_params, pn_list_kind, compile_funcdef_lambdef_param);
@@ -755,7 +830,11 @@ STATIC void compile_funcdef_lambdef(compiler_t *comp, scope_t *scope, mp_parse_n
     // in MicroPython we put the default positional parameters into a tuple using the bytecode
     // the default keywords args may have already made the tuple; if not, do it now
     if (comp->num_default_params > 0 && comp->num_dict_params == 0) {
-        EMIT_ARG(build, comp->num_default_params, MP_EMIT_BUILD_TUPLE);
+        if (const_defaults != MP_OBJ_NULL) {
+            EMIT_ARG(load_const_obj, const_defaults);
+        } else {
+            EMIT_ARG(build, comp->num_default_params, MP_EMIT_BUILD_TUPLE);
+        }
         EMIT(load_null); // sentinel indicating empty default keyword args
     }
 
@@ -764,6 +843,7 @@ STATIC void compile_funcdef_lambdef(compiler_t *comp, scope_t *scope, mp_parse_n
 
     // restore state
     comp->have_star = orig_have_star;
+    comp->have_const_defaults = orig_have_const_defaults;
     comp->num_dict_params = orig_num_dict_params;
     comp->num_default_params = orig_num_default_params;
 }
@@ -772,6 +852,13 @@ STATIC void compile_funcdef_lambdef(compiler_t *comp, scope_t *scope, mp_parse_n
 // returns function name
 STATIC qstr compile_funcdef_helper(compiler_t *comp, mp_parse_node_struct_t *pns, uint emit_options) {
     if (comp->pass == MP_PASS_SCOPE) {
+        // CIRCUITPY-CHANGE
+        #if MICROPY_DYNAMIC_COMPILER && MICROPY_EMIT_NATIVE
+        if (emit_options == MP_EMIT_OPT_NONE && mp_dynamic_compiler.native_select != NULL
+            && mp_dynamic_compiler.native_select(MP_PARSE_NODE_LEAF_ARG(pns->nodes[0]), pns->source_line)) {
+            emit_options = MP_EMIT_OPT_NATIVE_PYTHON;
+        }
+        #endif
         // create a new scope for this function
         scope_t *s = scope_new_and_link(comp, SCOPE_FUNCTION, (mp_parse_node_t)pns, emit_options);
         // store the function scope so the compiling function can use it at each pass
@@ -43,4 +43,11 @@ void mp_compile_to_raw_code(mp_parse_tree_t *parse_tree, qstr source_file, bool
 // this is implemented in runtime.c
 mp_obj_t mp_parse_compile_execute(mp_lexer_t *lex, mp_parse_input_kind_t parse_input_kind, mp_obj_dict_t *globals, mp_obj_dict_t *locals);
 
+// CIRCUITPY-CHANGE
+#if MICROPY_COMPILE_BY_STATEMENT
+// Like mp_parse_compile_execute() for MP_PARSE_FILE_INPUT, but each top-level
+// statement is parsed, compiled and run before the next one is read.
+void mp_parse_compile_execute_by_statement(mp_lexer_t *lex, mp_obj_dict_t *globals);
+#endif
+
 #endif // MICROPY_INCLUDED_PY_COMPILE_H
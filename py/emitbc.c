@@ -73,8 +73,28 @@ struct _emit_t {
 
     size_t n_info;
     size_t n_cell;
+
+    #if MICROPY_OPT_FUSED_OPCODES
+    // State of the peephole matcher for fused opcodes: which prefix of the
+    // fusable sequence was just emitted, where it started and where it ended.
+    uint8_t peep_kind;
+    size_t peep_start;
+    size_t peep_end;
+    mp_uint_t peep_local;
+    mp_int_t peep_int;
+    mp_binary_op_t peep_op;
+    #endif
 };
 
+#if MICROPY_OPT_FUSED_OPCODES
+enum {
+    PEEP_NONE,
+    PEEP_LOAD_FAST, // LOAD_FAST
+    PEEP_LOAD_FAST_INT, // LOAD_FAST, LOAD_CONST_SMALL_INT
+    PEEP_BINARY_OP, // BINARY_OP_FAST_SMALL_INT
+};
+#endif
+
 emit_t *emit_bc_new(mp_emit_common_t *emit_common) {
     emit_t *emit = m_new0(emit_t, 1);
     emit->emit_common = emit_common;
@@ -280,6 +300,29 @@ STATIC void emit_write_bytecode_byte_label(emit_t *emit, int stack_adj, byte b1,
     }
 }
 
+#if MICROPY_OPT_FUSED_OPCODES
+// The matcher works on offsets: a prefix can only be extended if nothing else
+// was emitted since it ended, and it can only be rewritten if no line number
+// boundary was recorded inside it.  Both are the same on every pass, so the
+// code size stays consistent between passes.
+STATIC void emit_peep_record(emit_t *emit, uint8_t kind, size_t start) {
+    if (emit->suppress) {
+        emit->peep_kind = PEEP_NONE;
+        return;
+    }
+    emit->peep_kind = kind;
+    emit->peep_start = start;
+    emit->peep_end = emit->bytecode_offset;
+}
+
+STATIC bool emit_peep_match(emit_t *emit, uint8_t kind) {
+    return emit->peep_kind == kind
+           && !emit->suppress
+           && emit->peep_end == emit->bytecode_offset
+           && emit->last_source_line_offset <= emit->peep_start;
+}
+#endif
+
 void mp_emit_bc_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scope) {
     emit->pass = pass;
     emit->stack_size = 0;
@@ -290,6 +333,9 @@ void mp_emit_bc_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scope) {
     emit->bytecode_offset = 0;
     emit->code_info_offset = 0;
     emit->overflow = false;
+    #if MICROPY_OPT_FUSED_OPCODES
+    emit->peep_kind = PEEP_NONE;
+    #endif
 
     // Write local state size, exception stack size, scope flags and number of arguments
     {
@@ -457,6 +503,11 @@ void mp_emit_bc_label_assign(emit_t *emit, mp_uint_t l) {
 
     // Assign label offset.
     emit->label_offsets[l] = emit->bytecode_offset;
+
+    #if MICROPY_OPT_FUSED_OPCODES
+    // Code can jump here, so the previous opcodes can no longer be fused.
+    emit->peep_kind = PEEP_NONE;
+    #endif
 }
 
 void mp_emit_bc_import(emit_t *emit, qstr qst, int kind) {
@@ -482,6 +533,10 @@ void mp_emit_bc_load_const_tok(emit_t *emit, mp_token_kind_t tok) {
 
 void mp_emit_bc_load_const_small_int(emit_t *emit, mp_int_t arg) {
     assert(MP_SMALL_INT_FITS(arg));
+    #if MICROPY_OPT_FUSED_OPCODES
+    bool fusable = emit_peep_match(emit, PEEP_LOAD_FAST)
+        && MP_BC_FUSED_SMALL_INT_MIN <= arg && arg <= MP_BC_FUSED_SMALL_INT_MAX;
+    #endif
     if (-MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS <= arg
         && arg < MP_BC_LOAD_CONST_SMALL_INT_MULTI_NUM - MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS) {
         emit_write_bytecode_byte(emit, 1,
@@ -489,6 +544,12 @@ void mp_emit_bc_load_const_small_int(emit_t *emit, mp_int_t arg) {
     } else {
         emit_write_bytecode_byte_int(emit, 1, MP_BC_LOAD_CONST_SMALL_INT, arg);
     }
+    #if MICROPY_OPT_FUSED_OPCODES
+    if (fusable) {
+        emit->peep_int = arg;
+        emit_peep_record(emit, PEEP_LOAD_FAST_INT, emit->peep_start);
+    }
+    #endif
 }
 
 void mp_emit_bc_load_const_str(emit_t *emit, qstr qst) {
@@ -507,11 +568,20 @@ void mp_emit_bc_load_local(emit_t *emit, qstr qst, mp_uint_t local_num, int kind
     MP_STATIC_ASSERT(MP_BC_LOAD_FAST_N + MP_EMIT_IDOP_LOCAL_FAST == MP_BC_LOAD_FAST_N);
     MP_STATIC_ASSERT(MP_BC_LOAD_FAST_N + MP_EMIT_IDOP_LOCAL_DEREF == MP_BC_LOAD_DEREF);
     (void)qst;
+    #if MICROPY_OPT_FUSED_OPCODES
+    size_t start = emit->bytecode_offset;
+    #endif
     if (kind == MP_EMIT_IDOP_LOCAL_FAST && local_num <= 15) {
         emit_write_bytecode_byte(emit, 1, MP_BC_LOAD_FAST_MULTI + local_num);
     } else {
         emit_write_bytecode_byte_uint(emit, 1, MP_BC_LOAD_FAST_N + kind, local_num);
     }
+    #if MICROPY_OPT_FUSED_OPCODES
+    if (kind == MP_EMIT_IDOP_LOCAL_FAST) {
+        emit->peep_local = local_num;
+        emit_peep_record(emit, PEEP_LOAD_FAST, start);
+    }
+    #endif
 }
 
 void mp_emit_bc_load_global(emit_t *emit, qstr qst, int kind) {
@@ -558,6 +628,16 @@ void mp_emit_bc_store_local(emit_t *emit, qstr qst, mp_uint_t local_num, int kin
     MP_STATIC_ASSERT(MP_BC_STORE_FAST_N + MP_EMIT_IDOP_LOCAL_FAST == MP_BC_STORE_FAST_N);
     MP_STATIC_ASSERT(MP_BC_STORE_FAST_N + MP_EMIT_IDOP_LOCAL_DEREF == MP_BC_STORE_DEREF);
     (void)qst;
+    #if MICROPY_OPT_FUSED_OPCODES
+    if (kind == MP_EMIT_IDOP_LOCAL_FAST && local_num == emit->peep_local && emit_peep_match(emit, PEEP_BINARY_OP)) {
+        // Rewrite "local op int" followed by a store back to the same local.
+        emit->bytecode_offset = emit->peep_start;
+        emit->peep_kind = PEEP_NONE;
+        emit_write_bytecode_byte_uint(emit, -1, MP_BC_INPLACE_OP_FAST_SMALL_INT,
+            MP_BC_FUSED_ENCODE(local_num, emit->peep_int, emit->peep_op));
+        return;
+    }
+    #endif
     if (kind == MP_EMIT_IDOP_LOCAL_FAST && local_num <= 15) {
         emit_write_bytecode_byte(emit, -1, MP_BC_STORE_FAST_MULTI + local_num);
     } else {
@@ -698,6 +778,18 @@ void mp_emit_bc_binary_op(emit_t *emit, mp_binary_op_t op) {
         invert = true;
         op = MP_BINARY_OP_IS;
     }
+    #if MICROPY_OPT_FUSED_OPCODES
+    if (!invert && emit_peep_match(emit, PEEP_LOAD_FAST_INT)) {
+        // Replace the LOAD_FAST and LOAD_CONST_SMALL_INT with a single opcode.
+        size_t start = emit->peep_start;
+        emit->bytecode_offset = start;
+        emit_write_bytecode_byte_uint(emit, -1, MP_BC_BINARY_OP_FAST_SMALL_INT,
+            MP_BC_FUSED_ENCODE(emit->peep_local, emit->peep_int, op));
+        emit->peep_op = op;
+        emit_peep_record(emit, PEEP_BINARY_OP, start);
+        return;
+    }
+    #endif
     emit_write_bytecode_byte(emit, -1, MP_BC_BINARY_OP_MULTI + op);
     if (invert) {
         emit_write_bytecode_byte(emit, 0, MP_BC_UNARY_OP_MULTI + MP_UNARY_OP_NOT);
@@ -30,6 +30,7 @@
 #include <string.h>
 
 #include "py/gc.h"
+#include "py/mphal.h"
 #include "py/runtime.h"
 
 #if MICROPY_DEBUG_VALGRIND
@@ -38,6 +39,7 @@
 
 // CIRCUITPY-CHANGE
 #include "supervisor/shared/safe_mode.h"
+#include "supervisor/shared/trace.h"
 
 #if CIRCUITPY_MEMORYMONITOR
 #include "shared-module/memorymonitor/__init__.h"
@@ -103,6 +105,18 @@
 #define ATB_HEAD_TO_MARK(area, block) do { area->gc_alloc_table_start[(block) / BLOCKS_PER_ATB] |= (AT_MARK << BLOCK_SHIFT(block)); } while (0)
 #define ATB_MARK_TO_HEAD(area, block) do { area->gc_alloc_table_start[(block) / BLOCKS_PER_ATB] &= (~(AT_TAIL << BLOCK_SHIFT(block))); } while (0)
 
+#if MICROPY_GC_INCREMENTAL_SWEEP
+// Heads that the pending sweep hasn't reached yet still carry their mark.
+#define ATB_IS_HEAD(area, block) (ATB_GET_KIND(area, block) == AT_HEAD || ATB_GET_KIND(area, block) == AT_MARK)
+#else
+#define ATB_IS_HEAD(area, block) (ATB_GET_KIND(area, block) == AT_HEAD)
+#endif
+
+#if MICROPY_GC_HOT_ALLOC_MAX_BYTES
+// Allocations of this many blocks look in slow areas first.
+#define GC_WANTS_SLOW_AREA(n_blocks) ((n_blocks) * BYTES_PER_BLOCK > MICROPY_GC_HOT_ALLOC_MAX_BYTES)
+#endif
+
 #define BLOCK_FROM_PTR(area, ptr) (((byte *)(ptr) - area->gc_pool_start) / BYTES_PER_BLOCK)
 #define PTR_FROM_BLOCK(area, block) (((block) * BYTES_PER_BLOCK + (uintptr_t)area->gc_pool_start))
 
@@ -188,6 +202,27 @@ STATIC void gc_setup_area(mp_state_mem_area_t *area, void *start, void *end) {
 
     area->gc_last_free_atb_index = 0;
     area->gc_last_used_block = 0;
+    #if MICROPY_GC_SMALL_ALLOC_NEXT_FIT
+    area->gc_small_alloc_atb_index = 0;
+    #endif
+    #if MICROPY_GC_HOT_ALLOC_MAX_BYTES
+    area->gc_slow = MP_PLAT_HEAP_IS_SLOW(start);
+    #endif
+
+    #if MICROPY_GC_FREE_RUN_INDEX
+    // An empty area is one big free run.
+    memset(area->gc_free_run_len, 0, sizeof(area->gc_free_run_len));
+    area->gc_free_run_start[0] = 0;
+    area->gc_free_run_len[0] = gc_pool_block_len;
+    #endif
+
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    // nothing to sweep in a new area
+    area->gc_sweep_block = 0;
+    area->gc_sweep_end = 0;
+    area->gc_sweep_last_used = 0;
+    area->gc_sweep_free_tail = 0;
+    #endif
 
     #if MICROPY_GC_SPLIT_HEAP
     area->next = NULL;
@@ -227,6 +262,21 @@ void gc_init(void *start, void *end) {
     // allow auto collection
     MP_STATE_MEM(gc_auto_collect_enabled) = 1;
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_STATS
+    MP_STATE_MEM(gc_stats_collections) = 0;
+    MP_STATE_MEM(gc_stats_alloc_blocks) = 0;
+    MP_STATE_MEM(gc_stats_alloc_failures) = 0;
+    MP_STATE_MEM(gc_stats_pause_total_us) = 0;
+    MP_STATE_MEM(gc_stats_pause_max_us) = 0;
+    #endif
+
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    MP_STATE_MEM(gc_sweep_pending) = false;
+    MP_STATE_MEM(gc_pause_last_ms) = 0;
+    MP_STATE_MEM(gc_pause_max_ms) = 0;
+    #endif
+
     #if MICROPY_GC_ALLOC_THRESHOLD
     // by default, maxuint for gc threshold, effectively turning gc-by-threshold off
     MP_STATE_MEM(gc_alloc_threshold) = (size_t)-1;
@@ -317,7 +367,21 @@ STATIC bool gc_try_add_heap(size_t failed_alloc) {
 
     size_t to_alloc = MIN(avail, MAX(total_heap, needed));
 
-    mp_state_mem_area_t *new_heap = MP_PLAT_ALLOC_HEAP(to_alloc);
+    mp_state_mem_area_t *new_heap = NULL;
+    #if MICROPY_GC_HOT_ALLOC_MAX_BYTES
+    // Small objects get a modest area in fast memory if there is room, rather
+    // than doubling the heap there.
+    if (failed_alloc <= MICROPY_GC_HOT_ALLOC_MAX_BYTES) {
+        size_t fast_alloc = MIN(avail, MAX(needed, 8192));
+        new_heap = MP_PLAT_ALLOC_FAST_HEAP(fast_alloc);
+        if (new_heap != NULL) {
+            to_alloc = fast_alloc;
+        }
+    }
+    #endif
+    if (new_heap == NULL) {
+        new_heap = MP_PLAT_ALLOC_HEAP(to_alloc);
+    }
 
     DEBUG_printf("MP_PLAT_ALLOC_HEAP " UINT_FMT " = %p\n",
         to_alloc, new_heap);
@@ -506,6 +570,159 @@ STATIC void gc_deal_with_stack_overflow(void) {
     }
 }
 
+#if MICROPY_GC_FREE_RUN_INDEX
+// Remember a free run if it is larger than the smallest one already indexed.
+STATIC void gc_free_run_note(mp_state_mem_area_t *area, size_t start, size_t len) {
+    if (len < MICROPY_GC_FREE_RUN_MIN_BLOCKS) {
+        return;
+    }
+    size_t smallest = 0;
+    for (size_t j = 1; j < MICROPY_GC_FREE_RUN_INDEX; j++) {
+        if (area->gc_free_run_len[j] < area->gc_free_run_len[smallest]) {
+            smallest = j;
+        }
+    }
+    if (len > area->gc_free_run_len[smallest]) {
+        area->gc_free_run_start[smallest] = start;
+        area->gc_free_run_len[smallest] = len;
+    }
+}
+
+// Rebuild the free run index of every area from the allocation table.  Only
+// blocks up to gc_last_used_block need scanning; everything after it is free.
+STATIC void gc_free_run_rebuild(void) {
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        memset(area->gc_free_run_len, 0, sizeof(area->gc_free_run_len));
+        size_t total_blocks = area->gc_alloc_table_byte_len * BLOCKS_PER_ATB;
+        size_t end_block = MIN(area->gc_last_used_block + 1, total_blocks);
+        size_t run_start = 0;
+        size_t run_len = 0;
+        for (size_t block = 0; block < end_block; block++) {
+            if (ATB_GET_KIND(area, block) == AT_FREE) {
+                if (run_len++ == 0) {
+                    run_start = block;
+                }
+            } else {
+                gc_free_run_note(area, run_start, run_len);
+                run_len = 0;
+            }
+        }
+        if (run_len == 0) {
+            run_start = end_block;
+        }
+        gc_free_run_note(area, run_start, run_len + total_blocks - end_block);
+    }
+}
+
+// Find the smallest indexed run that fits n_blocks and whose blocks are still
+// free.  On success *area_out and *end_out describe the run like the linear
+// search in gc_alloc does (ending at block *end_out inclusive).
+STATIC bool gc_free_run_take(size_t n_blocks, mp_state_mem_area_t **area_out, size_t *end_out) {
+    #if MICROPY_GC_HOT_ALLOC_MAX_BYTES
+    bool want_slow = GC_WANTS_SLOW_AREA(n_blocks);
+    #endif
+    for (;;) {
+        mp_state_mem_area_t *best_area = NULL;
+        size_t best = 0;
+        for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+            for (size_t j = 0; j < MICROPY_GC_FREE_RUN_INDEX; j++) {
+                size_t len = area->gc_free_run_len[j];
+                if (len < n_blocks) {
+                    continue;
+                }
+                bool better = best_area == NULL || len < best_area->gc_free_run_len[best];
+                #if MICROPY_GC_HOT_ALLOC_MAX_BYTES
+                // The smallest run in the preferred kind of area wins.
+                if (best_area != NULL && best_area->gc_slow != area->gc_slow) {
+                    better = area->gc_slow == want_slow;
+                }
+                #endif
+                if (better) {
+                    best_area = area;
+                    best = j;
+                }
+            }
+        }
+        if (best_area == NULL) {
+            return false;
+        }
+        size_t start = best_area->gc_free_run_start[best];
+        size_t bl = start;
+        while (bl < start + n_blocks && ATB_GET_KIND(best_area, bl) == AT_FREE) {
+            bl++;
+        }
+        if (bl < start + n_blocks) {
+            // Part of the run was allocated since the sweep; forget it.
+            best_area->gc_free_run_len[best] = 0;
+            continue;
+        }
+        best_area->gc_free_run_start[best] = start + n_blocks;
+        best_area->gc_free_run_len[best] -= n_blocks;
+        *area_out = best_area;
+        *end_out = start + n_blocks - 1;
+        return true;
+    }
+}
+#endif
+
+// Sweep a single block: free unmarked heads along with their tails, and clear
+// the mark of heads that are still in use.  last_used_block only ever grows,
+// as gc_sweep_keep may already have raised it past this block.  Returns true
+// if the block was freed.
+STATIC bool gc_sweep_one(mp_state_mem_area_t *area, size_t block, int *free_tail, size_t *last_used_block) {
+    switch (ATB_GET_KIND(area, block)) {
+        case AT_HEAD:
+            #if MICROPY_ENABLE_FINALISER
+            if (FTB_GET(area, block)) {
+                mp_obj_base_t *obj = (mp_obj_base_t *)PTR_FROM_BLOCK(area, block);
+                if (obj->type != NULL) {
+                    // if the object has a type then see if it has a __del__ method
+                    mp_obj_t dest[2];
+                    mp_load_method_maybe(MP_OBJ_FROM_PTR(obj), MP_QSTR___del__, dest);
+                    if (dest[0] != MP_OBJ_NULL) {
+                        // load_method returned a method, execute it in a protected environment
+                        #if MICROPY_ENABLE_SCHEDULER
+                        mp_sched_lock();
+                        #endif
+                        mp_call_function_1_protected(dest[0], dest[1]);
+                        #if MICROPY_ENABLE_SCHEDULER
+                        mp_sched_unlock();
+                        #endif
+                    }
+                }
+                // clear finaliser flag
+                FTB_CLEAR(area, block);
+            }
+            #endif
+            *free_tail = 1;
+            DEBUG_printf("gc_sweep(%p)\n", (void *)PTR_FROM_BLOCK(area, block));
+            #if MICROPY_PY_GC_COLLECT_RETVAL
+            MP_STATE_MEM(gc_collected)++;
+            #endif
+            // fall through to free the head
+            MP_FALLTHROUGH
+
+        case AT_TAIL:
+            if (*free_tail) {
+                ATB_ANY_TO_FREE(area, block);
+                #if CLEAR_ON_SWEEP
+                memset((void *)PTR_FROM_BLOCK(area, block), 0, BYTES_PER_BLOCK);
+                #endif
+                return true;
+            }
+            *last_used_block = MAX(*last_used_block, block);
+            break;
+
+        case AT_MARK:
+            ATB_MARK_TO_HEAD(area, block);
+            *free_tail = 0;
+            *last_used_block = MAX(*last_used_block, block);
+            break;
+    }
+    return false;
+}
+
+#if !MICROPY_GC_INCREMENTAL_SWEEP
 STATIC void gc_sweep(void) {
     #if MICROPY_PY_GC_COLLECT_RETVAL
     MP_STATE_MEM(gc_collected) = 0;
@@ -525,55 +742,7 @@ STATIC void gc_sweep(void) {
 
         for (size_t block = 0; block < end_block; block++) {
             MICROPY_GC_HOOK_LOOP(block);
-            switch (ATB_GET_KIND(area, block)) {
-                case AT_HEAD:
-                    #if MICROPY_ENABLE_FINALISER
-                    if (FTB_GET(area, block)) {
-                        mp_obj_base_t *obj = (mp_obj_base_t *)PTR_FROM_BLOCK(area, block);
-                        if (obj->type != NULL) {
-                            // if the object has a type then see if it has a __del__ method
-                            mp_obj_t dest[2];
-                            mp_load_method_maybe(MP_OBJ_FROM_PTR(obj), MP_QSTR___del__, dest);
-                            if (dest[0] != MP_OBJ_NULL) {
-                                // load_method returned a method, execute it in a protected environment
-                                #if MICROPY_ENABLE_SCHEDULER
-                                mp_sched_lock();
-                                #endif
-                                mp_call_function_1_protected(dest[0], dest[1]);
-                                #if MICROPY_ENABLE_SCHEDULER
-                                mp_sched_unlock();
-                                #endif
-                            }
-                        }
-                        // clear finaliser flag
-                        FTB_CLEAR(area, block);
-                    }
-                    #endif
-                    free_tail = 1;
-                    DEBUG_printf("gc_sweep(%p)\n", (void *)PTR_FROM_BLOCK(area, block));
-                    #if MICROPY_PY_GC_COLLECT_RETVAL
-                    MP_STATE_MEM(gc_collected)++;
-                    #endif
-                    // fall through to free the head
-                    MP_FALLTHROUGH
-
-                case AT_TAIL:
-                    if (free_tail) {
-                        ATB_ANY_TO_FREE(area, block);
-                        #if CLEAR_ON_SWEEP
-                        memset((void *)PTR_FROM_BLOCK(area, block), 0, BYTES_PER_BLOCK);
-                        #endif
-                    } else {
-                        last_used_block = block;
-                    }
-                    break;
-
-                case AT_MARK:
-                    ATB_MARK_TO_HEAD(area, block);
-                    free_tail = 0;
-                    last_used_block = block;
-                    break;
-            }
+            gc_sweep_one(area, block, &free_tail, &last_used_block);
         }
 
         area->gc_last_used_block = last_used_block;
@@ -590,13 +759,157 @@ STATIC void gc_sweep(void) {
         #endif
     }
 }
+#endif
+
+#if MICROPY_GC_INCREMENTAL_SWEEP
+
+STATIC void gc_pause_end(void) {
+    mp_uint_t pause = mp_hal_ticks_ms() - MP_STATE_MEM(gc_pause_start_ms);
+    MP_STATE_MEM(gc_pause_last_ms) = pause;
+    if (pause > MP_STATE_MEM(gc_pause_max_ms)) {
+        MP_STATE_MEM(gc_pause_max_ms) = pause;
+    }
+}
+
+// Start a sweep of every area that is carried out later by gc_sweep_blocks.
+STATIC void gc_sweep_begin(void) {
+    #if MICROPY_PY_GC_COLLECT_RETVAL
+    MP_STATE_MEM(gc_collected) = 0;
+    #endif
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+        area->gc_sweep_block = 0;
+        area->gc_sweep_end = MIN(area->gc_last_used_block + 1, area->gc_alloc_table_byte_len * BLOCKS_PER_ATB);
+        area->gc_sweep_last_used = 0;
+        area->gc_sweep_free_tail = 0;
+    }
+    MP_STATE_MEM(gc_sweep_pending) = true;
+}
+
+// Sweep up to n_blocks more blocks of the pending sweep.  The GC mutex must
+// be held.
+STATIC void gc_sweep_blocks(size_t n_blocks) {
+    if (!MP_STATE_MEM(gc_sweep_pending)) {
+        return;
+    }
+    MP_STATE_THREAD(gc_lock_depth)++;
+    bool done = true;
+    for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL && done; area = NEXT_AREA(area)) {
+        size_t first_freed = (size_t)-1;
+        while (area->gc_sweep_block < area->gc_sweep_end) {
+            if (n_blocks == 0) {
+                done = false;
+                break;
+            }
+            n_blocks--;
+            // advance first, so that a finaliser re-entering the sweep
+            // doesn't process this block a second time
+            size_t block = area->gc_sweep_block++;
+            MICROPY_GC_HOOK_LOOP(block);
+            if (gc_sweep_one(area, block, &area->gc_sweep_free_tail, &area->gc_sweep_last_used)) {
+                first_freed = MIN(first_freed, block);
+            }
+        }
+        if (first_freed != (size_t)-1) {
+            // freed blocks may lie before where gc_alloc starts looking
+            #if MICROPY_GC_SPLIT_HEAP
+            MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
+            #endif
+            if (first_freed / BLOCKS_PER_ATB < area->gc_last_free_atb_index) {
+                area->gc_last_free_atb_index = first_freed / BLOCKS_PER_ATB;
+            }
+        }
+    }
+    if (done) {
+        #if MICROPY_GC_SPLIT_HEAP_AUTO
+        mp_state_mem_area_t *prev_area = NULL;
+        #endif
+        for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
+            area->gc_last_used_block = area->gc_sweep_last_used;
+            #if MICROPY_GC_SPLIT_HEAP_AUTO
+            // Free any empty area, aside from the first one
+            if (area->gc_last_used_block == 0 && prev_area != NULL) {
+                DEBUG_printf("gc_sweep free empty area %p\n", area);
+                NEXT_AREA(prev_area) = NEXT_AREA(area);
+                MP_PLAT_FREE_HEAP(area);
+                area = prev_area;
+                MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
+            }
+            prev_area = area;
+            #endif
+        }
+        MP_STATE_MEM(gc_sweep_pending) = false;
+        #if MICROPY_GC_FREE_RUN_INDEX
+        gc_free_run_rebuild();
+        #endif
+    }
+    MP_STATE_THREAD(gc_lock_depth)--;
+}
+
+// Blocks start_block..end_block of area have just become used while a sweep
+// is pending.  A new head the sweep hasn't reached yet is marked so it isn't
+// freed, and tails that the sweep is about to reach must not be mistaken for
+// the tail of a dead chain.
+STATIC void gc_sweep_keep(mp_state_mem_area_t *area, size_t start_block, size_t end_block, bool is_head) {
+    if (!MP_STATE_MEM(gc_sweep_pending)) {
+        return;
+    }
+    size_t cursor = area->gc_sweep_block;
+    if (cursor < area->gc_sweep_end) {
+        if (is_head && start_block >= cursor && start_block < area->gc_sweep_end) {
+            ATB_HEAD_TO_MARK(area, start_block);
+        } else if (start_block <= cursor && cursor <= end_block) {
+            area->gc_sweep_free_tail = 0;
+        }
+    }
+    // the sweep only sees blocks between its cursor and its end
+    if (end_block < cursor || end_block >= area->gc_sweep_end) {
+        area->gc_sweep_last_used = MAX(area->gc_sweep_last_used, end_block);
+    }
+}
+
+void gc_sweep_step(void) {
+    if (!MP_STATE_MEM(gc_sweep_pending) || MP_STATE_THREAD(gc_lock_depth) > 0) {
+        return;
+    }
+    GC_ENTER();
+    MP_STATE_MEM(gc_pause_start_ms) = mp_hal_ticks_ms();
+    gc_sweep_blocks(MICROPY_GC_INCREMENTAL_SWEEP_BLOCKS);
+    gc_pause_end();
+    GC_EXIT();
+}
+
+void gc_sweep_finish(void) {
+    if (!MP_STATE_MEM(gc_sweep_pending) || MP_STATE_THREAD(gc_lock_depth) > 0) {
+        return;
+    }
+    GC_ENTER();
+    MP_STATE_MEM(gc_pause_start_ms) = mp_hal_ticks_ms();
+    gc_sweep_blocks((size_t)-1);
+    gc_pause_end();
+    GC_EXIT();
+}
+#endif
 
 void gc_collect_start(void) {
     GC_ENTER();
+    // CIRCUITPY-CHANGE
+    CIRCUITPY_TRACE_BEGIN(TRACE_EVENT_GC_COLLECT);
+    #if MICROPY_GC_STATS
+    MP_STATE_MEM(gc_stats_pause_start_us) = MICROPY_GC_STATS_TICKS_US();
+    #endif
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    MP_STATE_MEM(gc_pause_start_ms) = mp_hal_ticks_ms();
+    // the previous sweep must be complete before marking again
+    gc_sweep_blocks((size_t)-1);
+    #endif
     MP_STATE_THREAD(gc_lock_depth)++;
     #if MICROPY_GC_ALLOC_THRESHOLD
     MP_STATE_MEM(gc_alloc_amount) = 0;
     #endif
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_STATS
+    MP_STATE_MEM(gc_stats_collections)++;
+    #endif
     MP_STATE_MEM(gc_stack_overflow) = 0;
 
     // Trace root pointers.  This relies on the root pointers being organised
@@ -668,22 +981,60 @@ void gc_collect_root(void **ptrs, size_t len) {
 
 void gc_collect_end(void) {
     gc_deal_with_stack_overflow();
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    gc_sweep_begin();
+    #else
     gc_sweep();
+    #if MICROPY_GC_FREE_RUN_INDEX
+    gc_free_run_rebuild();
+    #endif
+    #endif
     #if MICROPY_GC_SPLIT_HEAP
     MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
     #endif
     for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
         area->gc_last_free_atb_index = 0;
+        #if MICROPY_GC_SMALL_ALLOC_NEXT_FIT
+        area->gc_small_alloc_atb_index = 0;
+        #endif
     }
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    gc_pause_end();
+    #endif
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_STATS
+    uint32_t pause_us = MICROPY_GC_STATS_TICKS_US() - MP_STATE_MEM(gc_stats_pause_start_us);
+    MP_STATE_MEM(gc_stats_pause_total_us) += pause_us;
+    if (pause_us > MP_STATE_MEM(gc_stats_pause_max_us)) {
+        MP_STATE_MEM(gc_stats_pause_max_us) = pause_us;
+    }
+    #endif
     MP_STATE_THREAD(gc_lock_depth)--;
+    // CIRCUITPY-CHANGE
+    CIRCUITPY_TRACE_END(TRACE_EVENT_GC_COLLECT);
     GC_EXIT();
 }
 
 void gc_sweep_all(void) {
     GC_ENTER();
+    // CIRCUITPY-CHANGE: gc_collect_end() ends the event.
+    CIRCUITPY_TRACE_BEGIN(TRACE_EVENT_GC_COLLECT);
+    #if MICROPY_GC_STATS
+    MP_STATE_MEM(gc_stats_pause_start_us) = MICROPY_GC_STATS_TICKS_US();
+    #endif
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    MP_STATE_MEM(gc_pause_start_ms) = mp_hal_ticks_ms();
+    gc_sweep_blocks((size_t)-1);
+    #endif
     MP_STATE_THREAD(gc_lock_depth)++;
     MP_STATE_MEM(gc_stack_overflow) = 0;
     gc_collect_end();
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    // nothing is marked, so this frees everything
+    GC_ENTER();
+    gc_sweep_blocks((size_t)-1);
+    GC_EXIT();
+    #endif
 }
 
 void gc_info(gc_info_t *info) {
@@ -701,6 +1052,12 @@ void gc_info(gc_info_t *info) {
         for (size_t block = 0, len = 0, len_free = 0; !finish;) {
             MICROPY_GC_HOOK_LOOP(block);
             size_t kind = ATB_GET_KIND(area, block);
+            #if MICROPY_GC_INCREMENTAL_SWEEP
+            if (kind == AT_MARK) {
+                // not reached by the pending sweep yet
+                kind = AT_HEAD;
+            }
+            #endif
             switch (kind) {
                 case AT_FREE:
                     info->free += 1;
@@ -727,7 +1084,7 @@ void gc_info(gc_info_t *info) {
             finish = (block == area->gc_alloc_table_byte_len * BLOCKS_PER_ATB);
             // Get next block type if possible
             if (!finish) {
-                kind = ATB_GET_KIND(area, block);
+                kind = ATB_IS_HEAD(area, block) ? AT_HEAD : ATB_GET_KIND(area, block);
             }
 
             if (finish || kind == AT_FREE || kind == AT_HEAD) {
@@ -756,9 +1113,65 @@ void gc_info(gc_info_t *info) {
     info->max_new_split = gc_get_max_new_split();
     #endif
 
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    info->last_pause_ms = MP_STATE_MEM(gc_pause_last_ms);
+    info->max_pause_ms = MP_STATE_MEM(gc_pause_max_ms);
+    #endif
+
     GC_EXIT();
 }
 
+// CIRCUITPY-CHANGE
+void gc_run_start(gc_run_t *run) {
+    run->area = &MP_STATE_MEM(area);
+    run->block = 0;
+}
+
+// CIRCUITPY-CHANGE
+bool gc_run_next(gc_run_t *run) {
+    mp_state_mem_area_t *area = run->area;
+    if (area == NULL) {
+        return false;
+    }
+    GC_ENTER();
+    size_t total = area->gc_alloc_table_byte_len * BLOCKS_PER_ATB;
+    size_t block = run->block;
+    run->ptr = (void *)PTR_FROM_BLOCK(area, block);
+    run->area_blocks = total;
+    run->area_start = block == 0;
+    run->has_finaliser = false;
+    if (ATB_GET_KIND(area, block) == AT_FREE) {
+        run->allocated = false;
+        do {
+            block++;
+            // Skip four free blocks at a time where the whole ATB is free.
+            while (block % BLOCKS_PER_ATB == 0 && block < total
+                   && area->gc_alloc_table_start[block / BLOCKS_PER_ATB] == 0) {
+                block += BLOCKS_PER_ATB;
+            }
+        } while (block < total && ATB_GET_KIND(area, block) == AT_FREE);
+    } else {
+        // A head and its tails. The run only starts with a tail when the heap
+        // changed since the last call.
+        run->allocated = true;
+        #if MICROPY_ENABLE_FINALISER
+        run->has_finaliser = ATB_IS_HEAD(area, block) && FTB_GET(area, block);
+        #endif
+        do {
+            block++;
+        } while (block < total && ATB_GET_KIND(area, block) == AT_TAIL);
+    }
+    run->n_blocks = block - run->block;
+    if (block == total) {
+        run->area = NEXT_AREA(area);
+        run->block = 0;
+    } else {
+        run->block = block;
+    }
+    GC_EXIT();
+    return true;
+}
+
 // CIRCUITPY-CHANGE
 bool gc_alloc_possible(void) {
     #if MICROPY_GC_SPLIT_HEAP
@@ -768,6 +1181,159 @@ bool gc_alloc_possible(void) {
     #endif
 }
 
+#if MICROPY_GC_MOVABLE
+typedef struct _gc_movable_entry_t {
+    void *ptr;
+    size_t pins;
+} gc_movable_entry_t;
+
+// Number of slots in the movable buffer table, which is itself on the heap.
+// Takes the GC mutex.
+STATIC size_t gc_movable_table_len(void) {
+    gc_movable_entry_t *table = MP_STATE_VM(gc_movable_table);
+    return table == NULL ? 0 : gc_nbytes(table) / sizeof(gc_movable_entry_t);
+}
+
+// Move the buffer at *ptr_in to the lowest free run below it that can hold
+// it, or else slide it down over the free blocks directly below it.  The GC
+// mutex must be held.
+STATIC bool gc_movable_slide(void **ptr_in) {
+    void *ptr = *ptr_in;
+    mp_state_mem_area_t *area;
+    #if MICROPY_GC_SPLIT_HEAP
+    area = gc_get_ptr_area(ptr);
+    #else
+    area = &MP_STATE_MEM(area);
+    #endif
+    size_t block = BLOCK_FROM_PTR(area, ptr);
+    size_t total_blocks = area->gc_alloc_table_byte_len * BLOCKS_PER_ATB;
+    size_t n_blocks = 1;
+    while (block + n_blocks < total_blocks && ATB_GET_KIND(area, block + n_blocks) == AT_TAIL) {
+        n_blocks++;
+    }
+    size_t dest = block;
+    size_t n_free = 0;
+    for (size_t bl = 0; bl < block; bl++) {
+        MICROPY_GC_HOOK_LOOP(bl);
+        if (ATB_GET_KIND(area, bl) != AT_FREE) {
+            n_free = 0;
+        } else if (++n_free == n_blocks) {
+            dest = bl + 1 - n_blocks;
+            break;
+        }
+    }
+    if (dest == block) {
+        // n_free counts the free blocks that end just below the buffer.
+        dest = block - n_free;
+    }
+    if (dest == block) {
+        return false;
+    }
+    for (size_t bl = block; bl < block + n_blocks; bl++) {
+        ATB_ANY_TO_FREE(area, bl);
+    }
+    ATB_FREE_TO_HEAD(area, dest);
+    for (size_t bl = dest + 1; bl < dest + n_blocks; bl++) {
+        ATB_FREE_TO_TAIL(area, bl);
+    }
+    void *new_ptr = (void *)PTR_FROM_BLOCK(area, dest);
+    memmove(new_ptr, ptr, n_blocks * BYTES_PER_BLOCK);
+    *ptr_in = new_ptr;
+    return true;
+}
+
+// Move every unpinned buffer down, lowest first, so that the free space they
+// leave behind coalesces above them.  Returns whether anything moved.
+STATIC bool gc_movable_compact(void) {
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    if (MP_STATE_MEM(gc_sweep_pending)) {
+        return false;
+    }
+    #endif
+    gc_movable_entry_t *table = MP_STATE_VM(gc_movable_table);
+    size_t len = gc_movable_table_len();
+    GC_ENTER();
+    bool moved = false;
+    void *prev = NULL;
+    for (;;) {
+        gc_movable_entry_t *next = NULL;
+        for (size_t i = 0; i < len; i++) {
+            void *ptr = table[i].ptr;
+            if (ptr != NULL && ptr > prev && (next == NULL || ptr < next->ptr)) {
+                next = &table[i];
+            }
+        }
+        if (next == NULL) {
+            break;
+        }
+        // A buffer only ever moves down, so it won't be picked again.
+        prev = next->ptr;
+        if (next->pins == 0) {
+            moved |= gc_movable_slide(&next->ptr);
+        }
+    }
+    if (moved) {
+        #if MICROPY_GC_SPLIT_HEAP
+        MP_STATE_MEM(gc_last_free_area) = &MP_STATE_MEM(area);
+        #endif
+        #if MICROPY_GC_FREE_RUN_INDEX
+        gc_free_run_rebuild();
+        #endif
+    }
+    GC_EXIT();
+    return moved;
+}
+
+gc_movable_t gc_movable_alloc(size_t n_bytes) {
+    void *ptr = gc_alloc(n_bytes, 0);
+    if (ptr == NULL) {
+        return 0;
+    }
+    gc_movable_entry_t *table = MP_STATE_VM(gc_movable_table);
+    size_t len = gc_movable_table_len();
+    size_t i = 0;
+    while (i < len && table[i].ptr != NULL) {
+        i++;
+    }
+    if (i == len) {
+        // Until it is in the table, ptr is kept alive by the C stack.
+        table = gc_realloc(table, (len + 4) * sizeof(gc_movable_entry_t), true);
+        if (table == NULL) {
+            gc_free(ptr);
+            return 0;
+        }
+        MP_STATE_VM(gc_movable_table) = table;
+        memset(&table[len], 0, (gc_movable_table_len() - len) * sizeof(gc_movable_entry_t));
+    }
+    table[i].ptr = ptr;
+    table[i].pins = 0;
+    return i + 1;
+}
+
+void gc_movable_free(gc_movable_t handle) {
+    gc_movable_entry_t *entry = &MP_STATE_VM(gc_movable_table)[handle - 1];
+    gc_free(entry->ptr);
+    entry->ptr = NULL;
+    entry->pins = 0;
+}
+
+void *gc_movable_get(gc_movable_t handle) {
+    return MP_STATE_VM(gc_movable_table)[handle - 1].ptr;
+}
+
+void *gc_movable_pin(gc_movable_t handle) {
+    gc_movable_entry_t *entry = &MP_STATE_VM(gc_movable_table)[handle - 1];
+    entry->pins++;
+    return entry->ptr;
+}
+
+void gc_movable_unpin(gc_movable_t handle) {
+    MP_STATE_VM(gc_movable_table)[handle - 1].pins--;
+}
+
+MP_REGISTER_ROOT_POINTER(struct _gc_movable_entry_t *gc_movable_table);
+#endif
+
 void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
     bool has_finaliser = alloc_flags & GC_ALLOC_FLAG_HAS_FINALISER;
     size_t n_blocks = ((n_bytes + BYTES_PER_BLOCK - 1) & (~(BYTES_PER_BLOCK - 1))) / BYTES_PER_BLOCK;
@@ -780,6 +1346,10 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
 
     // check if GC is locked
     if (MP_STATE_THREAD(gc_lock_depth) > 0) {
+        // CIRCUITPY-CHANGE
+        #if MICROPY_GC_STATS
+        MP_STATE_MEM(gc_stats_alloc_failures)++;
+        #endif
         return NULL;
     }
 
@@ -794,6 +1364,15 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
     #if MICROPY_GC_SPLIT_HEAP_AUTO
     bool added = false;
     #endif
+    #if MICROPY_GC_MOVABLE
+    bool compacted = false;
+    #endif
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    size_t sweep_blocks = MICROPY_GC_INCREMENTAL_SWEEP_BLOCKS;
+    #endif
+    #if MICROPY_GC_HOT_ALLOC_MAX_BYTES
+    bool want_slow = GC_WANTS_SLOW_AREA(n_blocks);
+    #endif
 
     #if MICROPY_GC_ALLOC_THRESHOLD
     if (!collected && MP_STATE_MEM(gc_alloc_amount) >= MP_STATE_MEM(gc_alloc_threshold)) {
@@ -817,10 +1396,37 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
             reset_into_safe_mode(SAFE_MODE_GC_ALLOC_OUTSIDE_VM);
         }
 
+        #if MICROPY_GC_FREE_RUN_INDEX
+        // large allocations first try a run remembered by the last sweep
+        if (n_blocks >= MICROPY_GC_FREE_RUN_MIN_BLOCKS && gc_free_run_take(n_blocks, &area, &i)) {
+            n_free = n_blocks;
+            goto found;
+        }
+        #endif
+
         // look for a run of n_blocks available blocks
+        #if MICROPY_GC_HOT_ALLOC_MAX_BYTES
+        // The first pass only looks in the preferred kind of area, and the
+        // second pass in the others.
+        mp_state_mem_area_t *first_area = area;
+        for (int pass = 0; pass < 2; pass++) {
+            area = first_area;
+        #endif
         for (; area != NULL; area = NEXT_AREA(area), i = 0) {
+            #if MICROPY_GC_HOT_ALLOC_MAX_BYTES
+            if ((area->gc_slow == want_slow) != (pass == 0)) {
+                continue;
+            }
+            #endif
             n_free = 0;
-            for (i = area->gc_last_free_atb_index; i < area->gc_alloc_table_byte_len; i++) {
+            size_t start_atb = area->gc_last_free_atb_index;
+            #if MICROPY_GC_SMALL_ALLOC_NEXT_FIT
+            if (n_blocks > 1 && n_blocks <= MICROPY_GC_SMALL_ALLOC_NEXT_FIT) {
+                start_atb = MAX(start_atb, area->gc_small_alloc_atb_index);
+            }
+        scan_area:
+            #endif
+            for (i = start_atb; i < area->gc_alloc_table_byte_len; i++) {
                 MICROPY_GC_HOOK_LOOP(i);
                 byte a = area->gc_alloc_table_start[i];
                 // *FORMAT-OFF*
@@ -831,6 +1437,15 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
                 // *FORMAT-ON*
             }
 
+            #if MICROPY_GC_SMALL_ALLOC_NEXT_FIT
+            if (start_atb > area->gc_last_free_atb_index) {
+                // wrap around to the part of the heap skipped by next fit
+                start_atb = area->gc_last_free_atb_index;
+                n_free = 0;
+                goto scan_area;
+            }
+            #endif
+
             // No free blocks found on this heap. Mark this heap as
             // filled, so we won't try to find free space here again until
             // space is freed.
@@ -840,6 +1455,19 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
             }
             #endif
         }
+        #if MICROPY_GC_HOT_ALLOC_MAX_BYTES
+        }
+        #endif
+
+        #if MICROPY_GC_INCREMENTAL_SWEEP
+        if (MP_STATE_MEM(gc_sweep_pending)) {
+            // sweep some more of the garbage left by the last collection,
+            // doubling the amount each time to bound the rescans
+            gc_sweep_blocks(sweep_blocks);
+            sweep_blocks *= 2;
+            continue;
+        }
+        #endif
 
         GC_EXIT();
         // nothing found!
@@ -851,9 +1479,21 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
             }
             #endif
 
+            #if MICROPY_GC_MOVABLE
+            if (!compacted && gc_movable_compact()) {
+                compacted = true;
+                GC_ENTER();
+                continue;
+            }
+            #endif
+
             #if CIRCUITPY_DEBUG
             gc_dump_alloc_table(&mp_plat_print);
             #endif
+            // CIRCUITPY-CHANGE
+            #if MICROPY_GC_STATS
+            MP_STATE_MEM(gc_stats_alloc_failures)++;
+            #endif
             return NULL;
         }
         DEBUG_printf("gc_alloc(" UINT_FMT "): no free mem, triggering GC\n", n_bytes);
@@ -879,6 +1519,11 @@ found:
         #endif
         area->gc_last_free_atb_index = (i + 1) / BLOCKS_PER_ATB;
     }
+    #if MICROPY_GC_SMALL_ALLOC_NEXT_FIT
+    if (n_free > 1 && n_free <= MICROPY_GC_SMALL_ALLOC_NEXT_FIT) {
+        area->gc_small_alloc_atb_index = (i + 1) / BLOCKS_PER_ATB;
+    }
+    #endif
 
     // CIRCUITPY-CHANGE
     #ifdef LOG_HEAP_ACTIVITY
@@ -887,6 +1532,11 @@ found:
 
     area->gc_last_used_block = MAX(area->gc_last_used_block, end_block);
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_STATS
+    MP_STATE_MEM(gc_stats_alloc_blocks) += end_block - start_block + 1;
+    #endif
+
     // mark first block as used head
     ATB_FREE_TO_HEAD(area, start_block);
 
@@ -896,6 +1546,10 @@ found:
         ATB_FREE_TO_TAIL(area, bl);
     }
 
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    gc_sweep_keep(area, start_block, end_block, true);
+    #endif
+
     // get pointer to first block
     // we must create this pointer before unlocking the GC so a collection can find it
     void *ret_ptr = (void *)(area->gc_pool_start + start_block * BYTES_PER_BLOCK);
@@ -937,7 +1591,7 @@ found:
     #endif
 
     #if CIRCUITPY_MEMORYMONITOR
-    memorymonitor_track_allocation(end_block - start_block + 1);
+    memorymonitor_track_allocation(ret_ptr, end_block - start_block + 1);
     #endif
 
     return ret_ptr;
@@ -988,7 +1642,7 @@ void gc_free(void *ptr) {
     #endif
 
     size_t block = BLOCK_FROM_PTR(area, ptr);
-    assert(ATB_GET_KIND(area, block) == AT_HEAD);
+    assert(ATB_IS_HEAD(area, block));
 
     #if MICROPY_ENABLE_FINALISER
     FTB_CLEAR(area, block);
@@ -1048,7 +1702,7 @@ size_t gc_nbytes(const void *ptr) {
 
     if (area) {
         size_t block = BLOCK_FROM_PTR(area, ptr);
-        if (ATB_GET_KIND(area, block) == AT_HEAD) {
+        if (ATB_IS_HEAD(area, block)) {
             // work out number of consecutive blocks in the chain starting with this on
             size_t n_blocks = 0;
             do {
@@ -1123,7 +1777,7 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
     area = &MP_STATE_MEM(area);
     #endif
     size_t block = BLOCK_FROM_PTR(area, ptr);
-    assert(ATB_GET_KIND(area, block) == AT_HEAD);
+    assert(ATB_IS_HEAD(area, block));
 
     // compute number of new blocks that are requested
     size_t new_blocks = (n_bytes + BYTES_PER_BLOCK - 1) / BYTES_PER_BLOCK;
@@ -1191,7 +1845,7 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
         #endif
 
         #if CIRCUITPY_MEMORYMONITOR
-        memorymonitor_track_allocation(new_blocks);
+        memorymonitor_track_allocation(ptr_in, new_blocks);
         #endif
 
         return ptr_in;
@@ -1206,6 +1860,10 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
             ATB_FREE_TO_TAIL(area, bl);
         }
 
+        #if MICROPY_GC_INCREMENTAL_SWEEP
+        gc_sweep_keep(area, block + n_blocks, end_block - 1, false);
+        #endif
+
         area->gc_last_used_block = MAX(area->gc_last_used_block, end_block);
 
         GC_EXIT();
@@ -1228,7 +1886,7 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
         #endif
 
         #if CIRCUITPY_MEMORYMONITOR
-        memorymonitor_track_allocation(new_blocks);
+        memorymonitor_track_allocation(ptr_in, new_blocks);
         #endif
 
         return ptr_in;
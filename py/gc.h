@@ -70,6 +70,14 @@ bool gc_alloc_possible(void);
 // Use this function to sweep the whole heap and run all finalisers
 void gc_sweep_all(void);
 
+#if MICROPY_GC_INCREMENTAL_SWEEP
+// Sweep the next part of the heap left over by the last collection.  Cheap
+// to call when there is nothing left to sweep.
+void gc_sweep_step(void);
+// Finish the sweep left over by the last collection.
+void gc_sweep_finish(void);
+#endif
+
 enum {
     GC_ALLOC_FLAG_HAS_FINALISER = 1,
 };
@@ -90,6 +98,21 @@ bool gc_never_free(void *ptr);
 // of a block.
 bool gc_ptr_on_heap(void *ptr);
 
+#if MICROPY_GC_MOVABLE
+// A handle to a buffer that gc_alloc may move when it runs out of memory.
+// The buffer stays alive until gc_movable_free, so its owner must free it,
+// usually from a finaliser. A pointer from gc_movable_get is only valid until
+// the next allocation; pin the buffer to keep it in place for longer, for
+// example while DMA uses it. 0 is never a valid handle.
+typedef size_t gc_movable_t;
+
+gc_movable_t gc_movable_alloc(size_t n_bytes); // returns 0 if out of memory
+void gc_movable_free(gc_movable_t handle);
+void *gc_movable_get(gc_movable_t handle);
+void *gc_movable_pin(gc_movable_t handle);
+void gc_movable_unpin(gc_movable_t handle);
+#endif
+
 typedef struct _gc_info_t {
     size_t total;
     size_t used;
@@ -101,10 +124,34 @@ typedef struct _gc_info_t {
     #if MICROPY_GC_SPLIT_HEAP_AUTO
     size_t max_new_split;
     #endif
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    size_t last_pause_ms;
+    size_t max_pause_ms;
+    #endif
 } gc_info_t;
 
 void gc_info(gc_info_t *info);
 void gc_dump_info(const mp_print_t *print);
 void gc_dump_alloc_table(const mp_print_t *print);
 
+// CIRCUITPY-CHANGE: walk the heap a run at a time, in address order. Each
+// call to gc_run_next finds the next run of free blocks or the next
+// allocation. The heap is only locked during each call, so the caller may
+// allocate between calls, but then the walk no longer shows a single moment.
+typedef struct _gc_run_t {
+    // Where the walk has got to.
+    mp_state_mem_area_t *area;
+    size_t block;
+    // The run that was found.
+    void *ptr;
+    size_t n_blocks;
+    size_t area_blocks;
+    bool area_start; // this run starts a new area of area_blocks blocks
+    bool allocated;
+    bool has_finaliser;
+} gc_run_t;
+
+void gc_run_start(gc_run_t *run);
+bool gc_run_next(gc_run_t *run);
+
 #endif // MICROPY_INCLUDED_PY_GC_H
@@ -457,12 +457,20 @@ def print_qstr_data(qcfgs, qstrs, translations):
     print('QDEF(MP_QSTRnull, 0, 0, "")')
 
     total_qstr_size = 0
+    hashes = []
     # go through each qstr and print it out
     for order, ident, qstr in sorted(qstrs.values(), key=lambda x: x[0]):
         qbytes = make_bytes(cfg_bytes_len, cfg_bytes_hash, qstr)
         print("QDEF(MP_QSTR_%s, %s)" % (ident, qbytes))
 
         total_qstr_size += len(qstr)
+        hashes.append(compute_hash(bytes_cons(qstr, "utf8"), cfg_bytes_hash))
+
+    # qstr indices (skipping MP_QSTRnull) ordered by hash, for MICROPY_QSTR_SORTED_INDEX
+    print("#ifdef QSORTED")
+    for index in sorted(range(1, len(hashes) + 1), key=lambda i: hashes[i - 1]):
+        print("QSORTED(%d)" % index)
+    print("#endif")
 
     print(
         "// Enumerate translated texts but don't actually include translations. Instead, the linker will link them in."
@@ -83,6 +83,191 @@ STATIC size_t get_hash_alloc_greater_or_equal_to(size_t x) {
     return (x + x / 2) | 1;
 }
 
+// CIRCUITPY-CHANGE: hash index for ordered maps
+STATIC mp_uint_t map_key_hash(mp_obj_t key) {
+    // fast path for common case of qstr
+    if (mp_obj_is_qstr(key)) {
+        return qstr_hash(MP_OBJ_QSTR_VALUE(key));
+    }
+    return MP_OBJ_SMALL_INT_VALUE(mp_unary_op(MP_UNARY_OP_HASH, key));
+}
+
+#if MICROPY_OPT_MAP_ORDERED_INDEX
+// An ordered map that can grow is given a hash index once it has room for
+// MAP_ORDERED_INDEX_MIN entries. The index follows the entries in the same
+// allocation, and each slot holds the position of an entry plus one, or zero
+// if the slot is empty, in the narrowest width that fits. There are at least
+// half again as many slots as entries, so probe sequences stay short and there
+// is always an empty slot to end them. Entries stay in insertion order.
+#define MAP_ORDERED_INDEX_MIN (8)
+
+STATIC size_t ordered_index_slots(size_t alloc) {
+    size_t n = MAP_ORDERED_INDEX_MIN;
+    while (n < alloc + alloc / 2) {
+        n <<= 1;
+    }
+    return n;
+}
+
+STATIC size_t ordered_index_width(size_t alloc) {
+    return alloc < 0xff ? 1 : alloc < 0xffff ? 2 : 4;
+}
+
+STATIC size_t map_table_bytes(size_t alloc, bool has_index) {
+    size_t n = alloc * sizeof(mp_map_elem_t);
+    if (has_index) {
+        n += ordered_index_slots(alloc) * ordered_index_width(alloc);
+    }
+    return n;
+}
+
+STATIC size_t ordered_index_get(const mp_map_t *map, size_t slot) {
+    const void *index = &map->table[map->alloc];
+    switch (ordered_index_width(map->alloc)) {
+        case 1:
+            return ((const uint8_t *)index)[slot];
+        case 2:
+            return ((const uint16_t *)index)[slot];
+        default:
+            return ((const uint32_t *)index)[slot];
+    }
+}
+
+STATIC void ordered_index_set(mp_map_t *map, size_t slot, size_t value) {
+    void *index = &map->table[map->alloc];
+    switch (ordered_index_width(map->alloc)) {
+        case 1:
+            ((uint8_t *)index)[slot] = value;
+            break;
+        case 2:
+            ((uint16_t *)index)[slot] = value;
+            break;
+        default:
+            ((uint32_t *)index)[slot] = value;
+            break;
+    }
+}
+
+STATIC void ordered_index_insert(mp_map_t *map, mp_uint_t hash, size_t pos) {
+    size_t mask = ordered_index_slots(map->alloc) - 1;
+    size_t slot = hash & mask;
+    while (ordered_index_get(map, slot) != 0) {
+        slot = (slot + 1) & mask;
+    }
+    ordered_index_set(map, slot, pos + 1);
+}
+
+// Removes the slot for the entry at pos, before the entries after it are moved down.
+STATIC void ordered_index_remove(mp_map_t *map, size_t slot, size_t pos) {
+    size_t n_slots = ordered_index_slots(map->alloc);
+    size_t mask = n_slots - 1;
+    // Move later slots of the probe sequence back into the hole where they are
+    // still reachable from their home slot, so no deleted markers are needed.
+    size_t hole = slot;
+    for (size_t i = (slot + 1) & mask;; i = (i + 1) & mask) {
+        size_t value = ordered_index_get(map, i);
+        if (value == 0) {
+            break;
+        }
+        size_t home = map_key_hash(map->table[value - 1].key) & mask;
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            ordered_index_set(map, hole, value);
+            hole = i;
+        }
+    }
+    ordered_index_set(map, hole, 0);
+    if (pos + 1 < map->used) {
+        for (size_t i = 0; i < n_slots; i++) {
+            size_t value = ordered_index_get(map, i);
+            if (value > pos + 1) {
+                ordered_index_set(map, i, value - 1);
+            }
+        }
+    }
+}
+
+// Appends a new entry, growing the table when it is full and adding the index
+// when the table is big enough. Growth is by a quarter once indexed, so that
+// the index isn't rebuilt every few additions.
+STATIC mp_map_elem_t *ordered_append(mp_map_t *map, mp_obj_t index, mp_uint_t hash) {
+    size_t new_alloc = map->alloc;
+    if (map->used == new_alloc) {
+        new_alloc += MAX(4, new_alloc >= MAP_ORDERED_INDEX_MIN ? new_alloc / 4 : 0);
+    }
+    bool has_index = new_alloc >= MAP_ORDERED_INDEX_MIN;
+    if (new_alloc != map->alloc || has_index != map->has_index) {
+        size_t old_bytes = map_table_bytes(map->alloc, map->has_index);
+        size_t new_bytes = map_table_bytes(new_alloc, has_index);
+        mp_map_elem_t *table;
+        if (new_alloc == map->alloc) {
+            // Only adding the index, e.g. to a copy, which isn't worth failing over.
+            table = (mp_map_elem_t *)m_renew_maybe(uint8_t, map->table, old_bytes, new_bytes, true);
+            if (table == NULL) {
+                has_index = false;
+            }
+        } else {
+            table = (mp_map_elem_t *)m_renew(uint8_t, map->table, old_bytes, new_bytes);
+            mp_seq_clear(table, map->used, new_alloc, sizeof(*table));
+        }
+        if (table != NULL) {
+            map->table = table;
+            map->alloc = new_alloc;
+            map->has_index = 0;
+            if (has_index) {
+                memset(&table[new_alloc], 0, new_bytes - new_alloc * sizeof(*table));
+                for (size_t i = 0; i < map->used; i++) {
+                    ordered_index_insert(map, map_key_hash(table[i].key), i);
+                }
+                map->has_index = 1;
+            }
+        }
+    }
+    size_t pos = map->used++;
+    if (map->has_index) {
+        ordered_index_insert(map, hash, pos);
+    }
+    mp_map_elem_t *elem = &map->table[pos];
+    elem->key = index;
+    elem->value = MP_OBJ_NULL;
+    if (!mp_obj_is_qstr(index)) {
+        map->all_keys_are_qstrs = 0;
+    }
+    return elem;
+}
+
+STATIC mp_map_elem_t *ordered_index_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t lookup_kind, bool compare_only_ptrs) {
+    mp_uint_t hash = map_key_hash(index);
+    size_t mask = ordered_index_slots(map->alloc) - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        size_t value = ordered_index_get(map, slot);
+        if (value == 0) {
+            break;
+        }
+        mp_map_elem_t *elem = &map->table[value - 1];
+        if (elem->key == index || (!compare_only_ptrs && mp_obj_equal(elem->key, index))) {
+            if (MP_UNLIKELY(lookup_kind == MP_MAP_LOOKUP_REMOVE_IF_FOUND)) {
+                // as for the linear search below
+                ordered_index_remove(map, slot, value - 1);
+                mp_obj_t elem_value = elem->value;
+                mp_map_elem_t *top = &map->table[map->used--];
+                memmove(elem, elem + 1, (top - elem - 1) * sizeof(*elem));
+                elem = &map->table[map->used];
+                elem->key = MP_OBJ_NULL;
+                elem->value = elem_value;
+            }
+            MAP_CACHE_SET(index, elem - map->table);
+            return elem;
+        }
+    }
+    if (lookup_kind != MP_MAP_LOOKUP_ADD_IF_NOT_FOUND) {
+        return NULL;
+    }
+    return ordered_append(map, index, hash);
+}
+#else
+#define map_table_bytes(alloc, has_index) ((alloc) * sizeof(mp_map_elem_t))
+#endif
+
 /******************************************************************************/
 /* map                                                                        */
 
@@ -98,6 +283,8 @@ void mp_map_init(mp_map_t *map, size_t n) {
     map->all_keys_are_qstrs = 1;
     map->is_fixed = 0;
     map->is_ordered = 0;
+    // CIRCUITPY-CHANGE: hash index for ordered maps
+    map->has_index = 0;
 }
 
 void mp_map_init_fixed_table(mp_map_t *map, size_t n, const mp_obj_t *table) {
@@ -106,31 +293,38 @@ void mp_map_init_fixed_table(mp_map_t *map, size_t n, const mp_obj_t *table) {
     map->all_keys_are_qstrs = 1;
     map->is_fixed = 1;
     map->is_ordered = 1;
+    // CIRCUITPY-CHANGE: hash index for ordered maps
+    map->has_index = 0;
     map->table = (mp_map_elem_t *)table;
 }
 
 // Differentiate from mp_map_clear() - semantics is different
 void mp_map_deinit(mp_map_t *map) {
     if (!map->is_fixed) {
-        m_del(mp_map_elem_t, map->table, map->alloc);
+        // CIRCUITPY-CHANGE: hash index for ordered maps
+        m_del(uint8_t, map->table, map_table_bytes(map->alloc, map->has_index));
     }
     map->used = map->alloc = 0;
+    map->has_index = 0;
 }
 
 void mp_map_clear(mp_map_t *map) {
     if (!map->is_fixed) {
-        m_del(mp_map_elem_t, map->table, map->alloc);
+        // CIRCUITPY-CHANGE: hash index for ordered maps
+        m_del(uint8_t, map->table, map_table_bytes(map->alloc, map->has_index));
     }
     map->alloc = 0;
     map->used = 0;
     map->all_keys_are_qstrs = 1;
     map->is_fixed = 0;
+    map->has_index = 0;
     map->table = NULL;
 }
 
-STATIC void mp_map_rehash(mp_map_t *map) {
+// CIRCUITPY-CHANGE: rehash to a given size, for mp_map_reserve
+STATIC void mp_map_rehash(mp_map_t *map, size_t min_alloc) {
     size_t old_alloc = map->alloc;
-    size_t new_alloc = get_hash_alloc_greater_or_equal_to(map->alloc + 1);
+    size_t new_alloc = get_hash_alloc_greater_or_equal_to(min_alloc);
     DEBUG_printf("mp_map_rehash(%p): " UINT_FMT " -> " UINT_FMT "\n", map, old_alloc, new_alloc);
     mp_map_elem_t *old_table = map->table;
     mp_map_elem_t *new_table = m_new0(mp_map_elem_t, new_alloc);
@@ -147,6 +341,14 @@ STATIC void mp_map_rehash(mp_map_t *map) {
     m_del(mp_map_elem_t, old_table, old_alloc);
 }
 
+// CIRCUITPY-CHANGE
+// Makes room in a hash map for n entries in all, so that adding them needn't rehash.
+void mp_map_reserve(mp_map_t *map, size_t n) {
+    if (!map->is_fixed && !map->is_ordered && map->alloc < n) {
+        mp_map_rehash(map, n);
+    }
+}
+
 // MP_MAP_LOOKUP behaviour:
 //  - returns NULL if not found, else the slot it was found in with key,value non-null
 // MP_MAP_LOOKUP_ADD_IF_NOT_FOUND behaviour:
@@ -190,6 +392,13 @@ mp_map_elem_t *MICROPY_WRAP_MP_MAP_LOOKUP(mp_map_lookup)(mp_map_t * map, mp_obj_
 
     // if the map is an ordered array then we must do a brute force linear search
     if (map->is_ordered) {
+        // CIRCUITPY-CHANGE: hash index for ordered maps
+        #if MICROPY_OPT_MAP_ORDERED_INDEX
+        // unless it has a hash index
+        if (map->has_index) {
+            return ordered_index_lookup(map, index, lookup_kind, compare_only_ptrs);
+        }
+        #endif
         for (mp_map_elem_t *elem = &map->table[0], *top = &map->table[map->used]; elem < top; elem++) {
             if (elem->key == index || (!compare_only_ptrs && mp_obj_equal(elem->key, index))) {
                 #if MICROPY_PY_COLLECTIONS_ORDEREDDICT
@@ -213,6 +422,12 @@ mp_map_elem_t *MICROPY_WRAP_MP_MAP_LOOKUP(mp_map_lookup)(mp_map_t * map, mp_obj_
         if (MP_LIKELY(lookup_kind != MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)) {
             return NULL;
         }
+        // CIRCUITPY-CHANGE: hash index for ordered maps
+        #if MICROPY_OPT_MAP_ORDERED_INDEX
+        // Keys are hashed even before there is an index, so that unhashable
+        // keys are refused as they are by dict, and the index can be built later.
+        return ordered_append(map, index, map_key_hash(index));
+        #else
         if (map->used == map->alloc) {
             // TODO: Alloc policy
             map->alloc += 4;
@@ -226,6 +441,7 @@ mp_map_elem_t *MICROPY_WRAP_MP_MAP_LOOKUP(mp_map_lookup)(mp_map_t * map, mp_obj_
             map->all_keys_are_qstrs = 0;
         }
         return elem;
+        #endif
         #else
         return NULL;
         #endif
@@ -235,19 +451,14 @@ mp_map_elem_t *MICROPY_WRAP_MP_MAP_LOOKUP(mp_map_lookup)(mp_map_t * map, mp_obj_
 
     if (map->alloc == 0) {
         if (lookup_kind == MP_MAP_LOOKUP_ADD_IF_NOT_FOUND) {
-            mp_map_rehash(map);
+            mp_map_rehash(map, map->alloc + 1);
         } else {
             return NULL;
         }
     }
 
-    // get hash of index, with fast path for common case of qstr
-    mp_uint_t hash;
-    if (mp_obj_is_qstr(index)) {
-        hash = qstr_hash(MP_OBJ_QSTR_VALUE(index));
-    } else {
-        hash = MP_OBJ_SMALL_INT_VALUE(mp_unary_op(MP_UNARY_OP_HASH, index));
-    }
+    // CIRCUITPY-CHANGE: hash index for ordered maps
+    mp_uint_t hash = map_key_hash(index);
 
     size_t pos = hash % map->alloc;
     size_t start_pos = pos;
@@ -310,7 +521,7 @@ mp_map_elem_t *MICROPY_WRAP_MP_MAP_LOOKUP(mp_map_lookup)(mp_map_t * map, mp_obj_
                     return avail_slot;
                 } else {
                     // not enough room in table, rehash it
-                    mp_map_rehash(map);
+                    mp_map_rehash(map, map->alloc + 1);
                     // restart the search for the new element
                     start_pos = pos = hash % map->alloc;
                 }
@@ -33,6 +33,10 @@
 // collect(): run a garbage collection
 STATIC mp_obj_t py_gc_collect(void) {
     gc_collect();
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    // an explicit collection runs all finalisers before returning
+    gc_sweep_finish();
+    #endif
     #if MICROPY_PY_GC_COLLECT_RETVAL
     return MP_OBJ_NEW_SMALL_INT(MP_STATE_MEM(gc_collected));
     #else
@@ -100,6 +104,30 @@ STATIC mp_obj_t gc_threshold(size_t n_args, const mp_obj_t *args) {
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(gc_threshold_obj, 0, 1, gc_threshold);
 #endif
 
+// CIRCUITPY-CHANGE
+#if MICROPY_GC_STATS
+// stats(): return counters that run from heap setup, so that sampling them
+// twice gives the collection rate, pause time and allocation rate between
+STATIC mp_obj_t gc_stats(void) {
+    static const qstr fields[] = {
+        MP_QSTR_collections,
+        MP_QSTR_pause_us,
+        MP_QSTR_max_pause_us,
+        MP_QSTR_allocated_bytes,
+        MP_QSTR_failed_allocs,
+    };
+    mp_obj_t items[] = {
+        mp_obj_new_int_from_uint(MP_STATE_MEM(gc_stats_collections)),
+        mp_obj_new_int_from_ull(MP_STATE_MEM(gc_stats_pause_total_us)),
+        mp_obj_new_int_from_uint(MP_STATE_MEM(gc_stats_pause_max_us)),
+        mp_obj_new_int_from_ull((uint64_t)MP_STATE_MEM(gc_stats_alloc_blocks) * MICROPY_BYTES_PER_GC_BLOCK),
+        mp_obj_new_int_from_uint(MP_STATE_MEM(gc_stats_alloc_failures)),
+    };
+    return mp_obj_new_attrtuple(fields, MP_ARRAY_SIZE(fields), items);
+}
+MP_DEFINE_CONST_FUN_OBJ_0(gc_stats_obj, gc_stats);
+#endif
+
 STATIC const mp_rom_map_elem_t mp_module_gc_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_gc) },
     { MP_ROM_QSTR(MP_QSTR_collect), MP_ROM_PTR(&gc_collect_obj) },
@@ -108,6 +136,10 @@ STATIC const mp_rom_map_elem_t mp_module_gc_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_isenabled), MP_ROM_PTR(&gc_isenabled_obj) },
     { MP_ROM_QSTR(MP_QSTR_mem_free), MP_ROM_PTR(&gc_mem_free_obj) },
     { MP_ROM_QSTR(MP_QSTR_mem_alloc), MP_ROM_PTR(&gc_mem_alloc_obj) },
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_STATS
+    { MP_ROM_QSTR(MP_QSTR_stats), MP_ROM_PTR(&gc_stats_obj) },
+    #endif
     #if MICROPY_GC_ALLOC_THRESHOLD
     { MP_ROM_QSTR(MP_QSTR_threshold), MP_ROM_PTR(&gc_threshold_obj) },
     #endif
@@ -25,7 +25,11 @@
  */
 
 #include <stdio.h>
+// CIRCUITPY-CHANGE
+#include <string.h>
 
+// CIRCUITPY-CHANGE
+#include "py/bc.h"
 #include "py/builtin.h"
 #include "py/stackctrl.h"
 #include "py/runtime.h"
@@ -157,6 +161,34 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(mp_micropython_kbd_intr_obj, mp_micropython_kbd
 #endif
 
 #if MICROPY_ENABLE_SCHEDULER
+// CIRCUITPY-CHANGE
+#if MICROPY_SCHEDULER_PRIORITY
+// schedule(function, arg, *, high_priority=False, coalesce=False)
+STATIC mp_obj_t mp_micropython_schedule(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_function, ARG_arg, ARG_high_priority, ARG_coalesce };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_function, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_arg, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_high_priority, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+        { MP_QSTR_coalesce, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    unsigned int flags = 0;
+    if (args[ARG_high_priority].u_bool) {
+        flags |= MP_SCHED_HIGH_PRIORITY;
+    }
+    if (args[ARG_coalesce].u_bool) {
+        flags |= MP_SCHED_COALESCE;
+    }
+    if (!mp_sched_schedule_ex(args[ARG_function].u_obj, args[ARG_arg].u_obj, flags)) {
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("schedule queue full"));
+    }
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(mp_micropython_schedule_obj, 2, mp_micropython_schedule);
+#else
 STATIC mp_obj_t mp_micropython_schedule(mp_obj_t function, mp_obj_t arg) {
     if (!mp_sched_schedule(function, arg)) {
         mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("schedule queue full"));
@@ -165,6 +197,39 @@ STATIC mp_obj_t mp_micropython_schedule(mp_obj_t function, mp_obj_t arg) {
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(mp_micropython_schedule_obj, mp_micropython_schedule);
 #endif
+#endif
+
+// CIRCUITPY-CHANGE
+#if MICROPY_VM_OPCODE_STATS
+// Returns (opcodes, pairs, pairs_dropped) where opcodes maps each dispatched
+// opcode to its count and pairs maps (previous, opcode) to its count.
+STATIC mp_obj_t mp_micropython_opcode_stats(size_t n_args, const mp_obj_t *args) {
+    mp_opcode_stats_t *stats = &mp_opcode_stats;
+    mp_obj_t opcodes = mp_obj_new_dict(0);
+    for (size_t i = 0; i < MP_ARRAY_SIZE(stats->opcodes); i++) {
+        if (stats->opcodes[i] != 0) {
+            mp_obj_dict_store(opcodes, MP_OBJ_NEW_SMALL_INT(i), mp_obj_new_int_from_uint(stats->opcodes[i]));
+        }
+    }
+    mp_obj_t pairs = mp_obj_new_dict(0);
+    for (size_t i = 0; i < MICROPY_VM_OPCODE_STATS_PAIRS; i++) {
+        const mp_opcode_pair_count_t *entry = &stats->pairs[i];
+        if (entry->key != 0) {
+            mp_obj_t pair[] = {
+                MP_OBJ_NEW_SMALL_INT((entry->key - 1) >> 8),
+                MP_OBJ_NEW_SMALL_INT((entry->key - 1) & 0xff),
+            };
+            mp_obj_dict_store(pairs, mp_obj_new_tuple(2, pair), mp_obj_new_int_from_uint(entry->count));
+        }
+    }
+    mp_obj_t result[] = { opcodes, pairs, mp_obj_new_int_from_uint(stats->pairs_dropped) };
+    if (n_args == 1 && mp_obj_is_true(args[0])) {
+        memset(stats, 0, sizeof(*stats));
+    }
+    return mp_obj_new_tuple(MP_ARRAY_SIZE(result), result);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_opcode_stats_obj, 0, 1, mp_micropython_opcode_stats);
+#endif
 
 STATIC const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_micropython) },
@@ -203,6 +268,10 @@ STATIC const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
     #if MICROPY_ENABLE_SCHEDULER
     { MP_ROM_QSTR(MP_QSTR_schedule), MP_ROM_PTR(&mp_micropython_schedule_obj) },
     #endif
+    // CIRCUITPY-CHANGE
+    #if MICROPY_VM_OPCODE_STATS
+    { MP_ROM_QSTR(MP_QSTR_opcode_stats), MP_ROM_PTR(&mp_micropython_opcode_stats_obj) },
+    #endif
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_micropython_globals, mp_module_micropython_globals_table);
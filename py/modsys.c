@@ -214,6 +214,11 @@ MP_DEFINE_CONST_FUN_OBJ_1(mp_sys_settrace_obj, mp_sys_settrace);
 #error "MICROPY_PY_SYS_ATTR_DELEGATION requires MICROPY_MODULE_ATTR_DELEGATION"
 #endif
 
+// CIRCUITPY-CHANGE
+#if MICROPY_STATE_PER_THREAD && !MICROPY_PY_SYS_ATTR_DELEGATION
+#error "MICROPY_STATE_PER_THREAD requires MICROPY_PY_SYS_ATTR_DELEGATION"
+#endif
+
 #if MICROPY_PY_SYS_ATTR_DELEGATION
 // Must be kept in sync with the enum at the top of mpstate.h.
 STATIC const uint16_t sys_mutable_keys[] = {
@@ -235,6 +240,24 @@ STATIC const uint16_t sys_mutable_keys[] = {
 void mp_module_sys_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
     MP_STATIC_ASSERT(MP_ARRAY_SIZE(sys_mutable_keys) == MP_SYS_MUTABLE_NUM + 1);
     MP_STATIC_ASSERT(MP_ARRAY_SIZE(MP_STATE_VM(sys_mutable)) == MP_SYS_MUTABLE_NUM);
+    // CIRCUITPY-CHANGE: these can't be in the const globals table when every
+    // thread has its own VM state.
+    #if MICROPY_STATE_PER_THREAD
+    if (dest[0] == MP_OBJ_NULL) {
+        #if MICROPY_PY_SYS_ARGV
+        if (attr == MP_QSTR_argv) {
+            dest[0] = MP_OBJ_FROM_PTR(&MP_STATE_VM(mp_sys_argv_obj));
+            return;
+        }
+        #endif
+        #if MICROPY_PY_SYS_MODULES
+        if (attr == MP_QSTR_modules) {
+            dest[0] = MP_OBJ_FROM_PTR(&MP_STATE_VM(mp_loaded_modules_dict));
+            return;
+        }
+        #endif
+    }
+    #endif
     mp_module_generic_attr(attr, dest, sys_mutable_keys, MP_STATE_VM(sys_mutable));
 }
 #endif
@@ -242,7 +265,8 @@ void mp_module_sys_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
 STATIC const mp_rom_map_elem_t mp_module_sys_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_sys) },
 
-    #if MICROPY_PY_SYS_ARGV
+    // CIRCUITPY-CHANGE: with a VM per thread, argv is found by mp_module_sys_attr().
+    #if MICROPY_PY_SYS_ARGV && !MICROPY_STATE_PER_THREAD
     { MP_ROM_QSTR(MP_QSTR_argv), MP_ROM_PTR(&MP_STATE_VM(mp_sys_argv_obj)) },
     #endif
     { MP_ROM_QSTR(MP_QSTR_version), MP_ROM_PTR(&mp_sys_version_obj) },
@@ -284,7 +308,8 @@ STATIC const mp_rom_map_elem_t mp_module_sys_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_stderr), MP_ROM_PTR(&mp_sys_stderr_obj) },
     #endif
 
-    #if MICROPY_PY_SYS_MODULES
+    // CIRCUITPY-CHANGE: with a VM per thread, modules is found by mp_module_sys_attr().
+    #if MICROPY_PY_SYS_MODULES && !MICROPY_STATE_PER_THREAD
     { MP_ROM_QSTR(MP_QSTR_modules), MP_ROM_PTR(&MP_STATE_VM(mp_loaded_modules_dict)) },
     #endif
     #if MICROPY_PY_SYS_EXC_INFO
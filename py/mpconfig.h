@@ -195,6 +195,15 @@
 #define MICROPY_GC_ALLOC_THRESHOLD (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
 #endif
 
+// CIRCUITPY-CHANGE
+// When a vstr has to grow, grow it by at least 1/MICROPY_VSTR_GROWTH_DIVISOR
+// of its current allocation, so appending many small pieces takes amortized
+// linear time. The result is trimmed when the vstr becomes a str or bytes.
+// Set to 0 to grow only by what is needed.
+#ifndef MICROPY_VSTR_GROWTH_DIVISOR
+#define MICROPY_VSTR_GROWTH_DIVISOR (2)
+#endif
+
 // Number of bytes to allocate initially when creating new chunks to store
 // interned string data.  Smaller numbers lead to more chunks being needed
 // and more wastage at the end of the chunk.  Larger numbers lead to wasted
@@ -292,6 +301,19 @@
 #endif
 #endif
 
+// Whether qstr_find_strn binary searches the ROM qstr pool using an index,
+// sorted by hash, that is generated at build time (costs 2 bytes of ROM per
+// qstr)
+#ifndef MICROPY_QSTR_SORTED_INDEX
+#define MICROPY_QSTR_SORTED_INDEX (0)
+#endif
+
+// Whether dynamically allocated qstr pools carry an open-addressing hash
+// index for qstr_find_strn (costs 4 bytes of RAM per pool entry)
+#ifndef MICROPY_QSTR_HASH_INDEX
+#define MICROPY_QSTR_HASH_INDEX (0)
+#endif
+
 // Avoid using C stack when making Python function calls. C stack still
 // may be used if there's no free heap.
 #ifndef MICROPY_STACKLESS
@@ -323,6 +345,19 @@
 #define MICROPY_PERSISTENT_CODE_LOAD (0)
 #endif
 
+// Whether loading persistent code from read-only, memory-mapped storage
+// references bytecode, qstr data and str/bytes constants in place instead of
+// copying them to the heap.  The storage must not change while the code runs.
+#ifndef MICROPY_PERSISTENT_CODE_LOAD_XIP
+#define MICROPY_PERSISTENT_CODE_LOAD_XIP (0)
+#endif
+
+// Whether files on memory-mapped block devices can report the address of their
+// contents through the MP_STREAM_GET_XIP_ADDR stream ioctl.
+#ifndef MICROPY_VFS_XIP
+#define MICROPY_VFS_XIP (MICROPY_PERSISTENT_CODE_LOAD_XIP)
+#endif
+
 // Whether to support saving of persistent code, i.e. for mpy-cross to
 // generate .mpy files. Enabling this enables additional metadata on raw code
 // objects which is also required for sys.settrace.
@@ -399,8 +434,14 @@
 #define MICROPY_EMIT_XTENSAWIN (0)
 #endif
 
+// CIRCUITPY-CHANGE: RV32 native emitter
+// Whether to emit RISC-V RV32IMC native code
+#ifndef MICROPY_EMIT_RV32
+#define MICROPY_EMIT_RV32 (0)
+#endif
+
 // Convenience definition for whether any native emitter is enabled
-#define MICROPY_EMIT_NATIVE (MICROPY_EMIT_X64 || MICROPY_EMIT_X86 || MICROPY_EMIT_THUMB || MICROPY_EMIT_ARM || MICROPY_EMIT_XTENSA || MICROPY_EMIT_XTENSAWIN)
+#define MICROPY_EMIT_NATIVE (MICROPY_EMIT_X64 || MICROPY_EMIT_X86 || MICROPY_EMIT_THUMB || MICROPY_EMIT_ARM || MICROPY_EMIT_XTENSA || MICROPY_EMIT_XTENSAWIN || MICROPY_EMIT_RV32)
 
 // Some architectures cannot read byte-wise from executable memory.  In this case
 // the prelude for a native function (which usually sits after the machine code)
@@ -433,6 +474,15 @@
 #define MICROPY_ENABLE_COMPILER (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether imported source modules are parsed, compiled and run one top-level
+// statement at a time. Peak memory then depends on the largest statement
+// rather than on the whole file. The catch is that a syntax error is only
+// reported once all the statements before it have run.
+#ifndef MICROPY_COMPILE_BY_STATEMENT
+#define MICROPY_COMPILE_BY_STATEMENT (0)
+#endif
+
 // Whether the compiler is dynamically configurable (ie at runtime)
 // This will disable the ability to execute native/viper code
 #ifndef MICROPY_DYNAMIC_COMPILER
@@ -465,6 +515,13 @@
 #define MICROPY_COMP_CONST (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether the parser can fold const() values imported from other modules and
+// strip unused private definitions, as mpy-cross does when asked to
+#ifndef MICROPY_COMP_CROSS_MODULE
+#define MICROPY_COMP_CROSS_MODULE (0)
+#endif
+
 // Whether to enable optimisation of: a, b = c, d
 // Costs 124 bytes (Thumb2)
 #ifndef MICROPY_COMP_DOUBLE_TUPLE_ASSIGN
@@ -540,6 +597,21 @@
 #define MICROPY_OPT_COMPUTED_GOTO (0)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether to count how often each opcode, and each pair of consecutive opcodes,
+// is dispatched. Read the counts with micropython.opcode_stats(). Slows the VM
+// down a lot, so only for builds that collect statistics.
+#ifndef MICROPY_VM_OPCODE_STATS
+#define MICROPY_VM_OPCODE_STATS (0)
+#endif
+
+// CIRCUITPY-CHANGE
+// Number of distinct opcode pairs that MICROPY_VM_OPCODE_STATS can count.
+// Each takes 8 bytes.
+#ifndef MICROPY_VM_OPCODE_STATS_PAIRS
+#define MICROPY_VM_OPCODE_STATS_PAIRS (1024)
+#endif
+
 // CIRCUITPY-CHANGE
 // Whether to save trade flash space for speed in MICROPY_OPT_COMPUTED_GOTO.
 // Costs about 3% speed, saves about 1500 bytes space.  In addition to the assumptions
@@ -555,6 +627,28 @@
 #define MICROPY_OPT_LOAD_ATTR_FAST_PATH (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
 
+// Whether the bytecode compiler fuses common sequences on a local and a small
+// int, such as "i += 1" and "i < 10", into single opcodes that the VM
+// executes with one dispatch.  Bytecode using them only runs on a VM built
+// with this option, so it also changes MPY_VERSION; mpy-cross must be built
+// with the same setting to emit them.  Older .mpy files still load.
+#ifndef MICROPY_OPT_FUSED_OPCODES
+#define MICROPY_OPT_FUSED_OPCODES (0)
+#endif
+
+// Cache, per LOAD_GLOBAL/LOAD_ATTR/LOAD_METHOD instruction, the map slot where
+// the name was last found so repeated lookups in loops skip mp_map_lookup.
+// Entries are checked against the live map on every use.  Costs RAM for
+// MICROPY_OPT_LOAD_ATTR_INLINE_CACHE_SIZE entries of three words each.
+#ifndef MICROPY_OPT_LOAD_ATTR_INLINE_CACHE
+#define MICROPY_OPT_LOAD_ATTR_INLINE_CACHE (0)
+#endif
+
+// Number of inline cache entries; should be a power of two.
+#ifndef MICROPY_OPT_LOAD_ATTR_INLINE_CACHE_SIZE
+#define MICROPY_OPT_LOAD_ATTR_INLINE_CACHE_SIZE (64)
+#endif
+
 // Use extra RAM to cache map lookups by remembering the likely location of
 // the index. Avoids the hash computation on unordered maps, and avoids the
 // linear search on ordered (especially in-ROM) maps. Can provide a +10-15%
@@ -569,12 +663,27 @@
 #define MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE (128)
 #endif
 
+// CIRCUITPY-CHANGE: hash index for ordered maps
+// Whether ordered maps that can grow (i.e. OrderedDict) keep a hash index
+// after their entries once they have a few, so that lookups don't have to
+// scan every entry. Costs one to four bytes per index slot.
+#ifndef MICROPY_OPT_MAP_ORDERED_INDEX
+#define MICROPY_OPT_MAP_ORDERED_INDEX (MICROPY_PY_COLLECTIONS_ORDEREDDICT)
+#endif
+
 // Whether to use fast versions of bitwise operations (and, or, xor) when the
 // arguments are both positive.  Increases Thumb2 code size by about 250 bytes.
 #ifndef MICROPY_OPT_MPZ_BITWISE
 #define MICROPY_OPT_MPZ_BITWISE (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether to do long-int arithmetic in 64 bits when both arguments and the
+// result fit, and to store such values inline in a single heap block.
+#ifndef MICROPY_OPT_MPZ_INT64
+#define MICROPY_OPT_MPZ_INT64 (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
 
 // Whether math.factorial is large, fast and recursive (1) or small and slow (0).
 #ifndef MICROPY_OPT_MATH_FACTORIAL
@@ -649,6 +758,67 @@
 #define MICROPY_GC_SPLIT_HEAP_AUTO (0)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether the GC counts collections, pause time, allocated blocks and failed
+// allocations, for benchmarking and gc.stats().
+#ifndef MICROPY_GC_STATS
+#define MICROPY_GC_STATS (0)
+#endif
+
+// Microsecond clock used to time collections when MICROPY_GC_STATS is enabled.
+#ifndef MICROPY_GC_STATS_TICKS_US
+#define MICROPY_GC_STATS_TICKS_US() mp_hal_ticks_us()
+#endif
+
+// Number of large free runs each heap area remembers after a sweep, so that
+// big allocations can be placed without a linear scan of the allocation
+// table.  Set to 0 to disable the index.
+#ifndef MICROPY_GC_FREE_RUN_INDEX
+#define MICROPY_GC_FREE_RUN_INDEX (0)
+#endif
+
+// Smallest allocation, in blocks, that consults the free run index first.
+#ifndef MICROPY_GC_FREE_RUN_MIN_BLOCKS
+#define MICROPY_GC_FREE_RUN_MIN_BLOCKS (16)
+#endif
+
+// Allocations of more than one and up to this many blocks carry on searching
+// from where the previous such allocation ended instead of from the first
+// free block, so that short-lived small objects don't keep rescanning the
+// fragmented start of the heap.  Set to 0 to disable.
+#ifndef MICROPY_GC_SMALL_ALLOC_NEXT_FIT
+#define MICROPY_GC_SMALL_ALLOC_NEXT_FIT (0)
+#endif
+
+// Heap areas for which MP_PLAT_HEAP_IS_SLOW() is true, such as areas in
+// PSRAM, are passed over by allocations of up to this many bytes while a fast
+// area has room, because small objects such as bound methods and frames are
+// the most frequently accessed.  Larger allocations look in slow areas first,
+// leaving fast memory for the small objects.  Set to 0 to disable.
+#ifndef MICROPY_GC_HOT_ALLOC_MAX_BYTES
+#define MICROPY_GC_HOT_ALLOC_MAX_BYTES (0)
+#endif
+
+// Whether gc_collect_end leaves the sweep to be finished in steps of
+// MICROPY_GC_INCREMENTAL_SWEEP_BLOCKS blocks, by gc_sweep_step() or by
+// gc_alloc when it runs out of free blocks.  This bounds the pause of an
+// automatic collection to the mark phase plus a short sweep.
+#ifndef MICROPY_GC_INCREMENTAL_SWEEP
+#define MICROPY_GC_INCREMENTAL_SWEEP (0)
+#endif
+
+// Number of blocks swept by each incremental sweep step.
+#ifndef MICROPY_GC_INCREMENTAL_SWEEP_BLOCKS
+#define MICROPY_GC_INCREMENTAL_SWEEP_BLOCKS (1024)
+#endif
+
+// Whether to support movable buffers (see gc_movable_alloc), which gc_alloc
+// slides down into free blocks below them when it would otherwise fail, so
+// that long-lived large buffers don't leave the heap fragmented.
+#ifndef MICROPY_GC_MOVABLE
+#define MICROPY_GC_MOVABLE (0)
+#endif
+
 // Hook to run code during time consuming garbage collector operations
 // *i* is the loop index variable (e.g. can be used to run every x loops)
 #ifndef MICROPY_GC_HOOK_LOOP
@@ -682,6 +852,13 @@
 #define MICROPY_STACK_CHECK (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether to remember the most C stack seen by mp_stack_check() and the most
+// pystack allocated, so that stack sizes can be chosen from measurements.
+#ifndef MICROPY_STACK_HIGH_WATER
+#define MICROPY_STACK_HIGH_WATER (0)
+#endif
+
 // Whether to have an emergency exception buffer
 #ifndef MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF
 #define MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF (0)
@@ -824,6 +1001,14 @@ typedef long long mp_longint_impl_t;
 #endif
 
 
+// CIRCUITPY-CHANGE
+// Whether StopIteration without a value and OSError(EAGAIN) are raised as
+// reused instances rather than being allocated each time
+#ifndef MICROPY_STATIC_CONTROL_FLOW_EXCEPTIONS
+#define MICROPY_STATIC_CONTROL_FLOW_EXCEPTIONS (1)
+#endif
+
+
 // Float and complex implementation
 #define MICROPY_FLOAT_IMPL_NONE (0)
 #define MICROPY_FLOAT_IMPL_FLOAT (1)
@@ -923,6 +1108,31 @@ typedef double mp_float_t;
 #define MICROPY_MODULE_OVERRIDE_MAIN_IMPORT (0)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether to size the globals dict of a frozen or .mpy module for the names
+// its body stores before running it, rather than growing it name by name.
+#ifndef MICROPY_MODULE_PRESIZE_GLOBALS
+#define MICROPY_MODULE_PRESIZE_GLOBALS (1)
+#endif
+
+// CIRCUITPY-CHANGE
+// Whether to record, for each import, how long it spent loading (compiling
+// the .py or reading the .mpy) and running the module body, and how much it
+// allocated.  The imports it made itself are not counted in its figures.
+#ifndef MICROPY_MODULE_IMPORT_STATS
+#define MICROPY_MODULE_IMPORT_STATS (0)
+#endif
+
+// Number of imports recorded by MICROPY_MODULE_IMPORT_STATS.
+#ifndef MICROPY_MODULE_IMPORT_STATS_MAX
+#define MICROPY_MODULE_IMPORT_STATS_MAX (32)
+#endif
+
+// Microsecond clock that times imports.  Only differences are used, so it may wrap.
+#ifndef MICROPY_MODULE_IMPORT_STATS_TICKS_US
+#define MICROPY_MODULE_IMPORT_STATS_TICKS_US() mp_hal_ticks_us()
+#endif
+
 // Whether frozen modules are supported in the form of strings
 #ifndef MICROPY_MODULE_FROZEN_STR
 #define MICROPY_MODULE_FROZEN_STR (0)
@@ -987,6 +1197,13 @@ typedef double mp_float_t;
 #define MICROPY_SCHEDULER_DEPTH (4)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether the scheduler supports high priority and coalesced Python callbacks,
+// through mp_sched_schedule_ex()
+#ifndef MICROPY_SCHEDULER_PRIORITY
+#define MICROPY_SCHEDULER_PRIORITY (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EVERYTHING)
+#endif
+
 // Support for generic VFS sub-system
 #ifndef MICROPY_VFS
 #define MICROPY_VFS (0)
@@ -1085,6 +1302,12 @@ typedef double mp_float_t;
 #define MICROPY_PY_BUILTINS_STR_UNICODE_CHECK (MICROPY_PY_BUILTINS_STR_UNICODE)
 #endif
 
+// Whether list.sort() and sorted() use a stable, adaptive merge sort that calls
+// the key function once per item, instead of a smaller quicksort
+#ifndef MICROPY_PY_LIST_SORT_STABLE
+#define MICROPY_PY_LIST_SORT_STABLE (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
 // Whether str.center() method provided
 #ifndef MICROPY_PY_BUILTINS_STR_CENTER
 #define MICROPY_PY_BUILTINS_STR_CENTER (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
@@ -1510,6 +1733,26 @@ typedef double mp_float_t;
 #define MICROPY_PY_SYS_SETTRACE (0)
 #endif
 
+// Whether to support a sampling profiler (see py/profile.c).  The port calls
+// mp_prof_sample_tick() from a periodic interrupt and the VM records where it
+// is at its next branch.  Costs a word per bytecode frame and a flag test on
+// each branch.
+#ifndef MICROPY_PROF_SAMPLING
+#define MICROPY_PROF_SAMPLING (0)
+#endif
+
+// Number of frames, innermost first, kept for each profiler sample.
+#ifndef MICROPY_PROF_SAMPLING_DEPTH
+#define MICROPY_PROF_SAMPLING_DEPTH (4)
+#endif
+
+// Whether the VM keeps a chain of the running bytecode frames, so that code
+// outside the VM can find out which line is running.  Used by the sampling
+// profiler and by allocation profiling.  Costs a word per bytecode frame.
+#ifndef MICROPY_PROF_FRAME_CHAIN
+#define MICROPY_PROF_FRAME_CHAIN (MICROPY_PROF_SAMPLING)
+#endif
+
 // Whether to provide "sys.getsizeof" function
 #ifndef MICROPY_PY_SYS_GETSIZEOF
 #define MICROPY_PY_SYS_GETSIZEOF (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EVERYTHING)
@@ -1564,6 +1807,13 @@ typedef double mp_float_t;
 #define MICROPY_PY_SELECT_SELECT (1)
 #endif
 
+// Whether poll/select should skip the MP_STREAM_POLL ioctl of streams that were
+// not ready last time and have not signalled a readiness change since, see
+// MP_STREAM_GET_POLL_GEN in py/stream.h
+#ifndef MICROPY_PY_SELECT_POLL_GEN
+#define MICROPY_PY_SELECT_POLL_GEN (0)
+#endif
+
 // Whether to provide the "time" module
 #ifndef MICROPY_PY_TIME
 #define MICROPY_PY_TIME (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_BASIC_FEATURES)
@@ -1606,6 +1856,23 @@ typedef double mp_float_t;
 #define MICROPY_PY_THREAD_GIL_VM_DIVISOR (32)
 #endif
 
+// CIRCUITPY-CHANGE: Whether mp_state_ctx is reached through a thread-local
+// pointer, so that each OS thread can run its own separate VM with its own
+// heap. This is for hosts running many interpreters in one process, and it
+// cannot be combined with the _thread module.
+#ifndef MICROPY_STATE_PER_THREAD
+#define MICROPY_STATE_PER_THREAD (0)
+#endif
+
+// Storage class used for the per-thread state pointer.
+#ifndef MICROPY_STATE_THREAD_LOCAL
+#define MICROPY_STATE_THREAD_LOCAL __thread
+#endif
+
+#if MICROPY_STATE_PER_THREAD && MICROPY_PY_THREAD
+#error "MICROPY_STATE_PER_THREAD requires MICROPY_PY_THREAD to be disabled"
+#endif
+
 // Extended modules
 
 #ifndef MICROPY_PY_ASYNCIO
@@ -1647,6 +1914,12 @@ typedef double mp_float_t;
 #define MICROPY_PY_JSON_SEPARATORS (1)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether to provide json.iterparse, which yields selected parts of a document
+#ifndef MICROPY_PY_JSON_ITERPARSE
+#define MICROPY_PY_JSON_ITERPARSE (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
 #ifndef MICROPY_PY_OS
 #define MICROPY_PY_OS (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
@@ -1675,6 +1948,20 @@ typedef double mp_float_t;
 #define MICROPY_PY_RE_SUB (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether re runs patterns on a Pike VM, which takes time linear in the
+// length of the subject, instead of the recursive backtracking matcher, which
+// can take exponential time and C stack on patterns like "(a*)*b".
+#ifndef MICROPY_PY_RE_PIKEVM
+#define MICROPY_PY_RE_PIKEVM (0)
+#endif
+
+// Number of patterns given as strings to re.match(), re.search() and re.sub()
+// that are kept compiled, most recently used first.  Set to 0 to disable.
+#ifndef MICROPY_PY_RE_CACHE_SIZE
+#define MICROPY_PY_RE_CACHE_SIZE (0)
+#endif
+
 #ifndef MICROPY_PY_HEAPQ
 #define MICROPY_PY_HEAPQ (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
@@ -1972,6 +2259,16 @@ typedef double mp_float_t;
 #ifndef MP_PLAT_FREE_HEAP
 #define MP_PLAT_FREE_HEAP(ptr) free(ptr)
 #endif
+// CIRCUITPY-CHANGE: Allocate a heap area for small, hot objects in fast memory.
+#ifndef MP_PLAT_ALLOC_FAST_HEAP
+#define MP_PLAT_ALLOC_FAST_HEAP(size) MP_PLAT_ALLOC_HEAP(size)
+#endif
+#endif
+
+// CIRCUITPY-CHANGE: Whether a heap area starting at ptr is in slow memory, see
+// MICROPY_GC_HOT_ALLOC_MAX_BYTES.
+#ifndef MP_PLAT_HEAP_IS_SLOW
+#define MP_PLAT_HEAP_IS_SLOW(ptr) (false)
 #endif
 
 // This macro is used to do all output (except when MICROPY_PY_IO is defined)
@@ -32,4 +32,12 @@
 mp_dynamic_compiler_t mp_dynamic_compiler = {0};
 #endif
 
+// CIRCUITPY-CHANGE
+#if MICROPY_STATE_PER_THREAD
+// The state of the thread that started the process. Other threads must point
+// mp_state_ctx_ptr at their own state before using the VM.
+STATIC mp_state_ctx_t mp_state_ctx_main;
+MICROPY_STATE_THREAD_LOCAL mp_state_ctx_t *mp_state_ctx_ptr = &mp_state_ctx_main;
+#else
 mp_state_ctx_t PLACE_IN_DTCM_BSS(mp_state_ctx);
+#endif
@@ -73,6 +73,12 @@ typedef struct mp_dynamic_compiler_t {
     uint8_t small_int_bits; // must be <= host small_int_bits
     uint8_t native_arch;
     uint8_t nlr_buf_num_regs;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_EMIT_NATIVE
+    // If set, called for each function that has no emitter decorator, with
+    // its name and def line. Returns true to emit it as native code.
+    bool (*native_select)(qstr name, size_t line);
+    #endif
 } mp_dynamic_compiler_t;
 extern mp_dynamic_compiler_t mp_dynamic_compiler;
 #endif
@@ -85,8 +91,32 @@ extern mp_dynamic_compiler_t mp_dynamic_compiler;
 typedef struct _mp_sched_item_t {
     mp_obj_t func;
     mp_obj_t arg;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_SCHEDULER_PRIORITY
+    // Number of schedules merged into this item by MP_SCHED_COALESCE.
+    uint16_t count;
+    uint8_t flags;
+    #endif
 } mp_sched_item_t;
 
+// CIRCUITPY-CHANGE
+#if MICROPY_MODULE_IMPORT_STATS
+enum {
+    MP_IMPORT_KIND_PY,
+    MP_IMPORT_KIND_MPY,
+    MP_IMPORT_KIND_FROZEN,
+};
+
+// What one import cost, not counting the imports that it made.
+typedef struct _mp_import_record_t {
+    qstr name;
+    uint8_t kind;
+    uint32_t load_us;
+    uint32_t exec_us;
+    size_t alloc_blocks;
+} mp_import_record_t;
+#endif
+
 // This structure holds information about a single contiguous area of
 // memory reserved for the memory manager.
 typedef struct _mp_state_mem_area_t {
@@ -104,6 +134,31 @@ typedef struct _mp_state_mem_area_t {
 
     size_t gc_last_free_atb_index;
     size_t gc_last_used_block; // The block ID of the highest block allocated in the area
+
+    #if MICROPY_GC_SMALL_ALLOC_NEXT_FIT
+    size_t gc_small_alloc_atb_index; // Where the last small multi-block allocation ended
+    #endif
+
+    #if MICROPY_GC_HOT_ALLOC_MAX_BYTES
+    bool gc_slow; // In memory such as PSRAM, see MICROPY_GC_HOT_ALLOC_MAX_BYTES
+    #endif
+
+    #if MICROPY_GC_FREE_RUN_INDEX
+    // Largest free runs found after the last sweep.  These are only hints:
+    // blocks are re-checked before use and entries shrink as they are used.
+    size_t gc_free_run_start[MICROPY_GC_FREE_RUN_INDEX];
+    size_t gc_free_run_len[MICROPY_GC_FREE_RUN_INDEX];
+    #endif
+
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    // Progress of the pending sweep of this area: blocks before
+    // gc_sweep_block have been swept, the sweep is done when it reaches
+    // gc_sweep_end.
+    size_t gc_sweep_block;
+    size_t gc_sweep_end;
+    size_t gc_sweep_last_used;
+    int gc_sweep_free_tail;
+    #endif
 } mp_state_mem_area_t;
 
 // This structure hold information about the memory allocation system.
@@ -141,6 +196,24 @@ typedef struct _mp_state_mem_t {
     size_t gc_collected;
     #endif
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_GC_STATS
+    // Free running counts. Take differences to measure a span of code.
+    size_t gc_stats_collections;
+    size_t gc_stats_alloc_blocks;
+    size_t gc_stats_alloc_failures;
+    uint64_t gc_stats_pause_total_us;
+    uint32_t gc_stats_pause_max_us;
+    uint32_t gc_stats_pause_start_us;
+    #endif
+
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    bool gc_sweep_pending;
+    mp_uint_t gc_pause_start_ms;
+    mp_uint_t gc_pause_last_ms;
+    mp_uint_t gc_pause_max_ms;
+    #endif
+
     #if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
     // This is a global mutex used to make the GC thread-safe.
     mp_thread_mutex_t gc_mutex;
@@ -150,6 +223,17 @@ typedef struct _mp_state_mem_t {
     void **permanent_pointers;
 } mp_state_mem_t;
 
+#if MICROPY_OPT_LOAD_ATTR_INLINE_CACHE
+// Remembers where the name used by the instruction at ip was last found.
+// owner is whatever the map was reached through (type, globals map or the
+// builtins module).
+typedef struct _mp_inline_cache_entry_t {
+    const byte *ip;
+    const void *owner;
+    size_t slot;
+} mp_inline_cache_entry_t;
+#endif
+
 // This structure hold runtime and VM information.  It includes a section
 // which contains root pointers that must be scanned by the GC.
 typedef struct _mp_state_vm_t {
@@ -197,6 +281,12 @@ typedef struct _mp_state_vm_t {
     // dictionary for the __main__ module
     mp_obj_dict_t dict_main;
 
+    // CIRCUITPY-CHANGE: the __main__ module itself, when it can't be a const
+    // object because each thread has its own dict_main.
+    #if MICROPY_STATE_PER_THREAD
+    mp_obj_module_t module_main;
+    #endif
+
     // dictionary for overridden builtins
     #if MICROPY_CAN_OVERRIDE_BUILTINS
     mp_obj_dict_t *mp_module_builtins_override_dict;
@@ -250,6 +340,11 @@ typedef struct _mp_state_vm_t {
     // These index sched_queue.
     uint8_t sched_len;
     uint8_t sched_idx;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_SCHEDULER_PRIORITY
+    // The first sched_len_high items in sched_queue are high priority.
+    uint8_t sched_len_high;
+    #endif
     #endif
 
     #if MICROPY_ENABLE_VM_ABORT
@@ -266,6 +361,30 @@ typedef struct _mp_state_vm_t {
     // See mp_map_lookup.
     uint8_t map_lookup_cache[MICROPY_OPT_MAP_LOOKUP_CACHE_SIZE];
     #endif
+
+    #if MICROPY_OPT_LOAD_ATTR_INLINE_CACHE
+    // See mp_execute_bytecode.  Not scanned by the GC: entries are only hints.
+    mp_inline_cache_entry_t inline_cache[MICROPY_OPT_LOAD_ATTR_INLINE_CACHE_SIZE];
+    #endif
+
+    #if MICROPY_PROF_SAMPLING
+    // See py/profile.c.  The ring buffer itself is a root pointer.
+    volatile bool prof_sample_pending;
+    volatile mp_uint_t prof_sample_interval;
+    volatile mp_uint_t prof_sample_countdown;
+    size_t prof_sample_alloc;
+    size_t prof_sample_next;
+    size_t prof_sample_total;
+    #endif
+
+    // CIRCUITPY-CHANGE
+    #if MICROPY_MODULE_IMPORT_STATS
+    // See py/builtinimport.c.  import_stats_len counts every import, even
+    // those that didn't fit in the table.
+    mp_import_record_t import_stats[MICROPY_MODULE_IMPORT_STATS_MAX];
+    size_t import_stats_len;
+    struct _mp_import_timer_t *import_stats_timer;
+    #endif
 } mp_state_vm_t;
 
 // This structure holds state that is specific to a given thread.
@@ -283,10 +402,19 @@ typedef struct _mp_state_thread_t {
     size_t stack_limit;
     #endif
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_STACK_CHECK && MICROPY_STACK_HIGH_WATER
+    size_t stack_high_water;
+    #endif
+
     #if MICROPY_ENABLE_PYSTACK
     uint8_t *pystack_start;
     uint8_t *pystack_end;
     uint8_t *pystack_cur;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_STACK_HIGH_WATER
+    uint8_t *pystack_high_water;
+    #endif
     #endif
 
     // Locking of the GC is done per thread.
@@ -316,6 +444,11 @@ typedef struct _mp_state_thread_t {
     struct _mp_code_state_t *current_code_state;
     #endif
 
+    #if MICROPY_PROF_FRAME_CHAIN
+    // Innermost executing bytecode frame, for the profilers.
+    struct _mp_code_state_t *prof_sample_code_state;
+    #endif
+
     #if CIRCUITPY_WARNINGS
     warnings_action_t warnings_action;
     #endif
@@ -329,7 +462,13 @@ typedef struct _mp_state_ctx_t {
     mp_state_mem_t mem;
 } mp_state_ctx_t;
 
+// CIRCUITPY-CHANGE: optionally one state per OS thread, see MICROPY_STATE_PER_THREAD.
+#if MICROPY_STATE_PER_THREAD
+extern MICROPY_STATE_THREAD_LOCAL mp_state_ctx_t *mp_state_ctx_ptr;
+#define mp_state_ctx (*mp_state_ctx_ptr)
+#else
 extern mp_state_ctx_t mp_state_ctx;
+#endif
 
 #define MP_STATE_VM(x) (mp_state_ctx.vm.x)
 #define MP_STATE_MEM(x) (mp_state_ctx.mem.x)
@@ -26,6 +26,8 @@
 
 #include <string.h>
 #include <assert.h>
+// CIRCUITPY-CHANGE
+#include <limits.h>
 
 #include "py/mpz.h"
 
@@ -1593,6 +1595,29 @@ bool mpz_as_uint_checked(const mpz_t *i, mp_uint_t *value) {
     return true;
 }
 
+// CIRCUITPY-CHANGE: used by the 64-bit fast path in objint_mpz.c
+#if MICROPY_OPT_MPZ_INT64
+bool mpz_as_ll_checked(const mpz_t *i, long long *value) {
+    unsigned long long val = 0;
+    mpz_dig_t *d = i->dig + i->len;
+
+    while (d-- > i->dig) {
+        if (val > ((unsigned long long)LLONG_MAX >> DIG_SIZE)) {
+            // will overflow
+            return false;
+        }
+        val = (val << DIG_SIZE) | *d;
+    }
+
+    if (i->neg != 0) {
+        val = -val;
+    }
+
+    *value = val;
+    return true;
+}
+#endif
+
 void mpz_as_bytes(const mpz_t *z, bool big_endian, size_t len, byte *buf) {
     byte *b = buf;
     if (big_endian) {
@@ -44,6 +44,8 @@
 #define MICROPY_NLR_NUM_REGS_MIPS           (13)
 #define MICROPY_NLR_NUM_REGS_XTENSA         (10)
 #define MICROPY_NLR_NUM_REGS_XTENSAWIN      (17)
+// CIRCUITPY-CHANGE: RV32 uses setjmp, and newlib's jmp_buf has room for the FP registers
+#define MICROPY_NLR_NUM_REGS_RV32I          (76)
 
 // *FORMAT-OFF*
 
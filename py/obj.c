@@ -41,10 +41,19 @@
 
 #include "supervisor/shared/stack.h"
 
+// CIRCUITPY-CHANGE
+#if CIRCUITPY_MEMORYMONITOR
+#include "shared-module/memorymonitor/AllocationProfiler.h"
+#endif
+
 // Allocates an object and also sets type, for mp_obj_malloc{,_var} macros.
 MP_NOINLINE void *mp_obj_malloc_helper(size_t num_bytes, const mp_obj_type_t *type) {
     mp_obj_base_t *base = (mp_obj_base_t *)m_malloc(num_bytes);
     base->type = type;
+    // CIRCUITPY-CHANGE
+    #if CIRCUITPY_MEMORYMONITOR
+    memorymonitor_allocationprofiler_track_object_type(base, type);
+    #endif
     return base;
 }
 
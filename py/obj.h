@@ -492,7 +492,9 @@ typedef struct _mp_map_t {
     size_t all_keys_are_qstrs : 1;
     size_t is_fixed : 1;    // if set, table is fixed/read-only and can't be modified
     size_t is_ordered : 1;  // if set, table is an ordered array, not a hash map
-    size_t used : (8 * sizeof(size_t) - 3);
+    // CIRCUITPY-CHANGE: hash index for ordered maps
+    size_t has_index : 1;   // if set, an ordered table is followed by a hash index (see map.c)
+    size_t used : (8 * sizeof(size_t) - 4);
     size_t alloc;
     mp_map_elem_t *table;
 } mp_map_t;
@@ -516,6 +518,8 @@ mp_map_t *mp_map_new(size_t n);
 void mp_map_deinit(mp_map_t *map);
 void mp_map_free(mp_map_t *map);
 mp_map_elem_t *mp_map_lookup(mp_map_t *map, mp_obj_t index, mp_map_lookup_kind_t lookup_kind);
+// CIRCUITPY-CHANGE
+void mp_map_reserve(mp_map_t *map, size_t n);
 void mp_map_clear(mp_map_t *map);
 void mp_map_dump(mp_map_t *map);
 
@@ -958,6 +962,14 @@ extern const struct _mp_obj_singleton_t mp_const_notimplemented_obj;
 #if MICROPY_CONST_GENERATOREXIT_OBJ
 extern const struct _mp_obj_exception_t mp_const_GeneratorExit_obj;
 #endif
+// CIRCUITPY-CHANGE
+#if MICROPY_STATIC_CONTROL_FLOW_EXCEPTIONS
+extern struct _mp_obj_exception_t mp_static_StopIteration_obj;
+extern struct _mp_obj_exception_t mp_static_OSError_EAGAIN_obj;
+#define MP_OBJ_IS_STATIC_EXCEPTION(o) ((o) == &mp_static_StopIteration_obj || (o) == &mp_static_OSError_EAGAIN_obj)
+#else
+#define MP_OBJ_IS_STATIC_EXCEPTION(o) (false)
+#endif
 
 // Fixed empty map. Useful when calling keyword-receiving functions
 // without any keywords from C, etc.
@@ -393,7 +393,12 @@ STATIC mp_obj_t dict_popitem(mp_obj_t self_in) {
     size_t cur = 0;
     #if MICROPY_PY_COLLECTIONS_ORDEREDDICT
     if (self->map.is_ordered) {
-        cur = self->map.used - 1;
+        // CIRCUITPY-CHANGE: remove through the map so that its hash index stays up to date
+        mp_obj_t key = self->map.table[self->map.used - 1].key;
+        mp_map_elem_t *elem = mp_map_lookup(&self->map, key, MP_MAP_LOOKUP_REMOVE_IF_FOUND);
+        mp_obj_t items[] = {key, elem->value};
+        elem->value = MP_OBJ_NULL;
+        return mp_obj_new_tuple(2, items);
     }
     #endif
     mp_map_elem_t *next = dict_iter_next(self, &cur);
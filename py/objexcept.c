@@ -206,6 +206,28 @@ void mp_obj_exception_print(const mp_print_t *print, mp_obj_t o_in, mp_print_kin
     mp_obj_tuple_print(print, MP_OBJ_FROM_PTR(o->args), kind);
 }
 
+// CIRCUITPY-CHANGE
+#if MICROPY_STATIC_CONTROL_FLOW_EXCEPTIONS
+// Iterators and non-blocking I/O raise these over and over, so the same
+// instances are raised each time instead of allocating new ones. Nothing is
+// recorded in them: no traceback is added, and stores to __traceback__,
+// __cause__ and __context__ are ignored, so they never refer to other objects.
+// They stay in RAM because printing an exception chain marks its members.
+STATIC const mp_rom_obj_tuple_t eagain_args = {{&mp_type_tuple}, 1, {MP_ROM_INT(MP_EAGAIN)}};
+
+mp_obj_exception_t mp_static_StopIteration_obj = {
+    .base = {&mp_type_StopIteration},
+    .args = (mp_obj_tuple_t *)&mp_const_empty_tuple_obj,
+    .traceback = (mp_obj_traceback_t *)&mp_const_empty_traceback_obj,
+};
+
+mp_obj_exception_t mp_static_OSError_EAGAIN_obj = {
+    .base = {&mp_type_OSError},
+    .args = (mp_obj_tuple_t *)&eagain_args,
+    .traceback = (mp_obj_traceback_t *)&mp_const_empty_traceback_obj,
+};
+#endif
+
 // CIRCUITPY-CHANGE
 void mp_obj_exception_initialize0(mp_obj_exception_t *o_exc, const mp_obj_type_t *type) {
     o_exc->base.type = type;
@@ -285,6 +307,11 @@ void mp_obj_exception_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
             mp_raise_AttributeError(MP_ERROR_TEXT("can't set attribute"));
         }
         #endif
+        if (MP_OBJ_IS_STATIC_EXCEPTION(self)) {
+            // The VM chains exceptions by storing __context__, so don't fail.
+            dest[0] = MP_OBJ_NULL;
+            return;
+        }
         if (attr == MP_QSTR___traceback__) {
             if (dest[1] == mp_const_none) {
                 self->traceback = (mp_obj_traceback_t *)&mp_const_empty_traceback_obj;
@@ -632,6 +659,11 @@ void mp_obj_exception_clear_traceback(mp_obj_t self_in) {
 void mp_obj_exception_add_traceback(mp_obj_t self_in, qstr file, size_t line, qstr block) {
     mp_obj_exception_t *self = mp_obj_exception_get_native(self_in);
 
+    // CIRCUITPY-CHANGE
+    if (MP_OBJ_IS_STATIC_EXCEPTION(self)) {
+        return;
+    }
+
     // append this traceback info to traceback data
     // if memory allocation fails (eg because gc is locked), just return
 
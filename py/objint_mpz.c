@@ -27,6 +27,8 @@
 #include <string.h>
 #include <stdio.h>
 #include <assert.h>
+// CIRCUITPY-CHANGE
+#include <limits.h>
 
 #include "py/parsenumbase.h"
 #include "py/smallint.h"
@@ -80,6 +82,107 @@ mp_obj_int_t *mp_obj_int_new_mpz(void) {
     return o;
 }
 
+#if MICROPY_OPT_MPZ_INT64
+// CIRCUITPY-CHANGE: a long int made from a 64-bit value keeps its digits in
+// the same heap block as the object, so it takes one allocation instead of
+// two.  The digits are fixed, so the result must not be used as the
+// destination of an in-place mpz operation.
+STATIC mp_obj_t mp_obj_int_new_fixed_ll(long long val, bool is_signed) {
+    mp_obj_int_t *o = mp_obj_malloc_var(mp_obj_int_t, mpz_dig_t, MPZ_NUM_DIG_FOR_LL, &mp_type_int);
+    o->mpz.neg = 0;
+    o->mpz.fixed_dig = 1;
+    o->mpz.alloc = MPZ_NUM_DIG_FOR_LL;
+    o->mpz.len = 0;
+    o->mpz.dig = (mpz_dig_t *)(o + 1);
+    mpz_set_from_ll(&o->mpz, val, is_signed);
+    return MP_OBJ_FROM_PTR(o);
+}
+
+STATIC mp_obj_t mp_obj_int_from_ll_result(long long val) {
+    if (val >= MP_SMALL_INT_MIN && val <= MP_SMALL_INT_MAX) {
+        return MP_OBJ_NEW_SMALL_INT((mp_int_t)val);
+    }
+    return mp_obj_int_new_fixed_ll(val, true);
+}
+
+// Do a binary op on two ints that fit in 64 bits.  Returns MP_OBJ_NULL if the
+// op isn't handled here or the result doesn't fit, in which case the caller
+// falls back to mpz.  Errors such as division by zero are left to mpz too.
+STATIC mp_obj_t mp_obj_int_binary_op_ll(mp_binary_op_t op, long long lhs, long long rhs) {
+    long long res;
+    switch (op) {
+        case MP_BINARY_OP_ADD:
+        case MP_BINARY_OP_INPLACE_ADD:
+            if (__builtin_add_overflow(lhs, rhs, &res)) {
+                return MP_OBJ_NULL;
+            }
+            break;
+        case MP_BINARY_OP_SUBTRACT:
+        case MP_BINARY_OP_INPLACE_SUBTRACT:
+            if (__builtin_sub_overflow(lhs, rhs, &res)) {
+                return MP_OBJ_NULL;
+            }
+            break;
+        case MP_BINARY_OP_MULTIPLY:
+        case MP_BINARY_OP_INPLACE_MULTIPLY:
+            if (__builtin_mul_overflow(lhs, rhs, &res)) {
+                return MP_OBJ_NULL;
+            }
+            break;
+        case MP_BINARY_OP_FLOOR_DIVIDE:
+        case MP_BINARY_OP_INPLACE_FLOOR_DIVIDE:
+            // Neither argument can be LLONG_MIN, so this can't overflow.
+            if (rhs == 0) {
+                return MP_OBJ_NULL;
+            }
+            res = lhs / rhs;
+            if (lhs % rhs != 0 && (lhs < 0) != (rhs < 0)) {
+                res -= 1;
+            }
+            break;
+        case MP_BINARY_OP_MODULO:
+        case MP_BINARY_OP_INPLACE_MODULO:
+            if (rhs == 0) {
+                return MP_OBJ_NULL;
+            }
+            res = lhs % rhs;
+            if (res != 0 && (res < 0) != (rhs < 0)) {
+                res += rhs;
+            }
+            break;
+        case MP_BINARY_OP_AND:
+        case MP_BINARY_OP_INPLACE_AND:
+            res = lhs & rhs;
+            break;
+        case MP_BINARY_OP_OR:
+        case MP_BINARY_OP_INPLACE_OR:
+            res = lhs | rhs;
+            break;
+        case MP_BINARY_OP_XOR:
+        case MP_BINARY_OP_INPLACE_XOR:
+            res = lhs ^ rhs;
+            break;
+        case MP_BINARY_OP_LSHIFT:
+        case MP_BINARY_OP_INPLACE_LSHIFT:
+            if (rhs < 0 || rhs >= 63 || lhs > (LLONG_MAX >> rhs) || lhs < -(LLONG_MAX >> rhs)) {
+                return MP_OBJ_NULL;
+            }
+            res = lhs * (1LL << rhs);
+            break;
+        case MP_BINARY_OP_RSHIFT:
+        case MP_BINARY_OP_INPLACE_RSHIFT:
+            if (rhs < 0) {
+                return MP_OBJ_NULL;
+            }
+            res = lhs >> (rhs < 63 ? rhs : 63);
+            break;
+        default:
+            return MP_OBJ_NULL;
+    }
+    return mp_obj_int_from_ll_result(res);
+}
+#endif
+
 // This routine expects you to pass in a buffer and size (in *buf and buf_size).
 // If, for some reason, this buffer is too small, then it will allocate a
 // buffer and return the allocated buffer and size in *buf and *buf_size. It
@@ -225,6 +328,17 @@ mp_obj_t mp_obj_int_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_i
     #endif
 
     if (op >= MP_BINARY_OP_INPLACE_OR && op < MP_BINARY_OP_CONTAINS) {
+        #if MICROPY_OPT_MPZ_INT64
+        // CIRCUITPY-CHANGE: avoid building an mpz result when 64 bits will do
+        long long llhs, lrhs;
+        if (mpz_as_ll_checked(zlhs, &llhs) && mpz_as_ll_checked(zrhs, &lrhs)) {
+            mp_obj_t res = mp_obj_int_binary_op_ll(op, llhs, lrhs);
+            if (res != MP_OBJ_NULL) {
+                return res;
+            }
+        }
+        #endif
+
         mp_obj_int_t *res = mp_obj_int_new_mpz();
 
         switch (op) {
@@ -356,8 +470,9 @@ mp_obj_t mp_obj_int_pow3(mp_obj_t base, mp_obj_t exponent,  mp_obj_t modulus) {
     if (!mp_obj_is_int(base) || !mp_obj_is_int(exponent) || !mp_obj_is_int(modulus)) {
         mp_raise_TypeError(MP_ERROR_TEXT("pow() with 3 arguments requires integers"));
     } else {
-        mp_obj_t result = mp_obj_new_int_from_ull(0); // Use the _from_ull version as this forces an mpz int
-        mp_obj_int_t *res_p = (mp_obj_int_t *)MP_OBJ_TO_PTR(result);
+        // CIRCUITPY-CHANGE: the result is built in place, so it needs growable digits
+        mp_obj_int_t *res_p = mp_obj_int_new_mpz();
+        mp_obj_t result = MP_OBJ_FROM_PTR(res_p);
 
         mpz_t l_temp, r_temp, m_temp;
         mpz_t *lhs = mp_mpz_for_int(base,     &l_temp);
@@ -392,15 +507,23 @@ mp_obj_t mp_obj_new_int(mp_int_t value) {
 }
 
 mp_obj_t mp_obj_new_int_from_ll(long long val) {
+    #if MICROPY_OPT_MPZ_INT64
+    return mp_obj_int_new_fixed_ll(val, true);
+    #else
     mp_obj_int_t *o = mp_obj_int_new_mpz();
     mpz_set_from_ll(&o->mpz, val, true);
     return MP_OBJ_FROM_PTR(o);
+    #endif
 }
 
 mp_obj_t mp_obj_new_int_from_ull(unsigned long long val) {
+    #if MICROPY_OPT_MPZ_INT64
+    return mp_obj_int_new_fixed_ll(val, false);
+    #else
     mp_obj_int_t *o = mp_obj_int_new_mpz();
     mpz_set_from_ll(&o->mpz, val, false);
     return MP_OBJ_FROM_PTR(o);
+    #endif
 }
 
 mp_obj_t mp_obj_new_int_from_uint(mp_uint_t value) {
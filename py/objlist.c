@@ -301,6 +301,336 @@ STATIC mp_obj_t list_pop(size_t n_args, const mp_obj_t *args) {
     return mp_obj_list_pop(self, index);
 }
 
+#if MICROPY_PY_LIST_SORT_STABLE
+
+// Stable, adaptive merge sort along the lines of timsort.  Natural runs are
+// found (descending ones reversed) and extended to a minimum length with a
+// binary insertion sort, then adjacent runs are merged while keeping their
+// lengths balanced.  Merging trims elements that are already in place using
+// binary searches, so nearly sorted input needs few comparisons.
+//
+// Each element is a group of `w` objects that is ordered by its first object.
+// This lets keys be computed once and sorted together with their items.  All
+// comparisons are made before any element is moved, so if one raises then the
+// array still holds a permutation of the original elements.
+
+// With run lengths kept balanced as below, 40 pending runs need more than
+// 2**32 elements.
+#define SORT_MAX_RUNS (40)
+#define SORT_MIN_MERGE (64)
+
+typedef struct _sort_run_t {
+    size_t start;
+    size_t len;
+} sort_run_t;
+
+typedef struct _sort_state_t {
+    mp_obj_t *base;
+    size_t w;
+    mp_obj_t *tmp; // space for half of the elements, allocated at the first merge
+    size_t tmp_len;
+    size_t n_runs;
+    sort_run_t runs[SORT_MAX_RUNS];
+} sort_state_t;
+
+STATIC bool sort_less(mp_obj_t a, mp_obj_t b) {
+    if (mp_obj_is_small_int(a) && mp_obj_is_small_int(b)) {
+        return MP_OBJ_SMALL_INT_VALUE(a) < MP_OBJ_SMALL_INT_VALUE(b);
+    }
+    return mp_obj_is_true(mp_binary_op(MP_BINARY_OP_LESS, a, b));
+}
+
+STATIC void sort_reverse(mp_obj_t *lo, size_t n, size_t w) {
+    mp_obj_t *hi = lo + (n - 1) * w;
+    while (lo < hi) {
+        for (size_t i = 0; i < w; ++i) {
+            mp_obj_t x = lo[i];
+            lo[i] = hi[i];
+            hi[i] = x;
+        }
+        lo += w;
+        hi -= w;
+    }
+}
+
+// Returns the number of elements in lo[0:n] that are <= x.
+STATIC size_t sort_upper_bound(const mp_obj_t *lo, size_t n, size_t w, mp_obj_t x) {
+    size_t l = 0;
+    while (l < n) {
+        size_t m = l + (n - l) / 2;
+        if (sort_less(x, lo[m * w])) {
+            n = m;
+        } else {
+            l = m + 1;
+        }
+    }
+    return l;
+}
+
+// Returns the number of elements in lo[0:n] that are < x.
+STATIC size_t sort_lower_bound(const mp_obj_t *lo, size_t n, size_t w, mp_obj_t x) {
+    size_t l = 0;
+    while (l < n) {
+        size_t m = l + (n - l) / 2;
+        if (sort_less(lo[m * w], x)) {
+            l = m + 1;
+        } else {
+            n = m;
+        }
+    }
+    return l;
+}
+
+// Sort lo[0:n] given that lo[0:start] is already sorted.
+STATIC void sort_binary_insertion(mp_obj_t *lo, size_t n, size_t start, size_t w) {
+    mp_obj_t x[2];
+    for (; start < n; ++start) {
+        mp_obj_t *p = lo + start * w;
+        size_t pos = sort_upper_bound(lo, start, w, p[0]);
+        memcpy(x, p, w * sizeof(mp_obj_t));
+        memmove(lo + (pos + 1) * w, lo + pos * w, (start - pos) * w * sizeof(mp_obj_t));
+        memcpy(lo + pos * w, x, w * sizeof(mp_obj_t));
+    }
+}
+
+// Returns the length of the run at the start of lo[0:n], making it ascending.
+// Only strictly descending runs are reversed, to keep the sort stable.
+STATIC size_t sort_count_run(mp_obj_t *lo, size_t n, size_t w) {
+    if (n < 2) {
+        return n;
+    }
+    size_t len = 2;
+    if (sort_less(lo[w], lo[0])) {
+        while (len < n && sort_less(lo[len * w], lo[(len - 1) * w])) {
+            ++len;
+        }
+        sort_reverse(lo, len, w);
+    } else {
+        while (len < n && !sort_less(lo[len * w], lo[(len - 1) * w])) {
+            ++len;
+        }
+    }
+    return len;
+}
+
+// Merge a[0:na] with the following b[0:nb], where na <= nb, via a copy of a.
+STATIC void sort_merge_lo(sort_state_t *st, mp_obj_t *a, size_t na, size_t nb) {
+    size_t w = st->w;
+    mp_obj_t *tmp = st->tmp;
+    mp_obj_t *b = a + na * w;
+    memcpy(tmp, a, na * w * sizeof(mp_obj_t));
+    // The gap a[k:k+(na-i)] is what remains of tmp[i:na].
+    volatile size_t i = 0;
+    volatile size_t k = 0;
+    size_t j = 0;
+    nlr_buf_t nlr;
+    bool ok = nlr_push(&nlr) == 0;
+    if (ok) {
+        while (i < na && j < nb) {
+            if (sort_less(b[j * w], tmp[i * w])) {
+                memcpy(a + k * w, b + j * w, w * sizeof(mp_obj_t));
+                ++j;
+            } else {
+                memcpy(a + k * w, tmp + i * w, w * sizeof(mp_obj_t));
+                i = i + 1;
+            }
+            k = k + 1;
+        }
+        nlr_pop();
+    }
+    memcpy(a + k * w, tmp + i * w, (na - i) * w * sizeof(mp_obj_t));
+    if (!ok) {
+        nlr_jump(nlr.ret_val);
+    }
+}
+
+// Merge a[0:na] with the following b[0:nb], where na > nb, via a copy of b.
+STATIC void sort_merge_hi(sort_state_t *st, mp_obj_t *a, size_t na, size_t nb) {
+    size_t w = st->w;
+    mp_obj_t *tmp = st->tmp;
+    memcpy(tmp, a + na * w, nb * w * sizeof(mp_obj_t));
+    // The gap a[i:i+j] is what remains of tmp[0:j].
+    volatile size_t i = na;
+    volatile size_t j = nb;
+    nlr_buf_t nlr;
+    bool ok = nlr_push(&nlr) == 0;
+    if (ok) {
+        while (i > 0 && j > 0) {
+            if (sort_less(tmp[(j - 1) * w], a[(i - 1) * w])) {
+                memcpy(a + (i + j - 1) * w, a + (i - 1) * w, w * sizeof(mp_obj_t));
+                i = i - 1;
+            } else {
+                memcpy(a + (i + j - 1) * w, tmp + (j - 1) * w, w * sizeof(mp_obj_t));
+                j = j - 1;
+            }
+        }
+        nlr_pop();
+    }
+    memcpy(a + i * w, tmp, j * w * sizeof(mp_obj_t));
+    if (!ok) {
+        nlr_jump(nlr.ret_val);
+    }
+}
+
+// Merge pending runs k and k + 1.
+STATIC void sort_merge_at(sort_state_t *st, size_t k) {
+    size_t w = st->w;
+    mp_obj_t *a = st->base + st->runs[k].start * w;
+    size_t na = st->runs[k].len;
+    size_t nb = st->runs[k + 1].len;
+    mp_obj_t *b = a + na * w;
+
+    st->runs[k].len = na + nb;
+    if (k + 2 < st->n_runs) {
+        st->runs[k + 1] = st->runs[k + 2];
+    }
+    st->n_runs -= 1;
+
+    // Elements of a that are <= b[0], and of b that are >= the last of a, are
+    // already in their final place.
+    size_t skip = sort_upper_bound(a, na, w, b[0]);
+    a += skip * w;
+    na -= skip;
+    if (na == 0) {
+        return;
+    }
+    nb = sort_lower_bound(b, nb, w, a[(na - 1) * w]);
+    if (nb == 0) {
+        return;
+    }
+
+    if (st->tmp == NULL) {
+        st->tmp = m_new(mp_obj_t, st->tmp_len);
+    }
+    if (na <= nb) {
+        sort_merge_lo(st, a, na, nb);
+    } else {
+        sort_merge_hi(st, a, na, nb);
+    }
+}
+
+// Merge pending runs until their lengths satisfy, from the top of the stack,
+// len[k-2] > len[k-1] + len[k] and len[k-1] > len[k].
+STATIC void sort_merge_collapse(sort_state_t *st) {
+    sort_run_t *r = st->runs;
+    while (st->n_runs > 1) {
+        size_t k = st->n_runs - 2;
+        if ((k > 0 && r[k - 1].len <= r[k].len + r[k + 1].len)
+            || (k > 1 && r[k - 2].len <= r[k - 1].len + r[k].len)) {
+            if (r[k - 1].len < r[k + 1].len) {
+                --k;
+            }
+        } else if (r[k].len > r[k + 1].len) {
+            break;
+        }
+        sort_merge_at(st, k);
+    }
+}
+
+// Choose a minimum run length in [SORT_MIN_MERGE / 2, SORT_MIN_MERGE] so that
+// n / minrun is, or is just below, a power of two.
+STATIC size_t sort_min_run(size_t n) {
+    size_t r = 0;
+    while (n >= SORT_MIN_MERGE) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+STATIC void mp_sort(mp_obj_t *base, size_t n, size_t w, bool reverse) {
+    MP_STACK_CHECK();
+    if (reverse) {
+        // Reversing before and after keeps equal elements in their original order.
+        sort_reverse(base, n, w);
+    }
+
+    sort_state_t st;
+    st.base = base;
+    st.w = w;
+    st.tmp = NULL;
+    st.tmp_len = n / 2 * w;
+    st.n_runs = 0;
+
+    size_t min_run = sort_min_run(n);
+    size_t lo = 0;
+    while (lo < n) {
+        size_t remaining = n - lo;
+        size_t len = sort_count_run(base + lo * w, remaining, w);
+        if (len < min_run) {
+            size_t forced = MIN(min_run, remaining);
+            sort_binary_insertion(base + lo * w, forced, len, w);
+            len = forced;
+        }
+        st.runs[st.n_runs].start = lo;
+        st.runs[st.n_runs].len = len;
+        st.n_runs += 1;
+        sort_merge_collapse(&st);
+        lo += len;
+    }
+
+    // Merge everything that is left.
+    while (st.n_runs > 1) {
+        size_t k = st.n_runs - 2;
+        if (k > 0 && st.runs[k - 1].len < st.runs[k + 1].len) {
+            --k;
+        }
+        sort_merge_at(&st, k);
+    }
+
+    if (st.tmp != NULL) {
+        m_del(mp_obj_t, st.tmp, st.tmp_len);
+    }
+    if (reverse) {
+        sort_reverse(base, n, w);
+    }
+}
+
+mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_key, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_reverse, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+    };
+
+    // parse args
+    struct {
+        mp_arg_val_t key, reverse;
+    } args;
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args,
+        MP_ARRAY_SIZE(allowed_args), allowed_args, (mp_arg_val_t *)&args);
+
+    mp_check_self(mp_obj_is_type(pos_args[0], &mp_type_list));
+    mp_obj_list_t *self = native_list(pos_args[0]);
+
+    size_t n = self->len;
+    if (n > 1) {
+        if (args.key.u_obj == mp_const_none) {
+            mp_sort(self->items, n, 1, args.reverse.u_bool);
+        } else {
+            // Call the key function once per item, and sort (key, item) pairs.
+            mp_obj_t *pairs = m_new(mp_obj_t, 2 * n);
+            for (size_t i = 0; i < n; ++i) {
+                pairs[2 * i + 1] = self->items[i];
+            }
+            for (size_t i = 0; i < n; ++i) {
+                pairs[2 * i] = mp_call_function_1(args.key.u_obj, pairs[2 * i + 1]);
+            }
+            mp_sort(pairs, n, 2, args.reverse.u_bool);
+            if (self->len != n) {
+                mp_raise_ValueError(MP_ERROR_TEXT("list modified during sort"));
+            }
+            for (size_t i = 0; i < n; ++i) {
+                self->items[i] = pairs[2 * i + 1];
+            }
+            m_del(mp_obj_t, pairs, 2 * n);
+        }
+    }
+
+    return mp_const_none;
+}
+
+#else
+
 STATIC void mp_quicksort(mp_obj_t *head, mp_obj_t *tail, mp_obj_t key_fn, mp_obj_t binop_less_result) {
     MP_STACK_CHECK();
     while (head < tail) {
@@ -333,7 +663,6 @@ STATIC void mp_quicksort(mp_obj_t *head, mp_obj_t *tail, mp_obj_t key_fn, mp_obj
     }
 }
 
-// TODO Python defines sort to be stable but ours is not
 mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_key, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
@@ -359,6 +688,8 @@ mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_
     return mp_const_none;
 }
 
+#endif // MICROPY_PY_LIST_SORT_STABLE
+
 mp_obj_t mp_obj_list_clear(mp_obj_t self_in) {
     mp_check_self(mp_obj_is_type(self_in, &mp_type_list));
     mp_obj_list_t *self = native_list(self_in);
@@ -238,7 +238,8 @@ typedef struct _parser_t {
     mp_parse_chunk_t *cur_chunk;
 
     #if MICROPY_COMP_CONST
-    mp_map_t consts;
+    // CIRCUITPY-CHANGE: a pointer, so statement-at-a-time parsing can share it
+    mp_map_t *consts;
     #endif
 } parser_t;
 
@@ -355,7 +356,8 @@ bool mp_parse_node_get_int_maybe(mp_parse_node_t pn, mp_obj_t *o) {
 }
 
 #if MICROPY_COMP_CONST_TUPLE || MICROPY_COMP_CONST
-STATIC bool mp_parse_node_is_const(mp_parse_node_t pn) {
+// CIRCUITPY-CHANGE: not static, so the compiler can fold constant default arguments
+bool mp_parse_node_is_const(mp_parse_node_t pn) {
     if (MP_PARSE_NODE_IS_SMALL_INT(pn)) {
         // Small integer.
         return true;
@@ -382,7 +384,7 @@ STATIC bool mp_parse_node_is_const(mp_parse_node_t pn) {
     return false;
 }
 
-STATIC mp_obj_t mp_parse_node_convert_to_obj(mp_parse_node_t pn) {
+mp_obj_t mp_parse_node_convert_to_obj(mp_parse_node_t pn) {
     assert(mp_parse_node_is_const(pn));
     if (MP_PARSE_NODE_IS_SMALL_INT(pn)) {
         mp_int_t arg = MP_PARSE_NODE_LEAF_SMALL_INT(pn);
@@ -593,7 +595,7 @@ STATIC void push_result_token(parser_t *parser, uint8_t rule_id) {
         // if name is a standalone identifier, look it up in the table of dynamic constants
         mp_map_elem_t *elem;
         if (rule_id == RULE_atom
-            && (elem = mp_map_lookup(&parser->consts, MP_OBJ_NEW_QSTR(id), MP_MAP_LOOKUP)) != NULL) {
+            && (elem = mp_map_lookup(parser->consts, MP_OBJ_NEW_QSTR(id), MP_MAP_LOOKUP)) != NULL) {
             pn = make_node_const_object_optimised(parser, lex->tok_line, elem->value);
         } else {
             pn = mp_parse_node_new_leaf(MP_PARSE_NODE_ID, id);
@@ -832,7 +834,7 @@ STATIC bool fold_constants(parser_t *parser, uint8_t rule_id, size_t num_args) {
                 mp_obj_t value = mp_parse_node_convert_to_obj(pn_value);
 
                 // store the value in the table of dynamic constants
-                mp_map_elem_t *elem = mp_map_lookup(&parser->consts, MP_OBJ_NEW_QSTR(id), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
+                mp_map_elem_t *elem = mp_map_lookup(parser->consts, MP_OBJ_NEW_QSTR(id), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
                 assert(elem->value == MP_OBJ_NULL);
                 elem->value = value;
 
@@ -898,6 +900,70 @@ STATIC bool fold_constants(parser_t *parser, uint8_t rule_id, size_t num_args) {
 
 #endif // MICROPY_COMP_CONST_FOLDING
 
+// CIRCUITPY-CHANGE
+#if MICROPY_COMP_CROSS_MODULE
+// Module name to a dict of the public constants that it defines.
+MP_REGISTER_ROOT_POINTER(mp_obj_t parse_import_consts);
+
+// For "from <module> import NAME [as ALIAS]" where the module's constants
+// are known, make NAME or ALIAS a constant for the rest of the parse. The
+// import itself is kept, so the module still gets the name at runtime.
+STATIC void add_imported_consts(parser_t *parser) {
+    mp_obj_t modules = MP_STATE_VM(parse_import_consts);
+    if (modules == MP_OBJ_NULL) {
+        return;
+    }
+    mp_parse_node_t pn_module = peek_result(parser, 1);
+    mp_parse_node_t pn_names = peek_result(parser, 0);
+    qstr module;
+    if (MP_PARSE_NODE_IS_ID(pn_module)) {
+        module = MP_PARSE_NODE_LEAF_ARG(pn_module);
+    } else if (MP_PARSE_NODE_IS_STRUCT_KIND(pn_module, RULE_dotted_name)) {
+        mp_parse_node_struct_t *pns = (mp_parse_node_struct_t *)pn_module;
+        vstr_t vstr;
+        vstr_init(&vstr, 16);
+        for (size_t i = 0; i < MP_PARSE_NODE_STRUCT_NUM_NODES(pns); i++) {
+            if (i > 0) {
+                vstr_add_char(&vstr, '.');
+            }
+            vstr_add_str(&vstr, qstr_str(MP_PARSE_NODE_LEAF_ARG(pns->nodes[i])));
+        }
+        module = qstr_from_strn(vstr.buf, vstr.len);
+        vstr_clear(&vstr);
+    } else {
+        // Relative imports aren't resolved.
+        return;
+    }
+    mp_map_elem_t *elem = mp_map_lookup(mp_obj_dict_get_map(modules), MP_OBJ_NEW_QSTR(module), MP_MAP_LOOKUP);
+    if (elem == NULL) {
+        return;
+    }
+    mp_map_t *module_consts = mp_obj_dict_get_map(elem->value);
+
+    mp_parse_node_t *names;
+    size_t n = mp_parse_node_extract_list(&pn_names, RULE_import_as_names, &names);
+    for (size_t i = 0; i < n; i++) {
+        if (!MP_PARSE_NODE_IS_STRUCT_KIND(names[i], RULE_import_as_name)) {
+            // import *
+            continue;
+        }
+        mp_parse_node_struct_t *pns = (mp_parse_node_struct_t *)names[i];
+        qstr id = MP_PARSE_NODE_LEAF_ARG(pns->nodes[0]);
+        mp_map_elem_t *value = mp_map_lookup(module_consts, MP_OBJ_NEW_QSTR(id), MP_MAP_LOOKUP);
+        if (value == NULL) {
+            continue;
+        }
+        if (!MP_PARSE_NODE_IS_NULL(pns->nodes[1])) {
+            id = MP_PARSE_NODE_LEAF_ARG(pns->nodes[1]);
+        }
+        mp_map_elem_t *dest = mp_map_lookup(parser->consts, MP_OBJ_NEW_QSTR(id), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
+        if (dest->value == MP_OBJ_NULL) {
+            dest->value = value->value;
+        }
+    }
+}
+#endif
+
 #if MICROPY_COMP_CONST_TUPLE
 STATIC bool build_tuple_from_stack(parser_t *parser, size_t src_line, size_t num_args) {
     for (size_t i = num_args; i > 0;) {
@@ -1007,6 +1073,13 @@ STATIC void push_result_rule(parser_t *parser, size_t src_line, uint8_t rule_id,
     }
     #endif
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_COMP_CROSS_MODULE
+    if (rule_id == RULE_import_from) {
+        add_imported_consts(parser);
+    }
+    #endif
+
     #if MICROPY_COMP_CONST_TUPLE
     if (build_tuple(parser, src_line, rule_id, num_args)) {
         // we built a tuple from this rule so return straightaway
@@ -1027,11 +1100,9 @@ STATIC void push_result_rule(parser_t *parser, size_t src_line, uint8_t rule_id,
     push_result_node(parser, (mp_parse_node_t)pn);
 }
 
-mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
-    // Set exception handler to free the lexer if an exception is raised.
-    MP_DEFINE_NLR_JUMP_CALLBACK_FUNCTION_1(ctx, mp_lexer_free, lex);
-    nlr_push_jump_callback(&ctx.callback, mp_call_function_1_from_nlr_jump_callback);
-
+// CIRCUITPY-CHANGE: the body of mp_parse(), which can also stop after a single
+// top-level statement of a file and leave the lexer at the next one.
+STATIC mp_parse_tree_t parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind, void *consts, bool one_stmt) {
     // initialise parser and allocate memory for its stacks
 
     parser_t parser;
@@ -1071,7 +1142,9 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
     parser.cur_chunk = NULL;
 
     #if MICROPY_COMP_CONST
-    mp_map_init(&parser.consts, 0);
+    parser.consts = consts;
+    #else
+    (void)consts;
     #endif
 
     // work out the top-level rule to use, and push it on the stack
@@ -1084,7 +1157,9 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
             top_level_rule = RULE_eval_input;
             break;
         default:
-            top_level_rule = RULE_file_input;
+            // CIRCUITPY-CHANGE: in MicroPython single_input is exactly one
+            // statement, with no trailing NEWLINE after a compound one.
+            top_level_rule = one_stmt ? RULE_single_input : RULE_file_input;
     }
     push_rule(&parser, lex->tok_line, top_level_rule, 0);
 
@@ -1346,10 +1421,6 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
         }
     }
 
-    #if MICROPY_COMP_CONST
-    mp_map_deinit(&parser.consts);
-    #endif
-
     // truncate final chunk and link into chain of chunks
     if (parser.cur_chunk != NULL) {
         (void)m_renew_maybe(byte, parser.cur_chunk,
@@ -1362,7 +1433,8 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
     }
 
     if (
-        lex->tok_kind != MP_TOKEN_END // check we are at the end of the token stream
+        // CIRCUITPY-CHANGE: one_stmt leaves the rest of the token stream
+        (!one_stmt && lex->tok_kind != MP_TOKEN_END) // check we are at the end of the token stream
         || parser.result_stack_top == 0 // check that we got a node (can fail on empty input)
         ) {
     syntax_error:;
@@ -1399,12 +1471,181 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
     m_del(rule_stack_t, parser.rule_stack, parser.rule_stack_alloc);
     m_del(mp_parse_node_t, parser.result_stack, parser.result_stack_alloc);
 
+    return parser.tree;
+}
+
+mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
+    // Set exception handler to free the lexer if an exception is raised.
+    MP_DEFINE_NLR_JUMP_CALLBACK_FUNCTION_1(ctx, mp_lexer_free, lex);
+    nlr_push_jump_callback(&ctx.callback, mp_call_function_1_from_nlr_jump_callback);
+
+    #if MICROPY_COMP_CONST
+    mp_map_t consts;
+    mp_map_init(&consts, 0);
+    mp_parse_tree_t tree = parse(lex, input_kind, &consts, false);
+    mp_map_deinit(&consts);
+    #else
+    mp_parse_tree_t tree = parse(lex, input_kind, NULL, false);
+    #endif
+
     // Deregister exception handler and free the lexer.
     nlr_pop_jump_callback(true);
 
-    return parser.tree;
+    return tree;
+}
+
+// CIRCUITPY-CHANGE
+#if MICROPY_COMPILE_BY_STATEMENT
+void mp_parse_stmt_init(mp_parse_stmt_t *stmt_parser, mp_lexer_t *lex) {
+    stmt_parser->lex = lex;
+    stmt_parser->first = true;
+    #if MICROPY_COMP_CONST
+    mp_map_init(&stmt_parser->consts, 0);
+    #endif
 }
 
+bool mp_parse_stmt_next(mp_parse_stmt_t *stmt_parser, mp_parse_tree_t *tree) {
+    if (stmt_parser->lex->tok_kind == MP_TOKEN_END) {
+        return false;
+    }
+    #if MICROPY_COMP_CONST
+    void *consts = &stmt_parser->consts;
+    #else
+    void *consts = NULL;
+    #endif
+    *tree = parse(stmt_parser->lex, MP_PARSE_FILE_INPUT, consts, true);
+
+    #if MICROPY_ENABLE_DOC_STRING
+    // Only the first statement can be the module's doc string. A lone string
+    // later on does nothing, so drop it rather than let the compiler take it
+    // for one.
+    mp_parse_node_t pn = tree->root;
+    if (!stmt_parser->first && MP_PARSE_NODE_IS_STRUCT_KIND(pn, RULE_expr_stmt)) {
+        mp_parse_node_struct_t *pns = (mp_parse_node_struct_t *)pn;
+        if (MP_PARSE_NODE_IS_NULL(pns->nodes[1])
+            && ((MP_PARSE_NODE_IS_LEAF(pns->nodes[0]) && !MP_PARSE_NODE_IS_ID(pns->nodes[0]))
+                || MP_PARSE_NODE_IS_STRUCT_KIND(pns->nodes[0], RULE_const_object))) {
+            tree->root = MP_PARSE_NODE_NULL;
+        }
+    }
+    #endif
+    if (!MP_PARSE_NODE_IS_TOKEN_KIND(tree->root, MP_TOKEN_NEWLINE)) {
+        stmt_parser->first = false;
+    }
+    return true;
+}
+
+void mp_parse_stmt_deinit(mp_parse_stmt_t *stmt_parser) {
+    #if MICROPY_COMP_CONST
+    mp_map_deinit(&stmt_parser->consts);
+    #endif
+    mp_lexer_free(stmt_parser->lex);
+}
+#endif
+
+// CIRCUITPY-CHANGE
+#if MICROPY_COMP_CROSS_MODULE
+void mp_parse_add_import_consts(qstr module, mp_lexer_t *lex) {
+    MP_DEFINE_NLR_JUMP_CALLBACK_FUNCTION_1(ctx, mp_lexer_free, lex);
+    nlr_push_jump_callback(&ctx.callback, mp_call_function_1_from_nlr_jump_callback);
+
+    mp_map_t consts;
+    mp_map_init(&consts, 0);
+    mp_parse_tree_t tree = parse(lex, MP_PARSE_FILE_INPUT, &consts, false);
+    mp_parse_tree_clear(&tree);
+
+    // Private constants are never stored in the module, so can't be imported.
+    mp_obj_t dict = mp_obj_new_dict(0);
+    for (size_t i = 0; i < consts.alloc; i++) {
+        if (mp_map_slot_is_filled(&consts, i)
+            && qstr_str(MP_OBJ_QSTR_VALUE(consts.table[i].key))[0] != '_') {
+            mp_obj_dict_store(dict, consts.table[i].key, consts.table[i].value);
+        }
+    }
+    mp_map_deinit(&consts);
+
+    nlr_pop_jump_callback(true);
+
+    if (MP_STATE_VM(parse_import_consts) == MP_OBJ_NULL) {
+        MP_STATE_VM(parse_import_consts) = mp_obj_new_dict(0);
+    }
+    mp_obj_dict_store(MP_STATE_VM(parse_import_consts), MP_OBJ_NEW_QSTR(module), dict);
+}
+
+// Name of each top-level definition that may be removed, to the number of
+// times it appears in the tree.
+STATIC void count_private_refs(mp_parse_node_t pn, mp_map_t *counts, bool *dynamic) {
+    if (MP_PARSE_NODE_IS_ID(pn)) {
+        qstr id = MP_PARSE_NODE_LEAF_ARG(pn);
+        mp_map_elem_t *elem = mp_map_lookup(counts, MP_OBJ_NEW_QSTR(id), MP_MAP_LOOKUP);
+        if (elem != NULL) {
+            elem->value = MP_OBJ_NEW_SMALL_INT(MP_OBJ_SMALL_INT_VALUE(elem->value) + 1);
+        } else if (id == MP_QSTR_globals || id == MP_QSTR_locals || id == MP_QSTR_eval || id == MP_QSTR_exec) {
+            // Names can be looked up without appearing in the source.
+            *dynamic = true;
+        }
+    } else if (MP_PARSE_NODE_IS_STRUCT(pn) && !MP_PARSE_NODE_IS_STRUCT_KIND(pn, RULE_const_object)) {
+        mp_parse_node_struct_t *pns = (mp_parse_node_struct_t *)pn;
+        for (size_t i = 0; i < MP_PARSE_NODE_STRUCT_NUM_NODES(pns); i++) {
+            count_private_refs(pns->nodes[i], counts, dynamic);
+        }
+    }
+}
+
+STATIC qstr strippable_name(mp_parse_node_t pn) {
+    // Decorated definitions are left alone, the decorator may register them.
+    if (!MP_PARSE_NODE_IS_STRUCT_KIND(pn, RULE_funcdef) && !MP_PARSE_NODE_IS_STRUCT_KIND(pn, RULE_classdef)) {
+        return MP_QSTRnull;
+    }
+    qstr id = MP_PARSE_NODE_LEAF_ARG(((mp_parse_node_struct_t *)pn)->nodes[0]);
+    const char *name = qstr_str(id);
+    // Dunder names such as a module __getattr__ are used by the runtime.
+    if (name[0] != '_' || name[1] == '_') {
+        return MP_QSTRnull;
+    }
+    return id;
+}
+
+void mp_parse_strip_unused_private(mp_parse_tree_t *tree) {
+    mp_parse_node_t *stmts;
+    size_t n = mp_parse_node_extract_list(&tree->root, RULE_file_input_2, &stmts);
+    mp_map_t counts;
+    mp_map_init(&counts, 0);
+    bool removed = true;
+    // Removing one definition can leave another one unused.
+    while (removed) {
+        removed = false;
+        mp_map_clear(&counts);
+        for (size_t i = 0; i < n; i++) {
+            qstr id = strippable_name(stmts[i]);
+            if (id != MP_QSTRnull) {
+                mp_map_lookup(&counts, MP_OBJ_NEW_QSTR(id), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND)->value = MP_OBJ_NEW_SMALL_INT(0);
+            }
+        }
+        if (counts.used == 0) {
+            break;
+        }
+        bool dynamic = false;
+        for (size_t i = 0; i < n; i++) {
+            count_private_refs(stmts[i], &counts, &dynamic);
+        }
+        if (dynamic) {
+            break;
+        }
+        for (size_t i = 0; i < n; i++) {
+            qstr id = strippable_name(stmts[i]);
+            // Only its own definition names it.
+            if (id != MP_QSTRnull
+                && mp_map_lookup(&counts, MP_OBJ_NEW_QSTR(id), MP_MAP_LOOKUP)->value == MP_OBJ_NEW_SMALL_INT(1)) {
+                stmts[i] = MP_PARSE_NODE_NULL;
+                removed = true;
+            }
+        }
+    }
+    mp_map_deinit(&counts);
+}
+#endif
+
 void mp_parse_tree_clear(mp_parse_tree_t *tree) {
     mp_parse_chunk_t *chunk = tree->chunk;
     while (chunk != NULL) {
@@ -94,6 +94,11 @@ static inline mp_obj_t mp_parse_node_extract_const_object(mp_parse_node_struct_t
 bool mp_parse_node_is_const_false(mp_parse_node_t pn);
 bool mp_parse_node_is_const_true(mp_parse_node_t pn);
 bool mp_parse_node_get_int_maybe(mp_parse_node_t pn, mp_obj_t *o);
+// CIRCUITPY-CHANGE: used by the compiler to fold constant default arguments
+#if MICROPY_COMP_CONST_TUPLE || MICROPY_COMP_CONST
+bool mp_parse_node_is_const(mp_parse_node_t pn);
+mp_obj_t mp_parse_node_convert_to_obj(mp_parse_node_t pn);
+#endif
 size_t mp_parse_node_extract_list(mp_parse_node_t *pn, size_t pn_kind, mp_parse_node_t **nodes);
 void mp_parse_node_print(const mp_print_t *print, mp_parse_node_t pn, size_t indent);
 
@@ -113,4 +118,35 @@ typedef struct _mp_parse_t {
 mp_parse_tree_t mp_parse(struct _mp_lexer_t *lex, mp_parse_input_kind_t input_kind);
 void mp_parse_tree_clear(mp_parse_tree_t *tree);
 
+// CIRCUITPY-CHANGE
+#if MICROPY_COMPILE_BY_STATEMENT
+// Parse a file one top-level statement at a time, so that each statement's
+// parse tree can be compiled and freed before the next is read. Constants
+// made with const() carry over from one statement to the next. deinit frees
+// the lexer; it must also be called if parsing raises.
+typedef struct _mp_parse_stmt_t {
+    struct _mp_lexer_t *lex;
+    bool first;
+    #if MICROPY_COMP_CONST
+    mp_map_t consts;
+    #endif
+} mp_parse_stmt_t;
+
+void mp_parse_stmt_init(mp_parse_stmt_t *stmt_parser, struct _mp_lexer_t *lex);
+// Returns false when there are no more statements.
+bool mp_parse_stmt_next(mp_parse_stmt_t *stmt_parser, mp_parse_tree_t *tree);
+void mp_parse_stmt_deinit(mp_parse_stmt_t *stmt_parser);
+#endif
+
+// CIRCUITPY-CHANGE
+#if MICROPY_COMP_CROSS_MODULE
+// Parse a module only for its public const() definitions, so that later
+// parses fold the names that "from <module> import NAME" brings in. Frees
+// the lexer.
+void mp_parse_add_import_consts(qstr module, struct _mp_lexer_t *lex);
+// Remove top-level functions and classes with a single-underscore name that
+// nothing in the module refers to.
+void mp_parse_strip_unused_private(mp_parse_tree_t *tree);
+#endif
+
 #endif // MICROPY_INCLUDED_PY_PARSE_H
@@ -169,6 +169,12 @@ STATIC qstr load_qstr(mp_reader_t *reader) {
         return len >> 1;
     }
     len >>= 1;
+    #if MICROPY_PERSISTENT_CODE_LOAD_XIP
+    const char *str_xip = (const char *)mp_reader_try_read_xip(reader, len + 1);
+    if (str_xip != NULL) {
+        return qstr_from_strn_static(str_xip, len);
+    }
+    #endif
     char *str = m_new(char, len);
     read_bytes(reader, (byte *)str, len);
     read_byte(reader); // read and discard null terminator
@@ -204,6 +210,15 @@ STATIC mp_obj_t load_obj(mp_reader_t *reader) {
             }
             return MP_OBJ_FROM_PTR(tuple);
         }
+        #if MICROPY_PERSISTENT_CODE_LOAD_XIP
+        if (obj_type == MP_PERSISTENT_OBJ_STR || obj_type == MP_PERSISTENT_OBJ_BYTES) {
+            // Refer to the data and its null terminator in place.
+            const byte *data = mp_reader_try_read_xip(reader, len + 1);
+            if (data != NULL) {
+                return mp_obj_new_str_static(obj_type == MP_PERSISTENT_OBJ_STR ? &mp_type_str : &mp_type_bytes, data, len);
+            }
+        }
+        #endif
         vstr_t vstr;
         vstr_init_len(&vstr, len);
         read_bytes(reader, (byte *)vstr.buf, len);
@@ -245,10 +260,17 @@ STATIC mp_raw_code_t *load_raw_code(mp_reader_t *reader, mp_module_context_t *co
     #endif
 
     if (kind == MP_CODE_BYTECODE) {
-        // Allocate memory for the bytecode
-        fun_data = m_new(uint8_t, fun_data_len);
-        // Load bytecode
-        read_bytes(reader, fun_data, fun_data_len);
+        #if MICROPY_PERSISTENT_CODE_LOAD_XIP
+        // Bytecode is never written to, so it can be executed in place.
+        fun_data = (uint8_t *)mp_reader_try_read_xip(reader, fun_data_len);
+        if (fun_data == NULL)
+        #endif
+        {
+            // Allocate memory for the bytecode
+            fun_data = m_new(uint8_t, fun_data_len);
+            // Load bytecode
+            read_bytes(reader, fun_data, fun_data_len);
+        }
 
     #if MICROPY_EMIT_MACHINE_CODE
     } else {
@@ -405,9 +427,9 @@ void mp_raw_code_load(mp_reader_t *reader, mp_compiled_module_t *cm) {
     byte header[4];
     read_bytes(reader, header, sizeof(header));
     byte arch = MPY_FEATURE_DECODE_ARCH(header[2]);
-    // CIRCUITPY-CHANGE: 'C', not 'M'
+    // CIRCUITPY-CHANGE: 'C', not 'M', and MPY_VERSION_COMPAT
     if (header[0] != 'C'
-        || header[1] != MPY_VERSION
+        || (header[1] != MPY_VERSION && header[1] != MPY_VERSION_COMPAT)
         || (arch != MP_NATIVE_ARCH_NONE && MPY_FEATURE_DECODE_SUB_VERSION(header[2]) != MPY_SUB_VERSION)
         || header[3] > MP_SMALL_INT_BITS) {
         mp_raise_ValueError(MP_ERROR_TEXT("incompatible .mpy file"));
@@ -34,7 +34,15 @@
 // as long as MPY_VERSION matches, but a native .mpy (i.e. one with an arch
 // set) must also match MPY_SUB_VERSION. This allows 3 additional updates to
 // the native ABI per bytecode revision.
+#if MICROPY_OPT_FUSED_OPCODES
+// Bytecode may contain the fused opcodes, which other VMs don't understand.
+#define MPY_VERSION 7
+// Version 6 bytecode only uses opcodes this VM also has, so it still loads.
+#define MPY_VERSION_COMPAT 6
+#else
 #define MPY_VERSION 6
+#define MPY_VERSION_COMPAT MPY_VERSION
+#endif
 #define MPY_SUB_VERSION 1
 
 // Macros to encode/decode sub-version to/from the feature byte. This replaces
@@ -71,6 +79,9 @@
     #define MPY_FEATURE_ARCH (MP_NATIVE_ARCH_XTENSA)
 #elif MICROPY_EMIT_XTENSAWIN
     #define MPY_FEATURE_ARCH (MP_NATIVE_ARCH_XTENSAWIN)
+// CIRCUITPY-CHANGE: RV32 native emitter
+#elif MICROPY_EMIT_RV32
+    #define MPY_FEATURE_ARCH (MP_NATIVE_ARCH_RV32IMC)
 #else
     #define MPY_FEATURE_ARCH (MP_NATIVE_ARCH_NONE)
 #endif
@@ -95,6 +106,8 @@ enum {
     MP_NATIVE_ARCH_ARMV7EMDP,
     MP_NATIVE_ARCH_XTENSA,
     MP_NATIVE_ARCH_XTENSAWIN,
+    // CIRCUITPY-CHANGE: RV32 native emitter
+    MP_NATIVE_ARCH_RV32IMC,
 };
 
 enum {
@@ -112,6 +125,8 @@ enum {
 };
 
 void mp_raw_code_load(mp_reader_t *reader, mp_compiled_module_t *ctx);
+// With MICROPY_PERSISTENT_CODE_LOAD_XIP the loaded code may refer to buf in place,
+// so buf must then stay valid and unchanged for as long as the code is in use.
 void mp_raw_code_load_mem(const byte *buf, size_t len, mp_compiled_module_t *ctx);
 void mp_raw_code_load_file(const char *filename, mp_compiled_module_t *ctx);
 
@@ -24,6 +24,8 @@
  * THE SOFTWARE.
  */
 
+#include <string.h>
+
 #include "py/profile.h"
 #include "py/bc0.h"
 #include "py/gc.h"
@@ -975,3 +977,153 @@ void mp_prof_print_instr(const byte *ip, mp_code_state_t *code_state) {
 #endif // MICROPY_PROF_INSTR_DEBUG_PRINT_ENABLE
 
 #endif // MICROPY_PY_SYS_SETTRACE
+
+#if MICROPY_PROF_FRAME_CHAIN
+
+void mp_prof_frame_location(const mp_code_state_t *code_state, mp_prof_sample_frame_t *frame) {
+    const byte *ip = code_state->fun_bc->bytecode;
+    MP_BC_PRELUDE_SIG_DECODE(ip);
+    MP_BC_PRELUDE_SIZE_DECODE(ip);
+    const byte *line_info_top = ip + n_info;
+    const byte *bytecode_start = ip + n_info + n_cell;
+    size_t bc = code_state->ip > bytecode_start ? code_state->ip - bytecode_start : 0;
+    qstr block_name = mp_decode_uint_value(ip);
+    for (size_t i = 0; i < 1 + n_pos_args + n_kwonly_args; ++i) {
+        ip = mp_decode_uint_skip(ip);
+    }
+    #if MICROPY_EMIT_BYTECODE_USES_QSTR_TABLE
+    block_name = code_state->fun_bc->context->constants.qstr_table[block_name];
+    qstr source_file = code_state->fun_bc->context->constants.qstr_table[0];
+    #else
+    qstr source_file = code_state->fun_bc->context->constants.source_file;
+    #endif
+    size_t line = mp_bytecode_get_source_line(ip, line_info_top, bc);
+    frame->file = source_file;
+    frame->name = block_name;
+    frame->line = MIN(line, 0xffff);
+}
+
+#endif // MICROPY_PROF_FRAME_CHAIN
+
+#if MICROPY_PROF_SAMPLING
+
+// Sampling profiler.  The port's periodic interrupt only sets a flag; the VM
+// notices it at its next branch and records the current line plus a few
+// callers.  Samples therefore land on loop edges and calls rather than on
+// arbitrary instructions, which is plenty to find hot spots and keeps the
+// interrupt side trivial.  Lines are resolved when the sample is taken so the
+// buffer holds no pointers into code that may since have been freed.
+
+MP_REGISTER_ROOT_POINTER(struct _mp_prof_sample_t *prof_samples);
+
+void mp_prof_sample_start(size_t n_samples, mp_uint_t interval) {
+    mp_prof_sample_stop();
+    m_del(mp_prof_sample_t, MP_STATE_VM(prof_samples), MP_STATE_VM(prof_sample_alloc));
+    MP_STATE_VM(prof_samples) = NULL;
+    MP_STATE_VM(prof_samples) = m_new(mp_prof_sample_t, n_samples);
+    MP_STATE_VM(prof_sample_alloc) = n_samples;
+    MP_STATE_VM(prof_sample_next) = 0;
+    MP_STATE_VM(prof_sample_total) = 0;
+    MP_STATE_VM(prof_sample_countdown) = interval;
+    MP_STATE_VM(prof_sample_interval) = interval;
+}
+
+void mp_prof_sample_stop(void) {
+    MP_STATE_VM(prof_sample_interval) = 0;
+    MP_STATE_VM(prof_sample_pending) = false;
+}
+
+bool mp_prof_sample_is_running(void) {
+    return MP_STATE_VM(prof_sample_interval) != 0;
+}
+
+void mp_prof_sample_tick(void) {
+    mp_uint_t interval = MP_STATE_VM(prof_sample_interval);
+    if (interval != 0 && --MP_STATE_VM(prof_sample_countdown) == 0) {
+        MP_STATE_VM(prof_sample_countdown) = interval;
+        MP_STATE_VM(prof_sample_pending) = true;
+    }
+}
+
+void mp_prof_sample_take(const mp_code_state_t *code_state) {
+    MP_STATE_VM(prof_sample_pending) = false;
+    mp_prof_sample_t *samples = MP_STATE_VM(prof_samples);
+    if (samples == NULL) {
+        return;
+    }
+    mp_prof_sample_t *sample = &samples[MP_STATE_VM(prof_sample_next)];
+    memset(sample, 0, sizeof(*sample));
+    for (size_t depth = 0; code_state != NULL && depth < MICROPY_PROF_SAMPLING_DEPTH; ++depth) {
+        mp_prof_frame_location(code_state, &sample->frame[depth]);
+        code_state = code_state->prof_sample_prev;
+    }
+    if (++MP_STATE_VM(prof_sample_next) == MP_STATE_VM(prof_sample_alloc)) {
+        MP_STATE_VM(prof_sample_next) = 0;
+    }
+    MP_STATE_VM(prof_sample_total) += 1;
+}
+
+STATIC bool prof_sample_equal(const mp_prof_sample_t *a, const mp_prof_sample_t *b, bool collapsed) {
+    size_t n = collapsed ? MICROPY_PROF_SAMPLING_DEPTH : 1;
+    return memcmp(a->frame, b->frame, n * sizeof(mp_prof_sample_frame_t)) == 0;
+}
+
+void mp_prof_sample_print(const mp_print_t *print, bool collapsed) {
+    mp_prof_sample_t *samples = MP_STATE_VM(prof_samples);
+    size_t n = MIN(MP_STATE_VM(prof_sample_total), MP_STATE_VM(prof_sample_alloc));
+    if (samples == NULL || n == 0) {
+        return;
+    }
+
+    // Fold duplicates into the first occurrence; SIZE_MAX marks folded samples.
+    size_t *counts = m_new(size_t, n);
+    for (size_t i = 0; i < n; ++i) {
+        counts[i] = 0;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (counts[i] == SIZE_MAX) {
+            continue;
+        }
+        counts[i] = 1;
+        for (size_t j = i + 1; j < n; ++j) {
+            if (counts[j] != SIZE_MAX && prof_sample_equal(&samples[i], &samples[j], collapsed)) {
+                counts[i] += 1;
+                counts[j] = SIZE_MAX;
+            }
+        }
+    }
+
+    if (!collapsed) {
+        mp_printf(print, "%u samples, %u shown\n", (uint)MP_STATE_VM(prof_sample_total), (uint)n);
+    }
+    // Most frequent first.
+    for (;;) {
+        size_t best = n;
+        for (size_t i = 0; i < n; ++i) {
+            if (counts[i] != SIZE_MAX && counts[i] != 0 && (best == n || counts[i] > counts[best])) {
+                best = i;
+            }
+        }
+        if (best == n) {
+            break;
+        }
+        const mp_prof_sample_frame_t *frame = samples[best].frame;
+        if (collapsed) {
+            // Outermost frame first, separated by semicolons.
+            size_t depth = MICROPY_PROF_SAMPLING_DEPTH;
+            while (depth > 1 && frame[depth - 1].name == MP_QSTRnull) {
+                --depth;
+            }
+            while (depth-- > 0) {
+                mp_printf(print, "%q:%q:%u%s", frame[depth].file, frame[depth].name, frame[depth].line, depth ? ";" : "");
+            }
+            mp_printf(print, " %u\n", (uint)counts[best]);
+        } else {
+            mp_printf(print, "%6u %q:%u (%q)\n", (uint)counts[best], frame[0].file, frame[0].line, frame[0].name);
+        }
+        counts[best] = 0;
+    }
+    m_del(size_t, counts, n);
+}
+
+#endif // MICROPY_PROF_SAMPLING
@@ -78,4 +78,49 @@ void mp_prof_print_instr(const byte *ip, mp_code_state_t *code_state);
 #endif
 
 #endif // MICROPY_PY_SYS_SETTRACE
+
+#if MICROPY_PROF_FRAME_CHAIN
+
+#if MICROPY_STACKLESS
+#error MICROPY_PROF_FRAME_CHAIN requires !MICROPY_STACKLESS
+#endif
+
+// One frame of a profiler sample.  Unused frames, when the stack was shallower
+// than MICROPY_PROF_SAMPLING_DEPTH, have name == MP_QSTRnull.
+typedef struct _mp_prof_sample_frame_t {
+    qstr_short_t file;
+    qstr_short_t name;
+    uint16_t line;
+} mp_prof_sample_frame_t;
+
+// Fill in the file, function and line that code_state is running.
+void mp_prof_frame_location(const mp_code_state_t *code_state, mp_prof_sample_frame_t *frame);
+
+#endif // MICROPY_PROF_FRAME_CHAIN
+
+#if MICROPY_PROF_SAMPLING
+
+typedef struct _mp_prof_sample_t {
+    // Innermost frame first.
+    mp_prof_sample_frame_t frame[MICROPY_PROF_SAMPLING_DEPTH];
+} mp_prof_sample_t;
+
+// Allocate a ring buffer of n_samples and request a sample every interval
+// calls to mp_prof_sample_tick().  Discards any previous samples.
+void mp_prof_sample_start(size_t n_samples, mp_uint_t interval);
+// Stop taking samples.  The samples already taken are kept.
+void mp_prof_sample_stop(void);
+bool mp_prof_sample_is_running(void);
+
+// Called from the port's periodic interrupt.
+void mp_prof_sample_tick(void);
+
+// Called by the VM once a sample has been requested.
+void mp_prof_sample_take(const mp_code_state_t *code_state);
+
+// Print a histogram of the innermost lines, or collapsed stacks in the form
+// consumed by flamegraph.pl.
+void mp_prof_sample_print(const mp_print_t *print, bool collapsed);
+
+#endif // MICROPY_PROF_SAMPLING
 #endif // MICROPY_INCLUDED_PY_PROFILING_H
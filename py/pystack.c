@@ -34,6 +34,10 @@ void mp_pystack_init(void *start, void *end) {
     MP_STATE_THREAD(pystack_start) = start;
     MP_STATE_THREAD(pystack_end) = end;
     MP_STATE_THREAD(pystack_cur) = start;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_STACK_HIGH_WATER
+    MP_STATE_THREAD(pystack_high_water) = start;
+    #endif
 }
 
 void *PLACE_IN_ITCM(mp_pystack_alloc)(size_t n_bytes) {
@@ -47,6 +51,12 @@ void *PLACE_IN_ITCM(mp_pystack_alloc)(size_t n_bytes) {
     }
     void *ptr = MP_STATE_THREAD(pystack_cur);
     MP_STATE_THREAD(pystack_cur) += n_bytes;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_STACK_HIGH_WATER
+    if (MP_STATE_THREAD(pystack_cur) > MP_STATE_THREAD(pystack_high_water)) {
+        MP_STATE_THREAD(pystack_high_water) = MP_STATE_THREAD(pystack_cur);
+    }
+    #endif
     #if MP_PYSTACK_DEBUG
     *(size_t *)(MP_STATE_THREAD(pystack_cur) - MICROPY_PYSTACK_ALIGN) = n_bytes;
     #endif
@@ -114,6 +114,21 @@ const qstr_pool_t mp_qstr_const_pool = {
     },
 };
 
+#if MICROPY_QSTR_SORTED_INDEX
+// Indices into mp_qstr_const_pool ordered by hash.
+STATIC const qstr_short_t mp_qstr_const_sorted[] = {
+    #ifndef NO_QSTR
+#define QDEF(id, hash, len, str)
+#define TRANSLATION(id, length, compressed ...)
+#define QSORTED(index) index,
+    #include "genhdr/qstrdefs.generated.h"
+#undef QSORTED
+#undef TRANSLATION
+#undef QDEF
+    #endif
+};
+#endif
+
 #ifdef MICROPY_QSTR_EXTRA_POOL
 extern const qstr_pool_t MICROPY_QSTR_EXTRA_POOL;
 #define CONST_POOL MICROPY_QSTR_EXTRA_POOL
@@ -147,6 +162,38 @@ STATIC const qstr_pool_t *PLACE_IN_ITCM(find_qstr)(qstr *q) {
     return pool;
 }
 
+#if MICROPY_QSTR_HASH_INDEX
+// A dynamic pool of alloc entries has a hash index of 1 << bits slots, at
+// least twice as many as entries, stored after its qstrs array.  Each slot
+// holds an entry's index in the pool plus one, or 0 if the slot is free.
+STATIC size_t qstr_index_bits(size_t alloc) {
+    size_t bits = 1;
+    while (((size_t)1 << bits) < alloc * 2) {
+        bits++;
+    }
+    return bits;
+}
+
+STATIC inline qstr_short_t *qstr_index(const qstr_pool_t *pool) {
+    return (qstr_short_t *)(pool->qstrs + pool->alloc);
+}
+
+// Only the low bits of the stored hash vary, so mix in the length and take
+// the top bits of a multiplicative hash.
+STATIC inline size_t qstr_index_slot(size_t hash, size_t len, size_t bits) {
+    return (uint32_t)((hash ^ (len << 16)) * 2654435769u) >> (32 - bits);
+}
+#endif
+
+STATIC size_t qstr_pool_bytes(size_t alloc) {
+    size_t n_bytes = sizeof(qstr_pool_t)
+        + (sizeof(const char *) + sizeof(qstr_hash_t) + sizeof(qstr_len_t)) * alloc;
+    #if MICROPY_QSTR_HASH_INDEX
+    n_bytes += sizeof(qstr_short_t) << qstr_index_bits(alloc);
+    #endif
+    return n_bytes;
+}
+
 // qstr_mutex must be taken while in this function
 STATIC qstr qstr_add(mp_uint_t hash, mp_uint_t len, const char *q_ptr) {
     DEBUG_printf("QSTR: add hash=%d len=%d data=%.*s\n", hash, len, len, q_ptr);
@@ -158,8 +205,11 @@ STATIC qstr qstr_add(mp_uint_t hash, mp_uint_t len, const char *q_ptr) {
         // Put a lower bound on the allocation size in case the extra qstr pool has few entries
         new_alloc = MAX(MICROPY_ALLOC_QSTR_ENTRIES_INIT, new_alloc);
         #endif
-        mp_uint_t pool_size = sizeof(qstr_pool_t)
-            + (sizeof(const char *) + sizeof(qstr_hash_t) + sizeof(qstr_len_t)) * new_alloc;
+        #if MICROPY_QSTR_HASH_INDEX
+        // index slots store the entry index in a qstr_short_t
+        new_alloc = MIN(new_alloc, 0x8000);
+        #endif
+        mp_uint_t pool_size = qstr_pool_bytes(new_alloc);
         qstr_pool_t *pool = (qstr_pool_t *)m_malloc_maybe(pool_size);
         if (pool == NULL) {
             // Keep qstr_last_chunk consistent with qstr_pool_t: qstr_last_chunk is not scanned
@@ -172,6 +222,12 @@ STATIC qstr qstr_add(mp_uint_t hash, mp_uint_t len, const char *q_ptr) {
             m_malloc_fail(new_alloc);
         }
         pool->hashes = (qstr_hash_t *)(pool->qstrs + new_alloc);
+        #if MICROPY_QSTR_HASH_INDEX
+        // the index goes first so it stays aligned
+        size_t index_len = (size_t)1 << qstr_index_bits(new_alloc);
+        pool->hashes = (qstr_hash_t *)((qstr_short_t *)pool->hashes + index_len);
+        memset(pool->qstrs + new_alloc, 0, index_len * sizeof(qstr_short_t));
+        #endif
         pool->lengths = (qstr_len_t *)(pool->hashes + new_alloc);
         pool->prev = MP_STATE_VM(last_pool);
         pool->total_prev_len = MP_STATE_VM(last_pool)->total_prev_len + MP_STATE_VM(last_pool)->len;
@@ -188,6 +244,19 @@ STATIC qstr qstr_add(mp_uint_t hash, mp_uint_t len, const char *q_ptr) {
     MP_STATE_VM(last_pool)->qstrs[at] = q_ptr;
     MP_STATE_VM(last_pool)->len++;
 
+    #if MICROPY_QSTR_HASH_INDEX
+    if (MP_STATE_VM(last_pool) != &CONST_POOL) {
+        qstr_short_t *index = qstr_index(MP_STATE_VM(last_pool));
+        size_t bits = qstr_index_bits(MP_STATE_VM(last_pool)->alloc);
+        size_t mask = ((size_t)1 << bits) - 1;
+        size_t slot = qstr_index_slot(hash, len, bits);
+        while (index[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        index[slot] = at + 1;
+    }
+    #endif
+
     // return id for the newly-added qstr
     return MP_STATE_VM(last_pool)->total_prev_len + at;
 }
@@ -197,7 +266,53 @@ qstr qstr_find_strn(const char *str, size_t str_len) {
     size_t str_hash = qstr_compute_hash((const byte *)str, str_len);
 
     // search pools for the data
+    #if MICROPY_QSTR_HASH_INDEX
+    bool dynamic = true;
+    #endif
     for (const qstr_pool_t *pool = MP_STATE_VM(last_pool); pool != NULL; pool = pool->prev) {
+        #if MICROPY_QSTR_HASH_INDEX
+        if (pool == &CONST_POOL) {
+            dynamic = false;
+        }
+        if (dynamic) {
+            const qstr_short_t *index = qstr_index(pool);
+            size_t bits = qstr_index_bits(pool->alloc);
+            size_t mask = ((size_t)1 << bits) - 1;
+            for (size_t slot = qstr_index_slot(str_hash, str_len, bits); index[slot] != 0; slot = (slot + 1) & mask) {
+                mp_uint_t at = index[slot] - 1;
+                if (pool->hashes[at] == str_hash && pool->lengths[at] == str_len
+                    && memcmp(pool->qstrs[at], str, str_len) == 0) {
+                    return pool->total_prev_len + at;
+                }
+            }
+            continue;
+        }
+        #endif
+        #if MICROPY_QSTR_SORTED_INDEX
+        if (pool == &mp_qstr_const_pool) {
+            // find the first entry with this hash, then check all entries sharing it
+            size_t lo = 0;
+            size_t hi = MP_ARRAY_SIZE(mp_qstr_const_sorted);
+            while (lo < hi) {
+                size_t mid = lo + (hi - lo) / 2;
+                if (pool->hashes[mp_qstr_const_sorted[mid]] < str_hash) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            for (; lo < MP_ARRAY_SIZE(mp_qstr_const_sorted); lo++) {
+                mp_uint_t at = mp_qstr_const_sorted[lo];
+                if (pool->hashes[at] != str_hash) {
+                    break;
+                }
+                if (pool->lengths[at] == str_len && memcmp(pool->qstrs[at], str, str_len) == 0) {
+                    return at;
+                }
+            }
+            continue;
+        }
+        #endif
         for (mp_uint_t at = 0, top = pool->len; at < top; at++) {
             if (pool->hashes[at] == str_hash && pool->lengths[at] == str_len
                 && memcmp(pool->qstrs[at], str, str_len) == 0) {
@@ -276,6 +391,25 @@ qstr qstr_from_strn(const char *str, size_t len) {
     return q;
 }
 
+#if MICROPY_PERSISTENT_CODE_LOAD_XIP
+// Like qstr_from_strn, but str must be null terminated and stay valid forever,
+// so it is referenced in place instead of being copied into a chunk.
+qstr qstr_from_strn_static(const char *str, size_t len) {
+    QSTR_ENTER();
+    qstr q = qstr_find_strn(str, len);
+    if (q == 0) {
+        if (len >= (1 << (8 * MICROPY_QSTR_BYTES_IN_LEN))) {
+            QSTR_EXIT();
+            mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("Name too long"));
+        }
+        size_t hash = qstr_compute_hash((const byte *)str, len);
+        q = qstr_add(hash, len, str);
+    }
+    QSTR_EXIT();
+    return q;
+}
+#endif
+
 mp_uint_t qstr_hash(qstr q) {
     const qstr_pool_t *pool = find_qstr(&q);
     return pool->hashes[q];
@@ -312,8 +446,7 @@ void qstr_pool_info(size_t *n_pool, size_t *n_qstr, size_t *n_str_data_bytes, si
         #if MICROPY_ENABLE_GC
         *n_total_bytes += gc_nbytes(pool); // this counts actual bytes used in heap
         #else
-        *n_total_bytes += sizeof(qstr_pool_t)
-            + (sizeof(const char *) + sizeof(qstr_hash_t) + sizeof(qstr_len_t)) * pool->alloc;
+        *n_total_bytes += qstr_pool_bytes(pool->alloc);
         #endif
     }
     *n_total_bytes += *n_str_data_bytes;
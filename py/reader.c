@@ -67,6 +67,21 @@ void mp_reader_new_mem(mp_reader_t *reader, const byte *buf, size_t len, size_t
     reader->close = mp_reader_mem_close;
 }
 
+#if MICROPY_PERSISTENT_CODE_LOAD_XIP
+const byte *mp_reader_try_read_xip(mp_reader_t *reader, size_t len) {
+    if (reader->readbyte != mp_reader_mem_readbyte) {
+        return NULL;
+    }
+    mp_reader_mem_t *rm = (mp_reader_mem_t *)reader->data;
+    if (rm->free_len > 0 || (size_t)(rm->end - rm->cur) < len) {
+        return NULL;
+    }
+    const byte *buf = rm->cur;
+    rm->cur += len;
+    return buf;
+}
+#endif
+
 #if MICROPY_READER_POSIX
 
 #include <sys/stat.h>
@@ -43,4 +43,11 @@ void mp_reader_new_mem(mp_reader_t *reader, const byte *buf, size_t len, size_t
 void mp_reader_new_file(mp_reader_t *reader, const char *filename);
 void mp_reader_new_file_from_fd(mp_reader_t *reader, int fd, bool close_fd);
 
+#if MICROPY_PERSISTENT_CODE_LOAD_XIP
+// Return a pointer to the next len bytes and skip over them, if the reader is
+// reading from memory that stays valid and unchanged forever (a memory reader
+// with free_len == 0).  Otherwise return NULL and leave the reader untouched.
+const byte *mp_reader_try_read_xip(mp_reader_t *reader, size_t len);
+#endif
+
 #endif // MICROPY_INCLUDED_PY_READER_H
@@ -8,6 +8,9 @@
 
 // CIRCUITPY-CHANGE: thoroughly reworked
 
+#include <string.h>
+
+#include "py/misc.h"
 #include "ringbuf.h"
 
 bool ringbuf_init(ringbuf_t *r, uint8_t *buf, size_t size) {
@@ -102,24 +105,147 @@ size_t ringbuf_num_filled(ringbuf_t *r) {
 // If the ring buffer fills up, not all bytes will be written.
 // Returns how many bytes were successfully written.
 size_t ringbuf_put_n(ringbuf_t *r, const uint8_t *buf, size_t bufsize) {
-    for (size_t i = 0; i < bufsize; i++) {
-        if (ringbuf_put(r, buf[i]) < 0) {
-            // If ringbuf is full, give up and return how many bytes
-            // we wrote so far.
-            return i;
-        }
+    size_t n = MIN(bufsize, r->size - r->used);
+    // Copy up to the end of the storage, then the rest from the start.
+    size_t first = MIN(n, r->size - r->next_write);
+    memcpy(r->buf + r->next_write, buf, first);
+    memcpy(r->buf, buf + first, n - first);
+    r->next_write += n;
+    if (r->next_write >= r->size) {
+        r->next_write -= r->size;
     }
-    return bufsize;
+    r->used += n;
+    return n;
 }
 
 // Returns how many bytes were fetched.
 size_t ringbuf_get_n(ringbuf_t *r, uint8_t *buf, size_t bufsize) {
-    for (size_t i = 0; i < bufsize; i++) {
-        int b = ringbuf_get(r);
-        if (b < 0) {
-            return i;
-        }
-        buf[i] = b;
+    size_t n = MIN(bufsize, r->used);
+    size_t first = MIN(n, r->size - r->next_read);
+    memcpy(buf, r->buf + r->next_read, first);
+    memcpy(buf + first, r->buf, n - first);
+    r->next_read += n;
+    if (r->next_read >= r->size) {
+        r->next_read -= r->size;
+    }
+    r->used -= n;
+    return n;
+}
+
+// Single producer, single consumer ring buffer.
+//
+// next_read and next_write count over twice the size, so a full buffer
+// (they differ by size) can be told from an empty one (they are equal)
+// without a count that both sides write. Each side only ever writes its own
+// index. It loads the other side's index with acquire ordering, so the bytes
+// published before that index was stored are visible, and stores its own
+// with release ordering, after it has finished with the bytes.
+
+static inline uint32_t spsc_load(volatile uint32_t *index) {
+    return __atomic_load_n(index, __ATOMIC_ACQUIRE);
+}
+
+static inline void spsc_store(volatile uint32_t *index, uint32_t value) {
+    __atomic_store_n(index, value, __ATOMIC_RELEASE);
+}
+
+static inline uint32_t spsc_filled(const ringbuf_spsc_t *r, uint32_t next_read, uint32_t next_write) {
+    return next_write >= next_read ? next_write - next_read : next_write + 2 * r->size - next_read;
+}
+
+static inline uint32_t spsc_offset(const ringbuf_spsc_t *r, uint32_t index) {
+    return index >= r->size ? index - r->size : index;
+}
+
+static inline uint32_t spsc_advance(const ringbuf_spsc_t *r, uint32_t index, size_t n) {
+    index += n;
+    return index >= 2 * r->size ? index - 2 * r->size : index;
+}
+
+bool ringbuf_spsc_init(ringbuf_spsc_t *r, uint8_t *buf, size_t size) {
+    r->buf = buf;
+    r->size = size;
+    r->next_read = 0;
+    r->next_write = 0;
+    return r->buf != NULL;
+}
+
+bool ringbuf_spsc_alloc(ringbuf_spsc_t *r, size_t size) {
+    return ringbuf_spsc_init(r, m_malloc(size), size);
+}
+
+void ringbuf_spsc_deinit(ringbuf_spsc_t *r) {
+    // As for ringbuf_deinit(), the gc frees buf. The producer must have stopped.
+    r->buf = (uint8_t *)NULL;
+    r->size = 0;
+    r->next_read = 0;
+    r->next_write = 0;
+}
+
+// Consumer side: drop everything written so far.
+void ringbuf_spsc_clear(ringbuf_spsc_t *r) {
+    spsc_store(&r->next_read, spsc_load(&r->next_write));
+}
+
+size_t ringbuf_spsc_num_filled(ringbuf_spsc_t *r) {
+    return spsc_filled(r, spsc_load(&r->next_read), spsc_load(&r->next_write));
+}
+
+size_t ringbuf_spsc_num_empty(ringbuf_spsc_t *r) {
+    return r->size - ringbuf_spsc_num_filled(r);
+}
+
+// Return -1 if buffer is empty, else return byte fetched.
+int ringbuf_spsc_get(ringbuf_spsc_t *r) {
+    uint8_t v;
+    if (ringbuf_spsc_get_n(r, &v, 1) == 0) {
+        return -1;
+    }
+    return v;
+}
+
+// Return -1 if no room in buffer, else return 0.
+int ringbuf_spsc_put(ringbuf_spsc_t *r, uint8_t v) {
+    return ringbuf_spsc_put_n(r, &v, 1) == 1 ? 0 : -1;
+}
+
+// Consumer side: copy up to bufsize bytes from offset bytes into the filled
+// data, without consuming them. Returns how many bytes were copied.
+size_t ringbuf_spsc_peek_n(ringbuf_spsc_t *r, size_t offset, uint8_t *buf, size_t bufsize) {
+    uint32_t next_read = r->next_read;
+    size_t filled = spsc_filled(r, next_read, spsc_load(&r->next_write));
+    if (offset >= filled) {
+        return 0;
+    }
+    size_t n = MIN(bufsize, filled - offset);
+    uint32_t start = spsc_offset(r, spsc_advance(r, next_read, offset));
+    size_t first = MIN(n, r->size - start);
+    memcpy(buf, r->buf + start, first);
+    memcpy(buf + first, r->buf, n - first);
+    return n;
+}
+
+// Consumer side. Returns how many bytes were fetched.
+size_t ringbuf_spsc_get_n(ringbuf_spsc_t *r, uint8_t *buf, size_t bufsize) {
+    size_t n = ringbuf_spsc_peek_n(r, 0, buf, bufsize);
+    if (n > 0) {
+        spsc_store(&r->next_read, spsc_advance(r, r->next_read, n));
+    }
+    return n;
+}
+
+// Producer side. Writes all of buf, or nothing if there is not room for it,
+// so a consumer never sees part of a record. Returns how many bytes were
+// written.
+size_t ringbuf_spsc_put_n(ringbuf_spsc_t *r, const uint8_t *buf, size_t bufsize) {
+    uint32_t next_write = r->next_write;
+    if (bufsize > r->size - spsc_filled(r, spsc_load(&r->next_read), next_write)) {
+        return 0;
     }
+    uint32_t start = spsc_offset(r, next_write);
+    size_t first = MIN(bufsize, r->size - start);
+    memcpy(r->buf + start, buf, first);
+    memcpy(r->buf, buf + first, bufsize - first);
+    spsc_store(&r->next_write, spsc_advance(r, next_write, bufsize));
     return bufsize;
 }
@@ -47,3 +47,34 @@ int ringbuf_put16(ringbuf_t *r, uint16_t v);
 
 int ringbuf_get_bytes(ringbuf_t *r, uint8_t *data, size_t data_len);
 int ringbuf_put_bytes(ringbuf_t *r, const uint8_t *data, size_t data_len);
+
+// A ring buffer for one producer and one consumer that run concurrently,
+// such as an interrupt handler or another task filling it while the VM
+// drains it. No locking is needed: each side updates only its own index,
+// atomically, after it has copied the data. Nothing else may touch it, so it
+// is not a fit when both the VM and an interrupt write to the same buffer.
+typedef struct _ringbuf_spsc_t {
+    uint8_t *buf;
+    uint32_t size;
+    // Run from 0 to 2 * size - 1. Written only by the consumer and producer respectively.
+    volatile uint32_t next_read;
+    volatile uint32_t next_write;
+} ringbuf_spsc_t;
+
+bool ringbuf_spsc_init(ringbuf_spsc_t *r, uint8_t *buf, size_t capacity);
+bool ringbuf_spsc_alloc(ringbuf_spsc_t *r, size_t capacity);
+void ringbuf_spsc_deinit(ringbuf_spsc_t *r);
+
+// Either side.
+size_t ringbuf_spsc_num_empty(ringbuf_spsc_t *r);
+size_t ringbuf_spsc_num_filled(ringbuf_spsc_t *r);
+
+// Consumer side only.
+int ringbuf_spsc_get(ringbuf_spsc_t *r);
+size_t ringbuf_spsc_get_n(ringbuf_spsc_t *r, uint8_t *buf, size_t bufsize);
+size_t ringbuf_spsc_peek_n(ringbuf_spsc_t *r, size_t offset, uint8_t *buf, size_t bufsize);
+void ringbuf_spsc_clear(ringbuf_spsc_t *r);
+
+// Producer side only. put_n writes all of buf or nothing.
+int ringbuf_spsc_put(ringbuf_spsc_t *r, uint8_t v);
+size_t ringbuf_spsc_put_n(ringbuf_spsc_t *r, const uint8_t *buf, size_t bufsize);
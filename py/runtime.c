@@ -60,12 +60,15 @@
 #define DEBUG_OP_printf(...) (void)0
 #endif
 
+// CIRCUITPY-CHANGE: with a VM per thread, __main__ is set up by mp_init() instead.
+#if !MICROPY_STATE_PER_THREAD
 const mp_obj_module_t mp_module___main__ = {
     .base = { &mp_type_module },
     .globals = (mp_obj_dict_t *)&MP_STATE_VM(dict_main),
 };
 
 MP_REGISTER_MODULE(MP_QSTR___main__, mp_module___main__);
+#endif
 
 #define TYPE_HAS_ITERNEXT(type) (type->flags & (MP_TYPE_FLAG_ITER_IS_ITERNEXT | MP_TYPE_FLAG_ITER_IS_CUSTOM | MP_TYPE_FLAG_ITER_IS_STREAM))
 
@@ -85,6 +88,10 @@ void mp_init(void) {
     #endif
     MP_STATE_VM(sched_idx) = 0;
     MP_STATE_VM(sched_len) = 0;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_SCHEDULER_PRIORITY
+    MP_STATE_VM(sched_len_high) = 0;
+    #endif
     #endif
 
     #if MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF
@@ -99,6 +106,25 @@ void mp_init(void) {
 
     mp_obj_exception_initialize0(&MP_STATE_VM(mp_reload_exception), &mp_type_ReloadException);
 
+    #if MICROPY_OPT_LOAD_ATTR_INLINE_CACHE
+    // forget instructions from the previous VM so stale builtin markers don't linger
+    memset(MP_STATE_VM(inline_cache), 0, sizeof(MP_STATE_VM(inline_cache)));
+    #endif
+
+    // CIRCUITPY-CHANGE: compiled struct formats from the previous VM are gone
+    #if CIRCUITPY_STRUCT
+    MP_STATE_VM(struct_cache) = NULL;
+    #endif
+
+    // CIRCUITPY-CHANGE: and so are compiled regexes
+    #if MICROPY_PY_RE && MICROPY_PY_RE_CACHE_SIZE
+    memset(MP_STATE_VM(re_cache), 0, sizeof(MP_STATE_VM(re_cache)));
+    #endif
+
+    #if MICROPY_GC_MOVABLE
+    MP_STATE_VM(gc_movable_table) = NULL;
+    #endif
+
     // call port specific initialization if any
     #ifdef MICROPY_PORT_INIT_FUNC
     MICROPY_PORT_INIT_FUNC;
@@ -118,6 +144,12 @@ void mp_init(void) {
     // initialise the __main__ module
     mp_obj_dict_init(&MP_STATE_VM(dict_main), 1);
     mp_obj_dict_store(MP_OBJ_FROM_PTR(&MP_STATE_VM(dict_main)), MP_OBJ_NEW_QSTR(MP_QSTR___name__), MP_OBJ_NEW_QSTR(MP_QSTR___main__));
+    // CIRCUITPY-CHANGE
+    #if MICROPY_STATE_PER_THREAD
+    MP_STATE_VM(module_main).base.type = &mp_type_module;
+    MP_STATE_VM(module_main).globals = &MP_STATE_VM(dict_main);
+    mp_obj_dict_store(MP_OBJ_FROM_PTR(&MP_STATE_VM(mp_loaded_modules_dict)), MP_OBJ_NEW_QSTR(MP_QSTR___main__), MP_OBJ_FROM_PTR(&MP_STATE_VM(module_main)));
+    #endif
 
     // locals = globals for outer module (see Objects/frameobject.c/PyFrame_New())
     mp_locals_set(&MP_STATE_VM(dict_main));
@@ -173,6 +205,23 @@ void mp_init(void) {
     MP_STATE_THREAD(current_code_state) = NULL;
     #endif
 
+    #if MICROPY_PROF_SAMPLING
+    MP_STATE_VM(prof_sample_interval) = 0;
+    MP_STATE_VM(prof_sample_pending) = false;
+    MP_STATE_VM(prof_samples) = NULL;
+    MP_STATE_VM(prof_sample_total) = 0;
+    #endif
+
+    #if MICROPY_PROF_FRAME_CHAIN
+    MP_STATE_THREAD(prof_sample_code_state) = NULL;
+    #endif
+
+    // CIRCUITPY-CHANGE
+    #if MICROPY_MODULE_IMPORT_STATS
+    MP_STATE_VM(import_stats_len) = 0;
+    MP_STATE_VM(import_stats_timer) = NULL;
+    #endif
+
     #if MICROPY_PY_SYS_TRACEBACKLIMIT
     MP_STATE_VM(sys_mutable[MP_SYS_MUTABLE_TRACEBACKLIMIT]) = MP_OBJ_NEW_SMALL_INT(1000);
     #endif
@@ -231,23 +280,30 @@ mp_obj_t MICROPY_WRAP_MP_LOAD_GLOBAL(mp_load_global)(qstr qst) {
     DEBUG_OP_printf("load global %s\n", qstr_str(qst));
     mp_map_elem_t *elem = mp_map_lookup(&mp_globals_get()->map, MP_OBJ_NEW_QSTR(qst), MP_MAP_LOOKUP);
     if (elem == NULL) {
-        #if MICROPY_CAN_OVERRIDE_BUILTINS
-        if (MP_STATE_VM(mp_module_builtins_override_dict) != NULL) {
-            // lookup in additional dynamic table of builtins first
-            elem = mp_map_lookup(&MP_STATE_VM(mp_module_builtins_override_dict)->map, MP_OBJ_NEW_QSTR(qst), MP_MAP_LOOKUP);
-            if (elem != NULL) {
-                return elem->value;
-            }
+        // CIRCUITPY-CHANGE: split out for the VM's global lookup cache
+        return mp_load_builtin(qst);
+    }
+    return elem->value;
+}
+
+// CIRCUITPY-CHANGE
+mp_obj_t mp_load_builtin(qstr qst) {
+    #if MICROPY_CAN_OVERRIDE_BUILTINS
+    if (MP_STATE_VM(mp_module_builtins_override_dict) != NULL) {
+        // lookup in additional dynamic table of builtins first
+        mp_map_elem_t *elem = mp_map_lookup(&MP_STATE_VM(mp_module_builtins_override_dict)->map, MP_OBJ_NEW_QSTR(qst), MP_MAP_LOOKUP);
+        if (elem != NULL) {
+            return elem->value;
         }
+    }
+    #endif
+    mp_map_elem_t *elem = mp_map_lookup((mp_map_t *)&mp_module_builtins_globals.map, MP_OBJ_NEW_QSTR(qst), MP_MAP_LOOKUP);
+    if (elem == NULL) {
+        #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
+        mp_raise_msg(&mp_type_NameError, MP_ERROR_TEXT("name not defined"));
+        #else
+        mp_raise_msg_varg(&mp_type_NameError, MP_ERROR_TEXT("name '%q' is not defined"), qst);
         #endif
-        elem = mp_map_lookup((mp_map_t *)&mp_module_builtins_globals.map, MP_OBJ_NEW_QSTR(qst), MP_MAP_LOOKUP);
-        if (elem == NULL) {
-            #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
-            mp_raise_msg(&mp_type_NameError, MP_ERROR_TEXT("name not defined"));
-            #else
-            mp_raise_msg_varg(&mp_type_NameError, MP_ERROR_TEXT("name '%q' is not defined"), qst);
-            #endif
-        }
     }
     return elem->value;
 }
@@ -1712,6 +1768,11 @@ mp_obj_t mp_parse_compile_execute(mp_lexer_t *lex, mp_parse_input_kind_t parse_i
     mp_parse_tree_t parse_tree = mp_parse(lex, parse_input_kind);
     mp_obj_t module_fun = mp_compile(&parse_tree, source_name, parse_input_kind == MP_PARSE_SINGLE_INPUT);
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_MODULE_IMPORT_STATS
+    mp_import_stats_loaded();
+    #endif
+
     mp_obj_t ret;
     if (MICROPY_PY_BUILTINS_COMPILE && globals == NULL) {
         // for compile only, return value is the module function
@@ -1728,6 +1789,43 @@ mp_obj_t mp_parse_compile_execute(mp_lexer_t *lex, mp_parse_input_kind_t parse_i
     return ret;
 }
 
+// CIRCUITPY-CHANGE
+#if MICROPY_COMPILE_BY_STATEMENT
+void mp_parse_compile_execute_by_statement(mp_lexer_t *lex, mp_obj_dict_t *globals) {
+    // save context
+    nlr_jump_callback_node_globals_locals_t ctx;
+    ctx.globals = mp_globals_get();
+    ctx.locals = mp_locals_get();
+
+    // set new context
+    mp_globals_set(globals);
+    mp_locals_set(globals);
+
+    // set exception handler to restore context if an exception is raised
+    nlr_push_jump_callback(&ctx.callback, mp_globals_locals_set_from_nlr_jump_callback);
+
+    qstr source_name = lex->source_name;
+    mp_parse_stmt_t stmt_parser;
+    mp_parse_stmt_init(&stmt_parser, lex);
+
+    // free the lexer if an exception is raised
+    MP_DEFINE_NLR_JUMP_CALLBACK_FUNCTION_1(stmt_ctx, mp_parse_stmt_deinit, &stmt_parser);
+    nlr_push_jump_callback(&stmt_ctx.callback, mp_call_function_1_from_nlr_jump_callback);
+
+    mp_parse_tree_t parse_tree;
+    while (mp_parse_stmt_next(&stmt_parser, &parse_tree)) {
+        // mp_compile() frees the parse tree, so only one statement's tree is
+        // alive at a time.
+        mp_obj_t module_fun = mp_compile(&parse_tree, source_name, false);
+        mp_call_function_0(module_fun);
+    }
+
+    // deregister exception handlers, free the lexer and restore context
+    nlr_pop_jump_callback(true);
+    nlr_pop_jump_callback(true);
+}
+#endif
+
 #endif // MICROPY_ENABLE_COMPILER
 
 // CIRCUITPY-CHANGE: MP_COLD are CIRCUITPY
@@ -1895,7 +1993,12 @@ NORETURN MP_COLD void mp_raise_type_arg(const mp_obj_type_t *exc_type, mp_obj_t
 // Leave this as not COLD because it is used by iterators in normal execution.
 NORETURN void mp_raise_StopIteration(mp_obj_t arg) {
     if (arg == MP_OBJ_NULL) {
+        // CIRCUITPY-CHANGE
+        #if MICROPY_STATIC_CONTROL_FLOW_EXCEPTIONS
+        nlr_raise(MP_OBJ_FROM_PTR(&mp_static_StopIteration_obj));
+        #else
         mp_raise_type(&mp_type_StopIteration);
+        #endif
     } else {
         mp_raise_type_arg(&mp_type_StopIteration, arg);
     }
@@ -1912,6 +2015,12 @@ NORETURN void mp_raise_TypeError_int_conversion(mp_const_obj_t arg) {
 }
 
 NORETURN MP_COLD void mp_raise_OSError(int errno_) {
+    // CIRCUITPY-CHANGE
+    #if MICROPY_STATIC_CONTROL_FLOW_EXCEPTIONS
+    if (errno_ == MP_EAGAIN) {
+        nlr_raise(MP_OBJ_FROM_PTR(&mp_static_OSError_EAGAIN_obj));
+    }
+    #endif
     mp_raise_type_arg(&mp_type_OSError, MP_OBJ_NEW_SMALL_INT(errno_));
 }
 
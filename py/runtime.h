@@ -112,6 +112,16 @@ void mp_sched_lock(void);
 void mp_sched_unlock(void);
 #define mp_sched_num_pending() (MP_STATE_VM(sched_len))
 bool mp_sched_schedule(mp_obj_t function, mp_obj_t arg);
+// CIRCUITPY-CHANGE
+#if MICROPY_SCHEDULER_PRIORITY
+// Flags for mp_sched_schedule_ex().
+// Run before any normal priority callback that is waiting.
+#define MP_SCHED_HIGH_PRIORITY (1)
+// Merge with a waiting call of the same function and arg, which is then
+// called as function(arg, count) with the number of schedules merged.
+#define MP_SCHED_COALESCE (2)
+bool mp_sched_schedule_ex(mp_obj_t function, mp_obj_t arg, unsigned int flags);
+#endif
 bool mp_sched_schedule_node(mp_sched_node_t *node, mp_sched_callback_t callback);
 #endif
 
@@ -168,6 +178,8 @@ void mp_call_function_1_from_nlr_jump_callback(void *ctx_in);
 
 mp_obj_t mp_load_name(qstr qst);
 mp_obj_t mp_load_global(qstr qst);
+// CIRCUITPY-CHANGE: the part of mp_load_global after globals has been searched
+mp_obj_t mp_load_builtin(qstr qst);
 mp_obj_t mp_load_build_class(void);
 void mp_store_name(qstr qst, mp_obj_t obj);
 void mp_store_global(qstr qst, mp_obj_t obj);
@@ -102,6 +102,34 @@ static inline void mp_sched_run_pending(void) {
     }
     #endif
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_SCHEDULER_PRIORITY
+    // Run the high priority Python callbacks that are pending, which are at
+    // the front of the queue, then at most one normal priority one. The limit
+    // stops a high priority callback that reschedules itself from running
+    // forever.
+    uint8_t budget = MP_STATE_VM(sched_len_high) + 1;
+    while (budget-- > 0 && !mp_sched_empty()) {
+        mp_sched_item_t item = MP_STATE_VM(sched_queue)[MP_STATE_VM(sched_idx)];
+        MP_STATE_VM(sched_idx) = IDX_MASK(MP_STATE_VM(sched_idx) + 1);
+        --MP_STATE_VM(sched_len);
+        bool high = MP_STATE_VM(sched_len_high) > 0;
+        if (high) {
+            --MP_STATE_VM(sched_len_high);
+        }
+        MICROPY_END_ATOMIC_SECTION(atomic_state);
+        if (item.flags & MP_SCHED_COALESCE) {
+            mp_call_function_2_protected(item.func, item.arg, MP_OBJ_NEW_SMALL_INT(item.count));
+        } else {
+            mp_call_function_1_protected(item.func, item.arg);
+        }
+        atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+        if (!high) {
+            break;
+        }
+    }
+    MICROPY_END_ATOMIC_SECTION(atomic_state);
+    #else
     // Run at most one pending Python callback.
     if (!mp_sched_empty()) {
         mp_sched_item_t item = MP_STATE_VM(sched_queue)[MP_STATE_VM(sched_idx)];
@@ -112,6 +140,7 @@ static inline void mp_sched_run_pending(void) {
     } else {
         MICROPY_END_ATOMIC_SECTION(atomic_state);
     }
+    #endif
 
     // Restore MP_STATE_VM(sched_state) to idle (or pending if there are still
     // tasks in the queue).
@@ -157,6 +186,10 @@ void mp_sched_unlock(void) {
 }
 
 bool MICROPY_WRAP_MP_SCHED_SCHEDULE(mp_sched_schedule)(mp_obj_t function, mp_obj_t arg) {
+    // CIRCUITPY-CHANGE
+    #if MICROPY_SCHEDULER_PRIORITY
+    return mp_sched_schedule_ex(function, arg, 0);
+    #else
     mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
     bool ret;
     if (!mp_sched_full()) {
@@ -174,7 +207,56 @@ bool MICROPY_WRAP_MP_SCHED_SCHEDULE(mp_sched_schedule)(mp_obj_t function, mp_obj
     }
     MICROPY_END_ATOMIC_SECTION(atomic_state);
     return ret;
+    #endif
+}
+
+// CIRCUITPY-CHANGE
+#if MICROPY_SCHEDULER_PRIORITY
+bool MICROPY_WRAP_MP_SCHED_SCHEDULE(mp_sched_schedule_ex)(mp_obj_t function, mp_obj_t arg, unsigned int flags) {
+    mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    bool high = flags & MP_SCHED_HIGH_PRIORITY;
+    // The items waiting at the same priority are queue positions first to last - 1.
+    uint8_t first = high ? 0 : MP_STATE_VM(sched_len_high);
+    uint8_t last = high ? MP_STATE_VM(sched_len_high) : MP_STATE_VM(sched_len);
+    if (flags & MP_SCHED_COALESCE) {
+        for (uint8_t i = first; i < last; i++) {
+            mp_sched_item_t *item = &MP_STATE_VM(sched_queue)[IDX_MASK(MP_STATE_VM(sched_idx) + i)];
+            if ((item->flags & MP_SCHED_COALESCE) && item->func == function && item->arg == arg) {
+                if (item->count < UINT16_MAX) {
+                    item->count++;
+                }
+                MICROPY_END_ATOMIC_SECTION(atomic_state);
+                return true;
+            }
+        }
+    }
+    if (mp_sched_full()) {
+        // schedule queue is full
+        MICROPY_END_ATOMIC_SECTION(atomic_state);
+        return false;
+    }
+    if (MP_STATE_VM(sched_state) == MP_SCHED_IDLE) {
+        MP_STATE_VM(sched_state) = MP_SCHED_PENDING;
+    }
+    // Move the items after this priority back one to make room.
+    for (uint8_t i = MP_STATE_VM(sched_len); i > last; i--) {
+        MP_STATE_VM(sched_queue)[IDX_MASK(MP_STATE_VM(sched_idx) + i)] =
+            MP_STATE_VM(sched_queue)[IDX_MASK(MP_STATE_VM(sched_idx) + i - 1)];
+    }
+    mp_sched_item_t *item = &MP_STATE_VM(sched_queue)[IDX_MASK(MP_STATE_VM(sched_idx) + last)];
+    item->func = function;
+    item->arg = arg;
+    item->count = 1;
+    item->flags = flags;
+    MP_STATE_VM(sched_len)++;
+    if (high) {
+        MP_STATE_VM(sched_len_high)++;
+    }
+    MICROPY_SCHED_HOOK_SCHEDULED;
+    MICROPY_END_ATOMIC_SECTION(atomic_state);
+    return true;
 }
+#endif
 
 #if MICROPY_SCHEDULER_STATIC_NODES
 bool mp_sched_schedule_node(mp_sched_node_t *node, mp_sched_callback_t callback) {
@@ -526,6 +526,16 @@ const byte *mp_bytecode_print_str(const mp_print_t *print, const byte *ip_start,
             mp_printf(print, "IMPORT_STAR");
             break;
 
+        case MP_BC_BINARY_OP_FAST_SMALL_INT:
+        case MP_BC_INPLACE_OP_FAST_SMALL_INT: {
+            const char *name = ip[-1] == MP_BC_BINARY_OP_FAST_SMALL_INT ? "BINARY_OP_FAST_SMALL_INT" : "INPLACE_OP_FAST_SMALL_INT";
+            DECODE_UINT;
+            mp_uint_t op = MP_BC_FUSED_DECODE_OP(unum);
+            mp_printf(print, "%s " UINT_FMT " " INT_FMT " " UINT_FMT " %s", name,
+                (mp_uint_t)MP_BC_FUSED_DECODE_LOCAL(unum), MP_BC_FUSED_DECODE_INT(unum), op, qstr_str(mp_binary_op_method_name[op]));
+            break;
+        }
+
         default:
             if (ip[-1] < MP_BC_LOAD_CONST_SMALL_INT_MULTI + 64) {
                 mp_printf(print, "LOAD_CONST_SMALL_INT " INT_FMT, (mp_int_t)ip[-1] - MP_BC_LOAD_CONST_SMALL_INT_MULTI - 16);
@@ -39,10 +39,18 @@ void mp_stack_ctrl_init(void) {
     #if __GNUC__ >= 13
     #pragma GCC diagnostic pop
     #endif
+    // CIRCUITPY-CHANGE
+    #if MICROPY_STACK_CHECK && MICROPY_STACK_HIGH_WATER
+    MP_STATE_THREAD(stack_high_water) = 0;
+    #endif
 }
 
 void mp_stack_set_top(void *top) {
     MP_STATE_THREAD(stack_top) = top;
+    // CIRCUITPY-CHANGE
+    #if MICROPY_STACK_CHECK && MICROPY_STACK_HIGH_WATER
+    MP_STATE_THREAD(stack_high_water) = 0;
+    #endif
 }
 
 mp_uint_t PLACE_IN_ITCM(mp_stack_usage)(void) {
@@ -60,9 +68,20 @@ void mp_stack_set_limit(mp_uint_t limit) {
 }
 
 void PLACE_IN_ITCM(mp_stack_check)(void) {
+    // CIRCUITPY-CHANGE
+    #if MICROPY_STACK_HIGH_WATER
+    mp_uint_t usage = mp_stack_usage();
+    if (usage > MP_STATE_THREAD(stack_high_water)) {
+        MP_STATE_THREAD(stack_high_water) = usage;
+    }
+    if (usage >= MP_STATE_THREAD(stack_limit)) {
+        mp_raise_recursion_depth();
+    }
+    #else
     if (mp_stack_usage() >= MP_STATE_THREAD(stack_limit)) {
         mp_raise_recursion_depth();
     }
+    #endif
 }
 
 #endif // MICROPY_STACK_CHECK
@@ -45,6 +45,8 @@
 #define MP_STREAM_GET_DATA_OPTS (8)  // Get data/message options
 #define MP_STREAM_SET_DATA_OPTS (9)  // Set data/message options
 #define MP_STREAM_GET_FILENO    (10) // Get fileno of underlying file
+#define MP_STREAM_GET_XIP_ADDR  (11) // Get address of memory-mapped contents, see below
+#define MP_STREAM_GET_POLL_GEN  (12) // Get readiness change counter, see below
 
 // These poll ioctl values are compatible with Linux
 #define MP_STREAM_POLL_RD       (0x0001)
@@ -62,6 +64,27 @@ struct mp_stream_seek_t {
     int whence;
 };
 
+// MP_STREAM_GET_XIP_ADDR: arg points to a const byte * which is set to the
+// address of the whole contents of a read-only stream, if they are memory
+// mapped and won't change.  Returns the length.  Callers must initialise the
+// pointer to NULL and ignore the result if it stays NULL.
+
+// Argument structure for MP_STREAM_GET_POLL_GEN.  A stream that can tell when
+// its poll state changes fills in a counter that it increments (with
+// mp_stream_poll_gen_bump, possibly from an interrupt) whenever any of the
+// given events, or ERR/HUP, may have gone from not-ready to ready.  Pollers can
+// then skip MP_STREAM_POLL while the counter is unchanged and the stream was
+// not ready last time.  Callers must initialise counter to NULL and ignore the
+// result if it stays NULL.
+typedef struct _mp_stream_poll_gen_t {
+    const volatile mp_uint_t *counter;
+    mp_uint_t events;
+} mp_stream_poll_gen_t;
+
+static inline void mp_stream_poll_gen_bump(volatile mp_uint_t *counter) {
+    *counter += 1;
+}
+
 // seek ioctl "whence" values
 #define MP_SEEK_SET (0)
 #define MP_SEEK_CUR (1)
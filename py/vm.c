@@ -35,6 +35,8 @@
 #include "py/runtime.h"
 #include "py/bc0.h"
 #include "py/profile.h"
+// CIRCUITPY-CHANGE: for the builtins in the global lookup cache
+#include "py/builtin.h"
 
 // *FORMAT-OFF*
 
@@ -195,6 +197,50 @@
 #define TRACE_TICK(current_ip, current_sp, is_exception)
 #endif // MICROPY_PY_SYS_SETTRACE
 
+// CIRCUITPY-CHANGE
+#if MICROPY_VM_OPCODE_STATS
+mp_opcode_stats_t mp_opcode_stats;
+
+static void opcode_stats_record(byte opcode) {
+    mp_opcode_stats_t *stats = &mp_opcode_stats;
+    stats->opcodes[opcode]++;
+    uint32_t key = (stats->last_opcode << 8 | opcode) + 1;
+    stats->last_opcode = opcode;
+    size_t i = (key * 2654435761u) % MICROPY_VM_OPCODE_STATS_PAIRS;
+    for (size_t probes = 0; probes < MICROPY_VM_OPCODE_STATS_PAIRS; probes++) {
+        mp_opcode_pair_count_t *entry = &stats->pairs[i];
+        if (entry->key == key) {
+            entry->count++;
+            return;
+        }
+        if (entry->key == 0) {
+            entry->key = key;
+            entry->count = 1;
+            return;
+        }
+        i = (i + 1) % MICROPY_VM_OPCODE_STATS_PAIRS;
+    }
+    stats->pairs_dropped++;
+}
+#define OPCODE_STATS(ip) opcode_stats_record(*(ip))
+#else
+#define OPCODE_STATS(ip)
+#endif
+
+#if MICROPY_PROF_FRAME_CHAIN
+// Keep the chain of bytecode frames that the profilers walk.
+#define PROF_SAMPLE_ENTER() do { \
+    code_state->prof_sample_prev = MP_STATE_THREAD(prof_sample_code_state); \
+    MP_STATE_THREAD(prof_sample_code_state) = code_state; \
+} while (0)
+#define PROF_SAMPLE_LEAVE() do { \
+    MP_STATE_THREAD(prof_sample_code_state) = code_state->prof_sample_prev; \
+} while (0)
+#else
+#define PROF_SAMPLE_ENTER()
+#define PROF_SAMPLE_LEAVE()
+#endif
+
 // CIRCUITPY-CHANGE
 STATIC mp_obj_t get_active_exception(mp_exc_stack_t *exc_sp, mp_exc_stack_t *exc_stack) {
     for (mp_exc_stack_t *e = exc_sp; e >= exc_stack; --e) {
@@ -205,6 +251,125 @@ STATIC mp_obj_t get_active_exception(mp_exc_stack_t *exc_sp, mp_exc_stack_t *exc
     return MP_OBJ_NULL;
 }
 
+#if MICROPY_OPT_LOAD_ATTR_INLINE_CACHE
+// Inline caches for LOAD_GLOBAL, LOAD_ATTR and LOAD_METHOD, keyed by the
+// address of the instruction.  An entry only says which slot of a map held the
+// name last time; a hit is confirmed against the live map, so entries left
+// behind by freed code, grown maps or reused type addresses simply miss.
+#define INLINE_CACHE_ENTRY(ip) (&MP_STATE_VM(inline_cache)[(uintptr_t)(ip) % MICROPY_OPT_LOAD_ATTR_INLINE_CACHE_SIZE])
+
+STATIC mp_map_elem_t *vm_cached_map_lookup(const byte *ip, const void *owner, mp_map_t *map, qstr qst) {
+    mp_inline_cache_entry_t *entry = INLINE_CACHE_ENTRY(ip);
+    mp_obj_t key = MP_OBJ_NEW_QSTR(qst);
+    if (entry->ip == ip && entry->owner == owner) {
+        size_t slot = entry->slot;
+        if (slot < map->alloc && map->table[slot].key == key) {
+            return &map->table[slot];
+        }
+    }
+    mp_map_elem_t *elem = mp_map_lookup(map, key, MP_MAP_LOOKUP);
+    if (elem != NULL) {
+        entry->ip = ip;
+        entry->owner = owner;
+        entry->slot = elem - map->table;
+    }
+    return elem;
+}
+
+STATIC mp_obj_t vm_load_global_cached(const byte *ip, qstr qst) {
+    mp_map_t *map = &mp_globals_get()->map;
+    mp_map_elem_t *elem = vm_cached_map_lookup(ip, map, map, qst);
+    if (elem != NULL) {
+        return elem->value;
+    }
+    // Not a global, so only the builtins are left to search.  Their table is
+    // cached too, unless builtins can be overridden at runtime.
+    #if MICROPY_CAN_OVERRIDE_BUILTINS
+    if (MP_STATE_VM(mp_module_builtins_override_dict) != NULL) {
+        return mp_load_builtin(qst);
+    }
+    #endif
+    mp_map_t *builtins = (mp_map_t *)&mp_module_builtins_globals.map;
+    elem = vm_cached_map_lookup(ip, &mp_module_builtins_globals, builtins, qst);
+    if (elem == NULL) {
+        // raises NameError
+        return mp_load_builtin(qst);
+    }
+    return elem->value;
+}
+
+// Handles the common case of mp_load_method_maybe for a native type that is
+// looked up purely through its locals dict.  Returns false if the full
+// lookup is needed.
+STATIC bool vm_load_method_cached(const byte *ip, mp_obj_t obj, qstr qst, mp_obj_t *dest) {
+    const mp_obj_type_t *type = mp_obj_get_type(obj);
+    if (MP_OBJ_TYPE_HAS_SLOT(type, attr) || !MP_OBJ_TYPE_HAS_SLOT(type, locals_dict)
+        || qst == MP_QSTR___next__
+        #if MICROPY_CPYTHON_COMPAT
+        || qst == MP_QSTR___class__
+        #endif
+        ) {
+        return false;
+    }
+    mp_map_elem_t *elem = vm_cached_map_lookup(ip, type, &MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map, qst);
+    if (elem == NULL) {
+        return false;
+    }
+    #if MICROPY_PY_BUILTINS_PROPERTY
+    if (mp_obj_is_type(elem->value, &mp_type_property) && (type->flags & MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS) == 0) {
+        return false;
+    }
+    #endif
+    dest[1] = MP_OBJ_NULL;
+    mp_convert_member_lookup(obj, type, elem->value, dest);
+    return true;
+}
+
+STATIC mp_obj_t vm_load_attr_cached(const byte *ip, mp_obj_t obj, qstr qst) {
+    mp_obj_t dest[2];
+    if (!vm_load_method_cached(ip, obj, qst, dest)) {
+        return mp_load_attr(obj, qst);
+    }
+    if (dest[1] == MP_OBJ_NULL) {
+        return dest[0];
+    }
+    return mp_obj_new_bound_meth(dest[0], dest[1]);
+}
+#endif
+
+#if MICROPY_OPT_FUSED_OPCODES
+// Binary op with a small int rhs, as done by the fused opcodes.  The common
+// small-int arithmetic and comparisons are done inline.
+static inline mp_obj_t vm_binary_op_small_int(mp_binary_op_t op, mp_obj_t lhs, mp_int_t rhs) {
+    if (mp_obj_is_small_int(lhs)) {
+        mp_int_t lhs_val = MP_OBJ_SMALL_INT_VALUE(lhs);
+        switch (op) {
+            case MP_BINARY_OP_ADD:
+            case MP_BINARY_OP_INPLACE_ADD:
+                return mp_obj_new_int(lhs_val + rhs);
+            case MP_BINARY_OP_SUBTRACT:
+            case MP_BINARY_OP_INPLACE_SUBTRACT:
+                return mp_obj_new_int(lhs_val - rhs);
+            case MP_BINARY_OP_LESS:
+                return mp_obj_new_bool(lhs_val < rhs);
+            case MP_BINARY_OP_MORE:
+                return mp_obj_new_bool(lhs_val > rhs);
+            case MP_BINARY_OP_EQUAL:
+                return mp_obj_new_bool(lhs_val == rhs);
+            case MP_BINARY_OP_LESS_EQUAL:
+                return mp_obj_new_bool(lhs_val <= rhs);
+            case MP_BINARY_OP_MORE_EQUAL:
+                return mp_obj_new_bool(lhs_val >= rhs);
+            case MP_BINARY_OP_NOT_EQUAL:
+                return mp_obj_new_bool(lhs_val != rhs);
+            default:
+                break;
+        }
+    }
+    return mp_binary_op(op, lhs, MP_OBJ_NEW_SMALL_INT(rhs));
+}
+#endif
+
 // fastn has items in reverse order (fastn[0] is local[0], fastn[-1] is local[1], etc)
 // sp points to bottom of stack which grows up
 // returns:
@@ -242,6 +407,7 @@ mp_vm_return_kind_t MICROPY_WRAP_MP_EXECUTE_BYTECODE(mp_execute_bytecode)(mp_cod
     #define ONE_TRUE_DISPATCH() one_true_dispatch : do { \
         TRACE(ip); \
         MARK_EXC_IP_GLOBAL(); \
+        OPCODE_STATS(ip); \
         goto *(void *)((char *) && entry_MP_BC_LOAD_CONST_FALSE + entry_table[*ip++]); \
 } while (0)
     #define DISPATCH() do { goto one_true_dispatch; } while (0)
@@ -251,6 +417,7 @@ mp_vm_return_kind_t MICROPY_WRAP_MP_EXECUTE_BYTECODE(mp_execute_bytecode)(mp_cod
         TRACE(ip); \
         MARK_EXC_IP_GLOBAL(); \
         TRACE_TICK(ip, sp, false); \
+        OPCODE_STATS(ip); \
         goto *entry_table[*ip++]; \
 } while (0)
     #endif
@@ -274,6 +441,7 @@ mp_vm_return_kind_t MICROPY_WRAP_MP_EXECUTE_BYTECODE(mp_execute_bytecode)(mp_cod
 run_code_state: ;
 #endif
 FRAME_ENTER();
+PROF_SAMPLE_ENTER();
 
 #if MICROPY_STACKLESS
 run_code_state_from_return: ;
@@ -334,6 +502,8 @@ dispatch_loop:
                 TRACE(ip);
                 MARK_EXC_IP_GLOBAL();
                 TRACE_TICK(ip, sp, false);
+                // CIRCUITPY-CHANGE
+                OPCODE_STATS(ip);
                 switch (*ip++) {
                 #endif
 
@@ -409,7 +579,11 @@ dispatch_loop:
                 ENTRY(MP_BC_LOAD_GLOBAL): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
+                    #if MICROPY_OPT_LOAD_ATTR_INLINE_CACHE
+                    PUSH(vm_load_global_cached(ip, qst));
+                    #else
                     PUSH(mp_load_global(qst));
+                    #endif
                     DISPATCH();
                 }
 
@@ -427,14 +601,22 @@ dispatch_loop:
                     mp_map_elem_t *elem = NULL;
                     if (mp_obj_is_instance_type(mp_obj_get_type(top))) {
                         mp_obj_instance_t *self = MP_OBJ_TO_PTR(top);
+                        #if MICROPY_OPT_LOAD_ATTR_INLINE_CACHE
+                        elem = vm_cached_map_lookup(ip, self->base.type, &self->members, qst);
+                        #else
                         elem = mp_map_lookup(&self->members, MP_OBJ_NEW_QSTR(qst), MP_MAP_LOOKUP);
+                        #endif
                     }
                     if (elem) {
                         obj = elem->value;
                     } else
                     #endif
                     {
+                        #if MICROPY_OPT_LOAD_ATTR_INLINE_CACHE
+                        obj = vm_load_attr_cached(ip, top, qst);
+                        #else
                         obj = mp_load_attr(top, qst);
+                        #endif
                     }
                     SET_TOP(obj);
                     DISPATCH();
@@ -443,7 +625,12 @@ dispatch_loop:
                 ENTRY(MP_BC_LOAD_METHOD): {
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
-                    mp_load_method(*sp, qst, sp);
+                    #if MICROPY_OPT_LOAD_ATTR_INLINE_CACHE
+                    if (!vm_load_method_cached(ip, *sp, qst, sp))
+                    #endif
+                    {
+                        mp_load_method(*sp, qst, sp);
+                    }
                     sp += 1;
                     DISPATCH();
                 }
@@ -1167,6 +1354,7 @@ unwind_return:
                     }
                     #endif
                     FRAME_LEAVE();
+                    PROF_SAMPLE_LEAVE();
                     return MP_VM_RETURN_NORMAL;
 
                 ENTRY(MP_BC_RAISE_LAST): {
@@ -1219,6 +1407,7 @@ yield:
                     code_state->sp = sp;
                     code_state->exc_sp_idx = MP_CODE_STATE_EXC_SP_IDX_FROM_PTR(exc_stack, exc_sp);
                     FRAME_LEAVE();
+                    PROF_SAMPLE_LEAVE();
                     return MP_VM_RETURN_YIELD;
 
                 ENTRY(MP_BC_YIELD_FROM): {
@@ -1283,6 +1472,30 @@ yield:
                     mp_import_all(POP());
                     DISPATCH();
 
+                #if MICROPY_OPT_FUSED_OPCODES
+                ENTRY(MP_BC_BINARY_OP_FAST_SMALL_INT): {
+                    MARK_EXC_IP_SELECTIVE();
+                    DECODE_UINT;
+                    mp_obj_t lhs = fastn[-(mp_int_t)MP_BC_FUSED_DECODE_LOCAL(unum)];
+                    if (lhs == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    PUSH(vm_binary_op_small_int(MP_BC_FUSED_DECODE_OP(unum), lhs, MP_BC_FUSED_DECODE_INT(unum)));
+                    DISPATCH();
+                }
+
+                ENTRY(MP_BC_INPLACE_OP_FAST_SMALL_INT): {
+                    MARK_EXC_IP_SELECTIVE();
+                    DECODE_UINT;
+                    mp_obj_t *local = &fastn[-(mp_int_t)MP_BC_FUSED_DECODE_LOCAL(unum)];
+                    if (*local == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    *local = vm_binary_op_small_int(MP_BC_FUSED_DECODE_OP(unum), *local, MP_BC_FUSED_DECODE_INT(unum));
+                    DISPATCH();
+                }
+                #endif
+
                 #if MICROPY_OPT_COMPUTED_GOTO
                 ENTRY(MP_BC_LOAD_CONST_SMALL_INT_MULTI):
                     PUSH(MP_OBJ_NEW_SMALL_INT((mp_int_t)ip[-1] - MP_BC_LOAD_CONST_SMALL_INT_MULTI - MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS));
@@ -1337,6 +1550,7 @@ yield:
                     nlr_pop();
                     code_state->state[0] = obj;
                     FRAME_LEAVE();
+                    PROF_SAMPLE_LEAVE();
                     return MP_VM_RETURN_EXCEPTION;
                 }
 
@@ -1351,6 +1565,13 @@ pending_exception_check:
                 // occur every few instructions.
                 MICROPY_VM_HOOK_LOOP
 
+                #if MICROPY_PROF_SAMPLING
+                if (MP_STATE_VM(prof_sample_pending)) {
+                    code_state->ip = ip;
+                    mp_prof_sample_take(code_state);
+                }
+                #endif
+
                 // Check for pending exceptions or scheduled tasks to run.
                 // Note: it's safe to just call mp_handle_pending(true), but
                 // we can inline the check for the common case where there is
@@ -1442,6 +1663,7 @@ unwind_loop:
 #endif
             // Set traceback info (file and line number) where the exception occurred, but not for:
             // - constant GeneratorExit object, because it's const
+            // - reused StopIteration and OSError(EAGAIN) objects, which record nothing
             // - exceptions re-raised by END_FINALLY
             // - exceptions re-raised explicitly by "raise"
             if ( true
@@ -1449,6 +1671,7 @@ unwind_loop:
                 #if MICROPY_CONST_GENERATOREXIT_OBJ
                 && nlr.ret_val != &mp_const_GeneratorExit_obj
                 #endif
+                && !MP_OBJ_IS_STATIC_EXCEPTION(nlr.ret_val)
                 && *code_state->ip != MP_BC_END_FINALLY
                 && *code_state->ip != MP_BC_RAISE_LAST) {
                 const byte *ip = code_state->fun_bc->bytecode;
@@ -1529,6 +1752,7 @@ unwind_loop:
                 // Note: ip and sp don't have usable values at this point
                 code_state->state[0] = MP_OBJ_FROM_PTR(nlr.ret_val); // put exception here because sp is invalid
                 FRAME_LEAVE();
+                PROF_SAMPLE_LEAVE();
                 return MP_VM_RETURN_EXCEPTION;
             }
         }
@@ -116,7 +116,22 @@ STATIC void vstr_ensure_extra(vstr_t *vstr, size_t size) {
             mp_raise_msg(&mp_type_RuntimeError, NULL);
         }
         size_t new_alloc = ROUND_ALLOC((vstr->len + size) + 16);
-        char *new_buf = m_renew(char, vstr->buf, vstr->alloc, new_alloc);
+        char *new_buf = NULL;
+        // CIRCUITPY-CHANGE: grow geometrically so that building a string from
+        // many small pieces doesn't copy it on nearly every append. If the
+        // heap has no room for that, grow by just what is needed.
+        #if MICROPY_VSTR_GROWTH_DIVISOR
+        size_t geometric_alloc = ROUND_ALLOC(vstr->alloc + vstr->alloc / MICROPY_VSTR_GROWTH_DIVISOR);
+        if (new_alloc < geometric_alloc) {
+            new_buf = m_renew_maybe(char, vstr->buf, vstr->alloc, geometric_alloc, true);
+            if (new_buf != NULL) {
+                new_alloc = geometric_alloc;
+            }
+        }
+        #endif
+        if (new_buf == NULL) {
+            new_buf = m_renew(char, vstr->buf, vstr->alloc, new_alloc);
+        }
         vstr->alloc = new_alloc;
         vstr->buf = new_buf;
     }
@@ -262,7 +262,9 @@ static MP_DEFINE_CONST_FUN_OBJ_1(bleio_adapter_stop_advertising_obj, bleio_adapt
 //|         interval: float = 0.1,
 //|         window: float = 0.1,
 //|         minimum_rssi: int = -80,
-//|         active: bool = True
+//|         active: bool = True,
+//|         addresses: Optional[Sequence[Address]] = None,
+//|         duplicate_timeout: float = 0
 //|     ) -> Iterable[ScanEntry]:
 //|         """Starts a BLE scan and returns an iterator of results. Advertisements and scan responses are
 //|         filtered and returned separately.
@@ -279,11 +281,16 @@ static MP_DEFINE_CONST_FUN_OBJ_1(bleio_adapter_stop_advertising_obj, bleio_adapt
 //|            window must be <= interval.
 //|         :param int minimum_rssi: the minimum rssi of entries to return.
 //|         :param bool active: retrieve scan responses for scannable advertisements.
+//|         :param Sequence[Address] addresses: only return entries from these addresses. The address type is
+//|            not compared.
+//|         :param float duplicate_timeout: when non-zero, drop an advertisement or scan response for this many
+//|            seconds after another one from the same address is returned. Only the most recent
+//|            addresses are remembered.
 //|         :returns: an iterable of `_bleio.ScanEntry` objects
 //|         :rtype: iterable"""
 //|         ...
 static mp_obj_t bleio_adapter_start_scan(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    enum { ARG_prefixes, ARG_buffer_size, ARG_extended, ARG_timeout, ARG_interval, ARG_window, ARG_minimum_rssi, ARG_active };
+    enum { ARG_prefixes, ARG_buffer_size, ARG_extended, ARG_timeout, ARG_interval, ARG_window, ARG_minimum_rssi, ARG_active, ARG_addresses, ARG_duplicate_timeout };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_prefixes,  MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
         { MP_QSTR_buffer_size,  MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 512} },
@@ -293,6 +300,8 @@ static mp_obj_t bleio_adapter_start_scan(size_t n_args, const mp_obj_t *pos_args
         { MP_QSTR_window,   MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
         { MP_QSTR_minimum_rssi,  MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = -80} },
         { MP_QSTR_active,  MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = true} },
+        { MP_QSTR_addresses,  MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_duplicate_timeout,  MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
     };
 
     bleio_adapter_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
@@ -339,7 +348,31 @@ static mp_obj_t bleio_adapter_start_scan(size_t n_args, const mp_obj_t *pos_args
         }
     }
 
-    return common_hal_bleio_adapter_start_scan(self, prefix_bufinfo.buf, prefix_bufinfo.len, args[ARG_extended].u_bool, args[ARG_buffer_size].u_int, timeout, interval, window, args[ARG_minimum_rssi].u_int, args[ARG_active].u_bool);
+    // The scan keeps the addresses as one heap buffer of address bytes.
+    uint8_t *addresses = NULL;
+    size_t addresses_length = 0;
+    if (args[ARG_addresses].u_obj != mp_const_none) {
+        size_t count;
+        mp_obj_t *items;
+        mp_obj_get_array(args[ARG_addresses].u_obj, &count, &items);
+        addresses_length = count * NUM_BLEIO_ADDRESS_BYTES;
+        addresses = m_malloc(addresses_length);
+        for (size_t i = 0; i < count; i++) {
+            bleio_address_obj_t *address = MP_OBJ_TO_PTR(mp_arg_validate_type(items[i], &bleio_address_type, MP_QSTR_addresses));
+            mp_buffer_info_t address_bufinfo;
+            mp_get_buffer_raise(common_hal_bleio_address_get_address_bytes(address), &address_bufinfo, MP_BUFFER_READ);
+            memcpy(addresses + i * NUM_BLEIO_ADDRESS_BYTES, address_bufinfo.buf, NUM_BLEIO_ADDRESS_BYTES);
+        }
+    }
+
+    mp_int_t duplicate_timeout_ms = 0;
+    if (args[ARG_duplicate_timeout].u_obj != mp_const_none) {
+        mp_float_t duplicate_timeout = mp_arg_validate_obj_float_non_negative(args[ARG_duplicate_timeout].u_obj, 0, MP_QSTR_duplicate_timeout);
+        duplicate_timeout_ms = (mp_int_t)(duplicate_timeout * 1000);
+    }
+
+    return common_hal_bleio_adapter_start_scan(self, prefix_bufinfo.buf, prefix_bufinfo.len, args[ARG_extended].u_bool, args[ARG_buffer_size].u_int, timeout, interval, window, args[ARG_minimum_rssi].u_int, args[ARG_active].u_bool,
+        addresses, addresses_length, duplicate_timeout_ms);
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(bleio_adapter_start_scan_obj, 1, bleio_adapter_start_scan);
 
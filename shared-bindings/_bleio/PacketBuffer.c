@@ -95,10 +95,18 @@ static mp_obj_t bleio_packet_buffer_readinto(mp_obj_t self_in, mp_obj_t buffer_o
 }
 static MP_DEFINE_CONST_FUN_OBJ_2(bleio_packet_buffer_readinto_obj, bleio_packet_buffer_readinto);
 
-//|     def write(self, data: ReadableBuffer, *, header: Optional[bytes] = None) -> int:
+//|     def write(
+//|         self,
+//|         data: Union[ReadableBuffer, Sequence[ReadableBuffer]],
+//|         *,
+//|         header: Optional[bytes] = None,
+//|     ) -> int:
 //|         """Writes all bytes from data into the same outgoing packet. The bytes from header are included
 //|         before data when the pending packet is currently empty.
 //|
+//|         data may also be a list or tuple of buffers. Each one is written in turn as if by its own
+//|         call, which saves a call per packet when streaming.
+//|
 //|         This does not block until the data is sent. It only blocks until the data is pending.
 //|
 //|         :return: number of bytes written. May include header bytes when packet is empty.
@@ -119,17 +127,34 @@ static mp_obj_t bleio_packet_buffer_write(mp_uint_t n_args, const mp_obj_t *pos_
     bleio_packet_buffer_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
     check_for_deinit(self);
 
-    mp_buffer_info_t data_bufinfo;
-    mp_get_buffer_raise(args[ARG_data].u_obj, &data_bufinfo, MP_BUFFER_READ);
-
     mp_buffer_info_t header_bufinfo;
     header_bufinfo.len = 0;
     if (args[ARG_header].u_obj != mp_const_none) {
         mp_get_buffer_raise(args[ARG_header].u_obj, &header_bufinfo, MP_BUFFER_READ);
     }
 
-    mp_int_t num_bytes_written = common_hal_bleio_packet_buffer_write(
-        self, data_bufinfo.buf, data_bufinfo.len, header_bufinfo.buf, header_bufinfo.len);
+    size_t num_buffers = 1;
+    mp_obj_t *buffers = &args[ARG_data].u_obj;
+    if (mp_obj_is_type(args[ARG_data].u_obj, &mp_type_list) ||
+        mp_obj_is_type(args[ARG_data].u_obj, &mp_type_tuple)) {
+        mp_obj_get_array(args[ARG_data].u_obj, &num_buffers, &buffers);
+    }
+
+    mp_int_t num_bytes_written = 0;
+    for (size_t i = 0; i < num_buffers; i++) {
+        mp_buffer_info_t data_bufinfo;
+        mp_get_buffer_raise(buffers[i], &data_bufinfo, MP_BUFFER_READ);
+        mp_int_t written = common_hal_bleio_packet_buffer_write(
+            self, data_bufinfo.buf, data_bufinfo.len, header_bufinfo.buf, header_bufinfo.len);
+        if (written < 0) {
+            // Report what was pending before the connection went away.
+            if (num_bytes_written == 0) {
+                num_bytes_written = written;
+            }
+            break;
+        }
+        num_bytes_written += written;
+    }
     if (num_bytes_written < 0) {
         // TODO: Raise an error if not connected. Right now the not-connected error
         // is unreliable, because common_hal_bleio_packet_buffer_write()
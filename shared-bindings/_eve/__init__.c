@@ -860,6 +860,28 @@ static mp_obj_t _vertex2f(mp_obj_t self, mp_obj_t a0, mp_obj_t a1) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_3(vertex2f_obj, _vertex2f);
 
+//|     def vertices(self, coords: ReadableBuffer, ii: bool = False) -> None:
+//|         """Draw many points in one call, as though :meth:`Vertex2f` was called
+//|         for each of them. This is much faster than calling it from a loop,
+//|         for example to draw a ``LINE_STRIP`` chart.
+//|
+//|         :param ~circuitpython_typing.ReadableBuffer coords: x and y pixel coordinates
+//|           of each point in turn, as signed 16-bit integers such as an ``array.array("h")``
+//|         :param bool ii: encode each point as :meth:`Vertex2ii` with handle and cell 0
+//|           instead, so the coordinates are not scaled by :meth:`VertexFormat`"""
+//|         ...
+static mp_obj_t _vertices(size_t n_args, const mp_obj_t *args) {
+    mp_buffer_info_t buffer_info;
+    mp_get_buffer_raise(args[1], &buffer_info, MP_BUFFER_READ);
+    if (buffer_info.len % (2 * sizeof(int16_t)) != 0) {
+        mp_arg_error_invalid(MP_QSTR_coords);
+    }
+    bool ii = (n_args > 2) && mp_obj_is_true(args[2]);
+    common_hal__eve_vertices(EVEHAL(args[0]), buffer_info.buf, buffer_info.len / (2 * sizeof(int16_t)), ii);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(vertices_obj, 2, 3, _vertices);
+
 //|     def LineWidth(self, width: float) -> None:
 //|         """Set the width of rasterized lines
 //|
@@ -1030,6 +1052,7 @@ static const mp_rom_map_elem_t _EVE_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_cc), MP_ROM_PTR(&cc_obj) },
     { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&flush_obj) },
     { MP_ROM_QSTR(MP_QSTR_Vertex2f), MP_ROM_PTR(&vertex2f_obj) },
+    { MP_ROM_QSTR(MP_QSTR_vertices), MP_ROM_PTR(&vertices_obj) },
     { MP_ROM_QSTR(MP_QSTR_cmd), MP_ROM_PTR(&cmd_obj) },
     { MP_ROM_QSTR(MP_QSTR_cmd0), MP_ROM_PTR(&cmd0_obj) },
     ROM_DECLS
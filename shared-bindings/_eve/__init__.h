@@ -11,6 +11,7 @@
 void common_hal__eve_flush(common_hal__eve_t *eve);
 void common_hal__eve_add(common_hal__eve_t *eve, size_t len, void *buf);
 void common_hal__eve_Vertex2f(common_hal__eve_t *eve, mp_float_t x, mp_float_t y);
+void common_hal__eve_vertices(common_hal__eve_t *eve, const int16_t *coords, size_t n, bool ii);
 
 void common_hal__eve_AlphaFunc(common_hal__eve_t *eve, uint32_t func, uint32_t ref);
 void common_hal__eve_Begin(common_hal__eve_t *eve, uint32_t prim);
@@ -32,6 +32,8 @@ size_t common_hal_adafruit_pixelbuf_pixelbuf_get_len(mp_obj_t self_in);
 mp_obj_t common_hal_adafruit_pixelbuf_pixelbuf_get_byteorder_string(mp_obj_t self);
 void common_hal_adafruit_pixelbuf_pixelbuf_fill(mp_obj_t self, mp_obj_t item);
 void common_hal_adafruit_pixelbuf_pixelbuf_show(mp_obj_t self);
+// The bytes object that show() passes to _transmit, for native transmitters.
+mp_obj_t common_hal_adafruit_pixelbuf_pixelbuf_get_transmit_buffer(mp_obj_t self);
 mp_obj_t common_hal_adafruit_pixelbuf_pixelbuf_get_pixel(mp_obj_t self, size_t index);
 void common_hal_adafruit_pixelbuf_pixelbuf_set_pixel(mp_obj_t self, size_t index, mp_obj_t item);
 void common_hal_adafruit_pixelbuf_pixelbuf_set_pixels(mp_obj_t self_in, size_t start, mp_int_t step, size_t slice_len, mp_obj_t *values, mp_obj_tuple_t *flatten_to);
@@ -28,3 +28,9 @@ void common_hal_aesio_aes_encrypt(aesio_aes_obj_t *self,
 void common_hal_aesio_aes_decrypt(aesio_aes_obj_t *self,
     uint8_t *buffer,
     size_t len);
+size_t common_hal_aesio_aes_crypt_stream(aesio_aes_obj_t *self,
+    bool encrypt,
+    mp_obj_t src,
+    mp_obj_t dest,
+    uint8_t *buffer,
+    size_t length);
@@ -216,6 +216,64 @@ static mp_obj_t aesio_aes_decrypt_into(mp_obj_t self_in, mp_obj_t src, mp_obj_t
 
 static MP_DEFINE_CONST_FUN_OBJ_3(aesio_aes_decrypt_into_obj, aesio_aes_decrypt_into);
 
+static mp_obj_t aesio_aes_crypt_stream(size_t n_args, const mp_obj_t *args, bool encrypt) {
+    aesio_aes_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+
+    uint8_t *buffer;
+    size_t length;
+    if (n_args > 3 && args[3] != mp_const_none) {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(args[3], &bufinfo, MP_BUFFER_WRITE);
+        buffer = bufinfo.buf;
+        length = mp_arg_validate_length_min(bufinfo.len, AES_BLOCKLEN, MP_QSTR_buffer);
+    } else {
+        length = AESIO_STREAM_BUFFER_SIZE;
+        buffer = m_new(uint8_t, length);
+    }
+
+    size_t total = common_hal_aesio_aes_crypt_stream(self, encrypt, args[1], args[2], buffer, length);
+
+    if (n_args <= 3 || args[3] == mp_const_none) {
+        m_del(uint8_t, buffer, length);
+    }
+    return mp_obj_new_int_from_uint(total);
+}
+
+//|     def encrypt_stream(
+//|         self,
+//|         src: circuitpython_typing.ByteStream,
+//|         dest: circuitpython_typing.ByteStream,
+//|         buffer: Optional[WriteableBuffer] = None,
+//|     ) -> int:
+//|         """Read ``src`` until it ends, encrypt it and write the result to ``dest``.
+//|         Returns the number of bytes processed.
+//|
+//|         The data is processed in chunks the size of ``buffer``, rounded down to a
+//|         multiple of 16 bytes, or 512 bytes at a time if no buffer is given. The
+//|         output is the same as from a single `encrypt_into` of the whole input, so for
+//|         ECB and CBC modes the length of ``src`` must be a multiple of 16 bytes."""
+//|         ...
+static mp_obj_t aesio_aes_encrypt_stream(size_t n_args, const mp_obj_t *args) {
+    return aesio_aes_crypt_stream(n_args, args, true);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(aesio_aes_encrypt_stream_obj, 3, 4, aesio_aes_encrypt_stream);
+
+//|     def decrypt_stream(
+//|         self,
+//|         src: circuitpython_typing.ByteStream,
+//|         dest: circuitpython_typing.ByteStream,
+//|         buffer: Optional[WriteableBuffer] = None,
+//|     ) -> int:
+//|         """Read ``src`` until it ends, decrypt it and write the result to ``dest``.
+//|         Returns the number of bytes processed. See `encrypt_stream` for how the
+//|         data is chunked."""
+//|         ...
+//|
+static mp_obj_t aesio_aes_decrypt_stream(size_t n_args, const mp_obj_t *args) {
+    return aesio_aes_crypt_stream(n_args, args, false);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(aesio_aes_decrypt_stream_obj, 3, 4, aesio_aes_decrypt_stream);
+
 static mp_obj_t aesio_aes_get_mode(mp_obj_t self_in) {
     aesio_aes_obj_t *self = MP_OBJ_TO_PTR(self_in);
 
@@ -250,6 +308,8 @@ static const mp_rom_map_elem_t aesio_locals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR___name__), MP_OBJ_NEW_QSTR(MP_QSTR_AES)},
     {MP_ROM_QSTR(MP_QSTR_encrypt_into), (mp_obj_t)&aesio_aes_encrypt_into_obj},
     {MP_ROM_QSTR(MP_QSTR_decrypt_into), (mp_obj_t)&aesio_aes_decrypt_into_obj},
+    {MP_ROM_QSTR(MP_QSTR_encrypt_stream), (mp_obj_t)&aesio_aes_encrypt_stream_obj},
+    {MP_ROM_QSTR(MP_QSTR_decrypt_stream), (mp_obj_t)&aesio_aes_decrypt_stream_obj},
     {MP_ROM_QSTR(MP_QSTR_rekey), (mp_obj_t)&aesio_aes_rekey_obj},
     {MP_ROM_QSTR(MP_QSTR_mode), (mp_obj_t)&aesio_aes_mode_obj},
 };
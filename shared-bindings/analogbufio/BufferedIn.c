@@ -9,6 +9,7 @@
 #include "py/binary.h"
 #include "py/mphal.h"
 #include "py/nlr.h"
+#include "py/objproperty.h"
 #include "py/runtime.h"
 #include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/analogbufio/BufferedIn.h"
@@ -96,7 +97,20 @@ static mp_obj_t analogbufio_bufferedin___exit__(size_t n_args, const mp_obj_t *a
 }
 static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(analogbufio_bufferedin___exit___obj, 4, 4, analogbufio_bufferedin___exit__);
 
-//|     def readinto(self, buffer: WriteableBuffer) -> int:
+// Returns the bytes per sample for a buffer's typecode.
+static uint8_t validate_buffer(mp_obj_t buffer_obj, mp_buffer_info_t *bufinfo) {
+    mp_get_buffer_raise(buffer_obj, bufinfo, MP_BUFFER_WRITE);
+
+    // Bytes Per Sample
+    if (bufinfo->typecode == 'H') {
+        return 2;
+    } else if (bufinfo->typecode != 'B' && bufinfo->typecode != BYTEARRAY_TYPECODE) {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("%q must be a bytearray or array of type 'H' or 'B'"), MP_QSTR_buffer);
+    }
+    return 1;
+}
+
+//|     def readinto(self, buffer: WriteableBuffer, *, loop: bool = False) -> int:
 //|         """Fills the provided buffer with ADC voltage values.
 //|
 //|         ADC values will be read into the given buffer at the supplied sample_rate.
@@ -105,30 +119,105 @@ static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(analogbufio_bufferedin___exit___obj,
 //|         The ADC most significant bits of the ADC are kept. (See
 //|         https://docs.circuitpython.org/en/latest/docs/library/array.html)
 //|
-//|         :param ~circuitpython_typing.WriteableBuffer buffer: buffer: A buffer for samples"""
+//|         When ``loop`` is True, sampling continues in the background, writing
+//|         to the buffer over and over with no gap between passes, and this
+//|         returns 0 immediately. Use `read_last` to get the newest samples and
+//|         `stop` to end sampling. The buffer holds the samples as the ADC
+//|         produces them (12 bits in an 'H' buffer) and must not be changed
+//|         while looping.
+//|
+//|         :param ~circuitpython_typing.WriteableBuffer buffer: buffer: A buffer for samples
+//|         :param bool loop: sample into the buffer continuously"""
 //|         ...
 //|
-static mp_obj_t analogbufio_bufferedin_obj_readinto(mp_obj_t self_in, mp_obj_t buffer_obj) {
-    analogbufio_bufferedin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+static mp_obj_t analogbufio_bufferedin_obj_readinto(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer, ARG_loop };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_loop, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+    };
+    analogbufio_bufferedin_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
     check_for_deinit(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
     // Buffer defined and allocated by user
     mp_buffer_info_t bufinfo;
-    mp_get_buffer_raise(buffer_obj, &bufinfo, MP_BUFFER_READ);
+    uint8_t bytes_per_sample = validate_buffer(args[ARG_buffer].u_obj, &bufinfo);
 
-    uint8_t bytes_per_sample = 1;
-
-    // Bytes Per Sample
-    if (bufinfo.typecode == 'H') {
-        bytes_per_sample = 2;
-    } else if (bufinfo.typecode != 'B' && bufinfo.typecode != BYTEARRAY_TYPECODE) {
-        mp_raise_ValueError_varg(MP_ERROR_TEXT("%q must be a bytearray or array of type 'H' or 'B'"), MP_QSTR_buffer);
+    if (args[ARG_loop].u_bool) {
+        mp_arg_validate_length_min(bufinfo.len / bytes_per_sample, 1, MP_QSTR_buffer);
+        common_hal_analogbufio_bufferedin_start_loop(self, bufinfo.buf, bufinfo.len, bytes_per_sample);
+        return MP_OBJ_NEW_SMALL_INT(0);
     }
 
     mp_uint_t captured = common_hal_analogbufio_bufferedin_readinto(self, bufinfo.buf, bufinfo.len, bytes_per_sample);
     return MP_OBJ_NEW_SMALL_INT(captured);
 }
-MP_DEFINE_CONST_FUN_OBJ_2(analogbufio_bufferedin_readinto_obj, analogbufio_bufferedin_obj_readinto);
+MP_DEFINE_CONST_FUN_OBJ_KW(analogbufio_bufferedin_readinto_obj, 1, analogbufio_bufferedin_obj_readinto);
+
+//|     def read_last(self, buffer: WriteableBuffer) -> int:
+//|         """Copy the newest samples from a looping `readinto` into ``buffer``,
+//|         oldest first. The buffer's typecode may differ from the looping one
+//|         and samples are scaled to match.
+//|
+//|         Fewer samples are copied when fewer have been captured since looping
+//|         started. Samples about to be overwritten may change while they are
+//|         copied, so keep the looping buffer longer than the ones read from it.
+//|
+//|         :param ~circuitpython_typing.WriteableBuffer buffer: buffer: A buffer for samples
+//|         :return: the number of samples copied, 0 if not looping"""
+//|         ...
+//|
+static mp_obj_t analogbufio_bufferedin_obj_read_last(mp_obj_t self_in, mp_obj_t buffer_obj) {
+    analogbufio_bufferedin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+
+    mp_buffer_info_t bufinfo;
+    uint8_t bytes_per_sample = validate_buffer(buffer_obj, &bufinfo);
+
+    mp_uint_t copied = common_hal_analogbufio_bufferedin_read_last(self, bufinfo.buf, bufinfo.len, bytes_per_sample);
+    return MP_OBJ_NEW_SMALL_INT(copied);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(analogbufio_bufferedin_read_last_obj, analogbufio_bufferedin_obj_read_last);
+
+//|     def stop(self) -> None:
+//|         """Stop a looping `readinto`. Does nothing if not looping."""
+//|         ...
+//|
+static mp_obj_t analogbufio_bufferedin_obj_stop(mp_obj_t self_in) {
+    analogbufio_bufferedin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_analogbufio_bufferedin_stop_loop(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(analogbufio_bufferedin_stop_obj, analogbufio_bufferedin_obj_stop);
+
+//|     looping: bool
+//|     """True while a looping `readinto` is sampling. (read-only)"""
+static mp_obj_t analogbufio_bufferedin_obj_get_looping(mp_obj_t self_in) {
+    analogbufio_bufferedin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_bool(common_hal_analogbufio_bufferedin_get_looping(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(analogbufio_bufferedin_get_looping_obj, analogbufio_bufferedin_obj_get_looping);
+
+MP_PROPERTY_GETTER(analogbufio_bufferedin_looping_obj,
+    (mp_obj_t)&analogbufio_bufferedin_get_looping_obj);
+
+//|     write_index: int
+//|     """The index in the looping buffer of the next sample to be written.
+//|     Samples before it are the newest ones. 0 when not looping. (read-only)"""
+//|
+static mp_obj_t analogbufio_bufferedin_obj_get_write_index(mp_obj_t self_in) {
+    analogbufio_bufferedin_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_int_from_uint(common_hal_analogbufio_bufferedin_get_write_index(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(analogbufio_bufferedin_get_write_index_obj, analogbufio_bufferedin_obj_get_write_index);
+
+MP_PROPERTY_GETTER(analogbufio_bufferedin_write_index_obj,
+    (mp_obj_t)&analogbufio_bufferedin_get_write_index_obj);
 
 static const mp_rom_map_elem_t analogbufio_bufferedin_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___del__),    MP_ROM_PTR(&analogbufio_bufferedin_deinit_obj) },
@@ -136,6 +225,10 @@ static const mp_rom_map_elem_t analogbufio_bufferedin_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___enter__),  MP_ROM_PTR(&default___enter___obj) },
     { MP_ROM_QSTR(MP_QSTR___exit__),   MP_ROM_PTR(&analogbufio_bufferedin___exit___obj) },
     { MP_ROM_QSTR(MP_QSTR_readinto),       MP_ROM_PTR(&analogbufio_bufferedin_readinto_obj)},
+    { MP_ROM_QSTR(MP_QSTR_read_last),      MP_ROM_PTR(&analogbufio_bufferedin_read_last_obj)},
+    { MP_ROM_QSTR(MP_QSTR_stop),           MP_ROM_PTR(&analogbufio_bufferedin_stop_obj)},
+    { MP_ROM_QSTR(MP_QSTR_looping),        MP_ROM_PTR(&analogbufio_bufferedin_looping_obj)},
+    { MP_ROM_QSTR(MP_QSTR_write_index),    MP_ROM_PTR(&analogbufio_bufferedin_write_index_obj)},
 
 };
 
@@ -15,3 +15,8 @@ void common_hal_analogbufio_bufferedin_construct(analogbufio_bufferedin_obj_t *s
 void common_hal_analogbufio_bufferedin_deinit(analogbufio_bufferedin_obj_t *self);
 bool common_hal_analogbufio_bufferedin_deinited(analogbufio_bufferedin_obj_t *self);
 uint32_t common_hal_analogbufio_bufferedin_readinto(analogbufio_bufferedin_obj_t *self, uint8_t *buffer, uint32_t len, uint8_t bytes_per_sample);
+void common_hal_analogbufio_bufferedin_start_loop(analogbufio_bufferedin_obj_t *self, uint8_t *buffer, uint32_t len, uint8_t bytes_per_sample);
+void common_hal_analogbufio_bufferedin_stop_loop(analogbufio_bufferedin_obj_t *self);
+bool common_hal_analogbufio_bufferedin_get_looping(analogbufio_bufferedin_obj_t *self);
+uint32_t common_hal_analogbufio_bufferedin_get_write_index(analogbufio_bufferedin_obj_t *self);
+uint32_t common_hal_analogbufio_bufferedin_read_last(analogbufio_bufferedin_obj_t *self, uint8_t *buffer, uint32_t len, uint8_t bytes_per_sample);
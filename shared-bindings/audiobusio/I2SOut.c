@@ -11,6 +11,7 @@
 #include "py/objproperty.h"
 #include "py/runtime.h"
 #include "shared-bindings/microcontroller/Pin.h"
+#include "shared-bindings/audiocore/__init__.h"
 #include "shared-bindings/audiobusio/I2SOut.h"
 #include "shared-bindings/util.h"
 
@@ -140,19 +141,37 @@ static mp_obj_t audiobusio_i2sout_obj___exit__(size_t n_args, const mp_obj_t *ar
 static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(audiobusio_i2sout___exit___obj, 4, 4, audiobusio_i2sout_obj___exit__);
 
 
-//|     def play(self, sample: circuitpython_typing.AudioSample, *, loop: bool = False) -> None:
+//|     def play(
+//|         self,
+//|         sample: circuitpython_typing.AudioSample,
+//|         *,
+//|         loop: bool = False,
+//|         buffer_count: int = 2,
+//|         latency: float = 0.0,
+//|     ) -> None:
 //|         """Plays the sample once when loop=False and continuously when loop=True.
 //|         Does not block. Use `playing` to block.
 //|
 //|         Sample must be an `audiocore.WaveFile`, `audiocore.RawSample`, `audiomixer.Mixer` or `audiomp3.MP3Decoder`.
 //|
-//|         The sample itself should consist of 8 bit or 16 bit samples."""
+//|         The sample itself should consist of 8 bit or 16 bit samples.
+//|
+//|         :param int buffer_count: Number of DMA buffers to cycle through, from 2 to 4.
+//|           More buffers use more RAM but ride out longer delays in refilling them.
+//|         :param float latency: Target total delay in seconds held in the buffers, 0 to 1.
+//|           When 0, each buffer holds one of the sample's own buffers. A smaller value
+//|           uses smaller buffers for a shorter delay between the sample and the output,
+//|           at the cost of more frequent refills.
+//|
+//|         Ports that do not use DMA buffers for this output ignore ``buffer_count`` and ``latency``."""
 //|         ...
 static mp_obj_t audiobusio_i2sout_obj_play(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    enum { ARG_sample, ARG_loop };
+    enum { ARG_sample, ARG_loop, ARG_buffer_count, ARG_latency };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_sample,    MP_ARG_OBJ | MP_ARG_REQUIRED },
         { MP_QSTR_loop,      MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+        { MP_QSTR_buffer_count, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 2} },
+        { MP_QSTR_latency,   MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_ROM_INT(0)} },
     };
     audiobusio_i2sout_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
     check_for_deinit(self);
@@ -160,7 +179,11 @@ static mp_obj_t audiobusio_i2sout_obj_play(size_t n_args, const mp_obj_t *pos_ar
     mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
     mp_obj_t sample = args[ARG_sample].u_obj;
-    common_hal_audiobusio_i2sout_play(self, sample, args[ARG_loop].u_bool);
+    uint8_t buffer_count = (uint8_t)mp_arg_validate_int_range(args[ARG_buffer_count].u_int,
+        2, AUDIOCORE_DMA_MAX_BUFFER_COUNT, MP_QSTR_buffer_count);
+    mp_float_t latency = mp_arg_validate_obj_float_range(args[ARG_latency].u_obj, 0, 1, MP_QSTR_latency);
+    common_hal_audiobusio_i2sout_play(self, sample, args[ARG_loop].u_bool, buffer_count,
+        (uint32_t)(latency * MICROPY_FLOAT_CONST(1000000.0)));
 
     return mp_const_none;
 }
@@ -231,6 +254,26 @@ MP_DEFINE_CONST_FUN_OBJ_1(audiobusio_i2sout_get_paused_obj, audiobusio_i2sout_ob
 
 MP_PROPERTY_GETTER(audiobusio_i2sout_paused_obj,
     (mp_obj_t)&audiobusio_i2sout_get_paused_obj);
+
+//|     dma_stats: audiocore.DMAStats
+//|     """Buffer and underrun counts for the current or most recent playback. (read-only)"""
+//|
+static mp_obj_t audiobusio_i2sout_obj_get_dma_stats(mp_obj_t self_in) {
+    audiobusio_i2sout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    audiocore_dma_stats_t stats;
+    common_hal_audiobusio_i2sout_get_dma_stats(self, &stats);
+    return audiocore_dma_stats_to_obj(&stats);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audiobusio_i2sout_get_dma_stats_obj, audiobusio_i2sout_obj_get_dma_stats);
+
+MP_PROPERTY_GETTER(audiobusio_i2sout_dma_stats_obj,
+    (mp_obj_t)&audiobusio_i2sout_get_dma_stats_obj);
+
+// Ports whose audio output does not go through audio_dma have nothing to report.
+MP_WEAK void common_hal_audiobusio_i2sout_get_dma_stats(audiobusio_i2sout_obj_t *self, audiocore_dma_stats_t *stats) {
+    *stats = (audiocore_dma_stats_t) { 0 };
+}
 #endif // CIRCUITPY_AUDIOBUSIO_I2SOUT
 
 static const mp_rom_map_elem_t audiobusio_i2sout_locals_dict_table[] = {
@@ -248,6 +291,7 @@ static const mp_rom_map_elem_t audiobusio_i2sout_locals_dict_table[] = {
     // Properties
     { MP_ROM_QSTR(MP_QSTR_playing), MP_ROM_PTR(&audiobusio_i2sout_playing_obj) },
     { MP_ROM_QSTR(MP_QSTR_paused), MP_ROM_PTR(&audiobusio_i2sout_paused_obj) },
+    { MP_ROM_QSTR(MP_QSTR_dma_stats), MP_ROM_PTR(&audiobusio_i2sout_dma_stats_obj) },
     #endif // CIRCUITPY_AUDIOBUSIO_I2SOUT
 };
 static MP_DEFINE_CONST_DICT(audiobusio_i2sout_locals_dict, audiobusio_i2sout_locals_dict_table);
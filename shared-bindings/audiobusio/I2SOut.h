@@ -8,6 +8,7 @@
 
 #include "common-hal/audiobusio/I2SOut.h"
 #include "common-hal/microcontroller/Pin.h"
+#include "shared-module/audiocore/__init__.h"
 
 extern const mp_obj_type_t audiobusio_i2sout_type;
 
@@ -20,11 +21,13 @@ void common_hal_audiobusio_i2sout_construct(audiobusio_i2sout_obj_t *self,
 
 void common_hal_audiobusio_i2sout_deinit(audiobusio_i2sout_obj_t *self);
 bool common_hal_audiobusio_i2sout_deinited(audiobusio_i2sout_obj_t *self);
-void common_hal_audiobusio_i2sout_play(audiobusio_i2sout_obj_t *self, mp_obj_t sample, bool loop);
+void common_hal_audiobusio_i2sout_play(audiobusio_i2sout_obj_t *self, mp_obj_t sample, bool loop,
+    uint8_t buffer_count, uint32_t target_latency_us);
 void common_hal_audiobusio_i2sout_stop(audiobusio_i2sout_obj_t *self);
 bool common_hal_audiobusio_i2sout_get_playing(audiobusio_i2sout_obj_t *self);
 void common_hal_audiobusio_i2sout_pause(audiobusio_i2sout_obj_t *self);
 void common_hal_audiobusio_i2sout_resume(audiobusio_i2sout_obj_t *self);
 bool common_hal_audiobusio_i2sout_get_paused(audiobusio_i2sout_obj_t *self);
+void common_hal_audiobusio_i2sout_get_dma_stats(audiobusio_i2sout_obj_t *self, audiocore_dma_stats_t *stats);
 
 #endif // CIRCUITPY_AUDIOBUSIO_I2SOUT
@@ -16,6 +16,37 @@
 // #include "shared-bindings/audiomixer/Mixer.h"
 
 //| """Support for audio samples"""
+//|
+//| class DMAStats:
+//|     """Playback statistics reported by the ``dma_stats`` property of an audio output.
+//|     The counts restart each time ``play()`` is called. Ports without audio DMA report zeros."""
+//|
+//|     buffers: int
+//|     """Number of buffers handed to the DMA."""
+//|     underruns: int
+//|     """Number of times the DMA reached a buffer that had not been refilled yet."""
+//|     max_latency_us: int
+//|     """Longest time, in microseconds, between the DMA asking for a buffer and the buffer being refilled."""
+//|
+
+const mp_obj_namedtuple_type_t audiocore_dmastats_type_obj = {
+    NAMEDTUPLE_TYPE_BASE_AND_SLOTS(MP_QSTR_DMAStats),
+    .n_fields = 3,
+    .fields = {
+        MP_QSTR_buffers,
+        MP_QSTR_underruns,
+        MP_QSTR_max_latency_us,
+    },
+};
+
+mp_obj_t audiocore_dma_stats_to_obj(const audiocore_dma_stats_t *stats) {
+    mp_obj_t items[3] = {
+        mp_obj_new_int_from_uint(stats->buffers),
+        mp_obj_new_int_from_uint(stats->underruns),
+        mp_obj_new_int_from_uint(stats->max_latency_us),
+    };
+    return namedtuple_make_new((const mp_obj_type_t *)&audiocore_dmastats_type_obj, 3, 0, items);
+}
 
 #if CIRCUITPY_AUDIOCORE_DEBUG
 // (no docstrings so that the debug functions are not shown on docs.circuitpython.org)
@@ -78,6 +109,7 @@ static const mp_rom_map_elem_t audiocore_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_audiocore) },
     { MP_ROM_QSTR(MP_QSTR_RawSample), MP_ROM_PTR(&audioio_rawsample_type) },
     { MP_ROM_QSTR(MP_QSTR_WaveFile), MP_ROM_PTR(&audioio_wavefile_type) },
+    { MP_ROM_QSTR(MP_QSTR_DMAStats), MP_ROM_PTR(&audiocore_dmastats_type_obj) },
     #if CIRCUITPY_AUDIOCORE_DEBUG
     { MP_ROM_QSTR(MP_QSTR_get_buffer), MP_ROM_PTR(&audiocore_get_buffer_obj) },
     { MP_ROM_QSTR(MP_QSTR_reset_buffer), MP_ROM_PTR(&audiocore_reset_buffer_obj) },
@@ -7,5 +7,9 @@
 #pragma once
 
 #include "py/obj.h"
+#include "py/objnamedtuple.h"
+#include "shared-module/audiocore/__init__.h"
 
-// Nothing now.
+extern const mp_obj_namedtuple_type_t audiocore_dmastats_type_obj;
+
+mp_obj_t audiocore_dma_stats_to_obj(const audiocore_dma_stats_t *stats);
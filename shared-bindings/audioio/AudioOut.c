@@ -11,6 +11,7 @@
 #include "py/objproperty.h"
 #include "py/runtime.h"
 #include "shared-bindings/microcontroller/Pin.h"
+#include "shared-bindings/audiocore/__init__.h"
 #include "shared-bindings/audioio/AudioOut.h"
 #include "shared-bindings/audiocore/RawSample.h"
 #include "shared-bindings/util.h"
@@ -223,6 +224,26 @@ MP_DEFINE_CONST_FUN_OBJ_1(audioio_audioout_get_paused_obj, audioio_audioout_obj_
 MP_PROPERTY_GETTER(audioio_audioout_paused_obj,
     (mp_obj_t)&audioio_audioout_get_paused_obj);
 
+//|     dma_stats: audiocore.DMAStats
+//|     """Buffer and underrun counts for the current or most recent playback. (read-only)"""
+//|
+static mp_obj_t audioio_audioout_obj_get_dma_stats(mp_obj_t self_in) {
+    audioio_audioout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    audiocore_dma_stats_t stats;
+    common_hal_audioio_audioout_get_dma_stats(self, &stats);
+    return audiocore_dma_stats_to_obj(&stats);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(audioio_audioout_get_dma_stats_obj, audioio_audioout_obj_get_dma_stats);
+
+MP_PROPERTY_GETTER(audioio_audioout_dma_stats_obj,
+    (mp_obj_t)&audioio_audioout_get_dma_stats_obj);
+
+// Ports whose audio output does not go through audio_dma have nothing to report.
+MP_WEAK void common_hal_audioio_audioout_get_dma_stats(audioio_audioout_obj_t *self, audiocore_dma_stats_t *stats) {
+    *stats = (audiocore_dma_stats_t) { 0 };
+}
+
 static const mp_rom_map_elem_t audioio_audioout_locals_dict_table[] = {
     // Methods
     { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&audioio_audioout_deinit_obj) },
@@ -237,6 +258,7 @@ static const mp_rom_map_elem_t audioio_audioout_locals_dict_table[] = {
     // Properties
     { MP_ROM_QSTR(MP_QSTR_playing), MP_ROM_PTR(&audioio_audioout_playing_obj) },
     { MP_ROM_QSTR(MP_QSTR_paused), MP_ROM_PTR(&audioio_audioout_paused_obj) },
+    { MP_ROM_QSTR(MP_QSTR_dma_stats), MP_ROM_PTR(&audioio_audioout_dma_stats_obj) },
 };
 static MP_DEFINE_CONST_DICT(audioio_audioout_locals_dict, audioio_audioout_locals_dict_table);
 
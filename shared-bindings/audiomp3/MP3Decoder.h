@@ -15,7 +15,7 @@
 extern const mp_obj_type_t audiomp3_mp3file_type;
 
 void common_hal_audiomp3_mp3file_construct(audiomp3_mp3file_obj_t *self,
-    mp_obj_t stream, uint8_t *buffer, size_t buffer_size);
+    mp_obj_t stream, uint8_t *buffer, size_t buffer_size, bool use_second_core);
 
 void common_hal_audiomp3_mp3file_set_file(audiomp3_mp3file_obj_t *self, mp_obj_t stream);
 void common_hal_audiomp3_mp3file_deinit(audiomp3_mp3file_obj_t *self);
@@ -9,6 +9,7 @@
 #include "common-hal/audiopwmio/PWMAudioOut.h"
 #include "common-hal/microcontroller/Pin.h"
 #include "shared-bindings/audiocore/RawSample.h"
+#include "shared-module/audiocore/__init__.h"
 
 extern const mp_obj_type_t audiopwmio_pwmaudioout_type;
 
@@ -18,9 +19,11 @@ void common_hal_audiopwmio_pwmaudioout_construct(audiopwmio_pwmaudioout_obj_t *s
 
 void common_hal_audiopwmio_pwmaudioout_deinit(audiopwmio_pwmaudioout_obj_t *self);
 bool common_hal_audiopwmio_pwmaudioout_deinited(audiopwmio_pwmaudioout_obj_t *self);
-void common_hal_audiopwmio_pwmaudioout_play(audiopwmio_pwmaudioout_obj_t *self, mp_obj_t sample, bool loop);
+void common_hal_audiopwmio_pwmaudioout_play(audiopwmio_pwmaudioout_obj_t *self, mp_obj_t sample, bool loop,
+    uint8_t buffer_count, uint32_t target_latency_us);
 void common_hal_audiopwmio_pwmaudioout_stop(audiopwmio_pwmaudioout_obj_t *self);
 bool common_hal_audiopwmio_pwmaudioout_get_playing(audiopwmio_pwmaudioout_obj_t *self);
 void common_hal_audiopwmio_pwmaudioout_pause(audiopwmio_pwmaudioout_obj_t *self);
 void common_hal_audiopwmio_pwmaudioout_resume(audiopwmio_pwmaudioout_obj_t *self);
 bool common_hal_audiopwmio_pwmaudioout_get_paused(audiopwmio_pwmaudioout_obj_t *self);
+void common_hal_audiopwmio_pwmaudioout_get_dma_stats(audiopwmio_pwmaudioout_obj_t *self, audiocore_dma_stats_t *stats);
@@ -85,6 +85,33 @@ static mp_float_t get_m(mp_obj_t mul_obj, int sum) {
     return mul_obj != mp_const_none ? mp_obj_get_float(mul_obj) : sum ? 1 / (mp_float_t)sum : 1;
 }
 
+// Validate a morph kernel and return its number of weights.
+static size_t get_morph_weights_len(mp_obj_t weights) {
+    mp_obj_t obj_len = mp_obj_len(weights);
+    if (obj_len == MP_OBJ_NULL || !mp_obj_is_small_int(obj_len)) {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("%q must be of type %q, not %q"), MP_QSTR_weights, MP_QSTR_Sequence, mp_obj_get_type_qstr(weights));
+    }
+
+    size_t n_weights = MP_OBJ_SMALL_INT_VALUE(obj_len);
+
+    size_t sq_n_weights = (int)MICROPY_FLOAT_C_FUN(sqrt)(n_weights);
+    if (sq_n_weights % 2 == 0 || sq_n_weights * sq_n_weights != n_weights) {
+        mp_raise_ValueError(MP_ERROR_TEXT("weights must be a sequence with an odd square number of elements (usually 9 or 25)"));
+    }
+    return n_weights;
+}
+
+// Convert the morph kernel to integers, returning the sum of the weights.
+static int get_morph_weights(mp_obj_t weights, size_t n_weights, int *iweights) {
+    int weight_sum = 0;
+    for (size_t i = 0; i < n_weights; i++) {
+        mp_int_t j = mp_obj_get_int(mp_obj_subscr(weights, MP_OBJ_NEW_SMALL_INT(i), MP_OBJ_SENTINEL));
+        iweights[i] = j;
+        weight_sum += j;
+    }
+    return weight_sum;
+}
+
 static mp_obj_t bitmapfilter_morph(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_bitmap, ARG_weights, ARG_mul, ARG_add, ARG_threshold, ARG_offset, ARG_invert, ARG_mask };
     static const mp_arg_t allowed_args[] = {
@@ -112,25 +139,11 @@ static mp_obj_t bitmapfilter_morph(size_t n_args, const mp_obj_t *pos_args, mp_m
     mp_float_t b = mp_obj_get_float(args[ARG_add].u_obj);
 
     mp_obj_t weights = args[ARG_weights].u_obj;
-    mp_obj_t obj_len = mp_obj_len(weights);
-    if (obj_len == MP_OBJ_NULL || !mp_obj_is_small_int(obj_len)) {
-        mp_raise_ValueError_varg(MP_ERROR_TEXT("%q must be of type %q, not %q"), MP_QSTR_weights, MP_QSTR_Sequence, mp_obj_get_type_qstr(weights));
-    }
-
-    size_t n_weights = MP_OBJ_SMALL_INT_VALUE(obj_len);
-
+    size_t n_weights = get_morph_weights_len(weights);
     size_t sq_n_weights = (int)MICROPY_FLOAT_C_FUN(sqrt)(n_weights);
-    if (sq_n_weights % 2 == 0 || sq_n_weights * sq_n_weights != n_weights) {
-        mp_raise_ValueError(MP_ERROR_TEXT("weights must be a sequence with an odd square number of elements (usually 9 or 25)"));
-    }
 
     int iweights[n_weights];
-    int weight_sum = 0;
-    for (size_t i = 0; i < n_weights; i++) {
-        mp_int_t j = mp_obj_get_int(mp_obj_subscr(weights, MP_OBJ_NEW_SMALL_INT(i), MP_OBJ_SENTINEL));
-        iweights[i] = j;
-        weight_sum += j;
-    }
+    int weight_sum = get_morph_weights(weights, n_weights, iweights);
 
     mp_float_t m = get_m(args[ARG_mul].u_obj, weight_sum);
 
@@ -351,23 +364,9 @@ static const mp_obj_namedtuple_type_t bitmapfilter_channel_mixer_offset_type = {
 //|     Only pixels set to a non-zero value in the mask are modified.
 //|     """
 //|
-static mp_obj_t bitmapfilter_mix(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    enum { ARG_bitmap, ARG_weights, ARG_mask };
-    static const mp_arg_t allowed_args[] = {
-        { MP_QSTR_bitmap, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_obj = MP_OBJ_NULL } },
-        { MP_QSTR_weights, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_obj = MP_OBJ_NULL } },
-        { MP_QSTR_mask, MP_ARG_OBJ, { .u_obj = MP_ROM_NONE } },
-    };
-    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
-    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
-
-    mp_arg_validate_type(args[ARG_bitmap].u_obj, &displayio_bitmap_type, MP_QSTR_bitmap);
-    displayio_bitmap_t *bitmap = MP_OBJ_TO_PTR(args[ARG_bitmap].u_obj);
+static void get_mix_weights(mp_obj_t weights_obj, mp_float_t weights[12]) {
+    memset(weights, 0, 12 * sizeof(mp_float_t));
 
-    mp_float_t weights[12];
-    memset(weights, 0, sizeof(weights));
-
-    mp_obj_t weights_obj = args[ARG_weights].u_obj;
     if (mp_obj_is_type(weights_obj, (const mp_obj_type_t *)&bitmapfilter_channel_scale_type)) {
         for (int i = 0; i < 3; i++) {
             weights[5 * i] = float_subscr(weights_obj, i);
@@ -393,7 +392,23 @@ static mp_obj_t bitmapfilter_mix(size_t n_args, const mp_obj_t *pos_args, mp_map
             mp_obj_get_type_qstr(weights_obj)
             );
     }
+}
+
+static mp_obj_t bitmapfilter_mix(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_bitmap, ARG_weights, ARG_mask };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_bitmap, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_obj = MP_OBJ_NULL } },
+        { MP_QSTR_weights, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_obj = MP_OBJ_NULL } },
+        { MP_QSTR_mask, MP_ARG_OBJ, { .u_obj = MP_ROM_NONE } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
+    mp_arg_validate_type(args[ARG_bitmap].u_obj, &displayio_bitmap_type, MP_QSTR_bitmap);
+    displayio_bitmap_t *bitmap = MP_OBJ_TO_PTR(args[ARG_bitmap].u_obj);
+
+    mp_float_t weights[12];
+    get_mix_weights(args[ARG_weights].u_obj, weights);
 
     displayio_bitmap_t *mask = NULL;
     if (args[ARG_mask].u_obj != mp_const_none) {
@@ -490,6 +505,28 @@ static int scaled_lut(int maxval, mp_obj_t func, int i) {
     return (int)MICROPY_FLOAT_C_FUN(round)(val * maxval);
 }
 
+static void get_lookup_table(mp_obj_t lookup, bitmapfilter_lookup_table_t *table) {
+    mp_obj_t lookup_r, lookup_g, lookup_b;
+
+    if (mp_obj_is_tuple_compatible(lookup)) {
+        mp_obj_tuple_t *lookup_tuple = MP_OBJ_TO_PTR(lookup);
+        mp_arg_validate_length(lookup_tuple->len, 3, MP_QSTR_lookup);
+        lookup_r = lookup_tuple->items[0];
+        lookup_g = lookup_tuple->items[1];
+        lookup_b = lookup_tuple->items[2];
+    } else {
+        lookup_r = lookup_g = lookup_b = lookup;
+    }
+
+    for (int i = 0; i < 32; i++) {
+        table->r[i] = scaled_lut(31, lookup_r, i);
+        table->b[i] = lookup_r == lookup_b ? table->r[i] : scaled_lut(31, lookup_b, i);
+    }
+    for (int i = 0; i < 64; i++) {
+        table->g[i] = scaled_lut(63, lookup_g, i);
+    }
+}
+
 static mp_obj_t bitmapfilter_lookup(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_bitmap, ARG_lookup, ARG_mask };
     static const mp_arg_t allowed_args[] = {
@@ -503,27 +540,8 @@ static mp_obj_t bitmapfilter_lookup(size_t n_args, const mp_obj_t *pos_args, mp_
     mp_arg_validate_type(args[ARG_bitmap].u_obj, &displayio_bitmap_type, MP_QSTR_bitmap);
     displayio_bitmap_t *bitmap = MP_OBJ_TO_PTR(args[ARG_bitmap].u_obj);
 
-    mp_obj_t lookup_r, lookup_g, lookup_b;
-
-    if (mp_obj_is_tuple_compatible(args[ARG_lookup].u_obj)) {
-        mp_obj_tuple_t *lookup_tuple = MP_OBJ_TO_PTR(args[ARG_lookup].u_obj);
-        mp_arg_validate_length(lookup_tuple->len, 3, MP_QSTR_lookup);
-        lookup_r = lookup_tuple->items[0];
-        lookup_g = lookup_tuple->items[1];
-        lookup_b = lookup_tuple->items[2];
-    } else {
-        lookup_r = lookup_g = lookup_b = args[ARG_lookup].u_obj;
-    }
-
     bitmapfilter_lookup_table_t table;
-
-    for (int i = 0; i < 32; i++) {
-        table.r[i] = scaled_lut(31, lookup_r, i);
-        table.b[i] = lookup_r == lookup_b ? table.r[i] : scaled_lut(31, lookup_b, i);
-    }
-    for (int i = 0; i < 64; i++) {
-        table.g[i] = scaled_lut(63, lookup_g, i);
-    }
+    get_lookup_table(args[ARG_lookup].u_obj, &table);
 
     displayio_bitmap_t *mask = NULL;
     if (args[ARG_mask].u_obj != mp_const_none) {
@@ -562,6 +580,13 @@ MP_DEFINE_CONST_FUN_OBJ_KW(bitmapfilter_lookup_obj, 0, bitmapfilter_lookup);
 //|     Only pixels set to a non-zero value in the mask are modified.
 //|     """
 //|
+static displayio_palette_t *get_false_color_palette(mp_obj_t palette_obj) {
+    mp_arg_validate_type(palette_obj, &displayio_palette_type, MP_QSTR_palette);
+    displayio_palette_t *palette = MP_OBJ_TO_PTR(palette_obj);
+    mp_arg_validate_length(palette->color_count, 256, MP_QSTR_palette);
+    return palette;
+}
+
 static mp_obj_t bitmapfilter_false_color(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_bitmap, ARG_palette, ARG_mask };
     static const mp_arg_t allowed_args[] = {
@@ -575,9 +600,7 @@ static mp_obj_t bitmapfilter_false_color(size_t n_args, const mp_obj_t *pos_args
     mp_arg_validate_type(args[ARG_bitmap].u_obj, &displayio_bitmap_type, MP_QSTR_bitmap);
     displayio_bitmap_t *bitmap = MP_OBJ_TO_PTR(args[ARG_bitmap].u_obj);
 
-    mp_arg_validate_type(args[ARG_palette].u_obj, &displayio_palette_type, MP_QSTR_palette);
-    displayio_palette_t *palette = MP_OBJ_TO_PTR(args[ARG_palette].u_obj);
-    mp_arg_validate_length(palette->color_count, 256, MP_QSTR_palette);
+    displayio_palette_t *palette = get_false_color_palette(args[ARG_palette].u_obj);
 
     displayio_bitmap_t *mask = NULL;
     if (args[ARG_mask].u_obj != mp_const_none) {
@@ -713,6 +736,185 @@ static mp_obj_t bitmapfilter_blend(size_t n_args, const mp_obj_t *pos_args, mp_m
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(bitmapfilter_blend_obj, 0, bitmapfilter_blend);
 
+//| class Pipeline:
+//|     """A sequence of bitmapfilter operations applied in as few passes as possible
+//|
+//|     Each of the per-pixel operations `mix`, `solarize`, `lookup` and
+//|     `false_color` reads and writes every pixel of the bitmap. When several of
+//|     them are added to a Pipeline, they are all applied to each pixel in a
+//|     single pass over the bitmap instead.
+//|
+//|     `morph` depends on neighboring pixels, so it runs as its own pass, after
+//|     the operations before it and before the operations after it.
+//|
+//|     Any function arguments (such as the ``lookup`` functions) are evaluated
+//|     when the operation is added, not when the pipeline is applied.
+//|
+//|     .. code-block:: python
+//|
+//|         pre = bitmapfilter.Pipeline()
+//|         pre.lookup(gamma).mix(sepia_weights).solarize(0.75)
+//|
+//|         while True:
+//|             camera.take(bitmap)
+//|             pre.apply(bitmap)
+//|     """
+//|
+//|     def __init__(self) -> None:
+//|         """Construct an empty Pipeline"""
+//|
+static mp_obj_t bitmapfilter_pipeline_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    mp_arg_check_num(n_args, n_kw, 0, 0, false);
+    bitmapfilter_pipeline_obj_t *self = mp_obj_malloc(bitmapfilter_pipeline_obj_t, &bitmapfilter_pipeline_type);
+    shared_module_bitmapfilter_pipeline_construct(self);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|     def mix(
+//|         self, weights: ChannelScale | ChannelScaleOffset | ChannelMixer | ChannelMixerOffset
+//|     ) -> Pipeline:
+//|         """Add a `bitmapfilter.mix` operation to the pipeline"""
+//|
+static mp_obj_t bitmapfilter_pipeline_mix(mp_obj_t self_in, mp_obj_t weights_obj) {
+    bitmapfilter_pipeline_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_float_t weights[12];
+    get_mix_weights(weights_obj, weights);
+    shared_module_bitmapfilter_pipeline_mix(self, weights);
+    return self_in;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(bitmapfilter_pipeline_mix_obj, bitmapfilter_pipeline_mix);
+
+//|     def solarize(self, threshold: float = 0.5) -> Pipeline:
+//|         """Add a `bitmapfilter.solarize` operation to the pipeline"""
+//|
+static mp_obj_t bitmapfilter_pipeline_solarize(size_t n_args, const mp_obj_t *args) {
+    bitmapfilter_pipeline_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_float_t threshold = n_args > 1 ? mp_obj_get_float(args[1]) : MICROPY_FLOAT_CONST(0.5);
+    shared_module_bitmapfilter_pipeline_solarize(self, threshold);
+    return args[0];
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(bitmapfilter_pipeline_solarize_obj, 1, 2, bitmapfilter_pipeline_solarize);
+
+//|     def lookup(self, lookup: LookupFunction | ThreeLookupFunctions) -> Pipeline:
+//|         """Add a `bitmapfilter.lookup` operation to the pipeline"""
+//|
+static mp_obj_t bitmapfilter_pipeline_lookup(mp_obj_t self_in, mp_obj_t lookup) {
+    bitmapfilter_pipeline_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    bitmapfilter_lookup_table_t table;
+    get_lookup_table(lookup, &table);
+    shared_module_bitmapfilter_pipeline_lookup(self, &table);
+    return self_in;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(bitmapfilter_pipeline_lookup_obj, bitmapfilter_pipeline_lookup);
+
+//|     def false_color(self, palette: displayio.Palette) -> Pipeline:
+//|         """Add a `bitmapfilter.false_color` operation to the pipeline"""
+//|
+static mp_obj_t bitmapfilter_pipeline_false_color(mp_obj_t self_in, mp_obj_t palette_obj) {
+    bitmapfilter_pipeline_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    displayio_palette_t *palette = get_false_color_palette(palette_obj);
+    shared_module_bitmapfilter_pipeline_false_color(self, palette->colors);
+    return self_in;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(bitmapfilter_pipeline_false_color_obj, bitmapfilter_pipeline_false_color);
+
+//|     def morph(
+//|         self,
+//|         weights: Sequence[int],
+//|         mul: float | None = None,
+//|         add: float = 0,
+//|         threshold=False,
+//|         offset: int = 0,
+//|         invert: bool = False,
+//|     ) -> Pipeline:
+//|         """Add a `bitmapfilter.morph` operation to the pipeline
+//|
+//|         This operation needs neighboring pixels, so it ends the current pass
+//|         over the bitmap and runs as a pass of its own."""
+//|
+static mp_obj_t bitmapfilter_pipeline_morph(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_weights, ARG_mul, ARG_add, ARG_threshold, ARG_offset, ARG_invert };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_weights, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_obj = MP_OBJ_NULL } },
+        { MP_QSTR_mul, MP_ARG_OBJ, { .u_obj = MP_ROM_NONE } },
+        { MP_QSTR_add, MP_ARG_OBJ, { .u_obj = MP_ROM_INT(0) } },
+        { MP_QSTR_threshold, MP_ARG_BOOL, { .u_bool = false } },
+        { MP_QSTR_offset, MP_ARG_INT, { .u_int = 0 } },
+        { MP_QSTR_invert, MP_ARG_BOOL, { .u_bool = false } },
+    };
+    bitmapfilter_pipeline_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_float_t b = mp_obj_get_float(args[ARG_add].u_obj);
+
+    mp_obj_t weights = args[ARG_weights].u_obj;
+    size_t n_weights = get_morph_weights_len(weights);
+    size_t sq_n_weights = (int)MICROPY_FLOAT_C_FUN(sqrt)(n_weights);
+
+    int iweights[n_weights];
+    int weight_sum = get_morph_weights(weights, n_weights, iweights);
+
+    mp_float_t m = get_m(args[ARG_mul].u_obj, weight_sum);
+
+    shared_module_bitmapfilter_pipeline_morph(self, sq_n_weights / 2, iweights, m, b,
+        args[ARG_threshold].u_bool, args[ARG_offset].u_int, args[ARG_invert].u_bool);
+    return pos_args[0];
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(bitmapfilter_pipeline_morph_obj, 1, bitmapfilter_pipeline_morph);
+
+//|     def apply(self, bitmap: displayio.Bitmap, mask: displayio.Bitmap | None = None) -> displayio.Bitmap:
+//|         """Apply all the operations in the pipeline to the bitmap, in order
+//|
+//|         The ``bitmap`` must be in RGB565_SWAPPED format.
+//|
+//|         ``mask`` is another image to use as a pixel level mask for every
+//|         operation in the pipeline, with the same meaning as for the
+//|         individual functions."""
+//|
+//|
+static mp_obj_t bitmapfilter_pipeline_apply(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_bitmap, ARG_mask };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_bitmap, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_obj = MP_OBJ_NULL } },
+        { MP_QSTR_mask, MP_ARG_OBJ, { .u_obj = MP_ROM_NONE } },
+    };
+    bitmapfilter_pipeline_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_arg_validate_type(args[ARG_bitmap].u_obj, &displayio_bitmap_type, MP_QSTR_bitmap);
+    displayio_bitmap_t *bitmap = MP_OBJ_TO_PTR(args[ARG_bitmap].u_obj);
+
+    displayio_bitmap_t *mask = NULL;
+    if (args[ARG_mask].u_obj != mp_const_none) {
+        mp_arg_validate_type(args[ARG_mask].u_obj, &displayio_bitmap_type, MP_QSTR_mask);
+        mask = MP_OBJ_TO_PTR(args[ARG_mask].u_obj);
+    }
+
+    shared_module_bitmapfilter_pipeline_apply(self, bitmap, mask);
+    return args[ARG_bitmap].u_obj;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(bitmapfilter_pipeline_apply_obj, 1, bitmapfilter_pipeline_apply);
+
+static const mp_rom_map_elem_t bitmapfilter_pipeline_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_mix), MP_ROM_PTR(&bitmapfilter_pipeline_mix_obj) },
+    { MP_ROM_QSTR(MP_QSTR_solarize), MP_ROM_PTR(&bitmapfilter_pipeline_solarize_obj) },
+    { MP_ROM_QSTR(MP_QSTR_lookup), MP_ROM_PTR(&bitmapfilter_pipeline_lookup_obj) },
+    { MP_ROM_QSTR(MP_QSTR_false_color), MP_ROM_PTR(&bitmapfilter_pipeline_false_color_obj) },
+    { MP_ROM_QSTR(MP_QSTR_morph), MP_ROM_PTR(&bitmapfilter_pipeline_morph_obj) },
+    { MP_ROM_QSTR(MP_QSTR_apply), MP_ROM_PTR(&bitmapfilter_pipeline_apply_obj) },
+};
+static MP_DEFINE_CONST_DICT(bitmapfilter_pipeline_locals_dict, bitmapfilter_pipeline_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    bitmapfilter_pipeline_type,
+    MP_QSTR_Pipeline,
+    MP_TYPE_FLAG_NONE,
+    make_new, bitmapfilter_pipeline_make_new,
+    locals_dict, &bitmapfilter_pipeline_locals_dict
+    );
+
 static const mp_rom_map_elem_t bitmapfilter_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_bitmapfilter) },
     { MP_ROM_QSTR(MP_QSTR_morph), MP_ROM_PTR(&bitmapfilter_morph_obj) },
@@ -726,6 +928,7 @@ static const mp_rom_map_elem_t bitmapfilter_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_ChannelMixerOffset), MP_ROM_PTR(&bitmapfilter_channel_mixer_offset_type) },
     { MP_ROM_QSTR(MP_QSTR_blend), MP_ROM_PTR(&bitmapfilter_blend_obj) },
     { MP_ROM_QSTR(MP_QSTR_blend_precompute), MP_ROM_PTR(&bitmapfilter_blend_precompute_obj) },
+    { MP_ROM_QSTR(MP_QSTR_Pipeline), MP_ROM_PTR(&bitmapfilter_pipeline_type) },
 };
 static MP_DEFINE_CONST_DICT(bitmapfilter_module_globals, bitmapfilter_module_globals_table);
 
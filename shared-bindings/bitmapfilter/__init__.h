@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "shared-module/bitmapfilter/__init__.h"
 #include "shared-module/displayio/Bitmap.h"
 
 void shared_module_bitmapfilter_morph(
@@ -40,10 +41,6 @@ void shared_module_bitmapfilter_solarize(
     displayio_bitmap_t *mask,
     const mp_float_t threshold);
 
-typedef struct {
-    uint8_t r[32], g[64], b[32];
-} bitmapfilter_lookup_table_t;
-
 void shared_module_bitmapfilter_lookup(
     displayio_bitmap_t *bitmap,
     displayio_bitmap_t *mask,
@@ -62,3 +59,24 @@ void shared_module_bitmapfilter_blend(
     displayio_bitmap_t *src2,
     displayio_bitmap_t *mask,
     const uint8_t lookup[4096]);
+
+extern const mp_obj_type_t bitmapfilter_pipeline_type;
+
+void shared_module_bitmapfilter_pipeline_construct(bitmapfilter_pipeline_obj_t *self);
+void shared_module_bitmapfilter_pipeline_mix(bitmapfilter_pipeline_obj_t *self, const mp_float_t weights[12]);
+void shared_module_bitmapfilter_pipeline_solarize(bitmapfilter_pipeline_obj_t *self, const mp_float_t threshold);
+void shared_module_bitmapfilter_pipeline_lookup(bitmapfilter_pipeline_obj_t *self, const bitmapfilter_lookup_table_t *table);
+void shared_module_bitmapfilter_pipeline_false_color(bitmapfilter_pipeline_obj_t *self, _displayio_color_t palette[256]);
+void shared_module_bitmapfilter_pipeline_morph(
+    bitmapfilter_pipeline_obj_t *self,
+    const int ksize,
+    const int *krn,
+    const mp_float_t m,
+    const mp_float_t b,
+    bool threshold,
+    int offset,
+    bool invert);
+void shared_module_bitmapfilter_pipeline_apply(
+    bitmapfilter_pipeline_obj_t *self,
+    displayio_bitmap_t *bitmap,
+    displayio_bitmap_t *mask);
@@ -21,8 +21,11 @@
 //|     stream of bytes suitable for sending via a parallel conversion method.
 //|
 //|     The number of bytes in the input buffer must be a multiple of the width,
-//|     and the width can be any value from 2 to 8.  If the width is fewer than 8,
+//|     and the width can be any value from 2 to 16.  If the width is fewer than 8,
 //|     then the remaining (less significant) bits of the output are set to zero.
+//|     If the width is more than 8, each output byte is followed by a byte made
+//|     the same way from the 9th and later inputs, with its remaining low bits
+//|     set to zero.
 //|
 //|     Let ``stride = len(input)//width``.  Then the first byte is made out of the
 //|     most significant bits of ``[input[0], input[stride], input[2*stride], ...]``.
@@ -30,7 +33,8 @@
 //|     byte which is made of the first bits of ``input[1], input[1+stride,
 //|     input[2*stride], ...]``.
 //|
-//|     The required output buffer size is ``len(input) * 8  // width``.
+//|     The required output buffer size is ``len(input) * 8  // width``, or
+//|     ``len(input) * 16 // width`` when the width is more than 8.
 //|
 //|     Returns the output buffer."""
 //|     ...
@@ -39,14 +43,14 @@
 static mp_obj_t bit_transpose(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_input, ARG_output, ARG_width };
     static const mp_arg_t allowed_args[] = {
-        { MP_QSTR_input, MP_ARG_OBJ | MP_ARG_REQUIRED },
-        { MP_QSTR_output, MP_ARG_OBJ | MP_ARG_REQUIRED },
+        { MP_QSTR_input, MP_ARG_OBJ | MP_ARG_REQUIRED, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_output, MP_ARG_OBJ | MP_ARG_REQUIRED, {.u_obj = MP_OBJ_NULL} },
         { MP_QSTR_width, MP_ARG_INT, { .u_int = 8 } },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
-    mp_int_t width = mp_arg_validate_int_range(args[ARG_width].u_int, 2, 8, MP_QSTR_width);
+    mp_int_t width = mp_arg_validate_int_range(args[ARG_width].u_int, 2, 16, MP_QSTR_width);
 
     mp_buffer_info_t input_bufinfo;
     mp_get_buffer_raise(args[ARG_input].u_obj, &input_bufinfo, MP_BUFFER_READ);
@@ -58,7 +62,7 @@ static mp_obj_t bit_transpose(size_t n_args, const mp_obj_t *pos_args, mp_map_t
     mp_buffer_info_t output_bufinfo;
     mp_get_buffer_raise(args[ARG_output].u_obj, &output_bufinfo, MP_BUFFER_WRITE);
     int avail = output_bufinfo.len;
-    int outlen = 8 * (inlen / width);
+    int outlen = (width > 8 ? 16 : 8) * (inlen / width);
 
     mp_arg_validate_length_min(avail, outlen, MP_QSTR_output);
 
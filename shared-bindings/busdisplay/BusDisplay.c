@@ -65,7 +65,8 @@
 //|         auto_refresh: bool = True,
 //|         native_frames_per_second: int = 60,
 //|         backlight_on_high: bool = True,
-//|         SH1107_addressing: bool = False
+//|         SH1107_addressing: bool = False,
+//|         refresh_buffer_size: int = 0
 //|     ) -> None:
 //|         r"""Create a Display object on the given display bus (`FourWire`, `paralleldisplaybus.ParallelBus` or `I2CDisplayBus`).
 //|
@@ -123,6 +124,9 @@
 //|         :param bool SH1107_addressing: Special quirk for SH1107, use upper/lower column set and page set
 //|         :param int set_vertical_scroll: This parameter is accepted but ignored for backwards compatibility. It will be removed in a future release.
 //|         :param int backlight_pwm_frequency: The frequency to use to drive the PWM for backlight brightness control. Default is 50000.
+//|         :param int refresh_buffer_size: Size in bytes of a persistent buffer, allocated outside the VM heap, used to
+//|             send pixels. Larger buffers send big areas in fewer, larger bus transfers. 0 uses a small buffer on the
+//|             stack. The default is board specific and usually 0.
 //|         """
 //|         ...
 static mp_obj_t busdisplay_busdisplay_make_new(const mp_obj_type_t *type, size_t n_args,
@@ -134,7 +138,7 @@ static mp_obj_t busdisplay_busdisplay_make_new(const mp_obj_type_t *type, size_t
            ARG_set_vertical_scroll, ARG_backlight_pin, ARG_brightness_command,
            ARG_brightness, ARG_single_byte_bounds, ARG_data_as_commands,
            ARG_auto_refresh, ARG_native_frames_per_second, ARG_backlight_on_high,
-           ARG_SH1107_addressing, ARG_backlight_pwm_frequency };
+           ARG_SH1107_addressing, ARG_backlight_pwm_frequency, ARG_refresh_buffer_size };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_display_bus, MP_ARG_REQUIRED | MP_ARG_OBJ },
         { MP_QSTR_init_sequence, MP_ARG_REQUIRED | MP_ARG_OBJ },
@@ -162,7 +166,8 @@ static mp_obj_t busdisplay_busdisplay_make_new(const mp_obj_type_t *type, size_t
         { MP_QSTR_native_frames_per_second, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 60} },
         { MP_QSTR_backlight_on_high, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = true} },
         { MP_QSTR_SH1107_addressing, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
-        { MP_QSTR_backlight_pwm_frequency, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 50000} }
+        { MP_QSTR_backlight_pwm_frequency, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 50000} },
+        { MP_QSTR_refresh_buffer_size, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = CIRCUITPY_BUSDISPLAY_REFRESH_BUFFER_SIZE} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -188,6 +193,8 @@ static mp_obj_t busdisplay_busdisplay_make_new(const mp_obj_type_t *type, size_t
         mp_raise_ValueError_varg(MP_ERROR_TEXT("%q must be 1 when %q is True"), MP_QSTR_color_depth, MP_QSTR_SH1107_addressing);
     }
 
+    const mp_int_t refresh_buffer_size = mp_arg_validate_int_min(args[ARG_refresh_buffer_size].u_int, 0, MP_QSTR_refresh_buffer_size);
+
     primary_display_t *disp = allocate_display_or_raise();
     busdisplay_busdisplay_obj_t *self = &disp->display;
 
@@ -215,6 +222,10 @@ static mp_obj_t busdisplay_busdisplay_make_new(const mp_obj_type_t *type, size_t
         args[ARG_backlight_pwm_frequency].u_int
         );
 
+    if (refresh_buffer_size != CIRCUITPY_BUSDISPLAY_REFRESH_BUFFER_SIZE) {
+        common_hal_busdisplay_busdisplay_set_refresh_buffer_size(self, refresh_buffer_size);
+    }
+
     return self;
 }
 
@@ -379,6 +390,18 @@ MP_PROPERTY_GETSET(busdisplay_busdisplay_rotation_obj,
     (mp_obj_t)&busdisplay_busdisplay_get_rotation_obj,
     (mp_obj_t)&busdisplay_busdisplay_set_rotation_obj);
 
+//|     refresh_buffer_size: int
+//|     """Size in bytes of the persistent refresh buffer. 0 when the small stack buffer is used,
+//|     including when the requested buffer could not be allocated."""
+static mp_obj_t busdisplay_busdisplay_obj_get_refresh_buffer_size(mp_obj_t self_in) {
+    busdisplay_busdisplay_obj_t *self = native_display(self_in);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_busdisplay_busdisplay_get_refresh_buffer_size(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(busdisplay_busdisplay_get_refresh_buffer_size_obj, busdisplay_busdisplay_obj_get_refresh_buffer_size);
+
+MP_PROPERTY_GETTER(busdisplay_busdisplay_refresh_buffer_size_obj,
+    (mp_obj_t)&busdisplay_busdisplay_get_refresh_buffer_size_obj);
+
 //|     bus: _DisplayBus
 //|     """The bus being used by the display"""
 static mp_obj_t busdisplay_busdisplay_obj_get_bus(mp_obj_t self_in) {
@@ -390,6 +413,23 @@ MP_DEFINE_CONST_FUN_OBJ_1(busdisplay_busdisplay_get_bus_obj, busdisplay_busdispl
 MP_PROPERTY_GETTER(busdisplay_busdisplay_bus_obj,
     (mp_obj_t)&busdisplay_busdisplay_get_bus_obj);
 
+//|     refresh_stats: Tuple[int, int, int, int, int, int, int]
+//|     """What the last finished refresh did, as a named tuple
+//|     ``(frames, frames_skipped, areas, pixels, bytes, fill_us, send_us)``.
+//|
+//|     ``frames`` and ``frames_skipped`` count every refresh since the display was created,
+//|     where a skipped frame is one `refresh` dropped to catch up with ``target_frames_per_second``.
+//|     The rest describe the last refresh: the dirty areas drawn, the pixels composited, the
+//|     bytes sent to the display, and the microseconds spent compositing and sending them."""
+static mp_obj_t busdisplay_busdisplay_obj_get_refresh_stats(mp_obj_t self_in) {
+    busdisplay_busdisplay_obj_t *self = native_display(self_in);
+    return common_hal_busdisplay_busdisplay_get_refresh_stats(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(busdisplay_busdisplay_get_refresh_stats_obj, busdisplay_busdisplay_obj_get_refresh_stats);
+
+MP_PROPERTY_GETTER(busdisplay_busdisplay_refresh_stats_obj,
+    (mp_obj_t)&busdisplay_busdisplay_get_refresh_stats_obj);
+
 //|     root_group: displayio.Group
 //|     """The root group on the display.
 //|     If the root group is set to `displayio.CIRCUITPYTHON_TERMINAL`, the default CircuitPython terminal will be shown.
@@ -489,7 +529,9 @@ static const mp_rom_map_elem_t busdisplay_busdisplay_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_width), MP_ROM_PTR(&busdisplay_busdisplay_width_obj) },
     { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&busdisplay_busdisplay_height_obj) },
     { MP_ROM_QSTR(MP_QSTR_rotation), MP_ROM_PTR(&busdisplay_busdisplay_rotation_obj) },
+    { MP_ROM_QSTR(MP_QSTR_refresh_buffer_size), MP_ROM_PTR(&busdisplay_busdisplay_refresh_buffer_size_obj) },
     { MP_ROM_QSTR(MP_QSTR_bus), MP_ROM_PTR(&busdisplay_busdisplay_bus_obj) },
+    { MP_ROM_QSTR(MP_QSTR_refresh_stats), MP_ROM_PTR(&busdisplay_busdisplay_refresh_stats_obj) },
     { MP_ROM_QSTR(MP_QSTR_root_group), MP_ROM_PTR(&busdisplay_busdisplay_root_group_obj) },
 };
 static MP_DEFINE_CONST_DICT(busdisplay_busdisplay_locals_dict, busdisplay_busdisplay_locals_dict_table);
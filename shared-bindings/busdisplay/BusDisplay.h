@@ -39,9 +39,13 @@ void common_hal_busdisplay_busdisplay_set_rotation(busdisplay_busdisplay_obj_t *
 bool common_hal_busdisplay_busdisplay_get_dither(busdisplay_busdisplay_obj_t *self);
 void common_hal_busdisplay_busdisplay_set_dither(busdisplay_busdisplay_obj_t *self, bool dither);
 
+uint32_t common_hal_busdisplay_busdisplay_get_refresh_buffer_size(busdisplay_busdisplay_obj_t *self);
+void common_hal_busdisplay_busdisplay_set_refresh_buffer_size(busdisplay_busdisplay_obj_t *self, uint32_t size);
+
 mp_float_t common_hal_busdisplay_busdisplay_get_brightness(busdisplay_busdisplay_obj_t *self);
 bool common_hal_busdisplay_busdisplay_set_brightness(busdisplay_busdisplay_obj_t *self, mp_float_t brightness);
 
 mp_obj_t common_hal_busdisplay_busdisplay_get_bus(busdisplay_busdisplay_obj_t *self);
 mp_obj_t common_hal_busdisplay_busdisplay_get_root_group(busdisplay_busdisplay_obj_t *self);
+mp_obj_t common_hal_busdisplay_busdisplay_get_refresh_stats(busdisplay_busdisplay_obj_t *self);
 mp_obj_t common_hal_busdisplay_busdisplay_set_root_group(busdisplay_busdisplay_obj_t *self, displayio_group_t *root_group);
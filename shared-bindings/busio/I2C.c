@@ -357,6 +357,66 @@ static mp_obj_t busio_i2c_writeto_then_readfrom(size_t n_args, const mp_obj_t *p
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(busio_i2c_writeto_then_readfrom_obj, 1, busio_i2c_writeto_then_readfrom);
+
+//|     def transfer(
+//|         self,
+//|         transfers: Sequence[
+//|             Tuple[int, Optional[ReadableBuffer], Optional[WriteableBuffer]]
+//|         ],
+//|     ) -> None:
+//|         """Run several transfers, in order, in one call. Each transfer is a tuple of
+//|         ``(address, out_buffer, in_buffer)``. A transfer with only ``out_buffer`` works like
+//|         `writeto`, one with only ``in_buffer`` like `readfrom_into` and one with both like
+//|         `writeto_then_readfrom`. Pass ``None`` for the buffer that isn't used.
+//|
+//|         Polling many devices this way saves the cost of a method call per transfer. The
+//|         transfers still run one after another and this call returns once all are done.
+//|
+//|         Raises `OSError` for the first transfer that fails, without running the rest.
+//|
+//|         :param Sequence transfers: the transfers to run
+//|         """
+//|         ...
+//|
+static mp_obj_t busio_i2c_transfer(mp_obj_t self_in, mp_obj_t transfers_in) {
+    busio_i2c_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    check_lock(self);
+
+    size_t len;
+    mp_obj_t *transfers;
+    mp_obj_get_array(transfers_in, &len, &transfers);
+    for (size_t i = 0; i < len; i++) {
+        mp_obj_t *items;
+        mp_obj_get_array_fixed_n(transfers[i], 3, &items);
+        mp_int_t address = mp_obj_get_int(items[0]);
+
+        mp_buffer_info_t out_bufinfo = { .buf = NULL, .len = 0 };
+        if (items[1] != mp_const_none) {
+            mp_get_buffer_raise(items[1], &out_bufinfo, MP_BUFFER_READ);
+        }
+        mp_buffer_info_t in_bufinfo = { .buf = NULL, .len = 0 };
+        if (items[2] != mp_const_none) {
+            mp_get_buffer_raise(items[2], &in_bufinfo, MP_BUFFER_WRITE);
+            mp_arg_validate_length_min(in_bufinfo.len, 1, MP_QSTR_in_buffer);
+        }
+
+        uint8_t status;
+        if (in_bufinfo.buf == NULL) {
+            status = common_hal_busio_i2c_write(self, address, out_bufinfo.buf, out_bufinfo.len);
+        } else if (out_bufinfo.buf == NULL) {
+            status = common_hal_busio_i2c_read(self, address, in_bufinfo.buf, in_bufinfo.len);
+        } else {
+            status = common_hal_busio_i2c_write_read(self, address,
+                out_bufinfo.buf, out_bufinfo.len, in_bufinfo.buf, in_bufinfo.len);
+        }
+        if (status != 0) {
+            mp_raise_OSError(status);
+        }
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(busio_i2c_transfer_obj, busio_i2c_transfer);
 #endif // CIRCUITPY_BUSIO_I2C
 
 static const mp_rom_map_elem_t busio_i2c_locals_dict_table[] = {
@@ -372,6 +432,7 @@ static const mp_rom_map_elem_t busio_i2c_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_readfrom_into), MP_ROM_PTR(&busio_i2c_readfrom_into_obj) },
     { MP_ROM_QSTR(MP_QSTR_writeto), MP_ROM_PTR(&busio_i2c_writeto_obj) },
     { MP_ROM_QSTR(MP_QSTR_writeto_then_readfrom), MP_ROM_PTR(&busio_i2c_writeto_then_readfrom_obj) },
+    { MP_ROM_QSTR(MP_QSTR_transfer), MP_ROM_PTR(&busio_i2c_transfer_obj) },
     #endif // CIRCUITPY_BUSIO_I2C
 };
 
@@ -31,6 +31,15 @@ extern void common_hal_busio_spi_unlock(busio_spi_obj_t *self);
 // Writes out the given data.
 extern bool common_hal_busio_spi_write(busio_spi_obj_t *self, const uint8_t *data, size_t len);
 
+#if CIRCUITPY_BUSIO_SPI_ASYNC_WRITE
+// Starts writing out the given data and may return before it is done. data must stay valid
+// until common_hal_busio_spi_wait_for_write() returns. Other transfers wait for it to finish.
+extern bool common_hal_busio_spi_start_write(busio_spi_obj_t *self, const uint8_t *data, size_t len);
+
+// Waits for a write started by common_hal_busio_spi_start_write() to finish.
+extern void common_hal_busio_spi_wait_for_write(busio_spi_obj_t *self);
+#endif
+
 // Reads in len bytes while outputting the byte write_value.
 extern bool common_hal_busio_spi_read(busio_spi_obj_t *self, uint8_t *data, size_t len, uint8_t write_value);
 
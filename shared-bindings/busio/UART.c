@@ -275,6 +275,10 @@ static mp_uint_t busio_uart_write(mp_obj_t self_in, const void *buf_in, mp_uint_
     return common_hal_busio_uart_write(self, buf, size, errcode);
 }
 
+MP_WEAK volatile mp_uint_t *common_hal_busio_uart_get_rx_poll_gen(busio_uart_obj_t *self) {
+    return NULL;
+}
+
 static mp_uint_t busio_uart_ioctl(mp_obj_t self_in, mp_uint_t request, mp_uint_t arg, int *errcode) {
     busio_uart_obj_t *self = native_uart(self_in);
     check_for_deinit(self);
@@ -288,6 +292,13 @@ static mp_uint_t busio_uart_ioctl(mp_obj_t self_in, mp_uint_t request, mp_uint_t
         if ((flags & MP_STREAM_POLL_WR) && common_hal_busio_uart_ready_to_tx(self)) {
             ret |= MP_STREAM_POLL_WR;
         }
+    #if MICROPY_PY_SELECT_POLL_GEN
+    } else if (request == MP_STREAM_GET_POLL_GEN) {
+        mp_stream_poll_gen_t *poll_gen = (mp_stream_poll_gen_t *)arg;
+        poll_gen->counter = common_hal_busio_uart_get_rx_poll_gen(self);
+        poll_gen->events = MP_STREAM_POLL_RD;
+        ret = 0;
+    #endif
     } else {
         *errcode = MP_EINVAL;
         ret = MP_STREAM_ERROR;
@@ -47,4 +47,8 @@ extern uint32_t common_hal_busio_uart_rx_characters_available(busio_uart_obj_t *
 extern void common_hal_busio_uart_clear_rx_buffer(busio_uart_obj_t *self);
 extern bool common_hal_busio_uart_ready_to_tx(busio_uart_obj_t *self);
 
+// Returns a counter the port bumps from its receive interrupt, or NULL if it
+// has none. See MP_STREAM_GET_POLL_GEN.
+extern volatile mp_uint_t *common_hal_busio_uart_get_rx_poll_gen(busio_uart_obj_t *self);
+
 extern void common_hal_busio_uart_never_reset(busio_uart_obj_t *self);
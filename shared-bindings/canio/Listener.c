@@ -8,16 +8,24 @@
 #include "shared-bindings/canio/Message.h"
 #include "common-hal/canio/Listener.h"
 
+#include <string.h>
+
 #include "py/runtime.h"
 #include "py/objproperty.h"
 
+// Layout of each message written by Listener.readinto().
+#define CANIO_RECORD_SIZE (16)
+#define CANIO_RECORD_FLAG_EXTENDED (1 << 0)
+#define CANIO_RECORD_FLAG_RTR (1 << 1)
+
 //| class Listener:
 //|     """Listens for CAN message
 //|
 //|     `canio.Listener` is not constructed directly, but instead by calling
 //|     `canio.CAN.listen`.
 //|
-//|     In addition to using the `receive` method to retrieve a message or
+//|     In addition to using the `receive` method to retrieve a message, the
+//|     `readinto` method to retrieve several without allocating, or
 //|     the `in_waiting` method to check for an available message, a
 //|     listener can be used as an iterable, yielding messages until no
 //|     message arrives within ``self.timeout`` seconds."""
@@ -33,16 +41,71 @@ static mp_obj_t canio_listener_receive(mp_obj_t self_in) {
     canio_listener_obj_t *self = MP_OBJ_TO_PTR(self_in);
     common_hal_canio_listener_check_for_deinit(self);
 
-    mp_obj_t message = common_hal_canio_listener_receive(self);
+    canio_message_obj_t message;
     // note: receive fills out the type field of the message
-
-    if (message) {
-        return message;
+    if (!common_hal_canio_listener_receive(self, &message)) {
+        return mp_const_none;
     }
-    return mp_const_none;
+
+    canio_message_obj_t *result = mp_obj_malloc(canio_message_obj_t, message.base.type);
+    *result = message;
+    return MP_OBJ_FROM_PTR(result);
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(canio_listener_receive_obj, canio_listener_receive);
 
+//|     def readinto(self, buffer: WriteableBuffer) -> int:
+//|         """Reads as many messages as fit in ``buffer`` without allocating,
+//|         after waiting up to ``self.timeout`` seconds for the first one
+//|
+//|         Only messages that are already waiting are read after the first.
+//|         Each message takes 16 bytes of ``buffer``: the id as a 32-bit
+//|         little endian number, a flags byte (bit 0 set for an extended id,
+//|         bit 1 set for a remote transmission request), the data length, two
+//|         unused bytes and 8 bytes of data. Only the first data length bytes
+//|         of the data are meaningful.
+//|
+//|         Returns the number of messages read, which is 0 if no message was
+//|         received in time."""
+//|         ...
+static mp_obj_t canio_listener_readinto(mp_obj_t self_in, mp_obj_t buffer_in) {
+    canio_listener_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_canio_listener_check_for_deinit(self);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_in, &bufinfo, MP_BUFFER_WRITE);
+    size_t max_records = bufinfo.len / CANIO_RECORD_SIZE;
+
+    uint8_t *record = bufinfo.buf;
+    size_t count = 0;
+    canio_message_obj_t message;
+    while (count < max_records) {
+        if (count > 0 && !common_hal_canio_listener_in_waiting(self)) {
+            break;
+        }
+        if (!common_hal_canio_listener_receive(self, &message)) {
+            break;
+        }
+        bool rtr = message.base.type == &canio_remote_transmission_request_type;
+        uint32_t id = message.id;
+        record[0] = id;
+        record[1] = id >> 8;
+        record[2] = id >> 16;
+        record[3] = id >> 24;
+        record[4] = (message.extended ? CANIO_RECORD_FLAG_EXTENDED : 0) |
+            (rtr ? CANIO_RECORD_FLAG_RTR : 0);
+        record[5] = message.size;
+        record[6] = record[7] = 0;
+        memset(record + 8, 0, 8);
+        if (!rtr) {
+            memcpy(record + 8, message.data, message.size);
+        }
+        record += CANIO_RECORD_SIZE;
+        count++;
+    }
+    return MP_OBJ_NEW_SMALL_INT(count);
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(canio_listener_readinto_obj, canio_listener_readinto);
+
 //|     def in_waiting(self) -> int:
 //|         """Returns the number of messages (including remote
 //|         transmission requests) waiting"""
@@ -142,6 +205,7 @@ static const mp_rom_map_elem_t canio_listener_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&canio_listener_exit_obj) },
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&canio_listener_deinit_obj) },
     { MP_ROM_QSTR(MP_QSTR_in_waiting), MP_ROM_PTR(&canio_listener_in_waiting_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&canio_listener_readinto_obj) },
     { MP_ROM_QSTR(MP_QSTR_receive), MP_ROM_PTR(&canio_listener_receive_obj) },
     { MP_ROM_QSTR(MP_QSTR_timeout), MP_ROM_PTR(&canio_listener_timeout_obj) },
 };
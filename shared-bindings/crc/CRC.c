@@ -0,0 +1,139 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "shared-bindings/crc/CRC.h"
+
+#include "py/obj.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+
+//| class CRC:
+//|     """A cyclic redundancy check, computed a piece at a time
+//|
+//|     The parameters are those of the usual CRC catalogues. For example,
+//|     the CRC-16 used by Modbus is ``CRC(16, 0x8005, initial=0xffff,
+//|     reflect_input=True, reflect_output=True)`` and the CRC-32 used by zlib
+//|     and `binascii.crc32` is ``CRC(32, 0x04c11db7, initial=0xffffffff,
+//|     reflect_input=True, reflect_output=True, final_xor=0xffffffff)``.
+//|
+//|     The CRC is computed with lookup tables built when the object is
+//|     created. Ports with a CRC engine use it for large updates with the
+//|     polynomials it supports."""
+//|
+//|     def __init__(
+//|         self,
+//|         width: int,
+//|         polynomial: int,
+//|         *,
+//|         initial: int = 0,
+//|         reflect_input: bool = False,
+//|         reflect_output: bool = False,
+//|         final_xor: int = 0,
+//|     ) -> None:
+//|         """Create a CRC. Values that don't fit in ``width`` bits raise `ValueError`.
+//|
+//|         :param int width: The number of bits in the CRC, from 1 to 32
+//|         :param int polynomial: The generator polynomial, without its top bit
+//|         :param int initial: The value of the register before any data
+//|         :param bool reflect_input: True to process each byte starting from its lowest bit
+//|         :param bool reflect_output: True to reverse the bits of the register before ``final_xor``
+//|         :param int final_xor: Exclusive-ored with the register to give `value`
+//|
+//|         Example usage:
+//|
+//|         .. code-block:: python
+//|
+//|             import crc
+//|
+//|             modbus = crc.CRC(16, 0x8005, initial=0xffff, reflect_input=True, reflect_output=True)
+//|             modbus.update(b"\x01\x03\x00\x00\x00\x01")
+//|             print(hex(modbus.value))"""
+//|         ...
+//|
+static uint32_t validate_crc_value(mp_obj_t obj, uint8_t width, qstr arg_name) {
+    uint32_t value = mp_obj_get_int_truncated(obj) & (0xffffffff >> (32 - width));
+    if (!mp_obj_equal(mp_obj_new_int_from_uint(value), obj)) {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("%q out of range"), arg_name);
+    }
+    return value;
+}
+
+static mp_obj_t crc_crc_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_width, ARG_polynomial, ARG_initial, ARG_reflect_input, ARG_reflect_output, ARG_final_xor };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_width, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_polynomial, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_initial, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = MP_OBJ_NEW_SMALL_INT(0)} },
+        { MP_QSTR_reflect_input, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+        { MP_QSTR_reflect_output, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+        { MP_QSTR_final_xor, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = MP_OBJ_NEW_SMALL_INT(0)} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    uint8_t width = mp_arg_validate_int_range(args[ARG_width].u_int, 1, 32, MP_QSTR_width);
+    uint32_t polynomial = validate_crc_value(args[ARG_polynomial].u_obj, width, MP_QSTR_polynomial);
+    uint32_t initial = validate_crc_value(args[ARG_initial].u_obj, width, MP_QSTR_initial);
+    uint32_t final_xor = validate_crc_value(args[ARG_final_xor].u_obj, width, MP_QSTR_final_xor);
+
+    crc_crc_obj_t *self = mp_obj_malloc(crc_crc_obj_t, &crc_crc_type);
+    common_hal_crc_crc_construct(self, width, polynomial, initial,
+        args[ARG_reflect_input].u_bool, args[ARG_reflect_output].u_bool, final_xor);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|     value: int
+//|     """The CRC of all the data given to `update` since the object was
+//|     created or `reset`."""
+static mp_obj_t crc_crc_get_value(mp_obj_t self_in) {
+    crc_crc_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_int_from_uint(common_hal_crc_crc_get_value(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(crc_crc_get_value_obj, crc_crc_get_value);
+
+MP_PROPERTY_GETTER(crc_crc_value_obj,
+    (mp_obj_t)&crc_crc_get_value_obj);
+
+//|     def update(self, data: ReadableBuffer) -> None:
+//|         """Add the bytes in ``data`` to the CRC.
+//|
+//|         :param ~circuitpython_typing.ReadableBuffer data: the bytes to add"""
+//|         ...
+//|
+static mp_obj_t crc_crc_update(mp_obj_t self_in, mp_obj_t data_in) {
+    crc_crc_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(data_in, &bufinfo, MP_BUFFER_READ);
+    common_hal_crc_crc_update(self, bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(crc_crc_update_obj, crc_crc_update);
+
+//|     def reset(self) -> None:
+//|         """Start a new CRC, as if no data had been added."""
+//|         ...
+//|
+static mp_obj_t crc_crc_reset(mp_obj_t self_in) {
+    crc_crc_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_crc_crc_reset(self);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(crc_crc_reset_obj, crc_crc_reset);
+
+static const mp_rom_map_elem_t crc_crc_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&crc_crc_reset_obj) },
+    { MP_ROM_QSTR(MP_QSTR_update), MP_ROM_PTR(&crc_crc_update_obj) },
+    { MP_ROM_QSTR(MP_QSTR_value), MP_ROM_PTR(&crc_crc_value_obj) },
+};
+static MP_DEFINE_CONST_DICT(crc_crc_locals_dict, crc_crc_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    crc_crc_type,
+    MP_QSTR_CRC,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    make_new, crc_crc_make_new,
+    locals_dict, &crc_crc_locals_dict
+    );
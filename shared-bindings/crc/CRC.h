@@ -0,0 +1,17 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "shared-module/crc/CRC.h"
+
+extern const mp_obj_type_t crc_crc_type;
+
+void common_hal_crc_crc_construct(crc_crc_obj_t *self, uint8_t width, uint32_t polynomial, uint32_t initial,
+    bool reflect_input, bool reflect_output, uint32_t final_xor);
+void common_hal_crc_crc_reset(crc_crc_obj_t *self);
+void common_hal_crc_crc_update(crc_crc_obj_t *self, const uint8_t *data, size_t len);
+uint32_t common_hal_crc_crc_get_value(crc_crc_obj_t *self);
@@ -0,0 +1,31 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/crc/CRC.h"
+
+//| """Cyclic redundancy checks
+//|
+//| The `crc` module computes CRCs of any width up to 32 bits, such as the
+//| CRC-8s of sensor readings, the CRC-16s of Modbus and XMODEM and the CRC-32s
+//| of zlib and MPEG-2. Data can be added a piece at a time as it arrives."""
+//|
+
+static const mp_rom_map_elem_t crc_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_crc) },
+    { MP_ROM_QSTR(MP_QSTR_CRC), MP_ROM_PTR(&crc_crc_type) },
+};
+
+static MP_DEFINE_CONST_DICT(crc_module_globals, crc_module_globals_table);
+
+const mp_obj_module_t crc_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t *)&crc_module_globals,
+};
+
+MP_REGISTER_MODULE(MP_QSTR_crc, crc_module);
@@ -51,6 +51,15 @@ MP_WEAK const mcu_pin_obj_t *common_hal_digitalio_validate_pin(mp_obj_t obj) {
     return validate_obj_is_free_pin(obj, MP_QSTR_pin);
 }
 
+// Ports that can expose their GPIO registers directly override these.
+MP_WEAK bool common_hal_digitalio_has_reg_op(digitalinout_reg_op_t op) {
+    return false;
+}
+
+MP_WEAK volatile uint32_t *common_hal_digitalio_digitalinout_get_reg(digitalio_digitalinout_obj_t *self, digitalinout_reg_op_t op, uint32_t *mask) {
+    return NULL;
+}
+
 //| class DigitalInOut:
 //|     """Digital input and output
 //|
@@ -17,20 +17,24 @@
 //| class Group:
 //|     """Manage a group of sprites and groups and how they are inter-related."""
 //|
-//|     def __init__(self, *, scale: int = 1, x: int = 0, y: int = 0) -> None:
+//|     def __init__(
+//|         self, *, scale: int = 1, x: int = 0, y: int = 0, cached: bool = False
+//|     ) -> None:
 //|         """Create a Group of a given size and scale. Scale is in one dimension. For example, scale=2
 //|         leads to a layer's pixel being 2x2 pixels when in the group.
 //|
 //|         :param int scale: Scale of layer pixels in one dimension.
 //|         :param int x: Initial x position within the parent.
-//|         :param int y: Initial y position within the parent."""
+//|         :param int y: Initial y position within the parent.
+//|         :param bool cached: Render the Group's layers once and reuse the result. See `cached`."""
 //|         ...
 static mp_obj_t displayio_group_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
-    enum { ARG_scale, ARG_x, ARG_y };
+    enum { ARG_scale, ARG_x, ARG_y, ARG_cached };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_scale, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1} },
         { MP_QSTR_x, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
         { MP_QSTR_y, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
+        { MP_QSTR_cached, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -39,6 +43,7 @@ static mp_obj_t displayio_group_make_new(const mp_obj_type_t *type, size_t n_arg
 
     displayio_group_t *self = mp_obj_malloc(displayio_group_t, &displayio_group_type);
     common_hal_displayio_group_construct(self, scale, args[ARG_x].u_int, args[ARG_y].u_int);
+    common_hal_displayio_group_set_cached(self, args[ARG_cached].u_bool);
 
     return MP_OBJ_FROM_PTR(self);
 }
@@ -74,6 +79,29 @@ MP_PROPERTY_GETSET(displayio_group_hidden_obj,
     (mp_obj_t)&displayio_group_get_hidden_obj,
     (mp_obj_t)&displayio_group_set_hidden_obj);
 
+//|     cached: bool
+//|     """True when the Group keeps a copy of its rendered layers. The copy is drawn instead of the
+//|     layers until one of them changes, which makes static backgrounds cheap to show behind
+//|     overlays that change. The copy uses memory for all pixels the layers cover and is only
+//|     used for displays with 8, 16 or 32 bits per pixel."""
+static mp_obj_t displayio_group_obj_get_cached(mp_obj_t self_in) {
+    displayio_group_t *self = native_group(self_in);
+    return mp_obj_new_bool(common_hal_displayio_group_get_cached(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(displayio_group_get_cached_obj, displayio_group_obj_get_cached);
+
+static mp_obj_t displayio_group_obj_set_cached(mp_obj_t self_in, mp_obj_t cached_obj) {
+    displayio_group_t *self = native_group(self_in);
+
+    common_hal_displayio_group_set_cached(self, mp_obj_is_true(cached_obj));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(displayio_group_set_cached_obj, displayio_group_obj_set_cached);
+
+MP_PROPERTY_GETSET(displayio_group_cached_obj,
+    (mp_obj_t)&displayio_group_get_cached_obj,
+    (mp_obj_t)&displayio_group_set_cached_obj);
+
 //|     scale: int
 //|     """Scales each pixel within the Group in both directions. For example, when scale=2 each pixel
 //|     will be represented by 2x2 pixels."""
@@ -318,6 +346,7 @@ MP_DEFINE_CONST_FUN_OBJ_KW(displayio_group_sort_obj, 1, displayio_group_obj_sort
 
 static const mp_rom_map_elem_t displayio_group_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_hidden), MP_ROM_PTR(&displayio_group_hidden_obj) },
+    { MP_ROM_QSTR(MP_QSTR_cached), MP_ROM_PTR(&displayio_group_cached_obj) },
     { MP_ROM_QSTR(MP_QSTR_scale), MP_ROM_PTR(&displayio_group_scale_obj) },
     { MP_ROM_QSTR(MP_QSTR_x), MP_ROM_PTR(&displayio_group_x_obj) },
     { MP_ROM_QSTR(MP_QSTR_y), MP_ROM_PTR(&displayio_group_y_obj) },
@@ -17,6 +17,8 @@ uint32_t common_hal_displayio_group_get_scale(displayio_group_t *self);
 void common_hal_displayio_group_set_scale(displayio_group_t *self, uint32_t scale);
 bool common_hal_displayio_group_get_hidden(displayio_group_t *self);
 void common_hal_displayio_group_set_hidden(displayio_group_t *self, bool hidden);
+bool common_hal_displayio_group_get_cached(displayio_group_t *self);
+void common_hal_displayio_group_set_cached(displayio_group_t *self, bool cached);
 mp_int_t common_hal_displayio_group_get_x(displayio_group_t *self);
 void common_hal_displayio_group_set_x(displayio_group_t *self, mp_int_t x);
 mp_int_t common_hal_displayio_group_get_y(displayio_group_t *self);
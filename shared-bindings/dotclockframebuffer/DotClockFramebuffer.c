@@ -43,6 +43,7 @@
 //|         pclk_active_high: bool,
 //|         pclk_idle_high: bool,
 //|         overscan_left: int = 0,
+//|         bounce_buffer_lines: int = 0,
 //|     ) -> None:
 //|         """Create a DotClockFramebuffer object associated with the given pins.
 //|
@@ -88,6 +89,11 @@
 //|         :param bool pclk_idle_high: True if the dclk stays at high level in IDLE phase
 //|
 //|         :param int overscan_left: Allocate additional non-visible columns left of the first display column
+//|         :param int bounce_buffer_lines: When not 0, the display is sent from two buffers of this
+//|           many lines each in internal RAM. The CPU refills them from the framebuffer in PSRAM,
+//|           which keeps the display steady when other code is also busy with PSRAM. This costs
+//|           ``4 * bounce_buffer_lines * width`` bytes of internal RAM and some CPU time. ``height``
+//|           must be a multiple of twice this number.
 //|         """
 //|         #:param int overscan_top: Allocate additional non-visible rows above the first display row
 //|         #:param int overscan_right: Allocate additional non-visible columns right of the last display column
@@ -99,7 +105,7 @@ static mp_obj_t dotclockframebuffer_framebuffer_make_new(const mp_obj_type_t *ty
            ARG_hsync_pulse_width, ARG_hsync_back_porch, ARG_hsync_front_porch, ARG_hsync_idle_low,
            ARG_vsync_pulse_width, ARG_vsync_back_porch, ARG_vsync_front_porch, ARG_vsync_idle_low,
            ARG_de_idle_high, ARG_pclk_active_high, ARG_pclk_idle_high,
-           ARG_overscan_left};
+           ARG_overscan_left, ARG_bounce_buffer_lines};
 
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_de, MP_ARG_OBJ | MP_ARG_KW_ONLY | MP_ARG_REQUIRED, {.u_obj = mp_const_none } },
@@ -129,6 +135,7 @@ static mp_obj_t dotclockframebuffer_framebuffer_make_new(const mp_obj_type_t *ty
         { MP_QSTR_pclk_idle_high, MP_ARG_BOOL | MP_ARG_KW_ONLY | MP_ARG_REQUIRED, {.u_bool = false } },
 
         { MP_QSTR_overscan_left, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0 } },
+        { MP_QSTR_bounce_buffer_lines, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0 } },
     };
 
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
@@ -139,6 +146,11 @@ static mp_obj_t dotclockframebuffer_framebuffer_make_new(const mp_obj_type_t *ty
     const mcu_pin_obj_t *hsync = validate_obj_is_free_pin(args[ARG_hsync].u_obj, MP_QSTR_hsync);
     const mcu_pin_obj_t *dclk = validate_obj_is_free_pin(args[ARG_dclk].u_obj, MP_QSTR_dclk);
 
+    mp_int_t bounce_buffer_lines = mp_arg_validate_int_min(args[ARG_bounce_buffer_lines].u_int, 0, MP_QSTR_bounce_buffer_lines);
+    if (bounce_buffer_lines > 0 && args[ARG_height].u_int % (2 * bounce_buffer_lines) != 0) {
+        mp_arg_error_invalid(MP_QSTR_bounce_buffer_lines);
+    }
+
     uint8_t num_red, num_green, num_blue;
     const mcu_pin_obj_t *red_pins[8], *green_pins[8], *blue_pins[8];
 
@@ -157,7 +169,8 @@ static mp_obj_t dotclockframebuffer_framebuffer_make_new(const mp_obj_type_t *ty
         args[ARG_de_idle_high].u_bool,
         args[ARG_pclk_active_high].u_bool,
         args[ARG_pclk_idle_high].u_bool,
-        args[ARG_overscan_left].u_int
+        args[ARG_overscan_left].u_int,
+        bounce_buffer_lines
         );
 
     return self;
@@ -179,7 +192,7 @@ static void check_for_deinit(dotclockframebuffer_framebuffer_obj_t *self) {
 static mp_obj_t dotclockframebuffer_framebuffer_refresh(mp_obj_t self_in) {
     dotclockframebuffer_framebuffer_obj_t *self = (dotclockframebuffer_framebuffer_obj_t *)self_in;
     check_for_deinit(self);
-    common_hal_dotclockframebuffer_framebuffer_refresh(self);
+    common_hal_dotclockframebuffer_framebuffer_refresh(self, NULL);
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_1(dotclockframebuffer_framebuffer_refresh_obj, dotclockframebuffer_framebuffer_refresh);
@@ -281,9 +294,8 @@ static mp_int_t dotclockframebuffer_framebuffer_get_buffer(mp_obj_t self_in, mp_
 // These version exists so that the prototype matches the protocol,
 // avoiding a type cast that can hide errors
 static void dotclockframebuffer_framebuffer_swapbuffers(mp_obj_t self_in, uint8_t *dirty_row_bitmap) {
-    (void)dirty_row_bitmap;
     dotclockframebuffer_framebuffer_obj_t *self = (dotclockframebuffer_framebuffer_obj_t *)self_in;
-    common_hal_dotclockframebuffer_framebuffer_refresh(self);
+    common_hal_dotclockframebuffer_framebuffer_refresh(self, dirty_row_bitmap);
 }
 
 static void dotclockframebuffer_framebuffer_deinit_proto(mp_obj_t self_in) {
@@ -0,0 +1,189 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "shared/runtime/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "py/stream.h"
+#include "shared-bindings/dualbank/Update.h"
+#include "shared-bindings/util.h"
+
+#if CIRCUITPY_STORAGE_EXTEND
+#include "supervisor/flash.h"
+#endif
+
+//| class Update:
+//|     """Writes a firmware image to the next-update partition as it arrives,
+//|     for example from a socket or a file, and switches to it once the whole
+//|     image has been checked.
+//|
+//|     Each piece is hashed as it is written, and the flash is erased and
+//|     written in the background while the next piece is received, so the
+//|     update takes little longer than the download.
+//|
+//|     .. code-block:: python
+//|
+//|         import dualbank
+//|
+//|         with dualbank.Update(size=size, sha256=expected) as update:
+//|             while chunk := response.read(4096):
+//|                 update.write(chunk)
+//|             update.commit()
+//|     """
+//|
+//|     def __init__(self, *, size: int = 0, sha256: Optional[ReadableBuffer] = None) -> None:
+//|         """Start an update. Only one can be in progress at a time.
+//|
+//|         :param int size: the length of the image in bytes, or 0 if it is not known
+//|         :param ReadableBuffer sha256: the SHA-256 digest that the whole image must have
+//|         """
+//|         ...
+//|
+static mp_obj_t dualbank_update_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_size, ARG_sha256 };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_size, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_sha256, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    #if CIRCUITPY_STORAGE_EXTEND
+    if (supervisor_flash_get_extended()) {
+        mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("%q is %q"), MP_QSTR_storage, MP_QSTR_extended);
+    }
+    #endif
+
+    mp_int_t size = mp_arg_validate_int_min(args[ARG_size].u_int, 0, MP_QSTR_size);
+    const uint8_t *sha256 = NULL;
+    if (args[ARG_sha256].u_obj != mp_const_none) {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(args[ARG_sha256].u_obj, &bufinfo, MP_BUFFER_READ);
+        mp_arg_validate_length(bufinfo.len, 32, MP_QSTR_sha256);
+        sha256 = bufinfo.buf;
+    }
+
+    dualbank_update_obj_t *self = mp_obj_malloc(dualbank_update_obj_t, &dualbank_update_type);
+    common_hal_dualbank_update_construct(self, size, sha256);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+static void check_for_deinit(dualbank_update_obj_t *self) {
+    if (common_hal_dualbank_update_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|     def deinit(self) -> None:
+//|         """Abandon the update. The partition being written is left unused."""
+//|         ...
+//|
+static mp_obj_t dualbank_update_deinit(mp_obj_t self_in) {
+    dualbank_update_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_dualbank_update_deinit(self);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(dualbank_update_deinit_obj, dualbank_update_deinit);
+
+//|     def __enter__(self) -> Update:
+//|         """No-op used by Context Managers."""
+//|         ...
+//|
+//  Provided by context manager helper.
+
+//|     def __exit__(self) -> None:
+//|         """Abandons the update if `commit` was not called. See
+//|         :ref:`lifetime-and-contextmanagers` for more info."""
+//|         ...
+//|
+static mp_obj_t dualbank_update_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_dualbank_update_deinit(MP_OBJ_TO_PTR(args[0]));
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(dualbank_update___exit___obj, 4, 4, dualbank_update_obj___exit__);
+
+//|     def write(self, buf: ReadableBuffer) -> int:
+//|         """Add the next piece of the image, and return its length. The
+//|         `Update` can also be passed where a writable stream is expected."""
+//|         ...
+//|
+static mp_uint_t dualbank_update_stream_write(mp_obj_t self_in, const void *buf, mp_uint_t size, int *errcode) {
+    dualbank_update_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_dualbank_update_write(self, buf, size);
+    return size;
+}
+
+//|     def commit(self) -> None:
+//|         """Finish writing, check the image and set it as the boot partition.
+//|         The firmware is loaded from it on the next reset.
+//|
+//|         A `RuntimeError` is raised, and the boot partition is left as it
+//|         was, if the image is not the given size, does not match the given
+//|         SHA-256 digest, or is not a valid firmware image."""
+//|         ...
+//|
+static mp_obj_t dualbank_update_commit(mp_obj_t self_in) {
+    dualbank_update_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_dualbank_update_commit(self);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(dualbank_update_commit_obj, dualbank_update_commit);
+
+//|     written: int
+//|     """The number of bytes written so far. (read-only)"""
+//|
+static mp_obj_t dualbank_update_obj_get_written(mp_obj_t self_in) {
+    dualbank_update_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_int_from_uint(common_hal_dualbank_update_get_written(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(dualbank_update_get_written_obj, dualbank_update_obj_get_written);
+
+MP_PROPERTY_GETTER(dualbank_update_written_obj,
+    (mp_obj_t)&dualbank_update_get_written_obj);
+
+//|     sha256: bytes
+//|     """The SHA-256 digest of the bytes written so far. (read-only)"""
+//|
+static mp_obj_t dualbank_update_obj_get_sha256(mp_obj_t self_in) {
+    dualbank_update_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    uint8_t digest[32];
+    common_hal_dualbank_update_get_sha256(self, digest);
+    return mp_obj_new_bytes(digest, sizeof(digest));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(dualbank_update_get_sha256_obj, dualbank_update_obj_get_sha256);
+
+MP_PROPERTY_GETTER(dualbank_update_sha256_obj,
+    (mp_obj_t)&dualbank_update_get_sha256_obj);
+
+static const mp_rom_map_elem_t dualbank_update_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&dualbank_update_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&dualbank_update___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&mp_stream_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_commit), MP_ROM_PTR(&dualbank_update_commit_obj) },
+    { MP_ROM_QSTR(MP_QSTR_written), MP_ROM_PTR(&dualbank_update_written_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sha256), MP_ROM_PTR(&dualbank_update_sha256_obj) },
+};
+static MP_DEFINE_CONST_DICT(dualbank_update_locals_dict, dualbank_update_locals_dict_table);
+
+static const mp_stream_p_t dualbank_update_stream_p = {
+    .write = dualbank_update_stream_write,
+    .is_text = false,
+};
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    dualbank_update_type,
+    MP_QSTR_Update,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    make_new, dualbank_update_make_new,
+    locals_dict, &dualbank_update_locals_dict,
+    protocol, &dualbank_update_stream_p
+    );
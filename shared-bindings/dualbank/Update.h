@@ -0,0 +1,21 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "common-hal/dualbank/Update.h"
+
+extern const mp_obj_type_t dualbank_update_type;
+
+// sha256 is the expected digest of the whole image, or NULL. size is the
+// expected length, or 0 if it is not known.
+extern void common_hal_dualbank_update_construct(dualbank_update_obj_t *self, size_t size, const uint8_t *sha256);
+extern void common_hal_dualbank_update_deinit(dualbank_update_obj_t *self);
+extern bool common_hal_dualbank_update_deinited(dualbank_update_obj_t *self);
+extern void common_hal_dualbank_update_write(dualbank_update_obj_t *self, const uint8_t *buf, size_t len);
+extern void common_hal_dualbank_update_commit(dualbank_update_obj_t *self);
+extern size_t common_hal_dualbank_update_get_written(dualbank_update_obj_t *self);
+extern void common_hal_dualbank_update_get_sha256(dualbank_update_obj_t *self, uint8_t *digest);
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: MIT
 
 #include "shared-bindings/dualbank/__init__.h"
+#include "shared-bindings/dualbank/Update.h"
 
 #if CIRCUITPY_STORAGE_EXTEND
 #include "supervisor/flash.h"
@@ -43,6 +44,8 @@
 //|
 //|     dualbank.flash(buffer, offset)
 //|     dualbank.switch()
+//|
+//| To write an image as it is downloaded, use `Update`.
 //| """
 //| ...
 //|
@@ -113,6 +116,8 @@ static const mp_rom_map_elem_t dualbank_module_globals_table[] = {
     // module functions
     { MP_ROM_QSTR(MP_QSTR_flash), MP_ROM_PTR(&dualbank_flash_obj) },
     { MP_ROM_QSTR(MP_QSTR_switch), MP_ROM_PTR(&dualbank_switch_obj) },
+    // module classes
+    { MP_ROM_QSTR(MP_QSTR_Update), MP_ROM_PTR(&dualbank_update_type) },
 };
 static MP_DEFINE_CONST_DICT(dualbank_module_globals, dualbank_module_globals_table);
 
@@ -62,7 +62,10 @@
 //|         advanced_color_epaper: bool = False,
 //|         two_byte_sequence_length: bool = False,
 //|         start_up_time: float = 0,
-//|         address_little_endian: bool = False
+//|         address_little_endian: bool = False,
+//|         partial_refresh_sequence: Optional[circuitpython_typing.ReadableBuffer] = None,
+//|         partial_refresh_time: Optional[float] = None,
+//|         max_partial_refreshes: int = 10
 //|     ) -> None:
 //|         """Create a EPaperDisplay object on the given display bus (`fourwire.FourWire` or `paralleldisplaybus.ParallelBus`).
 //|
@@ -105,6 +108,12 @@
 //|         :param bool two_byte_sequence_length: When true, use two bytes to define sequence length
 //|         :param float start_up_time: Time to wait after reset before sending commands
 //|         :param bool address_little_endian: Send the least significant byte (not bit) of multi-byte addresses first. Ignored when ram is addressed with one byte
+//|         :param ~circuitpython_typing.ReadableBuffer partial_refresh_sequence: Byte-packed command sequence sent instead of
+//|           ``refresh_display_command`` when the changed areas cover at most half of the display, usually
+//|           selecting a fast partial update waveform. Requires the window commands. None always refreshes fully.
+//|         :param float partial_refresh_time: Time a partial refresh takes, like ``refresh_time``. Defaults to ``refresh_time``.
+//|         :param int max_partial_refreshes: Partial refreshes in a row before the next one is made a full refresh
+//|           to clear the ghosting they leave behind. 0 never forces a full refresh.
 //|         """
 //|         ...
 static mp_obj_t epaperdisplay_epaperdisplay_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
@@ -115,7 +124,8 @@ static mp_obj_t epaperdisplay_epaperdisplay_make_new(const mp_obj_type_t *type,
            ARG_write_color_ram_command, ARG_color_bits_inverted, ARG_highlight_color,
            ARG_refresh_display_command,  ARG_refresh_time, ARG_busy_pin, ARG_busy_state,
            ARG_seconds_per_frame, ARG_always_toggle_chip_select, ARG_grayscale, ARG_advanced_color_epaper,
-           ARG_two_byte_sequence_length, ARG_start_up_time, ARG_address_little_endian };
+           ARG_two_byte_sequence_length, ARG_start_up_time, ARG_address_little_endian,
+           ARG_partial_refresh_sequence, ARG_partial_refresh_time, ARG_max_partial_refreshes };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_display_bus, MP_ARG_REQUIRED | MP_ARG_OBJ },
         { MP_QSTR_start_sequence, MP_ARG_REQUIRED | MP_ARG_OBJ },
@@ -147,6 +157,9 @@ static mp_obj_t epaperdisplay_epaperdisplay_make_new(const mp_obj_type_t *type,
         { MP_QSTR_two_byte_sequence_length, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
         { MP_QSTR_start_up_time, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_OBJ_NEW_SMALL_INT(0)} },
         { MP_QSTR_address_little_endian, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+        { MP_QSTR_partial_refresh_sequence, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_partial_refresh_time, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_max_partial_refreshes, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 10} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -173,6 +186,17 @@ static mp_obj_t epaperdisplay_epaperdisplay_make_new(const mp_obj_type_t *type,
     mp_float_t seconds_per_frame = mp_obj_get_float(args[ARG_seconds_per_frame].u_obj);
     mp_float_t start_up_time = mp_obj_get_float(args[ARG_start_up_time].u_obj);
 
+    mp_buffer_info_t partial_refresh_bufinfo = { .buf = NULL, .len = 0 };
+    if (args[ARG_partial_refresh_sequence].u_obj != mp_const_none) {
+        mp_get_buffer_raise(args[ARG_partial_refresh_sequence].u_obj, &partial_refresh_bufinfo, MP_BUFFER_READ);
+    }
+    mp_float_t partial_refresh_time = refresh_time;
+    if (args[ARG_partial_refresh_time].u_obj != mp_const_none) {
+        partial_refresh_time = mp_obj_get_float(args[ARG_partial_refresh_time].u_obj);
+    }
+    uint16_t max_partial_refreshes = mp_arg_validate_int_range(args[ARG_max_partial_refreshes].u_int, 0, 0xffff,
+        MP_QSTR_max_partial_refreshes);
+
     mp_int_t write_color_ram_command = NO_COMMAND;
     mp_int_t highlight_color = args[ARG_highlight_color].u_int;
     if (args[ARG_write_color_ram_command].u_obj != mp_const_none) {
@@ -216,6 +240,11 @@ static mp_obj_t epaperdisplay_epaperdisplay_make_new(const mp_obj_type_t *type,
         two_byte_sequence_length, args[ARG_address_little_endian].u_bool
         );
 
+    if (partial_refresh_bufinfo.buf != NULL) {
+        epaperdisplay_epaperdisplay_set_partial_refresh(self,
+            partial_refresh_bufinfo.buf, partial_refresh_bufinfo.len, partial_refresh_time, max_partial_refreshes);
+    }
+
     return self;
 }
 
@@ -354,6 +383,23 @@ MP_DEFINE_CONST_FUN_OBJ_1(epaperdisplay_epaperdisplay_get_bus_obj, epaperdisplay
 MP_PROPERTY_GETTER(epaperdisplay_epaperdisplay_bus_obj,
     (mp_obj_t)&epaperdisplay_epaperdisplay_get_bus_obj);
 
+//|     refresh_stats: Tuple[int, int, int, int, int, int, int]
+//|     """What the last finished refresh did, as a named tuple
+//|     ``(frames, frames_skipped, areas, pixels, bytes, fill_us, send_us)``.
+//|
+//|     ``frames`` counts every refresh since the display was created. E-paper refreshes are
+//|     never dropped to keep up a frame rate, so ``frames_skipped`` stays 0.
+//|     The rest describe the last refresh: the dirty areas drawn, the pixels composited, the
+//|     bytes sent to the display, and the microseconds spent compositing and sending them."""
+static mp_obj_t epaperdisplay_epaperdisplay_obj_get_refresh_stats(mp_obj_t self_in) {
+    epaperdisplay_epaperdisplay_obj_t *self = native_display(self_in);
+    return common_hal_epaperdisplay_epaperdisplay_get_refresh_stats(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(epaperdisplay_epaperdisplay_get_refresh_stats_obj, epaperdisplay_epaperdisplay_obj_get_refresh_stats);
+
+MP_PROPERTY_GETTER(epaperdisplay_epaperdisplay_refresh_stats_obj,
+    (mp_obj_t)&epaperdisplay_epaperdisplay_get_refresh_stats_obj);
+
 //|     root_group: displayio.Group
 //|     """The root group on the epaper display.
 //|     If the root group is set to `displayio.CIRCUITPYTHON_TERMINAL`, the default CircuitPython terminal will be shown.
@@ -393,6 +439,7 @@ static const mp_rom_map_elem_t epaperdisplay_epaperdisplay_locals_dict_table[] =
     { MP_ROM_QSTR(MP_QSTR_bus), MP_ROM_PTR(&epaperdisplay_epaperdisplay_bus_obj) },
     { MP_ROM_QSTR(MP_QSTR_busy), MP_ROM_PTR(&epaperdisplay_epaperdisplay_busy_obj) },
     { MP_ROM_QSTR(MP_QSTR_time_to_refresh), MP_ROM_PTR(&epaperdisplay_epaperdisplay_time_to_refresh_obj) },
+    { MP_ROM_QSTR(MP_QSTR_refresh_stats), MP_ROM_PTR(&epaperdisplay_epaperdisplay_refresh_stats_obj) },
     { MP_ROM_QSTR(MP_QSTR_root_group), MP_ROM_PTR(&epaperdisplay_epaperdisplay_root_group_obj) },
 };
 static MP_DEFINE_CONST_DICT(epaperdisplay_epaperdisplay_locals_dict, epaperdisplay_epaperdisplay_locals_dict_table);
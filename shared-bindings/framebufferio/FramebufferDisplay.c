@@ -303,6 +303,25 @@ static mp_obj_t framebufferio_framebufferdisplay_obj_fill_row(size_t n_args, con
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(framebufferio_framebufferdisplay_fill_row_obj, 1, framebufferio_framebufferdisplay_obj_fill_row);
 
+//|     refresh_stats: Tuple[int, int, int, int, int, int, int]
+//|     """What the last finished refresh did, as a named tuple
+//|     ``(frames, frames_skipped, areas, pixels, bytes, fill_us, send_us)``.
+//|
+//|     ``frames`` and ``frames_skipped`` count every refresh since the display was created,
+//|     where a skipped frame is one `refresh` dropped to catch up with ``target_frames_per_second``.
+//|     The rest describe the last refresh: the dirty areas drawn, the pixels composited, the
+//|     bytes sent to the display, and the microseconds spent compositing and sending them.
+//|     Areas that span whole rows of the framebuffer are composited straight into it, so
+//|     they add to ``pixels`` and ``fill_us`` but not to ``bytes``."""
+static mp_obj_t framebufferio_framebufferdisplay_obj_get_refresh_stats(mp_obj_t self_in) {
+    framebufferio_framebufferdisplay_obj_t *self = native_display(self_in);
+    return common_hal_framebufferio_framebufferdisplay_get_refresh_stats(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(framebufferio_framebufferdisplay_get_refresh_stats_obj, framebufferio_framebufferdisplay_obj_get_refresh_stats);
+
+MP_PROPERTY_GETTER(framebufferio_framebufferdisplay_refresh_stats_obj,
+    (mp_obj_t)&framebufferio_framebufferdisplay_get_refresh_stats_obj);
+
 //|     root_group: displayio.Group
 //|     """The root group on the display.
 //|     If the root group is set to `displayio.CIRCUITPYTHON_TERMINAL`, the default CircuitPython terminal will be shown.
@@ -347,6 +366,7 @@ static const mp_rom_map_elem_t framebufferio_framebufferdisplay_locals_dict_tabl
     { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&framebufferio_framebufferdisplay_height_obj) },
     { MP_ROM_QSTR(MP_QSTR_rotation), MP_ROM_PTR(&framebufferio_framebufferdisplay_rotation_obj) },
     { MP_ROM_QSTR(MP_QSTR_framebuffer), MP_ROM_PTR(&framebufferio_framebufferframebuffer_obj) },
+    { MP_ROM_QSTR(MP_QSTR_refresh_stats), MP_ROM_PTR(&framebufferio_framebufferdisplay_refresh_stats_obj) },
     { MP_ROM_QSTR(MP_QSTR_root_group), MP_ROM_PTR(&framebufferio_framebufferdisplay_root_group_obj) },
 };
 static MP_DEFINE_CONST_DICT(framebufferio_framebufferdisplay_locals_dict, framebufferio_framebufferdisplay_locals_dict_table);
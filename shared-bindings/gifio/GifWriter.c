@@ -22,6 +22,7 @@
 //|         colorspace: displayio.Colorspace,
 //|         loop: bool = True,
 //|         dither: bool = False,
+//|         frame_differencing: bool = False,
 //|     ) -> None:
 //|         """Construct a GifWriter object
 //|
@@ -31,10 +32,11 @@
 //|         :param colorspace: The colorspace of the image.  All frames must have the same colorspace.  The supported colorspaces are ``RGB565``, ``BGR565``, ``RGB565_SWAPPED``, ``BGR565_SWAPPED``, and ``L8`` (greyscale)
 //|         :param loop: If True, the GIF is marked for looping playback
 //|         :param dither: If True, and the image is in color, a simple ordered dither is applied.
+//|         :param frame_differencing: If True, each frame after the first only stores the rectangle that changed since the previous frame. This makes recordings of mostly static screens much smaller, at the cost of ``width * height`` bytes of memory.
 //|         """
 //|         ...
 static mp_obj_t gifio_gifwriter_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
-    enum { ARG_file, ARG_width, ARG_height, ARG_colorspace, ARG_loop, ARG_dither };
+    enum { ARG_file, ARG_width, ARG_height, ARG_colorspace, ARG_loop, ARG_dither, ARG_frame_differencing };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_file, MP_ARG_OBJ | MP_ARG_REQUIRED, {.u_obj = NULL} },
         { MP_QSTR_width, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
@@ -42,6 +44,7 @@ static mp_obj_t gifio_gifwriter_make_new(const mp_obj_type_t *type, size_t n_arg
         { MP_QSTR_colorspace, MP_ARG_OBJ | MP_ARG_REQUIRED, {.u_obj = NULL} },
         { MP_QSTR_loop, MP_ARG_BOOL, { .u_bool = true } },
         { MP_QSTR_dither, MP_ARG_BOOL, { .u_bool = false } },
+        { MP_QSTR_frame_differencing, MP_ARG_BOOL, { .u_bool = false } },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -53,7 +56,8 @@ static mp_obj_t gifio_gifwriter_make_new(const mp_obj_type_t *type, size_t n_arg
         own_file = true;
     }
 
-    gifio_gifwriter_t *self = mp_obj_malloc(gifio_gifwriter_t, &gifio_gifwriter_type);
+    gifio_gifwriter_t *self = m_new_obj_with_finaliser(gifio_gifwriter_t);
+    self->base.type = &gifio_gifwriter_type;
     shared_module_gifio_gifwriter_construct(
         self,
         file,
@@ -62,6 +66,7 @@ static mp_obj_t gifio_gifwriter_make_new(const mp_obj_type_t *type, size_t n_arg
         (displayio_colorspace_t)cp_enum_value(&displayio_colorspace_type, args[ARG_colorspace].u_obj, MP_QSTR_colorspace),
         args[ARG_loop].u_bool,
         args[ARG_dither].u_bool,
+        args[ARG_frame_differencing].u_bool,
         own_file);
 
     return self;
@@ -94,6 +99,15 @@ static mp_obj_t gifio_gifwriter_deinit(mp_obj_t self_in) {
 }
 MP_DEFINE_CONST_FUN_OBJ_1(gifio_gifwriter_deinit_obj, gifio_gifwriter_deinit);
 
+// Frees the frame buffers when the writer is collected without being closed.
+// The file is left alone because it may have been collected already.
+static mp_obj_t gifio_gifwriter___del__(mp_obj_t self_in) {
+    gifio_gifwriter_t *self = MP_OBJ_TO_PTR(self_in);
+    shared_module_gifio_gifwriter_del(self);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(gifio_gifwriter___del___obj, gifio_gifwriter___del__);
+
 //|     def add_frame(self, bitmap: ReadableBuffer, delay: float = 0.1) -> None:
 //|         """Add a frame to the GIF.
 //|
@@ -132,6 +146,7 @@ static const mp_rom_map_elem_t gifio_gifwriter_locals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_GifWriter) },
     { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
     { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&gifio_gifwriter___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&gifio_gifwriter___del___obj) },
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&gifio_gifwriter_deinit_obj) },
     { MP_ROM_QSTR(MP_QSTR_add_frame), MP_ROM_PTR(&gifio_gifwriter_add_frame_obj) },
 };
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: MIT
 
 #include "py/obj.h"
+#include "py/objproperty.h"
 #include "py/runtime.h"
 
 #include "shared/runtime/context_manager_helpers.h"
@@ -97,7 +98,11 @@ static mp_obj_t imagecapture_parallelimagecapture_continuous_capture_start(mp_ob
 static MP_DEFINE_CONST_FUN_OBJ_3(imagecapture_parallelimagecapture_continuous_capture_start_obj, imagecapture_parallelimagecapture_continuous_capture_start);
 
 //|     def continuous_capture_get_frame(self) -> WriteableBuffer:
-//|         """Return the next available frame, one of the two buffers passed to `continuous_capture_start`"""
+//|         """Return the next available frame, one of the two buffers passed to `continuous_capture_start`
+//|
+//|         This is the most recently completed frame that hasn't been returned
+//|         yet, waiting for one if needed. The other buffer is being filled
+//|         meanwhile, so finish with the frame before the next one completes."""
 //|         ...
 static mp_obj_t imagecapture_parallelimagecapture_continuous_capture_get_frame(mp_obj_t self_in) {
     imagecapture_parallelimagecapture_obj_t *self = (imagecapture_parallelimagecapture_obj_t *)self_in;
@@ -107,6 +112,19 @@ static MP_DEFINE_CONST_FUN_OBJ_1(imagecapture_parallelimagecapture_continuous_ca
 
 
 
+//|     dropped_frames: int
+//|     """The number of frames completed since `continuous_capture_start` that
+//|     were replaced by a newer frame before `continuous_capture_get_frame`
+//|     returned them. Always 0 if continuous capture is not supported."""
+static mp_obj_t imagecapture_parallelimagecapture_get_dropped_frames(mp_obj_t self_in) {
+    imagecapture_parallelimagecapture_obj_t *self = (imagecapture_parallelimagecapture_obj_t *)self_in;
+    return mp_obj_new_int(common_hal_imagecapture_parallelimagecapture_get_dropped_frames(self));
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(imagecapture_parallelimagecapture_get_dropped_frames_obj, imagecapture_parallelimagecapture_get_dropped_frames);
+
+MP_PROPERTY_GETTER(imagecapture_parallelimagecapture_dropped_frames_obj,
+    (mp_obj_t)&imagecapture_parallelimagecapture_get_dropped_frames_obj);
+
 //|     def continuous_capture_stop(self) -> None:
 //|         """Stop continuous capture.
 //|
@@ -164,6 +182,7 @@ static const mp_rom_map_elem_t imagecapture_parallelimagecapture_locals_dict_tab
     { MP_ROM_QSTR(MP_QSTR_continuous_capture_start), MP_ROM_PTR(&imagecapture_parallelimagecapture_continuous_capture_start_obj) },
     { MP_ROM_QSTR(MP_QSTR_continuous_capture_stop), MP_ROM_PTR(&imagecapture_parallelimagecapture_continuous_capture_stop_obj) },
     { MP_ROM_QSTR(MP_QSTR_continuous_capture_get_frame), MP_ROM_PTR(&imagecapture_parallelimagecapture_continuous_capture_get_frame_obj) },
+    { MP_ROM_QSTR(MP_QSTR_dropped_frames), MP_ROM_PTR(&imagecapture_parallelimagecapture_dropped_frames_obj) },
 };
 
 static MP_DEFINE_CONST_DICT(imagecapture_parallelimagecapture_locals_dict, imagecapture_parallelimagecapture_locals_dict_table);
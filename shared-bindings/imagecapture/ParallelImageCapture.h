@@ -24,3 +24,4 @@ void common_hal_imagecapture_parallelimagecapture_singleshot_capture(imagecaptur
 void common_hal_imagecapture_parallelimagecapture_continuous_capture_start(imagecapture_parallelimagecapture_obj_t *self, mp_obj_t buffer1, mp_obj_t buffer2);
 void common_hal_imagecapture_parallelimagecapture_continuous_capture_stop(imagecapture_parallelimagecapture_obj_t *self);
 mp_obj_t common_hal_imagecapture_parallelimagecapture_continuous_capture_get_frame(imagecapture_parallelimagecapture_obj_t *self);
+mp_int_t common_hal_imagecapture_parallelimagecapture_get_dropped_frames(imagecapture_parallelimagecapture_obj_t *self);
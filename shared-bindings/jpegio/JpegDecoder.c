@@ -13,6 +13,9 @@
 #include "shared-bindings/jpegio/JpegDecoder.h"
 #include "shared-module/jpegio/JpegDecoder.h"
 #include "shared-module/displayio/Bitmap.h"
+#if CIRCUITPY_BUSDISPLAY
+#include "shared-bindings/busdisplay/BusDisplay.h"
+#endif
 
 //| class JpegDecoder:
 //|     """A JPEG decoder
@@ -85,7 +88,7 @@ MP_DEFINE_CONST_FUN_OBJ_2(jpegio_jpegdecoder_open_obj, jpegio_jpegdecoder_open);
 
 //|     def decode(
 //|         self,
-//|         bitmap: displayio.Bitmap,
+//|         bitmap: Union[displayio.Bitmap, busdisplay.BusDisplay],
 //|         scale: int = 0,
 //|         x: int = 0,
 //|         y: int = 0,
@@ -102,8 +105,22 @@ MP_DEFINE_CONST_FUN_OBJ_2(jpegio_jpegdecoder_open_obj, jpegio_jpegdecoder_open);
 //|         The bitmap must be large enough to contain the decoded image.
 //|         The pixel data is stored in the `displayio.Colorspace.RGB565_SWAPPED` colorspace.
 //|
+//|         When a `busdisplay.BusDisplay` is given instead of a bitmap, each block of the
+//|         image is written straight to the display as soon as it is decoded, so no memory
+//|         is needed for the full image. The display must have a 16-bit color depth. The
+//|         pixels are not part of any `displayio.Group`, so they are overwritten the next
+//|         time displayio refreshes that part of the display; set ``root_group`` to ``None``
+//|         or turn off ``auto_refresh`` to keep them visible. ``skip_source_index`` and
+//|         ``skip_dest_index`` are not supported in this mode.
+//|
 //|         The image is optionally downscaled by a factor of ``2**scale``.
-//|         Scaling by a factor of 8 (scale=3) is particularly efficient in terms of decoding time.
+//|         Scaling by a factor of 8 (scale=3) is particularly efficient in terms of decoding time,
+//|         because only the average color of each 8x8 block is computed. This makes it a good
+//|         choice for thumbnails.
+//|
+//|         Parts of the image that fall outside the crop region or the destination are skipped
+//|         without being fully decoded. Decoding stops after the last row that is needed. If the
+//|         JPEG has restart markers, whole restart intervals outside the region are skipped.
 //|
 //|         The remaining parameters are as for `bitmaptools.blit`.
 //|         Because JPEG is a lossy data format, chroma keying based on the "source
@@ -116,7 +133,7 @@ MP_DEFINE_CONST_FUN_OBJ_2(jpegio_jpegdecoder_open_obj, jpegio_jpegdecoder_open);
 //|         possible to repeatedly ``decode`` the same jpeg data, even if it is to
 //|         select different scales or crop regions from it.
 //|
-//|         :param Bitmap bitmap: Optional output buffer
+//|         :param Bitmap bitmap: Output buffer or display
 //|         :param int scale: Scale factor from 0 to 3, inclusive.
 //|         :param int x: Horizontal pixel location in bitmap where source_bitmap upper-left
 //|                       corner will be placed
@@ -149,12 +166,36 @@ static mp_obj_t jpegio_jpegdecoder_decode(mp_uint_t n_args, const mp_obj_t *pos_
     mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
     mp_obj_t bitmap_in = args[ARG_bitmap].u_obj;
-    mp_arg_validate_type(bitmap_in, &displayio_bitmap_type, MP_QSTR_bitmap);
-    displayio_bitmap_t *bitmap = MP_OBJ_TO_PTR(args[ARG_bitmap].u_obj);
 
     int scale = args[ARG_scale].u_int;
     mp_arg_validate_int_range(scale, 0, 3, MP_QSTR_scale);
 
+    #if CIRCUITPY_BUSDISPLAY
+    if (mp_obj_is_type(bitmap_in, &busdisplay_busdisplay_type)) {
+        busdisplay_busdisplay_obj_t *display = MP_OBJ_TO_PTR(bitmap_in);
+        mp_arg_validate_int(display->core.colorspace.depth, 16, MP_QSTR_color_depth);
+        if (display->core.colorspace.grayscale) {
+            mp_raise_ValueError_varg(MP_ERROR_TEXT("Invalid %q"), MP_QSTR_grayscale);
+        }
+        if (args[ARG_skip_source_index].u_obj != mp_const_none) {
+            mp_raise_ValueError_varg(MP_ERROR_TEXT("Invalid %q"), MP_QSTR_skip_source_index);
+        }
+        if (args[ARG_skip_dest_index].u_obj != mp_const_none) {
+            mp_raise_ValueError_varg(MP_ERROR_TEXT("Invalid %q"), MP_QSTR_skip_dest_index);
+        }
+        uint16_t width = common_hal_busdisplay_busdisplay_get_width(display);
+        uint16_t height = common_hal_busdisplay_busdisplay_get_height(display);
+        int x = mp_arg_validate_int_range(args[ARG_x].u_int, 0, width, MP_QSTR_x);
+        int y = mp_arg_validate_int_range(args[ARG_y].u_int, 0, height, MP_QSTR_y);
+        bitmaptools_rect_t lim = bitmaptools_validate_coord_range_pair(&args[ARG_x1], width, height);
+        common_hal_jpegio_jpegdecoder_decode_to_display(self, display, scale, x, y, &lim);
+        return mp_const_none;
+    }
+    #endif
+
+    mp_arg_validate_type(bitmap_in, &displayio_bitmap_type, MP_QSTR_bitmap);
+    displayio_bitmap_t *bitmap = MP_OBJ_TO_PTR(bitmap_in);
+
     int x = mp_arg_validate_int_range(args[ARG_x].u_int, 0, bitmap->width, MP_QSTR_x);
     int y = mp_arg_validate_int_range(args[ARG_y].u_int, 0, bitmap->height, MP_QSTR_y);
     bitmaptools_rect_t lim = bitmaptools_validate_coord_range_pair(&args[ARG_x1], bitmap->width, bitmap->height);
@@ -6,6 +6,7 @@
 
 #include "py/stream.h"
 #include "py/mperrno.h"
+#include "py/binary.h"
 #include "py/objproperty.h"
 #include "py/runtime.h"
 #include "py/stream.h"
@@ -64,6 +65,42 @@ static mp_obj_t keypad_eventqueue_get_into(mp_obj_t self_in, mp_obj_t event_in)
 }
 MP_DEFINE_CONST_FUN_OBJ_2(keypad_eventqueue_get_into_obj, keypad_eventqueue_get_into);
 
+//|     def get_many(self, buffer: WriteableBuffer) -> int:
+//|         """Store as many queued key transition events as fit in ``buffer`` and return
+//|         how many were stored. Each event takes three consecutive 32-bit entries:
+//|         the key number, ``1`` if pressed or ``0`` if released, and the timestamp
+//|         in `supervisor.ticks_ms` units.
+//|
+//|         Like ``get_into()``, this does not allocate storage. Use it to drain the
+//|         queue of a large scanner with one call.
+//|
+//|         .. code-block:: python
+//|
+//|             import array
+//|             events = array.array("L", [0] * (3 * 16))
+//|             count = keys.events.get_many(events)
+//|             for i in range(0, 3 * count, 3):
+//|                 print(events[i], events[i + 1], events[i + 2])
+//|
+//|         :param WriteableBuffer buffer: Buffer with 32-bit elements, such as an ``array.array("L")``
+//|         :return: The number of events stored.
+//|         :rtype: int
+//|         """
+//|         ...
+static mp_obj_t keypad_eventqueue_get_many(mp_obj_t self_in, mp_obj_t buffer_in) {
+    keypad_eventqueue_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_in, &bufinfo, MP_BUFFER_WRITE);
+    if (mp_binary_get_size('@', bufinfo.typecode, NULL) != sizeof(uint32_t)) {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("%q must be array of type 'L'"), MP_QSTR_buffer);
+    }
+
+    size_t max_events = bufinfo.len / (3 * sizeof(uint32_t));
+    return MP_OBJ_NEW_SMALL_INT(common_hal_keypad_eventqueue_get_many(self, bufinfo.buf, max_events));
+}
+MP_DEFINE_CONST_FUN_OBJ_2(keypad_eventqueue_get_many_obj, keypad_eventqueue_get_many);
+
 //|     def clear(self) -> None:
 //|         """Clear any queued key transition events. Also sets `overflowed` to ``False``."""
 //|         ...
@@ -115,6 +152,7 @@ static const mp_rom_map_elem_t keypad_eventqueue_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_clear),      MP_ROM_PTR(&keypad_eventqueue_clear_obj) },
     { MP_ROM_QSTR(MP_QSTR_get),        MP_ROM_PTR(&keypad_eventqueue_get_obj) },
     { MP_ROM_QSTR(MP_QSTR_get_into),   MP_ROM_PTR(&keypad_eventqueue_get_into_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get_many),   MP_ROM_PTR(&keypad_eventqueue_get_many_obj) },
     { MP_ROM_QSTR(MP_QSTR_overflowed), MP_ROM_PTR(&keypad_eventqueue_overflowed_obj) },
 };
 
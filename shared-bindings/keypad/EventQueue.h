@@ -17,6 +17,8 @@ void common_hal_keypad_eventqueue_clear(keypad_eventqueue_obj_t *self);
 size_t common_hal_keypad_eventqueue_get_length(keypad_eventqueue_obj_t *self);
 mp_obj_t common_hal_keypad_eventqueue_get(keypad_eventqueue_obj_t *self);
 bool common_hal_keypad_eventqueue_get_into(keypad_eventqueue_obj_t *self, keypad_event_obj_t *event);
+// Stores up to max_events events as (key_number, pressed, timestamp) triples. Returns how many were stored.
+size_t common_hal_keypad_eventqueue_get_many(keypad_eventqueue_obj_t *self, uint32_t *buffer, size_t max_events);
 
 bool common_hal_keypad_eventqueue_get_overflowed(keypad_eventqueue_obj_t *self);
 void common_hal_keypad_eventqueue_set_overflowed(keypad_eventqueue_obj_t *self, bool overflowed);
@@ -0,0 +1,197 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <stdint.h>
+
+#include "py/gc.h"
+#include "py/mpstate.h"
+#include "py/objlist.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/memorymonitor/AllocationProfiler.h"
+
+//| class AllocationProfiler:
+//|     def __init__(self, *, every: int = 16, samples: int = 256) -> None:
+//|         """Records where heap allocations come from, to find the code that makes the
+//|         garbage collector run often.
+//|
+//|         While active, one in ``every`` allocations is sampled. A sample records the size,
+//|         the Python line that was running and, for objects, their type. The last ``samples``
+//|         samples are kept, so use a larger ``every`` for code that runs for a long time.
+//|
+//|         Find the top allocation sites::
+//|
+//|           import memorymonitor
+//|
+//|           profiler = memorymonitor.AllocationProfiler(every=4)
+//|           with profiler:
+//|               main_loop()
+//|
+//|           for count, size, file, line, function, kind in profiler.top(5):
+//|               print(count, size, file, line, function, kind)
+//|
+//|         """
+//|         ...
+static mp_obj_t memorymonitor_allocationprofiler_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_every, ARG_samples };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_every, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 16} },
+        { MP_QSTR_samples, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 256} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t every = mp_arg_validate_int_range(args[ARG_every].u_int, 1, 0xffff, MP_QSTR_every);
+    mp_int_t samples = mp_arg_validate_int_range(args[ARG_samples].u_int, 1, 0xffff, MP_QSTR_samples);
+
+    memorymonitor_allocationprofiler_obj_t *self =
+        mp_obj_malloc(memorymonitor_allocationprofiler_obj_t, &memorymonitor_allocationprofiler_type);
+
+    common_hal_memorymonitor_allocationprofiler_construct(self, samples, every);
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|     def __enter__(self) -> AllocationProfiler:
+//|         """Clears the samples and starts sampling. Only one profiler can be active at a time."""
+//|         ...
+static mp_obj_t memorymonitor_allocationprofiler_obj___enter__(mp_obj_t self_in) {
+    common_hal_memorymonitor_allocationprofiler_resume(self_in);
+    common_hal_memorymonitor_allocationprofiler_clear(self_in);
+    return self_in;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(memorymonitor_allocationprofiler___enter___obj, memorymonitor_allocationprofiler_obj___enter__);
+
+//|     def __exit__(self) -> None:
+//|         """Stops sampling. The samples are kept for `top`. See
+//|         :ref:`lifetime-and-contextmanagers` for more info."""
+//|         ...
+static mp_obj_t memorymonitor_allocationprofiler_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_memorymonitor_allocationprofiler_pause(args[0]);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(memorymonitor_allocationprofiler___exit___obj, 4, 4, memorymonitor_allocationprofiler_obj___exit__);
+
+//|     allocations: int
+//|     """Number of allocations made while active, sampled or not."""
+static mp_obj_t memorymonitor_allocationprofiler_obj_get_allocations(mp_obj_t self_in) {
+    memorymonitor_allocationprofiler_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_int_from_uint(common_hal_memorymonitor_allocationprofiler_get_allocations(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(memorymonitor_allocationprofiler_get_allocations_obj, memorymonitor_allocationprofiler_obj_get_allocations);
+
+MP_PROPERTY_GETTER(memorymonitor_allocationprofiler_allocations_obj,
+    (mp_obj_t)&memorymonitor_allocationprofiler_get_allocations_obj);
+
+static bool same_site(const memorymonitor_allocation_sample_t *a, const memorymonitor_allocation_sample_t *b) {
+    return a->type == b->type &&
+           a->location.file == b->location.file &&
+           a->location.name == b->location.name &&
+           a->location.line == b->location.line;
+}
+
+//|     def top(
+//|         self, count: int = 10
+//|     ) -> List[Tuple[int, int, Optional[str], Optional[int], Optional[str], Optional[type]]]:
+//|         """Returns up to ``count`` allocation sites, the most sampled first. Each is
+//|         ``(samples, bytes, file, line, function, type)`` where ``bytes`` is the total size of
+//|         the sampled allocations. Multiply both by ``every`` to estimate the totals.
+//|         ``type`` is ``None`` for buffers that aren't objects, such as list storage. ``file``,
+//|         ``line`` and ``function`` are ``None`` for allocations made outside Python code."""
+//|         ...
+//|
+static mp_obj_t memorymonitor_allocationprofiler_obj_top(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_count };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_count, MP_ARG_INT, {.u_int = 10} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    memorymonitor_allocationprofiler_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    size_t count = mp_arg_validate_int_min(args[ARG_count].u_int, 0, MP_QSTR_count);
+
+    // Don't sample our own allocations while reading the samples.
+    bool active = MP_STATE_VM(active_allocationprofiler) == self;
+    if (active) {
+        common_hal_memorymonitor_allocationprofiler_pause(self);
+    }
+
+    const memorymonitor_allocation_sample_t *samples = common_hal_memorymonitor_allocationprofiler_get_samples(self);
+    size_t n = common_hal_memorymonitor_allocationprofiler_get_sample_count(self);
+
+    // Fold duplicate sites into their first sample. SIZE_MAX marks folded samples.
+    size_t *hits = m_new(size_t, n);
+    size_t *blocks = m_new(size_t, n);
+    for (size_t i = 0; i < n; i++) {
+        hits[i] = 0;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (hits[i] == SIZE_MAX) {
+            continue;
+        }
+        hits[i] = 1;
+        blocks[i] = samples[i].blocks;
+        for (size_t j = i + 1; j < n; j++) {
+            if (hits[j] != SIZE_MAX && same_site(&samples[i], &samples[j])) {
+                hits[i]++;
+                blocks[i] += samples[j].blocks;
+                hits[j] = SIZE_MAX;
+            }
+        }
+    }
+
+    mp_obj_list_t *result = MP_OBJ_TO_PTR(mp_obj_new_list(0, NULL));
+    while (result->len < count) {
+        size_t best = n;
+        for (size_t i = 0; i < n; i++) {
+            if (hits[i] != SIZE_MAX && hits[i] != 0 && (best == n || hits[i] > hits[best])) {
+                best = i;
+            }
+        }
+        if (best == n) {
+            break;
+        }
+        const memorymonitor_allocation_sample_t *sample = &samples[best];
+        bool in_python = sample->location.name != MP_QSTRnull;
+        mp_obj_t items[] = {
+            mp_obj_new_int_from_uint(hits[best]),
+            mp_obj_new_int_from_uint(blocks[best] * MICROPY_BYTES_PER_GC_BLOCK),
+            in_python ? MP_OBJ_NEW_QSTR(sample->location.file) : mp_const_none,
+            in_python ? MP_OBJ_NEW_SMALL_INT(sample->location.line) : mp_const_none,
+            in_python ? MP_OBJ_NEW_QSTR(sample->location.name) : mp_const_none,
+            sample->type != NULL ? MP_OBJ_FROM_PTR(sample->type) : mp_const_none,
+        };
+        hits[best] = 0;
+        mp_obj_list_append(MP_OBJ_FROM_PTR(result), mp_obj_new_tuple(MP_ARRAY_SIZE(items), items));
+    }
+    m_del(size_t, hits, n);
+    m_del(size_t, blocks, n);
+    if (active) {
+        common_hal_memorymonitor_allocationprofiler_resume(self);
+    }
+    return MP_OBJ_FROM_PTR(result);
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(memorymonitor_allocationprofiler_top_obj, 1, memorymonitor_allocationprofiler_obj_top);
+
+static const mp_rom_map_elem_t memorymonitor_allocationprofiler_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&memorymonitor_allocationprofiler___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&memorymonitor_allocationprofiler___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_top), MP_ROM_PTR(&memorymonitor_allocationprofiler_top_obj) },
+
+    // Properties
+    { MP_ROM_QSTR(MP_QSTR_allocations), MP_ROM_PTR(&memorymonitor_allocationprofiler_allocations_obj) },
+};
+static MP_DEFINE_CONST_DICT(memorymonitor_allocationprofiler_locals_dict, memorymonitor_allocationprofiler_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    memorymonitor_allocationprofiler_type,
+    MP_QSTR_AllocationProfiler,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    make_new, memorymonitor_allocationprofiler_make_new,
+    locals_dict, &memorymonitor_allocationprofiler_locals_dict
+    );
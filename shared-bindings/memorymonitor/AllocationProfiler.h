@@ -0,0 +1,19 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "shared-module/memorymonitor/AllocationProfiler.h"
+
+extern const mp_obj_type_t memorymonitor_allocationprofiler_type;
+
+void common_hal_memorymonitor_allocationprofiler_construct(memorymonitor_allocationprofiler_obj_t *self, size_t sample_count, uint32_t every);
+void common_hal_memorymonitor_allocationprofiler_pause(memorymonitor_allocationprofiler_obj_t *self);
+void common_hal_memorymonitor_allocationprofiler_resume(memorymonitor_allocationprofiler_obj_t *self);
+void common_hal_memorymonitor_allocationprofiler_clear(memorymonitor_allocationprofiler_obj_t *self);
+size_t common_hal_memorymonitor_allocationprofiler_get_allocations(memorymonitor_allocationprofiler_obj_t *self);
+size_t common_hal_memorymonitor_allocationprofiler_get_sample_count(memorymonitor_allocationprofiler_obj_t *self);
+const memorymonitor_allocation_sample_t *common_hal_memorymonitor_allocationprofiler_get_samples(memorymonitor_allocationprofiler_obj_t *self);
@@ -4,6 +4,7 @@
 //
 // SPDX-License-Identifier: MIT
 
+#include <stdarg.h>
 #include <stdint.h>
 
 #include "py/obj.h"
@@ -11,6 +12,7 @@
 
 #include "shared-bindings/memorymonitor/__init__.h"
 #include "shared-bindings/memorymonitor/AllocationAlarm.h"
+#include "shared-bindings/memorymonitor/AllocationProfiler.h"
 #include "shared-bindings/memorymonitor/AllocationSize.h"
 
 //| """Memory monitoring helpers"""
@@ -34,6 +36,7 @@ NORETURN void mp_raise_memorymonitor_AllocationError(mp_rom_error_text_t fmt, ..
 static const mp_rom_map_elem_t memorymonitor_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_memorymonitor) },
     { MP_ROM_QSTR(MP_QSTR_AllocationAlarm), MP_ROM_PTR(&memorymonitor_allocationalarm_type) },
+    { MP_ROM_QSTR(MP_QSTR_AllocationProfiler), MP_ROM_PTR(&memorymonitor_allocationprofiler_type) },
     { MP_ROM_QSTR(MP_QSTR_AllocationSize), MP_ROM_PTR(&memorymonitor_allocationsize_type) },
 
     // Errors
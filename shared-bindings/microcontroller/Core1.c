@@ -0,0 +1,95 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "py/obj.h"
+#include "py/runtime.h"
+#include "shared-bindings/microcontroller/Core1.h"
+
+//| class Core1:
+//|     """Run built-in native kernels on the second CPU core
+//|
+//|     Only kernels that are part of CircuitPython can be run. A kernel never
+//|     touches the Python heap or VM, so Python code keeps running on the first
+//|     core until `Core1.wait` is called. The kernel's arguments must not be
+//|     changed while it runs.
+//|
+//|     If there is no second core, or it is already in use (for instance by
+//|     `picodvi` or `usb_host`), `Core1.run` runs the kernel to completion
+//|     before returning instead.
+//|
+//|     Usage::
+//|
+//|        import microcontroller
+//|        microcontroller.Core1.run("copy", dest, source)
+//|        # ... do other work ...
+//|        microcontroller.Core1.wait()
+//|
+//|     The available kernels are:
+//|
+//|     * ``"copy"``, ``(dest, source)``: copies a buffer into another of the
+//|       same length.
+//|     * ``"bitmapfilter_pipeline"``, ``(pipeline, bitmap, mask=None)``: applies a
+//|       `bitmapfilter.Pipeline` to an RGB565 bitmap. Pipelines with a
+//|       ``morph`` stage are not supported.
+//|     """
+//|
+//|     def __init__(self) -> None:
+//|         """You cannot create an instance of `microcontroller.Core1`."""
+//|         ...
+//|
+
+//|     @staticmethod
+//|     def run(kernel: str, *args: Any) -> None:
+//|         """Start ``kernel`` with ``args``, first waiting for any kernel that
+//|         is still running. The second core is held until `Core1.wait` is
+//|         called."""
+//|         ...
+//|
+static mp_obj_t mcu_core1_run(size_t n_args, const mp_obj_t *args) {
+    qstr kernel = mp_obj_str_get_qstr(args[0]);
+    shared_module_microcontroller_core1_run(kernel, n_args - 1, args + 1);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR(mcu_core1_run_fun_obj, 1, mcu_core1_run);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(mcu_core1_run_obj, MP_ROM_PTR(&mcu_core1_run_fun_obj));
+
+//|     @staticmethod
+//|     def busy() -> bool:
+//|         """True while a kernel is still running."""
+//|         ...
+//|
+static mp_obj_t mcu_core1_busy(void) {
+    return mp_obj_new_bool(shared_module_microcontroller_core1_get_busy());
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(mcu_core1_busy_fun_obj, mcu_core1_busy);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(mcu_core1_busy_obj, MP_ROM_PTR(&mcu_core1_busy_fun_obj));
+
+//|     @staticmethod
+//|     def wait() -> None:
+//|         """Wait for the running kernel, if any, to finish, and release the
+//|         second core."""
+//|         ...
+//|
+static mp_obj_t mcu_core1_wait(void) {
+    shared_module_microcontroller_core1_wait();
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(mcu_core1_wait_fun_obj, mcu_core1_wait);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(mcu_core1_wait_obj, MP_ROM_PTR(&mcu_core1_wait_fun_obj));
+
+static const mp_rom_map_elem_t mcu_core1_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_busy), MP_ROM_PTR(&mcu_core1_busy_obj) },
+    { MP_ROM_QSTR(MP_QSTR_run), MP_ROM_PTR(&mcu_core1_run_obj) },
+    { MP_ROM_QSTR(MP_QSTR_wait), MP_ROM_PTR(&mcu_core1_wait_obj) },
+};
+static MP_DEFINE_CONST_DICT(mcu_core1_locals_dict, mcu_core1_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    mcu_core1_type,
+    MP_QSTR_Core1,
+    MP_TYPE_FLAG_NONE,
+    locals_dict, &mcu_core1_locals_dict
+    );
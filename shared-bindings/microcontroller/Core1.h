@@ -0,0 +1,15 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+extern const mp_obj_type_t mcu_core1_type;
+
+void shared_module_microcontroller_core1_run(qstr kernel, size_t n_args, const mp_obj_t *args);
+bool shared_module_microcontroller_core1_get_busy(void);
+void shared_module_microcontroller_core1_wait(void);
@@ -16,9 +16,14 @@
 #include "common-hal/microcontroller/Processor.h"
 
 #include "shared-bindings/microcontroller/__init__.h"
+#include "shared-bindings/microcontroller/Core1.h"
 #include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/microcontroller/Processor.h"
 
+#if CIRCUITPY_NVM && CIRCUITPY_INTERNAL_NVM_SIZE > 0
+#include "shared-module/nvm/ByteArray.h"
+#endif
+
 //| """Pin references and cpu functionality
 //|
 //| The `microcontroller` module defines the pins and other bare-metal hardware
@@ -113,6 +118,9 @@ static MP_DEFINE_CONST_FUN_OBJ_1(mcu_on_next_reset_obj, mcu_on_next_reset);
 //|     ...
 //|
 static mp_obj_t mcu_reset(void) {
+    #if CIRCUITPY_NVM && CIRCUITPY_INTERNAL_NVM_SIZE > 0
+    nvm_bytearray_flush();
+    #endif
     common_hal_mcu_reset();
     // We won't actually get here because we're resetting.
     return mp_const_none;
@@ -160,6 +168,9 @@ static const mp_rom_map_elem_t mcu_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_Pin),  MP_ROM_PTR(&mcu_pin_type) },
     { MP_ROM_QSTR(MP_QSTR_pin),  MP_ROM_PTR(&mcu_pin_module) },
     { MP_ROM_QSTR(MP_QSTR_Processor),   MP_ROM_PTR(&mcu_processor_type) },
+    #if CIRCUITPY_MICROCONTROLLER_CORE1
+    { MP_ROM_QSTR(MP_QSTR_Core1),   MP_ROM_PTR(&mcu_core1_type) },
+    #endif
 
 };
 
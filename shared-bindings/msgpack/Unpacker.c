@@ -0,0 +1,131 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "py/runtime.h"
+#include "shared-bindings/msgpack/Unpacker.h"
+#include "shared-module/msgpack/__init__.h"
+
+//| class Unpacker:
+//|     """Unpack a sequence of objects from a stream, reading it in large chunks."""
+//|
+//|     def __init__(
+//|         self,
+//|         stream: circuitpython_typing.ByteStream,
+//|         buffer: Optional[circuitpython_typing.WriteableBuffer] = None,
+//|         *,
+//|         buffer_size: int = 1024,
+//|         ext_hook: Union[Callable[[int, bytes], object], None] = None,
+//|         use_list: bool = True,
+//|         use_memoryview: bool = False,
+//|     ) -> None:
+//|         """Create an unpacker reading from ``stream``.
+//|
+//|         Data is read from the stream into ``buffer``, or into a newly allocated
+//|         buffer of ``buffer_size`` bytes, so that small objects do not each need
+//|         a call to the stream's ``readinto``.
+//|
+//|         :param ~circuitpython_typing.ByteStream stream: stream to read from
+//|         :param ~circuitpython_typing.WriteableBuffer buffer: buffer to read into
+//|         :param int buffer_size: size of the buffer to allocate when ``buffer`` is not given
+//|         :param Optional[~circuitpython_typing.Callable[[int, bytes], object]] ext_hook: function called for objects in
+//|                msgpack ext format.
+//|         :param bool use_list: return array as list or tuple (use_list=False).
+//|         :param bool use_memoryview: return bin data that fits in the buffer as a
+//|                `memoryview` of the buffer instead of a copy. The buffer is reused,
+//|                so a view's contents are only valid until the next object is
+//|                unpacked; copy it with `bytes` to keep it.
+//|
+//|         Example::
+//|
+//|             import msgpack
+//|             with open("log.msgpack", "rb") as f:
+//|                 for record in msgpack.Unpacker(f):
+//|                     print(record)
+//|         """
+//|         ...
+//|
+static mp_obj_t mod_msgpack_unpacker_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_stream, ARG_buffer, ARG_buffer_size, ARG_ext_hook, ARG_use_list, ARG_use_memoryview };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_stream, MP_ARG_REQUIRED | MP_ARG_OBJ, { .u_obj = MP_OBJ_NULL } },
+        { MP_QSTR_buffer, MP_ARG_OBJ, { .u_obj = mp_const_none } },
+        { MP_QSTR_buffer_size, MP_ARG_KW_ONLY | MP_ARG_INT, { .u_int = 1024 } },
+        { MP_QSTR_ext_hook, MP_ARG_KW_ONLY | MP_ARG_OBJ, { .u_obj = mp_const_none } },
+        { MP_QSTR_use_list, MP_ARG_KW_ONLY | MP_ARG_BOOL, { .u_bool = true } },
+        { MP_QSTR_use_memoryview, MP_ARG_KW_ONLY | MP_ARG_BOOL, { .u_bool = false } },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t hook = args[ARG_ext_hook].u_obj;
+    if (hook != mp_const_none && !mp_obj_is_callable(hook)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("ext_hook is not a function"));
+    }
+
+    // A bytearray rather than a bare allocation, so that memoryviews of it
+    // keep it alive.
+    mp_obj_t buffer = args[ARG_buffer].u_obj;
+    if (buffer == mp_const_none) {
+        mp_int_t buffer_size = mp_arg_validate_int_min(args[ARG_buffer_size].u_int, 1, MP_QSTR_buffer_size);
+        buffer = mp_obj_new_bytearray_of_zeros(buffer_size);
+    }
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_WRITE);
+    mp_arg_validate_length_min(bufinfo.len, 1, MP_QSTR_buffer);
+
+    msgpack_unpacker_obj_t *self = mp_obj_malloc(msgpack_unpacker_obj_t, &mod_msgpack_unpacker_type);
+    common_hal_msgpack_unpacker_construct(self, args[ARG_stream].u_obj, bufinfo.buf, bufinfo.len,
+        hook, args[ARG_use_list].u_bool, args[ARG_use_memoryview].u_bool);
+    self->buffer = buffer;
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|     def unpack(self) -> object:
+//|         """Unpack and return the next object.
+//|         Raises `EOFError` if the stream has no more objects.
+//|
+//|         If reading the stream raises an error, such as a timeout, the next
+//|         call starts the same object again. Objects larger than the buffer
+//|         can't be started again once part of them has been read."""
+//|         ...
+//|
+static mp_obj_t mod_msgpack_unpacker_unpack(mp_obj_t self_in) {
+    msgpack_unpacker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_t obj = common_hal_msgpack_unpacker_unpack(self);
+    if (obj == MP_OBJ_STOP_ITERATION) {
+        mp_raise_msg(&mp_type_EOFError, NULL);
+    }
+    return obj;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(mod_msgpack_unpacker_unpack_obj, mod_msgpack_unpacker_unpack);
+
+//|     def __iter__(self) -> Iterator[object]:
+//|         """Returns itself since it is the iterator."""
+//|         ...
+//|
+//|     def __next__(self) -> object:
+//|         """Returns the next object.
+//|         Raises `StopIteration` when the stream ends between objects."""
+//|         ...
+//|
+static mp_obj_t mod_msgpack_unpacker_iternext(mp_obj_t self_in) {
+    msgpack_unpacker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return common_hal_msgpack_unpacker_unpack(self);
+}
+
+static const mp_rom_map_elem_t mod_msgpack_unpacker_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_unpack), MP_ROM_PTR(&mod_msgpack_unpacker_unpack_obj) },
+};
+static MP_DEFINE_CONST_DICT(mod_msgpack_unpacker_locals_dict, mod_msgpack_unpacker_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    mod_msgpack_unpacker_type,
+    MP_QSTR_Unpacker,
+    MP_TYPE_FLAG_ITER_IS_ITERNEXT,
+    make_new, mod_msgpack_unpacker_make_new,
+    iter, mod_msgpack_unpacker_iternext,
+    locals_dict, &mod_msgpack_unpacker_locals_dict
+    );
@@ -0,0 +1,153 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <stdint.h>
+
+#include "shared/runtime/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/adafruit_pixelbuf/PixelBuf.h"
+#include "shared-bindings/microcontroller/Pin.h"
+#include "shared-bindings/neopixel_parallel/NeoPixelParallel.h"
+#include "shared-bindings/util.h"
+
+//| class NeoPixelParallel:
+//|     """Send the pixels of several strips out of consecutive pins at the same time."""
+//|
+//|     def __init__(
+//|         self, data0: microcontroller.Pin, strips: Sequence[adafruit_pixelbuf.PixelBuf]
+//|     ) -> None:
+//|         """Create a NeoPixelParallel object that drives one strip from each of
+//|         ``len(strips)`` pins, starting at ``data0``.
+//|
+//|         The strips are plain `adafruit_pixelbuf.PixelBuf` objects, usually with
+//|         ``auto_write=False``, and are sent with `show` rather than their own ``show()``.
+//|         They may differ in length and in bytes per pixel.
+//|
+//|         :param ~microcontroller.Pin data0: the pin for the first strip. Each following
+//|           strip uses the next pin up.
+//|         :param Sequence[adafruit_pixelbuf.PixelBuf] strips: a list or tuple of 1 to 16 strips
+//|
+//|         For example::
+//|
+//|             import adafruit_pixelbuf
+//|             import board
+//|             import neopixel_parallel
+//|
+//|             strips = [adafruit_pixelbuf.PixelBuf(300, byteorder="GRB", auto_write=False) for _ in range(8)]
+//|             leds = neopixel_parallel.NeoPixelParallel(board.GP0, strips)
+//|             for i, strip in enumerate(strips):
+//|                 strip.fill((i * 32, 0, 0))
+//|             leds.show()
+//|
+//|         **Limitations:** Only available on RP2040, where it uses a PIO state machine
+//|         and a DMA channel.
+//|         """
+//|         ...
+static mp_obj_t neopixel_parallel_neopixelparallel_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_data0, ARG_strips };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_data0,  MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_strips, MP_ARG_REQUIRED | MP_ARG_OBJ },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    const mcu_pin_obj_t *data0 = validate_obj_is_free_pin(args[ARG_data0].u_obj, MP_QSTR_data0);
+
+    size_t strip_count;
+    mp_obj_t *items;
+    mp_obj_get_array(args[ARG_strips].u_obj, &strip_count, &items);
+    mp_arg_validate_length_range(strip_count, 1, NEOPIXEL_PARALLEL_MAX_STRIPS, MP_QSTR_strips);
+    for (size_t i = 0; i < strip_count; i++) {
+        if (mp_obj_cast_to_native_base(items[i], &pixelbuf_pixelbuf_type) == MP_OBJ_NULL) {
+            mp_raise_TypeError_varg(MP_ERROR_TEXT("%q must be of type %q, not %q"),
+                MP_QSTR_strips, MP_QSTR_PixelBuf, mp_obj_get_type(items[i])->name);
+        }
+    }
+
+    neopixel_parallel_neopixelparallel_obj_t *self = m_new_obj_with_finaliser(neopixel_parallel_neopixelparallel_obj_t);
+    self->base.type = &neopixel_parallel_neopixelparallel_type;
+    // Keep our own copy so later changes to the caller's list don't matter.
+    common_hal_neopixel_parallel_neopixelparallel_construct(self, data0, mp_obj_new_tuple(strip_count, items));
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|     def deinit(self) -> None:
+//|         """Waits for any transmission to finish, then releases the pins and other hardware for reuse."""
+static mp_obj_t neopixel_parallel_neopixelparallel_deinit(mp_obj_t self_in) {
+    neopixel_parallel_neopixelparallel_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_neopixel_parallel_neopixelparallel_deinit(self);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(neopixel_parallel_neopixelparallel_deinit_obj, neopixel_parallel_neopixelparallel_deinit);
+
+static void check_for_deinit(neopixel_parallel_neopixelparallel_obj_t *self) {
+    if (common_hal_neopixel_parallel_neopixelparallel_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|     def __enter__(self) -> NeoPixelParallel:
+//|         """No-op used by Context Managers."""
+//  Provided by context manager helper.
+
+//|     def __exit__(self) -> None:
+//|         """Automatically deinitializes the hardware when exiting a context. See
+//|         :ref:`lifetime-and-contextmanagers` for more info."""
+static mp_obj_t neopixel_parallel_neopixelparallel_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_neopixel_parallel_neopixelparallel_deinit(args[0]);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(neopixel_parallel_neopixelparallel___exit___obj, 4, 4, neopixel_parallel_neopixelparallel_obj___exit__);
+
+//|     def show(self) -> None:
+//|         """Start sending the current contents of all the strips.
+//|
+//|         This returns as soon as the data is on its way. If the previous `show` is
+//|         still being sent, it waits for that to finish first. The strips may be
+//|         changed as soon as this returns."""
+static mp_obj_t neopixel_parallel_neopixelparallel_show(mp_obj_t self_in) {
+    neopixel_parallel_neopixelparallel_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_neopixel_parallel_neopixelparallel_show(self);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(neopixel_parallel_neopixelparallel_show_obj, neopixel_parallel_neopixelparallel_show);
+
+//|     busy: bool
+//|     """True while the data from the last `show` is still being sent."""
+//|
+static mp_obj_t neopixel_parallel_neopixelparallel_get_busy(mp_obj_t self_in) {
+    neopixel_parallel_neopixelparallel_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return mp_obj_new_bool(common_hal_neopixel_parallel_neopixelparallel_get_busy(self));
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(neopixel_parallel_neopixelparallel_get_busy_obj, neopixel_parallel_neopixelparallel_get_busy);
+
+MP_PROPERTY_GETTER(neopixel_parallel_neopixelparallel_busy_obj,
+    (mp_obj_t)&neopixel_parallel_neopixelparallel_get_busy_obj);
+
+static const mp_rom_map_elem_t neopixel_parallel_neopixelparallel_locals_dict_table[] = {
+    // Methods
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&neopixel_parallel_neopixelparallel_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&neopixel_parallel_neopixelparallel_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&neopixel_parallel_neopixelparallel___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_show), MP_ROM_PTR(&neopixel_parallel_neopixelparallel_show_obj) },
+    { MP_ROM_QSTR(MP_QSTR_busy), MP_ROM_PTR(&neopixel_parallel_neopixelparallel_busy_obj) },
+};
+static MP_DEFINE_CONST_DICT(neopixel_parallel_neopixelparallel_locals_dict, neopixel_parallel_neopixelparallel_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    neopixel_parallel_neopixelparallel_type,
+    MP_QSTR_NeoPixelParallel,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    make_new, neopixel_parallel_neopixelparallel_make_new,
+    locals_dict, &neopixel_parallel_neopixelparallel_locals_dict
+    );
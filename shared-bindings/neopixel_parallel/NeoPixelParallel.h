@@ -0,0 +1,20 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "common-hal/microcontroller/Pin.h"
+#include "common-hal/neopixel_parallel/NeoPixelParallel.h"
+
+extern const mp_obj_type_t neopixel_parallel_neopixelparallel_type;
+
+// strips is a tuple of PixelBufs, one per pin starting at data0.
+void common_hal_neopixel_parallel_neopixelparallel_construct(neopixel_parallel_neopixelparallel_obj_t *self,
+    const mcu_pin_obj_t *data0, mp_obj_t strips);
+void common_hal_neopixel_parallel_neopixelparallel_deinit(neopixel_parallel_neopixelparallel_obj_t *self);
+bool common_hal_neopixel_parallel_neopixelparallel_deinited(neopixel_parallel_neopixelparallel_obj_t *self);
+void common_hal_neopixel_parallel_neopixelparallel_show(neopixel_parallel_neopixelparallel_obj_t *self);
+bool common_hal_neopixel_parallel_neopixelparallel_get_busy(neopixel_parallel_neopixelparallel_obj_t *self);
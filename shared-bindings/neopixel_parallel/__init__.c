@@ -0,0 +1,37 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <stdint.h>
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/neopixel_parallel/NeoPixelParallel.h"
+
+//| """Drive several NeoPixel strips at the same time
+//|
+//| The `neopixel_parallel` module sends the data of up to 16 `adafruit_pixelbuf.PixelBuf`
+//| strips out of consecutive pins at once, so updating all of them takes as long as
+//| updating the longest one.
+//|
+//| All classes change hardware state and should be deinitialized when they
+//| are no longer needed if the program continues after use. To do so, either
+//| call :py:meth:`!deinit` or use a context manager. See
+//| :ref:`lifetime-and-contextmanagers` for more info."""
+
+static const mp_rom_map_elem_t neopixel_parallel_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_neopixel_parallel) },
+    { MP_ROM_QSTR(MP_QSTR_NeoPixelParallel), MP_ROM_PTR(&neopixel_parallel_neopixelparallel_type) },
+};
+
+static MP_DEFINE_CONST_DICT(neopixel_parallel_module_globals, neopixel_parallel_module_globals_table);
+
+const mp_obj_module_t neopixel_parallel_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t *)&neopixel_parallel_module_globals,
+};
+
+MP_REGISTER_MODULE(MP_QSTR_neopixel_parallel, neopixel_parallel_module);
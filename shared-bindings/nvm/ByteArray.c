@@ -8,13 +8,17 @@
 #include "py/runtime.h"
 #include "py/runtime0.h"
 #include "shared-bindings/nvm/ByteArray.h"
+#include "shared-module/nvm/ByteArray.h"
 
 //| class ByteArray:
 //|     r"""Presents a stretch of non-volatile memory as a bytearray.
 //|
 //|     Non-volatile memory is available as a byte array that persists over reloads
-//|     and power cycles. Each assignment causes an erase and write cycle so its recommended to assign
-//|     all values to change at once.
+//|     and power cycles. On most boards, assignments to nearby bytes are collected
+//|     in RAM and written together a short time later, or when the program ends,
+//|     so a value that changes often does not cost an erase and write cycle each
+//|     time. Call `flush` to make sure that changes have been written, for example
+//|     before power may be removed.
 //|
 //|     Usage::
 //|
@@ -44,7 +48,20 @@ static mp_obj_t nvm_bytearray_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
     }
 }
 
+//|     def flush(self) -> None:
+//|         """Write any changes that are still held in RAM to the non-volatile memory."""
+//|         ...
+//|
+static mp_obj_t nvm_bytearray_flush_obj_fun(mp_obj_t self_in) {
+    if (!nvm_bytearray_flush()) {
+        mp_raise_RuntimeError(MP_ERROR_TEXT("Unable to write to nvm."));
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(nvm_bytearray_flush_obj, nvm_bytearray_flush_obj_fun);
+
 static const mp_rom_map_elem_t nvm_bytearray_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&nvm_bytearray_flush_obj) },
 };
 
 static MP_DEFINE_CONST_DICT(nvm_bytearray_locals_dict, nvm_bytearray_locals_dict_table);
@@ -100,7 +117,7 @@ static mp_obj_t nvm_bytearray_subscr(mp_obj_t self_in, mp_obj_t index_in, mp_obj
                     mp_raise_NotImplementedError(MP_ERROR_TEXT("array/bytes required on right side"));
                 }
 
-                if (!common_hal_nvm_bytearray_set_bytes(self, slice.start, src_items, src_len)) {
+                if (!nvm_bytearray_set_bytes(self, slice.start, src_items, src_len)) {
                     mp_raise_RuntimeError(MP_ERROR_TEXT("Unable to write to nvm."));
                 }
                 return mp_const_none;
@@ -111,7 +128,7 @@ static mp_obj_t nvm_bytearray_subscr(mp_obj_t self_in, mp_obj_t index_in, mp_obj
                 // Read slice.
                 size_t len = slice.stop - slice.start;
                 uint8_t *items = m_new(uint8_t, len);
-                common_hal_nvm_bytearray_get_bytes(self, slice.start, len, items);
+                nvm_bytearray_get_bytes(self, slice.start, len, items);
                 return mp_obj_new_bytearray_by_ref(len, items);
             }
         #endif
@@ -122,7 +139,7 @@ static mp_obj_t nvm_bytearray_subscr(mp_obj_t self_in, mp_obj_t index_in, mp_obj
             if (value == MP_OBJ_SENTINEL) {
                 // load
                 uint8_t value_out;
-                common_hal_nvm_bytearray_get_bytes(self, index, 1, &value_out);
+                nvm_bytearray_get_bytes(self, index, 1, &value_out);
                 return MP_OBJ_NEW_SMALL_INT(value_out);
             } else {
                 // store
@@ -130,7 +147,7 @@ static mp_obj_t nvm_bytearray_subscr(mp_obj_t self_in, mp_obj_t index_in, mp_obj
                 mp_arg_validate_int_range(byte_value, 0, 255, MP_QSTR_bytes);
 
                 uint8_t short_value = byte_value;
-                if (!common_hal_nvm_bytearray_set_bytes(self, index, &short_value, 1)) {
+                if (!nvm_bytearray_set_bytes(self, index, &short_value, 1)) {
                     mp_raise_RuntimeError(MP_ERROR_TEXT("Unable to write to nvm."));
                 }
                 return mp_const_none;
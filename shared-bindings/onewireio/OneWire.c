@@ -120,6 +120,67 @@ static mp_obj_t onewireio_onewire_obj_write_bit(mp_obj_t self_in, mp_obj_t bool_
 }
 MP_DEFINE_CONST_FUN_OBJ_2(onewireio_onewire_write_bit_obj, onewireio_onewire_obj_write_bit);
 
+//|     def write(self, buffer: ReadableBuffer) -> None:
+//|         """Write out the bytes in buffer, least significant bit first."""
+//|         ...
+//|
+static mp_obj_t onewireio_onewire_obj_write(mp_obj_t self_in, mp_obj_t buffer_obj) {
+    onewireio_onewire_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_obj, &bufinfo, MP_BUFFER_READ);
+    common_hal_onewireio_onewire_write(self, bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(onewireio_onewire_write_obj, onewireio_onewire_obj_write);
+
+//|     def readinto(self, buffer: WriteableBuffer) -> None:
+//|         """Read enough bytes to fill buffer, least significant bit first."""
+//|         ...
+//|
+static mp_obj_t onewireio_onewire_obj_readinto(mp_obj_t self_in, mp_obj_t buffer_obj) {
+    onewireio_onewire_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_obj, &bufinfo, MP_BUFFER_WRITE);
+    common_hal_onewireio_onewire_readinto(self, bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(onewireio_onewire_readinto_obj, onewireio_onewire_obj_readinto);
+
+//|     def search(self, command: int = 0xF0) -> List[bytes]:
+//|         """Find the ROM codes of the devices on the bus.
+//|
+//|         :param int command: the search command to send, 0xF0 to find every device or
+//|           0xEC to only find devices with an alarm set
+//|         :returns: the 8 byte ROM code of each device found
+//|         :rtype: List[bytes]"""
+//|         ...
+//|
+static mp_obj_t onewireio_onewire_obj_search(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_command };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_command, MP_ARG_INT, {.u_int = 0xf0} },
+    };
+    onewireio_onewire_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    check_for_deinit(self);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    uint8_t command = (uint8_t)mp_arg_validate_int_range(args[ARG_command].u_int, 0, 0xff, MP_QSTR_command);
+
+    mp_obj_t roms = mp_obj_new_list(0, NULL);
+    uint8_t rom[8] = {0};
+    int last_discrepancy = 64;
+    while (last_discrepancy >= 0 &&
+           common_hal_onewireio_onewire_search(self, command, rom, &last_discrepancy)) {
+        mp_obj_list_append(roms, mp_obj_new_bytes(rom, sizeof(rom)));
+    }
+    return roms;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(onewireio_onewire_search_obj, 1, onewireio_onewire_obj_search);
+
 static const mp_rom_map_elem_t onewireio_onewire_locals_dict_table[] = {
     // Methods
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&onewireio_onewire_deinit_obj) },
@@ -128,6 +189,9 @@ static const mp_rom_map_elem_t onewireio_onewire_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&onewireio_onewire_reset_obj) },
     { MP_ROM_QSTR(MP_QSTR_read_bit), MP_ROM_PTR(&onewireio_onewire_read_bit_obj) },
     { MP_ROM_QSTR(MP_QSTR_write_bit), MP_ROM_PTR(&onewireio_onewire_write_bit_obj) },
+    { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&onewireio_onewire_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&onewireio_onewire_readinto_obj) },
+    { MP_ROM_QSTR(MP_QSTR_search), MP_ROM_PTR(&onewireio_onewire_search_obj) },
 };
 static MP_DEFINE_CONST_DICT(onewireio_onewire_locals_dict, onewireio_onewire_locals_dict_table);
 
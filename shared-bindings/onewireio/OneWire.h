@@ -18,3 +18,6 @@ extern bool common_hal_onewireio_onewire_deinited(onewireio_onewire_obj_t *self)
 extern bool common_hal_onewireio_onewire_reset(onewireio_onewire_obj_t *self);
 extern bool common_hal_onewireio_onewire_read_bit(onewireio_onewire_obj_t *self);
 extern void common_hal_onewireio_onewire_write_bit(onewireio_onewire_obj_t *self, bool bit);
+extern void common_hal_onewireio_onewire_write(onewireio_onewire_obj_t *self, const uint8_t *data, size_t len);
+extern void common_hal_onewireio_onewire_readinto(onewireio_onewire_obj_t *self, uint8_t *data, size_t len);
+extern bool common_hal_onewireio_onewire_search(onewireio_onewire_obj_t *self, uint8_t command, uint8_t rom[8], int *last_discrepancy);
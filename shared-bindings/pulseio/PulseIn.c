@@ -169,6 +169,43 @@ static mp_obj_t pulseio_pulsein_obj_popleft(mp_obj_t self_in) {
 }
 MP_DEFINE_CONST_FUN_OBJ_1(pulseio_pulsein_popleft_obj, pulseio_pulsein_obj_popleft);
 
+//|     def readinto(self, buffer: WriteableBuffer) -> int:
+//|         """Removes the oldest pulse durations and stores them in ``buffer``,
+//|         which must be an array of type ``'H'``. Returns the number stored.
+//|
+//|         Stops early after a duration of 65535, which marks an idle period
+//|         too long to measure and so the end of a transmission. A single call
+//|         therefore returns at most one transmission, such as one button press
+//|         from an IR remote, however many have been captured. Reading a long
+//|         pulse train this way takes one call instead of one `popleft` per
+//|         pulse.
+//|
+//|         :param WriteableBuffer buffer: where to store the pulse durations in microseconds"""
+//|         ...
+static mp_obj_t pulseio_pulsein_obj_readinto(mp_obj_t self_in, mp_obj_t buffer_in) {
+    pulseio_pulsein_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer_in, &bufinfo, MP_BUFFER_WRITE);
+    if (bufinfo.typecode != 'H') {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("%q must be array of type 'H'"), MP_QSTR_buffer);
+    }
+    uint16_t *buffer = bufinfo.buf;
+    size_t len = bufinfo.len / sizeof(uint16_t);
+
+    size_t count = 0;
+    while (count < len && common_hal_pulseio_pulsein_get_len(self) > 0) {
+        uint16_t duration = common_hal_pulseio_pulsein_popleft(self);
+        buffer[count++] = duration;
+        if (duration == 0xffff) {
+            break;
+        }
+    }
+    return MP_OBJ_NEW_SMALL_INT(count);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(pulseio_pulsein_readinto_obj, pulseio_pulsein_obj_readinto);
+
 //|     maxlen: int
 //|     """The maximum length of the PulseIn. When len() is equal to maxlen,
 //|     it is unclear which pulses are active and which are idle."""
@@ -262,6 +299,7 @@ static const mp_rom_map_elem_t pulseio_pulsein_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_resume), MP_ROM_PTR(&pulseio_pulsein_resume_obj) },
     { MP_ROM_QSTR(MP_QSTR_clear), MP_ROM_PTR(&pulseio_pulsein_clear_obj) },
     { MP_ROM_QSTR(MP_QSTR_popleft), MP_ROM_PTR(&pulseio_pulsein_popleft_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&pulseio_pulsein_readinto_obj) },
 
     // Properties
     { MP_ROM_QSTR(MP_QSTR_maxlen), MP_ROM_PTR(&pulseio_pulsein_maxlen_obj) },
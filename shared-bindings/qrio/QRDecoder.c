@@ -13,25 +13,32 @@
 #include "py/enum.h"
 
 //| class QRDecoder:
-//|     def __init__(self, width: int, height: int) -> None:
+//|     def __init__(self, width: int, height: int, *, track: bool = False) -> None:
 //|         """Construct a QRDecoder object
 //|
 //|         :param int width: The pixel width of the image to decode
 //|         :param int height: The pixel height of the image to decode
+//|         :param bool track: After codes are found, look for them in the following
+//|             frames only in a padded region around their last position, at half
+//|             resolution when the codes are large enough. The whole frame is scanned
+//|             again whenever nothing is found in that region, and periodically to
+//|             pick up new codes. This uses extra memory for a second, quarter-size
+//|             decoder image.
 //|         """
 //|         ...
 
 static mp_obj_t qrio_qrdecoder_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args_in) {
-    enum { ARG_width, ARG_height };
+    enum { ARG_width, ARG_height, ARG_track };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_width, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
         { MP_QSTR_height, MP_ARG_INT | MP_ARG_REQUIRED, {.u_int = 0} },
+        { MP_QSTR_track, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all_kw_array(n_args, n_kw, args_in, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
     qrio_qrdecoder_obj_t *self = mp_obj_malloc(qrio_qrdecoder_obj_t, &qrio_qrdecoder_type_obj);
-    shared_module_qrio_qrdecoder_construct(self, args[ARG_width].u_int, args[ARG_height].u_int);
+    shared_module_qrio_qrdecoder_construct(self, args[ARG_width].u_int, args[ARG_height].u_int, args[ARG_track].u_bool);
 
     return self;
 }
@@ -310,9 +310,33 @@ MP_PROPERTY_GETSET(rgbmatrix_rgbmatrix_brightness_obj,
     (mp_obj_t)&rgbmatrix_rgbmatrix_get_brightness_obj,
     (mp_obj_t)&rgbmatrix_rgbmatrix_set_brightness_obj);
 
+//|     background_refresh: bool
+//|     """When True, `refresh` only queues the conversion of the framebuffer
+//|     into the matrix's bitplanes and returns. The conversion runs with the
+//|     other background tasks, and several refreshes before then only convert
+//|     once. Setting it to False does any queued conversion right away."""
+static mp_obj_t rgbmatrix_rgbmatrix_get_background_refresh(mp_obj_t self_in) {
+    rgbmatrix_rgbmatrix_obj_t *self = (rgbmatrix_rgbmatrix_obj_t *)self_in;
+    check_for_deinit(self);
+    return mp_obj_new_bool(common_hal_rgbmatrix_rgbmatrix_get_background_refresh(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(rgbmatrix_rgbmatrix_get_background_refresh_obj, rgbmatrix_rgbmatrix_get_background_refresh);
+
+static mp_obj_t rgbmatrix_rgbmatrix_set_background_refresh(mp_obj_t self_in, mp_obj_t value_in) {
+    rgbmatrix_rgbmatrix_obj_t *self = (rgbmatrix_rgbmatrix_obj_t *)self_in;
+    check_for_deinit(self);
+    common_hal_rgbmatrix_rgbmatrix_set_background_refresh(self, mp_obj_is_true(value_in));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(rgbmatrix_rgbmatrix_set_background_refresh_obj, rgbmatrix_rgbmatrix_set_background_refresh);
+
+MP_PROPERTY_GETSET(rgbmatrix_rgbmatrix_background_refresh_obj,
+    (mp_obj_t)&rgbmatrix_rgbmatrix_get_background_refresh_obj,
+    (mp_obj_t)&rgbmatrix_rgbmatrix_set_background_refresh_obj);
+
 //|     def refresh(self) -> None:
 //|         """Transmits the color data in the buffer to the pixels so that
-//|         they are shown."""
+//|         they are shown. See `background_refresh`."""
 //|         ...
 static mp_obj_t rgbmatrix_rgbmatrix_refresh(mp_obj_t self_in) {
     rgbmatrix_rgbmatrix_obj_t *self = (rgbmatrix_rgbmatrix_obj_t *)self_in;
@@ -349,6 +373,7 @@ MP_PROPERTY_GETTER(rgbmatrix_rgbmatrix_height_obj,
 static const mp_rom_map_elem_t rgbmatrix_rgbmatrix_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&rgbmatrix_rgbmatrix_deinit_obj) },
     { MP_ROM_QSTR(MP_QSTR_brightness), MP_ROM_PTR(&rgbmatrix_rgbmatrix_brightness_obj) },
+    { MP_ROM_QSTR(MP_QSTR_background_refresh), MP_ROM_PTR(&rgbmatrix_rgbmatrix_background_refresh_obj) },
     { MP_ROM_QSTR(MP_QSTR_refresh), MP_ROM_PTR(&rgbmatrix_rgbmatrix_refresh_obj) },
     { MP_ROM_QSTR(MP_QSTR_width), MP_ROM_PTR(&rgbmatrix_rgbmatrix_width_obj) },
     { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&rgbmatrix_rgbmatrix_height_obj) },
@@ -362,8 +387,7 @@ static void rgbmatrix_rgbmatrix_get_bufinfo(mp_obj_t self_in, mp_buffer_info_t *
 // These version exists so that the prototype matches the protocol,
 // avoiding a type cast that can hide errors
 static void rgbmatrix_rgbmatrix_swapbuffers(mp_obj_t self_in, uint8_t *dirty_row_bitmap) {
-    (void)dirty_row_bitmap;
-    common_hal_rgbmatrix_rgbmatrix_refresh(self_in);
+    common_hal_rgbmatrix_rgbmatrix_refresh_rows(self_in, dirty_row_bitmap);
 }
 
 static void rgbmatrix_rgbmatrix_deinit_proto(mp_obj_t self_in) {
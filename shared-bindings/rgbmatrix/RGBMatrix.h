@@ -19,5 +19,8 @@ void common_hal_rgbmatrix_rgbmatrix_reconstruct(rgbmatrix_rgbmatrix_obj_t *self)
 void common_hal_rgbmatrix_rgbmatrix_set_paused(rgbmatrix_rgbmatrix_obj_t *self, bool paused);
 bool common_hal_rgbmatrix_rgbmatrix_get_paused(rgbmatrix_rgbmatrix_obj_t *self);
 void common_hal_rgbmatrix_rgbmatrix_refresh(rgbmatrix_rgbmatrix_obj_t *self);
+void common_hal_rgbmatrix_rgbmatrix_refresh_rows(rgbmatrix_rgbmatrix_obj_t *self, const uint8_t *dirty_row_bitmap);
+void common_hal_rgbmatrix_rgbmatrix_set_background_refresh(rgbmatrix_rgbmatrix_obj_t *self, bool background_refresh);
+bool common_hal_rgbmatrix_rgbmatrix_get_background_refresh(rgbmatrix_rgbmatrix_obj_t *self);
 int common_hal_rgbmatrix_rgbmatrix_get_width(rgbmatrix_rgbmatrix_obj_t *self);
 int common_hal_rgbmatrix_rgbmatrix_get_height(rgbmatrix_rgbmatrix_obj_t *self);
@@ -149,6 +149,26 @@ MP_PROPERTY_GETSET(rotaryio_incrementalencoder_position_obj,
     (mp_obj_t)&rotaryio_incrementalencoder_get_position_obj,
     (mp_obj_t)&rotaryio_incrementalencoder_set_position_obj);
 
+//|     velocity: float
+//|     """The speed in `position` counts per second, negative when `position` is decreasing,
+//|     estimated from the time between the most recent changes of `position`. It falls
+//|     towards 0 when no change comes, and is 0 after a second without one.
+//|
+//|     Where the port counts pulses in hardware, the changes are timed when `position` or
+//|     `velocity` is read, so reading it regularly, as a control loop would, gives the best
+//|     estimate. (read-only)"""
+//|
+static mp_obj_t rotaryio_incrementalencoder_obj_get_velocity(mp_obj_t self_in) {
+    rotaryio_incrementalencoder_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+
+    return mp_obj_new_float(common_hal_rotaryio_incrementalencoder_get_velocity(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(rotaryio_incrementalencoder_get_velocity_obj, rotaryio_incrementalencoder_obj_get_velocity);
+
+MP_PROPERTY_GETTER(rotaryio_incrementalencoder_velocity_obj,
+    (mp_obj_t)&rotaryio_incrementalencoder_get_velocity_obj);
+
 static const mp_rom_map_elem_t rotaryio_incrementalencoder_locals_dict_table[] = {
     // Methods
     { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&rotaryio_incrementalencoder_deinit_obj) },
@@ -157,6 +177,7 @@ static const mp_rom_map_elem_t rotaryio_incrementalencoder_locals_dict_table[] =
     { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&rotaryio_incrementalencoder___exit___obj) },
     { MP_ROM_QSTR(MP_QSTR_position), MP_ROM_PTR(&rotaryio_incrementalencoder_position_obj) },
     { MP_ROM_QSTR(MP_QSTR_divisor), MP_ROM_PTR(&rotaryio_incrementalencoder_divisor_obj) },
+    { MP_ROM_QSTR(MP_QSTR_velocity), MP_ROM_PTR(&rotaryio_incrementalencoder_velocity_obj) },
 };
 static MP_DEFINE_CONST_DICT(rotaryio_incrementalencoder_locals_dict, rotaryio_incrementalencoder_locals_dict_table);
 
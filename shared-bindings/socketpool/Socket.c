@@ -7,6 +7,7 @@
 
 #include "shared-bindings/socketpool/Socket.h"
 
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -18,6 +19,7 @@
 #include "py/stream.h"
 
 #include "shared/netutils/netutils.h"
+#include "shared/runtime/buffer_helper.h"
 #include "shared/runtime/context_manager_helpers.h"
 #include "shared/runtime/interrupt_char.h"
 
@@ -214,14 +216,30 @@ static mp_obj_t _socketpool_socket_recv_into(size_t n_args, const mp_obj_t *args
 }
 static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(socketpool_socket_recv_into_obj, 2, 3, _socketpool_socket_recv_into);
 
-//|     def send(self, bytes: ReadableBuffer) -> int:
+//|     import sys
+//|     def send(self, bytes: ReadableBuffer, *, start: int = 0, end: int = sys.maxsize) -> int:
 //|         """Send some bytes to the connected remote address.
 //|         Suits sockets of type SOCK_STREAM
 //|
-//|         :param ~bytes bytes: some bytes to send"""
+//|         If ``start`` or ``end`` is provided, then the buffer will be sliced
+//|         as if ``bytes[start:end]`` were passed, but without copying the data.
+//|
+//|         :param ~bytes bytes: some bytes to send
+//|         :param int start: beginning of buffer slice
+//|         :param int end: end of buffer slice; if not specified, use ``len(bytes)``"""
 //|         ...
-static mp_obj_t _socketpool_socket_send(mp_obj_t self_in, mp_obj_t buf_in) {
-    socketpool_socket_obj_t *self = MP_OBJ_TO_PTR(self_in);
+static const mp_arg_t socketpool_socket_send_args[] = {
+    { MP_QSTR_bytes, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+    { MP_QSTR_start, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+    { MP_QSTR_end, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = INT_MAX} },
+};
+
+static mp_obj_t _socketpool_socket_send(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_bytes, ARG_start, ARG_end };
+    socketpool_socket_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(socketpool_socket_send_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(socketpool_socket_send_args), socketpool_socket_send_args, args);
+
     if (common_hal_socketpool_socket_get_closed(self)) {
         // Bad file number.
         mp_raise_OSError(MP_EBADF);
@@ -230,16 +248,16 @@ static mp_obj_t _socketpool_socket_send(mp_obj_t self_in, mp_obj_t buf_in) {
         mp_raise_BrokenPipeError();
     }
     mp_buffer_info_t bufinfo;
-    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_READ);
+    get_buffer_slice_raise(args[ARG_bytes].u_obj, &bufinfo, MP_BUFFER_READ, args[ARG_start].u_int, args[ARG_end].u_int);
     mp_int_t ret = common_hal_socketpool_socket_send(self, bufinfo.buf, bufinfo.len);
     if (ret == -1) {
         mp_raise_BrokenPipeError();
     }
     return mp_obj_new_int_from_uint(ret);
 }
-static MP_DEFINE_CONST_FUN_OBJ_2(socketpool_socket_send_obj, _socketpool_socket_send);
+static MP_DEFINE_CONST_FUN_OBJ_KW(socketpool_socket_send_obj, 1, _socketpool_socket_send);
 
-//|     def sendall(self, bytes: ReadableBuffer) -> None:
+//|     def sendall(self, bytes: ReadableBuffer, *, start: int = 0, end: int = sys.maxsize) -> None:
 //|         """Send some bytes to the connected remote address.
 //|         Suits sockets of type SOCK_STREAM
 //|
@@ -247,10 +265,16 @@ static MP_DEFINE_CONST_FUN_OBJ_2(socketpool_socket_send_obj, _socketpool_socket_
 //|         occurs. If an error occurs, it's impossible to tell how much data
 //|         has been sent.
 //|
-//|         :param ~bytes bytes: some bytes to send"""
+//|         :param ~bytes bytes: some bytes to send
+//|         :param int start: beginning of buffer slice
+//|         :param int end: end of buffer slice; if not specified, use ``len(bytes)``"""
 //|         ...
-static mp_obj_t _socketpool_socket_sendall(mp_obj_t self_in, mp_obj_t buf_in) {
-    socketpool_socket_obj_t *self = MP_OBJ_TO_PTR(self_in);
+static mp_obj_t _socketpool_socket_sendall(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_bytes, ARG_start, ARG_end };
+    socketpool_socket_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(socketpool_socket_send_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(socketpool_socket_send_args), socketpool_socket_send_args, args);
+
     if (common_hal_socketpool_socket_get_closed(self)) {
         // Bad file number.
         mp_raise_OSError(MP_EBADF);
@@ -259,7 +283,7 @@ static mp_obj_t _socketpool_socket_sendall(mp_obj_t self_in, mp_obj_t buf_in) {
         mp_raise_BrokenPipeError();
     }
     mp_buffer_info_t bufinfo;
-    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_READ);
+    get_buffer_slice_raise(args[ARG_bytes].u_obj, &bufinfo, MP_BUFFER_READ, args[ARG_start].u_int, args[ARG_end].u_int);
     while (bufinfo.len > 0) {
         mp_int_t ret = common_hal_socketpool_socket_send(self, bufinfo.buf, bufinfo.len);
         if (ret == -1) {
@@ -277,24 +301,35 @@ static mp_obj_t _socketpool_socket_sendall(mp_obj_t self_in, mp_obj_t buf_in) {
     }
     return mp_const_none;
 }
-static MP_DEFINE_CONST_FUN_OBJ_2(socketpool_socket_sendall_obj, _socketpool_socket_sendall);
+static MP_DEFINE_CONST_FUN_OBJ_KW(socketpool_socket_sendall_obj, 1, _socketpool_socket_sendall);
 
-//|     def sendto(self, bytes: ReadableBuffer, address: Tuple[str, int]) -> int:
+//|     def sendto(self, bytes: ReadableBuffer, address: Tuple[str, int], *, start: int = 0, end: int = sys.maxsize) -> int:
 //|         """Send some bytes to a specific address.
 //|         Suits sockets of type SOCK_DGRAM
 //|
 //|         :param ~bytes bytes: some bytes to send
-//|         :param ~tuple address: tuple of (remote_address, remote_port)"""
+//|         :param ~tuple address: tuple of (remote_address, remote_port)
+//|         :param int start: beginning of buffer slice
+//|         :param int end: end of buffer slice; if not specified, use ``len(bytes)``"""
 //|         ...
-static mp_obj_t socketpool_socket_sendto(mp_obj_t self_in, mp_obj_t data_in, mp_obj_t addr_in) {
-    socketpool_socket_obj_t *self = MP_OBJ_TO_PTR(self_in);
+static mp_obj_t socketpool_socket_sendto(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_bytes, ARG_address, ARG_start, ARG_end };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_bytes, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_address, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_start, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_end, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = INT_MAX} },
+    };
+    socketpool_socket_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
     // get the data
     mp_buffer_info_t bufinfo;
-    mp_get_buffer_raise(data_in, &bufinfo, MP_BUFFER_READ);
+    get_buffer_slice_raise(args[ARG_bytes].u_obj, &bufinfo, MP_BUFFER_READ, args[ARG_start].u_int, args[ARG_end].u_int);
 
     mp_obj_t *addr_items;
-    mp_obj_get_array_fixed_n(addr_in, 2, &addr_items);
+    mp_obj_get_array_fixed_n(args[ARG_address].u_obj, 2, &addr_items);
 
     size_t hostlen;
     const char *host = mp_obj_str_get_data(addr_items[0], &hostlen);
@@ -307,7 +342,7 @@ static mp_obj_t socketpool_socket_sendto(mp_obj_t self_in, mp_obj_t data_in, mp_
 
     return mp_obj_new_int_from_uint(ret);
 }
-static MP_DEFINE_CONST_FUN_OBJ_3(socketpool_socket_sendto_obj, socketpool_socket_sendto);
+static MP_DEFINE_CONST_FUN_OBJ_KW(socketpool_socket_sendto_obj, 1, socketpool_socket_sendto);
 
 //|     def setblocking(self, flag: bool) -> Optional[int]:
 //|         """Set the blocking behaviour of this socket.
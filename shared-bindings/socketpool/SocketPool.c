@@ -15,6 +15,7 @@
 #include "shared-bindings/ipaddress/__init__.h"
 #include "shared-bindings/socketpool/Socket.h"
 #include "shared-bindings/socketpool/SocketPool.h"
+#include "shared-module/socketpool/SocketPool.h"
 
 //| class SocketPool:
 //|     """A pool of socket resources available for the given radio. Only one
@@ -124,7 +125,12 @@ MP_DEFINE_CONST_FUN_OBJ_KW(socketpool_socketpool_socket_obj, 1, socketpool_socke
 //|
 //|         Returns the appropriate family, socket type, socket protocol and
 //|         address information to call socket.socket() and socket.connect() with,
-//|         as a tuple."""
+//|         as a tuple.
+//|
+//|         The addresses of the last few host names are kept for up to a minute,
+//|         even across reloads, so repeated lookups don't go out to the network.
+//|         If a lookup fails after that, the last address found for the name is
+//|         returned. Use `clear_dns_cache` to forget them."""
 //|         ...
 //|
 static mp_obj_t socketpool_socketpool_getaddrinfo(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
@@ -151,7 +157,7 @@ static mp_obj_t socketpool_socketpool_getaddrinfo(size_t n_args, const mp_obj_t
     }
 
     if (ip_str == mp_const_none) {
-        ip_str = common_hal_socketpool_socketpool_gethostbyname_raise(self, host);
+        ip_str = socketpool_socketpool_gethostbyname_cached(self, host);
     }
 
     mp_obj_tuple_t *tuple = MP_OBJ_TO_PTR(mp_obj_new_tuple(5, NULL));
@@ -167,9 +173,29 @@ static mp_obj_t socketpool_socketpool_getaddrinfo(size_t n_args, const mp_obj_t
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(socketpool_socketpool_getaddrinfo_obj, 1, socketpool_socketpool_getaddrinfo);
 
+//|     def clear_dns_cache(self, host: Optional[str] = None) -> None:
+//|         """Forget the address remembered by `getaddrinfo` for ``host``, or
+//|         for every host name when none is given. The next lookup goes out to
+//|         the network.
+//|
+//|         :param str host: the host name to forget
+//|         """
+//|         ...
+//|
+static mp_obj_t socketpool_socketpool_obj_clear_dns_cache(size_t n_args, const mp_obj_t *args) {
+    const char *host = NULL;
+    if (n_args > 1 && args[1] != mp_const_none) {
+        host = mp_obj_str_get_str(args[1]);
+    }
+    socketpool_socketpool_clear_dns_cache(host);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(socketpool_socketpool_clear_dns_cache_obj, 1, 2, socketpool_socketpool_obj_clear_dns_cache);
+
 static const mp_rom_map_elem_t socketpool_socketpool_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_socket), MP_ROM_PTR(&socketpool_socketpool_socket_obj) },
     { MP_ROM_QSTR(MP_QSTR_getaddrinfo), MP_ROM_PTR(&socketpool_socketpool_getaddrinfo_obj) },
+    { MP_ROM_QSTR(MP_QSTR_clear_dns_cache), MP_ROM_PTR(&socketpool_socketpool_clear_dns_cache_obj) },
     { MP_ROM_QSTR(MP_QSTR_gaierror), MP_ROM_PTR(&mp_type_gaierror) },
 
     // class constants
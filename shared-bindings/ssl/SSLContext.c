@@ -156,7 +156,13 @@ MP_PROPERTY_GETSET(ssl_sslcontext_check_hostname_obj,
 //|         server_hostname: Optional[str] = None
 //|     ) -> ssl.SSLSocket:
 //|         """Wraps the socket into a socket-compatible class that handles SSL negotiation.
-//|         The socket must be of type SOCK_STREAM."""
+//|         The socket must be of type SOCK_STREAM.
+//|
+//|         When ``server_hostname`` is given, the negotiated session is remembered
+//|         by this context and offered again on the next connection to the same
+//|         hostname, letting the server skip the full handshake. The remembered
+//|         sessions are discarded when the certificates or verify locations of
+//|         the context change."""
 //|
 
 static mp_obj_t ssl_sslcontext_wrap_socket(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
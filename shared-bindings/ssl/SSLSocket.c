@@ -6,9 +6,11 @@
 
 #include "shared-bindings/ssl/SSLSocket.h"
 
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
 
+#include "shared/runtime/buffer_helper.h"
 #include "shared/runtime/context_manager_helpers.h"
 #include "py/objtuple.h"
 #include "py/objlist.h"
@@ -155,14 +157,29 @@ static mp_obj_t ssl_sslsocket_recv_into(size_t n_args, const mp_obj_t *args) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(ssl_sslsocket_recv_into_obj, 2, 3, ssl_sslsocket_recv_into);
 
-//|     def send(self, bytes: ReadableBuffer) -> int:
+//|     import sys
+//|     def send(self, bytes: ReadableBuffer, *, start: int = 0, end: int = sys.maxsize) -> int:
 //|         """Send some bytes to the connected remote address.
 //|         Suits sockets of type SOCK_STREAM
 //|
-//|         :param ~bytes bytes: some bytes to send"""
+//|         If ``start`` or ``end`` is provided, then the buffer will be sliced
+//|         as if ``bytes[start:end]`` were passed, but without copying the data.
+//|
+//|         :param ~bytes bytes: some bytes to send
+//|         :param int start: beginning of buffer slice
+//|         :param int end: end of buffer slice; if not specified, use ``len(bytes)``"""
 //|         ...
-static mp_obj_t ssl_sslsocket_send(mp_obj_t self_in, mp_obj_t buf_in) {
-    ssl_sslsocket_obj_t *self = MP_OBJ_TO_PTR(self_in);
+static mp_obj_t ssl_sslsocket_send(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_bytes, ARG_start, ARG_end };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_bytes, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_start, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_end, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = INT_MAX} },
+    };
+    ssl_sslsocket_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
     if (common_hal_ssl_sslsocket_get_closed(self)) {
         // Bad file number.
         mp_raise_OSError(MP_EBADF);
@@ -171,14 +188,14 @@ static mp_obj_t ssl_sslsocket_send(mp_obj_t self_in, mp_obj_t buf_in) {
         mp_raise_BrokenPipeError();
     }
     mp_buffer_info_t bufinfo;
-    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_READ);
+    get_buffer_slice_raise(args[ARG_bytes].u_obj, &bufinfo, MP_BUFFER_READ, args[ARG_start].u_int, args[ARG_end].u_int);
     mp_int_t ret = common_hal_ssl_sslsocket_send(self, bufinfo.buf, bufinfo.len);
     if (ret == -1) {
         mp_raise_BrokenPipeError();
     }
     return mp_obj_new_int_from_uint(ret);
 }
-static MP_DEFINE_CONST_FUN_OBJ_2(ssl_sslsocket_send_obj, ssl_sslsocket_send);
+static MP_DEFINE_CONST_FUN_OBJ_KW(ssl_sslsocket_send_obj, 1, ssl_sslsocket_send);
 
 // //|     def setsockopt(self, level: int, optname: int, value: int | ReadableBuffer) -> None:
 // //|         """Sets socket options"""
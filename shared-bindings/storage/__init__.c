@@ -219,6 +219,46 @@ static mp_obj_t storage_enable_usb_drive(void) {
 }
 MP_DEFINE_CONST_FUN_OBJ_0(storage_enable_usb_drive_obj, storage_enable_usb_drive);
 
+#if CIRCUITPY_STORAGE_MMAP
+//| def mmap(file: io.FileIO, *, typecode: str = "B") -> memoryview:
+//|     """Return a read-only view of the contents of ``file`` where they are stored,
+//|     without copying them into RAM.
+//|
+//|     The view can be given to anything that takes a `ReadableBuffer`, such as
+//|     `audiocore.RawSample` or a `synthio` waveform, which then read the data straight
+//|     from flash. It stays valid after ``file`` is closed.
+//|
+//|     This only works for a file that is open for reading only, is on the ``CIRCUITPY``
+//|     drive of a board whose flash is memory mapped, and is stored in one contiguous
+//|     run. Files copied onto a freshly erased or defragmented drive usually are.
+//|
+//|     The view reflects the flash as it is now. If the file is changed or deleted,
+//|     for example from the host over USB, its contents change underneath the view.
+//|
+//|     :param io.FileIO file: The open file
+//|     :param str typecode: The type of the view's elements, as in `array.array`.
+//|       Use ``"h"`` for signed 16-bit samples. Any bytes past the last whole element are left out.
+//|     """
+//|     ...
+//|
+static mp_obj_t storage_mmap(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_file, ARG_typecode };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_file, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_typecode, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_QSTR(MP_QSTR_B)} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    size_t typecode_len;
+    const char *typecode = mp_obj_str_get_data(args[ARG_typecode].u_obj, &typecode_len);
+    mp_arg_validate_length(typecode_len, 1, MP_QSTR_typecode);
+
+    return common_hal_storage_mmap(args[ARG_file].u_obj, typecode[0]);
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(storage_mmap_obj, 1, storage_mmap);
+#endif
+
 static const mp_rom_map_elem_t storage_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_storage) },
 
@@ -229,6 +269,9 @@ static const mp_rom_map_elem_t storage_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_erase_filesystem),  MP_ROM_PTR(&storage_erase_filesystem_obj) },
     { MP_ROM_QSTR(MP_QSTR_disable_usb_drive), MP_ROM_PTR(&storage_disable_usb_drive_obj) },
     { MP_ROM_QSTR(MP_QSTR_enable_usb_drive),  MP_ROM_PTR(&storage_enable_usb_drive_obj) },
+    #if CIRCUITPY_STORAGE_MMAP
+    { MP_ROM_QSTR(MP_QSTR_mmap),              MP_ROM_PTR(&storage_mmap_obj) },
+    #endif
 
 //| class VfsFat:
 //|     def __init__(self, block_device: BlockDevice) -> None:
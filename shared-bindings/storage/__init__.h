@@ -17,6 +17,9 @@ void common_hal_storage_umount_object(mp_obj_t vfs_obj);
 void common_hal_storage_remount(const char *path, bool readonly, bool disable_concurrent_write_protection);
 mp_obj_t common_hal_storage_getmount(const char *path);
 void common_hal_storage_erase_filesystem(bool extended);
+#if CIRCUITPY_STORAGE_MMAP
+mp_obj_t common_hal_storage_mmap(mp_obj_t file, char typecode);
+#endif
 
 bool common_hal_storage_disable_usb_drive(void);
 bool common_hal_storage_enable_usb_drive(void);
@@ -11,11 +11,12 @@
 
 #include "py/runtime.h"
 #include "py/builtin.h"
+#include "py/objlist.h"
+#include "py/objproperty.h"
 #include "py/objtuple.h"
 #include "py/binary.h"
 #include "py/parsenum.h"
 #include "shared-bindings/struct/__init__.h"
-#include "shared-module/struct/__init__.h"
 
 //| """Manipulation of c-style data
 //|
@@ -28,14 +29,72 @@
 //|
 
 
+static mp_obj_t struct_pack_helper(struct_struct_obj_t *self, size_t n_args, const mp_obj_t *args) {
+    mp_int_t size = shared_modules_struct_calcsize(self);
+    vstr_t vstr;
+    vstr_init_len(&vstr, size);
+    byte *p = (byte *)vstr.buf;
+    memset(p, 0, size);
+    byte *end_p = &p[size];
+    shared_modules_struct_pack_into(self, p, end_p, n_args, args);
+    return mp_obj_new_bytes_from_vstr(&vstr);
+}
+
+static void struct_pack_into_helper(struct_struct_obj_t *self, mp_obj_t buffer, mp_obj_t offset_in, size_t n_args, const mp_obj_t *args) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_WRITE);
+    mp_int_t offset = mp_obj_get_int(offset_in);
+    if (offset < 0) {
+        // negative offsets are relative to the end of the buffer
+        offset = (mp_int_t)bufinfo.len + offset;
+        if (offset < 0) {
+            mp_raise_RuntimeError(MP_ERROR_TEXT("Buffer too small"));
+        }
+    }
+    byte *p = (byte *)bufinfo.buf;
+    byte *end_p = &p[bufinfo.len];
+    p += offset;
+
+    shared_modules_struct_pack_into(self, p, end_p, n_args, args);
+}
+
+// With exact_size, the buffer must be exactly the size of the format.
+// Otherwise it only has to be big enough. If into is a list, the values are
+// stored in it rather than in a new tuple.
+static mp_obj_t struct_unpack_from_helper(struct_struct_obj_t *self, mp_obj_t buffer, mp_int_t offset, bool exact_size, mp_obj_t into) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_READ);
+    byte *p = bufinfo.buf;
+    byte *end_p = &p[bufinfo.len];
+
+    if (offset < 0) {
+        // negative offsets are relative to the end of the buffer
+        offset = bufinfo.len + offset;
+        if (offset < 0) {
+            mp_raise_RuntimeError(MP_ERROR_TEXT("Buffer too small"));
+        }
+    }
+    p += offset;
+
+    mp_uint_t n_items = shared_modules_struct_get_n_items(self);
+    if (into != mp_const_none) {
+        mp_obj_list_t *list = MP_OBJ_TO_PTR(mp_arg_validate_type(into, &mp_type_list, MP_QSTR_into));
+        mp_arg_validate_length(list->len, n_items, MP_QSTR_into);
+        shared_modules_struct_unpack_from(self, p, end_p, exact_size, list->items);
+        return into;
+    }
+    mp_obj_tuple_t *res = MP_OBJ_TO_PTR(mp_obj_new_tuple(n_items, NULL));
+    shared_modules_struct_unpack_from(self, p, end_p, exact_size, res->items);
+    return MP_OBJ_FROM_PTR(res);
+}
+
 //| def calcsize(fmt: str) -> int:
 //|     """Return the number of bytes needed to store the given fmt."""
 //|     ...
 //|
 
 static mp_obj_t struct_calcsize(mp_obj_t fmt_in) {
-
-    return MP_OBJ_NEW_SMALL_INT(shared_modules_struct_calcsize(fmt_in));
+    return MP_OBJ_NEW_SMALL_INT(shared_modules_struct_calcsize(shared_modules_struct_compile(fmt_in)));
 }
 MP_DEFINE_CONST_FUN_OBJ_1(struct_calcsize_obj, struct_calcsize);
 
@@ -46,14 +105,7 @@ MP_DEFINE_CONST_FUN_OBJ_1(struct_calcsize_obj, struct_calcsize);
 //|
 
 static mp_obj_t struct_pack(size_t n_args, const mp_obj_t *args) {
-    mp_int_t size = MP_OBJ_SMALL_INT_VALUE(struct_calcsize(args[0]));
-    vstr_t vstr;
-    vstr_init_len(&vstr, size);
-    byte *p = (byte *)vstr.buf;
-    memset(p, 0, size);
-    byte *end_p = &p[size];
-    shared_modules_struct_pack_into(args[0], p, end_p, n_args - 1, &args[1]);
-    return mp_obj_new_bytes_from_vstr(&vstr);
+    return struct_pack_helper(shared_modules_struct_compile(args[0]), n_args - 1, &args[1]);
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(struct_pack_obj, 1, MP_OBJ_FUN_ARGS_MAX, struct_pack);
 
@@ -64,21 +116,7 @@ MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(struct_pack_obj, 1, MP_OBJ_FUN_ARGS_MAX, str
 //|
 
 static mp_obj_t struct_pack_into(size_t n_args, const mp_obj_t *args) {
-    mp_buffer_info_t bufinfo;
-    mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_WRITE);
-    mp_int_t offset = mp_obj_get_int(args[2]);
-    if (offset < 0) {
-        // negative offsets are relative to the end of the buffer
-        offset = (mp_int_t)bufinfo.len + offset;
-        if (offset < 0) {
-            mp_raise_RuntimeError(MP_ERROR_TEXT("Buffer too small"));
-        }
-    }
-    byte *p = (byte *)bufinfo.buf;
-    byte *end_p = &p[bufinfo.len];
-    p += offset;
-
-    shared_modules_struct_pack_into(args[0], p, end_p, n_args - 3, &args[3]);
+    struct_pack_into_helper(shared_modules_struct_compile(args[0]), args[1], args[2], n_args - 3, &args[3]);
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(struct_pack_into_obj, 3, MP_OBJ_FUN_ARGS_MAX, struct_pack_into);
@@ -91,13 +129,8 @@ MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(struct_pack_into_obj, 3, MP_OBJ_FUN_ARGS_MAX
 //|
 
 static mp_obj_t struct_unpack(size_t n_args, const mp_obj_t *args) {
-    mp_buffer_info_t bufinfo;
-    mp_get_buffer_raise(args[1], &bufinfo, MP_BUFFER_READ);
-    byte *p = bufinfo.buf;
-    byte *end_p = &p[bufinfo.len];
-
     // true means check the size must be exactly right.
-    return MP_OBJ_FROM_PTR(shared_modules_struct_unpack_from(args[0], p, end_p, true));
+    return struct_unpack_from_helper(shared_modules_struct_compile(args[0]), args[1], 0, true, mp_const_none);
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(struct_unpack_obj, 2, 3, struct_unpack);
 
@@ -120,29 +153,125 @@ static mp_obj_t struct_unpack_from(size_t n_args, const mp_obj_t *pos_args, mp_m
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
-    mp_buffer_info_t bufinfo;
-    mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_READ);
-    byte *p = bufinfo.buf;
-    byte *end_p = &p[bufinfo.len];
-
-    mp_int_t offset = args[ARG_offset].u_int;
-    if (offset < 0) {
-        // negative offsets are relative to the end of the buffer
-        offset = bufinfo.len + offset;
-        if (offset < 0) {
-            mp_raise_RuntimeError(MP_ERROR_TEXT("Buffer too small"));
-        }
-    }
-    p += offset;
-
     // false means the size doesn't have to be exact. struct.unpack_from() only requires
     // that be buffer be big enough.
-    return MP_OBJ_FROM_PTR(shared_modules_struct_unpack_from(args[ARG_format].u_obj, p, end_p, false));
+    return struct_unpack_from_helper(shared_modules_struct_compile(args[ARG_format].u_obj),
+        args[ARG_buffer].u_obj, args[ARG_offset].u_int, false, mp_const_none);
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(struct_unpack_from_obj, 0, struct_unpack_from);
 
+//| class Struct:
+//|     """A format string compiled once, for packing and unpacking the same
+//|     layout many times.
+//|
+//|     |see_cpython| :class:`cpython:struct.Struct`."""
+//|
+//|     def __init__(self, format: str) -> None:
+//|         """Compile ``format``. See the module documentation for the format codes."""
+//|         ...
+//|
+
+static mp_obj_t struct_struct_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 1, 1, false);
+    return MP_OBJ_FROM_PTR(shared_modules_struct_compile(args[0]));
+}
+
+//|     format: str
+//|     """The format string used to construct this Struct."""
+//|
+static mp_obj_t struct_struct_get_format(mp_obj_t self_in) {
+    struct_struct_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return self->format;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(struct_struct_get_format_obj, struct_struct_get_format);
+
+MP_PROPERTY_GETTER(struct_struct_format_obj,
+    (mp_obj_t)&struct_struct_get_format_obj);
+
+//|     size: int
+//|     """The number of bytes needed to store the format, the same as `calcsize`."""
+//|
+static mp_obj_t struct_struct_get_size(mp_obj_t self_in) {
+    struct_struct_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return MP_OBJ_NEW_SMALL_INT(shared_modules_struct_calcsize(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(struct_struct_get_size_obj, struct_struct_get_size);
+
+MP_PROPERTY_GETTER(struct_struct_size_obj,
+    (mp_obj_t)&struct_struct_get_size_obj);
+
+//|     def pack(self, *values: Any) -> bytes:
+//|         """Pack the values according to the format. See `struct.pack`."""
+//|         ...
+//|
+static mp_obj_t struct_struct_pack(size_t n_args, const mp_obj_t *args) {
+    return struct_pack_helper(MP_OBJ_TO_PTR(args[0]), n_args - 1, &args[1]);
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(struct_struct_pack_obj, 1, MP_OBJ_FUN_ARGS_MAX, struct_struct_pack);
+
+//|     def pack_into(self, buffer: WriteableBuffer, offset: int, *values: Any) -> None:
+//|         """Pack the values into buffer starting at offset. See `struct.pack_into`."""
+//|         ...
+//|
+static mp_obj_t struct_struct_pack_into(size_t n_args, const mp_obj_t *args) {
+    struct_pack_into_helper(MP_OBJ_TO_PTR(args[0]), args[1], args[2], n_args - 3, &args[3]);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(struct_struct_pack_into_obj, 3, MP_OBJ_FUN_ARGS_MAX, struct_struct_pack_into);
+
+//|     def unpack(self, data: ReadableBuffer) -> Tuple[Any, ...]:
+//|         """Unpack data, which must be exactly `size` bytes long. See `struct.unpack`."""
+//|         ...
+//|
+static mp_obj_t struct_struct_unpack(mp_obj_t self_in, mp_obj_t data) {
+    return struct_unpack_from_helper(MP_OBJ_TO_PTR(self_in), data, 0, true, mp_const_none);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(struct_struct_unpack_obj, struct_struct_unpack);
+
+//|     def unpack_from(self, data: ReadableBuffer, offset: int = 0, *, into: Optional[List[Any]] = None) -> Union[Tuple[Any, ...], List[Any]]:
+//|         """Unpack from data starting at offset. See `struct.unpack_from`.
+//|
+//|         If ``into`` is given, it must be a list with one entry per value.
+//|         The values are stored in it and it is returned, so no new tuple is
+//|         allocated."""
+//|         ...
+//|
+static mp_obj_t struct_struct_unpack_from(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_buffer, ARG_offset, ARG_into };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_buffer, MP_ARG_REQUIRED | MP_ARG_OBJ, {} },
+        { MP_QSTR_offset, MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_into, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+    struct_struct_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    return struct_unpack_from_helper(self, args[ARG_buffer].u_obj, args[ARG_offset].u_int, false, args[ARG_into].u_obj);
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(struct_struct_unpack_from_obj, 1, struct_struct_unpack_from);
+
+static const mp_rom_map_elem_t struct_struct_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_format), MP_ROM_PTR(&struct_struct_format_obj) },
+    { MP_ROM_QSTR(MP_QSTR_size), MP_ROM_PTR(&struct_struct_size_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pack), MP_ROM_PTR(&struct_struct_pack_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pack_into), MP_ROM_PTR(&struct_struct_pack_into_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unpack), MP_ROM_PTR(&struct_struct_unpack_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unpack_from), MP_ROM_PTR(&struct_struct_unpack_from_obj) },
+};
+static MP_DEFINE_CONST_DICT(struct_struct_locals_dict, struct_struct_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    struct_struct_type,
+    MP_QSTR_Struct,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    make_new, struct_struct_make_new,
+    locals_dict, &struct_struct_locals_dict
+    );
+
 static const mp_rom_map_elem_t mp_module_struct_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_struct) },
+    { MP_ROM_QSTR(MP_QSTR_Struct), MP_ROM_PTR(&struct_struct_type) },
     { MP_ROM_QSTR(MP_QSTR_calcsize), MP_ROM_PTR(&struct_calcsize_obj) },
     { MP_ROM_QSTR(MP_QSTR_pack), MP_ROM_PTR(&struct_pack_obj) },
     { MP_ROM_QSTR(MP_QSTR_pack_into), MP_ROM_PTR(&struct_pack_into_obj) },
@@ -6,6 +6,12 @@
 
 #pragma once
 
-void shared_modules_struct_pack_into(mp_obj_t fmt_in, byte *p, byte *end_p, size_t n_args, const mp_obj_t *args);
-mp_uint_t shared_modules_struct_calcsize(mp_obj_t fmt_in);
-mp_obj_tuple_t *shared_modules_struct_unpack_from(mp_obj_t fmt_in, byte *p, byte *end_p, bool exact_size);
+#include "shared-module/struct/__init__.h"
+
+extern const mp_obj_type_t struct_struct_type;
+
+struct_struct_obj_t *shared_modules_struct_compile(mp_obj_t fmt_in);
+mp_uint_t shared_modules_struct_calcsize(struct_struct_obj_t *self);
+mp_uint_t shared_modules_struct_get_n_items(struct_struct_obj_t *self);
+void shared_modules_struct_pack_into(struct_struct_obj_t *self, byte *p, byte *end_p, size_t n_args, const mp_obj_t *args);
+void shared_modules_struct_unpack_from(struct_struct_obj_t *self, byte *p, byte *end_p, bool exact_size, mp_obj_t *items);
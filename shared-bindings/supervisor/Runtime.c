@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: MIT
 
 #include <stdbool.h>
+#include <string.h>
 #include "py/obj.h"
 #include "py/enum.h"
 #include "py/runtime.h"
@@ -14,6 +15,9 @@
 #include "shared-bindings/supervisor/Runtime.h"
 #include "shared-bindings/supervisor/SafeModeReason.h"
 
+#include "supervisor/background_callback.h"
+#include "supervisor/port_heap.h"
+#include "supervisor/shared/boot_timing.h"
 #include "supervisor/shared/reload.h"
 #include "supervisor/shared/serial.h"
 #include "supervisor/shared/stack.h"
@@ -202,6 +206,97 @@ MP_PROPERTY_GETSET(supervisor_runtime_rgb_status_brightness_obj,
     (mp_obj_t)&supervisor_runtime_get_rgb_status_brightness_obj,
     (mp_obj_t)&supervisor_runtime_set_rgb_status_brightness_obj);
 
+#if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+//|     background_stats: Dict[int, Tuple[int, int, int, int, int]]
+//|     """Background callback statistics since the VM started, keyed by the address of the
+//|     callback function. Look addresses up in the firmware's ``.elf`` or ``.map`` file. Key
+//|     ``0`` totals functions beyond the tracking limit. Each value is ``(count, total_time,
+//|     max_time, total_latency, max_latency)`` where latency is the time from being queued to
+//|     starting to run. Times are in CPU cycles, or in 1/32768 second units on
+//|     CPUs without a cycle counter. Only available in builds with
+//|     ``CIRCUITPY_BACKGROUND_CALLBACK_STATS``. (read-only)"""
+//|
+static mp_obj_t supervisor_runtime_get_background_stats(mp_obj_t self) {
+    const background_callback_stats_t *stats;
+    size_t count = background_callback_get_stats(&stats);
+    mp_obj_t dict = mp_obj_new_dict(count);
+    for (size_t i = 0; i < count; i++) {
+        mp_obj_t items[] = {
+            mp_obj_new_int_from_uint(stats[i].count),
+            mp_obj_new_int_from_ull(stats[i].total_cycles),
+            mp_obj_new_int_from_uint(stats[i].max_cycles),
+            mp_obj_new_int_from_ull(stats[i].total_latency),
+            mp_obj_new_int_from_uint(stats[i].max_latency),
+        };
+        mp_obj_dict_store(dict, mp_obj_new_int_from_uint((uintptr_t)stats[i].fun), mp_obj_new_tuple(MP_ARRAY_SIZE(items), items));
+    }
+    return dict;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(supervisor_runtime_get_background_stats_obj, supervisor_runtime_get_background_stats);
+
+MP_PROPERTY_GETTER(supervisor_runtime_background_stats_obj,
+    (mp_obj_t)&supervisor_runtime_get_background_stats_obj);
+#endif
+
+#if CIRCUITPY_BOOT_TIMING
+//|     boot_timing: Tuple[Tuple[str, int], ...]
+//|     """When each phase of the last cold boot finished, as ``(phase, microseconds)``
+//|     pairs in boot order. Times count from when the tick counter started, normally at
+//|     reset. Phases that haven't happened, such as ``usb_mounted`` with no host, are left
+//|     out. Soft reloads don't change the values. Only available in builds with
+//|     ``CIRCUITPY_BOOT_TIMING``. (read-only)"""
+//|
+static mp_obj_t supervisor_runtime_get_boot_timing(mp_obj_t self) {
+    mp_obj_t items[BOOT_PHASE_COUNT];
+    size_t count = 0;
+    for (size_t phase = 0; phase < BOOT_PHASE_COUNT; phase++) {
+        uint64_t us;
+        if (supervisor_boot_timing_get(phase, &us)) {
+            const char *name = supervisor_boot_timing_phase_name(phase);
+            mp_obj_t pair[] = {
+                mp_obj_new_str(name, strlen(name)),
+                mp_obj_new_int_from_ull(us),
+            };
+            items[count++] = mp_obj_new_tuple(MP_ARRAY_SIZE(pair), pair);
+        }
+    }
+    return mp_obj_new_tuple(count, items);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(supervisor_runtime_get_boot_timing_obj, supervisor_runtime_get_boot_timing);
+
+MP_PROPERTY_GETTER(supervisor_runtime_boot_timing_obj,
+    (mp_obj_t)&supervisor_runtime_get_boot_timing_obj);
+#endif
+
+#if CIRCUITPY_PORT_HEAP_STATS
+//|     port_heap_stats: Dict[int, Tuple[int, int, int]]
+//|     """Memory held outside the VM heap, keyed by the address in the firmware that called
+//|     ``port_malloc()``. Look addresses up in the firmware's ``.elf`` or ``.map`` file. Key
+//|     ``0`` totals callers beyond the tracking limit. Each value is ``(allocations, bytes,
+//|     peak_bytes)`` for the allocations still held, the bytes they use and the most bytes
+//|     held at once since boot. Only available in builds with ``CIRCUITPY_PORT_HEAP_STATS``.
+//|     (read-only)"""
+//|
+static mp_obj_t supervisor_runtime_get_port_heap_stats(mp_obj_t self) {
+    const port_heap_stats_t *stats;
+    size_t count = port_heap_get_stats(&stats);
+    mp_obj_t dict = mp_obj_new_dict(count);
+    for (size_t i = 0; i < count; i++) {
+        mp_obj_t items[] = {
+            mp_obj_new_int_from_uint(stats[i].allocations),
+            mp_obj_new_int_from_uint(stats[i].bytes),
+            mp_obj_new_int_from_uint(stats[i].peak_bytes),
+        };
+        mp_obj_dict_store(dict, mp_obj_new_int_from_uint((uintptr_t)stats[i].owner), mp_obj_new_tuple(MP_ARRAY_SIZE(items), items));
+    }
+    return dict;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(supervisor_runtime_get_port_heap_stats_obj, supervisor_runtime_get_port_heap_stats);
+
+MP_PROPERTY_GETTER(supervisor_runtime_port_heap_stats_obj,
+    (mp_obj_t)&supervisor_runtime_get_port_heap_stats_obj);
+#endif
+
 static const mp_rom_map_elem_t supervisor_runtime_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_usb_connected), MP_ROM_PTR(&supervisor_runtime_usb_connected_obj) },
     { MP_ROM_QSTR(MP_QSTR_serial_connected), MP_ROM_PTR(&supervisor_runtime_serial_connected_obj) },
@@ -211,6 +306,15 @@ static const mp_rom_map_elem_t supervisor_runtime_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_autoreload), MP_ROM_PTR(&supervisor_runtime_autoreload_obj) },
     { MP_ROM_QSTR(MP_QSTR_ble_workflow),  MP_ROM_PTR(&supervisor_runtime_ble_workflow_obj) },
     { MP_ROM_QSTR(MP_QSTR_rgb_status_brightness),  MP_ROM_PTR(&supervisor_runtime_rgb_status_brightness_obj) },
+    #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+    { MP_ROM_QSTR(MP_QSTR_background_stats),  MP_ROM_PTR(&supervisor_runtime_background_stats_obj) },
+    #endif
+    #if CIRCUITPY_PORT_HEAP_STATS
+    { MP_ROM_QSTR(MP_QSTR_port_heap_stats),  MP_ROM_PTR(&supervisor_runtime_port_heap_stats_obj) },
+    #endif
+    #if CIRCUITPY_BOOT_TIMING
+    { MP_ROM_QSTR(MP_QSTR_boot_timing),  MP_ROM_PTR(&supervisor_runtime_boot_timing_obj) },
+    #endif
 };
 
 static MP_DEFINE_CONST_DICT(supervisor_runtime_locals_dict, supervisor_runtime_locals_dict_table);
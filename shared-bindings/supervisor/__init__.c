@@ -5,14 +5,19 @@
 // SPDX-License-Identifier: MIT
 #include <string.h>
 
+#include "py/gc.h"
 #include "py/obj.h"
 #include "py/runtime.h"
+#include "py/objlist.h"
 #include "py/objstr.h"
+#include "py/profile.h"
 
 #include "shared/runtime/interrupt_char.h"
+#include "supervisor/background_callback.h"
 #include "supervisor/port.h"
 #include "supervisor/shared/display.h"
 #include "supervisor/shared/reload.h"
+#include "supervisor/shared/trace.h"
 #include "supervisor/shared/traceback.h"
 #include "supervisor/shared/workflow.h"
 
@@ -310,6 +315,222 @@ static mp_obj_t supervisor_set_usb_identification(size_t n_args, const mp_obj_t
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(supervisor_set_usb_identification_obj, 0, supervisor_set_usb_identification);
 
+#if CIRCUITPY_SAMPLING_PROFILER
+//| def start_profiling(*, samples: int = 256, interval_ms: int = 10) -> None:
+//|     """Start the sampling profiler, discarding any samples from a previous run.
+//|
+//|     Every ``interval_ms`` milliseconds the line being run, and the lines of a few of its
+//|     callers, are recorded in a ring buffer of ``samples`` entries on the heap. Once the buffer
+//|     is full the oldest samples are overwritten. The sample is taken at the next branch, loop
+//|     iteration or call, so time spent inside a long native function is credited to the line
+//|     that called it.
+//|
+//|     Profiling stops when the VM exits. Only available on builds with
+//|     ``CIRCUITPY_SAMPLING_PROFILER`` enabled."""
+//|     ...
+//|
+static mp_obj_t supervisor_start_profiling(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_samples, ARG_interval_ms };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_samples, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 256} },
+        { MP_QSTR_interval_ms, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 10} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t samples = mp_arg_validate_int_min(args[ARG_samples].u_int, 1, MP_QSTR_samples);
+    mp_int_t interval_ms = mp_arg_validate_int_range(args[ARG_interval_ms].u_int, 1, 0xffff, MP_QSTR_interval_ms);
+    supervisor_profiling_start(samples, interval_ms);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(supervisor_start_profiling_obj, 0, supervisor_start_profiling);
+
+//| def stop_profiling() -> None:
+//|     """Stop the sampling profiler. The samples taken so far are kept for `print_profile`."""
+//|     ...
+//|
+static mp_obj_t supervisor_stop_profiling(void) {
+    supervisor_profiling_stop();
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(supervisor_stop_profiling_obj, supervisor_stop_profiling);
+
+//| def print_profile(*, collapsed: bool = False) -> None:
+//|     """Print the samples collected by `start_profiling`, most frequent first.
+//|
+//|     By default prints how often each ``file:line`` was the one running. With ``collapsed``
+//|     true, prints one line per distinct call stack in the "collapsed stack" format read by
+//|     flame graph tools: ``outer;...;inner count``."""
+//|     ...
+//|
+static mp_obj_t supervisor_print_profile(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_collapsed };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_collapsed, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_prof_sample_print(&mp_plat_print, args[ARG_collapsed].u_bool);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(supervisor_print_profile_obj, 0, supervisor_print_profile);
+#endif
+
+#if CIRCUITPY_SUPERVISOR_BENCHMARK
+//| def benchmark(
+//|     function: Callable[[], Any], *, repeat: int = 5, background_tasks: bool = True
+//| ) -> Tuple[int, int, int, int, int]:
+//|     """Call ``function`` with no arguments ``repeat`` times and time each call with the CPU
+//|     cycle counter. The heap is collected before each call so that earlier garbage doesn't
+//|     trigger a collection part way through.
+//|
+//|     Returns ``(min, median, max, allocated, collections)``. The times are in CPU cycles, or
+//|     in 1/32768 second units on CPUs without a cycle counter. ``allocated`` is the
+//|     average number of heap bytes allocated by a call and ``collections`` is the total
+//|     number of collections that happened during the calls.
+//|
+//|     With ``background_tasks`` false, background work such as USB, displays and audio is
+//|     held off while ``function`` runs. The host connection is not serviced in that time, so
+//|     keep each call short. Only available on builds with
+//|     ``CIRCUITPY_SUPERVISOR_BENCHMARK`` enabled."""
+//|     ...
+//|
+static mp_obj_t supervisor_benchmark(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_function, ARG_repeat, ARG_background_tasks };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_function, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_repeat, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 5} },
+        { MP_QSTR_background_tasks, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = true} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t function = args[ARG_function].u_obj;
+    size_t repeat = mp_arg_validate_int_range(args[ARG_repeat].u_int, 1, 1000, MP_QSTR_repeat);
+    bool background_tasks = args[ARG_background_tasks].u_bool;
+
+    uint32_t *cycles = m_new(uint32_t, repeat);
+    size_t alloc_blocks = 0;
+    size_t collections = 0;
+    for (size_t i = 0; i < repeat; i++) {
+        gc_collect();
+        size_t start_blocks = MP_STATE_MEM(gc_stats_alloc_blocks);
+        size_t start_collections = MP_STATE_MEM(gc_stats_collections);
+        if (!background_tasks) {
+            background_callback_prevent();
+        }
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            uint32_t start = port_get_cpu_cycles();
+            mp_call_function_0(function);
+            cycles[i] = port_get_cpu_cycles() - start;
+            nlr_pop();
+        } else {
+            if (!background_tasks) {
+                background_callback_allow();
+            }
+            nlr_jump(nlr.ret_val);
+        }
+        if (!background_tasks) {
+            background_callback_allow();
+        }
+        alloc_blocks += MP_STATE_MEM(gc_stats_alloc_blocks) - start_blocks;
+        collections += MP_STATE_MEM(gc_stats_collections) - start_collections;
+    }
+
+    // Insertion sort, repeat is small.
+    for (size_t i = 1; i < repeat; i++) {
+        uint32_t c = cycles[i];
+        size_t j = i;
+        for (; j > 0 && cycles[j - 1] > c; j--) {
+            cycles[j] = cycles[j - 1];
+        }
+        cycles[j] = c;
+    }
+
+    mp_obj_t items[] = {
+        mp_obj_new_int_from_uint(cycles[0]),
+        mp_obj_new_int_from_uint(cycles[repeat / 2]),
+        mp_obj_new_int_from_uint(cycles[repeat - 1]),
+        mp_obj_new_int_from_uint(alloc_blocks * MICROPY_BYTES_PER_GC_BLOCK / repeat),
+        mp_obj_new_int_from_uint(collections),
+    };
+    m_del(uint32_t, cycles, repeat);
+    return mp_obj_new_tuple(MP_ARRAY_SIZE(items), items);
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(supervisor_benchmark_obj, 1, supervisor_benchmark);
+#endif
+
+#if CIRCUITPY_SUPERVISOR_IMPORT_STATS
+//| def import_stats() -> List[Tuple[str, str, int, int, int]]:
+//|     """Returns what each import since the VM started cost, in the order the imports
+//|     started. Each is ``(name, kind, load_us, exec_us, allocated)``:
+//|
+//|     * ``kind`` is ``"py"``, ``"mpy"`` or ``"frozen"``.
+//|     * ``load_us`` is the time spent compiling the ``.py`` or reading the ``.mpy``.
+//|     * ``exec_us`` is the time spent running the module body.
+//|     * ``allocated`` is the number of heap bytes allocated by both.
+//|
+//|     None of the figures include the imports that the module made itself, so sum them to
+//|     get the cost of a whole library. Times have about 30us resolution. Only the first
+//|     ``MICROPY_MODULE_IMPORT_STATS_MAX`` imports are kept.
+//|
+//|     Only available on builds with ``CIRCUITPY_SUPERVISOR_IMPORT_STATS`` enabled.
+//|
+//|     Find the slowest imports at the end of ``code.py``::
+//|
+//|       import supervisor
+//|
+//|       for name, kind, load_us, exec_us, allocated in sorted(
+//|           supervisor.import_stats(), key=lambda s: -(s[2] + s[3])
+//|       )[:5]:
+//|           print(name, kind, load_us, exec_us, allocated)
+//|     """
+//|     ...
+//|
+static mp_obj_t supervisor_import_stats(void) {
+    static const qstr kinds[] = {
+        [MP_IMPORT_KIND_PY] = MP_QSTR_py,
+        [MP_IMPORT_KIND_MPY] = MP_QSTR_mpy,
+        [MP_IMPORT_KIND_FROZEN] = MP_QSTR_frozen,
+    };
+    size_t len = MIN(MP_STATE_VM(import_stats_len), MICROPY_MODULE_IMPORT_STATS_MAX);
+    mp_obj_list_t *result = MP_OBJ_TO_PTR(mp_obj_new_list(len, NULL));
+    for (size_t i = 0; i < len; i++) {
+        const mp_import_record_t *record = &MP_STATE_VM(import_stats)[i];
+        mp_obj_t items[] = {
+            MP_OBJ_NEW_QSTR(record->name),
+            MP_OBJ_NEW_QSTR(kinds[record->kind]),
+            mp_obj_new_int_from_uint(record->load_us),
+            mp_obj_new_int_from_uint(record->exec_us),
+            mp_obj_new_int_from_uint(record->alloc_blocks * MICROPY_BYTES_PER_GC_BLOCK),
+        };
+        result->items[i] = mp_obj_new_tuple(MP_ARRAY_SIZE(items), items);
+    }
+    return MP_OBJ_FROM_PTR(result);
+}
+MP_DEFINE_CONST_FUN_OBJ_0(supervisor_import_stats_obj, supervisor_import_stats);
+#endif
+
+#if CIRCUITPY_SUPERVISOR_TRACE
+//| def dump_trace() -> None:
+//|     """Print the recently traced events to the console as Chrome trace JSON and forget them.
+//|     Save the output to a ``.json`` file and open it in https://ui.perfetto.dev or
+//|     ``chrome://tracing`` to see when garbage collection, background callbacks, display
+//|     refreshes and audio DMA refills ran. Only the last ``CIRCUITPY_SUPERVISOR_TRACE_EVENTS``
+//|     events are kept, and timestamps are in microseconds from the oldest one.
+//|
+//|     Only available on builds with ``CIRCUITPY_SUPERVISOR_TRACE`` enabled."""
+//|     ...
+//|
+static mp_obj_t supervisor_dump_trace(void) {
+    supervisor_trace_dump(&mp_plat_print);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(supervisor_dump_trace_obj, supervisor_dump_trace);
+#endif
+
 static const mp_rom_map_elem_t supervisor_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_supervisor) },
     { MP_ROM_QSTR(MP_QSTR_runtime),  MP_ROM_PTR(&common_hal_supervisor_runtime_obj) },
@@ -326,6 +547,20 @@ static const mp_rom_map_elem_t supervisor_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_reset_terminal),  MP_ROM_PTR(&supervisor_reset_terminal_obj) },
     { MP_ROM_QSTR(MP_QSTR_set_usb_identification),  MP_ROM_PTR(&supervisor_set_usb_identification_obj) },
     { MP_ROM_QSTR(MP_QSTR_status_bar),  MP_ROM_PTR(&shared_module_supervisor_status_bar_obj) },
+    #if CIRCUITPY_SAMPLING_PROFILER
+    { MP_ROM_QSTR(MP_QSTR_start_profiling),  MP_ROM_PTR(&supervisor_start_profiling_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stop_profiling),  MP_ROM_PTR(&supervisor_stop_profiling_obj) },
+    { MP_ROM_QSTR(MP_QSTR_print_profile),  MP_ROM_PTR(&supervisor_print_profile_obj) },
+    #endif
+    #if CIRCUITPY_SUPERVISOR_BENCHMARK
+    { MP_ROM_QSTR(MP_QSTR_benchmark),  MP_ROM_PTR(&supervisor_benchmark_obj) },
+    #endif
+    #if CIRCUITPY_SUPERVISOR_IMPORT_STATS
+    { MP_ROM_QSTR(MP_QSTR_import_stats),  MP_ROM_PTR(&supervisor_import_stats_obj) },
+    #endif
+    #if CIRCUITPY_SUPERVISOR_TRACE
+    { MP_ROM_QSTR(MP_QSTR_dump_trace),  MP_ROM_PTR(&supervisor_dump_trace_obj) },
+    #endif
 };
 
 static MP_DEFINE_CONST_DICT(supervisor_module_globals, supervisor_module_globals_table);
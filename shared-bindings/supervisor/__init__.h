@@ -32,3 +32,9 @@ extern supervisor_next_code_info_t *next_code_configuration;
 #if CIRCUITPY_USB_DEVICE
 extern usb_identification_t *custom_usb_identification;
 #endif
+
+#if CIRCUITPY_SAMPLING_PROFILER
+void supervisor_profiling_start(size_t samples, mp_uint_t interval_ms);
+// Also called when the VM ends.
+void supervisor_profiling_stop(void);
+#endif
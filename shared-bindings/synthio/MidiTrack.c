@@ -20,7 +20,7 @@
 //|     def __init__(
 //|         self,
 //|         buffer: ReadableBuffer,
-//|         tempo: int,
+//|         tempo: int = 0,
 //|         *,
 //|         sample_rate: int = 11025,
 //|         waveform: Optional[ReadableBuffer] = None,
@@ -30,8 +30,13 @@
 //|         are supported; channel numbers and key velocities are ignored. Up to two notes may be on at the
 //|         same time.
 //|
-//|         :param ~circuitpython_typing.ReadableBuffer buffer: Stream of MIDI events, as stored in a MIDI file track chunk
-//|         :param int tempo: Tempo of the streamed events, in MIDI ticks per second
+//|         The buffer may instead hold a whole type 0 or type 1 Standard MIDI File, such as one read
+//|         from the filesystem. Its tracks are merged as it plays, tempo changes are followed, and
+//|         *tempo* is not used. Note On with a velocity of 0 is taken as Note Off, and notes on
+//|         channel 10 (percussion) are skipped. Other events are ignored.
+//|
+//|         :param ~circuitpython_typing.ReadableBuffer buffer: Stream of MIDI events, as stored in a MIDI file track chunk, or a Standard MIDI File
+//|         :param int tempo: Tempo of the streamed events, in MIDI ticks per second. Required unless the buffer is a Standard MIDI File
 //|         :param int sample_rate: The desired playback sample rate; higher sample rate requires more memory
 //|         :param ReadableBuffer waveform: A single-cycle waveform. Default is a 50% duty cycle square wave. If specified, must be a ReadableBuffer of type 'h' (signed 16 bit)
 //|         :param Envelope envelope: An object that defines the loudness of a note over time. The default envelope provides no ramping, voices turn instantly on and off.
@@ -56,7 +61,7 @@ static mp_obj_t synthio_miditrack_make_new(const mp_obj_type_t *type, size_t n_a
     enum { ARG_buffer, ARG_tempo, ARG_sample_rate, ARG_waveform, ARG_envelope };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_buffer, MP_ARG_OBJ | MP_ARG_REQUIRED, {} },
-        { MP_QSTR_tempo, MP_ARG_INT | MP_ARG_REQUIRED, {} },
+        { MP_QSTR_tempo, MP_ARG_INT, {.u_int = 0} },
         { MP_QSTR_sample_rate, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 11025} },
         { MP_QSTR_waveform, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none } },
         { MP_QSTR_envelope, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none } },
@@ -127,7 +132,8 @@ MP_PROPERTY_GETTER(synthio_miditrack_sample_rate_obj,
     (mp_obj_t)&synthio_miditrack_get_sample_rate_obj);
 
 //|     error_location: Optional[int]
-//|     """Offset, in bytes within the midi data, of a decoding error"""
+//|     """Offset, in bytes within the midi data, of a decoding error. For a Standard MIDI File,
+//|     this is the offset within the whole file."""
 //|
 static mp_obj_t synthio_miditrack_obj_get_error_location(mp_obj_t self_in) {
     synthio_miditrack_obj_t *self = MP_OBJ_TO_PTR(self_in);
@@ -42,7 +42,7 @@ static const mp_arg_t note_properties[] = {
 //|         envelope: Optional[Envelope] = None,
 //|         amplitude: BlockInput = 0.0,
 //|         bend: BlockInput = 0.0,
-//|         filter: Optional[Biquad] = None,
+//|         filter: Optional[Union[Biquad, Sequence[Biquad]]] = None,
 //|         ring_frequency: float = 0.0,
 //|         ring_bend: float = 0.0,
 //|         ring_waveform: Optional[ReadableBuffer] = None,
@@ -85,9 +85,11 @@ MP_PROPERTY_GETSET(synthio_note_frequency_obj,
     (mp_obj_t)&synthio_note_get_frequency_obj,
     (mp_obj_t)&synthio_note_set_frequency_obj);
 
-//|     filter: Optional[Biquad]
+//|     filter: Optional[Union[Biquad, Sequence[Biquad]]]
 //|     """If not None, the output of this Note is filtered according to the provided coefficients.
 //|
+//|     A sequence of up to 4 `Biquad` objects is applied in order, for filters with more poles.
+//|
 //|     Construct an appropriate filter by calling a filter-making method on the
 //|     `Synthesizer` object where you plan to play the note, as filter coefficients depend
 //|     on the sample rate"""
@@ -222,6 +222,30 @@ MP_PROPERTY_GETSET(synthio_synthesizer_envelope_obj,
     (mp_obj_t)&synthio_synthesizer_get_envelope_obj,
     (mp_obj_t)&synthio_synthesizer_set_envelope_obj);
 
+//|     filter: Optional[Union[Biquad, Sequence[Biquad]]]
+//|     """If not None, the mixed output of all notes is filtered according to the provided coefficients.
+//|
+//|     A sequence of up to 4 `Biquad` objects is applied in order, for filters with more poles.
+//|     Unlike `Note.filter`, this costs the same however many notes are playing."""
+static mp_obj_t synthio_synthesizer_obj_get_filter(mp_obj_t self_in) {
+    synthio_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return synthio_synth_filter_get(&self->synth);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(synthio_synthesizer_get_filter_obj, synthio_synthesizer_obj_get_filter);
+
+static mp_obj_t synthio_synthesizer_obj_set_filter(mp_obj_t self_in, mp_obj_t filter) {
+    synthio_synthesizer_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    synthio_synth_filter_set(&self->synth, filter);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(synthio_synthesizer_set_filter_obj, synthio_synthesizer_obj_set_filter);
+
+MP_PROPERTY_GETSET(synthio_synthesizer_filter_obj,
+    (mp_obj_t)&synthio_synthesizer_get_filter_obj,
+    (mp_obj_t)&synthio_synthesizer_set_filter_obj);
+
 //|     sample_rate: int
 //|     """32 bit value that tells how quickly samples are played in Hertz (cycles per second)."""
 static mp_obj_t synthio_synthesizer_obj_get_sample_rate(mp_obj_t self_in) {
@@ -412,6 +436,7 @@ static const mp_rom_map_elem_t synthio_synthesizer_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_band_pass_filter), MP_ROM_PTR(&synthio_synthesizer_bpf_fun_obj) },
     // Properties
     { MP_ROM_QSTR(MP_QSTR_envelope), MP_ROM_PTR(&synthio_synthesizer_envelope_obj) },
+    { MP_ROM_QSTR(MP_QSTR_filter), MP_ROM_PTR(&synthio_synthesizer_filter_obj) },
     { MP_ROM_QSTR(MP_QSTR_sample_rate), MP_ROM_PTR(&synthio_synthesizer_sample_rate_obj) },
     { MP_ROM_QSTR(MP_QSTR_max_polyphony), MP_ROM_INT(CIRCUITPY_SYNTHIO_MAX_CHANNELS) },
     { MP_ROM_QSTR(MP_QSTR_pressed), MP_ROM_PTR(&synthio_synthesizer_pressed_obj) },
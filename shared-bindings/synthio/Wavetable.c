@@ -0,0 +1,81 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2023 Jeff Epler for Adafruit Industries
+//
+// SPDX-License-Identifier: MIT
+
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/synthio/__init__.h"
+#include "shared-bindings/synthio/Wavetable.h"
+#include "shared-module/synthio/__init__.h"
+
+//| class Wavetable:
+//|     def __init__(self, waveform: ReadableBuffer) -> None:
+//|         """A single-cycle waveform with precomputed band-limited copies.
+//|
+//|         When a `Wavetable` is used as the ``waveform`` of a `Note` or `Synthesizer`,
+//|         each note plays from the copy with enough harmonics removed that it does
+//|         not alias at the note's frequency. The copies are computed once, here, by
+//|         repeatedly low-pass filtering and halving the waveform, so playing a note
+//|         costs the same as playing the plain waveform.
+//|
+//|         A copy is made for each time the length can be halved evenly, so a
+//|         waveform whose length is a power of two gets the most levels. The
+//|         filtered copies are not used while ``waveform_loop_start`` or
+//|         ``waveform_loop_end`` select part of the waveform.
+//|
+//|         A `Wavetable` supports the buffer protocol; its contents are the original waveform.
+//|
+//|         :param ReadableBuffer waveform: A single-cycle waveform. Must be a ReadableBuffer of type 'h' (signed 16 bit). The contents are copied."""
+//|
+static mp_obj_t synthio_wavetable_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_waveform };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_waveform, MP_ARG_OBJ | MP_ARG_REQUIRED, {} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_buffer_info_t bufinfo;
+    synthio_synth_parse_waveform(&bufinfo, args[ARG_waveform].u_obj);
+
+    synthio_wavetable_obj_t *self = mp_obj_malloc(synthio_wavetable_obj_t, &synthio_wavetable_type);
+    common_hal_synthio_wavetable_construct(self, bufinfo.buf, bufinfo.len);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|     levels: int
+//|     """The number of band-limited copies, including the original waveform (read-only)"""
+//|
+static mp_obj_t synthio_wavetable_get_levels(mp_obj_t self_in) {
+    synthio_wavetable_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_synthio_wavetable_get_levels(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(synthio_wavetable_get_levels_obj, synthio_wavetable_get_levels);
+
+MP_PROPERTY_GETTER(synthio_wavetable_levels_obj,
+    (mp_obj_t)&synthio_wavetable_get_levels_obj);
+
+static mp_int_t synthio_wavetable_buffer(mp_obj_t self_in, mp_buffer_info_t *bufinfo, mp_uint_t flags) {
+    if (flags & MP_BUFFER_WRITE) {
+        return 1;
+    }
+    synthio_wavetable_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_synthio_wavetable_get_buffer(self, bufinfo);
+    return 0;
+}
+
+static const mp_rom_map_elem_t synthio_wavetable_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_levels), MP_ROM_PTR(&synthio_wavetable_levels_obj) },
+};
+static MP_DEFINE_CONST_DICT(synthio_wavetable_locals_dict, synthio_wavetable_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    synthio_wavetable_type,
+    MP_QSTR_Wavetable,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    make_new, synthio_wavetable_make_new,
+    locals_dict, &synthio_wavetable_locals_dict,
+    buffer, synthio_wavetable_buffer
+    );
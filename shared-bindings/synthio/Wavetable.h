@@ -0,0 +1,16 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2023 Jeff Epler for Adafruit Industries
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+#include "shared-module/synthio/Wavetable.h"
+
+extern const mp_obj_type_t synthio_wavetable_type;
+
+void common_hal_synthio_wavetable_construct(synthio_wavetable_obj_t *self, const int16_t *waveform, size_t length);
+mp_int_t common_hal_synthio_wavetable_get_levels(synthio_wavetable_obj_t *self);
+void common_hal_synthio_wavetable_get_buffer(synthio_wavetable_obj_t *self, mp_buffer_info_t *bufinfo);
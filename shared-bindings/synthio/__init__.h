@@ -28,5 +28,7 @@ extern int16_t shared_bindings_synthio_square_wave[];
 extern const mp_obj_namedtuple_type_t synthio_envelope_type_obj;
 void synthio_synth_envelope_set(synthio_synth_t *synth, mp_obj_t envelope_obj);
 mp_obj_t synthio_synth_envelope_get(synthio_synth_t *synth);
+void synthio_synth_filter_set(synthio_synth_t *synth, mp_obj_t filter_obj);
+mp_obj_t synthio_synth_filter_get(synthio_synth_t *synth);
 mp_float_t common_hal_synthio_midi_to_hz_float(mp_float_t note);
 mp_float_t common_hal_synthio_voct_to_hz_float(mp_float_t note);
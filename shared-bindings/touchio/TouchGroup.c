@@ -0,0 +1,224 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <stdint.h>
+
+#include "shared/runtime/context_manager_helpers.h"
+#include "py/objproperty.h"
+#include "py/objtuple.h"
+#include "py/runtime.h"
+#include "shared-bindings/microcontroller/Pin.h"
+#include "shared-bindings/touchio/TouchGroup.h"
+#include "shared-bindings/util.h"
+
+//| class TouchGroup:
+//|     """Read several capacitive touch pads at once
+//|
+//|     All of the pads are measured together, so reading twelve pads takes
+//|     about as long as reading one with `TouchIn`. Each pad has a baseline
+//|     that follows slow drift while it isn't touched, and a touch has to be
+//|     seen on several readings in a row before it is reported.
+//|
+//|     Usage::
+//|
+//|        import board
+//|        import touchio
+//|
+//|        pads = touchio.TouchGroup((board.A1, board.A2, board.A3))
+//|        while True:
+//|            for i in pads.update():
+//|                print(i, "touched" if pads.values[i] else "released")"""
+//|
+
+//|     def __init__(
+//|         self, pins: Sequence[microcontroller.Pin], *, margin: int = 100, debounce: int = 2
+//|     ) -> None:
+//|         """Use the given pins as touch pads. Each needs a pull down resistor of
+//|         about 1Mohm, as for `TouchIn`. The pads must not be touched while the
+//|         baselines are measured, here and in `recalibrate`.
+//|
+//|         :param Sequence[microcontroller.Pin] pins: the pads, up to 32
+//|         :param int margin: how far above its baseline, plus 5%, a reading
+//|           must be to count as a touch
+//|         :param int debounce: how many readings in a row must agree before
+//|           a pad changes state"""
+//|         ...
+//|
+static mp_obj_t touchio_touchgroup_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_pins, ARG_margin, ARG_debounce };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_pins, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_margin, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 100} },
+        { MP_QSTR_debounce, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 2} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t pins = args[ARG_pins].u_obj;
+    const size_t pad_count = (size_t)mp_arg_validate_length_range(
+        MP_OBJ_SMALL_INT_VALUE(mp_obj_len(pins)), 1, TOUCHIO_TOUCHGROUP_MAX_PADS, MP_QSTR_pins);
+    const uint16_t margin = mp_arg_validate_int_range(args[ARG_margin].u_int, 0, UINT16_MAX, MP_QSTR_margin);
+    const uint8_t debounce = mp_arg_validate_int_range(args[ARG_debounce].u_int, 1, 127, MP_QSTR_debounce);
+
+    const mcu_pin_obj_t *pins_array[pad_count];
+    for (size_t i = 0; i < pad_count; i++) {
+        mp_obj_t pin = mp_obj_subscr(pins, MP_OBJ_NEW_SMALL_INT(i), MP_OBJ_SENTINEL);
+        pins_array[i] = validate_obj_is_free_pin(pin, MP_QSTR_pin);
+    }
+    validate_no_duplicate_pins(pins, MP_QSTR_pins);
+
+    touchio_touchgroup_obj_t *self = mp_obj_malloc(touchio_touchgroup_obj_t, &touchio_touchgroup_type);
+    common_hal_touchio_touchgroup_construct(self, pins_array, pad_count, margin, debounce);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|     def deinit(self) -> None:
+//|         """Release the pins for other use."""
+//|         ...
+//|
+static mp_obj_t touchio_touchgroup_deinit(mp_obj_t self_in) {
+    touchio_touchgroup_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_touchio_touchgroup_deinit(self);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(touchio_touchgroup_deinit_obj, touchio_touchgroup_deinit);
+
+static void check_for_deinit(touchio_touchgroup_obj_t *self) {
+    if (common_hal_touchio_touchgroup_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|     def __enter__(self) -> TouchGroup:
+//|         """No-op used by Context Managers."""
+//|         ...
+//|
+//  Provided by context manager helper.
+
+//|     def __exit__(self) -> None:
+//|         """Automatically deinitializes the hardware when exiting a context. See
+//|         :ref:`lifetime-and-contextmanagers` for more info."""
+//|         ...
+//|
+static mp_obj_t touchio_touchgroup_obj___exit__(size_t n_args, const mp_obj_t *args) {
+    (void)n_args;
+    common_hal_touchio_touchgroup_deinit(args[0]);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(touchio_touchgroup___exit___obj, 4, 4, touchio_touchgroup_obj___exit__);
+
+//|     def update(self) -> Tuple[int, ...]:
+//|         """Measure every pad and return the indices of the pads that were
+//|         touched or released since the last call. Usually this is an empty
+//|         tuple, so polling it is cheap."""
+//|         ...
+//|
+static mp_obj_t touchio_touchgroup_update(mp_obj_t self_in) {
+    touchio_touchgroup_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    uint32_t changed = common_hal_touchio_touchgroup_update(self);
+    if (changed == 0) {
+        return mp_const_empty_tuple;
+    }
+    mp_obj_tuple_t *result = MP_OBJ_TO_PTR(mp_obj_new_tuple(__builtin_popcount(changed), NULL));
+    size_t n = 0;
+    for (size_t i = 0; changed != 0; i++, changed >>= 1) {
+        if (changed & 1) {
+            result->items[n++] = MP_OBJ_NEW_SMALL_INT(i);
+        }
+    }
+    return MP_OBJ_FROM_PTR(result);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(touchio_touchgroup_update_obj, touchio_touchgroup_update);
+
+//|     def recalibrate(self) -> None:
+//|         """Measure new baselines for all the pads, which must not be touched,
+//|         and mark them all released."""
+//|         ...
+//|
+static mp_obj_t touchio_touchgroup_recalibrate(mp_obj_t self_in) {
+    touchio_touchgroup_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_touchio_touchgroup_recalibrate(self);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(touchio_touchgroup_recalibrate_obj, touchio_touchgroup_recalibrate);
+
+static mp_obj_t new_tuple_from_u16(const uint16_t *values, size_t n) {
+    mp_obj_tuple_t *result = MP_OBJ_TO_PTR(mp_obj_new_tuple(n, NULL));
+    for (size_t i = 0; i < n; i++) {
+        result->items[i] = MP_OBJ_NEW_SMALL_INT(values[i]);
+    }
+    return MP_OBJ_FROM_PTR(result);
+}
+
+//|     values: Tuple[bool, ...]
+//|     """Whether each pad is touched, as of the last `update`. (read-only)"""
+static mp_obj_t touchio_touchgroup_obj_get_values(mp_obj_t self_in) {
+    touchio_touchgroup_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    size_t n = common_hal_touchio_touchgroup_get_pad_count(self);
+    uint32_t touched = common_hal_touchio_touchgroup_get_touched(self);
+    mp_obj_tuple_t *result = MP_OBJ_TO_PTR(mp_obj_new_tuple(n, NULL));
+    for (size_t i = 0; i < n; i++) {
+        result->items[i] = mp_obj_new_bool(touched & (1u << i));
+    }
+    return MP_OBJ_FROM_PTR(result);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(touchio_touchgroup_get_values_obj, touchio_touchgroup_obj_get_values);
+
+MP_PROPERTY_GETTER(touchio_touchgroup_values_obj,
+    (mp_obj_t)&touchio_touchgroup_get_values_obj);
+
+//|     raw_values: Tuple[int, ...]
+//|     """The measurement of each pad from the last `update`. (read-only)"""
+static mp_obj_t touchio_touchgroup_obj_get_raw_values(mp_obj_t self_in) {
+    touchio_touchgroup_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return new_tuple_from_u16(common_hal_touchio_touchgroup_get_raw_values(self),
+        common_hal_touchio_touchgroup_get_pad_count(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(touchio_touchgroup_get_raw_values_obj, touchio_touchgroup_obj_get_raw_values);
+
+MP_PROPERTY_GETTER(touchio_touchgroup_raw_values_obj,
+    (mp_obj_t)&touchio_touchgroup_get_raw_values_obj);
+
+//|     baselines: Tuple[int, ...]
+//|     """The untouched reading of each pad, which `update` keeps following
+//|     while the pad is released. (read-only)"""
+//|
+static mp_obj_t touchio_touchgroup_obj_get_baselines(mp_obj_t self_in) {
+    touchio_touchgroup_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return new_tuple_from_u16(common_hal_touchio_touchgroup_get_baselines(self),
+        common_hal_touchio_touchgroup_get_pad_count(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(touchio_touchgroup_get_baselines_obj, touchio_touchgroup_obj_get_baselines);
+
+MP_PROPERTY_GETTER(touchio_touchgroup_baselines_obj,
+    (mp_obj_t)&touchio_touchgroup_get_baselines_obj);
+
+static const mp_rom_map_elem_t touchio_touchgroup_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&touchio_touchgroup___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&touchio_touchgroup_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR_update), MP_ROM_PTR(&touchio_touchgroup_update_obj) },
+    { MP_ROM_QSTR(MP_QSTR_recalibrate), MP_ROM_PTR(&touchio_touchgroup_recalibrate_obj) },
+
+    { MP_ROM_QSTR(MP_QSTR_values), MP_ROM_PTR(&touchio_touchgroup_values_obj) },
+    { MP_ROM_QSTR(MP_QSTR_raw_values), MP_ROM_PTR(&touchio_touchgroup_raw_values_obj) },
+    { MP_ROM_QSTR(MP_QSTR_baselines), MP_ROM_PTR(&touchio_touchgroup_baselines_obj) },
+};
+
+static MP_DEFINE_CONST_DICT(touchio_touchgroup_locals_dict, touchio_touchgroup_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    touchio_touchgroup_type,
+    MP_QSTR_TouchGroup,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    make_new, touchio_touchgroup_make_new,
+    locals_dict, &touchio_touchgroup_locals_dict
+    );
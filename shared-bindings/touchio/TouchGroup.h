@@ -0,0 +1,24 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "common-hal/microcontroller/Pin.h"
+#include "shared-module/touchio/TouchGroup.h"
+
+extern const mp_obj_type_t touchio_touchgroup_type;
+
+void common_hal_touchio_touchgroup_construct(touchio_touchgroup_obj_t *self,
+    const mcu_pin_obj_t **pins, size_t pad_count, uint16_t margin, uint8_t debounce);
+void common_hal_touchio_touchgroup_deinit(touchio_touchgroup_obj_t *self);
+bool common_hal_touchio_touchgroup_deinited(touchio_touchgroup_obj_t *self);
+size_t common_hal_touchio_touchgroup_get_pad_count(touchio_touchgroup_obj_t *self);
+// Measures every pad and returns a bitmask of the pads that changed state.
+uint32_t common_hal_touchio_touchgroup_update(touchio_touchgroup_obj_t *self);
+uint32_t common_hal_touchio_touchgroup_get_touched(touchio_touchgroup_obj_t *self);
+const uint16_t *common_hal_touchio_touchgroup_get_raw_values(touchio_touchgroup_obj_t *self);
+const uint16_t *common_hal_touchio_touchgroup_get_baselines(touchio_touchgroup_obj_t *self);
+void common_hal_touchio_touchgroup_recalibrate(touchio_touchgroup_obj_t *self);
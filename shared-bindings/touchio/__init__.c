@@ -12,6 +12,9 @@
 #include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/touchio/__init__.h"
 #include "shared-bindings/touchio/TouchIn.h"
+#if !CIRCUITPY_TOUCHIO_USE_NATIVE
+#include "shared-bindings/touchio/TouchGroup.h"
+#endif
 
 #include "py/runtime.h"
 
@@ -42,6 +45,9 @@
 static const mp_rom_map_elem_t touchio_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_touchio) },
     { MP_ROM_QSTR(MP_QSTR_TouchIn),   MP_ROM_PTR(&touchio_touchin_type) },
+    #if !CIRCUITPY_TOUCHIO_USE_NATIVE
+    { MP_ROM_QSTR(MP_QSTR_TouchGroup), MP_ROM_PTR(&touchio_touchgroup_type) },
+    #endif
 };
 
 static MP_DEFINE_CONST_DICT(touchio_module_globals, touchio_module_globals_table);
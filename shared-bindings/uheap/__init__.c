@@ -26,9 +26,42 @@ static mp_obj_t uheap_info(mp_obj_t obj) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(uheap_info_obj, uheap_info);
 
+//| def snapshot(dest: Union[WriteableBuffer, io.BufferedIOBase]) -> int:
+//|     """Writes a compact map of the heap to ``dest`` and returns its length in bytes.
+//|
+//|     ``dest`` is a buffer, which must be large enough, or a file opened for writing.
+//|     The map records every run of free blocks and every allocation, in address order,
+//|     with the kind of object each allocation holds where it can be told. Writing to
+//|     a buffer doesn't allocate, so the map shows the heap at one moment. Writing to a
+//|     file may allocate as the map is written.
+//|
+//|     Run ``tools/heap_snapshot.py`` on the host to show the fragmentation in one or
+//|     more snapshots. That script also describes the format.
+//|
+//|     Save a snapshot when memory runs out::
+//|
+//|       import uheap
+//|
+//|       snapshot = bytearray(4096)
+//|       try:
+//|           main_loop()
+//|       except MemoryError:
+//|           length = uheap.snapshot(snapshot)
+//|           with open("/heap.bin", "wb") as f:
+//|               f.write(memoryview(snapshot)[:length])
+//|
+//|     """
+//|     ...
+//|
+static mp_obj_t uheap_snapshot(mp_obj_t dest) {
+    return mp_obj_new_int_from_uint(shared_module_uheap_snapshot(dest));
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(uheap_snapshot_obj, uheap_snapshot);
+
 static const mp_rom_map_elem_t uheap_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_uheap) },
     { MP_ROM_QSTR(MP_QSTR_info), MP_ROM_PTR(&uheap_info_obj) },
+    { MP_ROM_QSTR(MP_QSTR_snapshot), MP_ROM_PTR(&uheap_snapshot_obj) },
 };
 
 static MP_DEFINE_CONST_DICT(uheap_module_globals, uheap_module_globals_table);
@@ -0,0 +1,142 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/usb/core/Device.h"
+#include "shared-bindings/usb/msc/BlockDevice.h"
+
+//| class BlockDevice:
+//|     """A USB mass storage device, such as a flash drive, attached to the
+//|     USB host port. Usually used with ``storage.VfsFat`` to read and write
+//|     files on the drive. Only drives with 512 byte blocks are supported.
+//|
+//|     Each read or write of many blocks is sent as one SCSI command, and its
+//|     data as a single transfer that the host controller splits into packets,
+//|     so large reads and writes do not return to Python between packets."""
+//|
+//|     def __init__(self, device: usb.core.Device, *, lun: int = 0) -> None:
+//|         """Start using a mass storage device. The device's configuration is
+//|         set if it has not been already. Waits up to a few seconds for a drive
+//|         that was just plugged in to become ready.
+//|
+//|         :param usb.core.Device device: the device to use
+//|         :param int lun: the logical unit to use, for devices with more than one
+//|
+//|         Example usage:
+//|
+//|         .. code-block:: python
+//|
+//|             import os
+//|
+//|             import storage
+//|             import usb.core
+//|             import usb.msc
+//|
+//|             device = usb.core.find()
+//|             drive = usb.msc.BlockDevice(device)
+//|             storage.mount(storage.VfsFat(drive), "/usb")
+//|             os.listdir("/usb")"""
+//|
+static mp_obj_t usb_msc_blockdevice_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_device, ARG_lun };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_device, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_lun, MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = 0} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    usb_core_device_obj_t *device = MP_OBJ_TO_PTR(mp_arg_validate_type(args[ARG_device].u_obj, &usb_core_device_type, MP_QSTR_device));
+    mp_int_t lun = mp_arg_validate_int_range(args[ARG_lun].u_int, 0, 15, MP_QSTR_lun);
+
+    usb_msc_blockdevice_obj_t *self = mp_obj_malloc(usb_msc_blockdevice_obj_t, &usb_msc_blockdevice_type);
+    common_hal_usb_msc_blockdevice_construct(self, device, lun);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+//|     def count(self) -> int:
+//|         """Returns the total number of blocks
+//|
+//|         :return: The number of 512-byte blocks, as a number"""
+static mp_obj_t usb_msc_blockdevice_count(mp_obj_t self_in) {
+    usb_msc_blockdevice_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_int_from_uint(common_hal_usb_msc_blockdevice_get_block_count(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(usb_msc_blockdevice_count_obj, usb_msc_blockdevice_count);
+
+//|     def readblocks(self, start_block: int, buf: WriteableBuffer) -> None:
+//|         """Read one or more blocks from the drive
+//|
+//|         :param int start_block: The block to start reading from
+//|         :param ~circuitpython_typing.WriteableBuffer buf: The buffer to write into.  Length must be multiple of 512.
+//|
+//|         :return: None"""
+static mp_obj_t _usb_msc_blockdevice_readblocks(mp_obj_t self_in, mp_obj_t start_block_in, mp_obj_t buf_in) {
+    usb_msc_blockdevice_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    uint32_t start_block = mp_obj_get_int(start_block_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_WRITE);
+    int result = common_hal_usb_msc_blockdevice_readblocks(self, start_block, &bufinfo);
+    if (result != 0) {
+        mp_raise_OSError(result);
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_3(usb_msc_blockdevice_readblocks_obj, _usb_msc_blockdevice_readblocks);
+
+//|     def sync(self) -> None:
+//|         """Ask the drive to commit any blocks it has cached
+//|
+//|         :return: None"""
+//|         ...
+static mp_obj_t usb_msc_blockdevice_sync(mp_obj_t self_in) {
+    usb_msc_blockdevice_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    int result = common_hal_usb_msc_blockdevice_sync(self);
+    if (result != 0) {
+        mp_raise_OSError(result);
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(usb_msc_blockdevice_sync_obj, usb_msc_blockdevice_sync);
+
+//|     def writeblocks(self, start_block: int, buf: ReadableBuffer) -> None:
+//|         """Write one or more blocks to the drive
+//|
+//|         :param int start_block: The block to start writing from
+//|         :param ~circuitpython_typing.ReadableBuffer buf: The buffer to read from.  Length must be multiple of 512.
+//|
+//|         :return: None"""
+//|
+static mp_obj_t _usb_msc_blockdevice_writeblocks(mp_obj_t self_in, mp_obj_t start_block_in, mp_obj_t buf_in) {
+    usb_msc_blockdevice_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    uint32_t start_block = mp_obj_get_int(start_block_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_READ);
+    int result = common_hal_usb_msc_blockdevice_writeblocks(self, start_block, &bufinfo);
+    if (result != 0) {
+        mp_raise_OSError(result);
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_3(usb_msc_blockdevice_writeblocks_obj, _usb_msc_blockdevice_writeblocks);
+
+static const mp_rom_map_elem_t usb_msc_blockdevice_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_count), MP_ROM_PTR(&usb_msc_blockdevice_count_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readblocks), MP_ROM_PTR(&usb_msc_blockdevice_readblocks_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sync), MP_ROM_PTR(&usb_msc_blockdevice_sync_obj) },
+    { MP_ROM_QSTR(MP_QSTR_writeblocks), MP_ROM_PTR(&usb_msc_blockdevice_writeblocks_obj) },
+};
+static MP_DEFINE_CONST_DICT(usb_msc_blockdevice_locals_dict, usb_msc_blockdevice_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    usb_msc_blockdevice_type,
+    MP_QSTR_BlockDevice,
+    MP_TYPE_FLAG_NONE,
+    make_new, usb_msc_blockdevice_make_new,
+    locals_dict, &usb_msc_blockdevice_locals_dict
+    );
@@ -0,0 +1,22 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "shared-module/usb/msc/BlockDevice.h"
+
+extern const mp_obj_type_t usb_msc_blockdevice_type;
+
+void common_hal_usb_msc_blockdevice_construct(usb_msc_blockdevice_obj_t *self, usb_core_device_obj_t *device, uint8_t lun);
+uint32_t common_hal_usb_msc_blockdevice_get_block_count(usb_msc_blockdevice_obj_t *self);
+int common_hal_usb_msc_blockdevice_readblocks(usb_msc_blockdevice_obj_t *self, uint32_t start_block, mp_buffer_info_t *buf);
+int common_hal_usb_msc_blockdevice_writeblocks(usb_msc_blockdevice_obj_t *self, uint32_t start_block, mp_buffer_info_t *buf);
+int common_hal_usb_msc_blockdevice_sync(usb_msc_blockdevice_obj_t *self);
+
+// Used by native vfs blockdev.
+mp_uint_t usb_msc_blockdevice_readblocks(mp_obj_t self_in, uint8_t *buf, uint32_t start_block, uint32_t nblocks);
+mp_uint_t usb_msc_blockdevice_writeblocks(mp_obj_t self_in, uint8_t *buf, uint32_t start_block, uint32_t nblocks);
+bool usb_msc_blockdevice_ioctl(mp_obj_t self_in, size_t cmd, size_t arg, mp_int_t *out_value);
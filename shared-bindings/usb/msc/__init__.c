@@ -0,0 +1,32 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/usb/msc/__init__.h"
+#include "shared-bindings/usb/msc/BlockDevice.h"
+
+//| """USB mass storage host
+//|
+//| Use a USB flash drive, or another USB mass storage device, plugged into a
+//| USB host port as a block device for `storage.VfsFat`.
+//| """
+//|
+
+static mp_rom_map_elem_t usb_msc_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__),        MP_OBJ_NEW_QSTR(MP_QSTR_usb_dot_msc) },
+    { MP_ROM_QSTR(MP_QSTR_BlockDevice),     MP_OBJ_FROM_PTR(&usb_msc_blockdevice_type) },
+};
+
+static MP_DEFINE_CONST_DICT(usb_msc_module_globals, usb_msc_module_globals_table);
+
+const mp_obj_module_t usb_msc_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t *)&usb_msc_module_globals,
+};
+
+MP_REGISTER_MODULE(MP_QSTR_usb_dot_msc, usb_msc_module);
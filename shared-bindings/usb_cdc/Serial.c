@@ -71,6 +71,15 @@
 //|         :rtype: int"""
 //|         ...
 //|
+//|     def start_write(self, buf: ReadableBuffer) -> None:
+//|         """Queue all of ``buf`` to be sent in the background and return immediately.
+//|         Bytes are copied straight from ``buf`` into the USB transmit buffer as
+//|         earlier packets go out, so ``buf`` must not be changed until
+//|         `write_in_progress` is ``False``. Only one buffer can be queued at a time.
+//|         `write()` waits, subject to `write_timeout`, until the queued buffer is sent.
+//|         `reset_output_buffer()` cancels it."""
+//|         ...
+//|
 //|     def flush(self) -> None:
 //|         """Force out any unwritten bytes, waiting until they are written."""
 //|         ...
@@ -115,6 +124,15 @@ static mp_uint_t usb_cdc_serial_ioctl_stream(mp_obj_t self_in, mp_uint_t request
             common_hal_usb_cdc_serial_flush(self);
             break;
 
+        #if MICROPY_PY_SELECT_POLL_GEN
+        case MP_STREAM_GET_POLL_GEN: {
+            mp_stream_poll_gen_t *poll_gen = (mp_stream_poll_gen_t *)arg;
+            poll_gen->counter = &self->poll_gen;
+            poll_gen->events = MP_STREAM_POLL_RD | MP_STREAM_POLL_WR;
+            break;
+        }
+        #endif
+
         default:
             *errcode = MP_EINVAL;
             ret = MP_STREAM_ERROR;
@@ -122,6 +140,15 @@ static mp_uint_t usb_cdc_serial_ioctl_stream(mp_obj_t self_in, mp_uint_t request
     return ret;
 }
 
+static mp_obj_t usb_cdc_serial_start_write(mp_obj_t self_in, mp_obj_t buf_in) {
+    usb_cdc_serial_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_READ);
+    common_hal_usb_cdc_serial_start_write(self, buf_in, bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(usb_cdc_serial_start_write_obj, usb_cdc_serial_start_write);
+
 //|     connected: bool
 //|     """True if this Serial is connected to a host. (read-only)
 //|
@@ -160,6 +187,17 @@ MP_DEFINE_CONST_FUN_OBJ_1(usb_cdc_serial_get_out_waiting_obj, usb_cdc_serial_get
 MP_PROPERTY_GETTER(usb_cdc_serial_out_waiting_obj,
     (mp_obj_t)&usb_cdc_serial_get_out_waiting_obj);
 
+//|     write_in_progress: bool
+//|     """True while a buffer passed to `start_write()` is still being sent. (read-only)"""
+static mp_obj_t usb_cdc_serial_get_write_in_progress(mp_obj_t self_in) {
+    usb_cdc_serial_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool(common_hal_usb_cdc_serial_get_write_in_progress(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(usb_cdc_serial_get_write_in_progress_obj, usb_cdc_serial_get_write_in_progress);
+
+MP_PROPERTY_GETTER(usb_cdc_serial_write_in_progress_obj,
+    (mp_obj_t)&usb_cdc_serial_get_write_in_progress_obj);
+
 //|     def reset_input_buffer(self) -> None:
 //|         """Clears any unread bytes."""
 //|         ...
@@ -246,6 +284,8 @@ static const mp_rom_map_elem_t usb_cdc_serial_locals_dict_table[] = {
 
     // Not in pyserial protocol.
     { MP_OBJ_NEW_QSTR(MP_QSTR_connected),     MP_ROM_PTR(&usb_cdc_serial_connected_obj) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_start_write),   MP_ROM_PTR(&usb_cdc_serial_start_write_obj) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_write_in_progress), MP_ROM_PTR(&usb_cdc_serial_write_in_progress_obj) },
 
 
 
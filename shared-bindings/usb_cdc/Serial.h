@@ -12,6 +12,8 @@ extern const mp_obj_type_t usb_cdc_serial_type;
 
 extern size_t common_hal_usb_cdc_serial_read(usb_cdc_serial_obj_t *self, uint8_t *data, size_t len, int *errcode);
 extern size_t common_hal_usb_cdc_serial_write(usb_cdc_serial_obj_t *self, const uint8_t *data, size_t len, int *errcode);
+extern void common_hal_usb_cdc_serial_start_write(usb_cdc_serial_obj_t *self, mp_obj_t obj, const uint8_t *data, size_t len);
+extern bool common_hal_usb_cdc_serial_get_write_in_progress(usb_cdc_serial_obj_t *self);
 
 extern uint32_t common_hal_usb_cdc_serial_get_in_waiting(usb_cdc_serial_obj_t *self);
 extern uint32_t common_hal_usb_cdc_serial_get_out_waiting(usb_cdc_serial_obj_t *self);
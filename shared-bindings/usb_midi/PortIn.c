@@ -9,6 +9,7 @@
 #include "shared-bindings/usb_midi/PortIn.h"
 #include "shared-bindings/util.h"
 
+#include "py/binary.h"
 #include "py/stream.h"
 #include "py/objproperty.h"
 #include "py/runtime.h"
@@ -44,6 +45,55 @@
 //|         :rtype: bytes or None"""
 //|         ...
 //|
+//|     def read_packets(
+//|         self, packets: WriteableBuffer, timestamps: Optional[WriteableBuffer] = None
+//|     ) -> int:
+//|         """Read the 4-byte USB-MIDI event packets that have already arrived into ``packets``,
+//|         without waiting and without parsing or allocating. Each packet is the cable number
+//|         and code index byte followed by up to three MIDI bytes, as sent by the host.
+//|
+//|         If ``timestamps`` is given, it must be an ``array.array`` of 32-bit unsigned
+//|         integers, such as ``array.array("L", ...)``. The time each packet arrived is stored in
+//|         it, in microseconds from the same clock as `time.monotonic_ns()`, wrapping around
+//|         every 2**32 microseconds. Packets that have waited through more than one USB
+//|         transfer get the time of the first one.
+//|
+//|         Don't mix this with the byte stream methods on the same data, because `read()` keeps
+//|         partly read packets to itself.
+//|
+//|         :return: the number of packets read, which may be 0
+//|         :rtype: int"""
+//|         ...
+//|
+static mp_obj_t usb_midi_portin_read_packets(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    usb_midi_portin_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    enum { ARG_packets, ARG_timestamps };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_packets, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_timestamps, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_buffer_info_t packets_info;
+    mp_get_buffer_raise(args[ARG_packets].u_obj, &packets_info, MP_BUFFER_WRITE);
+    size_t count = packets_info.len / 4;
+
+    uint32_t *timestamps = NULL;
+    if (args[ARG_timestamps].u_obj != mp_const_none) {
+        mp_buffer_info_t timestamps_info;
+        mp_get_buffer_raise(args[ARG_timestamps].u_obj, &timestamps_info, MP_BUFFER_WRITE);
+        if (mp_binary_get_size('@', timestamps_info.typecode, NULL) != sizeof(uint32_t)) {
+            mp_raise_ValueError_varg(MP_ERROR_TEXT("%q must be array of type 'L'"), MP_QSTR_timestamps);
+        }
+        timestamps = timestamps_info.buf;
+        count = MIN(count, timestamps_info.len / sizeof(uint32_t));
+    }
+
+    return MP_OBJ_NEW_SMALL_INT(common_hal_usb_midi_portin_read_packets(self, packets_info.buf, timestamps, count));
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(usb_midi_portin_read_packets_obj, 1, usb_midi_portin_read_packets);
+
 
 // These three methods are used by the shared stream methods.
 static mp_uint_t usb_midi_portin_read(mp_obj_t self_in, void *buf_in, mp_uint_t size, int *errcode) {
@@ -78,6 +128,8 @@ static const mp_rom_map_elem_t usb_midi_portin_locals_dict_table[] = {
     // Standard stream methods.
     { MP_OBJ_NEW_QSTR(MP_QSTR_read),     MP_ROM_PTR(&mp_stream_read_obj) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&mp_stream_readinto_obj) },
+
+    { MP_ROM_QSTR(MP_QSTR_read_packets), MP_ROM_PTR(&usb_midi_portin_read_packets_obj) },
 };
 static MP_DEFINE_CONST_DICT(usb_midi_portin_locals_dict, usb_midi_portin_locals_dict_table);
 
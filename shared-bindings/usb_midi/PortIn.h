@@ -14,5 +14,8 @@ extern const mp_obj_type_t usb_midi_portin_type;
 extern size_t common_hal_usb_midi_portin_read(usb_midi_portin_obj_t *self,
     uint8_t *data, size_t len, int *errcode);
 
+extern size_t common_hal_usb_midi_portin_read_packets(usb_midi_portin_obj_t *self,
+    uint8_t *packets, uint32_t *timestamps, size_t count);
+
 extern uint32_t common_hal_usb_midi_portin_bytes_available(usb_midi_portin_obj_t *self);
 extern void common_hal_usb_midi_portin_clear_buffer(usb_midi_portin_obj_t *self);
@@ -32,6 +32,24 @@
 //|         :rtype: int or None"""
 //|         ...
 //|
+//|     def write_packets(self, packets: ReadableBuffer) -> int:
+//|         """Queue prebuilt 4-byte USB-MIDI event packets to send to the host, without
+//|         waiting. Packets are sent as they are, so the cable number and code index in the
+//|         first byte of each one must be right. Only whole packets are taken from ``packets``.
+//|
+//|         :return: the number of packets queued, which is less than the number given when
+//|           the transmit buffer fills up
+//|         :rtype: int"""
+//|         ...
+//|
+static mp_obj_t usb_midi_portout_write_packets(mp_obj_t self_in, mp_obj_t packets_in) {
+    usb_midi_portout_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(packets_in, &bufinfo, MP_BUFFER_READ);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_usb_midi_portout_write_packets(self, bufinfo.buf, bufinfo.len / 4));
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(usb_midi_portout_write_packets_obj, usb_midi_portout_write_packets);
+
 
 static mp_uint_t usb_midi_portout_write(mp_obj_t self_in, const void *buf_in, mp_uint_t size, int *errcode) {
     usb_midi_portout_obj_t *self = MP_OBJ_TO_PTR(self_in);
@@ -59,6 +77,8 @@ static mp_uint_t usb_midi_portout_ioctl(mp_obj_t self_in, mp_uint_t request, mp_
 static const mp_rom_map_elem_t usb_midi_portout_locals_dict_table[] = {
     // Standard stream methods.
     { MP_OBJ_NEW_QSTR(MP_QSTR_write),    MP_ROM_PTR(&mp_stream_write_obj) },
+
+    { MP_ROM_QSTR(MP_QSTR_write_packets), MP_ROM_PTR(&usb_midi_portout_write_packets_obj) },
 };
 static MP_DEFINE_CONST_DICT(usb_midi_portout_locals_dict, usb_midi_portout_locals_dict_table);
 
@@ -14,4 +14,7 @@ extern const mp_obj_type_t usb_midi_portout_type;
 extern size_t common_hal_usb_midi_portout_write(usb_midi_portout_obj_t *self,
     const uint8_t *data, size_t len, int *errcode);
 
+extern size_t common_hal_usb_midi_portout_write_packets(usb_midi_portout_obj_t *self,
+    const uint8_t *packets, size_t count);
+
 extern bool common_hal_usb_midi_portout_ready_to_tx(usb_midi_portout_obj_t *self);
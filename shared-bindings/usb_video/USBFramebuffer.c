@@ -48,7 +48,7 @@ static mp_obj_t usb_video_uvcframebuffer_make_new(const mp_obj_type_t *type, siz
 static mp_obj_t usb_video_uvcframebuffer_refresh(mp_obj_t self_in) {
     usb_video_uvcframebuffer_obj_t *self = (usb_video_uvcframebuffer_obj_t *)self_in;
     check_for_deinit(self);
-    shared_module_usb_video_uvcframebuffer_refresh(self);
+    shared_module_usb_video_uvcframebuffer_refresh(self, NULL);
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_1(usb_video_uvcframebuffer_refresh_obj, usb_video_uvcframebuffer_refresh);
@@ -91,8 +91,7 @@ static void usb_video_uvcframebuffer_get_bufinfo(mp_obj_t self_in, mp_buffer_inf
 // These version exists so that the prototype matches the protocol,
 // avoiding a type cast that can hide errors
 static void usb_video_uvcframebuffer_swapbuffers(mp_obj_t self_in, uint8_t *dirty_row_bitmap) {
-    (void)dirty_row_bitmap;
-    shared_module_usb_video_uvcframebuffer_refresh(self_in);
+    shared_module_usb_video_uvcframebuffer_refresh(self_in, dirty_row_bitmap);
 }
 
 static void usb_video_uvcframebuffer_deinit_proto(mp_obj_t self_in) {
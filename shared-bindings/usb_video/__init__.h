@@ -9,4 +9,5 @@
 #include "shared-module/displayio/Bitmap.h"
 bool shared_module_usb_video_enable(mp_int_t frame_width, mp_int_t frame_height);
 bool shared_module_usb_video_disable(void);
-void shared_module_usb_video_swapbuffers(void);
+// Mark rows to convert before the next frame goes out, NULL for all of them.
+void shared_module_usb_video_swapbuffers(const uint8_t *dirty_row_bitmap);
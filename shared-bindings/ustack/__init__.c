@@ -50,6 +50,84 @@ static mp_obj_t stack_usage(void) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_0(stack_usage_obj, stack_usage);
 
+#if MICROPY_STACK_HIGH_WATER
+//| def stack_high_water() -> int:
+//|     """Return the most stack seen in use since the VM started or `reset_high_water` was
+//|     called. Stack use is sampled where calls check for stack overflow, so the deepest C
+//|     functions can go a little further; the part of ``CIRCUITPY_STACK_SIZE`` kept back from
+//|     `stack_size` covers that."""
+//|     ...
+//|
+static mp_obj_t stack_high_water(void) {
+    return MP_OBJ_NEW_SMALL_INT(shared_module_ustack_stack_high_water());
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(stack_high_water_obj, stack_high_water);
+
+//| def reset_high_water() -> None:
+//|     """Start `stack_high_water` and `pystack_high_water` again from the current usage, for
+//|     example to measure one part of a program."""
+//|     ...
+//|
+static mp_obj_t reset_high_water(void) {
+    shared_module_ustack_reset_high_water();
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(reset_high_water_obj, reset_high_water);
+
+//| def headroom() -> Tuple[int, Optional[int]]:
+//|     """Return ``(stack, pystack)``, the bytes that were still free on each stack at its
+//|     high-water mark. A value near zero means a slightly deeper call would have raised
+//|     a ``RuntimeError``, and zero or less means one did. A large value is memory that
+//|     could go to the heap instead.
+//|     ``pystack`` is ``None`` when the Python stack is part of the C stack."""
+//|     ...
+//|
+static mp_obj_t headroom(void) {
+    mp_obj_t items[] = {
+        MP_OBJ_NEW_SMALL_INT((mp_int_t)shared_module_ustack_stack_size() - (mp_int_t)shared_module_ustack_stack_high_water()),
+        #if MICROPY_ENABLE_PYSTACK
+        MP_OBJ_NEW_SMALL_INT((mp_int_t)shared_module_ustack_pystack_size() - (mp_int_t)shared_module_ustack_pystack_high_water()),
+        #else
+        mp_const_none,
+        #endif
+    };
+    return mp_obj_new_tuple(MP_ARRAY_SIZE(items), items);
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(headroom_obj, headroom);
+#endif // MICROPY_STACK_HIGH_WATER
+
+#if MICROPY_ENABLE_PYSTACK
+//| def pystack_size() -> int:
+//|     """Return the size of the Python stack, set by ``CIRCUITPY_PYSTACK_SIZE``."""
+//|     ...
+//|
+static mp_obj_t pystack_size(void) {
+    return MP_OBJ_NEW_SMALL_INT(shared_module_ustack_pystack_size());
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(pystack_size_obj, pystack_size);
+
+//| def pystack_usage() -> int:
+//|     """Return how much of the Python stack is currently in use."""
+//|     ...
+//|
+static mp_obj_t pystack_usage(void) {
+    return MP_OBJ_NEW_SMALL_INT(shared_module_ustack_pystack_usage());
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(pystack_usage_obj, pystack_usage);
+
+#if MICROPY_STACK_HIGH_WATER
+//| def pystack_high_water() -> int:
+//|     """Return the most Python stack in use since the VM started or `reset_high_water`
+//|     was called."""
+//|     ...
+//|
+static mp_obj_t pystack_high_water(void) {
+    return MP_OBJ_NEW_SMALL_INT(shared_module_ustack_pystack_high_water());
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(pystack_high_water_obj, pystack_high_water);
+#endif
+#endif // MICROPY_ENABLE_PYSTACK
+
 static const mp_rom_map_elem_t ustack_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_ustack) },
     #if MICROPY_MAX_STACK_USAGE
@@ -57,6 +135,18 @@ static const mp_rom_map_elem_t ustack_module_globals_table[] = {
     #endif
     { MP_ROM_QSTR(MP_QSTR_stack_size), MP_ROM_PTR(&stack_size_obj) },
     { MP_ROM_QSTR(MP_QSTR_stack_usage), MP_ROM_PTR(&stack_usage_obj) },
+    #if MICROPY_STACK_HIGH_WATER
+    { MP_ROM_QSTR(MP_QSTR_stack_high_water), MP_ROM_PTR(&stack_high_water_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset_high_water), MP_ROM_PTR(&reset_high_water_obj) },
+    { MP_ROM_QSTR(MP_QSTR_headroom), MP_ROM_PTR(&headroom_obj) },
+    #endif
+    #if MICROPY_ENABLE_PYSTACK
+    { MP_ROM_QSTR(MP_QSTR_pystack_size), MP_ROM_PTR(&pystack_size_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pystack_usage), MP_ROM_PTR(&pystack_usage_obj) },
+    #if MICROPY_STACK_HIGH_WATER
+    { MP_ROM_QSTR(MP_QSTR_pystack_high_water), MP_ROM_PTR(&pystack_high_water_obj) },
+    #endif
+    #endif
 };
 
 static MP_DEFINE_CONST_DICT(ustack_module_globals, ustack_module_globals_table);
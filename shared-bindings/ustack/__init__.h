@@ -13,3 +13,14 @@ extern uint32_t shared_module_ustack_max_stack_usage(void);
 #endif
 extern uint32_t shared_module_ustack_stack_size(void);
 extern uint32_t shared_module_ustack_stack_usage(void);
+#if MICROPY_STACK_HIGH_WATER
+extern uint32_t shared_module_ustack_stack_high_water(void);
+extern void shared_module_ustack_reset_high_water(void);
+#endif
+#if MICROPY_ENABLE_PYSTACK
+extern uint32_t shared_module_ustack_pystack_size(void);
+extern uint32_t shared_module_ustack_pystack_usage(void);
+#if MICROPY_STACK_HIGH_WATER
+extern uint32_t shared_module_ustack_pystack_high_water(void);
+#endif
+#endif
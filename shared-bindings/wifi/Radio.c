@@ -423,7 +423,11 @@ MP_PROPERTY_GETTER(wifi_radio_ap_active_obj,
 //|         significantly because a full scan doesn't occur.
 //|
 //|         If ``bssid`` is given and not None, the scan will start at the first channel or the one given and
-//|         connect to the AP with the given ``bssid`` and ``ssid``."""
+//|         connect to the AP with the given ``bssid`` and ``ssid``.
+//|
+//|         On Espressif boards, when neither ``channel`` nor ``bssid`` is given, the AP and channel
+//|         last used for the same ``ssid`` are tried first, even after a reload or deep sleep. A full
+//|         scan is done if that AP doesn't answer."""
 //|         ...
 static mp_obj_t wifi_radio_connect(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_ssid, ARG_password, ARG_channel, ARG_bssid, ARG_timeout };
@@ -0,0 +1,127 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "py/mperrno.h"
+#include "py/runtime.h"
+#include "py/stream.h"
+
+#include "shared-bindings/zlib/Compress.h"
+
+//| class Compress:
+//|     """A compressor for data that is produced in pieces, such as a log that
+//|     is uploaded as it is written. Only a small window of history is kept, so
+//|     memory use does not grow with the size of the stream.
+//|
+//|     Create one with `zlib.compressobj`. When it was given a *stream*, the
+//|     compressed data is written to that stream as it is produced instead of
+//|     being returned, and the `Compress` can itself be written to like a
+//|     stream."""
+//|
+//|     def compress(self, data: ReadableBuffer) -> bytes:
+//|         """Compress *data*, returning the compressed bytes that are ready.
+//|         Some of the data may be held back until more arrives or `flush` is
+//|         called. Returns ``b""`` when writing to a stream.
+//|
+//|         :param ReadableBuffer data: the next piece of data to compress
+//|         """
+//|         ...
+//|
+static mp_obj_t zlib_compress_obj_compress(mp_obj_t self_in, mp_obj_t data) {
+    zlib_compress_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(data, &bufinfo, MP_BUFFER_READ);
+    return common_hal_zlib_compress_obj_compress(self, bufinfo.buf, bufinfo.len);
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(zlib_compress_obj_compress_obj, zlib_compress_obj_compress);
+
+//|     def flush(self, mode: int = zlib.Z_FINISH) -> bytes:
+//|         """Compress all the data held back and return it.
+//|
+//|         With `zlib.Z_FINISH` the stream is ended and the `Compress` cannot be
+//|         used again. With `zlib.Z_SYNC_FLUSH` everything given so far can be
+//|         decompressed from the output, and compression carries on.
+//|         `zlib.Z_FULL_FLUSH` also forgets the history, so a reader can start
+//|         decompressing raw data from this point.
+//|
+//|         :param int mode: the flush mode
+//|         """
+//|         ...
+//|
+static mp_obj_t zlib_compress_obj_flush(size_t n_args, const mp_obj_t *args) {
+    zlib_compress_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_int_t mode = ZLIB_Z_FINISH;
+    if (n_args > 1) {
+        mode = mp_obj_get_int(args[1]);
+        if (mode != ZLIB_Z_NO_FLUSH && mode != ZLIB_Z_SYNC_FLUSH && mode != ZLIB_Z_FULL_FLUSH && mode != ZLIB_Z_FINISH) {
+            mp_raise_ValueError_varg(MP_ERROR_TEXT("Invalid %q"), MP_QSTR_mode);
+        }
+    }
+    return common_hal_zlib_compress_obj_flush(self, mode);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(zlib_compress_obj_flush_obj, 1, 2, zlib_compress_obj_flush);
+
+//|     def write(self, buf: ReadableBuffer) -> int:
+//|         """Compress *buf* into the stream given to `zlib.compressobj`, and
+//|         return the number of bytes consumed. Lets the `Compress` be passed
+//|         where a writable stream is expected. `flush` must still be called to
+//|         end the compressed stream."""
+//|         ...
+//|
+static mp_uint_t zlib_compress_write(mp_obj_t self_in, const void *buf, mp_uint_t size, int *errcode) {
+    zlib_compress_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->stream == MP_OBJ_NULL) {
+        // There would be nowhere for the output to go.
+        *errcode = MP_EINVAL;
+        return MP_STREAM_ERROR;
+    }
+    common_hal_zlib_compress_obj_compress(self, buf, size);
+    return size;
+}
+
+static const mp_rom_map_elem_t zlib_compress_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_compress), MP_ROM_PTR(&zlib_compress_obj_compress_obj) },
+    { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&zlib_compress_obj_flush_obj) },
+    { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&mp_stream_write_obj) },
+};
+static MP_DEFINE_CONST_DICT(zlib_compress_locals_dict, zlib_compress_locals_dict_table);
+
+static const mp_stream_p_t zlib_compress_stream_p = {
+    .write = zlib_compress_write,
+    .is_text = false,
+};
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    zlib_compress_type,
+    MP_QSTR_Compress,
+    MP_TYPE_FLAG_NONE,
+    locals_dict, &zlib_compress_locals_dict,
+    protocol, &zlib_compress_stream_p
+    );
+
+mp_obj_t zlib_compress_obj_make_new(mp_int_t level, mp_int_t wbits, mp_obj_t stream) {
+    mp_arg_validate_int_range(level, -1, 9, MP_QSTR_level);
+    zlib_format_t format;
+    mp_int_t window_bits;
+    if (wbits >= -15 && wbits <= -8) {
+        format = ZLIB_FORMAT_RAW;
+        window_bits = -wbits;
+    } else if (wbits >= 8 && wbits <= 15) {
+        format = ZLIB_FORMAT_ZLIB;
+        window_bits = wbits;
+    } else if (wbits >= 24 && wbits <= 31) {
+        format = ZLIB_FORMAT_GZIP;
+        window_bits = wbits - 16;
+    } else {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("Invalid %q"), MP_QSTR_wbits);
+    }
+    if (stream != MP_OBJ_NULL) {
+        mp_get_stream_raise(stream, MP_STREAM_OP_WRITE);
+    }
+
+    zlib_compress_obj_t *self = mp_obj_malloc(zlib_compress_obj_t, &zlib_compress_type);
+    common_hal_zlib_compress_obj_construct(self, level, format, window_bits, stream);
+    return MP_OBJ_FROM_PTR(self);
+}
@@ -0,0 +1,19 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "shared-module/zlib/Compress.h"
+
+extern const mp_obj_type_t zlib_compress_type;
+
+void common_hal_zlib_compress_obj_construct(zlib_compress_obj_t *self, mp_int_t level, zlib_format_t format, mp_int_t window_bits, mp_obj_t stream);
+void common_hal_zlib_compress_obj_deinit(zlib_compress_obj_t *self);
+mp_obj_t common_hal_zlib_compress_obj_compress(zlib_compress_obj_t *self, const uint8_t *data, size_t len);
+mp_obj_t common_hal_zlib_compress_obj_flush(zlib_compress_obj_t *self, mp_int_t mode);
+
+// Checks the arguments of zlib.compressobj and returns a new Compress.
+mp_obj_t zlib_compress_obj_make_new(mp_int_t level, mp_int_t wbits, mp_obj_t stream);
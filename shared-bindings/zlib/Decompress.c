@@ -0,0 +1,125 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "py/objproperty.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/zlib/Decompress.h"
+
+//| class Decompress:
+//|     """A decompressor for data that arrives in pieces, such as from a socket
+//|     or a file read in chunks. Only a fixed-size window of history is kept, so
+//|     memory use does not grow with the size of the stream.
+//|
+//|     Create one with `zlib.decompressobj`."""
+//|
+//|     def decompress(self, data: ReadableBuffer, max_length: int = 0) -> bytes:
+//|         """Decompress *data*, returning the bytes it produces. Data that ends in
+//|         the middle of the compressed stream is kept until the next call.
+//|
+//|         If *max_length* is nonzero, at most that many bytes are returned and
+//|         the input not yet consumed is available in `unconsumed_tail`, which
+//|         must be passed to a later call.
+//|
+//|         :param ReadableBuffer data: the next piece of compressed data
+//|         :param int max_length: the maximum number of bytes to return, or 0 for no limit
+//|         """
+//|         ...
+//|
+static mp_obj_t zlib_decompress_obj_decompress(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_data, ARG_max_length };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_data, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_max_length, MP_ARG_INT, {.u_int = 0} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_data].u_obj, &bufinfo, MP_BUFFER_READ);
+    mp_int_t max_length = mp_arg_validate_int_min(args[ARG_max_length].u_int, 0, MP_QSTR_max_length);
+
+    return common_hal_zlib_decompress_obj_decompress(self, bufinfo.buf, bufinfo.len, max_length);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(zlib_decompress_obj_decompress_obj, 1, zlib_decompress_obj_decompress);
+
+//|     def flush(self, length: int = 0) -> bytes:
+//|         """Decompress whatever remains in `unconsumed_tail` and return it.
+//|
+//|         :param int length: ignored for compatibility with CPython only
+//|         """
+//|         ...
+//|
+static mp_obj_t zlib_decompress_obj_flush(size_t n_args, const mp_obj_t *args) {
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(common_hal_zlib_decompress_obj_get_unconsumed_tail(self), &bufinfo, MP_BUFFER_READ);
+    return common_hal_zlib_decompress_obj_decompress(self, bufinfo.buf, bufinfo.len, 0);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(zlib_decompress_obj_flush_obj, 1, 2, zlib_decompress_obj_flush);
+
+// Frees the dictionary of a stream that was dropped before its end.
+static mp_obj_t zlib_decompress_obj___del__(mp_obj_t self_in) {
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_zlib_decompress_obj_deinit(self);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(zlib_decompress_obj___del___obj, zlib_decompress_obj___del__);
+
+//|     eof: bool
+//|     """True once the end of the compressed stream has been reached. (read-only)"""
+//|
+static mp_obj_t zlib_decompress_obj_get_eof(mp_obj_t self_in) {
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool(common_hal_zlib_decompress_obj_get_eof(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(zlib_decompress_obj_get_eof_obj, zlib_decompress_obj_get_eof);
+
+MP_PROPERTY_GETTER(zlib_decompress_obj_eof_obj,
+    (mp_obj_t)&zlib_decompress_obj_get_eof_obj);
+
+//|     unused_data: bytes
+//|     """Data found after the end of the compressed stream. (read-only)"""
+//|
+static mp_obj_t zlib_decompress_obj_get_unused_data(mp_obj_t self_in) {
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return common_hal_zlib_decompress_obj_get_unused_data(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(zlib_decompress_obj_get_unused_data_obj, zlib_decompress_obj_get_unused_data);
+
+MP_PROPERTY_GETTER(zlib_decompress_obj_unused_data_obj,
+    (mp_obj_t)&zlib_decompress_obj_get_unused_data_obj);
+
+//|     unconsumed_tail: bytes
+//|     """Input not consumed by the last `decompress` call because its *max_length*
+//|     was reached. (read-only)"""
+//|
+static mp_obj_t zlib_decompress_obj_get_unconsumed_tail(mp_obj_t self_in) {
+    zlib_decompress_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return common_hal_zlib_decompress_obj_get_unconsumed_tail(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(zlib_decompress_obj_get_unconsumed_tail_obj, zlib_decompress_obj_get_unconsumed_tail);
+
+MP_PROPERTY_GETTER(zlib_decompress_obj_unconsumed_tail_obj,
+    (mp_obj_t)&zlib_decompress_obj_get_unconsumed_tail_obj);
+
+static const mp_rom_map_elem_t zlib_decompress_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&zlib_decompress_obj___del___obj) },
+    { MP_ROM_QSTR(MP_QSTR_decompress), MP_ROM_PTR(&zlib_decompress_obj_decompress_obj) },
+    { MP_ROM_QSTR(MP_QSTR_flush), MP_ROM_PTR(&zlib_decompress_obj_flush_obj) },
+    { MP_ROM_QSTR(MP_QSTR_eof), MP_ROM_PTR(&zlib_decompress_obj_eof_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unused_data), MP_ROM_PTR(&zlib_decompress_obj_unused_data_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unconsumed_tail), MP_ROM_PTR(&zlib_decompress_obj_unconsumed_tail_obj) },
+};
+static MP_DEFINE_CONST_DICT(zlib_decompress_locals_dict, zlib_decompress_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    zlib_decompress_type,
+    MP_QSTR_Decompress,
+    MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    locals_dict, &zlib_decompress_locals_dict
+    );
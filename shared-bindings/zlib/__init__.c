@@ -18,12 +18,28 @@
 #include "py/parsenum.h"
 
 #include "shared-bindings/zlib/__init__.h"
+#include "shared-bindings/zlib/Compress.h"
+#include "shared-bindings/zlib/Decompress.h"
 
-//| """zlib decompression functionality
+//| """zlib compression and decompression functionality
 //|
 //| The `zlib` module allows limited functionality similar to the CPython zlib library.
-//| This module allows to decompress binary data compressed with DEFLATE algorithm
-//| (commonly used in zlib library and gzip archiver). Compression is not yet implemented."""
+//| This module allows to compress and decompress binary data with the DEFLATE algorithm
+//| (commonly used in zlib library and gzip archiver). Compression uses a history
+//| window of at most 4096 bytes and the fixed Huffman codes, so it is fast and small
+//| but does not compress as well as CPython."""
+//|
+//| DEFLATED: int
+//| """The compression method, for `compressobj`."""
+//|
+//| Z_SYNC_FLUSH: int
+//| """Flush mode for `Compress.flush` that keeps the stream going."""
+//|
+//| Z_FULL_FLUSH: int
+//| """Flush mode for `Compress.flush` that keeps the stream going without its history."""
+//|
+//| Z_FINISH: int
+//| """Flush mode for `Compress.flush` that ends the stream."""
 //|
 
 //| def decompress(data: bytes, wbits: Optional[int] = 0, bufsize: Optional[int] = 0) -> bytes:
@@ -58,9 +74,100 @@ static mp_obj_t zlib_decompress(size_t n_args, const mp_obj_t *args) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(zlib_decompress_obj, 1, 3, zlib_decompress);
 
+//| def decompressobj(wbits: int = 15) -> Decompress:
+//|     """Return a `Decompress` object, for decompressing a stream that is too
+//|     large to hold in memory at once. *wbits* selects the format as for
+//|     `decompress`."""
+//|     ...
+//|
+static mp_obj_t zlib_decompressobj(size_t n_args, const mp_obj_t *args) {
+    mp_int_t wbits = 15;
+    if (n_args > 0) {
+        wbits = mp_obj_get_int(args[0]);
+    }
+
+    zlib_decompress_obj_t *self = m_new_obj_with_finaliser(zlib_decompress_obj_t);
+    self->base.type = &zlib_decompress_type;
+    common_hal_zlib_decompress_obj_construct(self, wbits);
+    return MP_OBJ_FROM_PTR(self);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(zlib_decompressobj_obj, 0, 1, zlib_decompressobj);
+
+//| def compress(data: ReadableBuffer, /, level: int = -1, wbits: int = 15) -> bytes:
+//|     """Return *data* compressed. *level* is from 0, which only finds no
+//|     matches, to 9, which searches hardest, or -1 for the default of 6.
+//|     *wbits* selects the format as for `decompress`. Its size, if larger than
+//|     12 (4096 bytes), is reduced to 12.
+//|
+//|     :param ReadableBuffer data: data to be compressed
+//|     :param int level: how hard to search for matches
+//|     :param int wbits: the format and history window size
+//|     """
+//|     ...
+//|
+static mp_obj_t zlib_compress(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_data, ARG_level, ARG_wbits };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_data, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_level, MP_ARG_INT, {.u_int = -1} },
+        { MP_QSTR_wbits, MP_ARG_INT, {.u_int = 15} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[ARG_data].u_obj, &bufinfo, MP_BUFFER_READ);
+    zlib_compress_obj_t *self = MP_OBJ_TO_PTR(zlib_compress_obj_make_new(args[ARG_level].u_int, args[ARG_wbits].u_int, MP_OBJ_NULL));
+    mp_obj_t head = common_hal_zlib_compress_obj_compress(self, bufinfo.buf, bufinfo.len);
+    return mp_binary_op(MP_BINARY_OP_ADD, head, common_hal_zlib_compress_obj_flush(self, ZLIB_Z_FINISH));
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(zlib_compress_obj, 1, zlib_compress);
+
+//| def compressobj(level: int = -1, method: int = DEFLATED, wbits: int = 15, *, stream: Optional[circuitpython_typing.ByteStream] = None) -> Compress:
+//|     """Return a `Compress` object, for compressing data that is produced in
+//|     pieces. *level* and *wbits* are as for `compress`, so *wbits* from 8 to
+//|     12 picks a window of 256 to 4096 bytes.
+//|
+//|     If *stream* is given, compressed data is written to it as it is produced,
+//|     a few bytes at a time, so no buffer for the output is needed. The stream
+//|     can be a file or a socket.
+//|
+//|     :param int level: how hard to search for matches
+//|     :param int method: must be `DEFLATED`
+//|     :param int wbits: the format and history window size
+//|     :param circuitpython_typing.ByteStream stream: where to write the compressed data
+//|     """
+//|     ...
+//|
+static mp_obj_t zlib_compressobj(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_level, ARG_method, ARG_wbits, ARG_stream };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_level, MP_ARG_INT, {.u_int = -1} },
+        { MP_QSTR_method, MP_ARG_INT, {.u_int = 8} },
+        { MP_QSTR_wbits, MP_ARG_INT, {.u_int = 15} },
+        { MP_QSTR_stream, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_arg_validate_int(args[ARG_method].u_int, 8, MP_QSTR_method);
+    mp_obj_t stream = args[ARG_stream].u_obj == mp_const_none ? MP_OBJ_NULL : args[ARG_stream].u_obj;
+    return zlib_compress_obj_make_new(args[ARG_level].u_int, args[ARG_wbits].u_int, stream);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(zlib_compressobj_obj, 0, zlib_compressobj);
+
 static const mp_rom_map_elem_t zlib_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_zlib) },
     { MP_ROM_QSTR(MP_QSTR_decompress), MP_ROM_PTR(&zlib_decompress_obj) },
+    { MP_ROM_QSTR(MP_QSTR_decompressobj), MP_ROM_PTR(&zlib_decompressobj_obj) },
+    { MP_ROM_QSTR(MP_QSTR_Decompress), MP_ROM_PTR(&zlib_decompress_type) },
+    { MP_ROM_QSTR(MP_QSTR_compress), MP_ROM_PTR(&zlib_compress_obj) },
+    { MP_ROM_QSTR(MP_QSTR_compressobj), MP_ROM_PTR(&zlib_compressobj_obj) },
+    { MP_ROM_QSTR(MP_QSTR_Compress), MP_ROM_PTR(&zlib_compress_type) },
+    { MP_ROM_QSTR(MP_QSTR_DEFLATED), MP_ROM_INT(8) },
+    { MP_ROM_QSTR(MP_QSTR_Z_SYNC_FLUSH), MP_ROM_INT(ZLIB_Z_SYNC_FLUSH) },
+    { MP_ROM_QSTR(MP_QSTR_Z_FULL_FLUSH), MP_ROM_INT(ZLIB_Z_FULL_FLUSH) },
+    { MP_ROM_QSTR(MP_QSTR_Z_FINISH), MP_ROM_INT(ZLIB_Z_FINISH) },
 };
 
 static MP_DEFINE_CONST_DICT(zlib_globals, zlib_globals_table);
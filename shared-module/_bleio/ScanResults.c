@@ -14,15 +14,58 @@
 #include "shared-bindings/_bleio/ScanEntry.h"
 #include "shared-bindings/_bleio/ScanResults.h"
 
-bleio_scanresults_obj_t *shared_module_bleio_new_scanresults(size_t buffer_size, uint8_t *prefixes, size_t prefixes_len, mp_int_t minimum_rssi) {
+bleio_scanresults_obj_t *shared_module_bleio_new_scanresults(size_t buffer_size, uint8_t *prefixes, size_t prefixes_len, mp_int_t minimum_rssi,
+    uint8_t *addresses, size_t addresses_length, mp_int_t duplicate_timeout_ms) {
     bleio_scanresults_obj_t *self = mp_obj_malloc(bleio_scanresults_obj_t, &bleio_scanresults_type);
     ringbuf_alloc(&self->buf, buffer_size);
     self->prefixes = prefixes;
     self->prefix_length = prefixes_len;
     self->minimum_rssi = minimum_rssi;
+    self->addresses = addresses;
+    self->addresses_length = addresses_length;
+    self->duplicate_timeout_ms = duplicate_timeout_ms;
+    self->seen = NULL;
+    if (duplicate_timeout_ms > 0) {
+        self->seen = m_malloc0(CIRCUITPY_BLEIO_SCAN_DUPLICATE_COUNT * sizeof(bleio_scanresults_seen_t));
+    }
     return self;
 }
 
+static bool address_included(bleio_scanresults_obj_t *self, const uint8_t *peer_addr) {
+    if (self->addresses_length == 0) {
+        return true;
+    }
+    for (size_t i = 0; i < self->addresses_length; i += NUM_BLEIO_ADDRESS_BYTES) {
+        if (memcmp(self->addresses + i, peer_addr, NUM_BLEIO_ADDRESS_BYTES) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns the entry for the address and kind of packet, or the one to reuse for it.
+static bleio_scanresults_seen_t *find_seen(bleio_scanresults_obj_t *self, const uint8_t *peer_addr,
+    bool scan_response, bool *found) {
+    bleio_scanresults_seen_t *oldest = &self->seen[0];
+    for (size_t i = 0; i < CIRCUITPY_BLEIO_SCAN_DUPLICATE_COUNT; i++) {
+        bleio_scanresults_seen_t *seen = &self->seen[i];
+        if (!seen->used) {
+            *found = false;
+            return seen;
+        }
+        if (seen->scan_response == scan_response &&
+            memcmp(seen->address, peer_addr, NUM_BLEIO_ADDRESS_BYTES) == 0) {
+            *found = true;
+            return seen;
+        }
+        if (seen->ticks_ms < oldest->ticks_ms) {
+            oldest = seen;
+        }
+    }
+    *found = false;
+    return oldest;
+}
+
 mp_obj_t common_hal_bleio_scanresults_next(bleio_scanresults_obj_t *self) {
     while (ringbuf_num_filled(&self->buf) == 0 && !self->done && !mp_hal_is_interrupted()) {
         RUN_BACKGROUND_TASKS;
@@ -86,6 +129,20 @@ void shared_module_bleio_scanresults_append(bleio_scanresults_obj_t *self,
     if (!bleio_scanentry_data_matches(data, len, self->prefixes, self->prefix_length, true)) {
         return;
     }
+
+    if (!address_included(self, peer_addr)) {
+        return;
+    }
+
+    // Drop the packet if one like it from the same address was queued recently.
+    bleio_scanresults_seen_t *seen = NULL;
+    if (self->seen != NULL) {
+        bool found;
+        seen = find_seen(self, peer_addr, scan_response, &found);
+        if (found && ticks_ms - seen->ticks_ms < (uint64_t)self->duplicate_timeout_ms) {
+            return;
+        }
+    }
     uint8_t type = 0;
     if (connectable) {
         type |= 1 << 0;
@@ -111,6 +168,13 @@ void shared_module_bleio_scanresults_append(bleio_scanresults_obj_t *self,
         ringbuf_put(&self->buf, addr_type);
         ringbuf_put_n(&self->buf, (uint8_t *)&len, sizeof(len));
         ringbuf_put_n(&self->buf, data, len);
+
+        if (seen != NULL) {
+            memcpy(seen->address, peer_addr, NUM_BLEIO_ADDRESS_BYTES);
+            seen->scan_response = scan_response;
+            seen->ticks_ms = ticks_ms;
+            seen->used = true;
+        }
     }
 
     common_hal_mcu_enable_interrupts();
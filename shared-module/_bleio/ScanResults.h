@@ -11,6 +11,20 @@
 
 #include "py/obj.h"
 #include "py/ringbuf.h"
+#include "shared-module/_bleio/Address.h"
+
+// How many addresses are remembered to drop duplicates. The least recently
+// queued one is forgotten to make room for a new one.
+#ifndef CIRCUITPY_BLEIO_SCAN_DUPLICATE_COUNT
+#define CIRCUITPY_BLEIO_SCAN_DUPLICATE_COUNT (64)
+#endif
+
+typedef struct {
+    uint64_t ticks_ms;
+    uint8_t address[NUM_BLEIO_ADDRESS_BYTES];
+    bool scan_response;
+    bool used;
+} bleio_scanresults_seen_t;
 
 typedef struct {
     mp_obj_base_t base;
@@ -21,11 +35,19 @@ typedef struct {
     uint8_t *prefixes;
     size_t prefix_length;
     mp_int_t minimum_rssi;
+    // Addresses to include, NUM_BLEIO_ADDRESS_BYTES each. Empty includes all.
+    uint8_t *addresses;
+    size_t addresses_length;
+    // Entries from an address are dropped for this long after one is queued.
+    mp_int_t duplicate_timeout_ms;
+    // CIRCUITPY_BLEIO_SCAN_DUPLICATE_COUNT entries, or NULL without a duplicate_timeout_ms.
+    bleio_scanresults_seen_t *seen;
     bool active;
     bool done;
 } bleio_scanresults_obj_t;
 
-bleio_scanresults_obj_t *shared_module_bleio_new_scanresults(size_t buffer_size, uint8_t *prefixes, size_t prefixes_len, mp_int_t minimum_rssi);
+bleio_scanresults_obj_t *shared_module_bleio_new_scanresults(size_t buffer_size, uint8_t *prefixes, size_t prefixes_len, mp_int_t minimum_rssi,
+    uint8_t *addresses, size_t addresses_length, mp_int_t duplicate_timeout_ms);
 
 bool shared_module_bleio_scanresults_get_done(bleio_scanresults_obj_t *self);
 void shared_module_bleio_scanresults_set_done(bleio_scanresults_obj_t *self, bool done);
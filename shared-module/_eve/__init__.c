@@ -6,6 +6,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include "py/runtime.h"
 #include "shared-bindings/_eve/__init__.h"
 #include "shared-module/_eve/__init__.h"
@@ -33,11 +34,7 @@ static void *append(common_hal__eve_t *eve, size_t m) {
 
 void common_hal__eve_add(common_hal__eve_t *eve, size_t len, void *buf) {
     if (len <= sizeof(eve->buf)) {
-        uint8_t *p = (uint8_t *)append(eve, len);
-        // memcpy(p, buffer_info.buf, buffer_info.len);
-        uint8_t *s = buf;
-        for (size_t i = 0; i < len; i++) { *p++ = *s++;
-        }
+        memcpy(append(eve, len), buf, len);
     } else {
         common_hal__eve_flush(eve);
         write(eve, len, buf);
@@ -52,6 +49,32 @@ void common_hal__eve_Vertex2f(common_hal__eve_t *eve, mp_float_t x, mp_float_t y
     C4(eve, (1 << 30) | ((ix & 32767) << 15) | (iy & 32767));
 }
 
+void common_hal__eve_vertices(common_hal__eve_t *eve, const int16_t *coords, size_t n, bool ii) {
+    int vscale = eve->vscale;
+    while (n > 0) {
+        // Encode as many points as fit straight into the command buffer.
+        size_t room = (sizeof(eve->buf) - eve->n) / sizeof(uint32_t);
+        if (room == 0) {
+            common_hal__eve_flush(eve);
+            continue;
+        }
+        size_t chunk = MIN(n, room);
+        uint32_t *p = append(eve, chunk * sizeof(uint32_t));
+        if (ii) {
+            for (size_t i = 0; i < chunk; i++, coords += 2) {
+                *p++ = (2 << 30) | ((coords[0] & 511) << 21) | ((coords[1] & 511) << 12);
+            }
+        } else {
+            for (size_t i = 0; i < chunk; i++, coords += 2) {
+                int16_t ix = coords[0] * vscale;
+                int16_t iy = coords[1] * vscale;
+                *p++ = (1 << 30) | ((ix & 32767) << 15) | (iy & 32767);
+            }
+        }
+        n -= chunk;
+    }
+}
+
 void common_hal__eve_VertexFormat(common_hal__eve_t *eve, uint32_t frac) {
     C4(eve, ((39 << 24) | ((frac & 7))));
     eve->vscale = 1 << frac;
@@ -11,6 +11,36 @@
 #include "shared-bindings/_stage/Text.h"
 
 
+// The part of the stage a layer covers, so that it is only asked for the pixels in it.
+typedef struct {
+    mp_obj_t layer;
+    int16_t x1, y1, x2, y2;
+    bool text;
+} layer_span_t;
+
+static bool get_layer_span(mp_obj_t layer, layer_span_t *span) {
+    span->layer = layer;
+    layer_obj_t *obj = MP_OBJ_TO_PTR(layer);
+    if (obj->base.type == &mp_type_layer) {
+        span->text = false;
+        span->x1 = obj->x;
+        span->y1 = obj->y;
+        span->x2 = obj->x + (obj->width << 4);
+        span->y2 = obj->y + (obj->height << 4);
+        return true;
+    }
+    if (obj->base.type == &mp_type_text) {
+        text_obj_t *text = (text_obj_t *)obj;
+        span->text = true;
+        span->x1 = text->x;
+        span->y1 = text->y;
+        span->x2 = text->x + (text->width << 3);
+        span->y2 = text->y + (text->height << 3);
+        return true;
+    }
+    return false;
+}
+
 void render_stage(
     uint16_t x0, uint16_t y0,
     uint16_t x1, uint16_t y1,
@@ -20,31 +50,52 @@ void render_stage(
     busdisplay_busdisplay_obj_t *display,
     uint8_t scale, uint16_t background) {
 
+    // Only the layers that overlap the area, in drawing order.
+    layer_span_t spans[layers_size ? layers_size : 1];
+    size_t spans_size = 0;
+    for (size_t layer = 0; layer < layers_size; ++layer) {
+        layer_span_t *span = &spans[spans_size];
+        if (get_layer_span(layers[layer], span) &&
+            span->x1 < x1 + vx && span->x2 > x0 + vx &&
+            span->y1 < y1 + vy && span->y2 > y0 + vy) {
+            spans_size += 1;
+        }
+    }
+    // The layers that cover the current row.
+    layer_span_t *row_spans[spans_size ? spans_size : 1];
 
     displayio_area_t area;
     area.x1 = x0 * scale;
     area.y1 = y0 * scale;
     area.x2 = x1 * scale;
     area.y2 = y1 * scale;
-    displayio_display_bus_set_region_to_update(&display->bus, &display->core, &area);
-
     while (!displayio_display_bus_begin_transaction(&display->bus)) {
         RUN_BACKGROUND_TASKS;
     }
+    displayio_display_bus_send_region_to_update(&display->bus, &display->core, &area);
     display->bus.send(display->bus.bus, DISPLAY_COMMAND,
         CHIP_SELECT_TOGGLE_EVERY_BYTE,
         &display->write_ram_command, 1);
     size_t index = 0;
     for (int16_t y = y0 + vy; y < y1 + vy; ++y) {
+        size_t row_spans_size = 0;
+        for (size_t i = 0; i < spans_size; ++i) {
+            if (spans[i].y1 <= y && y < spans[i].y2) {
+                row_spans[row_spans_size++] = &spans[i];
+            }
+        }
         for (uint8_t yscale = 0; yscale < scale; ++yscale) {
             for (int16_t x = x0 + vx; x < x1 + vx; ++x) {
                 uint16_t c = TRANSPARENT;
-                for (size_t layer = 0; layer < layers_size; ++layer) {
-                    layer_obj_t *obj = MP_OBJ_TO_PTR(layers[layer]);
-                    if (obj->base.type == &mp_type_layer) {
-                        c = get_layer_pixel(obj, x, y);
-                    } else if (obj->base.type == &mp_type_text) {
-                        c = get_text_pixel((text_obj_t *)obj, x, y);
+                for (size_t i = 0; i < row_spans_size; ++i) {
+                    const layer_span_t *span = row_spans[i];
+                    if (x < span->x1 || x >= span->x2) {
+                        continue;
+                    }
+                    if (span->text) {
+                        c = get_text_pixel(MP_OBJ_TO_PTR(span->layer), x, y);
+                    } else {
+                        c = get_layer_pixel(MP_OBJ_TO_PTR(span->layer), x, y);
                     }
                     if (c != TRANSPARENT) {
                         break;
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: MIT
 
 
+#include "py/binary.h"
 #include "py/obj.h"
 #include "py/objstr.h"
 #include "py/objtype.h"
@@ -105,13 +106,24 @@ void common_hal_adafruit_pixelbuf_pixelbuf_set_brightness(mp_obj_t self_in, mp_f
         if (self->pre_brightness_buffer == NULL) {
             self->pre_brightness_buffer = m_malloc(pixel_len);
             memcpy(self->pre_brightness_buffer, self->post_brightness_buffer, pixel_len);
+            self->brightness_lut = m_malloc(256);
         }
-        for (size_t i = 0; i < pixel_len; i++) {
+        uint8_t *lut = self->brightness_lut;
+        for (size_t v = 0; v < 256; v++) {
+            lut[v] = (v * self->scaled_brightness) / 256;
+        }
+        if (self->byteorder.is_dotstar) {
             // Don't adjust per-pixel luminance bytes in dotstar mode
-            if (self->byteorder.is_dotstar && i % 4 == 0) {
-                continue;
+            for (size_t i = 0; i < pixel_len; i += 4) {
+                self->post_brightness_buffer[i] = self->pre_brightness_buffer[i];
+                self->post_brightness_buffer[i + 1] = lut[self->pre_brightness_buffer[i + 1]];
+                self->post_brightness_buffer[i + 2] = lut[self->pre_brightness_buffer[i + 2]];
+                self->post_brightness_buffer[i + 3] = lut[self->pre_brightness_buffer[i + 3]];
+            }
+        } else {
+            for (size_t i = 0; i < pixel_len; i++) {
+                self->post_brightness_buffer[i] = lut[self->pre_brightness_buffer[i]];
             }
-            self->post_brightness_buffer[i] = (self->pre_brightness_buffer[i] * self->scaled_brightness) / 256;
         }
 
         if (self->auto_write) {
@@ -182,43 +194,68 @@ void common_hal_adafruit_pixelbuf_pixelbuf_parse_color(mp_obj_t self_in, mp_obj_
     pixelbuf_parse_color(self, color, r, g, b, w);
 }
 
-static void pixelbuf_set_pixel_color(pixelbuf_pixelbuf_obj_t *self, size_t index, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
+// Lay out one pixel's bytes in buffer order, both as given and with brightness
+// applied. scaled is only filled in when there is a brightness to apply.
+static void pixelbuf_encode_pixel(pixelbuf_pixelbuf_obj_t *self, uint8_t r, uint8_t g, uint8_t b, uint8_t w,
+    uint8_t unscaled[4], uint8_t scaled[4]) {
     // DotStars don't have white, instead they have 5 bit brightness so pack it into w. Shift right
     // by three to leave the top five bits.
     if (self->bytes_per_pixel == 4 && self->byteorder.is_dotstar) {
         w = DOTSTAR_LED_START | w >> 3;
     }
     pixelbuf_rgbw_t *rgbw_order = &self->byteorder.byteorder;
+    if (self->bytes_per_pixel == 4) {
+        unscaled[rgbw_order->w] = w;
+    }
+    unscaled[rgbw_order->r] = r;
+    unscaled[rgbw_order->g] = g;
+    unscaled[rgbw_order->b] = b;
+
+    if (self->pre_brightness_buffer) {
+        const uint8_t *lut = self->brightness_lut;
+        if (self->bytes_per_pixel == 4) {
+            scaled[rgbw_order->w] = self->byteorder.is_dotstar ? w : lut[w];
+        }
+        scaled[rgbw_order->r] = lut[r];
+        scaled[rgbw_order->g] = lut[g];
+        scaled[rgbw_order->b] = lut[b];
+    }
+}
+
+static void pixelbuf_set_pixel_color(pixelbuf_pixelbuf_obj_t *self, size_t index, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
+    uint8_t unscaled[4], scaled[4];
+    pixelbuf_encode_pixel(self, r, g, b, w, unscaled, scaled);
     size_t offset = index * self->bytes_per_pixel;
-    uint8_t *scaled_buffer, *unscaled_buffer;
     if (self->pre_brightness_buffer) {
-        scaled_buffer = self->post_brightness_buffer + offset;
-        unscaled_buffer = self->pre_brightness_buffer + offset;
+        memcpy(self->pre_brightness_buffer + offset, unscaled, self->bytes_per_pixel);
+        memcpy(self->post_brightness_buffer + offset, scaled, self->bytes_per_pixel);
     } else {
-        scaled_buffer = NULL;
-        unscaled_buffer = self->post_brightness_buffer + offset;
+        memcpy(self->post_brightness_buffer + offset, unscaled, self->bytes_per_pixel);
     }
+}
 
-    if (self->bytes_per_pixel == 4) {
-        unscaled_buffer[rgbw_order->w] = w;
+// Repeat the first pattern_len bytes of buf over all of its len bytes.
+static void pixelbuf_repeat_pattern(uint8_t *buf, size_t pattern_len, size_t len) {
+    if (len == 0) {
+        return;
     }
-
-    unscaled_buffer[rgbw_order->r] = r;
-    unscaled_buffer[rgbw_order->g] = g;
-    unscaled_buffer[rgbw_order->b] = b;
-
-    if (scaled_buffer) {
-        if (self->bytes_per_pixel == 4) {
-            if (!self->byteorder.is_dotstar) {
-                w = (w * self->scaled_brightness) / 256;
-            }
-            scaled_buffer[rgbw_order->w] = w;
-        }
-        scaled_buffer[rgbw_order->r] = (r * self->scaled_brightness) / 256;
-        scaled_buffer[rgbw_order->g] = (g * self->scaled_brightness) / 256;
-        scaled_buffer[rgbw_order->b] = (b * self->scaled_brightness) / 256;
+    bool uniform = true;
+    for (size_t i = 1; i < pattern_len; i++) {
+        uniform &= buf[i] == buf[0];
+    }
+    if (uniform) {
+        memset(buf, buf[0], len);
+        return;
+    }
+    // Double the filled part each time so there are only log2(pixels) copies.
+    size_t filled = pattern_len;
+    while (filled < len) {
+        size_t n = MIN(filled, len - filled);
+        memcpy(buf + filled, buf, n);
+        filled += n;
     }
 }
+
 void common_hal_adafruit_pixelbuf_pixelbuf_set_pixel_color(mp_obj_t self_in, size_t index, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
     pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
     pixelbuf_set_pixel_color(self, index, r, g, b, w);
@@ -233,17 +270,45 @@ static void _pixelbuf_set_pixel(pixelbuf_pixelbuf_obj_t *self, size_t index, mp_
     common_hal_adafruit_pixelbuf_pixelbuf_set_pixel_color(self, index, r, g, b, w);
 }
 
+// Packed bytes, bpp per pixel in r, g, b[, w] order, as for a flattened sequence of values.
+static bool pixelbuf_set_pixels_from_buffer(pixelbuf_pixelbuf_obj_t *self, size_t start, mp_int_t step, size_t slice_len, mp_obj_t values) {
+    mp_buffer_info_t bufinfo;
+    if (!mp_get_buffer(values, &bufinfo, MP_BUFFER_READ) ||
+        (bufinfo.typecode != 'B' && bufinfo.typecode != BYTEARRAY_TYPECODE) ||
+        bufinfo.len != slice_len * self->byteorder.bpp) {
+        return false;
+    }
+    const uint8_t *src = bufinfo.buf;
+    uint8_t bpp = self->byteorder.bpp;
+    uint8_t default_w = self->byteorder.is_dotstar ? 255 : 0;
+    for (size_t i = 0; i < slice_len; i++) {
+        pixelbuf_set_pixel_color(self, start, src[PIXEL_R], src[PIXEL_G], src[PIXEL_B], bpp > 3 ? src[PIXEL_W] : default_w);
+        src += bpp;
+        start += step;
+    }
+    return true;
+}
+
 void common_hal_adafruit_pixelbuf_pixelbuf_set_pixels(mp_obj_t self_in, size_t start, mp_int_t step, size_t slice_len, mp_obj_t *values,
     mp_obj_tuple_t *flatten_to) {
     pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
+    bool flattened = flatten_to != mp_const_none;
+    if (flattened && pixelbuf_set_pixels_from_buffer(self, start, step, slice_len, values)) {
+        if (self->auto_write) {
+            common_hal_adafruit_pixelbuf_pixelbuf_show(self_in);
+        }
+        return;
+    }
     mp_obj_iter_buf_t iter_buf;
     mp_obj_t iterable = mp_getiter(values, &iter_buf);
     mp_obj_t item;
     size_t i = 0;
-    bool flattened = flatten_to != mp_const_none;
     if (flattened) {
         flatten_to->len = self->bytes_per_pixel;
     }
+    // Sequences like [color] * n repeat the same object, so only parse it once.
+    mp_obj_t last_item = MP_OBJ_NULL;
+    uint8_t r = 0, g = 0, b = 0, w = 0;
     while ((item = mp_iternext(iterable)) != MP_OBJ_STOP_ITERATION) {
         if (flattened) {
             flatten_to->items[i % self->bytes_per_pixel] = item;
@@ -252,7 +317,11 @@ void common_hal_adafruit_pixelbuf_pixelbuf_set_pixels(mp_obj_t self_in, size_t s
                 start += step;
             }
         } else {
-            _pixelbuf_set_pixel(self, start, item);
+            if (item != last_item) {
+                pixelbuf_parse_color(self, item, &r, &g, &b, &w);
+                last_item = item;
+            }
+            pixelbuf_set_pixel_color(self, start, r, g, b, w);
             start += step;
         }
     }
@@ -306,6 +375,11 @@ void common_hal_adafruit_pixelbuf_pixelbuf_show(mp_obj_t self_in) {
     mp_call_method_n_kw(1, 0, dest);
 }
 
+mp_obj_t common_hal_adafruit_pixelbuf_pixelbuf_get_transmit_buffer(mp_obj_t self_in) {
+    pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
+    return self->transmit_buffer_obj;
+}
+
 void common_hal_adafruit_pixelbuf_pixelbuf_fill(mp_obj_t self_in, mp_obj_t fill_color) {
     pixelbuf_pixelbuf_obj_t *self = native_pixelbuf(self_in);
 
@@ -315,8 +389,14 @@ void common_hal_adafruit_pixelbuf_pixelbuf_fill(mp_obj_t self_in, mp_obj_t fill_
     uint8_t w;
     common_hal_adafruit_pixelbuf_pixelbuf_parse_color(self, fill_color, &r, &g, &b, &w);
 
-    for (size_t i = 0; i < self->pixel_count; i++) {
-        common_hal_adafruit_pixelbuf_pixelbuf_set_pixel_color(self, i, r, g, b, w);
+    // Lay out the first pixel and copy it over the rest of the buffers.
+    size_t pixel_len = self->pixel_count * self->bytes_per_pixel;
+    if (pixel_len > 0) {
+        pixelbuf_set_pixel_color(self, 0, r, g, b, w);
+        pixelbuf_repeat_pattern(self->post_brightness_buffer, self->bytes_per_pixel, pixel_len);
+        if (self->pre_brightness_buffer) {
+            pixelbuf_repeat_pattern(self->pre_brightness_buffer, self->bytes_per_pixel, pixel_len);
+        }
     }
     if (self->auto_write) {
         common_hal_adafruit_pixelbuf_pixelbuf_show(self_in);
@@ -36,6 +36,9 @@ typedef struct {
     // account for any header.
     uint8_t *post_brightness_buffer;
     uint8_t *pre_brightness_buffer;
+    // brightness_lut[v] is v scaled by the brightness. Allocated along with
+    // pre_brightness_buffer and rebuilt whenever the brightness changes.
+    uint8_t *brightness_lut;
     bool auto_write;
 } pixelbuf_pixelbuf_obj_t;
 
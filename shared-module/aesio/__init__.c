@@ -7,6 +7,7 @@
 #include <string.h>
 
 #include "py/runtime.h"
+#include "py/stream.h"
 
 #include "shared-bindings/aesio/__init__.h"
 #include "shared-module/aesio/__init__.h"
@@ -33,8 +34,15 @@ void common_hal_aesio_aes_set_mode(aesio_aes_obj_t *self, int mode) {
     self->mode = mode;
 }
 
+MP_WEAK bool aesio_aes_port_crypt(aesio_aes_obj_t *self, bool encrypt, uint8_t *buffer, size_t length) {
+    return false;
+}
+
 void common_hal_aesio_aes_encrypt(aesio_aes_obj_t *self, uint8_t *buffer,
     size_t length) {
+    if (self->mode != AES_MODE_ECB && aesio_aes_port_crypt(self, true, buffer, length)) {
+        return;
+    }
     switch (self->mode) {
         case AES_MODE_ECB:
             AES_ECB_encrypt(&self->ctx, buffer);
@@ -50,6 +58,9 @@ void common_hal_aesio_aes_encrypt(aesio_aes_obj_t *self, uint8_t *buffer,
 
 void common_hal_aesio_aes_decrypt(aesio_aes_obj_t *self, uint8_t *buffer,
     size_t length) {
+    if (self->mode != AES_MODE_ECB && aesio_aes_port_crypt(self, false, buffer, length)) {
+        return;
+    }
     switch (self->mode) {
         case AES_MODE_ECB:
             AES_ECB_decrypt(&self->ctx, buffer);
@@ -62,3 +73,58 @@ void common_hal_aesio_aes_decrypt(aesio_aes_obj_t *self, uint8_t *buffer,
             break;
     }
 }
+
+size_t common_hal_aesio_aes_crypt_stream(aesio_aes_obj_t *self, bool encrypt,
+    mp_obj_t src, mp_obj_t dest, uint8_t *buffer, size_t length) {
+    mp_get_stream_raise(src, MP_STREAM_OP_READ);
+    mp_get_stream_raise(dest, MP_STREAM_OP_WRITE);
+    // Only the final chunk may be short, so that CTR mode does not start a fresh
+    // counter block in the middle of the stream.
+    length &= ~(AES_BLOCKLEN - 1);
+    size_t total = 0;
+    for (;;) {
+        int errcode;
+        mp_uint_t n = mp_stream_rw(src, buffer, length, &errcode, MP_STREAM_RW_READ);
+        if (errcode != 0) {
+            mp_raise_OSError(errcode);
+        }
+        if (n == 0) {
+            break;
+        }
+        switch (self->mode) {
+            case AES_MODE_ECB:
+                if ((n & (AES_BLOCKLEN - 1)) != 0) {
+                    mp_raise_ValueError(MP_ERROR_TEXT("ECB only operates on 16 bytes at a time"));
+                }
+                for (size_t i = 0; i < n; i += AES_BLOCKLEN) {
+                    if (encrypt) {
+                        AES_ECB_encrypt(&self->ctx, buffer + i);
+                    } else {
+                        AES_ECB_decrypt(&self->ctx, buffer + i);
+                    }
+                }
+                break;
+            case AES_MODE_CBC:
+                if ((n & (AES_BLOCKLEN - 1)) != 0) {
+                    mp_raise_ValueError(MP_ERROR_TEXT("CBC blocks must be multiples of 16 bytes"));
+                }
+                MP_FALLTHROUGH
+            case AES_MODE_CTR:
+                if (encrypt) {
+                    common_hal_aesio_aes_encrypt(self, buffer, n);
+                } else {
+                    common_hal_aesio_aes_decrypt(self, buffer, n);
+                }
+                break;
+        }
+        mp_uint_t written = mp_stream_rw(dest, buffer, n, &errcode, MP_STREAM_RW_WRITE);
+        if (written != n) {
+            mp_raise_OSError(errcode != 0 ? errcode : MP_EIO);
+        }
+        total += n;
+        if (n < length) {
+            break;
+        }
+    }
+    return total;
+}
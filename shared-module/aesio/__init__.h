@@ -14,6 +14,11 @@
 
 #include "shared-module/aesio/aes.h"
 
+// Size of the buffer allocated by encrypt_stream and decrypt_stream when none is given.
+#ifndef AESIO_STREAM_BUFFER_SIZE
+#define AESIO_STREAM_BUFFER_SIZE (512)
+#endif
+
 // These values were chosen to correspond with the values
 // present in pycrypto.
 enum AES_MODE {
@@ -34,3 +39,8 @@ typedef struct {
     // Counter for running in CTR mode
     uint32_t counter;
 } aesio_aes_obj_t;
+
+// Ports with an AES engine override this to process CBC and CTR buffers in hardware. The key
+// is the first ctx.KeyLength bytes of ctx.RoundKey128, and ctx.Iv must be left as the software
+// implementation would leave it. Return false, with buffer untouched, to fall back to software.
+bool aesio_aes_port_crypt(aesio_aes_obj_t *self, bool encrypt, uint8_t *buffer, size_t length);
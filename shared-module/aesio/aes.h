@@ -27,6 +27,12 @@
   #define CTR 1
 #endif
 
+// TTABLE encrypts with 32-bit words and a 1 KB lookup table that combines SubBytes,
+// ShiftRows and MixColumns, instead of working on single bytes.
+#ifndef AES_TTABLE
+  #define AES_TTABLE 1
+#endif
+
 
 #define AES128 1
 #define AES192 1
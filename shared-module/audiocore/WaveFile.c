@@ -13,6 +13,13 @@
 #include "py/runtime.h"
 
 #include "shared-module/audiocore/WaveFile.h"
+#include "supervisor/background_callback.h"
+
+#if defined(MICROPY_UNIX_COVERAGE)
+#define background_callback_prevent() ((void)0)
+#define background_callback_allow() ((void)0)
+#define background_callback_add(buf, fn, arg) ((fn)((arg)))
+#endif
 
 struct wave_format_chunk {
     uint16_t audio_format;
@@ -27,9 +34,12 @@ struct wave_format_chunk {
 void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t *self,
     pyb_file_obj_t *file,
     uint8_t *buffer,
-    size_t buffer_size) {
+    size_t buffer_size,
+    uint8_t read_ahead) {
     // Load the wave
     self->file = file;
+    // Looping seeks back to the start of the samples.
+    fat_file_enable_fast_seek(file);
     uint8_t chunk_header[16];
     f_rewind(&self->file->fp);
     UINT bytes_read;
@@ -89,6 +99,32 @@ void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t *self,
     self->file_length = data_length;
     self->data_start = self->file->fp.fptr;
 
+    self->ring = NULL;
+    self->ring_size = 0;
+    self->ring_next = 0;
+    self->ring_filled = 0;
+    self->ring_current = 0;
+    self->underruns = 0;
+
+    if (read_ahead) {
+        // Besides the buffers being read ahead, two may be in use by the consumer.
+        self->ring_size = read_ahead + 2;
+        if (buffer_size) {
+            self->len = buffer_size / self->ring_size / sizeof(uint32_t) * sizeof(uint32_t);
+            if (self->len == 0) {
+                mp_arg_error_invalid(MP_QSTR_buffer);
+            }
+            self->ring = buffer;
+        } else {
+            self->len = 256;
+            self->ring = m_malloc(self->len * self->ring_size);
+        }
+        self->ring_length = m_malloc(self->ring_size * sizeof(uint32_t));
+        self->buffer = NULL;
+        self->second_buffer = NULL;
+        return;
+    }
+
     // Try to allocate two buffers, one will be loaded from file and the other
     // DMAed to DAC.
     if (buffer_size) {
@@ -114,10 +150,12 @@ void common_hal_audioio_wavefile_construct(audioio_wavefile_obj_t *self,
 void common_hal_audioio_wavefile_deinit(audioio_wavefile_obj_t *self) {
     self->buffer = NULL;
     self->second_buffer = NULL;
+    self->ring = NULL;
+    self->ring_length = NULL;
 }
 
 bool common_hal_audioio_wavefile_deinited(audioio_wavefile_obj_t *self) {
-    return self->buffer == NULL;
+    return self->buffer == NULL && self->ring == NULL;
 }
 
 uint32_t common_hal_audioio_wavefile_get_sample_rate(audioio_wavefile_obj_t *self) {
@@ -137,6 +175,66 @@ uint8_t common_hal_audioio_wavefile_get_channel_count(audioio_wavefile_obj_t *se
     return self->channel_count;
 }
 
+uint32_t common_hal_audioio_wavefile_get_underruns(audioio_wavefile_obj_t *self) {
+    return self->underruns;
+}
+
+// Pads the last buffer of the file to word align it.
+static uint32_t wavefile_pad_last_buffer(audioio_wavefile_obj_t *self, uint8_t *buffer, uint32_t length_read) {
+    if (length_read % sizeof(uint32_t) != 0) {
+        uint32_t pad = length_read % sizeof(uint32_t);
+        length_read += pad;
+        if (self->bits_per_sample == 8) {
+            for (uint32_t i = 0; i < pad; i++) {
+                buffer[length_read / sizeof(uint8_t) - i - 1] = 0x80;
+            }
+        } else if (self->bits_per_sample == 16) {
+            // We know the buffer is aligned because we allocated it onto the heap ourselves.
+            #pragma GCC diagnostic push
+            #pragma GCC diagnostic ignored "-Wcast-align"
+            ((int16_t *)buffer)[length_read / sizeof(int16_t) - 1] = 0;
+            #pragma GCC diagnostic pop
+        }
+    }
+    return length_read;
+}
+
+// Reads the next part of the file into the next free ring buffer. Returns
+// false on a read error.
+static bool wavefile_fill_ring_buffer(audioio_wavefile_obj_t *self) {
+    uint8_t index = (self->ring_next + self->ring_filled) % self->ring_size;
+    uint8_t *buffer = self->ring + index * self->len;
+    uint32_t num_bytes_to_load = MIN(self->len, self->bytes_unread);
+    UINT length_read;
+    if (f_read(&self->file->fp, buffer, num_bytes_to_load, &length_read) != FR_OK || length_read != num_bytes_to_load) {
+        return false;
+    }
+    self->bytes_unread -= length_read;
+    if (self->bytes_unread == 0) {
+        length_read = wavefile_pad_last_buffer(self, buffer, length_read);
+    }
+    self->ring_length[index] = length_read;
+    self->ring_filled += 1;
+    return true;
+}
+
+static bool wavefile_ring_has_space(audioio_wavefile_obj_t *self) {
+    return !self->read_error && self->bytes_unread > 0 && self->ring_filled < self->ring_size - 2;
+}
+
+// Reads ahead from a background callback, into every ring buffer that is free.
+static void wavefile_fill_ring_cb(void *self_in) {
+    audioio_wavefile_obj_t *self = self_in;
+    if (common_hal_audioio_wavefile_deinited(self)) {
+        return;
+    }
+    while (wavefile_ring_has_space(self)) {
+        if (!wavefile_fill_ring_buffer(self)) {
+            self->read_error = true;
+        }
+    }
+}
+
 void audioio_wavefile_reset_buffer(audioio_wavefile_obj_t *self,
     bool single_channel_output,
     uint8_t channel) {
@@ -145,11 +243,21 @@ void audioio_wavefile_reset_buffer(audioio_wavefile_obj_t *self,
     }
     // We don't reset the buffer index in case we're looping and we have an odd number of buffer
     // loads
+    background_callback_prevent();
     self->bytes_remaining = self->file_length;
     f_lseek(&self->file->fp, self->data_start);
     self->read_count = 0;
     self->left_read_count = 0;
     self->right_read_count = 0;
+    if (self->ring_size) {
+        // Likewise ring_next is kept, so the buffers in use by the consumer aren't overwritten.
+        // Load the first buffer now, so it's ready straight away, and the rest in the background.
+        self->ring_filled = 0;
+        self->bytes_unread = self->file_length;
+        self->read_error = !wavefile_fill_ring_buffer(self);
+        background_callback_add(&self->fill_cb, wavefile_fill_ring_cb, self);
+    }
+    background_callback_allow();
 }
 
 audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t *self,
@@ -174,7 +282,22 @@ audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t *
         return GET_BUFFER_DONE;
     }
 
-    if (need_more_data) {
+    if (need_more_data && self->ring_size) {
+        if (self->ring_filled == 0) {
+            // The background read-ahead has fallen behind, so load the next buffer now.
+            if (self->read_error || !wavefile_fill_ring_buffer(self)) {
+                return GET_BUFFER_ERROR;
+            }
+            self->underruns += 1;
+        }
+        self->ring_current = self->ring_next;
+        self->ring_next = (self->ring_next + 1) % self->ring_size;
+        self->ring_filled -= 1;
+        // Only the last buffer is padded, so this can't take more than remains.
+        self->bytes_remaining -= MIN(self->ring_length[self->ring_current], self->bytes_remaining);
+        self->read_count += 1;
+        background_callback_add(&self->fill_cb, wavefile_fill_ring_cb, self);
+    } else if (need_more_data) {
         uint32_t num_bytes_to_load = self->len;
         if (num_bytes_to_load > self->bytes_remaining) {
             num_bytes_to_load = self->bytes_remaining;
@@ -189,21 +312,8 @@ audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t *
             return GET_BUFFER_ERROR;
         }
         self->bytes_remaining -= length_read;
-        // Pad the last buffer to word align it.
-        if (self->bytes_remaining == 0 && length_read % sizeof(uint32_t) != 0) {
-            uint32_t pad = length_read % sizeof(uint32_t);
-            length_read += pad;
-            if (self->bits_per_sample == 8) {
-                for (uint32_t i = 0; i < pad; i++) {
-                    ((uint8_t *)(*buffer))[length_read / sizeof(uint8_t) - i - 1] = 0x80;
-                }
-            } else if (self->bits_per_sample == 16) {
-                // We know the buffer is aligned because we allocated it onto the heap ourselves.
-                #pragma GCC diagnostic push
-                #pragma GCC diagnostic ignored "-Wcast-align"
-                ((int16_t *)(*buffer))[length_read / sizeof(int16_t) - 1] = 0;
-                #pragma GCC diagnostic pop
-            }
+        if (self->bytes_remaining == 0) {
+            length_read = wavefile_pad_last_buffer(self, *buffer, length_read);
         }
         *buffer_length = length_read;
         if (self->buffer_index % 2 == 1) {
@@ -216,7 +326,11 @@ audioio_get_buffer_result_t audioio_wavefile_get_buffer(audioio_wavefile_obj_t *
     }
 
     uint32_t buffers_back = self->read_count - 1 - channel_read_count;
-    if ((self->buffer_index - buffers_back) % 2 == 0) {
+    if (self->ring_size) {
+        uint8_t index = (self->ring_current + self->ring_size - buffers_back) % self->ring_size;
+        *buffer = self->ring + index * self->len;
+        *buffer_length = self->ring_length[index];
+    } else if ((self->buffer_index - buffers_back) % 2 == 0) {
         *buffer = self->second_buffer;
         *buffer_length = self->second_buffer_length;
     } else {
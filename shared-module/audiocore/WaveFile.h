@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "supervisor/background_callback.h"
 #include "extmod/vfs_fat.h"
 #include "py/obj.h"
 
@@ -32,6 +33,21 @@ typedef struct {
     uint32_t read_count;
     uint32_t left_read_count;
     uint32_t right_read_count;
+
+    // Read-ahead ring of ring_size buffers of len bytes, used instead of
+    // buffer/second_buffer when ring_size is non-zero. ring_filled buffers
+    // starting at ring_next are loaded and not yet returned; the two before
+    // ring_next may still be in use by the consumer.
+    background_callback_t fill_cb;
+    uint8_t *ring;
+    uint32_t *ring_length;
+    uint8_t ring_size;
+    uint8_t ring_next;
+    uint8_t ring_filled;
+    uint8_t ring_current; // last buffer returned
+    bool read_error;
+    uint32_t bytes_unread; // still to be read from the file into the ring
+    uint32_t underruns;
 } audioio_wavefile_obj_t;
 
 // These are not available from Python because it may be called in an interrupt.
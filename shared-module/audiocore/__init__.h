@@ -41,6 +41,24 @@ typedef struct _audiosample_p_t {
     audiosample_get_buffer_structure_fun get_buffer_structure;
 } audiosample_p_t;
 
+// Most buffers an audio output's play() may ask its DMA to cycle through.
+#define AUDIOCORE_DMA_MAX_BUFFER_COUNT (4)
+
+// Playback telemetry kept by a port's audio DMA. An underrun is a DMA buffer
+// that began playing before it was refilled. Latency is measured from the DMA
+// asking for a buffer to the buffer being refilled.
+typedef struct {
+    uint32_t buffers;
+    uint32_t underruns;
+    uint32_t max_latency_us;
+} audiocore_dma_stats_t;
+
+static inline void audiocore_dma_stats_add_latency(audiocore_dma_stats_t *stats, uint32_t latency_us) {
+    if (latency_us > stats->max_latency_us) {
+        stats->max_latency_us = latency_us;
+    }
+}
+
 uint32_t audiosample_sample_rate(mp_obj_t sample_obj);
 uint8_t audiosample_bits_per_sample(mp_obj_t sample_obj);
 uint8_t audiosample_channel_count(mp_obj_t sample_obj);
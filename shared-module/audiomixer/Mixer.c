@@ -8,6 +8,7 @@
 #include "shared-bindings/audiomixer/MixerVoice.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #include "py/runtime.h"
 #include "shared-module/audiocore/__init__.h"
@@ -22,7 +23,8 @@ void common_hal_audiomixer_mixer_construct(audiomixer_mixer_obj_t *self,
     uint8_t bits_per_sample,
     bool samples_signed,
     uint8_t channel_count,
-    uint32_t sample_rate) {
+    uint32_t sample_rate,
+    bool wide_accumulator) {
     self->len = buffer_size / 2 / sizeof(uint32_t) * sizeof(uint32_t);
 
     self->first_buffer = m_malloc(self->len);
@@ -41,6 +43,7 @@ void common_hal_audiomixer_mixer_construct(audiomixer_mixer_obj_t *self,
     self->samples_signed = samples_signed;
     self->channel_count = channel_count;
     self->sample_rate = sample_rate;
+    self->wide_accumulator = wide_accumulator;
     self->voice_count = voice_count;
 }
 
@@ -166,25 +169,120 @@ static inline uint32_t pack8(uint32_t val) {
     return ((val & 0xff000000) >> 16) | ((val & 0xff00) >> 8);
 }
 
+// Loads the voice's next buffer once the current one is used up. Returns false
+// if the sample has finished and isn't looping.
+static bool load_next_buffer(audiomixer_mixervoice_obj_t *voice) {
+    if (!voice->more_data) {
+        if (voice->loop) {
+            audiosample_reset_buffer(voice->sample, false, 0);
+        } else {
+            voice->sample = NULL;
+            return false;
+        }
+    }
+    audioio_get_buffer_result_t result = audiosample_get_buffer(voice->sample, false, 0, (uint8_t **)&voice->remaining_buffer, &voice->buffer_length);
+    // Track length in terms of words.
+    voice->buffer_length /= sizeof(uint32_t);
+    voice->more_data = result == GET_BUFFER_MORE_DATA;
+    return true;
+}
+
+// Fetches the next frame of a resampled voice into resample_next, as signed
+// 16-bit values with mono in the low half. Returns false if the sample has finished.
+static bool resample_next_frame(audiomixer_mixer_obj_t *self, audiomixer_mixervoice_obj_t *voice) {
+    while (voice->buffer_length == 0) {
+        if (voice->sample == NULL) {
+            return false;
+        }
+        if (!load_next_buffer(voice)) {
+            // Interpolate the last frame towards silence so that it still gets played.
+            voice->resample_prev = voice->resample_next;
+            voice->resample_next = 0;
+            return true;
+        }
+        voice->resample_odd = false;
+    }
+    uint32_t word = *voice->remaining_buffer;
+    if (!self->samples_signed) {
+        word = tosigned16(word);
+    }
+    voice->resample_prev = voice->resample_next;
+    if (self->channel_count == 2) {
+        voice->resample_next = word;
+    } else {
+        voice->resample_next = voice->resample_odd ? word >> 16 : word & 0xffff;
+        voice->resample_odd = !voice->resample_odd;
+        if (voice->resample_odd) {
+            return true;
+        }
+    }
+    voice->remaining_buffer++;
+    voice->buffer_length--;
+    return true;
+}
+
+// Linearly interpolates between mono frames a and b, phase being 0.15 fixed point.
+static inline int16_t resample_lerp(uint32_t a, uint32_t b, int32_t phase) {
+    int32_t sa = (int16_t)a;
+    int32_t sb = (int16_t)b;
+    return sa + (((sb - sa) * phase) >> 15);
+}
+
+// Like mix_down_one_voice, but for a 16-bit voice whose sample rate differs
+// from the mixer's.
+static void mix_down_one_resampled_voice(audiomixer_mixer_obj_t *self,
+    audiomixer_mixervoice_obj_t *voice, bool voices_active,
+    uint32_t *word_buffer, uint32_t length) {
+    uint16_t level = voice->level;
+    uint32_t frames_per_word = self->channel_count == 2 ? 1 : 2;
+    uint32_t i = 0;
+    for (; i < length; i++) {
+        uint32_t word = 0;
+        for (uint32_t f = 0; f < frames_per_word; f++) {
+            while (voice->resample_phase >= (1 << 16)) {
+                if (!resample_next_frame(self, voice)) {
+                    goto finished;
+                }
+                voice->resample_phase -= 1 << 16;
+            }
+            int32_t phase = voice->resample_phase >> 1;
+            if (frames_per_word == 1) {
+                // Both channels at once, folding the level into the weights.
+                int32_t w_next = (phase * level) >> 15;
+                // Keep the weight below 1 << 15, which smulwb would treat as -1.
+                int32_t w_prev = MIN(level - w_next, (1 << 15) - 1);
+                word = add16signed(mult16signed(voice->resample_prev, w_prev), mult16signed(voice->resample_next, w_next));
+            } else {
+                word |= (uint32_t)(uint16_t)resample_lerp(voice->resample_prev, voice->resample_next, phase) << (16 * f);
+            }
+            voice->resample_phase += voice->resample_step;
+        }
+        if (frames_per_word != 1) {
+            word = mult16signed(word, level);
+        }
+        word_buffer[i] = voices_active ? add16signed(word, word_buffer[i]) : word;
+    }
+    return;
+
+finished:
+    if (!voices_active) {
+        for (; i < length; i++) {
+            word_buffer[i] = 0;
+        }
+    }
+}
+
 static void mix_down_one_voice(audiomixer_mixer_obj_t *self,
     audiomixer_mixervoice_obj_t *voice, bool voices_active,
     uint32_t *word_buffer, uint32_t length) {
+    if (voice->resample_step != 0) {
+        mix_down_one_resampled_voice(self, voice, voices_active, word_buffer, length);
+        return;
+    }
     while (length != 0) {
         if (voice->buffer_length == 0) {
-            if (!voice->more_data) {
-                if (voice->loop) {
-                    audiosample_reset_buffer(voice->sample, false, 0);
-                } else {
-                    voice->sample = NULL;
-                    break;
-                }
-            }
-            if (voice->sample) {
-                // Load another buffer
-                audioio_get_buffer_result_t result = audiosample_get_buffer(voice->sample, false, 0, (uint8_t **)&voice->remaining_buffer, &voice->buffer_length);
-                // Track length in terms of words.
-                voice->buffer_length /= sizeof(uint32_t);
-                voice->more_data = result == GET_BUFFER_MORE_DATA;
+            if (!load_next_buffer(voice)) {
+                break;
             }
         }
 
@@ -260,6 +358,135 @@ static void mix_down_one_voice(audiomixer_mixer_obj_t *self,
     }
 }
 
+// Number of 16-bit samples mix_down_wide accumulates at a time.
+#define MIXER_ACCUMULATOR_SAMPLES (64)
+
+// Adds (val.bottom * level) >> 15 to acc, level being at most 1 << 15.
+__attribute__((always_inline))
+static inline int32_t mac16bottom(int32_t acc, uint32_t val, int32_t level) {
+    #if (defined(__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1))
+    asm ("smlawb %0, %1, %2, %3" : "=r" (acc) : "r" (level << 1), "r" (val), "r" (acc));
+    return acc;
+    #else
+    return acc + (((int16_t)val * level) >> 15);
+    #endif
+}
+
+// Adds (val.top * level) >> 15 to acc, level being at most 1 << 15.
+__attribute__((always_inline))
+static inline int32_t mac16top(int32_t acc, uint32_t val, int32_t level) {
+    #if (defined(__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1))
+    asm ("smlawt %0, %1, %2, %3" : "=r" (acc) : "r" (level << 1), "r" (val), "r" (acc));
+    return acc;
+    #else
+    return acc + (((int16_t)(val >> 16) * level) >> 15);
+    #endif
+}
+
+// Saturates two accumulators to 16 bits and packs them into a word.
+__attribute__((always_inline))
+static inline uint32_t saturate16x2(int32_t lo, int32_t hi) {
+    #if (defined(__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1))
+    uint32_t val;
+    asm ("ssat %0, %1, %2" : "=r" (lo) : "I" (16), "r" (lo));
+    asm ("ssat %0, %1, %2" : "=r" (hi) : "I" (16), "r" (hi));
+    asm ("pkhbt %0, %1, %2, lsl #16" : "=r" (val) : "r" (lo), "r" (hi));
+    return val;
+    #else
+    lo = MIN(MAX(lo, SHRT_MIN), SHRT_MAX);
+    hi = MIN(MAX(hi, SHRT_MIN), SHRT_MAX);
+    return ((uint32_t)lo & 0xffff) | ((uint32_t)hi << 16);
+    #endif
+}
+
+// Adds length words of the voice to acc, one accumulator per 16-bit sample
+// (or per 8-bit sample scaled up to 16 bits).
+static void accumulate_one_voice(audiomixer_mixer_obj_t *self,
+    audiomixer_mixervoice_obj_t *voice, int32_t *acc, uint32_t length) {
+    while (length != 0) {
+        if (voice->buffer_length == 0) {
+            if (!load_next_buffer(voice)) {
+                break;
+            }
+        }
+
+        uint32_t n = MIN(voice->buffer_length, length);
+        uint32_t *src = voice->remaining_buffer;
+        int32_t level = voice->level;
+
+        if (MP_LIKELY(self->bits_per_sample == 16)) {
+            for (uint32_t i = 0; i < n; i++) {
+                uint32_t word = src[i];
+                if (MP_UNLIKELY(!self->samples_signed)) {
+                    word = tosigned16(word);
+                }
+                acc[0] = mac16bottom(acc[0], word, level);
+                acc[1] = mac16top(acc[1], word, level);
+                acc += 2;
+            }
+        } else {
+            uint16_t *hsrc = (uint16_t *)src;
+            for (uint32_t i = 0; i < n * 2; i++) {
+                uint32_t word = unpack8(hsrc[i]);
+                if (MP_LIKELY(!self->samples_signed)) {
+                    word = tosigned16(word);
+                }
+                acc[0] = mac16bottom(acc[0], word, level);
+                acc[1] = mac16top(acc[1], word, level);
+                acc += 2;
+            }
+        }
+        length -= n;
+        voice->remaining_buffer += n;
+        voice->buffer_length -= n;
+    }
+}
+
+// Mixes all voices into word_buffer by summing them in 32-bit accumulators and
+// saturating once at the end, a block at a time.
+static void mix_down_wide(audiomixer_mixer_obj_t *self, uint32_t *word_buffer, uint32_t length) {
+    int32_t acc[MIXER_ACCUMULATOR_SAMPLES];
+    uint32_t samples_per_word = 32 / self->bits_per_sample;
+    uint32_t block_length = MIXER_ACCUMULATOR_SAMPLES / samples_per_word;
+
+    while (length != 0) {
+        uint32_t n = MIN(block_length, length);
+        uint32_t n_samples = n * samples_per_word;
+        memset(acc, 0, n_samples * sizeof(int32_t));
+
+        for (int32_t v = 0; v < self->voice_count; v++) {
+            audiomixer_mixervoice_obj_t *voice = MP_OBJ_TO_PTR(self->voice[v]);
+            if (voice->sample == NULL) {
+                continue;
+            }
+            if (voice->resample_step != 0) {
+                // Resampled voices are 16-bit and already scaled by their level.
+                uint32_t resampled[MIXER_ACCUMULATOR_SAMPLES / 2];
+                mix_down_one_resampled_voice(self, voice, false, resampled, n);
+                for (uint32_t i = 0; i < n; i++) {
+                    acc[2 * i] += (int16_t)resampled[i];
+                    acc[2 * i + 1] += (int16_t)(resampled[i] >> 16);
+                }
+            } else {
+                accumulate_one_voice(self, voice, acc, n);
+            }
+        }
+
+        if (MP_LIKELY(self->bits_per_sample == 16)) {
+            for (uint32_t i = 0; i < n; i++) {
+                word_buffer[i] = saturate16x2(acc[2 * i], acc[2 * i + 1]);
+            }
+        } else {
+            uint16_t *hword_buffer = (uint16_t *)word_buffer;
+            for (uint32_t i = 0; i < n * 2; i++) {
+                hword_buffer[i] = pack8(saturate16x2(acc[2 * i], acc[2 * i + 1]));
+            }
+        }
+        length -= n;
+        word_buffer += n;
+    }
+}
+
 audioio_get_buffer_result_t audiomixer_mixer_get_buffer(audiomixer_mixer_obj_t *self,
     bool single_channel_output,
     uint8_t channel,
@@ -286,20 +513,24 @@ audioio_get_buffer_result_t audiomixer_mixer_get_buffer(audiomixer_mixer_obj_t *
             word_buffer = self->second_buffer;
         }
         self->use_first_buffer = !self->use_first_buffer;
-        bool voices_active = false;
         uint32_t length = self->len / sizeof(uint32_t);
 
-        for (int32_t v = 0; v < self->voice_count; v++) {
-            audiomixer_mixervoice_obj_t *voice = MP_OBJ_TO_PTR(self->voice[v]);
-            if (voice->sample) {
-                mix_down_one_voice(self, voice, voices_active, word_buffer, length);
-                voices_active = true;
+        if (self->wide_accumulator) {
+            mix_down_wide(self, word_buffer, length);
+        } else {
+            bool voices_active = false;
+            for (int32_t v = 0; v < self->voice_count; v++) {
+                audiomixer_mixervoice_obj_t *voice = MP_OBJ_TO_PTR(self->voice[v]);
+                if (voice->sample) {
+                    mix_down_one_voice(self, voice, voices_active, word_buffer, length);
+                    voices_active = true;
+                }
             }
-        }
 
-        if (!voices_active) {
-            for (uint32_t i = 0; i < length; i++) {
-                word_buffer[i] = 0;
+            if (!voices_active) {
+                for (uint32_t i = 0; i < length; i++) {
+                    word_buffer[i] = 0;
+                }
             }
         }
 
@@ -21,6 +21,7 @@ typedef struct {
     bool samples_signed;
     uint8_t channel_count;
     uint32_t sample_rate;
+    bool wide_accumulator; // sum voices in 32 bits and saturate once, see mix_down_wide
 
     uint32_t read_count;
     uint32_t left_read_count;
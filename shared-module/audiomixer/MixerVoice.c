@@ -13,6 +13,8 @@
 #include "shared-module/audiomixer/__init__.h"
 #include "shared-module/audiocore/RawSample.h"
 
+#define MIXER_MAX_RESAMPLE_RATIO (16)
+
 void common_hal_audiomixer_mixervoice_construct(audiomixer_mixervoice_obj_t *self) {
     self->sample = NULL;
     self->level = 1 << 15;
@@ -31,7 +33,12 @@ void common_hal_audiomixer_mixervoice_set_level(audiomixer_mixervoice_obj_t *sel
 }
 
 void common_hal_audiomixer_mixervoice_play(audiomixer_mixervoice_obj_t *self, mp_obj_t sample, bool loop) {
-    if (audiosample_sample_rate(sample) != self->parent->sample_rate) {
+    uint32_t sample_rate = audiosample_sample_rate(sample);
+    // Source frames per output frame, in 16.16 fixed point. Only 16-bit samples
+    // can be resampled, and by at most MIXER_MAX_RESAMPLE_RATIO.
+    uint64_t step = ((uint64_t)sample_rate << 16) / self->parent->sample_rate;
+    if (sample_rate != self->parent->sample_rate &&
+        (self->parent->bits_per_sample != 16 || step == 0 || step > (MIXER_MAX_RESAMPLE_RATIO << 16))) {
         mp_raise_ValueError(MP_ERROR_TEXT("The sample's sample rate does not match the mixer's"));
     }
     if (audiosample_channel_count(sample) != self->parent->channel_count) {
@@ -52,6 +59,16 @@ void common_hal_audiomixer_mixervoice_play(audiomixer_mixervoice_obj_t *self, mp
     self->sample = sample;
     self->loop = loop;
 
+    self->resample_step = 0;
+    if (sample_rate != self->parent->sample_rate) {
+        self->resample_step = step;
+        // Start two frames back so that the first two are fetched before any output.
+        self->resample_phase = 2 << 16;
+        self->resample_prev = 0;
+        self->resample_next = 0;
+        self->resample_odd = false;
+    }
+
     audiosample_reset_buffer(sample, false, 0);
     audioio_get_buffer_result_t result = audiosample_get_buffer(sample, false, 0, (uint8_t **)&self->remaining_buffer, &self->buffer_length);
     // Track length in terms of words.
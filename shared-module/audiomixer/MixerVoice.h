@@ -19,4 +19,12 @@ typedef struct {
     uint32_t *remaining_buffer;
     uint32_t buffer_length;
     uint16_t level;
+    // Resampling state, used when the sample rate differs from the mixer's.
+    // step and phase are 16.16 fixed point source frames; prev and next are
+    // the signed 16-bit frames being interpolated between.
+    uint32_t resample_step;
+    uint32_t resample_phase;
+    uint32_t resample_prev;
+    uint32_t resample_next;
+    bool resample_odd; // mono only: next frame is the high half of *remaining_buffer
 } audiomixer_mixervoice_obj_t;
@@ -16,9 +16,11 @@
 #include "py/mperrno.h"
 #include "py/runtime.h"
 #include "py/stream.h"
+#include "extmod/vfs_fat.h"
 
 #include "shared-module/audiomp3/MP3Decoder.h"
 #include "supervisor/background_callback.h"
+#include "supervisor/port.h"
 #include "lib/mp3/src/mp3common.h"
 
 #define MAX_BUFFER_LEN (MAX_NSAMP * MAX_NGRAN * MAX_NCHAN * sizeof(int16_t))
@@ -147,6 +149,48 @@ static bool mp3file_update_inbuf_always(audiomp3_mp3file_obj_t *self, bool block
     return INPUT_BUFFER_AVAILABLE(self->inbuf) > 0;
 }
 
+enum {
+    MP3_JOB_IDLE,
+    MP3_JOB_QUEUED,
+    MP3_JOB_DONE,
+};
+
+// Runs on the second core.  Only the decode itself is done there; stream
+// reads, inbuf compaction and the sync word search stay on the main core.
+static void mp3file_worker(void *self_in) {
+    audiomp3_mp3file_obj_t *self = self_in;
+    if (__atomic_load_n(&self->job_state, __ATOMIC_ACQUIRE) != MP3_JOB_QUEUED) {
+        return;
+    }
+    self->job_err = MP3Decode(self->decoder, &self->job_inptr, &self->job_bytes_left, self->job_pcm, 0);
+    __atomic_store_n(&self->job_state, MP3_JOB_DONE, __ATOMIC_RELEASE);
+}
+
+static bool mp3file_job_idle(audiomp3_mp3file_obj_t *self) {
+    return __atomic_load_n(&self->job_state, __ATOMIC_ACQUIRE) == MP3_JOB_IDLE;
+}
+
+// There is at most one frame in flight, so waiting for it is brief.
+static void mp3file_wait_for_job(audiomp3_mp3file_obj_t *self) {
+    while (__atomic_load_n(&self->job_state, __ATOMIC_ACQUIRE) == MP3_JOB_QUEUED) {
+    }
+}
+
+static void mp3file_cancel_job(audiomp3_mp3file_obj_t *self) {
+    mp3file_wait_for_job(self);
+    __atomic_store_n(&self->job_state, MP3_JOB_IDLE, __ATOMIC_RELEASE);
+}
+
+// Hand the frame at the read pointer to the second core, to be decoded into
+// pcm while the other buffer plays.
+static void mp3file_queue_job(audiomp3_mp3file_obj_t *self, int16_t *pcm) {
+    self->job_inptr = INPUT_BUFFER_READ_PTR(self->inbuf);
+    self->job_bytes_left = INPUT_BUFFER_AVAILABLE(self->inbuf);
+    self->job_pcm = pcm;
+    __atomic_store_n(&self->job_state, MP3_JOB_QUEUED, __ATOMIC_RELEASE);
+    port_second_core_wake();
+}
+
 /** Update the inbuf from a background callback.
  *
  * Re-queue if there's still buffer space available to read stream data
@@ -156,6 +200,10 @@ static void mp3file_update_inbuf_cb(void *self_in) {
     if (common_hal_audiomp3_mp3file_deinited(self_in)) {
         return;
     }
+    // The second core is reading inbuf; get_buffer() will top it up instead.
+    if (!mp3file_job_idle(self)) {
+        return;
+    }
     if (!self->eof && stream_readable(self->stream)) {
         mp3file_update_inbuf_always(self, false);
     }
@@ -218,7 +266,7 @@ static void mp3file_skip_id3v2(audiomp3_mp3file_obj_t *self, bool block_ok) {
     size -= to_consume;
 
     // Next, seek in the file after the header
-    if (stream_lseek(self->stream, SEEK_CUR, size) == 0) {
+    if (stream_lseek(self->stream, size, SEEK_CUR) >= 0) {
         return;
     }
 
@@ -267,7 +315,8 @@ static bool mp3file_get_next_frame_info(audiomp3_mp3file_obj_t *self, MP3FrameIn
 void common_hal_audiomp3_mp3file_construct(audiomp3_mp3file_obj_t *self,
     mp_obj_t stream,
     uint8_t *buffer,
-    size_t buffer_size) {
+    size_t buffer_size,
+    bool use_second_core) {
     // Note: Adafruit_MP3 uses a 2kB input buffer and two 4kB output pcm_buffer.
     // for a whopping total of 10kB pcm_buffer (+mp3 decoder state and frame buffer)
     // At 44kHz, that's 23ms of output audio data.
@@ -322,12 +371,19 @@ void common_hal_audiomp3_mp3file_construct(audiomp3_mp3file_obj_t *self,
     }
 
     common_hal_audiomp3_mp3file_set_file(self, stream);
+
+    // Falls back to decoding in get_buffer() if there's no idle core.
+    self->use_second_core = use_second_core && port_second_core_start(mp3file_worker, self);
 }
 
 void common_hal_audiomp3_mp3file_set_file(audiomp3_mp3file_obj_t *self, mp_obj_t stream) {
     background_callback_prevent();
+    mp3file_cancel_job(self);
 
     self->stream = stream;
+    if (mp_obj_is_type(stream, &mp_type_vfs_fat_fileio)) {
+        fat_file_enable_fast_seek(MP_OBJ_TO_PTR(stream));
+    }
 
     INPUT_BUFFER_CLEAR(self->inbuf);
     self->eof = 0;
@@ -357,6 +413,11 @@ void common_hal_audiomp3_mp3file_set_file(audiomp3_mp3file_obj_t *self, mp_obj_t
 }
 
 void common_hal_audiomp3_mp3file_deinit(audiomp3_mp3file_obj_t *self) {
+    if (self->use_second_core) {
+        mp3file_cancel_job(self);
+        port_second_core_stop();
+        self->use_second_core = false;
+    }
     if (self->decoder) {
         MP3FreeDecoder(self->decoder);
     }
@@ -399,6 +460,7 @@ void audiomp3_mp3file_reset_buffer(audiomp3_mp3file_obj_t *self,
     // loads
     background_callback_prevent();
     if (self->eof && stream_lseek(self->stream, SEEK_SET, 0) == 0) {
+        mp3file_cancel_job(self);
         INPUT_BUFFER_CLEAR(self->inbuf);
         self->eof = 0;
         self->samples_decoded = 0;
@@ -445,15 +507,25 @@ audioio_get_buffer_result_t audiomp3_mp3file_get_buffer(audiomp3_mp3file_obj_t *
     int16_t *buffer = (int16_t *)(void *)self->pcm_buffer[self->buffer_index];
     *bufptr = (uint8_t *)buffer;
 
-    mp3file_skip_id3v2(self, false);
-    if (!mp3file_find_sync_word(self, false)) {
-        memset(buffer, 0, self->frame_buffer_size);
-        *buffer_length = 0;
-        return self->eof ? GET_BUFFER_DONE : GET_BUFFER_ERROR;
+    int bytes_left;
+    int err;
+    if (!mp3file_job_idle(self)) {
+        // The second core decoded this frame while the previous one played
+        mp3file_wait_for_job(self);
+        bytes_left = self->job_bytes_left;
+        err = self->job_err;
+        __atomic_store_n(&self->job_state, MP3_JOB_IDLE, __ATOMIC_RELEASE);
+    } else {
+        mp3file_skip_id3v2(self, false);
+        if (!mp3file_find_sync_word(self, false)) {
+            memset(buffer, 0, self->frame_buffer_size);
+            *buffer_length = 0;
+            return self->eof ? GET_BUFFER_DONE : GET_BUFFER_ERROR;
+        }
+        bytes_left = BYTES_LEFT(self);
+        uint8_t *inbuf = READ_PTR(self);
+        err = MP3Decode(self->decoder, &inbuf, &bytes_left, buffer, 0);
     }
-    int bytes_left = BYTES_LEFT(self);
-    uint8_t *inbuf = READ_PTR(self);
-    int err = MP3Decode(self->decoder, &inbuf, &bytes_left, buffer, 0);
     if (err != ERR_MP3_INDATA_UNDERFLOW) {
         CONSUME(self, BYTES_LEFT(self) - bytes_left);
     }
@@ -485,6 +557,12 @@ audioio_get_buffer_result_t audiomp3_mp3file_get_buffer(audiomp3_mp3file_obj_t *
             self);
     }
 
+    // In split-channel mode the other channel may still be playing from the
+    // previous buffer, so only decode ahead when both channels come together.
+    if (self->use_second_core && !single_channel_output && result == GET_BUFFER_MORE_DATA) {
+        mp3file_queue_job(self, self->pcm_buffer[!self->buffer_index]);
+    }
+
     if (DO_DEBUG) {
         mp_printf(&mp_plat_print, "post-decode avail=%d eof=%d\n", (int)INPUT_BUFFER_AVAILABLE(self->inbuf), self->eof);
     }
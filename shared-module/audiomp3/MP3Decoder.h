@@ -40,6 +40,15 @@ typedef struct {
     int8_t other_buffer_index;
 
     uint32_t samples_decoded;
+
+    // When decoding on the second core, the main core queues one frame at a
+    // time and leaves inbuf alone until it has collected the result.
+    bool use_second_core;
+    uint8_t job_state;
+    int job_err;
+    int job_bytes_left;
+    uint8_t *job_inptr;
+    int16_t *job_pcm;
 } audiomp3_mp3file_obj_t;
 
 // These are not available from Python because it may be called in an interrupt.
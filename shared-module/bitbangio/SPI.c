@@ -15,6 +15,11 @@
 
 #define MAX_BAUDRATE (common_hal_mcu_get_clock_frequency() / 48)
 
+MP_WEAK size_t bitbangio_spi_port_transfer(bitbangio_spi_obj_t *self,
+    const uint8_t *dout, uint8_t write_value, uint8_t *din, size_t len) {
+    return 0;
+}
+
 void shared_module_bitbangio_spi_construct(bitbangio_spi_obj_t *self,
     const mcu_pin_obj_t *clock, const mcu_pin_obj_t *mosi,
     const mcu_pin_obj_t *miso) {
@@ -46,6 +51,7 @@ void shared_module_bitbangio_spi_construct(bitbangio_spi_obj_t *self,
         }
         self->has_miso = true;
     }
+    self->baudrate = 100000;
     self->delay_half = 5;
     self->polarity = 0;
     self->phase = 0;
@@ -70,6 +76,7 @@ void shared_module_bitbangio_spi_deinit(bitbangio_spi_obj_t *self) {
 
 void shared_module_bitbangio_spi_configure(bitbangio_spi_obj_t *self,
     uint32_t baudrate, uint8_t polarity, uint8_t phase, uint8_t bits) {
+    self->baudrate = baudrate;
     self->delay_half = 500000 / baudrate;
     // round delay_half up so that: actual_baudrate <= requested_baudrate
     if (500000 % baudrate != 0) {
@@ -109,6 +116,9 @@ bool shared_module_bitbangio_spi_write(bitbangio_spi_obj_t *self, const uint8_t
     if (len > 0 && !self->has_mosi) {
         mp_raise_ValueError_varg(MP_ERROR_TEXT("No %q pin"), MP_QSTR_mosi);
     }
+    size_t done = bitbangio_spi_port_transfer(self, data, 0, NULL, len);
+    data += done;
+    len -= done;
     uint32_t delay_half = self->delay_half;
 
     // only MSB transfer is implemented
@@ -164,6 +174,9 @@ bool shared_module_bitbangio_spi_read(bitbangio_spi_obj_t *self, uint8_t *data,
     if (len > 0 && !self->has_miso) {
         mp_raise_ValueError_varg(MP_ERROR_TEXT("No %q pin"), MP_QSTR_miso);
     }
+    size_t done = bitbangio_spi_port_transfer(self, NULL, write_data, data, len);
+    data += done;
+    len -= done;
 
     uint32_t delay_half = self->delay_half;
 
@@ -235,6 +248,10 @@ bool shared_module_bitbangio_spi_transfer(bitbangio_spi_obj_t *self, const uint8
     if (!self->has_miso && din != NULL) {
         mp_raise_ValueError_varg(MP_ERROR_TEXT("No %q pin"), MP_QSTR_miso);
     }
+    size_t done = bitbangio_spi_port_transfer(self, dout, 0, din, len);
+    dout += done;
+    din += done;
+    len -= done;
     uint32_t delay_half = self->delay_half;
 
     // only MSB transfer is implemented
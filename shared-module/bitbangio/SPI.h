@@ -15,6 +15,7 @@ typedef struct {
     digitalio_digitalinout_obj_t clock;
     digitalio_digitalinout_obj_t mosi;
     digitalio_digitalinout_obj_t miso;
+    uint32_t baudrate;
     uint32_t delay_half;
     bool has_miso : 1;
     bool has_mosi : 1;
@@ -22,3 +23,10 @@ typedef struct {
     uint8_t phase : 1;
     volatile bool locked : 1;
 } bitbangio_spi_obj_t;
+
+// Ports may run transfers on a hardware engine, such as an RP2040 PIO state
+// machine, instead of toggling the pins from the CPU. dout and din may be NULL;
+// write_value is sent for every byte when dout is NULL. Returns how many bytes
+// were transferred. The rest are bit banged. The default does none.
+size_t bitbangio_spi_port_transfer(bitbangio_spi_obj_t *self,
+    const uint8_t *dout, uint8_t write_value, uint8_t *din, size_t len);
@@ -8,6 +8,7 @@
 
 #include <stdbool.h>
 #include <math.h>
+#include <stdlib.h>
 
 #include "py/runtime.h"
 
@@ -17,14 +18,7 @@
 #include "shared-module/bitmapfilter/__init__.h"
 #include "shared-module/bitmapfilter/macros.h"
 
-#if defined(UNIX)
-#include <stdlib.h>
-#define port_free free
-#define port_malloc(sz, hint) (malloc(sz))
-#define port_realloc realloc
-#else
-#include "supervisor/port_heap.h"
-#endif
+#include "supervisor/shared/memory.h"
 
 // Triggered by use of IM_MIN(IM_MAX(...)); this is a spurious diagnostic.
 #pragma GCC diagnostic ignored "-Wshadow"
@@ -35,43 +29,11 @@ static void check_matching_details(displayio_bitmap_t *b1, displayio_bitmap_t *b
     }
 }
 
-size_t scratchpad_size = 0;
-static void *scratchpad = NULL;
-
-static void *scratchpad_alloc(size_t sz) {
-    if (sz == 0) {
-        if (scratchpad) {
-            port_free(scratchpad);
-        }
-        scratchpad_size = sz;
-        scratchpad = NULL;
-    } else {
-        if (scratchpad) {
-            if (sz > scratchpad_size) {
-                void *tmp = port_realloc(scratchpad, sz);
-                if (!tmp) {
-                    port_free(scratchpad);
-                    scratchpad = NULL;
-                } else {
-                    scratchpad = tmp;
-                    scratchpad_size = sz;
-                }
-            }
-        } else {
-            scratchpad = port_malloc(sz, false);
-            scratchpad_size = sz;
-        }
-        if (!scratchpad) {
-            m_malloc_fail(sz);
-        }
-    }
-    return scratchpad;
-}
-
+// The caller must return buf->data with supervisor_scratch_pop().
 static void scratch_bitmap16(displayio_bitmap_t *buf, int rows, int cols) {
     int stride = (cols + 1) / 2;
     size_t sz = rows * stride * sizeof(uint32_t);
-    void *data = scratchpad_alloc(sz);
+    void *data = supervisor_scratch_push(sz);
     // memset(data, 0, sz);
     buf->width = cols;
     buf->height = rows;
@@ -88,6 +50,227 @@ uint16_t imlib_yuv_to_rgb(uint8_t y, int8_t u, int8_t v) {
     return COLOR_R8_G8_B8_TO_RGB565(r, g, b);
 }
 
+// Scale, offset and clamp the convolution sums for one pixel.
+static inline int morph_pixel(int32_t r_acc, int32_t g_acc, int32_t b_acc, int32_t m_int, int32_t b_int) {
+    r_acc = (r_acc * m_int + b_int) >> 16;
+    if (r_acc > COLOR_R5_MAX) {
+        r_acc = COLOR_R5_MAX;
+    } else if (r_acc < 0) {
+        r_acc = 0;
+    }
+    g_acc = (g_acc * m_int + b_int * 2) >> 16;
+    if (g_acc > COLOR_G6_MAX) {
+        g_acc = COLOR_G6_MAX;
+    } else if (g_acc < 0) {
+        g_acc = 0;
+    }
+    b_acc = (b_acc * m_int + b_int) >> 16;
+    if (b_acc > COLOR_B5_MAX) {
+        b_acc = COLOR_B5_MAX;
+    } else if (b_acc < 0) {
+        b_acc = 0;
+    }
+    return COLOR_R5_G6_B5_TO_RGB565(r_acc, g_acc, b_acc);
+}
+
+static inline int morph_threshold(int pixel, int original, int offset, bool invert) {
+    if (((COLOR_RGB565_TO_Y(pixel) - offset) < COLOR_RGB565_TO_Y(original)) ^ invert) {
+        return COLOR_RGB565_BINARY_MAX;
+    }
+    return COLOR_RGB565_BINARY_MIN;
+}
+
+// Split the kernel into column and row vectors such that
+// krn[j * n + k] == col[j] * row[k]. This is only possible for rank-1 kernels
+// such as the box and gaussian blurs.
+static bool morph_factor_kernel(const int ksize, const int *krn, int *col, int *row) {
+    int n = 2 * ksize + 1;
+    int j0 = -1, k0 = -1;
+    for (int i = 0; i < n * n; i++) {
+        if (krn[i]) {
+            j0 = i / n;
+            k0 = i % n;
+            break;
+        }
+    }
+    if (j0 < 0) {
+        return false;
+    }
+    // Dividing the first non-zero row by its gcd makes every column weight
+    // an integer, if the kernel is separable at all.
+    int g = 0;
+    for (int k = 0; k < n; k++) {
+        int a = abs(krn[j0 * n + k]);
+        while (a) {
+            int t = g % a;
+            g = a;
+            a = t;
+        }
+    }
+    for (int k = 0; k < n; k++) {
+        row[k] = krn[j0 * n + k] / g;
+    }
+    for (int j = 0; j < n; j++) {
+        col[j] = krn[j * n + k0] / row[k0];
+        for (int k = 0; k < n; k++) {
+            if (krn[j * n + k] != col[j] * row[k]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Horizontal pass of a separable convolution: convolve one bitmap row with
+// the row vector, storing r, g, b sums in dst. Box kernels use a sliding
+// window sum instead of multiplying every tap.
+static void morph_hpass(const uint16_t *row_ptr, int width, int ksize, const int *row, bool box, int16_t *dst) {
+    if (box) {
+        int r_acc = 0, g_acc = 0, b_acc = 0;
+        for (int k = -ksize; k <= ksize; k++) {
+            int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, IM_MIN(IM_MAX(k, 0), (width - 1)));
+            r_acc += COLOR_RGB565_TO_R5(pixel);
+            g_acc += COLOR_RGB565_TO_G6(pixel);
+            b_acc += COLOR_RGB565_TO_B5(pixel);
+        }
+        for (int x = 0; x < width; x++) {
+            *dst++ = r_acc * row[0];
+            *dst++ = g_acc * row[0];
+            *dst++ = b_acc * row[0];
+            int leaving = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, IM_MAX(x - ksize, 0));
+            int entering = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, IM_MIN(x + ksize + 1, (width - 1)));
+            r_acc += COLOR_RGB565_TO_R5(entering) - COLOR_RGB565_TO_R5(leaving);
+            g_acc += COLOR_RGB565_TO_G6(entering) - COLOR_RGB565_TO_G6(leaving);
+            b_acc += COLOR_RGB565_TO_B5(entering) - COLOR_RGB565_TO_B5(leaving);
+        }
+        return;
+    }
+    for (int x = 0; x < width; x++) {
+        int r_acc = 0, g_acc = 0, b_acc = 0;
+        if (x >= ksize && x < width - ksize) {
+            for (int k = -ksize; k <= ksize; k++) {
+                int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x + k);
+                r_acc += row[k + ksize] * COLOR_RGB565_TO_R5(pixel);
+                g_acc += row[k + ksize] * COLOR_RGB565_TO_G6(pixel);
+                b_acc += row[k + ksize] * COLOR_RGB565_TO_B5(pixel);
+            }
+        } else {
+            for (int k = -ksize; k <= ksize; k++) {
+                int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, IM_MIN(IM_MAX(x + k, 0), (width - 1)));
+                r_acc += row[k + ksize] * COLOR_RGB565_TO_R5(pixel);
+                g_acc += row[k + ksize] * COLOR_RGB565_TO_G6(pixel);
+                b_acc += row[k + ksize] * COLOR_RGB565_TO_B5(pixel);
+            }
+        }
+        *dst++ = r_acc;
+        *dst++ = g_acc;
+        *dst++ = b_acc;
+    }
+}
+
+// Convolve with a rank-1 kernel as a horizontal pass into a ring of
+// 2 * ksize + 1 rows followed by a vertical pass. This costs 2n rather than
+// n*n operations per pixel, and a constant number for box kernels. The
+// sums are identical to the full 2-D convolution, edges included.
+static void morph_separable(
+    displayio_bitmap_t *bitmap,
+    displayio_bitmap_t *mask,
+    const int ksize,
+    const int *col,
+    const int *row,
+    bool box,
+    int32_t m_int,
+    int32_t b_int,
+    bool threshold,
+    int offset,
+    bool invert) {
+
+    const int n = 2 * ksize + 1;
+    const int width = bitmap->width, height = bitmap->height;
+    const int row_len = 3 * width;
+
+    // Each horizontal sum fits in 16 bits (checked by the caller); the
+    // vertical sums of box kernels are kept in an extra 32-bit row.
+    size_t sz = n * row_len * sizeof(int16_t) + (box ? row_len * sizeof(int32_t) : 0);
+    int32_t *vsum = supervisor_scratch_push(sz);
+    int16_t *ring = (int16_t *)(vsum + (box ? row_len : 0));
+
+    #define MORPH_RING_ROW(y) (ring + ((y) % n) * row_len)
+    #define MORPH_CLAMP_Y(y) IM_MIN(IM_MAX((y), 0), (height - 1))
+
+    for (int y = 0; y < IM_MIN(ksize, height); y++) {
+        morph_hpass(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, y), width, ksize, row, box, MORPH_RING_ROW(y));
+    }
+
+    for (int y = 0; y < height; y++) {
+        // Rows y - ksize - 1 and earlier are no longer needed, so row
+        // y + ksize can take the oldest slot; bitmap rows at and below y are
+        // still unmodified.
+        if (box && y > 0) {
+            const int16_t *leaving = MORPH_RING_ROW(MORPH_CLAMP_Y(y - ksize - 1));
+            for (int i = 0; i < row_len; i++) {
+                vsum[i] -= leaving[i];
+            }
+        }
+        if (y + ksize < height) {
+            morph_hpass(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, y + ksize), width, ksize, row, box, MORPH_RING_ROW(y + ksize));
+        }
+        if (box) {
+            if (y == 0) {
+                memset(vsum, 0, row_len * sizeof(int32_t));
+                for (int j = -ksize; j <= ksize; j++) {
+                    const int16_t *src = MORPH_RING_ROW(MORPH_CLAMP_Y(j));
+                    for (int i = 0; i < row_len; i++) {
+                        vsum[i] += src[i];
+                    }
+                }
+            } else {
+                const int16_t *entering = MORPH_RING_ROW(MORPH_CLAMP_Y(y + ksize));
+                for (int i = 0; i < row_len; i++) {
+                    vsum[i] += entering[i];
+                }
+            }
+        }
+
+        const int16_t *rows[n];
+        for (int j = -ksize; j <= ksize; j++) {
+            rows[j + ksize] = MORPH_RING_ROW(MORPH_CLAMP_Y(y + j));
+        }
+
+        uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, y);
+        for (int x = 0, i = 0; x < width; x++, i += 3) {
+            if (mask && common_hal_displayio_bitmap_get_pixel(mask, x, y)) {
+                continue; // Short circuit.
+            }
+            int32_t r_acc = 0, g_acc = 0, b_acc = 0;
+            if (box) {
+                r_acc = vsum[i] * col[0];
+                g_acc = vsum[i + 1] * col[0];
+                b_acc = vsum[i + 2] * col[0];
+            } else {
+                for (int j = 0; j < n; j++) {
+                    r_acc += col[j] * rows[j][i];
+                    g_acc += col[j] * rows[j][i + 1];
+                    b_acc += col[j] * rows[j][i + 2];
+                }
+            }
+
+            int pixel = morph_pixel(r_acc, g_acc, b_acc, m_int, b_int);
+
+            if (threshold) {
+                pixel = morph_threshold(pixel, IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x), offset, invert);
+            }
+
+            IMAGE_PUT_RGB565_PIXEL_FAST(row_ptr, x, pixel);
+        }
+    }
+
+    #undef MORPH_RING_ROW
+    #undef MORPH_CLAMP_Y
+
+    supervisor_scratch_pop(vsum);
+}
+
 void shared_module_bitmapfilter_morph(
     displayio_bitmap_t *bitmap,
     displayio_bitmap_t *mask,
@@ -108,6 +291,21 @@ void shared_module_bitmapfilter_morph(
         default:
             mp_raise_ValueError(MP_ERROR_TEXT("unsupported bitmap depth"));
         case 16: {
+            int n = 2 * ksize + 1;
+            int col[n], row[n];
+            if (bitmap->width > 0 && morph_factor_kernel(ksize, krn, col, row)) {
+                int row_abs = 0;
+                bool box = true;
+                for (int k = 0; k < n; k++) {
+                    row_abs += abs(row[k]);
+                    box = box && row[k] == row[0] && col[k] == col[0];
+                }
+                if (row_abs * COLOR_G6_MAX <= INT16_MAX) {
+                    morph_separable(bitmap, mask, ksize, col, row, box, m_int, b_int, threshold, offset, invert);
+                    break;
+                }
+            }
+
             displayio_bitmap_t buf;
             scratch_bitmap16(&buf, brows, bitmap->width);
 
@@ -146,33 +344,10 @@ void shared_module_bitmapfilter_morph(
                             }
                         }
                     }
-                    r_acc = (r_acc * m_int + b_int) >> 16;
-                    if (r_acc > COLOR_R5_MAX) {
-                        r_acc = COLOR_R5_MAX;
-                    } else if (r_acc < 0) {
-                        r_acc = 0;
-                    }
-                    g_acc = (g_acc * m_int + b_int * 2) >> 16;
-                    if (g_acc > COLOR_G6_MAX) {
-                        g_acc = COLOR_G6_MAX;
-                    } else if (g_acc < 0) {
-                        g_acc = 0;
-                    }
-                    b_acc = (b_acc * m_int + b_int) >> 16;
-                    if (b_acc > COLOR_B5_MAX) {
-                        b_acc = COLOR_B5_MAX;
-                    } else if (b_acc < 0) {
-                        b_acc = 0;
-                    }
-
-                    int pixel = COLOR_R5_G6_B5_TO_RGB565(r_acc, g_acc, b_acc);
+                    int pixel = morph_pixel(r_acc, g_acc, b_acc, m_int, b_int);
 
                     if (threshold) {
-                        if (((COLOR_RGB565_TO_Y(pixel) - offset) < COLOR_RGB565_TO_Y(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x))) ^ invert) {
-                            pixel = COLOR_RGB565_BINARY_MAX;
-                        } else {
-                            pixel = COLOR_RGB565_BINARY_MIN;
-                        }
+                        pixel = morph_threshold(pixel, IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x), offset, invert);
                     }
 
                     IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, pixel);
@@ -192,17 +367,13 @@ void shared_module_bitmapfilter_morph(
                     IMAGE_RGB565_LINE_LEN_BYTES(bitmap));
             }
 
+            supervisor_scratch_pop(buf.data);
             break;
         }
     }
 }
 
-void shared_module_bitmapfilter_mix(
-    displayio_bitmap_t *bitmap,
-    displayio_bitmap_t *mask,
-    const mp_float_t weights[12]) {
-
-    int wt[12];
+static void mix_fixed_weights(const mp_float_t weights[12], int32_t wt[12]) {
     for (int i = 0; i < 12; i++) {
         // The different scale factors correct for G having 6 bits while R, G have 5
         // by doubling the scale for R/B->G and halving the scale for G->R/B.
@@ -216,6 +387,47 @@ void shared_module_bitmapfilter_mix(
             65536;
         wt[i] = (int32_t)MICROPY_FLOAT_C_FUN(round)(scale * weights[i]);
     }
+}
+
+static inline int mix_pixel(int pixel, const int32_t wt[12]) {
+    int32_t r_acc = 0, g_acc = 0, b_acc = 0;
+    int r = COLOR_RGB565_TO_R5(pixel);
+    int g = COLOR_RGB565_TO_G6(pixel);
+    int b = COLOR_RGB565_TO_B5(pixel);
+    r_acc = r * wt[0] + g * wt[1] + b * wt[2] + wt[3];
+    r_acc >>= 16;
+    if (r_acc < 0) {
+        r_acc = 0;
+    } else if (r_acc > COLOR_R5_MAX) {
+        r_acc = COLOR_R5_MAX;
+    }
+
+    g_acc = r * wt[4] + g * wt[5] + b * wt[6] + wt[7];
+    g_acc >>= 16;
+    if (g_acc < 0) {
+        g_acc = 0;
+    } else if (g_acc > COLOR_G6_MAX) {
+        g_acc = COLOR_G6_MAX;
+    }
+
+    b_acc = r * wt[8] + g * wt[9] + b * wt[10] + wt[11];
+    b_acc >>= 16;
+    if (b_acc < 0) {
+        b_acc = 0;
+    } else if (b_acc > COLOR_B5_MAX) {
+        b_acc = COLOR_B5_MAX;
+    }
+
+    return COLOR_R5_G6_B5_TO_RGB565(r_acc, g_acc, b_acc);
+}
+
+void shared_module_bitmapfilter_mix(
+    displayio_bitmap_t *bitmap,
+    displayio_bitmap_t *mask,
+    const mp_float_t weights[12]) {
+
+    int32_t wt[12];
+    mix_fixed_weights(weights, wt);
 
     switch (bitmap->bits_per_value) {
         default:
@@ -228,35 +440,7 @@ void shared_module_bitmapfilter_mix(
                         continue; // Short circuit.
                     }
                     int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
-                    int32_t r_acc = 0, g_acc = 0, b_acc = 0;
-                    int r = COLOR_RGB565_TO_R5(pixel);
-                    int g = COLOR_RGB565_TO_G6(pixel);
-                    int b = COLOR_RGB565_TO_B5(pixel);
-                    r_acc = r * wt[0] + g * wt[1] + b * wt[2] + wt[3];
-                    r_acc >>= 16;
-                    if (r_acc < 0) {
-                        r_acc = 0;
-                    } else if (r_acc > COLOR_R5_MAX) {
-                        r_acc = COLOR_R5_MAX;
-                    }
-
-                    g_acc = r * wt[4] + g * wt[5] + b * wt[6] + wt[7];
-                    g_acc >>= 16;
-                    if (g_acc < 0) {
-                        g_acc = 0;
-                    } else if (g_acc > COLOR_G6_MAX) {
-                        g_acc = COLOR_G6_MAX;
-                    }
-
-                    b_acc = r * wt[8] + g * wt[9] + b * wt[10] + wt[11];
-                    b_acc >>= 16;
-                    if (b_acc < 0) {
-                        b_acc = 0;
-                    } else if (b_acc > COLOR_B5_MAX) {
-                        b_acc = COLOR_B5_MAX;
-                    }
-
-                    pixel = COLOR_R5_G6_B5_TO_RGB565(r_acc, g_acc, b_acc);
+                    pixel = mix_pixel(pixel, wt);
                     IMAGE_PUT_RGB565_PIXEL_FAST(row_ptr, x, pixel);
                 }
             }
@@ -265,12 +449,27 @@ void shared_module_bitmapfilter_mix(
     }
 }
 
+static inline int solarize_pixel(int pixel, int threshold_i) {
+    int y = COLOR_RGB565_TO_Y(pixel);
+    if (y > threshold_i) {
+        y = MIN(255, MAX(0, 2 * threshold_i - y));
+        int u = COLOR_RGB565_TO_U(pixel);
+        int v = COLOR_RGB565_TO_V(pixel);
+        pixel = COLOR_YUV_TO_RGB565(y, u, v);
+    }
+    return pixel;
+}
+
+static int solarize_fixed_threshold(const mp_float_t threshold) {
+    return (int32_t)MICROPY_FLOAT_C_FUN(round)(256 * threshold);
+}
+
 void shared_module_bitmapfilter_solarize(
     displayio_bitmap_t *bitmap,
     displayio_bitmap_t *mask,
     const mp_float_t threshold) {
 
-    int threshold_i = (int32_t)MICROPY_FLOAT_C_FUN(round)(256 * threshold);
+    int threshold_i = solarize_fixed_threshold(threshold);
     switch (bitmap->bits_per_value) {
         default:
             mp_raise_ValueError(MP_ERROR_TEXT("unsupported bitmap depth"));
@@ -282,14 +481,8 @@ void shared_module_bitmapfilter_solarize(
                         continue; // Short circuit.
                     }
                     int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
-                    int y = COLOR_RGB565_TO_Y(pixel);
-                    if (y > threshold_i) {
-                        y = MIN(255, MAX(0, 2 * threshold_i - y));
-                        int u = COLOR_RGB565_TO_U(pixel);
-                        int v = COLOR_RGB565_TO_V(pixel);
-                        pixel = COLOR_YUV_TO_RGB565(y, u, v);
-                        IMAGE_PUT_RGB565_PIXEL_FAST(row_ptr, x, pixel);
-                    }
+                    pixel = solarize_pixel(pixel, threshold_i);
+                    IMAGE_PUT_RGB565_PIXEL_FAST(row_ptr, x, pixel);
                 }
             }
             break;
@@ -297,6 +490,18 @@ void shared_module_bitmapfilter_solarize(
     }
 }
 
+static inline int lookup_pixel(int pixel, const bitmapfilter_lookup_table_t *table) {
+    int r = COLOR_RGB565_TO_R5(pixel);
+    int g = COLOR_RGB565_TO_G6(pixel);
+    int b = COLOR_RGB565_TO_B5(pixel);
+
+    r = table->r[r];
+    g = table->g[g];
+    b = table->b[b];
+
+    return COLOR_R5_G6_B5_TO_RGB565(r, g, b);
+}
+
 void shared_module_bitmapfilter_lookup(
     displayio_bitmap_t *bitmap,
     displayio_bitmap_t *mask,
@@ -313,15 +518,7 @@ void shared_module_bitmapfilter_lookup(
                         continue; // Short circuit.
                     }
                     int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
-                    int r = COLOR_RGB565_TO_R5(pixel);
-                    int g = COLOR_RGB565_TO_G6(pixel);
-                    int b = COLOR_RGB565_TO_B5(pixel);
-
-                    r = table->r[r];
-                    g = table->g[g];
-                    b = table->b[b];
-
-                    pixel = COLOR_R5_G6_B5_TO_RGB565(r, g, b);
+                    pixel = lookup_pixel(pixel, table);
                     IMAGE_PUT_RGB565_PIXEL_FAST(row_ptr, x, pixel);
                 }
             }
@@ -330,12 +527,7 @@ void shared_module_bitmapfilter_lookup(
     }
 }
 
-void shared_module_bitmapfilter_false_color(
-    displayio_bitmap_t *bitmap,
-    displayio_bitmap_t *mask,
-    _displayio_color_t palette[256]) {
-
-    uint16_t table[256];
+static void false_color_table(const _displayio_color_t palette[256], uint16_t table[256]) {
     for (int i = 0; i < 256; i++) {
         uint32_t rgb888 = palette[i].rgb888;
         int r = rgb888 >> 16;
@@ -343,6 +535,15 @@ void shared_module_bitmapfilter_false_color(
         int b = rgb888 & 0xff;
         table[i] = COLOR_R8_G8_B8_TO_RGB565(r, g, b);
     }
+}
+
+void shared_module_bitmapfilter_false_color(
+    displayio_bitmap_t *bitmap,
+    displayio_bitmap_t *mask,
+    _displayio_color_t palette[256]) {
+
+    uint16_t table[256];
+    false_color_table(palette, table);
 
     switch (bitmap->bits_per_value) {
         default:
@@ -424,3 +625,126 @@ void shared_module_bitmapfilter_blend(
         }
     }
 }
+
+void shared_module_bitmapfilter_pipeline_construct(bitmapfilter_pipeline_obj_t *self) {
+    self->stages = NULL;
+    self->len = self->alloc = 0;
+}
+
+static bitmapfilter_stage_t *pipeline_add_stage(bitmapfilter_pipeline_obj_t *self, bitmapfilter_stage_kind_t kind) {
+    if (self->len == self->alloc) {
+        size_t new_alloc = self->alloc ? 2 * self->alloc : 4;
+        self->stages = m_renew(bitmapfilter_stage_t, self->stages, self->alloc, new_alloc);
+        self->alloc = new_alloc;
+    }
+    bitmapfilter_stage_t *stage = &self->stages[self->len++];
+    stage->kind = kind;
+    return stage;
+}
+
+void shared_module_bitmapfilter_pipeline_mix(bitmapfilter_pipeline_obj_t *self, const mp_float_t weights[12]) {
+    mix_fixed_weights(weights, pipeline_add_stage(self, BITMAPFILTER_STAGE_MIX)->mix);
+}
+
+void shared_module_bitmapfilter_pipeline_solarize(bitmapfilter_pipeline_obj_t *self, const mp_float_t threshold) {
+    pipeline_add_stage(self, BITMAPFILTER_STAGE_SOLARIZE)->solarize = solarize_fixed_threshold(threshold);
+}
+
+void shared_module_bitmapfilter_pipeline_lookup(bitmapfilter_pipeline_obj_t *self, const bitmapfilter_lookup_table_t *table) {
+    pipeline_add_stage(self, BITMAPFILTER_STAGE_LOOKUP)->lookup = *table;
+}
+
+void shared_module_bitmapfilter_pipeline_false_color(bitmapfilter_pipeline_obj_t *self, _displayio_color_t palette[256]) {
+    false_color_table(palette, pipeline_add_stage(self, BITMAPFILTER_STAGE_FALSE_COLOR)->false_color);
+}
+
+void shared_module_bitmapfilter_pipeline_morph(
+    bitmapfilter_pipeline_obj_t *self,
+    const int ksize,
+    const int *krn,
+    const mp_float_t m,
+    const mp_float_t b,
+    bool threshold,
+    int offset,
+    bool invert) {
+
+    size_t n_weights = (2 * ksize + 1) * (2 * ksize + 1);
+    int *krn_copy = m_new(int, n_weights);
+    memcpy(krn_copy, krn, n_weights * sizeof(int));
+
+    bitmapfilter_stage_t *stage = pipeline_add_stage(self, BITMAPFILTER_STAGE_MORPH);
+    stage->morph.krn = krn_copy;
+    stage->morph.ksize = ksize;
+    stage->morph.m = m;
+    stage->morph.b = b;
+    stage->morph.threshold = threshold;
+    stage->morph.offset = offset;
+    stage->morph.invert = invert;
+}
+
+// Run a sequence of per-pixel stages over the bitmap in a single pass, so
+// each pixel is loaded and stored once no matter how many stages there are.
+static void pipeline_pointwise(
+    displayio_bitmap_t *bitmap,
+    displayio_bitmap_t *mask,
+    const bitmapfilter_stage_t *first,
+    const bitmapfilter_stage_t *last) {
+
+    for (int y = 0, yy = bitmap->height; y < yy; y++) {
+        uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, y);
+        for (int x = 0, xx = bitmap->width; x < xx; x++) {
+            if (mask && common_hal_displayio_bitmap_get_pixel(mask, x, y)) {
+                continue; // Short circuit.
+            }
+            int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
+            for (const bitmapfilter_stage_t *stage = first; stage != last; stage++) {
+                switch (stage->kind) {
+                    case BITMAPFILTER_STAGE_MIX:
+                        pixel = mix_pixel(pixel, stage->mix);
+                        break;
+                    case BITMAPFILTER_STAGE_SOLARIZE:
+                        pixel = solarize_pixel(pixel, stage->solarize);
+                        break;
+                    case BITMAPFILTER_STAGE_LOOKUP:
+                        pixel = lookup_pixel(pixel, &stage->lookup);
+                        break;
+                    case BITMAPFILTER_STAGE_FALSE_COLOR:
+                        pixel = stage->false_color[COLOR_RGB565_TO_Y(pixel)];
+                        break;
+                    default:
+                        break;
+                }
+            }
+            IMAGE_PUT_RGB565_PIXEL_FAST(row_ptr, x, pixel);
+        }
+    }
+}
+
+void shared_module_bitmapfilter_pipeline_apply(
+    bitmapfilter_pipeline_obj_t *self,
+    displayio_bitmap_t *bitmap,
+    displayio_bitmap_t *mask) {
+
+    if (bitmap->bits_per_value != 16) {
+        mp_raise_ValueError(MP_ERROR_TEXT("unsupported bitmap depth"));
+    }
+
+    // Neighborhood stages such as morph need the finished output of the
+    // stages before them, so they split the pipeline into separate passes.
+    const bitmapfilter_stage_t *stage = self->stages, *end = self->stages + self->len;
+    while (stage != end) {
+        if (stage->kind == BITMAPFILTER_STAGE_MORPH) {
+            shared_module_bitmapfilter_morph(bitmap, mask, stage->morph.ksize, stage->morph.krn,
+                stage->morph.m, stage->morph.b, stage->morph.threshold, stage->morph.offset,
+                stage->morph.invert);
+            stage++;
+            continue;
+        }
+        const bitmapfilter_stage_t *run_end = stage;
+        while (run_end != end && run_end->kind != BITMAPFILTER_STAGE_MORPH) {
+            run_end++;
+        }
+        pipeline_pointwise(bitmap, mask, stage, run_end);
+        stage = run_end;
+    }
+}
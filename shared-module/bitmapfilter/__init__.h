@@ -5,3 +5,42 @@
 // SPDX-License-Identifier: MIT
 
 #pragma once
+
+#include "py/obj.h"
+
+typedef struct {
+    uint8_t r[32], g[64], b[32];
+} bitmapfilter_lookup_table_t;
+
+typedef enum {
+    BITMAPFILTER_STAGE_MIX,
+    BITMAPFILTER_STAGE_SOLARIZE,
+    BITMAPFILTER_STAGE_LOOKUP,
+    BITMAPFILTER_STAGE_FALSE_COLOR,
+    BITMAPFILTER_STAGE_MORPH,
+} bitmapfilter_stage_kind_t;
+
+// One step of a Pipeline, with its parameters already converted to the
+// fixed-point or table form used by the per-pixel code.
+typedef struct {
+    bitmapfilter_stage_kind_t kind;
+    union {
+        int32_t mix[12];
+        int solarize;
+        bitmapfilter_lookup_table_t lookup;
+        uint16_t false_color[256];
+        struct {
+            int *krn;
+            int ksize;
+            mp_float_t m, b;
+            int offset;
+            bool threshold, invert;
+        } morph;
+    };
+} bitmapfilter_stage_t;
+
+typedef struct {
+    mp_obj_base_t base;
+    bitmapfilter_stage_t *stages;
+    size_t len, alloc;
+} bitmapfilter_pipeline_obj_t;
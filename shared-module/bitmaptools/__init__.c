@@ -221,6 +221,16 @@ void common_hal_bitmaptools_fill_region(displayio_bitmap_t *destination,
     // update the dirty rectangle
     displayio_bitmap_set_dirty_area(destination, &area);
 
+    if (destination->bits_per_value >= 8 && !displayio_area_empty(&area)) {
+        uint8_t bytes_per_value = destination->bits_per_value / 8;
+        uint8_t *dest = (uint8_t *)(destination->data + area.y1 * destination->stride) + area.x1 * bytes_per_value;
+        if (displayio_port_fill_rect(dest, destination->stride * sizeof(uint32_t),
+            displayio_area_width(&area), displayio_area_height(&area), bytes_per_value,
+            value & destination->bitmask)) {
+            return;
+        }
+    }
+
     int16_t x, y;
     for (x = area.x1; x < area.x2; x++) {
         for (y = area.y1; y < area.y2; y++) {
@@ -730,24 +740,18 @@ static void fill_row(displayio_bitmap_t *bitmap, int swap, int16_t *luminance_da
     }
 }
 
-static void write_pixels(displayio_bitmap_t *bitmap, int y, bool *data) {
-    if (bitmap->bits_per_value == 1) {
-        uint32_t *pixel_data = (uint32_t *)(bitmap->data + bitmap->stride * y);
-        for (int i = 0; i < bitmap->width; i++) {
-            uint32_t p = 0;
-            for (int j = 0; j < 32; j++) {
-                p = (p << 1);
-                if (*data++) {
-                    p |= 1;
-                }
-            }
-            *pixel_data++ = p;
+// Store one output pixel straight into the destination row. 1bpp output is
+// collected in *word and stored a whole word at a time once word_done is
+// set, so each direction of the serpentine scan writes each word once.
+static inline void write_dither_pixel(uint32_t *row_data, bool one_bit, int x, bool pixel_out, bool word_done, uint32_t *word) {
+    if (one_bit) {
+        *word |= (uint32_t)pixel_out << (31 - (x & 31));
+        if (word_done) {
+            row_data[x >> 5] = *word;
+            *word = 0;
         }
     } else {
-        uint16_t *pixel_data = (uint16_t *)(bitmap->data + bitmap->stride * y);
-        for (int i = 0; i < bitmap->width; i++) {
-            *pixel_data++ = *data++ ? 65535 : 0;
-        }
+        ((uint16_t *)row_data)[x] = pixel_out ? 65535 : 0;
     }
 }
 
@@ -770,8 +774,7 @@ void common_hal_bitmaptools_dither(displayio_bitmap_t *dest_bitmap, displayio_bi
     int16_t *rows[3] = {
         rowdata + info->mx, rowdata + width + info->mx * 3, rowdata + 2 * width + info->mx * 5
     };
-    // out holds one output row of pixels, and is padded to be a multiple of 32 so that the 1bpp storage loop can be simplified
-    bool out[(width + 31) / 32 * 32];
+    bool one_bit = dest_bitmap->bits_per_value == 1;
 
     fill_row(source_bitmap, swap, rows[0], 0, info->mx);
     fill_row(source_bitmap, swap, rows[1], 1, info->mx);
@@ -780,12 +783,14 @@ void common_hal_bitmaptools_dither(displayio_bitmap_t *dest_bitmap, displayio_bi
     int16_t err = 0;
 
     for (int y = 0; y < height; y++) {
+        uint32_t *row_data = dest_bitmap->data + dest_bitmap->stride * y;
+        uint32_t word = 0;
 
         // Serpentine dither.  Going left-to-right...
         for (int x = 0; x < width; x++) {
             int32_t pixel_in = rows[0][x] + err;
             bool pixel_out = pixel_in >= 128;
-            out[x] = pixel_out;
+            write_dither_pixel(row_data, one_bit, x, pixel_out, (x & 31) == 31 || x == width - 1, &word);
 
             err = pixel_in - (pixel_out ? 255 : 0);
 
@@ -797,7 +802,6 @@ void common_hal_bitmaptools_dither(displayio_bitmap_t *dest_bitmap, displayio_bi
             }
             err = (err * info->dl) / 256;
         }
-        write_pixels(dest_bitmap, y, out);
 
         // Cycle the rows by shuffling pointers, this is faster than copying the data.
         int16_t *tmp = rows[0];
@@ -812,11 +816,13 @@ void common_hal_bitmaptools_dither(displayio_bitmap_t *dest_bitmap, displayio_bi
 
         fill_row(source_bitmap, swap, rows[2], y + 2, info->mx);
 
+        row_data = dest_bitmap->data + dest_bitmap->stride * y;
+
         // Serpentine dither.   Going right-to-left...
         for (int x = width; x--;) {
             int16_t pixel_in = rows[0][x] + err;
             bool pixel_out = pixel_in >= 128;
-            out[x] = pixel_out;
+            write_dither_pixel(row_data, one_bit, x, pixel_out, (x & 31) == 0, &word);
             err = pixel_in - (pixel_out ? 255 : 0);
 
             for (int i = 0; i < info->count; i++) {
@@ -827,7 +833,6 @@ void common_hal_bitmaptools_dither(displayio_bitmap_t *dest_bitmap, displayio_bi
             }
             err = (err * info->dl) / 256;
         }
-        write_pixels(dest_bitmap, y, out);
 
         tmp = rows[0];
         rows[0] = rows[1];
@@ -848,8 +853,17 @@ void common_hal_bitmaptools_alphablend(displayio_bitmap_t *dest, displayio_bitma
 
     int ifactor1 = (int)(factor1 * 256);
     int ifactor2 = (int)(factor2 * 256);
+    int ifactor_blend = ifactor1 + ifactor2 - ifactor1 * ifactor2 / 256;
     bool blend_source1, blend_source2;
 
+    // With in-range factors, a normal (src-over) blend followed by the divide
+    // by the blended alpha is a fixed weighted sum of the two sources, with
+    // weights out of 256. That avoids the per-pixel divisions below.
+    bool fixed_weights = blendmode == BITMAPTOOLS_BLENDMODE_NORMAL
+        && ifactor1 >= 0 && ifactor1 <= 256 && ifactor2 >= 0 && ifactor2 <= 256 && ifactor_blend > 0;
+    uint32_t weight2 = fixed_weights ? ifactor2 * 256 / ifactor_blend : 0;
+    uint32_t weight1 = 256 - weight2;
+
     if (colorspace == DISPLAYIO_COLORSPACE_L8) {
         for (int y = 0; y < dest->height; y++) {
             uint8_t *dptr = (uint8_t *)(dest->data + y * dest->stride);
@@ -859,7 +873,9 @@ void common_hal_bitmaptools_alphablend(displayio_bitmap_t *dest, displayio_bitma
             for (int x = 0; x < dest->width; x++) {
                 blend_source1 = skip_source1_index_none || *sptr1 != (uint8_t)skip_source1_index;
                 blend_source2 = skip_source2_index_none || *sptr2 != (uint8_t)skip_source2_index;
-                if (blend_source1 && blend_source2) {
+                if (blend_source1 && blend_source2 && fixed_weights) {
+                    pixel = (*sptr1++ *weight1 + *sptr2++ *weight2) >> 8;
+                } else if (blend_source1 && blend_source2) {
                     // Premultiply by the alpha factor
                     int sda = *sptr1++ *ifactor1;
                     int sca = *sptr2++ *ifactor2;
@@ -907,12 +923,23 @@ void common_hal_bitmaptools_alphablend(displayio_bitmap_t *dest, displayio_bitma
                 blend_source1 = skip_source1_index_none || spix1 != (int)skip_source1_index;
                 blend_source2 = skip_source2_index_none || spix2 != (int)skip_source2_index;
 
-                if (blend_source1 && blend_source2) {
+                if (blend_source1 && blend_source2 && fixed_weights) {
+                    // Spread red and blue apart so that both can be weighted
+                    // with one multiply without carrying into each other.
+                    uint32_t rb1 = (spix1 & b_mask) | ((spix1 & r_mask) << 5);
+                    uint32_t rb2 = (spix2 & b_mask) | ((spix2 & r_mask) << 5);
+                    uint32_t rb = ((rb1 * weight1 + rb2 * weight2) >> 8) & 0x001f001f;
+                    uint32_t g = (((spix1 & g_mask) * weight1 + (spix2 & g_mask) * weight2) >> 8) & g_mask;
+
+                    pixel = ((rb >> 5) & r_mask) | g | (rb & b_mask);
+
+                    if (swap) {
+                        pixel = __builtin_bswap16(pixel);
+                    }
+                } else if (blend_source1 && blend_source2) {
                     // Blend based on the SVG alpha compositing specs
                     // https://dev.w3.org/SVG/modules/compositing/master/#alphaCompositing
 
-                    int ifactor_blend = ifactor1 + ifactor2 - ifactor1 * ifactor2 / 256;
-
                     // Premultiply the colors by the alpha factor
                     int red_dca = ((spix1 & r_mask) >> 8) * ifactor1;
                     int grn_dca = ((spix1 & g_mask) >> 3) * ifactor1;
@@ -952,16 +979,22 @@ void common_hal_bitmaptools_alphablend(displayio_bitmap_t *dest, displayio_bitma
                     }
                 } else if (blend_source1) {
                     // Apply iFactor1 to source1 only
-                    int r = (spix1 & r_mask) * ifactor1 / 256;
-                    int g = (spix1 & g_mask) * ifactor1 / 256;
-                    int b = (spix1 & b_mask) * ifactor1 / 256;
+                    int r = MIN(r_mask, MAX(0, (spix1 & r_mask) * ifactor1 / 256)) & r_mask;
+                    int g = MIN(g_mask, MAX(0, (spix1 & g_mask) * ifactor1 / 256)) & g_mask;
+                    int b = MIN(b_mask, MAX(0, (spix1 & b_mask) * ifactor1 / 256)) & b_mask;
                     pixel = r | g | b;
+                    if (swap) {
+                        pixel = __builtin_bswap16(pixel);
+                    }
                 } else if (blend_source2) {
                     // Apply iFactor2 to source1 only
-                    int r = (spix2 & r_mask) * ifactor2 / 256;
-                    int g = (spix2 & g_mask) * ifactor2 / 256;
-                    int b = (spix2 & b_mask) * ifactor2 / 256;
+                    int r = MIN(r_mask, MAX(0, (spix2 & r_mask) * ifactor2 / 256)) & r_mask;
+                    int g = MIN(g_mask, MAX(0, (spix2 & g_mask) * ifactor2 / 256)) & g_mask;
+                    int b = MIN(b_mask, MAX(0, (spix2 & b_mask) * ifactor2 / 256)) & b_mask;
                     pixel = r | g | b;
+                    if (swap) {
+                        pixel = __builtin_bswap16(pixel);
+                    }
                 } else {
                     // Use the destination value
                     pixel = *dptr;
@@ -1034,6 +1067,94 @@ void common_hal_bitmaptools_draw_circle(displayio_bitmap_t *destination,
     draw_circle(destination, x, y, radius, value);
 }
 
+// Copy nbits bits from src to dst, a word at a time. Bit offsets count from the
+// most significant bit of the first word, matching the packing of sub-byte pixels.
+// The source and destination ranges must not overlap.
+static void copy_bits(uint32_t *dst, uint32_t dst_bit, const uint32_t *src, uint32_t src_bit, uint32_t nbits) {
+    while (nbits > 0) {
+        const uint32_t dst_offset = dst_bit & 31;
+        const uint32_t n = MIN(nbits, 32 - dst_offset);
+
+        // Gather the next n source bits at the top of v.
+        const uint32_t *src_word = src + (src_bit >> 5);
+        const uint32_t src_offset = src_bit & 31;
+        uint32_t v = src_word[0] << src_offset;
+        if (src_offset + n > 32) {
+            v |= src_word[1] >> (32 - src_offset);
+        }
+
+        const uint32_t mask = n == 32 ? 0xffffffff : ~(0xffffffff >> n);
+        uint32_t *dst_word = dst + (dst_bit >> 5);
+        *dst_word = (*dst_word & ~(mask >> dst_offset)) | ((v & mask) >> dst_offset);
+
+        dst_bit += n;
+        src_bit += n;
+        nbits -= n;
+    }
+}
+
+// Blit without skip indices between bitmaps of the same depth by copying whole rows.
+// Returns false if the copy has to be done pixel by pixel instead.
+static bool blit_rows(displayio_bitmap_t *destination, displayio_bitmap_t *source, int16_t x, int16_t y,
+    int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
+    const uint32_t bits_per_value = source->bits_per_value;
+    if (bits_per_value != destination->bits_per_value) {
+        return false;
+    }
+
+    // Clip the destination to its bitmap, moving the source start to match.
+    int xs = x1, xd = x, width = x2 - x1;
+    if (xd < 0) {
+        xs -= xd;
+        width += xd;
+        xd = 0;
+    }
+    width = MIN(width, destination->width - xd);
+    int ys = y1, yd = y, height = y2 - y1;
+    if (yd < 0) {
+        ys -= yd;
+        height += yd;
+        yd = 0;
+    }
+    height = MIN(height, destination->height - yd);
+    if (width <= 0 || height <= 0) {
+        return true;
+    }
+
+    const bool same = source == destination;
+    if (bits_per_value >= 8 && !same) {
+        const size_t bytes_per_value = bits_per_value / 8;
+        if (displayio_port_copy_rect(
+            (uint8_t *)(destination->data + yd * destination->stride) + xd * bytes_per_value,
+            destination->stride * sizeof(uint32_t),
+            (const uint8_t *)(source->data + ys * source->stride) + xs * bytes_per_value,
+            source->stride * sizeof(uint32_t), width, height, bytes_per_value)) {
+            return true;
+        }
+    }
+    if (bits_per_value < 8 && same && ys == yd && xd > xs) {
+        // copy_bits() can only copy forwards within a row.
+        return false;
+    }
+
+    // Copy rows bottom up when moving down within the same bitmap.
+    const bool reverse = same && yd > ys;
+    for (int j = 0; j < height; j++) {
+        const int row = reverse ? height - j - 1 : j;
+        uint32_t *dst_row = destination->data + (yd + row) * destination->stride;
+        const uint32_t *src_row = source->data + (ys + row) * source->stride;
+        if (bits_per_value >= 8) {
+            const size_t bytes_per_value = bits_per_value / 8;
+            memmove((uint8_t *)dst_row + xd * bytes_per_value,
+                (const uint8_t *)src_row + xs * bytes_per_value,
+                width * bytes_per_value);
+        } else {
+            copy_bits(dst_row, xd * bits_per_value, src_row, xs * bits_per_value, width * bits_per_value);
+        }
+    }
+    return true;
+}
+
 void common_hal_bitmaptools_blit(displayio_bitmap_t *destination, displayio_bitmap_t *source, int16_t x, int16_t y,
     int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint32_t skip_source_index, bool skip_source_index_none, uint32_t skip_dest_index,
     bool skip_dest_index_none) {
@@ -1059,6 +1180,11 @@ void common_hal_bitmaptools_blit(displayio_bitmap_t *destination, displayio_bitm
     displayio_area_t a = { x, y, dirty_x_max, dirty_y_max, NULL};
     displayio_bitmap_set_dirty_area(destination, &a);
 
+    if (skip_source_index_none && skip_dest_index_none &&
+        blit_rows(destination, source, x, y, x1, y1, x2, y2)) {
+        return;
+    }
+
     bool x_reverse = false;
     bool y_reverse = false;
 
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: MIT
 
 #include "shared-bindings/bitops/__init__.h"
+#include "shared-module/bitops/__init__.h"
 
 #include <stdint.h>
 #include <stdlib.h>
@@ -51,6 +52,8 @@ static void transpose_var(uint32_t *result, const uint8_t *src, int src_stride,
         case 2:
             y |= *src << 8;
             src -= src_stride;
+            MP_FALLTHROUGH;
+        case 1:
             y |= *src;
     }
 
@@ -118,6 +121,14 @@ static void transpose_8(uint32_t *result, const uint8_t *src, int src_stride) {
     result[1] = y;
 }
 
+static void transpose_group(uint32_t *result, const uint8_t *src, int src_stride, int num_strands) {
+    if (num_strands == 8) {
+        transpose_8(result, src, src_stride);
+    } else {
+        transpose_var(result, src, src_stride, num_strands);
+    }
+}
+
 static void bit_transpose_8(uint32_t *result, const uint8_t *src, size_t src_stride, size_t n) {
     for (size_t i = 0; i < n; i++) {
         transpose_8(result, src, src_stride);
@@ -134,10 +145,33 @@ static void bit_transpose_var(uint32_t *result, const uint8_t *src, size_t src_s
     }
 }
 
-void common_hal_bitops_bit_transpose(uint8_t *result, const uint8_t *src, size_t inlen, size_t num_strands) {
-    if (num_strands == 8) {
-        bit_transpose_8((uint32_t *)(void *)result, src, inlen / 8, inlen / 8);
+// More than 8 strands are transposed as the first 8 and the rest, each with
+// the 8x8 kernels, and the two results are interleaved a byte at a time.
+static void bit_transpose_wide(uint8_t *result, const uint8_t *src, size_t src_stride, size_t n, int num_strands) {
+    for (size_t i = 0; i < n; i++) {
+        uint32_t lo[2], hi[2];
+        transpose_8(lo, src, src_stride);
+        transpose_group(hi, src + 8 * src_stride, src_stride, num_strands - 8);
+        const uint8_t *lo_bytes = (const uint8_t *)lo;
+        const uint8_t *hi_bytes = (const uint8_t *)hi;
+        for (size_t j = 0; j < 8; j++) {
+            *result++ = lo_bytes[j];
+            *result++ = hi_bytes[j];
+        }
+        src += 1;
+    }
+}
+
+void shared_module_bitops_bit_transpose_into(uint8_t *result, const uint8_t *src, size_t src_stride, size_t n, size_t num_strands) {
+    if (num_strands > 8) {
+        bit_transpose_wide(result, src, src_stride, n, num_strands);
+    } else if (num_strands == 8) {
+        bit_transpose_8((uint32_t *)(void *)result, src, src_stride, n);
     } else {
-        bit_transpose_var((uint32_t *)(void *)result, src, inlen / num_strands, inlen / num_strands, num_strands);
+        bit_transpose_var((uint32_t *)(void *)result, src, src_stride, n, num_strands);
     }
 }
+
+void common_hal_bitops_bit_transpose(uint8_t *result, const uint8_t *src, size_t inlen, size_t num_strands) {
+    shared_module_bitops_bit_transpose_into(result, src, inlen / num_strands, inlen / num_strands, num_strands);
+}
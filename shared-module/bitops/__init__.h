@@ -5,3 +5,12 @@
 // SPDX-License-Identifier: MIT
 
 #pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Transpose n bytes from each of num_strands strands that start src_stride
+// bytes apart, so a caller can fill a DMA buffer a piece at a time from a
+// larger source. Writes 8 * n bytes, or 16 * n when there are more than 8
+// strands. result must be 4-byte aligned.
+void shared_module_bitops_bit_transpose_into(uint8_t *result, const uint8_t *src, size_t src_stride, size_t n, size_t num_strands);
@@ -20,8 +20,10 @@
 #include "shared-bindings/time/__init__.h"
 #include "shared-module/displayio/__init__.h"
 #include "shared-module/displayio/display_core.h"
+#include "supervisor/port_heap.h"
 #include "supervisor/shared/display.h"
 #include "supervisor/shared/tick.h"
+#include "supervisor/shared/trace.h"
 
 #if CIRCUITPY_TINYUSB
 #include "supervisor/usb.h"
@@ -64,6 +66,8 @@ void common_hal_busdisplay_busdisplay_construct(busdisplay_busdisplay_obj_t *sel
     self->native_frames_per_second = native_frames_per_second;
     self->native_ms_per_frame = 1000 / native_frames_per_second;
 
+    common_hal_busdisplay_busdisplay_set_refresh_buffer_size(self, CIRCUITPY_BUSDISPLAY_REFRESH_BUFFER_SIZE);
+
     uint32_t i = 0;
     while (i < init_sequence_len) {
         uint8_t *cmd = init_sequence + i;
@@ -136,6 +140,38 @@ uint16_t common_hal_busdisplay_busdisplay_get_height(busdisplay_busdisplay_obj_t
     return displayio_display_core_get_height(&self->core);
 }
 
+uint32_t common_hal_busdisplay_busdisplay_get_refresh_buffer_size(busdisplay_busdisplay_obj_t *self) {
+    if (self->refresh_buffer == NULL) {
+        return 0;
+    }
+    return self->refresh_buffer_size * sizeof(uint32_t);
+}
+
+void common_hal_busdisplay_busdisplay_set_refresh_buffer_size(busdisplay_busdisplay_obj_t *self, uint32_t size) {
+    if (self->refresh_buffer != NULL) {
+        port_free(self->refresh_buffer);
+        self->refresh_buffer = NULL;
+        self->refresh_mask = NULL;
+        self->refresh_buffer_size = 0;
+    }
+    uint32_t buffer_size = size / sizeof(uint32_t);
+    if (buffer_size == 0) {
+        return;
+    }
+    // The mask has one bit per pixel that fits in the buffer.
+    uint8_t pixels_per_word = (sizeof(uint32_t) * 8) / self->core.colorspace.depth;
+    uint32_t mask_length = (buffer_size * pixels_per_word / 32) + 1;
+    // Pixels are DMAed straight out of the buffer on ports that support it.
+    uint32_t *buffer = port_malloc((buffer_size + mask_length) * sizeof(uint32_t), true);
+    if (buffer == NULL) {
+        // Fall back to the stack buffer.
+        return;
+    }
+    self->refresh_buffer = buffer;
+    self->refresh_mask = buffer + buffer_size;
+    self->refresh_buffer_size = buffer_size;
+}
+
 mp_float_t common_hal_busdisplay_busdisplay_get_brightness(busdisplay_busdisplay_obj_t *self) {
     return self->current_brightness;
 }
@@ -189,6 +225,10 @@ mp_obj_t common_hal_busdisplay_busdisplay_get_bus(busdisplay_busdisplay_obj_t *s
     return self->bus.bus;
 }
 
+mp_obj_t common_hal_busdisplay_busdisplay_get_refresh_stats(busdisplay_busdisplay_obj_t *self) {
+    return displayio_display_core_get_refresh_stats(&self->core);
+}
+
 mp_obj_t common_hal_busdisplay_busdisplay_get_root_group(busdisplay_busdisplay_obj_t *self) {
     if (self->core.current_group == NULL) {
         return mp_const_none;
@@ -213,8 +253,30 @@ static void _send_pixels(busdisplay_busdisplay_obj_t *self, uint8_t *pixels, uin
     self->bus.send(self->bus.bus, DISPLAY_DATA, CHIP_SELECT_UNTOUCHED, pixels, length);
 }
 
+// Like _send_pixels but may return before the pixels are sent. pixels must not change until
+// the bus's wait_for_send returns.
+static void _start_send_pixels(busdisplay_busdisplay_obj_t *self, uint8_t *pixels, uint32_t length) {
+    if (!self->bus.data_as_commands) {
+        self->bus.send(self->bus.bus, DISPLAY_COMMAND, CHIP_SELECT_TOGGLE_EVERY_BYTE, &self->write_ram_command, 1);
+    }
+    displayio_display_bus_start_send(&self->bus, DISPLAY_DATA, CHIP_SELECT_UNTOUCHED, pixels, length);
+}
+
 static bool _refresh_area(busdisplay_busdisplay_obj_t *self, const displayio_area_t *area) {
-    uint16_t buffer_size = 128; // In uint32_ts
+    // The persistent buffer isn't used for SH1107 because its mask would need to cover the
+    // whole area.
+    bool use_refresh_buffer = self->refresh_buffer != NULL && !self->bus.SH1107_addressing;
+    // When the bus can send in the background, split the persistent buffer in two so that one
+    // half is filled while the other is being sent.
+    bool pipelined = use_refresh_buffer &&
+        (self->bus.start_send != NULL || self->bus.second_core_send);
+    uint32_t buffer_size = 128; // In uint32_ts
+    if (pipelined) {
+        buffer_size = self->refresh_buffer_size / 2;
+    } else if (use_refresh_buffer) {
+        buffer_size = self->refresh_buffer_size;
+    }
+    const uint32_t buffer_capacity = buffer_size;
 
     displayio_area_t clipped;
     // Clip the area to the display by overlapping the areas. If there is no overlap then we're done.
@@ -223,7 +285,7 @@ static bool _refresh_area(busdisplay_busdisplay_obj_t *self, const displayio_are
     }
     uint16_t rows_per_buffer = displayio_area_height(&clipped);
     uint8_t pixels_per_word = (sizeof(uint32_t) * 8) / self->core.colorspace.depth;
-    uint16_t pixels_per_buffer = displayio_area_size(&clipped);
+    uint32_t pixels_per_buffer = displayio_area_size(&clipped);
 
     uint16_t subrectangles = 1;
     // for SH1107 and other boundary constrained controllers
@@ -252,13 +314,35 @@ static bool _refresh_area(busdisplay_busdisplay_obj_t *self, const displayio_are
         if (pixels_per_buffer % pixels_per_word) {
             buffer_size += 1;
         }
+    } else if (use_refresh_buffer) {
+        // Only clear the part of a large buffer that this area needs.
+        buffer_size = pixels_per_buffer / pixels_per_word;
+        if (pixels_per_buffer % pixels_per_word) {
+            buffer_size += 1;
+        }
+    }
+    // A single row may not fit in a small persistent buffer. Use the stack instead.
+    if (buffer_size > buffer_capacity) {
+        use_refresh_buffer = false;
+        pipelined = false;
     }
 
     // Allocated and shared as a uint32_t array so the compiler knows the
     // alignment everywhere.
-    uint32_t buffer[buffer_size];
     uint32_t mask_length = (pixels_per_buffer / 32) + 1;
-    uint32_t mask[mask_length];
+    uint32_t stack_buffer[use_refresh_buffer ? 1 : buffer_size];
+    uint32_t stack_mask[use_refresh_buffer ? 1 : mask_length];
+    uint32_t *buffers[2] = {stack_buffer, stack_buffer};
+    uint32_t *mask = stack_mask;
+    if (use_refresh_buffer) {
+        buffers[0] = self->refresh_buffer;
+        buffers[1] = self->refresh_buffer;
+        mask = self->refresh_mask;
+    }
+    if (pipelined) {
+        buffers[1] = self->refresh_buffer + self->refresh_buffer_size / 2;
+    }
+    bool sending = false;
     uint16_t remaining_rows = displayio_area_height(&clipped);
 
     for (uint16_t j = 0; j < subrectangles; j++) {
@@ -273,28 +357,46 @@ static bool _refresh_area(busdisplay_busdisplay_obj_t *self, const displayio_are
         }
         remaining_rows -= rows_per_buffer;
 
-        displayio_display_bus_set_region_to_update(&self->bus, &self->core, &subrectangle);
-
-        uint16_t subrectangle_size_bytes;
+        uint32_t subrectangle_size_bytes;
         if (self->core.colorspace.depth >= 8) {
             subrectangle_size_bytes = displayio_area_size(&subrectangle) * (self->core.colorspace.depth / 8);
         } else {
             subrectangle_size_bytes = displayio_area_size(&subrectangle) / (8 / self->core.colorspace.depth);
         }
 
+        uint32_t *buffer = buffers[j % 2];
         memset(mask, 0, mask_length * sizeof(mask[0]));
         memset(buffer, 0, buffer_size * sizeof(buffer[0]));
 
         displayio_display_core_fill_area(&self->core, &subrectangle, mask, buffer);
 
+        // Finish sending the previous subrectangle before using the bus again.
+        if (sending) {
+            uint32_t wait_start_us = supervisor_ticks_us32();
+            displayio_display_bus_wait_for_send(&self->bus);
+            displayio_display_core_record_send(&self->core, 0, wait_start_us);
+            displayio_display_bus_end_transaction(&self->bus);
+            sending = false;
+        }
+
         // Can't acquire display bus; skip the rest of the data.
         if (!displayio_display_bus_is_free(&self->bus)) {
             return false;
         }
 
+        // One transaction covers the window setup and the pixels.
         displayio_display_bus_begin_transaction(&self->bus);
-        _send_pixels(self, (uint8_t *)buffer, subrectangle_size_bytes);
-        displayio_display_bus_end_transaction(&self->bus);
+        displayio_display_bus_send_region_to_update(&self->bus, &self->core, &subrectangle);
+        uint32_t send_start_us = supervisor_ticks_us32();
+        if (pipelined) {
+            _start_send_pixels(self, (uint8_t *)buffer, subrectangle_size_bytes);
+            displayio_display_core_record_send(&self->core, subrectangle_size_bytes, send_start_us);
+            sending = true;
+        } else {
+            _send_pixels(self, (uint8_t *)buffer, subrectangle_size_bytes);
+            displayio_display_core_record_send(&self->core, subrectangle_size_bytes, send_start_us);
+            displayio_display_bus_end_transaction(&self->bus);
+        }
 
         // TODO(tannewt): Make refresh displays faster so we don't starve other
         // background tasks.
@@ -302,6 +404,12 @@ static bool _refresh_area(busdisplay_busdisplay_obj_t *self, const displayio_are
         usb_background();
         #endif
     }
+    if (sending) {
+        uint32_t wait_start_us = supervisor_ticks_us32();
+        displayio_display_bus_wait_for_send(&self->bus);
+        displayio_display_core_record_send(&self->core, 0, wait_start_us);
+        displayio_display_bus_end_transaction(&self->bus);
+    }
     return true;
 }
 
@@ -310,13 +418,26 @@ static void _refresh_display(busdisplay_busdisplay_obj_t *self) {
         // A refresh on this bus is already in progress.  Try next display.
         return;
     }
+    CIRCUITPY_TRACE_BEGIN(TRACE_EVENT_DISPLAY_REFRESH);
     displayio_display_core_start_refresh(&self->core);
     const displayio_area_t *current_area = _get_refresh_areas(self);
+    #if CIRCUITPY_DISPLAY_COALESCE_AREA_COUNT > 0
+    displayio_area_t coalesced_areas[CIRCUITPY_DISPLAY_COALESCE_AREA_COUNT];
+    current_area = displayio_display_core_coalesce_areas(&self->core, current_area,
+        coalesced_areas, CIRCUITPY_DISPLAY_COALESCE_AREA_COUNT);
+    #endif
+    // Composition stays on this core because it reads Python objects. Only the sends move.
+    bool background_sends = self->refresh_buffer != NULL && !self->bus.SH1107_addressing &&
+        current_area != NULL && displayio_display_bus_start_background_sends(&self->bus);
     while (current_area != NULL) {
         _refresh_area(self, current_area);
         current_area = current_area->next;
     }
+    if (background_sends) {
+        displayio_display_bus_stop_background_sends(&self->bus);
+    }
     displayio_display_core_finish_refresh(&self->core);
+    CIRCUITPY_TRACE_END(TRACE_EVENT_DISPLAY_REFRESH);
 }
 
 void common_hal_busdisplay_busdisplay_set_rotation(busdisplay_busdisplay_obj_t *self, int rotation) {
@@ -354,6 +475,7 @@ bool common_hal_busdisplay_busdisplay_refresh(busdisplay_busdisplay_obj_t *self,
         self->last_refresh_call = current_time;
         // Skip the actual refresh to help catch up.
         if (current_ms_since_last_call > target_ms_per_frame) {
+            displayio_display_core_skip_refresh(&self->core);
             return false;
         }
         uint32_t remaining_time = target_ms_per_frame - (current_ms_since_real_refresh % target_ms_per_frame);
@@ -392,6 +514,79 @@ mp_obj_t common_hal_busdisplay_busdisplay_set_root_group(busdisplay_busdisplay_o
     return mp_const_none;
 }
 
+// Map a pixel coordinate on one axis through the display transform. The mapping is its own
+// inverse so it converts both user to native and native to user coordinates.
+static int16_t _map_coord(uint16_t origin, int8_t delta, int16_t coord) {
+    return delta > 0 ? coord - origin : origin - coord - 1;
+}
+
+bool busdisplay_busdisplay_write_rgb565(busdisplay_busdisplay_obj_t *self, int16_t x, int16_t y,
+    uint16_t width, uint16_t height, const uint16_t *pixels, uint16_t stride) {
+    const displayio_buffer_transform_t *transform = &self->core.transform;
+    int16_t nx1, nx2, ny1, ny2;
+    if (transform->transpose_xy) {
+        nx1 = _map_coord(transform->x, transform->dx, y);
+        nx2 = _map_coord(transform->x, transform->dx, y + height - 1);
+        ny1 = _map_coord(transform->y, transform->dy, x);
+        ny2 = _map_coord(transform->y, transform->dy, x + width - 1);
+    } else {
+        nx1 = _map_coord(transform->x, transform->dx, x);
+        nx2 = _map_coord(transform->x, transform->dx, x + width - 1);
+        ny1 = _map_coord(transform->y, transform->dy, y);
+        ny2 = _map_coord(transform->y, transform->dy, y + height - 1);
+    }
+    displayio_area_t area = {
+        .x1 = MIN(nx1, nx2),
+        .y1 = MIN(ny1, ny2),
+        .x2 = MAX(nx1, nx2) + 1,
+        .y2 = MAX(ny1, ny2) + 1,
+    };
+    displayio_area_t clipped;
+    if (!displayio_display_core_clip_area(&self->core, &area, &clipped)) {
+        return true;
+    }
+
+    // Convert into native order a few rows at a time, but always at least one row.
+    uint16_t native_width = displayio_area_width(&clipped);
+    uint16_t rows_per_buffer = MAX(1, 256 / native_width);
+    uint16_t buffer[native_width * rows_per_buffer];
+    // The pixels are already in the order displayio sends when reverse_bytes_in_word is set.
+    bool swap = !self->core.colorspace.reverse_bytes_in_word;
+
+    for (int16_t row = clipped.y1; row < clipped.y2; row += rows_per_buffer) {
+        displayio_area_t subrectangle = {
+            .x1 = clipped.x1,
+            .y1 = row,
+            .x2 = clipped.x2,
+            .y2 = MIN(row + rows_per_buffer, clipped.y2),
+        };
+        uint16_t *out = buffer;
+        for (int16_t ny = subrectangle.y1; ny < subrectangle.y2; ny++) {
+            for (int16_t nx = subrectangle.x1; nx < subrectangle.x2; nx++) {
+                int16_t ux, uy;
+                if (transform->transpose_xy) {
+                    ux = _map_coord(transform->y, transform->dy, ny);
+                    uy = _map_coord(transform->x, transform->dx, nx);
+                } else {
+                    ux = _map_coord(transform->x, transform->dx, nx);
+                    uy = _map_coord(transform->y, transform->dy, ny);
+                }
+                uint16_t pixel = pixels[(uy - y) * stride + (ux - x)];
+                *out++ = swap ? __builtin_bswap16(pixel) : pixel;
+            }
+        }
+
+        if (!displayio_display_bus_is_free(&self->bus)) {
+            return false;
+        }
+        displayio_display_bus_begin_transaction(&self->bus);
+        displayio_display_bus_send_region_to_update(&self->bus, &self->core, &subrectangle);
+        _send_pixels(self, (uint8_t *)buffer, displayio_area_size(&subrectangle) * sizeof(uint16_t));
+        displayio_display_bus_end_transaction(&self->bus);
+    }
+    return true;
+}
+
 void busdisplay_busdisplay_background(busdisplay_busdisplay_obj_t *self) {
     if (self->auto_refresh && (supervisor_ticks_ms64() - self->core.last_refresh) > self->native_ms_per_frame) {
         _refresh_display(self);
@@ -400,6 +595,7 @@ void busdisplay_busdisplay_background(busdisplay_busdisplay_obj_t *self) {
 
 void release_busdisplay(busdisplay_busdisplay_obj_t *self) {
     common_hal_busdisplay_busdisplay_set_auto_refresh(self, false);
+    common_hal_busdisplay_busdisplay_set_refresh_buffer_size(self, 0);
     release_display_core(&self->core);
     #if (CIRCUITPY_PWMIO)
     if (self->backlight_pwm.base.type == &pwmio_pwmout_type) {
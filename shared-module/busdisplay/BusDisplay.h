@@ -27,6 +27,11 @@ typedef struct {
         #endif
     };
     uint64_t last_refresh_call;
+    // Optional persistent refresh buffer followed by its pixel mask. NULL when
+    // the small stack buffer is used instead.
+    uint32_t *refresh_buffer;
+    uint32_t *refresh_mask;
+    uint32_t refresh_buffer_size; // In uint32_ts
     mp_float_t current_brightness;
     uint16_t brightness_command;
     uint16_t native_frames_per_second;
@@ -38,6 +43,12 @@ typedef struct {
 } busdisplay_busdisplay_obj_t;
 
 void busdisplay_busdisplay_background(busdisplay_busdisplay_obj_t *self);
+// Write a width x height block of RGB565_SWAPPED pixels straight to the display at user
+// coordinates x, y, bypassing displayio. stride is the distance between rows of pixels, in
+// pixels. The display must have a 16-bit color depth. Returns false if the bus could not be
+// acquired.
+bool busdisplay_busdisplay_write_rgb565(busdisplay_busdisplay_obj_t *self, int16_t x, int16_t y,
+    uint16_t width, uint16_t height, const uint16_t *pixels, uint16_t stride);
 void release_busdisplay(busdisplay_busdisplay_obj_t *self);
 void reset_busdisplay(busdisplay_busdisplay_obj_t *self);
 void busdisplay_busdisplay_collect_ptrs(busdisplay_busdisplay_obj_t *self);
@@ -0,0 +1,121 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "shared-bindings/crc/CRC.h"
+
+uint32_t crc_reflect(uint32_t value, uint8_t width) {
+    uint32_t result = 0;
+    for (uint8_t i = 0; i < width; i++) {
+        result = (result << 1) | (value & 1);
+        value >>= 1;
+    }
+    return result;
+}
+
+MP_WEAK bool crc_crc_port_update(crc_crc_obj_t *self, const uint8_t *data, size_t len) {
+    return false;
+}
+
+// Reflected CRCs shift towards the low bit. The others are kept in the top
+// bits of the register so that every width shifts out of bit 31, as CRC-32
+// does.
+static void _build_tables(crc_crc_obj_t *self) {
+    if (self->reflect_input) {
+        uint32_t polynomial = crc_reflect(self->polynomial, self->width);
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int bit = 0; bit < 8; bit++) {
+                c = (c & 1) ? (c >> 1) ^ polynomial : c >> 1;
+            }
+            self->table[0][i] = c;
+        }
+        for (size_t k = 1; k < CIRCUITPY_CRC_TABLES; k++) {
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t c = self->table[k - 1][i];
+                self->table[k][i] = (c >> 8) ^ self->table[0][c & 0xff];
+            }
+        }
+    } else {
+        uint32_t polynomial = self->polynomial << (32 - self->width);
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i << 24;
+            for (int bit = 0; bit < 8; bit++) {
+                c = (c & 0x80000000) ? (c << 1) ^ polynomial : c << 1;
+            }
+            self->table[0][i] = c;
+        }
+        for (size_t k = 1; k < CIRCUITPY_CRC_TABLES; k++) {
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t c = self->table[k - 1][i];
+                self->table[k][i] = (c << 8) ^ self->table[0][c >> 24];
+            }
+        }
+    }
+}
+
+void common_hal_crc_crc_construct(crc_crc_obj_t *self, uint8_t width, uint32_t polynomial, uint32_t initial,
+    bool reflect_input, bool reflect_output, uint32_t final_xor) {
+    self->width = width;
+    self->polynomial = polynomial;
+    self->initial = initial;
+    self->reflect_input = reflect_input;
+    self->reflect_output = reflect_output;
+    self->final_xor = final_xor;
+    _build_tables(self);
+    common_hal_crc_crc_reset(self);
+}
+
+void common_hal_crc_crc_reset(crc_crc_obj_t *self) {
+    if (self->reflect_input) {
+        self->crc = crc_reflect(self->initial, self->width);
+    } else {
+        self->crc = self->initial << (32 - self->width);
+    }
+}
+
+void common_hal_crc_crc_update(crc_crc_obj_t *self, const uint8_t *data, size_t len) {
+    if (crc_crc_port_update(self, data, len)) {
+        return;
+    }
+
+    uint32_t crc = self->crc;
+    if (self->reflect_input) {
+        #if CIRCUITPY_CRC_TABLES == 4
+        for (; len >= 4; len -= 4, data += 4) {
+            crc ^= data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+            crc = self->table[3][crc & 0xff] ^ self->table[2][(crc >> 8) & 0xff] ^
+                self->table[1][(crc >> 16) & 0xff] ^ self->table[0][crc >> 24];
+        }
+        #endif
+        for (; len > 0; len--) {
+            crc = self->table[0][(crc ^ *data++) & 0xff] ^ (crc >> 8);
+        }
+    } else {
+        #if CIRCUITPY_CRC_TABLES == 4
+        for (; len >= 4; len -= 4, data += 4) {
+            crc ^= ((uint32_t)data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+            crc = self->table[3][crc >> 24] ^ self->table[2][(crc >> 16) & 0xff] ^
+                self->table[1][(crc >> 8) & 0xff] ^ self->table[0][crc & 0xff];
+        }
+        #endif
+        for (; len > 0; len--) {
+            crc = self->table[0][(crc >> 24) ^ *data++] ^ (crc << 8);
+        }
+    }
+    self->crc = crc;
+}
+
+uint32_t common_hal_crc_crc_get_value(crc_crc_obj_t *self) {
+    uint32_t value = self->crc;
+    if (!self->reflect_input) {
+        value >>= 32 - self->width;
+    }
+    if (self->reflect_input != self->reflect_output) {
+        value = crc_reflect(value, self->width);
+    }
+    uint32_t mask = 0xffffffff >> (32 - self->width);
+    return (value ^ self->final_xor) & mask;
+}
@@ -0,0 +1,42 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+// Slicing tables to use. Four process a word per step and take 4kB per CRC
+// object, one processes a byte per step and takes 1kB.
+#ifndef CIRCUITPY_CRC_TABLES
+#if CIRCUITPY_FULL_BUILD
+#define CIRCUITPY_CRC_TABLES (4)
+#else
+#define CIRCUITPY_CRC_TABLES (1)
+#endif
+#endif
+
+typedef struct {
+    mp_obj_base_t base;
+    // The register as the table loop sees it: in the low width bits when the
+    // input is reflected, otherwise in the top width bits.
+    uint32_t crc;
+    uint32_t polynomial;
+    uint32_t initial;
+    uint32_t final_xor;
+    uint8_t width;
+    bool reflect_input;
+    bool reflect_output;
+    uint32_t table[CIRCUITPY_CRC_TABLES][256];
+} crc_crc_obj_t;
+
+// Reverses the order of the low width bits of value.
+uint32_t crc_reflect(uint32_t value, uint8_t width);
+
+// Ports with a CRC engine override this to process large updates in hardware.
+// The engine must continue from self->crc and store the register back there,
+// so that the tables can carry on with the next update. Return false to use
+// the tables instead.
+bool crc_crc_port_update(crc_crc_obj_t *self, const uint8_t *data, size_t len);
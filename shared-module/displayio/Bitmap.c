@@ -13,6 +13,16 @@
 
 enum { ALIGN_BITS = 8 * sizeof(uint32_t) };
 
+MP_WEAK bool displayio_port_fill_rect(void *dest, size_t dest_stride, uint16_t width, uint16_t height,
+    uint8_t bytes_per_pixel, uint32_t value) {
+    return false;
+}
+
+MP_WEAK bool displayio_port_copy_rect(void *dest, size_t dest_stride, const void *src, size_t src_stride,
+    uint16_t width, uint16_t height, uint8_t bytes_per_pixel) {
+    return false;
+}
+
 static int stride(uint32_t width, uint32_t bits_per_value) {
     uint32_t row_width = width * bits_per_value;
     // align to uint32_t
@@ -190,6 +200,12 @@ void common_hal_displayio_bitmap_fill(displayio_bitmap_t *self, uint32_t value)
     displayio_area_t a = {0, 0, self->width, self->height, NULL};
     displayio_bitmap_set_dirty_area(self, &a);
 
+    if (self->bits_per_value >= 8 &&
+        displayio_port_fill_rect(self->data, self->stride * sizeof(uint32_t), self->width, self->height,
+            self->bits_per_value / 8, value & self->bitmask)) {
+        return;
+    }
+
     // build the packed word
     uint32_t word = 0;
     for (uint8_t i = 0; i < 32 / self->bits_per_value; i++) {
@@ -31,3 +31,15 @@ void displayio_bitmap_finish_refresh(displayio_bitmap_t *self);
 displayio_area_t *displayio_bitmap_get_refresh_areas(displayio_bitmap_t *self, displayio_area_t *tail);
 void displayio_bitmap_set_dirty_area(displayio_bitmap_t *self, const displayio_area_t *area);
 void displayio_bitmap_write_pixel(displayio_bitmap_t *self, int16_t x, int16_t y, uint32_t value);
+
+// A port with a 2D engine, such as a DMA controller or pixel processor, can
+// provide these to fill and copy rectangles of 8, 16 or 32 bit pixels for
+// displayio and bitmaptools. Strides are in bytes, rectangles are already
+// clipped and a copy's source and destination never overlap. Return false
+// to have the caller use its own loop instead, for example when the
+// rectangle is too small to be worth setting up the hardware. The pixels
+// must be written by the time true is returned.
+bool displayio_port_fill_rect(void *dest, size_t dest_stride, uint16_t width, uint16_t height,
+    uint8_t bytes_per_pixel, uint32_t value);
+bool displayio_port_copy_rect(void *dest, size_t dest_stride, const void *src, size_t src_stride,
+    uint16_t width, uint16_t height, uint8_t bytes_per_pixel);
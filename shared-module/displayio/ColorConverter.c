@@ -11,6 +11,21 @@
 
 #define NO_TRANSPARENT_COLOR (0x1000000)
 
+#if (CIRCUITPY_DISPLAYIO_COLORCONVERTER_CACHE_SIZE & (CIRCUITPY_DISPLAYIO_COLORCONVERTER_CACHE_SIZE - 1)) != 0 || \
+    CIRCUITPY_DISPLAYIO_COLORCONVERTER_CACHE_SIZE < 1 || CIRCUITPY_DISPLAYIO_COLORCONVERTER_CACHE_SIZE > 32
+#error "CIRCUITPY_DISPLAYIO_COLORCONVERTER_CACHE_SIZE must be a power of two from 1 to 32"
+#endif
+
+static void _invalidate_cache(displayio_colorconverter_t *self) {
+    self->cached_colorspace = NULL;
+    self->cache_valid = 0;
+}
+
+static inline size_t _cache_index(uint32_t pixel) {
+    // Fibonacci hashing spreads nearby colors across the entries.
+    return ((pixel * 0x9E3779B1u) >> 24) & (CIRCUITPY_DISPLAYIO_COLORCONVERTER_CACHE_SIZE - 1);
+}
+
 uint32_t displayio_colorconverter_dither_noise_1(uint32_t n) {
     n = (n >> 13) ^ n;
     int nn = (n * (n * n * 60493 + 19990303) + 1376312589) & 0x7fffffff;
@@ -26,6 +41,7 @@ void common_hal_displayio_colorconverter_construct(displayio_colorconverter_t *s
     self->transparent_color = NO_TRANSPARENT_COLOR;
     self->input_colorspace = input_colorspace;
     self->output_colorspace.depth = 16;
+    _invalidate_cache(self);
 }
 
 uint16_t displayio_colorconverter_compute_rgb565(uint32_t color_rgb888) {
@@ -170,12 +186,14 @@ void common_hal_displayio_colorconverter_make_transparent(displayio_colorconvert
         mp_raise_RuntimeError(MP_ERROR_TEXT("Only one color can be transparent at a time"));
     }
     self->transparent_color = transparent_color;
+    _invalidate_cache(self);
 }
 
 void common_hal_displayio_colorconverter_make_opaque(displayio_colorconverter_t *self, uint32_t transparent_color) {
     (void)transparent_color;
     // NO_TRANSPARENT_COLOR will never equal a valid color
     self->transparent_color = NO_TRANSPARENT_COLOR;
+    _invalidate_cache(self);
 }
 
 
@@ -285,6 +303,7 @@ void displayio_convert_color(const _displayio_colorspace_t *colorspace, bool dit
         }
         uint8_t pixel_hue = displayio_colorconverter_compute_hue(pixel);
         displayio_colorconverter_compute_tricolor(colorspace, pixel_hue, &output_color->pixel);
+        output_color->opaque = true;
         return;
     } else if (colorspace->grayscale && colorspace->depth <= 8) {
         uint8_t luma = displayio_colorconverter_compute_luma(pixel);
@@ -323,20 +342,34 @@ void displayio_colorconverter_convert(displayio_colorconverter_t *self, const _d
         return;
     }
 
-    if (!self->dither && self->cached_colorspace == colorspace && self->cached_input_pixel == input_pixel->pixel) {
-        output_color->pixel = self->cached_output_color;
+    if (self->dither) {
+        displayio_input_pixel_t rgb888_pixel = *input_pixel;
+        rgb888_pixel.pixel = displayio_colorconverter_convert_pixel(self->input_colorspace, pixel);
+        displayio_convert_color(colorspace, true, &rgb888_pixel, output_color);
         return;
     }
 
-    displayio_input_pixel_t rgb888_pixel = *input_pixel;
-    rgb888_pixel.pixel = displayio_colorconverter_convert_pixel(self->input_colorspace, input_pixel->pixel);
-    displayio_convert_color(colorspace, self->dither, &rgb888_pixel, output_color);
-
-    if (!self->dither) {
+    if (self->cached_colorspace != colorspace) {
         self->cached_colorspace = colorspace;
-        self->cached_input_pixel = input_pixel->pixel;
-        self->cached_output_color = output_color->pixel;
+        self->cache_valid = 0;
     }
+
+    size_t i = _cache_index(pixel);
+    uint32_t entry_bit = 1u << i;
+    if ((self->cache_valid & entry_bit) != 0 && self->cached_input_pixel[i] == pixel) {
+        output_color->pixel = self->cached_output_color[i];
+        output_color->opaque = self->cached_opaque[i];
+        return;
+    }
+
+    displayio_input_pixel_t rgb888_pixel = *input_pixel;
+    rgb888_pixel.pixel = displayio_colorconverter_convert_pixel(self->input_colorspace, pixel);
+    displayio_convert_color(colorspace, false, &rgb888_pixel, output_color);
+
+    self->cache_valid |= entry_bit;
+    self->cached_input_pixel[i] = pixel;
+    self->cached_output_color[i] = output_color->pixel;
+    self->cached_opaque[i] = output_color->opaque;
 }
 
 
@@ -10,8 +10,14 @@
 #include <stdint.h>
 
 #include "py/obj.h"
+#include "py/mpconfig.h"
 #include "shared-module/displayio/Palette.h"
 
+// Builds without the full CircuitPython config (such as unix) keep only the last color.
+#ifndef CIRCUITPY_DISPLAYIO_COLORCONVERTER_CACHE_SIZE
+#define CIRCUITPY_DISPLAYIO_COLORCONVERTER_CACHE_SIZE (1)
+#endif
+
 typedef struct displayio_colorconverter {
     mp_obj_base_t base;
     bool dither;
@@ -19,10 +25,13 @@ typedef struct displayio_colorconverter {
     _displayio_colorspace_t output_colorspace;
     uint32_t transparent_color;
 
-    // Cache the last computed color in case the are the same.
+    // Direct-mapped cache of recently converted colors. Only used when not dithering and
+    // only valid for cached_colorspace. Bit i of cache_valid is set when entry i is filled.
     const _displayio_colorspace_t *cached_colorspace;
-    uint32_t cached_input_pixel;
-    uint32_t cached_output_color;
+    uint32_t cache_valid;
+    uint32_t cached_input_pixel[CIRCUITPY_DISPLAYIO_COLORCONVERTER_CACHE_SIZE];
+    uint32_t cached_output_color[CIRCUITPY_DISPLAYIO_COLORCONVERTER_CACHE_SIZE];
+    bool cached_opaque[CIRCUITPY_DISPLAYIO_COLORCONVERTER_CACHE_SIZE];
 } displayio_colorconverter_t;
 
 bool displayio_colorconverter_needs_refresh(displayio_colorconverter_t *self);
@@ -6,6 +6,8 @@
 
 #include "shared-bindings/displayio/Group.h"
 
+#include <string.h>
+
 #include "py/runtime.h"
 #include "py/objlist.h"
 #include "shared-bindings/displayio/TileGrid.h"
@@ -98,6 +100,28 @@ void displayio_group_set_hidden_by_parent(displayio_group_t *self, bool hidden)
     }
 }
 
+static void _free_cache(displayio_group_t *self) {
+    m_del(uint8_t, self->cache_buffer, self->cache_buffer_size);
+    self->cache_buffer = NULL;
+    self->cache_mask = NULL;
+    self->cache_buffer_size = 0;
+    self->cache_valid = false;
+}
+
+bool common_hal_displayio_group_get_cached(displayio_group_t *self) {
+    return self->cached;
+}
+
+void common_hal_displayio_group_set_cached(displayio_group_t *self, bool cached) {
+    if (self->cached == cached) {
+        return;
+    }
+    check_readonly(self);
+    self->cached = cached;
+    self->cache_failed = false;
+    _free_cache(self);
+}
+
 uint32_t common_hal_displayio_group_get_scale(displayio_group_t *self) {
     return self->scale;
 }
@@ -364,47 +388,175 @@ void displayio_group_construct(displayio_group_t *self, mp_obj_list_t *members,
     self->scale = scale;
     self->in_group = false;
     self->readonly = false;
+    self->cached = false;
+    self->cache_valid = false;
+    self->cache_failed = false;
+    self->children_changed = false;
+    self->cache_buffer = NULL;
+    self->cache_mask = NULL;
+    self->cache_buffer_size = 0;
 }
 
-bool displayio_group_fill_area(displayio_group_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
+static bool _fill_members(displayio_group_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
     // Track if any of the layers finishes filling in the given area. We can ignore any remaining
     // layers at that point.
-    if (self->hidden == false) {
-        for (int32_t i = self->members->len - 1; i >= 0; i--) {
-            mp_obj_t layer;
-            #if CIRCUITPY_VECTORIO
-            const vectorio_draw_protocol_t *draw_protocol = mp_proto_get(MP_QSTR_protocol_draw, self->members->items[i]);
-            if (draw_protocol != NULL) {
-                layer = draw_protocol->draw_get_protocol_self(self->members->items[i]);
-                if (draw_protocol->draw_protocol_impl->draw_fill_area(layer, colorspace, area, mask, buffer)) {
-                    return true;
-                }
-                continue;
+    for (int32_t i = self->members->len - 1; i >= 0; i--) {
+        mp_obj_t layer;
+        #if CIRCUITPY_VECTORIO
+        const vectorio_draw_protocol_t *draw_protocol = mp_proto_get(MP_QSTR_protocol_draw, self->members->items[i]);
+        if (draw_protocol != NULL) {
+            layer = draw_protocol->draw_get_protocol_self(self->members->items[i]);
+            if (draw_protocol->draw_protocol_impl->draw_fill_area(layer, colorspace, area, mask, buffer)) {
+                return true;
             }
-            #endif
-            layer = mp_obj_cast_to_native_base(
-                self->members->items[i], &displayio_tilegrid_type);
-            if (layer != MP_OBJ_NULL) {
-                if (displayio_tilegrid_fill_area(layer, colorspace, area, mask, buffer)) {
-                    return true;
-                }
+            continue;
+        }
+        #endif
+        layer = mp_obj_cast_to_native_base(
+            self->members->items[i], &displayio_tilegrid_type);
+        if (layer != MP_OBJ_NULL) {
+            if (displayio_tilegrid_fill_area(layer, colorspace, area, mask, buffer)) {
+                return true;
+            }
+            continue;
+        }
+        layer = mp_obj_cast_to_native_base(
+            self->members->items[i], &displayio_group_type);
+        if (layer != MP_OBJ_NULL) {
+            if (displayio_group_fill_area(layer, colorspace, area, mask, buffer)) {
+                return true;
+            }
+            continue;
+        }
+    }
+    return false;
+}
+
+
+// Bounds of everything the members drew in the last frame, including vectorio shapes.
+static bool _get_render_extent(displayio_group_t *self, displayio_area_t *area) {
+    bool first = true;
+    for (size_t i = 0; i < self->members->len; i++) {
+        mp_obj_t layer;
+        displayio_area_t layer_area;
+        bool rendered = false;
+        #if CIRCUITPY_VECTORIO
+        const vectorio_draw_protocol_t *draw_protocol = mp_proto_get(MP_QSTR_protocol_draw, self->members->items[i]);
+        if (draw_protocol != NULL) {
+            layer = draw_protocol->draw_get_protocol_self(self->members->items[i]);
+            rendered = draw_protocol->draw_protocol_impl->draw_get_dirty_area(layer, &layer_area) &&
+                !displayio_area_empty(&layer_area);
+        }
+        #endif
+        layer = mp_obj_cast_to_native_base(
+            self->members->items[i], &displayio_tilegrid_type);
+        if (layer != MP_OBJ_NULL) {
+            rendered = displayio_tilegrid_get_previous_area(layer, &layer_area);
+        }
+        layer = mp_obj_cast_to_native_base(
+            self->members->items[i], &displayio_group_type);
+        if (layer != MP_OBJ_NULL) {
+            rendered = _get_render_extent(layer, &layer_area);
+        }
+        if (!rendered) {
+            continue;
+        }
+        if (first) {
+            displayio_area_copy(&layer_area, area);
+            first = false;
+        } else {
+            displayio_area_union(area, &layer_area, area);
+        }
+    }
+    return !first;
+}
+
+// Renders all of the members into the cache. Returns false if there is nothing to cache or the
+// buffer can't be allocated.
+static bool _build_cache(displayio_group_t *self, const _displayio_colorspace_t *colorspace) {
+    displayio_area_t extent;
+    if (!_get_render_extent(self, &extent)) {
+        return false;
+    }
+    uint32_t pixels = displayio_area_size(&extent);
+    uint32_t pixel_bytes = (pixels * (colorspace->depth / 8) + 3) & ~3;
+    uint32_t mask_bytes = (pixels / 32 + 1) * sizeof(uint32_t);
+    if (self->cache_buffer_size < pixel_bytes + mask_bytes) {
+        _free_cache(self);
+        self->cache_buffer = m_malloc_maybe(pixel_bytes + mask_bytes);
+        if (self->cache_buffer == NULL) {
+            self->cache_failed = true;
+            return false;
+        }
+        self->cache_buffer_size = pixel_bytes + mask_bytes;
+    }
+    self->cache_mask = (uint32_t *)(self->cache_buffer + pixel_bytes);
+    memset(self->cache_mask, 0, mask_bytes);
+    _fill_members(self, colorspace, &extent, self->cache_mask, (uint32_t *)self->cache_buffer);
+
+    displayio_area_copy(&extent, &self->cache_area);
+    self->cache_colorspace = colorspace;
+    self->cache_valid = true;
+    return true;
+}
+
+static bool _cache_usable(displayio_group_t *self, const _displayio_colorspace_t *colorspace) {
+    // Packed pixels smaller than a byte are laid out per area so only whole byte pixels are cached.
+    if (colorspace->depth != 8 && colorspace->depth != 16 && colorspace->depth != 32) {
+        return false;
+    }
+    if (self->cache_valid && self->cache_colorspace == colorspace) {
+        return true;
+    }
+    // Only cache once the members have settled for a frame.
+    if (self->children_changed || self->cache_failed) {
+        return false;
+    }
+    return _build_cache(self, colorspace);
+}
+
+static bool _fill_from_cache(displayio_group_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
+    displayio_area_t overlap;
+    if (!displayio_area_compute_overlap(area, &self->cache_area, &overlap)) {
+        return false;
+    }
+    uint8_t bytes_per_pixel = colorspace->depth / 8;
+    uint16_t area_width = displayio_area_width(area);
+    uint16_t cache_width = displayio_area_width(&self->cache_area);
+    uint32_t filled = 0;
+    for (int16_t y = overlap.y1; y < overlap.y2; y++) {
+        uint32_t offset = (y - area->y1) * area_width + (overlap.x1 - area->x1);
+        uint32_t cache_offset = (y - self->cache_area.y1) * cache_width + (overlap.x1 - self->cache_area.x1);
+        for (int16_t x = overlap.x1; x < overlap.x2; x++, offset++, cache_offset++) {
+            if ((mask[offset / 32] & (1u << (offset % 32))) != 0) {
+                filled++;
                 continue;
             }
-            layer = mp_obj_cast_to_native_base(
-                self->members->items[i], &displayio_group_type);
-            if (layer != MP_OBJ_NULL) {
-                if (displayio_group_fill_area(layer, colorspace, area, mask, buffer)) {
-                    return true;
-                }
+            if ((self->cache_mask[cache_offset / 32] & (1u << (cache_offset % 32))) == 0) {
                 continue;
             }
+            memcpy(((uint8_t *)buffer) + offset * bytes_per_pixel,
+                self->cache_buffer + cache_offset * bytes_per_pixel, bytes_per_pixel);
+            mask[offset / 32] |= 1u << (offset % 32);
+            filled++;
         }
     }
-    return false;
+    return filled == displayio_area_size(area);
+}
+
+bool displayio_group_fill_area(displayio_group_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
+    if (self->hidden) {
+        return false;
+    }
+    if (self->cached && _cache_usable(self, colorspace)) {
+        return _fill_from_cache(self, colorspace, area, mask, buffer);
+    }
+    return _fill_members(self, colorspace, area, mask, buffer);
 }
 
 void displayio_group_finish_refresh(displayio_group_t *self) {
     self->item_removed = false;
+    self->children_changed = false;
     for (int32_t i = self->members->len - 1; i >= 0; i--) {
         mp_obj_t layer;
         #if CIRCUITPY_VECTORIO
@@ -431,6 +583,7 @@ void displayio_group_finish_refresh(displayio_group_t *self) {
 }
 
 displayio_area_t *displayio_group_get_refresh_areas(displayio_group_t *self, displayio_area_t *tail) {
+    displayio_area_t *original_tail = tail;
     if (self->item_removed) {
         self->dirty_area.next = tail;
         tail = &self->dirty_area;
@@ -462,5 +615,12 @@ displayio_area_t *displayio_group_get_refresh_areas(displayio_group_t *self, dis
         }
     }
 
+    // Any change within the group makes the cached render stale.
+    if (tail != original_tail) {
+        self->children_changed = true;
+        self->cache_valid = false;
+        self->cache_failed = false;
+    }
+
     return tail;
 }
@@ -27,7 +27,18 @@ typedef struct {
     bool hidden : 1;
     bool hidden_by_parent : 1;
     bool readonly : 1;
-    uint8_t padding : 3;
+    bool cached : 1;
+    bool cache_valid : 1;
+    bool cache_failed : 1; // Allocation failed for the current cache_area.
+    bool children_changed : 1; // A member produced refresh areas this frame.
+    uint8_t padding : 7;
+    // When cached is set, the members are rendered once into cache_buffer (in output pixels) and
+    // the cache is composited instead until a member changes.
+    displayio_area_t cache_area;
+    const _displayio_colorspace_t *cache_colorspace;
+    uint8_t *cache_buffer;
+    uint32_t *cache_mask;
+    uint32_t cache_buffer_size; // In bytes, including the mask
 } displayio_group_t;
 
 void displayio_group_construct(displayio_group_t *self, mp_obj_list_t *members, uint32_t scale, mp_int_t x, mp_int_t y);
@@ -22,6 +22,8 @@ static uint32_t read_word(uint16_t *bmp_header, uint16_t index) {
 void common_hal_displayio_ondiskbitmap_construct(displayio_ondiskbitmap_t *self, pyb_file_obj_t *file) {
     // Load the wave
     self->file = file;
+    // Rows are read in whatever order the display refreshes them.
+    fat_file_enable_fast_seek(file);
     uint16_t bmp_header[69];
     f_rewind(&self->file->fp);
     UINT bytes_read;
@@ -126,6 +128,30 @@ void common_hal_displayio_ondiskbitmap_construct(displayio_ondiskbitmap_t *self,
         self->stride = (bit_stride / 8);
     }
 
+    self->row_buffer = m_malloc_maybe(self->stride);
+    self->buffered_row = -1;
+}
+
+static bool read_pixel_data(displayio_ondiskbitmap_t *self, int16_t y, uint32_t row_offset, uint8_t byte_count, uint32_t *pixel_data) {
+    uint32_t row_location = self->data_offset + (self->height - y - 1) * self->stride;
+    UINT bytes_read;
+    if (self->row_buffer == NULL) {
+        f_lseek(&self->file->fp, row_location + row_offset);
+        return f_read(&self->file->fp, pixel_data, byte_count, &bytes_read) == FR_OK;
+    }
+
+    if (self->buffered_row != y) {
+        self->buffered_row = -1;
+        f_lseek(&self->file->fp, row_location);
+        if (f_read(&self->file->fp, self->row_buffer, self->stride, &bytes_read) != FR_OK) {
+            return false;
+        }
+        // Zero anything past the end of a truncated file like a short per-pixel read did.
+        memset(self->row_buffer + bytes_read, 0, self->stride - bytes_read);
+        self->buffered_row = y;
+    }
+    memcpy(pixel_data, self->row_buffer + row_offset, byte_count);
+    return true;
 }
 
 
@@ -135,20 +161,16 @@ uint32_t common_hal_displayio_ondiskbitmap_get_pixel(displayio_ondiskbitmap_t *s
         return 0;
     }
 
-    uint32_t location;
+    uint32_t row_offset;
     uint8_t bytes_per_pixel = (self->bits_per_pixel / 8)  ? (self->bits_per_pixel / 8) : 1;
     uint8_t pixels_per_byte = 8 / self->bits_per_pixel;
     if (pixels_per_byte == 0) {
-        location = self->data_offset + (self->height - y - 1) * self->stride + x * bytes_per_pixel;
+        row_offset = x * bytes_per_pixel;
     } else {
-        location = self->data_offset + (self->height - y - 1) * self->stride + x / pixels_per_byte;
+        row_offset = x / pixels_per_byte;
     }
-    // We don't cache here because the underlying FS caches sectors.
-    f_lseek(&self->file->fp, location);
-    UINT bytes_read;
     uint32_t pixel_data = 0;
-    uint32_t result = f_read(&self->file->fp, &pixel_data, bytes_per_pixel, &bytes_read);
-    if (result == FR_OK) {
+    if (read_pixel_data(self, y, row_offset, bytes_per_pixel, &pixel_data)) {
         uint32_t tmp = 0;
         uint8_t red;
         uint8_t green;
@@ -23,6 +23,10 @@ typedef struct {
     uint32_t g_bitmask;
     uint32_t b_bitmask;
     pyb_file_obj_t *file;
+    // One row of raw file data so neighbouring pixels don't each seek and read. NULL when it
+    // couldn't be allocated.
+    uint8_t *row_buffer;
+    int16_t buffered_row; // -1 when row_buffer holds nothing.
     union {
         mp_obj_base_t *pixel_shader_base;
         struct displayio_palette *palette;
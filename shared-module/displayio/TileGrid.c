@@ -6,6 +6,8 @@
 
 #include "shared-bindings/displayio/TileGrid.h"
 
+#include <string.h>
+
 #include "py/runtime.h"
 #include "shared-bindings/displayio/Bitmap.h"
 #include "shared-bindings/displayio/ColorConverter.h"
@@ -281,6 +283,57 @@ void common_hal_displayio_tilegrid_set_tile(displayio_tilegrid_t *self, uint16_t
     self->partial_change = true;
 }
 
+void displayio_tilegrid_set_row_tiles(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint16_t count, uint8_t tile_index) {
+    if (tile_index >= self->tiles_in_bitmap) {
+        mp_raise_ValueError(MP_ERROR_TEXT("Tile index out of bounds"));
+    }
+    uint8_t *tiles = self->tiles;
+    if (self->inline_tiles) {
+        tiles = (uint8_t *)&self->tiles;
+    }
+    if (tiles == NULL || x >= self->width_in_tiles || count == 0) {
+        return;
+    }
+    count = MIN(count, self->width_in_tiles - x);
+    memset(tiles + y * self->width_in_tiles + x, tile_index, count);
+    if (self->full_change) {
+        // Everything is redrawn anyway so don't bother tracking the row.
+        return;
+    }
+
+    displayio_area_t temp_area;
+    displayio_area_t *row_area;
+    if (!self->partial_change) {
+        row_area = &self->dirty_area;
+    } else {
+        row_area = &temp_area;
+    }
+    int16_t tx = (x - self->top_left_x) % self->width_in_tiles;
+    if (tx < 0) {
+        tx += self->width_in_tiles;
+    }
+    if (tx + count > self->width_in_tiles) {
+        // The run wraps around the left edge so mark the whole row.
+        row_area->x1 = 0;
+        row_area->x2 = self->width_in_tiles * self->tile_width;
+    } else {
+        row_area->x1 = tx * self->tile_width;
+        row_area->x2 = (tx + count) * self->tile_width;
+    }
+    int16_t ty = (y - self->top_left_y) % self->height_in_tiles;
+    if (ty < 0) {
+        ty += self->height_in_tiles;
+    }
+    row_area->y1 = ty * self->tile_height;
+    row_area->y2 = row_area->y1 + self->tile_height;
+
+    if (self->partial_change) {
+        displayio_area_union(&self->dirty_area, &temp_area, &self->dirty_area);
+    }
+
+    self->partial_change = true;
+}
+
 void common_hal_displayio_tilegrid_set_all_tiles(displayio_tilegrid_t *self, uint8_t tile_index) {
     if (tile_index >= self->tiles_in_bitmap) {
         mp_raise_ValueError(MP_ERROR_TEXT("Tile index out of bounds"));
@@ -361,6 +414,311 @@ void common_hal_displayio_tilegrid_set_top_left(displayio_tilegrid_t *self, uint
     self->full_change = true;
 }
 
+// True when bitmap rows can be copied straight into the output buffer: no pixel shader, no
+// scaling, flipping or transposing, and bitmap values that are already whole output pixels.
+static bool _can_copy_rows(displayio_tilegrid_t *self, const _displayio_colorspace_t *colorspace) {
+    if (self->pixel_shader != mp_const_none ||
+        !mp_obj_is_type(self->bitmap, &displayio_bitmap_type) ||
+        colorspace->depth < 8) {
+        return false;
+    }
+    displayio_bitmap_t *bitmap = MP_OBJ_TO_PTR(self->bitmap);
+    const displayio_buffer_transform_t *transform = self->absolute_transform;
+    return bitmap->bits_per_value == colorspace->depth &&
+           transform->scale == 1 &&
+           transform->dx > 0 && transform->dy > 0 &&
+           !transform->transpose_xy && !self->transpose_xy &&
+           !self->flip_x && !self->flip_y;
+}
+
+// Copies count pixels that start at offset in the buffer, skipping those already set in the mask.
+static void _copy_run(uint8_t *buffer, uint32_t *mask, uint32_t offset, const uint8_t *src,
+    uint32_t count, uint8_t bytes_per_pixel) {
+    while (count > 0) {
+        uint32_t bit = offset % 32;
+        uint32_t n = MIN(count, 32 - bit);
+        uint32_t bits = (n == 32 ? 0xffffffff : ((1u << n) - 1)) << bit;
+        uint32_t *mask_word = &mask[offset / 32];
+        if ((*mask_word & bits) == 0) {
+            memcpy(buffer + offset * bytes_per_pixel, src, n * bytes_per_pixel);
+        } else {
+            for (uint32_t i = 0; i < n; i++) {
+                if ((*mask_word & (1u << (bit + i))) == 0) {
+                    memcpy(buffer + (offset + i) * bytes_per_pixel, src + i * bytes_per_pixel, bytes_per_pixel);
+                }
+            }
+        }
+        *mask_word |= bits;
+        offset += n;
+        src += n * bytes_per_pixel;
+        count -= n;
+    }
+}
+
+// True when none of the count pixels starting at offset are set in the mask.
+static bool _run_clear(const uint32_t *mask, uint32_t offset, uint32_t count) {
+    while (count > 0) {
+        uint32_t bit = offset % 32;
+        uint32_t n = MIN(count, 32 - bit);
+        if (mask[offset / 32] & ((n == 32 ? 0xffffffff : ((1u << n) - 1)) << bit)) {
+            return false;
+        }
+        offset += n;
+        count -= n;
+    }
+    return true;
+}
+
+static void _set_run(uint32_t *mask, uint32_t offset, uint32_t count) {
+    while (count > 0) {
+        uint32_t bit = offset % 32;
+        uint32_t n = MIN(count, 32 - bit);
+        mask[offset / 32] |= (n == 32 ? 0xffffffff : ((1u << n) - 1)) << bit;
+        offset += n;
+        count -= n;
+    }
+}
+
+// Hands the overlap to the port's 2D copy when it falls within a single tile and no higher
+// layer has drawn over it yet, so it is one rectangle of the bitmap.
+static bool _copy_tile_rect(displayio_tilegrid_t *self, const uint8_t *tiles,
+    uint8_t bytes_per_pixel, uint16_t area_width, uint32_t offset,
+    int16_t start_x, int16_t end_x, int16_t start_y, int16_t end_y, uint32_t *mask, uint32_t *buffer) {
+    if (start_x / self->tile_width != (end_x - 1) / self->tile_width ||
+        start_y / self->tile_height != (end_y - 1) / self->tile_height) {
+        return false;
+    }
+    uint16_t height = end_y - start_y;
+    uint16_t width = end_x - start_x;
+    for (uint16_t j = 0; j < height; j++) {
+        if (!_run_clear(mask, offset + j * area_width, width)) {
+            return false;
+        }
+    }
+    for (uint16_t j = 0; j < height; j++) {
+        _set_run(mask, offset + j * area_width, width);
+    }
+    displayio_bitmap_t *bitmap = MP_OBJ_TO_PTR(self->bitmap);
+    uint16_t tile_row = ((start_y / self->tile_height + self->top_left_y) % self->height_in_tiles) * self->width_in_tiles;
+    uint8_t tile = tiles[tile_row + (start_x / self->tile_width + self->top_left_x) % self->width_in_tiles];
+    uint16_t tile_x = (tile % self->bitmap_width_in_tiles) * self->tile_width + start_x % self->tile_width;
+    uint16_t tile_y = (tile / self->bitmap_width_in_tiles) * self->tile_height + start_y % self->tile_height;
+    const uint8_t *src = (const uint8_t *)(bitmap->data + tile_y * bitmap->stride) + tile_x * bytes_per_pixel;
+    if (displayio_port_copy_rect((uint8_t *)buffer + offset * bytes_per_pixel, area_width * bytes_per_pixel,
+        src, bitmap->stride * sizeof(uint32_t), width, height, bytes_per_pixel)) {
+        return true;
+    }
+    for (uint16_t j = 0; j < height; j++) {
+        memcpy((uint8_t *)buffer + (offset + j * area_width) * bytes_per_pixel,
+            src + j * bitmap->stride * sizeof(uint32_t), width * bytes_per_pixel);
+    }
+    return true;
+}
+
+// Fast path for _can_copy_rows. Each row of the overlap is copied a tile-wide run at a time.
+static void _copy_rows(displayio_tilegrid_t *self, const uint8_t *tiles,
+    const _displayio_colorspace_t *colorspace, const displayio_area_t *area,
+    const displayio_area_t *overlap, uint32_t *mask, uint32_t *buffer) {
+    displayio_bitmap_t *bitmap = MP_OBJ_TO_PTR(self->bitmap);
+    uint8_t bytes_per_pixel = colorspace->depth / 8;
+    uint16_t area_width = displayio_area_width(area);
+    int16_t start_x = overlap->x1 - self->current_area.x1;
+    int16_t end_x = overlap->x2 - self->current_area.x1;
+    int16_t start_y = overlap->y1 - self->current_area.y1;
+    int16_t end_y = overlap->y2 - self->current_area.y1;
+    uint32_t offset = (overlap->y1 - area->y1) * area_width + (overlap->x1 - area->x1);
+
+    if (_copy_tile_rect(self, tiles, bytes_per_pixel, area_width, offset,
+        start_x, end_x, start_y, end_y, mask, buffer)) {
+        return;
+    }
+
+    for (int16_t y = start_y; y < end_y; y++) {
+        uint16_t tile_row = ((y / self->tile_height + self->top_left_y) % self->height_in_tiles) * self->width_in_tiles;
+        uint16_t y_in_tile = y % self->tile_height;
+        int16_t x = start_x;
+        while (x < end_x) {
+            int16_t run_end = MIN(end_x, (x / self->tile_width + 1) * self->tile_width);
+            uint8_t tile = tiles[tile_row + (x / self->tile_width + self->top_left_x) % self->width_in_tiles];
+            uint16_t tile_x = (tile % self->bitmap_width_in_tiles) * self->tile_width + x % self->tile_width;
+            uint16_t tile_y = (tile / self->bitmap_width_in_tiles) * self->tile_height + y_in_tile;
+            const uint8_t *src = (const uint8_t *)(bitmap->data + tile_y * bitmap->stride) + tile_x * bytes_per_pixel;
+            _copy_run((uint8_t *)buffer, mask, offset + (x - start_x), src, run_end - x, bytes_per_pixel);
+            x = run_end;
+        }
+        offset += area_width;
+    }
+}
+
+// Where the pixels of the overlap go in the output buffer, for the fill kernels.
+typedef struct {
+    uint16_t start;
+    int16_t start_x;
+    int16_t end_x;
+    int16_t start_y;
+    int16_t end_y;
+    int16_t x_shift;
+    int16_t y_shift;
+    int16_t x_stride;
+    int16_t y_stride;
+} fill_loop_t;
+
+typedef enum {
+    FILL_SHADER_ANY,
+    FILL_SHADER_PALETTE,
+} fill_shader_t;
+
+// Fills the overlap pixel by pixel. Returns false if any pixel was transparent.
+typedef bool (*fill_kernel_t)(displayio_tilegrid_t *self, const uint8_t *tiles,
+    const _displayio_colorspace_t *colorspace, const displayio_area_t *area,
+    const fill_loop_t *loop, uint32_t *mask, uint32_t *buffer);
+
+// Reads a pixel of a Bitmap known to have bits values per pixel.
+static inline MP_ALWAYSINLINE uint32_t _bitmap_pixel(const displayio_bitmap_t *bitmap, uint16_t x, uint16_t y, const uint8_t bits) {
+    if (x >= bitmap->width || y >= bitmap->height) {
+        return 0;
+    }
+    const uint32_t *row = bitmap->data + y * bitmap->stride;
+    if (bits < 8) {
+        const uint8_t per_word = 32 / bits;
+        return (row[x / per_word] >> (32 - (x % per_word + 1) * bits)) & ((1u << bits) - 1);
+    }
+    return ((const uint8_t *)row)[x];
+}
+
+// The body of every fill kernel. src_bits, shader and depth are constants in each instance so
+// that the compiler drops the per pixel checks that don't apply to it. A src_bits of 0 reads
+// any kind of bitmap, FILL_SHADER_ANY handles any pixel shader and a depth of 0 writes the
+// colorspace's depth.
+static inline MP_ALWAYSINLINE bool _fill_pixels(displayio_tilegrid_t *self, const uint8_t *tiles,
+    const _displayio_colorspace_t *colorspace, const displayio_area_t *area,
+    const fill_loop_t *loop, uint32_t *mask, uint32_t *buffer,
+    const uint8_t src_bits, const fill_shader_t shader, const uint8_t depth_in) {
+    const uint8_t depth = depth_in ? depth_in : colorspace->depth;
+    uint8_t pixels_per_byte = 8 / depth;
+    bool opaque = true;
+
+    displayio_input_pixel_t input_pixel;
+    displayio_output_pixel_t output_pixel;
+
+    for (input_pixel.y = loop->start_y; input_pixel.y < loop->end_y; ++input_pixel.y) {
+        int16_t row_start = loop->start + (input_pixel.y - loop->start_y + loop->y_shift) * loop->y_stride; // in pixels
+        int16_t local_y = input_pixel.y / self->absolute_transform->scale;
+        for (input_pixel.x = loop->start_x; input_pixel.x < loop->end_x; ++input_pixel.x) {
+            // Compute the destination pixel in the buffer and mask based on the transformations.
+            int16_t offset = row_start + (input_pixel.x - loop->start_x + loop->x_shift) * loop->x_stride; // in pixels
+
+            // This is super useful for debugging out of range accesses. Uncomment to use.
+            // if (offset < 0 || offset >= (int32_t) displayio_area_size(area)) {
+            //     asm("bkpt");
+            // }
+
+            // Check the mask first to see if the pixel has already been set.
+            if ((mask[offset / 32] & (1 << (offset % 32))) != 0) {
+                continue;
+            }
+            int16_t local_x = input_pixel.x / self->absolute_transform->scale;
+            uint16_t tile_location = ((local_y / self->tile_height + self->top_left_y) % self->height_in_tiles) * self->width_in_tiles + (local_x / self->tile_width + self->top_left_x) % self->width_in_tiles;
+            input_pixel.tile = tiles[tile_location];
+            input_pixel.tile_x = (input_pixel.tile % self->bitmap_width_in_tiles) * self->tile_width + local_x % self->tile_width;
+            input_pixel.tile_y = (input_pixel.tile / self->bitmap_width_in_tiles) * self->tile_height + local_y % self->tile_height;
+
+            output_pixel.pixel = 0;
+            input_pixel.pixel = 0;
+
+            // We always want to read bitmap pixels by row first and then transpose into the destination
+            // buffer because most bitmaps are row associated.
+            if (src_bits != 0) {
+                input_pixel.pixel = _bitmap_pixel(MP_OBJ_TO_PTR(self->bitmap), input_pixel.tile_x, input_pixel.tile_y, src_bits);
+            } else if (mp_obj_is_type(self->bitmap, &displayio_bitmap_type)) {
+                input_pixel.pixel = common_hal_displayio_bitmap_get_pixel(self->bitmap, input_pixel.tile_x, input_pixel.tile_y);
+            } else if (mp_obj_is_type(self->bitmap, &displayio_ondiskbitmap_type)) {
+                input_pixel.pixel = common_hal_displayio_ondiskbitmap_get_pixel(self->bitmap, input_pixel.tile_x, input_pixel.tile_y);
+            }
+
+            output_pixel.opaque = true;
+            if (shader == FILL_SHADER_PALETTE) {
+                displayio_palette_get_color(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
+            } else if (self->pixel_shader == mp_const_none) {
+                output_pixel.pixel = input_pixel.pixel;
+            } else if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
+                displayio_palette_get_color(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
+            } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
+                displayio_colorconverter_convert(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
+            }
+            if (!output_pixel.opaque) {
+                opaque = false;
+            } else {
+                mask[offset / 32] |= 1 << (offset % 32);
+                if (depth == 16) {
+                    *(((uint16_t *)buffer) + offset) = output_pixel.pixel;
+                } else if (depth == 32) {
+                    *(((uint32_t *)buffer) + offset) = output_pixel.pixel;
+                } else if (depth == 8) {
+                    *(((uint8_t *)buffer) + offset) = output_pixel.pixel;
+                } else if (depth < 8) {
+                    // Reorder the offsets to pack multiple rows into a byte (meaning they share a column).
+                    if (!colorspace->pixels_in_byte_share_row) {
+                        uint16_t width = displayio_area_width(area);
+                        uint16_t row = offset / width;
+                        uint16_t col = offset % width;
+                        // Dividing by pixels_per_byte does truncated division even if we multiply it back out.
+                        offset = col * pixels_per_byte + (row / pixels_per_byte) * pixels_per_byte * width + row % pixels_per_byte;
+                        // Also useful for validating that the bitpacking worked correctly.
+                        // if (offset > displayio_area_size(area)) {
+                        //     asm("bkpt");
+                        // }
+                    }
+                    uint8_t shift = (offset % pixels_per_byte) * depth;
+                    if (colorspace->reverse_pixels_in_byte) {
+                        // Reverse the shift by subtracting it from the leftmost shift.
+                        shift = (pixels_per_byte - 1) * depth - shift;
+                    }
+                    ((uint8_t *)buffer)[offset / pixels_per_byte] |= output_pixel.pixel << shift;
+                }
+            }
+        }
+    }
+    return opaque;
+}
+
+#define FILL_KERNEL(name, src_bits, shader, depth) \
+    static bool name(displayio_tilegrid_t *self, const uint8_t *tiles, \
+    const _displayio_colorspace_t *colorspace, const displayio_area_t *area, \
+    const fill_loop_t *loop, uint32_t *mask, uint32_t *buffer) { \
+        return _fill_pixels(self, tiles, colorspace, area, loop, mask, buffer, src_bits, shader, depth); \
+    }
+
+FILL_KERNEL(_fill_any, 0, FILL_SHADER_ANY, 0)
+#if CIRCUITPY_DISPLAYIO_FILL_KERNELS
+// Palette indexed Bitmaps on 16 bit color displays, the most common combination.
+FILL_KERNEL(_fill_palette1_rgb16, 1, FILL_SHADER_PALETTE, 16)
+FILL_KERNEL(_fill_palette2_rgb16, 2, FILL_SHADER_PALETTE, 16)
+FILL_KERNEL(_fill_palette4_rgb16, 4, FILL_SHADER_PALETTE, 16)
+FILL_KERNEL(_fill_palette8_rgb16, 8, FILL_SHADER_PALETTE, 16)
+#endif
+
+static fill_kernel_t _pick_fill_kernel(displayio_tilegrid_t *self, const _displayio_colorspace_t *colorspace) {
+    #if CIRCUITPY_DISPLAYIO_FILL_KERNELS
+    if (colorspace->depth == 16 &&
+        mp_obj_is_type(self->bitmap, &displayio_bitmap_type) &&
+        mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
+        displayio_bitmap_t *bitmap = MP_OBJ_TO_PTR(self->bitmap);
+        switch (bitmap->bits_per_value) {
+            case 1:
+                return _fill_palette1_rgb16;
+            case 2:
+                return _fill_palette2_rgb16;
+            case 4:
+                return _fill_palette4_rgb16;
+            case 8:
+                return _fill_palette8_rgb16;
+        }
+    }
+    #endif
+    return _fill_any;
+}
+
 bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
     const _displayio_colorspace_t *colorspace, const displayio_area_t *area,
     uint32_t *mask, uint32_t *buffer) {
@@ -409,6 +767,12 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
     // layers at that point.
     bool full_coverage = displayio_area_equal(area, &overlap);
 
+    if (_can_copy_rows(self, colorspace)) {
+        // Every pixel is opaque so the coverage only depends on the overlap.
+        _copy_rows(self, tiles, colorspace, area, &overlap, mask, buffer);
+        return full_coverage;
+    }
+
     // TODO(tannewt): Skip coverage tracking if all pixels outside the overlap have already been
     // set and our palette is all opaque.
 
@@ -448,85 +812,20 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
         y_shift = temp_shift;
     }
 
-    uint8_t pixels_per_byte = 8 / colorspace->depth;
-
-    displayio_input_pixel_t input_pixel;
-    displayio_output_pixel_t output_pixel;
-
-    for (input_pixel.y = start_y; input_pixel.y < end_y; ++input_pixel.y) {
-        int16_t row_start = start + (input_pixel.y - start_y + y_shift) * y_stride; // in pixels
-        int16_t local_y = input_pixel.y / self->absolute_transform->scale;
-        for (input_pixel.x = start_x; input_pixel.x < end_x; ++input_pixel.x) {
-            // Compute the destination pixel in the buffer and mask based on the transformations.
-            int16_t offset = row_start + (input_pixel.x - start_x + x_shift) * x_stride; // in pixels
-
-            // This is super useful for debugging out of range accesses. Uncomment to use.
-            // if (offset < 0 || offset >= (int32_t) displayio_area_size(area)) {
-            //     asm("bkpt");
-            // }
-
-            // Check the mask first to see if the pixel has already been set.
-            if ((mask[offset / 32] & (1 << (offset % 32))) != 0) {
-                continue;
-            }
-            int16_t local_x = input_pixel.x / self->absolute_transform->scale;
-            uint16_t tile_location = ((local_y / self->tile_height + self->top_left_y) % self->height_in_tiles) * self->width_in_tiles + (local_x / self->tile_width + self->top_left_x) % self->width_in_tiles;
-            input_pixel.tile = tiles[tile_location];
-            input_pixel.tile_x = (input_pixel.tile % self->bitmap_width_in_tiles) * self->tile_width + local_x % self->tile_width;
-            input_pixel.tile_y = (input_pixel.tile / self->bitmap_width_in_tiles) * self->tile_height + local_y % self->tile_height;
-
-            output_pixel.pixel = 0;
-            input_pixel.pixel = 0;
-
-            // We always want to read bitmap pixels by row first and then transpose into the destination
-            // buffer because most bitmaps are row associated.
-            if (mp_obj_is_type(self->bitmap, &displayio_bitmap_type)) {
-                input_pixel.pixel = common_hal_displayio_bitmap_get_pixel(self->bitmap, input_pixel.tile_x, input_pixel.tile_y);
-            } else if (mp_obj_is_type(self->bitmap, &displayio_ondiskbitmap_type)) {
-                input_pixel.pixel = common_hal_displayio_ondiskbitmap_get_pixel(self->bitmap, input_pixel.tile_x, input_pixel.tile_y);
-            }
-
-            output_pixel.opaque = true;
-            if (self->pixel_shader == mp_const_none) {
-                output_pixel.pixel = input_pixel.pixel;
-            } else if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
-                displayio_palette_get_color(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
-            } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
-                displayio_colorconverter_convert(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
-            }
-            if (!output_pixel.opaque) {
-                // A pixel is transparent so we haven't fully covered the area ourselves.
-                full_coverage = false;
-            } else {
-                mask[offset / 32] |= 1 << (offset % 32);
-                if (colorspace->depth == 16) {
-                    *(((uint16_t *)buffer) + offset) = output_pixel.pixel;
-                } else if (colorspace->depth == 32) {
-                    *(((uint32_t *)buffer) + offset) = output_pixel.pixel;
-                } else if (colorspace->depth == 8) {
-                    *(((uint8_t *)buffer) + offset) = output_pixel.pixel;
-                } else if (colorspace->depth < 8) {
-                    // Reorder the offsets to pack multiple rows into a byte (meaning they share a column).
-                    if (!colorspace->pixels_in_byte_share_row) {
-                        uint16_t width = displayio_area_width(area);
-                        uint16_t row = offset / width;
-                        uint16_t col = offset % width;
-                        // Dividing by pixels_per_byte does truncated division even if we multiply it back out.
-                        offset = col * pixels_per_byte + (row / pixels_per_byte) * pixels_per_byte * width + row % pixels_per_byte;
-                        // Also useful for validating that the bitpacking worked correctly.
-                        // if (offset > displayio_area_size(area)) {
-                        //     asm("bkpt");
-                        // }
-                    }
-                    uint8_t shift = (offset % pixels_per_byte) * colorspace->depth;
-                    if (colorspace->reverse_pixels_in_byte) {
-                        // Reverse the shift by subtracting it from the leftmost shift.
-                        shift = (pixels_per_byte - 1) * colorspace->depth - shift;
-                    }
-                    ((uint8_t *)buffer)[offset / pixels_per_byte] |= output_pixel.pixel << shift;
-                }
-            }
-        }
+    fill_loop_t loop = {
+        .start = start,
+        .start_x = start_x,
+        .end_x = end_x,
+        .start_y = start_y,
+        .end_y = end_y,
+        .x_shift = x_shift,
+        .y_shift = y_shift,
+        .x_stride = x_stride,
+        .y_stride = y_stride,
+    };
+    if (!_pick_fill_kernel(self, colorspace)(self, tiles, colorspace, area, &loop, mask, buffer)) {
+        // A pixel is transparent so we haven't fully covered the area ourselves.
+        full_coverage = false;
     }
     return full_coverage;
 }
@@ -51,6 +51,9 @@ typedef struct {
 
 void displayio_tilegrid_set_hidden_by_parent(displayio_tilegrid_t *self, bool hidden);
 
+// Sets count tiles of row y starting at x to tile_index and marks only them as changed.
+void displayio_tilegrid_set_row_tiles(displayio_tilegrid_t *self, uint16_t x, uint16_t y, uint16_t count, uint8_t tile_index);
+
 // Updating the screen is a three stage process.
 
 // The first stage is used to determine i
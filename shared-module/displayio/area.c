@@ -139,3 +139,77 @@ void displayio_area_transform_within(bool mirror_x, bool mirror_y, bool transpos
         transformed->x1 = whole->x1 + (y1 - whole->y1);
     }
 }
+
+// Extra pixels drawn by replacing a and b with their union. Negative when merging saves work.
+static int32_t _merge_cost(const displayio_area_t *a, const displayio_area_t *b, uint32_t setup_cost) {
+    displayio_area_t u;
+    displayio_area_union(a, b, &u);
+    return (int32_t)displayio_area_size(&u) -
+           (int32_t)(displayio_area_size(a) + displayio_area_size(b) + setup_cost);
+}
+
+const displayio_area_t *displayio_area_coalesce(const displayio_area_t *areas,
+    displayio_area_t *out, size_t out_count, uint32_t setup_cost,
+    displayio_area_coalesce_stats_t *stats) {
+    if (out_count == 0) {
+        return areas;
+    }
+    uint16_t areas_in = 0;
+    uint32_t pixels_in = 0;
+    size_t count = 0;
+    for (const displayio_area_t *area = areas; area != NULL; area = area->next) {
+        if (displayio_area_empty(area)) {
+            continue;
+        }
+        areas_in++;
+        pixels_in += displayio_area_size(area);
+
+        displayio_area_t candidate;
+        displayio_area_copy(area, &candidate);
+        // Merging can make the candidate overlap areas it didn't before so keep going until
+        // nothing else is worth merging.
+        size_t i = 0;
+        while (i < count) {
+            if (_merge_cost(&candidate, &out[i], setup_cost) > 0) {
+                i++;
+                continue;
+            }
+            displayio_area_union(&candidate, &out[i], &candidate);
+            count--;
+            displayio_area_copy(&out[count], &out[i]);
+            i = 0;
+        }
+        if (count == out_count) {
+            // Out of room. Merge into the area where it costs the least.
+            size_t best = 0;
+            int32_t best_cost = _merge_cost(&candidate, &out[0], setup_cost);
+            for (i = 1; i < count; i++) {
+                int32_t cost = _merge_cost(&candidate, &out[i], setup_cost);
+                if (cost < best_cost) {
+                    best = i;
+                    best_cost = cost;
+                }
+            }
+            displayio_area_union(&candidate, &out[best], &out[best]);
+        } else {
+            displayio_area_copy(&candidate, &out[count]);
+            count++;
+        }
+    }
+
+    uint32_t pixels_out = 0;
+    for (size_t i = 0; i < count; i++) {
+        pixels_out += displayio_area_size(&out[i]);
+        out[i].next = i + 1 < count ? &out[i + 1] : NULL;
+    }
+    if (stats != NULL) {
+        stats->areas_in = areas_in;
+        stats->areas_out = count;
+        stats->pixels_in = pixels_in;
+        stats->pixels_out = pixels_out;
+    }
+    if (count == 0) {
+        return NULL;
+    }
+    return &out[0];
+}
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -33,6 +34,13 @@ typedef struct {
     bool transpose_xy;
 } displayio_buffer_transform_t;
 
+typedef struct {
+    uint16_t areas_in;
+    uint16_t areas_out;
+    uint32_t pixels_in;
+    uint32_t pixels_out;
+} displayio_area_coalesce_stats_t;
+
 extern displayio_buffer_transform_t null_transform;
 
 bool displayio_area_empty(const displayio_area_t *a);
@@ -55,3 +63,9 @@ void displayio_area_transform_within(bool mirror_x, bool mirror_y, bool transpos
     const displayio_area_t *original,
     const displayio_area_t *whole,
     displayio_area_t *transformed);
+// Merges the linked list of areas into at most out_count areas stored in out. Two areas are merged
+// when their union costs no more pixels than drawing both, where each separate area also costs
+// setup_cost pixels. Returns the new list. stats may be NULL.
+const displayio_area_t *displayio_area_coalesce(const displayio_area_t *areas,
+    displayio_area_t *out, size_t out_count, uint32_t setup_cost,
+    displayio_area_coalesce_stats_t *stats);
@@ -21,6 +21,7 @@
 #include "shared-bindings/time/__init__.h"
 #include "shared-module/displayio/__init__.h"
 #include "shared-module/displayio/display_core.h"
+#include "supervisor/port.h"
 #include "supervisor/shared/display.h"
 #include "supervisor/shared/tick.h"
 
@@ -48,6 +49,9 @@ void displayio_display_bus_construct(displayio_display_bus_t *self,
     self->always_toggle_chip_select = always_toggle_chip_select;
     self->SH1107_addressing = SH1107_addressing;
     self->address_little_endian = address_little_endian;
+    self->start_send = NULL;
+    self->wait_for_send = NULL;
+    self->second_core_send = false;
 
     #if CIRCUITPY_PARALLELDISPLAYBUS
     if (mp_obj_is_type(bus, &paralleldisplaybus_parallelbus_type)) {
@@ -65,6 +69,10 @@ void displayio_display_bus_construct(displayio_display_bus_t *self,
         self->bus_free = common_hal_fourwire_fourwire_bus_free;
         self->begin_transaction = common_hal_fourwire_fourwire_begin_transaction;
         self->send = common_hal_fourwire_fourwire_send;
+        #if CIRCUITPY_BUSIO_SPI_ASYNC_WRITE
+        self->start_send = common_hal_fourwire_fourwire_start_send;
+        self->wait_for_send = common_hal_fourwire_fourwire_wait_for_send;
+        #endif
         self->end_transaction = common_hal_fourwire_fourwire_end_transaction;
         self->collect_ptrs = common_hal_fourwire_fourwire_collect_ptrs;
     } else
@@ -97,7 +105,75 @@ void displayio_display_bus_end_transaction(displayio_display_bus_t *self) {
     self->end_transaction(self->bus);
 }
 
+// There is only one second core, so at most one send is in flight on it.
+static struct {
+    display_byte_type_t data_type;
+    display_chip_select_behavior_t chip_select;
+    const uint8_t *data;
+    uint32_t data_length;
+    bool queued;
+} _second_core_send;
+
+// Runs on the second core, possibly spuriously.
+static void _second_core_send_worker(void *arg) {
+    displayio_display_bus_t *self = arg;
+    if (__atomic_load_n(&_second_core_send.queued, __ATOMIC_ACQUIRE)) {
+        self->send(self->bus, _second_core_send.data_type, _second_core_send.chip_select,
+            _second_core_send.data, _second_core_send.data_length);
+        __atomic_store_n(&_second_core_send.queued, false, __ATOMIC_RELEASE);
+    }
+}
+
+bool displayio_display_bus_start_background_sends(displayio_display_bus_t *self) {
+    if (self->start_send != NULL) {
+        return true;
+    }
+    if (!self->second_core_send) {
+        _second_core_send.queued = false;
+        self->second_core_send = port_second_core_start(_second_core_send_worker, self);
+    }
+    return self->second_core_send;
+}
+
+void displayio_display_bus_stop_background_sends(displayio_display_bus_t *self) {
+    if (!self->second_core_send) {
+        return;
+    }
+    displayio_display_bus_wait_for_send(self);
+    port_second_core_stop();
+    self->second_core_send = false;
+}
+
+void displayio_display_bus_start_send(displayio_display_bus_t *self, display_byte_type_t data_type,
+    display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length) {
+    if (!self->second_core_send) {
+        self->start_send(self->bus, data_type, chip_select, data, data_length);
+        return;
+    }
+    _second_core_send.data_type = data_type;
+    _second_core_send.chip_select = chip_select;
+    _second_core_send.data = data;
+    _second_core_send.data_length = data_length;
+    __atomic_store_n(&_second_core_send.queued, true, __ATOMIC_RELEASE);
+    port_second_core_wake();
+}
+
+void displayio_display_bus_wait_for_send(displayio_display_bus_t *self) {
+    if (!self->second_core_send) {
+        self->wait_for_send(self->bus);
+        return;
+    }
+    while (__atomic_load_n(&_second_core_send.queued, __ATOMIC_ACQUIRE)) {
+    }
+}
+
 void displayio_display_bus_set_region_to_update(displayio_display_bus_t *self, displayio_display_core_t *display, displayio_area_t *area) {
+    displayio_display_bus_begin_transaction(self);
+    displayio_display_bus_send_region_to_update(self, display, area);
+    displayio_display_bus_end_transaction(self);
+}
+
+void displayio_display_bus_send_region_to_update(displayio_display_bus_t *self, displayio_display_core_t *display, displayio_area_t *area) {
     uint16_t x1 = area->x1 + self->colstart;
     uint16_t x2 = area->x2 + self->colstart;
     uint16_t y1 = area->y1 + self->rowstart;
@@ -123,9 +199,11 @@ void displayio_display_bus_set_region_to_update(displayio_display_bus_t *self, d
         chip_select = CHIP_SELECT_TOGGLE_EVERY_BYTE;
     }
 
+    // When coordinates are sent as commands, as on I2C OLEDs, the column
+    // and row commands are combined into one send, which is one I2C write.
+
     // Set column.
-    displayio_display_bus_begin_transaction(self);
-    uint8_t data[5];
+    uint8_t data[10];
     data[0] = self->column_command;
     uint8_t data_length = 1;
     display_byte_type_t data_type = DISPLAY_DATA;
@@ -158,60 +236,61 @@ void displayio_display_bus_set_region_to_update(displayio_display_bus_t *self, d
         data_length = 2;
     }
 
-    self->send(self->bus, data_type, chip_select, data, data_length);
-    displayio_display_bus_end_transaction(self);
+    // Keep the column bytes for the row's send when nothing goes in between.
+    bool combine = self->data_as_commands && self->set_current_column_command == NO_COMMAND;
+    if (!combine) {
+        self->send(self->bus, data_type, chip_select, data, data_length);
 
-    if (self->set_current_column_command != NO_COMMAND) {
-        uint8_t command = self->set_current_column_command;
-        displayio_display_bus_begin_transaction(self);
-        self->send(self->bus, DISPLAY_COMMAND, chip_select, &command, 1);
-        // Only send the first half of data because it is the first coordinate.
-        self->send(self->bus, DISPLAY_DATA, chip_select, data, data_length / 2);
-        displayio_display_bus_end_transaction(self);
+        if (self->set_current_column_command != NO_COMMAND) {
+            uint8_t command = self->set_current_column_command;
+            self->send(self->bus, DISPLAY_COMMAND, chip_select, &command, 1);
+            // Only send the first half of data because it is the first coordinate.
+            self->send(self->bus, DISPLAY_DATA, chip_select, data, data_length / 2);
+        }
     }
 
-
     // Set row.
-    displayio_display_bus_begin_transaction(self);
-    data[0] = self->row_command;
-    data_length = 1;
+    uint8_t *row = combine ? data + data_length : data;
+    uint8_t row_length = 1;
+    row[0] = self->row_command;
     if (!self->data_as_commands) {
-        self->send(self->bus, DISPLAY_COMMAND, CHIP_SELECT_UNTOUCHED, data, 1);
-        data_length = 0;
+        self->send(self->bus, DISPLAY_COMMAND, CHIP_SELECT_UNTOUCHED, row, 1);
+        row_length = 0;
     }
 
     if (self->ram_height < 0x100) {
-        data[data_length++] = y1;
-        data[data_length++] = y2;
+        row[row_length++] = y1;
+        row[row_length++] = y2;
     } else {
         if (self->address_little_endian) {
             y1 = __builtin_bswap16(y1);
             y2 = __builtin_bswap16(y2);
         }
-        data[data_length++] = y1 >> 8;
-        data[data_length++] = y1 & 0xff;
-        data[data_length++] = y2 >> 8;
-        data[data_length++] = y2 & 0xff;
+        row[row_length++] = y1 >> 8;
+        row[row_length++] = y1 & 0xff;
+        row[row_length++] = y2 >> 8;
+        row[row_length++] = y2 & 0xff;
     }
 
     // Quirk for SH1107 "SH1107_addressing"
     //     Page address command = 0xB0
     if (self->SH1107_addressing) {
         // set the page to our y value
-        data[0] = 0xB0 | y1;
-        data_length = 1;
+        row[0] = 0xB0 | y1;
+        row_length = 1;
     }
 
-    self->send(self->bus, data_type, chip_select, data, data_length);
-    displayio_display_bus_end_transaction(self);
+    if (combine) {
+        self->send(self->bus, data_type, chip_select, data, data_length + row_length);
+    } else {
+        self->send(self->bus, data_type, chip_select, row, row_length);
+    }
 
     if (self->set_current_row_command != NO_COMMAND) {
         uint8_t command = self->set_current_row_command;
-        displayio_display_bus_begin_transaction(self);
         self->send(self->bus, DISPLAY_COMMAND, chip_select, &command, 1);
         // Only send the first half of data because it is the first coordinate.
-        self->send(self->bus, DISPLAY_DATA, chip_select, data, data_length / 2);
-        displayio_display_bus_end_transaction(self);
+        self->send(self->bus, DISPLAY_DATA, chip_select, row, row_length / 2);
     }
 }
 
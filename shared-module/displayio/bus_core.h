@@ -20,6 +20,11 @@ typedef struct {
     display_bus_bus_free bus_free;
     display_bus_begin_transaction begin_transaction;
     display_bus_send send;
+    // NULL when the bus can't send in the background.
+    display_bus_start_send start_send;
+    display_bus_wait_for_send wait_for_send;
+    // True while sends are being handed to the port's second core instead.
+    bool second_core_send;
     display_bus_end_transaction end_transaction;
     display_bus_collect_ptrs collect_ptrs;
     uint16_t ram_width;
@@ -47,7 +52,20 @@ bool displayio_display_bus_is_free(displayio_display_bus_t *self);
 bool displayio_display_bus_begin_transaction(displayio_display_bus_t *self);
 void displayio_display_bus_end_transaction(displayio_display_bus_t *self);
 
+// Lends the port's idle second core to a bus that can't send in the background,
+// so that one buffer can be filled while another is sent. Returns true when
+// displayio_display_bus_start_send() can be used until the matching stop.
+bool displayio_display_bus_start_background_sends(displayio_display_bus_t *self);
+void displayio_display_bus_stop_background_sends(displayio_display_bus_t *self);
+// data must stay valid until displayio_display_bus_wait_for_send() returns.
+void displayio_display_bus_start_send(displayio_display_bus_t *self, display_byte_type_t data_type,
+    display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length);
+void displayio_display_bus_wait_for_send(displayio_display_bus_t *self);
+
 void displayio_display_bus_set_region_to_update(displayio_display_bus_t *self, displayio_display_core_t *display, displayio_area_t *area);
+// Like set_region_to_update but within a transaction the caller has begun, so
+// that the pixels can follow without another one.
+void displayio_display_bus_send_region_to_update(displayio_display_bus_t *self, displayio_display_core_t *display, displayio_area_t *area);
 
 void release_display_bus(displayio_display_bus_t *self);
 
@@ -8,7 +8,6 @@
 
 #include "py/gc.h"
 #include "py/runtime.h"
-#include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/time/__init__.h"
 #include "shared-module/displayio/__init__.h"
 #include "supervisor/shared/display.h"
@@ -33,6 +32,9 @@ void displayio_display_core_construct(displayio_display_core_t *self,
     self->colorspace.dither = false;
     self->current_group = NULL;
     self->last_refresh = 0;
+    memset(&self->refresh_stats, 0, sizeof(self->refresh_stats));
+    self->frames = 0;
+    self->frames_skipped = 0;
 
     supervisor_start_terminal(width, height);
 
@@ -146,6 +148,7 @@ bool displayio_display_core_start_refresh(displayio_display_core_t *self) {
     }
     self->refresh_in_progress = true;
     self->last_refresh = supervisor_ticks_ms64();
+    memset(&self->pending_refresh_stats, 0, sizeof(self->pending_refresh_stats));
     return true;
 }
 
@@ -157,6 +160,35 @@ void displayio_display_core_finish_refresh(displayio_display_core_t *self) {
     self->full_refresh = false;
     self->refresh_in_progress = false;
     self->last_refresh = supervisor_ticks_ms64();
+    self->refresh_stats = self->pending_refresh_stats;
+    self->frames++;
+}
+
+void displayio_display_core_record_send(displayio_display_core_t *self, uint32_t bytes, uint32_t start_us) {
+    self->pending_refresh_stats.bytes += bytes;
+    self->pending_refresh_stats.send_us += supervisor_ticks_us32() - start_us;
+}
+
+void displayio_display_core_skip_refresh(displayio_display_core_t *self) {
+    self->frames_skipped++;
+}
+
+mp_obj_t displayio_display_core_get_refresh_stats(displayio_display_core_t *self) {
+    static const qstr fields[] = {
+        MP_QSTR_frames, MP_QSTR_frames_skipped, MP_QSTR_areas, MP_QSTR_pixels,
+        MP_QSTR_bytes, MP_QSTR_fill_us, MP_QSTR_send_us,
+    };
+    const displayio_refresh_stats_t *stats = &self->refresh_stats;
+    mp_obj_t items[] = {
+        mp_obj_new_int_from_uint(self->frames),
+        mp_obj_new_int_from_uint(self->frames_skipped),
+        mp_obj_new_int_from_uint(stats->areas),
+        mp_obj_new_int_from_uint(stats->pixels),
+        mp_obj_new_int_from_uint(stats->bytes),
+        mp_obj_new_int_from_uint(stats->fill_us),
+        mp_obj_new_int_from_uint(stats->send_us),
+    };
+    return mp_obj_new_attrtuple(fields, MP_ARRAY_SIZE(items), items);
 }
 
 void release_display_core(displayio_display_core_t *self) {
@@ -170,10 +202,27 @@ void displayio_display_core_collect_ptrs(displayio_display_core_t *self) {
 }
 
 bool displayio_display_core_fill_area(displayio_display_core_t *self, displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
-    if (self->current_group != NULL) {
+    if (self->current_group == NULL) {
+        return false;
+    }
+    if (!self->refresh_in_progress) {
         return displayio_group_fill_area(self->current_group, &self->colorspace, area, mask, buffer);
     }
-    return false;
+    uint32_t start_us = supervisor_ticks_us32();
+    bool full_coverage = displayio_group_fill_area(self->current_group, &self->colorspace, area, mask, buffer);
+    self->pending_refresh_stats.fill_us += supervisor_ticks_us32() - start_us;
+    self->pending_refresh_stats.pixels += displayio_area_size(area);
+    return full_coverage;
+}
+
+const displayio_area_t *displayio_display_core_coalesce_areas(displayio_display_core_t *self,
+    const displayio_area_t *areas, displayio_area_t *out, size_t out_count) {
+    const displayio_area_t *result = displayio_area_coalesce(areas, out, out_count,
+        CIRCUITPY_DISPLAY_AREA_SETUP_COST, &self->coalesce_stats);
+    DISPLAYIO_CORE_DEBUG("displayiocore coalesce %d areas (%d px) -> %d areas (%d px)\n",
+        self->coalesce_stats.areas_in, (int)self->coalesce_stats.pixels_in,
+        self->coalesce_stats.areas_out, (int)self->coalesce_stats.pixels_out);
+    return result;
 }
 
 bool displayio_display_core_clip_area(displayio_display_core_t *self, const displayio_area_t *area, displayio_area_t *clipped) {
@@ -181,6 +230,9 @@ bool displayio_display_core_clip_area(displayio_display_core_t *self, const disp
     if (!overlaps) {
         return false;
     }
+    if (self->refresh_in_progress) {
+        self->pending_refresh_stats.areas++;
+    }
     // Expand the area if we have multiple pixels per byte and we need to byte
     // align the bounds.
     if (self->colorspace.depth < 8) {
@@ -13,6 +13,16 @@
 
 #define NO_COMMAND 0x100
 
+// What one refresh did. Times are in microseconds. send_us is the time the CPU spent
+// handing pixels to the display: waiting on the bus, or copying into a framebuffer.
+typedef struct {
+    uint32_t areas;
+    uint32_t pixels;
+    uint32_t bytes;
+    uint32_t fill_us;
+    uint32_t send_us;
+} displayio_refresh_stats_t;
+
 typedef struct {
     displayio_group_t *current_group;
     uint64_t last_refresh;
@@ -22,6 +32,13 @@ typedef struct {
     uint16_t height;
     uint16_t rotation;
     _displayio_colorspace_t colorspace;
+    // How merging changed the dirty areas of the last refresh.
+    displayio_area_coalesce_stats_t coalesce_stats;
+    // The last finished refresh and the one in progress.
+    displayio_refresh_stats_t refresh_stats;
+    displayio_refresh_stats_t pending_refresh_stats;
+    uint32_t frames;
+    uint32_t frames_skipped;
 
     bool full_refresh; // New group means we need to refresh the whole display.
     bool refresh_in_progress;
@@ -50,4 +67,14 @@ void displayio_display_core_collect_ptrs(displayio_display_core_t *self);
 
 bool displayio_display_core_fill_area(displayio_display_core_t *self, displayio_area_t *area, uint32_t *mask, uint32_t *buffer);
 
+const displayio_area_t *displayio_display_core_coalesce_areas(displayio_display_core_t *self,
+    const displayio_area_t *areas, displayio_area_t *out, size_t out_count);
+
+// Adds bytes sent to the display, and the time since start_us, to the refresh in progress.
+void displayio_display_core_record_send(displayio_display_core_t *self, uint32_t bytes, uint32_t start_us);
+// Counts a refresh that was skipped to keep up with the target frame rate.
+void displayio_display_core_skip_refresh(displayio_display_core_t *self);
+// Returns the refresh statistics as a named tuple for the display bindings.
+mp_obj_t displayio_display_core_get_refresh_stats(displayio_display_core_t *self);
+
 bool displayio_display_core_clip_area(displayio_display_core_t *self, const displayio_area_t *area, displayio_area_t *clipped);
@@ -15,6 +15,7 @@
 #include "shared-module/displayio/__init__.h"
 #include "supervisor/shared/display.h"
 #include "supervisor/shared/tick.h"
+#include "supervisor/shared/trace.h"
 
 #if CIRCUITPY_TINYUSB
 #include "supervisor/usb.h"
@@ -79,6 +80,12 @@ void common_hal_epaperdisplay_epaperdisplay_construct(epaperdisplay_epaperdispla
     self->stop_sequence_len = stop_sequence_len;
     self->refresh_sequence = refresh_sequence;
     self->refresh_sequence_len = refresh_sequence_len;
+    self->partial_refresh_sequence = NULL;
+    self->partial_refresh_sequence_len = 0;
+    self->partial_refresh_time = self->refresh_time;
+    self->max_partial_refreshes = 0;
+    self->partial_refreshes = 0;
+    self->refreshing_partial = false;
 
     self->busy.base.type = &mp_type_NoneType;
     self->two_byte_sequence_length = two_byte_sequence_length;
@@ -183,6 +190,38 @@ void epaperdisplay_epaperdisplay_change_refresh_mode_parameters(epaperdisplay_ep
     self->milliseconds_per_frame = seconds_per_frame * 1000;
 }
 
+void epaperdisplay_epaperdisplay_set_partial_refresh(epaperdisplay_epaperdisplay_obj_t *self,
+    const uint8_t *partial_refresh_sequence, uint16_t partial_refresh_sequence_len,
+    mp_float_t partial_refresh_time, uint16_t max_partial_refreshes) {
+    self->partial_refresh_sequence = partial_refresh_sequence;
+    self->partial_refresh_sequence_len = partial_refresh_sequence_len;
+    self->partial_refresh_time = partial_refresh_time * 1000;
+    self->max_partial_refreshes = max_partial_refreshes;
+    self->partial_refreshes = 0;
+}
+
+// Partial refreshes only redraw the windows written since the last refresh,
+// so they need window commands and are kept to changes covering at most half
+// of the panel. Bigger changes get the full waveform anyway.
+static bool epaperdisplay_epaperdisplay_use_partial_refresh(epaperdisplay_epaperdisplay_obj_t *self,
+    const displayio_area_t *areas) {
+    if (self->partial_refresh_sequence == NULL || self->core.full_refresh || self->acep ||
+        self->bus.row_command == NO_COMMAND) {
+        return false;
+    }
+    if (self->max_partial_refreshes > 0 && self->partial_refreshes >= self->max_partial_refreshes) {
+        return false;
+    }
+    uint32_t pixels = 0;
+    for (const displayio_area_t *area = areas; area != NULL; area = area->next) {
+        displayio_area_t clipped;
+        if (displayio_area_compute_overlap(&self->core.area, area, &clipped)) {
+            pixels += displayio_area_size(&clipped);
+        }
+    }
+    return pixels <= displayio_area_size(&self->core.area) / 2;
+}
+
 static void epaperdisplay_epaperdisplay_start_refresh(epaperdisplay_epaperdisplay_obj_t *self) {
     if (!displayio_display_bus_is_free(&self->bus)) {
         // Can't acquire display bus; skip updating this display. Try next display.
@@ -213,12 +252,19 @@ uint32_t common_hal_epaperdisplay_epaperdisplay_get_time_to_refresh(epaperdispla
     return self->milliseconds_per_frame - elapsed_time;
 }
 
-static void epaperdisplay_epaperdisplay_finish_refresh(epaperdisplay_epaperdisplay_obj_t *self) {
+static void epaperdisplay_epaperdisplay_finish_refresh(epaperdisplay_epaperdisplay_obj_t *self, bool partial) {
     // Actually refresh the display now that all pixel RAM has been updated.
-    send_command_sequence(self, false, self->refresh_sequence, self->refresh_sequence_len);
+    if (partial) {
+        send_command_sequence(self, false, self->partial_refresh_sequence, self->partial_refresh_sequence_len);
+        self->partial_refreshes++;
+    } else {
+        send_command_sequence(self, false, self->refresh_sequence, self->refresh_sequence_len);
+        self->partial_refreshes = 0;
+    }
 
     supervisor_enable_tick();
     self->refreshing = true;
+    self->refreshing_partial = partial;
 
     displayio_display_core_finish_refresh(&self->core);
 }
@@ -249,6 +295,10 @@ uint16_t common_hal_epaperdisplay_epaperdisplay_get_rotation(epaperdisplay_epape
     return self->core.rotation;
 }
 
+mp_obj_t common_hal_epaperdisplay_epaperdisplay_get_refresh_stats(epaperdisplay_epaperdisplay_obj_t *self) {
+    return displayio_display_core_get_refresh_stats(&self->core);
+}
+
 mp_obj_t common_hal_epaperdisplay_epaperdisplay_get_root_group(epaperdisplay_epaperdisplay_obj_t *self) {
     if (self->core.current_group == NULL) {
         return mp_const_none;
@@ -357,7 +407,9 @@ static bool epaperdisplay_epaperdisplay_refresh_area(epaperdisplay_epaperdisplay
                 // Can't acquire display bus; skip the rest of the data. Try next display.
                 return false;
             }
+            uint32_t send_start_us = supervisor_ticks_us32();
             self->bus.send(self->bus.bus, DISPLAY_DATA, self->chip_select, (uint8_t *)buffer, subrectangle_size_bytes);
+            displayio_display_core_record_send(&self->core, subrectangle_size_bytes, send_start_us);
             displayio_display_bus_end_transaction(&self->bus);
 
             // TODO(tannewt): Make refresh displays faster so we don't starve other
@@ -431,7 +483,7 @@ bool common_hal_epaperdisplay_epaperdisplay_refresh(epaperdisplay_epaperdisplay_
     if (self->acep) {
         epaperdisplay_epaperdisplay_start_refresh(self);
         _clean_area(self);
-        epaperdisplay_epaperdisplay_finish_refresh(self);
+        epaperdisplay_epaperdisplay_finish_refresh(self, false);
         while (self->refreshing && !mp_hal_is_interrupted()) {
             RUN_BACKGROUND_TASKS;
         }
@@ -440,12 +492,15 @@ bool common_hal_epaperdisplay_epaperdisplay_refresh(epaperdisplay_epaperdisplay_
         return false;
     }
 
+    bool partial = epaperdisplay_epaperdisplay_use_partial_refresh(self, current_area);
+    CIRCUITPY_TRACE_BEGIN(TRACE_EVENT_DISPLAY_REFRESH);
     epaperdisplay_epaperdisplay_start_refresh(self);
     while (current_area != NULL) {
         epaperdisplay_epaperdisplay_refresh_area(self, current_area);
         current_area = current_area->next;
     }
-    epaperdisplay_epaperdisplay_finish_refresh(self);
+    epaperdisplay_epaperdisplay_finish_refresh(self, partial);
+    CIRCUITPY_TRACE_END(TRACE_EVENT_DISPLAY_REFRESH);
     return true;
 }
 
@@ -456,7 +511,8 @@ void epaperdisplay_epaperdisplay_background(epaperdisplay_epaperdisplay_obj_t *s
             bool busy = common_hal_digitalio_digitalinout_get_value(&self->busy);
             refresh_done = busy != self->busy_state;
         } else {
-            refresh_done = supervisor_ticks_ms64() - self->core.last_refresh > self->refresh_time;
+            uint16_t refresh_time = self->refreshing_partial ? self->partial_refresh_time : self->refresh_time;
+            refresh_done = supervisor_ticks_ms64() - self->core.last_refresh > refresh_time;
         }
         if (refresh_done) {
             supervisor_disable_tick();
@@ -498,6 +554,7 @@ void epaperdisplay_epaperdisplay_collect_ptrs(epaperdisplay_epaperdisplay_obj_t
     gc_collect_ptr((void *)self->start_sequence);
     gc_collect_ptr((void *)self->stop_sequence);
     gc_collect_ptr((void *)self->refresh_sequence);
+    gc_collect_ptr((void *)self->partial_refresh_sequence);
 }
 
 size_t maybe_refresh_epaperdisplay(void) {
@@ -22,11 +22,20 @@ typedef struct {
     const uint8_t *start_sequence;
     const uint8_t *stop_sequence;
     const uint8_t *refresh_sequence;
+    // Optional sequence sent instead of refresh_sequence when only a small
+    // part of the panel changed, usually selecting a fast waveform.
+    const uint8_t *partial_refresh_sequence;
     uint16_t start_sequence_len;
     uint16_t stop_sequence_len;
     uint16_t refresh_sequence_len;
+    uint16_t partial_refresh_sequence_len;
     uint16_t start_up_time_ms;
     uint16_t refresh_time;
+    uint16_t partial_refresh_time;
+    // Partial refreshes allowed in a row before a full one clears the
+    // ghosting they leave behind. 0 allows any number.
+    uint16_t max_partial_refreshes;
+    uint16_t partial_refreshes;
     uint16_t write_black_ram_command;
     uint16_t write_color_ram_command;
     uint8_t hue;
@@ -34,6 +43,7 @@ typedef struct {
     bool black_bits_inverted;
     bool color_bits_inverted;
     bool refreshing;
+    bool refreshing_partial;
     bool grayscale;
     bool acep;
     bool two_byte_sequence_length;
@@ -42,6 +52,9 @@ typedef struct {
 
 void epaperdisplay_epaperdisplay_change_refresh_mode_parameters(epaperdisplay_epaperdisplay_obj_t *self,
     mp_buffer_info_t *start_sequence, float seconds_per_frame);
+void epaperdisplay_epaperdisplay_set_partial_refresh(epaperdisplay_epaperdisplay_obj_t *self,
+    const uint8_t *partial_refresh_sequence, uint16_t partial_refresh_sequence_len,
+    mp_float_t partial_refresh_time, uint16_t max_partial_refreshes);
 void epaperdisplay_epaperdisplay_background(epaperdisplay_epaperdisplay_obj_t *self);
 void epaperdisplay_epaperdisplay_reset(epaperdisplay_epaperdisplay_obj_t *self);
 void release_epaperdisplay(epaperdisplay_epaperdisplay_obj_t *self);
@@ -159,8 +159,31 @@ void common_hal_fourwire_fourwire_send(mp_obj_t obj, display_byte_type_t data_ty
     }
 }
 
+#if CIRCUITPY_BUSIO_SPI_ASYNC_WRITE
+void common_hal_fourwire_fourwire_start_send(mp_obj_t obj, display_byte_type_t data_type,
+    display_chip_select_behavior_t chip_select, const uint8_t *data, uint32_t data_length) {
+    fourwire_fourwire_obj_t *self = MP_OBJ_TO_PTR(obj);
+    // 9-bit mode and chip select toggling are done a byte at a time anyway.
+    if (self->command.base.type == &mp_type_NoneType || chip_select == CHIP_SELECT_TOGGLE_EVERY_BYTE) {
+        common_hal_fourwire_fourwire_send(obj, data_type, chip_select, data, data_length);
+        return;
+    }
+    common_hal_digitalio_digitalinout_set_value(&self->command, data_type == DISPLAY_DATA);
+    common_hal_busio_spi_start_write(self->bus, data, data_length);
+}
+
+void common_hal_fourwire_fourwire_wait_for_send(mp_obj_t obj) {
+    fourwire_fourwire_obj_t *self = MP_OBJ_TO_PTR(obj);
+    common_hal_busio_spi_wait_for_write(self->bus);
+}
+#endif
+
 void common_hal_fourwire_fourwire_end_transaction(mp_obj_t obj) {
     fourwire_fourwire_obj_t *self = MP_OBJ_TO_PTR(obj);
+    #if CIRCUITPY_BUSIO_SPI_ASYNC_WRITE
+    // Don't deselect the display while pixels are still going out.
+    common_hal_busio_spi_wait_for_write(self->bus);
+    #endif
     if (self->chip_select.base.type != &mp_type_NoneType) {
         common_hal_digitalio_digitalinout_set_value(&self->chip_select, true);
     }
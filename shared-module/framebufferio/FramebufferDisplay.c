@@ -11,10 +11,12 @@
 #include "py/runtime.h"
 #include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/time/__init__.h"
+#include "shared-module/displayio/Bitmap.h"
 #include "shared-module/displayio/__init__.h"
 #include "shared-module/displayio/display_core.h"
 #include "supervisor/shared/display.h"
 #include "supervisor/shared/tick.h"
+#include "supervisor/shared/trace.h"
 
 #if CIRCUITPY_TINYUSB
 #include "supervisor/usb.h"
@@ -116,6 +118,75 @@ static const displayio_area_t *_get_refresh_areas(framebufferio_framebufferdispl
 }
 
 #define MARK_ROW_DIRTY(r) (dirty_row_bitmask[r / 8] |= (1 << (r & 7)))
+
+// Whole framebuffer rows that are packed back to back are laid out exactly
+// like the buffer that fill_area composites, so they can be rendered in
+// place instead of through a buffer and a copy. Pixels must be whole bytes
+// because smaller ones are ORed into a zeroed buffer, which would show
+// through on framebuffers that are scanned out while we draw.
+static bool _can_render_direct(framebufferio_framebufferdisplay_obj_t *self, const displayio_area_t *clipped) {
+    uint8_t depth = self->core.colorspace.depth;
+    uint8_t *buf = (uint8_t *)self->bufinfo.buf + self->first_pixel_offset;
+    return (depth == 8 || depth == 16 || depth == 32) &&
+           clipped->x1 == self->core.area.x1 && clipped->x2 == self->core.area.x2 &&
+           self->row_stride == displayio_area_width(&self->core.area) * depth / 8 &&
+           self->row_stride % sizeof(uint32_t) == 0 &&
+           ((uintptr_t)buf) % sizeof(uint32_t) == 0;
+}
+
+static void _refresh_area_direct(framebufferio_framebufferdisplay_obj_t *self, const displayio_area_t *clipped, uint8_t *dirty_row_bitmask) {
+    uint16_t width = displayio_area_width(clipped);
+    uint8_t depth = self->core.colorspace.depth;
+    // Only the mask lives on the stack, so spend the area buffer on it.
+    uint16_t rows_per_chunk = CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE * 8 / width;
+    if (rows_per_chunk == 0) {
+        rows_per_chunk = 1;
+    }
+    uint32_t mask_length = (rows_per_chunk * width / 32) + 1;
+    uint32_t mask[mask_length];
+
+    uint8_t *buf = (uint8_t *)self->bufinfo.buf, *endbuf = buf + self->bufinfo.len;
+    (void)endbuf; // Hint to compiler that endbuf is "used" even if NDEBUG
+    buf += self->first_pixel_offset;
+
+    for (uint16_t y = clipped->y1; y < clipped->y2; y += rows_per_chunk) {
+        displayio_area_t chunk = {
+            .x1 = clipped->x1,
+            .y1 = y,
+            .x2 = clipped->x2,
+            .y2 = MIN(y + rows_per_chunk, clipped->y2),
+        };
+        uint8_t *dest = buf + chunk.y1 * self->row_stride;
+        uint32_t pixels = displayio_area_size(&chunk);
+        assert(dest >= buf && dest + pixels * depth / 8 <= endbuf);
+
+        // Pixels keep their previous value until they are drawn, and the
+        // ones no layer covers are cleared afterwards, so nothing flashes.
+        memset(mask, 0, mask_length * sizeof(mask[0]));
+        if (!displayio_display_core_fill_area(&self->core, &chunk, mask, (uint32_t *)dest)) {
+            for (uint32_t i = 0; i < pixels; i++) {
+                if (mask[i / 32] & (1u << (i % 32))) {
+                    continue;
+                }
+                if (depth == 16) {
+                    ((uint16_t *)dest)[i] = 0;
+                } else if (depth == 32) {
+                    ((uint32_t *)dest)[i] = 0;
+                } else {
+                    dest[i] = 0;
+                }
+            }
+        }
+        for (uint16_t i = chunk.y1; i < chunk.y2; i++) {
+            MARK_ROW_DIRTY(i);
+        }
+
+        #if CIRCUITPY_TINYUSB
+        usb_background();
+        #endif
+    }
+}
+
 static bool _refresh_area(framebufferio_framebufferdisplay_obj_t *self, const displayio_area_t *area, uint8_t *dirty_row_bitmask) {
     uint16_t buffer_size = CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE / sizeof(uint32_t); // In uint32_ts
 
@@ -124,6 +195,10 @@ static bool _refresh_area(framebufferio_framebufferdisplay_obj_t *self, const di
     if (!displayio_display_core_clip_area(&self->core, area, &clipped)) {
         return true;
     }
+    if (_can_render_direct(self, &clipped)) {
+        _refresh_area_direct(self, &clipped, dirty_row_bitmask);
+        return true;
+    }
     uint16_t subrectangles = 1;
 
     // If pixels are packed by row then rows are on byte boundaries
@@ -193,13 +268,22 @@ static bool _refresh_area(framebufferio_framebufferdisplay_obj_t *self, const di
         uint8_t *src = (uint8_t *)buffer;
         size_t rowsize = (subrectangle.x2 - subrectangle.x1) * self->core.colorspace.depth / 8;
 
+        uint32_t copy_start_us = supervisor_ticks_us32();
+        bool copied = self->core.colorspace.depth >= 8 &&
+            displayio_port_copy_rect(dest, rowstride, src, rowsize,
+                displayio_area_width(&subrectangle), displayio_area_height(&subrectangle),
+                self->core.colorspace.depth / 8);
         for (uint16_t i = subrectangle.y1; i < subrectangle.y2; i++) {
             assert(dest >= buf && dest < endbuf && dest + rowsize <= endbuf);
             MARK_ROW_DIRTY(i);
-            memcpy(dest, src, rowsize);
+            if (!copied) {
+                memcpy(dest, src, rowsize);
+            }
             dest += rowstride;
             src += rowsize;
         }
+        displayio_display_core_record_send(&self->core,
+            rowsize * (subrectangle.y2 - subrectangle.y1), copy_start_us);
 
         // TODO(tannewt): Make refresh displays faster so we don't starve other
         // background tasks.
@@ -215,8 +299,14 @@ static void _refresh_display(framebufferio_framebufferdisplay_obj_t *self) {
     if (!self->bufinfo.buf) {
         return;
     }
+    CIRCUITPY_TRACE_BEGIN(TRACE_EVENT_DISPLAY_REFRESH);
     displayio_display_core_start_refresh(&self->core);
     const displayio_area_t *current_area = _get_refresh_areas(self);
+    #if CIRCUITPY_DISPLAY_COALESCE_AREA_COUNT > 0
+    displayio_area_t coalesced_areas[CIRCUITPY_DISPLAY_COALESCE_AREA_COUNT];
+    current_area = displayio_display_core_coalesce_areas(&self->core, current_area,
+        coalesced_areas, CIRCUITPY_DISPLAY_COALESCE_AREA_COUNT);
+    #endif
     if (current_area) {
         bool transposed = (self->core.rotation == 90 || self->core.rotation == 270);
         int row_count = transposed ? self->core.width : self->core.height;
@@ -227,9 +317,12 @@ static void _refresh_display(framebufferio_framebufferdisplay_obj_t *self) {
             _refresh_area(self, current_area, dirty_row_bitmask);
             current_area = current_area->next;
         }
+        uint32_t swap_start_us = supervisor_ticks_us32();
         self->framebuffer_protocol->swapbuffers(self->framebuffer, dirty_row_bitmask);
+        displayio_display_core_record_send(&self->core, 0, swap_start_us);
     }
     displayio_display_core_finish_refresh(&self->core);
+    CIRCUITPY_TRACE_END(TRACE_EVENT_DISPLAY_REFRESH);
 }
 
 void common_hal_framebufferio_framebufferdisplay_set_rotation(framebufferio_framebufferdisplay_obj_t *self, int rotation) {
@@ -267,6 +360,7 @@ bool common_hal_framebufferio_framebufferdisplay_refresh(framebufferio_framebuff
         self->last_refresh_call = current_time;
         // Skip the actual refresh to help catch up.
         if (current_ms_since_last_call > target_ms_per_frame) {
+            displayio_display_core_skip_refresh(&self->core);
             return false;
         }
         uint32_t remaining_time = target_ms_per_frame - (current_ms_since_real_refresh % target_ms_per_frame);
@@ -333,6 +427,10 @@ void framebufferio_framebufferdisplay_reset(framebufferio_framebufferdisplay_obj
     }
 }
 
+mp_obj_t common_hal_framebufferio_framebufferdisplay_get_refresh_stats(framebufferio_framebufferdisplay_obj_t *self) {
+    return displayio_display_core_get_refresh_stats(&self->core);
+}
+
 mp_obj_t common_hal_framebufferio_framebufferdisplay_get_root_group(framebufferio_framebufferdisplay_obj_t *self) {
     if (self->core.current_group == NULL) {
         return mp_const_none;
@@ -16,7 +16,27 @@
 #include "shared-bindings/displayio/ColorConverter.h"
 #include "shared-bindings/util.h"
 
-#define BLOCK_SIZE (126) // (2^7) - 2 // (DO NOT CHANGE!)
+// The pixels are written as 7-bit color indices.
+#define LZW_MIN_CODE_SIZE (7)
+#define LZW_CLEAR_CODE (1 << LZW_MIN_CODE_SIZE)
+#define LZW_END_CODE (LZW_CLEAR_CODE + 1)
+#define LZW_FIRST_CODE (LZW_CLEAR_CODE + 2)
+#define LZW_MAX_CODE_BITS (12)
+
+// Size of the LZW string table as a power of two. Each entry takes 4 bytes. A smaller
+// table saves memory but restarts the dictionary more often, which compresses worse.
+#ifndef CIRCUITPY_GIFWRITER_LZW_HASH_BITS
+#define CIRCUITPY_GIFWRITER_LZW_HASH_BITS (12)
+#endif
+
+// The dictionary is restarted when it fills 3/4 of the hash table, so probes stay short.
+// This is never a power of two below 4096, which would confuse decoders about the code
+// size at the moment the dictionary is cleared.
+#define LZW_CODE_LIMIT MIN(1 << LZW_MAX_CODE_BITS, 3 << (CIRCUITPY_GIFWRITER_LZW_HASH_BITS - 2))
+
+// Data is flushed to the file whenever the space left may not hold another sub-block.
+#define GIFWRITER_BUFFER_SIZE (1024)
+#define SUB_BLOCK_SIZE (255)
 
 static void handle_error(gifio_gifwriter_t *self) {
     if (self->error != 0) {
@@ -48,15 +68,11 @@ static void write_byte(gifio_gifwriter_t *self, uint8_t value) {
     write_data(self, &value, sizeof(value));
 }
 
-static void write_long(gifio_gifwriter_t *self, uint32_t value) {
-    write_data(self, &value, sizeof(value));
-}
-
 static void write_word(gifio_gifwriter_t *self, uint16_t value) {
     write_data(self, &value, sizeof(value));
 }
 
-void shared_module_gifio_gifwriter_construct(gifio_gifwriter_t *self, mp_obj_t *file, int width, int height, displayio_colorspace_t colorspace, bool loop, bool dither, bool own_file) {
+void shared_module_gifio_gifwriter_construct(gifio_gifwriter_t *self, mp_obj_t *file, int width, int height, displayio_colorspace_t colorspace, bool loop, bool dither, bool frame_differencing, bool own_file) {
     self->file = file;
     self->file_proto = mp_get_stream_raise(file, MP_STREAM_OP_WRITE | MP_STREAM_OP_IOCTL);
     if (self->file_proto->is_text) {
@@ -68,11 +84,20 @@ void shared_module_gifio_gifwriter_construct(gifio_gifwriter_t *self, mp_obj_t *
     self->dither = dither;
     self->own_file = own_file;
 
-    size_t nblocks = (width * height + 125) / 126;
-    self->size = nblocks * 128 + 4;
+    self->size = GIFWRITER_BUFFER_SIZE;
     self->data = m_malloc(self->size);
     self->cur = 0;
     self->error = 0;
+    self->lzw_table = m_malloc(sizeof(uint32_t) << CIRCUITPY_GIFWRITER_LZW_HASH_BITS);
+    self->row = m_malloc(width);
+    self->previous = 0;
+    if (frame_differencing) {
+        self->previous = gc_movable_alloc(width * height);
+        if (self->previous == 0) {
+            m_malloc_fail(width * height);
+        }
+    }
+    self->frame_count = 0;
 
     write_data(self, "GIF89a", 6);
     write_word(self, width);
@@ -124,6 +149,13 @@ void shared_module_gifio_gifwriter_construct(gifio_gifwriter_t *self, mp_obj_t *
     handle_error(self);
 }
 
+void shared_module_gifio_gifwriter_del(gifio_gifwriter_t *self) {
+    if (self->previous != 0) {
+        gc_movable_free(self->previous);
+        self->previous = 0;
+    }
+}
+
 bool shared_module_gifio_gifwriter_deinited(gifio_gifwriter_t *self) {
     return !self->file;
 }
@@ -154,97 +186,215 @@ static const uint8_t g_bayer[4][4] = {
     {31, 14, 26, 10}
 };
 
-void shared_module_gifio_gifwriter_add_frame(gifio_gifwriter_t *self, const mp_buffer_info_t *bufinfo, int16_t delay) {
-    if (delay) {
-        write_data(self, (uint8_t []) {'!', 0xF9, 0x04, 0x04}, 4);
-        write_word(self, delay);
-        write_word(self, 0); // end
+// Convert one row of the frame to 7-bit color indices.
+static void convert_row(gifio_gifwriter_t *self, const mp_buffer_info_t *bufinfo, int y, uint8_t *out) {
+    int width = self->width;
+    if (self->colorspace == DISPLAYIO_COLORSPACE_L8) {
+        const uint8_t *pixels = (const uint8_t *)bufinfo->buf + y * width;
+        for (int x = 0; x < width; x++) {
+            *out++ = (*pixels++) >> 1;
+        }
+    } else if (!self->dither) {
+        const uint16_t *pixels = (const uint16_t *)bufinfo->buf + y * width;
+        for (int x = 0; x < width; x++) {
+            int pixel = *pixels++;
+            if (self->byteswap) {
+                pixel = __builtin_bswap16(pixel);
+            }
+            int red = (pixel >> (11 + (5 - 2))) & 0x3;
+            int green = (pixel >> (5 + (6 - 3))) & 0x7;
+            int blue = (pixel >> (0 + (5 - 2))) & 0x3;
+            *out++ = (red << 5) | (green << 2) | blue;
+        }
+    } else {
+        const uint16_t *pixels = (const uint16_t *)bufinfo->buf + y * width;
+        for (int x = 0; x < width; x++) {
+            int pixel = *pixels++;
+            if (self->byteswap) {
+                pixel = __builtin_bswap16(pixel);
+            }
+            int red = (pixel >> 8) & 0xf8;
+            int green = (pixel >> 3) & 0xfc;
+            int blue = (pixel << 3) & 0xf8;
+
+            red = MAX(0, red - rb_bayer[x % 4][y % 4]);
+            green = MAX(0, green - g_bayer[x % 4][(y + 2) % 4]);
+            blue = MAX(0, blue - rb_bayer[(x + 2) % 4][y % 4]);
+
+            *out++ = ((red >> 1) & 0x60) | ((green >> 3) & 0x1c) | (blue >> 6);
+        }
     }
+}
 
-    write_byte(self, 0x2C);
-    write_long(self, 0);
-    write_word(self, self->width);
-    write_word(self, self->height);
-    write_data(self, (uint8_t []) {0x00, 0x07}, 2); // 7-bits
+// Append a byte of LZW data, packing it into length-prefixed sub-blocks.
+static void lzw_put_byte(gifio_gifwriter_t *self, uint8_t value) {
+    if (self->sub_block_start < 0) {
+        self->sub_block_start = self->cur;
+        self->data[self->cur++] = 0;
+    }
+    self->data[self->cur++] = value;
+    if (++self->data[self->sub_block_start] == SUB_BLOCK_SIZE) {
+        self->sub_block_start = -1;
+        if (self->size - self->cur < SUB_BLOCK_SIZE + 1) {
+            flush_data(self);
+        }
+    }
+}
 
-    int pixel_count = self->width * self->height;
-    int blocks = (pixel_count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+static void lzw_put_code(gifio_gifwriter_t *self, uint32_t code) {
+    self->lzw_bits |= code << self->lzw_bit_count;
+    self->lzw_bit_count += self->lzw_code_size;
+    while (self->lzw_bit_count >= 8) {
+        lzw_put_byte(self, self->lzw_bits & 0xff);
+        self->lzw_bits >>= 8;
+        self->lzw_bit_count -= 8;
+    }
+}
 
-    uint8_t *data = self->data + self->cur;
+static void lzw_clear(gifio_gifwriter_t *self) {
+    lzw_put_code(self, LZW_CLEAR_CODE);
+    memset(self->lzw_table, 0, sizeof(uint32_t) << CIRCUITPY_GIFWRITER_LZW_HASH_BITS);
+    self->lzw_next_code = LZW_FIRST_CODE;
+    self->lzw_code_size = LZW_MIN_CODE_SIZE + 1;
+}
 
-    if (self->colorspace == DISPLAYIO_COLORSPACE_L8) {
-        mp_get_index(&mp_type_memoryview, bufinfo->len, MP_OBJ_NEW_SMALL_INT(pixel_count - 1), false);
-
-        uint8_t *pixels = bufinfo->buf;
-        for (int i = 0; i < blocks; i++) {
-            assert(pixel_count >= 0);
-            int block_size = MIN(BLOCK_SIZE, pixel_count);
-            pixel_count -= block_size;
-            *data++ = 1 + block_size;
-            *data++ = 0x80;
-            for (int j = 0; j < block_size; j++) {
-                *data++ = (*pixels++) >> 1;
-            }
+// Table entries hold (prefix code, next index) + 1 in the top 20 bits and the string's
+// code in the low 12 bits, so that 0 marks an empty slot.
+static void lzw_write(gifio_gifwriter_t *self, const uint8_t *indices, int count) {
+    const uint32_t mask = (1 << CIRCUITPY_GIFWRITER_LZW_HASH_BITS) - 1;
+    uint32_t *table = self->lzw_table;
+    int prefix = self->lzw_prefix;
+    for (int i = 0; i < count; i++) {
+        uint32_t c = indices[i];
+        if (prefix < 0) {
+            prefix = c;
+            continue;
         }
-    } else if (!self->dither) {
-        mp_get_index(&mp_type_memoryview, bufinfo->len, MP_OBJ_NEW_SMALL_INT(2 * pixel_count - 1), false);
-
-        uint16_t *pixels = bufinfo->buf;
-        for (int i = 0; i < blocks; i++) {
-            int block_size = MIN(BLOCK_SIZE, pixel_count);
-            pixel_count -= block_size;
-
-            *data++ = 1 + block_size;
-            *data++ = 0x80;
-            for (int j = 0; j < block_size; j++) {
-                int pixel = *pixels++;
-                if (self->byteswap) {
-                    pixel = __builtin_bswap16(pixel);
-                }
-                int red = (pixel >> (11 + (5 - 2))) & 0x3;
-                int green = (pixel >> (5 + (6 - 3))) & 0x7;
-                int blue = (pixel >> (0 + (5 - 2))) & 0x3;
-                *data++ = (red << 5) | (green << 2) | blue;
+        uint32_t key = ((prefix << LZW_MIN_CODE_SIZE) | c) + 1;
+        uint32_t h = (key * 2654435761u) >> (32 - CIRCUITPY_GIFWRITER_LZW_HASH_BITS);
+        uint32_t entry;
+        while ((entry = table[h]) != 0 && (entry >> LZW_MAX_CODE_BITS) != key) {
+            h = (h + 1) & mask;
+        }
+        if (entry != 0) {
+            prefix = entry & ((1 << LZW_MAX_CODE_BITS) - 1);
+            continue;
+        }
+        lzw_put_code(self, prefix);
+        if (self->lzw_next_code < LZW_CODE_LIMIT) {
+            table[h] = (key << LZW_MAX_CODE_BITS) | self->lzw_next_code++;
+            if (self->lzw_next_code > (1 << self->lzw_code_size)) {
+                self->lzw_code_size++;
             }
+        } else {
+            lzw_clear(self);
         }
-    } else {
-        mp_get_index(&mp_type_memoryview, bufinfo->len, MP_OBJ_NEW_SMALL_INT(2 * pixel_count - 1), false);
-
-        uint16_t *pixels = bufinfo->buf;
-        int x = 0, y = 0;
-        for (int i = 0; i < blocks; i++) {
-            int block_size = MIN(BLOCK_SIZE, pixel_count);
-            pixel_count -= block_size;
-
-            *data++ = 1 + block_size;
-            *data++ = 0x80;
-            for (int j = 0; j < block_size; j++) {
-                int pixel = *pixels++;
-                if (self->byteswap) {
-                    pixel = __builtin_bswap16(pixel);
-                }
-                int red = (pixel >> 8) & 0xf8;
-                int green = (pixel >> 3) & 0xfc;
-                int blue = (pixel << 3) & 0xf8;
-
-                red = MAX(0, red - rb_bayer[x % 4][y % 4]);
-                green = MAX(0, green - g_bayer[x % 4][(y + 2) % 4]);
-                blue = MAX(0, blue - rb_bayer[(x + 2) % 4][y % 4]);
-                x++;
-                if (x == self->width) {
-                    x = 0;
-                    y++;
-                }
+        prefix = c;
+    }
+    self->lzw_prefix = prefix;
+}
+
+static void unpin_previous(void *self_in) {
+    gifio_gifwriter_t *self = self_in;
+    gc_movable_unpin(self->previous);
+}
 
-                *data++ = ((red >> 1) & 0x60) | ((green >> 3) & 0x1c) | (blue >> 6);
+void shared_module_gifio_gifwriter_add_frame(gifio_gifwriter_t *self, const mp_buffer_info_t *bufinfo, int16_t delay) {
+    int pixel_count = self->width * self->height;
+    int bytes_per_pixel = self->colorspace == DISPLAYIO_COLORSPACE_L8 ? 1 : 2;
+    mp_get_index(&mp_type_memoryview, bufinfo->len, MP_OBJ_NEW_SMALL_INT(bytes_per_pixel * pixel_count - 1), false);
+
+    // With frame differencing, convert the whole frame first to find what changed since
+    // the previous one. Only that rectangle is encoded; the rest of the previous frame
+    // stays on screen.
+    int x1 = 0, y1 = 0, x2 = self->width, y2 = self->height;
+    // Nothing below allocates, but pin the buffer so that it can't move
+    // whatever the file's write does. That write may also raise, so the
+    // buffer is unpinned by a jump callback.
+    uint8_t *previous = NULL;
+    MP_DEFINE_NLR_JUMP_CALLBACK_FUNCTION_1(ctx, unpin_previous, self);
+    if (self->previous != 0) {
+        previous = gc_movable_pin(self->previous);
+        nlr_push_jump_callback(&ctx.callback, mp_call_function_1_from_nlr_jump_callback);
+        bool first = self->frame_count == 0;
+        if (!first) {
+            x1 = self->width;
+            y1 = self->height;
+            x2 = y2 = 0;
+        }
+        for (int y = 0; y < self->height; y++) {
+            uint8_t *previous_row = previous + y * self->width;
+            convert_row(self, bufinfo, y, self->row);
+            if (first) {
+                memcpy(previous_row, self->row, self->width);
+                continue;
             }
+            int x = 0;
+            while (x < self->width && self->row[x] == previous_row[x]) {
+                x++;
+            }
+            if (x == self->width) {
+                continue;
+            }
+            int last = self->width - 1;
+            while (self->row[last] == previous_row[last]) {
+                last--;
+            }
+            memcpy(previous_row + x, self->row + x, last + 1 - x);
+            x1 = MIN(x1, x);
+            x2 = MAX(x2, last + 1);
+            y1 = MIN(y1, y);
+            y2 = y + 1;
+        }
+        if (x2 <= x1) {
+            // Nothing changed, but the frame still carries the delay.
+            x1 = y1 = 0;
+            x2 = y2 = 1;
         }
     }
+    self->frame_count++;
 
-    self->cur = data - self->data;
+    // The control block also asks for each frame to be left in place under the next one,
+    // which frame differencing relies on.
+    if (delay || previous != NULL) {
+        write_data(self, (uint8_t []) {'!', 0xF9, 0x04, 0x04}, 4);
+        write_word(self, delay);
+        write_word(self, 0); // end
+    }
 
-    write_data(self, (uint8_t []) {0x01, 0x81, 0x00}, 3); // end code
+    write_byte(self, 0x2C);
+    write_word(self, x1);
+    write_word(self, y1);
+    write_word(self, x2 - x1);
+    write_word(self, y2 - y1);
+    write_data(self, (uint8_t []) {0x00, LZW_MIN_CODE_SIZE}, 2);
+
+    self->sub_block_start = -1;
+    self->lzw_bits = 0;
+    self->lzw_bit_count = 0;
+    self->lzw_code_size = LZW_MIN_CODE_SIZE + 1;
+    self->lzw_prefix = -1;
+    lzw_clear(self);
+
+    for (int y = y1; y < y2; y++) {
+        if (previous != NULL) {
+            lzw_write(self, previous + y * self->width + x1, x2 - x1);
+        } else {
+            convert_row(self, bufinfo, y, self->row);
+            lzw_write(self, self->row, self->width);
+        }
+    }
+
+    lzw_put_code(self, self->lzw_prefix);
+    lzw_put_code(self, LZW_END_CODE);
+    if (self->lzw_bit_count > 0) {
+        lzw_put_byte(self, self->lzw_bits);
+    }
+    write_byte(self, 0x00); // block terminator
     flush_data(self);
+    if (previous != NULL) {
+        nlr_pop_jump_callback(true);
+    }
     handle_error(self);
 }
 
@@ -255,6 +405,7 @@ void shared_module_gifio_gifwriter_close(gifio_gifwriter_t *self) {
     int error = 0;
     self->file_proto->ioctl(self->file, self->own_file ? MP_STREAM_CLOSE : MP_STREAM_FLUSH, 0, &error);
     self->file = NULL;
+    shared_module_gifio_gifwriter_del(self);
 
     if (error != 0) {
         self->error = error;
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "py/gc.h"
 #include "py/obj.h"
 #include "py/stream.h"
 #include "shared-bindings/displayio/__init__.h"
@@ -19,6 +20,22 @@ typedef struct gifio_gifwriter {
     int error;
     uint8_t *data;
     size_t cur, size;
+    // Start of the LZW sub-block being filled in data, or -1.
+    int sub_block_start;
+    // LZW string table and encoder state.
+    uint32_t *lzw_table;
+    uint32_t lzw_bits;
+    int lzw_bit_count;
+    int lzw_code_size;
+    int lzw_next_code;
+    int lzw_prefix;
+    // One row of converted pixels.
+    uint8_t *row;
+    // The previous frame as color indices when frame differencing, otherwise 0.
+    // It is usually the largest buffer by far and lives as long as the writer,
+    // so the heap is allowed to move it.
+    gc_movable_t previous;
+    uint32_t frame_count;
     bool own_file;
     bool byteswap;
     bool dither;
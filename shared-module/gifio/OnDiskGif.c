@@ -42,6 +42,29 @@ static int32_t GIFSeekFile(GIFFILE *pFile, int32_t iPosition) {
     return pFile->iPos;
 } /* GIFSeekFile() */
 
+// Load the frame's colors into the palette. Only entries that actually change are touched
+// so that the palette keeps the colors it already converted for the display and doesn't
+// make displayio redraw everything that uses it.
+static void GIFLoadPalette(displayio_palette_t *palette, GIFDRAW *pDraw) {
+    uint8_t *pPal = pDraw->pPalette24;
+    for (int p = 0; p < 256; p++) {
+        uint8_t r = *pPal++;
+        uint8_t g = *pPal++;
+        uint8_t b = *pPal++;
+        uint32_t color = (r << 16) + (g << 8) + b;
+        common_hal_displayio_palette_set_color(palette, p, color);
+        // Transparency can change frame to frame
+        bool transparent = pDraw->ucHasTransparency && p == pDraw->ucTransparent;
+        if (common_hal_displayio_palette_is_transparent(palette, p) != transparent) {
+            if (transparent) {
+                common_hal_displayio_palette_make_transparent(palette, p);
+            } else {
+                common_hal_displayio_palette_make_opaque(palette, p);
+            }
+        }
+    }
+}
+
 static void GIFDraw(GIFDRAW *pDraw) {
     // Called for every scan line of the image as it decodes
     // The pixels delivered are the 8-bit native GIF output
@@ -52,20 +75,9 @@ static void GIFDraw(GIFDRAW *pDraw) {
     displayio_bitmap_t *bitmap = ondiskgif->bitmap;
     displayio_palette_t *palette = ondiskgif->palette;
 
-    // Update the palette if we have one in RGB888
-    if (palette != NULL) {
-        uint8_t *pPal = pDraw->pPalette24;
-        for (int p = 0; p < 256; p++) {
-            uint8_t r = *pPal++;
-            uint8_t g = *pPal++;
-            uint8_t b = *pPal++;
-            uint32_t color = (r << 16) + (g << 8) + b;
-            common_hal_displayio_palette_set_color(palette, p, color);
-            common_hal_displayio_palette_make_opaque(palette, p); // Transparency can change frame to frame
-        }
-        if (pDraw->ucHasTransparency) {
-            common_hal_displayio_palette_make_transparent(palette, pDraw->ucTransparent);
-        }
+    // Update the palette if we have one in RGB888. It is the same for every line of a frame.
+    if (palette != NULL && pDraw->y == 0) {
+        GIFLoadPalette(palette, pDraw);
     }
 
     int iWidth = pDraw->iWidth;
@@ -77,6 +89,15 @@ static void GIFDraw(GIFDRAW *pDraw) {
         return;
     }
 
+    // Grow the area this frame touched by this line.
+    displayio_area_t line = {
+        .x1 = pDraw->iX,
+        .y1 = pDraw->iY + pDraw->y,
+        .x2 = pDraw->iX + iWidth,
+        .y2 = pDraw->iY + pDraw->y + 1,
+    };
+    displayio_area_union(&ondiskgif->frame_area, &line, &ondiskgif->frame_area);
+
     int32_t row_start = (pDraw->y + pDraw->iY) * bitmap->stride;
     uint32_t *row = bitmap->data + row_start;
 
@@ -129,6 +150,8 @@ static void GIFDraw(GIFDRAW *pDraw) {
 
 void common_hal_gifio_ondiskgif_construct(gifio_ondiskgif_t *self, pyb_file_obj_t *file, bool use_palette) {
     self->file = file;
+    // The decoder seeks back to the first frame every loop.
+    fat_file_enable_fast_seek(file);
 
     if (use_palette == true) {
         GIF_begin(&self->gif, GIF_PALETTE_RGB888);
@@ -230,17 +253,12 @@ int32_t common_hal_gifio_ondiskgif_get_max_delay(gifio_ondiskgif_t *self) {
 uint32_t common_hal_gifio_ondiskgif_next_frame(gifio_ondiskgif_t *self, bool setDirty) {
     int nextDelay = 0;
     int result = 0;
+    self->frame_area = (displayio_area_t) { 0 };
     result = GIF_playFrame(&self->gif, &nextDelay, self);
 
-    if ((result >= 0) && (setDirty)) {
-        displayio_area_t dirty_area = {
-            .x1 = 0,
-            .y1 = 0,
-            .x2 = self->bitmap->width,
-            .y2 = self->bitmap->height,
-        };
-
-        displayio_bitmap_set_dirty_area(self->bitmap, &dirty_area);
+    // Only the part of the bitmap covered by this frame's own bounds has changed.
+    if ((result >= 0) && (setDirty) && !displayio_area_empty(&self->frame_area)) {
+        displayio_bitmap_set_dirty_area(self->bitmap, &self->frame_area);
     }
 
     return nextDelay;
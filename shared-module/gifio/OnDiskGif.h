@@ -14,6 +14,7 @@
 #include "lib/AnimatedGIF/AnimatedGIF_circuitpy.h"
 #include "shared-module/displayio/Bitmap.h"
 #include "shared-module/displayio/Palette.h"
+#include "shared-module/displayio/area.h"
 
 #include "extmod/vfs_fat.h"
 
@@ -23,6 +24,8 @@ typedef struct {
     pyb_file_obj_t *file;
     displayio_bitmap_t *bitmap;
     displayio_palette_t *palette;
+    // The part of the bitmap drawn by the frame being decoded.
+    displayio_area_t frame_area;
     int32_t duration;
     int32_t frame_count;
     int32_t min_delay;
@@ -7,12 +7,19 @@
 #pragma once
 
 #include "mbedtls/sha1.h"
+#include "mbedtls/sha256.h"
 
 typedef struct {
     mp_obj_base_t base;
     union {
         mbedtls_sha1_context sha1;
+        mbedtls_sha256_context sha256;
     };
     // Of MBEDTLS_SSL_HASH_*
     uint8_t hash_type;
 } hashlib_hash_obj_t;
+
+// Ports with a hash engine override this to process large updates in hardware. The engine
+// must continue from the state in the mbedtls context and store its state back there, so
+// that software can carry on with the next update. Return false to use mbedtls instead.
+bool hashlib_hash_port_update(hashlib_hash_obj_t *self, const uint8_t *data, size_t datalen);
@@ -25,6 +25,9 @@ void common_hal_is31fl3741_IS31FL3741_construct(is31fl3741_IS31FL3741_obj_t *sel
 
     self->i2c = i2c;
     self->device_address = addr;
+    // Nothing is known about the PWM values until they are written or reset.
+    memset(self->pwm_known, 0, sizeof(self->pwm_known));
+    memset(self->pwm_dirty, 0, sizeof(self->pwm_dirty));
 }
 
 void common_hal_is31fl3741_IS31FL3741_deinit(is31fl3741_IS31FL3741_obj_t *self) {
@@ -38,18 +41,87 @@ void common_hal_is31fl3741_IS31FL3741_deinit(is31fl3741_IS31FL3741_obj_t *self)
     self->base.type = NULL;
 }
 
+// Records a PWM value for common_hal_is31fl3741_flush() to send if the chip doesn't have it.
+static void stage_led(is31fl3741_IS31FL3741_obj_t *self, uint16_t led, uint8_t level) {
+    if (led >= IS31FL3741_LED_COUNT) {
+        return;
+    }
+    uint8_t bit = 1 << (led % 8);
+    if ((self->pwm_known[led / 8] & bit) && self->pwm[led] == level) {
+        return;
+    }
+    self->pwm[led] = level;
+    self->pwm_known[led / 8] |= bit;
+    self->pwm_dirty[led / 8] |= bit;
+}
+
+static bool led_dirty(is31fl3741_IS31FL3741_obj_t *self, uint16_t led) {
+    return self->pwm_dirty[led / 8] & (1 << (led % 8));
+}
+
+// Unchanged registers between two changed runs are resent, rather than starting another
+// write, when that's no more bytes than the extra address and register bytes.
+#define MAX_RUN_GAP (2)
+
+void common_hal_is31fl3741_flush(is31fl3741_IS31FL3741_obj_t *self) {
+    uint8_t buf[IS31FL3741_PWM_PAGE_SIZE + 1];
+    for (uint8_t page = 0; page < 2; page++) {
+        uint16_t first = page * IS31FL3741_PWM_PAGE_SIZE;
+        uint16_t end = MIN(first + IS31FL3741_PWM_PAGE_SIZE, IS31FL3741_LED_COUNT);
+        uint16_t changed = 0;
+        for (uint16_t led = first; led < end; led++) {
+            changed += led_dirty(self, led);
+        }
+        if (changed == 0) {
+            continue;
+        }
+        common_hal_is31fl3741_set_page(self, page);
+        // With this much changed one write of the page is quickest, providing every value
+        // is known.
+        bool whole_page = changed > (end - first) / 2;
+        for (uint16_t led = first; whole_page && led < end; led++) {
+            whole_page = self->pwm_known[led / 8] & (1 << (led % 8));
+        }
+        uint16_t led = first;
+        while (led < end) {
+            if (!whole_page && !led_dirty(self, led)) {
+                led++;
+                continue;
+            }
+            uint16_t run_end = led + 1;
+            if (whole_page) {
+                run_end = end;
+            } else {
+                for (uint16_t next = run_end; next < end && next <= run_end + MAX_RUN_GAP; next++) {
+                    if (led_dirty(self, next)) {
+                        run_end = next + 1;
+                    }
+                }
+            }
+            buf[0] = led - first;
+            memcpy(buf + 1, self->pwm + led, run_end - led);
+            common_hal_busio_i2c_write(self->i2c, self->device_address, buf, run_end - led + 1);
+            led = run_end;
+        }
+        for (uint16_t i = first; i < end; i++) {
+            self->pwm_dirty[i / 8] &= ~(1 << (i % 8));
+        }
+    }
+}
+
 void common_hal_is31fl3741_write(is31fl3741_IS31FL3741_obj_t *is31, const mp_obj_t *mapping, const uint8_t *pixels, size_t numBytes) {
     common_hal_is31fl3741_begin_transaction(is31);
 
     for (size_t i = 0; i < numBytes; i += 3) {
         uint16_t ridx = mp_obj_get_int(mapping[i]);
         if (ridx != 65535) {
-            common_hal_is31fl3741_set_led(is31, ridx, IS31GammaTable[pixels[i]], 0); // red
-            common_hal_is31fl3741_set_led(is31, mp_obj_get_int(mapping[i + 1]), IS31GammaTable[pixels[i + 1]], 0); // green
-            common_hal_is31fl3741_set_led(is31, mp_obj_get_int(mapping[i + 2]), IS31GammaTable[pixels[i + 2]], 0); // blue
+            stage_led(is31, ridx, IS31GammaTable[pixels[i]]); // red
+            stage_led(is31, mp_obj_get_int(mapping[i + 1]), IS31GammaTable[pixels[i + 1]]); // green
+            stage_led(is31, mp_obj_get_int(mapping[i + 2]), IS31GammaTable[pixels[i + 2]]); // blue
         }
     }
 
+    common_hal_is31fl3741_flush(is31);
     common_hal_is31fl3741_end_transaction(is31);
 }
 
@@ -96,6 +168,10 @@ void common_hal_is31fl3741_send_reset(is31fl3741_IS31FL3741_obj_t *self) {
     common_hal_is31fl3741_set_page(self, 4);
     uint8_t rst[2] = { 0x3F, 0xAE }; // reset command
     common_hal_busio_i2c_write(self->i2c, self->device_address, rst, 2);
+    // The reset clears every PWM value.
+    memset(self->pwm, 0, sizeof(self->pwm));
+    memset(self->pwm_known, 0xff, sizeof(self->pwm_known));
+    memset(self->pwm_dirty, 0, sizeof(self->pwm_dirty));
 }
 
 void common_hal_is31fl3741_set_current(is31fl3741_IS31FL3741_obj_t *self, uint8_t current) {
@@ -126,6 +202,12 @@ void common_hal_is31fl3741_set_led(is31fl3741_IS31FL3741_obj_t *self, uint16_t l
     cmd[1] = level;
 
     common_hal_busio_i2c_write(self->i2c, self->device_address, cmd, 2);
+
+    if (page == 0 && led < IS31FL3741_LED_COUNT) {
+        self->pwm[led] = level;
+        self->pwm_known[led / 8] |= 1 << (led % 8);
+        self->pwm_dirty[led / 8] &= ~(1 << (led % 8));
+    }
 }
 
 void common_hal_is31fl3741_draw_pixel(is31fl3741_IS31FL3741_obj_t *self, int16_t x, int16_t y, uint32_t color, uint16_t *mapping, uint8_t display_height) {
@@ -139,8 +221,8 @@ void common_hal_is31fl3741_draw_pixel(is31fl3741_IS31FL3741_obj_t *self, int16_t
         uint16_t gidx = mapping[x1 + 1];
         uint16_t bidx = mapping[x1 + 0];
 
-        common_hal_is31fl3741_set_led(self, ridx, r, 0);
-        common_hal_is31fl3741_set_led(self, gidx, g, 0);
-        common_hal_is31fl3741_set_led(self, bidx, b, 0);
+        stage_led(self, ridx, r);
+        stage_led(self, gidx, g);
+        stage_led(self, bidx, b);
     }
 }
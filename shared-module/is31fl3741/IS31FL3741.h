@@ -10,12 +10,22 @@
 #include "lib/protomatter/src/core.h"
 #include "shared-bindings/busio/I2C.h"
 
+// PWM values are on page 0 for LEDs 0 to 179 and page 1 for the rest.
+#define IS31FL3741_PWM_PAGE_SIZE (180)
+#define IS31FL3741_LED_COUNT (351)
+
 extern const mp_obj_type_t is31fl3741_is31fl3741_type;
 typedef struct {
     mp_obj_base_t base;
     busio_i2c_obj_t *i2c;
     busio_i2c_obj_t inline_i2c;
     uint8_t device_address;
+    // The PWM values last sent or waiting to be sent by
+    // common_hal_is31fl3741_flush(), a bit per LED for whether the chip's value
+    // is known and another for whether it still needs sending.
+    uint8_t pwm[IS31FL3741_LED_COUNT];
+    uint8_t pwm_known[(IS31FL3741_LED_COUNT + 7) / 8];
+    uint8_t pwm_dirty[(IS31FL3741_LED_COUNT + 7) / 8];
 } is31fl3741_IS31FL3741_obj_t;
 
 // Gamma correction table
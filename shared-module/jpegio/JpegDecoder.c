@@ -9,6 +9,9 @@
 #include "shared-bindings/jpegio/JpegDecoder.h"
 #include "shared-bindings/bitmaptools/__init__.h"
 #include "shared-module/jpegio/JpegDecoder.h"
+#if CIRCUITPY_BUSDISPLAY
+#include "shared-bindings/busdisplay/BusDisplay.h"
+#endif
 
 typedef size_t (*input_func)(JDEC *jd, uint8_t *dest, size_t len);
 
@@ -102,6 +105,7 @@ static size_t file_input(JDEC *jd, uint8_t *dest, size_t len) {
 
 mp_obj_t common_hal_jpegio_jpegdecoder_set_source_file(jpegio_jpegdecoder_obj_t *self, mp_obj_t file_obj) {
     self->data_obj = file_obj;
+    self->source_is_buffer = false;
     return common_hal_jpegio_jpegdecoder_decode_common(self, file_input);
 }
 
@@ -119,26 +123,24 @@ static size_t buffer_input(JDEC *jd, uint8_t *dest, size_t len) {
 
 mp_obj_t common_hal_jpegio_jpegdecoder_set_source_buffer(jpegio_jpegdecoder_obj_t *self, mp_obj_t buffer_obj) {
     self->data_obj = buffer_obj;
+    self->source_is_buffer = true;
     mp_get_buffer_raise(buffer_obj, &self->bufinfo, MP_BUFFER_READ);
     return common_hal_jpegio_jpegdecoder_decode_common(self, buffer_input);
 }
 
 #define DECODER_CONTINUE (1)
 #define DECODER_INTERRUPT (0)
-static int bitmap_output(JDEC *jd, void *data, JRECT *rect) {
-    jpegio_jpegdecoder_obj_t *self = CONTAINER_OF(jd, jpegio_jpegdecoder_obj_t, decoder);
-    int src_width = rect->right - rect->left + 1, src_pixel_stride = src_width /* in units of pixels! */, src_height = rect->bottom - rect->top + 1;
+// The part of one decoded block that lands in the destination.
+typedef struct {
+    int x, y;
+    int x1, y1, x2, y2;
+} output_rect_t;
 
-    displayio_bitmap_t src = {
-        .width = src_width,
-        .height = src_height,
-        .data = data,
-        .stride = src_pixel_stride / 2, /* in units of uint32_t */
-        .bits_per_value = 16,
-        .x_shift = 1,
-        .x_mask = 1,
-        .bitmask = 0xffff,
-    };
+// Clip the decoded block `rect` against the requested source limits. Returns
+// DECODER_INTERRUPT if no later block can be in range either, otherwise
+// DECODER_CONTINUE with a possibly empty rectangle in `out`.
+static int clip_output(jpegio_jpegdecoder_obj_t *self, JRECT *rect, output_rect_t *out) {
+    int src_width = rect->right - rect->left + 1, src_height = rect->bottom - rect->top + 1;
 
     int x = self->x;
     int y = self->y;
@@ -157,6 +159,7 @@ static int bitmap_output(JDEC *jd, void *data, JRECT *rect) {
     if (x2 < x1) {
         // The last column in the source image to copy FROM is left of this, so
         // no more pixels on this row but could be on subsequent rows
+        *out = (output_rect_t) { 0 };
         return DECODER_CONTINUE;
     }
     x2 = MIN(x2, src_width);
@@ -174,15 +177,84 @@ static int bitmap_output(JDEC *jd, void *data, JRECT *rect) {
         y1 = 0;
     }
 
-    // blit takes care of x, y out of range
     assert(x1 >= 0);
     assert(y1 >= 0);
-    // blit takes care of x1 >= x2 and y1 >= y2 cases
     assert(x2 <= src_width);
     assert(y2 <= src_height);
 
-    common_hal_bitmaptools_blit(self->dest, &src, x, y, x1, y1, x2, y2, self->skip_source_index, self->skip_source_index_none, self->skip_dest_index, self->skip_dest_index_none);
-    return 1;
+    *out = (output_rect_t) { .x = x, .y = y, .x1 = x1, .y1 = y1, .x2 = x2, .y2 = y2 };
+    return DECODER_CONTINUE;
+}
+
+static int bitmap_output(JDEC *jd, void *data, JRECT *rect) {
+    jpegio_jpegdecoder_obj_t *self = CONTAINER_OF(jd, jpegio_jpegdecoder_obj_t, decoder);
+    int src_width = rect->right - rect->left + 1, src_pixel_stride = src_width /* in units of pixels! */, src_height = rect->bottom - rect->top + 1;
+
+    displayio_bitmap_t src = {
+        .width = src_width,
+        .height = src_height,
+        .data = data,
+        .stride = src_pixel_stride / 2, /* in units of uint32_t */
+        .bits_per_value = 16,
+        .x_shift = 1,
+        .x_mask = 1,
+        .bitmask = 0xffff,
+    };
+
+    output_rect_t out;
+    int result = clip_output(self, rect, &out);
+    if (result == DECODER_INTERRUPT || out.x1 >= out.x2 || out.y1 >= out.y2) {
+        return result;
+    }
+
+    // blit takes care of x, y out of range
+    common_hal_bitmaptools_blit(self->dest, &src, out.x, out.y, out.x1, out.y1, out.x2, out.y2, self->skip_source_index, self->skip_source_index_none, self->skip_dest_index, self->skip_dest_index_none);
+    return DECODER_CONTINUE;
+}
+
+#if CIRCUITPY_BUSDISPLAY
+static int display_output(JDEC *jd, void *data, JRECT *rect) {
+    jpegio_jpegdecoder_obj_t *self = CONTAINER_OF(jd, jpegio_jpegdecoder_obj_t, decoder);
+    int src_width = rect->right - rect->left + 1;
+
+    output_rect_t out;
+    int result = clip_output(self, rect, &out);
+    if (result == DECODER_INTERRUPT || out.x1 >= out.x2 || out.y1 >= out.y2) {
+        return result;
+    }
+
+    const uint16_t *pixels = (const uint16_t *)data + out.y1 * src_width + out.x1;
+    if (!busdisplay_busdisplay_write_rgb565(self->display_dest, out.x, out.y,
+        out.x2 - out.x1, out.y2 - out.y1, pixels, src_width)) {
+        self->display_bus_busy = true;
+        return DECODER_INTERRUPT;
+    }
+    return DECODER_CONTINUE;
+}
+#endif
+
+// Tell TJpgDec which part of the image can reach the destination so that it can skip
+// decoding the rest. Returns false if nothing can be output at all.
+static bool set_roi(jpegio_jpegdecoder_obj_t *self, int scale, int dest_width, int dest_height) {
+    int x2 = MIN(self->lim.x2, self->lim.x1 + dest_width - self->x);
+    int y2 = MIN(self->lim.y2, self->lim.y1 + dest_height - self->y);
+    if (x2 <= self->lim.x1 || y2 <= self->lim.y1) {
+        return false;
+    }
+    // The limits are in scaled pixels and the ROI is in image pixels.
+    int last_x = self->decoder.width - 1, last_y = self->decoder.height - 1;
+    self->decoder.roi.left = MIN(self->lim.x1 << scale, last_x);
+    self->decoder.roi.right = MIN((x2 << scale) - 1, last_x);
+    self->decoder.roi.top = MIN(self->lim.y1 << scale, last_y);
+    self->decoder.roi.bottom = MIN((y2 << scale) - 1, last_y);
+    return true;
+}
+
+// Ports with a hardware JPEG codec or an accelerated decoder override this. The decode
+// parameters are already stored in self, and data/len is the whole JPEG image. Return true
+// if the image was decoded into self->dest, or false to fall back to TJpgDec.
+MP_WEAK bool jpegio_jpegdecoder_port_decode(jpegio_jpegdecoder_obj_t *self, const uint8_t *data, size_t len) {
+    return false;
 }
 
 void common_hal_jpegio_jpegdecoder_decode_into(
@@ -204,9 +276,59 @@ void common_hal_jpegio_jpegdecoder_decode_into(
     self->skip_dest_index_none = skip_dest_index_none;
 
     self->dest = bitmap;
+    self->scale = scale;
+
+    // Only an in-memory image can be handed to the port in one piece.
+    if (self->source_is_buffer) {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(self->data_obj, &bufinfo, MP_BUFFER_READ);
+        if (jpegio_jpegdecoder_port_decode(self, bufinfo.buf, bufinfo.len)) {
+            common_hal_jpegio_jpegdecoder_close(self);
+            return;
+        }
+    }
+
+    if (!set_roi(self, scale, bitmap->width, bitmap->height)) {
+        common_hal_jpegio_jpegdecoder_close(self);
+        return;
+    }
     JRESULT result = jd_decomp(&self->decoder, bitmap_output, scale);
     common_hal_jpegio_jpegdecoder_close(self);
     if (result != JDR_INTR) {
         check_jresult(result);
     }
 }
+
+#if CIRCUITPY_BUSDISPLAY
+void common_hal_jpegio_jpegdecoder_decode_to_display(
+    jpegio_jpegdecoder_obj_t *self,
+    busdisplay_busdisplay_obj_t *display, int scale, int16_t x, int16_t y,
+    bitmaptools_rect_t *lim) {
+    if (self->data_obj == MP_OBJ_NULL) {
+        mp_raise_RuntimeError_varg(MP_ERROR_TEXT("%q() without %q()"), MP_QSTR_decode, MP_QSTR_open);
+    }
+
+    self->x = x;
+    self->y = y;
+    self->lim = *lim;
+
+    // Each block is sent to the display as soon as it is decoded, so no frame-sized
+    // buffer is needed.
+    if (!set_roi(self, scale, common_hal_busdisplay_busdisplay_get_width(display),
+        common_hal_busdisplay_busdisplay_get_height(display))) {
+        common_hal_jpegio_jpegdecoder_close(self);
+        return;
+    }
+    self->display_dest = display;
+    self->display_bus_busy = false;
+    JRESULT result = jd_decomp(&self->decoder, display_output, scale);
+    common_hal_jpegio_jpegdecoder_close(self);
+    self->display_dest = NULL;
+    if (self->display_bus_busy) {
+        mp_raise_RuntimeError_varg(MP_ERROR_TEXT("%q in use"), MP_QSTR_bus);
+    }
+    if (result != JDR_INTR) {
+        check_jresult(result);
+    }
+}
+#endif
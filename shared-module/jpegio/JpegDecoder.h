@@ -9,6 +9,9 @@
 #include "py/obj.h"
 #include "lib/tjpgd/src/tjpgd.h"
 #include "shared-module/displayio/Bitmap.h"
+#if CIRCUITPY_BUSDISPLAY
+#include "shared-module/busdisplay/BusDisplay.h"
+#endif
 
 #define TJPGD_WORKSPACE_SIZE 3500
 
@@ -24,4 +27,11 @@ typedef struct jpegio_jpegdecoder_obj {
     uint32_t skip_source_index, skip_dest_index;
     bool skip_source_index_none, skip_dest_index_none;
     uint8_t scale;
+    bool source_is_buffer;
+    #if CIRCUITPY_BUSDISPLAY
+    busdisplay_busdisplay_obj_t *display_dest;
+    bool display_bus_busy;
+    #endif
 } jpegio_jpegdecoder_obj_t;
+
+bool jpegio_jpegdecoder_port_decode(jpegio_jpegdecoder_obj_t *self, const uint8_t *data, size_t len);
@@ -13,36 +13,75 @@
 #define EVENT_PRESSED (1 << 15)
 #define EVENT_KEY_NUM_MASK ((1 << 15) - 1)
 
+// Each queued event is the 16-bit encoded key and state followed by a 32-bit
+// supervisor_ticks_ms32() timestamp, so nothing on the heap is referenced.
+#define EVENT_SIZE (sizeof(uint16_t) + sizeof(uint32_t))
+
 void common_hal_keypad_eventqueue_construct(keypad_eventqueue_obj_t *self, size_t max_events) {
-    // Event queue is 16-bit values.
-    ringbuf_alloc(&self->encoded_events, max_events * (sizeof(uint16_t) + sizeof(mp_obj_t)));
+    ringbuf_alloc(&self->encoded_events, max_events * EVENT_SIZE);
     self->overflowed = false;
     self->event_handler = NULL;
 }
 
-bool common_hal_keypad_eventqueue_get_into(keypad_eventqueue_obj_t *self, keypad_event_obj_t *event) {
+// Convert a supervisor_ticks_ms32() value to what supervisor.ticks_ms() returned at the time.
+static mp_int_t eventqueue_ticks_ms(uint32_t ticks) {
+    return (ticks + 0x1fff0000) % (1 << 29);
+}
+
+static bool eventqueue_get_raw(keypad_eventqueue_obj_t *self, mp_uint_t *key_number, bool *pressed, uint32_t *ticks) {
     int encoded_event = ringbuf_get16(&self->encoded_events);
     if (encoded_event == -1) {
         return false;
     }
+    ringbuf_get_n(&self->encoded_events, (uint8_t *)ticks, sizeof(*ticks));
+    *key_number = encoded_event & EVENT_KEY_NUM_MASK;
+    *pressed = encoded_event & EVENT_PRESSED;
+    return true;
+}
 
-    mp_obj_t ticks;
-    ringbuf_get_n(&self->encoded_events, (uint8_t *)&ticks, sizeof(ticks));
+bool common_hal_keypad_eventqueue_get_into(keypad_eventqueue_obj_t *self, keypad_event_obj_t *event) {
+    mp_uint_t key_number;
+    bool pressed;
+    uint32_t ticks;
+    if (!eventqueue_get_raw(self, &key_number, &pressed, &ticks)) {
+        return false;
+    }
     // "Construct" using the existing event.
-    common_hal_keypad_event_construct(event, encoded_event & EVENT_KEY_NUM_MASK, encoded_event & EVENT_PRESSED, ticks);
+    common_hal_keypad_event_construct(event, key_number, pressed, MP_OBJ_NEW_SMALL_INT(eventqueue_ticks_ms(ticks)));
     return true;
 }
 
 mp_obj_t common_hal_keypad_eventqueue_get(keypad_eventqueue_obj_t *self) {
+    // Only allocate when there is an event to return.
+    if (common_hal_keypad_eventqueue_get_length(self) == 0) {
+        return MP_ROM_NONE;
+    }
     keypad_event_obj_t *event = mp_obj_malloc(keypad_event_obj_t, &keypad_event_type);
-    bool result = common_hal_keypad_eventqueue_get_into(self, event);
-    if (result) {
+    if (common_hal_keypad_eventqueue_get_into(self, event)) {
         return event;
     }
     m_free(event);
     return MP_ROM_NONE;
 }
 
+size_t common_hal_keypad_eventqueue_get_many(keypad_eventqueue_obj_t *self, uint32_t *buffer, size_t max_events) {
+    size_t count = 0;
+    while (count < max_events) {
+        mp_uint_t key_number;
+        bool pressed;
+        uint32_t ticks;
+        if (!eventqueue_get_raw(self, &key_number, &pressed, &ticks)) {
+            break;
+        }
+        buffer[0] = key_number;
+        buffer[1] = pressed;
+        buffer[2] = eventqueue_ticks_ms(ticks);
+        buffer += 3;
+        count++;
+    }
+    return count;
+}
+
 bool common_hal_keypad_eventqueue_get_overflowed(keypad_eventqueue_obj_t *self) {
     return self->overflowed;
 }
@@ -57,15 +96,15 @@ void common_hal_keypad_eventqueue_clear(keypad_eventqueue_obj_t *self) {
 }
 
 size_t common_hal_keypad_eventqueue_get_length(keypad_eventqueue_obj_t *self) {
-    return ringbuf_num_filled(&self->encoded_events);
+    return ringbuf_num_filled(&self->encoded_events) / EVENT_SIZE;
 }
 
 void common_hal_keypad_eventqueue_set_event_handler(keypad_eventqueue_obj_t *self, void (*event_handler)(keypad_eventqueue_obj_t *)) {
     self->event_handler = event_handler;
 }
 
-bool keypad_eventqueue_record(keypad_eventqueue_obj_t *self, mp_uint_t key_number, bool pressed, mp_obj_t timestamp) {
-    if (ringbuf_num_empty(&self->encoded_events) == 0) {
+bool keypad_eventqueue_record(keypad_eventqueue_obj_t *self, mp_uint_t key_number, bool pressed, uint32_t timestamp) {
+    if (ringbuf_num_empty(&self->encoded_events) < EVENT_SIZE) {
         // Queue is full. Set the overflow flag. The caller will decide what else to do.
         common_hal_keypad_eventqueue_set_overflowed(self, true);
         return false;
@@ -76,7 +115,7 @@ bool keypad_eventqueue_record(keypad_eventqueue_obj_t *self, mp_uint_t key_numbe
         encoded_event |= EVENT_PRESSED;
     }
     ringbuf_put16(&self->encoded_events, encoded_event);
-    ringbuf_put_n(&self->encoded_events, (uint8_t *)&timestamp, sizeof(mp_obj_t));
+    ringbuf_put_n(&self->encoded_events, (uint8_t *)&timestamp, sizeof(timestamp));
 
     if (self->event_handler) {
         self->event_handler(self);
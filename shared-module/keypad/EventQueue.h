@@ -18,4 +18,5 @@ struct _keypad_eventqueue_obj_t {
     void (*event_handler)(keypad_eventqueue_obj_t *);
 };
 
-bool keypad_eventqueue_record(keypad_eventqueue_obj_t *self, mp_uint_t key_number, bool pressed, mp_obj_t timestamp);
+// timestamp is a supervisor_ticks_ms32() value. Safe to call from interrupt context.
+bool keypad_eventqueue_record(keypad_eventqueue_obj_t *self, mp_uint_t key_number, bool pressed, uint32_t timestamp);
@@ -17,7 +17,7 @@
 #include "supervisor/port.h"
 #include "supervisor/shared/tick.h"
 
-static void keymatrix_scan_now(void *self_in, mp_obj_t timestamp);
+static void keymatrix_scan_now(void *self_in, uint32_t timestamp);
 static size_t keymatrix_get_key_count(void *self_in);
 
 static keypad_scanner_funcs_t keymatrix_funcs = {
@@ -29,6 +29,31 @@ static mp_uint_t row_column_to_key_number(keypad_keymatrix_obj_t *self, mp_uint_
     return row * self->column_digitalinouts->len + column;
 }
 
+static void keymatrix_setup_column_port(keypad_keymatrix_obj_t *self) {
+    self->column_port = NULL;
+    self->column_masks = NULL;
+    if (!common_hal_digitalio_has_reg_op(DIGITALINOUT_REG_READ)) {
+        return;
+    }
+
+    const size_t num_columns = self->column_digitalinouts->len;
+    uint32_t *masks = m_new(uint32_t, num_columns);
+    volatile uint32_t *port = NULL;
+    for (size_t column = 0; column < num_columns; column++) {
+        volatile uint32_t *column_port = common_hal_digitalio_digitalinout_get_reg(
+            self->column_digitalinouts->items[column], DIGITALINOUT_REG_READ, &masks[column]);
+        if (column_port == NULL || (port != NULL && column_port != port)) {
+            // Columns are spread over more than one port, or one of them
+            // can't be read directly: use the digitalio path.
+            m_del(uint32_t, masks, num_columns);
+            return;
+        }
+        port = column_port;
+    }
+    self->column_port = port;
+    self->column_masks = masks;
+}
+
 void common_hal_keypad_keymatrix_construct(keypad_keymatrix_obj_t *self, mp_uint_t num_row_pins, const mcu_pin_obj_t *row_pins[], mp_uint_t num_column_pins, const mcu_pin_obj_t *column_pins[], bool columns_to_anodes, mp_float_t interval, size_t max_events, uint8_t debounce_threshold) {
 
     mp_obj_t row_dios[num_row_pins];
@@ -51,6 +76,7 @@ void common_hal_keypad_keymatrix_construct(keypad_keymatrix_obj_t *self, mp_uint
         column_dios[column] = dio;
     }
     self->column_digitalinouts = mp_obj_new_tuple(num_column_pins, column_dios);
+    keymatrix_setup_column_port(self);
 
     self->columns_to_anodes = columns_to_anodes;
     self->funcs = &keymatrix_funcs;
@@ -75,6 +101,8 @@ void common_hal_keypad_keymatrix_deinit(keypad_keymatrix_obj_t *self) {
         common_hal_digitalio_digitalinout_deinit(self->column_digitalinouts->items[column]);
     }
     self->column_digitalinouts = MP_ROM_NONE;
+    self->column_port = NULL;
+    self->column_masks = NULL;
     common_hal_keypad_deinit_core(self);
 }
 
@@ -101,7 +129,7 @@ static size_t keymatrix_get_key_count(void *self_in) {
     return common_hal_keypad_keymatrix_get_column_count(self) * common_hal_keypad_keymatrix_get_row_count(self);
 }
 
-static void keymatrix_scan_now(void *self_in, mp_obj_t timestamp) {
+static void keymatrix_scan_now(void *self_in, uint32_t timestamp) {
     keypad_keymatrix_obj_t *self = self_in;
 
     // On entry, all pins are set to inputs with a pull-up or pull-down,
@@ -113,15 +141,19 @@ static void keymatrix_scan_now(void *self_in, mp_obj_t timestamp) {
         common_hal_digitalio_digitalinout_switch_to_output(
             row_dio, !self->columns_to_anodes, DRIVE_MODE_PUSH_PULL);
 
+        // Sample all the columns at once if they share an input register.
+        const uint32_t port_value = self->column_port != NULL ? *self->column_port : 0;
+
         for (size_t column = 0; column < common_hal_keypad_keymatrix_get_column_count(self); column++) {
             mp_uint_t key_number = row_column_to_key_number(self, row, column);
 
             // Get the current state, by reading whether the column got pulled to the row value or not.
             // If low and columns_to_anodes is true, the key is pressed.
             // If high and columns_to_anodes is false, the key is pressed.
-            const bool current =
-                common_hal_digitalio_digitalinout_get_value(self->column_digitalinouts->items[column]) !=
-                self->columns_to_anodes;
+            const bool level = self->column_port != NULL
+                ? (port_value & self->column_masks[column]) != 0
+                : common_hal_digitalio_digitalinout_get_value(self->column_digitalinouts->items[column]);
+            const bool current = level != self->columns_to_anodes;
 
             // Record any transitions.
             if (keypad_debounce((keypad_scanner_obj_t *)self, key_number, current)) {
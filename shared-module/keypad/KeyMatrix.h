@@ -17,6 +17,11 @@ typedef struct {
     KEYPAD_SCANNER_COMMON_FIELDS;
     mp_obj_tuple_t *row_digitalinouts;
     mp_obj_tuple_t *column_digitalinouts;
+    // When every column pin can be read from the same GPIO input register,
+    // a row is sampled with a single register read instead of one
+    // digitalio call per column. NULL otherwise.
+    volatile uint32_t *column_port;
+    uint32_t *column_masks;
     bool columns_to_anodes;
 } keypad_keymatrix_obj_t;
 
@@ -19,12 +19,27 @@ supervisor_lock_t keypad_scanners_linked_list_lock;
 static void keypad_scan_now(keypad_scanner_obj_t *self, uint64_t now);
 static void keypad_scan_maybe(keypad_scanner_obj_t *self, uint64_t now);
 
-void keypad_tick(void) {
-    // Fast path. Return immediately there are no scanners.
-    if (!MP_STATE_VM(keypad_scanners_linked_list)) {
+// Scanning is driven by one deadline at the soonest scan any scanner needs.
+static supervisor_deadline_t keypad_deadline;
+
+static void keypad_deadline_due(void *unused);
+
+// Must be called with keypad_scanners_linked_list_lock held.
+static void keypad_schedule_next_scan(void) {
+    keypad_scanner_obj_t *scanner = MP_STATE_VM(keypad_scanners_linked_list);
+    if (scanner == NULL) {
+        supervisor_deadline_cancel(&keypad_deadline);
         return;
     }
+    uint64_t next_scan_ticks = scanner->next_scan_ticks;
+    for (scanner = scanner->next; scanner != NULL; scanner = scanner->next) {
+        next_scan_ticks = MIN(next_scan_ticks, scanner->next_scan_ticks);
+    }
+    supervisor_deadline_schedule(&keypad_deadline, next_scan_ticks, keypad_deadline_due, NULL);
+}
 
+// Called from interrupt context when a scan is due.
+static void keypad_deadline_due(void *unused) {
     // Skip scanning if someone else has the lock. Don't wait for the lock.
     if (supervisor_try_lock(&keypad_scanners_linked_list_lock)) {
         uint64_t now = port_get_raw_ticks(NULL);
@@ -33,7 +48,11 @@ void keypad_tick(void) {
             keypad_scan_maybe(scanner, now);
             scanner = ((keypad_scanner_obj_t *)scanner)->next;
         }
+        keypad_schedule_next_scan();
         supervisor_release_lock(&keypad_scanners_linked_list_lock);
+    } else {
+        // Try again on the next tick.
+        supervisor_deadline_schedule(&keypad_deadline, port_get_raw_ticks(NULL) + 1, keypad_deadline_due, NULL);
     }
 }
 
@@ -54,17 +73,12 @@ void keypad_register_scanner(keypad_scanner_obj_t *scanner) {
     supervisor_acquire_lock(&keypad_scanners_linked_list_lock);
     scanner->next = MP_STATE_VM(keypad_scanners_linked_list);
     MP_STATE_VM(keypad_scanners_linked_list) = scanner;
+    keypad_schedule_next_scan();
     supervisor_release_lock(&keypad_scanners_linked_list_lock);
-
-    // One more request for ticks.
-    supervisor_enable_tick();
 }
 
 // Remove scanner from the list of active scanners.
 void keypad_deregister_scanner(keypad_scanner_obj_t *scanner) {
-    // One less request for ticks.
-    supervisor_disable_tick();
-
     supervisor_acquire_lock(&keypad_scanners_linked_list_lock);
     if (MP_STATE_VM(keypad_scanners_linked_list) == scanner) {
         // Scanner is at the front; splice it out.
@@ -82,6 +96,7 @@ void keypad_deregister_scanner(keypad_scanner_obj_t *scanner) {
             current = current->next;
         }
     }
+    keypad_schedule_next_scan();
     supervisor_release_lock(&keypad_scanners_linked_list_lock);
 }
 
@@ -99,14 +114,15 @@ void keypad_construct_common(keypad_scanner_obj_t *self, mp_float_t interval, si
 
     self->never_reset = false;
 
-    // Add self to the list of active keypad scanners.
-    keypad_register_scanner(self);
+    // Do the first scan before adding self to the list of active keypad
+    // scanners so that the first scheduled scan is one interval out.
     keypad_scan_now(self, port_get_raw_ticks(NULL));
+    keypad_register_scanner(self);
 }
 
 static void keypad_scan_now(keypad_scanner_obj_t *self, uint64_t now) {
     self->next_scan_ticks = now + self->interval_ticks;
-    self->funcs->scan_now(self, supervisor_ticks_ms());
+    self->funcs->scan_now(self, supervisor_ticks_ms32());
 }
 
 static void keypad_scan_maybe(keypad_scanner_obj_t *self, uint64_t now) {
@@ -10,7 +10,8 @@
 #include "supervisor/shared/lock.h"
 
 typedef struct _keypad_scanner_funcs_t {
-    void (*scan_now)(void *self_in, mp_obj_t timestamp);
+    // timestamp is supervisor_ticks_ms32() at the start of the scan.
+    void (*scan_now)(void *self_in, uint32_t timestamp);
     size_t (*get_key_count)(void *self_in);
 } keypad_scanner_funcs_t;
 
@@ -34,7 +35,6 @@ typedef struct _keypad_scanner_obj_t {
 
 extern supervisor_lock_t keypad_scanners_linked_list_lock;
 
-void keypad_tick(void);
 void keypad_reset(void);
 
 void keypad_register_scanner(keypad_scanner_obj_t *scanner);
@@ -17,7 +17,7 @@
 #include "supervisor/port.h"
 #include "supervisor/shared/tick.h"
 
-static void demuxkeymatrix_scan_now(void *self_in, mp_obj_t timestamp);
+static void demuxkeymatrix_scan_now(void *self_in, uint32_t timestamp);
 static size_t demuxkeymatrix_get_key_count(void *self_in);
 
 static keypad_scanner_funcs_t keymatrix_funcs = {
@@ -100,7 +100,7 @@ static size_t demuxkeymatrix_get_key_count(void *self_in) {
     return common_hal_keypad_demux_demuxkeymatrix_get_column_count(self) * common_hal_keypad_demux_demuxkeymatrix_get_row_count(self);
 }
 
-static void demuxkeymatrix_scan_now(void *self_in, mp_obj_t timestamp) {
+static void demuxkeymatrix_scan_now(void *self_in, uint32_t timestamp) {
     keypad_demux_demuxkeymatrix_obj_t *self = self_in;
 
     for (size_t row = 0; row < common_hal_keypad_demux_demuxkeymatrix_get_row_count(self); row++) {
@@ -0,0 +1,99 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "shared-bindings/memorymonitor/AllocationProfiler.h"
+
+#include "py/gc.h"
+#include "py/mpstate.h"
+#include "py/runtime.h"
+
+void common_hal_memorymonitor_allocationprofiler_construct(memorymonitor_allocationprofiler_obj_t *self, size_t sample_count, uint32_t every) {
+    self->samples = m_new(memorymonitor_allocation_sample_t, sample_count);
+    self->sample_count = sample_count;
+    self->every = every;
+    common_hal_memorymonitor_allocationprofiler_clear(self);
+}
+
+void common_hal_memorymonitor_allocationprofiler_pause(memorymonitor_allocationprofiler_obj_t *self) {
+    if (MP_STATE_VM(active_allocationprofiler) == self) {
+        MP_STATE_VM(active_allocationprofiler) = NULL;
+    }
+    self->last_ptr = NULL;
+}
+
+void common_hal_memorymonitor_allocationprofiler_resume(memorymonitor_allocationprofiler_obj_t *self) {
+    if (MP_STATE_VM(active_allocationprofiler) != NULL) {
+        mp_raise_RuntimeError(MP_ERROR_TEXT("Already running"));
+    }
+    MP_STATE_VM(active_allocationprofiler) = self;
+}
+
+void common_hal_memorymonitor_allocationprofiler_clear(memorymonitor_allocationprofiler_obj_t *self) {
+    memset(self->samples, 0, self->sample_count * sizeof(memorymonitor_allocation_sample_t));
+    self->next = 0;
+    self->total = 0;
+    self->allocations = 0;
+    self->countdown = self->every;
+    self->last_ptr = NULL;
+}
+
+size_t common_hal_memorymonitor_allocationprofiler_get_allocations(memorymonitor_allocationprofiler_obj_t *self) {
+    return self->allocations;
+}
+
+size_t common_hal_memorymonitor_allocationprofiler_get_sample_count(memorymonitor_allocationprofiler_obj_t *self) {
+    return MIN(self->total, self->sample_count);
+}
+
+const memorymonitor_allocation_sample_t *common_hal_memorymonitor_allocationprofiler_get_samples(memorymonitor_allocationprofiler_obj_t *self) {
+    return self->samples;
+}
+
+// Called for every allocation, so the common path is a countdown. Sampled
+// allocations resolve their line straight away so that the ring holds no
+// pointers into code that may be freed later.
+void memorymonitor_allocationprofiler_track_allocation(void *ptr, size_t block_count) {
+    memorymonitor_allocationprofiler_obj_t *self = MP_STATE_VM(active_allocationprofiler);
+    if (self == NULL) {
+        return;
+    }
+    self->allocations++;
+    if (--self->countdown != 0) {
+        return;
+    }
+    self->countdown = self->every;
+
+    memorymonitor_allocation_sample_t *sample = &self->samples[self->next];
+    memset(sample, 0, sizeof(*sample));
+    sample->blocks = MIN(block_count, 0xffff);
+    const mp_code_state_t *code_state = MP_STATE_THREAD(prof_sample_code_state);
+    if (code_state != NULL) {
+        mp_prof_frame_location(code_state, &sample->location);
+    }
+    self->last_ptr = ptr;
+    if (++self->next == self->sample_count) {
+        self->next = 0;
+    }
+    self->total++;
+}
+
+void memorymonitor_allocationprofiler_track_object_type(void *ptr, const mp_obj_type_t *type) {
+    memorymonitor_allocationprofiler_obj_t *self = MP_STATE_VM(active_allocationprofiler);
+    if (self == NULL || self->last_ptr != ptr) {
+        return;
+    }
+    size_t last = (self->next == 0 ? self->sample_count : self->next) - 1;
+    self->samples[last].type = type;
+    self->last_ptr = NULL;
+}
+
+void memorymonitor_allocationprofiler_reset(void) {
+    MP_STATE_VM(active_allocationprofiler) = NULL;
+}
+
+MP_REGISTER_ROOT_POINTER(struct _memorymonitor_allocationprofiler_obj_t *active_allocationprofiler);
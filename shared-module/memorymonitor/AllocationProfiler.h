@@ -0,0 +1,40 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "py/obj.h"
+#include "py/profile.h"
+
+typedef struct {
+    // NULL when the allocation wasn't made by mp_obj_malloc().
+    const mp_obj_type_t *type;
+    // name == MP_QSTRnull when no Python code was running.
+    mp_prof_sample_frame_t location;
+    uint16_t blocks;
+} memorymonitor_allocation_sample_t;
+
+typedef struct _memorymonitor_allocationprofiler_obj_t {
+    mp_obj_base_t base;
+    memorymonitor_allocation_sample_t *samples;
+    size_t sample_count;
+    // Ring buffer index of the next sample to write.
+    size_t next;
+    // Samples taken, including ones that have been overwritten.
+    size_t total;
+    size_t allocations;
+    uint32_t every;
+    uint32_t countdown;
+    // The allocation sampled last, until mp_obj_malloc() gives it a type.
+    void *last_ptr;
+} memorymonitor_allocationprofiler_obj_t;
+
+void memorymonitor_allocationprofiler_track_allocation(void *ptr, size_t block_count);
+void memorymonitor_allocationprofiler_track_object_type(void *ptr, const mp_obj_type_t *type);
+void memorymonitor_allocationprofiler_reset(void);
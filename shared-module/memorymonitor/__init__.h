@@ -8,5 +8,5 @@
 
 #include <stddef.h>
 
-void memorymonitor_track_allocation(size_t block_count);
+void memorymonitor_track_allocation(void *ptr, size_t block_count);
 void memorymonitor_reset(void);
@@ -0,0 +1,176 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "shared-bindings/microcontroller/Core1.h"
+#include "shared-module/microcontroller/Core1.h"
+#include "supervisor/background_callback.h"
+#include "supervisor/port.h"
+
+#if CIRCUITPY_BITMAPFILTER
+#include "shared-bindings/bitmapfilter/__init__.h"
+#include "shared-bindings/displayio/Bitmap.h"
+#endif
+
+typedef struct {
+    void *dest;
+    const void *src;
+    size_t len;
+} copy_state_t;
+
+static mp_obj_t copy_prepare(void *state_in, size_t n_args, const mp_obj_t *args) {
+    copy_state_t *state = state_in;
+    mp_arg_check_num(n_args, 0, 2, 2, false);
+    mp_buffer_info_t dest, src;
+    mp_get_buffer_raise(args[0], &dest, MP_BUFFER_WRITE);
+    mp_get_buffer_raise(args[1], &src, MP_BUFFER_READ);
+    mp_arg_validate_length(src.len, dest.len, MP_QSTR_source);
+    state->dest = dest.buf;
+    state->src = src.buf;
+    state->len = dest.len;
+    return mp_const_none;
+}
+
+static void copy_run(void *state_in) {
+    copy_state_t *state = state_in;
+    memcpy(state->dest, state->src, state->len);
+}
+
+#if CIRCUITPY_BITMAPFILTER
+typedef struct {
+    bitmapfilter_pipeline_obj_t pipeline;
+    displayio_bitmap_t *bitmap, *mask;
+} pipeline_state_t;
+
+static mp_obj_t pipeline_prepare(void *state_in, size_t n_args, const mp_obj_t *args) {
+    pipeline_state_t *state = state_in;
+    mp_arg_check_num(n_args, 0, 2, 3, false);
+    bitmapfilter_pipeline_obj_t *pipeline = MP_OBJ_TO_PTR(mp_arg_validate_type(args[0], &bitmapfilter_pipeline_type, MP_QSTR_pipeline));
+    displayio_bitmap_t *bitmap = MP_OBJ_TO_PTR(mp_arg_validate_type(args[1], &displayio_bitmap_type, MP_QSTR_bitmap));
+    displayio_bitmap_t *mask = NULL;
+    if (n_args > 2 && args[2] != mp_const_none) {
+        mask = MP_OBJ_TO_PTR(mp_arg_validate_type(args[2], &displayio_bitmap_type, MP_QSTR_mask));
+    }
+    if (bitmap->bits_per_value != 16) {
+        mp_raise_ValueError(MP_ERROR_TEXT("unsupported bitmap depth"));
+    }
+    // Morph needs a scratch allocation, which core 1 cannot make.
+    for (size_t i = 0; i < pipeline->len; i++) {
+        if (pipeline->stages[i].kind == BITMAPFILTER_STAGE_MORPH) {
+            mp_raise_NotImplementedError(MP_ERROR_TEXT("Operation or feature not supported"));
+        }
+    }
+    // Snapshot the stages so that the pipeline can be changed while the
+    // kernel runs.
+    mp_obj_t stages = mp_obj_new_bytes((const byte *)pipeline->stages, pipeline->len * sizeof(bitmapfilter_stage_t));
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(stages, &bufinfo, MP_BUFFER_READ);
+    state->pipeline.stages = bufinfo.buf;
+    state->pipeline.len = state->pipeline.alloc = pipeline->len;
+    state->bitmap = bitmap;
+    state->mask = mask;
+    return stages;
+}
+
+static void pipeline_run(void *state_in) {
+    pipeline_state_t *state = state_in;
+    shared_module_bitmapfilter_pipeline_apply(&state->pipeline, state->bitmap, state->mask);
+}
+#endif
+
+static const microcontroller_core1_kernel_t kernels[] = {
+    { MP_QSTR_copy, copy_prepare, copy_run },
+    #if CIRCUITPY_BITMAPFILTER
+    { MP_QSTR_bitmapfilter_pipeline, pipeline_prepare, pipeline_run },
+    #endif
+};
+
+static const microcontroller_core1_kernel_t *_kernel;
+static uint64_t _state[MICROCONTROLLER_CORE1_STATE_SIZE / sizeof(uint64_t)];
+// Set by core 0 once the kernel and its state are ready, cleared by whichever
+// core ran it.
+static volatile bool _pending;
+static bool _own_second_core;
+
+static void core1_worker(void *arg) {
+    (void)arg;
+    // The worker can be woken spuriously.
+    if (!_pending) {
+        return;
+    }
+    _kernel->run(_state);
+    __sync_synchronize();
+    _pending = false;
+}
+
+void shared_module_microcontroller_core1_run(qstr name, size_t n_args, const mp_obj_t *args) {
+    const microcontroller_core1_kernel_t *kernel = NULL;
+    for (size_t i = 0; i < MP_ARRAY_SIZE(kernels); i++) {
+        if (kernels[i].name == name) {
+            kernel = &kernels[i];
+        }
+    }
+    if (kernel == NULL) {
+        mp_arg_error_invalid(MP_QSTR_kernel);
+    }
+
+    shared_module_microcontroller_core1_wait();
+
+    MP_STATIC_ASSERT(sizeof(copy_state_t) <= sizeof(_state));
+    #if CIRCUITPY_BITMAPFILTER
+    MP_STATIC_ASSERT(sizeof(pipeline_state_t) <= sizeof(_state));
+    #endif
+    mp_obj_t keep = kernel->prepare(_state, n_args, args);
+
+    // Hold references to everything the kernel uses until it is done.
+    mp_obj_tuple_t *objs = MP_OBJ_TO_PTR(mp_obj_new_tuple(n_args + 1, NULL));
+    memcpy(objs->items, args, n_args * sizeof(mp_obj_t));
+    objs->items[n_args] = keep;
+    MP_STATE_VM(core1_objs) = MP_OBJ_FROM_PTR(objs);
+
+    _kernel = kernel;
+    __sync_synchronize();
+    _pending = true;
+
+    _own_second_core = port_second_core_start(core1_worker, NULL);
+    if (_own_second_core) {
+        port_second_core_wake();
+    } else {
+        // Core 1 is busy with something else or this chip doesn't have one.
+        core1_worker(NULL);
+    }
+}
+
+bool shared_module_microcontroller_core1_get_busy(void) {
+    return _pending;
+}
+
+void shared_module_microcontroller_core1_wait(void) {
+    while (_pending) {
+        RUN_BACKGROUND_TASKS;
+    }
+    __sync_synchronize();
+    MP_STATE_VM(core1_objs) = MP_OBJ_NULL;
+    if (_own_second_core) {
+        port_second_core_stop();
+        _own_second_core = false;
+    }
+}
+
+void microcontroller_core1_reset(void) {
+    // A kernel can't be interrupted, but it always finishes.
+    while (_pending) {
+    }
+    if (_own_second_core) {
+        port_second_core_stop();
+        _own_second_core = false;
+    }
+    MP_STATE_VM(core1_objs) = MP_OBJ_NULL;
+}
+
+MP_REGISTER_ROOT_POINTER(mp_obj_t core1_objs);
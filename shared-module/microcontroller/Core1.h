@@ -0,0 +1,24 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+#define MICROCONTROLLER_CORE1_STATE_SIZE (64)
+
+// A native routine that Core1.run() can hand to the second core. prepare()
+// runs on the VM's core: it checks the arguments, may raise, and fills in
+// state. It returns an object that must stay alive until the kernel is done,
+// or mp_const_none. run() reads only state and must not allocate, raise or
+// otherwise touch the VM.
+typedef struct {
+    qstr name;
+    mp_obj_t (*prepare)(void *state, size_t n_args, const mp_obj_t *args);
+    void (*run)(void *state);
+} microcontroller_core1_kernel_t;
+
+void microcontroller_core1_reset(void);
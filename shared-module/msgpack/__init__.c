@@ -6,6 +6,7 @@
 
 #include <stdio.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include "py/obj.h"
 #include "py/binary.h"
@@ -23,47 +24,97 @@
 ////////////////////////////////////////////////////////////////
 // stream management
 
-typedef struct _msgpack_stream_t {
-    mp_obj_t stream_obj;
-    mp_uint_t (*read)(mp_obj_t obj, void *buf, mp_uint_t size, int *errcode);
-    mp_uint_t (*write)(mp_obj_t obj, const void *buf, mp_uint_t size, int *errcode);
-    int errcode;
-} msgpack_stream_t;
-
 static msgpack_stream_t get_stream(mp_obj_t stream_obj, int flags) {
     const mp_stream_p_t *stream_p = mp_get_stream_raise(stream_obj, flags);
-    msgpack_stream_t s = {stream_obj, stream_p->read, stream_p->write, 0};
+    msgpack_stream_t s = {
+        .stream_obj = stream_obj,
+        .read = stream_p->read,
+        .write = stream_p->write,
+    };
     return s;
 }
 
 ////////////////////////////////////////////////////////////////
 // readers
 
-static void read(msgpack_stream_t *s, void *buf, mp_uint_t size) {
-    if (size == 0) {
-        return;
+static void read_stream(msgpack_stream_t *s, void *buf, mp_uint_t size) {
+    uint8_t *dest = buf;
+    // Streams such as sockets and UARTs may return less than was asked for.
+    while (size > 0) {
+        s->errcode = 0;
+        mp_uint_t ret = s->read(s->stream_obj, dest, size, &s->errcode);
+        if (s->errcode != 0) {
+            mp_raise_OSError(s->errcode);
+        }
+        if (ret == 0) {
+            mp_raise_msg(&mp_type_EOFError, NULL);
+        }
+        dest += ret;
+        size -= ret;
+    }
+}
+
+// Move the object being unpacked, and the unread data after it, down to
+// buf[keep]. Nothing moves once the object has views into the buffer.
+static void buffer_compact(msgpack_stream_t *s) {
+    if (s->start > s->keep) {
+        size_t shift = s->start - s->keep;
+        memmove(s->buf + s->keep, s->buf + s->start, s->end - s->start);
+        s->start -= shift;
+        s->pos -= shift;
+        s->end -= shift;
     }
-    mp_uint_t ret = s->read(s->stream_obj, buf, size, &s->errcode);
+}
+
+// Read as much of the stream as fits after buf[end]. Returns 0 at end of stream.
+static mp_uint_t buffer_fill(msgpack_stream_t *s) {
+    // Stream read functions only set the error code when they fail.
+    s->errcode = 0;
+    mp_uint_t ret = s->read(s->stream_obj, s->buf + s->end, s->buf_size - s->end, &s->errcode);
     if (s->errcode != 0) {
         mp_raise_OSError(s->errcode);
     }
-    if (ret == 0) {
-        mp_raise_msg(&mp_type_EOFError, NULL);
+    s->end += ret;
+    return ret;
+}
+
+static void read_bytes(msgpack_stream_t *s, void *buf, mp_uint_t size) {
+    if (s->buf == NULL) {
+        read_stream(s, buf, size);
+        return;
     }
-    if (ret < size) {
-        mp_raise_ValueError(MP_ERROR_TEXT("short read"));
+    uint8_t *dest = buf;
+    while (size > 0) {
+        if (s->pos == s->end) {
+            buffer_compact(s);
+            if (size >= s->buf_size - s->end) {
+                // Nothing is gained by going through the buffer, but the
+                // object can no longer be read again from the start.
+                s->bypassed = true;
+                read_stream(s, dest, size);
+                return;
+            }
+            if (buffer_fill(s) == 0) {
+                mp_raise_msg(&mp_type_EOFError, NULL);
+            }
+        }
+        size_t n = MIN(size, s->end - s->pos);
+        memcpy(dest, s->buf + s->pos, n);
+        s->pos += n;
+        dest += n;
+        size -= n;
     }
 }
 
 static uint8_t read1(msgpack_stream_t *s) {
     uint8_t res = 0;
-    read(s, &res, 1);
+    read_bytes(s, &res, 1);
     return res;
 }
 
 static uint16_t read2(msgpack_stream_t *s) {
     uint16_t res = 0;
-    read(s, &res, 2);
+    read_bytes(s, &res, 2);
     int n = 1;
     if (*(char *)&n == 1) {
         res = __builtin_bswap16(res);
@@ -73,7 +124,7 @@ static uint16_t read2(msgpack_stream_t *s) {
 
 static uint32_t read4(msgpack_stream_t *s) {
     uint32_t res = 0;
-    read(s, &res, 4);
+    read_bytes(s, &res, 4);
     int n = 1;
     if (*(char *)&n == 1) {
         res = __builtin_bswap32(res);
@@ -83,7 +134,7 @@ static uint32_t read4(msgpack_stream_t *s) {
 
 static uint64_t read8(msgpack_stream_t *s) {
     uint64_t res = 0;
-    read(s, &res, 8);
+    read_bytes(s, &res, 8);
     int n = 1;
     if (*(char *)&n == 1) {
         res = __builtin_bswap64(res);
@@ -110,7 +161,8 @@ static size_t read_size(msgpack_stream_t *s, uint8_t len_index) {
 ////////////////////////////////////////////////////////////////
 // writers
 
-static void write(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
+static void write_bytes(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
+    s->errcode = 0;
     mp_uint_t ret = s->write(s->stream_obj, buf, size, &s->errcode);
     if (s->errcode != 0) {
         mp_raise_OSError(s->errcode);
@@ -121,7 +173,7 @@ static void write(msgpack_stream_t *s, const void *buf, mp_uint_t size) {
 }
 
 static void write1(msgpack_stream_t *s, uint8_t obj) {
-    write(s, &obj, 1);
+    write_bytes(s, &obj, 1);
 }
 
 static void write2(msgpack_stream_t *s, uint16_t obj) {
@@ -129,7 +181,7 @@ static void write2(msgpack_stream_t *s, uint16_t obj) {
     if (*(char *)&n == 1) {
         obj = __builtin_bswap16(obj);
     }
-    write(s, &obj, 2);
+    write_bytes(s, &obj, 2);
 }
 
 static void write4(msgpack_stream_t *s, uint32_t obj) {
@@ -137,7 +189,15 @@ static void write4(msgpack_stream_t *s, uint32_t obj) {
     if (*(char *)&n == 1) {
         obj = __builtin_bswap32(obj);
     }
-    write(s, &obj, 4);
+    write_bytes(s, &obj, 4);
+}
+
+static void write8(msgpack_stream_t *s, uint64_t obj) {
+    int n = 1;
+    if (*(char *)&n == 1) {
+        obj = __builtin_bswap64(obj);
+    }
+    write_bytes(s, &obj, 8);
 }
 
 // compute and write msgpack size code (array structures)
@@ -192,7 +252,7 @@ static void pack_int(msgpack_stream_t *s, int32_t x) {
 static void pack_bin(msgpack_stream_t *s, const uint8_t *data, size_t len) {
     write_size(s, 0xc4, len);
     if (len > 0) {
-        write(s, data, len);
+        write_bytes(s, data, len);
     }
 }
 
@@ -212,7 +272,7 @@ static void pack_ext(msgpack_stream_t *s, int8_t code, const uint8_t *data, size
     }
     write1(s, code);    // type byte
     if (len > 0) {
-        write(s, data, len);
+        write_bytes(s, data, len);
     }
 }
 
@@ -223,7 +283,7 @@ static void pack_str(msgpack_stream_t *s, const char *str, size_t len) {
         write_size(s, 0xd9, len);
     }
     if (len > 0) {
-        write(s, str, len);
+        write_bytes(s, str, len);
     }
 }
 
@@ -293,13 +353,23 @@ static void pack(mp_obj_t obj, msgpack_stream_t *s, mp_obj_t default_handler) {
             pack(next->value, s, default_handler);
         }
     } else if (mp_obj_is_float(obj)) {
-        union Float { mp_float_t f;
+        #if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_DOUBLE
+        union Double { double d;
+                       uint64_t u;
+        };
+        union Double data;
+        data.d = mp_obj_float_get(obj);
+        write1(s, 0xcb);
+        write8(s, data.u);
+        #else
+        union Float { float f;
                       uint32_t u;
         };
         union Float data;
         data.f = mp_obj_float_get(obj);
         write1(s, 0xca);
         write4(s, data.u);
+        #endif
     } else if (obj == mp_const_none) {
         write1(s, 0xc0);
     } else if (obj == mp_const_false) {
@@ -342,6 +412,20 @@ static mp_obj_t unpack_array_elements(msgpack_stream_t *s, size_t size, mp_obj_t
     }
 }
 
+static mp_obj_t unpack_map_elements(msgpack_stream_t *s, size_t size, mp_obj_t ext_hook, bool use_list) {
+    mp_obj_dict_t *d = MP_OBJ_TO_PTR(mp_obj_new_dict(size));
+    bool use_memoryview = s->use_memoryview;
+    for (size_t i = 0; i < size; i++) {
+        // Keys must be hashable, so never return them as a memoryview.
+        s->use_memoryview = false;
+        mp_obj_t key = unpack(s, ext_hook, use_list);
+        s->use_memoryview = use_memoryview;
+        mp_obj_t value = unpack(s, ext_hook, use_list);
+        mp_obj_dict_store(d, key, value);
+    }
+    return MP_OBJ_FROM_PTR(d);
+}
+
 static mp_obj_t unpack_bytes(msgpack_stream_t *s, size_t size) {
     vstr_t vstr;
     vstr_init_len(&vstr, size);
@@ -351,13 +435,37 @@ static mp_obj_t unpack_bytes(msgpack_stream_t *s, size_t size) {
     // read(s, p, size);
     while (size > 0) {
         int n = size > 256 ? 256 : size;
-        read(s, p, n);
+        read_bytes(s, p, n);
         size -= n;
         p += n;
     }
     return mp_obj_new_bytes_from_vstr(&vstr);
 }
 
+static mp_obj_t unpack_bin(msgpack_stream_t *s, size_t size) {
+    if (s->use_memoryview && s->buf_size < ((size_t)1 << MP_OBJ_ARRAY_FREE_SIZE_BITS)) {
+        if (s->end - s->pos < size) {
+            buffer_compact(s);
+        }
+        // Gather the payload contiguously in the buffer and return a view of it.
+        if (size <= s->buf_size - s->pos) {
+            while (s->end - s->pos < size) {
+                if (buffer_fill(s) == 0) {
+                    mp_raise_msg(&mp_type_EOFError, NULL);
+                }
+            }
+            // Point the view at the start of the buffer, with an offset, so
+            // that the GC keeps the buffer alive for as long as the view.
+            mp_obj_array_t *view = MP_OBJ_TO_PTR(mp_obj_new_memoryview('B', size, s->buf));
+            view->free = s->pos;
+            s->pos += size;
+            s->keep = s->pos;
+            return MP_OBJ_FROM_PTR(view);
+        }
+    }
+    return unpack_bytes(s, size);
+}
+
 static mp_obj_t unpack_ext(msgpack_stream_t *s, size_t size, mp_obj_t ext_hook) {
     int8_t code = read1(s);
     mp_obj_t data = unpack_bytes(s, size);
@@ -382,7 +490,7 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
         size_t len = code & 0b11111;
         // allocate on stack; len < 32
         char str[len];
-        read(s, &str, len);
+        read_bytes(s, &str, len);
         return mp_obj_new_str(str, len);
     }
     if ((code & 0b11110000) == 0b10010000) {
@@ -391,12 +499,7 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
     }
     if ((code & 0b11110000) == 0b10000000) {
         // map (dict)
-        size_t len = code & 0b1111;
-        mp_obj_dict_t *d = MP_OBJ_TO_PTR(mp_obj_new_dict(len));
-        for (size_t i = 0; i < len; i++) {
-            mp_obj_dict_store(d, unpack(s, ext_hook, use_list), unpack(s, ext_hook, use_list));
-        }
-        return MP_OBJ_FROM_PTR(d);
+        return unpack_map_elements(s, code & 0b1111, ext_hook, use_list);
     }
     switch (code) {
         case 0xc0:
@@ -409,7 +512,7 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
         case 0xc5:
         case 0xc6: {
             // bin 8, 16, 32
-            return unpack_bytes(s, read_size(s, code - 0xc4));
+            return unpack_bin(s, read_size(s, code - 0xc4));
         }
         case 0xcc: // uint8
             return MP_OBJ_NEW_SMALL_INT((uint8_t)read1(s));
@@ -429,7 +532,7 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
             return mp_obj_new_int_from_ll((int64_t)read8(s));
         case 0xca: { // float
             union Float {
-                mp_float_t f;
+                float f;
                 uint32_t u;
             };
             union Float data;
@@ -453,18 +556,14 @@ static mp_obj_t unpack(msgpack_stream_t *s, mp_obj_t ext_hook, bool use_list) {
             vstr_t vstr;
             vstr_init_len(&vstr, size);
             byte *p = (byte *)vstr.buf;
-            read(s, p, size);
+            read_bytes(s, p, size);
             return mp_obj_new_str_from_vstr(&vstr);
         }
         case 0xde:
         case 0xdf: {
             // map 16 & 32
             size_t len = read_size(s, code - 0xde + 1);
-            mp_obj_dict_t *d = MP_OBJ_TO_PTR(mp_obj_new_dict(len));
-            for (size_t i = 0; i < len; i++) {
-                mp_obj_dict_store(d, unpack(s, ext_hook, use_list), unpack(s, ext_hook, use_list));
-            }
-            return MP_OBJ_FROM_PTR(d);
+            return unpack_map_elements(s, len, ext_hook, use_list);
         }
         case 0xdc:
         case 0xdd: {
@@ -502,3 +601,38 @@ mp_obj_t common_hal_msgpack_unpack(mp_obj_t stream_obj, mp_obj_t ext_hook, bool
     msgpack_stream_t stream = get_stream(stream_obj, MP_STREAM_OP_READ);
     return unpack(&stream, ext_hook, use_list);
 }
+
+void common_hal_msgpack_unpacker_construct(msgpack_unpacker_obj_t *self, mp_obj_t stream_obj, uint8_t *buf, size_t buf_size, mp_obj_t ext_hook, bool use_list, bool use_memoryview) {
+    self->stream = get_stream(stream_obj, MP_STREAM_OP_READ);
+    self->stream.buf = buf;
+    self->stream.buf_size = buf_size;
+    self->stream.use_memoryview = use_memoryview;
+    self->ext_hook = ext_hook;
+    self->use_list = use_list;
+}
+
+mp_obj_t common_hal_msgpack_unpacker_unpack(msgpack_unpacker_obj_t *self) {
+    msgpack_stream_t *s = &self->stream;
+    // Views returned with the previous object are no longer protected.
+    s->keep = 0;
+    s->start = s->pos;
+    s->bypassed = false;
+    if (s->pos == s->end) {
+        buffer_compact(s);
+        if (buffer_fill(s) == 0) {
+            return MP_OBJ_STOP_ITERATION;
+        }
+    }
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        mp_obj_t obj = unpack(s, self->ext_hook, self->use_list);
+        nlr_pop();
+        return obj;
+    }
+    // After an error such as a timeout, the next call starts the object
+    // again, unless part of it was read around the buffer.
+    if (!s->bypassed) {
+        s->pos = s->start;
+    }
+    nlr_jump(nlr.ret_val);
+}
@@ -7,5 +7,39 @@
 
 #include "py/stream.h"
 
+typedef struct _msgpack_stream_t {
+    mp_obj_t stream_obj;
+    mp_uint_t (*read)(mp_obj_t obj, void *buf, mp_uint_t size, int *errcode);
+    mp_uint_t (*write)(mp_obj_t obj, const void *buf, mp_uint_t size, int *errcode);
+    int errcode;
+    // Optional read buffer, holding buf[pos:end] of not yet unpacked data.
+    uint8_t *buf;
+    size_t buf_size;
+    size_t pos;
+    size_t end;
+    // buf[:keep] must stay in place, because the object being unpacked
+    // holds memoryviews of it.
+    size_t keep;
+    // The object being unpacked starts at buf[start].
+    size_t start;
+    // Part of the object was read straight from the stream, so it can't be
+    // unpacked again from buf[start].
+    bool bypassed;
+    bool use_memoryview;
+} msgpack_stream_t;
+
+typedef struct {
+    mp_obj_base_t base;
+    msgpack_stream_t stream;
+    // Holds on to the object stream.buf points into.
+    mp_obj_t buffer;
+    mp_obj_t ext_hook;
+    bool use_list;
+} msgpack_unpacker_obj_t;
+
 void common_hal_msgpack_pack(mp_obj_t obj, mp_obj_t stream_obj, mp_obj_t default_handler);
 mp_obj_t common_hal_msgpack_unpack(mp_obj_t stream_obj, mp_obj_t ext_hook, bool use_list);
+
+void common_hal_msgpack_unpacker_construct(msgpack_unpacker_obj_t *self, mp_obj_t stream_obj, uint8_t *buf, size_t buf_size, mp_obj_t ext_hook, bool use_list, bool use_memoryview);
+// Returns MP_OBJ_STOP_ITERATION if the stream ends before the next object.
+mp_obj_t common_hal_msgpack_unpacker_unpack(msgpack_unpacker_obj_t *self);
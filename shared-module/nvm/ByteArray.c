@@ -0,0 +1,123 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/misc.h"
+#include "shared-bindings/nvm/ByteArray.h"
+#include "shared-module/nvm/ByteArray.h"
+
+#if CIRCUITPY_NVM_CACHE_SIZE > 0
+
+#include "supervisor/background_callback.h"
+#include "supervisor/port.h"
+#include "supervisor/shared/tick.h"
+
+// A copy of part of the nvm. Assignments within it only change RAM, and the
+// span that changed is written back with one port write, so a counter that
+// is bumped many times costs one erase instead of one per assignment.
+static struct {
+    const nvm_bytearray_obj_t *nvm; // NULL when nothing is loaded
+    uint32_t start;
+    uint32_t len;
+    // Changed bytes, relative to start. dirty_start == dirty_end when clean.
+    uint32_t dirty_start;
+    uint32_t dirty_end;
+    uint8_t data[CIRCUITPY_NVM_CACHE_SIZE];
+} window;
+
+static supervisor_deadline_t flush_deadline;
+static background_callback_t flush_callback;
+
+static void flush_in_background(void *unused) {
+    // Nothing to raise to. A failed write is retried by the next flush.
+    nvm_bytearray_flush();
+}
+
+// Called from interrupt context, so hand off to the background.
+static void flush_due(void *unused) {
+    background_callback_add(&flush_callback, flush_in_background, NULL);
+}
+
+bool nvm_bytearray_flush(void) {
+    if (window.dirty_start == window.dirty_end) {
+        return true;
+    }
+    supervisor_deadline_cancel(&flush_deadline);
+    if (!common_hal_nvm_bytearray_set_bytes(window.nvm, window.start + window.dirty_start,
+        window.data + window.dirty_start, window.dirty_end - window.dirty_start)) {
+        return false;
+    }
+    window.dirty_start = window.dirty_end = 0;
+    return true;
+}
+
+void nvm_bytearray_get_bytes(const nvm_bytearray_obj_t *self, uint32_t start_index, uint32_t len, uint8_t *values) {
+    common_hal_nvm_bytearray_get_bytes(self, start_index, len, values);
+    if (window.nvm != self) {
+        return;
+    }
+    uint32_t from = MAX(start_index, window.start);
+    uint32_t to = MIN(start_index + len, window.start + window.len);
+    if (from < to) {
+        memcpy(values + (from - start_index), window.data + (from - window.start), to - from);
+    }
+}
+
+bool nvm_bytearray_set_bytes(const nvm_bytearray_obj_t *self, uint32_t start_index, uint8_t *values, uint32_t len) {
+    if (len > sizeof(window.data)) {
+        // Too big to batch. Write what is pending first so the order holds.
+        if (!nvm_bytearray_flush()) {
+            return false;
+        }
+        window.nvm = NULL;
+        return common_hal_nvm_bytearray_set_bytes(self, start_index, values, len);
+    }
+    if (window.nvm != self || start_index < window.start || start_index + len > window.start + window.len) {
+        if (!nvm_bytearray_flush()) {
+            return false;
+        }
+        // Load a new window that starts here, or ends at the end of the nvm.
+        uint32_t nvm_len = common_hal_nvm_bytearray_get_length(self);
+        window.len = MIN(sizeof(window.data), nvm_len);
+        window.start = MIN(start_index, nvm_len - window.len);
+        common_hal_nvm_bytearray_get_bytes(self, window.start, window.len, window.data);
+        window.nvm = self;
+    }
+
+    uint32_t offset = start_index - window.start;
+    if (memcmp(window.data + offset, values, len) == 0) {
+        // Unchanged, so there is nothing to write.
+        return true;
+    }
+    memcpy(window.data + offset, values, len);
+    if (window.dirty_start == window.dirty_end) {
+        window.dirty_start = offset;
+        window.dirty_end = offset + len;
+        supervisor_deadline_schedule(&flush_deadline,
+            port_get_raw_ticks(NULL) + (CIRCUITPY_NVM_WRITE_DELAY_MS * 1024) / 1000, flush_due, NULL);
+    } else {
+        window.dirty_start = MIN(window.dirty_start, offset);
+        window.dirty_end = MAX(window.dirty_end, offset + len);
+    }
+    return true;
+}
+
+#else
+
+bool nvm_bytearray_flush(void) {
+    return true;
+}
+
+void nvm_bytearray_get_bytes(const nvm_bytearray_obj_t *self, uint32_t start_index, uint32_t len, uint8_t *values) {
+    common_hal_nvm_bytearray_get_bytes(self, start_index, len, values);
+}
+
+bool nvm_bytearray_set_bytes(const nvm_bytearray_obj_t *self, uint32_t start_index, uint8_t *values, uint32_t len) {
+    return common_hal_nvm_bytearray_set_bytes(self, start_index, values, len);
+}
+
+#endif
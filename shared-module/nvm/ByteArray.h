@@ -0,0 +1,32 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "common-hal/nvm/ByteArray.h"
+
+// Writes to the nvm go through a RAM window of this many bytes, which is
+// written back as one port write. 0 writes straight to the port.
+#ifndef CIRCUITPY_NVM_CACHE_SIZE
+#if CIRCUITPY_FULL_BUILD
+#define CIRCUITPY_NVM_CACHE_SIZE (256)
+#else
+#define CIRCUITPY_NVM_CACHE_SIZE (0)
+#endif
+#endif
+
+// How long after the first change the window is written back.
+#ifndef CIRCUITPY_NVM_WRITE_DELAY_MS
+#define CIRCUITPY_NVM_WRITE_DELAY_MS (100)
+#endif
+
+// Used instead of the common_hal_nvm_bytearray functions so that reads see
+// writes that are still in the window.
+bool nvm_bytearray_set_bytes(const nvm_bytearray_obj_t *self, uint32_t start_index, uint8_t *values, uint32_t len);
+void nvm_bytearray_get_bytes(const nvm_bytearray_obj_t *self, uint32_t start_index, uint32_t len, uint8_t *values);
+
+// Write back any changes still in the window. Returns false if the port write failed.
+bool nvm_bytearray_flush(void);
@@ -11,6 +11,11 @@
 
 // Durations are taken from here: https://www.maximintegrated.com/en/app-notes/index.mvp/id/126
 
+MP_WEAK size_t onewireio_onewire_port_transfer(onewireio_onewire_obj_t *self,
+    const uint8_t *out, uint8_t *in, size_t len) {
+    return 0;
+}
+
 void common_hal_onewireio_onewire_construct(onewireio_onewire_obj_t *self,
     const mcu_pin_obj_t *pin) {
     self->pin.base.type = &digitalio_digitalinout_type;
@@ -69,3 +74,71 @@ void common_hal_onewireio_onewire_write_bit(onewireio_onewire_obj_t *self,
     common_hal_mcu_delay_us(bit? 64 : 10);
     common_hal_mcu_enable_interrupts();
 }
+
+// Bytes go least significant bit first. A 1 is sent as a read slot so that
+// the bit the bus returns can be kept.
+static void _transfer(onewireio_onewire_obj_t *self, const uint8_t *out, uint8_t *in, size_t len) {
+    size_t done = onewireio_onewire_port_transfer(self, out, in, len);
+    for (size_t i = done; i < len; i++) {
+        uint8_t data_out = out == NULL ? 0xff : out[i];
+        uint8_t data_in = 0;
+        for (int j = 0; j < 8; j++) {
+            if ((data_out >> j) & 1) {
+                data_in |= common_hal_onewireio_onewire_read_bit(self) << j;
+            } else {
+                common_hal_onewireio_onewire_write_bit(self, false);
+            }
+        }
+        if (in != NULL) {
+            in[i] = data_in;
+        }
+    }
+}
+
+void common_hal_onewireio_onewire_write(onewireio_onewire_obj_t *self, const uint8_t *data, size_t len) {
+    _transfer(self, data, NULL, len);
+}
+
+void common_hal_onewireio_onewire_readinto(onewireio_onewire_obj_t *self, uint8_t *data, size_t len) {
+    _transfer(self, NULL, data, len);
+}
+
+// One pass of the ROM search from Maxim application note 187. rom holds the
+// previous ROM found and is replaced by the next one. last_discrepancy is the
+// bit where the previous pass took the 0 branch, or 64 before the first pass.
+// It is set to -1 once no other branches are left. Returns false when no
+// device answered.
+bool common_hal_onewireio_onewire_search(onewireio_onewire_obj_t *self, uint8_t command, uint8_t rom[8], int *last_discrepancy) {
+    if (common_hal_onewireio_onewire_reset(self)) {
+        return false;
+    }
+    common_hal_onewireio_onewire_write(self, &command, 1);
+    int last_zero = -1;
+    for (int i = 0; i < 64; i++) {
+        bool bit = common_hal_onewireio_onewire_read_bit(self);
+        bool complement = common_hal_onewireio_onewire_read_bit(self);
+        bool direction;
+        if (bit && complement) {
+            // Nothing answered, perhaps because a device left the bus.
+            return false;
+        } else if (bit != complement) {
+            // Every remaining device has the same bit here.
+            direction = bit;
+        } else if (i < *last_discrepancy) {
+            direction = (rom[i / 8] >> (i % 8)) & 1;
+        } else {
+            direction = i == *last_discrepancy;
+        }
+        if (bit == complement && !direction) {
+            last_zero = i;
+        }
+        if (direction) {
+            rom[i / 8] |= 1 << (i % 8);
+        } else {
+            rom[i / 8] &= ~(1 << (i % 8));
+        }
+        common_hal_onewireio_onewire_write_bit(self, direction);
+    }
+    *last_discrepancy = last_zero;
+    return true;
+}
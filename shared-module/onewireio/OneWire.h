@@ -14,3 +14,11 @@ typedef struct {
     mp_obj_base_t base;
     digitalio_digitalinout_obj_t pin;
 } onewireio_onewire_obj_t;
+
+// Ports may run byte transfers on a hardware engine, such as an RP2040 PIO
+// state machine, instead of timing each slot from the CPU. A read slot is a
+// written 1, so out may be NULL to read len bytes and in may be NULL to only
+// write. Returns how many bytes were transferred. The rest are done in
+// software. The default does none.
+size_t onewireio_onewire_port_transfer(onewireio_onewire_obj_t *self,
+    const uint8_t *out, uint8_t *in, size_t len);
@@ -26,6 +26,52 @@
 #define GETENV_PATH "/settings.toml"
 
 #include "extmod/vfs.h"
+#if CIRCUITPY_FILESYSTEM_LFS && !defined(UNIX)
+#include "extmod/vfs_lfs.h"
+typedef struct {
+    lfs2_t *lfs;
+    lfs2_file_t file;
+    struct lfs2_file_config cfg;
+    uint8_t buffer[FILESYSTEM_BLOCK_SIZE];
+} file_arg;
+static bool open_file(const char *name, file_arg *active_file) {
+    struct _mp_obj_vfs_lfs2_t *vfs = filesystem_circuitpy_lfs();
+    if (vfs == NULL) {
+        return false;
+    }
+    active_file->lfs = &vfs->lfs;
+    memset(&active_file->cfg, 0, sizeof(active_file->cfg));
+    active_file->cfg.buffer = active_file->buffer;
+    return lfs2_file_opencfg(active_file->lfs, &active_file->file, name, LFS2_O_RDONLY, &active_file->cfg) == LFS2_ERR_OK;
+}
+static void close_file(file_arg *active_file) {
+    lfs2_file_close(active_file->lfs, &active_file->file);
+}
+static bool file_is_eof(file_arg *active_file) {
+    lfs2_soff_t pos = lfs2_file_tell(active_file->lfs, &active_file->file);
+    return pos < 0 || pos >= lfs2_file_size(active_file->lfs, &active_file->file);
+}
+
+// Return 0 if there is no next character (EOF).
+static uint8_t file_get_next_byte(file_arg *active_file) {
+    uint8_t character = 0;
+    // If there's an error or nothing was read, character will remain 0.
+    lfs2_file_read(active_file->lfs, &active_file->file, &character, 1);
+    return character;
+}
+static void file_seek_eof(file_arg *active_file) {
+    lfs2_file_seek(active_file->lfs, &active_file->file, 0, LFS2_SEEK_END);
+}
+static size_t file_size(file_arg *active_file) {
+    lfs2_soff_t size = lfs2_file_size(active_file->lfs, &active_file->file);
+    return size < 0 ? 0 : size;
+}
+// Return the number of bytes read, which is less than len on an error.
+static size_t file_read(file_arg *active_file, uint8_t *buf, size_t len) {
+    lfs2_ssize_t quantity_read = lfs2_file_read(active_file->lfs, &active_file->file, buf, len);
+    return quantity_read < 0 ? 0 : quantity_read;
+}
+#else
 #include "extmod/vfs_fat.h"
 typedef FIL file_arg;
 static bool open_file(const char *name, file_arg *active_file) {
@@ -54,21 +100,63 @@ static bool open_file(const char *name, file_arg *active_file) {
 static void close_file(file_arg *active_file) {
     // nothing
 }
-static bool is_eof(file_arg *active_file) {
+static bool file_is_eof(file_arg *active_file) {
     return f_eof(active_file) || f_error(active_file);
 }
 
 // Return 0 if there is no next character (EOF).
-static uint8_t get_next_byte(FIL *active_file) {
+static uint8_t file_get_next_byte(FIL *active_file) {
     uint8_t character = 0;
     UINT quantity_read;
     // If there's an error or quantity_read is 0, character will remain 0.
     f_read(active_file, &character, 1, &quantity_read);
     return character;
 }
-static void seek_eof(file_arg *active_file) {
+static void file_seek_eof(file_arg *active_file) {
     f_lseek(active_file, f_size(active_file));
 }
+static size_t file_size(file_arg *active_file) {
+    return f_size(active_file);
+}
+// Return the number of bytes read, which is less than len on an error.
+static size_t file_read(file_arg *active_file, uint8_t *buf, size_t len) {
+    UINT quantity_read = 0;
+    f_read(active_file, buf, len, &quantity_read);
+    return quantity_read;
+}
+#endif
+
+// The parser reads either straight from the file or from the copy of it in
+// the cache below.
+typedef struct {
+    file_arg *file; // NULL when reading from text
+    const uint8_t *text;
+    size_t len;
+    size_t pos;
+} source_t;
+
+static bool is_eof(source_t *source) {
+    if (source->file) {
+        return file_is_eof(source->file);
+    }
+    return source->pos >= source->len;
+}
+
+// Return 0 if there is no next character (EOF).
+static uint8_t get_next_byte(source_t *source) {
+    if (source->file) {
+        return file_get_next_byte(source->file);
+    }
+    return source->pos < source->len ? source->text[source->pos++] : 0;
+}
+
+static void seek_eof(source_t *source) {
+    if (source->file) {
+        file_seek_eof(source->file);
+    } else {
+        source->pos = source->len;
+    }
+}
 
 // For a fixed buffer, record the required size rather than throwing
 static void vstr_add_byte_nonstd(vstr_t *vstr, byte b) {
@@ -92,7 +180,7 @@ static void vstr_add_char_nonstd(vstr_t *vstr, unichar c) {
     }
 }
 
-static void next_line(file_arg *active_file) {
+static void next_line(source_t *active_file) {
     uint8_t character;
     do {
         character = get_next_byte(active_file);
@@ -101,7 +189,7 @@ static void next_line(file_arg *active_file) {
 
 // Discard whitespace, except for newlines, returning the next character after the whitespace.
 // Return 0 if there is no next character (EOF).
-static uint8_t consume_whitespace(file_arg *active_file) {
+static uint8_t consume_whitespace(source_t *active_file) {
     uint8_t character;
     do {
         character = get_next_byte(active_file);
@@ -115,7 +203,7 @@ static uint8_t consume_whitespace(file_arg *active_file) {
 // If result is true, the key matches and file pointer is pointing just after the "=".
 // If the result is false, the key does NOT match and the file pointer is
 // pointing at the start of the next line, if any
-static bool key_matches(file_arg *active_file, const char *key) {
+static bool key_matches(source_t *active_file, const char *key) {
     uint8_t character;
     character = consume_whitespace(active_file);
     if (character == '[' || character == 0) {
@@ -151,7 +239,7 @@ static bool key_matches(file_arg *active_file, const char *key) {
     return true;
 }
 
-static os_getenv_err_t read_unicode_escape(file_arg *active_file, int sz, vstr_t *buf) {
+static os_getenv_err_t read_unicode_escape(source_t *active_file, int sz, vstr_t *buf) {
     char hex_buf[sz + 1];
     for (int i = 0; i < sz; i++) {
         hex_buf[i] = get_next_byte(active_file);
@@ -170,7 +258,7 @@ static os_getenv_err_t read_unicode_escape(file_arg *active_file, int sz, vstr_t
 }
 
 // Read a quoted string
-static os_getenv_err_t read_string_value(file_arg *active_file, vstr_t *buf) {
+static os_getenv_err_t read_string_value(source_t *active_file, vstr_t *buf) {
     while (true) {
         int character = get_next_byte(active_file);
         switch (character) {
@@ -236,7 +324,7 @@ static os_getenv_err_t read_string_value(file_arg *active_file, vstr_t *buf) {
 }
 
 // Read a numeric value (non-quoted value) as a string
-static os_getenv_err_t read_bare_value(file_arg *active_file, vstr_t *buf, int first_character) {
+static os_getenv_err_t read_bare_value(source_t *active_file, vstr_t *buf, int first_character) {
     int character = first_character;
     while (true) {
         switch (character) {
@@ -253,7 +341,7 @@ static os_getenv_err_t read_bare_value(file_arg *active_file, vstr_t *buf, int f
     }
 }
 
-static mp_int_t read_value(file_arg *active_file, vstr_t *buf, bool *quoted) {
+static mp_int_t read_value(source_t *active_file, vstr_t *buf, bool *quoted) {
     uint8_t character;
     character = consume_whitespace(active_file);
     *quoted = (character == '"');
@@ -265,19 +353,208 @@ static mp_int_t read_value(file_arg *active_file, vstr_t *buf, bool *quoted) {
     }
 }
 
-static os_getenv_err_t os_getenv_vstr(const char *path, const char *key, vstr_t *buf, bool *quoted) {
+// settings.toml is read into memory the first time a setting is looked up,
+// along with an index of its keys sorted for binary search. Writing any block
+// to a filesystem makes the copy stale, so the next lookup reads the file
+// again. Values are still parsed on every lookup, so errors are reported for
+// the key asked for, just like reading the file.
+#ifndef GETENV_CACHE_MAX_SIZE
+#define GETENV_CACHE_MAX_SIZE (4096)
+#endif
+
+#if defined(UNIX)
+#define cache_malloc(size) malloc(size)
+#define cache_free(ptr) free(ptr)
+#else
+#include "supervisor/port_heap.h"
+#define cache_malloc(size) port_malloc(size, false)
+#define cache_free(ptr) port_free(ptr)
+#endif
+
+typedef struct {
+    uint16_t key;
+    uint16_t key_len;
+    uint16_t value; // just after the '='
+} cache_entry_t;
+
+static struct {
+    uint8_t *text;
+    cache_entry_t *entries;
+    uint16_t len;
+    uint16_t entry_count;
+    uint32_t write_count;
+    bool valid;
+    bool file_found;
+} cache;
+
+static void cache_clear(void) {
+    cache_free(cache.text);
+    cache_free(cache.entries);
+    cache.text = NULL;
+    cache.entries = NULL;
+    cache.len = 0;
+    cache.entry_count = 0;
+    cache.valid = false;
+}
+
+static bool is_key_byte(uint8_t character) {
+    return character != 0 && character != '=' && !unichar_isspace(character);
+}
+
+static int compare_key(const cache_entry_t *entry, const char *key, size_t key_len) {
+    int result = memcmp(cache.text + entry->key, key, MIN(entry->key_len, key_len));
+    if (result == 0) {
+        result = (int)entry->key_len - (int)key_len;
+    }
+    return result;
+}
+
+// Find the lines of the form "key = ..." before the first table header, the
+// same ones key_matches() would. Returns how many there are, and fills in
+// entries if it isn't NULL.
+static size_t cache_index(cache_entry_t *entries) {
+    const uint8_t *text = cache.text;
+    size_t len = cache.len;
+    size_t count = 0;
+    size_t pos = 0;
+    while (pos < len) {
+        while (pos < len && text[pos] != '\n' && unichar_isspace(text[pos])) {
+            pos++;
+        }
+        if (pos >= len || text[pos] == '[' || text[pos] == 0) {
+            break;
+        }
+        size_t key = pos;
+        while (pos < len && is_key_byte(text[pos])) {
+            pos++;
+        }
+        size_t key_len = pos - key;
+        while (pos < len && text[pos] != '\n' && unichar_isspace(text[pos])) {
+            pos++;
+        }
+        if (pos < len && text[pos] == '=') {
+            if (entries) {
+                entries[count] = (cache_entry_t) { .key = key, .key_len = key_len, .value = pos + 1 };
+            }
+            count++;
+        }
+        while (pos < len && text[pos] != '\n') {
+            pos++;
+        }
+        pos++;
+    }
+    return count;
+}
+
+// Returns false if the file can't be cached and has to be read directly.
+static bool cache_update(void) {
+    if (cache.valid && cache.write_count == mp_vfs_blockdev_write_count) {
+        return true;
+    }
+    cache_clear();
+    cache.write_count = mp_vfs_blockdev_write_count;
+
     file_arg active_file;
-    if (!open_file(path, &active_file)) {
-        return GETENV_ERR_OPEN;
+    if (!open_file(GETENV_PATH, &active_file)) {
+        cache.file_found = false;
+        cache.valid = true;
+        return true;
+    }
+    size_t len = file_size(&active_file);
+    if (len > GETENV_CACHE_MAX_SIZE) {
+        close_file(&active_file);
+        return false;
     }
+    cache.text = cache_malloc(len + 1);
+    if (cache.text == NULL) {
+        close_file(&active_file);
+        return false;
+    }
+    cache.len = file_read(&active_file, cache.text, len);
+    close_file(&active_file);
+
+    size_t count = cache_index(NULL);
+    if (count > 0) {
+        cache.entries = cache_malloc(count * sizeof(cache_entry_t));
+        if (cache.entries == NULL) {
+            cache_clear();
+            return false;
+        }
+        cache_index(cache.entries);
+    }
+    cache.entry_count = count;
+
+    // Insertion sort keeps repeated keys in file order, so the first one is found like
+    // when reading the file. There are only a few dozen keys.
+    for (size_t i = 1; i < count; i++) {
+        cache_entry_t entry = cache.entries[i];
+        const char *key = (const char *)cache.text + entry.key;
+        size_t j = i;
+        while (j > 0 && compare_key(&cache.entries[j - 1], key, entry.key_len) > 0) {
+            cache.entries[j] = cache.entries[j - 1];
+            j--;
+        }
+        cache.entries[j] = entry;
+    }
+
+    cache.file_found = true;
+    cache.valid = true;
+    return true;
+}
 
+static os_getenv_err_t os_getenv_scan(source_t *source, const char *key, vstr_t *buf, bool *quoted) {
     os_getenv_err_t result = GETENV_ERR_NOT_FOUND;
-    while (!is_eof(&active_file)) {
-        if (key_matches(&active_file, key)) {
-            result = read_value(&active_file, buf, quoted);
+    while (!is_eof(source)) {
+        if (key_matches(source, key)) {
+            result = read_value(source, buf, quoted);
             break;
         }
     }
+    return result;
+}
+
+static os_getenv_err_t cache_lookup(const char *key, vstr_t *buf, bool *quoted) {
+    if (!cache.file_found) {
+        return GETENV_ERR_OPEN;
+    }
+    source_t source = { .text = cache.text, .len = cache.len };
+    size_t key_len = strlen(key);
+    for (size_t i = 0; i < key_len; i++) {
+        if (!is_key_byte(key[i])) {
+            // The index can't hold this key, but the file might.
+            return os_getenv_scan(&source, key, buf, quoted);
+        }
+    }
+
+    // Find the first entry that isn't less than key.
+    size_t lo = 0;
+    size_t hi = cache.entry_count;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (compare_key(&cache.entries[mid], key, key_len) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == cache.entry_count || compare_key(&cache.entries[lo], key, key_len) != 0) {
+        return GETENV_ERR_NOT_FOUND;
+    }
+    source.pos = cache.entries[lo].value;
+    return read_value(&source, buf, quoted);
+}
+
+static os_getenv_err_t os_getenv_vstr(const char *path, const char *key, vstr_t *buf, bool *quoted) {
+    if (strcmp(path, GETENV_PATH) == 0 && cache_update()) {
+        return cache_lookup(key, buf, quoted);
+    }
+
+    file_arg active_file;
+    if (!open_file(path, &active_file)) {
+        return GETENV_ERR_OPEN;
+    }
+    source_t source = { .file = &active_file };
+    os_getenv_err_t result = os_getenv_scan(&source, key, buf, quoted);
     close_file(&active_file);
     return result;
 }
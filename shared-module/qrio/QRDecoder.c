@@ -12,9 +12,25 @@
 #include "shared-bindings/qrio/QRInfo.h"
 #include "shared-module/qrio/QRDecoder.h"
 
-void shared_module_qrio_qrdecoder_construct(qrdecoder_qrdecoder_obj_t *self, int width, int height) {
+// Tracking starts again with a full-frame scan after this many frames
+// inside the region of interest, so that new codes elsewhere are noticed.
+#ifndef QRIO_TRACK_MAX_FRAMES
+#define QRIO_TRACK_MAX_FRAMES (30)
+#endif
+
+static void resize_tracker(qrdecoder_qrdecoder_obj_t *self, int width, int height) {
+    self->locked = false;
+    if (self->tracker) {
+        quirc_resize(self->tracker, (width + 1) / 2, (height + 1) / 2);
+    }
+}
+
+void shared_module_qrio_qrdecoder_construct(qrdecoder_qrdecoder_obj_t *self, int width, int height, bool track) {
     self->quirc = quirc_new();
     quirc_resize(self->quirc, width, height);
+    self->tracker = track ? quirc_new() : NULL;
+    self->frames_tracked = 0;
+    resize_tracker(self, width, height);
 }
 
 int shared_module_qrio_qrdecoder_get_height(qrdecoder_qrdecoder_obj_t *self) {
@@ -32,6 +48,7 @@ void shared_module_qrio_qrdecoder_set_height(qrdecoder_qrdecoder_obj_t *self, in
     if (height != shared_module_qrio_qrdecoder_get_height(self)) {
         int width = shared_module_qrio_qrdecoder_get_width(self);
         quirc_resize(self->quirc, width, height);
+        resize_tracker(self, width, height);
     }
 }
 
@@ -39,6 +56,7 @@ void shared_module_qrio_qrdecoder_set_width(qrdecoder_qrdecoder_obj_t *self, int
     if (width != shared_module_qrio_qrdecoder_get_width(self)) {
         int height = shared_module_qrio_qrdecoder_get_height(self);
         quirc_resize(self->quirc, width, height);
+        resize_tracker(self, width, height);
     }
 }
 
@@ -78,50 +96,156 @@ static mp_obj_t data_type(int type) {
     return mp_obj_new_int(type);
 }
 
-static void quirc_fill_buffer(qrdecoder_qrdecoder_obj_t *self, void *buf, qrio_pixel_policy_t policy) {
+// Convert pixels from the input buffer (src_width by src_height) into the
+// quirc image q, starting at (x0, y0) and sampling every step'th pixel and
+// row. Whatever falls outside the input is filled with white.
+static void quirc_fill_buffer(struct quirc *q, const void *buf, int src_width, int src_height,
+    qrio_pixel_policy_t policy, int x0, int y0, int step) {
     int width, height;
-    uint8_t *framebuffer = quirc_begin(self->quirc, &width, &height);
-    uint8_t *src = buf;
-
-    switch (policy) {
-        case QRIO_RGB565: {
-            uint16_t *src16 = buf;
-            for (int i = 0; i < width * height; i++) {
-                framebuffer[i] = (src16[i] >> 3) & 0xfc;
-            }
-            break;
+    uint8_t *framebuffer = quirc_begin(q, &width, &height);
+
+    int n = MIN(width, (src_width - x0 + step - 1) / step);
+    for (int y = 0; y < height; y++) {
+        uint8_t *dest = framebuffer + y * width;
+        int sy = y0 + y * step;
+        if (sy >= src_height) {
+            memset(dest, 255, width);
+            continue;
         }
-        case QRIO_RGB565_SWAPPED: {
-            uint16_t *src16 = buf;
-            for (int i = 0; i < width * height; i++) {
-                framebuffer[i] = (__builtin_bswap16(src16[i]) >> 3) & 0xfc;
+        size_t offset = (size_t)sy * src_width + x0;
+        switch (policy) {
+            case QRIO_RGB565: {
+                const uint16_t *src16 = (const uint16_t *)buf + offset;
+                for (int i = 0; i < n; i++) {
+                    dest[i] = (src16[i * step] >> 3) & 0xfc;
+                }
+                break;
+            }
+            case QRIO_RGB565_SWAPPED: {
+                const uint16_t *src16 = (const uint16_t *)buf + offset;
+                for (int i = 0; i < n; i++) {
+                    dest[i] = (__builtin_bswap16(src16[i * step]) >> 3) & 0xfc;
+                }
+                break;
+            }
+            case QRIO_EVERY_BYTE: {
+                const uint8_t *src = (const uint8_t *)buf + offset;
+                if (step == 1) {
+                    memcpy(dest, src, n);
+                } else {
+                    for (int i = 0; i < n; i++) {
+                        dest[i] = src[i * step];
+                    }
+                }
+                break;
+            }
+            case QRIO_ODD_BYTES:
+            case QRIO_EVEN_BYTES: {
+                const uint8_t *src = (const uint8_t *)buf + 2 * offset + (policy == QRIO_ODD_BYTES);
+                for (int i = 0; i < n; i++) {
+                    dest[i] = src[2 * i * step];
+                }
+                break;
             }
-            break;
         }
-        case QRIO_EVERY_BYTE:
-            memcpy(framebuffer, src, width * height);
-            break;
+        memset(dest + n, 255, width - n);
+    }
+    quirc_end(q);
+}
 
-        case QRIO_ODD_BYTES:
-            src++;
-            MP_FALLTHROUGH;
+// Scan the frame and return the decoder that holds the results. When
+// tracking, the region around the last codes found is tried first; the
+// whole frame is scanned only when nothing is found there.
+static struct quirc *qrdecoder_scan(qrdecoder_qrdecoder_obj_t *self, const mp_buffer_info_t *bufinfo, qrio_pixel_policy_t policy) {
+    int width, height;
+    quirc_begin(self->quirc, &width, &height);
 
-        case QRIO_EVEN_BYTES:
-            for (int i = 0; i < width * height; i++) {
-                framebuffer[i] = src[2 * i];
-            }
-            break;
+    if (self->locked) {
+        quirc_fill_buffer(self->tracker, bufinfo->buf, width, height, policy, self->roi_x, self->roi_y, self->roi_step);
+        if (quirc_count(self->tracker) > 0) {
+            return self->tracker;
+        }
+        self->locked = false;
+    }
+
+    self->roi_x = self->roi_y = 0;
+    self->roi_step = 1;
+    quirc_fill_buffer(self->quirc, bufinfo->buf, width, height, policy, 0, 0, 1);
+    return self->quirc;
+}
+
+// Map the corners of the code just extracted back to input pixel coordinates.
+static void qrdecoder_map_corners(qrdecoder_qrdecoder_obj_t *self) {
+    for (int i = 0; i < 4; i++) {
+        self->code.corners[i].x = self->roi_x + self->code.corners[i].x * self->roi_step;
+        self->code.corners[i].y = self->roi_y + self->code.corners[i].y * self->roi_step;
     }
-    quirc_end(self->quirc);
 }
 
+// Choose the region for the tracker to look at in the next frame: the
+// bounding box of the codes found, padded by half its size on every side
+// to allow for motion. Large codes are sampled at half resolution; if the
+// region does not fit the tracker, the next frame is a full scan.
+static void qrdecoder_update_tracking(qrdecoder_qrdecoder_obj_t *self, struct quirc *q, int count) {
+    if (!self->tracker) {
+        return;
+    }
+    if (count == 0 || (q == self->tracker && ++self->frames_tracked >= QRIO_TRACK_MAX_FRAMES)) {
+        self->locked = false;
+        return;
+    }
+    if (q != self->tracker) {
+        self->frames_tracked = 0;
+    }
+
+    int width, height, tracker_width, tracker_height;
+    quirc_begin(self->quirc, &width, &height);
+    quirc_begin(self->tracker, &tracker_width, &tracker_height);
+
+    int x1 = width, y1 = height, x2 = 0, y2 = 0, min_module = width;
+    for (int i = 0; i < count; i++) {
+        quirc_extract(q, i, &self->code);
+        qrdecoder_map_corners(self);
+        int cx1 = width, cy1 = height, cx2 = 0, cy2 = 0;
+        for (int j = 0; j < 4; j++) {
+            cx1 = MIN(cx1, self->code.corners[j].x);
+            cy1 = MIN(cy1, self->code.corners[j].y);
+            cx2 = MAX(cx2, self->code.corners[j].x);
+            cy2 = MAX(cy2, self->code.corners[j].y);
+        }
+        if (self->code.size > 0) {
+            min_module = MIN(min_module, MIN(cx2 - cx1, cy2 - cy1) / self->code.size);
+        }
+        x1 = MIN(x1, cx1);
+        y1 = MIN(y1, cy1);
+        x2 = MAX(x2, cx2);
+        y2 = MAX(y2, cy2);
+    }
+
+    int pad_x = (x2 - x1) / 2, pad_y = (y2 - y1) / 2;
+    x1 = MAX(0, x1 - pad_x);
+    y1 = MAX(0, y1 - pad_y);
+    x2 = MIN(width, x2 + pad_x);
+    y2 = MIN(height, y2 + pad_y);
+
+    // Sampling every other pixel keeps at least 2 pixels per module.
+    int step = min_module >= 4 ? 2 : 1;
+    if (x2 <= x1 || y2 <= y1 || (x2 - x1) > tracker_width * step || (y2 - y1) > tracker_height * step) {
+        self->locked = false;
+        return;
+    }
+    self->roi_x = x1;
+    self->roi_y = y1;
+    self->roi_step = step;
+    self->locked = true;
+}
 
 mp_obj_t shared_module_qrio_qrdecoder_decode(qrdecoder_qrdecoder_obj_t *self, const mp_buffer_info_t *bufinfo, qrio_pixel_policy_t policy) {
-    quirc_fill_buffer(self, bufinfo->buf, policy);
-    int count = quirc_count(self->quirc);
+    struct quirc *q = qrdecoder_scan(self, bufinfo, policy);
+    int count = quirc_count(q);
     mp_obj_t result = mp_obj_new_list(0, NULL);
     for (int i = 0; i < count; i++) {
-        quirc_extract(self->quirc, i, &self->code);
+        quirc_extract(q, i, &self->code);
         mp_obj_t code_obj;
         if (quirc_decode(&self->code, &self->data) != QUIRC_SUCCESS) {
             continue;
@@ -133,16 +257,18 @@ mp_obj_t shared_module_qrio_qrdecoder_decode(qrdecoder_qrdecoder_obj_t *self, co
         code_obj = namedtuple_make_new((const mp_obj_type_t *)&qrio_qrinfo_type_obj, 2, 0, elems);
         mp_obj_list_append(result, code_obj);
     }
+    qrdecoder_update_tracking(self, q, count);
     return result;
 }
 
 
 mp_obj_t shared_module_qrio_qrdecoder_find(qrdecoder_qrdecoder_obj_t *self, const mp_buffer_info_t *bufinfo, qrio_pixel_policy_t policy) {
-    quirc_fill_buffer(self, bufinfo->buf, policy);
-    int count = quirc_count(self->quirc);
+    struct quirc *q = qrdecoder_scan(self, bufinfo, policy);
+    int count = quirc_count(q);
     mp_obj_t result = mp_obj_new_list(0, NULL);
     for (int i = 0; i < count; i++) {
-        quirc_extract(self->quirc, i, &self->code);
+        quirc_extract(q, i, &self->code);
+        qrdecoder_map_corners(self);
         mp_obj_t code_obj;
         mp_obj_t elems[9] = {
             mp_obj_new_int(self->code.corners[0].x),
@@ -158,5 +284,6 @@ mp_obj_t shared_module_qrio_qrdecoder_find(qrdecoder_qrdecoder_obj_t *self, cons
         code_obj = namedtuple_make_new((const mp_obj_type_t *)&qrio_qrposition_type_obj, 9, 0, elems);
         mp_obj_list_append(result, code_obj);
     }
+    qrdecoder_update_tracking(self, q, count);
     return result;
 }
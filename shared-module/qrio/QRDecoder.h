@@ -13,11 +13,20 @@
 typedef struct qrio_qrdecoder_obj {
     mp_obj_base_t base;
     struct quirc *quirc;
+    // With tracking enabled, frames after a successful scan are first
+    // scanned only in a region around the last codes found, using this
+    // smaller decoder at up to half resolution.
+    struct quirc *tracker;
     struct quirc_code code;
     struct quirc_data data;
+    // The region in input pixels that the tracker looks at, and the step
+    // between the input pixels it samples.
+    int roi_x, roi_y, roi_step;
+    int frames_tracked;
+    bool locked;
 } qrdecoder_qrdecoder_obj_t;
 
-void shared_module_qrio_qrdecoder_construct(qrdecoder_qrdecoder_obj_t *, int width, int height);
+void shared_module_qrio_qrdecoder_construct(qrdecoder_qrdecoder_obj_t *, int width, int height, bool track);
 int shared_module_qrio_qrdecoder_get_height(qrdecoder_qrdecoder_obj_t *);
 int shared_module_qrio_qrdecoder_get_width(qrdecoder_qrdecoder_obj_t *);
 void shared_module_qrio_qrdecoder_set_height(qrdecoder_qrdecoder_obj_t *, int height);
@@ -37,6 +37,8 @@ void common_hal_rgbmatrix_rgbmatrix_construct(rgbmatrix_rgbmatrix_obj_t *self, i
     self->doublebuffer = doublebuffer;
     self->tile = tile;
     self->serpentine = serpentine;
+    self->background_refresh = false;
+    self->refresh_pending = false;
 
     self->timer = timer ? timer : common_hal_rgbmatrix_timer_allocate(self);
     if (self->timer == NULL) {
@@ -130,6 +132,7 @@ static void free_pin_seq(uint8_t *seq, int count) {
 extern int pm_row_count;
 static void common_hal_rgbmatrix_rgbmatrix_deinit1(rgbmatrix_rgbmatrix_obj_t *self) {
     common_hal_rgbmatrix_timer_disable(self->timer);
+    self->refresh_pending = false;
 
     if (_PM_protoPtr == &self->protomatter) {
         _PM_protoPtr = NULL;
@@ -209,13 +212,63 @@ bool common_hal_rgbmatrix_rgbmatrix_get_paused(rgbmatrix_rgbmatrix_obj_t *self)
     return self->paused;
 }
 
-void common_hal_rgbmatrix_rgbmatrix_refresh(rgbmatrix_rgbmatrix_obj_t *self) {
-    if (!self->paused) {
+static void rgbmatrix_rgbmatrix_convert(rgbmatrix_rgbmatrix_obj_t *self) {
+    self->refresh_pending = false;
+    // The matrix may have been paused or deinited since the refresh was queued.
+    if (!self->paused && self->bufinfo.buf != NULL) {
         _PM_convert_565(&self->protomatter, self->bufinfo.buf, self->width);
         _PM_swapbuffer_maybe(&self->protomatter);
     }
 }
 
+static void rgbmatrix_rgbmatrix_refresh_callback(void *self_in) {
+    rgbmatrix_rgbmatrix_obj_t *self = self_in;
+    if (self->refresh_pending) {
+        rgbmatrix_rgbmatrix_convert(self);
+    }
+}
+
+void common_hal_rgbmatrix_rgbmatrix_refresh(rgbmatrix_rgbmatrix_obj_t *self) {
+    if (self->paused) {
+        return;
+    }
+    if (self->background_refresh) {
+        self->refresh_pending = true;
+        background_callback_add(&self->refresh_callback, rgbmatrix_rgbmatrix_refresh_callback, self);
+        return;
+    }
+    rgbmatrix_rgbmatrix_convert(self);
+}
+
+void common_hal_rgbmatrix_rgbmatrix_refresh_rows(rgbmatrix_rgbmatrix_obj_t *self, const uint8_t *dirty_row_bitmap) {
+    // Protomatter only converts whole frames, but when displayio didn't change
+    // any rows there is nothing to convert at all.
+    if (dirty_row_bitmap != NULL) {
+        int height = common_hal_rgbmatrix_rgbmatrix_get_height(self);
+        bool dirty = false;
+        for (int i = 0; i < (height + 7) / 8 && !dirty; i++) {
+            dirty = dirty_row_bitmap[i] != 0;
+        }
+        if (!dirty) {
+            return;
+        }
+    }
+    common_hal_rgbmatrix_rgbmatrix_refresh(self);
+}
+
+void common_hal_rgbmatrix_rgbmatrix_set_background_refresh(rgbmatrix_rgbmatrix_obj_t *self, bool background_refresh) {
+    self->background_refresh = background_refresh;
+    // Don't leave a queued refresh waiting for a callback that may be a
+    // long way off.
+    if (!background_refresh && self->refresh_pending) {
+        rgbmatrix_rgbmatrix_convert(self);
+    }
+}
+
+bool common_hal_rgbmatrix_rgbmatrix_get_background_refresh(rgbmatrix_rgbmatrix_obj_t *self) {
+    return self->background_refresh;
+}
+
 int common_hal_rgbmatrix_rgbmatrix_get_width(rgbmatrix_rgbmatrix_obj_t *self) {
     return self->width;
 }
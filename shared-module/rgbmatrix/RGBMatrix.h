@@ -8,6 +8,7 @@
 
 #include "py/obj.h"
 #include "lib/protomatter/src/core.h"
+#include "supervisor/background_callback.h"
 
 extern const mp_obj_type_t rgbmatrix_RGBMatrix_type;
 typedef struct {
@@ -27,5 +28,10 @@ typedef struct {
     bool paused;
     bool doublebuffer;
     bool serpentine;
+    // Convert the framebuffer to bitplanes in a background callback instead
+    // of during refresh. Refreshes before it runs are coalesced.
+    bool background_refresh;
+    bool refresh_pending;
     int8_t tile;
+    background_callback_t refresh_callback;
 } rgbmatrix_rgbmatrix_obj_t;
@@ -8,6 +8,7 @@
 #include "shared-bindings/rotaryio/IncrementalEncoder.h"
 #include "shared-module/rotaryio/IncrementalEncoder.h"
 #include "common-hal/rotaryio/IncrementalEncoder.h"
+#include "shared-bindings/microcontroller/__init__.h"
 
 void shared_module_softencoder_state_init(rotaryio_incrementalencoder_obj_t *self, uint8_t quiescent_state) {
     self->state = quiescent_state;
@@ -46,9 +47,11 @@ void shared_module_softencoder_state_update(rotaryio_incrementalencoder_obj_t *s
     if (self->sub_count >= self->divisor) {
         self->position += 1;
         self->sub_count = 0;
+        rotaryio_velocity_update(&self->velocity, self->position);
     } else if (self->sub_count <= -self->divisor) {
         self->position -= 1;
         self->sub_count = 0;
+        rotaryio_velocity_update(&self->velocity, self->position);
     }
 }
 
@@ -57,7 +60,18 @@ mp_int_t common_hal_rotaryio_incrementalencoder_get_position(rotaryio_incrementa
 }
 
 void common_hal_rotaryio_incrementalencoder_set_position(rotaryio_incrementalencoder_obj_t *self, mp_int_t position) {
+    common_hal_mcu_disable_interrupts();
     self->position = position;
+    rotaryio_velocity_reset(&self->velocity, position);
+    common_hal_mcu_enable_interrupts();
+}
+
+mp_float_t common_hal_rotaryio_incrementalencoder_get_velocity(rotaryio_incrementalencoder_obj_t *self) {
+    // Steps are timed in the pin change interrupt.
+    common_hal_mcu_disable_interrupts();
+    rotaryio_velocity_t velocity = self->velocity;
+    common_hal_mcu_enable_interrupts();
+    return rotaryio_velocity_get(&velocity);
 }
 
 mp_int_t common_hal_rotaryio_incrementalencoder_get_divisor(rotaryio_incrementalencoder_obj_t *self) {
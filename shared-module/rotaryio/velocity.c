@@ -0,0 +1,51 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "shared-module/rotaryio/velocity.h"
+#include "shared-bindings/time/__init__.h"
+
+// With no step for this long, the encoder is taken to be stopped.
+#define STOPPED_NS (1000000000LL)
+
+void rotaryio_velocity_reset(rotaryio_velocity_t *self, mp_int_t position) {
+    self->last_change_ns = common_hal_time_monotonic_ns();
+    self->period_ns = 0;
+    self->last_position = position;
+}
+
+void rotaryio_velocity_update(rotaryio_velocity_t *self, mp_int_t position) {
+    mp_int_t steps = position - self->last_position;
+    if (steps == 0) {
+        return;
+    }
+    uint64_t now = common_hal_time_monotonic_ns();
+    int64_t elapsed = now - self->last_change_ns;
+    self->period_ns = elapsed / steps;
+    if (self->period_ns == 0) {
+        // Faster than the clock can tell apart.
+        self->period_ns = steps > 0 ? 1 : -1;
+    }
+    self->last_change_ns = now;
+    self->last_position = position;
+}
+
+mp_float_t rotaryio_velocity_get(const rotaryio_velocity_t *self) {
+    if (self->period_ns == 0) {
+        return 0;
+    }
+    int64_t elapsed = common_hal_time_monotonic_ns() - self->last_change_ns;
+    if (elapsed >= STOPPED_NS) {
+        return 0;
+    }
+    // When the next step is later than the last period, the encoder is at
+    // most this fast, so slow down smoothly instead of holding the old speed.
+    int64_t period = self->period_ns > 0 ? self->period_ns : -self->period_ns;
+    if (elapsed > period) {
+        period = elapsed;
+    }
+    mp_float_t velocity = (mp_float_t)1e9 / (mp_float_t)period;
+    return self->period_ns > 0 ? velocity : -velocity;
+}
@@ -0,0 +1,26 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdint.h>
+
+#include "py/obj.h"
+
+// Estimates speed from the times at which the position changes. Encoders
+// decoded in software update it on every step. Ports that count in hardware
+// update it whenever the position is read.
+typedef struct {
+    uint64_t last_change_ns;
+    // Time per step when the position last changed, negative when going
+    // backwards, and 0 when stopped.
+    int64_t period_ns;
+    mp_int_t last_position;
+} rotaryio_velocity_t;
+
+void rotaryio_velocity_reset(rotaryio_velocity_t *self, mp_int_t position);
+void rotaryio_velocity_update(rotaryio_velocity_t *self, mp_int_t position);
+mp_float_t rotaryio_velocity_get(const rotaryio_velocity_t *self);
@@ -111,6 +111,11 @@ static int exit_cmd25(sdcardio_sdcard_obj_t *self) {
     if (self->in_cmd25) {
         DEBUG_PRINT("exit cmd25\n");
         self->in_cmd25 = false;
+        // The card may still be programming the last block.
+        int r = wait_for_ready(self);
+        if (r < 0) {
+            return r;
+        }
         return cmd_nodata(self, TOKEN_STOP_TRAN, 0);
     }
     return 0;
@@ -328,11 +333,21 @@ int common_hal_sdcardio_sdcard_get_blockcount(sdcardio_sdcard_obj_t *self) {
 }
 
 static int readinto(sdcardio_sdcard_obj_t *self, void *buf, size_t size) {
-    uint8_t aux[2] = {0, 0};
-    while (aux[0] != 0xfe) {
+    // Wait for the start block token. The card sends 0xff while it fetches
+    // the block, or an error token (0b0000xxxx) if it can't.
+    uint8_t aux[2] = {0xff, 0xff};
+    uint64_t deadline = common_hal_time_monotonic_ns() + READY_TIMEOUT_NS;
+    do {
+        if (common_hal_time_monotonic_ns() >= deadline) {
+            return -ETIMEDOUT;
+        }
         common_hal_busio_spi_read(self->bus, aux, 1, 0xff);
+    } while (aux[0] == 0xff);
+    if (aux[0] != TOKEN_DATA) {
+        return -EIO;
     }
 
+    // Straight into the caller's buffer, which the port may DMA for us.
     common_hal_busio_spi_read(self->bus, buf, size, 0xff);
 
     // Read checksum and throw it away
@@ -349,7 +364,10 @@ mp_uint_t sdcardio_sdcard_readblocks(mp_obj_t self_in, uint8_t *buf, uint32_t st
     size_t buflen = 512 * nblocks;
     if (nblocks == 1) {
         //  Use CMD17 to read a single block
-        r = block_cmd(self, 17, start_block, buf, buflen, true, true);
+        r = block_cmd(self, 17, start_block, NULL, 0, true, true);
+        if (r == 0) {
+            r = readinto(self, buf, buflen);
+        }
     } else {
         //  Use CMD18 to read multiple blocks
         r = block_cmd(self, 18, start_block, NULL, 0, true, true);
@@ -424,10 +442,9 @@ static int _write(sdcardio_sdcard_obj_t *self, uint8_t token, void *buf, size_t
         }
     }
 
-    // Wait for the write to finish
-    do {
-        common_hal_busio_spi_read(self->bus, cmd, 1, 0xff);
-    } while (cmd[0] == 0);
+    // Don't wait here for the card to finish programming. The next block,
+    // command or stop token waits for ready first, so the caller gets to do
+    // other work (like preparing the next block) while the card is busy.
 
     // Success
     return 0;
@@ -483,10 +500,8 @@ int common_hal_sdcardio_sdcard_writeblocks(sdcardio_sdcard_obj_t *self, uint32_t
     if (buf->len % 512 != 0) {
         mp_raise_ValueError(MP_ERROR_TEXT("Buffer length must be a multiple of 512"));
     }
-    lock_and_configure_bus(self);
-    int r = sdcardio_sdcard_writeblocks(MP_OBJ_FROM_PTR(self), buf->buf, start_block, buf->len / 512);
-    extraclock_and_unlock_bus(self);
-    return r;
+    // sdcardio_sdcard_writeblocks takes the bus lock itself.
+    return sdcardio_sdcard_writeblocks(MP_OBJ_FROM_PTR(self), buf->buf, start_block, buf->len / 512);
 }
 
 bool sdcardio_sdcard_ioctl(mp_obj_t self_in, size_t cmd, size_t arg, mp_int_t *out_value) {
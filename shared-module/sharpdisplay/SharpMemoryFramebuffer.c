@@ -139,6 +139,8 @@ void common_hal_sharpdisplay_framebuffer_construct(
     common_hal_sharpdisplay_framebuffer_get_bufinfo(self, NULL);
 }
 
+#define ROW_CHANGED(y) (self->full_refresh || (dirty_row_bitmask[(y) / 8] & (1 << ((y) & 7))))
+
 static void common_hal_sharpdisplay_framebuffer_swapbuffers(sharpdisplay_framebuffer_obj_t *self, uint8_t *dirty_row_bitmask) {
     // claim SPI bus
     if (!common_hal_busio_spi_try_lock(self->bus)) {
@@ -155,13 +157,20 @@ static void common_hal_sharpdisplay_framebuffer_swapbuffers(sharpdisplay_framebu
 
     common_hal_busio_spi_write(self->bus, data++, 1);
 
-    // output each changed row
+    // output each changed row. Every row carries its own address, and rows
+    // are stored back to back, so a run of changed rows is one write.
     size_t row_stride = common_hal_sharpdisplay_framebuffer_get_row_stride(self);
-    for (int y = 0; y < self->height; y++) {
-        if (self->full_refresh || (dirty_row_bitmask[y / 8] & (1 << (y & 7)))) {
-            common_hal_busio_spi_write(self->bus, data, row_stride);
+    int y = 0;
+    while (y < self->height) {
+        if (!ROW_CHANGED(y)) {
+            y++;
+            continue;
+        }
+        int first_row = y;
+        while (y < self->height && ROW_CHANGED(y)) {
+            y++;
         }
-        data += row_stride;
+        common_hal_busio_spi_write(self->bus, data + first_row * row_stride, (y - first_row) * row_stride);
     }
 
     // output a trailing zero
@@ -0,0 +1,113 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "shared-module/socketpool/SocketPool.h"
+#include "supervisor/shared/tick.h"
+
+#if CIRCUITPY_SOCKETPOOL_DNS_CACHE_SIZE > 0
+
+typedef struct {
+    // When the address should be looked up again.
+    uint64_t expires_ms;
+    // Empty when the entry is unused.
+    char host[SOCKETPOOL_DNS_CACHE_HOST_LEN + 1];
+    char ip[SOCKETPOOL_DNS_CACHE_IP_LEN + 1];
+} dns_cache_entry_t;
+
+// Plain C memory, not the heap, so it lasts from one VM to the next.
+static dns_cache_entry_t dns_cache[CIRCUITPY_SOCKETPOOL_DNS_CACHE_SIZE];
+
+static dns_cache_entry_t *dns_cache_find(const char *host) {
+    for (size_t i = 0; i < CIRCUITPY_SOCKETPOOL_DNS_CACHE_SIZE; i++) {
+        if (strcmp(dns_cache[i].host, host) == 0) {
+            return &dns_cache[i];
+        }
+    }
+    return NULL;
+}
+
+static void dns_cache_store(dns_cache_entry_t *entry, const char *host, mp_obj_t ip_obj, uint64_t now) {
+    size_t ip_len;
+    const char *ip = mp_obj_str_get_data(ip_obj, &ip_len);
+    if (ip_len > SOCKETPOOL_DNS_CACHE_IP_LEN) {
+        return;
+    }
+    if (entry == NULL) {
+        // Take an unused entry, or else the one that expires first.
+        entry = &dns_cache[0];
+        for (size_t i = 0; i < CIRCUITPY_SOCKETPOOL_DNS_CACHE_SIZE; i++) {
+            if (dns_cache[i].host[0] == '\0') {
+                entry = &dns_cache[i];
+                break;
+            }
+            if (dns_cache[i].expires_ms < entry->expires_ms) {
+                entry = &dns_cache[i];
+            }
+        }
+        strcpy(entry->host, host);
+    }
+    memcpy(entry->ip, ip, ip_len);
+    entry->ip[ip_len] = '\0';
+    entry->expires_ms = now + CIRCUITPY_SOCKETPOOL_DNS_CACHE_SECONDS * 1000;
+}
+
+mp_obj_t socketpool_socketpool_gethostbyname_cached(socketpool_socketpool_obj_t *self, const char *host) {
+    size_t host_len = strlen(host);
+    if (host_len == 0 || host_len > SOCKETPOOL_DNS_CACHE_HOST_LEN) {
+        return common_hal_socketpool_socketpool_gethostbyname_raise(self, host);
+    }
+
+    uint64_t now = supervisor_ticks_ms64();
+    dns_cache_entry_t *entry = dns_cache_find(host);
+    if (entry != NULL && now < entry->expires_ms) {
+        return mp_obj_new_str(entry->ip, strlen(entry->ip));
+    }
+
+    mp_obj_t ip_obj;
+    if (entry == NULL) {
+        ip_obj = common_hal_socketpool_socketpool_gethostbyname_raise(self, host);
+    } else {
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            ip_obj = common_hal_socketpool_socketpool_gethostbyname_raise(self, host);
+            nlr_pop();
+        } else {
+            // Ride out a network that has stopped answering with the last
+            // known address. Anything but a lookup error, such as a
+            // KeyboardInterrupt, still goes through.
+            mp_obj_t exc = MP_OBJ_FROM_PTR(nlr.ret_val);
+            if (!mp_obj_is_subclass_fast(MP_OBJ_FROM_PTR(mp_obj_get_type(exc)), MP_OBJ_FROM_PTR(&mp_type_OSError))) {
+                nlr_jump(nlr.ret_val);
+            }
+            return mp_obj_new_str(entry->ip, strlen(entry->ip));
+        }
+    }
+    dns_cache_store(entry, host, ip_obj, now);
+    return ip_obj;
+}
+
+void socketpool_socketpool_clear_dns_cache(const char *host) {
+    for (size_t i = 0; i < CIRCUITPY_SOCKETPOOL_DNS_CACHE_SIZE; i++) {
+        if (host == NULL || strcmp(dns_cache[i].host, host) == 0) {
+            dns_cache[i].host[0] = '\0';
+            dns_cache[i].expires_ms = 0;
+        }
+    }
+}
+
+#else
+
+mp_obj_t socketpool_socketpool_gethostbyname_cached(socketpool_socketpool_obj_t *self, const char *host) {
+    return common_hal_socketpool_socketpool_gethostbyname_raise(self, host);
+}
+
+void socketpool_socketpool_clear_dns_cache(const char *host) {
+}
+
+#endif
@@ -0,0 +1,36 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+#include "shared-bindings/socketpool/SocketPool.h"
+
+// Number of host names whose addresses are remembered. 0 turns the cache off.
+#ifndef CIRCUITPY_SOCKETPOOL_DNS_CACHE_SIZE
+#define CIRCUITPY_SOCKETPOOL_DNS_CACHE_SIZE (4)
+#endif
+
+// Seconds an address is used before the name is looked up again. The network
+// stack keeps its own table that follows the record's TTL, so this only bounds
+// how stale an answer from this cache can be.
+#ifndef CIRCUITPY_SOCKETPOOL_DNS_CACHE_SECONDS
+#define CIRCUITPY_SOCKETPOOL_DNS_CACHE_SECONDS (60)
+#endif
+
+// Longer names are always looked up.
+#define SOCKETPOOL_DNS_CACHE_HOST_LEN (63)
+// Long enough for an IPv6 address.
+#define SOCKETPOOL_DNS_CACHE_IP_LEN (45)
+
+// Like common_hal_socketpool_socketpool_gethostbyname_raise() but answers from
+// the cache when it can. When a lookup fails, an expired address for the name
+// is returned instead of raising.
+mp_obj_t socketpool_socketpool_gethostbyname_cached(socketpool_socketpool_obj_t *self, const char *host);
+
+// Forget the address of host, or of every name when host is NULL.
+void socketpool_socketpool_clear_dns_cache(const char *host);
@@ -7,17 +7,70 @@
 #include "shared-bindings/ssl/SSLContext.h"
 #include "shared-bindings/ssl/SSLSocket.h"
 
+#include <string.h>
+
 #include "py/runtime.h"
 #include "py/stream.h"
 
 #include "lib/mbedtls_config/crt_bundle.h"
 
+#if CIRCUITPY_SSL_SESSION_CACHE_SIZE > 0
+// Find the cache entry for hostname, or claim the least recently used one
+// for it. The entry's hostname pointer identifies the claim, so a caller
+// can tell later whether the entry was evicted in the meantime.
+ssl_session_cache_entry_t *ssl_sslcontext_session_slot(ssl_sslcontext_obj_t *self, const char *hostname) {
+    ssl_session_cache_entry_t *victim = &self->session_cache[0];
+    for (size_t i = 0; i < CIRCUITPY_SSL_SESSION_CACHE_SIZE; i++) {
+        ssl_session_cache_entry_t *entry = &self->session_cache[i];
+        if (entry->hostname != NULL && strcmp(entry->hostname, hostname) == 0) {
+            entry->last_used = ++self->session_clock;
+            return entry;
+        }
+        if (entry->hostname == NULL) {
+            if (victim->hostname != NULL) {
+                victim = entry;
+            }
+        } else if (victim->hostname != NULL && entry->last_used < victim->last_used) {
+            victim = entry;
+        }
+    }
+
+    size_t hostname_len = strlen(hostname) + 1;
+    char *copy = m_new(char, hostname_len);
+    memcpy(copy, hostname, hostname_len);
+    m_free(victim->data);
+    victim->hostname = copy;
+    victim->data = NULL;
+    victim->len = 0;
+    victim->last_used = ++self->session_clock;
+    return victim;
+}
+
+// Forget every cached session, e.g. because the trust settings changed and
+// a session verified under the old ones must not be resumed.
+void ssl_sslcontext_session_clear(ssl_sslcontext_obj_t *self) {
+    for (size_t i = 0; i < CIRCUITPY_SSL_SESSION_CACHE_SIZE; i++) {
+        ssl_session_cache_entry_t *entry = &self->session_cache[i];
+        m_free(entry->hostname);
+        m_free(entry->data);
+        *entry = (ssl_session_cache_entry_t) {0};
+    }
+}
+#endif
+
 void common_hal_ssl_sslcontext_construct(ssl_sslcontext_obj_t *self) {
+    #if CIRCUITPY_SSL_SESSION_CACHE_SIZE > 0
+    memset(self->session_cache, 0, sizeof(self->session_cache));
+    self->session_clock = 0;
+    #endif
     common_hal_ssl_sslcontext_set_default_verify_paths(self);
 }
 
 void common_hal_ssl_sslcontext_load_verify_locations(ssl_sslcontext_obj_t *self,
     const char *cadata) {
+    #if CIRCUITPY_SSL_SESSION_CACHE_SIZE > 0
+    ssl_sslcontext_session_clear(self);
+    #endif
     self->crt_bundle_attach = NULL;
     self->use_global_ca_store = false;
     self->cacert_buf = (const unsigned char *)cadata;
@@ -25,6 +78,9 @@ void common_hal_ssl_sslcontext_load_verify_locations(ssl_sslcontext_obj_t *self,
 }
 
 void common_hal_ssl_sslcontext_set_default_verify_paths(ssl_sslcontext_obj_t *self) {
+    #if CIRCUITPY_SSL_SESSION_CACHE_SIZE > 0
+    ssl_sslcontext_session_clear(self);
+    #endif
     self->crt_bundle_attach = crt_bundle_attach;
     self->use_global_ca_store = true;
     self->cacert_buf = NULL;
@@ -40,6 +96,9 @@ void common_hal_ssl_sslcontext_set_check_hostname(ssl_sslcontext_obj_t *self, bo
 }
 
 void common_hal_ssl_sslcontext_load_cert_chain(ssl_sslcontext_obj_t *self, mp_buffer_info_t *cert_buf, mp_buffer_info_t *key_buf) {
+    #if CIRCUITPY_SSL_SESSION_CACHE_SIZE > 0
+    ssl_sslcontext_session_clear(self);
+    #endif
     self->cert_buf = *cert_buf;
     self->key_buf = *key_buf;
 }
@@ -10,6 +10,26 @@
 #include "py/obj.h"
 #include "mbedtls/ssl.h"
 
+// Number of client sessions remembered per SSLContext for resumption.
+// Set to 0 to disable the cache.
+#ifndef CIRCUITPY_SSL_SESSION_CACHE_SIZE
+#define CIRCUITPY_SSL_SESSION_CACHE_SIZE (4)
+#endif
+
+// Sessions that serialize to more than this are not cached.
+#ifndef CIRCUITPY_SSL_SESSION_MAX_BYTES
+#define CIRCUITPY_SSL_SESSION_MAX_BYTES (2048)
+#endif
+
+// A session is kept in its serialized (mbedtls_ssl_session_save) form, so
+// that the cache only holds plain heap buffers and needs no finaliser.
+typedef struct {
+    char *hostname;
+    uint8_t *data;
+    size_t len;
+    uint32_t last_used;
+} ssl_session_cache_entry_t;
+
 typedef struct {
     mp_obj_base_t base;
     bool check_name, use_global_ca_store;
@@ -17,4 +37,13 @@ typedef struct {
     size_t cacert_bytes;
     int (*crt_bundle_attach)(mbedtls_ssl_config *conf);
     mp_buffer_info_t cert_buf, key_buf;
+    #if CIRCUITPY_SSL_SESSION_CACHE_SIZE > 0
+    ssl_session_cache_entry_t session_cache[CIRCUITPY_SSL_SESSION_CACHE_SIZE];
+    uint32_t session_clock;
+    #endif
 } ssl_sslcontext_obj_t;
+
+#if CIRCUITPY_SSL_SESSION_CACHE_SIZE > 0
+ssl_session_cache_entry_t *ssl_sslcontext_session_slot(ssl_sslcontext_obj_t *self, const char *hostname);
+void ssl_sslcontext_session_clear(ssl_sslcontext_obj_t *self);
+#endif
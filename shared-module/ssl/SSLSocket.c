@@ -19,6 +19,9 @@
 #include "supervisor/shared/tick.h"
 
 #include "shared-bindings/socketpool/enum.h"
+#if CIRCUITPY_SOCKETPOOL
+#include "shared-bindings/socketpool/Socket.h"
+#endif
 
 #include "mbedtls/version.h"
 
@@ -109,6 +112,21 @@ static int call_method_errno(size_t n_args, const mp_obj_t *args) {
 }
 
 static int ssl_socket_send(ssl_sslsocket_obj_t *self, const byte *buf, size_t len) {
+    #if CIRCUITPY_SOCKETPOOL
+    // A native socket can be driven directly, without building a memoryview
+    // and dispatching through the Python-level method on every record.
+    if (self->native_sock != NULL) {
+        socketpool_socket_obj_t *sock = self->native_sock;
+        if (common_hal_socketpool_socket_get_closed(sock)) {
+            return -MP_EBADF;
+        }
+        if (!common_hal_socketpool_socket_get_connected(sock)) {
+            return -MP_EPIPE;
+        }
+        return socketpool_socket_send(sock, buf, len);
+    }
+    #endif
+
     mp_obj_array_t mv;
     mp_obj_memoryview_init(&mv, 'B', 0, len, (void *)buf);
 
@@ -117,6 +135,19 @@ static int ssl_socket_send(ssl_sslsocket_obj_t *self, const byte *buf, size_t le
 }
 
 static int ssl_socket_recv_into(ssl_sslsocket_obj_t *self, byte *buf, size_t len) {
+    #if CIRCUITPY_SOCKETPOOL
+    if (self->native_sock != NULL) {
+        socketpool_socket_obj_t *sock = self->native_sock;
+        if (common_hal_socketpool_socket_get_closed(sock)) {
+            return -MP_EBADF;
+        }
+        if (len == 0) {
+            return 0;
+        }
+        return socketpool_socket_recv_into(sock, buf, len);
+    }
+    #endif
+
     mp_obj_array_t mv;
     mp_obj_memoryview_init(&mv, 'B' | MP_OBJ_ARRAY_TYPECODE_FLAG_RW, 0, len, buf);
 
@@ -220,6 +251,20 @@ ssl_sslsocket_obj_t *common_hal_ssl_sslcontext_wrap_socket(ssl_sslcontext_obj_t
     o->base.type = &ssl_sslsocket_type;
     o->ssl_context = self;
     o->sock_obj = socket;
+    #if CIRCUITPY_SOCKETPOOL
+    o->native_sock = mp_obj_is_type(socket, &socketpool_socket_type) ? MP_OBJ_TO_PTR(socket) : NULL;
+    #endif
+
+    #if CIRCUITPY_SSL_SESSION_CACHE_SIZE > 0
+    // Claim the cache entry before any mbedtls state exists, since this can
+    // raise MemoryError.
+    o->session_entry = NULL;
+    o->session_hostname = NULL;
+    if (!server_side && server_hostname != NULL) {
+        o->session_entry = ssl_sslcontext_session_slot(self, server_hostname);
+        o->session_hostname = o->session_entry->hostname;
+    }
+    #endif
 
     mp_load_method(socket, MP_QSTR_accept, o->accept_args);
     mp_load_method(socket, MP_QSTR_bind, o->bind_args);
@@ -288,6 +333,23 @@ ssl_sslsocket_obj_t *common_hal_ssl_sslcontext_wrap_socket(ssl_sslcontext_obj_t
         }
     }
 
+    #if CIRCUITPY_SSL_SESSION_CACHE_SIZE > 0
+    if (o->session_entry != NULL && o->session_entry->data != NULL) {
+        ssl_session_cache_entry_t *entry = o->session_entry;
+        mbedtls_ssl_session session;
+        mbedtls_ssl_session_init(&session);
+        if (mbedtls_ssl_session_load(&session, entry->data, entry->len) != 0
+            || mbedtls_ssl_set_session(&o->ssl, &session) != 0) {
+            // Not usable (e.g. saved by a differently configured build);
+            // fall back to a full handshake.
+            m_free(entry->data);
+            entry->data = NULL;
+            entry->len = 0;
+        }
+        mbedtls_ssl_session_free(&session);
+    }
+    #endif
+
     mbedtls_ssl_set_bio(&o->ssl, o, _mbedtls_ssl_send, _mbedtls_ssl_recv, NULL);
 
     if (self->cert_buf.buf != NULL) {
@@ -376,6 +438,51 @@ void common_hal_ssl_sslsocket_close(ssl_sslsocket_obj_t *self) {
     mbedtls_entropy_free(&self->entropy);
 }
 
+#if CIRCUITPY_SSL_SESSION_CACHE_SIZE > 0
+static ssl_session_cache_entry_t *ssl_socket_session_entry(ssl_sslsocket_obj_t *self) {
+    ssl_session_cache_entry_t *entry = self->session_entry;
+    if (entry == NULL || entry->hostname != self->session_hostname) {
+        return NULL;
+    }
+    return entry;
+}
+
+// Remember the negotiated session so the next connection to this hostname
+// through the same context can resume it instead of doing a full handshake.
+static void ssl_socket_save_session(ssl_sslsocket_obj_t *self) {
+    ssl_session_cache_entry_t *entry = ssl_socket_session_entry(self);
+    if (entry == NULL) {
+        return;
+    }
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    if (mbedtls_ssl_get_session(&self->ssl, &session) == 0) {
+        size_t len = 0;
+        mbedtls_ssl_session_save(&session, NULL, 0, &len);
+        if (len > 0 && len <= CIRCUITPY_SSL_SESSION_MAX_BYTES) {
+            uint8_t *data = m_new_maybe(uint8_t, len);
+            if (data != NULL && mbedtls_ssl_session_save(&session, data, len, &len) == 0) {
+                m_free(entry->data);
+                entry->data = data;
+                entry->len = len;
+            } else {
+                m_free(data);
+            }
+        }
+    }
+    mbedtls_ssl_session_free(&session);
+}
+
+static void ssl_socket_forget_session(ssl_sslsocket_obj_t *self) {
+    ssl_session_cache_entry_t *entry = ssl_socket_session_entry(self);
+    if (entry != NULL) {
+        m_free(entry->data);
+        entry->data = NULL;
+        entry->len = 0;
+    }
+}
+#endif
+
 static void do_handshake(ssl_sslsocket_obj_t *self) {
     int ret;
     while ((ret = mbedtls_ssl_handshake(&self->ssl)) != 0) {
@@ -389,9 +496,15 @@ static void do_handshake(ssl_sslsocket_obj_t *self) {
         mp_hal_delay_ms(1);
     }
 
+    #if CIRCUITPY_SSL_SESSION_CACHE_SIZE > 0
+    ssl_socket_save_session(self);
+    #endif
     return;
 
 cleanup:
+    #if CIRCUITPY_SSL_SESSION_CACHE_SIZE > 0
+    ssl_socket_forget_session(self);
+    #endif
     self->closed = true;
     mbedtls_pk_free(&self->pkey);
     mbedtls_x509_crt_free(&self->cert);
@@ -10,6 +10,9 @@
 #include "py/obj.h"
 
 #include "shared-module/ssl/SSLContext.h"
+#if CIRCUITPY_SOCKETPOOL
+#include "common-hal/socketpool/Socket.h"
+#endif
 
 #include "mbedtls/platform.h"
 #include "mbedtls/ssl.h"
@@ -21,6 +24,11 @@
 typedef struct ssl_sslsocket_obj {
     mp_obj_base_t base;
     mp_obj_t sock_obj;
+    #if CIRCUITPY_SOCKETPOOL
+    // Set when sock_obj is a socketpool.Socket, so the mbedtls BIO callbacks
+    // can call into it directly instead of through its Python methods.
+    socketpool_socket_obj_t *native_sock;
+    #endif
     ssl_sslcontext_obj_t *ssl_context;
     mbedtls_entropy_context entropy;
     mbedtls_ctr_drbg_context ctr_drbg;
@@ -30,6 +38,12 @@ typedef struct ssl_sslsocket_obj {
     mbedtls_x509_crt cert;
     mbedtls_pk_context pkey;
     bool closed;
+    #if CIRCUITPY_SSL_SESSION_CACHE_SIZE > 0
+    // Where to save the session once a client handshake completes; the entry
+    // is only still ours while its hostname pointer matches session_hostname.
+    ssl_session_cache_entry_t *session_entry;
+    const char *session_hostname;
+    #endif
     mp_obj_t accept_args[2];
     mp_obj_t bind_args[3];
     mp_obj_t close_args[2];
@@ -13,6 +13,10 @@
 #include "py/mphal.h"
 #include "py/obj.h"
 #include "py/runtime.h"
+#if CIRCUITPY_STORAGE_MMAP
+#include "py/binary.h"
+#include "py/stream.h"
+#endif
 #include "shared-bindings/microcontroller/__init__.h"
 #include "shared-bindings/os/__init__.h"
 #include "shared-bindings/storage/__init__.h"
@@ -267,3 +271,22 @@ void common_hal_storage_erase_filesystem(bool extended) {
     common_hal_mcu_reset();
     // We won't actually get here, since we're resetting.
 }
+
+#if CIRCUITPY_STORAGE_MMAP
+mp_obj_t common_hal_storage_mmap(mp_obj_t file, char typecode) {
+    // object typecodes would turn whatever is in flash into pointers
+    if (typecode == '\0' || strchr("bBhHiIlLqQfd", typecode) == NULL) {
+        mp_raise_ValueError(MP_ERROR_TEXT("bad typecode"));
+    }
+    size_t item_size = mp_binary_get_size('@', typecode, NULL);
+    const mp_stream_p_t *stream_p = mp_get_stream_raise(file, MP_STREAM_OP_IOCTL);
+    const byte *addr = NULL;
+    int errcode;
+    mp_uint_t len = stream_p->ioctl(file, MP_STREAM_GET_XIP_ADDR, (uintptr_t)&addr, &errcode);
+    if (len == MP_STREAM_ERROR || addr == NULL) {
+        mp_raise_ValueError(MP_ERROR_TEXT("File is not contiguous in memory-mapped flash"));
+    }
+    // Without MP_OBJ_ARRAY_TYPECODE_FLAG_RW the view is read-only.
+    return mp_obj_new_memoryview(typecode, len / item_size, (void *)addr);
+}
+#endif
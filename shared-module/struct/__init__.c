@@ -12,6 +12,12 @@
 #include "py/binary.h"
 #include "py/parsenum.h"
 #include "shared-bindings/struct/__init__.h"
+#include "shared-module/struct/__init__.h"
+
+// Number of compiled formats that the module-level functions remember.
+#ifndef CIRCUITPY_STRUCT_CACHE_SIZE
+#define CIRCUITPY_STRUCT_CACHE_SIZE (8)
+#endif
 
 static void struct_validate_format(char fmt) {
     #if MICROPY_NONSTANDARD_TYPECODES
@@ -51,74 +57,103 @@ static mp_uint_t get_fmt_num(const char **p) {
     return val;
 }
 
-static mp_uint_t calcsize_items(const char *fmt) {
-    mp_uint_t cnt = 0;
-    while (*fmt) {
-        int num = 1;
+// Parse fmt into a Struct. The format is walked twice: once to size the op
+// array and once to fill it in.
+static struct_struct_obj_t *struct_compile(mp_obj_t fmt_in) {
+    const char *fmt_start = mp_obj_str_get_str(fmt_in);
+    const char *fmt = fmt_start;
+    get_fmt_type(&fmt);
+    size_t n_ops = 0;
+    for (; *fmt; fmt++) {
         if (unichar_isdigit(*fmt)) {
-            num = get_fmt_num(&fmt);
-            if (*fmt == 's') {
-                num = 1;
-            }
+            get_fmt_num(&fmt);
         }
-        // Pad bytes are skipped and don't get included in the item count.
-        if (*fmt != 'x') {
-            cnt += num;
+        n_ops++;
+        if (!*fmt) {
+            // A count with no type; mp_binary_get_size() rejects it below.
+            break;
         }
-        fmt++;
     }
-    return cnt;
-}
 
-mp_uint_t shared_modules_struct_calcsize(mp_obj_t fmt_in) {
-    const char *fmt = mp_obj_str_get_str(fmt_in);
-    char fmt_type = get_fmt_type(&fmt);
-
-    mp_uint_t size;
-    for (size = 0; *fmt; fmt++) {
+    struct_struct_obj_t *self = mp_obj_malloc_var(struct_struct_obj_t, struct_op_t, n_ops, &struct_struct_type);
+    self->format = fmt_in;
+    self->n_ops = n_ops;
+    self->size = 0;
+    self->n_items = 0;
+    fmt = fmt_start;
+    self->fmt_type = get_fmt_type(&fmt);
 
+    for (struct_op_t *op = self->ops; op != self->ops + n_ops; fmt++, op++) {
         struct_validate_format(*fmt);
 
         mp_uint_t cnt = 1;
         if (unichar_isdigit(*fmt)) {
             cnt = get_fmt_num(&fmt);
         }
+        op->code = *fmt;
+        op->count = cnt;
 
         if (*fmt == 's') {
-            size += cnt;
+            self->size += cnt;
+            self->n_items++;
         } else {
             mp_uint_t align;
-            size_t sz = mp_binary_get_size(fmt_type, *fmt, &align);
+            size_t sz = mp_binary_get_size(self->fmt_type, *fmt, &align);
             while (cnt--) {
                 // Apply alignment
-                size = (size + align - 1) & ~(align - 1);
-                size += sz;
+                self->size = (self->size + align - 1) & ~(align - 1);
+                self->size += sz;
+            }
+            // Pad bytes are skipped and don't get included in the item count.
+            if (*fmt != 'x') {
+                self->n_items += op->count;
             }
         }
     }
-    return size;
+    return self;
+}
+
+struct_struct_obj_t *shared_modules_struct_compile(mp_obj_t fmt_in) {
+    if (!mp_obj_is_qstr(fmt_in)) {
+        return struct_compile(fmt_in);
+    }
+    // Formats written as literals are qstrs, so the module-level functions can
+    // find the compiled form without parsing it again.
+    if (MP_STATE_VM(struct_cache) == NULL) {
+        MP_STATE_VM(struct_cache) = m_new0(mp_obj_t, CIRCUITPY_STRUCT_CACHE_SIZE);
+    }
+    mp_obj_t *slot = &MP_STATE_VM(struct_cache)[MP_OBJ_QSTR_VALUE(fmt_in) % CIRCUITPY_STRUCT_CACHE_SIZE];
+    if (*slot != MP_OBJ_NULL) {
+        struct_struct_obj_t *cached = MP_OBJ_TO_PTR(*slot);
+        if (cached->format == fmt_in) {
+            return cached;
+        }
+    }
+    struct_struct_obj_t *self = struct_compile(fmt_in);
+    *slot = MP_OBJ_FROM_PTR(self);
+    return self;
+}
+
+mp_uint_t shared_modules_struct_calcsize(struct_struct_obj_t *self) {
+    return self->size;
+}
+
+mp_uint_t shared_modules_struct_get_n_items(struct_struct_obj_t *self) {
+    return self->n_items;
 }
 
-void shared_modules_struct_pack_into(mp_obj_t fmt_in, byte *p, byte *end_p, size_t n_args, const mp_obj_t *args) {
-    const char *fmt = mp_obj_str_get_str(fmt_in);
-    char fmt_type = get_fmt_type(&fmt);
-    const mp_uint_t total_sz = shared_modules_struct_calcsize(fmt_in);
+void shared_modules_struct_pack_into(struct_struct_obj_t *self, byte *p, byte *end_p, size_t n_args, const mp_obj_t *args) {
+    char fmt_type = self->fmt_type;
 
-    if (p + total_sz > end_p) {
+    if (p + self->size > end_p) {
         mp_raise_RuntimeError(MP_ERROR_TEXT("Buffer too small"));
     }
 
     size_t i = 0;
     byte *p_base = p;
-    while (*fmt) {
-        mp_uint_t sz = 1;
-        struct_validate_format(*fmt);
-
-        if (unichar_isdigit(*fmt)) {
-            sz = get_fmt_num(&fmt);
-        }
-
-        if (*fmt == 's') {
+    for (const struct_op_t *op = self->ops; op != self->ops + self->n_ops; op++) {
+        mp_uint_t sz = op->count;
+        if (op->code == 's') {
             if (i < n_args) {
                 mp_buffer_info_t bufinfo;
                 mp_get_buffer_raise(args[i], &bufinfo, MP_BUFFER_READ);
@@ -134,66 +169,51 @@ void shared_modules_struct_pack_into(mp_obj_t fmt_in, byte *p, byte *end_p, size
         } else {
             while (sz--) {
                 // Pad bytes don't have a corresponding argument.
-                if (*fmt == 'x') {
-                    mp_binary_set_val(fmt_type, *fmt, MP_OBJ_NEW_SMALL_INT(0), p_base, &p);
+                if (op->code == 'x') {
+                    mp_binary_set_val(fmt_type, op->code, MP_OBJ_NEW_SMALL_INT(0), p_base, &p);
                 } else {
                     if (i < n_args) {
-                        mp_binary_set_val(fmt_type, *fmt, args[i], p_base, &p);
+                        mp_binary_set_val(fmt_type, op->code, args[i], p_base, &p);
                     }
                     i++;
                 }
             }
         }
-        fmt++;
     }
     (void)mp_arg_validate_length(n_args, i, MP_QSTR_values);
 }
 
-mp_obj_tuple_t *shared_modules_struct_unpack_from(mp_obj_t fmt_in, byte *p, byte *end_p, bool exact_size) {
-
-    const char *fmt = mp_obj_str_get_str(fmt_in);
-    char fmt_type = get_fmt_type(&fmt);
-    const mp_uint_t num_items = calcsize_items(fmt);
-    const mp_uint_t total_sz = shared_modules_struct_calcsize(fmt_in);
-    mp_obj_tuple_t *res = MP_OBJ_TO_PTR(mp_obj_new_tuple(num_items, NULL));
+void shared_modules_struct_unpack_from(struct_struct_obj_t *self, byte *p, byte *end_p, bool exact_size, mp_obj_t *items) {
+    char fmt_type = self->fmt_type;
 
     // If exact_size, make sure the buffer is exactly the right size.
     // Otherwise just make sure it's big enough.
     if (exact_size) {
-        if (p + total_sz != end_p) {
+        if (p + self->size != end_p) {
             mp_raise_RuntimeError(MP_ERROR_TEXT("buffer size must match format"));
         }
     } else {
-        if (p + total_sz > end_p) {
+        if (p + self->size > end_p) {
             mp_raise_RuntimeError(MP_ERROR_TEXT("buffer too small"));
         }
     }
 
     byte *p_base = p;
-    for (uint i = 0; i < num_items;) {
-        mp_uint_t sz = 1;
-
-        struct_validate_format(*fmt);
-
-        if (unichar_isdigit(*fmt)) {
-            sz = get_fmt_num(&fmt);
-        }
-        mp_obj_t item;
-        if (*fmt == 's') {
-            item = mp_obj_new_bytes(p, sz);
+    for (const struct_op_t *op = self->ops; op != self->ops + self->n_ops; op++) {
+        mp_uint_t sz = op->count;
+        if (op->code == 's') {
+            *items++ = mp_obj_new_bytes(p, sz);
             p += sz;
-            res->items[i++] = item;
         } else {
             while (sz--) {
-                item = mp_binary_get_val(fmt_type, *fmt, p_base, &p);
+                mp_obj_t item = mp_binary_get_val(fmt_type, op->code, p_base, &p);
                 // Pad bytes are not stored.
-                if (*fmt != 'x') {
-                    res->items[i++] = item;
+                if (op->code != 'x') {
+                    *items++ = item;
                 }
             }
         }
-        fmt++;
     }
-    return res;
-
 }
+
+MP_REGISTER_ROOT_POINTER(mp_obj_t *struct_cache);
@@ -5,6 +5,21 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 
-char get_fmt_type(const char **fmt);
-mp_uint_t get_fmt_num(const char **p);
-mp_uint_t calcsize_items(const char *fmt);
+#include "py/obj.h"
+
+// One format code and its repeat count (or length, for 's').
+typedef struct {
+    char code;
+    mp_uint_t count;
+} struct_op_t;
+
+// A format string parsed once, so packing and unpacking just walk ops[].
+typedef struct {
+    mp_obj_base_t base;
+    mp_obj_t format;
+    mp_uint_t size;
+    mp_uint_t n_items;
+    size_t n_ops;
+    char fmt_type;
+    struct_op_t ops[];
+} struct_struct_obj_t;
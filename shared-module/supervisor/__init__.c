@@ -5,10 +5,12 @@
 // SPDX-License-Identifier: MIT
 
 #include "py/obj.h"
+#include "py/profile.h"
 
 #include "shared-bindings/supervisor/__init__.h"
 #include "shared-bindings/supervisor/Runtime.h"
 #include "shared-bindings/supervisor/StatusBar.h"
+#include "supervisor/shared/tick.h"
 
 // The singleton supervisor.Runtime object, bound to supervisor.runtime
 const super_runtime_obj_t common_hal_supervisor_runtime_obj = {
@@ -34,3 +36,19 @@ supervisor_next_code_info_t *next_code_configuration = NULL;
 // Custom USB settings.
 usb_identification_t *custom_usb_identification = NULL;
 #endif
+
+#if CIRCUITPY_SAMPLING_PROFILER
+void supervisor_profiling_start(size_t samples, mp_uint_t interval_ms) {
+    supervisor_profiling_stop();
+    mp_prof_sample_start(samples, interval_ms);
+    // Samples are requested from the supervisor tick.
+    supervisor_enable_tick();
+}
+
+void supervisor_profiling_stop(void) {
+    if (mp_prof_sample_is_running()) {
+        mp_prof_sample_stop();
+        supervisor_disable_tick();
+    }
+}
+#endif
@@ -5,6 +5,9 @@
 // SPDX-License-Identifier: MIT
 
 #include <math.h>
+#include <string.h>
+
+#include "py/runtime.h"
 #include "shared-bindings/synthio/Biquad.h"
 #include "shared-module/synthio/Biquad.h"
 
@@ -91,10 +94,51 @@ void synthio_biquad_filter_assign(biquad_filter_state *st, mp_obj_t biquad_obj)
 }
 
 void synthio_biquad_filter_reset(biquad_filter_state *st) {
-    memset(&st->x, 0, 4 * sizeof(int16_t));
+    memset(&st->x, 0, sizeof(st->x));
+    memset(&st->y, 0, sizeof(st->y));
 }
 
-void synthio_biquad_filter_samples(biquad_filter_state *st, int32_t *buffer, size_t n_samples) {
+void synthio_biquad_cascade_assign(biquad_cascade_state *st, mp_obj_t filter_obj) {
+    if (filter_obj == mp_const_none) {
+        return;
+    }
+    size_t n_sections = 1;
+    mp_obj_t *sections = &filter_obj;
+    // a Biquad is itself a tuple, so it has to be recognized before a sequence of them
+    if (!mp_obj_is_type(filter_obj, (const mp_obj_type_t *)&synthio_biquad_type_obj)) {
+        mp_obj_get_array(filter_obj, &n_sections, &sections);
+        mp_arg_validate_length_range(n_sections, 1, SYNTHIO_BIQUAD_MAX_SECTIONS, MP_QSTR_filter);
+        for (size_t i = 0; i < n_sections; i++) {
+            mp_arg_validate_type(sections[i], (const mp_obj_type_t *)&synthio_biquad_type_obj, MP_QSTR_filter);
+        }
+    }
+    // only sections that weren't running before start from silence, so that
+    // coefficients can change smoothly while a note plays
+    for (size_t i = 0; i < n_sections; i++) {
+        if (i >= st->n_sections) {
+            synthio_biquad_filter_reset(&st->section[i]);
+        }
+        synthio_biquad_filter_assign(&st->section[i], sections[i]);
+    }
+    st->n_sections = n_sections;
+}
+
+void synthio_biquad_cascade_reset(biquad_cascade_state *st) {
+    for (size_t i = 0; i < SYNTHIO_BIQUAD_MAX_SECTIONS; i++) {
+        synthio_biquad_filter_reset(&st->section[i]);
+    }
+}
+
+// Where a 32x32+64 bit multiply-accumulate is a single instruction (SMLAL on
+// Cortex-M4 and M33), sum in 64 bits so that resonant or cascaded sections
+// can't overflow. Cortex-M0+ has no such instruction and keeps the narrower sum.
+#if !defined(__arm__) || (defined(__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1)) || (defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1))
+typedef int64_t biquad_accum_t;
+#else
+typedef int32_t biquad_accum_t;
+#endif
+
+static void biquad_section_samples(biquad_filter_state *st, int32_t *buffer, size_t n_samples, size_t stride) {
     int32_t a1 = st->a1;
     int32_t a2 = st->a2;
     int32_t b0 = st->b0;
@@ -106,9 +150,11 @@ void synthio_biquad_filter_samples(biquad_filter_state *st, int32_t *buffer, siz
     int32_t y0 = st->y[0];
     int32_t y1 = st->y[1];
 
-    for (size_t n = n_samples; n; --n, ++buffer) {
+    for (size_t n = n_samples; n; --n, buffer += stride) {
         int32_t input = *buffer;
-        int32_t output = (b0 * input + b1 * x0 + b2 * x1 - a1 * y0 - a2 * y1 + (1 << (BIQUAD_SHIFT - 1))) >> BIQUAD_SHIFT;
+        biquad_accum_t sum = (biquad_accum_t)b0 * input + (biquad_accum_t)b1 * x0 + (biquad_accum_t)b2 * x1
+            - (biquad_accum_t)a1 * y0 - (biquad_accum_t)a2 * y1 + (1 << (BIQUAD_SHIFT - 1));
+        int32_t output = (int32_t)(sum >> BIQUAD_SHIFT);
 
         x1 = x0;
         x0 = input;
@@ -121,3 +167,11 @@ void synthio_biquad_filter_samples(biquad_filter_state *st, int32_t *buffer, siz
     st->y[0] = y0;
     st->y[1] = y1;
 }
+
+void synthio_biquad_cascade_samples(biquad_cascade_state *st, int32_t *buffer, size_t n_samples, size_t stride) {
+    // Running each section over the whole block keeps its coefficients and
+    // history in registers, rather than reloading them for every sample.
+    for (size_t i = 0; i < st->n_sections; i++) {
+        biquad_section_samples(&st->section[i], buffer, n_samples, stride);
+    }
+}
@@ -8,11 +8,26 @@
 
 #include "py/obj.h"
 
+// The most Biquads a filter may chain together
+#ifndef SYNTHIO_BIQUAD_MAX_SECTIONS
+#define SYNTHIO_BIQUAD_MAX_SECTIONS (4)
+#endif
+
 typedef struct {
     int32_t a1, a2, b0, b1, b2;
     int32_t x[2], y[2];
 } biquad_filter_state;
 
+typedef struct {
+    uint8_t n_sections;
+    biquad_filter_state section[SYNTHIO_BIQUAD_MAX_SECTIONS];
+} biquad_cascade_state;
+
 void synthio_biquad_filter_assign(biquad_filter_state *st, mp_obj_t biquad_obj);
 void synthio_biquad_filter_reset(biquad_filter_state *st);
-void synthio_biquad_filter_samples(biquad_filter_state *st, int32_t *buffer, size_t n_samples);
+
+// filter_obj may be None, a Biquad, or a sequence of Biquads applied in order
+void synthio_biquad_cascade_assign(biquad_cascade_state *st, mp_obj_t filter_obj);
+void synthio_biquad_cascade_reset(biquad_cascade_state *st);
+// Filter every stride-th sample of buffer, e.g., one channel of interleaved audio
+void synthio_biquad_cascade_samples(biquad_cascade_state *st, int32_t *buffer, size_t n_samples, size_t stride);
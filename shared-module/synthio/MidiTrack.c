@@ -4,9 +4,14 @@
 //
 // SPDX-License-Identifier: MIT
 
+#include <string.h>
+
 #include "py/runtime.h"
 #include "shared-bindings/synthio/MidiTrack.h"
 
+// Tempo of a Standard MIDI File until it sets one: 120 beats per minute.
+#define SMF_DEFAULT_US_PER_QUARTER (500000)
+
 
 static void record_midi_stream_error(synthio_miditrack_obj_t *self) {
     self->error_location = self->pos;
@@ -84,6 +89,287 @@ static void decode_until_pause(synthio_miditrack_obj_t *self) {
     } while (self->pos < len && self->synth.span.dur == 0);
 }
 
+static uint32_t read_be32(const uint8_t *p) {
+    return (p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+static uint16_t read_be16(const uint8_t *p) {
+    return (p[0] << 8) | p[1];
+}
+
+// Reads a variable-length quantity. Returns false if it runs past the end of the track.
+static bool smf_read_varlen(const uint8_t *buffer, synthio_miditrack_smf_track_t *t, uint32_t *result) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4 && t->pos < t->end; i++) {
+        uint8_t c = buffer[t->pos++];
+        value = (value << 7) | (c & 0x7f);
+        if (!(c & 0x80)) {
+            *result = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Converts ticks to samples at the current tempo. The fraction of a sample is
+// carried to the next call so that rounding doesn't add up over a long song.
+static uint32_t smf_ticks_to_samples(synthio_miditrack_obj_t *self, uint32_t ticks) {
+    uint64_t num, den;
+    if (self->smf_division < 0) {
+        // SMPTE time: negative frames per second in the upper byte, ticks per frame in the lower.
+        int fps = -(self->smf_division >> 8);
+        uint32_t ticks_per_frame = self->smf_division & 0xff;
+        if (fps == 29) {
+            // 30 drop frame runs at 29.97 frames per second.
+            num = self->synth.sample_rate * 100ull;
+            den = 2997ull * ticks_per_frame;
+        } else {
+            num = self->synth.sample_rate;
+            den = (uint64_t)fps * ticks_per_frame;
+        }
+    } else {
+        num = (uint64_t)self->smf_us_per_quarter * self->synth.sample_rate;
+        den = (uint64_t)self->smf_division * 1000000;
+    }
+    uint64_t samples = 0;
+    while (ticks > 0) {
+        // Small enough steps that the product can't overflow.
+        uint32_t step = MIN(ticks, 0xffff);
+        ticks -= step;
+        uint64_t total = step * num + self->smf_remainder;
+        samples += total / den;
+        self->smf_remainder = total % den;
+    }
+    return MIN(samples, UINT32_MAX);
+}
+
+// Ties go to the lower numbered track, so the tempo track of a type 1 file comes first.
+static bool smf_before(synthio_miditrack_obj_t *self, uint16_t a, uint16_t b) {
+    uint32_t tick_a = self->smf_tracks[a].next_tick;
+    uint32_t tick_b = self->smf_tracks[b].next_tick;
+    return tick_a < tick_b || (tick_a == tick_b && a < b);
+}
+
+static void smf_sift_down(synthio_miditrack_obj_t *self, size_t i) {
+    uint16_t *heap = self->smf_heap;
+    size_t len = self->smf_heap_len;
+    while (true) {
+        size_t smallest = i;
+        size_t left = 2 * i + 1, right = left + 1;
+        if (left < len && smf_before(self, heap[left], heap[smallest])) {
+            smallest = left;
+        }
+        if (right < len && smf_before(self, heap[right], heap[smallest])) {
+            smallest = right;
+        }
+        if (smallest == i) {
+            return;
+        }
+        uint16_t tmp = heap[i];
+        heap[i] = heap[smallest];
+        heap[smallest] = tmp;
+        i = smallest;
+    }
+}
+
+// Plays the event at the track's position. An End of Track event moves the
+// position to the end. Returns false if the event is malformed.
+static bool smf_play_event(synthio_miditrack_obj_t *self, synthio_miditrack_smf_track_t *t) {
+    const uint8_t *buffer = self->track.buf;
+    if (t->pos >= t->end) {
+        return false;
+    }
+    uint8_t status = buffer[t->pos];
+    if (status & 0x80) {
+        t->pos++;
+        // System messages cancel running status.
+        t->running_status = status < 0xf0 ? status : 0;
+    } else if (t->running_status) {
+        status = t->running_status;
+    } else {
+        return false;
+    }
+
+    if (status < 0xf0) {
+        uint8_t kind = status >> 4;
+        size_t n_data = (kind == 0xc || kind == 0xd) ? 1 : 2;
+        if (t->end - t->pos < n_data) {
+            return false;
+        }
+        const uint8_t *data = buffer + t->pos;
+        t->pos += n_data;
+        if ((data[0] | data[n_data - 1]) & 0x80) {
+            return false;
+        }
+        // Channel 10 is percussion, which has no pitch to play.
+        if ((kind == 8 || kind == 9) && (status & 0xf) != 9) {
+            mp_obj_t note = MP_OBJ_NEW_SMALL_INT(data[0]);
+            if (kind == 9 && data[1] != 0) {
+                synthio_span_change_note(&self->synth, SYNTHIO_SILENCE, note);
+            } else {
+                // Note On with velocity 0 is the usual way to write Note Off.
+                synthio_span_change_note(&self->synth, note, SYNTHIO_SILENCE);
+            }
+        }
+        return true;
+    }
+
+    if (status != 0xf0 && status != 0xf7 && status != 0xff) {
+        return false;
+    }
+    uint8_t type = 0;
+    if (status == 0xff) {
+        if (t->pos >= t->end) {
+            return false;
+        }
+        type = buffer[t->pos++];
+    }
+    uint32_t len;
+    if (!smf_read_varlen(buffer, t, &len) || len > t->end - t->pos) {
+        return false;
+    }
+    const uint8_t *data = buffer + t->pos;
+    t->pos += len;
+    if (status == 0xff) {
+        if (type == 0x2f) { // End of Track
+            t->pos = t->end;
+        } else if (type == 0x51 && len == 3) { // Set Tempo
+            self->smf_us_per_quarter = (data[0] << 16) | (data[1] << 8) | data[2];
+        }
+    }
+    return true;
+}
+
+// Plays every event that is due, from whichever track has the earliest one,
+// until the next event is some samples away or all tracks have ended.
+static void smf_decode_until_pause(synthio_miditrack_obj_t *self) {
+    const uint8_t *buffer = self->track.buf;
+    while (self->smf_heap_len > 0) {
+        synthio_miditrack_smf_track_t *t = &self->smf_tracks[self->smf_heap[0]];
+        if (t->next_tick > self->smf_tick) {
+            self->smf_wait = smf_ticks_to_samples(self, t->next_tick - self->smf_tick);
+            self->smf_tick = t->next_tick;
+            if (self->smf_wait > 0) {
+                return;
+            }
+            continue;
+        }
+        // errors cannot be raised from the background task, so simply end the song.
+        uint32_t event_pos = t->pos;
+        if (!smf_play_event(self, t)) {
+            self->error_location = event_pos;
+            break;
+        }
+        if (t->pos < t->end) {
+            uint32_t delta;
+            if (!smf_read_varlen(buffer, t, &delta)) {
+                self->error_location = event_pos;
+                break;
+            }
+            t->next_tick += delta;
+        } else {
+            self->smf_heap[0] = self->smf_heap[--self->smf_heap_len];
+        }
+        smf_sift_down(self, 0);
+    }
+    self->smf_heap_len = 0;
+    self->pos = self->track.len;
+}
+
+// Starts the next span of samples, playing events whenever the wait runs out.
+static void smf_advance(synthio_miditrack_obj_t *self) {
+    if (self->smf_wait == 0) {
+        smf_decode_until_pause(self);
+    }
+    uint16_t dur = MIN(self->smf_wait, UINT16_MAX);
+    self->smf_wait -= dur;
+    self->synth.span.dur = dur;
+}
+
+static void smf_start_parse(synthio_miditrack_obj_t *self) {
+    const uint8_t *buffer = self->track.buf;
+    self->pos = 0;
+    self->error_location = -1;
+    self->smf_tick = 0;
+    self->smf_us_per_quarter = SMF_DEFAULT_US_PER_QUARTER;
+    self->smf_wait = 0;
+    self->smf_remainder = 0;
+    self->smf_heap_len = 0;
+    for (uint16_t i = 0; i < self->smf_num_tracks; i++) {
+        synthio_miditrack_smf_track_t *t = &self->smf_tracks[i];
+        t->pos = t->start;
+        t->next_tick = 0;
+        t->running_status = 0;
+        if (t->pos == t->end) {
+            continue;
+        }
+        if (!smf_read_varlen(buffer, t, &t->next_tick)) {
+            self->error_location = t->start;
+            self->smf_heap_len = 0;
+            break;
+        }
+        self->smf_heap[self->smf_heap_len++] = i;
+    }
+    for (size_t i = self->smf_heap_len / 2; i-- > 0;) {
+        smf_sift_down(self, i);
+    }
+    smf_advance(self);
+}
+
+// Finds the track chunks of a type 0 or type 1 Standard MIDI File.
+static void smf_construct(synthio_miditrack_obj_t *self) {
+    const uint8_t *buffer = self->track.buf;
+    size_t len = self->track.len;
+    if (len < 14) {
+        mp_raise_ValueError(MP_ERROR_TEXT("Invalid format"));
+    }
+    uint32_t header_len = read_be32(buffer + 4);
+    if (header_len < 6 || header_len > len - 8) {
+        mp_raise_ValueError(MP_ERROR_TEXT("Invalid format"));
+    }
+    uint16_t format = read_be16(buffer + 8);
+    uint16_t num_tracks = read_be16(buffer + 10);
+    int16_t division = read_be16(buffer + 12);
+    if (format > 1) {
+        // Type 2 holds independent sequences, which can't be played together.
+        mp_raise_ValueError(MP_ERROR_TEXT("Unsupported format"));
+    }
+    bool division_ok = division > 0;
+    if (division < 0) {
+        int fps = -(division >> 8);
+        division_ok = (fps == 24 || fps == 25 || fps == 29 || fps == 30) && (division & 0xff) != 0;
+    }
+    if (!division_ok || num_tracks == 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("Invalid format"));
+    }
+
+    synthio_miditrack_smf_track_t *tracks = m_malloc(num_tracks * sizeof(synthio_miditrack_smf_track_t));
+    uint16_t found = 0;
+    size_t pos = 8 + header_len;
+    while (found < num_tracks && len - pos >= 8) {
+        uint32_t start = pos + 8;
+        uint32_t chunk_len = read_be32(buffer + pos + 4);
+        if (chunk_len > len - start) {
+            mp_raise_ValueError(MP_ERROR_TEXT("Invalid format"));
+        }
+        // Chunks of other types are skipped, as the standard asks.
+        if (memcmp(buffer + pos, "MTrk", 4) == 0) {
+            tracks[found].start = start;
+            tracks[found].end = start + chunk_len;
+            found++;
+        }
+        pos = start + chunk_len;
+    }
+    if (found == 0 || (format == 0 && found != 1)) {
+        mp_raise_ValueError(MP_ERROR_TEXT("Invalid format"));
+    }
+
+    self->smf_tracks = tracks;
+    self->smf_heap = m_malloc(found * sizeof(uint16_t));
+    self->smf_num_tracks = found;
+    self->smf_division = division;
+}
+
 static void start_parse(synthio_miditrack_obj_t *self) {
     self->pos = 0;
     self->error_location = -1;
@@ -101,14 +387,30 @@ void common_hal_synthio_miditrack_construct(synthio_miditrack_obj_t *self,
     self->tempo = tempo;
     self->track.buf = (void *)buffer;
     self->track.len = len;
+    self->smf_tracks = NULL;
+    self->smf_heap = NULL;
+
+    // A Standard MIDI File starts with its header chunk, where a bare track
+    // stream starts with a delta time.
+    if (len >= 4 && memcmp(buffer, "MThd", 4) == 0) {
+        smf_construct(self);
+    } else {
+        mp_arg_validate_int_min(tempo, 1, MP_QSTR_tempo);
+    }
 
     synthio_synth_init(&self->synth, sample_rate, 1, waveform_obj, envelope_obj);
 
-    start_parse(self);
+    if (self->smf_tracks) {
+        smf_start_parse(self);
+    } else {
+        start_parse(self);
+    }
 }
 
 void common_hal_synthio_miditrack_deinit(synthio_miditrack_obj_t *self) {
     synthio_synth_deinit(&self->synth);
+    self->smf_tracks = NULL;
+    self->smf_heap = NULL;
 }
 
 bool common_hal_synthio_miditrack_deinited(synthio_miditrack_obj_t *self) {
@@ -132,7 +434,11 @@ uint8_t common_hal_synthio_miditrack_get_channel_count(synthio_miditrack_obj_t *
 void synthio_miditrack_reset_buffer(synthio_miditrack_obj_t *self,
     bool single_channel_output, uint8_t channel) {
     synthio_synth_reset_buffer(&self->synth, single_channel_output, channel);
-    start_parse(self);
+    if (self->smf_tracks) {
+        smf_start_parse(self);
+    } else {
+        start_parse(self);
+    }
 }
 
 audioio_get_buffer_result_t synthio_miditrack_get_buffer(synthio_miditrack_obj_t *self,
@@ -146,6 +452,8 @@ audioio_get_buffer_result_t synthio_miditrack_get_buffer(synthio_miditrack_obj_t
     if (self->synth.span.dur == 0) {
         if (self->pos == self->track.len) {
             return GET_BUFFER_DONE;
+        } else if (self->smf_tracks) {
+            smf_advance(self);
         } else {
             decode_until_pause(self);
         }
@@ -10,6 +10,14 @@
 
 #include "shared-module/synthio/__init__.h"
 
+// One track chunk of a Standard MIDI File. Offsets are within the buffer.
+typedef struct {
+    uint32_t start, pos, end;
+    // Absolute time of the next event, in ticks.
+    uint32_t next_tick;
+    uint8_t running_status;
+} synthio_miditrack_smf_track_t;
+
 typedef struct {
     mp_obj_base_t base;
     synthio_synth_t synth;
@@ -18,6 +26,17 @@ typedef struct {
     size_t pos;
     mp_int_t error_location;
     uint32_t tempo;
+    // Only used for a Standard MIDI File; smf_tracks is NULL for a bare track stream.
+    synthio_miditrack_smf_track_t *smf_tracks;
+    // Indices of the tracks that still have events, ordered as a min-heap on next_tick.
+    uint16_t *smf_heap;
+    uint16_t smf_num_tracks, smf_heap_len;
+    int16_t smf_division;
+    uint32_t smf_tick;
+    uint32_t smf_us_per_quarter;
+    // Samples to wait before the next event, and the part of a sample carried over.
+    uint32_t smf_wait;
+    uint64_t smf_remainder;
 } synthio_miditrack_obj_t;
 
 
@@ -25,7 +25,7 @@ mp_obj_t common_hal_synthio_note_get_filter_obj(synthio_note_obj_t *self) {
 }
 
 void common_hal_synthio_note_set_filter(synthio_note_obj_t *self, mp_obj_t filter_in) {
-    synthio_biquad_filter_assign(&self->filter_state, filter_in);
+    synthio_biquad_cascade_assign(&self->filter_state, filter_in);
     self->filter_obj = filter_in;
 }
 
@@ -164,7 +164,7 @@ void synthio_note_recalculate(synthio_note_obj_t *self, int32_t sample_rate) {
 
 void synthio_note_start(synthio_note_obj_t *self, int32_t sample_rate) {
     synthio_note_recalculate(self, sample_rate);
-    synthio_biquad_filter_reset(&self->filter_state);
+    synthio_biquad_cascade_reset(&self->filter_state);
 }
 
 // Perform a pitch bend operation
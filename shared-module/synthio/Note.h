@@ -20,7 +20,7 @@ typedef struct synthio_note_obj {
     mp_obj_t waveform_obj, envelope_obj, ring_waveform_obj;
     mp_obj_t filter_obj;
 
-    biquad_filter_state filter_state;
+    biquad_cascade_state filter_state;
 
     int32_t sample_rate;
 
@@ -0,0 +1,126 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2023 Jeff Epler for Adafruit Industries
+//
+// SPDX-License-Identifier: MIT
+
+#include <math.h>
+#include <string.h>
+
+#include "py/runtime.h"
+#include "shared-bindings/synthio/Wavetable.h"
+#include "shared-module/synthio/__init__.h"
+
+// M_PI is not part of the math.h standard and may not be defined
+// And by defining our own we can ensure it uses the correct const format.
+#define MP_PI MICROPY_FLOAT_CONST(3.14159265358979323846)
+
+// Nonzero taps on each side of the centre of the half-band filter
+#define HALFBAND_SIDE_TAPS (16)
+
+// Circularly filter one period of src with a Blackman-windowed half-band
+// low-pass whose taps are spread dilation samples apart, keeping every step-th
+// output. Every even tap but the centre one is zero, so only the odd taps are
+// stored.
+static void filter_level(int16_t *dst, const int16_t *src, size_t src_len, size_t dilation, size_t step, const mp_float_t *taps) {
+    for (size_t i = 0; i < src_len / step; i++) {
+        size_t centre = i * step;
+        mp_float_t acc = MICROPY_FLOAT_CONST(0.5) * src[centre];
+        for (size_t j = 0; j < HALFBAND_SIDE_TAPS; j++) {
+            size_t n = ((2 * j + 1) * dilation) % src_len;
+            size_t before = (centre + src_len - n) % src_len;
+            size_t after = (centre + n) % src_len;
+            acc += taps[j] * (src[before] + src[after]);
+        }
+        int32_t value = (int32_t)MICROPY_FLOAT_C_FUN(round)(acc);
+        dst[i] = MIN(32767, MAX(-32768, value));
+    }
+}
+
+void common_hal_synthio_wavetable_construct(synthio_wavetable_obj_t *self, const int16_t *waveform, size_t length) {
+    // the last level holds only the fundamental
+    int level_count = 1;
+    while (level_count < SYNTHIO_WAVETABLE_MAX_LEVELS && ((size_t)2 << level_count) <= length) {
+        level_count++;
+    }
+
+    size_t total = 0;
+    for (int level = 0; level < level_count; level++) {
+        uint8_t level_shift = 0;
+        if (level > 0) {
+            level_shift = self->level_shift[level - 1];
+            size_t previous_length = length >> level_shift;
+            if (previous_length % 2 == 0 && previous_length / 2 >= SYNTHIO_WAVETABLE_MIN_LEVEL_LENGTH) {
+                level_shift++;
+            }
+        }
+        self->level_shift[level] = level_shift;
+        self->level_offset[level] = total;
+        total += length >> level_shift;
+    }
+
+    // one spare sample so that an index at the very end of the last level stays in bounds
+    self->samples = m_malloc((total + 1) * sizeof(int16_t));
+    self->length = length;
+    self->level_count = level_count;
+    memcpy(self->samples, waveform, length * sizeof(int16_t));
+
+    mp_float_t taps[HALFBAND_SIDE_TAPS];
+    mp_float_t sum = 0;
+    for (size_t j = 0; j < HALFBAND_SIDE_TAPS; j++) {
+        mp_float_t n = (mp_float_t)(2 * j + 1);
+        mp_float_t window = MICROPY_FLOAT_CONST(0.42)
+            + MICROPY_FLOAT_CONST(0.5) * MICROPY_FLOAT_C_FUN(cos)(MP_PI * n / (2 * HALFBAND_SIDE_TAPS))
+            + MICROPY_FLOAT_CONST(0.08) * MICROPY_FLOAT_C_FUN(cos)(2 * MP_PI * n / (2 * HALFBAND_SIDE_TAPS));
+        taps[j] = ((j % 2) ? -window : window) / (MP_PI * n);
+        sum += taps[j];
+    }
+    // the odd taps of a half-band filter with unity DC gain sum to 1/4
+    for (size_t j = 0; j < HALFBAND_SIDE_TAPS; j++) {
+        taps[j] *= MICROPY_FLOAT_CONST(0.25) / sum;
+    }
+
+    // Each level halves the bandwidth of the one before. Once levels stop
+    // getting shorter, the filter is spread out to reach the lower cutoff.
+    for (int level = 1; level < level_count; level++) {
+        uint8_t previous_shift = self->level_shift[level - 1];
+        filter_level(self->samples + self->level_offset[level],
+            self->samples + self->level_offset[level - 1],
+            length >> previous_shift,
+            (size_t)1 << (level - 1 - previous_shift),
+            (size_t)1 << (self->level_shift[level] - previous_shift),
+            taps);
+    }
+    self->samples[total] = self->samples[self->level_offset[level_count - 1]];
+}
+
+mp_int_t common_hal_synthio_wavetable_get_levels(synthio_wavetable_obj_t *self) {
+    return self->level_count;
+}
+
+void common_hal_synthio_wavetable_get_buffer(synthio_wavetable_obj_t *self, mp_buffer_info_t *bufinfo) {
+    bufinfo->buf = self->samples;
+    bufinfo->len = self->length * sizeof(int16_t);
+    bufinfo->typecode = 'h';
+}
+
+const int16_t *synthio_wavetable_select_level(mp_obj_t waveform_obj, const int16_t *waveform, uint32_t waveform_start, uint32_t waveform_length, uint32_t dds_rate, uint8_t *shift) {
+    *shift = 0;
+    if (!mp_obj_is_type(waveform_obj, &synthio_wavetable_type)) {
+        return waveform;
+    }
+    synthio_wavetable_obj_t *self = MP_OBJ_TO_PTR(waveform_obj);
+    // loop points don't survive filtering, so a looped section plays from the original
+    if (waveform_start != 0 || waveform_length != self->length) {
+        return waveform;
+    }
+    // Level k keeps harmonics up to length / 2^(k+1), which stay below nyquist
+    // while the oscillator advances at most 2^k samples of the original per
+    // output sample.
+    int level = 0;
+    while (level + 1 < self->level_count && (dds_rate >> level) > (1u << SYNTHIO_FREQUENCY_SHIFT)) {
+        level++;
+    }
+    *shift = self->level_shift[level];
+    return self->samples + self->level_offset[level];
+}
@@ -0,0 +1,36 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2023 Jeff Epler for Adafruit Industries
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+// Enough levels to take a waveform of SYNTHIO_WAVEFORM_SIZE down to its fundamental
+#define SYNTHIO_WAVETABLE_MAX_LEVELS (14)
+
+// The oscillator does not interpolate, so very short levels would add
+// distortion of their own. Levels are decimated down to this length and after
+// that only filtered.
+#ifndef SYNTHIO_WAVETABLE_MIN_LEVEL_LENGTH
+#define SYNTHIO_WAVETABLE_MIN_LEVEL_LENGTH (256)
+#endif
+
+typedef struct {
+    mp_obj_base_t base;
+    // All levels back to back, starting with the original waveform. Level k
+    // keeps harmonics up to length / 2^(k+1) and has length >> level_shift[k]
+    // samples.
+    int16_t *samples;
+    uint32_t level_offset[SYNTHIO_WAVETABLE_MAX_LEVELS];
+    uint8_t level_shift[SYNTHIO_WAVETABLE_MAX_LEVELS];
+    uint16_t length;
+    uint8_t level_count;
+} synthio_wavetable_obj_t;
+
+// Return the level of waveform_obj to play at dds_rate (if it is a Wavetable
+// and the whole waveform is being played), or waveform unchanged. *shift is how
+// many octaves the returned waveform is decimated by.
+const int16_t *synthio_wavetable_select_level(mp_obj_t waveform_obj, const int16_t *waveform, uint32_t waveform_start, uint32_t waveform_length, uint32_t dds_rate, uint8_t *shift);
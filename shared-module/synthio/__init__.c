@@ -9,6 +9,7 @@
 #include "shared-bindings/synthio/__init__.h"
 #include "shared-module/synthio/Biquad.h"
 #include "shared-module/synthio/Note.h"
+#include "shared-module/synthio/Wavetable.h"
 #include "py/runtime.h"
 #include <math.h>
 #include <stdlib.h>
@@ -152,6 +153,15 @@ int16_t mix_down_sample(int32_t sample) {
     return sample;
 }
 
+// The rate to glide from at the start of a block. A new note, or a rate that
+// was for a longer waveform, starts directly at the new rate.
+static uint32_t ramp_start_rate(uint32_t last_rate, uint32_t rate, uint32_t lim) {
+    if (last_rate == 0 || last_rate > lim / 2) {
+        return rate;
+    }
+    return last_rate;
+}
+
 static bool synth_note_into_buffer(synthio_synth_t *synth, int chan, int32_t *out_buffer32, int16_t dur, int16_t loudness[2]) {
     mp_obj_t note_obj = synth->span.note_obj[chan];
 
@@ -159,11 +169,13 @@ static bool synth_note_into_buffer(synthio_synth_t *synth, int chan, int32_t *ou
 
 
     uint32_t dds_rate;
+    mp_obj_t waveform_obj = synth->waveform_obj;
     const int16_t *waveform = synth->waveform_bufinfo.buf;
     uint32_t waveform_start = 0;
     uint32_t waveform_length = synth->waveform_bufinfo.len;
 
     uint32_t ring_dds_rate = 0;
+    mp_obj_t ring_waveform_obj = mp_const_none;
     const int16_t *ring_waveform = NULL;
     uint32_t ring_waveform_start = 0;
     uint32_t ring_waveform_length = 0;
@@ -182,6 +194,7 @@ static bool synth_note_into_buffer(synthio_synth_t *synth, int chan, int32_t *ou
         synthio_note_obj_t *note = MP_OBJ_TO_PTR(note_obj);
         int32_t frequency_scaled = synthio_note_step(note, sample_rate, dur, loudness);
         if (note->waveform_buf.buf) {
+            waveform_obj = note->waveform_obj;
             waveform = note->waveform_buf.buf;
             waveform_length = note->waveform_buf.len;
             if (note->waveform_loop_start > 0 && note->waveform_loop_start < waveform_length) {
@@ -193,6 +206,7 @@ static bool synth_note_into_buffer(synthio_synth_t *synth, int chan, int32_t *ou
         }
         dds_rate = synthio_frequency_convert_scaled_to_dds((uint64_t)frequency_scaled * (waveform_length - waveform_start), sample_rate);
         if (note->ring_frequency_scaled != 0 && note->ring_waveform_buf.buf) {
+            ring_waveform_obj = note->ring_waveform_obj;
             ring_waveform = note->ring_waveform_buf.buf;
             ring_waveform_length = note->ring_waveform_buf.len;
             if (note->ring_waveform_loop_start > 0 && note->ring_waveform_loop_start < ring_waveform_length) {
@@ -215,6 +229,7 @@ static bool synth_note_into_buffer(synthio_synth_t *synth, int chan, int32_t *ou
 
     if (dds_rate > lim / 2) {
         // beyond nyquist, can't play note
+        synth->last_dds_rate[chan] = 0;
         return false;
     }
 
@@ -223,14 +238,26 @@ static bool synth_note_into_buffer(synthio_synth_t *synth, int chan, int32_t *ou
         accum = accum % lim + offset;
     }
 
+    // glide from the previous block's rate so that bends don't step
+    uint32_t rate = ramp_start_rate(synth->last_dds_rate[chan], dds_rate, lim);
+    int32_t rate_step = ((int32_t)dds_rate - (int32_t)rate) / dur;
+    synth->last_dds_rate[chan] = dds_rate;
+
+    // the phase stays in units of the full waveform; a decimated level just
+    // takes fewer bits of it as the index
+    uint8_t level_shift;
+    waveform = synthio_wavetable_select_level(waveform_obj, waveform, waveform_start, waveform_length, MAX(rate, dds_rate), &level_shift);
+    int shift = SYNTHIO_FREQUENCY_SHIFT + level_shift;
+
     // first, fill with waveform
     for (uint16_t i = 0; i < dur; i++) {
-        accum += dds_rate;
+        rate += rate_step;
+        accum += rate;
         // because dds_rate is low enough, the subtraction is guaranteed to go back into range, no expensive modulo needed
         if (accum > lim) {
             accum = accum - lim + offset;
         }
-        int16_t idx = accum >> SYNTHIO_FREQUENCY_SHIFT;
+        int16_t idx = accum >> shift;
         out_buffer32[i] = waveform[idx];
     }
     synth->accum[chan] = accum;
@@ -252,13 +279,21 @@ static bool synth_note_into_buffer(synthio_synth_t *synth, int chan, int32_t *ou
             accum = accum % lim + offset;
         }
 
+        rate = ramp_start_rate(synth->last_ring_dds_rate[chan], ring_dds_rate, lim);
+        rate_step = ((int32_t)ring_dds_rate - (int32_t)rate) / dur;
+        synth->last_ring_dds_rate[chan] = ring_dds_rate;
+
+        ring_waveform = synthio_wavetable_select_level(ring_waveform_obj, ring_waveform, ring_waveform_start, ring_waveform_length, MAX(rate, ring_dds_rate), &level_shift);
+        shift = SYNTHIO_FREQUENCY_SHIFT + level_shift;
+
         for (uint16_t i = 0; i < dur; i++) {
-            accum += ring_dds_rate;
+            rate += rate_step;
+            accum += rate;
             // because dds_rate is low enough, the subtraction is guaranteed to go back into range, no expensive modulo needed
             if (accum > lim) {
                 accum = accum - lim + offset;
             }
-            int16_t idx = accum >> SYNTHIO_FREQUENCY_SHIFT;
+            int16_t idx = accum >> shift;
             int16_t wi = (ring_waveform[idx] * out_buffer32[i]) / 32768;
             out_buffer32[i] = wi;
         }
@@ -278,15 +313,26 @@ static mp_obj_t synthio_synth_get_note_filter(mp_obj_t note_obj) {
     return mp_const_none;
 }
 
-static void sum_with_loudness(int32_t *out_buffer32, int32_t *tmp_buffer32, int16_t loudness[2], size_t dur, int synth_chan) {
+#define NO_LAST_LOUDNESS (INT16_MIN)
+
+// Loudness is ramped linearly from where the previous block ended, in steps of
+// 1/256, so that envelope and LFO changes don't step at block boundaries.
+static void sum_with_loudness(int32_t *out_buffer32, int32_t *tmp_buffer32, const int16_t last_loudness[2], const int16_t loudness[2], size_t dur, int synth_chan) {
+    int32_t left = last_loudness[0] * 256;
+    int32_t left_step = (loudness[0] - last_loudness[0]) * 256 / (int32_t)dur;
     if (synth_chan == 1) {
         for (size_t i = 0; i < dur; i++) {
-            *out_buffer32++ += (*tmp_buffer32++ *loudness[0]) >> 16;
+            left += left_step;
+            *out_buffer32++ += (*tmp_buffer32++ *(left >> 8)) >> 16;
         }
     } else {
+        int32_t right = last_loudness[1] * 256;
+        int32_t right_step = (loudness[1] - last_loudness[1]) * 256 / (int32_t)dur;
         for (size_t i = 0; i < dur; i++) {
-            *out_buffer32++ += (*tmp_buffer32 * loudness[0]) >> 16;
-            *out_buffer32++ += (*tmp_buffer32++ *loudness[1]) >> 16;
+            left += left_step;
+            right += right_step;
+            *out_buffer32++ += (*tmp_buffer32 * (left >> 8)) >> 16;
+            *out_buffer32++ += (*tmp_buffer32++ *(right >> 8)) >> 16;
         }
     }
 }
@@ -314,7 +360,8 @@ void synthio_synth_synthesize(synthio_synth_t *synth, uint8_t **bufptr, uint32_t
 
     for (int chan = 0; chan < CIRCUITPY_SYNTHIO_MAX_CHANNELS; chan++) {
         mp_obj_t note_obj = synth->span.note_obj[chan];
-        if (note_obj == SYNTHIO_SILENCE) {
+        // an empty block, as at the end of a MidiTrack, has no ramps to compute
+        if (note_obj == SYNTHIO_SILENCE || dur == 0) {
             continue;
         }
 
@@ -329,25 +376,46 @@ void synthio_synth_synthesize(synthio_synth_t *synth, uint8_t **bufptr, uint32_t
         if (!synth_note_into_buffer(synth, chan, tmp_buffer32, dur, loudness)) {
             // for some other reason, such as being above nyquist, note
             // couldn't be synthed, so don't filter or sum it in
+            synth->last_loudness[chan][0] = synth->last_loudness[chan][1] = 0;
             continue;
         }
 
         mp_obj_t filter_obj = synthio_synth_get_note_filter(note_obj);
         if (filter_obj != mp_const_none) {
             synthio_note_obj_t *note = MP_OBJ_TO_PTR(note_obj);
-            synthio_biquad_filter_samples(&note->filter_state, tmp_buffer32, dur);
+            synthio_biquad_cascade_samples(&note->filter_state, tmp_buffer32, dur, 1);
         }
 
         // adjust loudness by envelope
-        sum_with_loudness(out_buffer32, tmp_buffer32, loudness, dur, synth->channel_count);
+        if (synth->last_loudness[chan][0] == NO_LAST_LOUDNESS) {
+            // a note's first block starts right at its loudness
+            synth->last_loudness[chan][0] = loudness[0];
+            synth->last_loudness[chan][1] = loudness[1];
+        }
+        sum_with_loudness(out_buffer32, tmp_buffer32, synth->last_loudness[chan], loudness, dur, synth->channel_count);
+        synth->last_loudness[chan][0] = loudness[0];
+        synth->last_loudness[chan][1] = loudness[1];
     }
 
     int16_t *out_buffer16 = (int16_t *)(void *)synth->buffers[synth->buffer_index];
 
     // mix down audio
-    for (size_t i = 0; i < dur * synth->channel_count; i++) {
-        int32_t sample = out_buffer32[i];
-        out_buffer16[i] = mix_down_sample(sample);
+    if (synth->filter_obj != mp_const_none) {
+        // filter after compression, where samples are back within 16 bits
+        for (size_t i = 0; i < dur * synth->channel_count; i++) {
+            out_buffer32[i] = mix_down_sample(out_buffer32[i]);
+        }
+        for (int c = 0; c < synth->channel_count; c++) {
+            synthio_biquad_cascade_samples(&synth->output_filter[c], out_buffer32 + c, dur, synth->channel_count);
+        }
+        for (size_t i = 0; i < dur * synth->channel_count; i++) {
+            out_buffer16[i] = MIN(32767, MAX(-32768, out_buffer32[i]));
+        }
+    } else {
+        for (size_t i = 0; i < dur * synth->channel_count; i++) {
+            int32_t sample = out_buffer32[i];
+            out_buffer16[i] = mix_down_sample(sample);
+        }
     }
 
     // advance envelope states
@@ -368,6 +436,9 @@ void synthio_synth_reset_buffer(synthio_synth_t *synth, bool single_channel_outp
         return;
     }
     synth->other_channel = -1;
+    for (int c = 0; c < synth->channel_count; c++) {
+        synthio_biquad_cascade_reset(&synth->output_filter[c]);
+    }
 }
 
 bool synthio_synth_deinited(synthio_synth_t *synth) {
@@ -388,6 +459,17 @@ mp_obj_t synthio_synth_envelope_get(synthio_synth_t *synth) {
     return synth->envelope_obj;
 }
 
+void synthio_synth_filter_set(synthio_synth_t *synth, mp_obj_t filter_obj) {
+    for (int c = 0; c < synth->channel_count; c++) {
+        synthio_biquad_cascade_assign(&synth->output_filter[c], filter_obj);
+    }
+    synth->filter_obj = filter_obj;
+}
+
+mp_obj_t synthio_synth_filter_get(synthio_synth_t *synth) {
+    return synth->filter_obj;
+}
+
 void synthio_synth_init(synthio_synth_t *synth, uint32_t sample_rate, int channel_count, mp_obj_t waveform_obj, mp_obj_t envelope_obj) {
     synthio_synth_parse_waveform(&synth->waveform_bufinfo, waveform_obj);
     mp_arg_validate_int_range(channel_count, 1, 2, MP_QSTR_channel_count);
@@ -398,6 +480,7 @@ void synthio_synth_init(synthio_synth_t *synth, uint32_t sample_rate, int channe
     synth->other_channel = -1;
     synth->waveform_obj = waveform_obj;
     synth->sample_rate = sample_rate;
+    synth->filter_obj = mp_const_none;
     synthio_synth_envelope_set(synth, envelope_obj);
 
     for (size_t i = 0; i < CIRCUITPY_SYNTHIO_MAX_CHANNELS; i++) {
@@ -471,6 +554,9 @@ bool synthio_span_change_note(synthio_synth_t *synth, mp_obj_t old_note, mp_obj_
             synth->span.note_obj[channel] = new_note;
             synthio_envelope_state_init(&synth->envelope_state[channel], synthio_synth_get_note_envelope(synth, new_note));
             synth->accum[channel] = 0;
+            synth->last_dds_rate[channel] = 0;
+            synth->last_ring_dds_rate[channel] = 0;
+            synth->last_loudness[channel][0] = NO_LAST_LOUDNESS;
         }
         return true;
     }
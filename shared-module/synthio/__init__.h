@@ -8,13 +8,18 @@
 
 #define SYNTHIO_BITS_PER_SAMPLE (16)
 #define SYNTHIO_BYTES_PER_SAMPLE (SYNTHIO_BITS_PER_SAMPLE / 8)
+// Samples per block. Envelopes and LFOs advance once per block and are ramped
+// between blocks, so a board can raise this to spend less time evaluating them.
+#ifndef SYNTHIO_MAX_DUR
 #define SYNTHIO_MAX_DUR (256)
+#endif
 #define SYNTHIO_SILENCE (mp_const_none)
 #define SYNTHIO_NOTE_IS_SIMPLE(note) (mp_obj_is_small_int(note))
 #define SYNTHIO_NOTE_IS_PLAYING(synth, i) ((synth)->envelope_state[(i)].state != SYNTHIO_ENVELOPE_STATE_RELEASE)
 #define SYNTHIO_FREQUENCY_SHIFT (16)
 
 #include "shared-module/audiocore/__init__.h"
+#include "shared-module/synthio/Biquad.h"
 #include "shared-bindings/synthio/__init__.h"
 
 typedef struct {
@@ -47,9 +52,15 @@ typedef struct synthio_synth {
     mp_buffer_info_t waveform_bufinfo;
     synthio_envelope_definition_t global_envelope_definition;
     mp_obj_t waveform_obj, filter_obj, envelope_obj;
+    // applied to each channel of the mixed-down output
+    biquad_cascade_state output_filter[2];
     synthio_midi_span_t span;
     uint32_t accum[CIRCUITPY_SYNTHIO_MAX_CHANNELS];
     uint32_t ring_accum[CIRCUITPY_SYNTHIO_MAX_CHANNELS];
+    // Where each channel ended the previous block; the next block ramps from here.
+    uint32_t last_dds_rate[CIRCUITPY_SYNTHIO_MAX_CHANNELS];
+    uint32_t last_ring_dds_rate[CIRCUITPY_SYNTHIO_MAX_CHANNELS];
+    int16_t last_loudness[CIRCUITPY_SYNTHIO_MAX_CHANNELS][2];
     synthio_envelope_state_t envelope_state[CIRCUITPY_SYNTHIO_MAX_CHANNELS];
 } synthio_synth_t;
 
@@ -107,9 +107,8 @@ size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, con
                 if (i[0] == '[') {
                     if (i[1] == 'K') {
                         // Clear the rest of the line.
-                        for (uint16_t k = self->cursor_x; k < self->scroll_area->width_in_tiles; k++) {
-                            common_hal_displayio_tilegrid_set_tile(self->scroll_area, k, self->cursor_y, 0);
-                        }
+                        displayio_tilegrid_set_row_tiles(self->scroll_area, self->cursor_x, self->cursor_y,
+                            self->scroll_area->width_in_tiles - self->cursor_x, 0);
                         i += 2;
                     } else {
                         if (c == 'D') {
@@ -181,12 +180,11 @@ size_t common_hal_terminalio_terminal_write(terminalio_terminal_obj_t *self, con
             self->cursor_y %= self->scroll_area->height_in_tiles;
         }
         if (self->cursor_y != start_y) {
-            // clear the new row in case of scroll up
+            // clear the new row in case of scroll up. Scrolling only moves the ring buffer's top
+            // left so the rest of the rows aren't rewritten.
             if (self->cursor_y == self->scroll_area->top_left_y) {
-                for (uint16_t j = 0; j < self->scroll_area->width_in_tiles; j++) {
-                    common_hal_displayio_tilegrid_set_tile(self->scroll_area, j, self->cursor_y, 0);
-                }
                 common_hal_displayio_tilegrid_set_top_left(self->scroll_area, 0, (self->cursor_y + self->scroll_area->height_in_tiles + 1) % self->scroll_area->height_in_tiles);
+                displayio_tilegrid_set_row_tiles(self->scroll_area, 0, self->cursor_y, self->scroll_area->width_in_tiles, 0);
             }
             start_y = self->cursor_y;
         }
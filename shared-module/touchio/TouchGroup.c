@@ -0,0 +1,159 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "py/mphal.h"
+#include "shared-bindings/touchio/TouchGroup.h"
+#include "shared-bindings/microcontroller/Pin.h"
+
+// The same charge and discharge timing as TouchIn, done for every pad at once:
+// all pads are charged together and one loop watches them all discharge. The
+// raw values count passes of that loop, so they are in different units from
+// TouchIn's, but they only matter relative to each pad's baseline.
+
+#define N_SAMPLES 10
+#define TIMEOUT_TICKS 10000
+
+// A baseline moves 1/2**BASELINE_SHIFT of the way to each untouched reading.
+#define BASELINE_SHIFT 4
+
+static void measure(touchio_touchgroup_obj_t *self) {
+    size_t pad_count = self->pad_count;
+    memset(self->raw_values, 0, pad_count * sizeof(uint16_t));
+    uint32_t all = pad_count == 32 ? 0xffffffff : (1u << pad_count) - 1;
+
+    for (uint16_t sample = 0; sample < N_SAMPLES; sample++) {
+        for (size_t i = 0; i < pad_count; i++) {
+            common_hal_digitalio_digitalinout_switch_to_output(&self->pads[i], true, DRIVE_MODE_PUSH_PULL);
+        }
+        mp_hal_delay_us(10);
+        for (size_t i = 0; i < pad_count; i++) {
+            common_hal_digitalio_digitalinout_switch_to_input(&self->pads[i], PULL_NONE);
+        }
+
+        uint32_t charged = all;
+        while (charged != 0) {
+            for (size_t i = 0; i < pad_count; i++) {
+                uint32_t bit = 1u << i;
+                if ((charged & bit) == 0) {
+                    continue;
+                }
+                if (!common_hal_digitalio_digitalinout_get_value(&self->pads[i]) ||
+                    self->raw_values[i] >= TIMEOUT_TICKS) {
+                    charged &= ~bit;
+                } else {
+                    self->raw_values[i]++;
+                }
+            }
+        }
+    }
+}
+
+static uint16_t threshold(touchio_touchgroup_obj_t *self, size_t i) {
+    uint32_t baseline = self->baselines[i];
+    return MIN(baseline + baseline / 20 + self->margin, UINT16_MAX);
+}
+
+void common_hal_touchio_touchgroup_construct(touchio_touchgroup_obj_t *self,
+    const mcu_pin_obj_t **pins, size_t pad_count, uint16_t margin, uint8_t debounce) {
+    self->pads = m_new(digitalio_digitalinout_obj_t, pad_count);
+    self->raw_values = m_new(uint16_t, pad_count);
+    self->baselines = m_new(uint16_t, pad_count);
+    self->debounce_counter = m_new0(int8_t, pad_count);
+    self->pad_count = pad_count;
+    self->margin = margin;
+    self->debounce_threshold = debounce;
+    self->touched = 0;
+
+    for (size_t i = 0; i < pad_count; i++) {
+        common_hal_mcu_pin_claim(pins[i]);
+        common_hal_digitalio_digitalinout_construct(&self->pads[i], pins[i]);
+    }
+
+    measure(self);
+    for (size_t i = 0; i < pad_count; i++) {
+        if (self->raw_values[i] >= TIMEOUT_TICKS) {
+            common_hal_touchio_touchgroup_deinit(self);
+            mp_raise_ValueError(MP_ERROR_TEXT("No pulldown on pin; 1Mohm recommended"));
+        }
+        self->baselines[i] = self->raw_values[i];
+    }
+}
+
+bool common_hal_touchio_touchgroup_deinited(touchio_touchgroup_obj_t *self) {
+    return self->pads == NULL;
+}
+
+void common_hal_touchio_touchgroup_deinit(touchio_touchgroup_obj_t *self) {
+    if (common_hal_touchio_touchgroup_deinited(self)) {
+        return;
+    }
+    for (size_t i = 0; i < self->pad_count; i++) {
+        common_hal_digitalio_digitalinout_deinit(&self->pads[i]);
+    }
+    self->pads = NULL;
+}
+
+size_t common_hal_touchio_touchgroup_get_pad_count(touchio_touchgroup_obj_t *self) {
+    return self->pad_count;
+}
+
+uint32_t common_hal_touchio_touchgroup_update(touchio_touchgroup_obj_t *self) {
+    measure(self);
+    uint32_t changed = 0;
+    for (size_t i = 0; i < self->pad_count; i++) {
+        uint32_t bit = 1u << i;
+        uint16_t raw = self->raw_values[i];
+        bool over = raw > threshold(self, i);
+        // Count agreeing readings the same way keypad does, and flip the
+        // state when enough of them have been seen in a row.
+        int8_t *counter = &self->debounce_counter[i];
+        if (over) {
+            *counter = *counter < 0 ? 1 : MIN(*counter + 1, self->debounce_threshold);
+        } else {
+            *counter = *counter > 0 ? -1 : MAX(*counter - 1, -self->debounce_threshold);
+        }
+        bool touched = (self->touched & bit) != 0;
+        if (!touched && *counter >= self->debounce_threshold) {
+            self->touched |= bit;
+            changed |= bit;
+        } else if (touched && *counter <= -self->debounce_threshold) {
+            self->touched &= ~bit;
+            changed |= bit;
+        }
+        // Follow slow drift in the pad while it isn't touched.
+        if ((self->touched & bit) == 0 && !over) {
+            int32_t baseline = self->baselines[i];
+            int32_t step = ((int32_t)raw - baseline) / (1 << BASELINE_SHIFT);
+            if (step == 0 && raw != baseline) {
+                step = raw > baseline ? 1 : -1;
+            }
+            self->baselines[i] = baseline + step;
+        }
+    }
+    return changed;
+}
+
+uint32_t common_hal_touchio_touchgroup_get_touched(touchio_touchgroup_obj_t *self) {
+    return self->touched;
+}
+
+const uint16_t *common_hal_touchio_touchgroup_get_raw_values(touchio_touchgroup_obj_t *self) {
+    return self->raw_values;
+}
+
+const uint16_t *common_hal_touchio_touchgroup_get_baselines(touchio_touchgroup_obj_t *self) {
+    return self->baselines;
+}
+
+void common_hal_touchio_touchgroup_recalibrate(touchio_touchgroup_obj_t *self) {
+    measure(self);
+    memcpy(self->baselines, self->raw_values, self->pad_count * sizeof(uint16_t));
+    memset(self->debounce_counter, 0, self->pad_count);
+    self->touched = 0;
+}
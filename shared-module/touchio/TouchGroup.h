@@ -0,0 +1,28 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "common-hal/microcontroller/Pin.h"
+#include "shared-bindings/digitalio/DigitalInOut.h"
+
+#include "py/obj.h"
+
+// Pads are tracked in a bitmask.
+#define TOUCHIO_TOUCHGROUP_MAX_PADS (32)
+
+typedef struct {
+    mp_obj_base_t base;
+    digitalio_digitalinout_obj_t *pads;
+    uint16_t *raw_values;
+    uint16_t *baselines;
+    int8_t *debounce_counter;
+    // Bit n is set while pad n is touched.
+    uint32_t touched;
+    uint16_t margin;
+    uint8_t pad_count;
+    uint8_t debounce_threshold;
+} touchio_touchgroup_obj_t;
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: MIT
 
 #include <stdint.h>
+#include <string.h>
 
 #include "py/bc.h"
 #include "py/binary.h"
@@ -16,13 +17,11 @@
 #include "py/objstr.h"
 #include "py/objtype.h"
 #include "py/runtime.h"
+#include "py/stream.h"
 
 #include "shared-bindings/uheap/__init__.h"
 
-#define VERIFY_PTR(ptr) ( \
-    (void *)ptr >= (void *)MP_STATE_MEM(gc_pool_start)         /* must be above start of pool */ \
-    && (void *)ptr < (void *)MP_STATE_MEM(gc_pool_end)            /* must be below end of pool */ \
-    )
+#define VERIFY_PTR(ptr) gc_ptr_on_heap((void *)(ptr))
 
 static void indent(uint8_t levels) {
     for (int i = 0; i < levels; i++) {
@@ -41,6 +40,10 @@ static uint32_t int_size(uint8_t indent_level, mp_obj_t obj) {
     }
     #if MICROPY_LONGINT_IMPL == MICROPY_LONGINT_IMPL_MPZ
     mp_obj_int_t *i = MP_OBJ_TO_PTR(obj);
+    if (i->mpz.fixed_dig) {
+        // The digits are stored in the object's own block.
+        return gc_nbytes(obj);
+    }
     return gc_nbytes(obj) + gc_nbytes(i->mpz.dig);
     #else
     return gc_nbytes(obj);
@@ -65,7 +68,7 @@ static uint32_t string_size(uint8_t indent_level, mp_obj_t obj) {
 
 static uint32_t map_size(uint8_t indent_level, const mp_map_t *map) {
     uint32_t total_size = gc_nbytes(map->table);
-    for (int i = 0; i < map->used; i++) {
+    for (size_t i = 0; i < map->used; i++) {
         uint32_t this_size = 0;
         indent(indent_level);
         if (map->table[i].key != NULL) {
@@ -112,25 +115,7 @@ static uint32_t function_size(uint8_t indent_level, mp_obj_t obj) {
         return 0;
     } else if (mp_obj_is_type(obj, &mp_type_fun_bc)) {
         mp_obj_fun_bc_t *fn = MP_OBJ_TO_PTR(obj);
-        uint32_t total_size = gc_nbytes(fn) + gc_nbytes(fn->bytecode) + gc_nbytes(fn->const_table);
-        #if MICROPY_DEBUG_PRINTERS
-        mp_printf(&mp_plat_print, "BYTECODE START\n");
-        mp_bytecode_print(fn, fn->bytecode, gc_nbytes(fn->bytecode), fn->const_table);
-        mp_printf(&mp_plat_print, "BYTECODE END\n");
-        #endif
-        return total_size;
-    #if MICROPY_EMIT_NATIVE
-    } else if (mp_obj_is_type(obj, &mp_type_fun_native)) {
-        return 0;
-    #endif
-    #if MICROPY_EMIT_NATIVE
-    } else if (mp_obj_is_type(obj, &mp_obj_fun_viper_t)) {
-        return 0;
-    #endif
-    #if MICROPY_EMIT_THUMB
-    } else if (mp_obj_is_type(obj, &mp_type_fun_asm)) {
-        return 0;
-    #endif
+        return gc_nbytes(fn) + gc_nbytes(fn->bytecode) + gc_nbytes(fn->child_table);
     }
     return 0;
 }
@@ -195,8 +180,8 @@ static uint32_t type_size(uint8_t indent_level, mp_obj_type_t *type) {
     // // these are for dynamically created types (classes)
     // struct _mp_obj_tuple_t *bases_tuple;
     // struct _mp_obj_dict_t *locals_dict;
-    if (type->locals_dict != NULL) {
-        total_size += dict_size(indent_level, type->locals_dict);
+    if (MP_OBJ_TYPE_HAS_SLOT(type, locals_dict)) {
+        total_size += dict_size(indent_level, MP_OBJ_TYPE_GET_SLOT(type, locals_dict));
     }
 
     indent(indent_level);
@@ -270,3 +255,197 @@ uint32_t shared_module_uheap_info(mp_obj_t obj) {
     }
     return object_size(0, obj);
 }
+
+// Snapshot classes. These numbers are part of the snapshot format, so only
+// add new ones at the end. tools/heap_snapshot.py has the same list.
+enum {
+    SNAPSHOT_CLASS_UNKNOWN,
+    SNAPSHOT_CLASS_STR,
+    SNAPSHOT_CLASS_BYTES,
+    SNAPSHOT_CLASS_BYTEARRAY,
+    SNAPSHOT_CLASS_ARRAY,
+    SNAPSHOT_CLASS_LIST,
+    SNAPSHOT_CLASS_TUPLE,
+    SNAPSHOT_CLASS_DICT,
+    SNAPSHOT_CLASS_SET,
+    SNAPSHOT_CLASS_FLOAT,
+    SNAPSHOT_CLASS_INT,
+    SNAPSHOT_CLASS_FUNCTION,
+    SNAPSHOT_CLASS_MODULE,
+    SNAPSHOT_CLASS_TYPE,
+    SNAPSHOT_CLASS_INSTANCE,
+    SNAPSHOT_CLASS_GENERATOR,
+};
+
+#define SNAPSHOT_VERSION (1)
+#define SNAPSHOT_TAG_FREE (0x00)
+#define SNAPSHOT_TAG_ALLOCATED (0x40)
+#define SNAPSHOT_TAG_FINALISER (0x20)
+#define SNAPSHOT_TAG_REPEAT (0x80)
+#define SNAPSHOT_TAG_AREA (0xff)
+
+static const struct {
+    const mp_obj_type_t *type;
+    uint8_t snapshot_class;
+} snapshot_types[] = {
+    { &mp_type_str, SNAPSHOT_CLASS_STR },
+    { &mp_type_bytes, SNAPSHOT_CLASS_BYTES },
+    #if MICROPY_PY_BUILTINS_BYTEARRAY
+    { &mp_type_bytearray, SNAPSHOT_CLASS_BYTEARRAY },
+    #endif
+    #if MICROPY_PY_ARRAY
+    { &mp_type_array, SNAPSHOT_CLASS_ARRAY },
+    #endif
+    #if MICROPY_PY_BUILTINS_MEMORYVIEW
+    { &mp_type_memoryview, SNAPSHOT_CLASS_ARRAY },
+    #endif
+    { &mp_type_list, SNAPSHOT_CLASS_LIST },
+    { &mp_type_tuple, SNAPSHOT_CLASS_TUPLE },
+    { &mp_type_dict, SNAPSHOT_CLASS_DICT },
+    #if MICROPY_PY_BUILTINS_SET
+    { &mp_type_set, SNAPSHOT_CLASS_SET },
+    #endif
+    #if MICROPY_PY_BUILTINS_FROZENSET
+    { &mp_type_frozenset, SNAPSHOT_CLASS_SET },
+    #endif
+    #if MICROPY_PY_BUILTINS_FLOAT
+    { &mp_type_float, SNAPSHOT_CLASS_FLOAT },
+    #endif
+    { &mp_type_int, SNAPSHOT_CLASS_INT },
+    { &mp_type_fun_bc, SNAPSHOT_CLASS_FUNCTION },
+    { &mp_type_module, SNAPSHOT_CLASS_MODULE },
+    { &mp_type_type, SNAPSHOT_CLASS_TYPE },
+    { &mp_type_gen_instance, SNAPSHOT_CLASS_GENERATOR },
+};
+
+// Guesses the class of an allocation from its first word. Only pointer
+// comparisons are made, except to follow a pointer to a heap allocated type,
+// so buffers that aren't objects are safe to look at.
+static uint8_t snapshot_class(void *ptr) {
+    const mp_obj_type_t *type = ((mp_obj_base_t *)ptr)->type;
+    for (size_t i = 0; i < MP_ARRAY_SIZE(snapshot_types); i++) {
+        if (type == snapshot_types[i].type) {
+            return snapshot_types[i].snapshot_class;
+        }
+    }
+    if (gc_nbytes(type) != 0 && ((mp_obj_base_t *)type)->type == &mp_type_type) {
+        return SNAPSHOT_CLASS_INSTANCE;
+    }
+    return SNAPSHOT_CLASS_UNKNOWN;
+}
+
+typedef struct {
+    // Buffer destination, or NULL to write to stream.
+    byte *dest;
+    size_t dest_len;
+    mp_obj_t stream;
+    size_t written;
+    // Bytes waiting to be written to stream.
+    byte chunk[64];
+    size_t chunk_len;
+    // The last allocation record and how many times it has repeated since.
+    uint8_t last_tag;
+    size_t last_blocks;
+    size_t repeats;
+} snapshot_writer_t;
+
+static void snapshot_flush(snapshot_writer_t *writer) {
+    if (writer->chunk_len == 0) {
+        return;
+    }
+    int errcode;
+    mp_stream_write_exactly(writer->stream, writer->chunk, writer->chunk_len, &errcode);
+    if (errcode != 0) {
+        mp_raise_OSError(errcode);
+    }
+    writer->chunk_len = 0;
+}
+
+static void snapshot_write_byte(snapshot_writer_t *writer, byte b) {
+    if (writer->dest != NULL) {
+        if (writer->written == writer->dest_len) {
+            mp_raise_ValueError(MP_ERROR_TEXT("Buffer too small"));
+        }
+        writer->dest[writer->written] = b;
+    } else {
+        if (writer->chunk_len == sizeof(writer->chunk)) {
+            snapshot_flush(writer);
+        }
+        writer->chunk[writer->chunk_len++] = b;
+    }
+    writer->written++;
+}
+
+// Unsigned LEB128, like the lengths in .mpy files.
+static void snapshot_write_uint(snapshot_writer_t *writer, size_t value) {
+    while (value >= 0x80) {
+        snapshot_write_byte(writer, 0x80 | (value & 0x7f));
+        value >>= 7;
+    }
+    snapshot_write_byte(writer, value);
+}
+
+static void snapshot_write_record(snapshot_writer_t *writer, uint8_t tag, size_t value) {
+    snapshot_write_byte(writer, tag);
+    snapshot_write_uint(writer, value);
+}
+
+static void snapshot_end_repeats(snapshot_writer_t *writer) {
+    if (writer->repeats > 0) {
+        snapshot_write_record(writer, SNAPSHOT_TAG_REPEAT, writer->repeats);
+        writer->repeats = 0;
+    }
+}
+
+size_t shared_module_uheap_snapshot(mp_obj_t dest) {
+    snapshot_writer_t writer = {
+        .stream = dest,
+    };
+    mp_buffer_info_t bufinfo;
+    if (mp_get_buffer(dest, &bufinfo, MP_BUFFER_WRITE)) {
+        writer.dest = bufinfo.buf;
+        writer.dest_len = bufinfo.len;
+    } else {
+        mp_get_stream_raise(dest, MP_STREAM_OP_WRITE);
+    }
+
+    static const char magic[] = "GCHM";
+    for (size_t i = 0; i < strlen(magic); i++) {
+        snapshot_write_byte(&writer, magic[i]);
+    }
+    snapshot_write_byte(&writer, SNAPSHOT_VERSION);
+    snapshot_write_uint(&writer, MICROPY_BYTES_PER_GC_BLOCK);
+
+    gc_run_t run;
+    gc_run_start(&run);
+    while (gc_run_next(&run)) {
+        if (run.area_start) {
+            snapshot_end_repeats(&writer);
+            writer.last_tag = SNAPSHOT_TAG_FREE;
+            snapshot_write_record(&writer, SNAPSHOT_TAG_AREA, run.area_blocks);
+        }
+        if (!run.allocated) {
+            snapshot_end_repeats(&writer);
+            writer.last_tag = SNAPSHOT_TAG_FREE;
+            snapshot_write_record(&writer, SNAPSHOT_TAG_FREE, run.n_blocks);
+            continue;
+        }
+        uint8_t tag = SNAPSHOT_TAG_ALLOCATED | snapshot_class(run.ptr);
+        if (run.has_finaliser) {
+            tag |= SNAPSHOT_TAG_FINALISER;
+        }
+        if (tag == writer.last_tag && run.n_blocks == writer.last_blocks) {
+            writer.repeats++;
+            continue;
+        }
+        snapshot_end_repeats(&writer);
+        writer.last_tag = tag;
+        writer.last_blocks = run.n_blocks;
+        snapshot_write_record(&writer, tag, run.n_blocks);
+    }
+    snapshot_end_repeats(&writer);
+    if (writer.dest == NULL) {
+        snapshot_flush(&writer);
+    }
+    return writer.written;
+}
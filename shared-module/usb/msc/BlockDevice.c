@@ -0,0 +1,225 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "shared-bindings/usb/msc/BlockDevice.h"
+
+#include "tusb_config.h"
+
+#include "lib/tinyusb/src/host/usbh.h"
+#include "lib/tinyusb/src/class/msc/msc.h"
+#include "extmod/vfs.h"
+#include "py/mperrno.h"
+#include "py/mphal.h"
+#include "py/runtime.h"
+#include "shared-bindings/usb/core/Device.h"
+#include "shared-bindings/usb/core/__init__.h"
+
+// Not every version of msc.h names this one.
+#define SCSI_CMD_SYNCHRONIZE_CACHE_10 (0x35)
+
+// Transfers are limited to 16 bits of length, so larger reads and writes are
+// split into commands of this many blocks.
+#define MAX_BLOCKS_PER_COMMAND (127)
+
+// How many times to ask a drive that is still spinning up whether it is ready.
+#define READY_TRIES (50)
+
+static void _transfer(usb_msc_blockdevice_obj_t *self, uint8_t endpoint, uint8_t *buf, uint32_t len) {
+    mp_int_t actual;
+    if (endpoint & TUSB_DIR_IN_MASK) {
+        actual = common_hal_usb_core_device_read(self->device, endpoint, buf, len, CIRCUITPY_USB_MSC_TIMEOUT_MS);
+    } else {
+        actual = common_hal_usb_core_device_write(self->device, endpoint, buf, len, CIRCUITPY_USB_MSC_TIMEOUT_MS);
+    }
+    if (actual != (mp_int_t)len) {
+        mp_raise_usb_core_USBError(NULL);
+    }
+}
+
+// Runs one SCSI command using the bulk-only transport: a command block, the
+// data, then a status block. The data of a whole command is a single transfer,
+// which the host controller splits into packets without returning to us.
+// Returns the command status, MSC_CSW_STATUS_PASSED on success.
+static uint8_t _command(usb_msc_blockdevice_obj_t *self, const uint8_t *command, uint8_t command_len,
+    uint8_t *data, uint32_t data_len, bool data_in) {
+    msc_cbw_t cbw = {
+        .signature = MSC_CBW_SIGNATURE,
+        .tag = ++self->tag,
+        .total_bytes = data_len,
+        .dir = data_in ? TUSB_DIR_IN_MASK : 0,
+        .lun = self->lun,
+        .cmd_len = command_len,
+    };
+    memcpy(cbw.command, command, command_len);
+    _transfer(self, self->out_endpoint, (uint8_t *)&cbw, sizeof(cbw));
+
+    if (data_len > 0) {
+        _transfer(self, data_in ? self->in_endpoint : self->out_endpoint, data, data_len);
+    }
+
+    msc_csw_t csw;
+    _transfer(self, self->in_endpoint, (uint8_t *)&csw, sizeof(csw));
+    if (csw.signature != MSC_CSW_SIGNATURE || csw.tag != cbw.tag) {
+        mp_raise_usb_core_USBError(NULL);
+    }
+    return csw.status;
+}
+
+static void _find_interface(usb_msc_blockdevice_obj_t *self) {
+    usb_core_device_obj_t *device = self->device;
+    if (device->configuration_descriptor == NULL) {
+        common_hal_usb_core_device_set_configuration(device, 1);
+    }
+    if (device->configuration_descriptor == NULL) {
+        mp_raise_usb_core_USBError(MP_ERROR_TEXT("No configuration set"));
+    }
+
+    tusb_desc_configuration_t *desc_cfg = (tusb_desc_configuration_t *)device->configuration_descriptor;
+    uint8_t const *desc_end = ((uint8_t const *)desc_cfg) + tu_le16toh(desc_cfg->wTotalLength);
+    uint8_t const *p_desc = tu_desc_next(desc_cfg);
+
+    // Use the bulk endpoints of the first SCSI bulk-only interface.
+    bool in_msc_interface = false;
+    while (p_desc < desc_end) {
+        if (tu_desc_type(p_desc) == TUSB_DESC_INTERFACE) {
+            if (self->in_endpoint != 0 || self->out_endpoint != 0) {
+                break;
+            }
+            tusb_desc_interface_t const *desc_itf = (tusb_desc_interface_t const *)p_desc;
+            in_msc_interface = desc_itf->bInterfaceClass == TUSB_CLASS_MSC &&
+                desc_itf->bInterfaceSubClass == MSC_SUBCLASS_SCSI &&
+                desc_itf->bInterfaceProtocol == MSC_PROTOCOL_BOT;
+        } else if (in_msc_interface && tu_desc_type(p_desc) == TUSB_DESC_ENDPOINT) {
+            tusb_desc_endpoint_t const *desc_ep = (tusb_desc_endpoint_t const *)p_desc;
+            if (desc_ep->bmAttributes.xfer == TUSB_XFER_BULK) {
+                if (desc_ep->bEndpointAddress & TUSB_DIR_IN_MASK) {
+                    self->in_endpoint = desc_ep->bEndpointAddress;
+                } else {
+                    self->out_endpoint = desc_ep->bEndpointAddress;
+                }
+            }
+        }
+        p_desc = tu_desc_next(p_desc);
+    }
+    if (self->in_endpoint == 0 || self->out_endpoint == 0) {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("Invalid %q"), MP_QSTR_device);
+    }
+}
+
+void common_hal_usb_msc_blockdevice_construct(usb_msc_blockdevice_obj_t *self, usb_core_device_obj_t *device, uint8_t lun) {
+    self->device = device;
+    self->lun = lun;
+    self->tag = 0;
+    self->in_endpoint = 0;
+    self->out_endpoint = 0;
+    _find_interface(self);
+
+    // A drive that was just plugged in reports that it is not ready, or that
+    // its medium changed, until it has started up. Each failure is followed by
+    // REQUEST SENSE to clear it.
+    uint8_t command[10] = { SCSI_CMD_TEST_UNIT_READY };
+    uint8_t sense[18];
+    for (int i = 0; _command(self, command, 6, NULL, 0, false) != MSC_CSW_STATUS_PASSED; i++) {
+        if (i == READY_TRIES) {
+            mp_raise_OSError(MP_ENODEV);
+        }
+        uint8_t request_sense[6] = { SCSI_CMD_REQUEST_SENSE, 0, 0, 0, sizeof(sense), 0 };
+        _command(self, request_sense, sizeof(request_sense), sense, sizeof(sense), true);
+        mp_hal_delay_ms(100);
+    }
+
+    // The response holds the last block number and the block size, big endian.
+    uint32_t capacity[2];
+    command[0] = SCSI_CMD_READ_CAPACITY_10;
+    if (_command(self, command, 10, (uint8_t *)capacity, sizeof(capacity), true) != MSC_CSW_STATUS_PASSED) {
+        mp_raise_OSError(MP_EIO);
+    }
+    uint32_t last_block = tu_ntohl(capacity[0]);
+    if (tu_ntohl(capacity[1]) != 512) {
+        mp_raise_ValueError_varg(MP_ERROR_TEXT("Invalid %q"), MP_QSTR_block_size);
+    }
+    // Drives too big for READ CAPACITY (10) report the largest block number.
+    // Only the part that READ (10) can reach is used.
+    self->block_count = last_block == 0xffffffff ? last_block : last_block + 1;
+}
+
+uint32_t common_hal_usb_msc_blockdevice_get_block_count(usb_msc_blockdevice_obj_t *self) {
+    return self->block_count;
+}
+
+static mp_uint_t _readwrite(usb_msc_blockdevice_obj_t *self, uint8_t opcode, uint8_t *buf, uint32_t start_block, uint32_t nblocks) {
+    if (start_block >= self->block_count || nblocks > self->block_count - start_block) {
+        return MP_EIO;
+    }
+    while (nblocks > 0) {
+        uint16_t count = MIN(nblocks, MAX_BLOCKS_PER_COMMAND);
+        uint8_t command[10] = {
+            opcode, 0,
+            start_block >> 24, start_block >> 16, start_block >> 8, start_block,
+            0, count >> 8, count, 0
+        };
+        if (_command(self, command, sizeof(command), buf, count * 512, opcode == SCSI_CMD_READ_10) != MSC_CSW_STATUS_PASSED) {
+            return MP_EIO;
+        }
+        buf += count * 512;
+        start_block += count;
+        nblocks -= count;
+    }
+    return 0;
+}
+
+mp_uint_t usb_msc_blockdevice_readblocks(mp_obj_t self_in, uint8_t *buf, uint32_t start_block, uint32_t nblocks) {
+    usb_msc_blockdevice_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return _readwrite(self, SCSI_CMD_READ_10, buf, start_block, nblocks);
+}
+
+mp_uint_t usb_msc_blockdevice_writeblocks(mp_obj_t self_in, uint8_t *buf, uint32_t start_block, uint32_t nblocks) {
+    usb_msc_blockdevice_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return _readwrite(self, SCSI_CMD_WRITE_10, buf, start_block, nblocks);
+}
+
+int common_hal_usb_msc_blockdevice_readblocks(usb_msc_blockdevice_obj_t *self, uint32_t start_block, mp_buffer_info_t *buf) {
+    if (buf->len % 512 != 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("Buffer length must be a multiple of 512"));
+    }
+    return usb_msc_blockdevice_readblocks(MP_OBJ_FROM_PTR(self), buf->buf, start_block, buf->len / 512);
+}
+
+int common_hal_usb_msc_blockdevice_writeblocks(usb_msc_blockdevice_obj_t *self, uint32_t start_block, mp_buffer_info_t *buf) {
+    if (buf->len % 512 != 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("Buffer length must be a multiple of 512"));
+    }
+    return usb_msc_blockdevice_writeblocks(MP_OBJ_FROM_PTR(self), buf->buf, start_block, buf->len / 512);
+}
+
+int common_hal_usb_msc_blockdevice_sync(usb_msc_blockdevice_obj_t *self) {
+    // Drives without a write cache may reject this, which is harmless.
+    uint8_t command[10] = { SCSI_CMD_SYNCHRONIZE_CACHE_10 };
+    _command(self, command, sizeof(command), NULL, 0, false);
+    return 0;
+}
+
+bool usb_msc_blockdevice_ioctl(mp_obj_t self_in, size_t cmd, size_t arg, mp_int_t *out_value) {
+    usb_msc_blockdevice_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    *out_value = 0;
+    switch (cmd) {
+        case MP_BLOCKDEV_IOCTL_DEINIT:
+        case MP_BLOCKDEV_IOCTL_SYNC:
+            common_hal_usb_msc_blockdevice_sync(self);
+            break;
+        case MP_BLOCKDEV_IOCTL_BLOCK_COUNT:
+            *out_value = self->block_count;
+            break;
+        case MP_BLOCKDEV_IOCTL_BLOCK_SIZE:
+            *out_value = 512;
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,27 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+#include "shared-module/usb/core/Device.h"
+
+// How long to wait for each part of a command, in milliseconds. Flash drives
+// can take a while to finish a large write.
+#ifndef CIRCUITPY_USB_MSC_TIMEOUT_MS
+#define CIRCUITPY_USB_MSC_TIMEOUT_MS (5000)
+#endif
+
+typedef struct {
+    mp_obj_base_t base;
+    usb_core_device_obj_t *device;
+    uint32_t block_count;
+    uint32_t tag;
+    uint8_t in_endpoint;
+    uint8_t out_endpoint;
+    uint8_t lun;
+} usb_msc_blockdevice_obj_t;
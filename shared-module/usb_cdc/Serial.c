@@ -4,6 +4,7 @@
 //
 // SPDX-License-Identifier: MIT
 
+#include "py/runtime.h"
 #include "shared/runtime/interrupt_char.h"
 #include "shared-bindings/usb_cdc/Serial.h"
 #include "shared-module/usb_cdc/Serial.h"
@@ -11,94 +12,111 @@
 
 #include "tusb.h"
 
-size_t common_hal_usb_cdc_serial_read(usb_cdc_serial_obj_t *self, uint8_t *data, size_t len, int *errcode) {
+typedef struct {
+    usb_cdc_serial_obj_t *self;
+    uint8_t *data;
+    size_t len;
+    size_t total;
+} serial_transfer_t;
+
+static bool serial_read_more(void *arg) {
+    serial_transfer_t *transfer = arg;
+    if (tud_cdc_n_connected(transfer->self->idx)) {
+        transfer->total += tud_cdc_n_read(transfer->self->idx, transfer->data + transfer->total, transfer->len - transfer->total);
+    }
+    return transfer->total >= transfer->len;
+}
+
+static bool serial_write_more(void *arg) {
+    serial_transfer_t *transfer = arg;
+    // Don't interleave with a start_write() buffer that is still going out.
+    if (transfer->self->bulk_busy) {
+        return false;
+    }
+    transfer->total += tud_cdc_n_write(transfer->self->idx, transfer->data + transfer->total, transfer->len - transfer->total);
+    tud_cdc_n_write_flush(transfer->self->idx);
+    return transfer->total >= transfer->len;
+}
 
-    const bool wait_forever = self->timeout < 0.0f;
-    const bool wait_for_timeout = self->timeout > 0.0f;
+// Keeps each CDC interface's start_write() buffer alive while it is sent.
+// Indexed by idx; there are always two CDC interfaces.
+MP_REGISTER_ROOT_POINTER(mp_obj_t usb_cdc_bulk_write_obj[2]);
 
+// Use special routine to avoid pulling in uint64-float-compatible math routines.
+static uint64_t serial_timeout_ms(mp_float_t timeout) {
+    return timeout < 0.0f ? SUPERVISOR_WAIT_FOREVER : float_to_uint64(timeout * 1000);
+}
+
+size_t common_hal_usb_cdc_serial_read(usb_cdc_serial_obj_t *self, uint8_t *data, size_t len, int *errcode) {
     // Read up to len bytes immediately.
     // The number of bytes read will not be larger than what is already in the TinyUSB FIFO.
-    uint32_t total_num_read = 0;
-    if (tud_cdc_n_connected(self->idx)) {
-        total_num_read = tud_cdc_n_read(self->idx, data, len);
+    serial_transfer_t transfer = { .self = self, .data = data, .len = len, .total = 0 };
+    if (serial_read_more(&transfer) || self->timeout == 0.0f) {
+        return transfer.total;
     }
 
-    if (wait_forever || wait_for_timeout) {
-        // Continue filling the buffer past what we already read.
-        len -= total_num_read;
-        data += total_num_read;
-
-        // Read more if we have time.
-        // Use special routine to avoid pulling in uint64-float-compatible math routines.
-        uint64_t timeout_ms = float_to_uint64(self->timeout * 1000);  // Junk value if timeout < 0.
-        uint64_t start_ticks = supervisor_ticks_ms64();
-
-        uint32_t num_read = 0;
-        while (total_num_read < len &&
-               (wait_forever || supervisor_ticks_ms64() - start_ticks <= timeout_ms)) {
-
-            // Wait for a bit, and check for ctrl-C.
-            RUN_BACKGROUND_TASKS;
-            if (mp_hal_is_interrupted()) {
-                return 0;
-            }
-
-            // Advance buffer pointer and reduce number of bytes that need to be read.
-            len -= num_read;
-            data += num_read;
-
-            // Try to read another batch of bytes.
-            if (tud_cdc_n_connected(self->idx)) {
-                num_read = tud_cdc_n_read(self->idx, data, len);
-            }
-            total_num_read += num_read;
-        }
+    // Sleep until more arrives or we run out of time. USB interrupts wake us up.
+    if (!supervisor_wait_until(serial_read_more, &transfer, serial_timeout_ms(self->timeout)) &&
+        mp_hal_is_interrupted()) {
+        return 0;
     }
-
-    return total_num_read;
+    return transfer.total;
 }
 
 size_t common_hal_usb_cdc_serial_write(usb_cdc_serial_obj_t *self, const uint8_t *data, size_t len, int *errcode) {
-    const bool wait_forever = self->write_timeout < 0.0f;
-    const bool wait_for_timeout = self->write_timeout > 0.0f;
-
     // Write as many bytes as possible immediately.
     // The number of bytes written at once will not be larger than what can fit in the TinyUSB FIFO.
-    uint32_t total_num_written = tud_cdc_n_write(self->idx, data, len);
+    serial_transfer_t transfer = { .self = self, .data = (uint8_t *)data, .len = len, .total = 0 };
+    if (serial_write_more(&transfer) || self->write_timeout == 0.0f) {
+        return transfer.total;
+    }
+
+    // Sleep until the FIFO has room or we run out of time. USB interrupts wake us up.
+    if (!supervisor_wait_until(serial_write_more, &transfer, serial_timeout_ms(self->write_timeout)) &&
+        mp_hal_is_interrupted()) {
+        return 0;
+    }
+    return transfer.total;
+}
+
+void usb_cdc_serial_bulk_write_more(usb_cdc_serial_obj_t *self) {
+    if (!self->bulk_busy) {
+        return;
+    }
+    size_t sent = self->bulk_sent;
+    sent += tud_cdc_n_write(self->idx, self->bulk_data + sent, self->bulk_len - sent);
     tud_cdc_n_write_flush(self->idx);
+    self->bulk_sent = sent;
+    if (sent >= self->bulk_len) {
+        usb_cdc_serial_bulk_write_cancel(self);
+    }
+}
+
+void usb_cdc_serial_bulk_write_cancel(usb_cdc_serial_obj_t *self) {
+    self->bulk_busy = false;
+    self->bulk_data = NULL;
+    self->bulk_len = 0;
+    MP_STATE_VM(usb_cdc_bulk_write_obj)[self->idx] = MP_OBJ_NULL;
+}
 
-    if (wait_forever || wait_for_timeout) {
-        // Continue writing the rest of the buffer.
-        len -= total_num_written;
-        data += total_num_written;
-
-        // Write more if we have time.
-        // Use special routine to avoid pulling in uint64-float-compatible math routines.
-        uint64_t timeout_ms = float_to_uint64(self->write_timeout * 1000);  // Junk value if write_timeout < 0.
-        uint64_t start_ticks = supervisor_ticks_ms64();
-
-        uint32_t num_written = 0;
-        while (total_num_written < len &&
-               (wait_forever || supervisor_ticks_ms64() - start_ticks <= timeout_ms)) {
-
-            // Wait for a bit, and check for ctrl-C.
-            RUN_BACKGROUND_TASKS;
-            if (mp_hal_is_interrupted()) {
-                return 0;
-            }
-
-            // Advance buffer pointer and reduce number of bytes that need to be written.
-            len -= num_written;
-            data += num_written;
-
-            // Try to write another batch of bytes.
-            num_written = tud_cdc_n_write(self->idx, data, len);
-            tud_cdc_n_write_flush(self->idx);
-            total_num_written += num_written;
-        }
+void common_hal_usb_cdc_serial_start_write(usb_cdc_serial_obj_t *self, mp_obj_t obj, const uint8_t *data, size_t len) {
+    if (self->bulk_busy) {
+        mp_raise_RuntimeError_varg(MP_ERROR_TEXT("%q in use"), MP_QSTR_start_write);
     }
+    if (len == 0) {
+        return;
+    }
+    MP_STATE_VM(usb_cdc_bulk_write_obj)[self->idx] = obj;
+    self->bulk_data = data;
+    self->bulk_len = len;
+    self->bulk_sent = 0;
+    self->bulk_busy = true;
+    // Fill the FIFO now. TX completion callbacks send the rest.
+    usb_cdc_serial_bulk_write_more(self);
+}
 
-    return total_num_written;
+bool common_hal_usb_cdc_serial_get_write_in_progress(usb_cdc_serial_obj_t *self) {
+    return self->bulk_busy;
 }
 
 uint32_t common_hal_usb_cdc_serial_get_in_waiting(usb_cdc_serial_obj_t *self) {
@@ -106,8 +124,13 @@ uint32_t common_hal_usb_cdc_serial_get_in_waiting(usb_cdc_serial_obj_t *self) {
 }
 
 uint32_t common_hal_usb_cdc_serial_get_out_waiting(usb_cdc_serial_obj_t *self) {
-    // Return number of FIFO bytes currently occupied.
-    return CFG_TUD_CDC_TX_BUFSIZE - tud_cdc_n_write_available(self->idx);
+    // Return number of FIFO bytes currently occupied, plus whatever
+    // start_write() has not yet moved into the FIFO.
+    uint32_t waiting = CFG_TUD_CDC_TX_BUFSIZE - tud_cdc_n_write_available(self->idx);
+    if (self->bulk_busy) {
+        waiting += self->bulk_len - self->bulk_sent;
+    }
+    return waiting;
 }
 
 void common_hal_usb_cdc_serial_reset_input_buffer(usb_cdc_serial_obj_t *self) {
@@ -115,6 +138,7 @@ void common_hal_usb_cdc_serial_reset_input_buffer(usb_cdc_serial_obj_t *self) {
 }
 
 uint32_t common_hal_usb_cdc_serial_reset_output_buffer(usb_cdc_serial_obj_t *self) {
+    usb_cdc_serial_bulk_write_cancel(self);
     return tud_cdc_n_write_clear(self->idx);
 }
 
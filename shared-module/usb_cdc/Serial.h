@@ -13,4 +13,18 @@ typedef struct {
     mp_float_t timeout;       // if negative, wait forever.
     mp_float_t write_timeout; // if negative, wait forever.
     uint8_t idx;              // which CDC device?
+    // Buffer queued by start_write(). It is kept alive by a root pointer and
+    // fed into the TinyUSB FIFO as transfers complete.
+    const uint8_t *bulk_data;
+    size_t bulk_len;
+    volatile size_t bulk_sent;
+    volatile bool bulk_busy;
+    #if MICROPY_PY_SELECT_POLL_GEN
+    volatile mp_uint_t poll_gen; // bumped by TinyUSB callbacks, see MP_STREAM_GET_POLL_GEN
+    #endif
 } usb_cdc_serial_obj_t;
+
+// Move more of a pending start_write() buffer into the TinyUSB FIFO.
+void usb_cdc_serial_bulk_write_more(usb_cdc_serial_obj_t *self);
+// Drop a pending start_write() buffer.
+void usb_cdc_serial_bulk_write_cancel(usb_cdc_serial_obj_t *self);
@@ -8,6 +8,7 @@
 #include "py/obj.h"
 #include "py/mphal.h"
 #include "py/runtime.h"
+#include "py/stream.h"
 #include "py/objtuple.h"
 #include "shared-bindings/usb_cdc/__init__.h"
 #include "shared-bindings/usb_cdc/Serial.h"
@@ -161,6 +162,35 @@ bool usb_cdc_data_enabled(void) {
     return usb_cdc_data_is_enabled;
 }
 
+void usb_cdc_poll_notify(uint8_t itf) {
+    #if MICROPY_PY_SELECT_POLL_GEN
+    if (usb_cdc_console_is_enabled && usb_cdc_console_obj.idx == itf) {
+        mp_stream_poll_gen_bump(&usb_cdc_console_obj.poll_gen);
+    }
+    if (usb_cdc_data_is_enabled && usb_cdc_data_obj.idx == itf) {
+        mp_stream_poll_gen_bump(&usb_cdc_data_obj.poll_gen);
+    }
+    #else
+    (void)itf;
+    #endif
+}
+
+void usb_cdc_tx_notify(uint8_t itf) {
+    if (usb_cdc_console_is_enabled && usb_cdc_console_obj.idx == itf) {
+        usb_cdc_serial_bulk_write_more(&usb_cdc_console_obj);
+    }
+    if (usb_cdc_data_is_enabled && usb_cdc_data_obj.idx == itf) {
+        usb_cdc_serial_bulk_write_more(&usb_cdc_data_obj);
+    }
+    usb_cdc_poll_notify(itf);
+}
+
+void usb_cdc_user_reset(void) {
+    // start_write() buffers live on the heap, which is about to go away.
+    usb_cdc_serial_bulk_write_cancel(&usb_cdc_console_obj);
+    usb_cdc_serial_bulk_write_cancel(&usb_cdc_data_obj);
+}
+
 size_t usb_cdc_descriptor_length(void) {
     return sizeof(usb_cdc_descriptor_template);
 }
@@ -18,6 +18,13 @@ void usb_cdc_set_defaults(void);
 size_t usb_cdc_descriptor_length(void);
 size_t usb_cdc_add_descriptor(uint8_t *descriptor_buf, descriptor_counts_t *descriptor_counts, uint8_t *current_interface_string, bool console);
 
+// Called from TinyUSB callbacks when the poll state of a CDC interface may have changed.
+void usb_cdc_poll_notify(uint8_t itf);
+// Called when a CDC IN transfer completes. Sends more of any start_write() buffer.
+void usb_cdc_tx_notify(uint8_t itf);
+// Cancel background writes that use the VM heap.
+void usb_cdc_user_reset(void);
+
 #if CIRCUITPY_USB_VENDOR
 bool usb_vendor_enabled(void);
 size_t usb_vendor_descriptor_length(void);
@@ -12,6 +12,7 @@
 #include "shared-bindings/usb_hid/Device.h"
 #include "shared-module/usb_hid/__init__.h"
 #include "shared-module/usb_hid/Device.h"
+#include "supervisor/background_callback.h"
 #include "supervisor/shared/tick.h"
 #include "tusb.h"
 
@@ -146,6 +147,47 @@ const usb_hid_device_obj_t usb_hid_device_consumer_control_obj = {
 
 char *custom_usb_hid_interface_name;
 
+// All the devices share one IN endpoint, so there is one queue of reports for
+// all of them. A report is taken off the queue when it is handed to TinyUSB,
+// which copies it into its endpoint buffer. The queue is only touched from the
+// VM and background callbacks, never from the TinyUSB callback itself, which
+// may run in another task.
+typedef struct {
+    uint8_t report_id;
+    uint8_t len;
+    uint8_t report[CFG_TUD_HID_EP_BUFSIZE];
+} usb_hid_queued_report_t;
+
+static usb_hid_queued_report_t report_queue[CIRCUITPY_USB_HID_REPORT_QUEUE_LENGTH];
+static uint8_t report_queue_head;
+static uint8_t report_queue_count;
+static background_callback_t report_queue_callback;
+
+static void send_queued_report(void *unused) {
+    (void)unused;
+    if (report_queue_count == 0 || !tud_hid_ready()) {
+        return;
+    }
+    usb_hid_queued_report_t *queued = &report_queue[report_queue_head];
+    // There is nobody to report a failure to, so the report is dropped.
+    tud_hid_report(queued->report_id, queued->report, queued->len);
+    report_queue_head = (report_queue_head + 1) % CIRCUITPY_USB_HID_REPORT_QUEUE_LENGTH;
+    report_queue_count--;
+}
+
+void usb_hid_device_reset_report_queue(void) {
+    report_queue_head = 0;
+    report_queue_count = 0;
+}
+
+// Invoked when the previous report has been sent to the host, so the endpoint is free again.
+void tud_hid_report_complete_cb(uint8_t instance, uint8_t const *report, uint16_t len) {
+    (void)instance;
+    (void)report;
+    (void)len;
+    background_callback_add(&report_queue_callback, send_queued_report, NULL);
+}
+
 static size_t get_report_id_idx(usb_hid_device_obj_t *self, size_t report_id) {
     for (size_t i = 0; i < self->num_report_ids; i++) {
         if (report_id == self->report_ids[i]) {
@@ -199,29 +241,49 @@ uint16_t common_hal_usb_hid_device_get_usage(usb_hid_device_obj_t *self) {
     return self->usage;
 }
 
-void common_hal_usb_hid_device_send_report(usb_hid_device_obj_t *self, uint8_t *report, uint8_t len, uint8_t report_id) {
+void common_hal_usb_hid_device_send_report(usb_hid_device_obj_t *self, uint8_t *report, uint8_t len, uint8_t report_id, bool coalesce) {
     // report_id and len have already been validated for this device.
     size_t id_idx = get_report_id_idx(self, report_id);
 
     mp_arg_validate_length(len, self->in_report_lengths[id_idx], MP_QSTR_report);
 
-    // Wait until interface is ready, timeout = 2 seconds
-    uint64_t end_ticks = supervisor_ticks_ms64() + 2000;
-    while ((supervisor_ticks_ms64() < end_ticks) && !tud_hid_ready()) {
-        RUN_BACKGROUND_TASKS;
+    if (tud_suspended()) {
+        tud_remote_wakeup();
+        return;
     }
 
-    if (!tud_suspended()) {
-        if (!tud_hid_ready()) {
-            mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("USB busy"));
+    // Longer reports would be truncated by TinyUSB anyway.
+    len = MIN(len, CFG_TUD_HID_EP_BUFSIZE);
+
+    usb_hid_queued_report_t *queued = NULL;
+    if (coalesce && report_queue_count > 0) {
+        // The host has not picked up the last report yet, so just replace it if it has the same id.
+        usb_hid_queued_report_t *last =
+            &report_queue[(report_queue_head + report_queue_count - 1) % CIRCUITPY_USB_HID_REPORT_QUEUE_LENGTH];
+        if (last->report_id == report_id) {
+            queued = last;
         }
+    }
 
-        if (!tud_hid_report(report_id, report, len)) {
-            mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("USB error"));
+    if (queued == NULL) {
+        // Wait until there is room in the queue, timeout = 2 seconds
+        uint64_t end_ticks = supervisor_ticks_ms64() + 2000;
+        while (report_queue_count == CIRCUITPY_USB_HID_REPORT_QUEUE_LENGTH) {
+            if (supervisor_ticks_ms64() >= end_ticks) {
+                mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("USB busy"));
+            }
+            send_queued_report(NULL);
+            RUN_BACKGROUND_TASKS;
         }
-    } else {
-        tud_remote_wakeup();
+        queued = &report_queue[(report_queue_head + report_queue_count) % CIRCUITPY_USB_HID_REPORT_QUEUE_LENGTH];
+        report_queue_count++;
     }
+
+    queued->report_id = report_id;
+    queued->len = len;
+    memcpy(queued->report, report, len);
+
+    send_queued_report(NULL);
 }
 
 mp_obj_t common_hal_usb_hid_device_get_last_received_report(usb_hid_device_obj_t *self, uint8_t report_id) {
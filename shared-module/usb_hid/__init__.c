@@ -242,6 +242,9 @@ void usb_hid_setup_devices(void) {
     for (mp_int_t i = 0; i < num_hid_devices; i++) {
         usb_hid_device_create_report_buffers(&hid_devices[i]);
     }
+
+    // Don't send reports left over from the last VM.
+    usb_hid_device_reset_report_queue();
 }
 
 // Total length of the report descriptor, with all configured devices.
@@ -6,11 +6,54 @@
 
 #include "shared-bindings/usb_midi/PortIn.h"
 #include "shared-module/usb_midi/PortIn.h"
+#include "shared-bindings/time/__init__.h"
 #include "supervisor/shared/translate/translate.h"
 #include "tusb.h"
 
+// When the oldest unread data arrived, in microseconds. TinyUSB does not
+// keep arrival times, so every packet read gets the time of the first
+// transfer after the receive FIFO was last emptied. Readers that keep up
+// with the host get the arrival time of each transfer.
+static volatile uint32_t rx_timestamp_us;
+static volatile bool rx_timestamp_valid;
+
+static uint32_t now_us(void) {
+    return (uint32_t)(common_hal_time_monotonic_ns() / 1000);
+}
+
+// Invoked by TinyUSB when an OUT transfer has been added to the receive FIFO.
+void tud_midi_rx_cb(uint8_t itf) {
+    (void)itf;
+    if (!rx_timestamp_valid) {
+        rx_timestamp_us = now_us();
+        rx_timestamp_valid = true;
+    }
+}
+
+static void check_rx_drained(void) {
+    if (tud_midi_available() == 0) {
+        rx_timestamp_valid = false;
+    }
+}
+
 size_t common_hal_usb_midi_portin_read(usb_midi_portin_obj_t *self, uint8_t *data, size_t len, int *errcode) {
-    return tud_midi_stream_read(data, len);
+    size_t count = tud_midi_stream_read(data, len);
+    check_rx_drained();
+    return count;
+}
+
+size_t common_hal_usb_midi_portin_read_packets(usb_midi_portin_obj_t *self, uint8_t *packets, uint32_t *timestamps, size_t count) {
+    // Packets that arrived before the callback saw them get the time they are read.
+    uint32_t timestamp = rx_timestamp_valid ? rx_timestamp_us : now_us();
+    size_t done = 0;
+    while (done < count && tud_midi_packet_read(packets + done * 4)) {
+        if (timestamps != NULL) {
+            timestamps[done] = timestamp;
+        }
+        done++;
+    }
+    check_rx_drained();
+    return done;
 }
 
 uint32_t common_hal_usb_midi_portin_bytes_available(usb_midi_portin_obj_t *self) {
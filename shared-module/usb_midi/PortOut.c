@@ -13,6 +13,14 @@ size_t common_hal_usb_midi_portout_write(usb_midi_portout_obj_t *self, const uin
     return tud_midi_stream_write(0, data, len);
 }
 
+size_t common_hal_usb_midi_portout_write_packets(usb_midi_portout_obj_t *self, const uint8_t *packets, size_t count) {
+    size_t done = 0;
+    while (done < count && tud_midi_packet_write(packets + done * 4)) {
+        done++;
+    }
+    return done;
+}
+
 bool common_hal_usb_midi_portout_ready_to_tx(usb_midi_portout_obj_t *self) {
     return tud_midi_mounted();
 }
@@ -24,6 +24,9 @@ static unsigned interval_ms = 1000 / DEFAULT_FRAME_RATE;
 // TODO must dynamically allocate this, otherwise everyone pays for it
 static uint8_t *frame_buffer_yuyv;
 uint16_t *usb_video_framebuffer_rgb565;
+// One bit per row of usb_video_framebuffer_rgb565 changed since it was last
+// converted to frame_buffer_yuyv.
+static uint8_t *dirty_rows;
 
 static bool usb_video_is_enabled = false;
 uint16_t usb_video_frame_width, usb_video_frame_height;
@@ -45,18 +48,23 @@ bool shared_module_usb_video_enable(mp_int_t frame_width, mp_int_t frame_height)
     usb_video_frame_height = frame_height;
 
     size_t framebuffer_size = usb_video_frame_width * usb_video_frame_height * 2;
+    size_t dirty_rows_size = (usb_video_frame_height + 7) / 8;
     frame_buffer_yuyv = port_malloc(framebuffer_size, false);
     uint32_t *frame_buffer_rgb565_uint32 = port_malloc(framebuffer_size, false);
     usb_video_framebuffer_rgb565 = (uint16_t *)frame_buffer_rgb565_uint32;
+    dirty_rows = port_malloc(dirty_rows_size, false);
 
-    if (!frame_buffer_yuyv || !usb_video_framebuffer_rgb565) {
-        // this will free either of the buffers allocated just above, in
-        // case one succeeded and the other failed.
+    if (!frame_buffer_yuyv || !usb_video_framebuffer_rgb565 || !dirty_rows) {
+        // this will free any of the buffers allocated just above, in
+        // case some succeeded and the others failed.
         shared_module_usb_video_disable();
-        m_malloc_fail(2 * framebuffer_size);
+        m_malloc_fail(2 * framebuffer_size + dirty_rows_size);
     }
     memset(frame_buffer_yuyv, 0, framebuffer_size);
     memset(usb_video_framebuffer_rgb565, 0, framebuffer_size);
+    // black in RGB565 is not all zeros in YUYV, so convert everything once
+    memset(dirty_rows, 0xff, dirty_rows_size);
+    do_convert = true;
 
     usb_video_is_enabled = true;
 
@@ -70,8 +78,10 @@ bool shared_module_usb_video_disable(void) {
     usb_video_is_enabled = false;
     port_free(frame_buffer_yuyv);
     port_free(usb_video_framebuffer_rgb565);
+    port_free(dirty_rows);
     frame_buffer_yuyv = NULL;
     usb_video_framebuffer_rgb565 = NULL;
+    dirty_rows = NULL;
     return true;
 }
 
@@ -87,36 +97,63 @@ size_t usb_video_descriptor_length(void) {
     #endif
 }
 
+// Convert one row, a pixel pair at a time. Each pair of big endian RGB565
+// pixels is read as one word and written as one Y1 U Y2 V word, which
+// assumes a little endian CPU.
+static void convert_row(uint32_t *dest, const uint32_t *src) {
+    for (int i = 0; i < usb_video_frame_width / 2; i++) {
+        uint32_t pair = __builtin_bswap32(*src++);
+        uint16_t p1 = pair >> 16;
+        uint16_t p2 = pair & 0xffff;
+
+        int y1 = COLOR_RGB888_TO_Y(COLOR_RGB565_TO_R8(p1), COLOR_RGB565_TO_G8(p1), COLOR_RGB565_TO_B8(p1));
+        int y2 = COLOR_RGB888_TO_Y(COLOR_RGB565_TO_R8(p2), COLOR_RGB565_TO_G8(p2), COLOR_RGB565_TO_B8(p2));
+        if (y2 > y1) {
+            p1 = p2;          /* Use UV value of the brighter pixel */
+        }
+        int r = COLOR_RGB565_TO_R8(p1);
+        int g = COLOR_RGB565_TO_G8(p1);
+        int b = COLOR_RGB565_TO_B8(p1);
+        uint8_t u = COLOR_RGB888_TO_U(r, g, b) + 128;  // openmv UV are signed in the range [-127,128]
+        uint8_t v = COLOR_RGB888_TO_V(r, g, b) + 128;
+
+        *dest++ = (uint8_t)y1 | (u << 8) | ((uint8_t)y2 << 16) | ((uint32_t)v << 24);
+    }
+}
+
 static void convert_framebuffer_maybe(void) {
     if (!do_convert) {
         return; // new data not ready yet
     }
     do_convert = false; // assumes this happens via background, not interrupt
 
-    uint8_t *dest = frame_buffer_yuyv;
-    uint16_t *src = usb_video_framebuffer_rgb565;
+    // Both buffers come from port_malloc, so rows of an even number of
+    // pixels are word aligned.
+    size_t row_words = usb_video_frame_width / 2;
+    uint32_t *dest = (uint32_t *)(void *)frame_buffer_yuyv;
+    const uint32_t *src = (const uint32_t *)(void *)usb_video_framebuffer_rgb565;
 
-    for (int i = 0; i < usb_video_frame_width * usb_video_frame_height / 2; i++) {
-        uint16_t p1 = IMAGE_GET_RGB565_PIXEL_FAST(src, 0);
-        uint16_t p2 = IMAGE_GET_RGB565_PIXEL_FAST(src, 1);
-        src += 2;
-
-        int y1 = COLOR_RGB565_TO_Y(p1);
-        int y2 = COLOR_RGB565_TO_Y(p2);
-        if (y2 > y1) {
-            p1 = p2;          /* Use UV value of the brighter pixel */
+    for (int y = 0; y < usb_video_frame_height; y++, dest += row_words, src += row_words) {
+        if (!(dirty_rows[y / 8] & (1 << (y & 7)))) {
+            continue;
         }
-        int u = COLOR_RGB565_TO_U(p1) + 128;  // openmv UV are signed in the range [-127,128]
-        int v = COLOR_RGB565_TO_V(p1) + 128;
-
-        *dest++ = y1;
-        *dest++ = u;
-        *dest++ = y2;
-        *dest++ = v;
+        dirty_rows[y / 8] &= ~(1 << (y & 7));
+        convert_row(dest, src);
     }
 }
 
-void shared_module_usb_video_swapbuffers(void) {
+void shared_module_usb_video_swapbuffers(const uint8_t *dirty_row_bitmap) {
+    if (!dirty_rows) {
+        return;
+    }
+    size_t dirty_rows_size = (usb_video_frame_height + 7) / 8;
+    if (dirty_row_bitmap == NULL) {
+        memset(dirty_rows, 0xff, dirty_rows_size);
+    } else {
+        for (size_t i = 0; i < dirty_rows_size; i++) {
+            dirty_rows[i] |= dirty_row_bitmap[i];
+        }
+    }
     do_convert = true;
 }
 
@@ -7,6 +7,7 @@
 #include <stdint.h>
 
 #include "py/mpstate.h"
+#include "py/pystack.h"
 #include "py/stackctrl.h"
 
 #include "shared-bindings/ustack/__init__.h"
@@ -23,10 +24,39 @@ uint32_t shared_module_ustack_max_stack_usage(void) {
 }
 #endif
 
-uint32_t shared_module_ustack_stack_size() {
+uint32_t shared_module_ustack_stack_size(void) {
     return MP_STATE_THREAD(stack_limit);
 }
 
-uint32_t shared_module_ustack_stack_usage() {
+uint32_t shared_module_ustack_stack_usage(void) {
     return mp_stack_usage();
 }
+
+#if MICROPY_STACK_HIGH_WATER
+uint32_t shared_module_ustack_stack_high_water(void) {
+    return MP_STATE_THREAD(stack_high_water);
+}
+
+void shared_module_ustack_reset_high_water(void) {
+    MP_STATE_THREAD(stack_high_water) = mp_stack_usage();
+    #if MICROPY_ENABLE_PYSTACK
+    MP_STATE_THREAD(pystack_high_water) = MP_STATE_THREAD(pystack_cur);
+    #endif
+}
+#endif
+
+#if MICROPY_ENABLE_PYSTACK
+uint32_t shared_module_ustack_pystack_size(void) {
+    return mp_pystack_limit();
+}
+
+uint32_t shared_module_ustack_pystack_usage(void) {
+    return mp_pystack_usage();
+}
+
+#if MICROPY_STACK_HIGH_WATER
+uint32_t shared_module_ustack_pystack_high_water(void) {
+    return MP_STATE_THREAD(pystack_high_water) - MP_STATE_THREAD(pystack_start);
+}
+#endif
+#endif
@@ -45,6 +45,30 @@ uint32_t common_hal_vectorio_circle_get_pixel(void *obj, int16_t x, int16_t y) {
 }
 
 
+uint16_t common_hal_vectorio_circle_get_spans(void *obj, int16_t y, int16_t *spans, uint16_t max_spans, uint32_t *pixel) {
+    vectorio_circle_t *self = obj;
+    *pixel = self->color_index;
+    uint32_t radius = self->radius;
+    uint32_t abs_y = abs(y);
+    if (abs_y > radius || max_spans == 0) {
+        return 0;
+    }
+    // Find the widest x that get_pixel still covers: x * x + y * y <= radius * radius.
+    uint32_t remaining = radius * radius - abs_y * abs_y;
+    uint32_t half_width = 0;
+    for (uint32_t bit = 1u << 30; bit != 0; bit >>= 2) {
+        if (remaining >= half_width + bit) {
+            remaining -= half_width + bit;
+            half_width = (half_width >> 1) + bit;
+        } else {
+            half_width >>= 1;
+        }
+    }
+    spans[0] = -(int16_t)half_width;
+    spans[1] = half_width + 1;
+    return 1;
+}
+
 void common_hal_vectorio_circle_get_area(void *circle, displayio_area_t *out_area) {
     vectorio_circle_t *self = circle;
     out_area->x1 = -1 * self->radius - 1;
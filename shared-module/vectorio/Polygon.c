@@ -6,6 +6,7 @@
 
 #include "shared-module/vectorio/__init__.h"
 #include "shared-bindings/vectorio/Polygon.h"
+#include "shared-module/vectorio/VectorShape.h"
 #include "shared-module/displayio/area.h"
 
 #include "py/runtime.h"
@@ -185,6 +186,85 @@ uint32_t common_hal_vectorio_polygon_get_pixel(void *obj, int16_t x, int16_t y)
     return winding_number == 0 ? 0 : self->color_index;
 }
 
+// Crossings of one row kept while listing spans. Rows with more are drawn pixel by pixel.
+#define VECTORIO_POLYGON_MAX_CROSSINGS (2 * VECTORIO_MAX_SPANS)
+
+uint16_t common_hal_vectorio_polygon_get_spans(void *obj, int16_t y, int16_t *spans, uint16_t max_spans, uint32_t *pixel) {
+    vectorio_polygon_t *self = obj;
+    *pixel = self->color_index;
+
+    if (self->len == 0) {
+        return 0;
+    }
+
+    // get_pixel winds an edge for every x strictly left of where the edge crosses row y, so each
+    // crossing becomes the integer x at which its wind stops counting. Keep them sorted by x.
+    int32_t crossing_x[VECTORIO_POLYGON_MAX_CROSSINGS];
+    int8_t crossing_wind[VECTORIO_POLYGON_MAX_CROSSINGS];
+    uint16_t crossings = 0;
+    int16_t x1 = self->points_list[0];
+    int16_t y1 = self->points_list[1];
+    for (uint16_t i = 2; i <= self->len + 1; ++i) {
+        int16_t x2 = self->points_list[i % self->len];
+        ++i;
+        int16_t y2 = self->points_list[i % self->len];
+        int8_t wind = 0;
+        if (y1 <= y) {
+            if (y2 > y) {
+                wind = 1;
+            }
+        } else if (y2 <= y) {
+            wind = -1;
+        }
+        if (wind != 0) {
+            if (crossings == MIN(VECTORIO_POLYGON_MAX_CROSSINGS, 2 * max_spans)) {
+                return VECTORIO_SPANS_UNAVAILABLE;
+            }
+            // x is left of the edge when x < (x1 * dy + (y - y1) * dx) / dy. Round up to get the
+            // first x that isn't.
+            int32_t numerator = (int32_t)x1 * (y2 - y1) + (int32_t)(y - y1) * (x2 - x1);
+            int32_t denominator = y2 - y1;
+            if (denominator < 0) {
+                numerator = -numerator;
+                denominator = -denominator;
+            }
+            int32_t x = numerator >= 0 ? (numerator + denominator - 1) / denominator : -((-numerator) / denominator);
+            uint16_t j = crossings;
+            while (j > 0 && crossing_x[j - 1] > x) {
+                crossing_x[j] = crossing_x[j - 1];
+                crossing_wind[j] = crossing_wind[j - 1];
+                j--;
+            }
+            crossing_x[j] = x;
+            crossing_wind[j] = wind;
+            crossings++;
+        }
+        x1 = x2;
+        y1 = y2;
+    }
+
+    // The winds of a closed polygon sum to zero, so between two crossings the winding number is
+    // the negated sum of the winds already passed.
+    uint16_t span_count = 0;
+    int16_t winding_number = 0;
+    for (uint16_t i = 0; i + 1 < crossings; i++) {
+        winding_number -= crossing_wind[i];
+        if (winding_number == 0 || crossing_x[i] == crossing_x[i + 1]) {
+            continue;
+        }
+        int16_t start = MAX(SHRT_MIN, crossing_x[i]);
+        int16_t end = MIN(SHRT_MAX, crossing_x[i + 1]);
+        if (span_count > 0 && spans[2 * span_count - 1] == start) {
+            spans[2 * span_count - 1] = end;
+            continue;
+        }
+        spans[2 * span_count] = start;
+        spans[2 * span_count + 1] = end;
+        span_count++;
+    }
+    return span_count;
+}
+
 mp_obj_t common_hal_vectorio_polygon_get_draw_protocol(void *polygon) {
     vectorio_polygon_t *self = polygon;
     return self->draw_protocol_instance;
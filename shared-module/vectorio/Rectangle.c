@@ -34,6 +34,17 @@ uint32_t common_hal_vectorio_rectangle_get_pixel(void *obj, int16_t x, int16_t y
 }
 
 
+uint16_t common_hal_vectorio_rectangle_get_spans(void *obj, int16_t y, int16_t *spans, uint16_t max_spans, uint32_t *pixel) {
+    vectorio_rectangle_t *self = obj;
+    *pixel = self->color_index;
+    if (y < 0 || y >= self->height || self->width == 0 || max_spans == 0) {
+        return 0;
+    }
+    spans[0] = 0;
+    spans[1] = self->width;
+    return 1;
+}
+
 void common_hal_vectorio_rectangle_get_area(void *rectangle, displayio_area_t *out_area) {
     vectorio_rectangle_t *self = rectangle;
     out_area->x1 = 0;
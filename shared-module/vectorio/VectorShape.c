@@ -320,6 +320,65 @@ void common_hal_vectorio_vector_shape_set_pixel_shader(vectorio_vector_shape_t *
     common_hal_vectorio_vector_shape_set_dirty(self);
 }
 
+// Shades and stores one shape pixel value into the buffer. Returns false if the pixel is not
+// covered or is transparent, meaning the area is not fully covered.
+static bool _write_pixel(vectorio_vector_shape_t *self, const _displayio_colorspace_t *colorspace, displayio_input_pixel_t *input_pixel, uint16_t pixel_index, uint16_t linestride_px, uint32_t *mask, uint32_t *buffer) {
+    // vectorio shapes use 0 to mean "area is not covered."
+    // We can skip all the rest of the work for this pixel if it's not currently covered by the shape.
+    if (input_pixel->pixel == 0) {
+        VECTORIO_SHAPE_PIXEL_DEBUG(" (encountered transparent pixel; input area is not fully covered)");
+        return false;
+    }
+    bool covered = true;
+    displayio_output_pixel_t output_pixel;
+    output_pixel.pixel = 0;
+    // Pixel is not transparent. Let's pull the pixel value index down to 0-base for more error-resistant palettes.
+    input_pixel->pixel -= 1;
+    output_pixel.opaque = true;
+
+    if (self->pixel_shader == mp_const_none) {
+        output_pixel.pixel = input_pixel->pixel;
+    } else if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
+        displayio_palette_get_color(self->pixel_shader, colorspace, input_pixel, &output_pixel);
+    } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
+        displayio_colorconverter_convert(self->pixel_shader, colorspace, input_pixel, &output_pixel);
+    }
+
+    // We double-check this to fast-path the case when a pixel is not covered by the shape & not call the color converter unnecessarily.
+    if (!output_pixel.opaque) {
+        VECTORIO_SHAPE_PIXEL_DEBUG(" (encountered transparent pixel from colorconverter; input area is not fully covered)");
+        covered = false;
+    }
+
+    mask[pixel_index / 32] |= 1u << (pixel_index % 32);
+    if (colorspace->depth == 16) {
+        VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %04x 16", output_pixel.pixel);
+        *(((uint16_t *)buffer) + pixel_index) = output_pixel.pixel;
+    } else if (colorspace->depth == 32) {
+        VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %04x 32", output_pixel.pixel);
+        *(((uint32_t *)buffer) + pixel_index) = output_pixel.pixel;
+    } else if (colorspace->depth == 8) {
+        VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %02x 8", output_pixel.pixel);
+        *(((uint8_t *)buffer) + pixel_index) = output_pixel.pixel;
+    } else if (colorspace->depth < 8) {
+        uint8_t pixels_per_byte = 8 / colorspace->depth;
+        // Reorder the offsets to pack multiple rows into a byte (meaning they share a column).
+        if (!colorspace->pixels_in_byte_share_row) {
+            uint16_t row = pixel_index / linestride_px;
+            uint16_t col = pixel_index % linestride_px;
+            pixel_index = col * pixels_per_byte + (row / pixels_per_byte) * pixels_per_byte * linestride_px + row % pixels_per_byte;
+        }
+        uint8_t shift = (pixel_index % pixels_per_byte) * colorspace->depth;
+        if (colorspace->reverse_pixels_in_byte) {
+            // Reverse the shift by subtracting it from the leftmost shift.
+            shift = (pixels_per_byte - 1) * colorspace->depth - shift;
+        }
+        VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %2d %d", output_pixel.pixel, colorspace->depth);
+        ((uint8_t *)buffer)[pixel_index / pixels_per_byte] |= output_pixel.pixel << shift;
+    }
+    return covered;
+}
+
 bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
     // Shape areas are relative to 0,0.  This will allow rotation about a known axis.
     //   The consequence is that the area reported by the shape itself is _relative_ to 0,0.
@@ -348,7 +407,6 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
 
     bool full_coverage = displayio_area_equal(area, &overlap);
 
-    uint8_t pixels_per_byte = 8 / colorspace->depth;
     VECTORIO_SHAPE_DEBUG(" xy:(%3d %3d) tform:{x:%d y:%d dx:%d dy:%d scl:%d w:%d h:%d mx:%d my:%d tr:%d}",
         self->x, self->y,
         self->absolute_transform->x, self->absolute_transform->y, self->absolute_transform->dx, self->absolute_transform->dy, self->absolute_transform->scale,
@@ -358,18 +416,70 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
     uint16_t linestride_px = displayio_area_width(area);
     uint16_t line_dirty_offset_px = (overlap.y1 - area->y1) * linestride_px;
     uint16_t column_dirty_offset_px = overlap.x1 - area->x1;
-    VECTORIO_SHAPE_DEBUG(", linestride:%3d line_offset:%3d col_offset:%3d depth:%2d ppb:%2d shape:%s",
-        linestride_px, line_dirty_offset_px, column_dirty_offset_px, colorspace->depth, pixels_per_byte, mp_obj_get_type_str(self->ishape.shape));
+    VECTORIO_SHAPE_DEBUG(", linestride:%3d line_offset:%3d col_offset:%3d depth:%2d shape:%s",
+        linestride_px, line_dirty_offset_px, column_dirty_offset_px, colorspace->depth, mp_obj_get_type_str(self->ishape.shape));
 
     displayio_input_pixel_t input_pixel;
-    displayio_output_pixel_t output_pixel;
 
     displayio_area_t shape_area;
     self->ishape.get_area(self->ishape.shape, &shape_area);
 
+    // Shapes that can list their covered spans per row skip the per-pixel coverage test. A
+    // transposed transform turns screen rows into shape columns so it always goes pixel by pixel.
+    bool use_spans = self->ishape.get_spans != NULL && !self->absolute_transform->transpose_xy;
+    int8_t shape_dx = self->absolute_transform->dx < 1 ? -1 : 1;
+
     uint16_t mask_start_px = line_dirty_offset_px;
     for (input_pixel.y = overlap.y1; input_pixel.y < overlap.y2; ++input_pixel.y) {
         mask_start_px += column_dirty_offset_px;
+
+        int16_t spans[2 * VECTORIO_MAX_SPANS];
+        uint16_t span_count = VECTORIO_SPANS_UNAVAILABLE;
+        uint32_t span_pixel = 0;
+        int16_t shape_x1 = 0;
+        if (use_spans) {
+            int16_t shape_y;
+            screen_to_shape_coordinates(self, overlap.x1, input_pixel.y, &shape_x1, &shape_y);
+            span_count = self->ishape.get_spans(self->ishape.shape, shape_y, spans, VECTORIO_MAX_SPANS, &span_pixel);
+        }
+
+        if (span_count != VECTORIO_SPANS_UNAVAILABLE) {
+            uint16_t covered = 0;
+            for (uint16_t i = 0; i < span_count; i++) {
+                // Map the shape span back onto this screen row.
+                int32_t screen_x1;
+                int32_t screen_x2;
+                if (shape_dx > 0) {
+                    screen_x1 = overlap.x1 + (spans[2 * i] - shape_x1);
+                    screen_x2 = overlap.x1 + (spans[2 * i + 1] - shape_x1);
+                } else {
+                    screen_x1 = overlap.x1 + shape_x1 - spans[2 * i + 1] + 1;
+                    screen_x2 = overlap.x1 + shape_x1 - spans[2 * i] + 1;
+                }
+                screen_x1 = MAX(screen_x1, overlap.x1);
+                screen_x2 = MIN(screen_x2, overlap.x2);
+                if (screen_x1 >= screen_x2) {
+                    continue;
+                }
+                covered += screen_x2 - screen_x1;
+                for (input_pixel.x = screen_x1; input_pixel.x < screen_x2; ++input_pixel.x) {
+                    uint16_t pixel_index = mask_start_px + (input_pixel.x - overlap.x1);
+                    if ((mask[pixel_index / 32] & (1u << (pixel_index % 32))) != 0) {
+                        continue;
+                    }
+                    input_pixel.pixel = span_pixel;
+                    if (!_write_pixel(self, colorspace, &input_pixel, pixel_index, linestride_px, mask, buffer)) {
+                        full_coverage = false;
+                    }
+                }
+            }
+            if (covered < overlap.x2 - overlap.x1) {
+                full_coverage = false;
+            }
+            mask_start_px += linestride_px - column_dirty_offset_px;
+            continue;
+        }
+
         for (input_pixel.x = overlap.x1; input_pixel.x < overlap.x2; ++input_pixel.x) {
             // Check the mask first to see if the pixel has already been set.
             uint16_t pixel_index = mask_start_px + (input_pixel.x - overlap.x1);
@@ -380,7 +490,6 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
                 VECTORIO_SHAPE_PIXEL_DEBUG(" masked");
                 continue;
             }
-            output_pixel.pixel = 0;
 
             // Cast input screen coordinates to shape coordinates to pick the pixel to draw
             int16_t pixel_to_get_x;
@@ -398,55 +507,8 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
             #endif
             VECTORIO_SHAPE_PIXEL_DEBUG(" -> %d", input_pixel.pixel);
 
-            // vectorio shapes use 0 to mean "area is not covered."
-            // We can skip all the rest of the work for this pixel if it's not currently covered by the shape.
-            if (input_pixel.pixel == 0) {
-                VECTORIO_SHAPE_PIXEL_DEBUG(" (encountered transparent pixel; input area is not fully covered)");
+            if (!_write_pixel(self, colorspace, &input_pixel, pixel_index, linestride_px, mask, buffer)) {
                 full_coverage = false;
-            } else {
-                // Pixel is not transparent. Let's pull the pixel value index down to 0-base for more error-resistant palettes.
-                input_pixel.pixel -= 1;
-                output_pixel.opaque = true;
-
-                if (self->pixel_shader == mp_const_none) {
-                    output_pixel.pixel = input_pixel.pixel;
-                } else if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
-                    displayio_palette_get_color(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
-                } else if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
-                    displayio_colorconverter_convert(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
-                }
-
-                // We double-check this to fast-path the case when a pixel is not covered by the shape & not call the color converter unnecessarily.
-                if (!output_pixel.opaque) {
-                    VECTORIO_SHAPE_PIXEL_DEBUG(" (encountered transparent pixel from colorconverter; input area is not fully covered)");
-                    full_coverage = false;
-                }
-
-                *mask_doubleword |= 1u << mask_bit;
-                if (colorspace->depth == 16) {
-                    VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %04x 16", output_pixel.pixel);
-                    *(((uint16_t *)buffer) + pixel_index) = output_pixel.pixel;
-                } else if (colorspace->depth == 32) {
-                    VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %04x 32", output_pixel.pixel);
-                    *(((uint32_t *)buffer) + pixel_index) = output_pixel.pixel;
-                } else if (colorspace->depth == 8) {
-                    VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %02x 8", output_pixel.pixel);
-                    *(((uint8_t *)buffer) + pixel_index) = output_pixel.pixel;
-                } else if (colorspace->depth < 8) {
-                    // Reorder the offsets to pack multiple rows into a byte (meaning they share a column).
-                    if (!colorspace->pixels_in_byte_share_row) {
-                        uint16_t row = pixel_index / linestride_px;
-                        uint16_t col = pixel_index % linestride_px;
-                        pixel_index = col * pixels_per_byte + (row / pixels_per_byte) * pixels_per_byte * linestride_px + row % pixels_per_byte;
-                    }
-                    uint8_t shift = (pixel_index % pixels_per_byte) * colorspace->depth;
-                    if (colorspace->reverse_pixels_in_byte) {
-                        // Reverse the shift by subtracting it from the leftmost shift.
-                        shift = (pixels_per_byte - 1) * colorspace->depth - shift;
-                    }
-                    VECTORIO_SHAPE_PIXEL_DEBUG(" buffer = %2d %d", output_pixel.pixel, colorspace->depth);
-                    ((uint8_t *)buffer)[pixel_index / pixels_per_byte] |= output_pixel.pixel << shift;
-                }
             }
         }
         mask_start_px += linestride_px - column_dirty_offset_px;
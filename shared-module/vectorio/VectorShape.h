@@ -17,6 +17,15 @@
 typedef void get_area_function(mp_obj_t shape, displayio_area_t *out_area);
 typedef uint32_t get_pixel_function(mp_obj_t shape, int16_t x, int16_t y);
 
+// Most spans a shape lists for one row before VectorShape draws the row pixel by pixel instead.
+#define VECTORIO_MAX_SPANS (16)
+#define VECTORIO_SPANS_UNAVAILABLE (0xffff)
+
+// Fills spans with [x1, x2) pairs of shape x coordinates covered on row y, ordered left to right,
+// and returns the number of pairs. pixel is set to the value of the covered pixels. Returns
+// VECTORIO_SPANS_UNAVAILABLE if the row needs more than max_spans pairs.
+typedef uint16_t get_spans_function(mp_obj_t shape, int16_t y, int16_t *spans, uint16_t max_spans, uint32_t *pixel);
+
 // This struct binds a shape's common Shape support functions (its vector shape interface)
 //   to its instance pointer.  We only check at construction time what the type of the
 //   associated shape is and link the correct functions up.
@@ -27,6 +36,7 @@ typedef struct {
     mp_obj_t shape;
     get_area_function *get_area;
     get_pixel_function *get_pixel;
+    get_spans_function *get_spans; // Optional
 } vectorio_ishape_t;
 
 typedef struct {
@@ -0,0 +1,398 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "py/stream.h"
+
+#include "shared-bindings/zlib/Compress.h"
+
+#include "lib/uzlib/uzlib.h"
+
+// LZ77 with hash chains, encoded with the fixed Huffman codes of DEFLATE so
+// no block has to be buffered to build its own code tables. Matches are
+// found greedily. buf holds the window of history and the input after it.
+// When buf fills it slides down by one window, which keeps the position of
+// every entry in prev the same modulo the window size.
+
+#define MIN_MATCH (3)
+#define MAX_MATCH (258)
+#define NIL (0xffff)
+
+// Hash chain steps and the match length that ends the search, by level.
+static const uint16_t level_params[10][2] = {
+    {0, 0},
+    {4, 8},
+    {4, 16},
+    {8, 32},
+    {16, 64},
+    {32, 128},
+    {64, 128},
+    {128, MAX_MATCH},
+    {256, MAX_MATCH},
+    {1024, MAX_MATCH},
+};
+
+static const uint16_t length_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+};
+static const uint8_t length_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
+};
+static const uint16_t dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577,
+};
+static const uint8_t dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13,
+};
+
+void common_hal_zlib_compress_obj_construct(zlib_compress_obj_t *self, mp_int_t level, zlib_format_t format, mp_int_t window_bits, mp_obj_t stream) {
+    if (level < 0) {
+        level = 6;
+    }
+    window_bits = MIN(window_bits, CIRCUITPY_ZLIB_COMPRESS_MAX_WBITS);
+    size_t window_size = 1 << window_bits;
+
+    self->stream = stream;
+    self->out = NULL;
+    self->format = format;
+    self->window_bits = window_bits;
+    self->hash_bits = MIN(window_bits, 10);
+    // Room for a window of history and enough lookahead for a full match
+    // after sliding.
+    self->buf_size = MAX(2 * window_size, window_size + 2 * MAX_MATCH);
+    self->buf = m_new(uint8_t, self->buf_size);
+    self->head = m_new(uint16_t, 1 << self->hash_bits);
+    self->prev = m_new(uint16_t, window_size);
+    memset(self->head, 0xff, sizeof(uint16_t) << self->hash_bits);
+    self->pos = 0;
+    self->end = 0;
+    self->max_chain = MIN(level_params[level][0], window_size);
+    self->nice_length = level_params[level][1];
+    self->checksum = format == ZLIB_FORMAT_GZIP ? ~0 : 1;
+    self->total_in = 0;
+    self->bits = 0;
+    self->bit_count = 0;
+    self->out_len = 0;
+    self->header_done = false;
+    self->in_block = false;
+    self->finished = false;
+    self->level = level;
+}
+
+void common_hal_zlib_compress_obj_deinit(zlib_compress_obj_t *self) {
+    if (self->buf == NULL) {
+        return;
+    }
+    m_del(uint8_t, self->buf, self->buf_size);
+    m_del(uint16_t, self->head, 1 << self->hash_bits);
+    m_del(uint16_t, self->prev, 1 << self->window_bits);
+    self->buf = NULL;
+    self->head = NULL;
+    self->prev = NULL;
+}
+
+static void write_out(zlib_compress_obj_t *self) {
+    if (self->out_len == 0) {
+        return;
+    }
+    int errcode;
+    mp_stream_write_exactly(self->stream, self->out_buf, self->out_len, &errcode);
+    self->out_len = 0;
+    if (errcode != 0) {
+        mp_raise_OSError(errcode);
+    }
+}
+
+static void put_byte(zlib_compress_obj_t *self, uint8_t b) {
+    if (self->stream == MP_OBJ_NULL) {
+        vstr_add_byte(self->out, b);
+        return;
+    }
+    self->out_buf[self->out_len++] = b;
+    if (self->out_len == sizeof(self->out_buf)) {
+        write_out(self);
+    }
+}
+
+static void put_bits(zlib_compress_obj_t *self, uint32_t value, uint8_t count) {
+    self->bits |= value << self->bit_count;
+    self->bit_count += count;
+    while (self->bit_count >= 8) {
+        put_byte(self, self->bits & 0xff);
+        self->bits >>= 8;
+        self->bit_count -= 8;
+    }
+}
+
+static void align_to_byte(zlib_compress_obj_t *self) {
+    if (self->bit_count != 0) {
+        put_bits(self, 0, 8 - self->bit_count);
+    }
+}
+
+// Huffman codes are packed starting from their most significant bit.
+static void put_code(zlib_compress_obj_t *self, uint32_t code, uint8_t count) {
+    uint32_t reversed = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        reversed = (reversed << 1) | (code & 1);
+        code >>= 1;
+    }
+    put_bits(self, reversed, count);
+}
+
+static void put_symbol(zlib_compress_obj_t *self, uint16_t symbol) {
+    if (symbol < 144) {
+        put_code(self, 0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        put_code(self, 0x190 + symbol - 144, 9);
+    } else if (symbol < 280) {
+        put_code(self, symbol - 256, 7);
+    } else {
+        put_code(self, 0xc0 + symbol - 280, 8);
+    }
+}
+
+static void put_match(zlib_compress_obj_t *self, size_t length, size_t distance) {
+    size_t i = MP_ARRAY_SIZE(length_base) - 1;
+    while (length < length_base[i]) {
+        i--;
+    }
+    put_symbol(self, 257 + i);
+    put_bits(self, length - length_base[i], length_extra[i]);
+
+    i = MP_ARRAY_SIZE(dist_base) - 1;
+    while (distance < dist_base[i]) {
+        i--;
+    }
+    put_code(self, i, 5);
+    put_bits(self, distance - dist_base[i], dist_extra[i]);
+}
+
+static void put_header(zlib_compress_obj_t *self) {
+    self->header_done = true;
+    uint8_t level = self->level;
+    if (self->format == ZLIB_FORMAT_ZLIB) {
+        uint8_t cmf = 0x08 | (self->window_bits - 8) << 4;
+        uint8_t flevel = level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3;
+        uint8_t flg = flevel << 6;
+        flg |= (31 - (cmf << 8 | flg) % 31) % 31;
+        put_byte(self, cmf);
+        put_byte(self, flg);
+    } else if (self->format == ZLIB_FORMAT_GZIP) {
+        static const uint8_t gzip_header[] = { 0x1f, 0x8b, 0x08, 0, 0, 0, 0, 0 };
+        for (size_t i = 0; i < sizeof(gzip_header); i++) {
+            put_byte(self, gzip_header[i]);
+        }
+        put_byte(self, level == 9 ? 2 : level == 1 ? 4 : 0);
+        // Unknown operating system.
+        put_byte(self, 0xff);
+    }
+}
+
+static uint16_t hash_at(zlib_compress_obj_t *self, size_t pos) {
+    const uint8_t *p = self->buf + pos;
+    uint32_t h = (p[0] << 10) ^ (p[1] << 5) ^ p[2];
+    h ^= h >> self->hash_bits;
+    return h & ((1 << self->hash_bits) - 1);
+}
+
+static void insert(zlib_compress_obj_t *self, size_t pos, uint16_t h) {
+    self->prev[pos & ((1 << self->window_bits) - 1)] = self->head[h];
+    self->head[h] = pos;
+}
+
+// Returns the length of the longest match for pos found within the chain
+// limits, and sets *distance to how far back it starts.
+static size_t longest_match(zlib_compress_obj_t *self, size_t pos, size_t candidate, size_t *distance) {
+    size_t window_size = 1 << self->window_bits;
+    size_t limit = MIN((size_t)(self->end - pos), MAX_MATCH);
+    const uint8_t *here = self->buf + pos;
+    size_t best = 0;
+    uint16_t chain = self->max_chain;
+    while (candidate != NIL && chain-- > 0 && pos - candidate <= window_size) {
+        const uint8_t *there = self->buf + candidate;
+        if (there[best] == here[best] && there[0] == here[0]) {
+            size_t len = 0;
+            while (len < limit && there[len] == here[len]) {
+                len++;
+            }
+            if (len > best) {
+                best = len;
+                *distance = pos - candidate;
+                if (best >= self->nice_length || best == limit) {
+                    break;
+                }
+            }
+        }
+        // Positions from before the last window have been overwritten.
+        size_t next = self->prev[candidate & (window_size - 1)];
+        if (next >= candidate) {
+            break;
+        }
+        candidate = next;
+    }
+    return best;
+}
+
+// Encode the pending input, leaving enough to look ahead for a full match
+// unless flushing.
+static void encode(zlib_compress_obj_t *self, bool flush) {
+    while (self->pos < self->end) {
+        size_t pos = self->pos;
+        size_t avail = self->end - pos;
+        if (!flush && avail < MAX_MATCH) {
+            break;
+        }
+        if (!self->in_block) {
+            // Not the final block, fixed codes.
+            put_bits(self, 2, 3);
+            self->in_block = true;
+        }
+        size_t length = 0;
+        size_t distance = 0;
+        if (avail >= MIN_MATCH) {
+            uint16_t h = hash_at(self, pos);
+            if (self->max_chain > 0) {
+                length = longest_match(self, pos, self->head[h], &distance);
+            }
+            insert(self, pos, h);
+        }
+        if (length >= MIN_MATCH) {
+            put_match(self, length, distance);
+            for (size_t p = pos + 1; p < pos + length && p + MIN_MATCH <= self->end; p++) {
+                insert(self, p, hash_at(self, p));
+            }
+        } else {
+            length = 1;
+            put_symbol(self, self->buf[pos]);
+        }
+        self->pos = pos + length;
+    }
+}
+
+static void slide(zlib_compress_obj_t *self) {
+    uint16_t shift = 1 << self->window_bits;
+    memmove(self->buf, self->buf + shift, self->end - shift);
+    self->pos -= shift;
+    self->end -= shift;
+    for (size_t i = 0; i < (1u << self->hash_bits); i++) {
+        uint16_t p = self->head[i];
+        self->head[i] = p == NIL || p < shift ? NIL : p - shift;
+    }
+    for (size_t i = 0; i < shift; i++) {
+        uint16_t p = self->prev[i];
+        self->prev[i] = p == NIL || p < shift ? NIL : p - shift;
+    }
+}
+
+static void begin(zlib_compress_obj_t *self, vstr_t *out) {
+    if (self->finished) {
+        mp_raise_ValueError(MP_ERROR_TEXT("Compression stream has finished"));
+    }
+    self->out = out;
+    if (!self->header_done) {
+        put_header(self);
+    }
+}
+
+static mp_obj_t finish_call(zlib_compress_obj_t *self, vstr_t *out) {
+    self->out = NULL;
+    if (self->stream != MP_OBJ_NULL) {
+        write_out(self);
+        return mp_const_empty_bytes;
+    }
+    return mp_obj_new_bytes_from_vstr(out);
+}
+
+mp_obj_t common_hal_zlib_compress_obj_compress(zlib_compress_obj_t *self, const uint8_t *data, size_t len) {
+    vstr_t out;
+    vstr_init(&out, self->stream == MP_OBJ_NULL ? len / 2 + 16 : 0);
+    begin(self, &out);
+
+    self->total_in += len;
+    if (self->format == ZLIB_FORMAT_ZLIB) {
+        self->checksum = uzlib_adler32(data, len, self->checksum);
+    } else if (self->format == ZLIB_FORMAT_GZIP) {
+        self->checksum = uzlib_crc32(data, len, self->checksum);
+    }
+    while (len > 0) {
+        if (self->end == self->buf_size) {
+            slide(self);
+        }
+        size_t n = MIN(len, (size_t)(self->buf_size - self->end));
+        memcpy(self->buf + self->end, data, n);
+        self->end += n;
+        data += n;
+        len -= n;
+        encode(self, false);
+    }
+    return finish_call(self, &out);
+}
+
+static void put_be32(zlib_compress_obj_t *self, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        put_byte(self, value >> shift);
+    }
+}
+
+static void put_le32(zlib_compress_obj_t *self, uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        put_byte(self, value >> shift);
+    }
+}
+
+mp_obj_t common_hal_zlib_compress_obj_flush(zlib_compress_obj_t *self, mp_int_t mode) {
+    if (self->finished) {
+        return mp_const_empty_bytes;
+    }
+    vstr_t out;
+    vstr_init(&out, 16);
+    begin(self, &out);
+    encode(self, mode != ZLIB_Z_NO_FLUSH);
+    if (mode == ZLIB_Z_FINISH) {
+        if (self->in_block) {
+            put_symbol(self, 256);
+        }
+        // An empty final block.
+        put_bits(self, 3, 3);
+        put_symbol(self, 256);
+        align_to_byte(self);
+        if (self->format == ZLIB_FORMAT_ZLIB) {
+            put_be32(self, self->checksum);
+        } else if (self->format == ZLIB_FORMAT_GZIP) {
+            put_le32(self, ~self->checksum);
+            put_le32(self, self->total_in);
+        }
+        self->finished = true;
+    } else if (mode != ZLIB_Z_NO_FLUSH) {
+        if (self->in_block) {
+            put_symbol(self, 256);
+            self->in_block = false;
+        }
+        // An empty stored block brings the output to a byte boundary.
+        put_bits(self, 0, 3);
+        align_to_byte(self);
+        put_byte(self, 0x00);
+        put_byte(self, 0x00);
+        put_byte(self, 0xff);
+        put_byte(self, 0xff);
+        if (mode == ZLIB_Z_FULL_FLUSH) {
+            // Later data can be decompressed without anything before this point.
+            memset(self->head, 0xff, sizeof(uint16_t) << self->hash_bits);
+        }
+    }
+    mp_obj_t result = finish_call(self, &out);
+    if (self->finished) {
+        common_hal_zlib_compress_obj_deinit(self);
+    }
+    return result;
+}
@@ -0,0 +1,67 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+// The largest history window, as a power of two, that the compressor keeps.
+// Larger wbits are accepted and use this window. The buffers take about four
+// times the window in bytes.
+#ifndef CIRCUITPY_ZLIB_COMPRESS_MAX_WBITS
+#define CIRCUITPY_ZLIB_COMPRESS_MAX_WBITS (12)
+#endif
+
+// Bytes of output collected before each write to the destination stream.
+#ifndef CIRCUITPY_ZLIB_COMPRESS_OUT_SIZE
+#define CIRCUITPY_ZLIB_COMPRESS_OUT_SIZE (64)
+#endif
+
+typedef enum {
+    ZLIB_FORMAT_RAW,
+    ZLIB_FORMAT_ZLIB,
+    ZLIB_FORMAT_GZIP,
+} zlib_format_t;
+
+// The flush modes, with CPython's values.
+typedef enum {
+    ZLIB_Z_NO_FLUSH = 0,
+    ZLIB_Z_SYNC_FLUSH = 2,
+    ZLIB_Z_FULL_FLUSH = 3,
+    ZLIB_Z_FINISH = 4,
+} zlib_flush_mode_t;
+
+typedef struct {
+    mp_obj_base_t base;
+    // Where compressed output is written, or MP_OBJ_NULL to return it.
+    mp_obj_t stream;
+    // Collects the output returned by the current call when there is no stream.
+    vstr_t *out;
+    // History followed by input that has not been encoded yet.
+    uint8_t *buf;
+    // Most recent position for each hash, and the previous one for each position.
+    uint16_t *head;
+    uint16_t *prev;
+    uint32_t checksum;
+    uint32_t total_in;
+    uint32_t bits;
+    uint8_t bit_count;
+    uint8_t window_bits;
+    uint8_t hash_bits;
+    uint8_t format;
+    uint8_t level;
+    uint16_t buf_size;
+    // Next byte to encode, and end of the input in buf.
+    uint16_t pos;
+    uint16_t end;
+    uint16_t max_chain;
+    uint16_t nice_length;
+    uint8_t out_buf[CIRCUITPY_ZLIB_COMPRESS_OUT_SIZE];
+    uint8_t out_len;
+    bool header_done;
+    bool in_block;
+    bool finished;
+} zlib_compress_obj_t;
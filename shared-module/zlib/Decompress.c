@@ -0,0 +1,217 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/runtime.h"
+
+#include "shared-bindings/zlib/Decompress.h"
+
+// uzlib cannot suspend when its input runs out in the middle of a symbol:
+// it sets the sticky eof flag and carries on reading zeros. So input is
+// inflated in attempts of bounded output size. An attempt that hits eof is
+// undone by restoring the decoder state saved before it, and its input is
+// kept until more arrives. Halving the attempt size after each rollback
+// still extracts everything the available input can produce.
+
+void common_hal_zlib_decompress_obj_construct(zlib_decompress_obj_t *self, mp_int_t wbits) {
+    memset(&self->decomp, 0, sizeof(self->decomp));
+    uzlib_uncompress_init(&self->decomp, NULL, 0);
+    self->dict = 0;
+    self->pending = NULL;
+    self->pending_len = 0;
+    self->unused_data = mp_const_empty_bytes;
+    self->unconsumed_tail = mp_const_empty_bytes;
+    self->wbits = wbits;
+    self->header_done = false;
+    self->eof = false;
+}
+
+static NORETURN void raise_inflate_error(int st) {
+    mp_raise_type_arg(&mp_type_ValueError, MP_OBJ_NEW_SMALL_INT(st));
+}
+
+// Parse the zlib or gzip header, if any, and set up the dictionary ring.
+// Returns false if more input is needed first.
+static bool parse_header(zlib_decompress_obj_t *self) {
+    TINF_DATA *d = &self->decomp;
+    self->saved = *d;
+
+    int st = TINF_OK;
+    mp_int_t window_bits;
+    if (self->wbits >= 16) {
+        st = uzlib_gzip_parse_header(d);
+        window_bits = self->wbits - 16;
+    } else if (self->wbits >= 0) {
+        st = uzlib_zlib_parse_header(d);
+        // The header tells how large a window the stream really needs.
+        window_bits = st + 8;
+    } else {
+        window_bits = -self->wbits;
+    }
+    if (d->eof) {
+        *d = self->saved;
+        return false;
+    }
+    if (st < 0) {
+        raise_inflate_error(st);
+    }
+    if (window_bits < 8 || window_bits > 15) {
+        window_bits = 15;
+    }
+
+    size_t dict_size = (1 << window_bits) + CIRCUITPY_ZLIB_DECOMPRESS_STEP;
+    self->dict = gc_movable_alloc(dict_size);
+    if (self->dict == 0) {
+        m_malloc_fail(dict_size);
+    }
+    // Don't let a stream that refers back before its start see stale heap contents.
+    d->dict_ring = gc_movable_get(self->dict);
+    memset(d->dict_ring, 0, dict_size);
+    d->dict_size = dict_size;
+    d->dict_idx = 0;
+    self->header_done = true;
+    return true;
+}
+
+// Keep the input the decoder has not consumed for the next call. src is
+// either the caller's buffer or self->pending, which then has src_len bytes.
+static void keep_pending(zlib_decompress_obj_t *self, const uint8_t *src, size_t src_len) {
+    TINF_DATA *d = &self->decomp;
+    size_t leftover = d->source_limit - d->source;
+    if (src == self->pending) {
+        memmove(self->pending, d->source, leftover);
+        if (leftover == 0) {
+            m_del(uint8_t, self->pending, src_len);
+            self->pending = NULL;
+        } else {
+            self->pending = m_renew(uint8_t, self->pending, src_len, leftover);
+        }
+    } else if (leftover != 0) {
+        self->pending = m_new(uint8_t, leftover);
+        memcpy(self->pending, d->source, leftover);
+    }
+    self->pending_len = leftover;
+}
+
+mp_obj_t common_hal_zlib_decompress_obj_decompress(zlib_decompress_obj_t *self, const uint8_t *data, size_t len, mp_uint_t max_length) {
+    if (self->eof) {
+        // Like CPython, anything after the end of the stream is unused data.
+        if (len != 0) {
+            mp_buffer_info_t unused;
+            mp_get_buffer_raise(self->unused_data, &unused, MP_BUFFER_READ);
+            vstr_t v;
+            vstr_init(&v, unused.len + len);
+            vstr_add_strn(&v, unused.buf, unused.len);
+            vstr_add_strn(&v, (const char *)data, len);
+            self->unused_data = mp_obj_new_bytes_from_vstr(&v);
+        }
+        return mp_const_empty_bytes;
+    }
+
+    // Decode from the caller's buffer directly unless there's input left over.
+    const uint8_t *src = data;
+    size_t src_len = len;
+    if (self->pending_len != 0) {
+        self->pending = m_renew(uint8_t, self->pending, self->pending_len, self->pending_len + len);
+        memcpy(self->pending + self->pending_len, data, len);
+        src = self->pending;
+        src_len = self->pending_len + len;
+        self->pending_len = src_len;
+    }
+
+    TINF_DATA *d = &self->decomp;
+    d->source = src;
+    d->source_limit = src + src_len;
+
+    vstr_t out;
+    vstr_init(&out, max_length ? MIN(max_length, CIRCUITPY_ZLIB_DECOMPRESS_STEP) : CIRCUITPY_ZLIB_DECOMPRESS_STEP);
+    bool limited = false;
+
+    if (self->header_done || parse_header(self)) {
+        size_t step = CIRCUITPY_ZLIB_DECOMPRESS_STEP;
+        while (true) {
+            size_t room = step;
+            if (max_length) {
+                if (out.len >= max_length) {
+                    limited = true;
+                    break;
+                }
+                room = MIN(room, max_length - out.len);
+            }
+
+            if (out.alloc - out.len < room) {
+                // vstr only grows by what is asked for; double it instead.
+                vstr_hint_size(&out, MAX(room, out.len));
+            }
+            uint8_t *dest = (uint8_t *)vstr_add_len(&out, room);
+            d->dict_ring = gc_movable_get(self->dict);
+            self->saved = *d;
+            d->dest = d->dest_start = dest;
+            d->dest_limit = dest + room;
+            int st = uzlib_uncompress_chksum(d);
+
+            if (d->eof) {
+                // Ran out of input partway; undo and try a smaller attempt.
+                *d = self->saved;
+                out.len -= room;
+                if (room == 1) {
+                    break;
+                }
+                step = room / 2;
+                continue;
+            }
+            if (st < 0) {
+                raise_inflate_error(st);
+            }
+            out.len -= room - (d->dest - dest);
+            if (st == TINF_DONE) {
+                self->eof = true;
+                break;
+            }
+        }
+    }
+
+    if (self->eof) {
+        self->unused_data = mp_obj_new_bytes(d->source, d->source_limit - d->source);
+        d->source = d->source_limit;
+        // The history is no longer needed.
+        common_hal_zlib_decompress_obj_deinit(self);
+    }
+    if (limited) {
+        // As in CPython, input held back by max_length is handed back to
+        // the caller, who passes it in again.
+        self->unconsumed_tail = mp_obj_new_bytes(d->source, d->source_limit - d->source);
+        d->source = d->source_limit;
+    } else {
+        self->unconsumed_tail = mp_const_empty_bytes;
+    }
+    keep_pending(self, src, src_len);
+    d->source = d->source_limit = NULL;
+    d->dest = d->dest_start = d->dest_limit = NULL;
+
+    return mp_obj_new_bytes_from_vstr(&out);
+}
+
+void common_hal_zlib_decompress_obj_deinit(zlib_decompress_obj_t *self) {
+    if (self->dict != 0) {
+        gc_movable_free(self->dict);
+        self->dict = 0;
+        self->decomp.dict_ring = NULL;
+    }
+}
+
+bool common_hal_zlib_decompress_obj_get_eof(zlib_decompress_obj_t *self) {
+    return self->eof;
+}
+
+mp_obj_t common_hal_zlib_decompress_obj_get_unused_data(zlib_decompress_obj_t *self) {
+    return self->unused_data;
+}
+
+mp_obj_t common_hal_zlib_decompress_obj_get_unconsumed_tail(zlib_decompress_obj_t *self) {
+    return self->unconsumed_tail;
+}
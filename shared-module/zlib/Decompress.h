@@ -0,0 +1,37 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/gc.h"
+#include "py/obj.h"
+
+#include "lib/uzlib/uzlib.h"
+
+// Maximum output produced by one inflate attempt. The dictionary ring is
+// this much larger than the window, so that an attempt which runs out of
+// input and is rolled back only overwrites history that is out of reach.
+#ifndef CIRCUITPY_ZLIB_DECOMPRESS_STEP
+#define CIRCUITPY_ZLIB_DECOMPRESS_STEP (1024)
+#endif
+
+typedef struct {
+    mp_obj_base_t base;
+    TINF_DATA decomp;
+    // State before the current attempt, restored if it runs out of input.
+    TINF_DATA saved;
+    // The dictionary ring. The heap may move it between allocations, so the
+    // decoder's pointer to it is refreshed before each inflate attempt.
+    gc_movable_t dict;
+    // Input that was received but could not be decoded yet.
+    uint8_t *pending;
+    size_t pending_len;
+    mp_obj_t unused_data;
+    mp_obj_t unconsumed_tail;
+    mp_int_t wbits;
+    bool header_done;
+    bool eof;
+} zlib_decompress_obj_t;
@@ -18,6 +18,7 @@
 #include "py/parsenum.h"
 
 #include "shared-bindings/zlib/__init__.h"
+#include "supervisor/shared/memory.h"
 
 #define UZLIB_CONF_PARANOID_CHECKS (1)
 #include "lib/uzlib/tinf.h"
@@ -32,7 +33,9 @@ mp_obj_t common_hal_zlib_decompress(mp_obj_t data, mp_int_t wbits) {
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(data, &bufinfo, MP_BUFFER_READ);
 
-    TINF_DATA *decomp = m_new_obj(TINF_DATA);
+    // The decompressor state only points at buffers that are also held on
+    // the C stack, so it can live outside the GC heap.
+    TINF_DATA *decomp = supervisor_scratch_push(sizeof(TINF_DATA));
     memset(decomp, 0, sizeof(*decomp));
     DEBUG_printf("sizeof(TINF_DATA)=" UINT_FMT "\n", sizeof(*decomp));
     uzlib_uncompress_init(decomp, NULL, 0);
@@ -77,9 +80,10 @@ mp_obj_t common_hal_zlib_decompress(mp_obj_t data, mp_int_t wbits) {
     DEBUG_printf("zlib: Resizing from " UINT_FMT " to final size: " UINT_FMT " bytes\n", dest_buf_size, final_sz);
     dest_buf = (byte *)m_renew(byte, dest_buf, dest_buf_size, final_sz);
     mp_obj_t res = mp_obj_new_bytearray_by_ref(final_sz, dest_buf);
-    m_del_obj(TINF_DATA, decomp);
+    supervisor_scratch_pop(decomp);
     return res;
 
 error:
+    supervisor_scratch_pop(decomp);
     mp_raise_type_arg(&mp_type_ValueError, MP_OBJ_NEW_SMALL_INT(st));
 }
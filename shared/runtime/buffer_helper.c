@@ -6,6 +6,9 @@
 
 #include "shared/runtime/buffer_helper.h"
 
+#include "py/binary.h"
+#include "py/runtime.h"
+
 void normalize_buffer_bounds(int32_t *start, int32_t end, size_t *length) {
     if (end < 0) {
         end += *length;
@@ -21,3 +24,17 @@ void normalize_buffer_bounds(int32_t *start, int32_t end, size_t *length) {
         *length = end - *start;
     }
 }
+
+void get_buffer_slice_raise(mp_obj_t obj, mp_buffer_info_t *bufinfo, mp_uint_t flags, int32_t start, int32_t end) {
+    mp_get_buffer_raise(obj, bufinfo, flags);
+    size_t stride_in_bytes = mp_binary_get_size('@', bufinfo->typecode, NULL);
+    size_t length = bufinfo->len / stride_in_bytes;
+    normalize_buffer_bounds(&start, end, &length);
+    // A start before the beginning of the buffer is clamped, as slicing does.
+    if (start < 0) {
+        length = (size_t)-start < length ? length + start : 0;
+        start = 0;
+    }
+    bufinfo->buf = (uint8_t *)bufinfo->buf + start * stride_in_bytes;
+    bufinfo->len = length * stride_in_bytes;
+}
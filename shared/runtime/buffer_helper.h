@@ -9,4 +9,10 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "py/obj.h"
+
 void normalize_buffer_bounds(int32_t *start, int32_t end, size_t *length);
+
+// Get the buffer of obj narrowed to obj[start:end], without copying it.
+// start and end count elements of the buffer's type, as slicing does.
+void get_buffer_slice_raise(mp_obj_t obj, mp_buffer_info_t *bufinfo, mp_uint_t flags, int32_t start, int32_t end);
@@ -50,6 +50,14 @@
 #include "shared-module/atexit/__init__.h"
 #endif
 
+#if CIRCUITPY_CODE_CACHE
+#include "supervisor/shared/code_cache.h"
+#endif
+
+#if CIRCUITPY_BOOT_TIMING
+#include "supervisor/shared/boot_timing.h"
+#endif
+
 pyexec_mode_kind_t pyexec_mode_kind = PYEXEC_MODE_FRIENDLY_REPL;
 int pyexec_system_exit = 0;
 
@@ -92,6 +100,15 @@ STATIC int parse_compile_execute(const void *source, mp_parse_input_kind_t input
         if (!(exec_flags & EXEC_FLAG_SOURCE_IS_ATEXIT))
         #endif
         {
+            // CIRCUITPY-CHANGE: reuse previously compiled bytecode for source files
+            #if CIRCUITPY_CODE_CACHE
+            if ((exec_flags & EXEC_FLAG_SOURCE_IS_FILENAME) && input_kind == MP_PARSE_FILE_INPUT) {
+                #if MICROPY_PY___FILE__
+                mp_store_global(MP_QSTR___file__, MP_OBJ_NEW_QSTR(qstr_from_str(source)));
+                #endif
+                module_fun = supervisor_code_cache_load(source);
+            } else
+            #endif
             #if MICROPY_MODULE_FROZEN_MPY
             if (exec_flags & EXEC_FLAG_SOURCE_IS_RAW_CODE) {
                 // source is a raw_code object, create the function
@@ -131,6 +148,13 @@ STATIC int parse_compile_execute(const void *source, mp_parse_input_kind_t input
                 #endif
             }
 
+            // CIRCUITPY-CHANGE
+            #if CIRCUITPY_BOOT_TIMING
+            if (exec_flags & EXEC_FLAG_SOURCE_IS_FILENAME) {
+                supervisor_boot_timing_file_compiled();
+            }
+            #endif
+
             // If the code was loaded from a file, collect any garbage before running.
             if (input_kind == MP_PARSE_FILE_INPUT) {
                 gc_collect();
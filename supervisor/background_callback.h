@@ -7,6 +7,10 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "py/mpconfig.h"
 
 /** Background callbacks are a linked list of tasks to call in the background.
  *
@@ -27,6 +31,12 @@
  *
  * background_callback_add can be called from interrupt context.
  *
+ * Each callback belongs to a priority class, which is normal unless it was
+ * queued with background_callback_add_with_priority. Realtime callbacks, such
+ * as audio buffer refills, run first and again between every other callback.
+ * Idle callbacks only run when no realtime work is waiting and stay queued for
+ * a later run once CIRCUITPY_BACKGROUND_CALLBACK_IDLE_BUDGET_TICKS have passed.
+ *
  * If your work isn't triggered by an event, then it may be better implemented
  * using ticks, which runs tasks every millisecond or so. Ticks are enabled with
  * supervisor_enable_tick() and disabled with supervisor_disable_tick(). When
@@ -34,11 +44,24 @@
  * which includes port_background_tick(), every millisecond.
  */
 typedef void (*background_callback_fun)(void *data);
+
+// Normal is zero so that zero-initialized callbacks get it.
+typedef enum {
+    BACKGROUND_CALLBACK_PRIORITY_NORMAL = 0,
+    BACKGROUND_CALLBACK_PRIORITY_REALTIME,
+    BACKGROUND_CALLBACK_PRIORITY_IDLE,
+    BACKGROUND_CALLBACK_PRIORITY_COUNT
+} background_callback_priority_t;
+
 typedef struct background_callback {
     background_callback_fun fun;
     void *data;
     struct background_callback *next;
     struct background_callback *prev;
+    uint8_t priority; // background_callback_priority_t
+    #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+    uint32_t queued_cycles;
+    #endif
 } background_callback_t;
 
 /* Add a background callback for which 'fun' and 'data' were previously set */
@@ -53,6 +76,11 @@ void background_callback_add_core(background_callback_t *cb);
  */
 void background_callback_add(background_callback_t *cb, background_callback_fun fun, void *data);
 
+/* Like background_callback_add but also sets the priority class. The callback
+ * keeps it for later background_callback_add calls. The priority of a callback
+ * that is already queued is not changed. */
+void background_callback_add_with_priority(background_callback_t *cb, background_callback_fun fun, void *data, background_callback_priority_t priority);
+
 /* Run all background callbacks.  Normally, this is done by the supervisor
  * whenever the list is non-empty */
 void background_callback_run_all(void);
@@ -71,6 +99,23 @@ void background_callback_reset(void);
 void background_callback_prevent(void);
 void background_callback_allow(void);
 
+#if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+/* Run statistics for one callback function, in port_get_cpu_cycles() units.
+ * Latency is the time from being queued to starting to run. The entry with a
+ * NULL fun totals any functions that didn't fit in the table. */
+typedef struct {
+    background_callback_fun fun;
+    uint32_t count;
+    uint32_t max_cycles;
+    uint32_t max_latency;
+    uint64_t total_cycles;
+    uint64_t total_latency;
+} background_callback_stats_t;
+
+/* Returns the number of entries in *stats. They are cleared by background_callback_reset. */
+size_t background_callback_get_stats(const background_callback_stats_t **stats);
+#endif
+
 /*
  * Background callbacks may stop objects from being collected
  */
@@ -10,12 +10,14 @@
 
 #include "extmod/vfs_fat.h"
 
-extern volatile bool filesystem_flush_requested;
-
-void filesystem_background(void);
-void filesystem_tick(void);
+// Flush the cache after CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS unless a flush is already
+// scheduled. Called when the cache first becomes dirty.
+void filesystem_schedule_flush(void);
 bool filesystem_init(bool create_allowed, bool force_create);
 void filesystem_flush(void);
+// Ask background flushes to wait while timing sensitive work is running. Calls must be
+// balanced. A flush is only held off for CIRCUITPY_FILESYSTEM_FLUSH_MAX_DEFERRALS intervals.
+void filesystem_defer_flush(bool defer);
 bool filesystem_present(void);
 void filesystem_set_internal_writable_by_usb(bool usb_writable);
 void filesystem_set_internal_concurrent_write_protection(bool concurrent_write_protection);
@@ -36,6 +38,13 @@ fs_user_mount_t *filesystem_circuitpy(void);
 fs_user_mount_t *filesystem_for_path(const char *path_in, const char **path_under_mount);
 bool filesystem_native_fatfs(fs_user_mount_t *fs_mount);
 
+#if CIRCUITPY_FILESYSTEM_LFS
+// The littlefs object mounted at "/". filesystem_circuitpy() still returns the
+// holder of the CIRCUITPY flags and locks.
+struct _mp_obj_vfs_lfs2_t;
+struct _mp_obj_vfs_lfs2_t *filesystem_circuitpy_lfs(void);
+#endif
+
 // We have two levels of locking. filesystem_* calls grab a shared blockdev lock to allow
 // CircuitPython's fatfs code to edit the blocks. blockdev_* calls grab a lock to mutate blocks
 // directly, excluding any filesystem_* locks.
@@ -26,9 +26,25 @@ mp_uint_t supervisor_flash_write_blocks(const uint8_t *src, uint32_t block_num,
 
 struct _fs_user_mount_t;
 void supervisor_flash_init_vfs(struct _fs_user_mount_t *vfs);
+#if CIRCUITPY_FILESYSTEM_LFS
+// Fills in the littlefs device callbacks and geometry for the CIRCUITPY
+// partition. vfs holds the flags that storage.remount() and the filesystem
+// locks use.
+struct lfs2_config;
+void supervisor_flash_init_lfs(struct lfs2_config *config, struct _fs_user_mount_t *vfs);
+#endif
 void supervisor_flash_flush(void);
+// Writes back at most one cached sector. Returns true if more are dirty.
+bool supervisor_flash_flush_step(void);
 void supervisor_flash_release_cache(void);
 
+#if MICROPY_VFS_XIP
+// Returns the address where the block and the rest of the filesystem can be
+// read directly, or NULL if the flash isn't memory mapped. The default does
+// the latter.
+const uint8_t *supervisor_flash_get_xip_addr(uint32_t block_num);
+#endif
+
 void supervisor_flash_set_extended(bool extended);
 bool supervisor_flash_get_extended(void);
 void supervisor_flash_update_extended(void);
@@ -52,12 +52,21 @@ uint32_t port_get_saved_word(void);
 // tick is 32 subticks (for a resolution of 1/32768 or 30.5ish microseconds.)
 uint64_t port_get_raw_ticks(uint8_t *subticks);
 
+// Get a free running 32-bit CPU cycle count for profiling. The default uses the
+// Cortex-M DWT cycle counter when the core has one and otherwise counts subticks.
+uint32_t port_get_cpu_cycles(void);
+
 // Enable 1/1024 second tick.
 void port_enable_tick(void);
 
 // Disable 1/1024 second tick.
 void port_disable_tick(void);
 
+// Ports that set CIRCUITPY_TICKLESS_DEADLINES call supervisor_deadline_interrupt() from an
+// interrupt at the given raw tick, or as soon as possible if it has already passed. Only the
+// last call to this will apply. It is independent of port_interrupt_after_ticks().
+void port_set_deadline_interrupt(uint64_t tick);
+
 // Wake the CPU after the given number of ticks or sooner. Only the last call to this will apply.
 // Only the common sleep routine should use it.
 void port_interrupt_after_ticks(uint32_t ticks);
@@ -95,6 +104,17 @@ void port_wake_main_task_from_isr(void);
 // CircuitPython task when others are done.
 void port_yield(void);
 
+// Some ports can lend an otherwise idle CPU core to a single worker. Once
+// started, fn(arg) is run on that core after each port_second_core_wake(), and
+// may also be run spuriously. fn must not allocate, raise or otherwise touch the
+// VM. port_second_core_start() returns false if there is no spare core or it is
+// already in use, and port_second_core_stop() returns once any call of fn in
+// progress has finished. A default weak implementation is provided that never
+// starts a worker.
+bool port_second_core_start(void (*fn)(void *arg), void *arg);
+void port_second_core_wake(void);
+void port_second_core_stop(void);
+
 // Some ports need special handling just after completing boot.py execution.
 // This function is called once while boot.py's VM is still valid, and
 // then a second time after the VM is finalized.
@@ -8,6 +8,9 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+
+#include "py/mpconfig.h"
 
 // Ports provide a heap for allocations that live outside the VM. The VM heap
 // is allocated into it in split chunks. The supervisor provides a default heap
@@ -22,8 +25,32 @@ void port_heap_init(void);
 
 void *port_malloc(size_t size, bool dma_capable);
 
+// Allocate only from internal RAM, for memory that is accessed often. Returns
+// NULL when internal RAM is short. The default is the same as port_malloc().
+void *port_malloc_fast(size_t size);
+
 void port_free(void *ptr);
 
 void *port_realloc(void *ptr, size_t size);
 
+// Largest allocation that port_malloc() can currently satisfy. The default heap
+// caches this until the next malloc, free or realloc.
 size_t port_heap_get_largest_free_size(void);
+
+// Whether ptr, from port_malloc(), is in memory that is slower than internal
+// RAM, such as PSRAM. The GC keeps small objects out of heap areas there.
+bool port_heap_is_slow(const void *ptr);
+
+#if CIRCUITPY_PORT_HEAP_STATS
+// Port heap use by one caller of port_malloc() or port_realloc(), identified
+// by its return address. The entry with a NULL owner totals callers that
+// didn't fit in the table. Only the supervisor's default heap keeps these.
+typedef struct {
+    const void *owner;
+    uint32_t allocations;
+    uint32_t bytes;
+    uint32_t peak_bytes;
+} port_heap_stats_t;
+
+size_t port_heap_get_stats(const port_heap_stats_t **stats);
+#endif
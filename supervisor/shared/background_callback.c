@@ -12,9 +12,12 @@
 #include "supervisor/linker.h"
 #include "supervisor/port.h"
 #include "supervisor/shared/tick.h"
+#include "supervisor/shared/trace.h"
 #include "shared-bindings/microcontroller/__init__.h"
 
-static volatile background_callback_t *volatile callback_head, *volatile callback_tail;
+// One queue per priority class, indexed by background_callback_priority_t.
+static volatile background_callback_t *volatile callback_head[BACKGROUND_CALLBACK_PRIORITY_COUNT];
+static volatile background_callback_t *volatile callback_tail[BACKGROUND_CALLBACK_PRIORITY_COUNT];
 
 #ifndef CALLBACK_CRITICAL_BEGIN
 #define CALLBACK_CRITICAL_BEGIN (common_hal_mcu_disable_interrupts())
@@ -26,40 +29,151 @@ static volatile background_callback_t *volatile callback_head, *volatile callbac
 MP_WEAK void PLACE_IN_ITCM(port_wake_main_task)(void) {
 }
 
-void PLACE_IN_ITCM(background_callback_add_core)(background_callback_t * cb) {
+#if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+// Slot CIRCUITPY_BACKGROUND_CALLBACK_STATS_SLOTS collects functions that don't fit.
+static background_callback_stats_t callback_stats[CIRCUITPY_BACKGROUND_CALLBACK_STATS_SLOTS + 1];
+static size_t callback_stats_used;
+
+static void background_callback_record(background_callback_fun fun, uint32_t latency, uint32_t cycles) {
+    background_callback_stats_t *entry = NULL;
+    for (size_t i = 0; i < callback_stats_used; i++) {
+        if (callback_stats[i].fun == fun) {
+            entry = &callback_stats[i];
+            break;
+        }
+    }
+    if (entry == NULL) {
+        if (callback_stats_used < CIRCUITPY_BACKGROUND_CALLBACK_STATS_SLOTS) {
+            entry = &callback_stats[callback_stats_used++];
+            entry->fun = fun;
+        } else {
+            entry = &callback_stats[CIRCUITPY_BACKGROUND_CALLBACK_STATS_SLOTS];
+        }
+    }
+    entry->count++;
+    entry->total_cycles += cycles;
+    entry->total_latency += latency;
+    entry->max_cycles = MAX(entry->max_cycles, cycles);
+    entry->max_latency = MAX(entry->max_latency, latency);
+}
+
+size_t background_callback_get_stats(const background_callback_stats_t **stats) {
+    *stats = callback_stats;
+    if (callback_stats[CIRCUITPY_BACKGROUND_CALLBACK_STATS_SLOTS].count > 0) {
+        return CIRCUITPY_BACKGROUND_CALLBACK_STATS_SLOTS + 1;
+    }
+    return callback_stats_used;
+}
+#endif
+
+static void PLACE_IN_ITCM(background_callback_queue)(background_callback_t * cb, uint8_t priority) {
     CALLBACK_CRITICAL_BEGIN;
-    if (cb->prev || callback_head == cb) {
+    // A queued callback keeps its priority, so its own queue is the only one to check.
+    if (cb->prev || callback_head[cb->priority] == cb) {
         CALLBACK_CRITICAL_END;
         return;
     }
+    cb->priority = priority;
+    #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+    cb->queued_cycles = port_get_cpu_cycles();
+    #endif
     cb->next = 0;
-    cb->prev = (background_callback_t *)callback_tail;
-    if (callback_tail) {
-        callback_tail->next = cb;
+    cb->prev = (background_callback_t *)callback_tail[priority];
+    if (callback_tail[priority]) {
+        callback_tail[priority]->next = cb;
     }
-    if (!callback_head) {
-        callback_head = cb;
+    if (!callback_head[priority]) {
+        callback_head[priority] = cb;
     }
-    callback_tail = cb;
+    callback_tail[priority] = cb;
     CALLBACK_CRITICAL_END;
 
     port_wake_main_task();
 }
 
+void PLACE_IN_ITCM(background_callback_add_core)(background_callback_t * cb) {
+    background_callback_queue(cb, cb->priority);
+}
+
 void PLACE_IN_ITCM(background_callback_add)(background_callback_t * cb, background_callback_fun fun, void *data) {
     cb->fun = fun;
     cb->data = data;
-    background_callback_add_core(cb);
+    background_callback_queue(cb, cb->priority);
+}
+
+void PLACE_IN_ITCM(background_callback_add_with_priority)(background_callback_t * cb, background_callback_fun fun, void *data, background_callback_priority_t priority) {
+    cb->fun = fun;
+    cb->data = data;
+    background_callback_queue(cb, priority);
 }
 
 inline bool background_callback_pending(void) {
-    return callback_head != NULL;
+    for (size_t i = 0; i < BACKGROUND_CALLBACK_PRIORITY_COUNT; i++) {
+        if (callback_head[i] != NULL) {
+            return true;
+        }
+    }
+    return false;
 }
 
 static int background_prevention_count;
 
+// Must be called in the critical section. Returns with it held.
+static background_callback_t *PLACE_IN_ITCM(background_callback_pop)(size_t priority) {
+    background_callback_t *cb = (background_callback_t *)callback_head[priority];
+    callback_head[priority] = cb->next;
+    if (cb->next) {
+        cb->next->prev = NULL;
+    } else {
+        callback_tail[priority] = NULL;
+    }
+    cb->next = cb->prev = NULL;
+    return cb;
+}
+
+// Run callbacks from the given queue until `*last` has run. Callbacks queued
+// while doing so wait for the next run_all. Must be called in the critical
+// section. Returns with it held.
+static void PLACE_IN_ITCM(background_callback_run_one)(size_t priority, background_callback_t **last) {
+    if (!callback_head[priority]) {
+        *last = NULL;
+        return;
+    }
+    background_callback_t *cb = background_callback_pop(priority);
+    if (cb == *last) {
+        *last = NULL;
+    }
+    background_callback_fun fun = cb->fun;
+    void *data = cb->data;
+    #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+    uint32_t queued_cycles = cb->queued_cycles;
+    #endif
+    CALLBACK_CRITICAL_END;
+    // Leave the critical section in order to run the callback function
+    if (fun) {
+        #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+        uint32_t start = port_get_cpu_cycles();
+        fun(data);
+        background_callback_record(fun, start - queued_cycles, port_get_cpu_cycles() - start);
+        #else
+        fun(data);
+        #endif
+    }
+    CALLBACK_CRITICAL_BEGIN;
+}
+
+static void PLACE_IN_ITCM(background_callback_run_realtime)(void) {
+    background_callback_t *last = (background_callback_t *)callback_tail[BACKGROUND_CALLBACK_PRIORITY_REALTIME];
+    while (last) {
+        background_callback_run_one(BACKGROUND_CALLBACK_PRIORITY_REALTIME, &last);
+    }
+}
+
 void PLACE_IN_ITCM(background_callback_run_all)() {
     port_background_task();
+    #if MICROPY_GC_INCREMENTAL_SWEEP
+    gc_sweep_step();
+    #endif
     if (!background_callback_pending()) {
         return;
     }
@@ -69,22 +183,33 @@ void PLACE_IN_ITCM(background_callback_run_all)() {
         return;
     }
     ++background_prevention_count;
-    background_callback_t *cb = (background_callback_t *)callback_head;
-    callback_head = NULL;
-    callback_tail = NULL;
-    while (cb) {
-        background_callback_t *next = cb->next;
-        cb->next = cb->prev = NULL;
-        background_callback_fun fun = cb->fun;
-        void *data = cb->data;
-        CALLBACK_CRITICAL_END;
-        // Leave the critical section in order to run the callback function
-        if (fun) {
-            fun(data);
+    CIRCUITPY_TRACE_BEGIN(TRACE_EVENT_BACKGROUND_CALLBACKS);
+    // Only callbacks queued before now run in this call.
+    background_callback_t *last_normal = (background_callback_t *)callback_tail[BACKGROUND_CALLBACK_PRIORITY_NORMAL];
+    background_callback_t *last_idle = (background_callback_t *)callback_tail[BACKGROUND_CALLBACK_PRIORITY_IDLE];
+    uint64_t idle_deadline = 0;
+    if (last_idle) {
+        idle_deadline = port_get_raw_ticks(NULL) + CIRCUITPY_BACKGROUND_CALLBACK_IDLE_BUDGET_TICKS;
+    }
+
+    // Realtime callbacks run first and again whenever one is queued while
+    // lower priority work is running.
+    background_callback_run_realtime();
+    while (last_normal) {
+        background_callback_run_one(BACKGROUND_CALLBACK_PRIORITY_NORMAL, &last_normal);
+        background_callback_run_realtime();
+    }
+    // Idle work stays queued for a later call once realtime work is waiting or
+    // this call has used up its budget. At least one idle callback runs if
+    // nothing realtime is waiting.
+    while (last_idle && callback_head[BACKGROUND_CALLBACK_PRIORITY_REALTIME] == NULL) {
+        background_callback_run_one(BACKGROUND_CALLBACK_PRIORITY_IDLE, &last_idle);
+        if (port_get_raw_ticks(NULL) >= idle_deadline) {
+            break;
         }
-        CALLBACK_CRITICAL_BEGIN;
-        cb = next;
     }
+    background_callback_run_realtime();
+    CIRCUITPY_TRACE_END(TRACE_EVENT_BACKGROUND_CALLBACKS);
     --background_prevention_count;
     CALLBACK_CRITICAL_END;
 }
@@ -104,34 +229,40 @@ void background_callback_allow() {
 
 // Filter out queued callbacks if they are allocated on the heap.
 void background_callback_reset() {
-    background_callback_t *new_head = NULL;
-    background_callback_t **previous_next = &new_head;
-    background_callback_t *new_tail = NULL;
     CALLBACK_CRITICAL_BEGIN;
-    background_callback_t *cb = (background_callback_t *)callback_head;
-    while (cb) {
-        background_callback_t *next = cb->next;
-        cb->next = NULL;
-        // Unlink any callbacks that are allocated on the python heap or if they
-        // reference data on the python heap. The python heap will be disappear
-        // soon after this.
-        if (gc_ptr_on_heap((void *)cb) || gc_ptr_on_heap(cb->data)) {
-            cb->prev = NULL; // Used to indicate a callback isn't queued.
-        } else {
-            // Set .next of the previous callback.
-            *previous_next = cb;
-            // Set our .next for the next callback.
-            previous_next = &cb->next;
-            // Set our prev to the last callback.
-            cb->prev = new_tail;
-            // Now we're the tail of the list.
-            new_tail = cb;
+    for (size_t i = 0; i < BACKGROUND_CALLBACK_PRIORITY_COUNT; i++) {
+        background_callback_t *new_head = NULL;
+        background_callback_t **previous_next = &new_head;
+        background_callback_t *new_tail = NULL;
+        background_callback_t *cb = (background_callback_t *)callback_head[i];
+        while (cb) {
+            background_callback_t *next = cb->next;
+            cb->next = NULL;
+            // Unlink any callbacks that are allocated on the python heap or if they
+            // reference data on the python heap. The python heap will be disappear
+            // soon after this.
+            if (gc_ptr_on_heap((void *)cb) || gc_ptr_on_heap(cb->data)) {
+                cb->prev = NULL; // Used to indicate a callback isn't queued.
+            } else {
+                // Set .next of the previous callback.
+                *previous_next = cb;
+                // Set our .next for the next callback.
+                previous_next = &cb->next;
+                // Set our prev to the last callback.
+                cb->prev = new_tail;
+                // Now we're the tail of the list.
+                new_tail = cb;
+            }
+            cb = next;
         }
-        cb = next;
+        callback_head[i] = new_head;
+        callback_tail[i] = new_tail;
     }
-    callback_head = new_head;
-    callback_tail = new_tail;
     background_prevention_count = 0;
+    #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+    memset(callback_stats, 0, sizeof(callback_stats));
+    callback_stats_used = 0;
+    #endif
     CALLBACK_CRITICAL_END;
 }
 
@@ -150,9 +281,11 @@ void background_callback_gc_collect(void) {
     // It's necessary to traverse the whole list here, as the callbacks
     // themselves can be in non-gc memory, and some of the cb->data
     // objects themselves might be in non-gc memory.
-    background_callback_t *cb = (background_callback_t *)callback_head;
-    while (cb) {
-        gc_collect_ptr(cb->data);
-        cb = cb->next;
+    for (size_t i = 0; i < BACKGROUND_CALLBACK_PRIORITY_COUNT; i++) {
+        background_callback_t *cb = (background_callback_t *)callback_head[i];
+        while (cb) {
+            gc_collect_ptr(cb->data);
+            cb = cb->next;
+        }
     }
 }
@@ -0,0 +1,67 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "supervisor/shared/boot_timing.h"
+
+#include "py/mphal.h"
+#include "py/mpprint.h"
+#include "supervisor/port.h"
+
+static uint64_t _phase_us[BOOT_PHASE_COUNT];
+// One bit per boot_phase_t.
+static uint32_t _recorded;
+
+static const char *const _phase_names[BOOT_PHASE_COUNT] = {
+    [BOOT_PHASE_PORT_INIT] = "port_init",
+    [BOOT_PHASE_SAFE_MODE_WAIT] = "safe_mode_wait",
+    [BOOT_PHASE_FILESYSTEM_INIT] = "filesystem_init",
+    [BOOT_PHASE_BOARD_INIT] = "board_init",
+    [BOOT_PHASE_BOOT_PY_START] = "boot_py_start",
+    [BOOT_PHASE_BOOT_PY_DONE] = "boot_py_done",
+    [BOOT_PHASE_WORKFLOW_START] = "workflow_start",
+    [BOOT_PHASE_USB_MOUNTED] = "usb_mounted",
+    [BOOT_PHASE_CODE_PY_START] = "code_py_start",
+    [BOOT_PHASE_CODE_PY_COMPILED] = "code_py_compiled",
+};
+
+void supervisor_boot_timing_mark(boot_phase_t phase) {
+    if (_recorded & (1u << phase)) {
+        return;
+    }
+    uint8_t subticks;
+    uint64_t ticks = port_get_raw_ticks(&subticks);
+    // Ticks are 1/1024 s and subticks 1/32768 s.
+    _phase_us[phase] = ((ticks << 5) | subticks) * 1000000 / 32768;
+    _recorded |= 1u << phase;
+}
+
+void supervisor_boot_timing_file_compiled(void) {
+    if (_recorded & (1u << BOOT_PHASE_CODE_PY_START)) {
+        supervisor_boot_timing_mark(BOOT_PHASE_CODE_PY_COMPILED);
+    }
+}
+
+bool supervisor_boot_timing_get(boot_phase_t phase, uint64_t *us) {
+    if (!(_recorded & (1u << phase))) {
+        return false;
+    }
+    *us = _phase_us[phase];
+    return true;
+}
+
+const char *supervisor_boot_timing_phase_name(boot_phase_t phase) {
+    return _phase_names[phase];
+}
+
+void supervisor_boot_timing_print(void) {
+    mp_printf(&mp_plat_print, "Boot timing (us):\n");
+    for (size_t phase = 0; phase < BOOT_PHASE_COUNT; phase++) {
+        uint64_t us;
+        if (supervisor_boot_timing_get(phase, &us)) {
+            mp_printf(&mp_plat_print, "  %s: %u\n", _phase_names[phase], (unsigned int)us);
+        }
+    }
+}
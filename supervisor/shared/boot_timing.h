@@ -0,0 +1,43 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Points during a cold boot, in the order they normally happen.
+typedef enum {
+    BOOT_PHASE_PORT_INIT,
+    BOOT_PHASE_SAFE_MODE_WAIT,
+    BOOT_PHASE_FILESYSTEM_INIT,
+    BOOT_PHASE_BOARD_INIT,
+    BOOT_PHASE_BOOT_PY_START,
+    BOOT_PHASE_BOOT_PY_DONE,
+    BOOT_PHASE_WORKFLOW_START,
+    BOOT_PHASE_USB_MOUNTED,
+    BOOT_PHASE_CODE_PY_START,
+    BOOT_PHASE_CODE_PY_COMPILED,
+    BOOT_PHASE_COUNT,
+} boot_phase_t;
+
+// Record the time that `phase` completed. Only the first call for each phase
+// counts, so soft reloads don't overwrite the cold boot numbers.
+void supervisor_boot_timing_mark(boot_phase_t phase);
+
+// Called once a Python source file has been compiled. Marks
+// BOOT_PHASE_CODE_PY_COMPILED if code.py is the file being started.
+void supervisor_boot_timing_file_compiled(void);
+
+// Get the time of `phase` in microseconds since the tick counter started,
+// which is normally at reset. Returns false if it hasn't happened.
+bool supervisor_boot_timing_get(boot_phase_t phase, uint64_t *us);
+
+// Short name of `phase`, such as "boot_py_start".
+const char *supervisor_boot_timing_phase_name(boot_phase_t phase);
+
+// Print the recorded phases to the console.
+void supervisor_boot_timing_print(void);
@@ -0,0 +1,176 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "supervisor/shared/code_cache.h"
+
+#include "extmod/vfs.h"
+#include "genhdr/mpversion.h"
+#include "py/compile.h"
+#include "py/emitglue.h"
+#include "py/lexer.h"
+#include "py/parse.h"
+#include "py/persistentcode.h"
+#include "py/reader.h"
+#include "py/runtime.h"
+#include "py/stream.h"
+
+#if !MICROPY_PERSISTENT_CODE_SAVE
+#error CIRCUITPY_CODE_CACHE requires MICROPY_PERSISTENT_CODE_SAVE
+#endif
+
+// Written ahead of the .mpy data in each cache file.
+typedef struct {
+    char magic[4];
+    uint32_t source_size;
+    uint32_t source_hash;
+    uint32_t firmware_hash;
+} code_cache_header_t;
+
+static const char code_cache_magic[4] = {'C', 'P', 'C', 'C'};
+
+#define FNV_OFFSET_BASIS (2166136261u)
+
+static uint32_t fnv1a(uint32_t hash, const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static mp_obj_t open_file(const char *filename, const char *mode) {
+    mp_obj_t args[2] = {
+        mp_obj_new_str(filename, strlen(filename)),
+        mp_obj_new_str(mode, strlen(mode)),
+    };
+    return mp_vfs_open(MP_ARRAY_SIZE(args), args, (mp_map_t *)&mp_const_empty_map);
+}
+
+// Hash the source itself: FAT timestamps only have two second resolution,
+// which is too coarse to notice a quick save from an editor.
+static bool hash_source(const char *filename, code_cache_header_t *header) {
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) != 0) {
+        return false;
+    }
+    mp_obj_t file = open_file(filename, "rb");
+    uint8_t buf[128];
+    uint32_t hash = FNV_OFFSET_BASIS;
+    size_t total = 0;
+    int errcode;
+    while (true) {
+        mp_uint_t n = mp_stream_rw(file, buf, sizeof(buf), &errcode, MP_STREAM_RW_READ | MP_STREAM_RW_ONCE);
+        if (n == 0 || errcode != 0) {
+            break;
+        }
+        hash = fnv1a(hash, buf, n);
+        total += n;
+    }
+    mp_stream_close(file);
+    nlr_pop();
+    if (errcode != 0) {
+        return false;
+    }
+    header->source_size = total;
+    header->source_hash = hash;
+    return true;
+}
+
+// "dir/code.py" is cached in "dir/.code.py.mpc".
+static void cache_filename(const char *filename, char *out, size_t out_len) {
+    const char *base = strrchr(filename, '/');
+    size_t dir_len = base == NULL ? 0 : (size_t)(base - filename) + 1;
+    snprintf(out, out_len, "%.*s.%s.mpc", (int)dir_len, filename, filename + dir_len);
+}
+
+static bool header_matches(mp_reader_t *reader, const code_cache_header_t *expected) {
+    code_cache_header_t header;
+    uint8_t *p = (uint8_t *)&header;
+    for (size_t i = 0; i < sizeof(header); i++) {
+        mp_uint_t b = reader->readbyte(reader->data);
+        if (b == MP_READER_EOF) {
+            return false;
+        }
+        p[i] = b;
+    }
+    return memcmp(&header, expected, sizeof(header)) == 0;
+}
+
+static bool load_cached(const char *cache_name, const code_cache_header_t *expected, mp_compiled_module_t *cm) {
+    if (mp_import_stat(cache_name) != MP_IMPORT_STAT_FILE) {
+        return false;
+    }
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) != 0) {
+        // A truncated or incompatible cache file is simply rebuilt.
+        return false;
+    }
+    mp_reader_t reader;
+    mp_reader_new_file(&reader, cache_name);
+    if (!header_matches(&reader, expected)) {
+        reader.close(reader.data);
+        nlr_pop();
+        return false;
+    }
+    // Closes the reader.
+    mp_raw_code_load(&reader, cm);
+    nlr_pop();
+    return true;
+}
+
+static void cache_print_strn(void *env, const char *str, size_t len) {
+    int errcode;
+    mp_stream_rw(MP_OBJ_FROM_PTR(env), (void *)str, len, &errcode, MP_STREAM_RW_WRITE);
+    if (errcode != 0) {
+        // Abandon the save. The partial file fails to load and gets rebuilt.
+        mp_raise_OSError(errcode);
+    }
+}
+
+static void save_cached(const char *cache_name, const code_cache_header_t *header, mp_compiled_module_t *cm) {
+    mp_obj_t file = MP_OBJ_NULL;
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        // This fails if the filesystem is read-only to us, for example while
+        // the host has it mounted over USB. The cache is then written next time.
+        file = open_file(cache_name, "wb");
+        mp_print_t print = {MP_OBJ_TO_PTR(file), cache_print_strn};
+        print.print_strn(print.data, (const char *)header, sizeof(*header));
+        mp_raw_code_save(cm, &print);
+        mp_stream_close(file);
+        nlr_pop();
+    } else if (file != MP_OBJ_NULL) {
+        mp_stream_close(file);
+    }
+}
+
+mp_obj_t supervisor_code_cache_load(const char *filename) {
+    mp_compiled_module_t cm;
+    cm.context = m_new_obj(mp_module_context_t);
+    cm.context->module.globals = mp_globals_get();
+
+    code_cache_header_t header;
+    memcpy(header.magic, code_cache_magic, sizeof(header.magic));
+    header.firmware_hash = fnv1a(FNV_OFFSET_BASIS,
+        (const uint8_t *)MICROPY_GIT_HASH MICROPY_BUILD_DATE, strlen(MICROPY_GIT_HASH MICROPY_BUILD_DATE));
+    bool cacheable = hash_source(filename, &header);
+
+    char cache_name[MICROPY_ALLOC_PATH_MAX];
+    cache_filename(filename, cache_name, sizeof(cache_name));
+
+    if (!cacheable || !load_cached(cache_name, &header, &cm)) {
+        mp_lexer_t *lex = mp_lexer_new_from_file(filename);
+        qstr source_name = lex->source_name;
+        mp_parse_tree_t parse_tree = mp_parse(lex, MP_PARSE_FILE_INPUT);
+        mp_compile_to_raw_code(&parse_tree, source_name, false, &cm);
+        if (cacheable) {
+            save_cached(cache_name, &header, &cm);
+        }
+    }
+
+    return mp_make_function_from_raw_code(cm.rc, cm.context, NULL);
+}
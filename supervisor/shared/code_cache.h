@@ -0,0 +1,15 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+
+// Return the module function for the Python source file `filename`.
+// The compiled bytecode is kept in a hidden file next to the source,
+// keyed by the source's size and contents and by the firmware build,
+// so unchanged files skip the lexer, parser and compiler on later runs.
+mp_obj_t supervisor_code_cache_load(const char *filename);
@@ -22,24 +22,35 @@
 
 #define NO_SECTOR_LOADED 0xFFFFFFFF
 
-// The currently cached sector in the cache, ram or flash based.
-static uint32_t current_sector;
-
 static const external_flash_device possible_devices[] = {EXTERNAL_FLASH_DEVICES};
 #define EXTERNAL_FLASH_DEVICE_COUNT MP_ARRAY_SIZE(possible_devices)
 
 static const external_flash_device *flash_device = NULL;
 
-// Track which blocks (up to 32) in the current sector currently live in the
-// cache.
-static uint32_t dirty_mask;
-
-// Table of pointers to each cached block. Should be zero'd after allocation.
 #define BLOCKS_PER_SECTOR (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE)
 #define PAGES_PER_BLOCK (FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE)
 #define FLASH_CACHE_TABLE_NUM_ENTRIES (BLOCKS_PER_SECTOR * PAGES_PER_BLOCK)
 #define FLASH_CACHE_TABLE_SIZE (FLASH_CACHE_TABLE_NUM_ENTRIES * sizeof (uint8_t *))
-static uint8_t **flash_cache_table = NULL;
+
+// Write-back cache of up to CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS erase
+// sectors. FAT writes bounce between the FAT, the directory entry and the data,
+// so holding several sectors saves an erase cycle for each bounce. An entry
+// normally keeps its blocks in ram. If ram can't be had at all, a single entry
+// keeps them in the scratch sector at the end of the flash instead.
+typedef struct {
+    // The cached sector, or NO_SECTOR_LOADED.
+    uint32_t sector;
+    // Which blocks (up to 32) of the sector currently live in the cache.
+    uint32_t dirty_mask;
+    // For least recently used eviction.
+    uint32_t last_used;
+    // Table of pointers to each cached page, NULL when the entry is backed by
+    // the scratch sector. Should be zero'd after allocation.
+    uint8_t **table;
+} flash_cache_entry_t;
+
+static flash_cache_entry_t flash_cache[CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS];
+static uint32_t flash_cache_use_count;
 
 // Wait until both the write enable and write in progress bits have cleared.
 static bool wait_for_flash_ready(void) {
@@ -135,7 +146,7 @@ static bool page_erased(uint32_t sector_address) {
     uint8_t full_buffer[FILESYSTEM_BLOCK_SIZE];
     if (read_flash(sector_address, full_buffer, FILESYSTEM_BLOCK_SIZE)) {
         for (uint16_t i = 0; i < FILESYSTEM_BLOCK_SIZE; i++) {
-            if (short_buffer[i] != 0xff) {
+            if (full_buffer[i] != 0xff) {
                 return false;
             }
         }
@@ -277,9 +288,11 @@ void supervisor_flash_init(void) {
 
     wait_for_flash_ready();
 
-    current_sector = NO_SECTOR_LOADED;
-    dirty_mask = 0;
-    flash_cache_table = NULL;
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        flash_cache[i].sector = NO_SECTOR_LOADED;
+        flash_cache[i].dirty_mask = 0;
+        flash_cache[i].table = NULL;
+    }
 }
 
 // The size of each individual block.
@@ -299,18 +312,15 @@ uint32_t supervisor_flash_get_block_count(void) {
 
 // Flush the cache that was written to the scratch portion of flash. Only used
 // when ram is tight.
-static bool flush_scratch_flash(void) {
-    if (current_sector == NO_SECTOR_LOADED) {
-        return true;
-    }
+static bool flush_scratch_flash(flash_cache_entry_t *entry) {
     // First, copy out any blocks that we haven't touched from the sector we've
     // cached.
     bool copy_to_scratch_ok = true;
     uint32_t scratch_sector = flash_device->total_size - SPI_FLASH_ERASE_SIZE;
     for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
-        if ((dirty_mask & (1 << i)) == 0) {
+        if ((entry->dirty_mask & (1 << i)) == 0) {
             copy_to_scratch_ok = copy_to_scratch_ok &&
-                copy_block(current_sector + i * FILESYSTEM_BLOCK_SIZE,
+                copy_block(entry->sector + i * FILESYSTEM_BLOCK_SIZE,
                 scratch_sector + i * FILESYSTEM_BLOCK_SIZE);
         }
     }
@@ -320,44 +330,45 @@ static bool flush_scratch_flash(void) {
         return false;
     }
     // Second, erase the current sector.
-    erase_sector(current_sector);
+    erase_sector(entry->sector);
     // Finally, copy the new version into it.
     for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
         copy_block(scratch_sector + i * FILESYSTEM_BLOCK_SIZE,
-            current_sector + i * FILESYSTEM_BLOCK_SIZE);
+            entry->sector + i * FILESYSTEM_BLOCK_SIZE);
     }
     return true;
 }
 
-// Free all entries in the partially or completely filled flash_cache_table, and then free the table itself.
-static void release_ram_cache(void) {
-    if (flash_cache_table == NULL) {
+// Free all entries in the partially or completely filled table, and then free the table itself.
+static void release_ram_cache(flash_cache_entry_t *entry) {
+    uint8_t **table = entry->table;
+    if (table == NULL) {
         return;
     }
 
     for (size_t i = 0; i < FLASH_CACHE_TABLE_NUM_ENTRIES; i++) {
         // Table may not be completely full. Stop at first NULL entry.
-        if (flash_cache_table[i] == NULL) {
+        if (table[i] == NULL) {
             break;
         }
-        port_free(flash_cache_table[i]);
+        port_free(table[i]);
     }
-    port_free(flash_cache_table);
-    flash_cache_table = NULL;
+    port_free(table);
+    entry->table = NULL;
 }
 
 // Attempts to allocate a new set of page buffers for caching a full sector in
 // ram. Each page is allocated separately so that the GC doesn't need to provide
 // one huge block. We can free it as we write if we want to also.
-static bool allocate_ram_cache(void) {
-    flash_cache_table = port_malloc(FLASH_CACHE_TABLE_SIZE, false);
-    if (flash_cache_table == NULL) {
+static bool allocate_ram_cache(flash_cache_entry_t *entry) {
+    entry->table = port_malloc(FLASH_CACHE_TABLE_SIZE, false);
+    if (entry->table == NULL) {
         // Not enough space even for the cache table.
         return false;
     }
 
     // Clear all the entries so it's easy to find the last entry.
-    memset(flash_cache_table, 0, FLASH_CACHE_TABLE_SIZE);
+    memset(entry->table, 0, FLASH_CACHE_TABLE_SIZE);
 
     bool success = true;
     for (size_t i = 0; i < BLOCKS_PER_SECTOR && success; i++) {
@@ -367,41 +378,67 @@ static bool allocate_ram_cache(void) {
                 success = false;
                 break;
             }
-            flash_cache_table[i * PAGES_PER_BLOCK + j] = page_cache;
+            entry->table[i * PAGES_PER_BLOCK + j] = page_cache;
         }
     }
 
     // We couldn't allocate enough so give back what we got.
     if (!success) {
-        release_ram_cache();
+        release_ram_cache(entry);
     }
     return success;
 }
 
-// Flush the cached sector from ram onto the flash. We'll free the cache unless
-// keep_cache is true.
-static bool flush_ram_cache(bool keep_cache) {
-    if (flash_cache_table == NULL) {
-        // Nothing to flush because there is no cache.
-        return true;
+// Flush the cached sector from ram onto the flash.
+static bool flush_ram_cache(flash_cache_entry_t *entry) {
+    uint8_t **table = entry->table;
+    // Programming can only clear bits. If no cached page needs a bit set that
+    // is clear in flash (appending to a file's last block usually only fills
+    // in erased bytes), program the changed pages in place and skip the erase.
+    bool needs_erase = false;
+    uint32_t changed_pages = 0;
+    uint8_t flash_page[SPI_FLASH_PAGE_SIZE];
+    for (size_t i = 0; i < BLOCKS_PER_SECTOR && !needs_erase; i++) {
+        if ((entry->dirty_mask & (1 << i)) == 0) {
+            continue;
+        }
+        for (size_t j = 0; j < PAGES_PER_BLOCK && !needs_erase; j++) {
+            size_t page = i * PAGES_PER_BLOCK + j;
+            if (!read_flash(entry->sector + page * SPI_FLASH_PAGE_SIZE, flash_page, SPI_FLASH_PAGE_SIZE)) {
+                return false;
+            }
+            for (size_t k = 0; k < SPI_FLASH_PAGE_SIZE; k++) {
+                if (table[page][k] == flash_page[k]) {
+                    continue;
+                }
+                changed_pages |= 1 << page;
+                // Devices without an erase command can be rewritten freely.
+                if ((table[page][k] & ~flash_page[k]) != 0 && !flash_device->no_erase_cmd) {
+                    needs_erase = true;
+                    break;
+                }
+            }
+        }
     }
-
-    if (current_sector == NO_SECTOR_LOADED) {
-        if (!keep_cache) {
-            release_ram_cache();
+    if (!needs_erase) {
+        for (size_t page = 0; page < FLASH_CACHE_TABLE_NUM_ENTRIES; page++) {
+            if ((changed_pages & (1 << page)) != 0) {
+                write_flash(entry->sector + page * SPI_FLASH_PAGE_SIZE, table[page], SPI_FLASH_PAGE_SIZE);
+            }
         }
         return true;
     }
+
     // First, copy out any blocks that we haven't touched from the sector
     // we've cached. If we don't do this we'll erase the data during the sector
     // erase below.
     bool copy_to_ram_ok = true;
     for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
-        if ((dirty_mask & (1 << i)) == 0) {
+        if ((entry->dirty_mask & (1 << i)) == 0) {
             for (size_t j = 0; j < PAGES_PER_BLOCK; j++) {
                 copy_to_ram_ok = read_flash(
-                    current_sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
-                    flash_cache_table[i * PAGES_PER_BLOCK + j],
+                    entry->sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
+                    table[i * PAGES_PER_BLOCK + j],
                     SPI_FLASH_PAGE_SIZE);
                 if (!copy_to_ram_ok) {
                     break;
@@ -417,35 +454,45 @@ static bool flush_ram_cache(bool keep_cache) {
         return false;
     }
     // Second, erase the current sector.
-    erase_sector(current_sector);
+    erase_sector(entry->sector);
     // Lastly, write all the data in ram that we've cached.
     for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
         for (size_t j = 0; j < PAGES_PER_BLOCK; j++) {
-            write_flash(current_sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
-                flash_cache_table[i * PAGES_PER_BLOCK + j],
+            write_flash(entry->sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
+                table[i * PAGES_PER_BLOCK + j],
                 SPI_FLASH_PAGE_SIZE);
         }
     }
-    // We're done with the cache for now so give it back.
-    if (!keep_cache) {
-        release_ram_cache();
-    }
     return true;
 }
 
-// Delegates to the correct flash flush method depending on the existing cache.
+// Write one cached sector back to the flash, from ram or from the scratch
+// sector. The entry is left empty but keeps its ram for reuse.
+static void flush_cache_entry(flash_cache_entry_t *entry) {
+    if (entry->sector == NO_SECTOR_LOADED) {
+        return;
+    }
+    if (entry->table == NULL) {
+        flush_scratch_flash(entry);
+    } else {
+        flush_ram_cache(entry);
+    }
+    entry->sector = NO_SECTOR_LOADED;
+    entry->dirty_mask = 0;
+}
+
+// Flush every cached sector. We'll free the ram unless keep_cache is true.
 // TODO Don't blink the status indicator if we don't actually do any writing (hard to tell right now).
 static void spi_flash_flush_keep_cache(bool keep_cache) {
     #ifdef MICROPY_HW_LED_MSC
     port_pin_set_output_level(MICROPY_HW_LED_MSC, true);
     #endif
-    // If we've cached to the flash itself flush from there.
-    if (flash_cache_table == NULL) {
-        flush_scratch_flash();
-    } else {
-        flush_ram_cache(keep_cache);
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        flush_cache_entry(&flash_cache[i]);
+        if (!keep_cache) {
+            release_ram_cache(&flash_cache[i]);
+        }
     }
-    current_sector = NO_SECTOR_LOADED;
     #ifdef MICROPY_HW_LED_MSC
     port_pin_set_output_level(MICROPY_HW_LED_MSC, false);
     #endif
@@ -455,10 +502,95 @@ void supervisor_external_flash_flush(void) {
     spi_flash_flush_keep_cache(true);
 }
 
+// Write back only the least recently used dirty sector, so that the sectors
+// still being written to collect more writes first. Returns true if there are
+// more to do.
+bool supervisor_external_flash_flush_step(void) {
+    flash_cache_entry_t *oldest = NULL;
+    size_t dirty = 0;
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        flash_cache_entry_t *e = &flash_cache[i];
+        if (e->sector == NO_SECTOR_LOADED || e->dirty_mask == 0) {
+            continue;
+        }
+        dirty++;
+        if (oldest == NULL || e->last_used < oldest->last_used) {
+            oldest = e;
+        }
+    }
+    if (oldest == NULL) {
+        return false;
+    }
+    #ifdef MICROPY_HW_LED_MSC
+    port_pin_set_output_level(MICROPY_HW_LED_MSC, true);
+    #endif
+    flush_cache_entry(oldest);
+    #ifdef MICROPY_HW_LED_MSC
+    port_pin_set_output_level(MICROPY_HW_LED_MSC, false);
+    #endif
+    return dirty > 1;
+}
+
 void supervisor_flash_release_cache(void) {
     spi_flash_flush_keep_cache(false);
 }
 
+static flash_cache_entry_t *find_cache_entry(uint32_t sector) {
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        if (flash_cache[i].sector == sector) {
+            return &flash_cache[i];
+        }
+    }
+    return NULL;
+}
+
+// Find room to cache another sector: an empty entry that already has ram, then
+// an empty entry we can get ram for, then the least recently used entry in ram.
+// Only when there's no ram at all do we fall back to the scratch sector, which
+// can hold a single sector.
+static flash_cache_entry_t *claim_cache_entry(uint32_t sector) {
+    flash_cache_entry_t *empty = NULL;
+    flash_cache_entry_t *lru = NULL;
+    flash_cache_entry_t *scratch = NULL;
+    flash_cache_entry_t *entry = NULL;
+    for (size_t i = 0; i < CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS; i++) {
+        flash_cache_entry_t *e = &flash_cache[i];
+        if (e->sector == NO_SECTOR_LOADED) {
+            if (e->table != NULL) {
+                entry = e;
+                break;
+            }
+            if (empty == NULL) {
+                empty = e;
+            }
+        } else if (e->table == NULL) {
+            scratch = e;
+        } else if (lru == NULL || e->last_used < lru->last_used) {
+            lru = e;
+        }
+    }
+    if (entry == NULL && empty != NULL && allocate_ram_cache(empty)) {
+        entry = empty;
+    }
+    if (entry == NULL && lru != NULL) {
+        flush_cache_entry(lru);
+        entry = lru;
+    }
+    if (entry == NULL) {
+        if (scratch != NULL) {
+            flush_cache_entry(scratch);
+            entry = scratch;
+        } else {
+            entry = empty;
+        }
+        erase_sector(flash_device->total_size - SPI_FLASH_ERASE_SIZE);
+        wait_for_flash_ready();
+    }
+    entry->sector = sector;
+    entry->dirty_mask = 0;
+    return entry;
+}
+
 static int32_t convert_block_to_flash_addr(uint32_t block) {
     if (0 <= block && block < supervisor_flash_get_block_count()) {
         // a block in partition 1
@@ -479,12 +611,13 @@ static bool external_flash_read_block(uint8_t *dest, uint32_t block) {
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     size_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
     uint32_t mask = 1 << (block_index);
-    // We're reading from the currently cached sector.
-    if (current_sector == this_sector && (mask & dirty_mask) > 0) {
-        if (flash_cache_table != NULL) {
+    // We're reading from a cached sector.
+    flash_cache_entry_t *entry = find_cache_entry(this_sector);
+    if (entry != NULL && (mask & entry->dirty_mask) > 0) {
+        if (entry->table != NULL) {
             for (int i = 0; i < PAGES_PER_BLOCK; i++) {
                 memcpy(dest + i * SPI_FLASH_PAGE_SIZE,
-                    flash_cache_table[block_index * PAGES_PER_BLOCK + i],
+                    entry->table[block_index * PAGES_PER_BLOCK + i],
                     SPI_FLASH_PAGE_SIZE);
             }
             return true;
@@ -509,29 +642,27 @@ static bool external_flash_write_block(const uint8_t *data, uint32_t block) {
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     size_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
     uint32_t mask = 1 << (block_index);
-    // Flush the cache if we're moving onto a sector or we're writing the
-    // same block again.
-    if (current_sector != this_sector || (mask & dirty_mask) > 0) {
+    flash_cache_entry_t *entry = find_cache_entry(this_sector);
+    // A block held in the scratch sector can't be overwritten in place, so
+    // write that sector back and start over.
+    if (entry != NULL && entry->table == NULL && (mask & entry->dirty_mask) > 0) {
+        flush_cache_entry(entry);
+        entry = NULL;
+    }
+    if (entry == NULL) {
         // Check to see if we'd write to an erased page. In that case we
         // can write directly.
         if (page_erased(address)) {
             return write_flash(address, data, FILESYSTEM_BLOCK_SIZE);
         }
-        if (current_sector != NO_SECTOR_LOADED) {
-            supervisor_flash_flush();
-        }
-        if (flash_cache_table == NULL && !allocate_ram_cache()) {
-            erase_sector(flash_device->total_size - SPI_FLASH_ERASE_SIZE);
-            wait_for_flash_ready();
-        }
-        current_sector = this_sector;
-        dirty_mask = 0;
+        entry = claim_cache_entry(this_sector);
     }
-    dirty_mask |= mask;
+    entry->dirty_mask |= mask;
+    entry->last_used = ++flash_cache_use_count;
     // Copy the block to the appropriate cache.
-    if (flash_cache_table != NULL) {
+    if (entry->table != NULL) {
         for (int i = 0; i < PAGES_PER_BLOCK; i++) {
-            memcpy(flash_cache_table[block_index * PAGES_PER_BLOCK + i],
+            memcpy(entry->table[block_index * PAGES_PER_BLOCK + i],
                 data + i * SPI_FLASH_PAGE_SIZE,
                 SPI_FLASH_PAGE_SIZE);
         }
@@ -542,11 +673,40 @@ static bool external_flash_write_block(const uint8_t *data, uint32_t block) {
     }
 }
 
+// True if the block can be read straight from the flash: it is valid and
+// doesn't have newer data waiting in the cache.
+static bool block_readable_from_flash(uint32_t block) {
+    int32_t address = convert_block_to_flash_addr(block);
+    if (address == -1) {
+        return false;
+    }
+    uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
+    size_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
+    flash_cache_entry_t *entry = find_cache_entry(this_sector);
+    return entry == NULL || (entry->dirty_mask & (1 << block_index)) == 0;
+}
+
 mp_uint_t supervisor_flash_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
-    for (size_t i = 0; i < num_blocks; i++) {
+    size_t i = 0;
+    while (i < num_blocks) {
+        // Read each run of uncached blocks with a single command so the
+        // command and address overhead is paid once per run, not per block.
+        size_t run = 0;
+        while (i + run < num_blocks && block_readable_from_flash(block_num + i + run)) {
+            run++;
+        }
+        if (run > 0) {
+            if (!read_flash(convert_block_to_flash_addr(block_num + i), dest + i * FILESYSTEM_BLOCK_SIZE,
+                run * FILESYSTEM_BLOCK_SIZE)) {
+                return 1; // error
+            }
+            i += run;
+            continue;
+        }
         if (!external_flash_read_block(dest + i * FILESYSTEM_BLOCK_SIZE, block_num + i)) {
             return 1; // error
         }
+        i++;
     }
     return 0; // success
 }
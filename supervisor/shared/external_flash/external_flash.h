@@ -20,11 +20,18 @@
 #define SPI_FLASH_SYSTICK_MASK    (0x1ff) // 512ms
 #define SPI_FLASH_IDLE_TICK(tick) (((tick) & SPI_FLASH_SYSTICK_MASK) == 2)
 
+// Number of erase sectors held in the write-back cache. Each one takes
+// SPI_FLASH_ERASE_SIZE of ram, allocated only when a write needs it.
+#ifndef CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS
+#define CIRCUITPY_EXTERNAL_FLASH_CACHE_SECTORS (4)
+#endif
+
 #ifndef SPI_FLASH_MAX_BAUDRATE
 #define SPI_FLASH_MAX_BAUDRATE 8000000
 #endif
 
 void supervisor_external_flash_flush(void);
+bool supervisor_external_flash_flush_step(void);
 
 // Configure anything that needs to get set up before the external flash
 // is init'ed. For example, if GPIO needs to be configured to enable the
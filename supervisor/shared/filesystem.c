@@ -6,44 +6,172 @@
 
 #include "supervisor/filesystem.h"
 
+#include <string.h>
+
 #include "extmod/vfs_fat.h"
+#if CIRCUITPY_FILESYSTEM_LFS
+#include "extmod/vfs_lfs.h"
+#endif
 #include "lib/oofatfs/ff.h"
 #include "lib/oofatfs/diskio.h"
 
 #include "py/mpstate.h"
 
+#include "supervisor/background_callback.h"
 #include "supervisor/flash.h"
 #include "supervisor/linker.h"
+#include "supervisor/port.h"
+#include "supervisor/shared/tick.h"
 
 static mp_vfs_mount_t _mp_vfs;
 static fs_user_mount_t _internal_vfs;
 
-static volatile uint32_t filesystem_flush_interval_ms = CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS;
-volatile bool filesystem_flush_requested = false;
+#if CIRCUITPY_FILESYSTEM_LFS
+// CIRCUITPY is mounted before the VM heap exists, so littlefs gets static buffers.
+static mp_obj_vfs_lfs2_t _internal_lfs;
+static uint8_t _lfs_read_buffer[FILESYSTEM_BLOCK_SIZE];
+static uint8_t _lfs_prog_buffer[FILESYSTEM_BLOCK_SIZE];
+static uint8_t _lfs_lookahead_buffer[CIRCUITPY_FILESYSTEM_LFS_LOOKAHEAD];
+static char _lfs_cur_dir[MICROPY_ALLOC_PATH_MAX];
+#endif
 
-void filesystem_background(void) {
-    if (filesystem_flush_requested) {
-        filesystem_flush_interval_ms = CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS;
-        // Flush but keep caches
-        supervisor_flash_flush();
-        filesystem_flush_requested = false;
+// The cache is flushed a while after it first gets dirty, one sector per
+// background run so that a large dirty cache doesn't stall everything else.
+static supervisor_deadline_t filesystem_flush_deadline;
+static background_callback_t filesystem_flush_callback;
+// Number of timing sensitive activities (such as audio playback) asking us to
+// hold off on background flushes, and how many intervals we've held off for.
+static volatile uint8_t filesystem_flush_defer_count = 0;
+static volatile uint8_t filesystem_flush_deferred_intervals = 0;
+
+#define FILESYSTEM_FLUSH_INTERVAL_TICKS ((CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS * 1024) / 1000)
+
+static void filesystem_flush_due(void *unused);
+
+static void filesystem_background_flush(void *unused) {
+    if (filesystem_flush_defer_count > 0 &&
+        filesystem_flush_deferred_intervals < CIRCUITPY_FILESYSTEM_FLUSH_MAX_DEFERRALS) {
+        filesystem_flush_deferred_intervals++;
+        supervisor_deadline_schedule(&filesystem_flush_deadline,
+            port_get_raw_ticks(NULL) + FILESYSTEM_FLUSH_INTERVAL_TICKS, filesystem_flush_due, NULL);
+        return;
     }
+    // Caches are kept.
+    if (supervisor_flash_flush_step()) {
+        // Come back on the next tick for the next sector.
+        supervisor_deadline_schedule(&filesystem_flush_deadline,
+            port_get_raw_ticks(NULL) + 1, filesystem_flush_due, NULL);
+        return;
+    }
+    filesystem_flush_deferred_intervals = 0;
 }
 
-inline void filesystem_tick(void) {
-    if (filesystem_flush_interval_ms == 0) {
-        // 0 means not turned on.
-        return;
+// Called from interrupt context, so hand off to the background.
+static void filesystem_flush_due(void *unused) {
+    background_callback_add(&filesystem_flush_callback, filesystem_background_flush, NULL);
+}
+
+void filesystem_schedule_flush(void) {
+    #if CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS > 0
+    if (!filesystem_flush_deadline.queued) {
+        supervisor_deadline_schedule(&filesystem_flush_deadline,
+            port_get_raw_ticks(NULL) + FILESYSTEM_FLUSH_INTERVAL_TICKS, filesystem_flush_due, NULL);
     }
-    if (filesystem_flush_interval_ms == 1) {
-        filesystem_flush_requested = true;
-        filesystem_flush_interval_ms = CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS;
-    } else {
-        filesystem_flush_interval_ms--;
+    #endif
+}
+
+void filesystem_defer_flush(bool defer) {
+    if (defer) {
+        filesystem_flush_defer_count++;
+    } else if (filesystem_flush_defer_count > 0) {
+        filesystem_flush_defer_count--;
     }
 }
 
 
+#if CIRCUITPY_FILESYSTEM_LFS
+#if CIRCUITPY_FULL_BUILD
+#define LFS_FILE_CONTENTS(string_literal) string_literal
+#else
+#define LFS_FILE_CONTENTS(string_literal) ""
+#endif
+
+static void lfs_make_file_with_contents(lfs2_t *lfs, const char *filename, const char *content) {
+    uint8_t file_buffer[FILESYSTEM_BLOCK_SIZE];
+    struct lfs2_file_config cfg = { .buffer = file_buffer };
+    lfs2_file_t file;
+    if (lfs2_file_opencfg(lfs, &file, filename, LFS2_O_WRONLY | LFS2_O_CREAT | LFS2_O_TRUNC, &cfg) < 0) {
+        return;
+    }
+    lfs2_file_write(lfs, &file, content, strlen(content));
+    lfs2_file_close(lfs, &file);
+}
+
+static bool filesystem_init_lfs(bool create_allowed, bool force_create) {
+    // The Python-visible flags live in _internal_vfs so that storage.remount()
+    // and the filesystem locks work the same as with FAT.
+    fs_user_mount_t *vfs_flags = &_internal_vfs;
+    vfs_flags->blockdev.flags = 0;
+
+    mp_obj_vfs_lfs2_t *self = &_internal_lfs;
+    struct lfs2_config *config = &self->config;
+    memset(self, 0, sizeof(*self));
+    self->base.type = &mp_type_vfs_lfs2;
+    vstr_init_fixed_buf(&self->cur_dir, sizeof(_lfs_cur_dir), _lfs_cur_dir);
+    vstr_add_byte(&self->cur_dir, '/');
+
+    supervisor_flash_init_lfs(config, vfs_flags);
+    // Workflows edit CIRCUITPY through oofatfs, so don't let them think it's FAT.
+    vfs_flags->base.type = &mp_type_vfs_lfs2;
+    config->read_buffer = _lfs_read_buffer;
+    config->prog_buffer = _lfs_prog_buffer;
+    config->lookahead_size = sizeof(_lfs_lookahead_buffer);
+    config->lookahead_buffer = _lfs_lookahead_buffer;
+
+    lfs2_t *lfs = &self->lfs;
+    int res = lfs2_mount(lfs, config);
+    if ((res == LFS2_ERR_CORRUPT && create_allowed) || force_create) {
+        if (res == LFS2_ERR_OK) {
+            lfs2_unmount(lfs);
+        }
+        if (lfs2_format(lfs, config) < 0 || lfs2_mount(lfs, config) < 0) {
+            return false;
+        }
+
+        #if CIRCUITPY_SDCARDIO || CIRCUITPY_SDIOIO
+        lfs2_mkdir(lfs, "/sd");
+        lfs_make_file_with_contents(lfs, "/sd/placeholder.txt",
+            LFS_FILE_CONTENTS("SD cards mounted at /sd will hide this file from Python.\n"));
+        #endif
+
+        #if CIRCUITPY_OS_GETENV
+        lfs_make_file_with_contents(lfs, "/settings.toml", "");
+        #endif
+        // make a sample code.py file
+        lfs_make_file_with_contents(lfs, "/code.py", LFS_FILE_CONTENTS("print(\"Hello World!\")\n"));
+
+        // create empty lib directory
+        if (lfs2_mkdir(lfs, "/lib") < 0) {
+            return false;
+        }
+
+        // and ensure everything is flushed
+        supervisor_flash_flush();
+    } else if (res < 0) {
+        return false;
+    }
+
+    _mp_vfs.obj = MP_OBJ_FROM_PTR(self);
+    return true;
+}
+
+mp_obj_vfs_lfs2_t *filesystem_circuitpy_lfs(void) {
+    if (!filesystem_present()) {
+        return NULL;
+    }
+    return &_internal_lfs;
+}
+#else
 __attribute__((unused)) // this function MAY be unused
 static void make_empty_file(FATFS *fatfs, const char *path) {
     FIL fp;
@@ -69,17 +197,12 @@ static void make_file_with_contents(FATFS *fatfs, const char *filename, const by
     make_empty_file(fatfs, filename)
 #endif
 
-// we don't make this function static because it needs a lot of stack and we
-// want it to be executed without using stack within main() function
-bool filesystem_init(bool create_allowed, bool force_create) {
+static bool filesystem_init_fat(bool create_allowed, bool force_create) {
     // init the vfs object
     fs_user_mount_t *vfs_fat = &_internal_vfs;
     vfs_fat->blockdev.flags = 0;
     supervisor_flash_init_vfs(vfs_fat);
 
-    mp_vfs_mount_t *vfs = &_mp_vfs;
-    vfs->len = 0;
-
     // try to mount the flash
     FRESULT res = f_mount(&vfs_fat->fatfs);
     if ((res == FR_NO_FILESYSTEM && create_allowed) || force_create) {
@@ -148,9 +271,28 @@ bool filesystem_init(bool create_allowed, bool force_create) {
         return false;
     }
 
+    _mp_vfs.obj = MP_OBJ_FROM_PTR(vfs_fat);
+    return true;
+}
+#endif
+
+// we don't make this function static because it needs a lot of stack and we
+// want it to be executed without using stack within main() function
+bool filesystem_init(bool create_allowed, bool force_create) {
+    mp_vfs_mount_t *vfs = &_mp_vfs;
+    vfs->len = 0;
+
+    #if CIRCUITPY_FILESYSTEM_LFS
+    bool mounted = filesystem_init_lfs(create_allowed, force_create);
+    #else
+    bool mounted = filesystem_init_fat(create_allowed, force_create);
+    #endif
+    if (!mounted) {
+        return false;
+    }
+
     vfs->str = "/";
     vfs->len = 1;
-    vfs->obj = MP_OBJ_FROM_PTR(vfs_fat);
     vfs->next = NULL;
 
     MP_STATE_VM(vfs_mount_table) = vfs;
@@ -167,8 +309,9 @@ bool filesystem_init(bool create_allowed, bool force_create) {
 }
 
 void PLACE_IN_ITCM(filesystem_flush)(void) {
-    // Reset interval before next flush.
-    filesystem_flush_interval_ms = CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS;
+    // Everything is written now, so the next write starts a new interval.
+    supervisor_deadline_cancel(&filesystem_flush_deadline);
+    filesystem_flush_deferred_intervals = 0;
     supervisor_flash_flush();
     // Don't keep caches because this is called when starting or stopping the VM.
     supervisor_flash_release_cache();
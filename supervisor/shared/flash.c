@@ -8,9 +8,15 @@
 #include "extmod/vfs_fat.h"
 #include "py/runtime.h"
 #include "lib/oofatfs/ff.h"
+#include "supervisor/filesystem.h"
 #include "supervisor/flash.h"
 #include "supervisor/shared/tick.h"
 
+#if CIRCUITPY_FILESYSTEM_LFS
+#include "lib/littlefs/lfs2.h"
+#include "py/mperrno.h"
+#endif
+
 #define VFS_INDEX 0
 
 #define PART1_START_BLOCK (0x1)
@@ -106,24 +112,40 @@ static mp_uint_t flash_write_blocks(mp_obj_t self, const uint8_t *src, uint32_t
         return 0;
     } else {
         if (!filesystem_dirty) {
-            // Turn on ticks so that we can flush after a period of time elapses.
-            supervisor_enable_tick();
+            // Flush after a period of time elapses.
+            filesystem_schedule_flush();
             filesystem_dirty = true;
         }
         return supervisor_flash_write_blocks(src, block_num - PART1_START_BLOCK, num_blocks);
     }
 }
 
+#if MICROPY_VFS_XIP
+MP_WEAK const uint8_t *supervisor_flash_get_xip_addr(uint32_t block_num) {
+    return NULL;
+}
+#endif
+
+bool PLACE_IN_ITCM(supervisor_flash_flush_step)(void) {
+    #if INTERNAL_FLASH_FILESYSTEM
+    // Internal flash ports cache at most one sector, so this is a single step.
+    port_internal_flash_flush();
+    bool more = false;
+    #else
+    bool more = supervisor_external_flash_flush_step();
+    #endif
+    if (!more) {
+        filesystem_dirty = false;
+    }
+    return more;
+}
+
 void PLACE_IN_ITCM(supervisor_flash_flush)(void) {
     #if INTERNAL_FLASH_FILESYSTEM
     port_internal_flash_flush();
     #else
     supervisor_external_flash_flush();
     #endif
-    // Turn off ticks now that our filesystem has been flushed.
-    if (filesystem_dirty) {
-        supervisor_disable_tick();
-    }
     filesystem_dirty = false;
 }
 
@@ -163,6 +185,16 @@ static bool flash_ioctl(mp_obj_t self_in, size_t cmd, size_t arg, mp_int_t *out_
         case MP_BLOCKDEV_IOCTL_BLOCK_SIZE:
             *out_value = supervisor_flash_get_block_size();
             break;
+        #if MICROPY_VFS_XIP
+        case MP_BLOCKDEV_IOCTL_XIP_ADDR:
+            if (arg < PART1_START_BLOCK) {
+                return false;
+            }
+            // Reads through the mapping bypass the write cache, so flush it first.
+            supervisor_flash_flush();
+            *out_value = (mp_int_t)supervisor_flash_get_xip_addr(arg - PART1_START_BLOCK);
+            return *out_value != 0;
+        #endif
         default:
             return false;
     }
@@ -211,3 +243,60 @@ void supervisor_flash_init_vfs(fs_user_mount_t *vfs) {
     vfs->blockdev.u.ioctl[1] = (mp_obj_t)&supervisor_flash_obj;
     vfs->blockdev.u.ioctl[2] = (mp_obj_t)flash_ioctl; // native version
 }
+
+#if CIRCUITPY_FILESYSTEM_LFS
+// littlefs uses the whole partition and never sees the fake MBR. read_size and
+// prog_size are the block size, so it only ever asks for whole blocks.
+static int flash_lfs_read(const struct lfs2_config *c, lfs2_block_t block, lfs2_off_t off, void *buffer, lfs2_size_t size) {
+    if (off != 0 || size % c->block_size != 0) {
+        return LFS2_ERR_INVAL;
+    }
+    if (flash_read_blocks(MP_OBJ_NULL, buffer, PART1_START_BLOCK + block, size / c->block_size) != 0) {
+        return LFS2_ERR_IO;
+    }
+    return LFS2_ERR_OK;
+}
+
+static int flash_lfs_prog(const struct lfs2_config *c, lfs2_block_t block, lfs2_off_t off, const void *buffer, lfs2_size_t size) {
+    if (off != 0 || size % c->block_size != 0) {
+        return LFS2_ERR_INVAL;
+    }
+    // Honor storage.remount() the same way the FAT VFS does.
+    if (!filesystem_is_writable_by_python(c->context)) {
+        return -MP_EROFS;
+    }
+    if (flash_write_blocks(MP_OBJ_NULL, buffer, PART1_START_BLOCK + block, size / c->block_size) != 0) {
+        return LFS2_ERR_IO;
+    }
+    return LFS2_ERR_OK;
+}
+
+static int flash_lfs_erase(const struct lfs2_config *c, lfs2_block_t block) {
+    // Blocks are rewritable. The flash layer erases sectors as it flushes them.
+    return LFS2_ERR_OK;
+}
+
+static int flash_lfs_sync(const struct lfs2_config *c) {
+    supervisor_flash_flush();
+    return LFS2_ERR_OK;
+}
+
+void supervisor_flash_init_lfs(struct lfs2_config *config, fs_user_mount_t *vfs) {
+    supervisor_flash_init_vfs(vfs);
+    supervisor_flash_init();
+
+    config->context = vfs;
+    config->read = flash_lfs_read;
+    config->prog = flash_lfs_prog;
+    config->erase = flash_lfs_erase;
+    config->sync = flash_lfs_sync;
+
+    uint32_t block_size = supervisor_flash_get_block_size();
+    config->read_size = block_size;
+    config->prog_size = block_size;
+    config->cache_size = block_size;
+    config->block_size = block_size;
+    config->block_count = supervisor_flash_get_block_count();
+    config->block_cycles = 100;
+}
+#endif
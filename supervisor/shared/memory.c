@@ -3,3 +3,108 @@
 // SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
 //
 // SPDX-License-Identifier: MIT
+
+#include "supervisor/shared/memory.h"
+
+#include <stdint.h>
+
+#include "py/gc.h"
+#include "py/runtime.h"
+
+#if defined(UNIX)
+#include <stdlib.h>
+#define port_free free
+#define port_malloc(sz, hint) (malloc(sz))
+#else
+#include "supervisor/port_heap.h"
+#endif
+
+#ifndef CIRCUITPY_SCRATCH_ARENA_SIZE
+#define CIRCUITPY_SCRATCH_ARENA_SIZE (0)
+#endif
+
+#define SCRATCH_ALIGN(sz) (((sz) + 7) & ~(size_t)7)
+
+// Allocations that didn't fit in the arena. Each remembers the arena top at
+// the time it was made, which orders it relative to the arena allocations.
+typedef struct _scratch_overflow_t {
+    struct _scratch_overflow_t *prev;
+    size_t top;
+} scratch_overflow_t;
+
+#define OVERFLOW_HEADER_SIZE SCRATCH_ALIGN(sizeof(scratch_overflow_t))
+
+static uint8_t *_arena;
+static size_t _arena_size;
+static size_t _top;
+static scratch_overflow_t *_overflow;
+static bool _reserved;
+
+void supervisor_scratch_init(void) {
+    if (_reserved) {
+        return;
+    }
+    _reserved = true;
+    if (CIRCUITPY_SCRATCH_ARENA_SIZE > 0) {
+        _arena = port_malloc(CIRCUITPY_SCRATCH_ARENA_SIZE, false);
+    }
+    _arena_size = _arena != NULL ? CIRCUITPY_SCRATCH_ARENA_SIZE : 0;
+}
+
+// Free the newest overflow block.
+static void overflow_pop(void) {
+    scratch_overflow_t *prev = _overflow->prev;
+    port_free(_overflow);
+    _overflow = prev;
+}
+
+void *supervisor_scratch_push(size_t size) {
+    // The arena normally comes from main(), but a port that doesn't call
+    // supervisor_scratch_init() gets it on first use instead.
+    supervisor_scratch_init();
+    // Zero-sized requests still take a slot so that every pointer is distinct.
+    size_t sz = SCRATCH_ALIGN(size > 0 ? size : 1);
+    if (sz <= _arena_size - _top) {
+        void *ptr = _arena + _top;
+        _top += sz;
+        return ptr;
+    }
+    scratch_overflow_t *block = NULL;
+    if (sz <= SIZE_MAX - OVERFLOW_HEADER_SIZE) {
+        block = port_malloc(OVERFLOW_HEADER_SIZE + sz, false);
+    }
+    if (block == NULL) {
+        m_malloc_fail(size);
+    }
+    block->prev = _overflow;
+    block->top = _top;
+    _overflow = block;
+    return (uint8_t *)block + OVERFLOW_HEADER_SIZE;
+}
+
+void supervisor_scratch_pop(void *ptr) {
+    uint8_t *p = ptr;
+    if (_arena != NULL && p >= _arena && p < _arena + _arena_size) {
+        _top = p - _arena;
+        // Overflow blocks made after `ptr` saw a higher top.
+        while (_overflow != NULL && _overflow->top > _top) {
+            overflow_pop();
+        }
+        return;
+    }
+    scratch_overflow_t *block = (scratch_overflow_t *)(p - OVERFLOW_HEADER_SIZE);
+    // Anything pushed after this block is either a newer overflow block or
+    // sits in the arena at or above its top.
+    _top = block->top;
+    while (_overflow != block) {
+        overflow_pop();
+    }
+    overflow_pop();
+}
+
+void supervisor_scratch_reset(void) {
+    while (_overflow != NULL) {
+        overflow_pop();
+    }
+    _top = 0;
+}
@@ -0,0 +1,32 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stddef.h>
+
+// A scratch arena for the large temporary buffers that native code needs for
+// the duration of a single call. It is reserved once at boot, outside of the
+// VM heap, so borrowing from it never fragments the heap. Allocations are
+// released in LIFO order. The arena is never scanned by the GC, so it must not
+// hold the only reference to a VM object.
+//
+// Requests that don't fit in the arena fall back to the port heap, so callers
+// don't need to care whether the arena is enabled or big enough.
+
+// Reserve the arena. Called once from main() after port_heap_init().
+void supervisor_scratch_init(void);
+
+// Borrow `size` bytes, aligned to 8 bytes. Raises MemoryError on failure.
+void *supervisor_scratch_push(size_t size);
+
+// Return the most recent allocation from supervisor_scratch_push(). Anything
+// pushed after `ptr` and not yet popped is released too.
+void supervisor_scratch_pop(void *ptr);
+
+// Release everything, including allocations abandoned by an exception.
+// Called after each VM run.
+void supervisor_scratch_reset(void);
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: MIT
 
 #include "supervisor/port.h"
+#include "supervisor/port_heap.h"
 
 #include <string.h>
 
@@ -12,8 +13,6 @@
 
 #include "lib/tlsf/tlsf.h"
 
-static tlsf_t heap;
-
 MP_WEAK void port_wake_main_task(void) {
 }
 
@@ -26,24 +25,160 @@ MP_WEAK void port_yield(void) {
 MP_WEAK void port_boot_info(void) {
 }
 
+MP_WEAK bool port_second_core_start(void (*fn)(void *arg), void *arg) {
+    return false;
+}
+
+MP_WEAK void port_second_core_wake(void) {
+}
+
+MP_WEAK void port_second_core_stop(void) {
+}
+
+MP_WEAK uint32_t port_get_cpu_cycles(void) {
+    #if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+    // Use the architectural DWT addresses so that no device header is needed.
+    volatile uint32_t *demcr = (volatile uint32_t *)0xE000EDFC;
+    volatile uint32_t *dwt_ctrl = (volatile uint32_t *)0xE0001000;
+    volatile uint32_t *dwt_cyccnt = (volatile uint32_t *)0xE0001004;
+    if ((*dwt_ctrl & 1) == 0) {
+        // Enable trace and then CYCCNTENA.
+        *demcr |= 1 << 24;
+        *dwt_ctrl |= 1;
+    }
+    return *dwt_cyccnt;
+    #else
+    uint8_t subticks;
+    uint64_t ticks = port_get_raw_ticks(&subticks);
+    return (uint32_t)((ticks << 5) | subticks);
+    #endif
+}
+
+static tlsf_t heap;
+
+// The largest free block only changes when the heap does, so it is cached
+// between allocations. The GC asks for it every time it wants to grow.
+static size_t largest_free_size;
+static bool largest_free_size_valid;
+
+#if CIRCUITPY_PORT_HEAP_STATS
+// Each allocation is preceded by a header naming the table slot of the code
+// that allocated it, so that freeing it can be charged to the same slot. Slot
+// CIRCUITPY_PORT_HEAP_STATS_SLOTS collects callers that don't fit.
+typedef struct {
+    uint32_t slot;
+    uint32_t size;
+} port_heap_header_t;
+
+static port_heap_stats_t heap_stats[CIRCUITPY_PORT_HEAP_STATS_SLOTS + 1];
+static size_t heap_stats_used;
+
+static uint32_t port_heap_slot(const void *owner) {
+    for (size_t i = 0; i < heap_stats_used; i++) {
+        if (heap_stats[i].owner == owner) {
+            return i;
+        }
+    }
+    if (heap_stats_used < CIRCUITPY_PORT_HEAP_STATS_SLOTS) {
+        heap_stats[heap_stats_used].owner = owner;
+        return heap_stats_used++;
+    }
+    return CIRCUITPY_PORT_HEAP_STATS_SLOTS;
+}
+
+static void port_heap_charge(port_heap_header_t *header, uint32_t slot, size_t size) {
+    header->slot = slot;
+    header->size = size;
+    port_heap_stats_t *entry = &heap_stats[slot];
+    entry->allocations++;
+    entry->bytes += size;
+    entry->peak_bytes = MAX(entry->peak_bytes, entry->bytes);
+}
+
+static void port_heap_discharge(port_heap_header_t *header) {
+    port_heap_stats_t *entry = &heap_stats[header->slot];
+    entry->allocations--;
+    entry->bytes -= header->size;
+}
+
+static void *port_heap_alloc(size_t size, const void *owner) {
+    port_heap_header_t *header = tlsf_malloc(heap, size + sizeof(port_heap_header_t));
+    if (header == NULL) {
+        return NULL;
+    }
+    port_heap_charge(header, port_heap_slot(owner), size);
+    return header + 1;
+}
+
+size_t port_heap_get_stats(const port_heap_stats_t **stats) {
+    *stats = heap_stats;
+    if (heap_stats[CIRCUITPY_PORT_HEAP_STATS_SLOTS].peak_bytes > 0) {
+        return CIRCUITPY_PORT_HEAP_STATS_SLOTS + 1;
+    }
+    return heap_stats_used;
+}
+#endif
+
 MP_WEAK void port_heap_init(void) {
     uint32_t *heap_bottom = port_heap_get_bottom();
     uint32_t *heap_top = port_heap_get_top();
     size_t size = (heap_top - heap_bottom) * sizeof(uint32_t);
     heap = tlsf_create_with_pool(heap_bottom, size, size);
+    largest_free_size_valid = false;
 }
 
 MP_WEAK void *port_malloc(size_t size, bool dma_capable) {
+    largest_free_size_valid = false;
+    #if CIRCUITPY_PORT_HEAP_STATS
+    return port_heap_alloc(size, __builtin_return_address(0));
+    #else
     void *block = tlsf_malloc(heap, size);
     return block;
+    #endif
+}
+
+MP_WEAK void *port_malloc_fast(size_t size) {
+    return port_malloc(size, false);
 }
 
 MP_WEAK void port_free(void *ptr) {
+    largest_free_size_valid = false;
+    #if CIRCUITPY_PORT_HEAP_STATS
+    if (ptr == NULL) {
+        return;
+    }
+    port_heap_header_t *header = (port_heap_header_t *)ptr - 1;
+    port_heap_discharge(header);
+    tlsf_free(heap, header);
+    #else
     tlsf_free(heap, ptr);
+    #endif
 }
 
 MP_WEAK void *port_realloc(void *ptr, size_t size) {
+    largest_free_size_valid = false;
+    #if CIRCUITPY_PORT_HEAP_STATS
+    if (ptr == NULL) {
+        return port_heap_alloc(size, __builtin_return_address(0));
+    }
+    port_heap_header_t *header = (port_heap_header_t *)ptr - 1;
+    if (size == 0) {
+        port_heap_discharge(header);
+        tlsf_free(heap, header);
+        return NULL;
+    }
+    port_heap_header_t *new_header = tlsf_realloc(heap, header, size + sizeof(port_heap_header_t));
+    if (new_header == NULL) {
+        // The old block is untouched.
+        return NULL;
+    }
+    uint32_t slot = new_header->slot;
+    port_heap_discharge(new_header);
+    port_heap_charge(new_header, slot, size);
+    return new_header + 1;
+    #else
     return tlsf_realloc(heap, ptr, size);
+    #endif
 }
 
 static void max_size_walker(void *ptr, size_t size, int used, void *user) {
@@ -54,8 +189,20 @@ static void max_size_walker(void *ptr, size_t size, int used, void *user) {
 }
 
 MP_WEAK size_t port_heap_get_largest_free_size(void) {
+    if (largest_free_size_valid) {
+        return largest_free_size;
+    }
     size_t max_size = 0;
     tlsf_walk_pool(tlsf_get_pool(heap), max_size_walker, &max_size);
     // IDF does this. Not sure why.
-    return tlsf_fit_size(heap, max_size);
+    largest_free_size = tlsf_fit_size(heap, max_size);
+    #if CIRCUITPY_PORT_HEAP_STATS
+    largest_free_size = largest_free_size > sizeof(port_heap_header_t) ? largest_free_size - sizeof(port_heap_header_t) : 0;
+    #endif
+    largest_free_size_valid = true;
+    return largest_free_size;
+}
+
+MP_WEAK bool port_heap_is_slow(const void *ptr) {
+    return false;
 }
@@ -10,11 +10,14 @@
 #include "py/mphal.h"
 #include "py/mpstate.h"
 #include "py/runtime.h"
-#include "supervisor/filesystem.h"
 #include "supervisor/background_callback.h"
 #include "supervisor/port.h"
 #include "supervisor/shared/stack.h"
 
+#if MICROPY_PROF_SAMPLING
+#include "py/profile.h"
+#endif
+
 #if CIRCUITPY_BLEIO_HCI
 #include "common-hal/_bleio/__init__.h"
 #endif
@@ -23,10 +26,6 @@
 #include "shared-module/displayio/__init__.h"
 #endif
 
-#if CIRCUITPY_KEYPAD
-#include "shared-module/keypad/__init__.h"
-#endif
-
 #include "shared-bindings/microcontroller/__init__.h"
 
 #if CIRCUITPY_WATCHDOG
@@ -44,6 +43,90 @@ static volatile uint64_t last_finished_tick = 0;
 
 static volatile size_t tick_enable_count = 0;
 
+// Pending deadlines, soonest first.
+static supervisor_deadline_t *volatile deadline_head = NULL;
+#if !CIRCUITPY_TICKLESS_DEADLINES
+// Whether the deadline queue holds a tick request to poll itself.
+static bool deadline_tick_enabled = false;
+#endif
+
+// Must be called with interrupts disabled.
+static void deadline_unlink(supervisor_deadline_t *deadline) {
+    if (!deadline->queued) {
+        return;
+    }
+    supervisor_deadline_t *volatile *link = &deadline_head;
+    while (*link != NULL && *link != deadline) {
+        link = &(*link)->next;
+    }
+    if (*link == deadline) {
+        *link = deadline->next;
+    }
+    deadline->next = NULL;
+    deadline->queued = false;
+}
+
+// Point the port's one-shot interrupt, or the regular tick, at the head of the
+// queue. Must be called with interrupts disabled.
+static void deadline_update_wakeup(void) {
+    #if CIRCUITPY_TICKLESS_DEADLINES
+    if (deadline_head != NULL) {
+        port_set_deadline_interrupt(deadline_head->tick);
+    }
+    #else
+    bool want_tick = deadline_head != NULL;
+    if (want_tick != deadline_tick_enabled) {
+        deadline_tick_enabled = want_tick;
+        if (want_tick) {
+            supervisor_enable_tick();
+        } else {
+            supervisor_disable_tick();
+        }
+    }
+    #endif
+}
+
+void supervisor_deadline_schedule(supervisor_deadline_t *deadline, uint64_t tick, background_callback_fun fun, void *data) {
+    common_hal_mcu_disable_interrupts();
+    deadline_unlink(deadline);
+    deadline->tick = tick;
+    deadline->fun = fun;
+    deadline->data = data;
+    supervisor_deadline_t *volatile *link = &deadline_head;
+    while (*link != NULL && (*link)->tick <= tick) {
+        link = &(*link)->next;
+    }
+    deadline->next = *link;
+    *link = deadline;
+    deadline->queued = true;
+    deadline_update_wakeup();
+    common_hal_mcu_enable_interrupts();
+}
+
+void supervisor_deadline_cancel(supervisor_deadline_t *deadline) {
+    common_hal_mcu_disable_interrupts();
+    deadline_unlink(deadline);
+    deadline_update_wakeup();
+    common_hal_mcu_enable_interrupts();
+}
+
+void supervisor_deadline_interrupt(void) {
+    uint64_t now = port_get_raw_ticks(NULL);
+    common_hal_mcu_disable_interrupts();
+    while (deadline_head != NULL && deadline_head->tick <= now) {
+        supervisor_deadline_t *deadline = deadline_head;
+        deadline_unlink(deadline);
+        background_callback_fun fun = deadline->fun;
+        void *data = deadline->data;
+        // The callback may reschedule itself.
+        common_hal_mcu_enable_interrupts();
+        fun(data);
+        common_hal_mcu_disable_interrupts();
+    }
+    deadline_update_wakeup();
+    common_hal_mcu_enable_interrupts();
+}
+
 static void supervisor_background_tick(void *unused) {
     port_start_background_tick();
 
@@ -57,8 +140,6 @@ static void supervisor_background_tick(void *unused) {
     displayio_background();
     #endif
 
-    filesystem_background();
-
     port_background_tick();
 
     assert_heap_ok();
@@ -73,13 +154,14 @@ bool supervisor_background_ticks_ok(void) {
 }
 
 void supervisor_tick(void) {
-    #if CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS > 0
-    filesystem_tick();
+    #if !CIRCUITPY_TICKLESS_DEADLINES
+    if (deadline_head != NULL) {
+        supervisor_deadline_interrupt();
+    }
     #endif
 
-
-    #if CIRCUITPY_KEYPAD
-    keypad_tick();
+    #if MICROPY_PROF_SAMPLING
+    mp_prof_sample_tick();
     #endif
 
     background_callback_add(&tick_callback, supervisor_background_tick, NULL);
@@ -96,27 +178,47 @@ uint32_t supervisor_ticks_ms32() {
     return supervisor_ticks_ms64();
 }
 
-void mp_hal_delay_ms(mp_uint_t delay_ms) {
+uint32_t supervisor_ticks_us32(void) {
+    uint8_t subticks;
+    uint64_t result = port_get_raw_ticks(&subticks);
+    result = (result * 32 + subticks) * 15625 / 512;
+    return result;
+}
+
+bool supervisor_wait_until(bool (*done)(void *arg), void *arg, uint64_t timeout_ms) {
+    const bool wait_forever = timeout_ms == SUPERVISOR_WAIT_FOREVER;
     uint64_t start_tick = port_get_raw_ticks(NULL);
     // Adjust the delay to ticks vs ms.
-    uint64_t delay_ticks = (delay_ms * (uint64_t)1024) / 1000;
+    uint64_t delay_ticks = wait_forever ? 0 : (timeout_ms * 1024) / 1000;
     uint64_t end_tick = start_tick + delay_ticks;
     int64_t remaining = delay_ticks;
 
-    // Loop until we've waited long enough or we've been CTRL-Ced by autoreload
-    // or the user.
-    while (remaining > 0 && !mp_hal_is_interrupted()) {
+    // Loop until we're done, we've waited long enough or we've been CTRL-Ced
+    // by autoreload or the user.
+    while (!mp_hal_is_interrupted()) {
         RUN_BACKGROUND_TASKS;
-        remaining = end_tick - port_get_raw_ticks(NULL);
-        // We break a bit early so we don't risk setting the alarm before the time when we call
-        // sleep.
-        if (remaining < 1) {
-            break;
+        if (done != NULL && done(arg)) {
+            return true;
         }
-        port_interrupt_after_ticks(remaining);
-        // Idle until an interrupt happens.
+        if (!wait_forever) {
+            remaining = end_tick - port_get_raw_ticks(NULL);
+            // We break a bit early so we don't risk setting the alarm before the time when we call
+            // sleep.
+            if (remaining < 1) {
+                break;
+            }
+            port_interrupt_after_ticks(remaining);
+        }
+        // Idle until an interrupt happens. Whatever we're waiting on is
+        // expected to come with one, or to wake us with port_wake_main_task().
         port_idle_until_interrupt();
-        remaining = end_tick - port_get_raw_ticks(NULL);
+    }
+    return false;
+}
+
+void mp_hal_delay_ms(mp_uint_t delay_ms) {
+    if (delay_ms > 0) {
+        supervisor_wait_until(NULL, NULL, delay_ms);
     }
 }
 
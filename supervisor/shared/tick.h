@@ -9,6 +9,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "supervisor/background_callback.h"
+
 /** @brief To be called once every ms
  *
  * The port must call supervisor_tick once per millisecond to perform regular tasks.
@@ -33,6 +35,56 @@ extern uint32_t supervisor_ticks_ms32(void);
  */
 extern uint64_t supervisor_ticks_ms64(void);
 
+/** @brief Get the lower 32 bits of the time in microseconds
+ *
+ * The resolution is one subtick, about 30.5us. It wraps about every 71.5 minutes,
+ * so only use it to time short spans.
+ */
+extern uint32_t supervisor_ticks_us32(void);
+
+#define SUPERVISOR_WAIT_FOREVER (UINT64_MAX)
+
+/** @brief Sleep until done(arg) returns true or timeout_ms passes
+ *
+ * Background tasks run and done is polled each time the CPU wakes up, so
+ * whatever done waits on must raise an interrupt or call port_wake_main_task()
+ * when it changes. done may be NULL to wait out the timeout. Pass
+ * SUPERVISOR_WAIT_FOREVER to wait without a timeout. Returns true if done
+ * returned true and false if the wait timed out or the VM was interrupted.
+ */
+extern bool supervisor_wait_until(bool (*done)(void *arg), void *arg, uint64_t timeout_ms);
+
+/** @brief A one-shot timer in the deadline queue
+ *
+ * Instead of keeping the 1/1024 s tick running to count down to their next
+ * piece of work, subsystems queue a deadline. When the raw tick count reaches
+ * `tick`, fun(data) is called from interrupt context, so it must be as
+ * careful as a supervisor_tick() user. It may reschedule the deadline. Queue
+ * background work from it for anything longer.
+ *
+ * Ports with CIRCUITPY_TICKLESS_DEADLINES program a one-shot timer for the
+ * soonest deadline with port_set_deadline_interrupt(). Other ports keep the
+ * tick enabled while any deadline is queued and check the queue on each tick.
+ *
+ * Zero-initialize the struct before its first use.
+ */
+typedef struct supervisor_deadline {
+    struct supervisor_deadline *next;
+    uint64_t tick;
+    background_callback_fun fun;
+    void *data;
+    bool queued;
+} supervisor_deadline_t;
+
+/** @brief Queue `deadline` for the given raw tick, replacing any earlier schedule for it */
+extern void supervisor_deadline_schedule(supervisor_deadline_t *deadline, uint64_t tick, background_callback_fun fun, void *data);
+
+/** @brief Remove `deadline` from the queue if it is there */
+extern void supervisor_deadline_cancel(supervisor_deadline_t *deadline);
+
+/** @brief Run due deadlines. Called from the port's deadline interrupt. */
+extern void supervisor_deadline_interrupt(void);
+
 extern void supervisor_enable_tick(void);
 extern void supervisor_disable_tick(void);
 
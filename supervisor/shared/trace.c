@@ -0,0 +1,88 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "supervisor/shared/trace.h"
+
+#include "py/mpconfig.h"
+#include "shared-bindings/microcontroller/__init__.h"
+#include "supervisor/shared/tick.h"
+
+typedef struct {
+    uint32_t us;
+    uint8_t event;
+    char phase;
+} trace_entry_t;
+
+typedef struct {
+    const char *name;
+    const char *category;
+    // Events from interrupts get their own row so they don't split the main one.
+    uint8_t tid;
+} trace_event_info_t;
+
+#define TRACE_TID_MAIN (1)
+#define TRACE_TID_INTERRUPT (2)
+
+static const trace_event_info_t _event_info[TRACE_EVENT_COUNT] = {
+    [TRACE_EVENT_GC_COLLECT] = { "gc_collect", "gc", TRACE_TID_MAIN },
+    [TRACE_EVENT_BACKGROUND_CALLBACKS] = { "background_callbacks", "background", TRACE_TID_MAIN },
+    [TRACE_EVENT_DISPLAY_REFRESH] = { "display_refresh", "display", TRACE_TID_MAIN },
+    [TRACE_EVENT_AUDIO_DMA_REFILL] = { "audio_dma_refill", "audio", TRACE_TID_MAIN },
+    [TRACE_EVENT_AUDIO_DMA_IRQ] = { "audio_dma_irq", "audio", TRACE_TID_INTERRUPT },
+};
+
+static trace_entry_t _entries[CIRCUITPY_SUPERVISOR_TRACE_EVENTS];
+// Index the next entry is written to.
+static size_t _next;
+static size_t _count;
+static uint32_t _dropped;
+static volatile bool _dumping;
+
+void supervisor_trace_record(trace_event_t event, char phase) {
+    if (_dumping) {
+        return;
+    }
+    uint32_t us = supervisor_ticks_us32();
+    common_hal_mcu_disable_interrupts();
+    trace_entry_t *entry = &_entries[_next];
+    entry->us = us;
+    entry->event = event;
+    entry->phase = phase;
+    _next = (_next + 1) % CIRCUITPY_SUPERVISOR_TRACE_EVENTS;
+    if (_count < CIRCUITPY_SUPERVISOR_TRACE_EVENTS) {
+        _count++;
+    } else {
+        _dropped++;
+    }
+    common_hal_mcu_enable_interrupts();
+}
+
+void supervisor_trace_dump(const mp_print_t *print) {
+    _dumping = true;
+    size_t first = (_next + CIRCUITPY_SUPERVISOR_TRACE_EVENTS - _count) % CIRCUITPY_SUPERVISOR_TRACE_EVENTS;
+    // Timestamps count from the oldest event so that they don't wrap.
+    uint32_t start_us = _entries[first].us;
+
+    mp_printf(print, "{\"traceEvents\":[\n");
+    mp_printf(print, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"main\"}},\n", TRACE_TID_MAIN);
+    mp_printf(print, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"interrupts\"}}", TRACE_TID_INTERRUPT);
+    for (size_t i = 0; i < _count; i++) {
+        const trace_entry_t *entry = &_entries[(first + i) % CIRCUITPY_SUPERVISOR_TRACE_EVENTS];
+        const trace_event_info_t *info = &_event_info[entry->event];
+        mp_printf(print, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%u,\"pid\":1,\"tid\":%d",
+            info->name, info->category, entry->phase, (unsigned int)(entry->us - start_us), info->tid);
+        if (entry->phase == TRACE_PHASE_INSTANT) {
+            mp_printf(print, ",\"s\":\"t\"");
+        }
+        mp_printf(print, "}");
+    }
+    mp_printf(print, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":\"%u\"}}\n", (unsigned int)_dropped);
+
+    _next = 0;
+    _count = 0;
+    _dropped = 0;
+    _dumping = false;
+}
@@ -0,0 +1,45 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdint.h>
+
+#include "py/mpprint.h"
+
+// Things that can appear on the trace timeline.
+typedef enum {
+    TRACE_EVENT_GC_COLLECT,
+    TRACE_EVENT_BACKGROUND_CALLBACKS,
+    TRACE_EVENT_DISPLAY_REFRESH,
+    TRACE_EVENT_AUDIO_DMA_REFILL,
+    TRACE_EVENT_AUDIO_DMA_IRQ,
+    TRACE_EVENT_COUNT,
+} trace_event_t;
+
+// Chrome trace event phases.
+#define TRACE_PHASE_BEGIN 'B'
+#define TRACE_PHASE_END 'E'
+#define TRACE_PHASE_INSTANT 'i'
+
+#if CIRCUITPY_SUPERVISOR_TRACE
+// Use these instead of calling supervisor_trace_record() so that they compile
+// to nothing in builds without tracing. Safe to use from interrupts.
+#define CIRCUITPY_TRACE_BEGIN(event) supervisor_trace_record((event), TRACE_PHASE_BEGIN)
+#define CIRCUITPY_TRACE_END(event) supervisor_trace_record((event), TRACE_PHASE_END)
+#define CIRCUITPY_TRACE_INSTANT(event) supervisor_trace_record((event), TRACE_PHASE_INSTANT)
+#else
+#define CIRCUITPY_TRACE_BEGIN(event) ((void)0)
+#define CIRCUITPY_TRACE_END(event) ((void)0)
+#define CIRCUITPY_TRACE_INSTANT(event) ((void)0)
+#endif
+
+// Add an event to the ring buffer, overwriting the oldest one when it is full.
+void supervisor_trace_record(trace_event_t event, char phase);
+
+// Print the buffered events as Chrome trace JSON, oldest first, and empty the
+// buffer. Events are not recorded while printing.
+void supervisor_trace_dump(const mp_print_t *print);
@@ -20,6 +20,7 @@
 
 #if CIRCUITPY_USB_VIDEO
 #include "shared-module/usb_video/__init__.h"
+#include "supervisor/shared/boot_timing.h"
 #endif
 
 #include "tusb.h"
@@ -53,6 +54,9 @@ void tud_mount_cb(void) {
     #if CIRCUITPY_USB_MSC
     usb_msc_mount();
     #endif
+    #if CIRCUITPY_BOOT_TIMING
+    supervisor_boot_timing_mark(BOOT_PHASE_USB_MOUNTED);
+    #endif
 }
 
 // Invoked when device is unmounted
@@ -75,7 +79,10 @@ void tud_resume_cb(void) {
 // Invoked when cdc when line state changed e.g connected/disconnected
 // Use to reset to DFU when disconnect with 1200 bps
 void tud_cdc_line_state_cb(uint8_t itf, bool dtr, bool rts) {
-    (void)itf;  // interface ID, not used
+    (void)itf;
+    #if CIRCUITPY_USB_CDC
+    usb_cdc_poll_notify(itf);
+    #endif
 
     // DTR = false is counted as disconnected
     if (!dtr) {
@@ -94,6 +101,19 @@ void tud_cdc_line_state_cb(uint8_t itf, bool dtr, bool rts) {
     }
 }
 
+#if CIRCUITPY_USB_CDC
+// Invoked when CDC data has been received. Weak so that ports can supply
+// their own, which must also call usb_cdc_poll_notify().
+MP_WEAK void tud_cdc_rx_cb(uint8_t itf) {
+    usb_cdc_poll_notify(itf);
+}
+
+// Invoked when a CDC IN transfer has completed, freeing space to write.
+void tud_cdc_tx_complete_cb(uint8_t itf) {
+    usb_cdc_tx_notify(itf);
+}
+#endif
+
 #if CIRCUITPY_USB_VENDOR
 // --------------------------------------------------------------------+
 // WebUSB use vendor class
@@ -15,6 +15,7 @@
 #include "py/mpstate.h"
 
 #include "shared-module/storage/__init__.h"
+#include "supervisor/background_callback.h"
 #include "supervisor/filesystem.h"
 #include "supervisor/shared/reload.h"
 
@@ -40,6 +41,82 @@ static fs_user_mount_t *get_vfs(int lun) {
     return current_mount->obj;
 }
 
+// READ10 and WRITE10 overlap flash work with the USB transfers. A write is
+// acknowledged as soon as its data is copied here, and is written to the disk
+// from a background callback while the host sends the next chunk. After each
+// read, the next chunk is read ahead while the host receives the current one.
+// There is a single staging buffer, so at most one operation is in flight. An
+// operation that conflicts with it finishes it first, right in the callback:
+// returning "busy" would just spin tud_task(), which is what runs us.
+typedef enum {
+    MSC_IO_IDLE,
+    MSC_IO_QUEUED, // read or write waiting for the background callback
+    MSC_IO_READY, // read ahead data is in the buffer
+} msc_io_state_t;
+
+static struct {
+    uint8_t buf[CFG_TUD_MSC_BUFSIZE];
+    background_callback_t callback;
+    uint32_t lba;
+    uint32_t block_count;
+    uint8_t lun;
+    bool write;
+    msc_io_state_t state;
+} msc_io;
+
+// Since by getting here we assume the mount is read-only to
+// MicroPython let's update the cached FatFs sector if it's the one
+// we just wrote.
+static void update_fatfs_window(fs_user_mount_t *vfs, const uint8_t *buffer, uint32_t lba, uint32_t block_count) {
+    #if FF_MAX_SS != FF_MIN_SS
+    if (vfs->fatfs.ssize == MSC_FLASH_BLOCK_SIZE) {
+    #else
+    // The compiler can optimize this away.
+    if (FF_MAX_SS == FILESYSTEM_BLOCK_SIZE) {
+        #endif
+        if (lba == vfs->fatfs.winsect && lba > 0) {
+            memcpy(vfs->fatfs.win,
+                buffer + MSC_FLASH_BLOCK_SIZE * (vfs->fatfs.winsect - lba),
+                MSC_FLASH_BLOCK_SIZE);
+        }
+    }
+}
+
+static void msc_io_run(void *unused) {
+    if (msc_io.state != MSC_IO_QUEUED) {
+        return;
+    }
+    fs_user_mount_t *vfs = get_vfs(msc_io.lun);
+    if (vfs == NULL) {
+        msc_io.state = MSC_IO_IDLE;
+        return;
+    }
+    if (msc_io.write) {
+        disk_write(vfs, msc_io.buf, msc_io.lba, msc_io.block_count);
+        update_fatfs_window(vfs, msc_io.buf, msc_io.lba, msc_io.block_count);
+        msc_io.state = MSC_IO_IDLE;
+    } else {
+        disk_read(vfs, msc_io.buf, msc_io.lba, msc_io.block_count);
+        msc_io.state = MSC_IO_READY;
+    }
+}
+
+static void msc_io_queue(uint8_t lun, uint32_t lba, uint32_t block_count, bool write) {
+    msc_io.lun = lun;
+    msc_io.lba = lba;
+    msc_io.block_count = block_count;
+    msc_io.write = write;
+    msc_io.state = MSC_IO_QUEUED;
+    background_callback_add(&msc_io.callback, msc_io_run, NULL);
+}
+
+// Make sure any queued write has reached the disk.
+static void msc_io_finish_write(void) {
+    if (msc_io.state == MSC_IO_QUEUED && msc_io.write) {
+        msc_io_run(NULL);
+    }
+}
+
 static void _usb_msc_uneject(void) {
     for (uint8_t i = 0; i < sizeof(ejected); i++) {
         ejected[i] = false;
@@ -52,6 +129,8 @@ void usb_msc_mount(void) {
 }
 
 void usb_msc_umount(void) {
+    msc_io_finish_write();
+    msc_io.state = MSC_IO_IDLE;
     for (uint8_t i = 0; i < sizeof(ejected); i++) {
         fs_user_mount_t *vfs = get_vfs(i + 1);
         if (vfs == NULL) {
@@ -146,7 +225,22 @@ int32_t tud_msc_read10_cb(uint8_t lun, uint32_t lba, uint32_t offset, void *buff
         return -1;
     }
 
-    disk_read(vfs, buffer, lba, block_count);
+    msc_io_finish_write();
+    bool ahead = !msc_io.write && msc_io.state != MSC_IO_IDLE &&
+        msc_io.lun == lun && msc_io.lba == lba && msc_io.block_count == block_count;
+    if (ahead) {
+        msc_io_run(NULL);
+        memcpy(buffer, msc_io.buf, bufsize);
+    } else {
+        disk_read(vfs, buffer, lba, block_count);
+    }
+    msc_io.state = MSC_IO_IDLE;
+
+    // Hosts read files sequentially, so fetch the next chunk while this one is
+    // on the bus.
+    if (bufsize <= sizeof(msc_io.buf) && lba + 2 * block_count <= disk_block_count) {
+        msc_io_queue(lun, lba + block_count, block_count, false);
+    }
 
     return block_count * MSC_FLASH_BLOCK_SIZE;
 }
@@ -161,21 +255,15 @@ int32_t tud_msc_write10_cb(uint8_t lun, uint32_t lba, uint32_t offset, uint8_t *
     const uint32_t block_count = bufsize / MSC_FLASH_BLOCK_SIZE;
 
     fs_user_mount_t *vfs = get_vfs(lun);
-    disk_write(vfs, buffer, lba, block_count);
-    // Since by getting here we assume the mount is read-only to
-    // MicroPython let's update the cached FatFs sector if it's the one
-    // we just wrote.
-    #if FF_MAX_SS != FF_MIN_SS
-    if (vfs->fatfs.ssize == MSC_FLASH_BLOCK_SIZE) {
-    #else
-    // The compiler can optimize this away.
-    if (FF_MAX_SS == FILESYSTEM_BLOCK_SIZE) {
-        #endif
-        if (lba == vfs->fatfs.winsect && lba > 0) {
-            memcpy(vfs->fatfs.win,
-                buffer + MSC_FLASH_BLOCK_SIZE * (vfs->fatfs.winsect - lba),
-                MSC_FLASH_BLOCK_SIZE);
-        }
+    // Only one write in flight, and read ahead data is stale now.
+    msc_io_finish_write();
+    msc_io.state = MSC_IO_IDLE;
+    if (bufsize > sizeof(msc_io.buf)) {
+        disk_write(vfs, buffer, lba, block_count);
+        update_fatfs_window(vfs, buffer, lba, block_count);
+    } else {
+        memcpy(msc_io.buf, buffer, bufsize);
+        msc_io_queue(lun, lba, block_count, true);
     }
 
     return block_count * MSC_FLASH_BLOCK_SIZE;
@@ -185,6 +273,7 @@ int32_t tud_msc_write10_cb(uint8_t lun, uint32_t lba, uint32_t offset, uint8_t *
 // used to flush any pending cache.
 void tud_msc_write10_complete_cb(uint8_t lun) {
     (void)lun;
+    msc_io_finish_write();
 
     // This write is complete; initiate an autoreload.
     autoreload_resume(AUTORELOAD_SUSPEND_USB);
@@ -232,6 +321,7 @@ bool tud_msc_start_stop_cb(uint8_t lun, uint8_t power_condition, bool start, boo
     if (current_mount == NULL) {
         return false;
     }
+    msc_io_finish_write();
     if (load_eject) {
         if (!start) {
             // Eject but first flush.
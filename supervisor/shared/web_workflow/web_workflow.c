@@ -112,6 +112,14 @@ static char web_instance_name[50];
 static uint32_t _encoded_ip = 0;
 static char _our_ip_encoded[4 * 4];
 
+// File bodies move through this buffer in whole sectors so that FatFS reads and
+// writes them directly instead of through its one sector window. Only one request
+// is handled at a time so it is shared by uploads and downloads.
+#ifndef CIRCUITPY_WEB_WORKFLOW_TRANSFER_SIZE
+#define CIRCUITPY_WEB_WORKFLOW_TRANSFER_SIZE (4 * FF_MAX_SS)
+#endif
+static uint8_t _transfer_buffer[CIRCUITPY_WEB_WORKFLOW_TRANSFER_SIZE] __attribute__((aligned(4)));
+
 // in_len is the number of bytes to encode. out_len is the number of bytes we
 // have to do it.
 static bool _base64_in_place(char *buf, size_t in_len, size_t out_len) {
@@ -753,42 +761,24 @@ static void _reply_with_file(socketpool_socket_obj_t *socket, _request *request,
     _cors_header(socket, request);
     _send_str(socket, "\r\n");
 
+    // Reads start at offset 0 and are whole sectors until the last one.
     uint32_t total_read = 0;
-    int nodelay_ok = -1;
     while (total_read < total_length) {
-        uint8_t data_buffer[64];
-        size_t quantity_read;
-        f_read(active_file, data_buffer, 64, &quantity_read);
-        total_read += quantity_read;
-        // When getting near the end of the file, disable Nagle's combining algorithm so that
-        // data is sent immediately.
-        if (total_length - total_read < 64) {
-            int nodelay = 1;
-            // Returns 0 when it works.
-            nodelay_ok = common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
+        UINT quantity_read;
+        FRESULT result = f_read(active_file, _transfer_buffer, sizeof(_transfer_buffer), &quantity_read);
+        if (result != FR_OK || quantity_read == 0) {
+            break;
         }
-        uint32_t send_offset = 0;
-        while (send_offset < quantity_read) {
-            int sent = socketpool_socket_send(socket, data_buffer + send_offset, quantity_read - send_offset);
-            if (sent < 0) {
-                if (sent == -MP_EAGAIN) {
-                    sent = 0;
-                } else {
-                    break;
-                }
-            }
-            send_offset += sent;
+        total_read += quantity_read;
+        // Flush the last chunk so it isn't held back by Nagle's algorithm.
+        web_workflow_send_raw(socket, total_read >= total_length, _transfer_buffer, quantity_read);
+        if (!common_hal_socketpool_socket_get_connected(socket)) {
+            break;
         }
     }
     if (total_read < total_length) {
         socketpool_socket_close(socket);
     }
-
-    // Re-enable Nagle's algorithm when done sending.
-    if (nodelay_ok == 0) {
-        int nodelay = 0;
-        nodelay_ok = common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
-    }
 }
 
 static void _reply_with_devices_json(socketpool_socket_obj_t *socket, _request *request) {
@@ -939,9 +929,8 @@ static uint64_t truncate_time(uint64_t input_time, DWORD *fattime) {
 static void _discard_incoming(socketpool_socket_obj_t *socket, size_t amount) {
     size_t discarded = 0;
     while (discarded < amount) {
-        uint8_t bytes[64];
-        size_t read_len = MIN(sizeof(bytes), amount - discarded);
-        int len = socketpool_socket_recv_into(socket, bytes, read_len);
+        size_t read_len = MIN(sizeof(_transfer_buffer), amount - discarded);
+        int len = socketpool_socket_recv_into(socket, _transfer_buffer, read_len);
         if (len < 0) {
             if (len == -MP_EAGAIN) {
                 continue;
@@ -1021,12 +1010,14 @@ static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *req
     f_truncate(&active_file);
     f_rewind(&active_file);
 
+    // Fill the transfer buffer before each write so that every write but the last
+    // covers whole sectors and goes straight to the block device.
     size_t total_read = 0;
+    size_t buffered = 0;
     bool error = false;
     while (total_read < request->content_length && !error) {
-        uint8_t bytes[64];
-        size_t read_len = MIN(sizeof(bytes), request->content_length - total_read);
-        int len = socketpool_socket_recv_into(socket, bytes, read_len);
+        size_t read_len = MIN(sizeof(_transfer_buffer) - buffered, request->content_length - total_read);
+        int len = socketpool_socket_recv_into(socket, _transfer_buffer + buffered, read_len);
         if (len < 0) {
             if (len == -MP_EAGAIN) {
                 continue;
@@ -1035,12 +1026,17 @@ static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *req
             break;
         }
         total_read += len;
+        buffered += len;
+        if (buffered < sizeof(_transfer_buffer) && total_read < request->content_length) {
+            continue;
+        }
         UINT actual;
-        f_write(&active_file, bytes, len, &actual);
-        if (actual < (UINT)len) {
+        f_write(&active_file, _transfer_buffer, buffered, &actual);
+        if (actual < (UINT)buffered) {
             error = true;
             break;
         }
+        buffered = 0;
     }
 
     f_close(&active_file);
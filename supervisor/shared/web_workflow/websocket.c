@@ -6,11 +6,17 @@
 
 #include "supervisor/shared/web_workflow/websocket.h"
 
+#include <string.h>
+
+#include "py/mperrno.h"
 #include "py/ringbuf.h"
 #include "py/runtime.h"
 #include "shared/runtime/interrupt_char.h"
 #include "shared-bindings/socketpool/SocketPool.h"
+#include "supervisor/port.h"
+#include "supervisor/shared/tick.h"
 #include "supervisor/shared/web_workflow/web_workflow.h"
+#include "supervisor/workflow.h"
 
 #if CIRCUITPY_STATUS_BAR
 #include "supervisor/shared/status_bar.h"
@@ -25,6 +31,9 @@ typedef struct {
     uint8_t mask[4];
     int frame_index;
     size_t payload_remaining;
+    // Set once the client sends a binary frame. Output is then sent in binary
+    // frames too, so it no longer has to be valid UTF-8.
+    bool binary;
 } _websocket;
 
 // Buffer the incoming serial data in the background so that we can look for the
@@ -36,10 +45,55 @@ static bool in_web_background = false;
 
 static _websocket cp_serial;
 
+// Console output is collected into one frame while the previous one is sent, so
+// a slow client only holds up printing once both are full.
+#ifndef CIRCUITPY_WEBSOCKET_OUTPUT_BUFFER_SIZE
+#define CIRCUITPY_WEBSOCKET_OUTPUT_BUFFER_SIZE (256)
+#endif
+// How long output waits for more output to join it in the same frame.
+#ifndef CIRCUITPY_WEBSOCKET_FLUSH_MS
+#define CIRCUITPY_WEBSOCKET_FLUSH_MS (10)
+#endif
+// How long a write waits for a client that isn't reading before its output is dropped.
+#ifndef CIRCUITPY_WEBSOCKET_WRITE_TIMEOUT_MS
+#define CIRCUITPY_WEBSOCKET_WRITE_TIMEOUT_MS (100)
+#endif
+
+#if CIRCUITPY_WEBSOCKET_OUTPUT_BUFFER_SIZE >= (1 << 16)
+#error "CIRCUITPY_WEBSOCKET_OUTPUT_BUFFER_SIZE must be less than 64 KiB"
+#endif
+
+// Room in front of the payload for the frame header, which is 4 bytes for a 16 bit length.
+#define WEBSOCKET_HEADER_MAX (4)
+
+typedef struct {
+    uint8_t buf[WEBSOCKET_HEADER_MAX + CIRCUITPY_WEBSOCKET_OUTPUT_BUFFER_SIZE];
+    // buf[start:end] is still to be sent. While collecting, the payload is
+    // buf[WEBSOCKET_HEADER_MAX:end].
+    size_t start;
+    size_t end;
+} _websocket_frame;
+
+static _websocket_frame _frames[2];
+static _websocket_frame *_collecting = &_frames[0];
+static _websocket_frame *_sending = &_frames[1];
+
+static supervisor_deadline_t _flush_deadline;
+static volatile bool _flush_due;
+
+static void _reset_output(void) {
+    supervisor_deadline_cancel(&_flush_deadline);
+    _flush_due = false;
+    _collecting->end = WEBSOCKET_HEADER_MAX;
+    _sending->start = 0;
+    _sending->end = 0;
+}
+
 void websocket_init(void) {
     socketpool_socket_reset(&cp_serial.socket);
 
     ringbuf_init(&_incoming_ringbuf, _buf, sizeof(_buf));
+    _reset_output();
 }
 
 void websocket_handoff(socketpool_socket_obj_t *socket) {
@@ -51,6 +105,11 @@ void websocket_handoff(socketpool_socket_obj_t *socket) {
     cp_serial.opcode = 0;
     cp_serial.frame_index = 0;
     cp_serial.frame_len = 2;
+    cp_serial.binary = false;
+    _reset_output();
+    // Output is already combined into frames here, so don't let TCP hold it back too.
+    int nodelay = 1;
+    common_hal_socketpool_socket_setsockopt(&cp_serial.socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
 
     #if CIRCUITPY_STATUS_BAR
     // Send the title bar for the new client.
@@ -72,16 +131,42 @@ static bool _read_byte(uint8_t *c) {
     return true;
 }
 
+// XOR len bytes with the frame mask, starting offset bytes into the payload.
+static void _unmask(uint8_t *buf, size_t len, size_t offset) {
+    uint8_t mask[4];
+    for (size_t i = 0; i < 4; i++) {
+        mask[i] = cp_serial.mask[(offset + i) % 4];
+    }
+    uint32_t mask_word;
+    memcpy(&mask_word, mask, sizeof(mask_word));
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4) {
+        uint32_t word;
+        memcpy(&word, buf + i, sizeof(word));
+        word ^= mask_word;
+        memcpy(buf + i, &word, sizeof(word));
+    }
+    for (; i < len; i++) {
+        buf[i] ^= mask[i % 4];
+    }
+}
+
+static void _finish_sending(void);
+
 static void _read_next_frame_header(void) {
     uint8_t h;
     if (cp_serial.frame_index == 0 && _read_byte(&h)) {
         cp_serial.frame_index++;
         cp_serial.opcode = h & 0xf;
+        if (cp_serial.opcode == 0x2) {
+            cp_serial.binary = true;
+        }
     }
     if (cp_serial.frame_index == 1 && _read_byte(&h)) {
         cp_serial.frame_index++;
         uint8_t len = h & 0x7f;
         cp_serial.masked = (h >> 7) == 1;
+        cp_serial.payload_remaining = 0;
         if (len <= 125) {
             cp_serial.payload_remaining = len;
             cp_serial.payload_len_size = 0;
@@ -119,6 +204,8 @@ static void _read_next_frame_header(void) {
             if (cp_serial.opcode == 0x9) {
                 opcode = 0xA; // PONG
             }
+            // Don't split a console frame that is partly sent.
+            _finish_sending();
             uint8_t frame_header[2];
             frame_header[0] = 1 << 7 | opcode;
             frame_header[1] = cp_serial.payload_remaining;
@@ -126,7 +213,10 @@ static void _read_next_frame_header(void) {
         }
 
         if (cp_serial.payload_remaining > 0 && _read_byte(&h)) {
-            // Send the payload back to the client.
+            // Send the payload back to the client, unmasked as server frames must be.
+            if (cp_serial.masked) {
+                _unmask(&h, 1, cp_serial.frame_index - cp_serial.frame_len);
+            }
             cp_serial.frame_index++;
             cp_serial.payload_remaining--;
             web_workflow_send_raw(&cp_serial.socket, false, &h, 1);
@@ -137,27 +227,33 @@ static void _read_next_frame_header(void) {
             if (cp_serial.opcode == 0x8) {
                 common_hal_socketpool_socket_close(&cp_serial.socket);
             }
+        } else {
+            break;
         }
     }
 }
 
-static bool _read_next_payload_byte(uint8_t *c) {
+// Read up to len bytes of text, binary or continuation frame payload.
+static size_t _read_payload(uint8_t *buf, size_t len) {
     _read_next_frame_header();
-    if (cp_serial.opcode == 0x1 &&
-        cp_serial.frame_index >= cp_serial.frame_len &&
-        cp_serial.payload_remaining > 0) {
-        if (_read_byte(c)) {
-            uint8_t mask_offset = (cp_serial.frame_index - cp_serial.frame_len) % 4;
-            *c ^= cp_serial.mask[mask_offset];
-            cp_serial.frame_index++;
-            cp_serial.payload_remaining--;
-            if (cp_serial.payload_remaining == 0) {
-                cp_serial.frame_index = 0;
-            }
-            return true;
-        }
+    if (cp_serial.opcode > 0x2 ||
+        cp_serial.frame_index < cp_serial.frame_len ||
+        cp_serial.payload_remaining == 0) {
+        return 0;
     }
-    return false;
+    int got = socketpool_socket_recv_into(&cp_serial.socket, buf, MIN(len, cp_serial.payload_remaining));
+    if (got < 1) {
+        return 0;
+    }
+    if (cp_serial.masked) {
+        _unmask(buf, got, cp_serial.frame_index - cp_serial.frame_len);
+    }
+    cp_serial.frame_index += got;
+    cp_serial.payload_remaining -= got;
+    if (cp_serial.payload_remaining == 0) {
+        cp_serial.frame_index = 0;
+    }
+    return got;
 }
 
 uint32_t websocket_available(void) {
@@ -176,43 +272,142 @@ char websocket_read_char(void) {
     return -1;
 }
 
-static void _websocket_send(_websocket *ws, const char *text, size_t len) {
-    if (!websocket_connected()) {
+// Send as much of the current frame as the socket takes without waiting. Returns
+// true once all of it is sent.
+static bool _send_more(void) {
+    while (_sending->start < _sending->end) {
+        int sent = socketpool_socket_send(&cp_serial.socket, _sending->buf + _sending->start, _sending->end - _sending->start);
+        if (sent == -MP_EAGAIN) {
+            return false;
+        }
+        if (sent <= 0) {
+            // The connection is gone.
+            _sending->start = _sending->end;
+            break;
+        }
+        _sending->start += sent;
+    }
+    return true;
+}
+
+static void _finish_sending(void) {
+    if (_sending->start < _sending->end) {
+        web_workflow_send_raw(&cp_serial.socket, false, _sending->buf + _sending->start, _sending->end - _sending->start);
+        _sending->start = _sending->end;
+    }
+}
+
+// Returns how many bytes at the end of buf are an incomplete UTF-8 character.
+static size_t _incomplete_utf8(const uint8_t *buf, size_t len) {
+    size_t continuation = 0;
+    while (continuation < len && continuation < 3 && (buf[len - 1 - continuation] & 0xc0) == 0x80) {
+        continuation++;
+    }
+    if (continuation == len) {
+        return 0;
+    }
+    uint8_t lead = buf[len - 1 - continuation];
+    size_t needed = lead >= 0xf0 ? 3 : lead >= 0xe0 ? 2 : lead >= 0xc0 ? 1 : 0;
+    return needed > continuation ? continuation + 1 : 0;
+}
+
+// Turn the collected output into the frame to send. The previous frame must be sent.
+static void _start_frame(void) {
+    _websocket_frame *frame = _collecting;
+    size_t len = frame->end - WEBSOCKET_HEADER_MAX;
+    // Text frames must be valid UTF-8, so hold back a character that isn't complete yet.
+    size_t held = cp_serial.binary ? 0 : _incomplete_utf8(frame->buf + WEBSOCKET_HEADER_MAX, len);
+    if (held == len) {
         return;
     }
-    uint32_t opcode = 1;
-    uint8_t frame_header[2];
-    frame_header[0] = 1 << 7 | opcode;
-    uint8_t payload_len;
+    len -= held;
+    _collecting = _sending;
+    _sending = frame;
+    memcpy(_collecting->buf + WEBSOCKET_HEADER_MAX, frame->buf + WEBSOCKET_HEADER_MAX + len, held);
+    _collecting->end = WEBSOCKET_HEADER_MAX + held;
+
+    frame->end = WEBSOCKET_HEADER_MAX + len;
     if (len <= 125) {
-        payload_len = len;
-    } else if (len < (1 << 16)) {
-        payload_len = 126;
+        frame->start = WEBSOCKET_HEADER_MAX - 2;
+        frame->buf[frame->start + 1] = len;
     } else {
-        payload_len = 127;
-    }
-    frame_header[1] = payload_len;
-    web_workflow_send_raw(&ws->socket, false, (const uint8_t *)frame_header, 2);
-    uint8_t extended_len[4];
-    if (payload_len == 126) {
-        extended_len[0] = (len >> 8) & 0xff;
-        extended_len[1] = len & 0xff;
-        web_workflow_send_raw(&ws->socket, false, extended_len, 2);
-    } else if (payload_len == 127) {
-        uint32_t zero = 0;
-        // 64 bits where top four bytes are zero.
-        web_workflow_send_raw(&ws->socket, false, (const uint8_t *)&zero, 4);
-        extended_len[0] = (len >> 24) & 0xff;
-        extended_len[1] = (len >> 16) & 0xff;
-        extended_len[2] = (len >> 8) & 0xff;
-        extended_len[3] = len & 0xff;
-        web_workflow_send_raw(&ws->socket, false, extended_len, 4);
-    }
-    web_workflow_send_raw(&ws->socket, false, (const uint8_t *)text, len);
+        frame->start = WEBSOCKET_HEADER_MAX - 4;
+        frame->buf[frame->start + 1] = 126;
+        frame->buf[frame->start + 2] = (len >> 8) & 0xff;
+        frame->buf[frame->start + 3] = len & 0xff;
+    }
+    uint8_t opcode = cp_serial.binary ? 0x2 : 0x1;
+    frame->buf[frame->start] = 1 << 7 | opcode;
+}
+
+// Called from interrupt context, so only ask for the background to run.
+static void _websocket_flush_due(void *unused) {
+    _flush_due = true;
+    supervisor_workflow_request_background();
+}
+
+static void _schedule_flush(void) {
+    if (!_flush_deadline.queued) {
+        supervisor_deadline_schedule(&_flush_deadline,
+            port_get_raw_ticks(NULL) + (CIRCUITPY_WEBSOCKET_FLUSH_MS * 1024) / 1000 + 1,
+            _websocket_flush_due, NULL);
+    }
+}
+
+// Send whatever can go out without waiting. Collected output is only framed once
+// its flush deadline has passed or the buffer is full, unless forced.
+static void _websocket_output(bool force) {
+    if (!_send_more()) {
+        // Try again once the client has had time to read.
+        _schedule_flush();
+        return;
+    }
+    if (_collecting->end == WEBSOCKET_HEADER_MAX) {
+        return;
+    }
+    if (!force && !_flush_due && _collecting->end < sizeof(_collecting->buf)) {
+        return;
+    }
+    _flush_due = false;
+    _start_frame();
+    if (!_send_more()) {
+        _schedule_flush();
+    }
 }
 
 void websocket_write(const char *text, size_t len) {
-    _websocket_send(&cp_serial, text, len);
+    if (!websocket_connected()) {
+        _reset_output();
+        return;
+    }
+    uint64_t give_up = 0;
+    while (len > 0) {
+        size_t room = sizeof(_collecting->buf) - _collecting->end;
+        if (room == 0) {
+            _websocket_output(true);
+            room = sizeof(_collecting->buf) - _collecting->end;
+        }
+        if (room == 0) {
+            // Both frames are waiting on the client. Give it a little while, and then
+            // drop the output rather than stall the program.
+            uint64_t now = supervisor_ticks_ms64();
+            if (give_up == 0) {
+                give_up = now + CIRCUITPY_WEBSOCKET_WRITE_TIMEOUT_MS;
+            } else if (now >= give_up || !websocket_connected()) {
+                break;
+            }
+            port_yield();
+            continue;
+        }
+        size_t chunk = MIN(len, room);
+        memcpy(_collecting->buf + _collecting->end, text, chunk);
+        _collecting->end += chunk;
+        text += chunk;
+        len -= chunk;
+    }
+    if (_collecting->end > WEBSOCKET_HEADER_MAX) {
+        _schedule_flush();
+    }
 }
 
 void websocket_background(void) {
@@ -223,14 +418,21 @@ void websocket_background(void) {
         return;
     }
     in_web_background = true;
-    uint8_t c;
-    while (ringbuf_num_empty(&_incoming_ringbuf) > 0 &&
-           _read_next_payload_byte(&c)) {
-        if (c == mp_interrupt_char) {
-            mp_sched_keyboard_interrupt();
-            continue;
+    _websocket_output(false);
+    uint8_t chunk[sizeof(_buf)];
+    size_t room;
+    while ((room = ringbuf_num_empty(&_incoming_ringbuf)) > 0) {
+        size_t len = _read_payload(chunk, room);
+        if (len == 0) {
+            break;
+        }
+        for (size_t i = 0; i < len; i++) {
+            if (chunk[i] == mp_interrupt_char) {
+                mp_sched_keyboard_interrupt();
+                continue;
+            }
+            ringbuf_put(&_incoming_ringbuf, chunk[i]);
         }
-        ringbuf_put(&_incoming_ringbuf, c);
     }
     in_web_background = false;
 }
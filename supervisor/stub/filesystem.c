@@ -7,12 +7,7 @@
 #include "supervisor/filesystem.h"
 
 
-void filesystem_background(void) {
-    return;
-}
-
-void filesystem_tick(void) {
-    return;
+void filesystem_schedule_flush(void) {
 }
 
 bool filesystem_init(bool create_allowed, bool force_create) {
@@ -24,6 +19,10 @@ bool filesystem_init(bool create_allowed, bool force_create) {
 void filesystem_flush(void) {
 }
 
+void filesystem_defer_flush(bool defer) {
+    (void)defer;
+}
+
 void filesystem_set_internal_writable_by_usb(bool writable) {
     (void)writable;
     return;
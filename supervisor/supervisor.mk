@@ -8,6 +8,7 @@ SRC_SUPERVISOR = \
 	supervisor/shared/fatfs.c \
 	supervisor/shared/flash.c \
 	supervisor/shared/lock.c \
+	supervisor/shared/memory.c \
 	supervisor/shared/micropython.c \
 	supervisor/shared/port.c \
 	supervisor/shared/reload.c \
@@ -103,6 +104,24 @@ ifneq ($(wildcard supervisor/serial.c),)
   SRC_SUPERVISOR += supervisor/serial.c
 endif
 
+ifeq ($(CIRCUITPY_BOOT_TIMING),1)
+  SRC_SUPERVISOR += \
+    supervisor/shared/boot_timing.c \
+
+endif
+
+ifeq ($(CIRCUITPY_SUPERVISOR_TRACE),1)
+  SRC_SUPERVISOR += \
+    supervisor/shared/trace.c \
+
+endif
+
+ifeq ($(CIRCUITPY_CODE_CACHE),1)
+  SRC_SUPERVISOR += \
+    supervisor/shared/code_cache.c \
+
+endif
+
 ifeq ($(CIRCUITPY_STATUS_BAR),1)
   SRC_SUPERVISOR += \
     supervisor/shared/status_bar.c \
@@ -0,0 +1,83 @@
+# test that list.sort is stable, adaptive and calls the key function once per item
+
+seed = 1
+
+
+def rand(n):
+    global seed
+    seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+    return seed % n
+
+
+def check(l):
+    s = sorted(l)
+    for i in range(1, len(s)):
+        if s[i] < s[i - 1]:
+            return False
+    return True
+
+
+# various sizes and shapes, including runs longer and shorter than the minimum run
+ok = True
+for n in (0, 1, 2, 3, 10, 31, 32, 63, 64, 65, 100, 257, 1000):
+    l = [rand(n + 1) for _ in range(n)]
+    ok = ok and check(l)
+    ok = ok and check(list(range(n)))
+    ok = ok and check(list(range(n, 0, -1)))
+    ok = ok and check([rand(3) for _ in range(n)])
+    ok = ok and check(list(range(n // 2)) + list(range(n // 2)))
+    ok = ok and check(list(range(n)) + [rand(n + 1) for _ in range(5)])
+print(ok)
+
+# stability: equal keys keep their original order, also with reverse
+l = [(rand(5), i) for i in range(200)]
+print(sorted(l, key=lambda x: x[0]) == sorted(l))
+r = sorted(l, key=lambda x: x[0], reverse=True)
+print(all(r[i][0] > r[i + 1][0] or r[i][1] < r[i + 1][1] for i in range(len(r) - 1)))
+l.sort(key=lambda x: x[0])
+print(l[:8])
+
+# the key function is called exactly once per item
+calls = []
+
+
+def key(x):
+    calls.append(x)
+    return -x
+
+
+l = list(range(50))
+l.sort(key=key)
+print(len(calls), l[:5])
+
+
+# a failing comparison leaves the list as a permutation of its items
+class A:
+    def __init__(self, x):
+        self.x = x
+
+    def __lt__(self, other):
+        global budget
+        budget -= 1
+        if budget < 0:
+            raise ValueError
+        return self.x < other.x
+
+
+items = [A(rand(100)) for _ in range(300)]
+for budget_start in (10, 500, 5000):
+    l = list(items)
+    budget = budget_start
+    try:
+        l.sort()
+    except ValueError:
+        print("ValueError")
+    print(sorted(id(x) for x in l) == sorted(id(x) for x in items))
+
+# a failing key function leaves the list unchanged
+l = [3, 1, 2, "a"]
+try:
+    l.sort(key=lambda x: x + 1)
+except TypeError:
+    print("TypeError")
+print(l)
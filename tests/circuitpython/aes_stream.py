@@ -0,0 +1,44 @@
+import aesio
+from binascii import hexlify, unhexlify
+from io import BytesIO
+
+key = b"Sixteen byte key"
+iv = bytes(range(16))
+data = bytes((i * 7) & 0xFF for i in range(1000))
+
+for mode, n in ((aesio.MODE_CTR, 1000), (aesio.MODE_CBC, 992), (aesio.MODE_ECB, 992)):
+    ref = bytearray(n)
+    c = aesio.AES(key, mode, iv)
+    if mode == aesio.MODE_ECB:
+        for i in range(0, n, 16):
+            c.encrypt_into(data[i : i + 16], memoryview(ref)[i : i + 16])
+    else:
+        c.encrypt_into(data[:n], ref)
+    for buf in (None, bytearray(16), bytearray(40), bytearray(4096)):
+        out = BytesIO()
+        c = aesio.AES(key, mode, iv)
+        print(c.encrypt_stream(BytesIO(data[:n]), out, buf), out.getvalue() == ref)
+        back = BytesIO()
+        c = aesio.AES(key, mode, iv)
+        print(c.decrypt_stream(BytesIO(out.getvalue()), back, buf), back.getvalue() == data[:n])
+
+c = aesio.AES(key, aesio.MODE_CBC, iv)
+try:
+    c.encrypt_stream(BytesIO(b"x" * 17), BytesIO())
+except ValueError as e:
+    print("ValueError", e)
+try:
+    c.encrypt_stream(BytesIO(b""), BytesIO(), bytearray(8))
+except ValueError as e:
+    print("ValueError", e)
+print(c.encrypt_stream(BytesIO(b""), BytesIO()))
+
+# FIPS-197 appendix C vectors for every key size
+pt = unhexlify("00112233445566778899aabbccddeeff")
+for n in (16, 24, 32):
+    c = aesio.AES(bytes(range(n)), aesio.MODE_ECB)
+    o = bytearray(16)
+    c.encrypt_into(pt, o)
+    print(hexlify(o))
+    c.decrypt_into(o, o)
+    print(o == pt)
@@ -0,0 +1,55 @@
+# Test the ready FIFO and timer heap inside _asyncio.TaskQueue.
+import time
+import _asyncio
+
+TaskQueue = _asyncio.TaskQueue
+Task = _asyncio.Task
+
+MASK = (1 << 29) - 1
+
+
+def now():
+    return time.ticks_ms() & MASK
+
+
+def coro(i):
+    yield i
+
+
+q = TaskQueue()
+print(q.peek())
+try:
+    q.pop()
+except IndexError:
+    print("IndexError")
+
+tasks = [Task(coro(i), {}) for i in range(8)]
+
+# Due tasks come out in push order, sleeping ones by deadline.
+t0 = now()
+q.push(tasks[0], (t0 + 1000) & MASK)
+q.push(tasks[1])
+q.push(tasks[2], (t0 + 500) & MASK)
+q.push(tasks[3])
+q.push(tasks[4], (t0 - 100) & MASK)
+q.push(tasks[5])
+order = []
+while q.peek() is not None:
+    t = q.peek()
+    assert q.pop() is t
+    order.append(tasks.index(t))
+print(order)
+
+# Removing from the middle and ends of the ready queue.
+for t in tasks[:5]:
+    q.push(t)
+q.remove(tasks[0])
+q.remove(tasks[2])
+q.remove(tasks[4])
+q.push(tasks[6])
+q.push(tasks[7], (t0 + 2000) & MASK)
+q.remove(tasks[7])
+order = []
+while q.peek() is not None:
+    order.append(tasks.index(q.pop()))
+print(order)
@@ -0,0 +1,38 @@
+# Voices whose sample rate differs from the mixer's are linearly resampled.
+import array
+import audiocore
+import audiomixer
+
+
+def mix(channel_count, sample_rate, data, level=1.0):
+    sample = audiocore.RawSample(
+        array.array("h", data), channel_count=channel_count, sample_rate=sample_rate
+    )
+    mixer = audiomixer.Mixer(
+        voice_count=1, buffer_size=64, channel_count=channel_count, sample_rate=8000
+    )
+    mixer.voice[0].level = level
+    mixer.voice[0].play(sample)
+    print(list(memoryview(audiocore.get_buffer(mixer)[1]).cast("h")))
+
+
+ramp = [i * 1000 for i in range(8)]
+
+# same rate: copied through
+mix(1, 8000, ramp)
+
+# upsampling, mono and stereo
+mix(1, 4000, ramp)
+mix(2, 4000, [v for i in ramp for v in (i, -i)])
+mix(2, 4000, [v for i in ramp for v in (i, -i)], level=0.5)
+
+# downsampling
+mix(1, 12000, ramp)
+
+# mismatched 8-bit samples are still rejected
+sample = audiocore.RawSample(array.array("b", [0] * 8), sample_rate=4000)
+mixer = audiomixer.Mixer(voice_count=1, channel_count=1, bits_per_sample=8, sample_rate=8000)
+try:
+    mixer.voice[0].play(sample)
+except ValueError as e:
+    print("ValueError")
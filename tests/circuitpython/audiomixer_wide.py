@@ -0,0 +1,51 @@
+# With wide_accumulator, voices are summed at 32 bits and saturated only once.
+import array
+import audiocore
+import audiomixer
+
+
+def mix(wide, voices, bits_per_sample=16, samples_signed=True, levels=None):
+    mixer = audiomixer.Mixer(
+        voice_count=len(voices),
+        buffer_size=32,
+        channel_count=1,
+        bits_per_sample=bits_per_sample,
+        samples_signed=samples_signed,
+        sample_rate=8000,
+        wide_accumulator=wide,
+    )
+    for i, (typecode, data, sample_rate) in enumerate(voices):
+        if levels:
+            mixer.voice[i].level = levels[i]
+        sample = audiocore.RawSample(array.array(typecode, data), sample_rate=sample_rate)
+        mixer.voice[i].play(sample)
+    buf = audiocore.get_buffer(mixer)[1]
+    if bits_per_sample == 16:
+        buf = memoryview(buf).cast("H" if not samples_signed else "h")
+    print(list(buf))
+
+
+loud = [30000, 20000, -30000, 0, 100, -100, 32767, -32768]
+quiet = [-30000, 20000, 30000, 0, 100, -100, -32767, 32767]
+voices = [("h", loud, 8000), ("h", loud, 8000), ("h", quiet, 8000)]
+
+# intermediate sums saturate with the default engine but not the wide one
+mix(False, voices)
+mix(True, voices)
+mix(True, voices, levels=(0.5, 0.25, 1.0))
+
+# unsigned 16-bit
+unsigned = [v + 32768 for v in loud]
+mix(True, [("H", unsigned, 8000), ("H", unsigned, 8000)], samples_signed=False)
+
+# 8-bit signed and unsigned
+mix(True, [("b", [100, -100, 50, 0], 8000), ("b", [100, -100, -50, 1], 8000)], bits_per_sample=8)
+mix(
+    True,
+    [("B", [228, 28, 178, 128], 8000), ("B", [228, 28, 78, 129], 8000)],
+    bits_per_sample=8,
+    samples_signed=False,
+)
+
+# a resampled voice mixed with one at the mixer's rate
+mix(True, [("h", loud, 4000), ("h", quiet, 8000)])
@@ -39,3 +39,44 @@ dump_bitmap(b)
 b = make_circle_bitmap()
 bitmapfilter.morph(b, weights=sharpen, threshold=True, add=0.125, invert=True)
 dump_bitmap(b)
+
+
+# Separable and box kernels take a faster path; the results must match the
+# full 2-D convolution, including at the edges and with mask or threshold.
+def make_noise_bitmap():
+    b = Bitmap(23, 19, 65536)
+    s = 1
+    for i in range(b.width * b.height):
+        s = (s * 1103515245 + 12345) & 0x7FFFFFFF
+        b[i] = s >> 15 & 0xFFFF
+    return b
+
+
+def checksum(b):
+    c = 0
+    for i in range(b.width * b.height):
+        c = (c * 31 + b[i]) & 0xFFFFFF
+    return c
+
+
+box3 = [1] * 9
+box5 = [1] * 25
+gauss5 = [a * b for a in (1, 4, 6, 4, 1) for b in (1, 4, 6, 4, 1)]
+sobel = [-1, 0, 1, -2, 0, 2, -1, 0, 1]
+ring = [1, 1, 1, 1, 0, 1, 1, 1, 1]
+for name, weights in (
+    ("box3", box3),
+    ("box5", box5),
+    ("gauss5", gauss5),
+    ("sobel", sobel),
+    ("ring", ring),
+):
+    b = make_noise_bitmap()
+    bitmapfilter.morph(b, weights)
+    print(name, checksum(b))
+    b = make_noise_bitmap()
+    bitmapfilter.morph(b, weights, add=0.25, mask=make_quadrant_bitmap())
+    print(name, "mask", checksum(b))
+    b = make_noise_bitmap()
+    bitmapfilter.morph(b, weights, threshold=True, offset=3)
+    print(name, "threshold", checksum(b))
@@ -0,0 +1,72 @@
+from displayio import Bitmap, Palette
+import bitmapfilter
+
+
+def make_noise_bitmap():
+    b = Bitmap(23, 19, 65536)
+    s = 7
+    for i in range(b.width * b.height):
+        s = (s * 1103515245 + 12345) & 0x7FFFFFFF
+        b[i] = s >> 15 & 0xFFFF
+    return b
+
+
+def make_quadrant_bitmap():
+    b = Bitmap(23, 19, 1)
+    for i in range(b.height):
+        for j in range(b.width):
+            b[j, i] = (i < 8) ^ (j < 11)
+    return b
+
+
+def same(a, b):
+    return all(a[i] == b[i] for i in range(a.width * a.height))
+
+
+def gamma(x):
+    return x**0.6
+
+
+palette = Palette(256)
+for i in range(256):
+    palette[i] = (i << 16) | ((255 - i) << 8) | (i ^ 0x55)
+
+sepia = bitmapfilter.ChannelMixer(0.393, 0.769, 0.189, 0.349, 0.686, 0.168, 0.272, 0.534, 0.131)
+blur = [1, 2, 1, 2, 4, 2, 1, 2, 1]
+sharpen = [0, -1, 0, -1, 5, -1, 0, -1, 0]
+
+pipeline = bitmapfilter.Pipeline()
+print(pipeline.lookup(gamma) is pipeline)
+pipeline.mix(sepia).solarize(0.6).morph(blur).false_color(palette).morph(sharpen, threshold=True)
+
+
+def separately(b, mask=None):
+    bitmapfilter.lookup(b, gamma, mask=mask)
+    bitmapfilter.mix(b, sepia, mask=mask)
+    bitmapfilter.solarize(b, 0.6, mask=mask)
+    bitmapfilter.morph(b, blur, mask=mask)
+    bitmapfilter.false_color(b, palette, mask=mask)
+    bitmapfilter.morph(b, sharpen, threshold=True, mask=mask)
+
+
+for mask in (None, make_quadrant_bitmap()):
+    b1 = make_noise_bitmap()
+    b2 = make_noise_bitmap()
+    separately(b1, mask)
+    print(pipeline.apply(b2, mask=mask) is b2)
+    print(same(b1, b2))
+
+# An empty pipeline leaves the bitmap alone
+b1 = make_noise_bitmap()
+bitmapfilter.Pipeline().apply(b1)
+print(same(b1, make_noise_bitmap()))
+
+try:
+    pipeline.apply(Bitmap(4, 4, 256))
+except ValueError as e:
+    print("ValueError", e)
+
+try:
+    bitmapfilter.Pipeline().morph([1, 2])
+except ValueError as e:
+    print("ValueError")
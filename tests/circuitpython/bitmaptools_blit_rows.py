@@ -0,0 +1,58 @@
+# Compare bitmaptools.blit() without skip indices against a pixel by pixel copy.
+import displayio
+import bitmaptools
+
+
+def pattern(bmp, value_count, seed):
+    for y in range(bmp.height):
+        for x in range(bmp.width):
+            bmp[x, y] = (x * 7 + y * 13 + seed) % value_count
+
+
+def reference(dest, src, x, y, x1, y1, x2, y2):
+    pixels = [[src[i, j] for i in range(x1, x2)] for j in range(y1, y2)]
+    for j, row in enumerate(pixels):
+        for i, value in enumerate(row):
+            if x + i < dest.width and y + j < dest.height:
+                dest[x + i, y + j] = value
+
+
+def same(a, b):
+    for y in range(a.height):
+        for x in range(a.width):
+            if a[x, y] != b[x, y]:
+                return False
+    return True
+
+
+blits = (
+    (0, 0, 0, 0, 37, 9),
+    (3, 2, 5, 1, 30, 8),
+    (31, 1, 0, 0, 20, 5),  # clipped at the right
+    (1, 7, 2, 0, 35, 9),  # clipped at the bottom
+    (0, 0, 33, 3, 34, 4),  # single pixel
+)
+
+for value_count in (2, 4, 16, 256, 65536):
+    src = displayio.Bitmap(37, 9, value_count)
+    pattern(src, value_count, 1)
+    ok = True
+    for args in blits:
+        dest = displayio.Bitmap(40, 11, value_count)
+        expected = displayio.Bitmap(40, 11, value_count)
+        pattern(dest, value_count, 5)
+        pattern(expected, value_count, 5)
+        bitmaptools.blit(dest, src, *args[:2], x1=args[2], y1=args[3], x2=args[4], y2=args[5])
+        reference(expected, src, *args)
+        ok = ok and same(dest, expected)
+
+    # Overlapping copies within one bitmap.
+    for args in ((4, 0, 0, 0, 30, 9), (0, 0, 4, 0, 37, 9), (0, 3, 0, 0, 37, 6), (0, 0, 0, 3, 37, 9)):
+        bmp = displayio.Bitmap(37, 9, value_count)
+        expected = displayio.Bitmap(37, 9, value_count)
+        pattern(bmp, value_count, 2)
+        pattern(expected, value_count, 2)
+        bitmaptools.blit(bmp, bmp, *args[:2], x1=args[2], y1=args[3], x2=args[4], y2=args[5])
+        reference(expected, expected, *args)
+        ok = ok and same(bmp, expected)
+    print(value_count, ok)
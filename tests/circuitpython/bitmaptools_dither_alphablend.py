@@ -0,0 +1,51 @@
+import bitmaptools
+import displayio
+
+
+def noise(w, h, bits, seed):
+    b = displayio.Bitmap(w, h, 1 << bits)
+    s = seed
+    for i in range(w * h):
+        s = (s * 1103515245 + 12345) & 0x7FFFFFFF
+        b[i] = (s >> 13) & ((1 << bits) - 1)
+    return b
+
+
+def checksum(b):
+    c = 0
+    for i in range(b.width * b.height):
+        c = (c * 31 + b[i]) & 0xFFFFFF
+    return c
+
+
+C = displayio.Colorspace
+for cs in (C.RGB565, C.RGB565_SWAPPED, C.BGR565):
+    for f1, f2 in ((0.5, None), (1, 0.25), (0.3, 0.9), (0.25, 0), (0, 0.7), (1, 1)):
+        for mode in (bitmaptools.BlendMode.Normal, bitmaptools.BlendMode.Screen):
+            d = displayio.Bitmap(13, 7, 65536)
+            bitmaptools.alphablend(
+                d, noise(13, 7, 16, 1), noise(13, 7, 16, 2), cs, f1, f2, blendmode=mode
+            )
+            print(cs, f1, f2, mode, checksum(d))
+
+for f1, f2 in ((0.5, None), (1, 0.25), (0.3, 0.9), (0.25, 0)):
+    d = displayio.Bitmap(13, 7, 256)
+    bitmaptools.alphablend(d, noise(13, 7, 8, 1), noise(13, 7, 8, 2), C.L8, f1, f2)
+    print("L8", f1, f2, checksum(d))
+
+# Pixels matching a skip index take only the other source
+s1 = noise(13, 7, 16, 1)
+s2 = noise(13, 7, 16, 2)
+for cs in (C.RGB565, C.RGB565_SWAPPED):
+    d = displayio.Bitmap(13, 7, 65536)
+    bitmaptools.alphablend(d, s1, s2, cs, 0.75, skip_source1_index=s1[3], skip_source2_index=s2[5])
+    print(cs, "skip", d[3], d[5], checksum(d))
+
+# 1bpp output rows are packed a word at a time, in both scan directions
+for w in (1, 31, 32, 33, 70):
+    for alg in (bitmaptools.DitherAlgorithm.Atkinson, bitmaptools.DitherAlgorithm.FloydStenberg):
+        src = noise(w, 5, 16, w)
+        for bits in (1, 16):
+            d = displayio.Bitmap(w, 5, 1 << bits)
+            bitmaptools.dither(d, src, C.RGB565, alg)
+            print("dither", w, bits, checksum(d))
@@ -0,0 +1,48 @@
+import bitops
+
+
+def reference(data, width):
+    stride = len(data) // width
+    out_bytes = 2 if width > 8 else 1
+    result = bytearray(8 * stride * out_bytes)
+    for i in range(stride):
+        for bit in range(8):
+            o = (8 * i + bit) * out_bytes
+            for strand in range(width):
+                if data[strand * stride + i] & (0x80 >> bit):
+                    result[o + strand // 8] |= 1 << (strand % 8)
+    return result
+
+
+seed = 1
+
+
+def random_bytes(n):
+    global seed
+    result = bytearray(n)
+    for i in range(n):
+        seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+        result[i] = (seed >> 16) & 0xFF
+    return result
+
+
+for width in range(2, 17):
+    data = random_bytes(3 * width)
+    out = bytearray(48 if width > 8 else 24)
+    bitops.bit_transpose(data, out, width)
+    print(width, out == reference(data, width))
+
+data = bytes(range(1, 17))
+print(bitops.bit_transpose(data, bytearray(16), 16).hex())
+print(bitops.bit_transpose(data[:9], bytearray(16), 9).hex())
+
+for width in (1, 17):
+    try:
+        bitops.bit_transpose(bytes(width), bytearray(32), width)
+    except ValueError as e:
+        print("ValueError", e)
+
+try:
+    bitops.bit_transpose(bytes(10), bytearray(15), 10)
+except ValueError as e:
+    print("ValueError", e)
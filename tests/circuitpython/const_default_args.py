@@ -0,0 +1,51 @@
+# Constant positional defaults are loaded as a single tuple constant.
+
+
+def f(a, b=1, c=(2, "three"), d=None, e=-4.5, *args, **kwargs):
+    return a, b, c, d, e, args, kwargs
+
+
+print(f(0))
+print(f(0, 10, e=5))
+print(f(0, 1, 2, 3, 4, 5, x=6))
+
+# Defaults that aren't constants are still evaluated each time the def runs.
+n = 0
+for i in range(2):
+
+    def g(x=i, y=[]):
+        y.append(x)
+        return y
+
+    print(g(), g())
+
+# Keyword-only defaults keep the old path.
+def h(a=1, *, b=(2,)):
+    return a, b
+
+
+print(h(), h(b=3))
+
+# Annotated parameters and lambdas.
+def k(a: int = 7, b: str = "s"):
+    return a, b
+
+
+print(k(), (lambda x=1, y=2: x + y)())
+
+# A default that is itself an argument-less lambda.
+def m(a=lambda z=3: z):
+    return a()
+
+
+print(m())
+
+# Each def makes its own function object from the same constant defaults.
+fs = []
+for i in range(3):
+
+    def p(v=5):
+        return v
+
+    fs.append(p)
+print([q() for q in fs], fs[0] is fs[1])
@@ -0,0 +1,74 @@
+import binascii
+from crc import CRC
+
+CHECK = b"123456789"
+
+# name, width, polynomial, initial, reflect_input, reflect_output, final_xor
+catalogue = (
+    ("CRC-3/ROHC", 3, 0x3, 0x7, True, True, 0x0),
+    ("CRC-5/USB", 5, 0x05, 0x1F, True, True, 0x1F),
+    ("CRC-8/SMBUS", 8, 0x07, 0x00, False, False, 0x00),
+    ("CRC-8/MAXIM-DOW", 8, 0x31, 0x00, True, True, 0x00),
+    ("CRC-12/UMTS", 12, 0x80F, 0x000, False, True, 0x000),
+    ("CRC-16/MODBUS", 16, 0x8005, 0xFFFF, True, True, 0x0000),
+    ("CRC-16/IBM-3740", 16, 0x1021, 0xFFFF, False, False, 0x0000),
+    ("CRC-16/XMODEM", 16, 0x1021, 0x0000, False, False, 0x0000),
+    ("CRC-24/OPENPGP", 24, 0x864CFB, 0xB704CE, False, False, 0x000000),
+    ("CRC-32/ISO-HDLC", 32, 0x04C11DB7, 0xFFFFFFFF, True, True, 0xFFFFFFFF),
+    ("CRC-32/BZIP2", 32, 0x04C11DB7, 0xFFFFFFFF, False, False, 0xFFFFFFFF),
+    ("CRC-32/MPEG-2", 32, 0x04C11DB7, 0xFFFFFFFF, False, False, 0x00000000),
+    ("CRC-32/ISCSI", 32, 0x1EDC6F41, 0xFFFFFFFF, True, True, 0xFFFFFFFF),
+)
+
+data = bytes((i * 37 + 11) & 0xFF for i in range(101))
+
+for name, width, poly, init, refin, refout, xorout in catalogue:
+    c = CRC(
+        width,
+        poly,
+        initial=init,
+        reflect_input=refin,
+        reflect_output=refout,
+        final_xor=xorout,
+    )
+    c.update(CHECK)
+    check = c.value
+    c.reset()
+    c.update(data)
+    whole = c.value
+    # Pieces of every alignment must give the same CRC as one update.
+    c.reset()
+    i = 0
+    step = 1
+    while i < len(data):
+        c.update(memoryview(data)[i : i + step])
+        i += step
+        step = step % 7 + 1
+    print(name, hex(check), hex(whole), c.value == whole)
+
+zlib = CRC(
+    32,
+    0x04C11DB7,
+    initial=0xFFFFFFFF,
+    reflect_input=True,
+    reflect_output=True,
+    final_xor=0xFFFFFFFF,
+)
+zlib.update(data)
+print(zlib.value == binascii.crc32(data))
+
+empty = CRC(16, 0x1021, initial=0x1D0F)
+print(hex(empty.value))
+
+for args, kwargs in (
+    ((0, 1), {}),
+    ((33, 1), {}),
+    ((8, 0x100), {}),
+    ((8, -1), {}),
+    ((8, 7), {"initial": 0x1FF}),
+    ((32, 7), {"final_xor": 1 << 32}),
+):
+    try:
+        CRC(*args, **kwargs)
+    except ValueError as e:
+        print("ValueError", e)
@@ -0,0 +1,48 @@
+# Palette indexed TileGrids of every bitmap depth, with and without transforms and transparency,
+# drawn onto a 16 bit display. Each checksum must not depend on which pixel loop drew it.
+import displayio
+
+
+def checksum(display):
+    fb = display.framebuffer
+    total = 0
+    for i in range(0, len(fb), 2):
+        total = (total * 31 + (fb[i] | fb[i + 1] << 8)) & 0xFFFFFF
+    return hex(total)
+
+
+display = displayio.NullDisplay(40, 24)
+group = displayio.Group()
+display.root_group = group
+
+background = displayio.Bitmap(40, 24, 1)
+background_palette = displayio.Palette(1)
+background_palette[0] = 0x102030
+group.append(displayio.TileGrid(background, pixel_shader=background_palette))
+
+for bits in (1, 2, 4, 8):
+    colors = 1 << bits
+    palette = displayio.Palette(colors)
+    for i in range(colors):
+        palette[i] = (i * 0x3F1A2B + 0x405060) & 0xFFFFFF
+    palette.make_transparent(colors - 1)
+    bitmap = displayio.Bitmap(12, 8, colors)
+    for y in range(8):
+        for x in range(12):
+            bitmap[x, y] = (x * 3 + y * 5) % colors
+    for options in ({}, {"scale": 2}, {"flip_x": True}, {"flip_y": True, "transpose_xy": True}):
+        scale = options.pop("scale", 1)
+        tile_grid = displayio.TileGrid(
+            bitmap, pixel_shader=palette, width=2, height=2, tile_width=6, tile_height=4
+        )
+        for name, value in options.items():
+            setattr(tile_grid, name, value)
+        tile_grid[0] = 1
+        tile_grid[3] = 2
+        inner = displayio.Group(scale=scale, x=3, y=2)
+        inner.append(tile_grid)
+        group.append(inner)
+        display.refresh()
+        print(bits, scale, sorted(options), checksum(display))
+        group.remove(inner)
+        display.refresh()
@@ -0,0 +1,64 @@
+# Composite groups into the unix port's in-memory display.
+import displayio
+import vectorio
+
+
+def pixel(display, x, y):
+    fb = display.framebuffer
+    i = (y * display.width + x) * 2
+    return fb[i] | fb[i + 1] << 8
+
+
+display = displayio.NullDisplay(32, 16)
+print(display.width, display.height, len(display.framebuffer))
+print(display.root_group)
+
+group = displayio.Group()
+display.root_group = group
+# the first refresh covers the whole display
+print(display.refresh())
+print(display.refresh())
+
+palette = displayio.Palette(2)
+palette[0] = 0x000000
+palette[1] = 0xFF0000
+bitmap = displayio.Bitmap(8, 8, 2)
+bitmap.fill(1)
+tile_grid = displayio.TileGrid(bitmap, pixel_shader=palette, x=4, y=2)
+group.append(tile_grid)
+print(display.refresh())
+print(hex(pixel(display, 4, 2)), hex(pixel(display, 11, 9)), hex(pixel(display, 12, 2)))
+
+# moving dirties the old and the new position
+tile_grid.x = 10
+print(display.refresh())
+print(hex(pixel(display, 4, 2)), hex(pixel(display, 17, 9)))
+
+palette[1] = 0x00FF00
+print(display.refresh())
+print(hex(pixel(display, 10, 2)))
+
+circle = vectorio.Circle(pixel_shader=palette, radius=3, x=26, y=8, color_index=1)
+group.append(circle)
+print(display.refresh())
+print(hex(pixel(display, 26, 8)), hex(pixel(display, 26, 1)))
+
+rectangle = vectorio.Rectangle(pixel_shader=palette, width=4, height=2, x=0, y=14, color_index=1)
+group.append(rectangle)
+print(display.refresh())
+print(hex(pixel(display, 3, 15)), hex(pixel(display, 4, 15)))
+
+try:
+    displayio.NullDisplay(8, 8).root_group = group
+except ValueError as e:
+    print("ValueError:", e)
+
+display.root_group = None
+print(display.root_group, display.refresh())
+
+rotated = displayio.NullDisplay(32, 16, rotation=90)
+print(rotated.width, rotated.height, len(rotated.framebuffer))
+try:
+    displayio.NullDisplay(32, 16, rotation=45)
+except ValueError as e:
+    print("ValueError:", e)
@@ -0,0 +1,36 @@
+# Refresh statistics of the unix port's in-memory display.
+import displayio
+
+
+def show(stats):
+    # Times depend on the machine, so only check that they were recorded.
+    print(stats.frames, stats.frames_skipped, stats.areas, stats.pixels, stats.bytes)
+    print(stats.fill_us >= 0, stats.send_us >= 0)
+
+
+display = displayio.NullDisplay(32, 16)
+show(display.refresh_stats)
+
+group = displayio.Group()
+display.root_group = group
+# the first refresh covers the whole display, two bytes per pixel
+display.refresh()
+show(display.refresh_stats)
+
+# nothing changed
+display.refresh()
+show(display.refresh_stats)
+
+palette = displayio.Palette(1)
+palette[0] = 0xFF0000
+bitmap = displayio.Bitmap(8, 4, 1)
+group.append(displayio.TileGrid(bitmap, pixel_shader=palette, x=2, y=2))
+display.refresh()
+stats = display.refresh_stats
+show(stats)
+print(stats[0] == stats.frames, len(stats))
+
+# a tile grid partly off the display is clipped
+group[0].x = 28
+display.refresh()
+show(display.refresh_stats)
@@ -0,0 +1,40 @@
+# This file is part of the CircuitPython project: https://circuitpython.org
+#
+# SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+#
+# SPDX-License-Identifier: MIT
+
+import gc
+import micropython
+
+try:
+    gc.stats
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+before = gc.stats()
+print(len(before))
+
+gc.collect()
+gc.collect()
+after = gc.stats()
+print(after.collections - before.collections)
+print(after.pause_us >= before.pause_us)
+print(after.max_pause_us >= 0, after.max_pause_us <= after.pause_us)
+
+before = gc.stats()
+buf = bytearray(1000)
+after = gc.stats()
+print(after.allocated_bytes - before.allocated_bytes >= 1000)
+
+before = gc.stats()
+micropython.heap_lock()
+try:
+    bytearray(100)
+except MemoryError:
+    pass
+micropython.heap_unlock()
+after = gc.stats()
+# Raising the MemoryError may fail further allocations of its own.
+print(after.failed_allocs > before.failed_allocs)
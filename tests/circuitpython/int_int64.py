@@ -0,0 +1,55 @@
+# Long-int arithmetic near the 64-bit boundary, where the 64-bit fast path
+# hands over to mpz.
+
+vals = [
+    0,
+    -7,
+    0x3FFFFFFF,
+    -0x40000001,
+    0xFFFFFFFF,
+    1 << 40,
+    -(1 << 40) + 3,
+    0x7FFFFFFFFFFFFFFF,
+    -0x7FFFFFFFFFFFFFFF,
+    -0x8000000000000000,
+    0xFFFFFFFFFFFFFFFF,
+    1 << 64,
+]
+
+ops = [
+    ("+", lambda a, b: a + b),
+    ("-", lambda a, b: a - b),
+    ("*", lambda a, b: a * b),
+    ("//", lambda a, b: a // b),
+    ("%", lambda a, b: a % b),
+    ("&", lambda a, b: a & b),
+    ("|", lambda a, b: a | b),
+    ("^", lambda a, b: a ^ b),
+]
+
+for name, op in ops:
+    for a in vals:
+        row = []
+        for b in vals:
+            try:
+                row.append(op(a, b))
+            except ZeroDivisionError:
+                row.append(None)
+        print(name, a, row)
+
+for a in vals:
+    print(a, [(a << n, a >> n) for n in (0, 1, 33, 62, 63, 64, 100)])
+
+try:
+    (1 << 40) << -1
+except ValueError:
+    print("ValueError")
+try:
+    (1 << 40) >> -1
+except ValueError:
+    print("ValueError")
+
+# Results that shrink back are normal ints.
+x = (1 << 50) + 5
+print(x - (1 << 50), (x - (1 << 50)) == 5, hash(x - (1 << 50)) == hash(5))
+print([(1 << 40) * k for k in range(3)])
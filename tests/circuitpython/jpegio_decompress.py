@@ -52,6 +52,41 @@ E4XThw9iADZbPTTHqvKJf5EPkyA3ddZzZxqd1bIO6PZMoBvapvJasdrfGxW23ywDLbXPYADB1Sa4
 bGuXlnADbup+WcAAAAAAAAAAAAD/2Q=="""
 )
 
+# 64x48 grayscale with a restart marker every 3 MCUs
+content_rst = binascii.a2b_base64(
+    b"""
+/9j/2wBDAAQEBAQEBAQEBAQEBAQEBAQEBAQEBAQEBAQEBAQEBAQEBAQEBAQEBAQEBAQEBAQEBAQE
+BAQEBAQEBAQEBAQEBAT/wAALCAAwAEABAREA/8QAHwAAAQUBAQEBAQEAAAAAAAAAAAECAwQFBgcI
+CQoL/8QAtRAAAgEDAwIEAwUFBAQAAAF9AQIDAAQRBRIhMUEGE1FhByJxFDKBkaEII0KxwRVS0fAk
+M2JyggkKFhcYGRolJicoKSo0NTY3ODk6Q0RFRkdISUpTVFVWV1hZWmNkZWZnaGlqc3R1dnd4eXqD
+hIWGh4iJipKTlJWWl5iZmqKjpKWmp6ipqrKztLW2t7i5usLDxMXGx8jJytLT1NXW19jZ2uHi4+Tl
+5ufo6erx8vP09fb3+Pn6/90ABAAD/9oACAEBAAA/APb/AARqENrbRQllCoqmRs4GQPunoML1brzj
+oVNX/F+rRXNpIynjaUiQ88lTjOMYyRuY5yANoJwtfFPjTS5rm5kVBueV2aQjOQCc4+XjL85H93jG
+GBr/0PJfBmmSW13G7qwiiYds7m3Y3DHBzkKuTgDnK7mr7V8HapHa2iB2USyKBjOCi7cbhjkYwFXJ
+znnLFWqt411GK6tpIkb5ERjIQQQSFzjAycJzkf3uMZUGv//R8b8XaZLcXckwTJLFYlIxwG4zjPQH
+c3OM/KCMrWv4G0yW0uYkIYMWVpGz2J+6e+W6tnBxjqGNeqS+I/7KP2fzNu35pWbj0YfMT/wJj9Pm
++8K//9KaPxX/AGmeX3IPkjXcfmyeDz0LdTgZCjoSvOjH4XOpgMU3yTDLkrn5DkH2GfugAHCg42/L
+SyeF100eYIwI4Bu3D+NsDpnAJz8qepJIYhhX/9OaTxU2lnHmbXYlYweQigj6DCg8ccsclTlqWLxJ
+/apFuJAV4Mh3HGRn5T2wv3mznnHQqa0o/Co1IfaDESDxEpXPJGRnGAMkFm5zgbQTha//1NaXw3/Z
+Q4TDtlpCBgqCc4wAAN/OR/d/hwwNeI+Orua3upIYy25mJkYHsSflPU5bq3TjHUMaz/BmoST3kZck
+xowWMHguTj6n5iOOOFGSow1f/9X33wRYpNaRFgPNlUHIx8i8dM5IGPlT0AJByoy/xtYQQ2sgUKqR
+KSx24+cZB9yBnaAByxON3y18NeNL+aC7ldchmYrGoP3QOh56hepwMFj0G7j/1vJPA95LPdRROxPz
+Bpmb6hhlj/30x+nzfeFfcvg6xgmtEldQVVAqL03e/wA3Qt1OBkKOh2843jyyS3tZQoBkkQljt/gI
+IPsCcbQAOFBxt+U1/9fgPFmiSX88gRdzyszSEA5AJzjjAy+Tkf3e2GBqp4Z0J7O5SRkYRQsOgyGb
+djcMcHJIVcnAHOV3Gvqvwrri2FugZlErqBwdu1duNwxyMYCrk5zzltrV/9D2TxTrcV9bvCj/ACIp
+MhBBDEDOMDJOzuP738OVBr5S8T6HJe3Mk4j3FmKxKR/Du4zjJOAdzc4ydoIytWPCmhy2FxGpVgxY
+NI3fBP3T3y3VunGOoY1//9H2vw14ghtLdNzgJGu2MH5SzED6nLEcccKMkDDVm+LdZW+gkVWzLMDy
+p+4vTjJJAx8qegBwwKjPOaV4c/tONSU3yTDLkrn5DkHHYE42gAHCg42/LX//0u81PwxHp8ZkEYEc
+ILZH8bY98AnPyp6knDYbjynVfEz6ZIwDlXYlYx1CKD+AwoPHHLHJBy1JpXiM6lIlv5gKggyHccZG
+flPbC/ebrzjoVNf/0+70vw0upRC4aMkEARKVzyRkZxjqRubnOBgE4WotV8NjTI22oA7ZaQgYIB+b
+HAABfuP7vbDA15VqXik2ErJ5jLFCcYBzuYHbuGODkkKuTjHOV3NX/9TI0jxC+puFLhpZiBgEjapG
+Nwx6ABVyck85ba1fSfgFE+yRb8ebKoOQR8g49csOPlT0AOGyorS8bR24tJFXaEiUljjGXAIOO5xn
+aAANzE43fLX/1fGfHcky3csighncrGoOdoGcHnOQvU4GCx6DdwzwMZjeRRuTjcrTM31DD5j/AN9M
+fpz94V96eB1gazjkcAqiqsa5xuz0PzdC3U4GQo6Hbz//1vf/AB6ka2kirgyyISxx/AQRx2BONoAB
+AUHG35a+DfGjy/bZNhPlRMxypOHb2zhTz8qepJIYhhjZ+H7z/aonfdvdwIwRkKoI+gwoPHHzMclT
+lq//2Q=="""
+)
+
 decoder = jpegio.JpegDecoder()
 
 
@@ -130,3 +165,9 @@ test(content, scale=3, x=12, y=16, x1=8, y1=12, x2=16, y2=16)
 
 print("color key")
 test(content, scale=0, skip_source_index=0x4529, fill=0)
+
+print("restart intervals")
+test(content_rst, scale=0, x1=20, y1=10, x2=44, y2=30)
+test(content_rst, scale=0, x1=40, y1=17)
+test(content_rst, scale=0, x=30, y=20, x1=5, y1=3)
+test(content_rst, scale=1, x1=10, y1=5, x2=22, y2=15)
@@ -0,0 +1,58 @@
+try:
+    import memorymonitor
+    memorymonitor.AllocationProfiler
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+class Point:
+    def __init__(self, x):
+        self.x = x
+
+
+def make_points(n):
+    out = []
+    for i in range(n):
+        out.append(Point(i))
+    return out
+
+
+def make_buffers(n):
+    for i in range(n):
+        bytearray(100)
+
+
+profiler = memorymonitor.AllocationProfiler(every=1, samples=512)
+with profiler:
+    make_points(50)
+    make_buffers(20)
+
+print(profiler.allocations >= 70)
+sites = profiler.top(20)
+for count, size, file, line, function, kind in sites:
+    if function == "make_points" and kind is Point:
+        print(function, line, count, size > 0)
+buffers = [s for s in sites if s[4] == "make_buffers" and s[3] == 23]
+print(sum(s[0] for s in buffers) >= 20, sum(s[1] for s in buffers) >= 20 * 100)
+
+# Only 2 entries are returned when asked for 2.
+print(len(profiler.top(2)))
+
+# Sampling is off once the context exits.
+before = profiler.allocations
+bytearray(10)
+print(profiler.allocations == before)
+
+# Only one profiler can run at a time.
+other = memorymonitor.AllocationProfiler()
+with profiler:
+    try:
+        other.__enter__()
+    except RuntimeError:
+        print("RuntimeError")
+
+try:
+    memorymonitor.AllocationProfiler(every=0)
+except ValueError:
+    print("ValueError")
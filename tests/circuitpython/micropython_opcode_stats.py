@@ -0,0 +1,36 @@
+# Opcode and opcode pair counts from a VM built with MICROPY_VM_OPCODE_STATS.
+import micropython
+
+try:
+    micropython.opcode_stats
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+
+def loop(n):
+    t = 0
+    for i in range(n):
+        t += i
+    return t
+
+
+# reset, and the counts read before resetting are returned
+micropython.opcode_stats(True)
+opcodes, pairs, dropped = micropython.opcode_stats(True)
+print(sum(opcodes.values()) > 0, dropped)
+
+loop(100)
+opcodes, pairs, dropped = micropython.opcode_stats()
+# each opcode of the loop body runs once per iteration
+print(sorted(opcodes.values())[-2:])
+print(sum(opcodes.values()) == sum(pairs.values()), dropped)
+print(all(isinstance(a, int) and 0 <= a < 256 for pair in pairs for a in pair))
+
+# pairs chain together: the second of each starts another, apart from the last
+firsts = {}
+seconds = {}
+for (a, b), count in pairs.items():
+    firsts[a] = firsts.get(a, 0) + count
+    seconds[b] = seconds.get(b, 0) + count
+print(sum(abs(firsts.get(op, 0) - seconds.get(op, 0)) for op in set(firsts) | set(seconds)) <= 2)
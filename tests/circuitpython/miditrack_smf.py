@@ -0,0 +1,64 @@
+import struct
+
+try:
+    from synthio import MidiTrack
+    from audiocore import get_buffer, reset_buffer
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def chunk(kind, data):
+    return kind + struct.pack(">L", len(data)) + data
+
+
+def smf(format, tracks, division=96):
+    header = chunk(b"MThd", struct.pack(">HHH", format, len(tracks), division))
+    return header + b"".join(chunk(b"MTrk", t) for t in tracks)
+
+
+def play(m):
+    total = 0
+    while True:
+        result, buf = get_buffer(m)
+        total += len(buf)
+        if result != 1:
+            return result, total
+
+
+END = b"\0\xff\x2f\0"
+
+# The tempo track doubles the speed at tick 96. The notes use running status
+# and Note On with velocity 0 for Note Off.
+tempo_track = b"\x60\xff\x51\x03\x03\xd0\x90" + END
+note_track = b"\0\x90\x40\x40\x60\x40\0\0\x43\x40\x60\x43\0" + END
+
+# 96 ticks at 120 bpm is 4000 samples, then 96 ticks at 240 bpm is 2000.
+m = MidiTrack(smf(1, [tempo_track, note_track]), sample_rate=8000)
+print(play(m), m.error_location)
+# Playing again starts from the beginning.
+reset_buffer(m)
+print(play(m), m.error_location)
+
+m = MidiTrack(smf(0, [note_track]), sample_rate=8000)
+print(play(m), m.error_location)
+
+# 25 frames per second, 40 ticks per frame: 1000 ticks per second.
+m = MidiTrack(smf(0, [b"\0\x90\x40\x40\x83\x74\x80\x40\0" + END], division=0xE728), sample_rate=8000)
+print(play(m), m.error_location)
+
+# An undefined status byte stops playback at that event.
+bad = smf(0, [b"\0\x90\x40\x40\x60\xf4\x40" + END])
+m = MidiTrack(bad, sample_rate=8000)
+print(play(m), m.error_location)
+
+for data in (smf(2, [note_track]), smf(0, [note_track, note_track]), b"MThd\0\0\0\6"):
+    try:
+        MidiTrack(data, sample_rate=8000)
+    except ValueError as e:
+        print("ValueError", e)
+
+try:
+    MidiTrack(b"\0\x90@\0\x20\x80@\0", sample_rate=8000)
+except ValueError as e:
+    print("ValueError", e)
@@ -0,0 +1,79 @@
+import gc
+import io
+import msgpack
+
+
+class Trickle(io.IOBase):
+    # Returns at most `chunk` bytes per read, and no data (EAGAIN) on the
+    # reads listed in `stalls`.
+    def __init__(self, data, chunk, stalls=()):
+        self.data = data
+        self.pos = 0
+        self.chunk = chunk
+        self.stalls = stalls
+        self.reads = 0
+
+    def readinto(self, buf):
+        self.reads += 1
+        if self.reads in self.stalls:
+            return None
+        n = min(len(buf), self.chunk, len(self.data) - self.pos)
+        buf[:n] = self.data[self.pos : self.pos + n]
+        self.pos += n
+        return n
+
+
+objects = [1, "two", [3, 4.0], {"five": b"\x05" * 40}, None, True, b"seven"]
+b = io.BytesIO()
+for o in objects:
+    msgpack.pack(o, b)
+data = b.getvalue()
+
+# Short reads, with the default buffer and with buffers smaller than an object.
+for chunk in (1, 3, 64):
+    for size in (1, 4, 1024):
+        got = list(msgpack.Unpacker(Trickle(data, chunk), buffer_size=size))
+        print(chunk, size, got == objects)
+
+# A supplied buffer.
+print(list(msgpack.Unpacker(Trickle(data, 5), bytearray(16))) == objects)
+
+# A read that would block raises OSError, and the object is unpacked again
+# from its start by the next call.
+u = msgpack.Unpacker(Trickle(data, 5, stalls=(2, 5, 9, 14)), buffer_size=64)
+got = []
+while True:
+    try:
+        got.append(u.unpack())
+    except OSError as e:
+        print("OSError", e.errno)
+    except EOFError:
+        print("EOFError")
+        break
+print(got == objects)
+
+# End of stream in the middle of an object.
+try:
+    print(len(list(msgpack.Unpacker(Trickle(data[:-2], 7)))))
+except EOFError:
+    print("EOFError in object")
+
+# Bin data as views of the buffer. Keys are never views.
+b = io.BytesIO()
+msgpack.pack({b"key": b"value"}, b)
+msgpack.pack(b"x" * 100, b)
+msgpack.pack(b"\x01\x02\x03", b)
+u = msgpack.Unpacker(Trickle(b.getvalue(), 3), buffer_size=32, use_memoryview=True)
+d = u.unpack()
+for k, v in d.items():
+    print(type(k).__name__, k, type(v).__name__, bytes(v))
+# Too big for the buffer, so copied.
+print(type(u.unpack()).__name__)
+view = u.unpack()
+print(type(view).__name__, bytes(view))
+
+# A view keeps the buffer alive after the Unpacker is gone.
+del u
+gc.collect()
+junk = [bytearray(b"\xff" * 32) for _ in range(20)]
+print(bytes(view))
@@ -0,0 +1,38 @@
+# OrderedDicts with more than a few entries are looked up through a hash index.
+try:
+    from collections import OrderedDict
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+d = OrderedDict()
+for i in range(40):
+    d["k%d" % i] = i
+d[1.5] = "float"
+d[(1, 2)] = "tuple"
+print(len(d), d["k0"], d["k39"], d[1.5], d[(1, 2)], "k40" in d)
+
+# Removing keeps the order and the other keys reachable.
+for i in range(0, 40, 3):
+    del d["k%d" % i]
+print(list(d.keys())[:6], d.get("k3"), d["k38"])
+print(d.popitem(), d.popitem(), d.popitem())
+d["k0"] = "again"
+print(list(d.items())[-2:])
+
+# A copy is indexed again once it grows.
+e = d.copy()
+for i in range(100, 150):
+    e[i] = i
+print(len(e), e["k2"], e[149], list(e.keys())[:4] == list(d.keys())[:4])
+
+# Unhashable keys are refused, as by dict.
+try:
+    d[[1]] = 1
+except TypeError:
+    print("TypeError")
+
+d.clear()
+print(len(d), d.get("k1"))
+d["x"] = 1
+print(list(d.items()))
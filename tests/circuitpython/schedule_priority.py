@@ -0,0 +1,91 @@
+# test micropython.schedule() priorities and coalescing
+
+import micropython
+
+try:
+    micropython.schedule
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+calls = []
+
+
+def record(arg, count=None):
+    calls.append((arg, count))
+
+
+def wait(n):
+    while len(calls) < n:
+        pass
+
+
+try:
+    micropython.schedule(record, "probe", high_priority=True)
+except TypeError:
+    print("SKIP")
+    raise SystemExit
+wait(1)
+calls.clear()
+
+# Callbacks are scheduled from within a callback so the scheduler is locked
+# while they are queued.
+
+
+def queue_priorities(arg):
+    micropython.schedule(record, 1)
+    micropython.schedule(record, 2)
+    micropython.schedule(record, "a", high_priority=True)
+    micropython.schedule(record, "b", high_priority=True)
+
+
+micropython.schedule(queue_priorities, None)
+wait(4)
+print(calls)
+calls.clear()
+
+# Coalesced schedules of the same function and arg merge into one call with a
+# count, without taking more room in the queue.
+
+
+def queue_coalesced(arg):
+    for i in range(50):
+        micropython.schedule(record, "x", coalesce=True)
+    micropython.schedule(record, "y", coalesce=True)
+    micropython.schedule(record, "x", coalesce=True)
+    micropython.schedule(record, "x")
+
+
+micropython.schedule(queue_coalesced, None)
+wait(3)
+print(calls)
+calls.clear()
+
+# A coalesced high priority schedule does not merge with a normal one.
+
+
+def queue_mixed(arg):
+    micropython.schedule(record, "z", coalesce=True)
+    micropython.schedule(record, "z", coalesce=True, high_priority=True)
+    micropython.schedule(record, "z", coalesce=True, high_priority=True)
+
+
+micropython.schedule(queue_mixed, None)
+wait(2)
+print(calls)
+calls.clear()
+
+# The queue still fills up.
+
+
+def queue_full(arg):
+    try:
+        for i in range(100):
+            micropython.schedule(record, i, high_priority=True)
+    except RuntimeError:
+        print("RuntimeError")
+
+
+micropython.schedule(queue_full, None)
+wait(2)
+print(calls[:2])
@@ -0,0 +1,51 @@
+# StopIteration without a value is raised without allocating.
+import gc
+
+it = iter(())
+before = 0
+
+
+def exhaust():
+    for _ in range(100):
+        try:
+            next(it)
+        except StopIteration:
+            pass
+
+
+exhaust()
+gc.collect()
+before = gc.mem_alloc()
+exhaust()
+print(gc.mem_alloc() - before)
+
+try:
+    next(it)
+except StopIteration as e:
+    print(repr(e), e.args, e.value)
+
+
+def returns_none():
+    return
+    yield
+
+
+def returns_value():
+    return 5
+    yield
+
+
+for gen in (returns_none, returns_value):
+    try:
+        next(gen())
+    except StopIteration as e:
+        print(repr(e), e.args, e.value)
+
+# It can still be raised while handling another exception.
+try:
+    try:
+        raise ValueError
+    except ValueError:
+        next(it)
+except StopIteration as e:
+    print("caught", repr(e))
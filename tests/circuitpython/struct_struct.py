@@ -0,0 +1,28 @@
+import struct
+
+s = struct.Struct("<hhh")
+print(s.format, s.size)
+b = s.pack(1, -2, 3)
+print(b)
+print(s.unpack(b))
+print(s.unpack_from(b"\0" + b, 1))
+buf = bytearray(8)
+s.pack_into(buf, 2, 4, 5, -6)
+print(buf)
+
+out = [None] * 3
+r = s.unpack_from(buf, 2, into=out)
+print(r is out, out)
+
+try:
+    s.unpack_from(buf, into=[0])
+except ValueError:
+    print("ValueError")
+
+t = struct.Struct("2sxI")
+print(t.size, t.unpack(t.pack(b"ab", 7)))
+
+# The module-level functions share compiled formats through a cache, so
+# repeated and colliding formats must still give the right answers.
+for fmt in ("B", "H", "I", "b", "h", "i", "2B", "3H", "B"):
+    print(fmt, struct.calcsize(fmt), struct.unpack_from(fmt, b"\x01\x02\x03\x04\x05\x06"))
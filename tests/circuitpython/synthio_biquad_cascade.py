@@ -0,0 +1,32 @@
+import audiocore
+import synthio
+
+s = synthio.Synthesizer(sample_rate=8000)
+lpf = s.low_pass_filter(400)
+
+
+# peak-to-peak level of the second block, after the filter has settled
+def level(note_filter=None, output_filter=None):
+    s.filter = output_filter
+    s.press(synthio.Note(2000, filter=note_filter))
+    audiocore.get_buffer(s)
+    _, buf = audiocore.get_buffer(s)
+    s.release_all()
+    audiocore.get_buffer(s)
+    return max(buf) - min(buf)
+
+
+print(level())
+print(level(lpf))
+print(level((lpf, lpf)))
+print(level([lpf] * 4))
+print(level(output_filter=lpf))
+print(level(output_filter=(lpf, lpf)))
+s.filter = lpf
+print(s.filter)
+
+for bad in ([lpf] * 5, [], [1], 3):
+    try:
+        synthio.Note(1, filter=bad)
+    except (TypeError, ValueError) as e:
+        print(type(e).__name__, e)
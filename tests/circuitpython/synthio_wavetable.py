@@ -0,0 +1,36 @@
+import array
+import audiocore
+import synthio
+
+saw = array.array("h", [int(32767 * (2 * i / 256 - 1)) for i in range(256)])
+wavetable = synthio.Wavetable(saw)
+print(wavetable.levels)
+print(memoryview(wavetable) == memoryview(saw))
+
+print(synthio.Wavetable(array.array("h", [0] * 24)).levels)
+print(synthio.Wavetable(array.array("h", [0] * synthio.waveform_max_length)).levels)
+
+try:
+    synthio.Wavetable(array.array("b", [0] * 4))
+except ValueError as e:
+    print(e)
+
+
+# A high note from a plain sawtooth keeps its full-scale jumps; one from the
+# wavetable plays a band-limited copy and changes much more gently.
+def largest_step(waveform, frequency):
+    s = synthio.Synthesizer(sample_rate=8000)
+    s.press(synthio.Note(frequency, waveform=waveform))
+    _, buf = audiocore.get_buffer(s)
+    _, buf = audiocore.get_buffer(s)
+    return max(abs(buf[i + 1] - buf[i]) for i in range(len(buf) - 1))
+
+
+print(largest_step(saw, 1100) > 2 * largest_step(wavetable, 1100))
+
+# loop points select part of the waveform, which plays from the original
+s = synthio.Synthesizer(sample_rate=8000)
+n = synthio.Note(1100, waveform=wavetable, waveform_loop_end=128)
+s.press(n)
+_, buf = audiocore.get_buffer(s)
+print(max(buf) - min(buf) > 16000)
@@ -0,0 +1,80 @@
+# Test uheap.snapshot, which writes a run-length map of the heap.
+
+try:
+    import uheap
+    import io
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def read_uint(data, offset):
+    value = 0
+    shift = 0
+    while True:
+        b = data[offset]
+        offset += 1
+        value |= (b & 0x7F) << shift
+        shift += 7
+        if b < 0x80:
+            return value, offset
+
+
+def parse(data):
+    # Returns the block size and a list of (blocks in area, runs).
+    assert data[:4] == b"GCHM" and data[4] == 1
+    bytes_per_block, offset = read_uint(data, 5)
+    areas = []
+    last = None
+    while offset < len(data):
+        tag = data[offset]
+        value, offset = read_uint(data, offset + 1)
+        if tag == 0xFF:
+            areas.append((value, []))
+        elif tag == 0x80:
+            areas[-1][1].extend([last] * value)
+        else:
+            last = (tag, value)
+            areas[-1][1].append(last)
+    return bytes_per_block, areas
+
+
+buf = bytearray(8192)
+big = bytearray(3000)
+length = uheap.snapshot(buf)
+bytes_per_block, areas = parse(memoryview(buf)[:length])
+print(bytes_per_block in (16, 32))
+
+# Every block of every area is covered by exactly one run.
+print(all(blocks == sum(n for _, n in runs) for blocks, runs in areas))
+
+# Free runs merge, so two are never next to each other.
+print(all(runs[i][0] or runs[i + 1][0] for _, runs in areas for i in range(len(runs) - 1)))
+
+# The big bytearray's storage is one allocation that isn't a known object.
+big_blocks = (3000 + bytes_per_block - 1) // bytes_per_block
+print(any((0x40, big_blocks) in runs for _, runs in areas))
+
+# bytearray objects themselves are tagged.
+print(any(tag == 0x40 | 3 for _, runs in areas for tag, _ in runs))
+
+# Instances of classes are tagged.
+class Thing:
+    pass
+
+
+things = [Thing() for _ in range(10)]
+length = uheap.snapshot(buf)
+_, areas = parse(memoryview(buf)[:length])
+print(sum(1 for _, runs in areas for tag, _ in runs if tag == 0x40 | 14) >= 10)
+
+# Streams get the same format.
+stream = io.BytesIO()
+length = uheap.snapshot(stream)
+data = stream.getvalue()
+print(len(data) == length, data[:5])
+
+try:
+    uheap.snapshot(bytearray(3))
+except ValueError as e:
+    print("ValueError", e)
@@ -0,0 +1,41 @@
+# High-water marks of the C stack.
+import ustack
+
+try:
+    ustack.stack_high_water
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+
+def recurse(n):
+    if n:
+        return recurse(n - 1) + 1
+    return 0
+
+
+ustack.reset_high_water()
+base = ustack.stack_high_water()
+recurse(5)
+shallow = ustack.stack_high_water()
+recurse(50)
+deep = ustack.stack_high_water()
+print(base <= shallow < deep)
+# shallower calls don't lower it
+recurse(5)
+print(ustack.stack_high_water() == deep)
+
+# resetting starts again from the current usage
+ustack.reset_high_water()
+print(ustack.stack_high_water() < deep)
+
+stack, pystack = ustack.headroom()
+print(stack == ustack.stack_size() - ustack.stack_high_water())
+print(pystack is None or pystack >= 0)
+
+# running out raises, and the high-water mark has then reached the limit
+try:
+    recurse(100000)
+except RuntimeError:
+    print("RuntimeError")
+print(ustack.stack_high_water() >= ustack.stack_size(), ustack.headroom()[0] <= 0)
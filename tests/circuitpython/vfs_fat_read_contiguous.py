@@ -0,0 +1,65 @@
+# Large reads of a FAT file should reach the block device as one read per
+# run of contiguous clusters, whether or not the file has a fast seek map.
+try:
+    import os
+    os.VfsFat
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+class RAMFS:
+    SEC_SIZE = 512
+
+    def __init__(self, blocks):
+        self.data = bytearray(blocks * self.SEC_SIZE)
+        self.reads = []
+
+    def readblocks(self, n, buf):
+        self.reads.append((n, len(buf) // self.SEC_SIZE))
+        buf[:] = self.data[n * self.SEC_SIZE : n * self.SEC_SIZE + len(buf)]
+
+    def writeblocks(self, n, buf):
+        self.data[n * self.SEC_SIZE : n * self.SEC_SIZE + len(buf)] = buf
+
+    def ioctl(self, op, arg):
+        if op == 4:  # MP_BLOCKDEV_IOCTL_BLOCK_COUNT
+            return len(self.data) // self.SEC_SIZE
+        if op == 5:  # MP_BLOCKDEV_IOCTL_BLOCK_SIZE
+            return self.SEC_SIZE
+
+
+bdev = RAMFS(200)
+os.VfsFat.mkfs(bdev)
+vfs = os.VfsFat(bdev)
+os.mount(vfs, "/ramdisk")
+
+chunk = 2048
+with open("/ramdisk/solid", "wb") as f:
+    f.write(bytes(range(256)) * 32)
+
+# Append to two files in turn so their clusters interleave.
+for i in range(4):
+    for name in ("a", "b"):
+        with open("/ramdisk/" + name, "ab") as f:
+            f.write(bytes([ord(name) + i]) * chunk)
+
+
+def data_reads(name, mode):
+    buf = bytearray(4 * chunk)
+    with open("/ramdisk/" + name, mode) as f:
+        bdev.reads = []
+        n = f.readinto(buf)
+        reads = [r for r in bdev.reads if r[1] > 1]
+    return n, buf, reads
+
+
+for mode in ("rb", "r+b"):
+    n, buf, reads = data_reads("solid", mode)
+    print(mode, "solid", n, buf == bytes(range(256)) * 32, len(reads))
+    for name in ("a", "b"):
+        n, buf, reads = data_reads(name, mode)
+        expected = b"".join(bytes([ord(name) + i]) * chunk for i in range(4))
+        print(mode, name, n, buf == expected, len(reads), sum(r[1] for r in reads))
+
+os.umount("/ramdisk")
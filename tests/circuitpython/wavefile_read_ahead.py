@@ -0,0 +1,71 @@
+# WaveFile with read_ahead returns the same data as without.
+import os
+import struct
+import audiocore
+
+try:
+    os.VfsFat
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+
+class RAMFS:
+    SEC_SIZE = 512
+
+    def __init__(self, blocks):
+        self.data = bytearray(blocks * self.SEC_SIZE)
+
+    def readblocks(self, n, buf):
+        buf[:] = self.data[n * self.SEC_SIZE : n * self.SEC_SIZE + len(buf)]
+
+    def writeblocks(self, n, buf):
+        self.data[n * self.SEC_SIZE : n * self.SEC_SIZE + len(buf)] = buf
+
+    def ioctl(self, op, arg):
+        if op == 4:  # MP_BLOCKDEV_IOCTL_BLOCK_COUNT
+            return len(self.data) // self.SEC_SIZE
+        if op == 5:  # MP_BLOCKDEV_IOCTL_BLOCK_SIZE
+            return self.SEC_SIZE
+
+
+bdev = RAMFS(64)
+os.VfsFat.mkfs(bdev)
+os.mount(os.VfsFat(bdev), "/ramdisk")
+
+samples = bytes(range(250)) * 4
+with open("/ramdisk/test.wav", "wb") as f:
+    f.write(b"RIFF" + struct.pack("<I", 36 + len(samples)) + b"WAVEfmt ")
+    f.write(struct.pack("<IHHIIHH", 16, 1, 1, 8000, 16000, 2, 16))
+    f.write(b"data" + struct.pack("<I", len(samples)) + samples)
+
+
+def read_all(wav):
+    data = b""
+    for _ in range(2):
+        audiocore.reset_buffer(wav)
+        while True:
+            result, buf = audiocore.get_buffer(wav)
+            data += buf
+            if result != 1:
+                break
+    return data
+
+
+with audiocore.WaveFile("/ramdisk/test.wav") as wav:
+    expected = read_all(wav)
+print(len(expected), expected == samples * 2)
+
+for read_ahead, buffer in ((1, None), (4, None), (3, bytearray(100))):
+    with audiocore.WaveFile("/ramdisk/test.wav", buffer, read_ahead=read_ahead) as wav:
+        print(read_ahead, read_all(wav) == expected, wav.underruns)
+
+with audiocore.WaveFile("/ramdisk/test.wav") as wav:
+    print(wav.underruns)
+
+try:
+    audiocore.WaveFile("/ramdisk/test.wav", read_ahead=17)
+except ValueError as e:
+    print("ValueError")
+
+os.umount("/ramdisk")
@@ -0,0 +1,58 @@
+# Test zlib.compress and zlib.compressobj by decompressing what they produce.
+try:
+    import zlib
+
+    zlib.compressobj
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+def make_data():
+    # Repetitive like a log, with some noise between the repeats.
+    x = 1
+    data = bytearray()
+    words = (b"temp", b"=", b"21.5", b"\n", b"sensor", b"ok", b" ", b"error")
+    for _ in range(1500):
+        x = (x * 1103515245 + 12345) & 0x7FFFFFFF
+        data += words[(x >> 16) % 8]
+        if x & 0x10000:
+            data.append(32 + (x >> 8) % 95)
+    return bytes(data)
+
+
+DATA = make_data()
+
+for wbits in (-9, -12, -15, 9, 12, 15, 25, 31):
+    for level in (0, 1, 6, 9):
+        compressed = zlib.compress(DATA, level, wbits)
+        print(wbits, level, zlib.decompress(compressed, wbits) == DATA, len(compressed) < len(DATA))
+
+print(zlib.decompress(zlib.compress(b"")) == b"")
+print(zlib.decompress(zlib.compress(b"a")) == b"a")
+
+# In pieces, with sync flushes that make everything so far decodable.
+c = zlib.compressobj(6, zlib.DEFLATED, -10)
+d = zlib.decompressobj(-10)
+out = b""
+ok = True
+for i in range(0, len(DATA), 300):
+    data = c.compress(DATA[i : i + 300]) + c.flush(zlib.Z_SYNC_FLUSH)
+    out += d.decompress(data)
+    ok = ok and out == DATA[: i + 300]
+print(ok)
+out += d.decompress(c.flush())
+print(out == DATA, d.eof)
+
+# Full flushes forget the history, so each part decodes by itself.
+c = zlib.compressobj(wbits=-12)
+parts = []
+for i in range(0, len(DATA), 2000):
+    parts.append(c.compress(DATA[i : i + 2000]) + c.flush(zlib.Z_FULL_FLUSH))
+print(zlib.decompressobj(-12).decompress(parts[2]) == DATA[4000:6000])
+
+for args in ((10,), (6, 7), (6, zlib.DEFLATED, 16), (6, zlib.DEFLATED, 7)):
+    try:
+        zlib.compressobj(*args)
+    except ValueError:
+        print("ValueError")
@@ -0,0 +1,44 @@
+# Test zlib.compressobj writing straight to a stream.
+try:
+    import io
+    import zlib
+
+    zlib.compressobj
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+DATA = b"".join(b"%d: reading %d ok\n" % (i, i * 7 % 100) for i in range(500))
+
+for wbits in (-8, 12, 31):
+    f = io.BytesIO()
+    c = zlib.compressobj(wbits=wbits, stream=f)
+    # Nothing is returned, it all goes to the stream.
+    returned = set()
+    for i in range(0, len(DATA), 100):
+        returned.add(c.compress(DATA[i : i + 100]))
+    returned.add(c.flush())
+    print(wbits, returned, zlib.decompress(f.getvalue(), wbits) == DATA, len(f.getvalue()) < len(DATA) // 2)
+
+# It can be written to like a stream.
+f = io.BytesIO()
+c = zlib.compressobj(stream=f)
+for i in range(100):
+    print("line", i, file=c)
+c.flush()
+print(zlib.decompress(f.getvalue()) == b"".join(b"line %d\n" % i for i in range(100)))
+
+try:
+    c.compress(b"more")
+except ValueError as e:
+    print(e)
+
+try:
+    zlib.compressobj().write(b"data")
+except OSError:
+    print("OSError")
+
+try:
+    zlib.compressobj(stream=1)
+except OSError:
+    print("OSError")
@@ -0,0 +1,87 @@
+# Test zlib.decompressobj, fed in pieces of various sizes.
+try:
+    import zlib
+
+    zlib.decompressobj
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+def make_data():
+    # Incompressible noise, repeated at a distance larger than one inflate step.
+    x = 1
+    noise = bytearray()
+    for _ in range(200):
+        x = (x * 1103515245 + 12345) & 0x7FFFFFFF
+        noise.append(32 + (x >> 16) % 95)
+    text = b"".join(b"line %d of filler\n" % i for i in range(70))
+    return bytes(noise) + text + bytes(noise) + text[:300]
+
+
+DATA = make_data()
+
+# Produced by CPython's zlib.compressobj(9, zlib.DEFLATED, 15)
+ZLIB_DATA = (
+    b'x\xda\xed\xd4\xc9N\xc2P\x18\x86\xe1\xbdWA\xa9P\x90\xa8=c'
+    b'\x19\xd4*Se\x94A\r\x16,\x12\xa5\x940\tE"(^\xbb'
+    b'\x89+\xd3\xef\x12t\xfb\xae\x9e\x9c\xfc\xe73\xecJn)y\xdcQ'
+    b'\xb6\x85\xee\x8e\xf7\xe3\xfb\x87\xc4\xb2\xe8\xb6\x9dl:\x97\xd9\x9cG\xd6'
+    b'N\xe79\xd9\x8f\x8a\x8a\xef\xda\x97\x9d\\L\xb3\xd4\xc166\xbb\xfa'
+    b'\xf4\xb4\x9ae\xe7\xbfZ[\xd5iF\x13\xa9\xbb\xd1\xba\xa0\xa7\xea\xc9'
+    b'q\xd90\xddC\xe5\xb1SO\r\xaaUn\xdf/\x1a\xba\xd7~\xd2'
+    b'<7mo\x9ab~l\x19\xad\xc6\xae\x97\xcdk\xcb\x95z\xa4['
+    b'\xa5\xb7\x1a\xb9\xe8y\xbb\xc9kw1\xb8h\xb9\x8b\x8fQ\xd9\x97\xeb'
+    b'\xb0\x1f?5_\x14{\xc6n\xdfU\xc5\x1c\x99\x893\xa3\xb4\xcf\x98'
+    b'\xe1\x9bb\xd4\xf7\xbaj\xa4\xc2\xf2\xe6d\xae^\xafO*\xcaF\x0f'
+    b'M\xa7\xe3\xf90\xa4\x87\x16n\xc8\x1dO\xa7\xc3\xd5\xc1O \xc1@'
+    b'\x83\x81\x05\x03\x0f\x06\x11\x0c2\x18\x8c`H\x06C\n`H\x05+'
+    b'\x01,\x01-\x01.\x01/\x010\x011\x012\x013\x053\xc5\xf7'
+    b'\x053\x053\x053\x053\x053\x053\x053\x053\x033\x033'
+    b'\xc3\xa3\x003\x033\x033\x033\x033\x033\x033\x073\x073'
+    b'\x073\xc7K\x063\x073\x073\x073\x073\x07\xb3\x00\xb3\x00\xb3'
+    b'\x00\xb3\x00\xb3\xc0\xef\x07f\x01f\x01f\x01f\x01f\tf\tf'
+    b'\tf\tf\tf\x89\x9b\x01f\tf\tf\xf9\xdbl\xfc/\xf5'
+    b"\x9f[\xeao'\xf7n\xd8"
+)
+RAW_DATA = ZLIB_DATA[2:-4]
+GZIP_DATA = b'\x1f\x8b\x08\x00\x00\x00\x00\x00\x02\x03' + RAW_DATA + b'\xacPCi\x9e\x07\x00\x00'
+
+
+def feed(comp, wbits, chunk, max_length=0):
+    d = zlib.decompressobj(wbits)
+    out = b""
+    for i in range(0, len(comp), chunk):
+        out += d.decompress(comp[i : i + chunk], max_length)
+        while d.unconsumed_tail:
+            out += d.decompress(d.unconsumed_tail, max_length)
+    out += d.flush()
+    return d, out
+
+
+for name, comp, wbits in (("zlib", ZLIB_DATA, 15), ("raw", RAW_DATA, -15), ("gzip", GZIP_DATA, 31)):
+    for chunk in (1, 7, 100, len(comp)):
+        d, out = feed(comp, wbits, chunk)
+        print(name, chunk, out == DATA, d.eof, d.unused_data)
+
+# Output limited with max_length, using unconsumed_tail to continue.
+for max_length in (1, 50, 1000):
+    d, out = feed(ZLIB_DATA, 15, 64, max_length)
+    print("max_length", max_length, out == DATA, d.eof)
+
+# Bytes past the end of the stream end up in unused_data.
+d = zlib.decompressobj(15)
+out = d.decompress(ZLIB_DATA + b"trailer")
+print(out == DATA, d.eof, d.unused_data)
+print(d.decompress(b"more"), d.unused_data)
+
+# Incomplete streams produce what they can.
+d = zlib.decompressobj(15)
+out = d.decompress(ZLIB_DATA[:200])
+print(DATA.startswith(out), len(out) > 0, d.eof)
+
+# Corrupt data raises an error.
+try:
+    zlib.decompressobj(15).decompress(b"x\x9c\xff\xff\xff\xff")
+except Exception:
+    print("error")
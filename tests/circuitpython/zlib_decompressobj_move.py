@@ -0,0 +1,91 @@
+# Test that zlib.Decompress keeps working when the heap moves its dictionary.
+# A failed allocation makes the garbage collector compact movable buffers.
+try:
+    import zlib
+
+    zlib.decompressobj
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+import gc
+
+
+def make_data():
+    # Incompressible noise, repeated so that the stream refers back to it.
+    x = 1
+    noise = bytearray()
+    for _ in range(600):
+        x = (x * 1103515245 + 12345) & 0x7FFFFFFF
+        noise.append(32 + (x >> 16) % 95)
+    return bytes(noise) * 4
+
+
+DATA = make_data()
+
+# Produced by CPython's zlib.compress(DATA, 9)
+ZLIB_DATA = (
+    b'x\xda\xed\xd2\xfbb\xa9p\x00\x00\xe0W)m\xc5\x88'
+    b'\x92K!?*\xba\xb9\xc6LqR\xd9b\xae5-'
+    b'\xca\xe5\xd9\xcfy\x8f\xe3\t\xbe\x7f\xbe\xb2\xa1\xf2~\xa9'
+    b'\x902\xe1\xa85\x8b\x0b\x8b\xd4]O\xfbmwdr'
+    b'\x15\xbe\x1a\xb2\xaf\x819]\xd2\x0b\xb4\xa8\x9e\\\xa31'
+    b'\xe5\x93\x98\x88\xd8Qr\xdf\xbc\xad\xb1\xaeh\x08\x0f-'
+    b'B\xcc!\x9af\xdeWA\x8b`z\xf4\xb7R\x06\xee'
+    b'\x0b\xfcg\xdac\xecN\xa7`L\x8e\x03b=\xb2\xb0'
+    b'\xb5[1\xc2a\xf1\x80\x8bem\x10\xcf9\x01\xf3\x7f'
+    b'\x907B\x94\x7f\xbbd}\xbe\x8e\xb7\xde\xech\xd75'
+    b'\xf7x])\xa7R\x908\xa5r\xe0\x136\xf6\xd4\xf8'
+    b'\x82\xc0`\x05\xd2\xb5\xb2|\xaf\x82D\xbf\x8d\x9e\xd63'
+    b'\xe4U\xa5\x04\xb0= R\x90U\xe1\x90\x80vI\x08'
+    b'\xe2:\xbc\x8ek\x99\x8c(TuJ\xdcb\x8e\xe1\xa1'
+    b"@I\xe7\xef=\xfcF\\\xa3&'>F\x9d\xba\xc6"
+    b'\xf1\r\xe8\xd1\x8f\xa5\x0f$mUtm\x07\xbb\xb2\xc9'
+    b'\xce\x9dd\xed\x04\x08\xd6\x0f\x82\xf3\xd2\xf8\x81^\x83\xee'
+    b'\xd7\xa8\xad\x0flK\xa7\x94\xc00\xfbDw\x92\x8ai'
+    b'\x8a"\'<\xad\x8ds /\xde\xfb\x116K0\xfa'
+    b'Q\xe4\xda+2{`}\x05\xddy\xb8\xf7`\xfe\xe9'
+    b'\xa7\xd6\x10\xb4Mi0\x19\x93\xf5\x92\xe5Ir\xb9\xa0'
+    b'z2$\xe0B\xf8\x99=\x83\x0f\x0b\xaa5O\x16T'
+    b'\xaf\xbeO\xe2\xf1\x85\xfdl\x1c+\x9c\xe8\xec\x17\x8b\xda'
+    b'\xe56\xde\xbe\xb8.\x8f\xb4\x13\xc6-)q\xbf\xf2\x87'
+    b'\xd3\x1bD\x99\xf8\xa5\xab\xfdp\r1\xbb+\x9d7a'
+    b'\xc3\x0e\xab\x1b\xc6%\xd4)\x8f0\x96\x91\xb1\xe8k\xfe'
+    b'*\xac\xf2\xe4\xd2\xdd\xc8\xc5y1\xbc\xd3`\xef+;'
+    b'\xccK\x1d8\xaa\xafg\xf2\xd8\x8d\xccm\xd0\to\xd3'
+    b'\x05<L\xb1o\xc2Lz\xd4\xc5\xf4"M\xe56\r'
+    b'\x95\xfc\x8e\x0b]\xca\toU\xfc\xdc\x02\xcb\r\xb7f'
+    b'\xe7\x8bY\x7f\xbag\xa7\xadm\xde\x84\xc2a\x8b\xb2 '
+    b'\xc5{C\nup,\xed\xf9qk\xd5\xbc\x90g)'
+    b'\xd4\xd0\x8c\xe3\xd8\xbd\xe8\x17\x1b\x0c|8\xa8\xed\x15\x0e'
+    b'\x95\xdc~\xf9\xf9\xea\xf9\xea\xf9\xea\xf9\xea\xf9\xea\xf9\xea'
+    b'?~\xf5\x179\x15\xd8O'
+)
+
+
+def fill_heap():
+    # Take every free block, so that the last allocations fail.
+    pieces = []
+    try:
+        while True:
+            pieces.append(bytearray(200))
+    except MemoryError:
+        pass
+    return pieces
+
+
+# Leave a hole below the dictionary for it to move into.
+hole = bytearray(40000)
+d = zlib.decompressobj()
+out = d.decompress(ZLIB_DATA[:300])
+del hole
+gc.collect()
+try:
+    bytearray(1 << 30)
+except MemoryError:
+    pass
+pieces = fill_heap()
+del pieces
+gc.collect()
+out += d.decompress(ZLIB_DATA[300:])
+print(out == DATA, d.eof)
@@ -0,0 +1,71 @@
+# mpy-cross: -C cmd_mpy_cross/regs.py --strip-private
+# test mpy-cross folding imported constants and leaving out unused private code
+import sys
+
+
+# The import gets these values at runtime, so a name that prints as -1 wasn't
+# folded by mpy-cross.
+class FakeRegs:
+    WIDTH = -1
+    HEIGHT = -1
+    AREA = -1
+    NAME = "runtime"
+
+
+sys.modules["cmd_mpy_cross"] = FakeRegs
+sys.modules["cmd_mpy_cross.regs"] = FakeRegs
+
+from cmd_mpy_cross.regs import WIDTH, HEIGHT as H, AREA as _AREA, NAME
+
+
+def area():
+    return WIDTH * H
+
+
+print(WIDTH, H, _AREA, area())
+
+# not a constant, so it comes from the import
+print(NAME)
+
+# only the alias is a constant, and only the alias is bound
+try:
+    HEIGHT
+except NameError:
+    print("NameError")
+
+
+def _helper():
+    # only called from _unused, so it goes too
+    return 1
+
+
+def _unused():
+    return _helper()
+
+
+def _used():
+    return 2
+
+
+class _UnusedClass:
+    pass
+
+
+def _register(f):
+    return f
+
+
+# decorated definitions are kept
+@_register
+def _decorated():
+    pass
+
+
+def public():
+    return _used()
+
+
+print(public())
+
+names = dir()
+print(sorted(n for n in names if n.startswith("_") and not n.startswith("__")))
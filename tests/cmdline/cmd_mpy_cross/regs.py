@@ -0,0 +1,8 @@
+# Constants that cmdline/cmd_mpy_cross.py imports, read by mpy-cross -C.
+from micropython import const
+
+WIDTH = const(128)
+HEIGHT = const(64)
+AREA = const(WIDTH * HEIGHT)
+_PRIVATE = const(1)
+NAME = "regs"
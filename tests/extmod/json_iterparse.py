@@ -0,0 +1,66 @@
+try:
+    import json
+    from io import BytesIO
+
+    json.iterparse
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+doc = b"""{"name": "x", "daily": [
+    {"temp": 1.5, "rain": [1, 2], "note": "a\\"b"},
+    {"temp": -2, "rain": [], "note": "\\u0041"},
+    {"temp": 3}
+], "extra": {"deep": [[[{"temp": 99}]]]}, "tail": true}"""
+
+
+def run(paths=None, data=doc):
+    for item in json.iterparse(BytesIO(data), paths):
+        print(item)
+
+
+print("all")
+run()
+print("daily temps")
+run([("daily", None, "temp")])
+print("subtree")
+run([("daily", 1), ("extra",)])
+print("missing")
+run([("nope",)])
+print("index")
+run([["daily", 2, "temp"], ("name",)])
+print("root")
+run([()])
+run(None, b"42")
+run([()], b' "s" ')
+run(None, b"[]")
+run(None, b"{}")
+
+# a stream that only has readinto
+class Buffer:
+    def __init__(self, data):
+        self._data = data
+        self._i = 0
+
+    def readinto(self, buf):
+        l = min(len(buf), len(self._data) - self._i)
+        buf[:l] = self._data[self._i : self._i + l]
+        self._i += l
+        return l
+
+
+print([v for _, v in json.iterparse(Buffer(doc), [("daily", None, "temp")])])
+
+# the first object ends the iteration, like load
+print(list(json.iterparse(BytesIO(b"[1][2]"))))
+
+for bad in (b"", b"[1, 2", b'{"a": [1}', b"]", b'{"a": tru}', b'{[1]: 2}'):
+    try:
+        run(None, bad)
+    except ValueError:
+        print("ValueError")
+
+try:
+    json.iterparse(BytesIO(doc), ["daily.temp"])
+except TypeError:
+    print("TypeError")
@@ -0,0 +1,27 @@
+# Test that patterns given as strings are matched correctly when compiled
+# forms are reused, including after being dropped from the cache.
+
+try:
+    import re
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+patterns = ["a+", "b+", "(c)d", "[0-9]+", "x|y", "^z", "e$", "f?g"]
+subjects = ["aaa", "bb", "cd", "123", "y", "z", "e", "g", "none"]
+
+for _ in range(2):
+    for p in patterns:
+        print(p, [re.search(p, s) is not None for s in subjects])
+
+# Recently used patterns stay correct while others come and go.
+for p in patterns:
+    print(re.match("a+", "aab").group(0), re.match(p, "cd") is not None)
+
+# Equal patterns built at runtime are found like the literals.
+print(re.match("".join(["(c", ")d"]), "cd").group(1))
+
+# str and bytes patterns with the same text are kept apart.
+print(re.match("a+", "aa").group(0), re.match(b"a+", b"aa").group(0))
+
+print(re.sub("[0-9]", "#", "a1b2"), re.sub("[0-9]", "#", "33"))
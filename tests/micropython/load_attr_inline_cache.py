@@ -0,0 +1,83 @@
+# Test that cached attribute and global lookups notice when the underlying
+# maps change between executions of the same instruction.
+
+
+class A:
+    def __init__(self, n):
+        for i in range(n):
+            setattr(self, "x%d" % i, i)
+        self.v = "A"
+
+    def meth(self):
+        return "meth"
+
+
+class B:
+    def __init__(self):
+        self.v = "B"
+
+
+def get_v(o):
+    return o.v
+
+
+# Same instruction, instances with different member layouts.
+objs = [A(0), A(5), B(), A(20)]
+for _ in range(3):
+    print([get_v(o) for o in objs])
+
+# Attribute deleted then re-added.
+a = A(3)
+print(get_v(a))
+del a.v
+try:
+    get_v(a)
+except AttributeError:
+    print("AttributeError")
+a.v = "again"
+print(get_v(a))
+
+# Instance member shadowing a method.
+print(a.meth())
+a.meth = lambda: "member"
+print(a.meth())
+del a.meth
+print(a.meth())
+
+
+# Native methods on different types from the same instruction.
+def count1(o):
+    return o.count("a")
+
+
+for o in (["a", "a", "b"], ("a",), "aaa", ["a", "a", "b"]):
+    print(count1(o))
+
+g = 1
+
+
+def get_g():
+    return g
+
+
+# Global seen as builtin, then module global, then rehashed globals.
+def get_len():
+    return len
+
+
+print(get_len() is len)
+len = "shadowed"
+print(get_len())
+del len
+print(get_len()("abc"))
+
+print(get_g())
+for i in range(50):
+    globals()["filler%d" % i] = i
+g = 2
+print(get_g())
+del g
+try:
+    get_g()
+except NameError:
+    print("NameError")
@@ -0,0 +1,113 @@
+# Test sequences on locals and small ints that the compiler may fuse into
+# single opcodes; they must behave exactly like the unfused sequences.
+
+
+def loop(n):
+    i = 0
+    total = 0
+    while i < n:
+        total += i
+        i += 1
+    return i, total
+
+
+print(loop(10))
+
+
+def arith(x):
+    a = x + 1
+    b = x - 4
+    c = x * 11
+    d = x // 3
+    e = x % 3
+    f = x << 2
+    g = x & 7
+    return a, b, c, d, e, f, g
+
+
+print(arith(5))
+print(arith(-5))
+print(arith(2**62))
+
+
+def compare(x):
+    return x < 0, x <= 0, x == 0, x != 0, x >= 0, x > 0
+
+
+print(compare(-1))
+print(compare(0))
+print(compare(1))
+print(compare(0.5))
+
+
+def inplace(x):
+    x += 1
+    x -= 4
+    x *= 2
+    x = x + 11
+    return x
+
+
+print(inplace(3))
+print(inplace(1.5))
+print(inplace(2**62))
+
+
+# Overflow out of the small-int range.
+def grow(x):
+    for _ in range(3):
+        x += 11
+        x = x * 11
+    return x
+
+
+print(grow(2**29))
+
+
+def unbound():
+    x += 1
+    return x
+
+
+try:
+    unbound()
+except NameError:
+    print("NameError")
+
+
+def unbound2():
+    return y < 1
+    y = 0
+
+
+try:
+    unbound2()
+except NameError:
+    print("NameError")
+
+try:
+    inplace("a")
+except TypeError:
+    print("TypeError")
+
+
+# Operators with user types on the left.
+class A:
+    def __add__(self, other):
+        return "add %d" % other
+
+    def __iadd__(self, other):
+        return "iadd %d" % other
+
+    def __lt__(self, other):
+        return "lt %d" % other
+
+
+def user(a):
+    b = a + 2
+    c = a < 3
+    a += 1
+    return b, c, a
+
+
+print(user(A()))
@@ -0,0 +1,45 @@
+# Time rendering audio blocks from an audiomixer.Mixer with several looping voices.
+
+try:
+    import array
+    import audiocore
+    import audiomixer
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def make_mixer(voices, sample_rate):
+    mixer = audiomixer.Mixer(
+        voice_count=voices, buffer_size=1024, channel_count=2, sample_rate=sample_rate
+    )
+    for i in range(voices):
+        data = array.array("h", [((j * (i + 3)) % 200 - 100) * 300 for j in range(512)])
+        # every other voice plays at a different rate so it is resampled
+        rate = sample_rate if i % 2 == 0 else sample_rate // 2
+        sample = audiocore.RawSample(data, channel_count=2, sample_rate=rate)
+        mixer.voice[i].level = 1 / voices
+        mixer.voice[i].play(sample, loop=True)
+    return mixer
+
+
+def mix(mixer, nblocks):
+    for _ in range(nblocks):
+        audiocore.get_buffer(mixer)
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 10): (2, 50),
+    (100, 100): (4, 200),
+    (1000, 1000): (4, 1000),
+    (5000, 1000): (8, 4000),
+}
+
+
+def bm_setup(params):
+    voices, nblocks = params
+    mixer = make_mixer(voices, 22050)
+    return lambda: mix(mixer, nblocks), lambda: (voices * nblocks // 10, None)
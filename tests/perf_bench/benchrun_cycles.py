@@ -0,0 +1,41 @@
+def bm_run(N, M, repeat, background_tasks):
+    try:
+        from supervisor import benchmark
+
+        unit = "cycles"
+    except ImportError:
+        benchmark = None
+        unit = "us"
+
+    # Pick sensible parameters given N, M
+    cur_nm = (0, 0)
+    param = None
+    for nm, p in bm_params.items():
+        if 10 * nm[0] <= 12 * N and nm[1] <= M and nm > cur_nm:
+            cur_nm = nm
+            param = p
+    if param is None:
+        print("-", -1, -1, -1, -1, -1, -1, "SKIP: no matching params")
+        return
+
+    # Run, timing each repeat with the cycle counter when the board has one
+    run, result = bm_setup(param)
+    if benchmark is not None:
+        t_min, t_med, t_max, alloc, collections = benchmark(
+            run, repeat=repeat, background_tasks=background_tasks
+        )
+    else:
+        import gc
+        from time import ticks_us, ticks_diff
+
+        times = []
+        for _ in range(repeat):
+            gc.collect()
+            t0 = ticks_us()
+            run()
+            times.append(ticks_diff(ticks_us(), t0))
+        times.sort()
+        t_min, t_med, t_max = times[0], times[repeat // 2], times[-1]
+        alloc, collections = -1, -1
+    norm, out = result()
+    print(unit, t_min, t_med, t_max, alloc, collections, norm, out)
@@ -0,0 +1,41 @@
+# Time a 3x3 bitmapfilter.morph convolution over an RGB565 bitmap.
+
+try:
+    import displayio
+    import bitmapfilter
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def make_bitmap(size):
+    b = displayio.Bitmap(size, size, 65535)
+    for y in range(size):
+        for x in range(size):
+            b[x, y] = (x * 2113 + y * 31) & 0xFFFF
+    return b
+
+
+blur = (1, 2, 1, 2, 4, 2, 1, 2, 1)
+
+
+def filter(b, nloop):
+    for _ in range(nloop):
+        bitmapfilter.morph(b, weights=blur)
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 10): (32, 4),
+    (100, 100): (64, 8),
+    (1000, 1000): (128, 16),
+    (5000, 1000): (240, 32),
+}
+
+
+def bm_setup(params):
+    size, nloop = params
+    b = make_bitmap(size)
+    return lambda: filter(b, nloop), lambda: (size * size * nloop // 1000, None)
@@ -0,0 +1,43 @@
+# Time bitmaptools.blit of sprites, with and without a skip index.
+
+try:
+    import displayio
+    import bitmaptools
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def make_bitmaps(size, value_count):
+    dest = displayio.Bitmap(size, size, value_count)
+    sprite = displayio.Bitmap(16, 16, value_count)
+    for y in range(sprite.height):
+        for x in range(sprite.width):
+            sprite[x, y] = (x + y) % value_count
+    return dest, sprite
+
+
+def blit(dest, sprite, nloop):
+    span = dest.width - sprite.width
+    for i in range(nloop):
+        x = (i * 7) % span
+        y = (i * 13) % span
+        bitmaptools.blit(dest, sprite, x, y)
+        bitmaptools.blit(dest, sprite, y, x, skip_source_index=0)
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 10): (64, 200),
+    (100, 100): (128, 1000),
+    (1000, 1000): (240, 5000),
+    (5000, 1000): (320, 20000),
+}
+
+
+def bm_setup(params):
+    size, nloop = params
+    dest, sprite = make_bitmaps(size, 65535)
+    return lambda: blit(dest, sprite, nloop), lambda: (nloop // 10, None)
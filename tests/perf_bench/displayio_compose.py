@@ -0,0 +1,89 @@
+# Time full-screen composition of a group of tile grids and vectorio shapes.
+
+try:
+    import displayio
+    import vectorio
+
+    displayio.NullDisplay
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+def make_display(width, height, tiles):
+    display = displayio.NullDisplay(width, height)
+    palette = displayio.Palette(4)
+    for i, c in enumerate((0x000000, 0xFF0000, 0x00FF00, 0x0000FF)):
+        palette[i] = c
+    sheet = displayio.Bitmap(32, 8, 4)
+    for y in range(sheet.height):
+        for x in range(sheet.width):
+            sheet[x, y] = (x ^ y) & 3
+    group = displayio.Group()
+    background = displayio.TileGrid(
+        sheet,
+        pixel_shader=palette,
+        width=width // 8,
+        height=height // 8,
+        tile_width=8,
+        tile_height=8,
+    )
+    for i in range(background.width * background.height):
+        background[i] = i & 3
+    group.append(background)
+    for i in range(tiles):
+        group.append(
+            vectorio.Circle(
+                pixel_shader=palette,
+                radius=6,
+                x=(i * 17) % width,
+                y=(i * 11) % height,
+                color_index=1 + i % 3,
+            )
+        )
+        group.append(
+            vectorio.Rectangle(
+                pixel_shader=palette,
+                width=10,
+                height=6,
+                x=(i * 23) % width,
+                y=(i * 7) % height,
+                color_index=1 + (i + 1) % 3,
+            )
+        )
+    display.root_group = group
+    return display, background
+
+
+def compose(display, background, frames):
+    pixels = 0
+    for i in range(frames):
+        # scroll the background so that every frame is a full redraw
+        background.x = -(i & 7)
+        pixels += display.refresh()
+    return pixels
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 10): (64, 32, 2, 4),
+    (100, 100): (128, 64, 4, 8),
+    (1000, 1000): (240, 135, 8, 20),
+    (5000, 1000): (320, 240, 16, 40),
+}
+
+
+def bm_setup(params):
+    width, height, tiles, frames = params
+    display, background = make_display(width, height, tiles)
+    state = [0]
+
+    def run():
+        state[0] = compose(display, background, frames)
+
+    def result():
+        return state[0] // 1000, None
+
+    return run, result
@@ -0,0 +1,37 @@
+# Time rendering audio blocks from a synthio.Synthesizer playing a chord.
+
+try:
+    import audiocore
+    import synthio
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def make_synth(voices):
+    envelope = synthio.Envelope(attack_time=0.01, release_time=0.1, sustain_level=0.8)
+    synth = synthio.Synthesizer(sample_rate=48000, channel_count=2, envelope=envelope)
+    synth.press([synthio.Note(110 * (i + 1), panning=(i % 3 - 1) / 2) for i in range(voices)])
+    return synth
+
+
+def render(synth, nblocks):
+    for _ in range(nblocks):
+        audiocore.get_buffer(synth)
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 10): (2, 50),
+    (100, 100): (4, 200),
+    (1000, 1000): (8, 1000),
+    (5000, 1000): (12, 4000),
+}
+
+
+def bm_setup(params):
+    voices, nblocks = params
+    synth = make_synth(voices)
+    return lambda: render(synth, nblocks), lambda: (voices * nblocks // 10, None)
@@ -100,7 +100,97 @@ def run_benchmark_on_target(target, script, run_command=None):
         return -1, -1, "CRASH: %r" % err, runtime_us
 
 
-def run_benchmarks(console, target, param_n, param_m, n_average, test_list):
+def run_cycles_benchmark_on_target(target, script, run_command):
+    # Output of benchrun_cycles.py is: unit min median max alloc collections norm result
+    output, err, _ = run_script_on_target(target, script, run_command)
+    if err is not None:
+        return None, "CRASH: %r" % err
+    fields = output.split(None, 7)
+    if len(fields) == 8 and fields[-1].startswith("SKIP"):
+        return None, fields[-1]
+    try:
+        return (fields[0],) + tuple(int(f) for f in fields[1:7]), fields[7]
+    except (ValueError, IndexError):
+        return None, "CRASH: %r" % output
+
+
+def run_cycles_benchmarks(
+    console, target, param_n, param_m, n_average, test_list, background_tasks, output
+):
+    table = Table(show_header=True)
+    table.add_column("Test")
+    table.add_column("Median", justify="right")
+    table.add_column("Spread", justify="right")
+    table.add_column("Score", justify="right")
+    table.add_column("Alloc", justify="right")
+    table.add_column("GCs", justify="right")
+
+    live = Live(table, console=console)
+    live.start()
+
+    with open(BENCH_SCRIPT_DIR + "benchrun.py", "rb") as f:
+        benchrun = f.read()
+    with open(BENCH_SCRIPT_DIR + "benchrun_cycles.py", "rb") as f:
+        benchrun_cycles = f.read()
+    bm_run = b"bm_run(%u, %u)\n" % (param_n, param_m)
+    bm_run_cycles = b"bm_run(%u, %u, %u, %s)\n" % (
+        param_n,
+        param_m,
+        n_average,
+        b"True" if background_tasks else b"False",
+    )
+
+    for test_file in sorted(test_list):
+        with open(test_file, "rb") as f:
+            test_script = f.read()
+
+        # All repeats run in one VM, timed on the target itself
+        stats, result = run_cycles_benchmark_on_target(
+            target, test_script + benchrun_cycles, bm_run_cycles
+        )
+        if stats is not None and result != "None":
+            _, _, result_exp, _ = run_benchmark_on_target(
+                PYTHON_TRUTH, test_script + benchrun, bm_run
+            )
+            if result != result_exp:
+                stats, result = None, "FAIL truth"
+
+        if stats is None:
+            print(test_file, result)
+            table.add_row(test_file, *(["skip" if result.startswith("SKIP") else "error"] * 5))
+        else:
+            unit, t_min, t_med, t_max, alloc, collections, norm = stats
+            t_spread = 100 * (t_max - t_min) / max(t_med, 1)
+            score = 1e6 * norm / max(t_med, 1)
+            table.add_row(
+                test_file,
+                f"{t_med} {unit}",
+                f"{t_spread:.1f}%",
+                f"{score:.2f}",
+                "-" if alloc < 0 else str(alloc),
+                "-" if collections < 0 else str(collections),
+            )
+            if output:
+                # Same leading columns as run-perfbench.py so that -t and -s can diff it
+                output.write(
+                    "{}: {} {:.4f} {:.2f} {:.4f} {} {} {} {}\n".format(
+                        test_file,
+                        t_med,
+                        t_spread,
+                        score,
+                        t_spread,
+                        t_min,
+                        t_max,
+                        alloc,
+                        collections,
+                    )
+                )
+
+        live.update(table, refresh=True)
+    live.stop()
+
+
+def run_benchmarks(console, target, param_n, param_m, n_average, test_list, output):
     skip_complex = run_feature_test(target, "complex") != "complex"
     skip_native = run_feature_test(target, "native_check") != "native"
 
@@ -189,6 +279,12 @@ def run_benchmarks(console, target, param_n, param_m, n_average, test_list):
                 f"{s_avg:.2f}±{100 * s_sd / s_avg:.1f}%",
                 f"{r_avg:.2f}±{100 * r_sd / r_avg:.1f}%",
             )
+            if output:
+                output.write(
+                    "{}: {:.2f} {:.4f} {:.2f} {:.4f}\n".format(
+                        test_file, t_avg, 100 * t_sd / t_avg, s_avg, 100 * s_sd / s_avg
+                    )
+                )
             if 0:
                 print("  times: ", times)
                 print("  scores:", scores)
@@ -212,7 +308,7 @@ def parse_output(filename):
     return n, m, data
 
 
-def compute_diff(file1, file2, diff_score):
+def compute_diff(file1, file2, diff_score, max_regression=None):
     # Parse output data from previous runs
     n1, m1, d1 = parse_output(file1)
     n2, m2, d2 = parse_output(file2)
@@ -233,6 +329,7 @@ def compute_diff(file1, file2, diff_score):
     )
 
     # Print entries
+    regressions = 0
     while d1 and d2:
         if d1[0][0] == d2[0][0]:
             # Found entries with matching names
@@ -252,11 +349,19 @@ def compute_diff(file1, file2, diff_score):
                     name, av1, av2, av_diff, percent, percent_sd
                 )
             )
+            # Times regress upwards and scores downwards
+            regression = -percent if diff_score else percent
+            if max_regression is not None and regression > max_regression:
+                regressions += 1
         elif d1[0][0] < d2[0][0]:
             d1.pop(0)
         else:
             d2.pop(0)
 
+    if regressions:
+        print("{} regressions worse than {}%".format(regressions, max_regression))
+    return regressions
+
 
 def main():
     cmd_parser = argparse.ArgumentParser(description="Run benchmarks for MicroPython")
@@ -273,6 +378,23 @@ def main():
         "-d", "--device", default="/dev/ttyACM0", help="the device for pyboard.py"
     )
     cmd_parser.add_argument("-a", "--average", default="8", help="averaging number")
+    cmd_parser.add_argument(
+        "-c",
+        "--cycles",
+        action="store_true",
+        help="time on the target with supervisor.benchmark, repeating in one VM",
+    )
+    cmd_parser.add_argument(
+        "--no-background",
+        action="store_true",
+        help="with --cycles, hold off background tasks while each repeat runs",
+    )
+    cmd_parser.add_argument("-o", "--output", help="also write results to this file for -t and -s")
+    cmd_parser.add_argument(
+        "--max-regression",
+        type=float,
+        help="with -t or -s, exit with an error if any test got worse by more than this percent",
+    )
     cmd_parser.add_argument(
         "--emit", default="bytecode", help="MicroPython emitter to use (bytecode or native)"
     )
@@ -282,8 +404,8 @@ def main():
     args = cmd_parser.parse_args()
 
     if args.diff_time or args.diff_score:
-        compute_diff(args.N[0], args.M[0], args.diff_score)
-        sys.exit(0)
+        regressions = compute_diff(args.N[0], args.M[0], args.diff_score, args.max_regression)
+        sys.exit(1 if regressions else 0)
 
     # N, M = 50, 25 # esp8266
     # N, M = 100, 100 # pyboard, esp32
@@ -299,7 +421,7 @@ def main():
         target = [MICROPYTHON, "-X", "emit=" + args.emit]
 
     if len(args.files) == 0:
-        tests_skip = ("benchrun.py",)
+        tests_skip = ("benchrun.py", "benchrun_cycles.py")
         if M <= 25:
             # These scripts are too big to be compiled by the target
             tests_skip += ("bm_chaos.py", "bm_hexiom.py", "misc_raytrace.py")
@@ -313,8 +435,20 @@ def main():
 
     console = Console()
     print("N={} M={} n_average={}".format(N, M, n_average))
+    output = None
+    if args.output:
+        output = open(args.output, "w")
+        output.write("N={} M={} n_average={}\n".format(N, M, n_average))
+
+    if args.cycles:
+        run_cycles_benchmarks(
+            console, target, N, M, n_average, tests, not args.no_background, output
+        )
+    else:
+        run_benchmarks(console, target, N, M, n_average, tests, output)
 
-    run_benchmarks(console, target, N, M, n_average, tests)
+    if output:
+        output.close()
 
     if isinstance(target, pyboard.Pyboard):
         target.exit_raw_repl()
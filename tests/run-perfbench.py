@@ -293,7 +293,7 @@ def main():
             target.extend(["-X", "heapsize=" + args.heapsize])
 
     if len(args.files) == 0:
-        tests_skip = ("benchrun.py",)
+        tests_skip = ("benchrun.py", "benchrun_cycles.py")
         if M <= 25:
             # These scripts are too big to be compiled by the target
             tests_skip += ("bm_chaos.py", "bm_hexiom.py", "misc_raytrace.py")
@@ -196,11 +196,15 @@ def run_micropython(pyb, args, test_file, is_special=False):
         if is_special:
             # check for any cmdline options needed for this test
             args = [MICROPYTHON]
+            mpy_cross_args = None
             with open(test_file, "rb") as f:
                 line = f.readline()
                 if line.startswith(b"# cmdline:"):
                     # subprocess.check_output on Windows only accepts strings, not bytes
                     args += [str(c, "utf-8") for c in line[10:].strip().split()]
+                # CIRCUITPY-CHANGE: tests of mpy-cross options, run from the test's directory
+                elif line.startswith(b"# mpy-cross:"):
+                    mpy_cross_args = [str(c, "utf-8") for c in line[12:].strip().split()]
 
             # run the test, possibly with redirected input
             try:
@@ -252,6 +256,26 @@ def run_micropython(pyb, args, test_file, is_special=False):
                             pass
                         os.close(master)
                         os.close(slave)
+                # CIRCUITPY-CHANGE
+                elif mpy_cross_args is not None:
+                    cwd = os.path.dirname(test_file)
+                    mpy_filename = tempfile.mktemp(dir=cwd, suffix=".mpy")
+                    try:
+                        subprocess.check_output(
+                            [os.path.abspath(MPYCROSS)]
+                            + mpy_cross_args
+                            + ["-o", os.path.basename(mpy_filename), os.path.basename(test_file)],
+                            stderr=subprocess.STDOUT,
+                            cwd=cwd,
+                        )
+                        mpy_modname = os.path.splitext(os.path.basename(mpy_filename))[0]
+                        output_mupy = subprocess.check_output(
+                            [os.path.abspath(MICROPYTHON), "-m", mpy_modname],
+                            stderr=subprocess.STDOUT,
+                            cwd=cwd,
+                        )
+                    finally:
+                        rm_f(mpy_filename)
                 else:
                     output_mupy = subprocess.check_output(
                         args + [test_file], stderr=subprocess.STDOUT
@@ -94,10 +94,10 @@ for x, c in enumerate(filtered_characters):
                 b[overall_bit // 8] |= 1 << (7 - (overall_bit % 8))
 
 
-extra_characters = ""
-for c in filtered_characters:
-    if c not in visible_ascii:
-        extra_characters += c
+# Glyphs past visible ascii are looked up by binary search so keep them sorted by codepoint.
+extra_codepoints = sorted(ord(c) for c in filtered_characters if c not in visible_ascii)
+if extra_codepoints and extra_codepoints[-1] > 0xFFFF:
+    raise RuntimeError("Terminal font characters must be in the Basic Multilingual Plane")
 
 c_file = args.output_c_file
 
@@ -359,6 +359,27 @@ displayio_bitmap_t supervisor_terminal_font_bitmap = {{
 )
 
 
+c_file.write(
+    """\
+static const uint16_t supervisor_terminal_font_codepoints[{}] = {{
+""".format(
+        max(1, len(extra_codepoints))
+    )
+)
+
+for i, codepoint in enumerate(extra_codepoints):
+    c_file.write("0x{:04x}, ".format(codepoint))
+    if (i + 1) % 8 == 0:
+        c_file.write("\n")
+if len(extra_codepoints) % 8 != 0:
+    c_file.write("\n")
+
+c_file.write(
+    """\
+};
+"""
+)
+
 c_file.write(
     """\
 const fontio_builtinfont_t supervisor_terminal_font = {{
@@ -366,11 +387,11 @@ const fontio_builtinfont_t supervisor_terminal_font = {{
     .bitmap = &supervisor_terminal_font_bitmap,
     .width = {},
     .height = {},
-    .unicode_characters = (const uint8_t*) "{}",
-    .unicode_characters_len = {}
+    .unicode_codepoints = supervisor_terminal_font_codepoints,
+    .unicode_codepoints_len = {}
 }};
 """.format(
-        tile_x, tile_y, extra_characters, len(extra_characters.encode("utf-8"))
+        tile_x, tile_y, len(extra_codepoints)
     )
 )
 
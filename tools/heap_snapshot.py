@@ -0,0 +1,191 @@
+# This file is part of the CircuitPython project: https://circuitpython.org
+#
+# SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+#
+# SPDX-License-Identifier: MIT
+
+"""Show the heap fragmentation recorded by uheap.snapshot().
+
+Give one or more snapshot files, oldest first, to see how the heap changes
+over time. Each snapshot gets a line of statistics and a map where every
+character covers the same number of blocks:
+
+    python3 tools/heap_snapshot.py heap-1.bin heap-2.bin
+
+Snapshot format, version 1. Numbers are unsigned LEB128 as in .mpy files.
+
+    "GCHM" version:u8 bytes_per_block:uint
+    then records, each a tag byte and a uint:
+    0xff n   a new heap area of n blocks starts
+    0x00 n   n free blocks
+    0x40 n   one allocation of n blocks, low 5 bits of the tag are its
+             class (CLASSES below) and 0x20 is set if it has a finaliser
+    0x80 n   the previous allocation repeats n more times
+"""
+
+import argparse
+import sys
+
+# Index is the class number in the snapshot, see shared-module/uheap.
+# The letters match gc_dump_alloc_table where it has one. Lower case letters
+# in the map mark cells that are partly free.
+CLASSES = [
+    ("other", "H"),
+    ("str", "S"),
+    ("bytes", "S"),
+    ("bytearray", "A"),
+    ("array", "A"),
+    ("list", "L"),
+    ("tuple", "T"),
+    ("dict", "D"),
+    ("set", "E"),
+    ("float", "F"),
+    ("int", "N"),
+    ("function", "B"),
+    ("module", "M"),
+    ("type", "C"),
+    ("instance", "I"),
+    ("generator", "G"),
+]
+
+TAG_FREE = 0x00
+TAG_ALLOCATED = 0x40
+TAG_FINALISER = 0x20
+TAG_REPEAT = 0x80
+TAG_AREA = 0xFF
+
+
+class Snapshot:
+    def __init__(self, data):
+        if data[:4] != b"GCHM":
+            raise ValueError("not a heap snapshot")
+        if data[4] != 1:
+            raise ValueError("unknown snapshot version {}".format(data[4]))
+        self._data = data
+        self._offset = 5
+        self.bytes_per_block = self._read_uint()
+        # Each area is a list of (class or None for free, finaliser, blocks).
+        self.areas = []
+        last = None
+        while self._offset < len(data):
+            tag = data[self._offset]
+            self._offset += 1
+            value = self._read_uint()
+            if tag == TAG_AREA:
+                self.areas.append([])
+                last = None
+            elif tag == TAG_FREE:
+                self.areas[-1].append((None, False, value))
+            elif tag == TAG_REPEAT:
+                self.areas[-1].extend([last] * value)
+            elif tag & TAG_ALLOCATED:
+                last = (tag & 0x1F, bool(tag & TAG_FINALISER), value)
+                self.areas[-1].append(last)
+            else:
+                raise ValueError("bad tag 0x{:02x}".format(tag))
+
+    def _read_uint(self):
+        value = 0
+        shift = 0
+        while True:
+            b = self._data[self._offset]
+            self._offset += 1
+            value |= (b & 0x7F) << shift
+            shift += 7
+            if b < 0x80:
+                return value
+
+    def stats(self):
+        free = used = allocations = largest_free = free_runs = 0
+        by_class = {}
+        for area in self.areas:
+            for cls, _, blocks in area:
+                if cls is None:
+                    free += blocks
+                    free_runs += 1
+                    largest_free = max(largest_free, blocks)
+                else:
+                    used += blocks
+                    allocations += 1
+                    name = CLASSES[cls][0] if cls < len(CLASSES) else "class {}".format(cls)
+                    count, total = by_class.get(name, (0, 0))
+                    by_class[name] = (count + 1, total + blocks)
+        return {
+            "free": free,
+            "used": used,
+            "allocations": allocations,
+            "free_runs": free_runs,
+            "largest_free": largest_free,
+            # 0 when all free memory is one run, near 1 when it is shredded.
+            "fragmentation": 1 - largest_free / free if free else 0,
+            "by_class": by_class,
+        }
+
+    def map(self, width):
+        lines = []
+        for area in self.areas:
+            total = sum(blocks for _, _, blocks in area)
+            per_char = max(1, -(-total // width))
+            # Blocks of each kind within every character cell.
+            cells = [{} for _ in range(-(-total // per_char))]
+            block = 0
+            for cls, _, blocks in area:
+                while blocks:
+                    cell = block // per_char
+                    n = min(blocks, (cell + 1) * per_char - block)
+                    cells[cell][cls] = cells[cell].get(cls, 0) + n
+                    block += n
+                    blocks -= n
+            line = []
+            for cell in cells:
+                used = {cls: n for cls, n in cell.items() if cls is not None}
+                if not used:
+                    line.append(".")
+                    continue
+                cls = max(used, key=used.get)
+                letter = CLASSES[cls][1] if cls < len(CLASSES) else "?"
+                line.append(letter.lower() if None in cell else letter)
+            lines.append("".join(line))
+        return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Show heap fragmentation from uheap.snapshot().")
+    parser.add_argument("files", nargs="+", help="snapshot files, oldest first")
+    parser.add_argument("-w", "--width", type=int, default=64, help="characters in each map line")
+    parser.add_argument("--no-map", action="store_true", help="only print the statistics")
+    parser.add_argument("--classes", action="store_true", help="print blocks used by each class")
+    args = parser.parse_args()
+
+    print(
+        "{:24} {:>8} {:>8} {:>8} {:>8} {:>6}".format(
+            "snapshot", "used", "free", "largest", "runs", "frag"
+        )
+    )
+    for filename in args.files:
+        with open(filename, "rb") as f:
+            snapshot = Snapshot(f.read())
+        stats = snapshot.stats()
+        bpb = snapshot.bytes_per_block
+        print(
+            "{:24} {:>8} {:>8} {:>8} {:>8} {:>5.0f}%".format(
+                filename[-24:],
+                stats["used"] * bpb,
+                stats["free"] * bpb,
+                stats["largest_free"] * bpb,
+                stats["free_runs"],
+                stats["fragmentation"] * 100,
+            )
+        )
+        if args.classes:
+            for name, (count, blocks) in sorted(
+                stats["by_class"].items(), key=lambda item: -item[1][1]
+            ):
+                print("    {:12} {:>6} allocations {:>8} bytes".format(name, count, blocks * bpb))
+        if not args.no_map:
+            for line in snapshot.map(args.width):
+                print("    " + line)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
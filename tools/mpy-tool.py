@@ -88,6 +88,8 @@ class FreezeError(Exception):
 
 class Config:
     MPY_VERSION = 6
+    # Version used when the bytecode may contain fused opcodes.
+    MPY_VERSION_FUSED_OPCODES = 7
     MPY_SUB_VERSION = 1
     MICROPY_LONGINT_IMPL_NONE = 0
     MICROPY_LONGINT_IMPL_LONGLONG = 1
@@ -113,6 +115,7 @@ MP_NATIVE_ARCH_ARMV7EMSP = 7
 MP_NATIVE_ARCH_ARMV7EMDP = 8
 MP_NATIVE_ARCH_XTENSA = 9
 MP_NATIVE_ARCH_XTENSAWIN = 10
+MP_NATIVE_ARCH_RV32IMC = 11
 
 MP_PERSISTENT_OBJ_FUN_TABLE = 0
 MP_PERSISTENT_OBJ_NONE = 1
@@ -190,7 +193,7 @@ class Opcode:
     MP_BC_BASE_RESERVED               = (0x00) # ----------------
     MP_BC_BASE_QSTR_O                 = (0x10) # LLLLLLSSSDDII---
     MP_BC_BASE_VINT_E                 = (0x20) # MMLLLLSSDDBBBBBB
-    MP_BC_BASE_VINT_O                 = (0x30) # UUMMCCCC--------
+    MP_BC_BASE_VINT_O                 = (0x30) # UUMMCCCCOO------
     MP_BC_BASE_JUMP_E                 = (0x40) # J-JJJJJEEEEF----
     MP_BC_BASE_BYTE_O                 = (0x50) # LLLLSSDTTTTTEEFF
     MP_BC_BASE_BYTE_E                 = (0x60) # --BREEEYYI------
@@ -289,6 +292,8 @@ class Opcode:
     MP_BC_CALL_FUNCTION_VAR_KW        = (MP_BC_BASE_VINT_O + 0x05) # uint
     MP_BC_CALL_METHOD                 = (MP_BC_BASE_VINT_O + 0x06) # uint
     MP_BC_CALL_METHOD_VAR_KW          = (MP_BC_BASE_VINT_O + 0x07) # uint
+    MP_BC_BINARY_OP_FAST_SMALL_INT    = (MP_BC_BASE_VINT_O + 0x08) # uint
+    MP_BC_INPLACE_OP_FAST_SMALL_INT   = (MP_BC_BASE_VINT_O + 0x09) # uint
 
     MP_BC_IMPORT_NAME                 = (MP_BC_BASE_QSTR_O + 0x0b) # qstr
     MP_BC_IMPORT_FROM                 = (MP_BC_BASE_QSTR_O + 0x0c) # qstr
@@ -333,6 +338,34 @@ def mp_small_int_fits(i):
     return -0x4_000_000 <= i <= 0x3_FFF_FFF
 
 
+def const_pool_key(obj):
+    # Key that identifies a constant object by type and value, or None if
+    # the object isn't emitted as a static definition.  Booleans compare equal
+    # to ints and -0.0 to 0.0, so those are kept apart explicitly.
+    if is_str_type(obj):
+        return ("str", obj)
+    elif is_bytes_type(obj):
+        return ("bytes", bytes(obj))
+    elif is_int_type(obj) and not isinstance(obj, bool):
+        return ("int", obj)
+    elif isinstance(obj, float):
+        return ("float", struct.pack("<d", obj))
+    elif isinstance(obj, complex):
+        return ("complex", struct.pack("<dd", obj.real, obj.imag))
+    elif type(obj) is tuple:
+        keys = []
+        for sub_obj in obj:
+            if sub_obj is None or sub_obj is False or sub_obj is True or sub_obj is Ellipsis:
+                keys.append(("singleton", repr(sub_obj)))
+            else:
+                sub_key = const_pool_key(sub_obj)
+                if sub_key is None:
+                    return None
+                keys.append(sub_key)
+        return ("tuple", tuple(keys))
+    return None
+
+
 def mp_encode_uint(val, signed=False):
     encoded = bytearray([val & 0x7F])
     val >>= 7
@@ -686,6 +719,21 @@ class CompiledModule:
         print("};")
 
     def freeze_constant_obj(self, obj_name, obj):
+        global const_pool, const_pool_hits
+
+        # Constant objects are immutable, so modules that use an equal
+        # constant can all point at the first copy that was emitted.
+        key = const_pool_key(obj)
+        if key is None:
+            return self.freeze_constant_obj_new(obj_name, obj)
+        if key in const_pool:
+            const_pool_hits += 1
+            return const_pool[key]
+        ref = self.freeze_constant_obj_new(obj_name, obj)
+        const_pool[key] = ref
+        return ref
+
+    def freeze_constant_obj_new(self, obj_name, obj):
         global const_str_content, const_int_content, const_obj_content
 
         if isinstance(obj, MPFunTable):
@@ -1062,6 +1110,7 @@ class RawCodeNative(RawCode):
             MP_NATIVE_ARCH_X64,
             MP_NATIVE_ARCH_XTENSA,
             MP_NATIVE_ARCH_XTENSAWIN,
+            MP_NATIVE_ARCH_RV32IMC,
         ):
             self.fun_data_attributes = '__attribute__((section(".text,\\"ax\\",@progbits # ")))'
         else:
@@ -1077,8 +1126,11 @@ class RawCodeNative(RawCode):
         ):
             # ARMV6 or Xtensa -- four byte align.
             self.fun_data_attributes += " __attribute__ ((aligned (4)))"
-        elif MP_NATIVE_ARCH_ARMV6M <= config.native_arch <= MP_NATIVE_ARCH_ARMV7EMDP:
-            # ARMVxxM -- two byte align.
+        elif (
+            MP_NATIVE_ARCH_ARMV6M <= config.native_arch <= MP_NATIVE_ARCH_ARMV7EMDP
+            or config.native_arch == MP_NATIVE_ARCH_RV32IMC
+        ):
+            # ARMVxxM or RV32IMC -- two byte align.
             self.fun_data_attributes += " __attribute__ ((aligned (2)))"
 
     def disassemble(self):
@@ -1333,7 +1385,7 @@ def read_mpy(filename):
         header = reader.read_bytes(4)
         if header[0] != ord("C"):
             raise MPYReadError(filename, "not a valid .mpy file")
-        if header[1] != config.MPY_VERSION:
+        if header[1] not in (config.MPY_VERSION, config.MPY_VERSION_FUSED_OPCODES):
             raise MPYReadError(filename, "incompatible .mpy version")
         feature_byte = header[2]
         mpy_native_arch = feature_byte >> 2
@@ -1453,6 +1505,7 @@ def freeze_mpy(base_qstrs, compiled_modules):
     qstr_pool_alloc = min(len(new), 10)
 
     global bc_content, const_str_content, const_int_content, const_obj_content, const_table_qstr_content, const_table_ptr_content, raw_code_count, raw_code_content
+    global const_pool, const_pool_hits
     qstr_content = 0
     bc_content = 0
     const_str_content = 0
@@ -1462,6 +1515,8 @@ def freeze_mpy(base_qstrs, compiled_modules):
     const_table_ptr_content = 0
     raw_code_count = 0
     raw_code_content = 0
+    const_pool = {}
+    const_pool_hits = 0
 
     print()
     print("const qstr_hash_t mp_qstr_frozen_const_hashes[] = {")
@@ -1549,6 +1604,7 @@ def freeze_mpy(base_qstrs, compiled_modules):
     print("const str content: %d" % const_str_content)
     print("const int content: %d" % const_int_content)
     print("const obj content: %d" % const_obj_content)
+    print("const objs shared: %d" % const_pool_hits)
     print(
         "const table qstr content: %d entries, %d bytes"
         % (const_table_qstr_content, const_table_qstr_content * 4)
@@ -1675,9 +1731,13 @@ def merge_mpy(compiled_modules, output_file):
             # Shift main_cm to front of list.
             compiled_modules.insert(0, compiled_modules.pop(main_cm_idx))
 
+        mpy_version = compiled_modules[0].header[1]
+        if any(cm.header[1] != mpy_version for cm in compiled_modules):
+            raise Exception("can't merge files with different .mpy versions")
+
         header = bytearray(4)
         header[0] = ord("C")
-        header[1] = config.MPY_VERSION
+        header[1] = mpy_version
         header[2] = config.native_arch << 2 | config.MPY_SUB_VERSION if config.native_arch else 0
         header[3] = config.mp_small_int_bits
         merged_mpy.extend(header)
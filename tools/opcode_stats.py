@@ -0,0 +1,166 @@
+# This file is part of the CircuitPython project: https://circuitpython.org
+#
+# SPDX-FileCopyrightText: Copyright (c) 2024 Adafruit Industries LLC
+#
+# SPDX-License-Identifier: MIT
+
+"""Rank the bytecode opcodes and opcode pairs counted by micropython.opcode_stats().
+
+The counts come from a build with MICROPY_VM_OPCODE_STATS enabled: the unix
+coverage variant, any unix variant built with
+CFLAGS_EXTRA=-DMICROPY_VM_OPCODE_STATS=1, or a board built with
+CIRCUITPY_OPCODE_STATS=1.
+
+Run a script on the unix port and report on it directly:
+
+    python3 tools/opcode_stats.py --run ports/unix/build-coverage/micropython app.py
+
+On a board, end code.py with
+
+    import micropython
+    print(micropython.opcode_stats())
+
+and save that line from the serial console to a file to pass to this tool:
+
+    python3 tools/opcode_stats.py stats.txt
+
+Pairs are consecutive dispatches, so they follow calls and returns between
+functions.
+"""
+
+import argparse
+import ast
+import os
+import re
+import subprocess
+import sys
+
+TOP = os.path.join(os.path.dirname(__file__), "..")
+
+# Runs the script as __main__ with the counters reset, then prints them.
+RUN_WRAPPER = """\
+import micropython
+micropython.opcode_stats(True)
+exec(compile(open({path!r}).read(), {path!r}, "exec"), {{"__name__": "__main__"}})
+print(micropython.opcode_stats())
+"""
+
+
+def read_enum(text, name):
+    body = re.search(r"typedef enum \{([^}]*)\} " + name + ";", text).group(1)
+    return re.findall(r"^\s*MP_\w+?_OP_(\w+)", body, re.M)
+
+
+def opcode_names(fold):
+    with open(os.path.join(TOP, "py", "bc0.h")) as f:
+        bc0 = f.read()
+    with open(os.path.join(TOP, "py", "runtime0.h")) as f:
+        runtime0 = f.read()
+    unary_ops = read_enum(runtime0, "mp_unary_op_t")
+    binary_ops = read_enum(runtime0, "mp_binary_op_t")
+
+    values = {}
+    for name, expr in re.findall(r"^#define (MP_BC_\w+)\s+\(([^)]*)\)", bc0, re.M):
+        expr = re.sub(r"MP_BC_\w+", lambda m: str(values.get(m.group(0), "None")), expr)
+        try:
+            values[name] = eval(expr)
+        except (NameError, SyntaxError, TypeError):
+            pass
+
+    names = {}
+    for name, value in values.items():
+        if name.startswith(("MP_BC_BASE_", "MP_BC_MASK_", "MP_BC_FORMAT_", "MP_BC_FUSED_")):
+            continue
+        if name.endswith(("_NUM", "_EXCESS")):
+            continue
+        names[value] = name[len("MP_BC_") :]
+
+    def multi(base, count, label):
+        for i in range(count):
+            names[values["MP_BC_" + base] + i] = base if fold else label(i)
+
+    small_int_excess = values["MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS"]
+    multi(
+        "LOAD_CONST_SMALL_INT_MULTI",
+        values["MP_BC_LOAD_CONST_SMALL_INT_MULTI_NUM"],
+        lambda i: "LOAD_CONST_SMALL_INT {}".format(i - small_int_excess),
+    )
+    multi("LOAD_FAST_MULTI", values["MP_BC_LOAD_FAST_MULTI_NUM"], "LOAD_FAST {}".format)
+    multi("STORE_FAST_MULTI", values["MP_BC_STORE_FAST_MULTI_NUM"], "STORE_FAST {}".format)
+    unary_count = unary_ops.index("NOT") + 1
+    multi("UNARY_OP_MULTI", unary_count, lambda i: "UNARY_OP " + unary_ops[i])
+    binary_count = binary_ops.index("POWER") + 1
+    multi("BINARY_OP_MULTI", binary_count, lambda i: "BINARY_OP " + binary_ops[i])
+    return names
+
+
+def read_stats(text):
+    # The last line that looks like the tuple from opcode_stats().
+    for line in reversed(text.splitlines()):
+        line = line.strip()
+        if line.startswith("({"):
+            return ast.literal_eval(line)
+    raise ValueError("no micropython.opcode_stats() output found")
+
+
+def merge(counts, key):
+    merged = {}
+    for k, count in counts.items():
+        k = key(k)
+        merged[k] = merged.get(k, 0) + count
+    return merged
+
+
+def print_ranked(title, counts, top):
+    total = sum(counts.values())
+    print("{} ({} total)".format(title, total))
+    cumulative = 0
+    for rank, (name, count) in enumerate(sorted(counts.items(), key=lambda item: -item[1])):
+        if rank == top:
+            break
+        cumulative += count
+        print(
+            "{:4} {:>12} {:6.2f}% {:6.2f}%  {}".format(
+                rank + 1, count, 100 * count / total, 100 * cumulative / total, name
+            )
+        )
+    print()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Rank opcodes from micropython.opcode_stats().")
+    parser.add_argument("file", help="file with the printed stats, or the script with --run")
+    parser.add_argument("--run", metavar="MICROPYTHON", help="run file with this unix binary")
+    parser.add_argument("-n", "--top", type=int, default=30, help="rows in each table")
+    parser.add_argument(
+        "--fold", action="store_true", help="count LOAD_FAST 0, LOAD_FAST 1... as one opcode"
+    )
+    args = parser.parse_args()
+
+    if args.run:
+        wrapper = RUN_WRAPPER.format(path=os.path.abspath(args.file))
+        result = subprocess.run(
+            [args.run, "-c", wrapper], stdout=subprocess.PIPE, universal_newlines=True
+        )
+        if result.returncode != 0:
+            sys.stdout.write(result.stdout)
+            return result.returncode
+        text = result.stdout
+    else:
+        with open(args.file) as f:
+            text = f.read()
+
+    opcodes, pairs, pairs_dropped = read_stats(text)
+    names = opcode_names(args.fold)
+
+    def name(opcode):
+        return names.get(opcode, "0x{:02x}".format(opcode))
+
+    print_ranked("Opcodes", merge(opcodes, name), args.top)
+    print_ranked("Pairs", merge(pairs, lambda pair: "{} -> {}".format(*map(name, pair))), args.top)
+    if pairs_dropped:
+        print("{} pairs not counted because the pair table was full".format(pairs_dropped))
+
+
+if __name__ == "__main__":
+    sys.exit(main())